@@ -49,8 +49,16 @@ assert(planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "C
 explained = coll.explain().aggregate([{$match: {foo: {$gt: 0}}}, {$count: "count"}]);
 assert(planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN"));
 
-// A $match that is not a single range cannot use the COUNT_SCAN optimization.
+// A $match on several ranges can use one COUNT_SCAN for each of them.
 explained = coll.explain().aggregate([{$match: {foo: {$in: [0, 1]}}}, {$count: "count"}]);
+assert.eq(getPlanStages(explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN").length,
+          2,
+          explained);
+assert.eq(coll.aggregate([{$match: {foo: {$in: [0, 1]}}}, {$count: "count"}]).next().count, 10);
+
+// A $match which the index keys alone cannot answer exactly cannot use the COUNT_SCAN
+// optimization.
+explained = coll.explain().aggregate([{$match: {foo: {$in: [0, /x/]}}}, {$count: "count"}]);
 assert(!planHasStage(db, explained.stages[0].$cursor.queryPlanner.winningPlan, "COUNT_SCAN"));
 
 // Test that COUNT_SCAN can be used when there is a $sort.
@@ -1,8 +1,8 @@
 /**
- * $group stages with no accumulators or with only $first accumulators can sometimes be converted
- * into a DISTINCT_SCAN (see SERVER-9507). This optimization potentially applies to a $group when it
- * begins the pipeline or when it is preceded only by one or both of $match and $sort (in that
- * order). In all cases, it must be possible to do a DISTINCT_SCAN that sees each value of the
+ * $group stages with no accumulators, or with only $first or only $last accumulators, can sometimes
+ * be converted into a DISTINCT_SCAN (see SERVER-9507). This optimization potentially applies to a
+ * $group when it begins the pipeline or when it is preceded only by one or both of $match and $sort
+ * (in that order). In all cases, it must be possible to do a DISTINCT_SCAN that sees each value of the
  * distinct field exactly once among matching documents and also provides any requested sort. The
  * test queries below show most $match/$sort/$group combinations where that is possible.
  *
@@ -510,6 +510,41 @@ assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
 assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
 assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
 
+//
+// Verify that a $sort-$group pipeline can use DISTINCT_SCAN when all accumulators are $last, by
+// scanning the index in the reverse of the requested sort.
+//
+pipeline = [{$sort: {a: 1, b: 1}}, {$group: {_id: "$a", accum: {$last: "$b"}}}];
+assertResultsMatchWithAndWithoutHintandIndexes(
+    pipeline, [{_id: null, accum: 1}, {_id: 1, accum: 3}, {_id: 2, accum: 2}]);
+explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+assert.eq({a: 1, b: 1, c: 1}, getAggPlanStage(explain, "DISTINCT_SCAN").keyPattern);
+assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+pipeline = [
+    {$sort: {a: 1, b: 1, c: 1}},
+    {$group: {_id: "$a", doc: {$last: "$$ROOT"}, c: {$last: "$c"}}}
+];
+assertResultsMatchWithAndWithoutHintandIndexes(pipeline, [
+    {_id: null, doc: {_id: 6, a: null, b: 1, c: 1.5}, c: 1.5},
+    {_id: 1, doc: {_id: 3, a: 1, b: 3, c: 2}, c: 2},
+    {_id: 2, doc: {_id: 4, a: 2, b: 2, c: 2}, c: 2}
+]);
+explain = coll.explain().aggregate(pipeline);
+assert.neq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+assert.eq(null, getAggPlanStage(explain, "SORT"), explain);
+
+//
+// Verify that a $sort-$group pipeline _does not_ use DISTINCT_SCAN when it mixes $first and $last
+// accumulators.
+//
+pipeline = [{$sort: {a: 1, b: 1}}, {$group: {_id: "$a", f: {$first: "$b"}, l: {$last: "$b"}}}];
+assertResultsMatchWithAndWithoutHintandIndexes(
+    pipeline, [{_id: null, f: 1, l: 1}, {_id: 1, f: 1, l: 3}, {_id: 2, f: 2, l: 2}]);
+explain = coll.explain().aggregate(pipeline);
+assert.eq(null, getAggPlanStage(explain, "DISTINCT_SCAN"), explain);
+
 //
 // Verify that a $sort-$group pipeline _does not_ use DISTINCT_SCAN when there are non-$first
 // accumulators.
@@ -0,0 +1,58 @@
+/**
+ * Tests that a $sort and $limit which follow a $lookup and an $addFields, and do not depend on the
+ * fields they compute, are moved ahead of both so that only the documents kept are joined.
+ *
+ * @tags: [assumes_unsharded_collection, do_not_wrap_aggregations_in_facets]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStages().
+
+const testDB = db.getSiblingDB("lookup_after_sort_limit");
+testDB.dropDatabase();
+
+const orders = testDB.getCollection("orders");
+const customers = testDB.getCollection("customers");
+
+let bulk = orders.initializeUnorderedBulkOp();
+for (let i = 0; i < 100; i++) {
+    bulk.insert({_id: i, customer: i % 10, date: i});
+}
+assert.commandWorked(bulk.execute());
+bulk = customers.initializeUnorderedBulkOp();
+for (let i = 0; i < 10; i++) {
+    bulk.insert({_id: i, name: "customer" + i});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [
+    {$lookup: {from: customers.getName(), localField: "customer", foreignField: "_id", as: "info"}},
+    {$addFields: {latest: true}},
+    {$sort: {date: -1}},
+    {$limit: 3},
+];
+assert.eq(
+    [
+        {_id: 99, customer: 9, date: 99, info: [{_id: 9, name: "customer9"}], latest: true},
+        {_id: 98, customer: 8, date: 98, info: [{_id: 8, name: "customer8"}], latest: true},
+        {_id: 97, customer: 7, date: 97, info: [{_id: 7, name: "customer7"}], latest: true},
+    ],
+    orders.aggregate(pipeline).toArray());
+
+// The bounded sort runs in the query layer, before the join.
+const explain = orders.explain().aggregate(pipeline);
+assert.eq(0, getAggPlanStages(explain, "$sort").length, explain);
+assert.eq(0, getAggPlanStages(explain, "$limit").length, explain);
+assert.eq(1, getAggPlanStages(explain, "$lookup").length, explain);
+
+// A sort on a computed field still has to wait for it.
+const sortOnInfo = [
+    {$lookup: {from: customers.getName(), localField: "customer", foreignField: "_id", as: "info"}},
+    {$sort: {"info.name": -1, date: -1}},
+    {$limit: 1},
+];
+assert.eq([{_id: 99, customer: 9, date: 99, info: [{_id: 9, name: "customer9"}]}],
+          orders.aggregate(sortOnInfo).toArray());
+assert.eq(1, getAggPlanStages(orders.explain().aggregate(sortOnInfo), "$sort").length);
+}());
@@ -71,6 +71,35 @@ assert.commandFailedWithCode(coll.runCommand({
     cursor: {}
 }),
                              5414201);
+
+// Test that a window which looks back over more documents than fit in memory succeeds when the
+// documents behind the current one can be spilled to disk.
+for (let i = 0; i < 100; i++) {
+    assert.commandWorked(coll.insert({_id: 100 + i, partitionKey: 3, str: "str"}));
+}
+const lookbackPipeline = [
+    {$match: {partitionKey: 3}},
+    {
+        $setWindowFields: {
+            sortBy: {_id: 1},
+            partitionBy: "$partitionKey",
+            output: {val: {$sum: "$_id", window: {documents: [-50, 0]}}}
+        }
+    },
+    {$sort: {_id: 1}},
+];
+assert.commandFailedWithCode(
+    coll.runCommand({aggregate: coll.getName(), pipeline: lookbackPipeline, cursor: {}}), 5414201);
+const results = coll.aggregate(lookbackPipeline, {allowDiskUse: true}).toArray();
+assert.eq(100, results.length);
+for (let i = 0; i < 100; i++) {
+    let expected = 0;
+    for (let j = Math.max(0, i - 50); j <= i; j++) {
+        expected += 100 + j;
+    }
+    assert.eq(expected, results[i].val, results[i]);
+}
+
 // Reset limit for other tests.
 setParameterOnAllHosts(DiscoverTopology.findNonConfigNodes(db.getMongo()),
                        "internalDocumentSourceSetWindowFieldsMaxMemoryBytes",
@@ -5942,6 +5942,39 @@ var authCommandsLib = {
               FixtureHelpers.runCommandOnEachPrimary({db: db.getSiblingDB("admin"), cmdObj: cmd});
           }
         },
+        {
+          testname: "startCPUProfiler",
+          command: {startCPUProfiler: 1},
+          testcases: [
+              {runOnDb: adminDbName, roles: roles_hostManager},
+          ],
+          teardown: (db, response) => {
+              if (response.ok) {
+                  assert.commandWorked(db.runCommand({stopCPUProfiler: 1}));
+              }
+          }
+        },
+        {
+          testname: "stopCPUProfiler",
+          command: {stopCPUProfiler: 1},
+          testcases: [
+              {runOnDb: adminDbName, roles: roles_hostManager},
+          ],
+          setup: function(db) {
+              db.runCommand({stopCPUProfiler: 1});
+              assert.commandWorked(db.runCommand({startCPUProfiler: 1}));
+          },
+          teardown: function(db) {
+              db.runCommand({stopCPUProfiler: 1});
+          },
+        },
+        {
+          testname: "getCPUProfile",
+          command: {getCPUProfile: 1},
+          testcases: [
+              {runOnDb: adminDbName, roles: roles_hostManager},
+          ]
+        },
         {
           testname: "startRecordingTraffic",
           command: {startRecordingTraffic: 1, filename: "notARealPath"},
@@ -6108,6 +6141,52 @@ var authCommandsLib = {
               },
           ]
         },
+        {
+          testname: "aggregate_operation_latency_histograms",
+          command: {
+              aggregate: 1,
+              pipeline: [{$operationLatencyHistograms: {}}],
+              cursor: {}
+          },
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: Object.extend({backup: 1}, roles_monitoring),
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: Object.extend({backup: 1}, roles_monitoring),
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
+        {
+          testname: "aggregate_query_stats",
+          command: {aggregate: 1, pipeline: [{$queryStats: {}}], cursor: {}},
+          testcases: [
+              {
+                runOnDb: adminDbName,
+                roles: Object.extend({backup: 1}, roles_monitoring),
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+              },
+              {
+                runOnDb: firstDbName,
+                roles: Object.extend({backup: 1}, roles_monitoring),
+                privileges: [
+                    {resource: {cluster: true}, actions: ["serverStatus"]},
+                ],
+                expectFail: true,
+              },
+            ]
+        },
         {
           testname: "aggregate_operation_metrics",
           command: {
@@ -0,0 +1,39 @@
+/**
+ * Tests that the users evicted from the user cache by an invalidation are looked up again in the
+ * background when 'authorizationManagerRefreshUsersAfterInvalidation' is set, and only then.
+ */
+(function() {
+'use strict';
+
+const mongod = MongoRunner.runMongod({auth: ""});
+const admin = mongod.getDB("admin");
+admin.createUser({user: "root", pwd: "root", roles: ["root"]});
+assert(admin.auth("root", "root"));
+admin.createUser({user: "reader", pwd: "reader", roles: ["readAnyDatabase"]});
+
+const isCached = function(username) {
+    return admin.aggregate([{$listCachedAndActiveUsers: {}}])
+        .toArray()
+        .some(doc => doc.username == username);
+};
+
+// Leave "reader" in the cache, without any session using it.
+const conn = new Mongo(mongod.host);
+assert(conn.getDB("admin").auth("reader", "reader"));
+conn.getDB("admin").logout();
+assert.soon(() => isCached("reader"));
+
+assert.commandWorked(admin.runCommand({invalidateUserCache: 1}));
+assert.soon(() => isCached("reader"));
+
+assert.commandWorked(admin.adminCommand(
+    {setParameter: 1, authorizationManagerRefreshUsersAfterInvalidation: false}));
+assert.commandWorked(admin.runCommand({invalidateUserCache: 1}));
+assert(!isCached("reader"));
+
+// The next authentication looks the user up on demand.
+assert(conn.getDB("admin").auth("reader", "reader"));
+assert.soon(() => isCached("reader"));
+
+MongoRunner.stopMongod(mongod);
+})();
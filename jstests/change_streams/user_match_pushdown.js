@@ -0,0 +1,74 @@
+// Tests that a $match following $changeStream returns the same events once the predicates which
+// can be rewritten into oplog predicates are applied to the oplog scan.
+(function() {
+"use strict";
+
+load("jstests/libs/collection_drop_recreate.js");  // For assertDropAndRecreateCollection.
+
+const coll = assertDropAndRecreateCollection(db, "user_match_pushdown");
+const sentinelId = "sentinel";
+
+// Each stream also matches a final sentinel insert, so that we know when to stop reading.
+const filters = [
+    {operationType: "insert"},
+    {operationType: {$in: ["update", "delete"]}},
+    {"documentKey._id": 1},
+    {"fullDocument.x": {$gt: 2}},
+    {"ns.coll": coll.getName(), operationType: "replace"},
+    {operationType: "insert", "fullDocument.x": {$exists: true}, "fullDocument._id": {$lt: 3}},
+    {$or: [{"fullDocument.x": 1}, {operationType: "delete"}]},
+    {operationType: {$ne: "insert"}},
+    {"updateDescription.updatedFields.y": 1},
+];
+const streams = filters.map(
+    (filter) => coll.watch([{$match: {$or: [filter, {"documentKey._id": sentinelId}]}}]));
+
+assert.commandWorked(coll.insert({_id: 1, x: 1}));
+assert.commandWorked(coll.insert({_id: 2, x: 5}));
+assert.commandWorked(coll.update({_id: 1}, {$set: {y: 1}}));
+assert.commandWorked(coll.update({_id: 2}, {_id: 2, x: 6}));
+assert.commandWorked(coll.remove({_id: 1}));
+assert.commandWorked(coll.insert({_id: sentinelId}));
+
+const readEvents = (stream) => {
+    const events = [];
+    assert.soon(() => {
+        while (stream.hasNext()) {
+            const event = stream.next();
+            if (event.documentKey._id === sentinelId) {
+                return true;
+            }
+            events.push(event.operationType + ":" + event.documentKey._id);
+        }
+        return false;
+    });
+    stream.close();
+    return events;
+};
+
+const expected = [
+    ["insert:1", "insert:2"],
+    ["update:1", "delete:1"],
+    ["insert:1", "update:1", "delete:1"],
+    ["insert:2", "replace:2"],
+    ["replace:2"],
+    ["insert:1", "insert:2"],
+    ["insert:1", "delete:1"],
+    ["update:1", "replace:2", "delete:1"],
+    ["update:1"],
+];
+streams.forEach((stream, i) => assert.eq(expected[i], readEvents(stream), tojson(filters[i])));
+
+// Resuming from an event which the new pipeline filters out still finds the resume point.
+const fullStream = coll.watch();
+assert.commandWorked(coll.insert({_id: 3}));
+assert.commandWorked(coll.insert({_id: 4}));
+assert.soon(() => fullStream.hasNext());
+const resumeToken = fullStream.next()._id;
+fullStream.close();
+
+const resumedStream = coll.watch([{$match: {"documentKey._id": 4}}], {resumeAfter: resumeToken});
+assert.soon(() => resumedStream.hasNext());
+assert.eq(4, resumedStream.next().documentKey._id);
+resumedStream.close();
+}());
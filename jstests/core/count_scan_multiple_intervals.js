@@ -0,0 +1,51 @@
+/**
+ * Tests that a count whose index bounds are a union of several intervals is answered by one
+ * COUNT_SCAN per interval, unless a document could have keys in more than one of them.
+ *
+ * @tags: [
+ *     assumes_unsharded_collection,
+ *     requires_fcv_49,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStages().
+
+const coll = db.count_scan_multiple_intervals;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 60; ++i) {
+    docs.push({_id: i, a: i % 6, b: i % 5, c: [i % 3, i % 3 + 10]});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+
+function assertCount(filter, expectedCountScans) {
+    const expected = coll.find(filter).itcount();
+    assert.eq(coll.count(filter), expected, filter);
+    assert.eq(coll.aggregate([{$match: filter}, {$count: "n"}]).next().n, expected, filter);
+
+    const explain = coll.explain().count(filter);
+    const countScans = getPlanStages(explain.queryPlanner.winningPlan, "COUNT_SCAN");
+    assert.eq(countScans.length, expectedCountScans, explain);
+    if (expectedCountScans == 0) {
+        assert.eq(getPlanStages(explain.queryPlanner.winningPlan, "IXSCAN").length, 1, explain);
+    }
+}
+
+assertCount({a: {$in: [1, 3, 4]}}, 3);
+assertCount({a: {$in: [1, 3]}, b: {$in: [0, 2]}}, 4);
+assertCount({a: {$in: [1, 3]}, b: {$gte: 2}}, 2);
+
+// A range on 'a' followed by intervals on 'b' is not a union of single intervals.
+assertCount({a: {$gt: 2}, b: {$in: [0, 2]}}, 0);
+
+// Multikey 'c' may hold keys of the same document in several intervals, which would be counted
+// twice, but intervals on 'a' alone are still counted separately.
+assert.commandWorked(coll.dropIndexes());
+assert.commandWorked(coll.createIndex({a: 1, c: 1}));
+assertCount({a: {$in: [1, 3]}, c: {$gte: 10}}, 2);
+assertCount({a: 1, c: {$in: [1, 11]}}, 0);
+}());
@@ -226,16 +226,16 @@ validateFindCmdOutputAndPlan({
     expectedOutput: [{_id: 2}, {_id: 5}],
     expectedStages: {"IXSCAN": 1, "FETCH": 0, "PROJECTION_COVERED": 1},
 });
-// Note that we can't use a COUNT_SCAN here because we have a complex interval.
+// Each of the six combinations of an 'a' point and a 'b' null interval is counted by a COUNT_SCAN.
 validateSimpleCountCmdOutputAndPlan({
     filter: {a: {$in: [1, 2, 3]}, b: null},
     expectedCount: 2,
-    expectedStages: {"IXSCAN": 1, "FETCH": 0},
+    expectedStages: {"OR": 1, "COUNT_SCAN": 6, "IXSCAN": 0, "FETCH": 0},
 });
 validateCountAggCmdOutputAndPlan({
     filter: {a: {$in: [1, 2, 3]}, b: null},
     expectedCount: 2,
-    expectedStages: {"IXSCAN": 1, "FETCH": 0},
+    expectedStages: {"OR": 1, "COUNT_SCAN": 6, "IXSCAN": 0, "FETCH": 0},
 });
 
 validateFindCmdOutputAndPlan({
@@ -276,16 +276,16 @@ validateFindCmdOutputAndPlan({
     expectedOutput: [{_id: 2}, {_id: 5}],
     expectedStages: {"IXSCAN": 1, "FETCH": 1, "PROJECTION_SIMPLE": 1},
 });
-// Note that we can't use a COUNT_SCAN here because we have a complex interval.
+// Each of the six combinations of an 'a' point and a 'b' null interval is counted by a COUNT_SCAN.
 validateSimpleCountCmdOutputAndPlan({
     filter: {a: {$in: [1, 2, 3]}, b: null},
     expectedCount: 2,
-    expectedStages: {"IXSCAN": 1, "FETCH": 0},
+    expectedStages: {"OR": 1, "COUNT_SCAN": 6, "IXSCAN": 0, "FETCH": 0},
 });
 validateCountAggCmdOutputAndPlan({
     filter: {a: {$in: [1, 2, 3]}, b: null},
     expectedCount: 2,
-    expectedStages: {"IXSCAN": 1, "FETCH": 0},
+    expectedStages: {"OR": 1, "COUNT_SCAN": 6, "IXSCAN": 0, "FETCH": 0},
 });
 
 // Test index intersection plan.
@@ -43,6 +43,25 @@ explainRes = coll.explain("queryPlanner")
 winningPlan = getWinningPlan(explainRes.queryPlanner);
 assert(!planHasStage(db, winningPlan, "FETCH"));
 
+// Verify that an inexact predicate over a non-multikey field of a multikey index can be applied to
+// the index keys, so the query remains covered.
+assert(coll.drop());
+assert.commandWorked(coll.insert({a: "foo", b: [1, 2, 3]}));
+assert.commandWorked(coll.insert({a: "bar", b: [1, 4]}));
+assert.commandWorked(coll.createIndex({a: 1, b: 1}));
+assert.eq([{a: "foo"}], coll.find({a: /^f|o$/, b: 1}, {_id: 0, a: 1}).toArray());
+assert.eq(2, coll.find({a: /o|r/}, {_id: 0, a: 1}).itcount());
+explainRes = coll.explain("queryPlanner").find({a: /^f|o$/, b: 1}, {_id: 0, a: 1}).finish();
+winningPlan = getWinningPlan(explainRes.queryPlanner);
+assert(isIxscan(db, winningPlan));
+assert(!planHasStage(db, winningPlan, "FETCH"));
+
+// An inexact predicate over the multikey field still needs the fetched document.
+assert.eq(0, coll.find({a: "bar", b: /4/}, {_id: 0, a: 1}).itcount());
+explainRes = coll.explain("queryPlanner").find({a: "bar", b: /4/}, {_id: 0, a: 1}).finish();
+winningPlan = getWinningPlan(explainRes.queryPlanner);
+assert(planHasStage(db, winningPlan, "FETCH"));
+
 // Verify that a query cannot be covered over a path which is multikey due to an empty array.
 assert(coll.drop());
 assert.commandWorked(coll.insert({a: []}));
@@ -0,0 +1,109 @@
+// Tests that a $text query sorted by text score with a limit returns the same documents as the
+// unlimited query, and that the TEXT_OR stage stops reading postings once it has found them.
+// @tags: [
+//   assumes_unsharded_collection,
+//   assumes_read_concern_local,
+// ]
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage.
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
+
+const coll = db.fts_score_sort_limit;
+coll.drop();
+
+const words = ["apple", "banana", "cherry", "damson", "elder"];
+let docs = [];
+for (let i = 0; i < 200; ++i) {
+    // Vary the number of times each word appears so that the documents score differently.
+    let text = [];
+    for (let j = 0; j < words.length; ++j) {
+        for (let k = 0; k < (i * (j + 3)) % 7; ++k) {
+            text.push(words[j]);
+        }
+    }
+    text.push("filler" + i);
+    docs.push({_id: i, a: text.join(" "), b: i % 2});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: "text"}));
+
+function findWithScore(search, filter) {
+    return coll.find(Object.assign({$text: {$search: search}}, filter),
+                     {score: {$meta: "textScore"}});
+}
+
+function topScores(search, limit, filter) {
+    return findWithScore(search, filter)
+        .sort({score: {$meta: "textScore"}})
+        .limit(limit)
+        .toArray()
+        .map((doc) => doc.score);
+}
+
+function allScores(search, limit, filter) {
+    return findWithScore(search, filter)
+        .toArray()
+        .map((doc) => doc.score)
+        .sort((x, y) => y - x)
+        .slice(0, limit);
+}
+
+// The scores of the top-k documents must match those computed by scoring every document, for
+// single and multiple term queries, with and without a filter, and with negated terms and phrases
+// which prevent the limit from being pushed down.
+for (let search of ["apple", "apple banana", "cherry damson elder", "apple -banana", "\"apple\""]) {
+    for (let limit of [1, 3, 10, 500]) {
+        assert.eq(topScores(search, limit, {}), allScores(search, limit, {}), {search, limit});
+        assert.eq(topScores(search, limit, {b: 1}), allScores(search, limit, {b: 1}), {
+            search,
+            limit
+        });
+    }
+}
+
+// A skip is applied after the top-k documents are found.
+assert.eq(coll.find({$text: {$search: "apple banana"}}, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .skip(2)
+              .limit(3)
+              .toArray()
+              .map((doc) => doc.score),
+          allScores("apple banana", 5, {}).slice(2));
+
+if (checkSBEEnabled(db)) {
+    jsTestLog("Skipping TEXT_OR explain checks as the SBE engine does not use the TEXT_OR stage");
+    return;
+}
+
+// With a single term and a limit of one, the first posting read is the best scoring document.
+let explain = coll.find({$text: {$search: "apple"}}, {score: {$meta: "textScore"}})
+                  .sort({score: {$meta: "textScore"}})
+                  .limit(1)
+                  .explain("executionStats");
+let textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert.eq(1, textOr.limitAmount, textOr);
+assert.eq(true, textOr.earlyTermination, textOr);
+assert.eq(1, textOr.docsExamined, textOr);
+assert.eq(1, explain.executionStats.totalKeysExamined, explain);
+
+// Without a limit, every posting is read.
+explain = coll.find({$text: {$search: "apple"}}, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .explain("executionStats");
+textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert(!textOr.hasOwnProperty("limitAmount"), textOr);
+assert.gt(explain.executionStats.totalKeysExamined, 1, explain);
+
+// A negated term may reject documents after the TEXT_OR stage, so the limit is not pushed down.
+explain = coll.find({$text: {$search: "apple -banana"}}, {score: {$meta: "textScore"}})
+              .sort({score: {$meta: "textScore"}})
+              .limit(1)
+              .explain("executionStats");
+textOr = getPlanStage(explain.executionStats.executionStages, "TEXT_OR");
+assert.neq(null, textOr, explain);
+assert(!textOr.hasOwnProperty("limitAmount"), textOr);
+})();
@@ -0,0 +1,99 @@
+// Tests that a $near query on a 2dsphere index returns the nearest documents in distance order when
+// the data around the query point is sparse, so that the search has to reach well beyond the cells
+// next to the query point, and when non-point geometries are indexed by coarse cells.
+// @tags: [
+//   assumes_unsharded_collection,
+// ]
+(function() {
+"use strict";
+
+const coll = db.geo_near_best_first;
+coll.drop();
+
+const kRadiusOfEarthInMeters = 6378.1 * 1000;
+
+function toRadians(degrees) {
+    return degrees * Math.PI / 180;
+}
+
+// The great circle distance in meters between two [longitude, latitude] pairs.
+function distance(a, b) {
+    const lat1 = toRadians(a[1]);
+    const lat2 = toRadians(b[1]);
+    const dLat = lat2 - lat1;
+    const dLng = toRadians(b[0] - a[0]);
+    const h = Math.pow(Math.sin(dLat / 2), 2) +
+        Math.cos(lat1) * Math.cos(lat2) * Math.pow(Math.sin(dLng / 2), 2);
+    return 2 * kRadiusOfEarthInMeters * Math.asin(Math.sqrt(h));
+}
+
+Random.setRandomSeed();
+
+// A dense cluster of points far from the query point, and a few points scattered around it.
+let docs = [];
+for (let i = 0; i < 500; ++i) {
+    docs.push({_id: i, loc: [100 + Random.rand() * 0.01, 10 + Random.rand() * 0.01]});
+}
+for (let i = 500; i < 530; ++i) {
+    docs.push({_id: i, loc: [-20 + Random.rand() * 40, -20 + Random.rand() * 40]});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({loc: "2dsphere"}));
+
+const origin = [0.5, 0.5];
+const expected = docs.map((doc) => ({_id: doc._id, dist: distance(origin, doc.loc)}))
+                     .sort((a, b) => a.dist - b.dist);
+
+function nearest(limit, minDistance, maxDistance) {
+    let near = {$geometry: {type: "Point", coordinates: origin}};
+    if (minDistance !== undefined) {
+        near.$minDistance = minDistance;
+    }
+    if (maxDistance !== undefined) {
+        near.$maxDistance = maxDistance;
+    }
+    return coll.find({loc: {$near: near}}).limit(limit).toArray().map((doc) => doc._id);
+}
+
+for (let limit of [1, 10, 30, 100, 600]) {
+    assert.eq(nearest(limit), expected.slice(0, limit).map((doc) => doc._id), {limit});
+}
+
+// The distance bounds are honored at the edges of the search.
+const minDistance = expected[5].dist;
+const maxDistance = expected[20].dist;
+assert.eq(nearest(100, minDistance - 1, maxDistance + 1),
+          expected.slice(5, 21).map((doc) => doc._id));
+
+// The distances reported by $geoNear agree with the great circle distances.
+const results =
+    coll.aggregate([
+            {$geoNear: {near: {type: "Point", coordinates: origin}, distanceField: "dist"}},
+            {$limit: 10}
+        ])
+        .toArray();
+assert.eq(results.length, 10);
+for (let i = 0; i < results.length; ++i) {
+    assert.eq(results[i]._id, expected[i]._id);
+    assert.lt(Math.abs(results[i].dist - expected[i].dist), 1e-6 * expected[i].dist, results[i]);
+}
+
+// Every document within a distance is found, as checked by a $geoWithin query.
+const radius = expected[25].dist + 1;
+assert.eq(nearest(docs.length, undefined, radius).length,
+          coll.find({loc: {$geoWithin: {$centerSphere: [origin, radius / kRadiusOfEarthInMeters]}}})
+              .itcount());
+
+// A large polygon is indexed by coarse cells, which must be found even though the search
+// subdivides them on the way down to the query point.
+assert.commandWorked(coll.insert({
+    _id: "polygon",
+    loc: {type: "Polygon", coordinates: [[[1, 1], [60, 1], [60, 60], [1, 60], [1, 1]]]}
+}));
+const polygonDistance = distance(origin, [1, 1]);
+const ids = nearest(docs.length + 1);
+assert.eq(ids.length, docs.length + 1);
+assert.eq(ids.indexOf("polygon"),
+          expected.filter((doc) => doc.dist < polygonDistance).length,
+          {ids, polygonDistance});
+})();
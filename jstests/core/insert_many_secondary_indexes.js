@@ -0,0 +1,42 @@
+/**
+ * Tests that inserting a batch of documents into a collection with several secondary indexes
+ * indexes every document, and marks an index multikey only when a document in the batch has an
+ * array on its path.
+ *
+ * @tags: [assumes_unsharded_collection]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+
+const coll = db.insert_many_secondary_indexes;
+coll.drop();
+
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}, {c: 1, d: 1}, {"e.f": 1}, {g: "hashed"}]));
+
+const docs = [];
+for (let i = 0; i < 500; i++) {
+    docs.push({_id: i, a: i % 7, b: (i % 50 === 0) ? [i, i + 1] : i, c: i, d: -i, e: {f: i}, g: i});
+}
+assert.commandWorked(coll.insertMany(docs, {ordered: false}));
+
+const checkCount = (hint, filter, expected) =>
+    assert.eq(expected, coll.find(filter).hint(hint).itcount(), tojson(hint));
+checkCount({a: 1}, {a: 3}, docs.filter(doc => doc.a === 3).length);
+checkCount({b: 1}, {b: 101}, 2);
+checkCount({c: 1, d: 1}, {c: {$gte: 250}}, 250);
+checkCount({"e.f": 1}, {"e.f": {$lt: 10}}, 10);
+checkCount({g: "hashed"}, {g: 42}, 1);
+
+const isMultikey = (keyPattern) => {
+    const explain = coll.find().hint(keyPattern).explain();
+    return getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN").isMultiKey;
+};
+assert(isMultikey({b: 1}));
+assert(!isMultikey({a: 1}));
+assert(!isMultikey({c: 1, d: 1}));
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+})();
@@ -0,0 +1,50 @@
+/**
+ * Tests that $sample with a 'blockSize' samples runs of consecutive documents with the random
+ * cursor, without returning duplicates.
+ *
+ * @tags: [assumes_unsharded_collection, requires_fcv_50, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStages.
+
+// Although this test is tagged with 'requires_wiredtiger', this is not sufficient for ensuring
+// that the parallel suite runs this test only on WT configurations.
+if (jsTest.options().storageEngine && jsTest.options().storageEngine !== "wiredTiger") {
+    jsTest.log("Skipping test on non-WT storage engine: " + jsTest.options().storageEngine);
+    return;
+}
+
+const coll = db.sample_block_size;
+coll.drop();
+
+let docs = [];
+for (let i = 0; i < 2000; ++i) {
+    docs.push({_id: i});
+}
+assert.commandWorked(coll.insert(docs));
+
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$sample: {size: 1, blockSize: 0}}]}),
+    5963051);
+assert.commandFailedWithCode(
+    db.runCommand({aggregate: coll.getName(), pipeline: [{$sample: {size: 1, blockSize: "a"}}]}),
+    5963050);
+
+const pipeline = [{$sample: {size: 50, blockSize: 10}}];
+const explain = coll.explain().aggregate(pipeline);
+const sampleStages = getAggPlanStages(explain, "$sampleFromRandomCursor");
+assert.eq(sampleStages.length, 1, explain);
+assert.eq(sampleStages[0].$sampleFromRandomCursor, {size: 50, blockSize: 10}, explain);
+
+for (let i = 0; i < 5; ++i) {
+    const ids = coll.aggregate(pipeline).toArray().map(doc => doc._id);
+    assert.eq(ids.length, 50, ids);
+    assert.eq(new Set(ids).size, ids.length, ids);
+
+    // Most documents are followed by the next one of the collection, in the block they came in.
+    const numConsecutive = ids.filter((id, j) => j > 0 && id == ids[j - 1] + 1).length;
+    assert.gte(numConsecutive, 25, ids);
+}
+})();
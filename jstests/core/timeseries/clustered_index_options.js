@@ -66,9 +66,15 @@ assert.commandFailedWithCode(
                             {clusteredIndex: {}, idIndex: {key: {_id: 1}, name: '_id_'}}),
     ErrorCodes.InvalidOptions);
 
-// Using the 'clusteredIndex' option on any namespace other than a buckets namespace should fail.
-assert.commandFailedWithCode(testDB.createCollection(tsCollName, {clusteredIndex: {}}),
-                             ErrorCodes.InvalidOptions);
-assert.commandFailedWithCode(testDB.createCollection('test', {clusteredIndex: {}}),
-                             ErrorCodes.InvalidOptions);
+// Using the 'clusteredIndex' option on any namespace other than a buckets namespace should fail,
+// unless collections other than buckets collections may be clustered.
+const clusteredIndexesEnabled =
+    assert.commandWorked(testDB.adminCommand({getParameter: 1, featureFlagClusteredIndexes: 1}))
+        .featureFlagClusteredIndexes.value;
+if (!clusteredIndexesEnabled) {
+    assert.commandFailedWithCode(testDB.createCollection(tsCollName, {clusteredIndex: {}}),
+                                 ErrorCodes.InvalidOptions);
+    assert.commandFailedWithCode(testDB.createCollection('test', {clusteredIndex: {}}),
+                                 ErrorCodes.InvalidOptions);
+}
 })();
\ No newline at end of file
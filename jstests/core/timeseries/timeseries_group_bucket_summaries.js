@@ -0,0 +1,74 @@
+/**
+ * Tests that a $group on a time-series collection, which counts the buckets lying entirely within
+ * one group from their control fields rather than unpacking them, gives the same results as on a
+ * regular collection.
+ *
+ * @tags: [
+ *     assumes_unsharded_collection,
+ *     does_not_support_transactions,
+ *     requires_fcv_49,
+ *     requires_timeseries,
+ * ]
+ */
+(function() {
+"use strict";
+
+const testDB = db.getSiblingDB(jsTestName());
+assert.commandWorked(testDB.dropDatabase());
+
+const coll = testDB.getCollection("regular");
+const tsColl = testDB.getCollection("ts");
+assert.commandWorked(testDB.createCollection(coll.getName()));
+assert.commandWorked(
+    testDB.createCollection(tsColl.getName(), {timeseries: {timeField: "time", metaField: "meta"}}));
+
+// Measurements every ten seconds for most of an hour, some of which lack a field or have a string
+// in it, so that both summarized and unpacked buckets are grouped.
+const start = ISODate("2021-06-01T00:00:00Z");
+const minutes = (n) => new Date(start.getTime() + n * 60 * 1000);
+let docs = [];
+for (let i = 0; i < 300; ++i) {
+    for (let meta of ["x", "y", "z"]) {
+        let doc = {_id: docs.length, time: new Date(start.getTime() + i * 10 * 1000), meta: meta};
+        doc.a = (i * 7) % 100;
+        if (i % 3 != 0) {
+            doc.b = i;
+        }
+        doc.c = meta == "z" && i > 200 ? "s" + i : i * 0.5;
+        docs.push(doc);
+    }
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(tsColl.insert(docs));
+
+const pipelines = [
+    [{$count: "n"}],
+    [
+        {$group: {_id: "$meta", n: {$sum: 1}, lo: {$min: "$a"}, hi: {$max: "$b"}}},
+        {$sort: {_id: 1}}
+    ],
+    [
+        {$match: {time: {$gte: minutes(5), $lt: minutes(40)}}},
+        {$group: {_id: "$meta", n: {$sum: 1}, lo: {$min: "$c"}, hi: {$max: "$c"}}},
+        {$sort: {_id: 1}}
+    ],
+    [
+        {$match: {time: {$gt: minutes(10)}}},
+        {
+            $group: {
+                _id: {m: "$meta", t: {$dateTrunc: {date: "$time", unit: "minute", binSize: 15}}},
+                n: {$sum: 1},
+                lo: {$min: "$b"}
+            }
+        },
+        {$sort: {_id: 1}}
+    ],
+    [{$group: {_id: null, n: {$sum: 1}, missing: {$max: "$d"}}}],
+];
+for (let pipeline of pipelines) {
+    const expected = coll.aggregate(pipeline).toArray();
+    assert.neq(expected.length, 0, tojson(pipeline));
+    assert.eq(tsColl.aggregate(pipeline).toArray(), expected, tojson(pipeline));
+}
+assert.eq(tsColl.count(), docs.length);
+})();
@@ -145,6 +145,7 @@ let viewsCommandTests = {
     addShard: {skip: isUnrelated},
     addShardToZone: {skip: isUnrelated},
     aggregate: {command: {aggregate: "view", pipeline: [{$match: {}}], cursor: {}}},
+    analyze: {command: {analyze: "view", key: "a"}, expectFailure: true},
     appendOplogNote: {skip: isUnrelated},
     applyOps: {
         command: {applyOps: [{op: "i", o: {_id: 1}, ns: "test.view"}]},
@@ -294,6 +295,7 @@ let viewsCommandTests = {
     fsyncUnlock: {skip: isUnrelated},
     getAuditConfig: {skip: isUnrelated},
     getDatabaseVersion: {skip: isUnrelated},
+    getCPUProfile: {skip: isUnrelated},
     getCmdLineOpts: {skip: isUnrelated},
     getDefaultRWConcern: {skip: isUnrelated},
     getDiagnosticData: {skip: isUnrelated},
@@ -565,8 +567,10 @@ let viewsCommandTests = {
         expectFailure: true,
     },
     stageDebug: {skip: isAnInternalCommand},
+    startCPUProfiler: {skip: isUnrelated},
     startRecordingTraffic: {skip: isUnrelated},
     startSession: {skip: isAnInternalCommand},
+    stopCPUProfiler: {skip: isUnrelated},
     stopRecordingTraffic: {skip: isUnrelated},
     testDeprecation: {skip: isAnInternalCommand},
     testDeprecationInVersion2: {skip: isAnInternalCommand},
@@ -575,6 +579,11 @@ let viewsCommandTests = {
     testVersion2: {skip: isAnInternalCommand},
     testVersions1And2: {skip: isAnInternalCommand},
     top: {skip: "tested in views/views_stats.js"},
+    trainCompressionDictionary: {
+        command: {trainCompressionDictionary: "view"},
+        expectFailure: true,
+        skipSharded: true
+    },
     update: {command: {update: "view", updates: [{q: {x: 1}, u: {x: 2}}]}, expectFailure: true},
     updateRole: {
         command: {
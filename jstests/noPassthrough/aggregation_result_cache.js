@@ -0,0 +1,69 @@
+/**
+ * Tests that identical aggregations are answered from the aggregation result cache when it is
+ * enabled with 'internalQueryAggregationResultCacheMaxBytes', that inserts keep a cached $group
+ * result up to date, and that other writes keep later aggregations from seeing the results
+ * computed before them.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {internalQueryAggregationResultCacheMaxBytes: 10 * 1024 * 1024}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.aggregation_result_cache;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({a: i % 10, b: i});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [{$match: {b: {$gte: 100}}}, {$group: {_id: "$a", total: {$sum: "$b"}}}];
+const sortById = (docs) => docs.sort((x, y) => x._id - y._id);
+const cacheStats = () => db.serverStatus().metrics.query.aggregationResultCache;
+
+const expected = sortById(coll.aggregate(pipeline).toArray());
+assert.eq(10, expected.length);
+
+let hits = cacheStats().hits;
+assert.eq(expected, sortById(coll.aggregate(pipeline).toArray()));
+assert.eq(hits + 1, cacheStats().hits);
+
+// An insert keeps the cached $match/$group result up to date.
+assert.commandWorked(coll.insert([{a: 0, b: 5000}, {a: 10, b: 7}, {a: 3, b: 1}]));
+let afterInsert = sortById(coll.aggregate(pipeline).toArray());
+assert.eq(hits + 2, cacheStats().hits);
+assert.eq(11, afterInsert.length);
+assert.eq(expected[0].total + 5000, afterInsert[0].total);
+assert.eq(expected[3].total, afterInsert[3].total);
+assert.eq({_id: 10, total: 7}, afterInsert[10]);
+
+// Any other write invalidates it.
+assert.commandWorked(coll.remove({a: 10}));
+afterInsert = sortById(coll.aggregate(pipeline).toArray());
+assert.eq(hits + 2, cacheStats().hits);
+assert.eq(10, afterInsert.length);
+assert.eq(afterInsert, sortById(coll.aggregate(pipeline).toArray()));
+assert.eq(hits + 3, cacheStats().hits);
+
+// Results that depend on more than the data are never cached.
+hits = cacheStats().hits;
+const randomPipeline = [{$group: {_id: null, r: {$sum: {$rand: {}}}}}];
+coll.aggregate(randomPipeline).toArray();
+coll.aggregate(randomPipeline).toArray();
+assert.eq(hits, cacheStats().hits);
+
+// A batch size which the result does not fit in gets a cursor as usual.
+const cursor = coll.aggregate(pipeline, {cursor: {batchSize: 2}});
+assert.eq(afterInsert, sortById(cursor.toArray()));
+
+// Disabling the cache stops using it.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryAggregationResultCacheMaxBytes: 0}));
+hits = cacheStats().hits;
+assert.eq(afterInsert, sortById(coll.aggregate(pipeline).toArray()));
+assert.eq(hits, cacheStats().hits);
+
+MongoRunner.stopMongod(conn);
+})();
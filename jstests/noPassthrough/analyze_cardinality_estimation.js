@@ -0,0 +1,71 @@
+/**
+ * Tests that the 'analyze' command builds a histogram of a field, and that the query planner uses
+ * the histograms to skip the trial runs of the candidate plans which examine far more keys than
+ * the cheapest one.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getRejectedPlans().
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.analyze_cardinality_estimation;
+
+// Half of the documents have the same value of 'a'.
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10000; i++) {
+    bulk.insert({a: i % 2 == 0 ? 0 : i, b: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+
+const query = {a: 0, b: {$lt: 100}};
+const numRejectedPlans = () => getRejectedPlans(coll.find(query).explain()).length;
+const numRejectedPlansWithoutEstimates = numRejectedPlans();
+assert.gte(numRejectedPlansWithoutEstimates, 1);
+
+let res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "a"}));
+assert.eq(10000, res.sampled, res);
+assert.eq(10000, res.histogram.totalCount, res);
+assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "b", numBuckets: 50}));
+
+// The index on 'a' examines about 50 times as many keys as the index on 'b', and intersecting the
+// two indexes examines both.
+assert.eq(0, numRejectedPlans());
+assert.eq(50, coll.find(query).itcount());
+
+// With a sort or a limit, the plan which examines more keys may still finish first.
+assert.gte(getRejectedPlans(coll.find(query).sort({a: 1}).explain()).length, 1);
+assert.gte(getRejectedPlans(coll.find(query).limit(5).explain()).length, 1);
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryCardinalityEstimationPruningRatio: 0}));
+assert.eq(numRejectedPlansWithoutEstimates, numRejectedPlans());
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryCardinalityEstimationPruningRatio: 10}));
+
+// A sample smaller than the collection is scaled up to it.
+res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "a", sampleSize: 1000}));
+assert.eq(1000, res.sampled, res);
+assert.eq(10000, res.histogram.totalCount, res);
+
+assert.commandFailedWithCode(db.runCommand({analyze: "missing", key: "a"}),
+                             ErrorCodes.NamespaceNotFound);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: 1}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: "a", sampleSize: 0}),
+                             ErrorCodes.BadValue);
+assert.commandWorked(db.createView("view", coll.getName(), []));
+assert.commandFailedWithCode(db.runCommand({analyze: "view", key: "a"}),
+                             ErrorCodes.CommandNotSupportedOnView);
+
+// The histograms go away with the collection.
+assert(coll.drop());
+assert.commandWorked(coll.insert({a: 0, b: 0}));
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+assert.gte(numRejectedPlans(), 1);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -4,6 +4,7 @@
 
 load("jstests/aggregation/extras/utils.js");  // For assertArrayEq.
 load("jstests/libs/analyze_plan.js");  // For planHasStage helper to analyze explain() output.
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
 
 const conn = MongoRunner.runMongod();
 const db = conn.getDB("test");
@@ -50,6 +51,13 @@ function assertAndHashUsed({query, expectedResult, shouldUseAndHash} = {}) {
 
     assertArrayEq({actual: queryResult.toArray(), expected: expectedResult});
     assert.eq(shouldUseAndHash, planHasStage(db, getWinningPlan(expl.queryPlanner), "AND_HASH"));
+
+    // An intersection of index scans is fetched right away, so it keeps only the RecordIds.
+    const andHash = getPlanStage(getWinningPlan(expl.queryPlanner), "AND_HASH");
+    if (!checkSBEEnabled(db) && andHash &&
+        andHash.inputStages.every((stage) => stage.stage === "IXSCAN")) {
+        assert.eq(true, andHash.recordIdOnly, expl);
+    }
 }
 
 // Test basic index intersection where we expect AND_HASH to be used.
@@ -0,0 +1,66 @@
+/**
+ * Tests that validate with {background: true} traverses several indexes at once when
+ * validateIndexConcurrency is set, and still reports the keys of each index and the index entries
+ * which do not match a document.
+ *
+ * @tags: [
+ *   # Background validation is only supported by WT.
+ *   requires_wiredtiger,
+ *   # inMemory does not have checkpoints; background validation only runs on a checkpoint.
+ *   requires_persistence,
+ *   requires_replication,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+
+const replSet = new ReplSetTest({nodes: 1, nodeOptions: {setParameter: {maxValidateMBperSec: 10}}});
+replSet.startSet();
+replSet.initiate();
+
+const primary = replSet.getPrimary();
+const testDB = primary.getDB("test");
+const testColl = testDB.getCollection(jsTest.name());
+
+assert.commandFailedWithCode(testDB.adminCommand({setParameter: 1, validateIndexConcurrency: 0}),
+                             ErrorCodes.BadValue);
+assert.commandWorked(testDB.adminCommand({setParameter: 1, validateIndexConcurrency: 4}));
+
+const indexNames = ["a_1", "b_1", "c_1", "d_1", "e_1"];
+for (let field of ["a", "b", "c", "d", "e"]) {
+    assert.commandWorked(testColl.createIndex({[field]: 1}));
+}
+
+const numDocs = 1000;
+let bulk = testColl.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, a: i, b: i, c: i, d: i, e: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+let res = assert.commandWorked(testColl.validate({background: true}));
+assert(res.valid, tojson(res));
+for (let indexName of indexNames) {
+    assert.eq(res.keysPerIndex[indexName], numDocs, tojson(res));
+}
+
+// Leave index entries behind in one index for deleted documents.
+const fp = configureFailPoint(primary, "skipUnindexingDocumentWhenDeleted", {indexName: "c_1"});
+assert.commandWorked(testColl.deleteMany({_id: {$lt: 10}}));
+fp.off();
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+res = assert.commandWorked(testColl.validate({background: true}));
+assert(!res.valid, tojson(res));
+assert.eq(res.extraIndexEntries.length, 10, tojson(res));
+assert.eq(res.keysPerIndex["c_1"], numDocs, tojson(res));
+assert.eq(res.keysPerIndex["a_1"], numDocs - 10, tojson(res));
+assert(!res.indexDetails["c_1"].valid, tojson(res));
+
+// Drop the inconsistent index so that the validation at shutdown passes.
+assert.commandWorked(testColl.dropIndex("c_1"));
+replSet.stopSet();
+})();
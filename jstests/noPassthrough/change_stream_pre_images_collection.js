@@ -0,0 +1,61 @@
+/**
+ * Tests that with 'recordPreImagesInPreImagesCollection' enabled, the pre-images of updates and
+ * deletes are recorded in config.system.preimages on every node instead of in the oplog, and that
+ * change streams with 'fullDocumentBeforeChange' still return them.
+ *
+ * @tags: [uses_change_streams, requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest(
+    {nodes: 2, nodeOptions: {setParameter: {recordPreImagesInPreImagesCollection: true}}});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const testDB = primary.getDB(jsTestName());
+const coll = testDB.coll;
+assert.commandWorked(testDB.createCollection(coll.getName(), {recordPreImages: true}));
+const collUUID = testDB.getCollectionInfos({name: coll.getName()})[0].info.uuid;
+
+const csCursor = coll.watch([], {fullDocumentBeforeChange: "required"});
+
+assert.commandWorked(coll.insert({_id: 0, x: 0}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {x: 1}}));
+assert.commandWorked(coll.update({_id: 0}, {x: 2}));
+assert.commandWorked(coll.remove({_id: 0}));
+
+const expectedEvents = [
+    {operationType: "insert", fullDocumentBeforeChange: null},
+    {operationType: "update", fullDocumentBeforeChange: {_id: 0, x: 0}},
+    {operationType: "replace", fullDocumentBeforeChange: {_id: 0, x: 1}},
+    {operationType: "delete", fullDocumentBeforeChange: {_id: 0, x: 2}},
+];
+for (let expected of expectedEvents) {
+    assert.soon(() => csCursor.hasNext());
+    const event = csCursor.next();
+    assert.eq(event.operationType, expected.operationType, tojson(event));
+    if (expected.fullDocumentBeforeChange) {
+        assert.docEq(event.fullDocumentBeforeChange, expected.fullDocumentBeforeChange);
+    }
+}
+csCursor.close();
+
+// The pre-images were not written to the oplog, and the update and delete entries are flagged.
+const oplog = primary.getDB("local").oplog.rs;
+assert.eq(0, oplog.find({op: "n", ui: collUUID}).itcount());
+assert.eq(3, oplog.find({op: {$in: ["u", "d"]}, ui: collUUID, preImageRecorded: true}).itcount());
+
+// Every node records the pre-images in its own pre-images collection.
+rst.awaitReplication();
+for (let node of rst.nodes) {
+    node.setSecondaryOk();
+    const preImages =
+        node.getDB("config").system.preimages.find({"_id.nsUUID": collUUID}).sort({_id: 1});
+    assert.eq(preImages.toArray().map((doc) => doc.preImage),
+              [{_id: 0, x: 0}, {_id: 0, x: 1}, {_id: 0, x: 2}]);
+}
+
+rst.stopSet();
+})();
@@ -0,0 +1,73 @@
+/**
+ * Tests that change streams on the same node share the oplog entries they read through the shared
+ * oplog scan buffer, and that each of them still sees every event exactly once and in order.
+ *
+ * @tags: [
+ *   requires_replication,
+ *   requires_majority_read_concern,
+ * ]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB(jsTestName());
+const coll = db.coll;
+assert.commandWorked(db.createCollection(coll.getName()));
+
+const getSharedScanMetrics = () =>
+    assert.commandWorked(db.adminCommand({serverStatus: 1})).metrics.query.sharedOplogScan;
+
+const numStreams = 10;
+const numDocs = 50;
+const streams = [];
+for (let i = 0; i < numStreams; i++) {
+    // Give each stream its own filter, to check that they are still applied separately.
+    streams.push(coll.watch(i % 2 === 0 ? [] : [{$match: {"fullDocument.even": true}}]));
+}
+
+const metricsBefore = getSharedScanMetrics();
+for (let i = 0; i < numDocs; i++) {
+    assert.commandWorked(coll.insert({_id: i, even: i % 2 === 0}));
+}
+
+streams.forEach((stream, i) => {
+    const expectedIds = [];
+    for (let id = 0; id < numDocs; id++) {
+        if (i % 2 === 0 || id % 2 === 0) {
+            expectedIds.push(id);
+        }
+    }
+    for (let expectedId of expectedIds) {
+        assert.soon(() => stream.hasNext());
+        const event = stream.next();
+        assert.eq("insert", event.operationType, event);
+        assert.eq(expectedId, event.documentKey._id, event);
+    }
+    assert(!stream.hasNext());
+    stream.close();
+});
+
+// The first stream to reach the new entries reads them from the oplog, and the others take them
+// from the buffer.
+const metricsAfter = getSharedScanMetrics();
+assert.gte(metricsAfter.entriesBuffered - metricsBefore.entriesBuffered, numDocs, metricsAfter);
+assert.gt(metricsAfter.entriesRead - metricsBefore.entriesRead, 0, metricsAfter);
+
+// With the buffer disabled, change streams read every entry from the oplog themselves.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQuerySharedOplogScanBufferMaxBytes: 0}));
+const stream = coll.watch();
+const metricsDisabled = getSharedScanMetrics();
+assert.commandWorked(coll.insert({_id: numDocs}));
+assert.soon(() => stream.hasNext());
+assert.eq(numDocs, stream.next().documentKey._id);
+assert.eq(metricsDisabled.entriesBuffered, getSharedScanMetrics().entriesBuffered);
+stream.close();
+
+rst.stopSet();
+})();
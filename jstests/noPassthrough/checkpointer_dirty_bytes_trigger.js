@@ -0,0 +1,44 @@
+/**
+ * Tests that the checkpoint thread takes a checkpoint before the checkpoint delay has passed once
+ * the cache holds checkpointDirtyBytesTrigger dirty bytes, and that serverStatus reports why each
+ * checkpoint was taken.
+ *
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+// A checkpoint delay of an hour means that only the dirty bytes trigger takes checkpoints during
+// the test.
+const conn = MongoRunner.runMongod({syncdelay: 60 * 60});
+const db = conn.getDB("test");
+
+const statsBefore = assert.commandWorked(db.serverStatus()).checkpointer;
+assert(statsBefore.hasOwnProperty("checkpoints"), tojson(statsBefore));
+assert(statsBefore.hasOwnProperty("duration"), tojson(statsBefore));
+assert(statsBefore.hasOwnProperty("dirtyKBAtStart"), tojson(statsBefore));
+
+assert.commandWorked(db.adminCommand({setParameter: 1, checkpointIOBudgetMBPerSec: 1024}));
+assert.commandWorked(db.adminCommand({setParameter: 1, checkpointDirtyBytesTrigger: 1024 * 1024}));
+assert.commandFailedWithCode(db.adminCommand({setParameter: 1, checkpointDirtyBytesTrigger: -1}),
+                             ErrorCodes.BadValue);
+
+const padding = "x".repeat(1024);
+assert.soon(() => {
+    const docs = [];
+    for (let i = 0; i < 1000; i++) {
+        docs.push({padding: padding});
+    }
+    assert.commandWorked(db.coll.insert(docs));
+
+    const stats = assert.commandWorked(db.serverStatus()).checkpointer;
+    return stats.checkpoints.dirtyBytes > statsBefore.checkpoints.dirtyBytes;
+});
+
+const statsAfter = assert.commandWorked(db.serverStatus()).checkpointer;
+assert.eq(statsAfter.checkpoints.scheduled, statsBefore.checkpoints.scheduled, tojson(statsAfter));
+assert.gt(statsAfter.duration.count, statsBefore.duration.count, tojson(statsAfter));
+assert.gt(statsAfter.dirtyKBAtStart.max, 0, tojson(statsAfter));
+
+MongoRunner.stopMongod(conn);
+})();
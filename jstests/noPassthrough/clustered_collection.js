@@ -0,0 +1,63 @@
+/**
+ * Tests that with 'featureFlagClusteredIndexes' enabled an ordinary collection can be clustered by
+ * _id, so that it has no separate _id index and a range predicate on _id becomes a bounded
+ * collection scan.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage().
+
+const conn = MongoRunner.runMongod({setParameter: {featureFlagClusteredIndexes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.clustered_collection;
+
+assert.commandWorked(db.createCollection(coll.getName(), {clusteredIndex: {}}));
+assert.eq([], coll.getIndexes());
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, type: i % 5});
+}
+assert.commandWorked(bulk.execute());
+assert.commandFailedWithCode(coll.insert({_id: 10}), ErrorCodes.DuplicateKey);
+
+// A range on _id reads only the records in the range.
+const query = {_id: {$gte: 100, $lt: 200}};
+const explain = coll.find(query).explain("executionStats");
+const collScan = getPlanStage(explain.queryPlanner.winningPlan, "COLLSCAN");
+assert.neq(null, collScan, explain);
+assert(collScan.hasOwnProperty("minRecord"), explain);
+assert(collScan.hasOwnProperty("maxRecord"), explain);
+assert.eq(100, explain.executionStats.nReturned, explain);
+assert.lte(explain.executionStats.totalDocsExamined, 101, explain);
+assert.eq(0, explain.executionStats.totalKeysExamined, explain);
+assert.eq(100, coll.find(query).itcount());
+
+// Point lookups, updates and deletes by _id.
+assert.eq({_id: 7, type: 2}, coll.findOne({_id: 7}));
+assert.commandWorked(coll.update({_id: 7}, {$set: {type: 10}}));
+assert.eq(1, coll.find({type: 10}).itcount());
+assert.commandWorked(coll.remove({_id: 7}));
+assert.eq(null, coll.findOne({_id: 7}));
+
+// Secondary indexes work as on any other collection.
+assert.commandWorked(coll.createIndex({type: 1}));
+assert.eq(200, coll.find({type: 3}).hint({type: 1}).itcount());
+
+// A query collation which changes how a string _id compares does not bound the scan.
+assert.commandWorked(coll.insert({_id: "abc"}));
+assert.eq(1, coll.find({_id: "ABC"}).collation({locale: "en", strength: 2}).itcount());
+
+assert.commandFailedWithCode(
+    db.createCollection("clustered_capped", {clusteredIndex: {}, capped: true, size: 4096}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    db.createCollection("clustered_collation", {clusteredIndex: {}, collation: {locale: "en"}}),
+    ErrorCodes.InvalidOptions);
+
+MongoRunner.stopMongod(conn);
+})();
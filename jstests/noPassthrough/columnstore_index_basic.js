@@ -0,0 +1,80 @@
+/**
+ * Tests the creation and maintenance of columnstore indexes, and that the query planner does not
+ * choose them. Columnstore indexes can only be created with featureFlagColumnstoreIndexes enabled
+ * and in the latest FCV, and must be dropped before downgrading.
+ *
+ * @tags: [requires_fcv_50]
+ */
+(function() {
+"use strict";
+
+load("jstests/aggregation/extras/utils.js");  // For arrayEq.
+load("jstests/libs/analyze_plan.js");         // For getWinningPlan and planHasStage.
+
+const columnIndex = {
+    "$**": "columnstore"
+};
+
+let conn = MongoRunner.runMongod({setParameter: {featureFlagColumnstoreIndexes: true}});
+assert.neq(null, conn, "mongod was unable to start up");
+let db = conn.getDB("test");
+let coll = db.columnstore_index_basic;
+
+// The key pattern must be exactly {"$**": "columnstore"}, and the options which would leave
+// documents out of the index, or order its values differently, are not allowed.
+for (let [key, options] of [[{a: "columnstore"}, {}],
+                            [{"$**": "columnstore", b: 1}, {}],
+                            [{"a.$**": "columnstore"}, {}],
+                            [columnIndex, {sparse: true}],
+                            [columnIndex, {unique: true}],
+                            [columnIndex, {partialFilterExpression: {a: 1}}],
+                            [columnIndex, {collation: {locale: "fr"}}]]) {
+    assert.commandFailedWithCode(coll.createIndex(key, options),
+                                 ErrorCodes.CannotCreateIndex,
+                                 tojson({key: key, options: options}));
+}
+
+assert.commandWorked(coll.insert([
+    {_id: 0, a: 1, b: {c: "x", d: [1, 2]}},
+    {_id: 1, a: [1, {b: 2}], e: {}},
+    {_id: 2},
+]));
+assert.commandWorked(coll.createIndex(columnIndex));
+assert.commandWorked(coll.insert({_id: 3, a: 2, b: {c: "y"}}));
+assert.commandWorked(coll.update({_id: 0}, {$set: {"b.c": "z"}, $unset: {a: 1}}));
+assert.commandWorked(coll.update({_id: 2}, {$set: {f: 1}}));
+assert.commandWorked(coll.remove({_id: 1}));
+
+const expected = [{_id: 0, b: {c: "z", d: [1, 2]}}, {_id: 2, f: 1}, {_id: 3, a: 2, b: {c: "y"}}];
+assertArrayEq(coll.find().toArray(), expected);
+assertArrayEq(coll.find({"b.c": {$gte: "y"}}, {_id: 1}).toArray(), [{_id: 0}, {_id: 3}]);
+
+// The index holds several cells per document and is never multikey, and the planner does not use
+// it to answer queries.
+const validateRes = assert.commandWorked(coll.validate());
+assert(validateRes.valid, tojson(validateRes));
+const explain = coll.find({a: 2}).explain();
+assert(!planHasStage(db, getWinningPlan(explain.queryPlanner), "IXSCAN"), tojson(explain));
+
+// The FCV cannot be downgraded while a columnstore index exists, and none can be created in the
+// downgraded FCV.
+const adminDB = conn.getDB("admin");
+assert.commandFailedWithCode(adminDB.runCommand({setFeatureCompatibilityVersion: lastLTSFCV}),
+                             ErrorCodes.CannotDowngrade);
+assert.commandWorked(coll.dropIndex(columnIndex));
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: lastLTSFCV}));
+assert.commandFailedWithCode(coll.createIndex(columnIndex), ErrorCodes.CannotCreateIndex);
+assert.commandWorked(adminDB.runCommand({setFeatureCompatibilityVersion: latestFCV}));
+assert.commandWorked(coll.createIndex(columnIndex));
+assertArrayEq(coll.find().toArray(), expected);
+MongoRunner.stopMongod(conn);
+
+// Nor can one be created with the feature flag disabled.
+conn = MongoRunner.runMongod({setParameter: {featureFlagColumnstoreIndexes: false}});
+assert.neq(null, conn, "mongod was unable to start up");
+db = conn.getDB("test");
+coll = db.columnstore_index_basic;
+assert.commandWorked(coll.insert({_id: 0, a: 1}));
+assert.commandFailedWithCode(coll.createIndex(columnIndex), ErrorCodes.CannotCreateIndex);
+MongoRunner.stopMongod(conn);
+})();
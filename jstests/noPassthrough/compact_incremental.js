@@ -0,0 +1,60 @@
+/**
+ * Checks that compact runs in time slices when compactTimeSliceSeconds is set, without holding
+ * locks between the tables it compacts, and that it reports its progress in $currentOp.
+ *
+ * @tags: [requires_wiredtiger, requires_persistence]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/fail_point_util.js");
+load("jstests/libs/parallel_shell_helpers.js");
+
+const conn = MongoRunner.runMongod({setParameter: {compactTimeSliceSeconds: 1}});
+const db = conn.getDB("test");
+const collName = jsTest.name();
+const coll = db.getCollection(collName);
+
+assert.commandWorked(coll.createIndex({x: 1}));
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10000; i++) {
+    bulk.insert({_id: i, x: i, padding: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.deleteMany({_id: {$gte: 1000}}));
+
+assert.commandFailedWithCode(db.adminCommand({setParameter: 1, compactTimeSliceSeconds: -1}),
+                             ErrorCodes.BadValue);
+assert.commandWorked(db.adminCommand({setParameter: 1, compactSliceIntervalMillis: 10}));
+
+const fp = configureFailPoint(conn, "hangBeforeCompactingTableIncrementally");
+const awaitCompact = startParallelShell(funWithArgs(function(collName) {
+                                            const res = assert.commandWorked(
+                                                db.getSiblingDB("test").runCommand(
+                                                    {compact: collName}));
+                                            assert(res.hasOwnProperty("bytesFreed"), tojson(res));
+                                        }, collName), conn.port);
+fp.wait();
+
+// Compact reports the tables it has compacted out of the record store and the two indexes.
+const ops = db.getSiblingDB("admin")
+                .aggregate([
+                    {$currentOp: {}},
+                    {$match: {"command.compact": collName, msg: /^Compact: compacting tables/}}
+                ])
+                .toArray();
+assert.eq(ops.length, 1, tojson(ops));
+assert.eq(ops[0].progress.done, 0, tojson(ops));
+assert.eq(ops[0].progress.total, 3, tojson(ops));
+
+// No locks are held between tables, so operations needing an exclusive collection lock proceed.
+assert.commandWorked(db.runCommand({collMod: collName, validator: {}}));
+assert.commandWorked(coll.insert({_id: -1, x: -1}));
+
+fp.off();
+awaitCompact();
+assert.eq(1001, coll.find().itcount());
+assert.eq(1001, coll.find().hint({x: 1}).itcount());
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,65 @@
+/**
+ * Verify that the CPU profiler samples the running operations and exports the samples.
+ */
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod();
+const adminDb = conn.getDB("admin");
+const coll = conn.getDB("test").cpu_profiler;
+
+const res = adminDb.runCommand({startCPUProfiler: 1, periodMicros: 1000});
+if (res.code === ErrorCodes.InternalErrorNotSupported) {
+    jsTestLog("Skipping test as the CPU profiler is not supported on this platform");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+assert.commandWorked(res);
+
+// Starting the profiler twice, or with a period out of range, fails.
+assert.commandFailedWithCode(adminDb.runCommand({startCPUProfiler: 1}),
+                             ErrorCodes.IllegalOperation);
+assert.commandFailedWithCode(adminDb.runCommand({startCPUProfiler: 1, periodMicros: 1}),
+                             ErrorCodes.BadValue);
+
+let docs = [];
+for (let i = 0; i < 1000; ++i) {
+    docs.push({_id: i, a: i % 13, s: "x".repeat(100)});
+}
+assert.commandWorked(coll.insert(docs));
+
+// Burn CPU in a command until it has been sampled.
+assert.soon(() => {
+    coll.aggregate([{$group: {_id: "$a", n: {$sum: 1}, s: {$max: {$concat: ["$s", "$s"]}}}}])
+        .itcount();
+    const profile = assert.commandWorked(adminDb.runCommand({getCPUProfile: 1}));
+    return profile.operations.hasOwnProperty("aggregate");
+});
+
+assert.commandWorked(adminDb.runCommand({stopCPUProfiler: 1}));
+assert.commandFailedWithCode(adminDb.runCommand({stopCPUProfiler: 1}),
+                             ErrorCodes.IllegalOperation);
+
+// The profile is kept after the profiler is stopped.
+let profile = assert.commandWorked(adminDb.runCommand({getCPUProfile: 1}));
+assert.eq(profile.running, false, profile);
+assert.eq(profile.periodMicros, 1000, profile);
+assert.gt(profile.samples, 0, profile);
+assert.gt(profile.operations.aggregate, 0, profile);
+assert(profile.profile instanceof BinData, profile);
+
+// The profile can be restricted to the samples of one operation type.
+const aggregateProfile =
+    assert.commandWorked(adminDb.runCommand({getCPUProfile: 1, operationType: "aggregate"}));
+assert(aggregateProfile.profile instanceof BinData, aggregateProfile);
+assert.lte(aggregateProfile.profile.length(), profile.profile.length(), aggregateProfile);
+
+// Restarting the profiler discards the previous profile.
+assert.commandWorked(adminDb.runCommand({startCPUProfiler: 1}));
+assert.commandWorked(adminDb.runCommand({stopCPUProfiler: 1}));
+profile = assert.commandWorked(adminDb.runCommand({getCPUProfile: 1}));
+assert.eq(profile.periodMicros, 10000, profile);
+assert(!profile.operations.hasOwnProperty("aggregate"), profile);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,64 @@
+/**
+ * Tests that the documents of a cursor read ahead of its getMores, with 'cursorReadAheadMaxBytes'
+ * set, are returned in order and exactly once, and that read ahead cursors can still be killed.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {cursorReadAheadMaxBytes: 1024 * 1024}});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.coll;
+
+const numDocs = 1000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, padding: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+
+const getReadAheadMetrics = function() {
+    return assert.commandWorked(testDB.adminCommand({serverStatus: 1})).metrics.cursor.readAhead;
+};
+const batchesBefore = getReadAheadMetrics().batches;
+
+// Give the read aheads time to finish between some of the getMores, and none between others.
+let res = assert.commandWorked(
+    testDB.runCommand({find: coll.getName(), sort: {_id: 1}, batchSize: 10}));
+let ids = res.cursor.firstBatch.map(doc => doc._id);
+while (res.cursor.id != 0) {
+    if (ids.length % 30 == 0) {
+        sleep(20);
+    }
+    res = assert.commandWorked(
+        testDB.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 10}));
+    ids = ids.concat(res.cursor.nextBatch.map(doc => doc._id));
+}
+assert.eq(ids, Array.from({length: numDocs}, (_, i) => i));
+
+// Without a batch size, a read ahead is bounded by the size of the last batch.
+assert.eq(coll.find().batchSize(1).itcount(), numDocs);
+assert.eq(coll.find({_id: {$gte: 500}}).itcount(), numDocs - 500);
+assert.gt(getReadAheadMetrics().batches, batchesBefore);
+
+// A cursor which is being read ahead can be killed.
+res = assert.commandWorked(testDB.runCommand({find: coll.getName(), batchSize: 5}));
+res = assert.commandWorked(
+    testDB.runCommand({getMore: res.cursor.id, collection: coll.getName(), batchSize: 5}));
+assert.neq(res.cursor.id, 0);
+const cursorId = res.cursor.id;
+assert.soon(() => {
+    const killRes =
+        assert.commandWorked(testDB.runCommand({killCursors: coll.getName(), cursors: [cursorId]}));
+    return killRes.cursorsKilled.length == 1;
+});
+assert.commandFailedWithCode(
+    testDB.runCommand({getMore: cursorId, collection: coll.getName()}), ErrorCodes.CursorNotFound);
+
+// Read ahead can be turned off at runtime.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, cursorReadAheadMaxBytes: 0}));
+const batchesWhenOff = getReadAheadMetrics().batches;
+assert.eq(coll.find().batchSize(10).itcount(), numDocs);
+assert.eq(getReadAheadMetrics().batches, batchesWhenOff);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,47 @@
+/**
+ * Tests that dbHash with {hashFunction: "murmur3"} hashes each collection to the same value however
+ * many threads hash its _id ranges, and that the hashes still tell different contents apart.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {dbHashRangeConcurrency: 8}});
+const testDB = conn.getDB("test");
+
+assert.commandFailedWithCode(testDB.adminCommand({setParameter: 1, dbHashRangeConcurrency: 0}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(testDB.runCommand({dbHash: 1, hashFunction: "sha1"}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(testDB.runCommand({dbHash: 1, hashFunction: 1}),
+                             ErrorCodes.TypeMismatch);
+
+let bulk = testDB.coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 10000; ++i) {
+    bulk.insert({_id: i, x: i % 7, s: "x".repeat(i % 100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(testDB.createCollection("capped", {capped: true, size: 4096}));
+assert.commandWorked(testDB.capped.insert([{a: 1}, {a: 2}]));
+
+// MD5 stays the default.
+const md5Res = assert.commandWorked(testDB.runCommand({dbHash: 1}));
+assert.eq(md5Res.md5,
+          assert.commandWorked(testDB.runCommand({dbHash: 1, hashFunction: "md5"})).md5);
+
+const parallelRes = assert.commandWorked(testDB.runCommand({dbHash: 1, hashFunction: "murmur3"}));
+assert.neq(parallelRes.collections.coll, md5Res.collections.coll, tojson(parallelRes));
+
+assert.commandWorked(testDB.adminCommand({setParameter: 1, dbHashRangeConcurrency: 1}));
+const serialRes = assert.commandWorked(testDB.runCommand({dbHash: 1, hashFunction: "murmur3"}));
+assert.eq(serialRes.collections, parallelRes.collections, tojson(serialRes));
+assert.eq(serialRes.md5, parallelRes.md5, tojson(serialRes));
+
+// Changing one document changes the hash.
+assert.commandWorked(testDB.adminCommand({setParameter: 1, dbHashRangeConcurrency: 8}));
+assert.commandWorked(testDB.coll.update({_id: 5000}, {$set: {x: -1}}));
+const updatedRes = assert.commandWorked(testDB.runCommand({dbHash: 1, hashFunction: "murmur3"}));
+assert.neq(updatedRes.collections.coll, parallelRes.collections.coll, tojson(updatedRes));
+assert.eq(updatedRes.collections.capped, parallelRes.collections.capped, tojson(updatedRes));
+
+MongoRunner.stopMongod(conn);
+})();
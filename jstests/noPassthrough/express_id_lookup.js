@@ -0,0 +1,74 @@
+/**
+ * Tests that find and delete commands on a single exact _id value look the document up through the
+ * _id index without a plan executor, and that they are still profiled and counted as IDHACK
+ * lookups of the _id index.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.express_id_lookup;
+
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({_id: i, x: i}));
+}
+assert.commandWorked(db.setProfilingLevel(2));
+
+function lastProfileEntry(op) {
+    return db.system.profile.find({ns: coll.getFullName(), op: op})
+        .sort({$natural: -1})
+        .limit(1)
+        .next();
+}
+
+function idIndexOps() {
+    return coll.aggregate([{$indexStats: {}}, {$match: {name: "_id_"}}]).next().accesses.ops;
+}
+
+const opsBefore = idIndexOps();
+
+assert.eq([{_id: 3, x: 3}], coll.find({_id: 3}).toArray());
+let profileObj = lastProfileEntry("query");
+assert.eq("IDHACK", profileObj.planSummary, tojson(profileObj));
+assert.eq(1, profileObj.keysExamined, tojson(profileObj));
+assert.eq(1, profileObj.docsExamined, tojson(profileObj));
+assert.eq(1, profileObj.nreturned, tojson(profileObj));
+assert(profileObj.cursorExhausted, tojson(profileObj));
+assert.eq("IDHACK", profileObj.execStats.stage, tojson(profileObj));
+
+assert.eq([], coll.find({_id: 100}).toArray());
+profileObj = lastProfileEntry("query");
+assert.eq("IDHACK", profileObj.planSummary, tojson(profileObj));
+assert.eq(0, profileObj.keysExamined, tojson(profileObj));
+assert.eq(0, profileObj.nreturned, tojson(profileObj));
+
+// Options which change the result still go through the plan executor.
+assert.eq([{x: 4}], coll.find({_id: 4}, {_id: 0, x: 1}).toArray());
+assert.eq([], coll.find({_id: 4}).skip(1).toArray());
+const res = assert.commandWorked(db.runCommand({find: coll.getName(), filter: {_id: 4}}));
+assert.eq([{_id: 4, x: 4}], res.cursor.firstBatch);
+assert.eq(0, res.cursor.id);
+
+assert.commandWorked(coll.remove({_id: 5}));
+profileObj = lastProfileEntry("remove");
+assert.eq("IDHACK", profileObj.planSummary, tojson(profileObj));
+assert.eq(1, profileObj.ndeleted, tojson(profileObj));
+assert.eq(1, profileObj.keysExamined, tojson(profileObj));
+assert.eq(1, profileObj.keysDeleted, tojson(profileObj));
+assert.eq(null, coll.findOne({_id: 5}));
+assert.eq(0, assert.commandWorked(coll.remove({_id: 5})).nRemoved);
+assert.eq(9, coll.find().itcount());
+
+assert.gte(idIndexOps() - opsBefore, 5);
+
+// The lookup is the same with the express path turned off.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryEnableExpressIdLookup: false}));
+assert.eq([{_id: 3, x: 3}], coll.find({_id: 3}).toArray());
+assert.commandWorked(coll.remove({_id: 6}));
+assert.eq(8, coll.find().itcount());
+
+assert.commandWorked(db.setProfilingLevel(0));
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,85 @@
+/**
+ * Tests that $facet gives the same results whether its pipelines run one after another or on
+ * threads of their own, including when the input spans several batches, when a pipeline stops
+ * early, and when a pipeline fails.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryFacetMaxParallelism: 4}});
+const db = conn.getDB("test");
+const coll = db.facet_parallel;
+const other = db.facet_parallel_other;
+
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, internalQueryFacetMaxParallelism: 0}), ErrorCodes.BadValue);
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 2000; ++i) {
+    bulk.insert({_id: i, a: i % 10, b: i % 7, s: "x".repeat(i % 50)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(other.insert([{_id: 0, name: "zero"}, {_id: 1, name: "one"}]));
+
+const pipeline = [{
+    $facet: {
+        byA: [{$group: {_id: "$a", count: {$sum: 1}}}, {$sort: {_id: 1}}],
+        byB: [{$group: {_id: "$b", total: {$sum: "$_id"}}}, {$sort: {_id: 1}}],
+        first: [{$sort: {_id: 1}}, {$limit: 3}, {$project: {_id: 1}}],
+        mapped: [
+            {$match: {_id: {$lt: 5}}},
+            {$project: {doubled: {$map: {input: [1, 2], as: "x", in: {$multiply: ["$$x", "$_id"]}}}}},
+            {$sort: {_id: 1}}
+        ],
+        limited: [{$limit: 1}, {$count: "n"}],
+        looked: [
+            {$match: {_id: {$lt: 2}}},
+            {$lookup: {from: other.getName(), localField: "_id", foreignField: "_id", as: "o"}},
+            {$sort: {_id: 1}}
+        ],
+        withVar: [{$match: {_id: 0}}, {$project: {v: "$$val"}}],
+    }
+}];
+
+function runWithParallelism(parallelism, bufferSizeBytes) {
+    assert.commandWorked(db.adminCommand({
+        setParameter: 1,
+        internalQueryFacetMaxParallelism: parallelism,
+        internalQueryFacetBufferSizeBytes: bufferSizeBytes
+    }));
+    return coll.aggregate(pipeline, {let: {val: 42}}).toArray();
+}
+
+const expected = runWithParallelism(1, 100 * 1024 * 1024);
+assert.eq(expected[0].first.length, 3, tojson(expected));
+assert.eq(expected[0].withVar, [{_id: 0, v: 42}], tojson(expected));
+assert.eq(expected[0].looked[1].o, [{_id: 1, name: "one"}], tojson(expected));
+
+// With $lookup among the pipelines they all run on the operation's thread.
+assert.eq(runWithParallelism(4, 100 * 1024 * 1024), expected);
+assert.eq(runWithParallelism(4, 1024), expected);
+
+// Without it they run on threads of their own, over one batch or many.
+delete pipeline[0].$facet.looked;
+const expectedNoLookup = runWithParallelism(1, 100 * 1024 * 1024);
+for (let parallelism of [2, 4, 16]) {
+    assert.eq(runWithParallelism(parallelism, 100 * 1024 * 1024), expectedNoLookup);
+    assert.eq(runWithParallelism(parallelism, 1024), expectedNoLookup);
+}
+
+// An error in one pipeline fails the whole stage.
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryFacetMaxParallelism: 4}));
+assert.commandFailedWithCode(db.runCommand({
+    aggregate: coll.getName(),
+    pipeline: [{
+        $facet: {
+            ok: [{$count: "n"}],
+            bad: [{$project: {x: {$divide: ["$_id", 0]}}}],
+        }
+    }],
+    cursor: {}
+}),
+                             ErrorCodes.BadValue);
+
+MongoRunner.stopMongod(conn);
+})();
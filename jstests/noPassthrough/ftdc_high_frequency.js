@@ -0,0 +1,67 @@
+/**
+ * Verify that FTDC samples the hot counters several times per period when
+ * diagnosticDataCollectionHighFrequencyPeriodMillis is set.
+ *
+ * @tags: [
+ *   requires_wiredtiger,
+ * ]
+ */
+load('jstests/libs/ftdc.js');
+
+(function() {
+'use strict';
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        diagnosticDataCollectionPeriodMillis: 1000,
+        diagnosticDataCollectionHighFrequencyPeriodMillis: 100,
+    }
+});
+const adminDb = conn.getDB("admin");
+
+assert.eq(
+    adminDb.adminCommand({getParameter: 1, diagnosticDataCollectionHighFrequencyPeriodMillis: 1})
+        .diagnosticDataCollectionHighFrequencyPeriodMillis,
+    100);
+
+// Periods shorter than the minimum are rejected, but 0 disables the sampling.
+assert.commandFailedWithCode(
+    adminDb.adminCommand({setParameter: 1, diagnosticDataCollectionHighFrequencyPeriodMillis: 1}),
+    ErrorCodes.BadValue);
+
+// The samples of each period are reported as an array of a fixed size in the periodic sample.
+assert.soon(() => {
+    const data = verifyGetDiagnosticData(adminDb);
+    if (!data.hasOwnProperty("highFrequency") || !data.highFrequency.hasOwnProperty("samples")) {
+        return false;
+    }
+
+    const samples = data.highFrequency.samples;
+    assert.eq(samples.length, 10, tojson(data.highFrequency));
+    for (let sample of samples) {
+        const serverStatus = sample.serverStatus;
+        assert(serverStatus.hasOwnProperty("globalLock"), tojson(serverStatus));
+        assert(serverStatus.globalLock.hasOwnProperty("currentQueue"), tojson(serverStatus));
+        assert(serverStatus.wiredTiger.hasOwnProperty("concurrentTransactions"),
+               tojson(serverStatus));
+        assert(serverStatus.wiredTiger.cache.hasOwnProperty("bytes currently in the cache"),
+               tojson(serverStatus));
+
+        // Only the hot counters are sampled.
+        assert(!serverStatus.hasOwnProperty("opcounters"), tojson(serverStatus));
+        assert(!serverStatus.hasOwnProperty("metrics"), tojson(serverStatus));
+        assert(!serverStatus.wiredTiger.hasOwnProperty("transaction"), tojson(serverStatus));
+    }
+    return true;
+});
+
+// Disabling the sampling stops reporting samples.
+assert.commandWorked(
+    adminDb.adminCommand({setParameter: 1, diagnosticDataCollectionHighFrequencyPeriodMillis: 0}));
+assert.soon(() => {
+    const data = verifyGetDiagnosticData(adminDb);
+    return data.hasOwnProperty("highFrequency") && !data.highFrequency.hasOwnProperty("samples");
+});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,87 @@
+/**
+ * Tests that $graphLookup gives the same results when it queries its frontier in several batches
+ * and when it spills the documents it has found to disk, and that it still fails with
+ * allowDiskUse: false once it runs out of memory.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.graphlookup_spill;
+const foreign = db.graphlookup_spill_foreign;
+
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, internalDocumentSourceGraphLookupFrontierBatchSize: 0}),
+    ErrorCodes.BadValue);
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, internalDocumentSourceGraphLookupMaxMemoryBytes: 0}),
+    ErrorCodes.BadValue);
+
+// A tree in which every node has ten children, so that the frontier grows wide quickly.
+let bulk = foreign.initializeUnorderedBulkOp();
+for (let i = 0; i < 2000; ++i) {
+    bulk.insert({_id: i, parent: Math.floor((i - 1) / 10), pad: "x".repeat(100)});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.insert([{_id: 0, root: 0}, {_id: 1, root: 1}, {_id: 2, root: -5}]));
+
+const pipeline = [
+    {
+        $graphLookup: {
+            from: foreign.getName(),
+            startWith: "$root",
+            connectFromField: "_id",
+            connectToField: "parent",
+            as: "descendants",
+            depthField: "depth"
+        }
+    },
+    {$project: {count: {$size: "$descendants"}, maxDepth: {$max: "$descendants.depth"}}},
+    {$sort: {_id: 1}}
+];
+const unwoundPipeline = [
+    {
+        $graphLookup: {
+            from: foreign.getName(),
+            startWith: "$root",
+            connectFromField: "_id",
+            connectToField: "parent",
+            as: "descendant"
+        }
+    },
+    {$unwind: "$descendant"},
+    {$sort: {_id: 1, "descendant._id": 1}}
+];
+
+function setKnobs(batchSize, maxMemoryBytes) {
+    assert.commandWorked(db.adminCommand({
+        setParameter: 1,
+        internalDocumentSourceGraphLookupFrontierBatchSize: batchSize,
+        internalDocumentSourceGraphLookupMaxMemoryBytes: maxMemoryBytes
+    }));
+}
+
+setKnobs(10000, 100 * 1024 * 1024);
+const expected = coll.aggregate(pipeline).toArray();
+assert.eq(expected.length, 3, tojson(expected));
+assert.eq(expected[0].count, 1999, tojson(expected));
+assert.eq(expected[2].count, 0, tojson(expected));
+const expectedUnwound = coll.aggregate(unwoundPipeline).toArray();
+
+// Querying the frontier a few values at a time finds the same documents.
+setKnobs(7, 100 * 1024 * 1024);
+assert.eq(coll.aggregate(pipeline).toArray(), expected);
+assert.eq(coll.aggregate(unwoundPipeline).toArray(), expectedUnwound);
+
+// With a small memory limit the search fails without allowDiskUse and spills with it.
+setKnobs(7, 64 * 1024);
+assert.commandFailedWithCode(
+    db.runCommand(
+        {aggregate: coll.getName(), pipeline: unwoundPipeline, cursor: {}, allowDiskUse: false}),
+    40099);
+assert.eq(coll.aggregate(unwoundPipeline, {allowDiskUse: true}).toArray(), expectedUnwound);
+assert.eq(coll.aggregate(pipeline, {allowDiskUse: true}).toArray(), expected);
+
+MongoRunner.stopMongod(conn);
+})();
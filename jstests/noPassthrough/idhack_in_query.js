@@ -0,0 +1,68 @@
+/**
+ * Tests that an {_id: {$in: [...]}} query is answered by an IDHACK plan which looks up each key,
+ * that it returns each matching document once and in _id order, and that a query which needs
+ * anything else falls back to the regular planner.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage() and isIxscan().
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.idhack_in_query;
+
+if (checkSBEEnabled(db)) {
+    jsTestLog("Skipping test as only the classic engine builds IDHACK plans for $in queries");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, x: i % 10});
+}
+assert.commandWorked(bulk.execute());
+
+// Duplicate and missing keys, in no particular order.
+const keys = [512, 3, 999, 3, 40, 2000, 0, 40.0, -1];
+const query = {_id: {$in: keys}};
+const expectedIds = [0, 3, 40, 512, 999];
+
+const explain = coll.find(query).explain("executionStats");
+assert.neq(null, getPlanStage(explain.queryPlanner.winningPlan, "IDHACK"), explain);
+assert.eq(expectedIds.length, explain.executionStats.nReturned, explain);
+assert.eq(expectedIds.length, explain.executionStats.totalKeysExamined, explain);
+assert.eq(expectedIds.length, explain.executionStats.totalDocsExamined, explain);
+
+assert.eq(expectedIds, coll.find(query).toArray().map(doc => doc._id));
+assert.eq(expectedIds, coll.find(query).sort({_id: 1}).toArray().map(doc => doc._id));
+assert.eq([{x: 0}, {x: 3}], coll.find({_id: {$in: [13, 20]}}, {_id: 0, x: 1}).toArray());
+assert.eq([{_id: 3}, {_id: 40}], coll.find({_id: {$in: [40, 3]}}).returnKey().toArray());
+
+// Small batches make the stage save and restore its cursors between lookups.
+assert.eq(expectedIds, coll.find(query).batchSize(2).toArray().map(doc => doc._id));
+
+// A sort on another field, a limit, a hint or another predicate needs the regular planner.
+const plannedCursors = [
+    coll.find(query).sort({x: 1}),
+    coll.find(query).limit(2),
+    coll.find(query).hint({_id: 1}),
+    coll.find({_id: {$in: keys}, x: 0}),
+];
+for (let cursor of plannedCursors) {
+    const winningPlan = cursor.explain().queryPlanner.winningPlan;
+    assert.eq(null, getPlanStage(winningPlan, "IDHACK"), winningPlan);
+    assert(isIxscan(db, winningPlan), winningPlan);
+}
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableIdHackForInQueries: false}));
+const winningPlan = coll.find(query).explain().queryPlanner.winningPlan;
+assert.eq(null, getPlanStage(winningPlan, "IDHACK"), winningPlan);
+assert.eq(expectedIds, coll.find(query).toArray().map(doc => doc._id));
+
+MongoRunner.stopMongod(conn);
+})();
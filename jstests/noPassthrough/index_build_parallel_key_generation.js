@@ -0,0 +1,62 @@
+/**
+ * Tests that an index build of several indexes, or of a text index, generates the keys of the
+ * scanned documents on several threads when 'indexBuildKeyGenerationThreads' is greater than one,
+ * and that the resulting indexes are valid, including unique, partial, multikey and skipped-key
+ * cases.
+ */
+
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {indexBuildKeyGenerationThreads: 4}});
+const db = conn.getDB("test");
+const coll = db.index_build_parallel_key_generation;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; i++) {
+    bulk.insert({_id: i, a: i, b: [i, i + 1], c: i % 10, d: "x".repeat(i % 100)});
+}
+assert.commandWorked(bulk.execute());
+
+assert.commandWorked(coll.createIndexes([
+    {a: 1},
+    {b: 1},
+    {c: 1, a: -1},
+    {d: "hashed"},
+    {"$**": 1},
+]));
+assert.commandWorked(
+    coll.createIndex({a: -1}, {unique: true, partialFilterExpression: {c: {$gt: 5}}}));
+
+assert.eq(5000, coll.find().hint({a: 1}).itcount());
+assert.eq(10000, coll.find({b: {$gte: 0}}).hint({b: 1}).itcount());
+assert.eq(2000, coll.find({c: {$gt: 5}}).hint({a: -1}).itcount());
+
+// A duplicate key error raised on a key generation thread fails the build.
+assert.commandWorked(coll.insert({_id: 5000, e: 1, a: 1}));
+assert.commandWorked(coll.insert({_id: 5001, e: 1, a: 2}));
+assert.commandFailedWithCode(coll.createIndexes([{a: 1, x: 1}, {e: 1}], {unique: true}),
+                             ErrorCodes.DuplicateKey);
+
+// A single text index generates the keys of each batch of documents on all threads.
+const textColl = db.index_build_parallel_key_generation_text;
+const words = ["running", "jumped", "swimming", "flies", "quickly"];
+bulk = textColl.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; i++) {
+    bulk.insert({_id: i, t: words[i % 5] + " " + words[(i + 1) % 5] + " doc" + i, c: i % 10});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(textColl.createIndex({t: "text"}));
+assert.eq(2000, textColl.find({$text: {$search: "run"}}).itcount());
+assert.eq(1, textColl.find({$text: {$search: "doc1234"}}).itcount());
+assert.commandWorked(textColl.dropIndexes());
+assert.commandWorked(
+    textColl.createIndex({t: "text"}, {partialFilterExpression: {c: {$gt: 5}}}));
+assert.eq(1000, textColl.find({$text: {$search: "fly"}, c: {$gt: 5}}).itcount());
+assert(textColl.validate({full: true}).valid);
+
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, tojson(res));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,47 @@
+/**
+ * Tests that when 'internalQueryPlannerEnableIndexSkipScan' is set, a compound index can answer a
+ * query which has no predicate over its leading field by seeking past each distinct value of that
+ * field, and that it then wins over a collection scan.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getPlanStage() and isCollscan().
+
+const conn = MongoRunner.runMongod();
+assert.neq(null, conn, "mongod was unable to start up");
+const db = conn.getDB("test");
+const coll = db.index_skip_scan;
+
+const numTenants = 5;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 5000; i++) {
+    bulk.insert({tenant: i % numTenants, ts: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandWorked(coll.createIndex({tenant: 1, ts: 1}));
+
+const query = {ts: {$gte: 1000, $lt: 1100}};
+assert(isCollscan(db, coll.find(query).explain().queryPlanner.winningPlan));
+
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryPlannerEnableIndexSkipScan: true}));
+
+const explain = coll.find(query).explain("executionStats");
+const ixscan = getPlanStage(explain.queryPlanner.winningPlan, "IXSCAN");
+assert.neq(null, ixscan, explain);
+assert.eq(ixscan.indexBounds, {tenant: ["[MinKey, MaxKey]"], ts: ["[1000.0, 1100.0)"]}, explain);
+
+// Beyond the keys in range, the scan examines about one key per tenant when it seeks to the range
+// and one more when it seeks past it.
+assert.eq(100, explain.executionStats.nReturned, explain);
+assert.lte(explain.executionStats.totalKeysExamined, 100 + 2 * numTenants + 1, explain);
+assert.eq(100, coll.find(query).itcount());
+
+// Predicates over the leading field keep using ordinary bounds.
+const tenantExplain = coll.find({tenant: 2, ts: {$lt: 50}}).explain();
+const tenantIxscan = getPlanStage(tenantExplain.queryPlanner.winningPlan, "IXSCAN");
+assert.eq(tenantIxscan.indexBounds, {tenant: ["[2.0, 2.0]"], ts: ["[-inf.0, 50.0)"]});
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,48 @@
+/**
+ * Tests that journaled writes are acknowledged when the journal flusher waits for a group commit
+ * window, and that serverStatus reports how many waiters its flushes served.
+ *
+ * @tags: [requires_journaling, requires_persistence]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        journalFlusherGroupCommitWindowMicros: 20 * 1000,
+        journalFlusherGroupCommitMaxWaiters: 4,
+    }
+});
+const db = conn.getDB("test");
+
+const statsBefore = assert.commandWorked(db.serverStatus()).journalFlusher;
+assert(statsBefore.hasOwnProperty("flushes"), tojson(statsBefore));
+
+const numShells = 4;
+const numWritesPerShell = 50;
+const shells = [];
+for (let i = 0; i < numShells; i++) {
+    shells.push(startParallelShell(funWithArgs(function(shell, numWrites) {
+                                       for (let j = 0; j < numWrites; j++) {
+                                           assert.commandWorked(db.coll.insert(
+                                               {shell: shell, j: j}, {writeConcern: {j: true}}));
+                                       }
+                                   }, i, numWritesPerShell), conn.port));
+}
+shells.forEach(join => join());
+assert.eq(numShells * numWritesPerShell, db.coll.find().itcount());
+
+const statsAfter = assert.commandWorked(db.serverStatus()).journalFlusher;
+assert.gte(statsAfter.waitersServed - statsBefore.waitersServed,
+           numShells * numWritesPerShell,
+           tojson(statsAfter));
+assert.gt(statsAfter.flushes, statsBefore.flushes, tojson(statsAfter));
+assert.gte(statsAfter.maxWaitersPerFlush, 1, tojson(statsAfter));
+assert.gt(statsAfter.groupCommitWaitMicros, statsBefore.groupCommitWaitMicros, tojson(statsAfter));
+
+// Turning the window off flushes right away again.
+assert.commandWorked(db.adminCommand({setParameter: 1, journalFlusherGroupCommitWindowMicros: 0}));
+assert.commandWorked(db.coll.insert({}, {writeConcern: {j: true}}));
+
+MongoRunner.stopMongod(conn);
+})();
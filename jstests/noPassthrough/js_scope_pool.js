@@ -0,0 +1,93 @@
+/**
+ * Tests that $function and $accumulator give the same results whether or not JavaScript scopes are
+ * reused between operations, and that a reused scope is never handed to an operation on another
+ * database.
+ *
+ * @tags: [requires_scripting]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {internalQueryJavaScriptScopePoolSize: 4}});
+const db = conn.getDB("test");
+const coll = db.js_scope_pool;
+
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, internalQueryJavaScriptScopePoolSize: -1}),
+    ErrorCodes.BadValue);
+
+assert.commandWorked(coll.insert([{_id: 0, x: 1}, {_id: 1, x: 2}, {_id: 2, x: 3}]));
+
+const pipeline = [
+    {
+        $project: {
+            doubled: {
+                $function: {body: "function(x) { return 2 * x; }", args: ["$x"], lang: "js"}
+            }
+        }
+    },
+    {
+        $group: {
+            _id: null,
+            sum: {
+                $accumulator: {
+                    init: "function() { return 0; }",
+                    accumulate: "function(state, val) { return state + val; }",
+                    accumulateArgs: ["$doubled"],
+                    merge: "function(s1, s2) { return s1 + s2; }",
+                    lang: "js"
+                }
+            }
+        }
+    }
+];
+
+function runPipeline() {
+    return coll.aggregate(pipeline).toArray();
+}
+
+const expected = [{_id: null, sum: 12}];
+for (let i = 0; i < 5; ++i) {
+    assert.eq(runPipeline(), expected);
+}
+
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryJavaScriptScopePoolSize: 0}));
+assert.eq(runPipeline(), expected);
+assert.commandWorked(db.adminCommand({setParameter: 1, internalQueryJavaScriptScopePoolSize: 4}));
+
+// A global set by a function on one database is not visible to a function on another database.
+const otherDB = conn.getDB("other");
+assert.commandWorked(otherDB.js_scope_pool.insert({_id: 0}));
+function readGlobal(testDB) {
+    return testDB.js_scope_pool
+        .aggregate([{
+            $project: {
+                seen: {
+                    $function: {
+                        body: "function() { return typeof leakedGlobal; }",
+                        args: [],
+                        lang: "js"
+                    }
+                }
+            }
+        }])
+        .toArray()[0]
+        .seen;
+}
+assert.eq(coll.aggregate([{
+                  $project: {
+                      set: {
+                          $function: {
+                              body: "function() { leakedGlobal = 1; return true; }",
+                              args: [],
+                              lang: "js"
+                          }
+                      }
+                  }
+              }])
+              .itcount(),
+          3);
+assert.eq(readGlobal(otherDB), "undefined");
+
+MongoRunner.stopMongod(conn);
+})();
@@ -19,7 +19,6 @@ TestData.disableImplicitSessions = true;
 
 load("jstests/libs/fixture_helpers.js");  // For FixtureHelpers.
 load("jstests/libs/log.js");              // For findMatchingLogLine.
-load("jstests/libs/sbe_util.js");         // For checkSBEEnabled.
 
 // Prevent the mongo shell from gossiping its cluster time, since this will increase the amount
 // of data logged for each op. For some of the testcases below, including the cluster time would
@@ -100,8 +99,6 @@ function runLoggingTests({db, readWriteMode, slowMs, logLevel, sampleRate}) {
     assert.commandWorked(db.setLogLevel(logLevel, "command"));
     assert.commandWorked(db.setLogLevel(logLevel, "write"));
 
-    const isSBEEnabled = checkSBEEnabled(db);
-
     // Certain fields in the log lines on mongoD are not applicable in their counterparts on
     // mongoS, and vice-versa. Ignore these fields when examining the logs of an instance on
     // which we do not expect them to appear.
@@ -202,8 +199,7 @@ function runLoggingTests({db, readWriteMode, slowMs, logLevel, sampleRate}) {
                 command: "find",
                 find: coll.getName(),
                 comment: logFormatTestComment,
-                planSummary: isSBEEnabled && readWriteMode == "commands" ? "IXSCAN { _id: 1 }"
-                                                                         : "IDHACK",
+                planSummary: "IDHACK",
                 cursorExhausted: 1,
                 keysExamined: 1,
                 docsExamined: 1,
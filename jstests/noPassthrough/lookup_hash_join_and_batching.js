@@ -0,0 +1,73 @@
+/**
+ * Tests that a $lookup with localField/foreignField returns the same results when the foreign
+ * collection is read into a hash table, and when the foreign documents are fetched for a batch of
+ * input documents at once, as when it runs a query for each input document.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const local = db.local;
+const foreign = db.foreign;
+
+const values = [1, 1.0, NumberDecimal("2"), [1, 2], [[1, 2]], null, "abc", {c: 1}, [null, 3], 4];
+for (let i = 0; i < 200; i++) {
+    const value = values[i % values.length];
+    assert.commandWorked(local.insert({_id: i, a: value}));
+    assert.commandWorked(foreign.insert({_id: i, b: value, nested: {b: value}}));
+}
+assert.commandWorked(local.insert({_id: "missing"}));
+assert.commandWorked(foreign.insert({_id: "missing"}));
+
+function runLookups() {
+    const results = [];
+    for (let foreignField of ["b", "nested.b"]) {
+        const lookup = {from: "foreign", localField: "a", foreignField: foreignField, as: "j"};
+        const docs =
+            local.aggregate([{$lookup: lookup}, {$project: {ids: "$j._id"}}, {$sort: {_id: 1}}])
+                .toArray();
+        for (let doc of docs) {
+            doc.ids.sort();
+        }
+        results.push(docs);
+    }
+    return results;
+}
+
+function setParameters(params) {
+    assert.commandWorked(db.adminCommand(Object.assign({setParameter: 1}, params)));
+}
+
+for (let withIndex of [false, true]) {
+    if (withIndex) {
+        assert.commandWorked(foreign.createIndex({b: 1}));
+        assert.commandWorked(foreign.createIndex({"nested.b": 1}));
+    }
+
+    setParameters({
+        internalDocumentSourceLookupHashJoinMaxMemoryBytes: 0,
+        internalDocumentSourceLookupBatchSize: 1
+    });
+    const expected = runLookups();
+
+    // The whole foreign collection fits in the hash table.
+    setParameters({internalDocumentSourceLookupHashJoinMaxMemoryBytes: 100 * 1024 * 1024});
+    assert.eq(expected, runLookups());
+
+    // The hash table is abandoned, and the input documents are looked up in batches.
+    setParameters({
+        internalDocumentSourceLookupHashJoinMaxMemoryBytes: 1024,
+        internalDocumentSourceLookupBatchSize: 7
+    });
+    assert.eq(expected, runLookups());
+
+    setParameters({
+        internalDocumentSourceLookupHashJoinMaxMemoryBytes: 0,
+        internalDocumentSourceLookupBatchSize: 64
+    });
+    assert.eq(expected, runLookups());
+}
+
+MongoRunner.stopMongod(conn);
+})();
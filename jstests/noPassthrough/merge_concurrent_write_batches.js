@@ -0,0 +1,92 @@
+/**
+ * Tests that $merge gives the same results when a shard has several of its batches in flight at
+ * once, and that batches which write to the same target documents are still applied in order.
+ *
+ * @tags: [
+ *   requires_replication,
+ *   requires_sharding,
+ * ]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, mongos: 1, config: 1});
+const dbName = jsTestName();
+const testDB = st.s.getDB(dbName);
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+
+const source = testDB.source;
+const target = testDB.target;
+
+assert.commandFailedWithCode(
+    st.rs0.getPrimary().adminCommand(
+        {setParameter: 1, internalDocumentSourceMergeMaxConcurrentWriteBatches: 0}),
+    ErrorCodes.BadValue);
+
+// Enough padding that the documents do not fit in one batch, with each target document written
+// once per batch.
+const kNumKeys = 400;
+const pad = "x".repeat(30 * 1024);
+let bulk = source.initializeUnorderedBulkOp();
+for (let i = 0; i < 3 * kNumKeys; ++i) {
+    bulk.insert({_id: i, k: i % kNumKeys, pad: pad});
+}
+assert.commandWorked(bulk.execute());
+
+function setMaxConcurrentWriteBatches(n) {
+    for (let conn of [st.rs0.getPrimary(), st.rs1.getPrimary()]) {
+        assert.commandWorked(conn.adminCommand(
+            {setParameter: 1, internalDocumentSourceMergeMaxConcurrentWriteBatches: n}));
+    }
+}
+
+function runMerge(whenMatched) {
+    target.drop();
+    assert.commandWorked(st.s.adminCommand({shardCollection: target.getFullName(), key: {_id: 1}}));
+    assert.commandWorked(
+        st.s.adminCommand({split: target.getFullName(), middle: {_id: kNumKeys / 2}}));
+    assert.commandWorked(st.s.adminCommand({
+        moveChunk: target.getFullName(),
+        find: {_id: kNumKeys / 2},
+        to: st.shard1.shardName,
+        _waitForDelete: true
+    }));
+
+    source.aggregate([
+        {$sort: {_id: 1}},
+        {$project: {_id: "$k", last: "$_id", count: {$literal: 1}, pad: 1}},
+        {$merge: {into: target.getName(), on: "_id", whenMatched: whenMatched}}
+    ]);
+    return target.find({}, {pad: 0}).sort({_id: 1}).toArray();
+}
+
+const incrementCount = [{$set: {last: "$$new.last", count: {$add: ["$count", 1]}}}];
+for (let n of [1, 4]) {
+    setMaxConcurrentWriteBatches(n);
+
+    const replaced = runMerge("replace");
+    assert.eq(replaced.length, kNumKeys, tojson(replaced));
+    replaced.forEach((doc, k) => assert.eq(doc, {_id: k, last: 2 * kNumKeys + k, count: 1}));
+
+    const merged = runMerge(incrementCount);
+    assert.eq(merged.length, kNumKeys, tojson(merged));
+    merged.forEach((doc, k) => assert.eq(doc, {_id: k, last: 2 * kNumKeys + k, count: 3}));
+}
+
+// A batch which fails makes the whole $merge fail.
+setMaxConcurrentWriteBatches(4);
+target.drop();
+assert.commandWorked(target.insert({_id: 0}));
+assert.commandFailedWithCode(testDB.runCommand({
+    aggregate: source.getName(),
+    pipeline: [
+        {$project: {_id: "$k"}},
+        {$merge: {into: target.getName(), whenMatched: "fail", whenNotMatched: "insert"}}
+    ],
+    cursor: {}
+}),
+                             ErrorCodes.DuplicateKey);
+
+st.stop();
+})();
@@ -0,0 +1,79 @@
+// Tests that the CPU time and the time spent waiting for a ticket are reported for each operation
+// in the profiler, the slow query log and $currentOp.
+// @tags: [
+//   requires_profiling,
+//   requires_wiredtiger,
+// ]
+(function() {
+"use strict";
+
+load("jstests/libs/parallel_shell_helpers.js");  // For funWithArgs.
+
+const isLinux = getBuildInfo().buildEnvironment.target_os == "linux";
+
+// A single read ticket, so that a second reader must queue behind one holding it.
+const conn = MongoRunner.runMongod({setParameter: {wiredTigerConcurrentReadTransactions: 1}});
+const db = conn.getDB(jsTestName());
+const coll = db.coll;
+const otherColl = db.other;
+assert.commandWorked(coll.insert({_id: 0}));
+assert.commandWorked(otherColl.insert({_id: 0}));
+assert.commandWorked(db.setProfilingLevel(2, {slowms: -1}));
+
+function getProfileEntry(comment) {
+    const entries = db.system.profile.find({"command.comment": comment}).toArray();
+    assert.eq(entries.length, 1, entries);
+    return entries[0];
+}
+
+// The CPU time is reported wherever the platform can measure it.
+assert.eq(1, coll.find().comment("cpu").itcount());
+let entry = getProfileEntry("cpu");
+if (isLinux) {
+    assert.gt(entry.cpuNanos, 0, entry);
+    checkLog.containsJson(
+        conn, 51803, {command: (cmd) => cmd.comment === "cpu", cpuNanos: (n) => n > 0});
+} else {
+    assert(!entry.hasOwnProperty("cpuNanos"), entry);
+}
+assert(!entry.hasOwnProperty("ticketWaitMicros"), entry);
+
+// Hold the only read ticket in a find, and queue another find behind it.
+const fp = configureFailPoint(conn, "waitInFindBeforeMakingBatch", {nss: coll.getFullName()});
+const awaitHolder = startParallelShell(funWithArgs(function(dbName) {
+                                           assert.eq(1,
+                                                     db.getSiblingDB(dbName)
+                                                         .coll.find()
+                                                         .comment("holder")
+                                                         .itcount());
+                                       }, db.getName()), conn.port);
+fp.wait();
+
+const awaitQueued = startParallelShell(funWithArgs(function(dbName) {
+                                           assert.eq(1,
+                                                     db.getSiblingDB(dbName)
+                                                         .other.find()
+                                                         .comment("queued")
+                                                         .itcount());
+                                       }, db.getName()), conn.port);
+assert.soon(() => db.serverStatus().globalLock.currentQueue.readers > 0);
+
+// The holder reports its CPU time while it is still running.
+if (isLinux) {
+    const ops = conn.getDB("admin")
+                    .aggregate([{$currentOp: {}}, {$match: {"command.comment": "holder"}}])
+                    .toArray();
+    assert.eq(ops.length, 1, ops);
+    assert.gt(ops[0].cpuNanos, 0, ops);
+}
+
+sleep(100);
+fp.off();
+awaitHolder();
+awaitQueued();
+
+entry = getProfileEntry("queued");
+assert.gte(entry.ticketWaitMicros, 50 * 1000, entry);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,85 @@
+// Tests that operation latencies are recorded per command and namespace, and reported by the
+// $operationLatencyHistograms aggregation stage and the operationLatencyHistograms serverStatus
+// section.
+// @tags: [
+//   requires_fcv_50,
+// ]
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const adminDB = conn.getDB("admin");
+const testDB = conn.getDB(jsTestName());
+
+function getEntries(spec) {
+    let entries = {};
+    adminDB.aggregate([{$operationLatencyHistograms: spec || {}}]).forEach((doc) => {
+        entries[(doc.ns || "") + " " + doc.command] = doc;
+    });
+    return entries;
+}
+
+// The stage may only be run against the admin database in a 'collectionless' form.
+assert.commandFailedWithCode(
+    testDB.runCommand({aggregate: 1, pipeline: [{$operationLatencyHistograms: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDB.runCommand({aggregate: "c", pipeline: [{$operationLatencyHistograms: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(adminDB.runCommand({
+    aggregate: 1,
+    pipeline: [{$operationLatencyHistograms: {unknown: 1}}],
+    cursor: {}
+}),
+                             ErrorCodes.BadValue);
+
+const coll = testDB.a;
+for (let i = 0; i < 10; ++i) {
+    assert.commandWorked(coll.insert({_id: i}));
+}
+for (let i = 0; i < 20; ++i) {
+    assert.eq(1, coll.find({_id: i % 10}).itcount());
+}
+
+let entries = getEntries();
+const insertEntry = entries[coll.getFullName() + " insert"];
+const findEntry = entries[coll.getFullName() + " find"];
+assert(insertEntry, entries);
+assert(findEntry, entries);
+assert.eq(insertEntry.count, 10, insertEntry);
+assert.eq(findEntry.count, 20, findEntry);
+assert.gte(findEntry.micros, 0, findEntry);
+assert.lte(findEntry.percentiles.p50, findEntry.percentiles.p90, findEntry);
+assert.lte(findEntry.percentiles.p90, findEntry.percentiles.p99, findEntry);
+assert.lte(findEntry.percentiles.p99, findEntry.percentiles.p999, findEntry);
+assert(!findEntry.hasOwnProperty("histogram"), findEntry);
+
+// The full histograms add up to the number of operations.
+entries = getEntries({histograms: true});
+const histogram = entries[coll.getFullName() + " find"].histogram;
+assert.eq(20, histogram.reduce((total, bucket) => total + bucket.count, 0), histogram);
+
+// Once the cap on namespaces is reached, operations are recorded against their command alone.
+const countNamespaced = (entries) =>
+    Object.values(entries).filter((entry) => entry.hasOwnProperty("ns")).length;
+const numNamespaced = countNamespaced(entries);
+assert.commandWorked(
+    adminDB.runCommand({setParameter: 1, operationLatencyHistogramsMaxEntries: numNamespaced}));
+for (let name of ["b", "c", "d"]) {
+    assert.commandWorked(testDB[name].insert({_id: 0}));
+}
+entries = getEntries();
+assert.eq(numNamespaced, countNamespaced(entries), entries);
+assert(!entries.hasOwnProperty(testDB.b.getFullName() + " insert"), entries);
+assert.eq(3, entries[" insert"].count, entries);
+
+// The serverStatus section reports the same statistics, grouped by namespace.
+const section =
+    assert.commandWorked(adminDB.runCommand({serverStatus: 1, operationLatencyHistograms: 1}))
+        .operationLatencyHistograms;
+assert.eq(section[coll.getFullName()].insert.count, 10, section);
+assert.eq(section.otherNamespaces.insert.count, 3, section);
+assert(!adminDB.serverStatus().hasOwnProperty("operationLatencyHistograms"));
+
+MongoRunner.stopMongod(conn);
+})();
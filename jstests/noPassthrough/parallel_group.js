@@ -0,0 +1,56 @@
+/**
+ * Tests that a $group split between several threads by 'internalQueryParallelGroupWorkers' returns
+ * the same groups as a $group on a single thread, including when the workers spill to disk.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.parallel_group;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 20000; i++) {
+    const key = i % 101;
+    bulk.insert({_id: i, a: key === 0 ? null : (i % 2 ? key : NumberLong(key)), b: i % 7, c: i});
+}
+assert.commandWorked(bulk.execute());
+
+const pipelines = [
+    [{$group: {_id: "$a", count: {$sum: 1}, total: {$sum: "$c"}, first: {$first: "$c"}}}],
+    [{$group: {_id: {a: "$a", b: "$b"}, last: {$last: "$c"}}}, {$match: {last: {$gt: 100}}}],
+    [{$match: {b: {$ne: 3}}}, {$group: {_id: "$b", docs: {$push: "$$ROOT"}}}],
+];
+const sortById = (docs) => docs.sort((x, y) => bsonWoCompare({_id: x._id}, {_id: y._id}));
+
+function setWorkers(numWorkers) {
+    assert.commandWorked(
+        db.adminCommand({setParameter: 1, internalQueryParallelGroupWorkers: numWorkers}));
+}
+
+for (let pipeline of pipelines) {
+    setWorkers(0);
+    const expected = sortById(coll.aggregate(pipeline).toArray());
+
+    setWorkers(4);
+    assert.eq(expected, sortById(coll.aggregate(pipeline).toArray()), tojson(pipeline));
+    assert.eq(expected,
+              sortById(coll.aggregate(pipeline, {cursor: {batchSize: 2}}).toArray()),
+              tojson(pipeline));
+}
+
+// Each worker spills its own groups when it runs out of memory.
+const spillPipeline = [{$group: {_id: "$c", b: {$first: "$b"}}}];
+setWorkers(0);
+const expected = sortById(coll.aggregate(spillPipeline).toArray());
+setWorkers(3);
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalDocumentSourceGroupMaxMemoryBytes: 10 * 1024}));
+assert.eq(expected, sortById(coll.aggregate(spillPipeline, {allowDiskUse: true}).toArray()));
+assert.commandFailedWithCode(
+    db.runCommand(
+        {aggregate: coll.getName(), pipeline: spillPipeline, cursor: {}, allowDiskUse: false}),
+    ErrorCodes.QueryExceededMemoryLimitNoDiskUseAllowed);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,61 @@
+/**
+ * Tests that '$planCacheStats' with 'partitionStats: true' reports the entries, hits, misses and
+ * evictions of each partition of a collection's plan cache.
+ */
+(function() {
+"use strict";
+
+const numPartitions = 4;
+const conn = MongoRunner.runMongod({
+    setParameter: {internalQueryCacheNumPartitions: numPartitions},
+});
+assert.neq(null, conn, "mongod failed to start up");
+
+const testDb = conn.getDB("test");
+const coll = testDb.plan_cache_partition_stats;
+
+function getPartitionStats() {
+    const stats = coll.aggregate([{$planCacheStats: {partitionStats: true}}]).toArray();
+    assert.eq(numPartitions, stats.length, tojson(stats));
+    const totals = {numEntries: 0, hits: 0, misses: 0, evictions: 0};
+    stats.forEach((partition, i) => {
+        assert.eq(i, partition.partition, tojson(stats));
+        for (let field in totals) {
+            totals[field] += partition[field];
+        }
+    });
+    return totals;
+}
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.insert({a: i, b: i, c: i, d: i}));
+}
+
+let totals = getPartitionStats();
+assert.eq({numEntries: 0, hits: 0, misses: 0, evictions: 0}, totals);
+
+// Run queries of several shapes, each of which has two candidate plans and so gets cached.
+const shapes = [{a: 1, b: 1}, {a: 1, b: 1, c: 1}, {a: 1, b: 1, d: 1}, {a: 1, b: {$gt: 0}}];
+for (let shape of shapes) {
+    assert.eq(1, coll.find(shape).itcount());
+    assert.eq(1, coll.find(shape).itcount());
+}
+
+totals = getPartitionStats();
+assert.eq(shapes.length, totals.numEntries, tojson(totals));
+assert.eq(coll.aggregate([{$planCacheStats: {}}]).itcount(), totals.numEntries);
+assert.gte(totals.misses, shapes.length, tojson(totals));
+assert.gte(totals.hits, shapes.length, tojson(totals));
+assert.eq(0, totals.evictions, tojson(totals));
+
+// A $match after the stage applies to the partition documents.
+assert.eq(1, coll.aggregate([{$planCacheStats: {partitionStats: true}}, {$match: {partition: 0}}])
+                 .itcount());
+
+coll.getPlanCache().clear();
+assert.eq(0, getPartitionStats().numEntries);
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,62 @@
+/**
+ * Tests that blocking sorts and groups which are allowed to use disk spill before reaching their
+ * own memory limits once 'internalQueryMaxTotalBlockingMemoryUsageBytes' is exceeded, and not
+ * otherwise.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStages() and getPlanStage().
+load("jstests/libs/sbe_util.js");      // For checkSBEEnabled.
+
+const kStageMaxMemoryBytes = 16 * 1024 * 1024;
+const conn = MongoRunner.runMongod({
+    setParameter: {
+        internalDocumentSourceGroupMaxMemoryBytes: kStageMaxMemoryBytes,
+        internalQueryMaxBlockingSortMemoryUsageBytes: kStageMaxMemoryBytes,
+    }
+});
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.coll;
+
+// About 8MB of documents and groups, within the limit of each stage but above a quarter of it.
+const numDocs = 20000;
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < numDocs; ++i) {
+    bulk.insert({_id: i, padding: "x".repeat(300)});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [{$group: {_id: "$_id", padding: {$first: "$padding"}}}];
+const groupUsedDisk = function() {
+    const explain = coll.explain("executionStats").aggregate(pipeline, {allowDiskUse: true});
+    const stages = getAggPlanStages(explain, "$group");
+    assert.eq(stages.length, 1, explain);
+    return stages[0].usedDisk;
+};
+const sortUsedDisk = function() {
+    const explain =
+        coll.find().sort({padding: 1, _id: -1}).allowDiskUse().explain("executionStats");
+    return getPlanStage(explain.executionStats.executionStages, "SORT").usedDisk;
+};
+const isSBEEnabled = checkSBEEnabled(testDB);
+
+assert.eq(groupUsedDisk(), false);
+if (!isSBEEnabled) {
+    assert.eq(sortUsedDisk(), false);
+}
+
+// A budget smaller than a single stage makes the stages spill early.
+assert.commandWorked(testDB.adminCommand(
+    {setParameter: 1, internalQueryMaxTotalBlockingMemoryUsageBytes: 1024 * 1024}));
+assert.eq(groupUsedDisk(), true);
+if (!isSBEEnabled) {
+    assert.eq(sortUsedDisk(), true);
+}
+assert.eq(coll.aggregate(pipeline, {allowDiskUse: true}).itcount(), numDocs);
+
+// Stages which may not use disk are only bound by their own limits.
+assert.eq(coll.aggregate(pipeline).itcount(), numDocs);
+
+MongoRunner.stopMongod(conn);
+})();
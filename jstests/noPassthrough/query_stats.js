@@ -0,0 +1,63 @@
+// Tests that the $queryStats aggregation stage reports statistics for each query shape, sampled
+// according to the queryStatsSampleRate server parameter.
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({setParameter: {queryStatsSampleRate: 1}});
+const adminDB = conn.getDB("admin");
+const testDB = conn.getDB(jsTestName());
+const coll = testDB.coll;
+
+function getQueryStats() {
+    return adminDB.aggregate([{$queryStats: {}}]).toArray().filter(
+        (entry) => entry.ns === coll.getFullName());
+}
+
+// The stage may only be run against the admin database in a 'collectionless' form.
+assert.commandFailedWithCode(
+    testDB.runCommand({aggregate: 1, pipeline: [{$queryStats: {}}], cursor: {}}),
+    ErrorCodes.InvalidNamespace);
+assert.commandFailedWithCode(
+    adminDB.runCommand({aggregate: 1, pipeline: [{$queryStats: {unknown: 1}}], cursor: {}}),
+    ErrorCodes.BadValue);
+
+let docs = [];
+for (let i = 0; i < 100; ++i) {
+    docs.push({_id: i, a: i % 10, b: i});
+}
+assert.commandWorked(coll.insert(docs));
+assert.commandWorked(coll.createIndex({a: 1}));
+
+// Queries which differ only in their values share a shape.
+for (let i = 0; i < 5; ++i) {
+    assert.eq(10, coll.find({a: i}).itcount());
+}
+assert.eq(1, coll.find({b: 3}).itcount());
+
+let stats = getQueryStats();
+const byA = stats.filter((entry) => entry.planSummary === "IXSCAN { a: 1 }");
+const byB = stats.filter((entry) => entry.planSummary === "COLLSCAN");
+assert.eq(1, byA.length, stats);
+assert.eq(1, byB.length, stats);
+assert.neq(byA[0].queryHash, byB[0].queryHash, stats);
+
+assert.eq("find", byA[0].command, byA);
+assert.eq(5, byA[0].executions, byA);
+assert.eq(50, byA[0].docsExamined, byA);
+assert.eq(10, byA[0].maxDocsExamined, byA);
+assert.eq(50, byA[0].keysExamined, byA);
+assert.eq(50, byA[0].nreturned, byA);
+assert.eq(5, byA[0].latency.count, byA);
+assert.lte(byA[0].latency.percentiles.p50, byA[0].latency.percentiles.p99, byA);
+assert.lte(byA[0].firstSeen, byA[0].lastSeen, byA);
+
+assert.eq(1, byB[0].executions, byB);
+assert.eq(100, byB[0].docsExamined, byB);
+
+// Nothing is recorded with a sample rate of 0.
+assert.commandWorked(adminDB.runCommand({setParameter: 1, queryStatsSampleRate: 0}));
+assert.eq(1, coll.find({b: 4}).itcount());
+assert.eq(1, getQueryStats().filter((entry) => entry.planSummary === "COLLSCAN")[0].executions);
+
+MongoRunner.stopMongod(conn);
+})();
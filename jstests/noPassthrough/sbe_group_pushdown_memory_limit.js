@@ -0,0 +1,67 @@
+/**
+ * Tests that a $group pushed down to SBE honors the $group memory limit in the same way as the
+ * classic $group: it fails with QueryExceededMemoryLimitNoDiskUseAllowed when disk use is not
+ * allowed, and produces the same results as the classic engine when it is.
+ */
+(function() {
+"use strict";
+
+const nGroups = 500;
+const pipelines = {
+    minMax: [{$group: {_id: "$g", lo: {$min: "$v"}, hi: {$max: "$v"}}}],
+    push: [{$group: {_id: "$g", all: {$push: "$s"}}}],
+    firstLast: [{$group: {_id: "$g", first: {$first: "$s"}, last: {$last: "$s"}}}],
+    addToSet: [{$group: {_id: "$g", set: {$addToSet: "$s"}}}],
+};
+
+/**
+ * Starts a mongod with the given SBE setting and a small $group memory limit, loads the test
+ * collection and returns the results of every pipeline run with allowDiskUse, sorted by group.
+ */
+function runPipelines(sbe) {
+    const conn = MongoRunner.runMongod({
+        setParameter: {featureFlagSBE: sbe, internalDocumentSourceGroupMaxMemoryBytes: 64 * 1024}
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+    const db = conn.getDB("test");
+    const coll = db.sbe_group_pushdown_memory_limit;
+
+    const bigStr = "x".repeat(1024);
+    const bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 2000; i++) {
+        bulk.insert({_id: i, g: i % nGroups, v: i, s: bigStr + i});
+    }
+    assert.commandWorked(bulk.execute());
+
+    const results = {};
+    for (const [name, pipeline] of Object.entries(pipelines)) {
+        // The groups together exceed the memory limit, so without disk use the query must fail
+        // whichever engine runs the $group.
+        assert.commandFailedWithCode(
+            db.runCommand(
+                {aggregate: coll.getName(), pipeline: pipeline, cursor: {}, allowDiskUse: false}),
+            ErrorCodes.QueryExceededMemoryLimitNoDiskUseAllowed,
+            name);
+
+        // With disk use allowed, the $group spills and returns every group. The order of the
+        // elements of a $addToSet is unspecified, so they are sorted before comparing.
+        results[name] = coll.aggregate(pipeline, {allowDiskUse: true}).toArray();
+        assert.eq(results[name].length, nGroups, name);
+        for (const doc of results[name]) {
+            if (doc.set) {
+                doc.set.sort();
+            }
+        }
+        results[name].sort((a, b) => a._id - b._id);
+    }
+
+    MongoRunner.stopMongod(conn);
+    return results;
+}
+
+const sbeResults = runPipelines(true);
+const classicResults = runPipelines(false);
+for (const name of Object.keys(pipelines)) {
+    assert.eq(sbeResults[name], classicResults[name], name);
+}
+})();
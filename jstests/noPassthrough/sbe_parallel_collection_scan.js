@@ -0,0 +1,129 @@
+/**
+ * Tests that a find with '$_internalParallelism' splits its collection scan across threads only
+ * when that is safe, and that it returns the same documents as a serial scan.
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions:
+        {setParameter: {featureFlagSBE: true, internalQuerySlotBasedExecutionMaxParallelism: 4}}
+});
+rst.startSet();
+rst.initiate();
+const conn = rst.getPrimary();
+
+const db = conn.getDB("test");
+const coll = db.sbe_parallel_collection_scan;
+coll.drop();
+
+const nDocs = 20000;
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < nDocs; i++) {
+    bulk.insert({_id: i, a: i % 17, b: "x".repeat(i % 100)});
+}
+assert.commandWorked(bulk.execute());
+
+/**
+ * Runs the find command 'cmd' to completion and returns its documents.
+ */
+function runFind(cmd, session) {
+    const testDB = session ? session.getDatabase(db.getName()) : db;
+    const res = assert.commandWorked(testDB.runCommand(Object.assign({batchSize: 1000}, cmd)));
+    return new DBCommandCursor(testDB, res).toArray();
+}
+
+/**
+ * Returns whether the SBE plan of 'cmd' scans the collection in parallel.
+ */
+function usesParallelScan(cmd) {
+    const explain = assert.commandWorked(db.runCommand({explain: cmd}));
+    const plan = explain.queryPlanner.winningPlan;
+    assert(plan.hasOwnProperty("slotBasedPlan"), explain);
+    return plan.slotBasedPlan.stages.includes("exchange");
+}
+
+function sortById(docs) {
+    return docs.sort((a, b) => a._id - b._id);
+}
+
+const filters = [{}, {a: 3}, {a: {$lt: 5}, b: {$ne: ""}}, {nonexistent: 1}];
+for (const filter of filters) {
+    const serialCmd = {find: coll.getName(), filter: filter};
+    const parallelCmd = Object.assign({$_internalParallelism: 4}, serialCmd);
+
+    assert(!usesParallelScan(serialCmd), filter);
+    assert(usesParallelScan(parallelCmd), filter);
+
+    // Each document must be returned exactly once, as by the serial scan.
+    const serialDocs = runFind(serialCmd);
+    const parallelDocs = sortById(runFind(parallelCmd));
+    assert.eq(sortById(serialDocs), parallelDocs, filter);
+}
+
+// A limit on top of a parallel scan returns the right number of distinct matching documents.
+const limited =
+    runFind({find: coll.getName(), filter: {a: 1}, limit: 50, $_internalParallelism: 4});
+assert.eq(50, limited.length);
+assert.eq(50, new Set(limited.map(doc => doc._id)).size);
+limited.forEach(doc => assert.eq(1, doc.a, doc));
+
+// Scans which rely on the natural order of the collection stay serial and keep that order.
+for (const option of [{sort: {$natural: 1}}, {hint: {$natural: 1}}]) {
+    const cmd = Object.assign({find: coll.getName(), $_internalParallelism: 4}, option);
+    assert(!usesParallelScan(cmd), option);
+    assert.eq(runFind(Object.assign({find: coll.getName()}, option)), runFind(cmd), option);
+}
+
+// Reads at a read concern other than local, or at a point in time, stay serial since the producers
+// would not read from the snapshot of the operation. At a point in time before the last write, the
+// scan must not see that write.
+const writeTime = assert
+                      .commandWorked(db.runCommand({
+                          insert: coll.getName(),
+                          documents: [{_id: nDocs}],
+                          writeConcern: {w: "majority"}
+                      }))
+                      .operationTime;
+for (const readConcern of [{level: "majority"},
+                           {level: "snapshot"},
+                           {level: "snapshot", atClusterTime: writeTime}]) {
+    const docs =
+        runFind({find: coll.getName(), readConcern: readConcern, $_internalParallelism: 4});
+    assert.eq(nDocs + 1, docs.length, readConcern);
+    assert.eq(nDocs + 1, new Set(docs.map(doc => doc._id)).size, readConcern);
+}
+const beforeWrite = Timestamp(writeTime.getTime(), writeTime.getInc() - 1);
+assert.eq(
+    nDocs,
+    runFind({
+        find: coll.getName(),
+        readConcern: {level: "snapshot", atClusterTime: beforeWrite},
+        $_internalParallelism: 4
+    }).length);
+assert.commandWorked(coll.remove({_id: nDocs}));
+
+// So do reads in a multi-document transaction, which must see the writes of the transaction.
+const session = db.getMongo().startSession();
+session.startTransaction();
+const sessionColl = session.getDatabase(db.getName()).getCollection(coll.getName());
+assert.commandWorked(sessionColl.insert({_id: nDocs, a: 100}));
+const txnDocs =
+    runFind({find: coll.getName(), filter: {a: 100}, $_internalParallelism: 4}, session);
+assert.eq([{_id: nDocs, a: 100}], txnDocs);
+assert.commandWorked(session.abortTransaction_forTesting());
+session.endSession();
+
+// Neither is a tailable scan of a capped collection split.
+const capped = db.sbe_parallel_collection_scan_capped;
+capped.drop();
+assert.commandWorked(db.createCollection(capped.getName(), {capped: true, size: 1024 * 1024}));
+assert.commandWorked(capped.insert([{_id: 0}, {_id: 1}, {_id: 2}]));
+assert(!usesParallelScan({find: capped.getName(), $_internalParallelism: 4}));
+const tailable =
+    runFind({find: capped.getName(), tailable: true, awaitData: false, $_internalParallelism: 4});
+assert.eq([{_id: 0}, {_id: 1}, {_id: 2}], tailable);
+
+rst.stopSet();
+})();
@@ -0,0 +1,47 @@
+/**
+ * Tests that, with 'serverStatusExpensiveSectionRefreshMillis' set, the wiredTiger section of
+ * serverStatus is served from the last time it was generated until the interval has passed, unless
+ * it is asked for with options.
+ *
+ * @tags: [requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {serverStatusExpensiveSectionRefreshMillis: 60 * 60 * 1000}});
+const testDB = conn.getDB(jsTestName());
+const adminDB = conn.getDB("admin");
+
+const getTransactionBegins = function(cmd) {
+    const res = assert.commandWorked(adminDB.runCommand(cmd));
+    return res.wiredTiger.transaction["transaction begins"];
+};
+
+const cachedBegins = getTransactionBegins({serverStatus: 1});
+for (let i = 0; i < 10; ++i) {
+    assert.commandWorked(testDB.coll.insert({_id: i}));
+}
+
+// The section is served as it was generated, whether it is included by default or asked for.
+assert.eq(getTransactionBegins({serverStatus: 1}), cachedBegins);
+assert.eq(getTransactionBegins({serverStatus: 1, wiredTiger: 1}), cachedBegins);
+assert.eq(getTransactionBegins({serverStatus: 1, wiredTiger: true}), cachedBegins);
+
+// The other sections are still generated for every command.
+const opcounters = assert.commandWorked(adminDB.runCommand({serverStatus: 1})).opcounters;
+assert.gte(opcounters.insert, 10, tojson(opcounters));
+
+// Asking for the section with options generates it.
+assert.gt(getTransactionBegins({serverStatus: 1, wiredTiger: {}}), cachedBegins);
+
+// Setting the interval to 0 generates the section for every command.
+assert.commandWorked(
+    adminDB.runCommand({setParameter: 1, serverStatusExpensiveSectionRefreshMillis: 0}));
+const freshBegins = getTransactionBegins({serverStatus: 1});
+assert.gt(freshBegins, cachedBegins);
+assert.commandWorked(testDB.coll.insert({_id: 10}));
+assert.gt(getTransactionBegins({serverStatus: 1}), freshBegins);
+
+MongoRunner.stopMongod(conn);
+})();
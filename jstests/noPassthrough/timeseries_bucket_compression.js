@@ -0,0 +1,106 @@
+/**
+ * Tests that the buckets of a time-series collection are compressed once they are full when
+ * featureFlagTimeseriesBucketCompression is enabled, and only then, and that the measurements of
+ * compressed buckets are still returned by queries.
+ *
+ * @tags: [requires_fcv_50]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+
+const bucketMaxCount = 10;
+const timeFieldName = "time";
+const metaFieldName = "meta";
+
+function runTest(compressionEnabled) {
+    const conn = MongoRunner.runMongod({
+        setParameter: {
+            featureFlagTimeseriesBucketCompression: compressionEnabled,
+            timeseriesBucketMaxCount: bucketMaxCount
+        }
+    });
+    assert.neq(null, conn, "mongod was unable to start up");
+
+    if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+        jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+        MongoRunner.stopMongod(conn);
+        return;
+    }
+
+    const testDB = conn.getDB(jsTestName());
+    const coll = testDB.t;
+    const bucketsColl = testDB.system.buckets.t;
+    assert.commandWorked(testDB.createCollection(
+        coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+    const start = ISODate();
+    const makeDoc = (i, meta) => ({
+        _id: i,
+        [timeFieldName]: new Date(start.getTime() + i * 1000),
+        [metaFieldName]: meta,
+        x: i,
+        s: "abc",
+    });
+
+    // Insert the measurements for meta 0 one at a time, which commits each bucket on its own. This
+    // fills one bucket and rolls over to a new one.
+    const docs = [];
+    for (let i = 0; i < bucketMaxCount + 3; i++) {
+        docs.push(makeDoc(i, 0));
+        assert.commandWorked(coll.insert(docs[docs.length - 1]));
+    }
+
+    // Insert measurements for meta 1 at once with an ordered insert, which commits all buckets
+    // atomically, and then some more one at a time. This fills two buckets.
+    const batch = [];
+    for (let i = 100; i < 100 + bucketMaxCount + 2; i++) {
+        batch.push(makeDoc(i, 1));
+    }
+    assert.commandWorked(coll.insert(batch, {ordered: true}));
+    docs.push(...batch);
+    for (let i = 200; i < 200 + bucketMaxCount; i++) {
+        docs.push(makeDoc(i, 1));
+        assert.commandWorked(coll.insert(docs[docs.length - 1]));
+    }
+
+    // The three full buckets are compressed, while the buckets still open are not.
+    const buckets = bucketsColl.find().toArray();
+    let numFull = 0;
+    for (const bucket of buckets) {
+        const timeColumn = bucket.data[timeFieldName];
+        const isCompressed = timeColumn instanceof BinData;
+        for (const column of Object.values(bucket.data)) {
+            assert.eq(isCompressed, column instanceof BinData, tojson(bucket));
+        }
+        if (isCompressed) {
+            assert(compressionEnabled, tojson(bucket));
+            assert.eq(2, bucket.control.version, tojson(bucket));
+            assert.eq(128, timeColumn.subtype(), tojson(bucket));
+            numFull++;
+        } else {
+            assert.eq(1, bucket.control.version, tojson(bucket));
+            if (Object.keys(timeColumn).length === bucketMaxCount) {
+                assert(!compressionEnabled, tojson(bucket));
+                numFull++;
+            }
+        }
+    }
+    assert.eq(3, numFull, tojson(buckets));
+    assert.eq(5, buckets.length, tojson(buckets));
+
+    // Every measurement is returned, whether its bucket is compressed or not.
+    assert.sameMembers(docs, coll.find().toArray());
+    assert.sameMembers(docs.filter(doc => doc.x >= 3 && doc.x < 15),
+                       coll.find({x: {$gte: 3, $lt: 15}}).toArray());
+    assert.sameMembers(docs.filter(doc => doc[metaFieldName] === 1),
+                       coll.find({[metaFieldName]: 1}).toArray());
+    assert.eq(docs.length, coll.aggregate([{$count: "n"}]).toArray()[0].n);
+
+    MongoRunner.stopMongod(conn);
+}
+
+runTest(false);
+runTest(true);
+})();
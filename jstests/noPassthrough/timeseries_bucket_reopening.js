@@ -0,0 +1,97 @@
+/**
+ * Tests that inserts into a time-series collection add to a recent bucket on disk, rather than
+ * starting a new one, after a restart, and that buckets whose time range does not cover the
+ * measurement are left alone.
+ *
+ * @tags: [requires_fcv_49, requires_persistence]
+ */
+(function() {
+"use strict";
+
+load("jstests/core/timeseries/libs/timeseries.js");
+
+let conn = MongoRunner.runMongod({setParameter: {timeseriesBucketReopeningEnabled: true}});
+
+if (!TimeseriesTest.timeseriesCollectionsEnabled(conn)) {
+    jsTestLog("Skipping test because the time-series collection feature flag is disabled");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+const dbName = jsTestName();
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+const start = ISODate();
+
+const testDB = function() {
+    return conn.getDB(dbName);
+};
+const coll = function() {
+    return testDB().getCollection('t');
+};
+const bucketsColl = function() {
+    return testDB().getCollection('system.buckets.t');
+};
+
+const restart = function() {
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod({
+        dbpath: conn.dbpath,
+        noCleanData: true,
+        setParameter: {timeseriesBucketReopeningEnabled: true}
+    });
+    assert(conn);
+};
+
+const insert = function(id, secondsFromStart, meta) {
+    assert.commandWorked(coll().insert({
+        _id: id,
+        [timeFieldName]: new Date(start.getTime() + secondsFromStart * 1000),
+        [metaFieldName]: meta
+    }));
+};
+
+const checkBuckets = function(meta, expectedCounts) {
+    const buckets = bucketsColl().find({meta: meta}).sort({_id: 1}).toArray();
+    assert.eq(buckets.map(bucket => Object.keys(bucket.data[timeFieldName]).length),
+              expectedCounts,
+              tojson(buckets));
+};
+
+assert.commandWorked(testDB().createCollection(
+    coll().getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+insert(0, 0, {a: 1});
+insert(1, 1, {a: 1});
+insert(2, 0, 2);
+restart();
+
+// The buckets written before the restart are added to.
+insert(3, 2, {a: 1});
+insert(4, 1, 2);
+checkBuckets({a: 1}, [3]);
+checkBuckets(2, [2]);
+let stats = assert.commandWorked(coll().stats()).timeseries;
+assert.eq(stats.numBucketsReopened, 2, tojson(stats));
+assert.eq(stats.numBucketUpdates, 2, tojson(stats));
+assert.eq(stats.numBucketInserts, 0, tojson(stats));
+restart();
+
+// A measurement earlier than the bucket's range, or past its span, starts a new bucket.
+insert(5, -1, 2);
+checkBuckets(2, [1, 2]);
+restart();
+insert(6, 2 * 60 * 60, {a: 1});
+checkBuckets({a: 1}, [3, 1]);
+
+// Nothing is reopened with reopening disabled.
+restart();
+assert.commandWorked(
+    testDB().adminCommand({setParameter: 1, timeseriesBucketReopeningEnabled: false}));
+insert(7, 3, {a: 1});
+checkBuckets({a: 1}, [3, 1, 1]);
+
+assert.docEq(coll().find({}, {_id: 1}).sort({_id: 1}).toArray(),
+             [0, 1, 2, 3, 4, 5, 6, 7].map(id => ({_id: id})));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -46,6 +46,7 @@ const clearCollection = function() {
     expectedStats.numBucketInserts = 0;
     expectedStats.numBucketUpdates = 0;
     expectedStats.numBucketsOpenedDueToMetadata = 0;
+    expectedStats.numBucketsReopened = 0;
     expectedStats.numBucketsClosedDueToCount = 0;
     expectedStats.numBucketsClosedDueToSize = 0;
     expectedStats.numBucketsClosedDueToTimeForward = 0;
@@ -0,0 +1,76 @@
+/**
+ * Tests that the TTL monitor deletes expired documents in batches from several TTL indexes at once,
+ * and reports what it did for each TTL index in the "ttl" serverStatus section.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({
+    nodes: 1,
+    nodeOptions:
+        {setParameter: {ttlMonitorSleepSecs: 1, ttlMonitorBatchSize: 16, ttlMonitorConcurrency: 3}}
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+
+assert.commandFailedWithCode(db.adminCommand({setParameter: 1, ttlMonitorBatchSize: 0}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.adminCommand({setParameter: 1, ttlMonitorConcurrency: 0}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(
+    db.adminCommand({setParameter: 1, ttlMonitorMaxReplicationLagSecs: -1}), ErrorCodes.BadValue);
+
+// The "ttl" section is only reported on request.
+assert(!assert.commandWorked(db.serverStatus()).hasOwnProperty("ttl"));
+
+function waitForTTLPasses(numPasses) {
+    const ttlPasses = db.serverStatus().metrics.ttl.passes;
+    assert.soon(() => db.serverStatus().metrics.ttl.passes >= ttlPasses + numPasses,
+                "TTL monitor didn't run before timing out.");
+}
+
+// Stop the TTL monitor from deleting anything while the collections are filled.
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: false}));
+
+const numColls = 4;
+const numDocs = 500;
+const past = new Date(0);
+for (let i = 0; i < numColls; ++i) {
+    const coll = db.getCollection("coll" + i);
+    assert.commandWorked(coll.createIndex({expireAt: 1}, {expireAfterSeconds: 0}));
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let j = 0; j < numDocs; ++j) {
+        bulk.insert({_id: j, expireAt: past});
+    }
+    // One document which does not expire.
+    bulk.insert({_id: numDocs, expireAt: new Date(Date.now() + 24 * 60 * 60 * 1000)});
+    assert.commandWorked(bulk.execute());
+}
+
+assert.commandWorked(db.adminCommand({setParameter: 1, ttlMonitorEnabled: true}));
+waitForTTLPasses(2);
+
+const stats = assert.commandWorked(db.serverStatus({ttl: 1})).ttl;
+for (let i = 0; i < numColls; ++i) {
+    const coll = db.getCollection("coll" + i);
+    assert.eq(1, coll.find().itcount());
+
+    const indexStats = stats[coll.getFullName()]["expireAt_1"];
+    assert.gte(indexStats.passes, 1, tojson(stats));
+    assert.eq(indexStats.deletedDocuments, numDocs, tojson(stats));
+    assert.eq(indexStats.stoppedForReplicationLag, 0, tojson(stats));
+}
+
+// A dropped collection is no longer reported.
+assert(db.coll0.drop());
+waitForTTLPasses(2);
+assert(!assert.commandWorked(db.serverStatus({ttl: 1}))
+            .ttl.hasOwnProperty(db.coll0.getFullName()));
+
+rst.stopSet();
+})();
@@ -0,0 +1,60 @@
+/**
+ * Tests that $unionWith returns the same results, in the same order, when it dispatches its
+ * sub-pipeline before reading its input, including when the input is not read to the end.
+ *
+ * @tags: [
+ *   requires_replication,
+ *   requires_sharding,
+ * ]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, mongos: 1, config: 1});
+const dbName = jsTestName();
+const testDB = st.s.getDB(dbName);
+assert.commandWorked(st.s.adminCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+
+const months = ["jan", "feb", "mar", "apr", "may"];
+for (let month of months) {
+    const coll = testDB[month];
+    assert.commandWorked(
+        st.s.adminCommand({shardCollection: coll.getFullName(), key: {_id: 1}}));
+    assert.commandWorked(st.s.adminCommand({split: coll.getFullName(), middle: {_id: 50}}));
+    assert.commandWorked(st.s.adminCommand(
+        {moveChunk: coll.getFullName(), find: {_id: 50}, to: st.shard1.shardName}));
+    let docs = [];
+    for (let i = 0; i < 100; ++i) {
+        docs.push({_id: i, month: month});
+    }
+    assert.commandWorked(coll.insert(docs));
+}
+assert.commandWorked(testDB.unsharded.insert([{_id: 0, month: "none"}]));
+
+const pipeline = [{$sort: {_id: 1}}].concat(months.slice(1).map(
+    month => ({$unionWith: {coll: month, pipeline: [{$sort: {_id: 1}}]}})));
+pipeline.push({$unionWith: "unsharded"});
+
+function setEager(eager) {
+    for (let conn of [st.s, st.rs0.getPrimary(), st.rs1.getPrimary()]) {
+        assert.commandWorked(conn.adminCommand(
+            {setParameter: 1, internalQueryUnionWithDispatchSubPipelineEagerly: eager}));
+    }
+}
+
+setEager(false);
+const expected = testDB.jan.aggregate(pipeline).toArray();
+assert.eq(expected.length, 5 * 100 + 1, tojson(expected));
+const expectedLimited = testDB.jan.aggregate(pipeline.concat([{$limit: 10}])).toArray();
+
+setEager(true);
+assert.eq(testDB.jan.aggregate(pipeline).toArray(), expected);
+assert.eq(testDB.jan.aggregate(pipeline, {cursor: {batchSize: 2}}).toArray(), expected);
+assert.eq(testDB.jan.aggregate(pipeline.concat([{$limit: 10}])).toArray(), expectedLimited);
+
+// Explain does not dispatch the sub-pipelines early.
+assert.commandWorked(testDB.jan.explain("executionStats").aggregate(pipeline));
+
+st.stop();
+})();
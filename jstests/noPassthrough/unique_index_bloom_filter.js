@@ -0,0 +1,53 @@
+/**
+ * Tests that unique indexes still reject duplicate keys when
+ * 'wiredTigerUniqueIndexBloomFilterBitsPerKey' lets inserts of new keys skip the duplicate key
+ * lookup, both for indexes built while the server is running and for indexes opened at startup.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const options = {setParameter: {wiredTigerUniqueIndexBloomFilterBitsPerKey: 10}};
+let conn = MongoRunner.runMongod(options);
+let coll = conn.getDB("test").unique_index_bloom_filter;
+
+assert.commandWorked(coll.insert({_id: 0, a: 0}));
+assert.commandWorked(coll.createIndex({a: 1}, {unique: true}));
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 1; i < 1000; i++) {
+    bulk.insert({_id: i, a: i});
+}
+assert.commandWorked(bulk.execute());
+assert.commandFailedWithCode(coll.insert({a: 500}), ErrorCodes.DuplicateKey);
+
+// A key that was removed may be inserted again.
+assert.commandWorked(coll.remove({a: 10}));
+assert.commandWorked(coll.insert({_id: 10, a: 10}));
+assert.commandFailedWithCode(coll.insert({a: 10}), ErrorCodes.DuplicateKey);
+
+// An index built from existing data filters every key it was built with.
+for (let i = 0; i < 10; i++) {
+    assert.commandWorked(coll.update({_id: i}, {$set: {b: i}}));
+}
+assert.commandWorked(coll.createIndex({b: 1}, {unique: true, sparse: true}));
+assert.commandFailedWithCode(coll.insert({b: 2}), ErrorCodes.DuplicateKey);
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod(Object.merge(options, {dbpath: conn.dbpath, noCleanData: true}));
+coll = conn.getDB("test").unique_index_bloom_filter;
+
+// The filters rebuilt at startup hold the keys that were already in the indexes.
+for (let i = 0; i < 1000; i += 100) {
+    assert.commandFailedWithCode(coll.insert({a: i}), ErrorCodes.DuplicateKey);
+}
+assert.commandFailedWithCode(coll.insert({b: 2}), ErrorCodes.DuplicateKey);
+assert.commandWorked(coll.insert({_id: 1000, a: 1000}));
+assert.commandFailedWithCode(coll.insert({a: 1000}), ErrorCodes.DuplicateKey);
+
+assert.eq(1001, coll.find().itcount());
+const res = assert.commandWorked(coll.validate({full: true}));
+assert(res.valid, tojson(res));
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,56 @@
+/**
+ * Tests that a multi-update which writes its documents in batches of
+ * 'internalUpdateMaxBatchSize' updates every matching document, maintains the secondary indexes,
+ * and logs one oplog entry per document with its own timestamp.
+ *
+ * @tags: [requires_replication]
+ */
+(function() {
+"use strict";
+
+const rst = new ReplSetTest({nodes: 2});
+rst.startSet({setParameter: {internalUpdateMaxBatchSize: 64}});
+rst.initiate();
+
+const primary = rst.getPrimary();
+const db = primary.getDB("test");
+const coll = db.update_multi_batched;
+
+assert.commandWorked(coll.createIndexes([{a: 1}, {b: 1}]));
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, a: i % 10, b: i});
+}
+assert.commandWorked(bulk.execute());
+
+// Moves the matching documents forward in the {b: 1} index, which the update may be scanning, so
+// each of them must still be updated exactly once.
+let res = assert.commandWorked(
+    coll.updateMany({b: {$gte: 0}, a: {$in: [0, 2, 4, 6, 8]}}, {$inc: {b: 10000}, $set: {c: 1}}));
+assert.eq(500, res.matchedCount);
+assert.eq(500, res.modifiedCount);
+assert.eq(500, coll.find({c: 1}).hint({b: 1}).itcount());
+assert.eq(500, coll.find({b: {$gte: 10000}}).hint({b: 1}).itcount());
+
+// Documents the update leaves unchanged are not counted as modified.
+res = assert.commandWorked(coll.updateMany({}, {$set: {c: 1}}));
+assert.eq(1000, res.matchedCount);
+assert.eq(500, res.modifiedCount);
+
+const entries = primary.getDB("local")
+                    .oplog.rs.find({ns: coll.getFullName(), op: "u"})
+                    .sort({$natural: 1})
+                    .toArray();
+assert.eq(1000, entries.length);
+for (let i = 1; i < entries.length; i++) {
+    assert.lt(
+        timestampCmp(entries[i - 1].ts, entries[i].ts), 0, tojson(entries.slice(i - 1, i + 1)));
+}
+
+const validateRes = assert.commandWorked(coll.validate({full: true}));
+assert(validateRes.valid, tojson(validateRes));
+
+rst.awaitReplication();
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+})();
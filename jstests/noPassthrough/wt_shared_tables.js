@@ -0,0 +1,56 @@
+/**
+ * Tests that collections and indexes created with 'wiredTigerSharedTables' enabled are stored in
+ * the shared WiredTiger tables and keep their contents apart, across drops and restarts.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+"use strict";
+
+const dbName = "wt_shared_tables";
+let conn = MongoRunner.runMongod({setParameter: {wiredTigerSharedTables: true}});
+let testDB = conn.getDB(dbName);
+
+const numCollections = 4;
+for (let c = 0; c < numCollections; c++) {
+    const coll = testDB["coll" + c];
+    assert.commandWorked(coll.createIndex({a: 1}));
+    assert.commandWorked(coll.createIndex({u: 1}, {unique: true}));
+    for (let i = 0; i <= c; i++) {
+        assert.commandWorked(coll.insert({_id: i, a: c, u: i}));
+    }
+    assert.commandFailedWithCode(coll.insert({_id: 100, a: c, u: 0}), ErrorCodes.DuplicateKey);
+
+    const stats = coll.stats({indexDetails: true});
+    assert(stats.wiredTiger.uri.includes("sharedRecordStores"), tojson(stats.wiredTiger));
+}
+
+function checkContents(db, collections) {
+    for (let c of collections) {
+        const coll = db["coll" + c];
+        assert.eq(c + 1, coll.find().itcount());
+        assert.eq(c + 1, coll.find({a: c}).hint({a: 1}).itcount());
+        assert.eq(0, coll.find({a: c + 1}).hint({a: 1}).itcount());
+        assert.eq({_id: c, a: c, u: c}, coll.find({u: c}).hint({u: 1}).next());
+    }
+}
+
+checkContents(testDB, [0, 1, 2, 3]);
+assert(testDB.coll1.drop());
+assert.commandWorked(testDB.coll2.dropIndex({a: 1}));
+assert.commandWorked(testDB.coll2.createIndex({a: 1}));
+checkContents(testDB, [0, 2, 3]);
+
+MongoRunner.stopMongod(conn);
+conn = MongoRunner.runMongod({
+    dbpath: conn.dbpath,
+    noCleanData: true,
+    setParameter: {wiredTigerSharedTables: true},
+});
+testDB = conn.getDB(dbName);
+checkContents(testDB, [0, 2, 3]);
+assert.eq(0, testDB.coll1.find().itcount());
+assert.commandWorked(testDB.coll1.insert({_id: 0, a: 1, u: 0}));
+assert.eq(1, testDB.coll1.find().itcount());
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,124 @@
+/**
+ * Tests that a collection created with the 'zstd-dict' block compressor gets a compressor of its
+ * own, that trainCompressionDictionary trains a dictionary for it, and that the pages written with
+ * and without the dictionary are read back after a restart and from a backup. Dictionary
+ * compression requires featureFlagZstdDictionaryCompression and the latest FCV.
+ *
+ * @tags: [requires_persistence, requires_wiredtiger]
+ */
+(function() {
+'use strict';
+
+load("jstests/libs/backup_utils.js");
+
+const dbName = jsTestName();
+const dictConfig = {
+    storageEngine: {wiredTiger: {configString: "block_compressor=zstd-dict"}}
+};
+const getCreationString = (coll) => assert.commandWorked(coll.stats()).wiredTiger.creationString;
+
+// Without the feature flag, the collection block compressor cannot default to 'zstd-dict', and
+// collections which ask for it are compressed with plain zstd.
+assert.eq(null,
+          MongoRunner.runMongod({
+              wiredTigerCollectionBlockCompressor: "zstd-dict",
+              setParameter: {featureFlagZstdDictionaryCompression: false}
+          }));
+let conn = MongoRunner.runMongod({setParameter: {featureFlagZstdDictionaryCompression: false}});
+assert.commandWorked(conn.getDB(dbName).createCollection("dict", dictConfig));
+assert(/block_compressor=zstd[,)]/.test(getCreationString(conn.getDB(dbName).dict)));
+MongoRunner.stopMongod(conn);
+
+const options = {
+    setParameter: {featureFlagZstdDictionaryCompression: true}
+};
+conn = MongoRunner.runMongod(options);
+
+const restart = function() {
+    MongoRunner.stopMongod(conn);
+    conn = MongoRunner.runMongod(Object.assign({dbpath: conn.dbpath, noCleanData: true}, options));
+    assert(conn);
+};
+
+const insertDocs = function(coll, start, count) {
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = start; i < start + count; ++i) {
+        bulk.insert({
+            _id: i,
+            customer: {name: "customer" + (i % 50), country: ["NZ", "FR", "BR"][i % 3]},
+            status: i % 7 == 0 ? "cancelled" : "shipped",
+            items: [{sku: "sku" + (i % 20), quantity: i % 5}],
+        });
+    }
+    assert.commandWorked(bulk.execute());
+};
+
+let testDB = conn.getDB(dbName);
+assert.commandWorked(testDB.createCollection("dict", dictConfig));
+assert.commandWorked(testDB.createCollection("plain"));
+
+const creationString = getCreationString(testDB.dict);
+assert(/block_compressor=zstd_dict_\d+/.test(creationString), creationString);
+
+// Below the latest FCV, new collections are compressed with plain zstd.
+assert.commandWorked(testDB.adminCommand({setFeatureCompatibilityVersion: lastLTSFCV}));
+assert.commandWorked(testDB.createCollection("downgraded", dictConfig));
+assert(/block_compressor=zstd[,)]/.test(getCreationString(testDB.downgraded)));
+assert.commandWorked(testDB.adminCommand({setFeatureCompatibilityVersion: latestFCV}));
+
+// A collection without a trained dictionary is restored from a backup too.
+assert.commandWorked(testDB.createCollection("untrained", dictConfig));
+assert.commandWorked(testDB.untrained.insert({_id: 0}));
+
+// Only collections created with the dictionary compressor can be trained.
+assert.commandFailedWithCode(testDB.runCommand({trainCompressionDictionary: "plain"}),
+                             ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(testDB.runCommand({trainCompressionDictionary: "missing"}),
+                             ErrorCodes.NamespaceNotFound);
+assert.commandFailedWithCode(
+    testDB.runCommand({trainCompressionDictionary: "dict", dictionarySize: 10}),
+    ErrorCodes.BadValue);
+
+// Pages written before any dictionary is trained are compressed without one.
+insertDocs(testDB.dict, 0, 5000);
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+const res = assert.commandWorked(
+    testDB.runCommand({trainCompressionDictionary: "dict", sampleSize: 2000}));
+assert.gt(res.numSamples, 0, tojson(res));
+assert.gt(res.dictionarySize, 0, tojson(res));
+
+insertDocs(testDB.dict, 5000, 5000);
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+
+// The dictionaries are loaded again on startup, so that every page can still be read.
+restart();
+testDB = conn.getDB(dbName);
+assert.eq(testDB.dict.find().itcount(), 10000);
+assert.eq(testDB.dict.find({status: "cancelled"}).itcount(), 1429);
+assert.commandWorked(testDB.dict.validate({full: true}));
+
+// A second dictionary takes over for the pages written from then on.
+assert.commandWorked(testDB.runCommand({trainCompressionDictionary: "dict"}));
+insertDocs(testDB.dict, 10000, 1000);
+restart();
+testDB = conn.getDB(dbName);
+assert.eq(testDB.dict.find().itcount(), 11000);
+assert.commandWorked(testDB.dict.validate({full: true}));
+
+// A backup taken through $backupCursor includes the dictionaries, so that a node started on it
+// reads every page.
+assert.commandWorked(testDB.adminCommand({fsync: 1}));
+const backupDbPath = MongoRunner.dataPath + jsTestName() + "_backup";
+backupData(conn, backupDbPath);
+MongoRunner.stopMongod(conn);
+
+conn = MongoRunner.runMongod(
+    Object.assign({dbpath: backupDbPath, noCleanData: true}, options));
+assert(conn);
+testDB = conn.getDB(dbName);
+assert.eq(testDB.dict.find().itcount(), 11000);
+assert.eq(testDB.untrained.find().itcount(), 1);
+assert.commandWorked(testDB.dict.validate({full: true}));
+MongoRunner.stopMongod(conn);
+}());
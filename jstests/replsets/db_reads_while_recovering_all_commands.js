@@ -95,6 +95,11 @@ const allCommands = {
         expectFailure: true,
         expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
     },
+    analyze: {
+        command: {analyze: collName, key: "a"},
+        expectFailure: true,
+        expectedErrorCode: ErrorCodes.NotPrimaryOrSecondary,
+    },
     appendOplogNote: {skip: isPrimaryOnly},
     applyOps: {skip: isPrimaryOnly},
     authenticate: {skip: isNotAUserDataRead},
@@ -184,6 +189,7 @@ const allCommands = {
     fsync: {skip: isNotAUserDataRead},
     fsyncUnlock: {skip: isNotAUserDataRead},
     getAuditConfig: {skip: isNotAUserDataRead},
+    getCPUProfile: {skip: isNotAUserDataRead},
     getCmdLineOpts: {skip: isNotAUserDataRead},
     getDatabaseVersion: {skip: isNotAUserDataRead},
     getDefaultRWConcern: {skip: isNotAUserDataRead},
@@ -309,8 +315,10 @@ const allCommands = {
     splitChunk: {skip: isPrimaryOnly},
     splitVector: {skip: isPrimaryOnly},
     stageDebug: {skip: isPrimaryOnly},
+    startCPUProfiler: {skip: isNotAUserDataRead},
     startRecordingTraffic: {skip: isNotAUserDataRead},
     startSession: {skip: isNotAUserDataRead},
+    stopCPUProfiler: {skip: isNotAUserDataRead},
     stopRecordingTraffic: {skip: isNotAUserDataRead},
     testDeprecation: {skip: isNotAUserDataRead},
     testDeprecationInVersion2: {skip: isNotAUserDataRead},
@@ -319,6 +327,7 @@ const allCommands = {
     testVersions1And2: {skip: isNotAUserDataRead},
     testVersion2: {skip: isNotAUserDataRead},
     top: {skip: isNotAUserDataRead},
+    trainCompressionDictionary: {skip: isNotAUserDataRead},
     update: {skip: isPrimaryOnly},
     updateRole: {skip: isPrimaryOnly},
     updateUser: {skip: isPrimaryOnly},
@@ -0,0 +1,43 @@
+/**
+ * Tests that initial sync clones the collections of a database in parallel when
+ * 'initialSyncCollectionClonerConcurrency' is greater than one, and that the result matches the
+ * sync source.
+ */
+
+(function() {
+"use strict";
+
+const name = "initial_sync_parallel_collection_cloning";
+const rst = new ReplSetTest({name: name, nodes: 1});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const primaryDB = primary.getDB(name);
+const numCollections = 10;
+for (let c = 0; c < numCollections; c++) {
+    const bulk = primaryDB["coll" + c].initializeUnorderedBulkOp();
+    for (let i = 0; i < 500; i++) {
+        bulk.insert({_id: i, c: c});
+    }
+    assert.commandWorked(bulk.execute());
+    assert.commandWorked(primaryDB["coll" + c].createIndex({c: 1}));
+}
+
+const secondary = rst.add({
+    rsConfig: {priority: 0, votes: 0},
+    setParameter: {initialSyncCollectionClonerConcurrency: 4, collectionClonerBatchSize: 50},
+});
+rst.reInitiate();
+rst.awaitSecondaryNodes();
+rst.awaitReplication();
+
+secondary.setSecondaryOk();
+const secondaryDB = secondary.getDB(name);
+for (let c = 0; c < numCollections; c++) {
+    assert.eq(500, secondaryDB["coll" + c].find().itcount());
+    assert.eq(2, secondaryDB["coll" + c].getIndexes().length);
+}
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+})();
@@ -0,0 +1,48 @@
+/**
+ * Tests that a secondary which reads the documents targeted by each oplog batch before applying it
+ * replicates updates and deletes correctly, and reports the documents it prefetched.
+ */
+
+(function() {
+"use strict";
+
+const name = "oplog_batch_prefetch";
+const rst = new ReplSetTest({
+    name: name,
+    nodes: [{}, {rsConfig: {priority: 0}, setParameter: {replBatchPrefetchConcurrency: 4}}],
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const coll = primary.getDB(name).coll;
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({_id: i, x: 0});
+}
+assert.commandWorked(bulk.execute());
+rst.awaitReplication();
+
+bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    if (i % 10 === 0) {
+        bulk.find({_id: i}).removeOne();
+    } else {
+        bulk.find({_id: i}).updateOne({$inc: {x: 1}});
+    }
+}
+// An update of a missing document, which has nothing to prefetch.
+bulk.find({_id: 1000}).upsert().updateOne({$set: {x: 1}});
+assert.commandWorked(bulk.execute());
+rst.awaitReplication();
+
+const metrics = assert.commandWorked(secondary.adminCommand({serverStatus: 1})).metrics;
+assert.gt(metrics.repl.apply.prefetchedDocs, 0, tojson(metrics.repl.apply));
+
+secondary.setSecondaryOk();
+assert.eq(901, secondary.getDB(name).coll.find({x: 1}).itcount());
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+})();
@@ -27,13 +27,28 @@ for (let i = 0; i < maxOplogDocsForScanning + 1; i++) {
     assert.commandWorked(coll.insert({m: 1 + i}));
 }
 
-// Restart replica set to load entries from the oplog for sampling.
+// The truncation points stored on shutdown are loaded on the following start up.
 replSet.stopSet(null /* signal */, true /* forRestart */);
 replSet.startSet({restart: true});
 
 res = replSet.getPrimary().getDB("test").serverStatus();
 assert.commandWorked(res);
 
+assert.gt(res.oplogTruncation.totalTimeProcessingMicros, 0);
+assert.eq(res.oplogTruncation.processingMethod, "stored");
+
+// Restart replica set without the stored truncation points to load entries from the oplog for
+// sampling.
+replSet.stopSet(null /* signal */, true /* forRestart */);
+replSet.startSet({
+    restart: true,
+    setParameter:
+        {"maxOplogTruncationPointsDuringStartup": 10, "useStoredOplogTruncationPoints": false}
+});
+
+res = replSet.getPrimary().getDB("test").serverStatus();
+assert.commandWorked(res);
+
 assert.gt(res.oplogTruncation.totalTimeProcessingMicros, 0);
 assert.eq(res.oplogTruncation.processingMethod, "sampling");
 
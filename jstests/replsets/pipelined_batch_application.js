@@ -0,0 +1,49 @@
+/**
+ * Tests that a secondary which writes the next oplog batch to its oplog while still applying the
+ * current batch replicates writes correctly, including across commands that must be applied in
+ * their own batch.
+ */
+
+(function() {
+"use strict";
+
+const name = "pipelined_batch_application";
+const rst = new ReplSetTest({
+    name: name,
+    nodes: [{}, {rsConfig: {priority: 0}, setParameter: {replPipelinedBatchApplication: true}}],
+    // Keep the batches small so that most of them are prefetched.
+    nodeOptions: {setParameter: {replBatchLimitOperations: 50}},
+});
+rst.startSet();
+rst.initiate();
+
+const primary = rst.getPrimary();
+const secondary = rst.getSecondary();
+const db = primary.getDB(name);
+
+for (let round = 0; round < 5; round++) {
+    const coll = db["coll" + round];
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < 1000; i++) {
+        bulk.insert({_id: i, x: 0});
+    }
+    assert.commandWorked(bulk.execute());
+
+    // Updates concentrated on a few documents, interleaved with an index build and a drop.
+    bulk = coll.initializeOrderedBulkOp();
+    for (let i = 0; i < 1000; i++) {
+        bulk.find({_id: i % 4}).updateOne({$inc: {x: 1}});
+    }
+    assert.commandWorked(bulk.execute());
+    assert.commandWorked(coll.createIndex({x: 1}));
+    if (round > 0) {
+        assert(db["coll" + (round - 1)].drop());
+    }
+}
+
+rst.awaitReplication();
+secondary.setSecondaryOk();
+assert.eq(250, secondary.getDB(name).coll4.findOne({_id: 0}).x);
+rst.checkReplicatedDataHashes();
+rst.stopSet();
+})();
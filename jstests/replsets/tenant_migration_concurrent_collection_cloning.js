@@ -0,0 +1,65 @@
+/**
+ * Tests a full tenant migration whose recipient clones several collections of a database at once,
+ * as set by 'tenantMigrationCollectionClonerConcurrency'.
+ *
+ * @tags: [requires_fcv_50, requires_majority_read_concern, incompatible_with_windows_tls,
+ * incompatible_with_eft, incompatible_with_macos, requires_persistence]
+ */
+
+(function() {
+"use strict";
+
+load("jstests/libs/uuid_util.js");
+load("jstests/replsets/libs/tenant_migration_test.js");
+
+const kConcurrency = 3;
+const tenantMigrationTest = new TenantMigrationTest({
+    name: jsTestName(),
+    sharedOptions: {
+        setParameter: {
+            tenantMigrationCollectionClonerConcurrency: kConcurrency,
+            collectionClonerBatchSize: 10,
+        }
+    }
+});
+if (!tenantMigrationTest.isFeatureFlagEnabled()) {
+    jsTestLog("Skipping test because the tenant migrations feature flag is disabled");
+    return;
+}
+const tenantId = "testTenantId";
+
+// More collections than are cloned at once, in a database of their own and in one alongside
+// another database.
+const tenantDBs = ["db0", "db1"].map(dbName => tenantMigrationTest.tenantDB(tenantId, dbName));
+const collNames = [...Array(7).keys()].map(i => "coll" + i);
+const docs = [...Array(100).keys()].map(i => ({_id: i, x: "x".repeat(i)}));
+for (const db of tenantDBs) {
+    for (const coll of collNames) {
+        tenantMigrationTest.insertDonorDB(db, coll, docs);
+    }
+}
+
+const migrationId = UUID();
+const migrationOpts = {
+    migrationIdString: extractUUIDFromObject(migrationId),
+    tenantId,
+};
+
+const stateRes = assert.commandWorked(tenantMigrationTest.runMigration(migrationOpts));
+assert.eq(stateRes.state, TenantMigrationTest.DonorState.kCommitted);
+
+for (const db of tenantDBs) {
+    for (const coll of collNames) {
+        tenantMigrationTest.verifyRecipientDB(
+            tenantId, db, coll, true /* migrationCommitted */, docs);
+    }
+}
+
+// The recipient records the concurrency it cloned with, for a resumed migration to use.
+const recipientDoc =
+    tenantMigrationTest.getRecipientPrimary().getCollection(TenantMigrationTest.kConfigRecipientsNS)
+        .findOne({_id: migrationId});
+assert.eq(recipientDoc.collectionClonerConcurrency, kConcurrency, tojson(recipientDoc));
+
+tenantMigrationTest.stop();
+})();
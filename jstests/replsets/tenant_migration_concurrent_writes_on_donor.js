@@ -516,6 +516,7 @@ const testCases = {
             assert(!collectionExists(db, collName + "Out"));
         }
     },
+    analyze: {skip: isNotWriteCommand},
     appendOplogNote: {skip: isNotRunOnUserDatabase},
     applyOps: {skip: isNotSupportedInServerless},
     authenticate: {skip: isAuthCommand},
@@ -765,6 +766,7 @@ const testCases = {
     flushRouterConfig: {skip: isNotRunOnUserDatabase},
     fsync: {skip: isNotRunOnUserDatabase},
     fsyncUnlock: {skip: isNotRunOnUserDatabase},
+    getCPUProfile: {skip: isNotRunOnUserDatabase},
     getCmdLineOpts: {skip: isNotRunOnUserDatabase},
     getDatabaseVersion: {skip: isNotRunOnUserDatabase},
     getDefaultRWConcern: {skip: isNotRunOnUserDatabase},
@@ -904,10 +906,13 @@ const testCases = {
     splitChunk: {skip: isNotRunOnUserDatabase},
     splitVector: {skip: isNotRunOnUserDatabase},
     stageDebug: {skip: isNotRunOnUserDatabase},
+    startCPUProfiler: {skip: isNotRunOnUserDatabase},
     startRecordingTraffic: {skip: isNotRunOnUserDatabase},
     startSession: {skip: isNotRunOnUserDatabase},
+    stopCPUProfiler: {skip: isNotRunOnUserDatabase},
     stopRecordingTraffic: {skip: isNotRunOnUserDatabase},
     top: {skip: isNotRunOnUserDatabase},
+    trainCompressionDictionary: {skip: isNotWriteCommand},
     update: {
         testInTransaction: true,
         testAsRetryableWrite: true,
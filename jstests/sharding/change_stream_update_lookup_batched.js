@@ -0,0 +1,91 @@
+// Tests that a 'fullDocument: "updateLookup"' change stream on a sharded collection returns the
+// correct post-image for every update when the post-images of consecutive updates are looked up
+// together, including updates to documents on different shards and documents which have since
+// been deleted. Also verifies that a stream resumed from the postBatchResumeToken of a batch which
+// ended while events were still buffered on mongos does not skip any events.
+// @tags: [
+//   requires_majority_read_concern,
+//   uses_change_streams,
+// ]
+(function() {
+"use strict";
+
+const st = new ShardingTest({
+    shards: 2,
+    rs: {nodes: 1, setParameter: {periodicNoopIntervalSecs: 1, writePeriodicNoops: true}}
+});
+
+const mongosDB = st.s0.getDB(jsTestName());
+const mongosColl = mongosDB[jsTestName()];
+
+// Shard the collection on {shardKey: 1} and split it so that negative keys live on shard0 and
+// non-negative keys on shard1.
+assert.commandWorked(mongosDB.adminCommand({enableSharding: mongosDB.getName()}));
+st.ensurePrimaryShard(mongosDB.getName(), st.shard0.shardName);
+assert.commandWorked(
+    mongosDB.adminCommand({shardCollection: mongosColl.getFullName(), key: {shardKey: 1}}));
+assert.commandWorked(
+    mongosDB.adminCommand({split: mongosColl.getFullName(), middle: {shardKey: 0}}));
+assert.commandWorked(mongosDB.adminCommand(
+    {moveChunk: mongosColl.getFullName(), find: {shardKey: 1}, to: st.shard1.shardName}));
+
+const kNumDocs = 20;
+for (let i = 0; i < kNumDocs; ++i) {
+    assert.commandWorked(mongosColl.insert({_id: i, shardKey: (i % 2 === 0 ? -i - 1 : i)}));
+}
+
+const startTime = assert.commandWorked(mongosDB.runCommand({ping: 1})).operationTime;
+const stream = mongosColl.watch([], {fullDocument: "updateLookup"});
+
+// Update every document, then delete the last one so that its update finds no post-image.
+for (let i = 0; i < kNumDocs; ++i) {
+    assert.commandWorked(mongosColl.update({_id: i}, {$set: {updated: i}}));
+}
+assert.commandWorked(mongosColl.remove({_id: kNumDocs - 1}));
+
+for (let i = 0; i < kNumDocs; ++i) {
+    assert.soon(() => stream.hasNext());
+    const event = stream.next();
+    assert.eq(event.operationType, "update", tojson(event));
+    assert.eq(event.documentKey._id, i, tojson(event));
+    if (i === kNumDocs - 1) {
+        assert.eq(event.fullDocument, null, tojson(event));
+    } else {
+        assert.docEq(event.fullDocument,
+                     {_id: i, shardKey: event.documentKey.shardKey, updated: i});
+    }
+}
+assert.soon(() => stream.hasNext());
+assert.eq(stream.next().operationType, "delete");
+stream.close();
+
+// Read the updates with a small batch size, so that each getMore ends while the post-image lookup
+// stage on mongos still holds events that it read ahead. Resuming from the postBatchResumeToken of
+// the first batch must return the event following that batch.
+const cmdRes = assert.commandWorked(mongosDB.runCommand({
+    aggregate: mongosColl.getName(),
+    pipeline: [{$changeStream: {fullDocument: "updateLookup", startAtOperationTime: startTime}}],
+    cursor: {batchSize: 0}
+}));
+let cursor = cmdRes.cursor;
+let seenIds = [];
+assert.soon(() => {
+    const getMoreRes = assert.commandWorked(mongosDB.runCommand(
+        {getMore: cursor.id, collection: mongosColl.getName(), batchSize: 3}));
+    cursor = getMoreRes.cursor;
+    const updates = cursor.nextBatch.filter((event) => event.operationType === "update");
+    seenIds = updates.map((event) => event.documentKey._id);
+    return seenIds.length > 0;
+});
+assert.commandWorked(
+    mongosDB.runCommand({killCursors: mongosColl.getName(), cursors: [cursor.id]}));
+
+const resumedStream = mongosColl.watch(
+    [{$match: {operationType: "update"}}],
+    {fullDocument: "updateLookup", resumeAfter: cursor.postBatchResumeToken});
+assert.soon(() => resumedStream.hasNext());
+assert.eq(resumedStream.next().documentKey._id, seenIds[seenIds.length - 1] + 1);
+resumedStream.close();
+
+st.stop();
+})();
@@ -0,0 +1,76 @@
+/**
+ * Tests that with readHedgingDelayPercentile set, mongos only sends the additional request of a
+ * hedged read once the first target is slower than usual, and that the reads still succeed.
+ */
+(function() {
+"use strict";
+
+function setCommandDelay(nodeConn, command, delay, ns) {
+    assert.commandWorked(nodeConn.adminCommand({
+        configureFailPoint: "failCommand",
+        mode: {times: 1},
+        data: {
+            failInternalCommands: true,
+            blockConnection: true,
+            blockTimeMS: delay,
+            failCommands: [command],
+            namespace: ns
+        },
+    }));
+}
+
+const st = new ShardingTest({
+    mongos: [{
+        setParameter: {
+            // Force the mongos's replica set monitors to always include all the eligible nodes.
+            "failpoint.sdamServerSelectorIgnoreLatencyWindow": tojson({mode: "alwaysOn"}),
+            readHedgingDelayPercentile: 90,
+            readHedgingTargetLatencyPercentile: 95,
+            maxTimeMSForHedgedReads: 10 * 1000,
+        }
+    }],
+    shards: 1,
+    rs: {nodes: 2},
+});
+const dbName = "hedged_reads_deferred";
+const collName = "test";
+const ns = dbName + "." + collName;
+const testDB = st.s.getDB(dbName);
+
+assert.commandWorked(testDB[collName].insert({x: 1}, {writeConcern: {w: 2}}));
+
+function runHedgedCount() {
+    const res = assert.commandWorked(testDB.runCommand(
+        {count: collName, query: {x: {$gte: 0}}, $readPreference: {mode: "nearest"}}));
+    assert.eq(1, res.n, tojson(res));
+}
+
+function getHedgingMetrics() {
+    return assert.commandWorked(st.s.adminCommand({serverStatus: 1})).hedgingMetrics;
+}
+
+jsTest.log("Learn the latencies of both nodes, then verify that fast reads skip the hedge");
+assert.soon(() => {
+    for (let i = 0; i < 20; i++) {
+        runHedgedCount();
+    }
+    return getHedgingMetrics().numDeferredHedgesSkipped > 0;
+}, () => "expected some hedged requests to be skipped: " + tojson(getHedgingMetrics()));
+
+jsTest.log("Verify that a read on a slow node is still answered by the other node");
+const before = getHedgingMetrics();
+for (let node of st.rs0.nodes) {
+    setCommandDelay(node, "count", 1000, ns);
+}
+// Each node delays one count, so at least one of these reads is slow on its first target.
+for (let i = 0; i < 2; i++) {
+    runHedgedCount();
+}
+const after = getHedgingMetrics();
+assert.gt(after.numTotalHedgedOperations, before.numTotalHedgedOperations, tojson(after));
+
+for (let node of st.rs0.nodes) {
+    assert.commandWorked(node.adminCommand({configureFailPoint: "failCommand", mode: "off"}));
+}
+st.stop();
+})();
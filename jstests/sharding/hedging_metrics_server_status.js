@@ -105,7 +105,8 @@ let sortedNodes = [...st.rs0.nodes].sort((node1, node2) => node1.host.localeComp
 let expectedHedgingMetrics = {
     numTotalOperations: 0,
     numTotalHedgedOperations: 0,
-    numAdvantageouslyHedgedOperations: 0
+    numAdvantageouslyHedgedOperations: 0,
+    numDeferredHedgesSkipped: 0
 };
 
 jsTestLog("Run a command with hedging disabled, and verify the metrics does not change");
@@ -7,4 +7,5 @@ const commandsRemovedFromMongodSinceLastLTS =
 // These commands were added in mongod since the last LTS version, so will not appear in the
 // listCommands output of a last LTS version mongod. We will allow these commands to have a
 // test defined without always existing on the mongod being used.
-const commandsAddedToMongodSinceLastLTS = ["rotateCertificates"];
+const commandsAddedToMongodSinceLastLTS =
+    ["getCPUProfile", "rotateCertificates", "startCPUProfiler", "stopCPUProfiler"];
@@ -11,8 +11,11 @@ const commandsAddedToMongosSinceLastLTS = [
     "abortReshardCollection",
     "cleanupReshardCollection",
     "commitReshardCollection",
+    "getCPUProfile",
     "reshardCollection",
     "rotateCertificates",
+    "startCPUProfiler",
+    "stopCPUProfiler",
     "testDeprecation",
     "testDeprecationInVersion2",
     "testRemoval",
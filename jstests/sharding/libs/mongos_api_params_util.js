@@ -484,6 +484,10 @@ let MongosAPIParametersUtil = (function() {
                 command: () => ({fsync: 1})
             }
         },
+        {
+            commandName: "getCPUProfile",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "getCmdLineOpts",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -1129,6 +1133,10 @@ let MongosAPIParametersUtil = (function() {
                 })
             }
         },
+        {
+            commandName: "startCPUProfiler",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "startRecordingTraffic",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -1137,6 +1145,10 @@ let MongosAPIParametersUtil = (function() {
             commandName: "startSession",
             skip: "executes locally on mongos (not sent to any remote node)"
         },
+        {
+            commandName: "stopCPUProfiler",
+            skip: "executes locally on mongos (not sent to any remote node)"
+        },
         {
             commandName: "stopRecordingTraffic",
             skip: "executes locally on mongos (not sent to any remote node)"
@@ -627,6 +627,16 @@ var ReshardingTest = class {
             `config.localReshardingOperations.recipient.progress_txn_cloner wasn't cleaned up on ${
                 recipient.shardName}`);
 
+        assert.eq(
+            [],
+            recipient
+                .getCollection(
+                    `config.localReshardingOperations.recipient.progress_collection_cloner`)
+                .find()
+                .toArray(),
+            "config.localReshardingOperations.recipient.progress_collection_cloner wasn't cleaned" +
+                ` up on ${recipient.shardName}`);
+
         const sourceCollectionUUIDString = extractUUIDFromObject(this._sourceCollectionUUID);
         for (const donor of this._donorShards()) {
             assert.eq(null,
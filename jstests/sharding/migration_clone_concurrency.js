@@ -0,0 +1,68 @@
+/**
+ * Tests that a chunk migration clones every document exactly once when the recipient fetches the
+ * initial clone over several concurrent _migrateClone requests, including for a jumbo chunk which
+ * the donor scans through a single index scan.
+ *
+ * @tags: [requires_fcv_51]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({
+    shards: 2,
+    other: {
+        shardOptions: {
+            setParameter: {
+                migrateCloneConcurrency: 4,
+                migrateCloneMaxBufferedBytes: 1024 * 1024,
+                migrateCloneInsertionBatchSize: 100,
+            }
+        }
+    }
+});
+
+const dbName = "test";
+const mongos = st.s0;
+const admin = mongos.getDB("admin");
+
+assert.commandWorked(admin.runCommand({enableSharding: dbName}));
+st.ensurePrimaryShard(dbName, st.shard0.shardName);
+
+function testMoveChunk(collName, forceJumbo) {
+    const ns = dbName + "." + collName;
+    const coll = mongos.getCollection(ns);
+    assert.commandWorked(admin.runCommand({shardCollection: ns, key: {_id: 1}}));
+
+    const numDocs = 20000;
+    const padding = "x".repeat(1024);
+    let bulk = coll.initializeUnorderedBulkOp();
+    for (let i = 0; i < numDocs; ++i) {
+        bulk.insert({_id: i, padding: padding});
+    }
+    assert.commandWorked(bulk.execute());
+
+    assert.commandWorked(admin.runCommand({
+        moveChunk: ns,
+        find: {_id: 0},
+        to: st.shard1.shardName,
+        forceJumbo: forceJumbo,
+        _waitForDelete: true
+    }));
+
+    const recipientColl = st.shard1.getCollection(ns);
+    assert.eq(numDocs, recipientColl.find().itcount());
+    assert.eq(numDocs, recipientColl.aggregate([{$group: {_id: "$_id"}}]).itcount());
+    assert.eq(0, st.shard0.getCollection(ns).find().itcount());
+    assert.eq(numDocs, coll.find().itcount());
+}
+
+testMoveChunk("regular", false);
+
+// Lower the maximum chunk size so that the chunk is too large to record its record ids on the
+// donor.
+assert.commandWorked(
+    mongos.getDB("config").settings.update({_id: "chunksize"}, {$set: {value: 1}}, {upsert: true}));
+testMoveChunk("jumbo", true);
+
+st.stop();
+})();
@@ -0,0 +1,48 @@
+/**
+ * Tests that the merging half of a split $group can be hash-partitioned across shards with an
+ * $exchange when 'internalQueryGroupMergeExchangeConsumers' is set, and that it produces the same
+ * groups as a merge on a single node.
+ *
+ * @tags: [requires_sharding]
+ */
+(function() {
+"use strict";
+
+const st = new ShardingTest({shards: 2, rs: {nodes: 1}});
+
+const mongosDB = st.s.getDB("test_db");
+const coll = mongosDB["coll"];
+
+st.shardColl(coll, {a: 1}, {a: 500}, {a: 500}, mongosDB.getName());
+
+let bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({a: i, b: i % 97});
+}
+assert.commandWorked(bulk.execute());
+
+const pipeline = [
+    {$group: {_id: "$b", count: {$sum: 1}}},
+    {$addFields: {twice: {$multiply: ["$count", 2]}}},
+];
+const sortById = (docs) => docs.sort((x, y) => x._id - y._id);
+
+const expected = sortById(coll.aggregate(pipeline).toArray());
+assert.eq(97, expected.length);
+
+assert.commandWorked(
+    st.s.adminCommand({setParameter: 1, internalQueryGroupMergeExchangeConsumers: 2}));
+
+const explain = coll.explain().aggregate(pipeline);
+assert(explain.splitPipeline.hasOwnProperty("exchange"), tojson(explain));
+assert.eq(explain.splitPipeline.exchange.policy, "keyRange", tojson(explain));
+assert.eq(explain.splitPipeline.exchange.consumers, 2, tojson(explain));
+
+assert.eq(expected, sortById(coll.aggregate(pipeline).toArray()));
+
+// A stage that needs to see every group keeps the merge on a single node.
+const sortedExplain = coll.explain().aggregate(pipeline.concat([{$sort: {count: 1}}]));
+assert(!sortedExplain.splitPipeline.hasOwnProperty("exchange"), tojson(sortedExplain));
+
+st.stop();
+})();
@@ -0,0 +1,99 @@
+/**
+ * Tests that the resharding collection cloner clones every document exactly once when it splits
+ * the collection into several _id ranges cloned concurrently, and that it resumes each range where
+ * it left off.
+ *
+ * @tags: [
+ *   requires_fcv_51,
+ *   uses_atclustertime,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/uuid_util.js");
+load("jstests/sharding/libs/create_sharded_collection_util.js");
+
+const st = new ShardingTest({
+    mongos: 1,
+    config: 1,
+    shards: 2,
+    rs: {nodes: 1},
+    rsOptions: {
+        setParameter: {
+            "failpoint.WTPreserveSnapshotHistoryIndefinitely": tojson({mode: "alwaysOn"}),
+            reshardingCollectionClonerReaderCount: 4,
+            reshardingCollectionClonerBatchSizeInBytes: 1024,
+        }
+    },
+});
+
+const inputCollection = st.s.getCollection("reshardingDb.coll");
+
+CreateShardedCollectionUtil.shardCollectionWithChunks(inputCollection, {oldKey: 1}, [
+    {min: {oldKey: MinKey}, max: {oldKey: 0}, shard: st.shard0.shardName},
+    {min: {oldKey: 0}, max: {oldKey: MaxKey}, shard: st.shard1.shardName},
+]);
+
+const inputCollectionUUID =
+    getUUIDFromListCollections(inputCollection.getDB(), inputCollection.getName());
+const inputCollectionUUIDString = extractUUIDFromObject(inputCollectionUUID);
+
+const temporaryReshardingCollection =
+    st.s.getCollection(`reshardingDb.system.resharding.${inputCollectionUUIDString}`);
+
+CreateShardedCollectionUtil.shardCollectionWithChunks(temporaryReshardingCollection, {newKey: 1}, [
+    {min: {newKey: MinKey}, max: {newKey: 0}, shard: st.shard0.shardName},
+    {min: {newKey: 0}, max: {newKey: MaxKey}, shard: st.shard1.shardName},
+]);
+
+for (const shard of [st.shard0, st.shard1]) {
+    assert.commandWorked(shard.rs.getPrimary().adminCommand(
+        {_flushRoutingTableCacheUpdates: temporaryReshardingCollection.getFullName()}));
+}
+
+const numDocs = 1000;
+let docs = [];
+for (let i = 0; i < numDocs; ++i) {
+    docs.push({_id: i, oldKey: (i % 2 === 0 ? -1 : 1), newKey: (i % 3 === 0 ? -1 : 1)});
+}
+assert.commandWorked(inputCollection.insert(docs));
+
+const atClusterTime = inputCollection.getDB().getSession().getOperationTime();
+const expectedIds = docs.filter(doc => doc.newKey < 0).map(doc => doc._id);
+
+const recipient = st.shard0.rs.getPrimary();
+const reshardCmd = {
+    testReshardCloneCollection: inputCollection.getFullName(),
+    shardKey: {newKey: 1},
+    uuid: inputCollectionUUID,
+    shardId: st.shard0.shardName,
+    atClusterTime: atClusterTime,
+    outputNs: temporaryReshardingCollection.getFullName(),
+};
+
+function assertClonedIds() {
+    const clonedIds = recipient.getCollection(temporaryReshardingCollection.getFullName())
+                          .find({}, {_id: 1})
+                          .sort({_id: 1})
+                          .toArray()
+                          .map(doc => doc._id);
+    assert.eq(expectedIds, clonedIds);
+}
+
+assert.commandWorked(recipient.adminCommand(reshardCmd));
+assertClonedIds();
+
+// The _id ranges are persisted so that cloning can resume with the same ranges.
+const progress =
+    recipient.getCollection("config.localReshardingOperations.recipient.progress_collection_cloner")
+        .findOne({_id: inputCollectionUUID});
+assert.neq(null, progress);
+assert.gt(progress.idBoundaries.length, 0, progress);
+
+// Cloning again resumes each range after the highest _id already inserted within it.
+assert.commandWorked(recipient.adminCommand(reshardCmd));
+assertClonedIds();
+
+st.stop();
+})();
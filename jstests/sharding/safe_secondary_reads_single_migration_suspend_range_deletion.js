@@ -215,6 +215,7 @@ let testCases = {
     fsync: {skip: "does not return user data"},
     fsyncUnlock: {skip: "does not return user data"},
     getAuditConfig: {skip: "does not return user data"},
+    getCPUProfile: {skip: "does not return user data"},
     getCmdLineOpts: {skip: "does not return user data"},
     getDefaultRWConcern: {skip: "does not return user data"},
     getDiagnosticData: {skip: "does not return user data"},
@@ -373,8 +374,10 @@ let testCases = {
     splitChunk: {skip: "primary only"},
     splitVector: {skip: "primary only"},
     stageDebug: {skip: "primary only"},
+    startCPUProfiler: {skip: "does not return user data"},
     startRecordingTraffic: {skip: "does not return user data"},
     startSession: {skip: "does not return user data"},
+    stopCPUProfiler: {skip: "does not return user data"},
     stopRecordingTraffic: {skip: "does not return user data"},
     testDeprecation: {skip: "does not return user data"},
     testDeprecationInVersion2: {skip: "does not return user data"},
@@ -112,8 +112,27 @@ void BM_validate(benchmark::State& state) {
     state.SetBytesProcessed(totalSize);
 }
 
+// Validates a flat object whose field names are state.range(0) bytes long, as the scan for the
+// field name terminator dominates validation of such documents.
+void BM_validateLongFieldNames(benchmark::State& state) {
+    BSONObjBuilder builder;
+    for (auto j = 0; j < 100; j++)
+        builder.append(fmt::format("{:0>{}}", j, state.range(0)), j);
+    BSONObj obj = builder.obj();
+    invariant(validateBSON(obj.objdata(), obj.objsize()).isOK());
+
+    size_t totalSize = 0;
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        benchmark::DoNotOptimize(validateBSON(obj.objdata(), obj.objsize()));
+        totalSize += obj.objsize();
+    }
+    state.SetBytesProcessed(totalSize);
+}
+
 BENCHMARK(BM_arrayBuilder)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_arrayLookup)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_validate)->Ranges({{{1}, {1'000}}});
+BENCHMARK(BM_validateLongFieldNames)->RangeMultiplier(4)->Range(4, 256);
 
 }  // namespace mongo
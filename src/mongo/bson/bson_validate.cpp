@@ -35,6 +35,7 @@
 #include "mongo/bson/bson_depth.h"
 #include "mongo/bson/bson_validate.h"
 #include "mongo/bson/bsonelement.h"
+#include "mongo/db/fts/unicode/byte_vector.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -150,6 +151,16 @@ private:
             // This is actually by far the hottest code in all of BSON validation.
             dassert(ptr < end);
             size_t len = 0;
+#ifdef MONGO_HAVE_FAST_BYTE_VECTOR
+            // Look for the NUL a whole vector at a time, as long as one fits before the end of the
+            // buffer. The remaining bytes are scanned one at a time below.
+            using unicode::ByteVector;
+            while (static_cast<size_t>(end - ptr) - len >= ByteVector::size) {
+                if (auto mask = ByteVector::load(ptr + len).compareEQ(0).maskAny())
+                    return len + ByteVector::countInitialZeros(mask);
+                len += ByteVector::size;
+            }
+#endif
             while (ptr[len])
                 ++len;
             return len;
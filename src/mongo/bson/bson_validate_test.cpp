@@ -398,6 +398,32 @@ TEST(BSONValidateFast, BoolValuesAreValidated) {
     }
 }
 
+TEST(BSONValidateFast, FieldNamesOfEveryLength) {
+    // Field names of every length up to several vector widths, each followed by a value whose size
+    // varies so the names start at every offset from the end of the buffer.
+    for (size_t nameLen = 1; nameLen < 100; nameLen++) {
+        BSONObjBuilder bob;
+        bob.append(std::string(nameLen, 'a'), 1);
+        bob.append(std::string(nameLen, 'b'), std::string(nameLen % 17, 'x'));
+        bob.appendRegex(std::string(nameLen, 'c'), std::string(nameLen, 'r'), "i");
+        const BSONObj obj = bob.done();
+        ASSERT_OK(validateBSON(obj.objdata(), obj.objsize())) << nameLen;
+    }
+}
+
+TEST(BSONValidateFast, FieldNameRunsIntoEOO) {
+    // A Null element whose field name is only terminated by the EOO byte of the object leaves no
+    // EOO behind it, whatever the length of the name.
+    for (size_t nameLen = 1; nameLen < 100; nameLen++) {
+        BufBuilder bb;
+        bb.skip(4);
+        bb.appendChar(jstNULL);
+        bb.appendStr(std::string(nameLen, 'a'), /*withNUL*/ true);
+        DataView(bb.buf()).write(tagLittleEndian(bb.len()));
+        ASSERT_NOT_OK(validateBSON(bb.buf(), bb.len())) << nameLen;
+    }
+}
+
 TEST(BSONValidateFast, InvalidType) {
     // Encode an invalid BSON Object with an invalid type, x90.
     const char* buffer = "\x0c\x00\x00\x00\x90\x41\x00\x10\x00\x00\x00\x00";
@@ -2291,6 +2291,28 @@ void Document::reset(const BSONObj& value, InPlaceMode inPlaceMode) {
 
 Document::~Document() {}
 
+BSONObj Document::getObject() const {
+    const Impl& impl = getImpl();
+    const ElementRep& rootRep = impl.getElementRep(kRootRepIdx);
+    if (rootRep.objIdx == kLeafObjIdx || rootRep.objIdx == kInvalidObjIdx) {
+        BSONObjBuilder builder;
+        writeTo(&builder);
+        return builder.obj();
+    }
+
+    // Any modification deserializes the root, so a serialized root means that the document is
+    // still exactly the object it was built from, and we can hand that out instead of copying it.
+    const BSONObj& baseObj = impl.getObject(rootRep.objIdx);
+    if (rootRep.serialized)
+        return baseObj.getOwned();
+
+    // Otherwise, most of the document is usually copied over from the base object, so size the
+    // output for it to avoid growing the buffer repeatedly for large documents.
+    BSONObjBuilder builder(baseObj.objsize());
+    writeTo(&builder);
+    return builder.obj();
+}
+
 void Document::reserveDamageEvents(size_t expectedEvents) {
     return getImpl().reserveDamageEvents(expectedEvents);
 }
@@ -300,9 +300,10 @@ public:
     inline void writeTo(BSONObjBuilder* builder) const;
 
     /** Serialize the Elements reachable from the root Element of this Document and return
-     *  the result as a BSONObj.
+     *  the result as a BSONObj. If the Document has not been modified since it was built or
+     *  reset from a BSONObj, that object is returned (owned) without being re-serialized.
      */
-    inline BSONObj getObject() const;
+    BSONObj getObject() const;
 
 
     //
@@ -538,12 +539,6 @@ inline void Document::writeTo(BSONObjBuilder* builder) const {
     return root().writeTo(builder);
 }
 
-inline BSONObj Document::getObject() const {
-    BSONObjBuilder builder;
-    writeTo(&builder);
-    return builder.obj();
-}
-
 inline Element Document::root() {
     return _root;
 }
@@ -1188,6 +1188,30 @@ TEST(Document, RenameDeserialization) {
     ASSERT_BSONOBJ_EQ(mongo::fromjson(outJson), outObj);
 }
 
+TEST(Document, GetObjectOfUnmodifiedDocumentSharesBuffer) {
+    mongo::BSONObj inObj = mongo::fromjson("{ a : 1, b : { c : 2 } }");
+    mmb::Document doc(inObj);
+
+    // Navigating the document does not modify it, so its object is the one it was built from.
+    ASSERT_TRUE(doc.root()["b"]["c"].ok());
+    mongo::BSONObj outObj = doc.getObject();
+    ASSERT_EQUALS(inObj.objdata(), outObj.objdata());
+    ASSERT_TRUE(outObj.isOwned());
+
+    // An in-place update modifies the document, so it must be serialized again.
+    ASSERT_OK(doc.root()["b"]["c"].setValueInt(3));
+    outObj = doc.getObject();
+    ASSERT_NOT_EQUALS(inObj.objdata(), outObj.objdata());
+    ASSERT_BSONOBJ_EQ(mongo::fromjson("{ a : 1, b : { c : 3 } }"), outObj);
+
+    // The same holds after resetting the document to another object.
+    mongo::BSONObj unownedObj(inObj.objdata());
+    doc.reset(unownedObj);
+    outObj = doc.getObject();
+    ASSERT_TRUE(outObj.isOwned());
+    ASSERT_BSONOBJ_EQ(inObj, outObj);
+}
+
 TEST(Document, CantRenameRootElement) {
     mmb::Document doc;
     ASSERT_NOT_OK(doc.root().rename("foo"));
@@ -322,6 +322,135 @@ Future<executor::RemoteCommandResponse> AsyncDBClient::runCommandRequest(
         });
 }
 
+Future<executor::RemoteCommandResponse> AsyncDBClient::runPipelinedCommandRequest(
+    executor::RemoteCommandRequest request) {
+    invariant(_negotiatedProtocol);
+    auto startTimer = Timer();
+    auto requestMsg = rpc::messageFromOpMsgRequest(
+        *_negotiatedProtocol,
+        OpMsgRequest::fromDBAndBody(
+            std::move(request.dbname), std::move(request.cmdObj), std::move(request.metadata)));
+    auto msgId = nextMessageId();
+    auto pf = makePromiseFuture<Message>();
+
+    bool startSending = false;
+    bool startReceiving = false;
+    {
+        stdx::lock_guard lk(_pipelineMutex);
+        if (!_pipelineStatus.isOK()) {
+            return _pipelineStatus;
+        }
+
+        _pipelinedSends.emplace_back(msgId, std::move(requestMsg));
+        _pipelinedReplies.emplace_back(msgId, std::move(pf.promise));
+        startSending = !std::exchange(_pipelineSending, true);
+        startReceiving = !std::exchange(_pipelineReceiving, true);
+    }
+
+    if (startSending) {
+        _sendPipelined();
+    }
+    if (startReceiving) {
+        _receivePipelined();
+    }
+
+    return std::move(pf.future).then([startTimer](Message response) {
+        rpc::UniqueReply reply(response, rpc::makeReply(&response));
+        return executor::RemoteCommandResponse(*reply, startTimer.elapsed());
+    });
+}
+
+Status AsyncDBClient::pipelineStatus() const {
+    stdx::lock_guard lk(_pipelineMutex);
+    return _pipelineStatus;
+}
+
+void AsyncDBClient::_sendPipelined() {
+    std::pair<int32_t, Message> next;
+    {
+        stdx::lock_guard lk(_pipelineMutex);
+        if (!_pipelineStatus.isOK() || _pipelinedSends.empty()) {
+            _pipelineSending = false;
+            return;
+        }
+
+        next = std::move(_pipelinedSends.front());
+        _pipelinedSends.pop_front();
+    }
+
+    _call(std::move(next.second), next.first)
+        .getAsync([this, anchor = shared_from_this()](Status status) {
+            if (!status.isOK()) {
+                _failPipeline(std::move(status));
+                return;
+            }
+
+            _sendPipelined();
+        });
+}
+
+void AsyncDBClient::_receivePipelined() {
+    _waitForResponse(boost::none)
+        .getAsync([this, anchor = shared_from_this()](StatusWith<Message> swResponse) {
+            if (!swResponse.isOK()) {
+                _failPipeline(swResponse.getStatus());
+                return;
+            }
+
+            auto& response = swResponse.getValue();
+            boost::optional<Promise<Message>> promise;
+            bool receiveMore = false;
+            {
+                stdx::lock_guard lk(_pipelineMutex);
+                if (!_pipelineStatus.isOK()) {
+                    return;
+                }
+
+                if (!_pipelinedReplies.empty() &&
+                    response.header().getResponseToMsgId() == _pipelinedReplies.front().first) {
+                    promise.emplace(std::move(_pipelinedReplies.front().second));
+                    _pipelinedReplies.pop_front();
+                    receiveMore = !_pipelinedReplies.empty();
+                    _pipelineReceiving = receiveMore;
+                }
+            }
+
+            if (!promise) {
+                _failPipeline({ErrorCodes::ProtocolError,
+                               "Pipelined reply did not match the oldest outstanding request"});
+                return;
+            }
+
+            promise->emplaceValue(std::move(response));
+            if (receiveMore) {
+                _receivePipelined();
+            }
+        });
+}
+
+void AsyncDBClient::_failPipeline(Status status) {
+    decltype(_pipelinedReplies) replies;
+    {
+        stdx::lock_guard lk(_pipelineMutex);
+        if (!_pipelineStatus.isOK()) {
+            return;
+        }
+
+        _pipelineStatus = status;
+        _pipelinedSends.clear();
+        replies = std::exchange(_pipelinedReplies, {});
+        _pipelineSending = false;
+        _pipelineReceiving = false;
+    }
+
+    // Whichever of the send and receive loops is still running has to finish as well.
+    _session->end();
+
+    for (auto& reply : replies) {
+        reply.second.setError(status);
+    }
+}
+
 Future<executor::RemoteCommandResponse> AsyncDBClient::_continueReceiveExhaustResponse(
     ClockSource::StopWatch stopwatch, boost::optional<int32_t> msgId, const BatonHandle& baton) {
     return _waitForResponse(msgId, baton)
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/client/authenticate.h"
@@ -37,6 +38,7 @@
 #include "mongo/executor/remote_command_request.h"
 #include "mongo/executor/remote_command_response.h"
 #include "mongo/rpc/protocol.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/rpc/unique_message.h"
 #include "mongo/transport/baton.h"
 #include "mongo/transport/message_compressor_manager.h"
@@ -69,6 +71,23 @@ public:
                                         const BatonHandle& baton = nullptr,
                                         bool fireAndForget = false);
 
+    /**
+     * Sends a command without waiting for the replies to the commands already pipelined on this
+     * client. The remote executes and answers the commands in the order they were sent, and each
+     * reply is matched to its request by responseTo. If the client fails, every command still in
+     * the pipeline fails with it, and all later pipelined commands fail immediately.
+     *
+     * Pipelined commands must not be mixed with any other kind of command on the same client
+     * while any of them is outstanding.
+     */
+    Future<executor::RemoteCommandResponse> runPipelinedCommandRequest(
+        executor::RemoteCommandRequest request);
+
+    /**
+     * Returns the error that broke the pipeline, or OK if no pipelined command has failed.
+     */
+    Status pipelineStatus() const;
+
     Future<executor::RemoteCommandResponse> beginExhaustCommandRequest(
         executor::RemoteCommandRequest request, const BatonHandle& baton = nullptr);
     Future<executor::RemoteCommandResponse> runExhaustCommand(OpMsgRequest request,
@@ -112,11 +131,24 @@ private:
                                 const std::unique_ptr<rpc::ReplyInterface>& response);
     auth::RunCommandHook _makeAuthRunCommandHook();
 
+    void _sendPipelined();
+    void _receivePipelined();
+    void _failPipeline(Status status);
+
     const HostAndPort _peer;
     transport::SessionHandle _session;
     ServiceContext* const _svcCtx;
     MessageCompressorManager _compressorManager;
     boost::optional<rpc::Protocol> _negotiatedProtocol;
+
+    mutable Mutex _pipelineMutex = MONGO_MAKE_LATCH("AsyncDBClient::_pipelineMutex");
+    // Pipelined requests that still have to be written, in order.
+    std::deque<std::pair<int32_t, Message>> _pipelinedSends;
+    // Pipelined requests that still await a reply, in the order they were submitted.
+    std::deque<std::pair<int32_t, Promise<Message>>> _pipelinedReplies;
+    bool _pipelineSending = false;
+    bool _pipelineReceiving = false;
+    Status _pipelineStatus = Status::OK();
 };
 
 }  // namespace mongo
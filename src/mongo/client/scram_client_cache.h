@@ -60,6 +60,9 @@ namespace mongo {
  * server is going to advertise the same salt value upon
  * reauthentication.  This might be useful for mobile clients where
  * CPU usage is a concern."
+ *
+ * Secrets computed for one host also serve any other host which
+ * advertises the same salt and iteration count for the user.
  */
 template <typename HashBlock>
 class SCRAMClientCache {
@@ -69,30 +72,31 @@ private:
 
 public:
     /**
-     * Returns precomputed SCRAMSecrets, if one has already been
-     * stored for the specified hostname and the provided presecrets
-     * match those recorded for the hostname. Otherwise, no secrets
-     * are returned.
+     * Returns precomputed SCRAMSecrets, if the provided presecrets match
+     * those recorded for the specified hostname, or failing that for any
+     * other host. Otherwise, no secrets are returned.
      */
     scram::Secrets<HashBlock> getCachedSecrets(
         const HostAndPort& target, const scram::Presecrets<HashBlock>& presecrets) const {
         const stdx::lock_guard<Latch> lock(_hostToSecretsMutex);
 
-        // Search the cache for a record associated with the host we're trying to connect to.
-        auto foundSecret = _hostToSecrets.find(target);
-        if (foundSecret == _hostToSecrets.end()) {
-            return {};
-        }
-
         // Presecrets contain parameters provided by the server, which may change. If the
         // cached presecrets don't match the presecrets we have on hand, we must not return the
         // stale cached secrets. We'll need to rerun the SCRAM computation.
-        const auto& foundPresecrets = foundSecret->second.first;
-        if (foundPresecrets == presecrets) {
+        auto foundSecret = _hostToSecrets.find(target);
+        if (foundSecret != _hostToSecrets.end() && foundSecret->second.first == presecrets) {
             return foundSecret->second.second;
-        } else {
-            return {};
         }
+
+        // The members of a replica set, and the shards of a cluster, share the user documents and
+        // so the salt and iteration count of a user. Secrets computed for one of them serve for
+        // the others, which matters when many connections are opened to new hosts at once.
+        for (const auto& entry : _hostToSecrets) {
+            if (entry.second.first == presecrets) {
+                return entry.second.second;
+            }
+        }
+        return {};
     }
 
     /**
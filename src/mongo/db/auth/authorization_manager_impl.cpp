@@ -635,22 +635,66 @@ void AuthorizationManagerImpl::invalidateUserByName(OperationContext* opCtx,
     _authSchemaVersionCache.invalidateAll();
     // Invalidate the named User, assuming no externally provided roles. When roles are defined
     // externally, there exists no user document which may become invalid.
-    _userCache.invalidate(UserRequest(userName, boost::none));
+    UserRequest request(userName, boost::none);
+    auto usersToRefresh = _getUsersToRefresh(
+        opCtx, [&](const UserRequest& userRequest) { return userRequest == request; });
+    _userCache.invalidate(request);
+    _refreshUsers(std::move(usersToRefresh));
 }
 
 void AuthorizationManagerImpl::invalidateUsersFromDB(OperationContext* opCtx, StringData dbname) {
     LOGV2_DEBUG(20236, 2, "Invalidating all users from database", "database"_attr = dbname);
     _updateCacheGeneration();
     _authSchemaVersionCache.invalidateAll();
-    _userCache.invalidateKeyIf(
-        [&](const UserRequest& userRequest) { return userRequest.name.getDB() == dbname; });
+    auto isFromDB = [&](const UserRequest& userRequest) {
+        return userRequest.name.getDB() == dbname;
+    };
+    auto usersToRefresh = _getUsersToRefresh(opCtx, isFromDB);
+    _userCache.invalidateKeyIf(isFromDB);
+    _refreshUsers(std::move(usersToRefresh));
 }
 
 void AuthorizationManagerImpl::invalidateUserCache(OperationContext* opCtx) {
     LOGV2_DEBUG(20237, 2, "Invalidating user cache");
     _updateCacheGeneration();
     _authSchemaVersionCache.invalidateAll();
+    auto usersToRefresh = _getUsersToRefresh(opCtx, [](const UserRequest&) { return true; });
     _userCache.invalidateAll();
+    _refreshUsers(std::move(usersToRefresh));
+}
+
+template <typename Pred>
+std::vector<UserRequest> AuthorizationManagerImpl::_getUsersToRefresh(OperationContext* opCtx,
+                                                                      const Pred& predicate) {
+    std::vector<UserRequest> requests;
+    if (!authorizationManagerRefreshUsersAfterInvalidation.load() ||
+        opCtx->lockState()->inAWriteUnitOfWork()) {
+        return requests;
+    }
+
+    for (const auto& info : _userCache.getCacheInfo()) {
+        if (predicate(info.key)) {
+            requests.push_back(info.key);
+        }
+    }
+    return requests;
+}
+
+void AuthorizationManagerImpl::_refreshUsers(std::vector<UserRequest> requests) {
+    if (requests.empty()) {
+        return;
+    }
+
+    LOGV2_DEBUG(5963043,
+                2,
+                "Refreshing invalidated users in the background",
+                "numUsers"_attr = requests.size());
+    for (const auto& request : requests) {
+        // The lookup goes on after the future is dropped, and whoever needs the user next joins
+        // it. A failed lookup caches nothing, so the next acquisition simply looks the user up
+        // again.
+        (void)_userCache.acquireAsync(request);
+    }
 }
 
 Status AuthorizationManagerImpl::initialize(OperationContext* opCtx) {
@@ -127,6 +127,21 @@ public:
 private:
     void _updateCacheGeneration();
 
+    /**
+     * Returns the requests of the users in the cache which match 'predicate', for them to be
+     * looked up again by _refreshUsers once they have been invalidated. Returns nothing if users
+     * are not refreshed after invalidation, or if 'opCtx' is in a write unit of work, since a
+     * lookup could then read the auth data from before the write.
+     */
+    template <typename Pred>
+    std::vector<UserRequest> _getUsersToRefresh(OperationContext* opCtx, const Pred& predicate);
+
+    /**
+     * Starts looking up 'requests' in the background, so that the operations which need those
+     * users next join the lookups rather than each starting one on a cache miss.
+     */
+    void _refreshUsers(std::vector<UserRequest> requests);
+
     void _pinnedUsersThreadRoutine() noexcept;
 
     std::unique_ptr<AuthzManagerExternalState> _externalState;
@@ -210,6 +210,7 @@ MONGO_INITIALIZER(AuthorizationBuiltinRoles)(InitializerContext* context) {
         << ActionType::applicationMessage  // clusterManager gets this also
         << ActionType::auditConfigure
         << ActionType::connPoolSync
+        << ActionType::cpuProfiler
         << ActionType::dropConnections
         << ActionType::logRotate
         << ActionType::setParameter
@@ -610,9 +610,8 @@ void testSetAndGetWithDifferentParameters() {
     cache.setCachedSecrets(host, presecrets, secrets);
     ASSERT_TRUE(cache.getCachedSecrets(host, presecrets));
 
-    // Alter each of: host, password, salt, iterationCount.
+    // Alter each of: password, salt, iterationCount.
     // Any one of which should fail to retreive from cache.
-    ASSERT_FALSE(cache.getCachedSecrets(HostAndPort("localhost:27018"), presecrets));
     ASSERT_FALSE(cache.getCachedSecrets(host, scram::Presecrets<HashBlock>("aab", salt, 10000)));
     const auto badSalt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
     ASSERT_FALSE(cache.getCachedSecrets(host, scram::Presecrets<HashBlock>("aaa", badSalt, 10000)));
@@ -650,5 +649,35 @@ TEST(SCRAMCache, testSetAndReset) {
     testSetAndReset<SHA256Block>();
 }
 
+template <typename HashBlock>
+void testGetForOtherHost() {
+    SCRAMClientCache<HashBlock> cache;
+    const auto salt = scram::Presecrets<HashBlock>::generateSecureRandomSalt();
+    HostAndPort host("localhost:27017");
+    HostAndPort otherHost("localhost:27018");
+
+    const auto presecrets = scram::Presecrets<HashBlock>("aaa", salt, 10000);
+    const auto secrets = scram::Secrets<HashBlock>(presecrets);
+    cache.setCachedSecrets(host, presecrets, secrets);
+
+    // Another host which advertises the same salt and iteration count gets the same secrets.
+    const auto cachedSecrets = cache.getCachedSecrets(otherHost, presecrets);
+    ASSERT_TRUE(cachedSecrets);
+    ASSERT_TRUE(secrets.clientKey() == cachedSecrets.clientKey());
+    ASSERT_FALSE(
+        cache.getCachedSecrets(otherHost, scram::Presecrets<HashBlock>("aaa", salt, 10001)));
+
+    // A host whose own entry is stale still finds the secrets computed for another host.
+    const auto presecretsB = scram::Presecrets<HashBlock>("aab", salt, 10000);
+    cache.setCachedSecrets(otherHost, presecretsB, scram::Secrets<HashBlock>(presecretsB));
+    ASSERT_TRUE(cache.getCachedSecrets(otherHost, presecrets));
+    ASSERT_TRUE(cache.getCachedSecrets(host, presecretsB));
+}
+
+TEST(SCRAMCache, testGetForOtherHost) {
+    testGetForOtherHost<SHA1Block>();
+    testGetForOtherHost<SHA256Block>();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -32,6 +32,8 @@
 
 #include "collection_catalog.h"
 
+#include <algorithm>
+
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/concurrency/lock_manager_defs.h"
@@ -251,11 +253,10 @@ public:
                 case UncommittedCatalogUpdates::Entry::Action::kWritable:
                     writeJobs.push_back(
                         [collection = std::move(entry.collection)](CollectionCatalog& catalog) {
-                            catalog._collections[collection->ns()] = collection;
-                            catalog._catalog[collection->uuid()] = collection;
-                            auto dbIdPair = std::make_pair(collection->ns().db().toString(),
-                                                           collection->uuid());
-                            catalog._orderedCollections[dbIdPair] = collection;
+                            catalog._collections.getOrCreate(collection->ns()) = collection;
+                            catalog._catalog.getOrCreate(collection->uuid()) = collection;
+                            catalog._mutableDatabaseCollections(
+                                collection->ns().db().toString())[collection->uuid()] = collection;
                         });
                     break;
                 case UncommittedCatalogUpdates::Entry::Action::kRenamed:
@@ -312,9 +313,11 @@ CollectionCatalog::iterator::iterator(OperationContext* opCtx,
                                       StringData dbName,
                                       const CollectionCatalog& catalog)
     : _opCtx(opCtx), _dbName(dbName), _catalog(&catalog) {
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-
-    _mapIter = _catalog->_orderedCollections.lower_bound(std::make_pair(_dbName, minUuid));
+    auto dbIt = _catalog->_orderedCollections.find(_dbName);
+    if (dbIt != _catalog->_orderedCollections.end()) {
+        _dbCollections = dbIt->second.get();
+        _mapIter = _dbCollections->begin();
+    }
 
     // Start with the first collection that is visible outside of its transaction.
     while (!_exhausted() && !_mapIter->second->isCommitted()) {
@@ -322,15 +325,12 @@ CollectionCatalog::iterator::iterator(OperationContext* opCtx,
     }
 
     if (!_exhausted()) {
-        _uuid = _mapIter->first.second;
+        _uuid = _mapIter->first;
     }
 }
 
-CollectionCatalog::iterator::iterator(OperationContext* opCtx,
-                                      std::map<std::pair<std::string, CollectionUUID>,
-                                               std::shared_ptr<Collection>>::const_iterator mapIter,
-                                      const CollectionCatalog& catalog)
-    : _opCtx(opCtx), _mapIter(mapIter), _catalog(&catalog) {}
+CollectionCatalog::iterator::iterator(OperationContext* opCtx, const CollectionCatalog& catalog)
+    : _opCtx(opCtx), _catalog(&catalog) {}
 
 CollectionCatalog::iterator::value_type CollectionCatalog::iterator::operator*() {
     if (_exhausted()) {
@@ -359,14 +359,12 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++() {
     }
 
     if (_exhausted()) {
-        // If the iterator is at the end of the map or now points to an entry that does not
-        // correspond to the correct database.
-        _mapIter = _catalog->_orderedCollections.end();
+        // If the iterator is past the last collection of the database.
         _uuid = boost::none;
         return *this;
     }
 
-    _uuid = _mapIter->first.second;
+    _uuid = _mapIter->first;
     return *this;
 }
 
@@ -378,10 +376,7 @@ CollectionCatalog::iterator CollectionCatalog::iterator::operator++(int) {
 
 bool CollectionCatalog::iterator::operator==(const iterator& other) {
     invariant(_catalog == other._catalog);
-    if (other._mapIter == _catalog->_orderedCollections.end()) {
-        return _uuid == boost::none;
-    }
-
+    // The end iterator and every exhausted iterator have no UUID.
     return _uuid == other._uuid;
 }
 
@@ -390,7 +385,7 @@ bool CollectionCatalog::iterator::operator!=(const iterator& other) {
 }
 
 bool CollectionCatalog::iterator::_exhausted() {
-    return _mapIter == _catalog->_orderedCollections.end() || _mapIter->first.first != _dbName;
+    return !_dbCollections || _mapIter == _dbCollections->end();
 }
 
 std::shared_ptr<const CollectionCatalog> CollectionCatalog::get(ServiceContext* svcCtx) {
@@ -585,8 +580,9 @@ void CollectionCatalog::onCloseCatalog(OperationContext* opCtx) {
     invariant(opCtx->lockState()->isW());
     invariant(!_shadowCatalog);
     _shadowCatalog.emplace();
-    for (auto& entry : _catalog)
-        _shadowCatalog->insert({entry.first, entry.second->ns()});
+    _catalog.forEach([&](const CollectionUUID& uuid, const std::shared_ptr<Collection>& coll) {
+        _shadowCatalog->insert({uuid, coll->ns()});
+    });
 }
 
 void CollectionCatalog::onOpenCatalog(OperationContext* opCtx) {
@@ -676,8 +672,19 @@ bool CollectionCatalog::isCollectionAwaitingVisibility(CollectionUUID uuid) cons
 }
 
 std::shared_ptr<Collection> CollectionCatalog::_lookupCollectionByUUID(CollectionUUID uuid) const {
-    auto foundIt = _catalog.find(uuid);
-    return foundIt == _catalog.end() ? nullptr : foundIt->second;
+    auto found = _catalog.find(uuid);
+    return found ? *found : nullptr;
+}
+
+std::map<CollectionUUID, std::shared_ptr<Collection>>&
+CollectionCatalog::_mutableDatabaseCollections(const std::string& dbName) {
+    auto& dbCollections = _orderedCollections[dbName];
+    if (!dbCollections) {
+        dbCollections = std::make_shared<DatabaseCollectionMap>();
+    } else if (dbCollections.use_count() > 1) {
+        dbCollections = std::make_shared<DatabaseCollectionMap>(*dbCollections);
+    }
+    return *dbCollections;
 }
 
 std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespaceForRead(
@@ -686,8 +693,8 @@ std::shared_ptr<const Collection> CollectionCatalog::lookupCollectionByNamespace
         return coll;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto committed = _collections.find(nss);
+    auto coll = (committed ? *committed : nullptr);
     return (coll && coll->isCommitted()) ? coll : nullptr;
 }
 
@@ -717,8 +724,8 @@ Collection* CollectionCatalog::lookupCollectionByNamespaceForMetadataWrite(
         return nullptr;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto committed = _collections.find(nss);
+    auto coll = (committed ? *committed : nullptr);
 
     if (!coll || !coll->isCommitted())
         return nullptr;
@@ -754,8 +761,8 @@ CollectionPtr CollectionCatalog::lookupCollectionByNamespace(OperationContext* o
         return nullptr;
     }
 
-    auto it = _collections.find(nss);
-    auto coll = (it == _collections.end() ? nullptr : it->second);
+    auto committed = _collections.find(nss);
+    auto coll = (committed ? *committed : nullptr);
     return (coll && coll->isCommitted())
         ? CollectionPtr(opCtx, coll.get(), LookupCollectionForYieldRestore())
         : nullptr;
@@ -778,11 +785,10 @@ boost::optional<NamespaceString> CollectionCatalog::lookupNSSByUUID(OperationCon
         return coll->ns();
     }
 
-    auto foundIt = _catalog.find(uuid);
-    if (foundIt != _catalog.end()) {
-        boost::optional<NamespaceString> ns = foundIt->second->ns();
+    if (auto found = _catalog.find(uuid)) {
+        boost::optional<NamespaceString> ns = (*found)->ns();
         invariant(!ns.get().isEmpty());
-        return _collections.find(ns.get())->second->isCommitted() ? ns : boost::none;
+        return (*_collections.find(ns.get()))->isCommitted() ? ns : boost::none;
     }
 
     // Only in the case that the catalog is closed and a UUID is currently unknown, resolve it
@@ -812,10 +818,9 @@ boost::optional<CollectionUUID> CollectionCatalog::lookupUUIDByNSS(
         return boost::none;
     }
 
-    auto it = _collections.find(nss);
-    if (it != _collections.end()) {
-        boost::optional<CollectionUUID> uuid = it->second->uuid();
-        return it->second->isCommitted() ? uuid : boost::none;
+    if (auto found = _collections.find(nss)) {
+        boost::optional<CollectionUUID> uuid = (*found)->uuid();
+        return (*found)->isCommitted() ? uuid : boost::none;
     }
     return boost::none;
 }
@@ -858,15 +863,16 @@ bool CollectionCatalog::checkIfCollectionSatisfiable(CollectionUUID uuid,
 
 std::vector<CollectionUUID> CollectionCatalog::getAllCollectionUUIDsFromDb(
     StringData dbName) const {
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-    auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
-
     std::vector<CollectionUUID> ret;
-    while (it != _orderedCollections.end() && it->first.first == dbName) {
-        if (it->second->isCommitted()) {
-            ret.push_back(it->first.second);
+    auto dbIt = _orderedCollections.find(dbName.toString());
+    if (dbIt == _orderedCollections.end()) {
+        return ret;
+    }
+
+    for (const auto& [uuid, coll] : *dbIt->second) {
+        if (coll->isCommitted()) {
+            ret.push_back(uuid);
         }
-        ++it;
     }
     return ret;
 }
@@ -875,14 +881,15 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
     OperationContext* opCtx, StringData dbName) const {
     invariant(opCtx->lockState()->isDbLockedForMode(dbName, MODE_S));
 
-    auto minUuid = UUID::parse("00000000-0000-0000-0000-000000000000").getValue();
-
     std::vector<NamespaceString> ret;
-    for (auto it = _orderedCollections.lower_bound(std::make_pair(dbName.toString(), minUuid));
-         it != _orderedCollections.end() && it->first.first == dbName;
-         ++it) {
-        if (it->second->isCommitted()) {
-            ret.push_back(it->second->ns());
+    auto dbIt = _orderedCollections.find(dbName.toString());
+    if (dbIt == _orderedCollections.end()) {
+        return ret;
+    }
+
+    for (const auto& [uuid, coll] : *dbIt->second) {
+        if (coll->isCommitted()) {
+            ret.push_back(coll->ns());
         }
     }
     return ret;
@@ -890,20 +897,13 @@ std::vector<NamespaceString> CollectionCatalog::getAllCollectionNamesFromDb(
 
 std::vector<std::string> CollectionCatalog::getAllDbNames() const {
     std::vector<std::string> ret;
-    auto maxUuid = UUID::parse("FFFFFFFF-FFFF-FFFF-FFFF-FFFFFFFFFFFF").getValue();
-    auto iter = _orderedCollections.upper_bound(std::make_pair("", maxUuid));
-    while (iter != _orderedCollections.end()) {
-        auto dbName = iter->first.first;
-        if (iter->second->isCommitted()) {
+    for (const auto& [dbName, dbCollections] : _orderedCollections) {
+        // Only report databases with at least one collection visible outside of its transaction.
+        if (std::any_of(dbCollections->begin(), dbCollections->end(), [](const auto& entry) {
+                return entry.second->isCommitted();
+            })) {
             ret.push_back(dbName);
-        } else {
-            // If the first collection found for `dbName` is not yet committed, increment the
-            // iterator to find the next visible collection (possibly under a different `dbName`).
-            iter++;
-            continue;
         }
-        // Move on to the next database after `dbName`.
-        iter = _orderedCollections.upper_bound(std::make_pair(dbName, maxUuid));
     }
     return ret;
 }
@@ -931,7 +931,7 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
                                            CollectionUUID uuid,
                                            std::shared_ptr<Collection> coll) {
     auto ns = coll->ns();
-    if (_collections.find(ns) != _collections.end()) {
+    if (_collections.contains(ns)) {
         auto& uncommittedCatalogUpdates = getUncommittedCatalogUpdates(opCtx);
         auto [found, uncommittedPtr] = uncommittedCatalogUpdates.lookup(ns);
         // If we have an uncommitted drop of this collection we can defer the creation, the register
@@ -956,15 +956,15 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
                 "uuid"_attr = uuid);
 
     auto dbName = ns.db().toString();
-    auto dbIdPair = std::make_pair(dbName, uuid);
+    auto& dbCollections = _mutableDatabaseCollections(dbName);
 
     // Make sure no entry related to this uuid.
-    invariant(_catalog.find(uuid) == _catalog.end());
-    invariant(_orderedCollections.find(dbIdPair) == _orderedCollections.end());
+    invariant(!_catalog.contains(uuid));
+    invariant(dbCollections.find(uuid) == dbCollections.end());
 
-    _catalog[uuid] = coll;
-    _collections[ns] = coll;
-    _orderedCollections[dbIdPair] = coll;
+    _catalog.getOrCreate(uuid) = coll;
+    _collections.getOrCreate(ns) = coll;
+    dbCollections[uuid] = coll;
 
     auto dbRid = ResourceId(RESOURCE_DATABASE, dbName);
     addResource(dbRid, dbName);
@@ -975,20 +975,24 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
 
 std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationContext* opCtx,
                                                                     CollectionUUID uuid) {
-    invariant(_catalog.find(uuid) != _catalog.end());
+    auto found = _catalog.find(uuid);
+    invariant(found);
 
-    auto coll = std::move(_catalog[uuid]);
+    // Copy rather than move out, the entry may still be shared with other catalog instances.
+    auto coll = *found;
     auto ns = coll->ns();
     auto dbName = ns.db().toString();
-    auto dbIdPair = std::make_pair(dbName, uuid);
 
     LOGV2_DEBUG(20281, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
 
     // Make sure collection object exists.
-    invariant(_collections.find(ns) != _collections.end());
-    invariant(_orderedCollections.find(dbIdPair) != _orderedCollections.end());
+    invariant(_collections.contains(ns));
+    auto& dbCollections = _mutableDatabaseCollections(dbName);
+    invariant(dbCollections.erase(uuid) == 1);
+    if (dbCollections.empty()) {
+        _orderedCollections.erase(dbName);
+    }
 
-    _orderedCollections.erase(dbIdPair);
     _collections.erase(ns);
     _catalog.erase(uuid);
 
@@ -1002,17 +1006,13 @@ std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationCon
 
 void CollectionCatalog::deregisterAllCollections() {
     LOGV2(20282, "Deregistering all the collections");
-    for (auto& entry : _catalog) {
-        auto uuid = entry.first;
-        auto ns = entry.second->ns();
-        auto dbName = ns.db().toString();
-        auto dbIdPair = std::make_pair(dbName, uuid);
-
-        LOGV2_DEBUG(
-            20283, 1, "Deregistering collection", "namespace"_attr = ns, "uuid"_attr = uuid);
-
-        entry.second.reset();
-    }
+    _catalog.forEach([](const CollectionUUID& uuid, const std::shared_ptr<Collection>& coll) {
+        LOGV2_DEBUG(20283,
+                    1,
+                    "Deregistering collection",
+                    "namespace"_attr = coll->ns(),
+                    "uuid"_attr = uuid);
+    });
 
     _collections.clear();
     _orderedCollections.clear();
@@ -1026,18 +1026,18 @@ CollectionCatalog::iterator CollectionCatalog::begin(OperationContext* opCtx, St
 }
 
 CollectionCatalog::iterator CollectionCatalog::end(OperationContext* opCtx) const {
-    return iterator(opCtx, _orderedCollections.end(), *this);
+    return iterator(opCtx, *this);
 }
 
 boost::optional<std::string> CollectionCatalog::lookupResourceName(const ResourceId& rid) const {
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search) {
         return boost::none;
     }
 
-    const std::set<std::string>& namespaces = search->second;
+    const std::set<std::string>& namespaces = *search;
 
     // When there are multiple namespaces mapped to the same ResourceId, return boost::none as the
     // ResourceId does not identify a single namespace.
@@ -1052,16 +1052,16 @@ void CollectionCatalog::removeResource(const ResourceId& rid, const std::string&
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (!search || !search->count(entry)) {
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
+    std::set<std::string>& namespaces = _resourceInformation.getOrCreate(rid);
     namespaces.erase(entry);
 
     // Remove the map entry if this is the last namespace in the set for the ResourceId.
     if (namespaces.size() == 0) {
-        _resourceInformation.erase(search);
+        _resourceInformation.erase(rid);
     }
 }
 
@@ -1069,18 +1069,11 @@ void CollectionCatalog::addResource(const ResourceId& rid, const std::string& en
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
-        std::set<std::string> newSet = {entry};
-        _resourceInformation.insert(std::make_pair(rid, newSet));
-        return;
-    }
-
-    std::set<std::string>& namespaces = search->second;
-    if (namespaces.count(entry) > 0) {
+    if (search && search->count(entry) > 0) {
         return;
     }
 
-    namespaces.insert(entry);
+    _resourceInformation.getOrCreate(rid).insert(entry);
 }
 
 CollectionCatalogStasher::CollectionCatalogStasher(OperationContext* opCtx)
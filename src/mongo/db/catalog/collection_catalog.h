@@ -37,6 +37,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/service_context.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/copy_on_write_chunked_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -74,10 +75,11 @@ public:
         using value_type = CollectionPtr;
 
         iterator(OperationContext* opCtx, StringData dbName, const CollectionCatalog& catalog);
-        iterator(OperationContext* opCtx,
-                 std::map<std::pair<std::string, CollectionUUID>,
-                          std::shared_ptr<Collection>>::const_iterator mapIter,
-                 const CollectionCatalog& catalog);
+
+        /**
+         * Constructs the end iterator.
+         */
+        iterator(OperationContext* opCtx, const CollectionCatalog& catalog);
         value_type operator*();
         iterator operator++();
         iterator operator++(int);
@@ -98,8 +100,9 @@ public:
         OperationContext* _opCtx;
         std::string _dbName;
         boost::optional<CollectionUUID> _uuid;
-        std::map<std::pair<std::string, CollectionUUID>,
-                 std::shared_ptr<Collection>>::const_iterator _mapIter;
+        // The collections of '_dbName', or null if there are none or this is the end iterator.
+        const std::map<CollectionUUID, std::shared_ptr<Collection>>* _dbCollections = nullptr;
+        std::map<CollectionUUID, std::shared_ptr<Collection>>::const_iterator _mapIter;
         const CollectionCatalog* _catalog;
     };
 
@@ -365,6 +368,13 @@ private:
 
     std::shared_ptr<Collection> _lookupCollectionByUUID(CollectionUUID uuid) const;
 
+    /**
+     * Returns the collections of 'dbName' for modification, first copying them if another catalog
+     * instance still shares them, and creating them if there are none.
+     */
+    std::map<CollectionUUID, std::shared_ptr<Collection>>& _mutableDatabaseCollections(
+        const std::string& dbName);
+
     /**
      * When present, indicates that the catalog is in closed state, and contains a map from UUID
      * to pre-close NSS. See also onCloseCatalog.
@@ -373,16 +383,22 @@ private:
         mongo::stdx::unordered_map<CollectionUUID, NamespaceString, CollectionUUID::Hash>>
         _shadowCatalog;
 
+    // Every write to the catalog copies it (see CollectionCatalog::write), so the maps below that
+    // grow with the number of collections share their contents between copies and only copy the
+    // part a write modifies.
     using CollectionCatalogMap =
-        stdx::unordered_map<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
-    using OrderedCollectionMap =
-        std::map<std::pair<std::string, CollectionUUID>, std::shared_ptr<Collection>>;
+        CopyOnWriteChunkedMap<CollectionUUID, std::shared_ptr<Collection>, CollectionUUID::Hash>;
+    using DatabaseCollectionMap = std::map<CollectionUUID, std::shared_ptr<Collection>>;
+    using OrderedCollectionMap = std::map<std::string, std::shared_ptr<DatabaseCollectionMap>>;
     using NamespaceCollectionMap =
-        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>;
+        CopyOnWriteChunkedMap<NamespaceString, std::shared_ptr<Collection>>;
+    using ResourceInformationMap = CopyOnWriteChunkedMap<ResourceId, std::set<std::string>>;
     using DatabaseProfileSettingsMap = StringMap<ProfileSettings>;
 
     CollectionCatalogMap _catalog;
-    OrderedCollectionMap _orderedCollections;  // Ordered by <dbName, collUUID> pair
+    // Ordered by database name, then by collection UUID within each database. The collections of
+    // a database are shared with other catalog instances until modified.
+    OrderedCollectionMap _orderedCollections;
     NamespaceCollectionMap _collections;
 
     // Incremented whenever the CollectionCatalog gets closed and reopened (onCloseCatalog and
@@ -398,7 +414,7 @@ private:
     uint64_t _epoch = 0;
 
     // Mapping from ResourceId to a set of strings that contains collection and database namespaces.
-    std::map<ResourceId, std::set<std::string>> _resourceInformation;
+    ResourceInformationMap _resourceInformation;
 
     /**
      * Contains non-default database profile settings. New collections, current collections and
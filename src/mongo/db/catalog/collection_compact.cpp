@@ -32,9 +32,11 @@
 #include "mongo/db/catalog/collection_compact.h"
 
 #include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/collection_compact_gen.h"
 #include "mongo/db/catalog/document_validation.h"
 #include "mongo/db/catalog/index_key_validate.h"
 #include "mongo/db/catalog/multi_index_block.h"
+#include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/index/index_descriptor.h"
@@ -43,6 +45,8 @@
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/fail_point.h"
+#include "mongo/util/progress_meter.h"
 
 namespace mongo {
 
@@ -50,6 +54,8 @@ using logv2::LogComponent;
 
 namespace {
 
+MONGO_FAIL_POINT_DEFINE(hangBeforeCompactingTableIncrementally);
+
 CollectionPtr getCollectionForCompact(OperationContext* opCtx,
                                       Database* database,
                                       const NamespaceString& collectionNss) {
@@ -68,12 +74,76 @@ CollectionPtr getCollectionForCompact(OperationContext* opCtx,
     return collection;
 }
 
+/**
+ * Compacts the record store of the collection with 'uuid' and then its indexes named in
+ * 'indexNames', each in slices of 'timeSlice'. Only intent locks are taken for each slice, and no
+ * locks are held between slices, so that the collection stays available and compaction can be
+ * interrupted at any point. Indexes which are dropped in the meantime are skipped.
+ */
+Status compactTablesIncrementally(OperationContext* opCtx,
+                                  const NamespaceString& collectionNss,
+                                  const UUID& uuid,
+                                  const std::vector<std::string>& indexNames,
+                                  Seconds timeSlice) {
+    ProgressMeterHolder progress;
+    {
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        progress.set(CurOp::get(opCtx)->setProgress_inlock("Compact: compacting tables",
+                                                           1 + indexNames.size()));
+    }
+
+    // The table at position 0 is the record store, followed by the indexes.
+    for (size_t table = 0; table <= indexNames.size(); ++table) {
+        hangBeforeCompactingTableIncrementally.pauseWhileSet(opCtx);
+
+        while (true) {
+            opCtx->checkForInterrupt();
+
+            Status status = [&] {
+                AutoGetCollection collection(
+                    opCtx, NamespaceStringOrUUID(collectionNss.db().toString(), uuid), MODE_IX);
+                if (!collection) {
+                    return Status(ErrorCodes::NamespaceNotFound,
+                                  "collection was dropped during compaction");
+                }
+                if (table == 0) {
+                    return collection->getRecordStore()->compact(opCtx, timeSlice);
+                }
+
+                auto indexCatalog = collection->getIndexCatalog();
+                auto desc = indexCatalog->findIndexByName(opCtx, indexNames[table - 1]);
+                if (!desc) {
+                    return Status::OK();
+                }
+                LOGV2_DEBUG(5963014, 1, "compacting index", "index"_attr = *desc);
+                auto accessMethod =
+                    const_cast<IndexAccessMethod*>(indexCatalog->getEntry(desc)->accessMethod());
+                return accessMethod->compact(opCtx, timeSlice);
+            }();
+
+            if (status.isOK()) {
+                break;
+            }
+            if (status != ErrorCodes::ExceededTimeLimit) {
+                return status;
+            }
+
+            // The table is not compacted yet. Pause without holding any locks before the next
+            // slice, to leave disk bandwidth to other operations.
+            opCtx->sleepFor(Milliseconds(gCompactSliceIntervalMillis.load()));
+        }
+        progress.hit();
+    }
+    return Status::OK();
+}
+
 }  // namespace
 
 StatusWith<int64_t> compactCollection(OperationContext* opCtx,
                                       const NamespaceString& collectionNss) {
-    AutoGetDb autoDb(opCtx, collectionNss.db(), MODE_IX);
-    Database* database = autoDb.getDb();
+    boost::optional<AutoGetDb> autoDb;
+    autoDb.emplace(opCtx, collectionNss.db(), MODE_IX);
+    Database* database = autoDb->getDb();
     uassert(ErrorCodes::NamespaceNotFound, "database does not exist", database);
 
     // The collection lock will be downgraded to an intent lock if the record store supports
@@ -86,7 +156,8 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
 
     auto recordStore = collection->getRecordStore();
 
-    OldClientContext ctx(opCtx, collectionNss.ns());
+    boost::optional<OldClientContext> ctx;
+    ctx.emplace(opCtx, collectionNss.ns());
 
     if (!recordStore->compactSupported())
         return Status(ErrorCodes::CommandNotSupported,
@@ -112,7 +183,44 @@ StatusWith<int64_t> compactCollection(OperationContext* opCtx,
     auto oldTotalSize = recordStore->storageSize(opCtx) + collection->getIndexSize(opCtx);
     auto indexCatalog = collection->getIndexCatalog();
 
-    Status status = recordStore->compact(opCtx);
+    const Seconds timeSlice(gCompactTimeSliceSeconds.load());
+    if (recordStore->supportsOnlineCompaction() && timeSlice > Seconds(0)) {
+        // Compact in slices, taking the locks again for each slice.
+        const auto uuid = collection->uuid();
+        std::vector<std::string> indexNames;
+        auto it = indexCatalog->getIndexIterator(opCtx, false /* includeUnfinishedIndexes */);
+        while (it->more()) {
+            indexNames.push_back(it->next()->descriptor()->indexName());
+        }
+
+        collection.reset();
+        ctx.reset();
+        collLk.reset();
+        autoDb.reset();
+
+        Status status =
+            compactTablesIncrementally(opCtx, collectionNss, uuid, indexNames, timeSlice);
+        if (!status.isOK())
+            return status;
+
+        AutoGetCollection compacted(
+            opCtx, NamespaceStringOrUUID(collectionNss.db().toString(), uuid), MODE_IS);
+        if (!compacted)
+            return Status(ErrorCodes::NamespaceNotFound,
+                          "collection was dropped during compaction");
+
+        auto totalSizeDiff = oldTotalSize - compacted->getRecordStore()->storageSize(opCtx) -
+            compacted->getIndexSize(opCtx);
+        LOGV2(5963015,
+              "compact {namespace} end, bytes freed: {freedBytes}",
+              "Compact end",
+              "namespace"_attr = collectionNss,
+              "freedBytes"_attr = totalSizeDiff,
+              "incremental"_attr = true);
+        return totalSizeDiff;
+    }
+
+    Status status = recordStore->compact(opCtx, boost::none);
     if (!status.isOK())
         return status;
 
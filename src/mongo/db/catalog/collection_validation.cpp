@@ -39,12 +39,18 @@
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/index_consistency.h"
 #include "mongo/db/catalog/validate_adaptor.h"
+#include "mongo/db/catalog/validate_gen.h"
+#include "mongo/db/client.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/index/index_access_method.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 
@@ -105,21 +111,292 @@ void _validateIndexesInternalStructure(OperationContext* opCtx,
     }
 }
 
+/**
+ * Traverses the indexes of a background validation from several threads at once, each reading at
+ * the validation timestamp through an operation, cursor and intent locks of its own. The locks are
+ * yielded periodically as the validating operation does. The validating operation waits without
+ * its database and collection locks, and reports the progress of the threads.
+ */
+class ConcurrentIndexTraversal {
+public:
+    ConcurrentIndexTraversal(ValidateState* validateState, ValidateAdaptor* indexValidator)
+        : _validateState(validateState),
+          _indexValidator(indexValidator),
+          _dbName(validateState->nss().db().toString()),
+          _indexResults(validateState->getIndexes().size()) {}
+
+    /**
+     * Traverses the indexes with 'numThreads' threads, setting the number of keys traversed for
+     * each index in 'numTraversedKeys' and merging the errors found into 'results'. Returns false
+     * without traversing any index if the history at the validation timestamp cannot be kept for
+     * the threads to read.
+     */
+    bool run(OperationContext* opCtx,
+             size_t numThreads,
+             std::vector<int64_t>* numTraversedKeys,
+             ValidateResults* results);
+
+private:
+    struct IndexTraversalResults {
+        int64_t numTraversedKeys = 0;
+        ValidateResults results;
+    };
+
+    void _runWorker(OperationContext* opCtx);
+
+    void _traverseIndex(OperationContext* opCtx,
+                        const IndexCatalogEntry* index,
+                        IndexTraversalResults* indexResults);
+
+    /**
+     * Records the first error hit by a thread and interrupts the others.
+     */
+    void _recordFailure(Status status);
+
+    ValidateState* const _validateState;
+    ValidateAdaptor* const _indexValidator;
+    const std::string _dbName;
+
+    // The results of traversing the index at the same position in the validated indexes.
+    std::vector<IndexTraversalResults> _indexResults;
+
+    // The position of the next index for a thread to traverse.
+    AtomicWord<size_t> _nextIndex{0};
+
+    // The number of keys traversed over all indexes, to report progress.
+    AtomicWord<long long> _keysTraversed{0};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ConcurrentIndexTraversal::_mutex");
+    stdx::condition_variable _workerFinished;
+    size_t _numFinishedWorkers = 0;
+    std::vector<OperationContext*> _workerOpCtxs;
+    Status _firstError = Status::OK();
+};
+
+bool ConcurrentIndexTraversal::run(OperationContext* opCtx,
+                                   size_t numThreads,
+                                   std::vector<int64_t>* numTraversedKeys,
+                                   ValidateResults* results) {
+    const Timestamp validateTs = *_validateState->getValidateTimestamp();
+
+    // The open snapshot of this operation keeps the history at the validation timestamp only for
+    // itself. The threads start transactions of their own, each time they yield, so pin it.
+    auto storageEngine = opCtx->getServiceContext()->getStorageEngine();
+    const std::string pinName = str::stream()
+        << "validate-" << _validateState->uuid() << "-" << opCtx->getOpID();
+    auto pinned = storageEngine->pinOldestTimestamp(
+        opCtx, pinName, validateTs, /*roundUpIfTooOld=*/false);
+    if (!pinned.isOK()) {
+        LOGV2_OPTIONS(5963016,
+                      {LogComponent::kIndex},
+                      "Traversing indexes one after the other as the history at the validation "
+                      "timestamp cannot be pinned",
+                      "namespace"_attr = _validateState->nss(),
+                      "validateTimestamp"_attr = validateTs,
+                      "error"_attr = pinned.getStatus());
+        return false;
+    }
+    ON_BLOCK_EXIT([&] { storageEngine->unpinOldestTimestamp(pinName); });
+
+    _validateState->runWithoutCollectionLocks(opCtx, [&] {
+        auto serviceContext = opCtx->getServiceContext();
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+
+        try {
+            for (size_t idx = 0; idx < numThreads; ++idx) {
+                threads.emplace_back([this, serviceContext, idx] {
+                    const std::string threadName = str::stream() << "ValidateIndexes-" << idx;
+                    ThreadClient tc(threadName, serviceContext);
+                    auto workerOpCtx = cc().makeOperationContext();
+                    {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.push_back(workerOpCtx.get());
+                    }
+                    ON_BLOCK_EXIT([&] {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.erase(std::find(
+                            _workerOpCtxs.begin(), _workerOpCtxs.end(), workerOpCtx.get()));
+                        ++_numFinishedWorkers;
+                        _workerFinished.notify_all();
+                    });
+
+                    try {
+                        _runWorker(workerOpCtx.get());
+                    } catch (const DBException& ex) {
+                        _recordFailure(ex.toStatus());
+                    }
+                });
+            }
+        } catch (const std::exception& ex) {
+            _recordFailure({ErrorCodes::InternalError,
+                            str::stream() << "Failed to start an index validation thread: "
+                                          << ex.what()});
+            throw;
+        }
+
+        // Wait for the threads while reporting their progress, and stop them if this operation is
+        // interrupted.
+        try {
+            stdx::unique_lock<Latch> lk(_mutex);
+            while (!opCtx->waitForConditionOrInterruptFor(_workerFinished, lk, Seconds(1), [&] {
+                return _numFinishedWorkers == threads.size();
+            })) {
+                _indexValidator->reportIndexTraversalProgress(opCtx, _keysTraversed.load());
+            }
+        } catch (const DBException& ex) {
+            _recordFailure(ex.toStatus());
+            throw;
+        }
+    });
+
+    uassertStatusOK(_firstError);
+    _indexValidator->reportIndexTraversalProgress(opCtx, _keysTraversed.load());
+
+    const auto& indexes = _validateState->getIndexes();
+    for (size_t idx = 0; idx < indexes.size(); ++idx) {
+        const auto& indexName = indexes[idx]->descriptor()->indexName();
+        auto& indexResults = _indexResults[idx];
+        (*numTraversedKeys)[idx] = indexResults.numTraversedKeys;
+
+        auto& workerIndexResults = indexResults.results.indexResultsMap[indexName];
+        auto& curIndexResults = results->indexResultsMap[indexName];
+        curIndexResults.valid = curIndexResults.valid && workerIndexResults.valid;
+        std::move(workerIndexResults.errors.begin(),
+                  workerIndexResults.errors.end(),
+                  std::back_inserter(curIndexResults.errors));
+        std::move(workerIndexResults.warnings.begin(),
+                  workerIndexResults.warnings.end(),
+                  std::back_inserter(curIndexResults.warnings));
+
+        results->valid = results->valid && indexResults.results.valid;
+        std::move(indexResults.results.errors.begin(),
+                  indexResults.results.errors.end(),
+                  std::back_inserter(results->errors));
+        std::move(indexResults.results.warnings.begin(),
+                  indexResults.results.warnings.end(),
+                  std::back_inserter(results->warnings));
+    }
+    return true;
+}
+
+void ConcurrentIndexTraversal::_runWorker(OperationContext* opCtx) {
+    opCtx->recoveryUnit()->setTimestampReadSource(RecoveryUnit::ReadSource::kProvided,
+                                                  _validateState->getValidateTimestamp());
+
+    // Like the validating operation, avoid taking the PBWM lock and hold the global lock
+    // throughout, which prevents the catalog from being re-opened.
+    ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWM(opCtx->lockState());
+    Lock::GlobalLock globalLock(opCtx, MODE_IS);
+
+    const auto& indexes = _validateState->getIndexes();
+    for (size_t idx = _nextIndex.fetchAndAdd(1); idx < indexes.size();
+         idx = _nextIndex.fetchAndAdd(1)) {
+        _traverseIndex(opCtx, indexes[idx].get(), &_indexResults[idx]);
+    }
+}
+
+void ConcurrentIndexTraversal::_traverseIndex(OperationContext* opCtx,
+                                              const IndexCatalogEntry* index,
+                                              IndexTraversalResults* indexResults) {
+    const NamespaceStringOrUUID nssOrUUID(_dbName, _validateState->uuid());
+    const IndexDescriptor* descriptor = index->descriptor();
+
+    LOGV2_OPTIONS(20296,
+                  {LogComponent::kIndex},
+                  "Validating index consistency",
+                  "index"_attr = descriptor->indexName(),
+                  "namespace"_attr = _validateState->nss());
+
+    boost::optional<Lock::DBLock> dbLock;
+    boost::optional<Lock::CollectionLock> collLock;
+    auto lock = [&] {
+        dbLock.emplace(opCtx, _dbName, MODE_IS);
+        try {
+            collLock.emplace(opCtx, nssOrUUID, MODE_IS);
+        } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+            uasserted(ErrorCodes::Interrupted,
+                      str::stream() << "Interrupted due to: collection drop: "
+                                    << _validateState->nss() << " (" << _validateState->uuid()
+                                    << ") while validating the collection");
+        }
+        uassert(ErrorCodes::Interrupted,
+                str::stream() << "Interrupted due to: index being validated was dropped from "
+                                 "collection: "
+                              << _validateState->nss() << " (" << _validateState->uuid()
+                              << "), index: " << descriptor->indexName(),
+                !index->isDropped());
+    };
+    lock();
+
+    SortedDataInterfaceThrottleCursor indexCursor(
+        opCtx, index->accessMethod(), _validateState->getDataThrottle());
+    _indexValidator->traverseIndexWithCursor(
+        opCtx,
+        index,
+        &indexCursor,
+        [&] {
+            // Release the locks and the snapshot to let DDL operations through and to relieve
+            // cache pressure. The next snapshot is read at the same timestamp.
+            indexCursor.save();
+            collLock.reset();
+            dbLock.reset();
+            opCtx->recoveryUnit()->abandonSnapshot();
+            lock();
+            indexCursor.restore();
+        },
+        &_keysTraversed,
+        &indexResults->numTraversedKeys,
+        &indexResults->results);
+}
+
+void ConcurrentIndexTraversal::_recordFailure(Status status) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_firstError.isOK()) {
+        _firstError = std::move(status);
+    }
+
+    for (auto workerOpCtx : _workerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+        workerOpCtx->getServiceContext()->killOperation(clientLock, workerOpCtx);
+    }
+}
+
 /**
  * Validates each index in the Index Catalog using the cursors in 'indexCursors'.
  *
  * If 'level' is kValidateFull, then we will compare new index entry counts with a previously taken
  * count saved in 'numIndexKeysPerIndex'.
+ *
+ * Background validation with a validation timestamp traverses up to 'validateIndexConcurrency'
+ * indexes at once.
  */
 void _validateIndexes(OperationContext* opCtx,
                       ValidateState* validateState,
+                      IndexConsistency* indexConsistency,
                       ValidateAdaptor* indexValidator,
                       ValidateResults* results) {
-    // Validate Indexes, checking for mismatch between index entries and collection records.
-    for (const auto& index : validateState->getIndexes()) {
+    const auto& indexes = validateState->getIndexes();
+    std::vector<int64_t> numTraversedKeys(indexes.size());
+
+    const size_t concurrency =
+        std::min(static_cast<size_t>(gValidateIndexConcurrency.load()), indexes.size());
+    bool traversed = false;
+    if (concurrency > 1 && validateState->isBackground() &&
+        validateState->getValidateTimestamp()) {
+        indexConsistency->setConcurrentIndexTraversal();
+        traversed = ConcurrentIndexTraversal(validateState, indexValidator)
+                        .run(opCtx, concurrency, &numTraversedKeys, results);
+    }
+
+    for (size_t idx = 0; !traversed && idx < indexes.size(); ++idx) {
         opCtx->checkForInterrupt();
 
-        const IndexDescriptor* descriptor = index->descriptor();
+        const IndexDescriptor* descriptor = indexes[idx]->descriptor();
 
         LOGV2_OPTIONS(20296,
                       {LogComponent::kIndex},
@@ -127,11 +404,15 @@ void _validateIndexes(OperationContext* opCtx,
                       "index"_attr = descriptor->indexName(),
                       "namespace"_attr = validateState->nss());
 
-        int64_t numTraversedKeys;
-        indexValidator->traverseIndex(opCtx, index.get(), &numTraversedKeys, results);
+        indexValidator->traverseIndex(opCtx, indexes[idx].get(), &numTraversedKeys[idx], results);
+    }
+
+    // Validate Indexes, checking for mismatch between index entries and collection records.
+    for (size_t idx = 0; idx < indexes.size(); ++idx) {
+        const IndexDescriptor* descriptor = indexes[idx]->descriptor();
 
         auto& curIndexResults = (results->indexResultsMap)[descriptor->indexName()];
-        curIndexResults.keysTraversed = numTraversedKeys;
+        curIndexResults.keysTraversed = numTraversedKeys[idx];
 
         // If we are performing a full index validation, we have information on the number of index
         // keys validated in _validateIndexesInternalStructure (when we validated the internal
@@ -148,10 +429,10 @@ void _validateIndexes(OperationContext* opCtx,
             // comprised (which was set in _validateIndexesInternalStructure). If the index is
             // corrupted, there is no use in checking if the traversal yielded the same key count.
             if (curIndexResults.valid) {
-                if (numIndexKeys != numTraversedKeys) {
+                if (numIndexKeys != numTraversedKeys[idx]) {
                     curIndexResults.valid = false;
                     string msg = str::stream()
-                        << "number of traversed index entries (" << numTraversedKeys
+                        << "number of traversed index entries (" << numTraversedKeys[idx]
                         << ") does not match the number of expected index entries (" << numIndexKeys
                         << ")";
                     results->errors.push_back(msg);
@@ -547,7 +828,7 @@ Status validate(OperationContext* opCtx,
         }
 
         // Validate indexes and check for mismatches.
-        _validateIndexes(opCtx, &validateState, &indexValidator, results);
+        _validateIndexes(opCtx, &validateState, &indexConsistency, &indexValidator, results);
 
         if (indexConsistency.haveEntryMismatch()) {
             LOGV2_OPTIONS(20305,
@@ -50,8 +50,10 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/insert.h"
+#include "mongo/db/query/collation/collation_spec.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
 #include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/idl/command_generic_argument.h"
 #include "mongo/logv2/log.h"
@@ -421,9 +423,29 @@ Status _createCollection(OperationContext* opCtx,
         }
 
         if (collectionOptions.clusteredIndex && !nss.isTimeseriesBucketsCollection()) {
-            return Status(
-                ErrorCodes::InvalidOptions,
-                "The 'clusteredIndex' option is only supported on time-series buckets collections");
+            // Collections replicated from a primary which has general clustered collections enabled
+            // are created whatever the value of the feature flag here.
+            if (opCtx->writesAreReplicated() &&
+                !feature_flags::gClusteredIndexes.isEnabled(
+                    serverGlobalParams.featureCompatibility)) {
+                return Status(ErrorCodes::InvalidOptions,
+                              "The 'clusteredIndex' option is only supported on time-series "
+                              "buckets collections");
+            }
+
+            if (nss.isSystem() || collectionOptions.capped) {
+                return Status(ErrorCodes::InvalidOptions,
+                              "The 'clusteredIndex' option is not supported on system or capped "
+                              "collections");
+            }
+
+            // The RecordIds of a clustered collection order the _id values without collation.
+            if (!collectionOptions.collation.isEmpty() &&
+                collectionOptions.collation[Collation::kLocaleFieldName].str() !=
+                    CollationSpec::kSimpleBinaryComparison) {
+                return Status(ErrorCodes::InvalidOptions,
+                              "The 'clusteredIndex' option requires the simple collation");
+            }
         }
 
         if (collectionOptions.clusteredIndex && idIndex && !idIndex->isEmpty()) {
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/index_catalog_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/base/init.h"
@@ -57,6 +58,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/ops/delete.h"
 #include "mongo/db/query/collation/collation_spec.h"
@@ -72,6 +74,7 @@
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/storage_engine_init.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/ttl_collection_cache.h"
 #include "mongo/db/vector_clock.h"
@@ -689,7 +692,7 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
 
     const bool isSparse = spec["sparse"].trueValue();
 
-    if (pluginName == IndexNames::WILDCARD) {
+    if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
         if (isSparse) {
             return Status(ErrorCodes::CannotCreateIndex,
                           str::stream() << "Index type '" << pluginName
@@ -709,6 +712,24 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
         }
     }
 
+    // Indexes replicated from a primary which has columnstore indexes enabled are created whatever
+    // the value of the feature flag here.
+    if (pluginName == IndexNames::COLUMN && opCtx->writesAreReplicated() &&
+        !feature_flags::gColumnstoreIndexes.isEnabled(serverGlobalParams.featureCompatibility)) {
+        return Status(ErrorCodes::CannotCreateIndex,
+                      str::stream() << "Index type '" << pluginName
+                                    << "' requires featureFlagColumnstoreIndexes to be enabled "
+                                       "and the latest featureCompatibilityVersion");
+    }
+
+    // A column scan reads the row markers of a columnstore index in place of the collection, so
+    // the index must hold every document.
+    if (pluginName == IndexNames::COLUMN && spec.getField("partialFilterExpression")) {
+        return Status(ErrorCodes::CannotCreateIndex,
+                      str::stream() << "Index type '" << pluginName
+                                    << "' does not support the partialFilterExpression option");
+    }
+
     // Create an ExpressionContext, used to parse the match expression and to house the collator for
     // the remaining checks.
     boost::intrusive_ptr<ExpressionContext> expCtx(
@@ -761,6 +782,10 @@ Status IndexCatalogImpl::_isSpecOk(OperationContext* opCtx, const BSONObj& spec)
             "Text indexes are not supported on collections clustered by _id",
             !_collection->isClustered() || pluginName != IndexNames::TEXT);
 
+    uassert(ErrorCodes::InvalidOptions,
+            "Columnstore indexes are not supported on collections clustered by _id",
+            !_collection->isClustered() || pluginName != IndexNames::COLUMN);
+
     if (IndexDescriptor::isIdIndexPattern(key)) {
         if (_collection->isClustered()) {
             return Status(ErrorCodes::CannotCreateIndex,
@@ -1386,7 +1411,18 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     InsertDeleteOptions options;
     prepareInsertDeleteOptions(opCtx, coll->ns(), index->descriptor(), &options);
 
-    for (auto bsonRecord : bsonRecords) {
+    // The keys of a non-unique index need no per-document duplicate handling, so the records which
+    // share a timestamp can have their keys inserted together. Side writes of hybrid builds still
+    // go through the interceptor one document at a time.
+    const bool canBatch = !index->isHybridBuilding() && !index->descriptor()->unique();
+
+    for (auto it = bsonRecords.begin(); it != bsonRecords.end();) {
+        auto runEnd = std::next(it);
+        while (canBatch && runEnd != bsonRecords.end() && runEnd->ts == it->ts) {
+            ++runEnd;
+        }
+
+        const auto& bsonRecord = *it;
         invariant(bsonRecord.id != RecordId());
 
         if (!bsonRecord.ts.isNull()) {
@@ -1395,6 +1431,17 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
                 return status;
         }
 
+        if (std::distance(it, runEnd) > 1) {
+            Status status = _indexFilteredRecordsInBatch(
+                opCtx, coll, index, it, runEnd, options, keysInsertedOut);
+            if (!status.isOK()) {
+                return status;
+            }
+            it = runEnd;
+            continue;
+        }
+        ++it;
+
         auto keys = executionCtx.keys();
         auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
         auto multikeyPaths = executionCtx.multikeyPaths();
@@ -1427,6 +1474,77 @@ Status IndexCatalogImpl::_indexFilteredRecords(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status IndexCatalogImpl::_indexFilteredRecordsInBatch(
+    OperationContext* opCtx,
+    const CollectionPtr& coll,
+    IndexCatalogEntry* index,
+    std::vector<BsonRecord>::const_iterator first,
+    std::vector<BsonRecord>::const_iterator last,
+    const InsertDeleteOptions& options,
+    int64_t* keysInsertedOut) {
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+    IndexAccessMethod* iam = index->accessMethod();
+
+    std::vector<KeyString::Value> keysToInsert;
+    KeyStringSet multikeyMetadataKeysToSet;
+    MultikeyPaths multikeyPathsToSet;
+    bool shouldMarkMultikey = false;
+    int64_t numMultikeyMetadataKeys = 0;
+
+    for (auto it = first; it != last; ++it) {
+        invariant(it->id != RecordId());
+
+        auto keys = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto multikeyPaths = executionCtx.multikeyPaths();
+
+        iam->getKeys(executionCtx.pooledBufferBuilder(),
+                     *it->docPtr,
+                     options.getKeysMode,
+                     IndexAccessMethod::GetKeysContext::kAddingKeys,
+                     keys.get(),
+                     multikeyMetadataKeys.get(),
+                     multikeyPaths.get(),
+                     it->id,
+                     IndexAccessMethod::kNoopOnSuppressedErrorFn);
+
+        // Whether a document makes the index multikey depends on that document's keys alone, so
+        // decide it per document and mark the index once for the whole batch.
+        if (iam->shouldMarkIndexAsMultikey(keys->size(), *multikeyMetadataKeys, *multikeyPaths)) {
+            if (!shouldMarkMultikey) {
+                multikeyPathsToSet = *multikeyPaths;
+            } else {
+                MultikeyPathTracker::mergeMultikeyPaths(&multikeyPathsToSet, *multikeyPaths);
+            }
+            multikeyMetadataKeysToSet.insert(multikeyMetadataKeys->begin(),
+                                             multikeyMetadataKeys->end());
+            shouldMarkMultikey = true;
+        }
+        numMultikeyMetadataKeys += multikeyMetadataKeys->size();
+
+        keysToInsert.insert(keysToInsert.end(), keys->begin(), keys->end());
+    }
+
+    // Every key ends with the RecordId of its document, so the keys are distinct across the batch.
+    std::sort(keysToInsert.begin(), keysToInsert.end());
+    const KeyStringSet keys(
+        boost::container::ordered_unique_range_t(), keysToInsert.begin(), keysToInsert.end());
+
+    int64_t numInserted;
+    Status status = iam->insertKeysBatch(opCtx, keys, &numInserted);
+    if (!status.isOK()) {
+        return status;
+    }
+
+    if (shouldMarkMultikey) {
+        index->setMultikey(opCtx, coll, multikeyMetadataKeysToSet, multikeyPathsToSet);
+    }
+    if (keysInsertedOut) {
+        *keysInsertedOut += numInserted + numMultikeyMetadataKeys;
+    }
+    return Status::OK();
+}
+
 Status IndexCatalogImpl::_indexRecords(OperationContext* opCtx,
                                        const CollectionPtr& coll,
                                        IndexCatalogEntry* index,
@@ -1686,7 +1804,7 @@ Status IndexCatalogImpl::compactIndexes(OperationContext* opCtx) const {
                     1,
                     "compacting index: {entry_descriptor}",
                     "entry_descriptor"_attr = *(entry->descriptor()));
-        Status status = entry->accessMethod()->compact(opCtx);
+        Status status = entry->accessMethod()->compact(opCtx, boost::none);
         if (!status.isOK()) {
             LOGV2_ERROR(20377,
                         "Failed to compact index",
@@ -323,6 +323,19 @@ private:
                       const InsertDeleteOptions& options,
                       int64_t* keysInsertedOut);
 
+    /**
+     * Generates the keys of every record in ['first', 'last') for 'index', sorts them together and
+     * inserts them with one batch. The caller must have set the timestamp shared by the records.
+     * Only valid for a ready, non-unique index.
+     */
+    Status _indexFilteredRecordsInBatch(OperationContext* opCtx,
+                                        const CollectionPtr& coll,
+                                        IndexCatalogEntry* index,
+                                        std::vector<BsonRecord>::const_iterator first,
+                                        std::vector<BsonRecord>::const_iterator last,
+                                        const InsertDeleteOptions& options,
+                                        int64_t* keysInsertedOut);
+
     Status _indexFilteredRecords(OperationContext* opCtx,
                                  const CollectionPtr& coll,
                                  IndexCatalogEntry* index,
@@ -128,6 +128,11 @@ void IndexConsistency::setSecondPhase() {
     _firstPhase = false;
 }
 
+void IndexConsistency::setConcurrentIndexTraversal() {
+    invariant(_firstPhase);
+    _concurrentIndexTraversal = true;
+}
+
 void IndexConsistency::repairMissingIndexEntries(OperationContext* opCtx,
                                                  ValidateResults* results) {
     invariant(_validateState->getIndexes().size() > 0);
@@ -356,8 +361,14 @@ void IndexConsistency::addIndexKey(OperationContext* opCtx,
     if (_firstPhase) {
         // During the first phase of validation we only keep track of the count for the index entry
         // keys encountered.
-        _indexKeyBuckets[hash].indexKeyCount--;
-        _indexKeyBuckets[hash].bucketSizeBytes += ks.getSize();
+        {
+            stdx::unique_lock<Latch> lk;
+            if (_concurrentIndexTraversal) {
+                lk = stdx::unique_lock<Latch>(_bucketMutexes[hash % kNumBucketMutexes]);
+            }
+            _indexKeyBuckets[hash].indexKeyCount--;
+            _indexKeyBuckets[hash].bucketSizeBytes += ks.getSize();
+        }
         indexInfo->numKeys++;
 
         if (MONGO_unlikely(_validateState->extraLoggingForTest())) {
@@ -29,9 +29,12 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/validate_state.h"
 #include "mongo/db/storage/key_string.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
@@ -159,6 +162,12 @@ public:
      */
     void setSecondPhase();
 
+    /**
+     * Allows several threads to add the index keys of different indexes at the same time during
+     * the first phase of index validation. Must be called before any index keys are added.
+     */
+    void setConcurrentIndexTraversal();
+
     /**
      * If repair mode enabled, try inserting _missingIndexEntries into indexes.
      */
@@ -185,6 +194,8 @@ private:
 
     IndexConsistency() = delete;
 
+    static constexpr size_t kNumBucketMutexes = 64;
+
     CollectionValidation::ValidateState* _validateState;
 
     // We map the hashed KeyString values to a bucket that contains the count of how many
@@ -200,6 +211,12 @@ private:
 
     std::vector<IndexKeyBucket> _indexKeyBuckets;
 
+    // Set when indexes are traversed concurrently. Each bucket in '_indexKeyBuckets' is then
+    // updated under the mutex at the bucket's position modulo 'kNumBucketMutexes', as threads
+    // traversing different indexes may hash keys to the same bucket.
+    bool _concurrentIndexTraversal = false;
+    std::array<Mutex, kNumBucketMutexes> _bucketMutexes;
+
     // A vector of IndexInfo indexes by index number
     IndexInfoMap _indexesInfo;
 
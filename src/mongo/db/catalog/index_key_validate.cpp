@@ -150,7 +150,7 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
                                           << static_cast<int>(indexVersion)};
                 }
 
-                if (pluginName == IndexNames::WILDCARD) {
+                if (pluginName == IndexNames::WILDCARD || pluginName == IndexNames::COLUMN) {
                     return {code,
                             str::stream() << "'" << pluginName
                                           << "' index plugin is not allowed with index version v:"
@@ -197,6 +197,15 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "wildcard indexes do not allow compounding");
         }
 
+        // A columnstore index always covers the whole document.
+        if (pluginName == IndexNames::COLUMN &&
+            (key.nFields() != 1 || keyElement.fieldNameStringData() != "$**")) {
+            return Status(code,
+                          str::stream() << "The key pattern of a '" << IndexNames::COLUMN
+                                        << "' index must be {\"$**\": \"" << IndexNames::COLUMN
+                                        << "\"}");
+        }
+
         // Ensure that the fields on which we are building the index are valid: a field must not
         // begin with a '$' unless it is part of a wildcard, DBRef or text index, and a field path
         // cannot contain an empty field. If a field cannot be created or updated, it should not be
@@ -209,9 +218,10 @@ Status validateKeyPattern(const BSONObj& key, IndexDescriptor::IndexVersion inde
             return Status(code, "Index keys cannot be an empty field.");
         }
 
-        // "$**" is acceptable for a text index or wildcard index.
+        // "$**" is acceptable for a text, wildcard or columnstore index.
         if ((keyElement.fieldNameStringData() == "$**") &&
-            ((keyElement.isNumber()) || (keyElement.valuestrsafe() == IndexNames::TEXT)))
+            ((keyElement.isNumber()) || (keyElement.valuestrsafe() == IndexNames::TEXT) ||
+             (keyElement.valuestrsafe() == IndexNames::COLUMN)))
             continue;
 
         if ((keyElement.fieldNameStringData() == "_fts") &&
@@ -33,6 +33,7 @@
 
 #include "mongo/db/catalog/multi_index_block.h"
 
+#include <algorithm>
 #include <ostream>
 
 #include "mongo/base/error_codes.h"
@@ -43,7 +44,10 @@
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/multikey_paths.h"
+#include "mongo/db/index/skipped_record_tracker.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
 #include "mongo/db/operation_context.h"
@@ -55,6 +59,7 @@
 #include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/log_and_backoff.h"
 #include "mongo/util/progress_meter.h"
@@ -74,6 +79,10 @@ MONGO_FAIL_POINT_DEFINE(leaveIndexBuildUnfinishedForShutdown);
 
 namespace {
 
+// Limits on the documents buffered by a collection scan that generates keys on several threads.
+constexpr size_t kMaxKeyGenerationBatchDocs = 1000;
+constexpr size_t kMaxKeyGenerationBatchBytes = 16 * 1024 * 1024;
+
 size_t getEachIndexBuildMaxMemoryUsageBytes(size_t numIndexSpecs) {
     if (numIndexSpecs == 0) {
         return 0;
@@ -311,6 +320,7 @@ StatusWith<std::vector<BSONObj>> MultiIndexBlock::init(
                       eachIndexBuildMaxMemoryUsageBytes / 1024 / 1024);
 
             index.filterExpression = indexCatalogEntry->getFilterExpression();
+            index.generateKeysByDocument = descriptor->getAccessMethodName() == IndexNames::TEXT;
         }
 
         opCtx->recoveryUnit()->onCommit([ns = collection->ns(), this](auto commitTs) {
@@ -568,6 +578,46 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kCollectionScan;
 
+    // When building several indexes, or an index which generates keys by document, the scanned
+    // documents are buffered in batches and the keys of each batch are generated by several
+    // threads at once.
+    const bool anyIndexGeneratesKeysByDocument =
+        std::any_of(_indexes.begin(), _indexes.end(), [](const IndexToBuild& index) {
+            return index.generateKeysByDocument;
+        });
+    const size_t numKeyGenerationThreads = anyIndexGeneratesKeysByDocument
+        ? static_cast<size_t>(indexBuildKeyGenerationThreads.load())
+        : std::min(static_cast<size_t>(indexBuildKeyGenerationThreads.load()), _indexes.size());
+    std::unique_ptr<ThreadPool> keyGenerationPool;
+    if (numKeyGenerationThreads > 1) {
+        ThreadPool::Options options;
+        options.poolName = "IndexBuildKeyGeneration";
+        options.threadNamePrefix = "IndexBuildKeyGeneration-";
+        options.maxThreads = numKeyGenerationThreads - 1;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+        };
+        keyGenerationPool = std::make_unique<ThreadPool>(options);
+        keyGenerationPool->startup();
+    }
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+    ON_BLOCK_EXIT([&] {
+        if (keyGenerationPool) {
+            keyGenerationPool->shutdown();
+            keyGenerationPool->join();
+        }
+    });
+    auto flushBatch = [&] {
+        if (batch.empty()) {
+            return;
+        }
+        uassertStatusOK(_insertBatch(
+            opCtx, collection, keyGenerationPool.get(), numKeyGenerationThreads, batch));
+        batch.clear();
+        batchBytes = 0;
+    };
+
     BSONObj objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -590,7 +640,16 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
 
         // The external sorter is not part of the storage engine and therefore does not need
         // a WriteUnitOfWork to write keys.
-        uassertStatusOK(_insert(opCtx, objToIndex, loc));
+        if (keyGenerationPool) {
+            batchBytes += objToIndex.objsize();
+            batch.emplace_back(objToIndex.getOwned(), loc);
+            if (batch.size() >= kMaxKeyGenerationBatchDocs ||
+                batchBytes >= kMaxKeyGenerationBatchBytes) {
+                flushBatch();
+            }
+        } else {
+            uassertStatusOK(_insert(opCtx, objToIndex, loc));
+        }
 
         _failPointHangDuringBuild(opCtx,
                                   &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
@@ -602,6 +661,7 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
         // Go to the next document.
         progress->hit();
     }
+    flushBatch();
 }
 
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(OperationContext* opCtx,
@@ -636,6 +696,127 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx, const BSONObj& doc, con
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     ThreadPool* keyGenerationPool,
+                                     size_t numThreads,
+                                     const std::vector<std::pair<BSONObj, RecordId>>& batch) {
+    invariant(!_buildIsCleanedUp);
+    invariant(!batch.empty());
+
+    // Each thread records the documents whose key generation errors were suppressed separately.
+    std::vector<std::vector<std::vector<RecordId>>> skippedRecords(
+        numThreads, std::vector<std::vector<RecordId>>(_indexes.size()));
+    std::vector<Status> statuses(numThreads, Status::OK());
+
+    // The keys generated for each document, for the indexes which generate keys by document.
+    // Documents which do not match the filter of a partial index are left unset.
+    std::vector<std::vector<boost::optional<IndexAccessMethod::BulkBuilder::GeneratedKeys>>>
+        generatedKeys(_indexes.size());
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        if (_indexes[i].generateKeysByDocument) {
+            generatedKeys[i].resize(batch.size());
+        }
+    }
+
+    auto insertForThread = [&](OperationContext* threadOpCtx, size_t thread) {
+        for (size_t j = 0; j < batch.size(); ++j) {
+            const auto& [doc, loc] = batch[j];
+            for (size_t i = 0; i < _indexes.size(); ++i) {
+                auto& index = _indexes[i];
+                const size_t owner = index.generateKeysByDocument ? j : i;
+                if (owner % numThreads != thread) {
+                    continue;
+                }
+                if (index.filterExpression && !index.filterExpression->matchesBSON(doc)) {
+                    continue;
+                }
+
+                // When calling insert, BulkBuilderImpl's Sorter performs file I/O that may result
+                // in an exception.
+                try {
+                    Status status = Status::OK();
+                    if (index.generateKeysByDocument) {
+                        generatedKeys[i][j].emplace();
+                        status = index.bulk->generateKeys(threadOpCtx,
+                                                          doc,
+                                                          loc,
+                                                          index.options,
+                                                          generatedKeys[i][j].get_ptr(),
+                                                          &skippedRecords[thread][i]);
+                    } else {
+                        status = index.bulk->insert(
+                            threadOpCtx, doc, loc, index.options, &skippedRecords[thread][i]);
+                    }
+                    if (!status.isOK()) {
+                        statuses[thread] = status;
+                        return;
+                    }
+                } catch (...) {
+                    statuses[thread] = exceptionToStatus();
+                    return;
+                }
+            }
+        }
+    };
+
+    for (size_t thread = 1; thread < numThreads; ++thread) {
+        keyGenerationPool->schedule([&, thread](Status scheduleStatus) {
+            if (!scheduleStatus.isOK()) {
+                statuses[thread] = scheduleStatus;
+                return;
+            }
+            auto threadOpCtx = cc().makeOperationContext();
+            insertForThread(threadOpCtx.get(), thread);
+        });
+    }
+    insertForThread(opCtx, 0);
+    keyGenerationPool->waitForIdle();
+
+    for (const auto& status : statuses) {
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        try {
+            for (const auto& keys : generatedKeys[i]) {
+                if (keys) {
+                    _indexes[i].bulk->insertKeys(*keys);
+                }
+            }
+        } catch (...) {
+            return exceptionToStatus();
+        }
+    }
+
+    // Recording a skipped record writes to a temporary table, which must be done with the
+    // operation context of the index build.
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        for (const auto& threadSkippedRecords : skippedRecords) {
+            if (threadSkippedRecords[i].empty()) {
+                continue;
+            }
+            auto tracker = _indexes[i]
+                               .block->getEntry(opCtx, collection)
+                               ->indexBuildInterceptor()
+                               ->getSkippedRecordTracker();
+            try {
+                for (const auto& loc : threadSkippedRecords[i]) {
+                    tracker->record(opCtx, loc);
+                }
+            } catch (...) {
+                return exceptionToStatus();
+            }
+        }
+    }
+
+    _lastRecordIdInserted = batch.back().second;
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
@@ -61,6 +61,7 @@ class MatchExpression;
 class NamespaceString;
 class OperationContext;
 class ProgressMeterHolder;
+class ThreadPool;
 
 /**
  * Builds one or more indexes.
@@ -299,6 +300,11 @@ private:
         std::unique_ptr<IndexAccessMethod::BulkBuilder> bulk;
 
         InsertDeleteOptions options;
+
+        // Whether the keys of this index are generated by every key generation thread, each taking
+        // a share of the documents, rather than by a single thread. Set for text indexes, whose
+        // key generation tokenizes and stems every string in the document.
+        bool generateKeysByDocument = false;
     };
 
     void _writeStateToDisk(OperationContext* opCtx, const CollectionPtr& collection) const;
@@ -313,6 +319,20 @@ private:
 
     Status _insert(OperationContext* opCtx, const BSONObj& wholeDocument, const RecordId& loc);
 
+    /**
+     * Inserts a batch of documents into the bulk builders of all indexes. Index 'i' is handled by
+     * thread 'i % numThreads', where thread 0 is the calling thread and the others run on
+     * 'keyGenerationPool', so that each BulkBuilder is only used by one thread. The keys of the
+     * indexes which generate keys by document are instead generated for document 'j' by thread
+     * 'j % numThreads', and added to their BulkBuilders by the calling thread once all threads are
+     * done.
+     */
+    Status _insertBatch(OperationContext* opCtx,
+                        const CollectionPtr& collection,
+                        ThreadPool* keyGenerationPool,
+                        size_t numThreads,
+                        const std::vector<std::pair<BSONObj, RecordId>>& batch);
+
     /**
      * Performs a collection scan on the given collection and inserts the relevant index keys into
      * the external sorter.
@@ -34,6 +34,7 @@
 
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/util/fail_point.h"
 
 namespace mongo {
@@ -141,6 +142,8 @@ public:
      *
      * In addition to throttling, while the thread is waiting, its operation context remains
      * interruptible.
+     *
+     * May be called from several threads at once, which then share the limit.
      */
     void awaitIfNeeded(OperationContext* opCtx, const int64_t dataSize);
 
@@ -149,6 +152,9 @@ public:
     }
 
 private:
+    // Protects the tracked information below, but is not held while waiting.
+    Mutex _mutex = MONGO_MAKE_LATCH("DataThrottle::_mutex");
+
     // Point-in-time (milliseconds) when tracking for the current second has started.
     int64_t _startMillis;
 
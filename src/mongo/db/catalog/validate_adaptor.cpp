@@ -258,14 +258,42 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
                                     const IndexCatalogEntry* index,
                                     int64_t* numTraversedKeys,
                                     ValidateResults* results) {
-    const IndexDescriptor* descriptor = index->descriptor();
-    auto indexName = descriptor->indexName();
-    auto& indexResults = results->indexResultsMap[indexName];
-    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
-    int64_t numKeys = 0;
+    _startIndexTraversalProgress(opCtx);
 
-    bool isFirstEntry = true;
+    // Ensure that this index has an open index cursor.
+    const auto indexCursorIt =
+        _validateState->getIndexCursors().find(index->descriptor()->indexName());
+    invariant(indexCursorIt != _validateState->getIndexCursors().end());
 
+    _traverseIndex(opCtx,
+                   index,
+                   indexCursorIt->second.get(),
+                   [&] { _validateState->yield(opCtx); },
+                   nullptr,
+                   numTraversedKeys,
+                   results);
+}
+
+void ValidateAdaptor::traverseIndexWithCursor(OperationContext* opCtx,
+                                              const IndexCatalogEntry* index,
+                                              SortedDataInterfaceThrottleCursor* indexCursor,
+                                              const std::function<void()>& yield,
+                                              AtomicWord<long long>* keysTraversed,
+                                              int64_t* numTraversedKeys,
+                                              ValidateResults* results) {
+    invariant(keysTraversed);
+    _traverseIndex(opCtx, index, indexCursor, yield, keysTraversed, numTraversedKeys, results);
+}
+
+void ValidateAdaptor::reportIndexTraversalProgress(OperationContext* opCtx,
+                                                   long long keysTraversed) {
+    _startIndexTraversalProgress(opCtx);
+    if (keysTraversed > static_cast<long long>(_progress->done())) {
+        _progress->hit(static_cast<int>(keysTraversed - _progress->done()));
+    }
+}
+
+void ValidateAdaptor::_startIndexTraversalProgress(OperationContext* opCtx) {
     // The progress meter will be inactive after traversing the record store to allow the message
     // and the total to be set to different values.
     if (!_progress->isActive()) {
@@ -273,6 +301,22 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         stdx::unique_lock<Client> lk(*opCtx->getClient());
         _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, _totalIndexKeys));
     }
+}
+
+void ValidateAdaptor::_traverseIndex(OperationContext* opCtx,
+                                     const IndexCatalogEntry* index,
+                                     SortedDataInterfaceThrottleCursor* indexCursor,
+                                     const std::function<void()>& yield,
+                                     AtomicWord<long long>* keysTraversed,
+                                     int64_t* numTraversedKeys,
+                                     ValidateResults* results) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    auto indexName = descriptor->indexName();
+    auto& indexResults = results->indexResultsMap[indexName];
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
+    int64_t numKeys = 0;
+
+    bool isFirstEntry = true;
 
     const KeyString::Version version =
         index->accessMethod()->getSortedDataInterface()->getKeyStringVersion();
@@ -286,12 +330,6 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
     KeyString::Value firstKeyString = firstKeyStringBuilder.release();
     KeyString::Value prevIndexKeyStringValue;
 
-    // Ensure that this index has an open index cursor.
-    const auto indexCursorIt = _validateState->getIndexCursors().find(indexName);
-    invariant(indexCursorIt != _validateState->getIndexCursors().end());
-
-    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor = indexCursorIt->second;
-
     boost::optional<KeyStringEntry> indexEntry;
     try {
         indexEntry = indexCursor->seekForKeyString(opCtx, firstKeyString);
@@ -333,7 +371,11 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
             }
         }
 
-        _progress->hit();
+        if (keysTraversed) {
+            keysTraversed->fetchAndAddRelaxed(1);
+        } else {
+            _progress->hit();
+        }
         numKeys++;
         isFirstEntry = false;
         prevIndexKeyStringValue = indexEntry->keyString;
@@ -341,7 +383,7 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
         if (numKeys % kInterruptIntervalNumRecords == 0) {
             // Periodically checks for interrupts and yields.
             opCtx->checkForInterrupt();
-            _validateState->yield(opCtx);
+            yield();
         }
 
         try {
@@ -610,10 +652,11 @@ void ValidateAdaptor::validateIndexKeyCount(const IndexCatalogEntry* index,
 
     // Confirm that the number of index entries is not greater than the number of documents in the
     // collection. This check is only valid for indexes that are not multikey (indexed arrays
-    // produce an index key per array entry) and not $** indexes which can produce index keys for
-    // multiple paths within a single document.
+    // produce an index key per array entry) and not $** or columnstore indexes which can produce
+    // index keys for multiple paths within a single document.
     if (results.valid && !index->isMultikey() &&
-        desc->getIndexType() != IndexType::INDEX_WILDCARD && numTotalKeys > _numRecords) {
+        desc->getIndexType() != IndexType::INDEX_WILDCARD &&
+        desc->getIndexType() != IndexType::INDEX_COLUMN && numTotalKeys > _numRecords) {
         std::string err = str::stream()
             << "index " << desc->indexName() << " is not multi-key, but has more entries ("
             << numTotalKeys << ") than documents in the index (" << _numRecords << ")";
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mongo/db/catalog/validate_state.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/progress_meter.h"
 
 namespace mongo {
@@ -68,6 +71,26 @@ public:
                        int64_t* numTraversedKeys,
                        ValidateResults* results);
 
+    /**
+     * Traverses the index in the same way as traverseIndex(), but with the given cursor, for
+     * threads other than the validating one which traverse several indexes concurrently. Calls
+     * 'yield' periodically instead of yielding the shared validation state, and adds to
+     * 'keysTraversed' rather than reporting progress.
+     */
+    void traverseIndexWithCursor(OperationContext* opCtx,
+                                 const IndexCatalogEntry* index,
+                                 SortedDataInterfaceThrottleCursor* indexCursor,
+                                 const std::function<void()>& yield,
+                                 AtomicWord<long long>* keysTraversed,
+                                 int64_t* numTraversedKeys,
+                                 ValidateResults* results);
+
+    /**
+     * Reports 'keysTraversed' index keys as scanned so far in the progress of 'opCtx', for indexes
+     * traversed with traverseIndexWithCursor() by other threads.
+     */
+    void reportIndexTraversalProgress(OperationContext* opCtx, long long keysTraversed);
+
     /**
      * Traverses the record store to retrieve every record and go through its document key
      * set to keep track of the index consistency during a validation.
@@ -83,6 +106,16 @@ public:
     void validateIndexKeyCount(const IndexCatalogEntry* index, IndexValidateResults& results);
 
 private:
+    void _startIndexTraversalProgress(OperationContext* opCtx);
+
+    void _traverseIndex(OperationContext* opCtx,
+                        const IndexCatalogEntry* index,
+                        SortedDataInterfaceThrottleCursor* indexCursor,
+                        const std::function<void()>& yield,
+                        AtomicWord<long long>* keysTraversed,
+                        int64_t* numTraversedKeys,
+                        ValidateResults* results);
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
 
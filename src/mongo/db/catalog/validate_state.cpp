@@ -153,6 +153,18 @@ void ValidateState::_yieldLocks(OperationContext* opCtx) {
     }
 };
 
+void ValidateState::runWithoutCollectionLocks(OperationContext* opCtx,
+                                              const std::function<void()>& work) {
+    invariant(isBackground());
+
+    _collectionLock.reset();
+    _databaseLock.reset();
+
+    work();
+
+    _yieldLocks(opCtx);
+}
+
 void ValidateState::_yieldCursors(OperationContext* opCtx) {
     // Save all the cursors.
     for (const auto& indexCursor : _indexCursors) {
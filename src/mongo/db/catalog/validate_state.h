@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/collection_validation.h"
 #include "mongo/db/catalog/throttle_cursor.h"
@@ -161,6 +163,22 @@ public:
         return _validateTs;
     }
 
+    /**
+     * The data throttle shared by all the cursors of this validation.
+     */
+    DataThrottle* getDataThrottle() {
+        return &_dataThrottle;
+    }
+
+    /**
+     * Releases the database and collection locks while 'work' runs, then re-acquires them and
+     * checks that validation can resume in the same way as yield() does. Throws on interruptions.
+     *
+     * Used by background validation while other threads traverse indexes with locks of their own,
+     * so that those threads are not queued behind a DDL operation waiting for the locks held here.
+     */
+    void runWithoutCollectionLocks(OperationContext* opCtx, const std::function<void()>& work);
+
 private:
     ValidateState() = delete;
 
@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/change_stream_pre_images_collection.h"
+
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/database.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/exec/delete.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace change_stream_pre_images {
+namespace {
+
+const auto& kPreImagesNss = NamespaceString::kChangeStreamPreImagesNamespace;
+
+constexpr StringData kNsUUIDFieldName = "nsUUID"_sd;
+constexpr StringData kTsFieldName = "ts"_sd;
+constexpr StringData kPreImageFieldName = "preImage"_sd;
+
+/**
+ * Returns the UUID of the collection that the first pre-image with an _id after 'startKey' belongs
+ * to, or boost::none if there is no such pre-image.
+ */
+boost::optional<UUID> findNextNsUUID(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     const IndexDescriptor* idIndex,
+                                     const BSONObj& startKey,
+                                     BoundInclusion boundInclusion) {
+    auto exec = InternalPlanner::indexScan(opCtx,
+                                           &collection,
+                                           idIndex,
+                                           startKey,
+                                           BSON("" << MAXKEY),
+                                           boundInclusion,
+                                           PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                                           InternalPlanner::FORWARD,
+                                           InternalPlanner::IXSCAN_FETCH);
+    BSONObj preImage;
+    if (exec->getNext(&preImage, nullptr) != PlanExecutor::ADVANCED) {
+        return boost::none;
+    }
+    return uassertStatusOK(UUID::parse(preImage["_id"][kNsUUIDFieldName]));
+}
+
+}  // namespace
+
+void createPreImagesCollection(OperationContext* opCtx) {
+    writeConflictRetry(opCtx, "createPreImagesCollection", kPreImagesNss.ns(), [&] {
+        AutoGetDb autoDb(opCtx, kPreImagesNss.db(), MODE_X);
+        auto db = autoDb.ensureDbExists();
+        invariant(db);
+
+        if (CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, kPreImagesNss)) {
+            return;
+        }
+
+        // The collection is not replicated, so each node generates its own UUID. This also allows
+        // the collection to be created while the node is not primary.
+        WriteUnitOfWork wuow(opCtx);
+        CollectionOptions options;
+        options.uuid = UUID::gen();
+        invariant(db->createCollection(opCtx, kPreImagesNss, options));
+        wuow.commit();
+    });
+}
+
+BSONObj makePreImageId(const UUID& nsUUID, Timestamp ts) {
+    BSONObjBuilder builder;
+    nsUUID.appendToBuilder(&builder, kNsUUIDFieldName);
+    builder.append(kTsFieldName, ts);
+    return builder.obj();
+}
+
+void insertPreImage(OperationContext* opCtx,
+                    const UUID& nsUUID,
+                    Timestamp ts,
+                    const BSONObj& preImage) {
+    invariant(opCtx->lockState()->inAWriteUnitOfWork());
+
+    AutoGetCollection preImagesCollection(opCtx, kPreImagesNss, MODE_IX);
+    if (!preImagesCollection) {
+        return;
+    }
+
+    const auto preImageId = makePreImageId(nsUUID, ts);
+    if (!Helpers::findById(opCtx, *preImagesCollection, BSON("_id" << preImageId)).isNull()) {
+        return;
+    }
+
+    uassertStatusOK(preImagesCollection->insertDocument(
+        opCtx,
+        InsertStatement(BSON("_id" << preImageId << kPreImageFieldName << preImage)),
+        nullptr /* opDebug */));
+}
+
+size_t truncatePreImagesOlderThan(OperationContext* opCtx, Timestamp oldestTimestamp) {
+    // The collection is not replicated, so pre-images are removed on secondaries as well.
+    UnreplicatedWritesBlock uwb(opCtx);
+    AutoGetCollection preImagesCollection(opCtx, kPreImagesNss, MODE_IX);
+    if (!preImagesCollection) {
+        return 0;
+    }
+
+    const auto idIndex = preImagesCollection->getIndexCatalog()->findIdIndex(opCtx);
+    if (!idIndex) {
+        return 0;
+    }
+
+    size_t numDeleted = 0;
+    auto nsUUID = findNextNsUUID(opCtx,
+                                 *preImagesCollection,
+                                 idIndex,
+                                 BSON("" << MINKEY),
+                                 BoundInclusion::kIncludeBothStartAndEndKeys);
+    while (nsUUID) {
+        // Delete the range [{nsUUID, Timestamp(0, 0)}, {nsUUID, oldestTimestamp}).
+        auto params = std::make_unique<DeleteStageParams>();
+        params->isMulti = true;
+        auto exec = InternalPlanner::deleteWithIndexScan(
+            opCtx,
+            &(*preImagesCollection),
+            std::move(params),
+            idIndex,
+            BSON("" << makePreImageId(*nsUUID, Timestamp())),
+            BSON("" << makePreImageId(*nsUUID, oldestTimestamp)),
+            BoundInclusion::kIncludeStartKeyOnly,
+            PlanYieldPolicy::YieldPolicy::YIELD_AUTO);
+        numDeleted += exec->executeDelete();
+
+        // Skip past the remaining pre-images of this collection.
+        nsUUID = findNextNsUUID(opCtx,
+                                *preImagesCollection,
+                                idIndex,
+                                BSON("" << makePreImageId(*nsUUID, Timestamp::max())),
+                                BoundInclusion::kIncludeEndKeyOnly);
+    }
+
+    LOGV2_DEBUG(5869201,
+                2,
+                "Removed expired change stream pre-images",
+                "numDeleted"_attr = numDeleted,
+                "oldestTimestamp"_attr = oldestTimestamp);
+    return numDeleted;
+}
+
+}  // namespace change_stream_pre_images
+}  // namespace mongo
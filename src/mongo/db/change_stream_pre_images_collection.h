@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/timestamp.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+
+/**
+ * Helpers for the "config.system.preimages" collection, which stores the pre-images of updates
+ * and deletes on collections with 'recordPreImages' enabled outside of the oplog. Each node
+ * maintains the collection locally, both when performing writes as primary and when applying
+ * them as secondary, and removes pre-images once the oplog entries they belong to have been
+ * truncated.
+ *
+ * Format of a pre-image document:
+ * {
+ *		_id : {nsUUID : <UUID>, ts : <Timestamp>},
+ *		preImage : <BSON>
+ *	}
+ *
+ * where 'nsUUID' is the UUID of the collection the write was performed on and 'ts' is the
+ * timestamp of the oplog entry for the write.
+ */
+namespace change_stream_pre_images {
+
+/**
+ * Creates the "config.system.preimages" collection if it does not already exist. The collection
+ * is not replicated, so this is done on every node.
+ */
+void createPreImagesCollection(OperationContext* opCtx);
+
+/**
+ * Returns the _id of the pre-image recorded for the write with timestamp 'ts' on the collection
+ * with UUID 'nsUUID'.
+ */
+BSONObj makePreImageId(const UUID& nsUUID, Timestamp ts);
+
+/**
+ * Records 'preImage' as the pre-image of the write with timestamp 'ts' on the collection with UUID
+ * 'nsUUID'. Must be called inside the WriteUnitOfWork of the write. Does nothing if the pre-images
+ * collection does not exist or if a pre-image is already recorded for that write, which happens
+ * when oplog entries are re-applied during recovery.
+ */
+void insertPreImage(OperationContext* opCtx,
+                    const UUID& nsUUID,
+                    Timestamp ts,
+                    const BSONObj& preImage);
+
+/**
+ * Removes the pre-images of all writes with a timestamp earlier than 'oldestTimestamp'. The
+ * pre-images of each collection occupy a contiguous range of the _id index, so they are removed
+ * with one bounded index scan per collection. Returns the number of removed pre-images.
+ */
+size_t truncatePreImagesOlderThan(OperationContext* opCtx, Timestamp oldestTimestamp);
+
+}  // namespace change_stream_pre_images
+}  // namespace mongo
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog_raii.h"
+#include "mongo/db/change_stream_pre_images_collection.h"
+#include "mongo/db/dbhelpers.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+namespace {
+
+using namespace change_stream_pre_images;
+
+class ChangeStreamPreImagesCollectionTest : public CatalogTestFixture {
+public:
+    void setUp() override {
+        CatalogTestFixture::setUp();
+        operationContext()->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+        createPreImagesCollection(operationContext());
+    }
+
+protected:
+    void insert(const UUID& nsUUID, Timestamp ts, const BSONObj& preImage) {
+        WriteUnitOfWork wuow(operationContext());
+        insertPreImage(operationContext(), nsUUID, ts, preImage);
+        wuow.commit();
+    }
+
+    boost::optional<BSONObj> find(const UUID& nsUUID, Timestamp ts) {
+        AutoGetCollection coll(
+            operationContext(), NamespaceString::kChangeStreamPreImagesNamespace, MODE_IS);
+        BSONObj result;
+        if (!Helpers::findOne(operationContext(),
+                              coll.getCollection(),
+                              BSON("_id" << makePreImageId(nsUUID, ts)),
+                              result)) {
+            return boost::none;
+        }
+        return result["preImage"].Obj().getOwned();
+    }
+
+    long long count() {
+        AutoGetCollection coll(
+            operationContext(), NamespaceString::kChangeStreamPreImagesNamespace, MODE_IS);
+        return coll->numRecords(operationContext());
+    }
+};
+
+TEST_F(ChangeStreamPreImagesCollectionTest, CreateIsIdempotent) {
+    createPreImagesCollection(operationContext());
+    ASSERT_EQ(count(), 0);
+}
+
+TEST_F(ChangeStreamPreImagesCollectionTest, InsertedPreImageCanBeFound) {
+    const auto nsUUID = UUID::gen();
+    insert(nsUUID, Timestamp(10, 1), BSON("_id" << 1 << "x" << 1));
+
+    auto preImage = find(nsUUID, Timestamp(10, 1));
+    ASSERT(preImage);
+    ASSERT_BSONOBJ_EQ(*preImage, BSON("_id" << 1 << "x" << 1));
+    ASSERT_FALSE(find(nsUUID, Timestamp(10, 2)));
+    ASSERT_FALSE(find(UUID::gen(), Timestamp(10, 1)));
+}
+
+TEST_F(ChangeStreamPreImagesCollectionTest, InsertingExistingPreImageIsIgnored) {
+    const auto nsUUID = UUID::gen();
+    insert(nsUUID, Timestamp(10, 1), BSON("_id" << 1 << "x" << 1));
+    insert(nsUUID, Timestamp(10, 1), BSON("_id" << 1 << "x" << 2));
+
+    ASSERT_EQ(count(), 1);
+    ASSERT_BSONOBJ_EQ(*find(nsUUID, Timestamp(10, 1)), BSON("_id" << 1 << "x" << 1));
+}
+
+TEST_F(ChangeStreamPreImagesCollectionTest, TruncateRemovesOlderPreImagesOfEveryCollection) {
+    const auto firstUUID = UUID::gen();
+    const auto secondUUID = UUID::gen();
+    for (unsigned i = 1; i <= 5; ++i) {
+        insert(firstUUID, Timestamp(i, 0), BSON("_id" << static_cast<int>(i)));
+        insert(secondUUID, Timestamp(i, 1), BSON("_id" << static_cast<int>(i)));
+    }
+
+    ASSERT_EQ(truncatePreImagesOlderThan(operationContext(), Timestamp(3, 0)), 4U);
+    ASSERT_EQ(count(), 6);
+    for (unsigned i = 1; i <= 5; ++i) {
+        ASSERT_EQ(bool(find(firstUUID, Timestamp(i, 0))), i >= 3);
+        ASSERT_EQ(bool(find(secondUUID, Timestamp(i, 1))), i >= 3);
+    }
+
+    ASSERT_EQ(truncatePreImagesOlderThan(operationContext(), Timestamp(3, 0)), 0U);
+    ASSERT_EQ(truncatePreImagesOlderThan(operationContext(), Timestamp::max()), 6U);
+    ASSERT_EQ(count(), 0);
+}
+
+}  // namespace
+}  // namespace mongo
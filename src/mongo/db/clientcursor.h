@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <functional>
 
 #include "mongo/db/api_parameters.h"
@@ -295,6 +296,28 @@ public:
         return _opKey;
     }
 
+    /**
+     * Documents read ahead of the next getMore on this cursor, in the order they are to be
+     * returned. A getMore returns these before reading any more from the executor. The caller must
+     * have the cursor pinned.
+     */
+    std::deque<BSONObj>& getReadAheadDocs() {
+        return _readAheadDocs;
+    }
+
+    /**
+     * Returns whether the executor reached EOF while documents were read ahead, in which case the
+     * cursor is exhausted once the documents read ahead have been returned. The executor must not
+     * be used again after that.
+     */
+    bool readAheadReachedEOF() const {
+        return _readAheadReachedEOF;
+    }
+
+    void setReadAheadReachedEOF() {
+        _readAheadReachedEOF = true;
+    }
+
 private:
     friend class CursorManager;
     friend class ClientCursorPin;
@@ -421,6 +444,11 @@ private:
 
     // The client OperationKey associated with this cursor.
     boost::optional<OperationKey> _opKey;
+
+    // Owned documents read ahead of the next getMore, and whether the executor reached EOF while
+    // reading them. Only accessed by the operation which has the cursor pinned.
+    std::deque<BSONObj> _readAheadDocs;
+    bool _readAheadReachedEOF = false;
 };
 
 /**
@@ -0,0 +1,191 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/field_path.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/field_histogram.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+
+namespace mongo {
+namespace {
+
+constexpr long long kDefaultSampleSize = 10000;
+constexpr long long kDefaultNumBuckets = 100;
+constexpr long long kMaxNumBuckets = 10000;
+
+long long parsePositiveNumber(const BSONObj& cmdObj, StringData fieldName, long long defaultValue) {
+    auto elem = cmdObj[fieldName];
+    if (!elem) {
+        return defaultValue;
+    }
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "'" << fieldName << "' must be a positive number",
+            elem.isNumber() && elem.safeNumberLong() > 0);
+    return elem.safeNumberLong();
+}
+
+/**
+ * The 'analyze' command builds a histogram of the index keys of a field from a random sample of
+ * the documents of a collection, which the query planner then uses to avoid trial runs of the
+ * candidate plans that are far more expensive than others:
+ *
+ *    {
+ *        analyze: <collection>,
+ *        key: <field path>,
+ *        sampleSize: <number of documents to sample, 10000 by default>,
+ *        numBuckets: <number of buckets of the histogram, 100 by default>
+ *    }
+ *
+ * The histograms are kept in memory with the plan cache of the collection. Running the command
+ * again builds a new one, e.g. once the data has changed or after a restart.
+ */
+class AnalyzeCommand final : public BasicCommand {
+public:
+    AnalyzeCommand() : BasicCommand("analyze") {}
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kOptIn;
+    }
+
+    std::string help() const override {
+        return "Builds a histogram of a field of a collection for the query planner.";
+    }
+
+    Status checkAuthForCommand(Client* client,
+                               const std::string& dbname,
+                               const BSONObj& cmdObj) const override {
+        AuthorizationSession* authzSession = AuthorizationSession::get(client);
+        ResourcePattern pattern = parseResourcePattern(dbname, cmdObj);
+
+        if (authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::find) &&
+            authzSession->isAuthorizedForActionsOnResource(pattern, ActionType::planCacheWrite)) {
+            return Status::OK();
+        }
+
+        return Status(ErrorCodes::Unauthorized, "unauthorized");
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss(CommandHelpers::parseNsCollectionRequired(dbname, cmdObj));
+
+        auto keyElem = cmdObj["key"];
+        uassert(ErrorCodes::BadValue,
+                "'key' must be a field path",
+                keyElem.type() == BSONType::String);
+        const FieldPath key(keyElem.str());
+        const auto sampleSize = parsePositiveNumber(cmdObj, "sampleSize", kDefaultSampleSize);
+        const auto numBuckets = parsePositiveNumber(cmdObj, "numBuckets", kDefaultNumBuckets);
+        uassert(ErrorCodes::BadValue,
+                str::stream() << "'numBuckets' must be at most " << kMaxNumBuckets,
+                numBuckets <= kMaxNumBuckets);
+
+        AutoGetCollectionForReadCommand ctx(
+            opCtx, nss, AutoGetCollectionViewMode::kViewsPermitted);
+        uassert(ErrorCodes::CommandNotSupportedOnView,
+                str::stream() << "Namespace " << nss << " is a view, not a collection",
+                !ctx.getView());
+        const auto& collection = ctx.getCollection();
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << nss << " does not exist",
+                collection);
+
+        // A collection which does not fit in the sample is sampled at random, when the storage
+        // engine supports it.
+        const long long numRecords = collection->numRecords(opCtx);
+        std::unique_ptr<RecordCursor> cursor;
+        if (numRecords > sampleSize) {
+            cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+        }
+        if (!cursor) {
+            cursor = collection->getCursor(opCtx);
+        }
+
+        // Collect the index keys of the field, like a multikey index would: one for each distinct
+        // element of an array, and null when the field is missing.
+        std::vector<BSONObj> keys;
+        long long numSampled = 0;
+        for (; numSampled < sampleSize; ++numSampled) {
+            auto record = cursor->next();
+            if (!record) {
+                break;
+            }
+            if (numSampled % 128 == 0) {
+                opCtx->checkForInterrupt();
+            }
+
+            BSONElementSet elements;
+            dotted_path_support::extractAllElementsAlongPath(
+                record->data.toBson(), key.fullPath(), elements);
+            if (elements.empty()) {
+                keys.push_back(BSON("" << BSONNULL));
+            }
+            for (auto&& elem : elements) {
+                BSONObjBuilder keyBob;
+                keyBob.appendAs(elem, "");
+                keys.push_back(keyBob.obj());
+            }
+        }
+
+        const double scale =
+            numSampled ? static_cast<double>(std::max(numRecords, numSampled)) / numSampled : 0;
+        auto histogram = std::make_shared<FieldHistogram>(
+            FieldHistogram::make(std::move(keys), static_cast<size_t>(numBuckets), scale));
+        result.append("key", key.fullPath());
+        result.append("sampled", numSampled);
+        result.append("histogram", histogram->toBSON());
+
+        // The cached plans were chosen without the histogram.
+        auto& queryInfo = CollectionQueryInfo::get(collection);
+        queryInfo.getHistograms()->set(key.fullPath(), std::move(histogram));
+        queryInfo.getPlanCache()->clear();
+        queryInfo.getSbePlanCache()->clear();
+        return true;
+    }
+} analyzeCommand;
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kCommand
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/cpu_profiler_cmds_gen.h"
+#include "mongo/util/cpu_profiler.h"
+
+namespace mongo {
+namespace {
+
+void checkAuthForCPUProfiler(OperationContext* opCtx) {
+    uassert(ErrorCodes::Unauthorized,
+            "Unauthorized",
+            AuthorizationSession::get(opCtx->getClient())
+                ->isAuthorizedForPrivilege(
+                    Privilege{ResourcePattern::forClusterResource(), ActionType::cpuProfiler}));
+}
+
+class StartCPUProfilerCommand final : public TypedCommand<StartCPUProfilerCommand> {
+public:
+    using Request = StartCPUProfiler;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            uassertStatusOK(
+                CPUProfiler::get()->start(Microseconds(request().getPeriodMicros())));
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthForCPUProfiler(opCtx);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+} startCPUProfilerCommand;
+
+class StopCPUProfilerCommand final : public TypedCommand<StopCPUProfilerCommand> {
+public:
+    using Request = StopCPUProfiler;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        void typedRun(OperationContext* opCtx) {
+            uassertStatusOK(CPUProfiler::get()->stop());
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthForCPUProfiler(opCtx);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+} stopCPUProfilerCommand;
+
+class GetCPUProfileCommand final : public TypedCommand<GetCPUProfileCommand> {
+public:
+    using Request = GetCPUProfile;
+
+    class Invocation final : public InvocationBase {
+    public:
+        using InvocationBase::InvocationBase;
+
+        GetCPUProfileReply typedRun(OperationContext* opCtx) {
+            auto profiler = CPUProfiler::get();
+            auto stats = profiler->getStats();
+
+            BSONObjBuilder operations;
+            for (const auto& [operationType, samples] : stats.samplesByOperationType) {
+                operations.append(operationType, samples);
+            }
+
+            auto profile = profiler->exportPprof(request().getOperationType());
+
+            GetCPUProfileReply reply;
+            reply.setRunning(stats.running);
+            reply.setPeriodMicros(durationCount<Microseconds>(stats.period));
+            reply.setSamples(stats.samples);
+            reply.setDroppedSamples(stats.droppedSamples);
+            reply.setOperations(operations.obj());
+            reply.setProfile(std::vector<std::uint8_t>(profile.begin(), profile.end()));
+            return reply;
+        }
+
+    private:
+        bool supportsWriteConcern() const override {
+            return false;
+        }
+
+        void doCheckAuthorization(OperationContext* opCtx) const override {
+            checkAuthForCPUProfiler(opCtx);
+        }
+
+        NamespaceString ns() const override {
+            return NamespaceString(request().getDbName(), "");
+        }
+    };
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool adminOnly() const override {
+        return true;
+    }
+} getCPUProfileCommand;
+
+}  // namespace
+}  // namespace mongo
@@ -32,15 +32,19 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/optional.hpp>
+#include <fmt/format.h>
 #include <map>
 #include <set>
 #include <string>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/dbhash_gen.h"
 #include "mongo/db/commands/test_commands_enabled.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -51,14 +55,208 @@
 #include "mongo/db/transaction_participant.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/md5.hpp"
 #include "mongo/util/net/socket_utils.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/timer.h"
+#include <third_party/murmurhash3/MurmurHash3.h>
 
 namespace mongo {
 
 namespace {
 
+constexpr StringData kMD5HashFunction = "md5"_sd;
+constexpr StringData kMurmur3HashFunction = "murmur3"_sd;
+
+/**
+ * An order-independent hash of a set of documents: the sums of the two halves of the 128-bit
+ * MurmurHash3 of each document. The hashes of disjoint sets of documents combine by adding them up,
+ * so a collection can be hashed over ranges that differ from one node to another and still hash to
+ * the same value on every node.
+ */
+class DocumentSetHash {
+public:
+    void add(const char* data, int size) {
+        uint64_t hash[2];
+        MurmurHash3_x64_128(data, size, 0, hash);
+        _sums[0] += hash[0];
+        _sums[1] += hash[1];
+    }
+
+    void add(const DocumentSetHash& other) {
+        _sums[0] += other._sums[0];
+        _sums[1] += other._sums[1];
+    }
+
+    std::string toString() const {
+        return fmt::format("{:016x}{:016x}", _sums[0], _sums[1]);
+    }
+
+private:
+    uint64_t _sums[2] = {0, 0};
+};
+
+/**
+ * Hashes the documents of a collection into a DocumentSetHash over ranges of its _id index, which
+ * several threads hash at once. The threads other than the one running the command each use an
+ * operation of their own, which reads from the same point in time as the command. They only hold
+ * the global lock in intent mode, as the database and collection locks of the command keep the
+ * collection from changing.
+ */
+class IdRangeHasher {
+public:
+    /**
+     * The ranges end before each of the 'splitPoints', which are keys of the _id index in
+     * ascending order, and after the last of them.
+     */
+    IdRangeHasher(const IndexDescriptor* idIndex, std::vector<BSONObj> splitPoints)
+        : _idIndex(idIndex),
+          _splitPoints(std::move(splitPoints)),
+          _rangeHashes(_splitPoints.size() + 1) {}
+
+    DocumentSetHash run(OperationContext* opCtx,
+                        const CollectionPtr& collection,
+                        size_t numThreads) {
+        const auto serviceContext = opCtx->getServiceContext();
+        const auto uuid = collection->uuid();
+        const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+        const auto readTimestamp = readSource == RecoveryUnit::ReadSource::kProvided
+            ? opCtx->recoveryUnit()->getPointInTimeReadTimestamp(opCtx)
+            : boost::none;
+        const auto prepareConflictBehavior = opCtx->recoveryUnit()->getPrepareConflictBehavior();
+
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+
+        try {
+            for (size_t idx = 1; idx < std::min(numThreads, _rangeHashes.size()); ++idx) {
+                threads.emplace_back([this,
+                                      serviceContext,
+                                      idx,
+                                      uuid,
+                                      readSource,
+                                      readTimestamp,
+                                      prepareConflictBehavior] {
+                    const std::string threadName = str::stream() << "dbHash-" << idx;
+                    ThreadClient tc(threadName, serviceContext);
+                    auto workerOpCtx = cc().makeOperationContext();
+                    {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.push_back(workerOpCtx.get());
+                    }
+                    ON_BLOCK_EXIT([&] {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.erase(std::find(
+                            _workerOpCtxs.begin(), _workerOpCtxs.end(), workerOpCtx.get()));
+                        ++_numFinishedWorkers;
+                        _workerFinished.notify_all();
+                    });
+
+                    try {
+                        workerOpCtx->recoveryUnit()->setTimestampReadSource(readSource,
+                                                                            readTimestamp);
+                        workerOpCtx->recoveryUnit()->setPrepareConflictBehavior(
+                            prepareConflictBehavior);
+
+                        // Never wait for the PBWM lock, which oplog application on a secondary
+                        // may be queued for behind the lock held by the command.
+                        ShouldNotConflictWithSecondaryBatchApplicationBlock noPBWM(
+                            workerOpCtx->lockState());
+                        Lock::GlobalLock globalLock(workerOpCtx.get(), MODE_IS);
+                        CollectionPtr workerCollection =
+                            CollectionCatalog::get(workerOpCtx.get())
+                                ->lookupCollectionByUUID(workerOpCtx.get(), uuid);
+                        invariant(workerCollection);
+                        _hashRanges(workerOpCtx.get(), workerCollection);
+                    } catch (const DBException& ex) {
+                        _recordFailure(ex.toStatus());
+                    }
+                });
+            }
+        } catch (const std::exception& ex) {
+            _recordFailure({ErrorCodes::InternalError,
+                            str::stream() << "Failed to start a dbHash thread: " << ex.what()});
+            throw;
+        }
+
+        try {
+            _hashRanges(opCtx, collection);
+
+            stdx::unique_lock<Latch> lk(_mutex);
+            opCtx->waitForConditionOrInterrupt(
+                _workerFinished, lk, [&] { return _numFinishedWorkers == threads.size(); });
+        } catch (const DBException& ex) {
+            _recordFailure(ex.toStatus());
+            throw;
+        }
+        uassertStatusOK(_firstError);
+
+        DocumentSetHash hash;
+        for (auto&& rangeHash : _rangeHashes) {
+            hash.add(rangeHash);
+        }
+        return hash;
+    }
+
+private:
+    void _hashRanges(OperationContext* opCtx, const CollectionPtr& collection) {
+        for (size_t idx = _nextRange.fetchAndAdd(1); idx < _rangeHashes.size();
+             idx = _nextRange.fetchAndAdd(1)) {
+            auto exec = InternalPlanner::indexScan(
+                opCtx,
+                &collection,
+                _idIndex,
+                idx == 0 ? BSONObj() : _splitPoints[idx - 1],
+                idx == _splitPoints.size() ? BSONObj() : _splitPoints[idx],
+                BoundInclusion::kIncludeStartKeyOnly,
+                PlanYieldPolicy::YieldPolicy::NO_YIELD,
+                InternalPlanner::FORWARD,
+                InternalPlanner::IXSCAN_FETCH);
+
+            BSONObj c;
+            while (exec->getNext(&c, nullptr) == PlanExecutor::ADVANCED) {
+                _rangeHashes[idx].add(c.objdata(), c.objsize());
+            }
+        }
+    }
+
+    /**
+     * Records the first error hit while hashing and interrupts the threads.
+     */
+    void _recordFailure(Status status) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_firstError.isOK()) {
+            _firstError = std::move(status);
+        }
+
+        for (auto workerOpCtx : _workerOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+            workerOpCtx->getServiceContext()->killOperation(clientLock, workerOpCtx);
+        }
+    }
+
+    const IndexDescriptor* const _idIndex;
+    const std::vector<BSONObj> _splitPoints;
+
+    // The hash of each range, in the order of the ranges.
+    std::vector<DocumentSetHash> _rangeHashes;
+
+    // The position of the next range for a thread to hash.
+    AtomicWord<size_t> _nextRange{0};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("IdRangeHasher::_mutex");
+    stdx::condition_variable _workerFinished;
+    size_t _numFinishedWorkers = 0;
+    std::vector<OperationContext*> _workerOpCtxs;
+    Status _firstError = Status::OK();
+};
+
 class DBHashCmd : public ErrmsgCommandDeprecated {
 public:
     DBHashCmd() : ErrmsgCommandDeprecated("dbHash", "dbhash") {}
@@ -131,6 +329,20 @@ public:
             }
         }
 
+        bool useMurmur3 = false;
+        if (auto elem = cmdObj["hashFunction"]) {
+            uassert(ErrorCodes::TypeMismatch,
+                    "The 'hashFunction' option must be a string",
+                    elem.type() == String);
+            uassert(ErrorCodes::BadValue,
+                    str::stream() << "Unknown hash function '" << elem.valueStringData()
+                                  << "', expected '" << kMD5HashFunction << "' or '"
+                                  << kMurmur3HashFunction << "'",
+                    elem.valueStringData() == kMD5HashFunction ||
+                        elem.valueStringData() == kMurmur3HashFunction);
+            useMurmur3 = elem.valueStringData() == kMurmur3HashFunction;
+        }
+
         const std::string ns = parseNs(dbname, cmdObj);
         uassert(ErrorCodes::InvalidNamespace,
                 str::stream() << "Invalid db name: " << ns,
@@ -267,7 +479,8 @@ public:
                 collectionToUUIDMap.emplace(collNss.coll().toString(), collection->uuid());
 
                 // Compute the hash for this collection.
-                std::string hash = _hashCollection(opCtx, db, collNss);
+                std::string hash = useMurmur3 ? _hashCollectionInRanges(opCtx, db, collNss)
+                                              : _hashCollection(opCtx, db, collNss);
 
                 collectionToHashMap[collNss.coll().toString()] = hash;
 
@@ -313,8 +526,9 @@ public:
     }
 
 private:
-    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
-
+    CollectionPtr _lookupCollectionToHash(OperationContext* opCtx,
+                                          Database* db,
+                                          const NamespaceString& nss) {
         CollectionPtr collection =
             CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, nss);
         invariant(collection);
@@ -343,9 +557,15 @@ private:
             invariant(opCtx->lockState()->isDbLockedForMode(db->name(), MODE_S));
         }
 
+        return collection;
+    }
+
+    std::string _hashCollection(OperationContext* opCtx, Database* db, const NamespaceString& nss) {
+        CollectionPtr collection = _lookupCollectionToHash(opCtx, db, nss);
         auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
 
         std::unique_ptr<PlanExecutor, PlanExecutor::Deleter> exec;
+        std::unique_ptr<SeekableRecordCursor> cursor;
         if (desc) {
             exec = InternalPlanner::indexScan(opCtx,
                                               &collection,
@@ -357,8 +577,9 @@ private:
                                               InternalPlanner::FORWARD,
                                               InternalPlanner::IXSCAN_FETCH);
         } else if (collection->isCapped() || collection->isClustered()) {
-            exec = InternalPlanner::collectionScan(
-                opCtx, &collection, PlanYieldPolicy::YieldPolicy::NO_YIELD);
+            // Records are hashed in RecordId order, which needs no plan and no yielding, so read
+            // them straight from the record store in batches.
+            cursor = collection->getCursor(opCtx);
         } else {
             LOGV2(20455, "Can't find _id index for namespace", "namespace"_attr = nss);
             return "no _id _index";
@@ -369,11 +590,21 @@ private:
 
         try {
             long long n = 0;
-            BSONObj c;
-            verify(nullptr != exec.get());
-            while (exec->getNext(&c, nullptr) == PlanExecutor::ADVANCED) {
-                md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
-                n++;
+            if (exec) {
+                BSONObj c;
+                while (exec->getNext(&c, nullptr) == PlanExecutor::ADVANCED) {
+                    md5_append(&st, (const md5_byte_t*)c.objdata(), c.objsize());
+                    n++;
+                }
+            } else {
+                const size_t kBatchSize = 1024;
+                invariant(cursor);
+                while (cursor->nextBatch(kBatchSize, [&](const Record& record) {
+                    md5_append(&st, (const md5_byte_t*)record.data.data(), record.data.size());
+                    n++;
+                    return true;
+                })) {
+                }
             }
         } catch (DBException& exception) {
             LOGV2_WARNING(
@@ -389,6 +620,96 @@ private:
         return hash;
     }
 
+    /**
+     * Hashes the collection into a DocumentSetHash, which several threads compute over ranges of
+     * the _id index when the collection is read from a point in time that they can share.
+     */
+    std::string _hashCollectionInRanges(OperationContext* opCtx,
+                                        Database* db,
+                                        const NamespaceString& nss) {
+        CollectionPtr collection = _lookupCollectionToHash(opCtx, db, nss);
+        auto desc = collection->getIndexCatalog()->findIdIndex(opCtx);
+        if (!desc && !collection->isCapped() && !collection->isClustered()) {
+            LOGV2(20455, "Can't find _id index for namespace", "namespace"_attr = nss);
+            return "no _id _index";
+        }
+
+        DocumentSetHash hash;
+        try {
+            if (!desc) {
+                const size_t kBatchSize = 1024;
+                auto cursor = collection->getCursor(opCtx);
+                while (cursor->nextBatch(kBatchSize, [&](const Record& record) {
+                    hash.add(record.data.data(), record.data.size());
+                    return true;
+                })) {
+                }
+                return hash.toString();
+            }
+
+            // The ranges are split in the order of the _id index, which only matches the order of
+            // the split points for the simple collation. Other threads can only read the same data
+            // as this operation with the latest data under the database lock or at a timestamp.
+            const auto readSource = opCtx->recoveryUnit()->getTimestampReadSource();
+            const size_t numThreads = gDbHashRangeConcurrency.load();
+            std::vector<BSONObj> splitPoints;
+            if (numThreads > 1 && !collection->getDefaultCollator() &&
+                (readSource == RecoveryUnit::ReadSource::kNoTimestamp ||
+                 readSource == RecoveryUnit::ReadSource::kProvided)) {
+                splitPoints = _sampleIdSplitPoints(opCtx, collection, numThreads);
+            }
+
+            hash = IdRangeHasher(desc, std::move(splitPoints)).run(opCtx, collection, numThreads);
+        } catch (DBException& exception) {
+            LOGV2_WARNING(
+                20456, "Error while hashing, db possibly dropped", "namespace"_attr = nss);
+            exception.addContext("Plan executor error while running dbHash command");
+            throw;
+        }
+
+        return hash.toString();
+    }
+
+    /**
+     * Returns up to 'numRanges' - 1 keys of the _id index, in ascending order, which split a
+     * random sample of the collection into ranges of about the same size. The split points do not
+     * need to agree between nodes, as the hashes of the ranges are added up.
+     */
+    std::vector<BSONObj> _sampleIdSplitPoints(OperationContext* opCtx,
+                                              const CollectionPtr& collection,
+                                              size_t numRanges) {
+        const size_t kSamplesPerRange = 16;
+
+        std::vector<BSONObj> splitPoints;
+        auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+        if (!cursor) {
+            return splitPoints;
+        }
+
+        SimpleBSONObjSet samples;
+        for (size_t i = 0; i < numRanges * kSamplesPerRange; ++i) {
+            auto record = cursor->next();
+            if (!record) {
+                break;
+            }
+            if (auto id = record->data.toBson()["_id"]) {
+                samples.insert(id.wrap(""));
+            }
+        }
+
+        const size_t step = std::max<size_t>(1, samples.size() / numRanges);
+        size_t i = 0;
+        for (auto&& sample : samples) {
+            if (splitPoints.size() == numRanges - 1) {
+                break;
+            }
+            if (++i % step == 0 && i < samples.size()) {
+                splitPoints.push_back(sample);
+            }
+        }
+        return splitPoints;
+    }
+
 } dbhashCmd;
 
 }  // namespace
@@ -38,6 +38,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/run_aggregate.h"
 #include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/cursor_manager.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
@@ -125,6 +126,62 @@ boost::intrusive_ptr<ExpressionContext> makeExpressionContext(
     return expCtx;
 }
 
+/**
+ * Returns true if 'findCommand' reads at most one document by an exact _id value and returns it
+ * unchanged, so that it can be answered by findByIdExpress() without a PlanExecutor or a cursor.
+ */
+bool isExpressIdFind(const FindCommandRequest& findCommand) {
+    return CanonicalQuery::isSimpleIdQuery(findCommand.getFilter()) &&
+        findCommand.getProjection().isEmpty() && findCommand.getSort().isEmpty() &&
+        findCommand.getHint().isEmpty() && findCommand.getCollation().isEmpty() &&
+        findCommand.getMin().isEmpty() && findCommand.getMax().isEmpty() &&
+        !findCommand.getSkip() && !findCommand.getNtoreturn() &&
+        findCommand.getBatchSize().value_or(1) != 0 && !findCommand.getTailable() &&
+        !findCommand.getAwaitData() && !findCommand.getShowRecordId() &&
+        !findCommand.getReturnKey() && !findCommand.getReadOnce() &&
+        !findCommand.getRequestResumeToken() && findCommand.getResumeAfter().isEmpty();
+}
+
+/**
+ * Answers the express _id lookup 'findCommand' on 'collection', appending a single, exhausted
+ * batch to 'result'.
+ */
+void runExpressIdFind(OperationContext* opCtx,
+                      const CollectionPtr& collection,
+                      const NamespaceString& nss,
+                      const FindCommandRequest& findCommand,
+                      rpc::ReplyBuilderInterface* result) {
+    Snapshotted<BSONObj> doc;
+    const bool found = writeConflictRetry(opCtx, "find", nss.ns(), [&] {
+        return !findByIdExpress(opCtx, collection, findCommand.getFilter(), &doc).isNull();
+    });
+
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    options.expectedNumDocs = 1;
+    if (!opCtx->inMultiDocumentTransaction()) {
+        options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
+    }
+    CursorResponseBuilder firstBatch(result, options);
+    ResourceConsumption::DocumentUnitCounter docUnitsReturned;
+    if (found) {
+        firstBatch.append(doc.value());
+        docUnitsReturned.observeOne(doc.value().objsize());
+    }
+
+    auto curOp = CurOp::get(opCtx);
+    curOp->debug().nreturned = found ? 1 : 0;
+    curOp->debug().cursorid = -1;
+    curOp->debug().cursorExhausted = true;
+    endExpressIdOp(opCtx, collection, found);
+
+    firstBatch.done(0, nss.ns());
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    metricsCollector.incrementDocUnitsReturned(docUnitsReturned);
+    query_request_helper::validateCursorResponse(result->getBodyBuilder().asTempObj());
+}
+
 /**
  * A command for running .find() queries.
  */
@@ -403,6 +460,13 @@ public:
             const int ntoskip = -1;
             beginQueryOp(opCtx, nss, _request.body, ntoreturn, ntoskip);
 
+            // A point lookup by _id needs neither a CanonicalQuery nor a PlanExecutor.
+            if (!isExplain && !ctx->getView() && isExpressIdFind(*findCommand) &&
+                canUseExpressIdLookup(opCtx, ctx->getCollection())) {
+                runExpressIdFind(opCtx, ctx->getCollection(), nss, *findCommand, result);
+                return;
+            }
+
             // Finish the parsing step by using the FindCommandRequest to create a CanonicalQuery.
             const ExtensionsCallbackReal extensionsCallback(opCtx, &nss);
             auto expCtx = makeExpressionContext(opCtx, *findCommand, boost::none /* verbosity */);
@@ -473,6 +537,8 @@ public:
             // Stream query results, adding them to a BSONArray as we go.
             CursorResponseBuilder::Options options;
             options.isInitialResponse = true;
+            options.expectedNumDocs = originalFC.getBatchSize().value_or(
+                originalFC.getNtoreturn().value_or(query_request_helper::kDefaultBatchSize));
             if (!opCtx->inMultiDocumentTransaction()) {
                 options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
             }
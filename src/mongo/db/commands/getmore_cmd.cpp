@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -41,9 +42,11 @@
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
+#include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/curop_failpoint_helpers.h"
 #include "mongo/db/cursor_manager.h"
+#include "mongo/db/cursor_server_params.h"
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/working_set_common.h"
 #include "mongo/db/pipeline/change_stream_invalidation_info.h"
@@ -63,7 +66,10 @@
 #include "mongo/db/stats/top.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/chunk_version.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/time_support.h"
 
@@ -230,6 +236,242 @@ void setUpOperationContextStateForGetMore(OperationContext* opCtx,
     }
 }
 
+// Counts the batches read ahead of a getMore, and the documents in them.
+Counter64 readAheadBatchesCounter;
+Counter64 readAheadDocumentsCounter;
+ServerStatusMetricField<Counter64> displayReadAheadBatches("cursor.readAhead.batches",
+                                                           &readAheadBatchesCounter);
+ServerStatusMetricField<Counter64> displayReadAheadDocuments("cursor.readAhead.documents",
+                                                             &readAheadDocumentsCounter);
+
+/**
+ * How much of a cursor to read ahead of its next getMore. The client is expected to ask for as
+ * much as it took with the getMore which returned the last batch, so a read ahead is the size of
+ * that batch, within the 'cursorReadAheadMaxBytes' limit.
+ */
+struct ReadAheadSize {
+    std::uint64_t maxDocs;
+    std::size_t maxBytes;
+};
+
+/**
+ * Returns whether the next batch of 'cursor' may be read ahead once the current getMore on it has
+ * returned. Only cursors which read from a single collection, and whose getMores lock it, are read
+ * ahead. Cursors in a transaction, tailable or exhaust cursors and linearizable reads are not, and
+ * neither are cursors whose client has yet to take all the documents read ahead of the last
+ * getMore.
+ */
+bool shouldReadAhead(OperationContext* opCtx, ClientCursor* cursor) {
+    return getCursorReadAheadMaxBytes() > 0 && !opCtx->getClient()->isInDirectClient() &&
+        !opCtx->isExhaust() &&
+        cursor->getExecutor()->lockPolicy() == PlanExecutor::LockPolicy::kLockExternally &&
+        !cursor->isTailable() && !cursor->getTxnNumber() &&
+        cursor->getReadConcernArgs().getLevel() !=
+        repl::ReadConcernLevel::kLinearizableReadConcern &&
+        cursor->getReadAheadDocs().empty();
+}
+
+/**
+ * Reads up to 'size' of the documents of the cursor pinned by 'cursorPin' into the cursor's read
+ * ahead documents, under the read concern of the cursor, as its getMores do. Returns the number of
+ * documents read.
+ */
+std::uint64_t readAheadNextBatch(OperationContext* opCtx,
+                                 ClientCursorPin& cursorPin,
+                                 ReadAheadSize size) {
+    ClientCursor* cursor = cursorPin.getCursor();
+    applyCursorReadConcern(opCtx, cursor->getReadConcernArgs());
+
+    PlanExecutor* exec = cursor->getExecutor();
+    AutoGetCollectionForReadMaybeLockFree readLock(opCtx, exec->nss());
+    uassertStatusOK(repl::ReplicationCoordinator::get(opCtx)->checkCanServeReadsFor(
+        opCtx, cursor->nss(), true));
+
+    const auto* cq = exec->getCanonicalQuery();
+    if (cq && cq->getFindCommandRequest().getReadOnce()) {
+        opCtx->recoveryUnit()->setReadOnce(true);
+    }
+    exec->reattachToOperationContext(opCtx);
+    exec->restoreState(&readLock.getCollection());
+
+    auto& readAheadDocs = cursor->getReadAheadDocs();
+    std::uint64_t numDocs = 0;
+    std::size_t numBytes = 0;
+    BSONObj obj;
+    while (numDocs < size.maxDocs && numBytes < size.maxBytes) {
+        if (exec->getNext(&obj, nullptr) != PlanExecutor::ADVANCED) {
+            cursor->setReadAheadReachedEOF();
+            break;
+        }
+        numBytes += obj.objsize();
+        readAheadDocs.push_back(obj.getOwned());
+        ++numDocs;
+    }
+
+    exec->saveState();
+    exec->detachFromOperationContext();
+    return numDocs;
+}
+
+/**
+ * Reads the next batch of cursors in the background once a getMore has returned its batch, so
+ * that the next getMore does not wait on the storage engine for it. A read ahead pins the cursor
+ * while it runs. A getMore which arrives before the read ahead of its cursor has started cancels
+ * it, and one which arrives while it runs waits for it to finish.
+ */
+class CursorReadAhead {
+public:
+    CursorReadAhead()
+        : _threadPool([] {
+              ThreadPool::Options options;
+              options.threadNamePrefix = "CursorReadAhead";
+              options.minThreads = 0;
+              options.maxThreads = 4;
+              return options;
+          }()) {}
+
+    static CursorReadAhead& get(ServiceContext* service);
+
+    ThreadPool& getThreadPool() {
+        return _threadPool;
+    }
+
+    /**
+     * Schedules the read ahead of 'size' on the cursor 'cursorId', which the caller must have
+     * unpinned.
+     */
+    void schedule(ServiceContext* service, CursorId cursorId, ReadAheadSize size) {
+        auto readAhead = std::make_shared<ReadAhead>();
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            // A getMore which pinned the cursor before the previous read ahead on it was
+            // scheduled replaces that read ahead.
+            if (_readAheads.insert_or_assign(cursorId, readAhead).second) {
+                _numReadAheads.fetchAndAdd(1);
+            }
+        }
+
+        _threadPool.schedule([this, service, cursorId, size, readAhead](Status status) {
+            ON_BLOCK_EXIT([&] { _finish(cursorId, readAhead); });
+            if (!status.isOK() || !_start(cursorId, readAhead)) {
+                return;
+            }
+
+            ThreadClient tc("CursorReadAhead", service);
+            auto opCtx = tc->makeOperationContext();
+            boost::optional<ClientCursorPin> cursorPin;
+            try {
+                auto swCursorPin = CursorManager::get(opCtx.get())
+                                       ->pinCursor(opCtx.get(),
+                                                   cursorId,
+                                                   CursorManager::kNoCheckSession);
+                if (!swCursorPin.isOK()) {
+                    // The cursor was killed or timed out since the getMore.
+                    return;
+                }
+                cursorPin.emplace(std::move(swCursorPin.getValue()));
+
+                auto numDocs = readAheadNextBatch(opCtx.get(), *cursorPin, size);
+                readAheadBatchesCounter.increment();
+                readAheadDocumentsCounter.increment(numDocs);
+            } catch (const ExceptionFor<ErrorCodes::CursorInUse>&) {
+                // A getMore pinned the cursor before this read ahead was scheduled.
+            } catch (const DBException& ex) {
+                // The documents read before the error cannot be told apart from the ones which
+                // were not, so the cursor cannot be continued.
+                LOGV2(5963042,
+                      "Killing cursor after failing to read ahead of its next getMore",
+                      "cursorId"_attr = cursorId,
+                      "error"_attr = ex.toStatus());
+                if (cursorPin) {
+                    cursorPin->deleteUnderlying();
+                }
+            }
+        });
+    }
+
+    /**
+     * Cancels the read ahead on 'cursorId' if it has not started yet, or waits for it to finish
+     * otherwise. Must be called by a getMore before it pins the cursor.
+     */
+    void waitForReadAhead(OperationContext* opCtx, CursorId cursorId) {
+        if (_numReadAheads.load() == 0) {
+            return;
+        }
+
+        std::shared_ptr<ReadAhead> readAhead;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto it = _readAheads.find(cursorId);
+            if (it == _readAheads.end()) {
+                return;
+            }
+            if (!it->second->started) {
+                _readAheads.erase(it);
+                _numReadAheads.subtractAndFetch(1);
+                return;
+            }
+            readAhead = it->second;
+        }
+        readAhead->finished.getFuture().wait(opCtx);
+    }
+
+private:
+    struct ReadAhead {
+        bool started = false;
+        SharedPromise<void> finished;
+    };
+
+    /**
+     * Marks 'readAhead' as started, unless it was cancelled, in which case returns false.
+     */
+    bool _start(CursorId cursorId, const std::shared_ptr<ReadAhead>& readAhead) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _readAheads.find(cursorId);
+        if (it == _readAheads.end() || it->second != readAhead) {
+            return false;
+        }
+        readAhead->started = true;
+        return true;
+    }
+
+    void _finish(CursorId cursorId, const std::shared_ptr<ReadAhead>& readAhead) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            auto it = _readAheads.find(cursorId);
+            if (it != _readAheads.end() && it->second == readAhead) {
+                _readAheads.erase(it);
+                _numReadAheads.subtractAndFetch(1);
+            }
+        }
+        readAhead->finished.emplaceValue();
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("CursorReadAhead::_mutex");
+
+    // The read aheads which were scheduled and have not finished or been cancelled, by cursor id.
+    stdx::unordered_map<CursorId, std::shared_ptr<ReadAhead>> _readAheads;
+
+    // The size of '_readAheads', so that getMores need not take '_mutex' when there are none.
+    AtomicWord<size_t> _numReadAheads{0};
+
+    ThreadPool _threadPool;
+};
+
+const auto getCursorReadAhead = ServiceContext::declareDecoration<CursorReadAhead>();
+const ServiceContext::ConstructorActionRegisterer cursorReadAheadRegisterer{
+    "CursorReadAhead",
+    [](ServiceContext* service) { getCursorReadAhead(service).getThreadPool().startup(); },
+    [](ServiceContext* service) {
+        auto& pool = getCursorReadAhead(service).getThreadPool();
+        pool.shutdown();
+        pool.join();
+    }};
+
+CursorReadAhead& CursorReadAhead::get(ServiceContext* service) {
+    return getCursorReadAhead(service);
+}
+
 /**
  * A command for running getMore() against an existing cursor registered with a CursorManager.
  * Used to generate the next batch of results for a ClientCursor.
@@ -312,6 +554,21 @@ public:
                            ResourceConsumption::DocumentUnitCounter* docUnitsReturned) {
             PlanExecutor* exec = cursor->getExecutor();
 
+            // Documents read ahead of this getMore are returned before any more are read from the
+            // executor.
+            auto& readAheadDocs = cursor->getReadAheadDocs();
+            bool fromReadAhead = false;
+            auto getNext = [&](BSONObj* out) {
+                fromReadAhead = !readAheadDocs.empty();
+                if (fromReadAhead) {
+                    *out = std::move(readAheadDocs.front());
+                    readAheadDocs.pop_front();
+                    return PlanExecutor::ADVANCED;
+                }
+                return cursor->readAheadReachedEOF() ? PlanExecutor::IS_EOF
+                                                     : exec->getNext(out, nullptr);
+            };
+
             // If an awaitData getMore is killed during this process due to our max time expiring at
             // an interrupt point, we just continue as normal and return rather than reporting a
             // timeout to the user.
@@ -319,11 +576,15 @@ public:
             PlanExecutor::ExecState state;
             try {
                 while (!FindCommon::enoughForGetMore(cmd.getBatchSize().value_or(0), *numResults) &&
-                       PlanExecutor::ADVANCED == (state = exec->getNext(&obj, nullptr))) {
+                       PlanExecutor::ADVANCED == (state = getNext(&obj))) {
                     // If adding this object will cause us to exceed the message size limit, then we
                     // stash it for later.
                     if (!FindCommon::haveSpaceForNext(obj, *numResults, nextBatch->bytesUsed())) {
-                        exec->enqueue(obj);
+                        if (fromReadAhead) {
+                            readAheadDocs.push_front(obj);
+                        } else {
+                            exec->enqueue(obj);
+                        }
                         break;
                     }
 
@@ -377,14 +638,19 @@ public:
                 nextBatch->setPostBatchResumeToken(exec->getPostBatchResumeToken());
             }
 
-            return shouldSaveCursorGetMore(exec, isTailable);
+            return !readAheadDocs.empty() || shouldSaveCursorGetMore(exec, isTailable);
         }
 
-        void acquireLocksAndIterateCursor(OperationContext* opCtx,
-                                          rpc::ReplyBuilderInterface* reply,
-                                          CursorManager* cursorManager,
-                                          ClientCursorPin& cursorPin,
-                                          CurOp* curOp) {
+        /**
+         * Fills out the batch of this getMore. Returns how much of the cursor to read ahead of the
+         * next getMore, if it is to be read ahead.
+         */
+        boost::optional<ReadAheadSize> acquireLocksAndIterateCursor(
+            OperationContext* opCtx,
+            rpc::ReplyBuilderInterface* reply,
+            CursorManager* cursorManager,
+            ClientCursorPin& cursorPin,
+            CurOp* curOp) {
             // Cursors come in one of two flavors:
             //
             // - Cursors which read from a single collection, such as those generated via the
@@ -579,6 +845,7 @@ public:
             if (!opCtx->inMultiDocumentTransaction()) {
                 options.atClusterTime = repl::ReadConcernArgs::get(opCtx).getArgsAtClusterTime();
             }
+            options.expectedNumDocs = _cmd.getBatchSize().value_or(0);
             CursorResponseBuilder nextBatch(reply, options);
             BSONObj obj;
             std::uint64_t numResults = 0;
@@ -654,9 +921,18 @@ public:
                 curOp->debug().execStats = std::move(stats);
             }
 
+            boost::optional<ReadAheadSize> readAheadSize;
             if (shouldSaveCursor) {
                 respondWithId = cursorId;
 
+                if (shouldReadAhead(opCtx, cursorPin.getCursor())) {
+                    readAheadSize = ReadAheadSize{
+                        _cmd.getBatchSize() ? numResults
+                                            : std::numeric_limits<std::uint64_t>::max(),
+                        std::min(static_cast<std::size_t>(nextBatch.bytesUsed()),
+                                 static_cast<std::size_t>(getCursorReadAheadMaxBytes()))};
+                }
+
                 exec->saveState();
                 exec->detachFromOperationContext();
 
@@ -693,6 +969,8 @@ public:
                     reply->setNextInvocation(boost::none);
                 }
             }
+
+            return readAheadSize;
         }
 
         void run(OperationContext* opCtx, rpc::ReplyBuilderInterface* reply) override {
@@ -723,6 +1001,10 @@ public:
                 opCtx->lockState()->skipAcquireTicket();
             }
 
+            // A read ahead of the previous getMore holds the cursor pinned while it runs.
+            auto& cursorReadAhead = CursorReadAhead::get(opCtx->getServiceContext());
+            cursorReadAhead.waitForReadAhead(opCtx, cursorId);
+
             auto cursorManager = CursorManager::get(opCtx);
             auto cursorPin = uassertStatusOK(cursorManager->pinCursor(opCtx, cursorId));
 
@@ -730,7 +1012,8 @@ public:
             const auto isLinearizableReadConcern = cursorPin->getReadConcernArgs().getLevel() ==
                 repl::ReadConcernLevel::kLinearizableReadConcern;
 
-            acquireLocksAndIterateCursor(opCtx, reply, cursorManager, cursorPin, curOp);
+            auto readAheadSize =
+                acquireLocksAndIterateCursor(opCtx, reply, cursorManager, cursorPin, curOp);
 
             if (MONGO_unlikely(getMoreHangAfterPinCursor.shouldFail())) {
                 LOGV2(20477,
@@ -760,6 +1043,12 @@ public:
                     "waitBeforeUnpinningOrDeletingCursorAfterGetMoreBatch");
             }
 
+            if (readAheadSize) {
+                // The read ahead pins the cursor, so it must be unpinned first.
+                cursorPin.release();
+                cursorReadAhead.schedule(opCtx->getServiceContext(), cursorId, *readAheadSize);
+            }
+
             if (getTestCommandsEnabled()) {
                 validateResult(reply);
             }
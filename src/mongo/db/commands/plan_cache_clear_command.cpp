@@ -42,6 +42,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/plan_ranker.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
@@ -190,6 +191,9 @@ bool PlanCacheClearCommand::run(OperationContext* opCtx,
 
     auto planCache = getPlanCache(opCtx, ctx.getCollection());
     uassertStatusOK(clear(opCtx, planCache, nss.ns(), cmdObj));
+
+    // Cached SBE plans are cheap to rebuild, so drop all of them rather than a single shape.
+    CollectionQueryInfo::get(ctx.getCollection()).getSbePlanCache()->clear();
     return true;
 }
 
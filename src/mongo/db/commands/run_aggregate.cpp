@@ -49,12 +49,16 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
 #include "mongo/db/pipeline/change_stream_invalidation_info.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_cursor.h"
 #include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
+#include "mongo/db/pipeline/document_source_parallel_group.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/group_result_maintainer.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/pipeline_d.h"
 #include "mongo/db/pipeline/plan_executor_pipeline.h"
@@ -66,6 +70,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
 #include "mongo/db/read_concern.h"
 #include "mongo/db/repl/oplog.h"
@@ -116,7 +121,8 @@ bool canOptimizeAwayPipeline(const Pipeline* pipeline,
  * Returns true if we need to keep a ClientCursor saved for this pipeline (for future getMore
  * requests). Otherwise, returns false. The passed 'nsForCursor' is only used to determine the
  * namespace used in the returned cursor, which will be registered with the global cursor manager,
- * and thus will be different from that in 'request'.
+ * and thus will be different from that in 'request'. If 'resultBatch' is not null, the documents
+ * of the first batch are also appended to it.
  */
 bool handleCursorCommand(OperationContext* opCtx,
                          boost::intrusive_ptr<ExpressionContext> expCtx,
@@ -124,7 +130,8 @@ bool handleCursorCommand(OperationContext* opCtx,
                          std::vector<ClientCursor*> cursors,
                          const AggregateCommandRequest& request,
                          const BSONObj& cmdObj,
-                         rpc::ReplyBuilderInterface* result) {
+                         rpc::ReplyBuilderInterface* result,
+                         AggregationResultCache::Batch* resultBatch) {
     invariant(!cursors.empty());
     long long batchSize =
         request.getCursor().getBatchSize().value_or(aggregation_request_helper::kDefaultBatchSize);
@@ -247,6 +254,9 @@ bool handleCursorCommand(OperationContext* opCtx,
         responseBuilder.setPostBatchResumeToken(exec->getPostBatchResumeToken());
         responseBuilder.append(nextDoc);
         docUnitsReturned.observeOne(nextDoc.objsize());
+        if (resultBatch) {
+            resultBatch->push_back(nextDoc.getOwned());
+        }
     }
 
     if (cursor) {
@@ -537,6 +547,112 @@ std::vector<std::unique_ptr<Pipeline, PipelineDeleter>> createExchangePipelinesI
     return pipelines;
 }
 
+/**
+ * Splits the first $group of 'pipeline' between 'internalQueryParallelGroupWorkers' threads, if
+ * that is enabled and the input of the $group can be read from several operations. The extra
+ * operations only see the latest data and carry none of the shard versioning of this one, so this
+ * is limited to plain local reads outside of transactions.
+ */
+void parallelizeGroupIfNeeded(OperationContext* opCtx,
+                              const AggregateCommandRequest& request,
+                              const LiteParsedPipeline& liteParsedPipeline,
+                              Pipeline* pipeline) {
+    const auto numWorkers = internalQueryParallelGroupWorkers.load();
+    const auto& expCtx = pipeline->getContext();
+    if (numWorkers < 2 || request.getExchange() || expCtx->explain ||
+        liteParsedPipeline.hasChangeStream() || expCtx->tailableMode != TailableModeEnum::kNormal ||
+        request.getFromMongos() || opCtx->inMultiDocumentTransaction()) {
+        return;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAtClusterTime() || readConcernArgs.getArgsAfterClusterTime()) {
+        return;
+    }
+
+    // Only a collection read can be handed from one operation to another.
+    if (pipeline->getSources().empty() ||
+        !dynamic_cast<DocumentSourceCursor*>(pipeline->peekFront())) {
+        return;
+    }
+
+    DocumentSourceParallelGroup::parallelizeIfPossible(pipeline, numWorkers);
+}
+
+/**
+ * Returns the key to cache the result of 'request' under in the AggregationResultCache, or
+ * boost::none if the cache is disabled or cannot serve this aggregation. Only reads of a single
+ * collection outside of transactions and at the latest data are cached, see also
+ * AggregationResultCache::makeKey().
+ */
+boost::optional<std::string> getResultCacheKey(OperationContext* opCtx,
+                                               const AggregateCommandRequest& request,
+                                               const LiteParsedPipeline& liteParsedPipeline) {
+    auto& cache = AggregationResultCache::get(opCtx->getServiceContext());
+    if (!cache.isEnabled()) {
+        // Release the results cached before the cache was disabled.
+        if (cache.getSizeBytes() > 0) {
+            cache.clear();
+        }
+        return boost::none;
+    }
+
+    // The internal databases and the system collections are written to without going through the
+    // observed writes, the oplog in particular.
+    const auto& nss = request.getNamespace();
+    if (nss.isCollectionlessAggregateNS() || nss.isOnInternalDb() || nss.isSystem() ||
+        !liteParsedPipeline.getInvolvedNamespaces().empty() ||
+        liteParsedPipeline.hasChangeStream() || opCtx->inMultiDocumentTransaction()) {
+        return boost::none;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAtClusterTime() || readConcernArgs.getArgsAfterClusterTime()) {
+        return boost::none;
+    }
+
+    return AggregationResultCache::makeKey(request);
+}
+
+/**
+ * Replies to 'request' with a cached result as the exhausted first batch of a cursor. Returns
+ * false, without replying, if the result does not fit in the requested batch size or in a reply.
+ */
+bool replyWithCachedResult(OperationContext* opCtx,
+                           const NamespaceString& nsForCursor,
+                           const AggregateCommandRequest& request,
+                           const AggregationResultCache::Batch& batch,
+                           rpc::ReplyBuilderInterface* result) {
+    const auto batchSize =
+        request.getCursor().getBatchSize().value_or(aggregation_request_helper::kDefaultBatchSize);
+    if (static_cast<long long>(batch.size()) > batchSize) {
+        return false;
+    }
+    // A result maintained on inserts may have outgrown a single batch.
+    int bytes = 0;
+    for (size_t count = 0; count < batch.size(); ++count) {
+        if (!FindCommon::haveSpaceForNext(batch[count], count, bytes)) {
+            return false;
+        }
+        bytes += batch[count].objsize();
+    }
+
+    CursorResponseBuilder::Options options;
+    options.isInitialResponse = true;
+    CursorResponseBuilder responseBuilder(result, options);
+    for (auto&& doc : batch) {
+        responseBuilder.append(doc);
+    }
+    responseBuilder.done(0LL, nsForCursor.ns());
+
+    auto& opDebug = CurOp::get(opCtx)->debug();
+    opDebug.nreturned = batch.size();
+    opDebug.cursorExhausted = true;
+    return true;
+}
+
 /**
  * Performs validations related to API versioning and time-series stages.
  * Throws UserAssertion if any of the validations fails
@@ -576,6 +692,15 @@ Status runAggregate(OperationContext* opCtx,
     // For operations on views, this will be the underlying namespace.
     NamespaceString nss = request.getNamespace();
 
+    // The write generation is read before any storage snapshot is opened, so that a cached result
+    // is only used while nothing has been written since, see AggregationResultCache.
+    auto& resultCache = AggregationResultCache::get(opCtx->getServiceContext());
+    auto resultCacheKey = getResultCacheKey(opCtx, request, liteParsedPipeline);
+    const auto resultCacheWriteGeneration = resultCacheKey
+        ? resultCache.getWriteGeneration(nss)
+        : AggregationResultCache::WriteGeneration{};
+    AggregationResultCache::Batch resultBatch;
+
     // The collation to use for this aggregation. boost::optional to distinguish between the case
     // where the collation has not yet been resolved, and where it has been resolved to nullptr.
     boost::optional<std::unique_ptr<CollatorInterface>> collatorToUse;
@@ -751,6 +876,20 @@ Status runAggregate(OperationContext* opCtx,
                     uuid && uuid == *request.getCollectionUUID());
         }
 
+        // Only a read of the latest data, rather than of the last applied batch on a secondary,
+        // sees every write that was counted in the write generation.
+        if (resultCacheKey &&
+            opCtx->recoveryUnit()->getTimestampReadSource() !=
+                RecoveryUnit::ReadSource::kNoTimestamp) {
+            resultCacheKey = boost::none;
+        }
+        if (resultCacheKey) {
+            auto cached = resultCache.find(*resultCacheKey, resultCacheWriteGeneration);
+            if (cached && replyWithCachedResult(opCtx, origNss, request, *cached, result)) {
+                return Status::OK();
+            }
+        }
+
         invariant(collatorToUse);
         expCtx = makeExpressionContext(opCtx, request, std::move(*collatorToUse), uuid);
 
@@ -808,6 +947,8 @@ Status runAggregate(OperationContext* opCtx,
                                                           std::move(attachExecutorCallback.second),
                                                           pipeline.get());
 
+            parallelizeGroupIfNeeded(opCtx, request, liteParsedPipeline, pipeline.get());
+
             auto pipelines =
                 createExchangePipelinesIfNeeded(opCtx, expCtx, request, std::move(pipeline), uuid);
             for (auto&& pipelineIt : pipelines) {
@@ -901,10 +1042,25 @@ Status runAggregate(OperationContext* opCtx,
         }
     } else {
         // Cursor must be specified, if explain is not.
-        const bool keepCursor = handleCursorCommand(
-            opCtx, expCtx, origNss, std::move(cursors), request, cmdObj, result);
+        const bool keepCursor = handleCursorCommand(opCtx,
+                                                    expCtx,
+                                                    origNss,
+                                                    std::move(cursors),
+                                                    request,
+                                                    cmdObj,
+                                                    result,
+                                                    resultCacheKey ? &resultBatch : nullptr);
         if (keepCursor) {
             cursorFreer.dismiss();
+        } else if (resultCacheKey) {
+            // Without a collation, a $group result can be kept up to date on inserts.
+            resultCache.insert(*resultCacheKey,
+                               nss,
+                               resultCacheWriteGeneration,
+                               std::move(resultBatch),
+                               expCtx->getCollator()
+                                   ? nullptr
+                                   : GroupResultMaintainer::make(opCtx, request));
         }
 
         PlanSummaryStats stats;
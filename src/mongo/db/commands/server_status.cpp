@@ -34,6 +34,7 @@
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/server_status.h"
+#include "mongo/db/commands/server_status_gen.h"
 #include "mongo/db/commands/server_status_internal.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/stats/counters.h"
@@ -51,6 +52,18 @@ using std::stringstream;
 
 namespace {
 constexpr auto kTimingSection = "timing"_sd;
+
+// When false, only the sections named in the command are included, as if every section had
+// includeByDefault() return false.
+constexpr auto kIncludeDefaultSectionsField = "includeDefaultSections"_sd;
+
+/**
+ * Whether a section was asked for as 'section: true' or 'section: 1', or left to be included by
+ * default, so that the section generated for an earlier command can be given to this one.
+ */
+bool isRequestedWithoutOptions(const BSONElement& elem) {
+    return elem.eoo() || elem.type() == Bool || (elem.isNumber() && elem.numberDouble() == 1);
+}
 }  // namespace
 
 class CmdServerStatus : public BasicCommand {
@@ -106,6 +119,11 @@ public:
 
         // --- all sections
 
+        const auto& includeDefaultSectionsElem = cmdObj[kIncludeDefaultSectionsField];
+        const bool includeDefaultSections =
+            includeDefaultSectionsElem.eoo() || includeDefaultSectionsElem.trueValue();
+        const Milliseconds refreshInterval{gServerStatusExpensiveSectionRefreshMillis.load()};
+
         for (SectionMap::const_iterator i = _sections.begin(); i != _sections.end(); ++i) {
             ServerStatusSection* section = i->second;
 
@@ -114,7 +132,7 @@ public:
             if (!authSession->isAuthorizedForPrivileges(requiredPrivileges))
                 continue;
 
-            bool include = section->includeByDefault();
+            bool include = includeDefaultSections && section->includeByDefault();
             const auto& elem = cmdObj[section->getSectionName()];
             if (elem.type()) {
                 include = elem.trueValue();
@@ -124,7 +142,12 @@ public:
                 continue;
             }
 
-            section->appendSection(opCtx, elem, &result);
+            if (section->getCost() == ServerStatusSection::Cost::kExpensive &&
+                refreshInterval > Milliseconds(0) && isRequestedWithoutOptions(elem)) {
+                section->appendCachedSection(opCtx, elem, clock->now(), refreshInterval, &result);
+            } else {
+                section->appendSection(opCtx, elem, &result);
+            }
             timeBuilder.appendNumber(
                 static_cast<string>(str::stream() << "after " << section->getSectionName()),
                 durationCount<Milliseconds>(clock->now() - runStart));
@@ -201,6 +224,33 @@ ServerStatusSection::ServerStatusSection(const string& sectionName) : _sectionNa
     CmdServerStatusInstantiator::getInstance().addSection(this);
 }
 
+void ServerStatusSection::appendCachedSection(OperationContext* opCtx,
+                                              const BSONElement& configElement,
+                                              Date_t now,
+                                              Milliseconds refreshInterval,
+                                              BSONObjBuilder* result) const {
+    {
+        stdx::lock_guard<Latch> lk(_cacheMutex);
+        if (_cachedAt != Date_t() && now - _cachedAt < refreshInterval) {
+            result->appendElements(_cachedFields);
+            return;
+        }
+    }
+
+    // The section is generated without holding the mutex, as generating it may block, so two
+    // commands which find the cached fields out of date at the same time both generate it.
+    BSONObjBuilder fields;
+    appendSection(opCtx, configElement, &fields);
+    BSONObj generated = fields.obj();
+    result->appendElements(generated);
+
+    stdx::lock_guard<Latch> lk(_cacheMutex);
+    if (!generated.isEmpty() && now >= _cachedAt) {
+        _cachedFields = std::move(generated);
+        _cachedAt = now;
+    }
+}
+
 OpCounterServerStatusSection::OpCounterServerStatusSection(const string& sectionName,
                                                            OpCounters* counters)
     : ServerStatusSection(sectionName), _counters(counters) {}
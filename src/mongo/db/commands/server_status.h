@@ -33,12 +33,22 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/stats/counters.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/time_support.h"
 #include <string>
 
 namespace mongo {
 
 class ServerStatusSection {
 public:
+    /**
+     * How expensive a section is to generate. An expensive section is generated at most once per
+     * 'serverStatusExpensiveSectionRefreshMillis', and the serverStatus commands which ask for it
+     * without options in between are given the result of the last one. This lets the callers of
+     * serverStatus which poll it often, such as FTDC and monitoring agents, share one snapshot.
+     */
+    enum class Cost { kCheap, kExpensive };
+
     ServerStatusSection(const std::string& sectionName);
     virtual ~ServerStatusSection() = default;
 
@@ -64,6 +74,10 @@ public:
      */
     virtual bool includeByDefault() const = 0;
 
+    virtual Cost getCost() const {
+        return Cost::kCheap;
+    }
+
     /**
      * Adds the privileges that are required to view this section
      * TODO: Remove this empty default implementation and implement for every section.
@@ -103,8 +117,22 @@ public:
         result->append(getSectionName(), ret);
     }
 
+    /**
+     * Appends the section as appendSection() would, unless it was generated less than
+     * 'refreshInterval' before 'now', in which case the fields it generated then are appended.
+     */
+    void appendCachedSection(OperationContext* opCtx,
+                             const BSONElement& configElement,
+                             Date_t now,
+                             Milliseconds refreshInterval,
+                             BSONObjBuilder* result) const;
+
 private:
     const std::string _sectionName;
+
+    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("ServerStatusSection::_cacheMutex");
+    mutable BSONObj _cachedFields;
+    mutable Date_t _cachedAt;
 };
 
 class OpCounterServerStatusSection : public ServerStatusSection {
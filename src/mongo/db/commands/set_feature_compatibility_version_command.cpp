@@ -33,6 +33,7 @@
 
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/coll_mod.h"
+#include "mongo/db/catalog/collection_catalog_helper.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/drop_indexes.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/index_builds_coordinator.h"
+#include "mongo/db/index_names.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/read_write_concern_defaults.h"
@@ -56,6 +58,7 @@
 #include "mongo/db/s/config/sharding_catalog_manager.h"
 #include "mongo/db/s/sharding_ddl_coordinator_service.h"
 #include "mongo/db/server_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/transaction_history_iterator.h"
 #include "mongo/db/vector_clock.h"
 #include "mongo/db/views/view_catalog.h"
@@ -598,6 +601,31 @@ private:
             Lock::GlobalLock lk(opCtx, MODE_S);
         }
 
+        // Columnstore indexes cannot be created in the downgraded FCV, which the builds that
+        // started before the FCV change have now registered. The user must drop the existing ones
+        // before downgrading.
+        if (feature_flags::gColumnstoreIndexes.isEnabledAndIgnoreFCV() &&
+            requestedVersion < feature_flags::gColumnstoreIndexes.getVersion()) {
+            for (const auto& dbName : DatabaseHolder::get(opCtx)->getNames()) {
+                AutoGetDb autoDb(opCtx, dbName, MODE_IS);
+                catalog::forEachCollectionFromDb(
+                    opCtx, dbName, MODE_IS, [&](const CollectionPtr& collection) {
+                        std::vector<const IndexDescriptor*> columnIndexes;
+                        collection->getIndexCatalog()->findIndexByType(
+                            opCtx, IndexNames::COLUMN, columnIndexes, true /* includeUnfinished */);
+                        uassert(ErrorCodes::CannotDowngrade,
+                                str::stream()
+                                    << "Cannot downgrade the cluster when there are columnstore "
+                                       "indexes present; drop all columnstore indexes before "
+                                       "downgrading. First detected columnstore index: "
+                                    << collection->ns() << " "
+                                    << columnIndexes.front()->indexName(),
+                                columnIndexes.empty());
+                        return true;
+                    });
+            }
+        }
+
         uassert(ErrorCodes::Error(549181),
                 "Failing upgrade due to 'failDowngrading' failpoint set",
                 !failDowngrading.shouldFail());
@@ -27,6 +27,8 @@
  *    it in the license file.
  */
 
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kWrite
+
 #include "mongo/platform/basic.h"
 
 #include "mongo/base/checked_cast.h"
@@ -41,6 +43,8 @@
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/json.h"
 #include "mongo/db/lasterror.h"
 #include "mongo/db/matcher/doc_validation_error.h"
@@ -64,10 +68,14 @@
 #include "mongo/db/stats/counters.h"
 #include "mongo/db/storage/duplicate_key_error_info.h"
 #include "mongo/db/storage/durable_catalog.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/timeseries_field_names.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/db/write_concern.h"
+#include "mongo/logv2/log.h"
 #include "mongo/logv2/redaction.h"
 #include "mongo/s/stale_exception.h"
 #include "mongo/util/fail_point.h"
@@ -237,6 +245,46 @@ BSONObj makeTimeseriesInsertDocument(std::shared_ptr<BucketCatalog::WriteBatch>
     return builder.obj();
 }
 
+/**
+ * Returns the latest bucket in 'bucketsNs' that a measurement with the given metadata and time
+ * could be added to, or an empty document if there is none. A bucket's _id, which the buckets
+ * collection is clustered by, has the start of its time range as its timestamp, which bounds the
+ * scan to the buckets that may cover 'time'.
+ */
+BSONObj findBucketToReopen(OperationContext* opCtx,
+                           const NamespaceString& bucketsNs,
+                           const TimeseriesOptions& options,
+                           const BSONObj& metadata,
+                           Date_t time) {
+    AutoGetCollectionForRead bucketsColl(opCtx, bucketsNs);
+    if (!bucketsColl) {
+        return {};
+    }
+
+    OID minId;
+    minId.init(time - Seconds(options.getBucketMaxSpanSeconds()));
+    OID maxId;
+    maxId.init(time, true /* max */);
+
+    BSONObjBuilder filter;
+    filter.append(timeseries::kBucketIdFieldName, BSON("$gte" << minId << "$lte" << maxId));
+    if (auto metaElem = metadata.firstElement()) {
+        filter.appendAs(metaElem, timeseries::kBucketMetaFieldName);
+    } else {
+        filter.append(timeseries::kBucketMetaFieldName, BSON("$exists" << false));
+    }
+
+    auto findCommand = std::make_unique<FindCommandRequest>(bucketsNs);
+    findCommand->setFilter(filter.obj());
+    findCommand->setSort(BSON(timeseries::kBucketIdFieldName << -1));
+    auto recordId =
+        Helpers::findOne(opCtx, bucketsColl.getCollection(), std::move(findCommand), false);
+    if (recordId.isNull()) {
+        return {};
+    }
+    return bucketsColl->docFor(opCtx, recordId).value().getOwned();
+}
+
 /**
  * Returns true if the time-series write is retryable.
  */
@@ -628,6 +676,78 @@ public:
                 OperationSource::kTimeseries));
         }
 
+        /**
+         * Replaces the bucket 'bucketId', which is full and will not be written to again, with its
+         * compressed version. This is best-effort: upon failure, or if the bucket has been modified
+         * in the meantime, the bucket is left uncompressed, which readers handle just as well.
+         */
+        void _compressTimeseriesBucket(OperationContext* opCtx, const OID& bucketId) const {
+            // Use a client of its own, so that the replacement is neither a statement of a
+            // retryable insert nor part of what its write concern waits for.
+            auto client = opCtx->getServiceContext()->makeClient("TimeseriesBucketCompression");
+            {
+                stdx::lock_guard<Client> lk(*client);
+                client->setSystemOperationKillableByStepdown(lk);
+            }
+            AlternativeClientRegion acr(client);
+            auto compressionOpCtx = cc().makeOperationContext();
+
+            auto bucketsNs = ns().makeTimeseriesBucketsNamespace();
+            try {
+                DBDirectClient dbClient(compressionOpCtx.get());
+                auto bucket = dbClient.findOne(bucketsNs.ns(), BSON("_id" << bucketId));
+                if (bucket.isEmpty()) {
+                    return;
+                }
+                auto compressed = timeseries::compressBucket(bucket);
+                if (compressed.objdata() == bucket.objdata()) {
+                    // None of the columns can be compressed.
+                    return;
+                }
+
+                // Only replace the bucket if it is still the one which was compressed.
+                auto isUnchanged =
+                    BSON("$eq" << BSON_ARRAY("$$ROOT" << BSON("$literal" << bucket)));
+                write_ops::UpdateOpEntry update(
+                    BSON("_id" << bucketId << "$expr" << isUnchanged),
+                    write_ops::UpdateModification::parseFromClassicUpdate(compressed));
+                write_ops::UpdateCommandRequest op(bucketsNs, {std::move(update)});
+                op.setWriteCommandRequestBase(_makeTimeseriesWriteOpBase({}));
+
+                auto result = _getTimeseriesSingleWriteResult(write_ops_exec::performUpdates(
+                    compressionOpCtx.get(), op, OperationSource::kTimeseries));
+                uassertStatusOK(result.getStatus());
+            } catch (const DBException& ex) {
+                LOGV2_DEBUG(5843141,
+                            1,
+                            "Failed to compress time-series bucket",
+                            "namespace"_attr = bucketsNs,
+                            "bucketId"_attr = bucketId,
+                            "error"_attr = redact(ex.toStatus()));
+            }
+        }
+
+        /**
+         * Compresses the buckets which were closed by the batch 'batch', or by 'closedBucket', the
+         * result of finishing it, if the time-series bucket compression is enabled.
+         */
+        void _compressClosedTimeseriesBuckets(
+            OperationContext* opCtx,
+            const BucketCatalog::WriteBatch& batch,
+            const boost::optional<BucketCatalog::ClosedBucket>& closedBucket) const {
+            if (!feature_flags::gTimeseriesBucketCompression.isEnabled(
+                    serverGlobalParams.featureCompatibility)) {
+                return;
+            }
+
+            for (auto&& bucket : batch.closedBuckets()) {
+                _compressTimeseriesBucket(opCtx, bucket.bucketId);
+            }
+            if (closedBucket) {
+                _compressTimeseriesBucket(opCtx, closedBucket->bucketId);
+            }
+        }
+
         void _commitTimeseriesBucket(OperationContext* opCtx,
                                      std::shared_ptr<BucketCatalog::WriteBatch> batch,
                                      size_t start,
@@ -671,8 +791,11 @@ public:
 
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
-            bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+            auto closedBucket =
+                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
             batchGuard.dismiss();
+
+            _compressClosedTimeseriesBuckets(opCtx, *batch, closedBucket);
         }
 
         bool _commitTimeseriesBucketsAtomically(OperationContext* opCtx,
@@ -736,7 +859,9 @@ public:
             getOpTimeAndElectionId(opCtx, opTime, electionId);
 
             for (auto batch : batchesToCommit) {
-                bucketCatalog.finish(batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                auto closedBucket = bucketCatalog.finish(
+                    batch, BucketCatalog::CommitInfo{*opTime, *electionId});
+                _compressClosedTimeseriesBuckets(opCtx, *batch.get(), closedBucket);
                 batch.get().reset();
             }
 
@@ -767,6 +892,11 @@ public:
             TimeseriesBatches batches;
             TimeseriesStmtIds stmtIds;
 
+            auto findBucket = [&](const BSONObj& metadata, Date_t time) {
+                return findBucketToReopen(
+                    opCtx, bucketsNs, *bucketsColl->getTimeseriesOptions(), metadata, time);
+            };
+
             auto insert = [&](size_t index) {
                 invariant(start + index < request().getDocuments().size());
 
@@ -788,7 +918,8 @@ public:
                                          bucketsColl->getDefaultCollator(),
                                          *bucketsColl->getTimeseriesOptions(),
                                          request().getDocuments()[start + index],
-                                         _canCombineTimeseriesInsertWithOtherClients(opCtx));
+                                         _canCombineTimeseriesInsertWithOtherClients(opCtx),
+                                         findBucket);
 
                 if (auto error = generateError(opCtx, result, start + index, errors->size())) {
                     errors->push_back(*error);
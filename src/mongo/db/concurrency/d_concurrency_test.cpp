@@ -1496,6 +1496,36 @@ TEST_F(DConcurrencyTestFixture, NoThrottlingWhenNotAcquiringTickets) {
     ASSERT(R2.isLocked());
 }
 
+TEST_F(DConcurrencyTestFixture, ImmediateTicketPriorityDoesNotQueueForTickets) {
+    auto clientOpctxPairs = makeKClientsWithLockers(3);
+    auto opctx1 = clientOpctxPairs[0].second.get();
+    auto opctx2 = clientOpctxPairs[1].second.get();
+    auto opctx3 = clientOpctxPairs[2].second.get();
+    // Limit the locker to 1 ticket at a time.
+    UseGlobalThrottling throttle(opctx1, 1);
+
+    opctx2->lockState()->setTicketPriority(TicketPriority::kImmediate);
+    opctx3->lockState()->setTicketPriority(TicketPriority::kImmediate);
+
+    {
+        // The first locker with priority takes the only ticket, the second one proceeds without.
+        Lock::GlobalRead R2(opctx2, Date_t::now(), Lock::InterruptBehavior::kThrow);
+        ASSERT(R2.isLocked());
+        Lock::GlobalRead R3(opctx3, Date_t::now(), Lock::InterruptBehavior::kThrow);
+        ASSERT(R3.isLocked());
+
+        // Lockers without priority still queue for tickets.
+        ASSERT_THROWS_CODE(
+            Lock::GlobalRead(opctx1, Date_t::now(), Lock::InterruptBehavior::kThrow),
+            AssertionException,
+            ErrorCodes::LockTimeout);
+    }
+
+    // Both lockers with priority left behind the ticket they had, and only that one.
+    Lock::GlobalRead R1(opctx1, Date_t::now(), Lock::InterruptBehavior::kThrow);
+    ASSERT(R1.isLocked());
+}
+
 TEST_F(DConcurrencyTestFixture, ReleaseAndReacquireTicket) {
     auto clientOpctxPairs = makeKClientsWithLockers(2);
     auto opctx1 = clientOpctxPairs[0].second.get();
@@ -45,6 +45,7 @@
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 #include "mongo/util/timer.h"
@@ -413,9 +414,27 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
-// Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+namespace {
+
+/**
+ * Returns the number of partitions for intent locks. Balance scalability of intent locks against
+ * the potential added cost of conflicting locks, which must visit every partition in use. With
+ * fewer partitions than cores, lockers running at the same time share partition mutexes, so scale
+ * with the number of cores above a floor of 32. The value should be a power of two.
+ */
+unsigned computeNumPartitions() {
+    const unsigned kMinNumPartitions = 32;
+    const unsigned kMaxNumPartitions = 1024;
+
+    unsigned numPartitions = kMinNumPartitions;
+    while (numPartitions < stdx::thread::hardware_concurrency() &&
+           numPartitions < kMaxNumPartitions) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
 
 // static
 std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serviceContext) {
@@ -443,7 +462,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
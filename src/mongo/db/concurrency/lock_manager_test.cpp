@@ -317,6 +317,36 @@ TEST(LockManager, Conflict) {
     ASSERT(request2.numNotifies == 1);
 }
 
+TEST(LockManager, ConflictWithIntentLocksFromManyPartitions) {
+    LockManager lockMgr;
+    const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
+
+    // Enough lockers to spread the intent requests over every partition.
+    const int kNumIntentLockers = 2048;
+    std::vector<std::unique_ptr<LockerImpl>> lockers;
+    std::vector<std::unique_ptr<LockRequestCombo>> requests;
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        lockers.push_back(std::make_unique<LockerImpl>());
+        requests.push_back(std::make_unique<LockRequestCombo>(lockers.back().get()));
+        ASSERT(LOCK_OK ==
+               lockMgr.lock(resId, requests.back().get(), (i % 2) ? MODE_IX : MODE_IS));
+    }
+
+    // The exclusive request must wait for the intent locks in all the partitions.
+    LockerImpl lockerX;
+    LockRequestCombo requestX(&lockerX);
+    ASSERT(LOCK_WAITING == lockMgr.lock(resId, &requestX, MODE_X));
+
+    for (int i = 0; i < kNumIntentLockers; i++) {
+        ASSERT(requestX.numNotifies == 0);
+        lockMgr.unlock(requests[i].get());
+    }
+    ASSERT(requestX.numNotifies == 1);
+    ASSERT(requestX.lastResult == LOCK_OK);
+
+    lockMgr.unlock(&requestX);
+}
+
 TEST(LockManager, MultipleConflict) {
     LockManager lockMgr;
     const ResourceId resId(RESOURCE_COLLECTION, std::string("TestDB.collection"));
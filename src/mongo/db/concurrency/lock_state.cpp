@@ -50,6 +50,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -347,6 +348,11 @@ void LockerImpl::reacquireTicket(OperationContext* opCtx) {
 bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t deadline) {
     const bool reader = isSharedLockMode(mode);
     auto holder = shouldAcquireTicket() ? ticketHolders[mode] : nullptr;
+    if (holder && getTicketPriority() == TicketPriority::kImmediate) {
+        // Take a ticket if one is available, but never queue behind other operations for one.
+        _admittedWithoutTicket = !holder->tryAcquire();
+        holder = nullptr;
+    }
     if (holder) {
         _clientState.store(reader ? kQueuedReader : kQueuedWriter);
 
@@ -360,9 +366,11 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        Timer waitTimer;
+        ON_BLOCK_EXIT([&] { _ticketWaitMicros.fetchAndAdd(waitTimer.micros()); });
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, getTicketPriority());
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, getTicketPriority())) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
@@ -1035,9 +1043,10 @@ void LockerImpl::releaseTicket() {
 
 void LockerImpl::_releaseTicket() {
     auto holder = shouldAcquireTicket() ? ticketHolders[_modeForTicket] : nullptr;
-    if (holder) {
+    if (holder && !_admittedWithoutTicket) {
         holder->release();
     }
+    _admittedWithoutTicket = false;
     _clientState.store(kInactive);
 }
 
@@ -212,6 +212,10 @@ public:
         return _flowControlStats;
     }
 
+    Microseconds getTicketWaitTime() const override {
+        return Microseconds(_ticketWaitMicros.load());
+    }
+
     //
     // Below functions are for testing only.
     //
@@ -346,9 +350,16 @@ private:
     // Mode for which the Locker acquired a ticket, or MODE_NONE if no ticket was acquired.
     LockMode _modeForTicket = MODE_NONE;
 
+    // Whether the Locker was admitted without a ticket for '_modeForTicket' because of its
+    // immediate ticket priority, in which case it has no ticket to release.
+    bool _admittedWithoutTicket = false;
+
     // Indicates whether the client is active reader/writer or is queued.
     AtomicWord<ClientState> _clientState{kInactive};
 
+    // The total time spent waiting for tickets, which other threads read to report on operations.
+    AtomicWord<long long> _ticketWaitMicros{0};
+
     // Track the thread who owns the lock for debugging purposes
     stdx::thread::id _threadId;
 
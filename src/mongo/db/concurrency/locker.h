@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/ticket_priority.h"
 
 namespace mongo {
 
@@ -491,6 +492,20 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Sets the priority with which this locker waits for tickets. With TicketPriority::kImmediate,
+     * the locker proceeds without a ticket when none is immediately available instead of queueing.
+     * This is meant for internal work, such as oplog application, which must not be starved by a
+     * saturated ticket pool.
+     */
+    void setTicketPriority(TicketPriority priority) {
+        _ticketPriority = priority;
+    }
+
+    TicketPriority getTicketPriority() const {
+        return _ticketPriority;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -505,6 +520,14 @@ public:
         return FlowControlTicketholder::CurOp();
     }
 
+    /**
+     * If tracked by an implementation, returns the total time spent waiting for a ticket to take
+     * the global lock. May be called from other threads.
+     */
+    virtual Microseconds getTicketWaitTime() const {
+        return Microseconds(0);
+    }
+
     /**
      * This function is for unit testing only.
      */
@@ -539,6 +562,7 @@ protected:
 private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAcquireTicket = true;
+    TicketPriority _ticketPriority = TicketPriority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
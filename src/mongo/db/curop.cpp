@@ -50,6 +50,7 @@
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/query/getmore_request.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_memory_budget.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/metadata/client_metadata.h"
 #include "mongo/rpc/metadata/impersonated_user_metadata.h"
@@ -445,11 +446,30 @@ TickSource::Tick CurOp::startTime() {
     // accessed. The above thread ownership requirement ensures that there will never be concurrent
     // calls to this '_start' assignment, but we use compare-exchange anyway as an additional check
     // that writes to '_start' never race.
+    if ((_cpuClock = ThreadCPUClock::forCurrentThread())) {
+        _cpuTimeAtStart = _cpuClock->now().value_or(Nanoseconds(0));
+        _startThreadId = stdx::this_thread::get_id();
+    }
+    if (auto opCtx = _stack->opCtx()) {
+        _ticketWaitTimeAtStart = opCtx->lockState()->getTicketWaitTime();
+    }
+
     TickSource::Tick unassignedStart = 0;
     invariant(_start.compare_exchange_strong(unassignedStart, _tickSource->getTicks()));
     return _start.load();
 }
 
+boost::optional<Nanoseconds> CurOp::_getCPUTime() const {
+    if (!_cpuClock) {
+        return boost::none;
+    }
+    auto now = _cpuClock->now();
+    if (!now) {
+        return boost::none;
+    }
+    return *now - _cpuTimeAtStart;
+}
+
 void CurOp::done() {
     // As documented in the 'CurOp::startTime()' member function, it is legal for this function to
     // be called multiple times, but all calls must be in in the thread that "owns" this CurOp
@@ -457,6 +477,14 @@ void CurOp::done() {
     invariant(!_stack->opCtx() || Client::getCurrent() == _stack->opCtx()->getClient());
 
     _end = _tickSource->getTicks();
+
+    // The thread's CPU time only belongs to this operation if it ran on a single thread.
+    if (_startThreadId == stdx::this_thread::get_id()) {
+        _debug.cpuTime = _getCPUTime();
+    }
+    if (auto opCtx = _stack->opCtx()) {
+        _debug.ticketWaitTime = opCtx->lockState()->getTicketWaitTime() - _ticketWaitTimeAtStart;
+    }
 }
 
 Microseconds CurOp::computeElapsedTimeTotal(TickSource::Tick startTime,
@@ -782,6 +810,20 @@ void CurOp::reportState(OperationContext* opCtx, BSONObjBuilder* builder, bool t
 
     builder->append("numYields", _numYields.load());
 
+    if (auto bytes = QueryMemoryBudget::get().getBytesForOperation(opCtx->getOpID()); bytes > 0) {
+        builder->append("queryMemoryUsageBytes", static_cast<long long>(bytes));
+    }
+
+    if (start) {
+        if (auto cpuTime = _getCPUTime()) {
+            builder->append("cpuNanos", durationCount<Nanoseconds>(*cpuTime));
+        }
+        if (auto ticketWaitTime = opCtx->lockState()->getTicketWaitTime() - _ticketWaitTimeAtStart;
+            ticketWaitTime > Microseconds(0)) {
+            builder->append("ticketWaitMicros", durationCount<Microseconds>(ticketWaitTime));
+        }
+    }
+
     if (_debug.dataThroughputLastSecond) {
         builder->append("dataThroughputLastSecond", *_debug.dataThroughputLastSecond);
     }
@@ -964,6 +1006,14 @@ string OpDebug::report(OperationContext* opCtx, const SingleThreadedLockStats* l
         s << " remoteOpWaitMillis:" << durationCount<Milliseconds>(*remoteOpWaitTime);
     }
 
+    if (cpuTime) {
+        s << " cpuNanos:" << durationCount<Nanoseconds>(*cpuTime);
+    }
+
+    if (ticketWaitTime > Microseconds(0)) {
+        s << " ticketWaitMicros:" << durationCount<Microseconds>(ticketWaitTime);
+    }
+
     s << " " << durationCount<Milliseconds>(executionTime) << "ms";
 
     return s.str();
@@ -1145,6 +1195,14 @@ void OpDebug::report(OperationContext* opCtx,
         pAttrs->add("remoteOpWaitMillis", durationCount<Milliseconds>(*remoteOpWaitTime));
     }
 
+    if (cpuTime) {
+        pAttrs->add("cpuNanos", durationCount<Nanoseconds>(*cpuTime));
+    }
+
+    if (ticketWaitTime > Microseconds(0)) {
+        pAttrs->add("ticketWaitMicros", durationCount<Microseconds>(ticketWaitTime));
+    }
+
     pAttrs->add("durationMillis", durationCount<Milliseconds>(executionTime));
 }
 
@@ -1269,6 +1327,14 @@ void OpDebug::append(OperationContext* opCtx,
         b.append("remoteOpWaitMillis", durationCount<Milliseconds>(*remoteOpWaitTime));
     }
 
+    if (cpuTime) {
+        b.append("cpuNanos", durationCount<Nanoseconds>(*cpuTime));
+    }
+
+    if (ticketWaitTime > Microseconds(0)) {
+        b.append("ticketWaitMicros", durationCount<Microseconds>(ticketWaitTime));
+    }
+
     b.appendNumber("millis", durationCount<Milliseconds>(executionTime));
 
     if (!curop.getPlanSummary().empty()) {
@@ -1542,6 +1608,18 @@ std::function<BSONObj(ProfileFilter::Args)> OpDebug::appendStaged(StringSet requ
         }
     });
 
+    addIfNeeded("cpuNanos", [](auto field, auto args, auto& b) {
+        if (args.op.cpuTime) {
+            b.append(field, durationCount<Nanoseconds>(*args.op.cpuTime));
+        }
+    });
+
+    addIfNeeded("ticketWaitMicros", [](auto field, auto args, auto& b) {
+        if (args.op.ticketWaitTime > Microseconds(0)) {
+            b.append(field, durationCount<Microseconds>(args.op.ticketWaitTime));
+        }
+    });
+
     // millis and durationMillis are the same thing. This is one of the few inconsistencies between
     // the profiler (OpDebug::append) and the log file (OpDebug::report), so for the profile filter
     // we support both names.
@@ -37,6 +37,7 @@
 #include "mongo/db/commands.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/operation_cpu_timer.h"
 #include "mongo/db/profile_filter.h"
 #include "mongo/db/server_options.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
@@ -44,6 +45,7 @@
 #include "mongo/logv2/attribute_storage.h"
 #include "mongo/logv2/log_component.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/progress_meter.h"
 #include "mongo/util/time_support.h"
 
@@ -264,6 +266,12 @@ public:
     // Used to track the amount of time spent waiting for a response from remote operations.
     boost::optional<Microseconds> remoteOpWaitTime;
 
+    // The CPU time consumed by the thread running the operation, if the platform can measure it.
+    boost::optional<Nanoseconds> cpuTime;
+
+    // The time spent waiting for a ticket to take the global lock.
+    Microseconds ticketWaitTime{0};
+
     // Stores additive metrics.
     AdditiveMetrics additiveMetrics;
 
@@ -752,6 +760,11 @@ private:
     class CurOpStack;
 
     TickSource::Tick startTime();
+
+    /**
+     * Returns the CPU time consumed by the thread which started this CurOp since it started.
+     */
+    boost::optional<Nanoseconds> _getCPUTime() const;
     Microseconds computeElapsedTimeTotal(TickSource::Tick startTime,
                                          TickSource::Tick endTime) const;
 
@@ -787,6 +800,15 @@ private:
     // The cumulative duration for which the timer has been paused.
     Microseconds _totalPausedDuration{0};
 
+    // The CPU clock of the thread which started this CurOp, and its reading at the start. These
+    // are set before '_start', so other threads may read them once '_start' is set.
+    boost::optional<ThreadCPUClock> _cpuClock;
+    Nanoseconds _cpuTimeAtStart{0};
+    stdx::thread::id _startThreadId;
+
+    // The ticket wait time of the operation's Locker when this CurOp was started.
+    Microseconds _ticketWaitTimeAtStart{0};
+
     // The elapsedTimeTotal() value at which the remoteOpWait timer was started, or empty if the
     // remoteOpWait timer is not currently running.
     boost::optional<Microseconds> _remoteOpStartTime;
@@ -47,4 +47,8 @@ Milliseconds getDefaultCursorTimeoutMillis() {
     return Milliseconds(kCursorTimeoutMillisDefault);
 }
 
+int getCursorReadAheadMaxBytes() {
+    return gCursorReadAheadMaxBytes.load();
+}
+
 }  // namespace mongo
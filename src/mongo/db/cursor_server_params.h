@@ -41,4 +41,8 @@ long long getCursorTimeoutMillis();
 
 Milliseconds getDefaultCursorTimeoutMillis();
 
+// Maximum size of the documents read ahead of the next getMore on a cursor, or zero if cursors are
+// not read ahead. Configurable with server parameter "cursorReadAheadMaxBytes".
+int getCursorReadAheadMaxBytes();
+
 }  // namespace mongo
@@ -55,17 +55,21 @@ const size_t AndHashStage::kLookAheadWorks = 10;
 // static
 const char* AndHashStage::kStageType = "AND_HASH";
 
-AndHashStage::AndHashStage(ExpressionContext* expCtx, WorkingSet* ws)
+AndHashStage::AndHashStage(ExpressionContext* expCtx, WorkingSet* ws, bool recordIdOnly)
     : PlanStage(kStageType, expCtx),
       _ws(ws),
+      _recordIdOnly(recordIdOnly),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
-      _maxMemUsage(kDefaultMaxMemUsageBytes) {}
+      _maxMemUsage(kDefaultMaxMemUsageBytes) {
+    _specificStats.recordIdOnly = _recordIdOnly;
+}
 
 AndHashStage::AndHashStage(ExpressionContext* expCtx, WorkingSet* ws, size_t maxMemUsage)
     : PlanStage(kStageType, expCtx),
       _ws(ws),
+      _recordIdOnly(false),
       _hashingChildren(true),
       _currentChild(0),
       _memUsage(0),
@@ -203,6 +207,10 @@ PlanStage::StageState AndHashStage::doWork(WorkingSetID* out) {
         // Child's output wasn't in every previous child.  Throw it out.
         _ws->free(*out);
         return PlanStage::NEED_TIME;
+    } else if (_recordIdOnly) {
+        // Child's output was in every previous child, and nothing needs to be merged into it.
+        _dataMap.erase(it);
+        return PlanStage::ADVANCED;
     } else {
         // Child's output was in every previous child.  Merge any key data in
         // the child's output and free the child's just-outputted WSM.
@@ -241,6 +249,14 @@ PlanStage::StageState AndHashStage::readFirstChild(WorkingSetID* out) {
         // with no record id.
         invariant(member->hasRecordId());
 
+        if (_recordIdOnly) {
+            if (_dataMap.insert(std::make_pair(member->recordId, WorkingSet::INVALID_ID)).second) {
+                _memUsage += sizeof(RecordId) + sizeof(WorkingSetID);
+            }
+            _ws->free(id);
+            return PlanStage::NEED_TIME;
+        }
+
         if (!_dataMap.insert(std::make_pair(member->recordId, id)).second) {
             // Didn't insert because we already had this RecordId inside the map. This should only
             // happen if we're seeing a newer copy of the same doc in a more recent snapshot.
@@ -294,6 +310,8 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
 
         if (_dataMap.end() == _dataMap.find(member->recordId)) {
             // Ignore.  It's not in any previous child.
+        } else if (_recordIdOnly) {
+            _seenMap.insert(member->recordId);
         } else {
             // We have a hit.  Copy data into the WSM we already have.
             _seenMap.insert(member->recordId);
@@ -320,10 +338,14 @@ PlanStage::StageState AndHashStage::hashOtherChildren(WorkingSetID* out) {
                 ++it;
 
                 // Update memory stats.
-                WorkingSetMember* member = _ws->get(toErase->second);
-                _memUsage -= member->getMemUsage();
+                if (_recordIdOnly) {
+                    _memUsage -= sizeof(RecordId) + sizeof(WorkingSetID);
+                } else {
+                    WorkingSetMember* member = _ws->get(toErase->second);
+                    _memUsage -= member->getMemUsage();
+                    _ws->free(toErase->second);
+                }
 
-                _ws->free(toErase->second);
                 _dataMap.erase(toErase);
             } else {
                 ++it;
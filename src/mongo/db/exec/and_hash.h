@@ -44,11 +44,15 @@ namespace mongo {
  * Reads from N children, each of which must have a valid RecordId. Uses a hash table to intersect
  * the outputs of the N children based on their record ids, and outputs the intersection.
  *
+ * If 'recordIdOnly' is true, the hash table holds only the RecordIds of the children's results,
+ * and the output is the result of the last child as is, without the index keys of the other
+ * children merged in. The planner uses this when the intersection is fetched right away.
+ *
  * Preconditions: Valid RecordId. More than one child.
  */
 class AndHashStage final : public PlanStage {
 public:
-    AndHashStage(ExpressionContext* expCtx, WorkingSet* ws);
+    AndHashStage(ExpressionContext* expCtx, WorkingSet* ws, bool recordIdOnly = false);
 
     /**
      * For testing only. Allows tests to set memory usage threshold.
@@ -86,6 +90,10 @@ private:
     // Not owned by us.
     WorkingSet* _ws;
 
+    // True if '_dataMap' maps to WorkingSet::INVALID_ID, since the results of the children
+    // other than the last one are freed as soon as their RecordIds are recorded.
+    const bool _recordIdOnly;
+
     // We want to see if any of our children are EOF immediately.  This requires working them a
     // few times to see if they hit EOF or if they produce a result.  If they produce a result,
     // we place that result here.
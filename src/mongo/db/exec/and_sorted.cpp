@@ -45,12 +45,15 @@ using std::vector;
 // static
 const char* AndSortedStage::kStageType = "AND_SORTED";
 
-AndSortedStage::AndSortedStage(ExpressionContext* expCtx, WorkingSet* ws)
+AndSortedStage::AndSortedStage(ExpressionContext* expCtx, WorkingSet* ws, bool recordIdOnly)
     : PlanStage(kStageType, expCtx),
       _ws(ws),
+      _recordIdOnly(recordIdOnly),
       _targetNode(numeric_limits<size_t>::max()),
       _targetId(WorkingSet::INVALID_ID),
-      _isEOF(false) {}
+      _isEOF(false) {
+    _specificStats.recordIdOnly = _recordIdOnly;
+}
 
 
 void AndSortedStage::addChild(std::unique_ptr<PlanStage> child) {
@@ -148,7 +151,9 @@ PlanStage::StageState AndSortedStage::moveTowardTargetRecordId(WorkingSetID* out
             // The front element has hit _targetRecordId.  Don't move it forward anymore/work on
             // another element.
             _workingTowardRep.pop();
-            AndCommon::mergeFrom(_ws, _targetId, *member);
+            if (!_recordIdOnly) {
+                AndCommon::mergeFrom(_ws, _targetId, *member);
+            }
             _ws->free(id);
 
             if (0 == _workingTowardRep.size()) {
@@ -43,11 +43,15 @@ namespace mongo {
  * Reads from N children, each of which must have a valid RecordId. Assumes each child produces
  * RecordIds in sorted order. Outputs the intersection of the RecordIds outputted by the children.
  *
+ * If 'recordIdOnly' is true, the output is the result of the child which first produced each
+ * RecordId, without the index keys of the other children merged in. The planner uses this when the
+ * intersection is fetched right away.
+ *
  * Preconditions: Valid RecordId. More than one child.
  */
 class AndSortedStage final : public PlanStage {
 public:
-    AndSortedStage(ExpressionContext* expCtx, WorkingSet* ws);
+    AndSortedStage(ExpressionContext* expCtx, WorkingSet* ws, bool recordIdOnly = false);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -75,6 +79,9 @@ private:
     // Not owned by us.
     WorkingSet* _ws;
 
+    // Whether to skip merging the children's index keys into the output.
+    const bool _recordIdOnly;
+
     // The current node we're AND-ing against.
     size_t _targetNode;
     RecordId _targetRecordId;
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/timeseries/timeseries_field_names.h"
 
 namespace mongo {
@@ -87,6 +88,7 @@ int BucketUnpacker::computeMeasurementCount(int targetTimestampObjSize) {
 
 void BucketUnpacker::reset(BSONObj&& bucket) {
     _fieldIters.clear();
+    _decompressedColumns.clear();
     _timeFieldIter = boost::none;
 
     _bucket = std::move(bucket);
@@ -104,7 +106,8 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
             "The $_internalUnpackBucket stage requires the data region to have a timeField object",
             timeFieldElem);
 
-    _timeFieldIter = BSONObjIterator{timeFieldElem.Obj()};
+    auto timeColumn = getColumn(timeFieldElem);
+    _timeFieldIter = BSONObjIterator{timeColumn};
 
     _metaValue = _bucket[timeseries::kBucketMetaFieldName];
     if (_spec.metaField) {
@@ -137,7 +140,7 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
         // Includes a field when '_unpackerBehavior' is 'kInclude' and it's found in 'fieldSet' or
         // _unpackerBehavior is 'kExclude' and it's not found in 'fieldSet'.
         if (determineIncludeField(colName, _unpackerBehavior, _spec)) {
-            _fieldIters.emplace_back(colName.toString(), BSONObjIterator{elem.Obj()});
+            _fieldIters.emplace_back(colName.toString(), BSONObjIterator{getColumn(elem)});
         }
     }
 
@@ -149,7 +152,20 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
     }
 
     // Save the measurement count for the bucket.
-    _numberOfMeasurements = computeMeasurementCount(timeFieldElem.objsize());
+    _numberOfMeasurements = computeMeasurementCount(timeColumn.objsize());
+}
+
+BSONObj BucketUnpacker::getColumn(const BSONElement& column) {
+    if (!timeseries::isCompressedColumn(column)) {
+        return column.Obj();
+    }
+
+    auto colName = column.fieldNameStringData().toString();
+    auto it = _decompressedColumns.find(colName);
+    if (it == _decompressedColumns.end()) {
+        it = _decompressedColumns.emplace(colName, timeseries::decompressColumn(column)).first;
+    }
+    return it->second;
 }
 
 void BucketUnpacker::setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior) {
@@ -230,7 +246,7 @@ Document BucketUnpacker::extractSingleMeasurement(int j) {
         if (!determineIncludeField(colName, _unpackerBehavior, _spec)) {
             continue;
         }
-        auto value = dataElem[targetIdx];
+        auto value = getColumn(dataElem)[targetIdx];
         if (value) {
             measurement.addField(dataElem.fieldNameStringData(), Value{value});
         }
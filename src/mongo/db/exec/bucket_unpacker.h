@@ -145,6 +145,13 @@ public:
     void addComputedMetaProjFields(const std::vector<StringData>& computedFieldNames);
 
 private:
+    /**
+     * Returns the data column 'column' of the bucket being unpacked, decompressing it first if it
+     * is in the compressed format. Decompressed columns are kept in '_decompressedColumns' until
+     * the next reset(), so that the returned object can be iterated for as long as the bucket.
+     */
+    BSONObj getColumn(const BSONElement& column);
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
@@ -169,6 +176,10 @@ private:
     // phase according to the provided 'Behavior' and 'BucketSpec'.
     std::vector<std::pair<std::string, BSONObjIterator>> _fieldIters;
 
+    // The decompressed versions of the compressed columns of the above bucket accessed so far,
+    // keyed by column name. Cleared upon reset().
+    stdx::unordered_map<std::string, BSONObj> _decompressedColumns;
+
     // Map <name, BSONElement> for the computed meta field projections. Updated for
     // every bucket upon reset().
     stdx::unordered_map<std::string, BSONElement> _computedMetaProjections;
@@ -32,6 +32,7 @@
 #include "mongo/bson/json.h"
 #include "mongo/db/exec/bucket_unpacker.h"
 #include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -124,6 +125,29 @@ TEST_F(BucketUnpackerTest, ExcludeASingleField) {
     ASSERT_FALSE(unpacker.hasNext());
 }
 
+TEST_F(BucketUnpackerTest, UnpackCompressedBucket) {
+    std::set<std::string> fields{"b"};
+
+    auto bucket = timeseries::compressBucket(fromjson(
+        "{meta: {'m1': 999, 'm2': 9999}, data: {_id: {'0':1, '1':2}, time: {'0':1, '1':2}, "
+        "a:{'0':'x', '1':'x'}, b:{'1':1}}}"));
+    ASSERT(timeseries::isCompressedColumn(bucket["data"]["time"]));
+
+    auto unpacker = makeBucketUnpacker(std::move(fields),
+                                       BucketUnpacker::Behavior::kExclude,
+                                       std::move(bucket),
+                                       kUserDefinedMetaName.toString());
+
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{time: 1, myMeta: {m1: 999, m2: 9999}, _id: 1, a: 'x'}")});
+
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker,
+                  Document{fromjson("{time: 2, myMeta: {m1: 999, m2: 9999}, _id: 2, a: 'x'}")});
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
 TEST_F(BucketUnpackerTest, EmptyIncludeGetsEmptyMeasurements) {
     std::set<std::string> fields{};
 
@@ -40,8 +40,10 @@
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/scoped_timer.h"
+#include "mongo/db/exec/shared_oplog_scan_buffer.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/repl/optime.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
@@ -54,6 +56,17 @@ using std::vector;
 // static
 const char* CollectionScan::kStageType = "COLLSCAN";
 
+namespace {
+
+// The number of entries a scan copies out of the SharedOplogScanBuffer at a time.
+constexpr size_t kSharedOplogScanBatchSize = 100;
+
+RecordId oplogRecordIdFor(Timestamp ts) {
+    return RecordId(static_cast<int64_t>(ts.asULL()));
+}
+
+}  // namespace
+
 CollectionScan::CollectionScan(ExpressionContext* expCtx,
                                const CollectionPtr& collection,
                                const CollectionScanParams& params,
@@ -62,6 +75,7 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _workingSet(workingSet),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
+      _compiledFilter(SbeCompiledFilter::compile(expCtx, _filter)),
       _params(params) {
     // Explain reports the direction of the collection scan.
     _specificStats.direction = params.direction;
@@ -95,6 +109,10 @@ CollectionScan::CollectionScan(ExpressionContext* expCtx,
         // only support in the forward direction.
         invariant(params.direction == CollectionScanParams::FORWARD);
     }
+
+    _useSharedOplogScanBuffer = params.tailable &&
+        params.direction == CollectionScanParams::FORWARD && collection->ns().isOplog() &&
+        internalQuerySharedOplogScanBufferMaxBytes.load() > 0;
 }
 
 PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
@@ -102,7 +120,16 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (auto entry = nextSharedOplogEntry()) {
+        // The cursor, if any, is still positioned at an earlier entry. Dropping it makes the next
+        // read from the storage engine seek to '_lastSeenId' first, exactly as when tailing.
+        _cursor.reset();
+        _lastSeenId = entry->id;
+        return returnRecord(entry->id, std::move(entry->obj), out);
+    }
+
     boost::optional<Record> record;
+    bool seekedToStart = false;
     const bool needToMakeCursor = !_cursor;
     try {
         if (needToMakeCursor) {
@@ -170,6 +197,7 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
             _params.minRecord) {
             // Seek to the approximate start location.
             record = _cursor->seekNear(*_params.minRecord);
+            seekedToStart = true;
         }
 
         if (_lastSeenId.isNull() && _params.direction == CollectionScanParams::BACKWARD &&
@@ -200,29 +228,88 @@ PlanStage::StageState CollectionScan::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    // Unless we just sought to the start of the scan, the previous record we returned is the one
+    // that precedes this record in the collection.
+    const RecordId prevId = seekedToStart ? RecordId() : _lastSeenId;
     _lastSeenId = record->id;
     if (_params.assertTsHasNotFallenOffOplog) {
         assertTsHasNotFallenOffOplog(*record);
     }
+
+    BSONObj obj = record->data.releaseToBson();
+    if (_useSharedOplogScanBuffer &&
+        opCtx()->recoveryUnit()->getTimestampReadSource() ==
+            RecoveryUnit::ReadSource::kMajorityCommitted) {
+        // A majority snapshot sees every oplog entry up to its timestamp, and none of them can roll
+        // back, so this entry can be handed to the other scans of the oplog.
+        obj = obj.getOwned();
+        SharedOplogScanBuffer::get(opCtx()->getServiceContext())
+            .append(collection()->uuid(), prevId, record->id, obj);
+    }
+
+    return returnRecord(record->id, std::move(obj), out);
+}
+
+boost::optional<SharedOplogScanBuffer::Entry> CollectionScan::nextSharedOplogEntry() {
+    if (!_useSharedOplogScanBuffer || _lastSeenId.isNull()) {
+        return boost::none;
+    }
+
+    if (_sharedOplogEntries.empty()) {
+        // Only take entries that this scan's own snapshot would see. Once '_lastSeenId' has been
+        // truncated from the oplog, go back to the storage engine so that the scan fails with
+        // CappedPositionLost, as it would have without the buffer.
+        auto recoveryUnit = opCtx()->recoveryUnit();
+        if (recoveryUnit->getTimestampReadSource() !=
+            RecoveryUnit::ReadSource::kMajorityCommitted) {
+            return boost::none;
+        }
+        const auto readTimestamp = recoveryUnit->getPointInTimeReadTimestamp(opCtx());
+        const auto earliestTimestamp =
+            collection()->getRecordStore()->getEarliestOplogTimestamp(opCtx());
+        if (!readTimestamp || !earliestTimestamp.isOK() ||
+            _lastSeenId < oplogRecordIdFor(earliestTimestamp.getValue())) {
+            return boost::none;
+        }
+
+        SharedOplogScanBuffer::get(opCtx()->getServiceContext())
+            .readAfter(collection()->uuid(),
+                       _lastSeenId,
+                       oplogRecordIdFor(*readTimestamp),
+                       kSharedOplogScanBatchSize,
+                       &_sharedOplogEntries);
+        if (_sharedOplogEntries.empty()) {
+            return boost::none;
+        }
+    }
+
+    auto entry = std::move(_sharedOplogEntries.front());
+    _sharedOplogEntries.pop_front();
+    return entry;
+}
+
+PlanStage::StageState CollectionScan::returnRecord(const RecordId& recordId,
+                                                   BSONObj obj,
+                                                   WorkingSetID* out) {
     if (_params.shouldTrackLatestOplogTimestamp) {
-        setLatestOplogEntryTimestamp(*record);
+        setLatestOplogEntryTimestamp(obj);
     }
 
     WorkingSetID id = _workingSet->allocate();
     WorkingSetMember* member = _workingSet->get(id);
-    member->recordId = record->id;
-    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), record->data.releaseToBson());
+    member->recordId = recordId;
+    member->resetDocument(opCtx()->recoveryUnit()->getSnapshotId(), std::move(obj));
     _workingSet->transitionToRecordIdAndObj(id);
 
     return returnIfMatches(member, id, out);
 }
 
-void CollectionScan::setLatestOplogEntryTimestamp(const Record& record) {
-    auto tsElem = record.data.toBson()[repl::OpTime::kTimestampFieldName];
+void CollectionScan::setLatestOplogEntryTimestamp(const BSONObj& obj) {
+    auto tsElem = obj[repl::OpTime::kTimestampFieldName];
     uassert(ErrorCodes::Error(4382100),
             str::stream() << "CollectionScan was asked to track latest operation time, "
                              "but found a result without a valid 'ts' field: "
-                          << record.data.toBson().toString(),
+                          << obj.toString(),
             tsElem.type() == BSONType::bsonTimestamp);
     LOGV2_DEBUG(550450,
                 5,
@@ -275,9 +362,10 @@ PlanStage::StageState CollectionScan::returnIfMatches(WorkingSetMember* member,
         return PlanStage::IS_EOF;
     }
 
-    if (Filter::passes(member, _filter)) {
+    if (_compiledFilter ? _compiledFilter->passes(member) : Filter::passes(member, _filter)) {
         if (_params.stopApplyingFilterAfterFirstMatch) {
             _filter = nullptr;
+            _compiledFilter.reset();
         }
         *out = memberID;
         return PlanStage::ADVANCED;
@@ -295,6 +383,8 @@ void CollectionScan::doSaveStateRequiresCollection() {
     if (_cursor) {
         _cursor->save();
     }
+    // Make the scan check again that '_lastSeenId' is still in the oplog once it is restored.
+    _sharedOplogEntries.clear();
 }
 
 void CollectionScan::doRestoreStateRequiresCollection() {
@@ -311,11 +401,15 @@ void CollectionScan::doRestoreStateRequiresCollection() {
 void CollectionScan::doDetachFromOperationContext() {
     if (_cursor)
         _cursor->detachFromOperationContext();
+    if (_compiledFilter)
+        _compiledFilter->detachFromOperationContext();
 }
 
 void CollectionScan::doReattachToOperationContext() {
     if (_cursor)
         _cursor->reattachToOperationContext(opCtx());
+    if (_compiledFilter)
+        _compiledFilter->reattachToOperationContext(opCtx());
 }
 
 unique_ptr<PlanStageStats> CollectionScan::getStats() {
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 
 #include "mongo/db/exec/collection_scan_common.h"
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/sbe_compiled_filter.h"
+#include "mongo/db/exec/shared_oplog_scan_buffer.h"
 #include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/record_id.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -106,11 +109,23 @@ private:
     StageState returnIfMatches(WorkingSetMember* member, WorkingSetID memberID, WorkingSetID* out);
 
     /**
-     * Extracts the timestamp from the 'ts' field of 'record', and sets '_latestOplogEntryTimestamp'
+     * Places the record 'obj' with id 'recordId' in a new WorkingSetMember and returns it through
+     * returnIfMatches().
+     */
+    StageState returnRecord(const RecordId& recordId, BSONObj obj, WorkingSetID* out);
+
+    /**
+     * Returns the oplog entry following '_lastSeenId' if this scan can take it from the
+     * SharedOplogScanBuffer rather than from its cursor.
+     */
+    boost::optional<SharedOplogScanBuffer::Entry> nextSharedOplogEntry();
+
+    /**
+     * Extracts the timestamp from the 'ts' field of 'obj', and sets '_latestOplogEntryTimestamp'
      * to that time if it isn't already greater. Throws an exception if the 'ts' field cannot be
      * extracted.
      */
-    void setLatestOplogEntryTimestamp(const Record& record);
+    void setLatestOplogEntryTimestamp(const BSONObj& obj);
 
     /**
      * Asserts that the minimum timestamp in the query filter has not already fallen off the oplog.
@@ -123,6 +138,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Set when the filter is evaluated with an SBE plan compiled from it.
+    std::unique_ptr<SbeCompiledFilter> _compiledFilter;
+
     std::unique_ptr<SeekableRecordCursor> _cursor;
 
     CollectionScanParams _params;
@@ -133,6 +151,13 @@ private:
     // timestamp seen in the collection.  Otherwise, this is a null timestamp.
     Timestamp _latestOplogEntryTimestamp;
 
+    // Whether this is a tailable scan of the oplog which shares the entries it reads with other
+    // such scans through the SharedOplogScanBuffer.
+    bool _useSharedOplogScanBuffer = false;
+
+    // Entries copied from the SharedOplogScanBuffer which follow '_lastSeenId', in order.
+    std::deque<SharedOplogScanBuffer::Entry> _sharedOplogEntries;
+
     // Stats
     CollectionScanStats _specificStats;
 };
@@ -78,6 +78,9 @@ DeleteStage::DeleteStage(ExpressionContext* expCtx,
       _ws(ws),
       _idRetrying(WorkingSet::INVALID_ID),
       _idReturning(WorkingSet::INVALID_ID) {
+    invariant(_params->batchSize >= 1);
+    invariant(_params->batchSize == 1 ||
+              (_params->isMulti && !_params->returnDeleted && !_params->removeSaver));
     _children.emplace_back(child);
 }
 
@@ -85,8 +88,11 @@ bool DeleteStage::isEOF() {
     if (!_params->isMulti && _specificStats.docsDeleted > 0) {
         return true;
     }
+    if (_stopped) {
+        return true;
+    }
     return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
-        child()->isEOF();
+        _batch.empty() && child()->isEOF();
 }
 
 PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
@@ -94,6 +100,10 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
         return PlanStage::IS_EOF;
     }
 
+    if (_params->batchSize > 1) {
+        return doBatchedWork(out);
+    }
+
     // It is possible that after a delete was executed, a WriteConflictException occurred
     // and prevented us from returning ADVANCED with the old version of the document.
     if (_idReturning != WorkingSet::INVALID_ID) {
@@ -250,6 +260,140 @@ PlanStage::StageState DeleteStage::doWork(WorkingSetID* out) {
     return PlanStage::NEED_TIME;
 }
 
+PlanStage::StageState DeleteStage::doBatchedWork(WorkingSetID* out) {
+    if (!_batchFull) {
+        WorkingSetID id;
+        auto status = child()->work(&id);
+
+        switch (status) {
+            case PlanStage::ADVANCED:
+                break;
+
+            case PlanStage::NEED_TIME:
+                return status;
+
+            case PlanStage::NEED_YIELD:
+                *out = id;
+                return status;
+
+            case PlanStage::IS_EOF:
+                if (_batch.empty()) {
+                    return status;
+                }
+                _batchFull = true;
+                break;
+
+            default:
+                MONGO_UNREACHABLE;
+        }
+
+        if (status == PlanStage::ADVANCED) {
+            WorkingSetMember* member = _ws->get(id);
+            invariant(member->hasRecordId());
+            invariant(member->hasObj());
+
+            // The document may only be deleted after a yield, which is allowed to free the memory
+            // of the BSONObj.
+            member->makeObjOwnedIfNeeded();
+            _batch.push_back(id);
+            _batchFull = _batch.size() >= _params->batchSize;
+        }
+
+        if (!_batchFull) {
+            return PlanStage::NEED_TIME;
+        }
+    }
+
+    return deleteBatch(out);
+}
+
+PlanStage::StageState DeleteStage::deleteBatch(WorkingSetID* out) {
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    try {
+        if (_params->isExplain) {
+            for (; _batchPosition < _batch.size(); ++_batchPosition) {
+                if (write_stage_common::ensureStillMatches(collection(),
+                                                           opCtx(),
+                                                           _ws,
+                                                           _batch[_batchPosition],
+                                                           _params->canonicalQuery)) {
+                    ++_specificStats.docsDeleted;
+                }
+            }
+        } else if (repl::ReplicationCoordinator::get(opCtx())->isOplogDisabledFor(
+                       opCtx(), collection()->ns())) {
+            size_t numDeleted = 0;
+            WriteUnitOfWork wunit(opCtx());
+            for (auto id : _batch) {
+                numDeleted += deleteBatchMember(id);
+            }
+            wunit.commit();
+            _specificStats.docsDeleted += numDeleted;
+            _batchPosition = _batch.size();
+        } else {
+            for (; _batchPosition < _batch.size(); ++_batchPosition) {
+                WriteUnitOfWork wunit(opCtx());
+                const bool deleted = deleteBatchMember(_batch[_batchPosition]);
+                wunit.commit();
+                _specificStats.docsDeleted += deleted;
+            }
+        }
+    } catch (const WriteConflictException&) {
+        // Retry the documents of the batch not yet deleted after yielding.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    for (auto id : _batch) {
+        _ws->free(id);
+    }
+    _batch.clear();
+    _batchPosition = 0;
+    _batchFull = false;
+
+    if (_params->continueAfterBatch &&
+        !_params->continueAfterBatch(_specificStats.docsDeleted)) {
+        _stopped = true;
+    }
+
+    // As restoreState may restore (recreate) cursors, make sure to restore the state outside of
+    // the WriteUnitOfWork.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        // The batch was already committed, so there is nothing to retry.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    return PlanStage::NEED_TIME;
+}
+
+bool DeleteStage::deleteBatchMember(WorkingSetID id) {
+    if (!write_stage_common::ensureStillMatches(
+            collection(), opCtx(), _ws, id, _params->canonicalQuery)) {
+        return false;
+    }
+
+    WorkingSetMember* member = _ws->get(id);
+    Snapshotted<Document> memberDoc = member->doc;
+    BSONObj bsonObjDoc = memberDoc.value().toBson();
+    collection()->deleteDocument(opCtx(),
+                                 Snapshotted(memberDoc.snapshotId(), bsonObjDoc),
+                                 _params->stmtId,
+                                 member->recordId,
+                                 _params->opDebug,
+                                 _params->fromMigrate,
+                                 false,
+                                 Collection::StoreDeletedDoc::Off);
+    return true;
+}
+
 void DeleteStage::doRestoreStateRequiresCollection() {
     const NamespaceString& ns = collection()->ns();
     uassert(ErrorCodes::PrimarySteppedDown,
@@ -29,6 +29,9 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/logical_session_id.h"
@@ -84,6 +87,17 @@ struct DeleteStageParams {
     // reaches the removeSaver. However, this is still best effort since the RemoveSaver
     // operates on a different persistence system from the the database storage engine.
     std::unique_ptr<RemoveSaver> removeSaver;
+
+    // The number of documents to delete together, which must be 1 when the deleted documents are
+    // returned or saved with 'removeSaver'. A batch saves and restores the state of the child
+    // stage once rather than once per document. It is deleted in a single storage transaction
+    // when the deletes are not written to the oplog, and in one storage transaction per document
+    // otherwise, as each oplog entry needs a storage transaction of its own timestamp.
+    size_t batchSize = 1;
+
+    // Optional. Called after each batch is deleted with the number of documents deleted so far.
+    // The delete stops once it returns false.
+    std::function<bool(size_t)> continueAfterBatch;
 };
 
 /**
@@ -130,6 +144,24 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Adds the documents returned by the child to '_batch' and deletes them once the batch is
+     * full or the child is done. Used when the batch size is greater than 1.
+     */
+    StageState doBatchedWork(WorkingSetID* out);
+
+    /**
+     * Deletes the documents of '_batch' which still exist and match the predicate. Returns
+     * NEED_YIELD, with the batch left to retry, on a write conflict.
+     */
+    StageState deleteBatch(WorkingSetID* out);
+
+    /**
+     * Deletes the document of the batch member 'id' if it still exists and matches the predicate,
+     * in the current WriteUnitOfWork. Returns whether it was deleted.
+     */
+    bool deleteBatchMember(WorkingSetID id);
+
     std::unique_ptr<DeleteStageParams> _params;
 
     // Not owned by us.
@@ -141,6 +173,16 @@ private:
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
+    // The members waiting to be deleted together, and the number of them already deleted when
+    // they are deleted in a storage transaction each. Once '_batchFull' is set, the batch is
+    // deleted before anything more is asked of the child.
+    std::vector<WorkingSetID> _batch;
+    size_t _batchPosition = 0;
+    bool _batchFull = false;
+
+    // Set when 'continueAfterBatch' asks the delete to stop.
+    bool _stopped = false;
+
     // Stats
     DeleteStats _specificStats;
 };
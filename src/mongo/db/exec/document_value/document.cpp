@@ -31,19 +31,97 @@
 
 #include "mongo/db/exec/document_value/document.h"
 
+#include <array>
 #include <boost/functional/hash.hpp>
 
 #include "mongo/bson/bson_depth.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/resume_token.h"
+#include "mongo/platform/bits.h"
 #include "mongo/util/str.h"
 
+#if !defined(__has_feature)
+#define __has_feature(x) 0
+#endif
+
 namespace mongo {
 using boost::intrusive_ptr;
 using std::string;
 using std::vector;
 
+namespace {
+
+/**
+ * The field buffers of DocumentStorage released on a thread, by size, so that the next documents
+ * built on that thread can reuse them instead of going through the allocator. Documents passed
+ * between pipeline stages are mostly short-lived and of similar shapes, so most of their buffers
+ * come from here. Only the power-of-two sizes that alloc() produces, up to 'kMaxBufferBytes', are
+ * kept, and at most 'kMaxBuffersPerSize' of each.
+ *
+ * This is trivially destructible so that it can still be used, as a pass-through, by documents
+ * destroyed on a thread after its FieldBufferCacheReaper.
+ */
+struct FieldBufferCache {
+    static constexpr size_t kMinBufferBytes = 128;
+    static constexpr size_t kMaxBufferBytes = 8 * 1024;
+    static constexpr int kNumSizes = 7;  // 128 to 8192 bytes.
+    static constexpr size_t kMaxBuffersPerSize = 32;
+
+    static int getSizeIndex(size_t bytes) {
+        if (bytes < kMinBufferBytes || bytes > kMaxBufferBytes || (bytes & (bytes - 1))) {
+            return -1;
+        }
+        return countTrailingZeros64(bytes) - countTrailingZeros64(kMinBufferBytes);
+    }
+
+    std::array<std::array<char*, kMaxBuffersPerSize>, kNumSizes> buffers;
+    std::array<size_t, kNumSizes> numBuffers;
+    bool shutDown;
+};
+
+thread_local FieldBufferCache fieldBufferCache{};
+
+/**
+ * Frees the buffers cached by a thread when it exits.
+ */
+struct FieldBufferCacheReaper {
+    ~FieldBufferCacheReaper() {
+        for (int idx = 0; idx < FieldBufferCache::kNumSizes; ++idx) {
+            for (size_t pos = 0; pos < fieldBufferCache.numBuffers[idx]; ++pos) {
+                delete[] fieldBufferCache.buffers[idx][pos];
+            }
+            fieldBufferCache.numBuffers[idx] = 0;
+        }
+        fieldBufferCache.shutDown = true;
+    }
+};
+
+thread_local FieldBufferCacheReaper fieldBufferCacheReaper;
+
+char* allocateFieldBuffer(size_t bytes) {
+    const int idx = FieldBufferCache::getSizeIndex(bytes);
+    if (idx >= 0 && fieldBufferCache.numBuffers[idx] > 0) {
+        return fieldBufferCache.buffers[idx][--fieldBufferCache.numBuffers[idx]];
+    }
+    return new char[bytes];
+}
+
+void releaseFieldBuffer(char* buffer, size_t bytes) {
+    // Under ASAN, freeing every buffer keeps use-after-free detectable.
+    const int idx = __has_feature(address_sanitizer) ? -1 : FieldBufferCache::getSizeIndex(bytes);
+    if (idx >= 0 && !fieldBufferCache.shutDown &&
+        fieldBufferCache.numBuffers[idx] < FieldBufferCache::kMaxBuffersPerSize) {
+        // Make sure that the thread frees its cached buffers when it exits.
+        (void)&fieldBufferCacheReaper;
+        fieldBufferCache.buffers[idx][fieldBufferCache.numBuffers[idx]++] = buffer;
+        return;
+    }
+    delete[] buffer;
+}
+
+}  // namespace
+
 const DocumentStorage DocumentStorage::kEmptyDoc;
 
 const StringDataSet Document::allMetadataFieldNames{Document::metaFieldTextScore,
@@ -127,12 +205,12 @@ bool DocumentStorageIterator::shouldSkipDeleted() {
     return false;
 }
 
-Position DocumentStorage::findFieldInCache(StringData requested) const {
+Position DocumentStorage::findFieldInCache(StringData requested,
+                                           boost::optional<unsigned> hash) const {
     int reqSize = requested.size();  // get size calculation out of the way if needed
 
     if (_numFields >= HASH_TAB_MIN) {  // hash lookup
-        const unsigned hash = hashKey(requested);
-        const unsigned bucket = hash & _hashTabMask;
+        const unsigned bucket = (hash ? *hash : hashKey(requested)) & _hashTabMask;
 
         Position pos = _hashTab[bucket];
         while (pos.found()) {
@@ -156,19 +234,80 @@ Position DocumentStorage::findFieldInCache(StringData requested) const {
     return Position();
 }
 
-Position DocumentStorage::findField(StringData requested, LookupPolicy policy) const {
-    if (auto pos = findFieldInCache(requested); pos.found() || policy == LookupPolicy::kCacheOnly) {
+Position DocumentStorage::findField(StringData requested,
+                                    boost::optional<unsigned> hash,
+                                    LookupPolicy policy) const {
+    if (auto pos = findFieldInCache(requested, hash);
+        pos.found() || policy == LookupPolicy::kCacheOnly) {
         return pos;
     }
 
+    if (auto bsonElement = findFieldInBson(requested, hash); !bsonElement.eoo()) {
+        return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+    }
+
+    // if we got here, there's no such field
+    return Position();
+}
+
+BSONElement DocumentStorage::findFieldInBson(StringData requested,
+                                             boost::optional<unsigned> hash) const {
+    if (!_bsonFieldIndex.empty()) {
+        const unsigned mask = _bsonFieldIndex.size() - 1;
+        for (unsigned slot = (hash ? *hash : hashKey(requested)) & mask; _bsonFieldIndex[slot];
+             slot = (slot + 1) & mask) {
+            BSONElement elem(_bson.objdata() + _bsonFieldIndex[slot]);
+            if (requested == elem.fieldNameStringData()) {
+                return elem;
+            }
+        }
+        return BSONElement();
+    }
+
+    unsigned numWalked = 0;
+    BSONElement found;
     for (auto&& bsonElement : _bson) {
+        ++numWalked;
         if (requested == bsonElement.fieldNameStringData()) {
-            return const_cast<DocumentStorage*>(this)->constructInCache(bsonElement);
+            found = bsonElement;
+            break;
         }
     }
 
-    // if we got here, there's no such field
-    return Position();
+    if (numWalked >= BSON_INDEX_MIN_FIELDS && ++_numWideBsonScans >= BSON_INDEX_MIN_SCANS) {
+        buildBsonFieldIndex();
+    }
+    return found;
+}
+
+void DocumentStorage::buildBsonFieldIndex() const {
+    const unsigned numFields = _bson.nFields();
+
+    // Keep the load factor at or below one half.
+    unsigned numSlots = HASH_TAB_INIT_SIZE;
+    while (numSlots < numFields * 2) {
+        numSlots *= 2;
+    }
+    const unsigned mask = numSlots - 1;
+
+    _bsonFieldIndex.assign(numSlots, 0);
+    for (auto&& bsonElement : _bson) {
+        const auto fieldName = bsonElement.fieldNameStringData();
+        unsigned slot = hashKey(fieldName) & mask;
+        bool duplicate = false;
+        while (_bsonFieldIndex[slot]) {
+            // Like a walk of the object, lookups must find the first field with a given name.
+            if (fieldName ==
+                BSONElement(_bson.objdata() + _bsonFieldIndex[slot]).fieldNameStringData()) {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        if (!duplicate) {
+            _bsonFieldIndex[slot] = bsonElement.rawdata() - _bson.objdata();
+        }
+    }
 }
 
 Position DocumentStorage::constructInCache(const BSONElement& elem) {
@@ -242,6 +381,7 @@ void DocumentStorage::alloc(unsigned newSize) {
     const bool firstAlloc = !_cache;
     const bool doingRehash = needRehash();
     const size_t oldCapacity = _cacheEnd - _cache;
+    const size_t oldBufferBytes = allocatedBytes();
 
     // make new bucket count big enough
     while (needRehash() || hashTabBuckets() < HASH_TAB_INIT_SIZE)
@@ -254,13 +394,13 @@ void DocumentStorage::alloc(unsigned newSize) {
 
     uassert(16490, "Tried to make oversized document", capacity <= size_t(BufferMaxSize));
 
-    std::unique_ptr<char[]> oldBuf(_cache);
-    _cache = new char[capacity];
+    char* const oldBuf = _cache;
+    _cache = allocateFieldBuffer(capacity);
     _cacheEnd = _cache + capacity - hashTabBytes();
 
     if (!firstAlloc) {
         // This just copies the elements
-        memcpy(_cache, oldBuf.get(), _usedBytes);
+        memcpy(_cache, oldBuf, _usedBytes);
 
         if (_numFields >= HASH_TAB_MIN) {
             // if we were hashing, deal with the hash table
@@ -268,9 +408,10 @@ void DocumentStorage::alloc(unsigned newSize) {
                 rehash();
             } else {
                 // no rehash needed so just slide table down to new position
-                memcpy(_hashTab, oldBuf.get() + oldCapacity, hashTabBytes());
+                memcpy(_hashTab, oldBuf + oldCapacity, hashTabBytes());
             }
         }
+        releaseFieldBuffer(oldBuf, oldBufferBytes);
     }
 }
 
@@ -287,7 +428,7 @@ void DocumentStorage::reserveFields(size_t expectedFields) {
 
     uassert(16491, "Tried to make oversized document", newSize <= size_t(BufferMaxSize));
 
-    _cache = new char[newSize + hashTabBytes()];
+    _cache = allocateFieldBuffer(newSize + hashTabBytes());
     _cacheEnd = _cache + newSize;
 }
 
@@ -298,7 +439,7 @@ intrusive_ptr<DocumentStorage> DocumentStorage::clone() const {
         // Make a copy of the buffer with the fields.
         // It is very important that the positions of each field are the same after cloning.
         const size_t bufferBytes = allocatedBytes();
-        out->_cache = new char[bufferBytes];
+        out->_cache = allocateFieldBuffer(bufferBytes);
         out->_cacheEnd = out->_cache + (_cacheEnd - _cache);
         memcpy(out->_cache, _cache, bufferBytes);
 
@@ -330,24 +471,32 @@ size_t DocumentStorage::getMetadataApproximateSize() const {
 }
 
 DocumentStorage::~DocumentStorage() {
-    std::unique_ptr<char[]> deleteBufferAtScopeEnd(_cache);
-
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
+
+    if (_cache) {
+        releaseFieldBuffer(_cache, allocatedBytes());
+    }
 }
 
 void DocumentStorage::reset(const BSONObj& bson, bool stripMetadata) {
     _bson = bson;
+    _bsonFieldIndex.clear();
+    _numWideBsonScans = 0;
     _stripMetadata = stripMetadata;
     _modified = false;
 
-    // Clean cache.
+    // Clean cache, and give the buffer back since the size of the next one is not known yet.
     for (auto it = iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         it->val.~Value();  // explicit destructor call
     }
 
-    _cacheEnd = _cache;
+    if (_cache) {
+        releaseFieldBuffer(_cache, allocatedBytes());
+    }
+    _cache = nullptr;
+    _cacheEnd = nullptr;
     _usedBytes = 0;
     _numFields = 0;
     _hashTabMask = 0;
@@ -593,8 +742,7 @@ Document::getNestedFieldNonCachingHelper(const FieldPath& dottedField, size_t le
         return stdx::monostate{};
     }
 
-    StringData fieldName = dottedField.getFieldName(level);
-    auto bsonEltOrValue = _storage->getFieldNonCaching(fieldName);
+    auto bsonEltOrValue = _storage->getFieldNonCaching(dottedField.getFieldNameHashed(level));
 
     if (stdx::holds_alternative<BSONElement>(bsonEltOrValue)) {
         return getNestedFieldHelperBSON(
@@ -630,8 +778,7 @@ static Value getNestedFieldHelper(const Document& doc,
                                   const FieldPath& fieldNames,
                                   vector<Position>* positions,
                                   size_t level) {
-    const auto fieldName = fieldNames.getFieldName(level);
-    const Position pos = doc.positionOf(fieldName);
+    const Position pos = doc.positionOf(fieldNames.getFieldNameHashed(level));
 
     if (!pos.found())
         return Value();
@@ -661,6 +808,7 @@ size_t Document::getApproximateSize() const {
 
     size += sizeof(DocumentStorage);
     size += storage().allocatedBytes();
+    size += storage().bsonFieldIndexBytes();
 
     for (auto it = storage().iteratorCacheOnly(); !it.atEnd(); it.advance()) {
         size += it->val.getApproximateSize();
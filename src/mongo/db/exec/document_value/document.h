@@ -138,6 +138,14 @@ public:
         return storage().getField(key);
     }
 
+    /// Look up a field by key name and its precomputed hash, see FieldPath::getFieldNameHashed.
+    const Value operator[](FieldPath::HashedFieldName field) const {
+        return getField(field);
+    }
+    const Value getField(FieldPath::HashedFieldName field) const {
+        return storage().getField(field);
+    }
+
     /// Look up a field by Position. See positionOf and getNestedField.
     const Value operator[](Position pos) const {
         return getField(pos);
@@ -279,6 +287,9 @@ public:
     Position positionOf(StringData fieldName) const {
         return storage().findField(fieldName, DocumentStorage::LookupPolicy::kCacheAndBSON);
     }
+    Position positionOf(FieldPath::HashedFieldName field) const {
+        return storage().findField(field, DocumentStorage::LookupPolicy::kCacheAndBSON);
+    }
 
     /** Clone a document.
      *
@@ -29,14 +29,14 @@
 
 #pragma once
 
-#include <third_party/murmurhash3/MurmurHash3.h>
-
 #include <bitset>
 #include <boost/intrusive_ptr.hpp>
+#include <boost/optional.hpp>
 
 #include "mongo/base/static_assert.h"
 #include "mongo/db/exec/document_value/document_metadata_fields.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/pipeline/field_path.h"
 #include "mongo/stdx/variant.h"
 #include "mongo/util/intrusive_counter.h"
 
@@ -325,7 +325,12 @@ public:
     };
 
     /// Returns the position of the named field or Position()
-    Position findField(StringData name, LookupPolicy policy) const;
+    Position findField(StringData name, LookupPolicy policy) const {
+        return findField(name, boost::none, policy);
+    }
+    Position findField(FieldPath::HashedFieldName field, LookupPolicy policy) const {
+        return findField(field.name, field.hash, policy);
+    }
 
     // Document uses these
     const ValueElement& getField(Position pos) const {
@@ -338,6 +343,12 @@ public:
             return Value();
         return getField(pos).val;
     }
+    Value getField(FieldPath::HashedFieldName field) const {
+        Position pos = findField(field, LookupPolicy::kCacheAndBSON);
+        if (!pos.found())
+            return Value();
+        return getField(pos).val;
+    }
 
     // MutableDocument uses these
     ValueElement& getField(Position pos) {
@@ -357,16 +368,14 @@ public:
      * Given a field name either return a Value if the field resides in the cache, or a BSONElement
      * if the field resides in the backing BSON.
      */
-    stdx::variant<BSONElement, Value> getFieldNonCaching(StringData name) const {
-        Position pos = findField(name, LookupPolicy::kCacheOnly);
+    stdx::variant<BSONElement, Value> getFieldNonCaching(FieldPath::HashedFieldName field) const {
+        Position pos = findField(field, LookupPolicy::kCacheOnly);
         if (pos.found()) {
             return {getField(pos).val};
         }
 
-        for (auto&& bsonElement : _bson) {
-            if (name == bsonElement.fieldNameStringData()) {
-                return {bsonElement};
-            }
+        if (auto bsonElement = findFieldInBson(field.name, field.hash); !bsonElement.eoo()) {
+            return {bsonElement};
         }
 
         // Field not found. Return EOO Value.
@@ -398,6 +407,11 @@ public:
         return !_cache ? 0 : (_cacheEnd - _cache + hashTabBytes());
     }
 
+    /// The space used by the index of the fields in the backing BSON, if it has been built.
+    size_t bsonFieldIndexBytes() const {
+        return _bsonFieldIndex.capacity() * sizeof(uint32_t);
+    }
+
     auto bsonObjSize() const {
         return _bson.objsize();
     }
@@ -464,9 +478,7 @@ public:
 
     static unsigned hashKey(StringData name) {
         // TODO consider FNV-1a once we have a better benchmark corpus
-        unsigned out;
-        MurmurHash3_x86_32(name.rawData(), name.size(), 0, &out);
-        return out;
+        return FieldPath::hashFieldName(name);
     }
 
     const ValueElement* begin() const {
@@ -493,8 +505,25 @@ public:
     }
 
 private:
+    /**
+     * Returns the position of the named field or Position(). The hash of the name is computed only
+     * if a hash table is searched and 'hash' was not given.
+     */
+    Position findField(StringData name, boost::optional<unsigned> hash, LookupPolicy policy) const;
+
     /// Returns the position of the named field in the cache or Position()
-    Position findFieldInCache(StringData name) const;
+    Position findFieldInCache(StringData name, boost::optional<unsigned> hash = boost::none) const;
+
+    /**
+     * Returns the first element of the backing BSON with the given name, or an EOO element. Wide
+     * objects are walked until they have been searched a few times, after which the offsets of
+     * their fields are indexed by name so that later lookups do not walk the object at all.
+     */
+    BSONElement findFieldInBson(StringData name,
+                                boost::optional<unsigned> hash = boost::none) const;
+
+    /// Builds '_bsonFieldIndex' from the fields of '_bson'.
+    void buildBsonFieldIndex() const;
 
     /// Allocates space in _cache. Copies existing data if there is any.
     void alloc(unsigned newSize);
@@ -537,6 +566,10 @@ private:
         HASH_TAB_INIT_SIZE = 8,  // must be power of 2
         HASH_TAB_MIN = 4,        // don't hash fields for docs smaller than this
                                  // set to 1 to always hash
+        // Only index the fields of a backing BSON when a lookup walks at least this many of them,
+        BSON_INDEX_MIN_FIELDS = 32,
+        // and after this many such lookups.
+        BSON_INDEX_MIN_SCANS = 2,
     };
 
     // _cache layout:
@@ -565,6 +598,14 @@ private:
 
     BSONObj _bson;
 
+    // An open-addressing hash table, keyed by field name, of the offsets of the fields of '_bson'
+    // from its start. Zero marks an empty slot since no field starts at offset zero. Only built
+    // for wide objects that are searched repeatedly, see findFieldInBson().
+    mutable std::vector<uint32_t> _bsonFieldIndex;
+
+    // The number of lookups that had to walk at least BSON_INDEX_MIN_FIELDS fields of '_bson'.
+    mutable uint8_t _numWideBsonScans = 0;
+
     // If '_stripMetadata' is true, tracks whether or not the metadata has been lazy-loaded from the
     // backing '_bson' object. If so, then no attempt will be made to load the metadata again, even
     // if the metadata has been released by a call to 'releaseMetadata()'.
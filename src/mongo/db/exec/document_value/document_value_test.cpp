@@ -137,6 +137,71 @@ TEST(DocumentConstruction, FromBsonReset) {
     ASSERT_BSONOBJ_EQ(bson, toBson(newDocument));
 }
 
+TEST(DocumentConstruction, ReusedFieldBuffersDoNotLeakFields) {
+    // Documents built one after another on a thread reuse the field buffers of the earlier ones.
+    for (int round = 0; round < 100; ++round) {
+        MutableDocument md;
+        for (int i = 0; i < round; ++i) {
+            md.addField(std::to_string(i), Value(round * 1000 + i));
+        }
+        Document document = md.freeze();
+        ASSERT_EQ(static_cast<size_t>(round), document.computeSize());
+        for (int i = 0; i < round; ++i) {
+            ASSERT_VALUE_EQ(Value(round * 1000 + i), document[std::to_string(i)]);
+        }
+        ASSERT(document["missing"].missing());
+
+        Document copy = document.clone();
+        ASSERT_DOCUMENT_EQ(document, copy);
+    }
+
+    MutableDocument md(Document{{"a", 1}, {"b", 2}});
+    md.reset(BSON("c" << 3), false);
+    ASSERT_DOCUMENT_EQ(Document(BSON("c" << 3)), md.freeze());
+}
+
+TEST(DocumentGetFieldNonCaching, WideBsonFieldsAreFoundAfterIndexing) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 300; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    // A duplicate name must resolve to its first occurrence, as it does when walking the object.
+    builder.append("f7", -1);
+    Document document(builder.obj());
+
+    // The first lookups walk the object, the later ones go through the index of its fields.
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_VALUE_EQ(Value(299), document["f299"]);
+        ASSERT_VALUE_EQ(Value(7), document["f7"]);
+        ASSERT(document["missing"].missing());
+
+        auto bsonElt = stdx::get<BSONElement>(document.getNestedFieldNonCaching(FieldPath("f150")));
+        ASSERT_EQ(150, bsonElt.numberInt());
+    }
+    ASSERT_EQ(301U, document.computeSize());
+}
+
+TEST(DocumentGetField, HashedFieldNamesAreFoundInCacheAndBson) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 300; ++i) {
+        builder.append("f" + std::to_string(i), i);
+    }
+    MutableDocument md(Document(builder.obj()));
+    for (int i = 0; i < 20; ++i) {
+        md.setField("g" + std::to_string(i), Value(i));
+    }
+    Document document(md.freeze());
+
+    FieldPath path("g19.f150.f7");
+    for (int round = 0; round < 3; ++round) {
+        ASSERT_VALUE_EQ(Value(19), document[path.getFieldNameHashed(0)]);
+        ASSERT_VALUE_EQ(Value(150), document[FieldPath("f150").getFieldNameHashed(0)]);
+        ASSERT(document[path.getFieldNameHashed(2)].isNumber());
+        ASSERT(document[FieldPath("missing").getFieldNameHashed(0)].missing());
+        ASSERT(document.positionOf(path.getFieldNameHashed(1)).found());
+    }
+}
+
 /**
  * Appends to 'builder' an object nested 'depth' levels deep.
  */
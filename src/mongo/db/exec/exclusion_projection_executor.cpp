@@ -33,6 +33,84 @@
 
 namespace mongo::projection_executor {
 
+Document FastPathEligibleExclusionNode::applyToDocument(const Document& inputDoc) const {
+    // An exclusion projection may carry $meta expressions, which the fast path cannot evaluate.
+    if (_subtreeContainsComputedFields) {
+        return ExclusionNode::applyToDocument(inputDoc);
+    }
+
+    // If we can get the backing BSON object off the input document without allocating an owned
+    // copy, then we can apply a fast-path BSON-to-BSON exclusion projection.
+    if (auto bson = inputDoc.toBsonIfTriviallyConvertible()) {
+        BSONObjBuilder bob;
+        _applyProjections(*bson, &bob);
+
+        Document outputDoc{bob.obj()};
+        // Make sure that we always pass through any metadata present in the input doc.
+        if (inputDoc.metadata()) {
+            MutableDocument md{std::move(outputDoc)};
+            md.copyMetaDataFrom(inputDoc);
+            return md.freeze();
+        }
+        return outputDoc;
+    }
+
+    // A fast-path projection is not feasible, fall back to default implementation.
+    return ExclusionNode::applyToDocument(inputDoc);
+}
+
+void FastPathEligibleExclusionNode::_applyProjections(BSONObj bson, BSONObjBuilder* bob) const {
+    BSONObjIterator it{bson};
+    while (it.more()) {
+        const auto bsonElement{it.next()};
+        const auto fieldName{bsonElement.fieldNameStringData()};
+
+        if (_projectedFields.find(fieldName) != _projectedFields.end()) {
+            continue;
+        }
+
+        auto childIt = _children.find(fieldName);
+        if (childIt == _children.end()) {
+            bob->append(bsonElement);
+            continue;
+        }
+
+        auto child = static_cast<FastPathEligibleExclusionNode*>(childIt->second.get());
+        if (bsonElement.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bob->subobjStart(fieldName)};
+            child->_applyProjections(bsonElement.embeddedObject(), &subBob);
+        } else if (bsonElement.type() == BSONType::Array) {
+            BSONArrayBuilder subBab{bob->subarrayStart(fieldName)};
+            child->_applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+        } else {
+            // The projection semantics dictate to keep a scalar which has no subfields to exclude.
+            bob->append(bsonElement);
+        }
+    }
+}
+
+void FastPathEligibleExclusionNode::_applyProjectionsToArray(BSONObj array,
+                                                             BSONArrayBuilder* bab) const {
+    BSONObjIterator it{array};
+
+    while (it.more()) {
+        const auto bsonElement{it.next()};
+
+        if (bsonElement.type() == BSONType::Object) {
+            BSONObjBuilder subBob{bab->subobjStart()};
+            _applyProjections(bsonElement.embeddedObject(), &subBob);
+        } else if (bsonElement.type() == BSONType::Array &&
+                   _policies.arrayRecursionPolicy !=
+                       ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays) {
+            BSONArrayBuilder subBab{bab->subarrayStart()};
+            _applyProjectionsToArray(bsonElement.embeddedObject(), &subBab);
+        } else {
+            // Scalars, and nested arrays we do not recurse into, are kept unchanged.
+            bab->append(bsonElement);
+        }
+    }
+}
+
 std::pair<BSONObj, bool> ExclusionNode::extractProjectOnFieldAndRename(const StringData& oldName,
                                                                        const StringData& newName) {
     BSONObjBuilder extractedExclusion;
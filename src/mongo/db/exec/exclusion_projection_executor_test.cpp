@@ -35,6 +35,7 @@
 #include <iterator>
 #include <string>
 
+#include "mongo/base/exact_cast.h"
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/json.h"
@@ -54,11 +55,15 @@ namespace mongo::projection_executor {
 namespace {
 using std::vector;
 
-auto createProjectionExecutor(const BSONObj& spec, const ProjectionPolicies& policies) {
+auto createProjectionExecutor(const BSONObj& spec,
+                              const ProjectionPolicies& policies,
+                              bool allowFastPath = false) {
     const boost::intrusive_ptr<ExpressionContextForTest> expCtx(new ExpressionContextForTest());
     auto projection = projection_ast::parse(expCtx, spec, policies);
     auto builderParams = BuilderParamsBitSet{kDefaultBuilderParams};
-    builderParams.reset(kAllowFastPath);
+    if (!allowFastPath) {
+        builderParams.reset(kAllowFastPath);
+    }
     auto executor = buildProjectionExecutor(expCtx, &projection, policies, builderParams);
     invariant(executor->getType() == TransformerInterface::TransformerType::kExclusionProjection);
     return executor;
@@ -615,5 +620,41 @@ TEST(ExclusionProjectionExecutionTest, ShouldNotExtractWhenFieldIsNotPresent) {
     ASSERT_BSONOBJ_EQ(fromjson("{a: {b: false}, _id: true}"),
                       exclusion->serializeTransformation(boost::none).toBson());
 }
+
+TEST(ExclusionProjectionExecutionTest, FastPathMatchesDefaultImplementation) {
+    const std::vector<BSONObj> inputs{
+        fromjson("{_id: 1, a: 1, b: {c: 1, d: 2}, e: 3}"),
+        fromjson("{_id: 2, b: [{c: 1, d: 2}, 3, [{c: 4, d: 5}, 6], {d: 7}], a: [1, 2]}"),
+        fromjson("{_id: 3, b: 'scalar', x: {y: {z: 1, w: 2}, v: 3}}"),
+        fromjson("{x: [{y: [{z: 1}, {w: 2}]}, {y: 1}], e: {}}"),
+        BSONObj()};
+
+    for (auto&& spec :
+         {fromjson("{a: 0}"), fromjson("{'b.c': 0, e: 0}"), fromjson("{_id: 0, 'x.y.z': 0}")}) {
+        for (auto&& policies :
+             {ProjectionPolicies{},
+              ProjectionPolicies{
+                  ProjectionPolicies::kDefaultIdPolicyDefault,
+                  ProjectionPolicies::ArrayRecursionPolicy::kDoNotRecurseNestedArrays,
+                  ProjectionPolicies::kComputedFieldsPolicyDefault}}) {
+            auto fastPath = createProjectionExecutor(spec, policies, true);
+            auto fastPathRoot = static_cast<ExclusionProjectionExecutor*>(fastPath.get())->getRoot();
+            ASSERT(exact_pointer_cast<const FastPathEligibleExclusionNode*>(fastPathRoot));
+            auto defaultPath = createProjectionExecutor(spec, policies);
+
+            for (auto&& input : inputs) {
+                ASSERT_BSONOBJ_EQ(defaultPath->applyTransformation(Document{input}).toBson(),
+                                  fastPath->applyTransformation(Document{input}).toBson());
+            }
+        }
+    }
+}
+
+TEST(ExclusionProjectionExecutionTest, FastPathIsNotUsedWithMetaProjection) {
+    auto exclusion = createProjectionExecutor(
+        fromjson("{a: 0, b: {$meta: 'textScore'}}"), ProjectionPolicies{}, true);
+    auto root = static_cast<ExclusionProjectionExecutor*>(exclusion.get())->getRoot();
+    ASSERT_FALSE(exact_pointer_cast<const FastPathEligibleExclusionNode*>(root));
+}
 }  // namespace
 }  // namespace mongo::projection_executor
@@ -57,6 +57,7 @@ FetchStage::FetchStage(ExpressionContext* expCtx,
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _ws(ws),
       _filter((filter && !filter->isTriviallyTrue()) ? filter : nullptr),
+      _compiledFilter(SbeCompiledFilter::compile(expCtx, _filter)),
       _idRetrying(WorkingSet::INVALID_ID) {
     _children.emplace_back(std::move(child));
 }
@@ -141,11 +142,15 @@ void FetchStage::doRestoreStateRequiresCollection() {
 void FetchStage::doDetachFromOperationContext() {
     if (_cursor)
         _cursor->detachFromOperationContext();
+    if (_compiledFilter)
+        _compiledFilter->detachFromOperationContext();
 }
 
 void FetchStage::doReattachToOperationContext() {
     if (_cursor)
         _cursor->reattachToOperationContext(opCtx());
+    if (_compiledFilter)
+        _compiledFilter->reattachToOperationContext(opCtx());
 }
 
 PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
@@ -167,7 +172,7 @@ PlanStage::StageState FetchStage::returnIfMatches(WorkingSetMember* member,
     // predicate.
     ++_specificStats.docsExamined;
 
-    if (Filter::passes(member, _filter)) {
+    if (_compiledFilter ? _compiledFilter->passes(member) : Filter::passes(member, _filter)) {
         *out = memberID;
         return PlanStage::ADVANCED;
     } else {
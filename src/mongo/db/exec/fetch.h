@@ -32,6 +32,7 @@
 #include <memory>
 
 #include "mongo/db/exec/requires_collection_stage.h"
+#include "mongo/db/exec/sbe_compiled_filter.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/record_id.h"
@@ -95,6 +96,9 @@ private:
     // The filter is not owned by us.
     const MatchExpression* _filter;
 
+    // Set when the filter is evaluated with an SBE plan compiled from it.
+    std::unique_ptr<SbeCompiledFilter> _compiledFilter;
+
     // If not Null, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
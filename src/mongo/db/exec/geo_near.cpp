@@ -36,11 +36,13 @@
 #include <vector>
 
 // For s2 search
-#include "third_party/s2/s2regionintersection.h"
+#include "third_party/s2/s2cap.h"
+#include "third_party/s2/s2cell.h"
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/db/bson/dotted_path_support.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/eof.h"
 #include "mongo/db/exec/fetch.h"
 #include "mongo/db/geo/geoconstants.h"
 #include "mongo/db/geo/geoparser.h"
@@ -694,6 +696,30 @@ static int getFieldPosition(const IndexDescriptor* index, const string& fieldNam
 
 static const string kS2IndexNearStage("GEO_NEAR_2DSPHERE");
 
+namespace {
+
+// The number of cells scanned by the first interval, which matches the four cells searched by the
+// density estimator.
+const size_t kInitialCellsPerInterval = 4;
+
+// Bounds the size of the index scan built for a single interval.
+const size_t kMaxCellsPerInterval = 64;
+
+// Distances to cells are widened by this relative error, so that roundoff never places a geometry
+// lying on a cell boundary outside of the cell which indexes it.
+const double kCellDistanceEpsilon = 1e-12;
+
+// Returns bounds in meters on the distance from 'center' to the points within 'cell'.
+std::pair<double, double> distanceBoundsToCell(const S2Point& center, const S2Cell& cell) {
+    const S2Cap capBound = cell.GetCapBound();
+    const double centerToAxis = S1Angle(center, capBound.axis()).radians();
+    const double capAngle = capBound.angle().radians();
+    const double minDistance = std::max(0.0, centerToAxis - capAngle) * kRadiusOfEarthInMeters;
+    const double maxDistance = (centerToAxis + capAngle) * kRadiusOfEarthInMeters;
+    return {minDistance * (1 - kCellDistanceEpsilon), maxDistance * (1 + kCellDistanceEpsilon)};
+}
+}  // namespace
+
 GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
                                            ExpressionContext* expCtx,
                                            WorkingSet* workingSet,
@@ -707,8 +733,9 @@ GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
                 s2Index),
       _nearParams(nearParams),
       _fullBounds(geoNearDistanceBounds(*nearParams.nearQuery)),
-      _currBounds(_fullBounds.center(), -1, _fullBounds.getInner()),
-      _boundsIncrement(0.0) {
+      _scanLevel(0),
+      _cellsPerInterval(kInitialCellsPerInterval),
+      _searchedDistance(_fullBounds.getInner()) {
     _specificStats.keyPattern = s2Index->keyPattern();
     _specificStats.indexName = s2Index->indexName();
     _specificStats.indexVersion = static_cast<int>(s2Index->version());
@@ -719,63 +746,26 @@ GeoNear2DSphereStage::GeoNear2DSphereStage(const GeoNearParams& nearParams,
     // strings, and _nearParams.filter should have the collator.
     const CollatorInterface* collator = nullptr;
     ExpressionParams::initialize2dsphereParams(s2Index->infoObj(), collator, &_indexParams);
-}
-
-namespace {
-
-S2Region* buildS2Region(const R2Annulus& sphereBounds) {
-    // Internal bounds come in SPHERE CRS units
-    // i.e. center is lon/lat, inner/outer are in meters
-    S2LatLng latLng = S2LatLng::FromDegrees(sphereBounds.center().y, sphereBounds.center().x);
-
-    vector<S2Region*> regions;
-
-    const double inner = sphereBounds.getInner();
-    const double outer = sphereBounds.getOuter();
 
-    if (inner > 0) {
-        // TODO: Currently a workaround to fix occasional floating point errors
-        // in S2, where sometimes points near the axis will not be returned
-        // if inner == 0
-        S2Cap innerCap = S2Cap::FromAxisAngle(latLng.ToPoint(),
-                                              S1Angle::Radians(inner / kRadiusOfEarthInMeters));
-        innerCap = innerCap.Complement();
-        regions.push_back(new S2Cap(innerCap));
+    // The search starts from the six face cells, which together cover the whole earth.
+    for (int face = 0; face < S2CellId::kNumFaces; ++face) {
+        queueCell(S2CellId::FromFacePosLevel(face, 0, 0), 0.0);
     }
+}
 
-    // 'kEpsilon' is about 9 times the double-precision roundoff relative error.
-    const double kEpsilon = 1e-15;
-
-    // We only need to max bound if this is not a full search of the Earth
-    // Using the constant here is important since we use the min of kMaxEarthDistance
-    // and the actual bounds passed in to set up the search area.
-    if ((outer * (1 + kEpsilon)) < kMaxEarthDistanceInMeters) {
-        // SERVER-52953: The cell covering returned by S2 may have a matching point along its
-        // boundary. In certain cases, this boundary point is not contained within the covering,
-        // which means that this search will not match said point. As such, we avoid this issue by
-        // finding a covering for the region expanded over a very small radius because this covering
-        // is guaranteed to contain the boundary point.
-        auto angle = S1Angle::Radians((outer * (1 + kEpsilon)) / kRadiusOfEarthInMeters);
-        S2Cap outerCap = S2Cap::FromAxisAngle(latLng.ToPoint(), angle);
-
-        // If 'outer' is sufficiently small, the computation of the S2Cap's height from 'angle' may
-        // underflow, resulting in a height less than 'kEpsilon' and an empty cap. As such, we
-        // guarantee that 'outerCap' has a height of at least 'kEpsilon'.
-        if (outerCap.height() < kEpsilon) {
-            outerCap = S2Cap::FromAxisHeight(latLng.ToPoint(), kEpsilon);
-        }
-        regions.push_back(new S2Cap(outerCap));
-    }
+void GeoNear2DSphereStage::queueCell(const S2CellId& cellId, double parentDistance) {
+    auto [minDistance, maxDistance] =
+        distanceBoundsToCell(_nearParams.nearQuery->centroid->point, S2Cell(cellId));
 
-    // if annulus is entire world, return a full cap
-    if (regions.empty()) {
-        regions.push_back(new S2Cap(S2Cap::Full()));
-    }
+    // Everything within the cell is also within its parent, so the parent's bound still applies.
+    // This keeps the distances of the cells leaving the queue from ever decreasing.
+    minDistance = std::max(minDistance, parentDistance);
 
-    // Takes ownership of caps
-    return new S2RegionIntersection(&regions);
+    if (minDistance > _fullBounds.getOuter() || maxDistance < _fullBounds.getInner()) {
+        return;
+    }
+    _cellQueue.push({minDistance, cellId});
 }
-}  // namespace
 
 GeoNear2DSphereStage::DensityEstimator::DensityEstimator(const CollectionPtr& collection,
                                                          PlanStage::Children* children,
@@ -918,13 +908,15 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* opCtx,
     if (state == IS_EOF) {
         // We find a document in 4 neighbors at current level, but didn't at previous level.
         //
-        // Assuming cell size at current level is d and data is even distributed, the distance
-        // between two nearest points are at least d. The following circle with radius of 3 * d
-        // covers PI * 9 * d^2, giving at most 30 documents.
+        // Assuming data is evenly distributed, a cell whose edge is about the estimated distance
+        // holds roughly one document, so cells of that size are scanned and anything coarser is
+        // subdivided on the way down.
         //
         // At the coarsest level, the search area is the whole earth.
-        _boundsIncrement = 3 * estimatedDistance;
-        invariant(_boundsIncrement > 0.0);
+        invariant(estimatedDistance > 0.0);
+        _scanLevel = std::min(
+            S2::kAvgEdge.GetClosestLevel(estimatedDistance / kRadiusOfEarthInMeters),
+            S2::kMaxCellLevel);
 
         // Clean up
         _densityEstimator.reset(nullptr);
@@ -935,8 +927,7 @@ PlanStage::StageState GeoNear2DSphereStage::initialize(OperationContext* opCtx,
 
 std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     OperationContext* opCtx, WorkingSet* workingSet, const CollectionPtr& collection) {
-    // The search is finished if we searched at least once and all the way to the edge
-    if (_currBounds.getInner() >= 0 && _currBounds.getOuter() == _fullBounds.getOuter()) {
+    if (_searchedAll) {
         return nullptr;
     }
 
@@ -948,25 +939,76 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
         const IntervalStats& lastIntervalStats = _specificStats.intervalStats.back();
 
         // TODO: Generally we want small numbers of results fast, then larger numbers later
-        if (lastIntervalStats.numResultsReturned < 300)
-            _boundsIncrement *= 2;
-        else if (lastIntervalStats.numResultsReturned > 600)
-            _boundsIncrement /= 2;
+        //
+        // The area searched by an interval grows by scanning more cells, and once an interval
+        // holds as many cells as it may, by scanning coarser ones. Queued cells which are already
+        // finer than the scan level are still scanned as they are.
+        if (lastIntervalStats.numResultsReturned < 300) {
+            if (_cellsPerInterval < kMaxCellsPerInterval) {
+                _cellsPerInterval *= 2;
+            } else if (_scanLevel > 0) {
+                --_scanLevel;
+            }
+        } else if (lastIntervalStats.numResultsReturned > 600) {
+            if (_cellsPerInterval > 1) {
+                _cellsPerInterval /= 2;
+            } else if (_scanLevel < S2::kMaxCellLevel) {
+                ++_scanLevel;
+            }
+        }
     }
 
-    invariant(_boundsIncrement > 0.0);
+    // Take the nearest cells off the queue, subdividing them until they are fine enough to scan.
+    // As the queue is ordered by distance, this walks down the cell hierarchy towards the query
+    // point first and only descends into far away cells once everything nearer has been searched.
+    std::vector<S2CellId> scanCells;
+    std::vector<S2CellId> exactCells;
+    while (!_cellQueue.empty() && scanCells.size() < _cellsPerInterval) {
+        const QueuedCell cell = _cellQueue.top();
+        _cellQueue.pop();
+
+        if (cell.cellId.level() >= _scanLevel) {
+            scanCells.push_back(cell.cellId);
+            continue;
+        }
 
-    R2Annulus nextBounds(_currBounds.center(),
-                         _currBounds.getOuter(),
-                         min(_currBounds.getOuter() + _boundsIncrement, _fullBounds.getOuter()));
+        // A geometry may be indexed by this exact cell rather than by any of its children, so the
+        // cell's own key must be scanned before the children can stand in for it.
+        if (cell.cellId.level() >= _indexParams.coarsestIndexedLevel &&
+            cell.cellId.level() <= _indexParams.finestIndexedLevel) {
+            exactCells.push_back(cell.cellId);
+        }
 
-    bool isLastInterval = (nextBounds.getOuter() == _fullBounds.getOuter());
-    _currBounds = nextBounds;
+        for (S2CellId child = cell.cellId.child_begin(); child != cell.cellId.child_end();
+             child = child.next()) {
+            queueCell(child, cell.minDistance);
+        }
+    }
+
+    // Every cell still queued is at least as far away as the front of the queue, so all documents
+    // nearer than that have now been scanned. Once the queue is exhausted, the rest of the search
+    // annulus has been covered.
+    const double minDistance = _searchedDistance;
+    double maxDistance = _fullBounds.getOuter();
+    bool isLastInterval = true;
+    if (!_cellQueue.empty() && _cellQueue.top().minDistance < maxDistance) {
+        maxDistance = std::max(_cellQueue.top().minDistance, minDistance);
+        isLastInterval = false;
+    }
+    _searchedDistance = maxDistance;
+    _searchedAll = isLastInterval;
 
     //
-    // Setup the covering region and stages for this interval
+    // Setup the stages for this interval
     //
 
+    if (scanCells.empty() && exactCells.empty()) {
+        // Nothing left to scan, but this interval still returns what was buffered earlier.
+        _children.emplace_back(std::make_unique<EOFStage>(expCtx()));
+        return std::make_unique<CoveredInterval>(
+            _children.back().get(), minDistance, maxDistance, isLastInterval);
+    }
+
     IndexScanParams scanParams(opCtx, indexDescriptor());
 
     // This does force us to do our own deduping of results.
@@ -976,28 +1018,10 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
     const string s2Field = _nearParams.nearQuery->field;
     const int s2FieldPosition = getFieldPosition(indexDescriptor(), s2Field);
     fassert(28678, s2FieldPosition >= 0);
-    scanParams.bounds.fields[s2FieldPosition].intervals.clear();
-    std::unique_ptr<S2Region> region(buildS2Region(_currBounds));
-
-    std::vector<S2CellId> cover = ExpressionMapping::get2dsphereCovering(*region);
-
-    // Generate a covering that does not intersect with any previous coverings
-    S2CellUnion coverUnion;
-    coverUnion.InitSwap(&cover);
-    invariant(cover.empty());
-    S2CellUnion diffUnion;
-    diffUnion.GetDifference(&coverUnion, &_scannedCells);
-    for (auto cellId : diffUnion.cell_ids()) {
-        if (region->MayIntersect(S2Cell(cellId))) {
-            cover.push_back(cellId);
-        }
-    }
-
-    // Add the cells in this covering to the _scannedCells union
-    _scannedCells.Add(cover);
-
     OrderedIntervalList* coveredIntervals = &scanParams.bounds.fields[s2FieldPosition];
-    ExpressionMapping::S2CellIdsToIntervalsWithParents(cover, _indexParams, coveredIntervals);
+    coveredIntervals->intervals.clear();
+    ExpressionMapping::S2CellIdsToIntervalsWithExactCells(
+        scanCells, exactCells, _indexParams.indexVersion, coveredIntervals);
 
     auto scan = std::make_unique<IndexScan>(expCtx(), collection, scanParams, workingSet, nullptr);
 
@@ -1006,7 +1030,7 @@ std::unique_ptr<NearStage::CoveredInterval> GeoNear2DSphereStage::nextInterval(
         expCtx(), workingSet, std::move(scan), _nearParams.filter, collection));
 
     return std::make_unique<CoveredInterval>(
-        _children.back().get(), nextBounds.getInner(), nextBounds.getOuter(), isLastInterval);
+        _children.back().get(), minDistance, maxDistance, isLastInterval);
 }
 
 double GeoNear2DSphereStage::computeDistance(WorkingSetMember* member) {
@@ -29,6 +29,10 @@
 
 #pragma once
 
+#include <functional>
+#include <queue>
+#include <vector>
+
 #include "mongo/db/exec/index_scan.h"
 #include "mongo/db/exec/near.h"
 #include "mongo/db/exec/plan_stats.h"
@@ -40,7 +44,7 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/query/index_bounds.h"
-#include "third_party/s2/s2cellunion.h"
+#include "third_party/s2/s2cellid.h"
 
 namespace mongo {
 
@@ -186,6 +190,21 @@ private:
         IndexScan* _indexScan = nullptr;  // Owned in PlanStage::_children.
     };
 
+    // A cell of the S2 hierarchy which has not yet been searched, along with a lower bound on the
+    // distance from the query point to anything indexed within it.
+    struct QueuedCell {
+        bool operator>(const QueuedCell& other) const {
+            return minDistance > other.minDistance;
+        }
+
+        double minDistance;
+        S2CellId cellId;
+    };
+
+    // Queues 'cellId' to be searched if it may contain something within the search annulus.
+    // 'parentDistance' is the lower bound on the distance to the cell's parent.
+    void queueCell(const S2CellId& cellId, double parentDistance);
+
     const GeoNearParams _nearParams;
 
     S2IndexingParams _indexParams;
@@ -193,14 +212,22 @@ private:
     // The total search annulus
     const R2Annulus _fullBounds;
 
-    // The current search annulus
-    R2Annulus _currBounds;
+    // The cells left to search, nearest first. Cells coarser than '_scanLevel' are subdivided
+    // when they reach the front of the queue, the others are scanned.
+    std::priority_queue<QueuedCell, std::vector<QueuedCell>, std::greater<QueuedCell>> _cellQueue;
 
-    // Amount to increment the next bounds by
-    double _boundsIncrement;
+    // The level of the cells which are scanned. Initially chosen from the density estimate so
+    // that a scanned cell near the query point holds roughly one document.
+    int _scanLevel;
 
-    // Keeps track of the region that has already been scanned
-    S2CellUnion _scannedCells;
+    // The number of cells to scan in the next interval.
+    size_t _cellsPerInterval;
+
+    // Every document closer than this has been scanned by an earlier interval.
+    double _searchedDistance;
+
+    // Whether the last interval has been generated.
+    bool _searchedAll = false;
 
     std::unique_ptr<DensityEstimator> _densityEstimator;
 };
@@ -31,6 +31,7 @@
 
 #include "mongo/db/exec/idhack.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/db/catalog/index_catalog.h"
@@ -54,11 +55,18 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          WorkingSet* ws,
                          const CollectionPtr& collection,
                          const IndexDescriptor* descriptor)
-    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
-      _workingSet(ws),
-      _key(query->getQueryObj()["_id"].wrap()) {
+    : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws), _workingSet(ws) {
     _specificStats.indexName = descriptor->indexName();
     _addKeyMetadata = query->getFindCommandRequest().getReturnKey();
+
+    BSONElement idElt = query->getQueryObj()["_id"];
+    if (CanonicalQuery::isSimpleIdInQuery(query->getQueryObj())) {
+        for (auto&& elt : idElt.Obj().firstElement().Obj()) {
+            _keys.push_back(elt.wrap("_id"));
+        }
+    } else {
+        _keys.push_back(idElt.wrap());
+    }
 }
 
 IDHackStage::IDHackStage(ExpressionContext* expCtx,
@@ -68,7 +76,7 @@ IDHackStage::IDHackStage(ExpressionContext* expCtx,
                          const IndexDescriptor* descriptor)
     : RequiresIndexStage(kStageType, expCtx, collection, descriptor, ws),
       _workingSet(ws),
-      _key(key) {
+      _keys{key} {
     _specificStats.indexName = descriptor->indexName();
 }
 
@@ -85,14 +93,22 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
 
     WorkingSetID id = WorkingSet::INVALID_ID;
     try {
+        if (_seekKeys.empty()) {
+            makeSeekKeys();
+        }
+
+        if (!_indexCursor)
+            _indexCursor = indexAccessMethod()->newCursor(opCtx());
+
         // Look up the key by going directly to the index.
-        RecordId recordId = indexAccessMethod()->findSingle(opCtx(), _key);
+        auto kv = _indexCursor->seekExact(_seekKeys[_nextSeekKey],
+                                          SortedDataInterface::Cursor::kWantLoc);
 
         // Key not found.
-        if (recordId.isNull()) {
-            _done = true;
-            return PlanStage::IS_EOF;
+        if (!kv) {
+            return skipKey();
         }
+        RecordId recordId = kv->loc;
 
         ++_specificStats.keysExamined;
         ++_specificStats.docsExamined;
@@ -111,14 +127,14 @@ PlanStage::StageState IDHackStage::doWork(WorkingSetID* out) {
                 opCtx(), _workingSet, id, _recordCursor.get(), collection()->ns())) {
             // We didn't find a document with RecordId 'id'.
             _workingSet->free(id);
-            _commonStats.isEOF = true;
-            _done = true;
-            return IS_EOF;
+            return skipKey();
         }
 
+        ++_nextSeekKey;
         return advance(id, member, out);
     } catch (const WriteConflictException&) {
-        // Restart at the beginning on retry.
+        // Retry the current key with new cursors.
+        _indexCursor.reset();
         _recordCursor.reset();
         if (id != WorkingSet::INVALID_ID)
             _workingSet->free(id);
@@ -135,20 +151,51 @@ PlanStage::StageState IDHackStage::advance(WorkingSetID id,
 
     if (_addKeyMetadata) {
         BSONObj ownedKeyObj = member->doc.value().toBson()["_id"].wrap().getOwned();
-        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_key, ownedKeyObj));
+        member->metadata().setIndexKey(IndexKeyEntry::rehydrateKey(_keys[0], ownedKeyObj));
     }
 
-    _done = true;
+    _done = _nextSeekKey == _seekKeys.size();
     *out = id;
     return PlanStage::ADVANCED;
 }
 
+PlanStage::StageState IDHackStage::skipKey() {
+    if (++_nextSeekKey == _seekKeys.size()) {
+        _done = true;
+        return PlanStage::IS_EOF;
+    }
+    return PlanStage::NEED_TIME;
+}
+
+void IDHackStage::makeSeekKeys() {
+    _seekKeys.reserve(_keys.size());
+    for (auto&& key : _keys) {
+        _seekKeys.push_back(indexAccessMethod()->makeSingleKeyString(opCtx(), key));
+    }
+
+    // Seeking in index order lets each lookup start close to where the previous one ended. Values
+    // which are equal under the index collation make the same key, and are only looked up once.
+    std::sort(_seekKeys.begin(), _seekKeys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.compare(rhs) < 0;
+    });
+    _seekKeys.erase(std::unique(_seekKeys.begin(),
+                                _seekKeys.end(),
+                                [](const auto& lhs, const auto& rhs) {
+                                    return lhs.compare(rhs) == 0;
+                                }),
+                    _seekKeys.end());
+}
+
 void IDHackStage::doSaveStateRequiresIndex() {
+    if (_indexCursor)
+        _indexCursor->saveUnpositioned();
     if (_recordCursor)
         _recordCursor->saveUnpositioned();
 }
 
 void IDHackStage::doRestoreStateRequiresIndex() {
+    if (_indexCursor)
+        _indexCursor->restore();
     if (_recordCursor) {
         auto couldRestore = _recordCursor->restore();
         uassert(5083800, "IDHackStage could not restore cursor", couldRestore);
@@ -156,11 +203,15 @@ void IDHackStage::doRestoreStateRequiresIndex() {
 }
 
 void IDHackStage::doDetachFromOperationContext() {
+    if (_indexCursor)
+        _indexCursor->detachFromOperationContext();
     if (_recordCursor)
         _recordCursor->detachFromOperationContext();
 }
 
 void IDHackStage::doReattachToOperationContext() {
+    if (_indexCursor)
+        _indexCursor->reattachToOperationContext(opCtx());
     if (_recordCursor)
         _recordCursor->reattachToOperationContext(opCtx());
 }
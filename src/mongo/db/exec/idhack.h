@@ -30,10 +30,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/db/exec/requires_index_stage.h"
 #include "mongo/db/query/canonical_query.h"
 #include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/sorted_data_interface.h"
 
 namespace mongo {
 
@@ -44,6 +47,10 @@ class RecordCursor;
  * A standalone stage implementing the fast path for key-value retrievals via the _id index. Since
  * the _id index always has the collection default collation, the IDHackStage can only be used when
  * the query's collation is equal to the collection default.
+ *
+ * For an {_id: {$in: [...]}} query the stage looks up every key of the $in list. The keys are
+ * sorted into index order and deduplicated up front, so that a single index cursor and a single
+ * record cursor serve all of the lookups, and the documents are returned in _id order.
  */
 class IDHackStage final : public RequiresIndexStage {
 public:
@@ -85,21 +92,40 @@ protected:
 
 private:
     /**
-     * Marks this stage as done, optionally adds key metadata, and returns PlanStage::ADVANCED.
+     * Optionally adds key metadata and returns PlanStage::ADVANCED, marking this stage as done if
+     * there are no more keys to look up.
      *
      * Called whenever we have a WSM containing the matching obj.
      */
     StageState advance(WorkingSetID id, WorkingSetMember* member, WorkingSetID* out);
 
+    /**
+     * Moves past a key which matched no document, returning PlanStage::IS_EOF if it was the last
+     * one.
+     */
+    StageState skipKey();
+
+    /**
+     * Fills out '_seekKeys' from '_keys'.
+     */
+    void makeSeekKeys();
+
+    std::unique_ptr<SortedDataInterface::Cursor> _indexCursor;
     std::unique_ptr<SeekableRecordCursor> _recordCursor;
 
     // The WorkingSet we annotate with results.  Not owned by us.
     WorkingSet* _workingSet;
 
-    // The value to match against the _id field.
-    BSONObj _key;
+    // The values to match against the _id field, each wrapped as {_id: <value>}. There is more
+    // than one for an {_id: {$in: [...]}} query.
+    std::vector<BSONObj> _keys;
+
+    // The index keys to look up, in index order and without duplicates, and the position of the
+    // next one. Made from '_keys' by the first call to doWork().
+    std::vector<KeyString::Value> _seekKeys;
+    size_t _nextSeekKey = 0;
 
-    // Have we returned our one document?
+    // Have we looked up every key?
     bool _done = false;
 
     // Do we need to add index key metadata for returnKey?
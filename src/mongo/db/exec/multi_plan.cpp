@@ -50,6 +50,7 @@
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_ranker.h"
 #include "mongo/db/query/plan_ranker_util.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/str.h"
 
@@ -164,9 +165,17 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
     // make sense.
     auto optTimer = getOptTimer();
 
-    size_t numWorks = trial_period::getTrialPeriodMaxWorks(opCtx(), collection());
+    size_t numWorks = trial_period::getTrialPeriodMaxWorks(
+        opCtx(),
+        collection(),
+        trial_period::getCheapestEstimatedWorks(
+            _candidates.begin(), _candidates.end(), [](auto&& candidate) {
+                return candidate.solution.get();
+            }));
     size_t numResults = trial_period::getTrialPeriodNumToReturn(*_query);
 
+    const double cutoffRatio = internalQueryPlanEvaluationCutoffRatio.load();
+
     try {
         // Work the plans, stopping when a plan hits EOF or returns some fixed number of results.
         for (size_t ix = 0; ix < numWorks; ++ix) {
@@ -174,6 +183,10 @@ Status MultiPlanStage::pickBestPlan(PlanYieldPolicy* yieldPolicy) {
             if (!moreToDo) {
                 break;
             }
+
+            if (cutoffRatio > 1.0) {
+                cutOffTrailingPlans(cutoffRatio);
+            }
         }
     } catch (DBException& e) {
         return e.toStatus().withContext("error while multiplanner was selecting best plan");
@@ -253,6 +266,17 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
                 throw;
             }
 
+            // If every candidate which was still running has now failed, resume the candidates
+            // which were cut off for trailing the leader, since they may yet succeed.
+            if (_failureCount + _cutOffCount == _candidates.size()) {
+                for (auto&& other : _candidates) {
+                    if (other.status == ErrorCodes::QueryTrialRunCompleted) {
+                        other.status = Status::OK();
+                    }
+                }
+                _cutOffCount = 0;
+            }
+
             continue;
         }
 
@@ -289,6 +313,40 @@ bool MultiPlanStage::workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolic
     return !doneWorking;
 }
 
+void MultiPlanStage::cutOffTrailingPlans(double cutoffRatio) {
+    size_t leaderResults = 0;
+    for (auto&& candidate : _candidates) {
+        if (candidate.status.isOK()) {
+            leaderResults = std::max(leaderResults, candidate.results.size());
+        }
+    }
+
+    for (size_t ix = 0; ix < _candidates.size(); ++ix) {
+        auto& candidate = _candidates[ix];
+        if (!candidate.status.isOK() || candidate.solution->hasBlockingStage) {
+            continue;
+        }
+
+        // Every candidate has been worked the same number of times, so comparing the number of
+        // results compares the productivity the ranker would score. The leader is never cut off
+        // since the ratio is greater than one.
+        if (static_cast<double>(leaderResults) <
+            cutoffRatio * static_cast<double>(candidate.results.size() + 1)) {
+            continue;
+        }
+
+        LOGV2_DEBUG(5843129,
+                    2,
+                    "Stopping the trial period of a candidate plan which trails the leader",
+                    "candidateIdx"_attr = ix,
+                    "numResults"_attr = candidate.results.size(),
+                    "leaderNumResults"_attr = leaderResults);
+        candidate.status = Status(ErrorCodes::QueryTrialRunCompleted,
+                                  "candidate plan trailed the leading candidate");
+        ++_cutOffCount;
+    }
+}
+
 bool MultiPlanStage::hasBackupPlan() const {
     return kNoSuchPlan != _backupPlanIdx;
 }
@@ -153,6 +153,13 @@ private:
      */
     bool workAllPlans(size_t numResults, PlanYieldPolicy* yieldPolicy);
 
+    /**
+     * Stops the trial period of each candidate plan without a blocking stage which has returned
+     * fewer than 1/'cutoffRatio' as many results as the leading candidate. Such candidates are
+     * marked with a QueryTrialRunCompleted status, so that the ranker does not score them.
+     */
+    void cutOffTrailingPlans(double cutoffRatio);
+
     /**
      * Checks whether we need to perform either a timing-based yield or a yield for a document
      * fetch. If so, then uses 'yieldPolicy' to actually perform the yield.
@@ -193,6 +200,10 @@ private:
     // is safe for the query to continue executing.
     size_t _failureCount = 0u;
 
+    // Count of the number of candidate plans whose trial period was stopped early because they
+    // trailed the leading candidate. See 'internalQueryPlanEvaluationCutoffRatio'.
+    size_t _cutOffCount = 0u;
+
     // Stats
     MultiPlanStats _specificStats;
 };
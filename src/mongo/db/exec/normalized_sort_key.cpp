@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/normalized_sort_key.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo {
+
+void NormalizedSortKey::serializeForSorter(BufBuilder& buf) const {
+    buf.appendChar(_normalizedKey ? 1 : 0);
+    if (_normalizedKey) {
+        _normalizedKey->serializeForSorter(buf);
+    }
+    _sortKey.serializeForSorter(buf);
+}
+
+NormalizedSortKey NormalizedSortKey::deserializeForSorter(BufReader& buf,
+                                                          const SorterDeserializeSettings&) {
+    boost::optional<KeyString::Value> normalizedKey;
+    if (buf.read<char>()) {
+        normalizedKey = KeyString::Value::deserializeForSorter(
+            buf, KeyString::Value::SorterDeserializeSettings{KeyString::Version::kLatestVersion});
+    }
+    auto sortKey = Value::deserializeForSorter(buf, Value::SorterDeserializeSettings{});
+    return {std::move(sortKey), std::move(normalizedKey)};
+}
+
+int NormalizedSortKey::memUsageForSorter() const {
+    return _sortKey.memUsageForSorter() +
+        (_normalizedKey ? _normalizedKey->memUsageForSorter() : 0);
+}
+
+NormalizedSortKey NormalizedSortKey::getOwned() const {
+    return {_sortKey.getOwned(), _normalizedKey};
+}
+
+SortKeyNormalizer::SortKeyNormalizer(const SortPattern& sortPattern)
+    : _isSingleElementKey(sortPattern.isSingleElementKey()) {
+    if (!internalQuerySortUseNormalizedKeys.load()) {
+        return;
+    }
+
+    BSONObjBuilder orderingBob;
+    for (size_t i = 0; i < sortPattern.size(); ++i) {
+        if (!sortPattern[i].isAscending && i >= Ordering::kMaxCompoundIndexKeys) {
+            return;
+        }
+        orderingBob.append(""_sd, sortPattern[i].isAscending ? 1 : -1);
+    }
+    _ordering = Ordering::make(orderingBob.obj());
+}
+
+NormalizedSortKey SortKeyNormalizer::normalize(const Value& sortKey) const {
+    if (!_ordering) {
+        return {sortKey, boost::none};
+    }
+
+    // A compound sort key holds one component per part of the sort pattern, which are encoded in
+    // order. The sort key generator already replaces missing components with null.
+    BSONObjBuilder keyBob;
+    auto appendComponent = [&keyBob](const Value& component) {
+        if (component.missing()) {
+            keyBob.appendNull(""_sd);
+        } else {
+            component.addToBsonObj(&keyBob, ""_sd);
+        }
+    };
+    if (_isSingleElementKey) {
+        appendComponent(sortKey);
+    } else {
+        for (auto&& component : sortKey.getArray()) {
+            appendComponent(component);
+        }
+    }
+
+    KeyString::Builder builder(KeyString::Version::kLatestVersion, keyBob.done(), *_ordering);
+    return {sortKey, builder.getValueCopy()};
+}
+
+}  // namespace mongo
@@ -0,0 +1,96 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * A sort key together with its KeyString encoding under the ordering of the sort pattern. Sort keys
+ * already hold collation comparison keys in place of strings, so comparing the encodings byte-wise
+ * orders documents exactly as SortKeyComparator orders the sort keys, without dispatching on the
+ * type of each key component. The sort key itself is kept so that it can still be attached to the
+ * sorted documents as metadata.
+ */
+class NormalizedSortKey {
+public:
+    struct SorterDeserializeSettings {};  // unused
+
+    NormalizedSortKey() = default;
+    NormalizedSortKey(Value sortKey, boost::optional<KeyString::Value> normalizedKey)
+        : _sortKey(std::move(sortKey)), _normalizedKey(std::move(normalizedKey)) {}
+
+    const Value& sortKey() const {
+        return _sortKey;
+    }
+
+    /**
+     * Returns the KeyString encoding of the sort key, or boost::none if the sort key was not
+     * normalized.
+     */
+    const boost::optional<KeyString::Value>& normalizedKey() const {
+        return _normalizedKey;
+    }
+
+    void serializeForSorter(BufBuilder& buf) const;
+    static NormalizedSortKey deserializeForSorter(BufReader& buf,
+                                                  const SorterDeserializeSettings& settings);
+    int memUsageForSorter() const;
+    NormalizedSortKey getOwned() const;
+
+private:
+    Value _sortKey;
+    boost::optional<KeyString::Value> _normalizedKey;
+};
+
+/**
+ * Produces the NormalizedSortKeys for one sort pattern. Sort keys are only normalized when
+ * 'internalQuerySortUseNormalizedKeys' is set and KeyString can represent the ordering of the
+ * pattern, which only allows the first 32 components to be descending.
+ */
+class SortKeyNormalizer {
+public:
+    explicit SortKeyNormalizer(const SortPattern& sortPattern);
+
+    NormalizedSortKey normalize(const Value& sortKey) const;
+
+private:
+    bool _isSingleElementKey;
+    boost::optional<Ordering> _ordering;
+};
+
+}  // namespace mongo
@@ -195,6 +195,10 @@ struct AndHashStats : public SpecificStats {
 
     // What's our memory limit?
     size_t memLimit = 0u;
+
+    // Whether only the RecordIds of the children's results are kept, rather than their merged
+    // index keys.
+    bool recordIdOnly = false;
 };
 
 struct AndSortedStats : public SpecificStats {
@@ -210,6 +214,9 @@ struct AndSortedStats : public SpecificStats {
 
     // How many results from each child did not pass the AND?
     std::vector<size_t> failedAnd;
+
+    // Whether the results are output without merging in the index keys of the other children.
+    bool recordIdOnly = false;
 };
 
 struct CachedPlanStats : public SpecificStats {
@@ -788,6 +795,13 @@ struct TextOrStats : public SpecificStats {
     }
 
     size_t fetches;
+
+    // The number of highest scoring documents the stage returns, or zero if it returns all of the
+    // documents matching the query.
+    size_t limit = 0;
+
+    // Whether the stage found the highest scoring documents before reading every posting.
+    bool earlyTermination = false;
 };
 
 struct TrialStats : public SpecificStats {
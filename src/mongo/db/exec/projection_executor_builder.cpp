@@ -269,9 +269,9 @@ std::unique_ptr<ProjectionExecutor> buildProjectionExecutor(
     BuilderParamsBitSet params) {
     invariant(projection);
 
-    // Fast-path can only be used with inclusion-only projections, so we need to reset the
-    // fast-path flag.
-    if (!projection->isInclusionOnly()) {
+    // Fast-path can only be used with inclusion-only or exclusion-only projections, so we need to
+    // reset the fast-path flag.
+    if (!projection->isInclusionOnly() && !projection->isExclusionOnly()) {
         params.reset(kAllowFastPath);
     }
 
@@ -31,6 +31,8 @@
 
 #include "mongo/db/exec/projection_node.h"
 
+#include "mongo/db/query/query_knobs_gen.h"
+
 namespace mongo::projection_executor {
 using ArrayRecursionPolicy = ProjectionPolicies::ArrayRecursionPolicy;
 using ComputedFieldsPolicy = ProjectionPolicies::ComputedFieldsPolicy;
@@ -196,10 +198,14 @@ void ProjectionNode::applyExpressions(const Document& root, MutableDocument* out
         } else {
             auto expressionIt = _expressions.find(field);
             invariant(expressionIt != _expressions.end());
-            outputDoc->setField(
-                field,
-                expressionIt->second->evaluate(
-                    root, &expressionIt->second->getExpressionContext()->variables));
+            auto variables = &expressionIt->second->getExpressionContext()->variables;
+            auto compiledIt = _compiledExpressions.find(field);
+            if (compiledIt != _compiledExpressions.end() &&
+                compiledIt->second.getExpression() == expressionIt->second) {
+                outputDoc->setField(field, compiledIt->second.evaluate(root, variables));
+            } else {
+                outputDoc->setField(field, expressionIt->second->evaluate(root, variables));
+            }
         }
     }
 }
@@ -258,8 +264,13 @@ void ProjectionNode::reportComputedPaths(std::set<std::string>* computedPaths,
 }
 
 void ProjectionNode::optimize() {
+    _compiledExpressions.clear();
     for (auto&& expressionIt : _expressions) {
         _expressions[expressionIt.first] = expressionIt.second->optimize();
+        if (internalQueryCompileProjectionExpressions.load()) {
+            _compiledExpressions.emplace(expressionIt.first,
+                                         CompiledExpression::compile(expressionIt.second));
+        }
     }
     for (auto&& childPair : _children) {
         childPair.second->optimize();
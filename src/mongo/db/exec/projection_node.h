@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/projection_executor.h"
+#include "mongo/db/pipeline/expression_compiler.h"
 
 #include "mongo/db/query/projection_policies.h"
 
@@ -162,6 +163,11 @@ protected:
 
     StringMap<std::unique_ptr<ProjectionNode>> _children;
     StringMap<boost::intrusive_ptr<Expression>> _expressions;
+
+    // Compiled forms of '_expressions', populated by optimize() when
+    // 'internalQueryCompileProjectionExpressions' is enabled. An entry is only used while it was
+    // compiled from the expression currently held in '_expressions' for its field.
+    StringMap<CompiledExpression> _compiledExpressions;
     StringSet _projectedFields;
     ProjectionPolicies _policies;
     std::string _pathToNode;
@@ -883,6 +883,25 @@ std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeCopy(bool isSmp) {
     return std::unique_ptr<RuntimeEnvironment>(new RuntimeEnvironment(*this));
 }
 
+std::unique_ptr<RuntimeEnvironment> RuntimeEnvironment::makeDeepCopy() const {
+    auto env = std::make_unique<RuntimeEnvironment>();
+    *env->_state = *_state;
+
+    auto& state = *env->_state;
+    for (size_t idx = 0; idx < state.vals.size(); ++idx) {
+        if (state.owned[idx]) {
+            std::tie(state.typeTags[idx], state.vals[idx]) =
+                copyValue(state.typeTags[idx], state.vals[idx]);
+        }
+    }
+
+    for (auto&& [name, slot] : state.slots) {
+        env->emplaceAccessor(slot.first, slot.second);
+    }
+
+    return env;
+}
+
 void RuntimeEnvironment::debugString(StringBuilder* builder) {
     using namespace std::literals;
 
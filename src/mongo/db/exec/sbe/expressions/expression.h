@@ -157,6 +157,14 @@ public:
      */
     std::unique_ptr<RuntimeEnvironment> makeCopy(bool isSmp);
 
+    /**
+     * Make a copy of this environment which does not share any data with it. Every owned slot value
+     * is copied into the new environment, while unowned values are shared as they are. The new
+     * environment is always a serial one, so its slots can be reset independently from this
+     * environment.
+     */
+    std::unique_ptr<RuntimeEnvironment> makeDeepCopy() const;
+
     /**
      * Dumps all the slots currently defined in this environment into the given string builder.
      */
@@ -1131,6 +1131,9 @@ void Parser::walkGroup(AstQuery& ast) {
         lookupSlots(std::move(ast.nodes[1]->projects)),
         collatorSlotPos ? lookupSlot(std::move(ast.nodes[collatorSlotPos]->identifier))
                         : boost::none,
+        false /* allowDiskUse */,
+        HashAggMergingExprs{},
+        boost::none /* memoryLimit */,
         getCurrentPlanNodeId());
 }
 
@@ -364,6 +364,9 @@ protected:
                             stage_builder::makeFunction(
                                 "max", sbe::makeE<sbe::EVariable>(sbe::value::SlotId{1}))),
                 boost::none, /* optional collator slot */
+                false,       /* allowDiskUse */
+                sbe::HashAggMergingExprs{},
+                boost::none, /* memoryLimit */
                 planNodeId),
             // GROUP with a collator slot.
             sbe::makeS<sbe::HashAggStage>(
@@ -376,6 +379,9 @@ protected:
                             stage_builder::makeFunction(
                                 "max", sbe::makeE<sbe::EVariable>(sbe::value::SlotId{1}))),
                 sbe::value::SlotId{4}, /* optional collator slot */
+                false,       /* allowDiskUse */
+                sbe::HashAggMergingExprs{},
+                boost::none, /* memoryLimit */
                 planNodeId),
             // LIMIT
             sbe::makeS<sbe::LimitSkipStage>(
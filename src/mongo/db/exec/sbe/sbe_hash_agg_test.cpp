@@ -37,6 +37,9 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/temp_dir.h"
 
 namespace mongo::sbe {
 
@@ -82,6 +85,9 @@ TEST_F(HashAggStageTest, HashAggMinMaxTest) {
                    stage_builder::makeFunction(
                        "collMax", collExpr->clone(), makeE<EVariable>(scanSlot))),
             boost::none,
+            false /* allowDiskUse */,
+            HashAggMergingExprs{},
+            boost::none /* memoryLimit */,
             kEmptyPlanNodeId);
 
         auto outSlot = generateSlotId();
@@ -136,6 +142,9 @@ TEST_F(HashAggStageTest, HashAggAddToSetTest) {
                    stage_builder::makeFunction(
                        "collAddToSet", std::move(collExpr), makeE<EVariable>(scanSlot))),
             boost::none,
+            false /* allowDiskUse */,
+            HashAggMergingExprs{},
+            boost::none /* memoryLimit */,
             kEmptyPlanNodeId);
 
         return std::make_pair(hashAggSlot, std::move(hashAggStage));
@@ -220,6 +229,9 @@ TEST_F(HashAggStageTest, HashAggCollationTest) {
                                                makeE<EConstant>(value::TypeTags::NumberInt64,
                                                                 value::bitcastFrom<int64_t>(1)))),
                                     boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                    false /* allowDiskUse */,
+                                    HashAggMergingExprs{},
+                                    boost::none /* memoryLimit */,
                                     kEmptyPlanNodeId);
 
             return std::make_pair(countsSlot, std::move(hashAggStage));
@@ -280,4 +292,163 @@ TEST_F(HashAggStageTest, HashAggCollationTest) {
     }
 }
 
+TEST_F(HashAggStageTest, HashAggSpillsAndMergesSortedRuns) {
+    unittest::TempDir tempDir("HashAggStageTest");
+    storageGlobalParams.dbpath = tempDir.path();
+
+    // Force the hash table to be spilled on every memory check.
+    RAIIServerParameterControllerForTest spillController(
+        "internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill", 1);
+
+    // Feed 10 distinct keys, each repeated 50 times, in an interleaved order so that partial
+    // counts for every key end up in several sorted runs.
+    const int kNumKeys = 10;
+    const int kNumRepeats = 50;
+    BSONArrayBuilder inputBab;
+    for (int i = 0; i < kNumRepeats; ++i) {
+        for (int key = kNumKeys - 1; key >= 0; --key) {
+            inputBab.append(BSON_ARRAY(key));
+        }
+    }
+    auto [inputTag, inputVal] = stage_builder::makeValue(inputBab.arr());
+
+    auto ctx = makeCompileCtx();
+    auto [scanSlots, scanStage] = generateVirtualScanMulti(1, inputTag, inputVal);
+
+    auto countSlot = generateSlotId();
+    auto spilledCountSlot = generateSlotId();
+    HashAggMergingExprs mergingExprs;
+    mergingExprs.emplace(
+        countSlot,
+        std::make_pair(spilledCountSlot,
+                       stage_builder::makeFunction("sum", makeE<EVariable>(spilledCountSlot))));
+    auto stage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlots[0]),
+        makeEM(countSlot,
+               stage_builder::makeFunction(
+                   "sum",
+                   makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1)))),
+        boost::none,
+        true /* allowDiskUse */,
+        std::move(mergingExprs),
+        boost::none /* memoryLimit */,
+        kEmptyPlanNodeId);
+
+    auto resultAccessors = prepareTree(ctx.get(), stage.get(), makeSV(scanSlots[0], countSlot));
+    auto [resultsTag, resultsVal] = getAllResultsMulti(stage.get(), resultAccessors);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+
+    // Once spilled, groups are returned in key order with the partial counts merged.
+    BSONArrayBuilder expectedBab;
+    for (int key = 0; key < kNumKeys; ++key) {
+        expectedBab.append(BSON_ARRAY(key << static_cast<long long>(kNumRepeats)));
+    }
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(expectedBab.arr());
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+    assertValuesEqual(resultsTag, resultsVal, expectedTag, expectedVal);
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_GT(stats->spills, 1u);
+    ASSERT_GT(stats->spilledRecords, static_cast<size_t>(kNumKeys));
+
+    stage->close();
+}
+
+namespace {
+/**
+ * Builds a HashAggStage counting the occurrences of 100 keys, with the given 'allowDiskUse' and
+ * 'memoryLimit', and with a merging expression for the count if 'mergeable' is true.
+ */
+std::unique_ptr<PlanStage> makeCountingHashAgg(HashAggStageTest& test,
+                                               bool allowDiskUse,
+                                               bool mergeable,
+                                               boost::optional<long long> memoryLimit,
+                                               value::SlotId* countSlot) {
+    BSONArrayBuilder inputBab;
+    for (int i = 0; i < 1000; ++i) {
+        inputBab.append(BSON_ARRAY(i % 100));
+    }
+    auto [inputTag, inputVal] = stage_builder::makeValue(inputBab.arr());
+    auto [scanSlots, scanStage] = test.generateVirtualScanMulti(1, inputTag, inputVal);
+
+    *countSlot = test.generateSlotId();
+    HashAggMergingExprs mergingExprs;
+    if (mergeable) {
+        auto spilledCountSlot = test.generateSlotId();
+        mergingExprs.emplace(
+            *countSlot,
+            std::make_pair(spilledCountSlot,
+                           stage_builder::makeFunction("sum", makeE<EVariable>(spilledCountSlot))));
+    }
+    return makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlots[0]),
+        makeEM(*countSlot,
+               stage_builder::makeFunction(
+                   "sum",
+                   makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1)))),
+        boost::none,
+        allowDiskUse,
+        std::move(mergingExprs),
+        memoryLimit,
+        kEmptyPlanNodeId);
+}
+}  // namespace
+
+TEST_F(HashAggStageTest, HashAggFailsWhenExceedingMemoryLimitWithoutAllowDiskUse) {
+    auto ctx = makeCompileCtx();
+    value::SlotId countSlot;
+    auto stage = makeCountingHashAgg(*this, false /* allowDiskUse */, true, 1, &countSlot);
+    prepareTree(ctx.get(), stage.get(), countSlot);
+    ASSERT_THROWS_CODE(
+        stage->open(false), DBException, ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed);
+}
+
+TEST_F(HashAggStageTest, HashAggFailsWhenExceedingMemoryLimitWithoutMergingExprs) {
+    unittest::TempDir tempDir("HashAggStageTest");
+    storageGlobalParams.dbpath = tempDir.path();
+
+    auto ctx = makeCompileCtx();
+    value::SlotId countSlot;
+    auto stage = makeCountingHashAgg(*this, true /* allowDiskUse */, false, 1, &countSlot);
+    prepareTree(ctx.get(), stage.get(), countSlot);
+    ASSERT_THROWS_CODE(stage->open(false), DBException, 5843140);
+}
+
+TEST_F(HashAggStageTest, HashAggHonorsMemoryLimitOverride) {
+    unittest::TempDir tempDir("HashAggStageTest");
+    storageGlobalParams.dbpath = tempDir.path();
+
+    // The knob would never be reached, but the limit given to the stage is.
+    RAIIServerParameterControllerForTest spillController(
+        "internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill",
+        1024 * 1024 * 1024);
+
+    auto ctx = makeCompileCtx();
+    value::SlotId countSlot;
+    auto stage = makeCountingHashAgg(*this, true /* allowDiskUse */, true, 1, &countSlot);
+    auto resultAccessor = prepareTree(ctx.get(), stage.get(), countSlot);
+    auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessor);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    ASSERT_EQ(value::getArrayView(resultsVal)->size(), 100u);
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_GT(stats->spills, 0u);
+}
+
+TEST_F(HashAggStageTest, HashAggDoesNotFailWithinMemoryLimit) {
+    auto ctx = makeCompileCtx();
+    value::SlotId countSlot;
+    auto stage =
+        makeCountingHashAgg(*this, false /* allowDiskUse */, false, boost::none, &countSlot);
+    auto resultAccessor = prepareTree(ctx.get(), stage.get(), countSlot);
+    auto [resultsTag, resultsVal] = getAllResults(stage.get(), resultAccessor);
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    ASSERT_EQ(value::getArrayView(resultsVal)->size(), 100u);
+
+    auto stats = static_cast<const HashAggStats*>(stage->getSpecificStats());
+    ASSERT_EQ(stats->spills, 0u);
+}
+
 }  // namespace mongo::sbe
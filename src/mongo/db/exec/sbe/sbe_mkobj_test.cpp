@@ -298,4 +298,49 @@ TEST_F(MkObjStageTest, MakeObjProjectWithRoot) {
 TEST_F(MkObjStageTest, MakeBsonObjProjectWithRoot) {
     testProjectWithRoot<MakeBsonObjStage>();
 }
+TEST_F(MkObjStageTest, MakeObjRowsOnlyViewedByConsumer) {
+    // When the consumer only views each row, the stage refills the same object for the next row.
+    auto [inputTag, inputVal] = value::makeNewArray();
+    value::ValueGuard inputGuard{inputTag, inputVal};
+    {
+        auto inputView = value::getArrayView(inputVal);
+        addBsonObjToArray(inputView, BSON("a" << 1 << "b" << 2 << "c" << 3 << "d" << 4));
+        addBsonObjToArray(inputView, BSON("b" << 1));
+        addObjectToArray(inputView, BSON("c" << 1 << "d" << 2));
+        addBsonObjToArray(inputView, BSONObj());
+    }
+
+    auto [expectedTag, expectedVal] = stage_builder::makeValue(
+        BSON_ARRAY(BSON("c" << 3 << "d" << 4) << BSONObj() << BSON("c" << 1 << "d" << 2)
+                                              << BSONObj()));
+    value::ValueGuard expectedGuard{expectedTag, expectedVal};
+
+    auto ctx = makeCompileCtx();
+    inputGuard.reset();
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+    auto objOutSlotId = generateSlotId();
+    auto mkobj = makeS<MakeObjStage>(std::move(scanStage),
+                                     objOutSlotId,
+                                     scanSlot,
+                                     MakeObjStage::FieldBehavior::drop,
+                                     std::vector<std::string>{"a", "b"},
+                                     std::vector<std::string>{},
+                                     value::SlotVector{},
+                                     false,  // force new
+                                     false,  // return old
+                                     kEmptyPlanNodeId);
+    auto resultAccessor = prepareTree(ctx.get(), mkobj.get(), objOutSlotId);
+
+    auto [resultsTag, resultsVal] = value::makeNewArray();
+    value::ValueGuard resultsGuard{resultsTag, resultsVal};
+    auto resultsView = value::getArrayView(resultsVal);
+    for (auto st = mkobj->getNext(); st == PlanState::ADVANCED; st = mkobj->getNext()) {
+        auto [tag, val] = resultAccessor->getViewOfValue();
+        auto [copyTag, copyVal] = value::copyValue(tag, val);
+        resultsView->push_back(copyTag, copyVal);
+    }
+    mkobj->close();
+
+    assertValuesEqual(resultsTag, resultsVal, expectedTag, expectedVal);
+}
 }  // namespace mongo::sbe
@@ -0,0 +1,346 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <limits>
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/db/exec/sbe/stages/filter.h"
+#include "mongo/db/exec/sbe/stages/hash_agg.h"
+#include "mongo/db/exec/sbe/stages/project.h"
+#include "mongo/db/exec/sbe/stages/sort.h"
+#include "mongo/db/exec/sbe/values/slot.h"
+#include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/platform/random.h"
+
+namespace mongo::sbe {
+namespace {
+
+/**
+ * How the values of field 'a' of the generated documents are spread. Passed to the benchmarks as
+ * their second argument.
+ */
+enum Distribution : int64_t {
+    // Random values, almost all of them distinct.
+    kUniform,
+    // Increasing values, all of them distinct.
+    kSorted,
+    // Random values out of only 16 distinct ones.
+    kFewDistinct,
+};
+
+const std::vector<std::vector<int64_t>> kRowsAndDistributions = {
+    {1 << 10, 1 << 16}, {kUniform, kSorted, kFewDistinct}};
+
+/**
+ * Returns 'numRows' documents of the shape {a: <int>, b: <int>, s: <string>}, with the values of
+ * 'a' spread according to 'distribution'.
+ */
+std::vector<BSONObj> makeDocuments(int64_t numRows, Distribution distribution) {
+    PseudoRandom random(int64_t{12345});
+    std::vector<BSONObj> docs;
+    docs.reserve(numRows);
+    for (int64_t i = 0; i < numRows; ++i) {
+        int64_t a = 0;
+        switch (distribution) {
+            case kUniform:
+                a = random.nextInt64(numRows);
+                break;
+            case kSorted:
+                a = i;
+                break;
+            case kFewDistinct:
+                a = random.nextInt64(16);
+                break;
+        }
+        docs.push_back(BSON("a" << a << "b" << i << "s"
+                                << "value" + std::to_string(i % 100)));
+    }
+    return docs;
+}
+
+/**
+ * Runs trees of SBE stages over a mock record source: a virtual scan streaming out the generated
+ * documents as BSON objects, as a collection scan would, one per call to getNext().
+ */
+class StageBenchmark {
+public:
+    explicit StageBenchmark(const benchmark::State& state)
+        : _numRows(state.range(0)),
+          _docs(makeDocuments(_numRows, static_cast<Distribution>(state.range(1)))),
+          _opCtx(_serviceContext.makeOperationContext()) {}
+
+    value::SlotId generateSlotId() {
+        return _slotIdGenerator.generate();
+    }
+
+    /**
+     * Returns the slot holding each document and the virtual scan producing them.
+     */
+    std::pair<value::SlotId, std::unique_ptr<PlanStage>> makeScan() {
+        auto [arrTag, arrVal] = value::makeNewArray();
+        auto arr = value::getArrayView(arrVal);
+        arr->reserve(_docs.size());
+        for (auto&& doc : _docs) {
+            auto [tag, val] = value::copyValue(value::TypeTags::bsonObject,
+                                               value::bitcastFrom<const char*>(doc.objdata()));
+            arr->push_back(tag, val);
+        }
+        return stage_builder::generateVirtualScan(&_slotIdGenerator, arrTag, arrVal);
+    }
+
+    /**
+     * Returns an expression reading the field 'name' of the document in 'docSlot'.
+     */
+    static std::unique_ptr<EExpression> getField(value::SlotId docSlot, StringData name) {
+        return stage_builder::makeFunction(
+            "getField", makeE<EVariable>(docSlot), stage_builder::makeConstant(name));
+    }
+
+    /**
+     * Opens 'root' and reads all of its results, reading 'outSlot' of each, once per iteration of
+     * 'state'. Reports the number of rows read from the scan per second.
+     */
+    void run(benchmark::State& state, std::unique_ptr<PlanStage> root, value::SlotId outSlot) {
+        CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+        root->prepare(ctx);
+        root->attachToOperationContext(_opCtx.get());
+        auto accessor = root->getAccessor(ctx, outSlot);
+
+        bool reOpen = false;
+        size_t rowsOut = 0;
+        for (auto keepRunning : state) {
+            root->open(reOpen);
+            reOpen = true;
+            while (root->getNext() == PlanState::ADVANCED) {
+                benchmark::DoNotOptimize(accessor->getViewOfValue());
+                ++rowsOut;
+            }
+        }
+        root->close();
+
+        state.SetItemsProcessed(state.iterations() * _numRows);
+        state.counters["rowsOutPerIteration"] =
+            static_cast<double>(rowsOut) / std::max<int64_t>(state.iterations(), 1);
+    }
+
+private:
+    const int64_t _numRows;
+    const std::vector<BSONObj> _docs;
+
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx;
+    value::SlotIdGenerator _slotIdGenerator;
+};
+
+void BM_Scan(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    bm.run(state, std::move(scan), docSlot);
+}
+
+void BM_Filter(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    auto filter = makeS<FilterStage<false>>(
+        std::move(scan),
+        stage_builder::makeBinaryOp(
+            EPrimBinary::less,
+            StageBenchmark::getField(docSlot, "a"),
+            stage_builder::makeConstant(value::TypeTags::NumberInt64, state.range(0) / 2)),
+        kEmptyPlanNodeId);
+    bm.run(state, std::move(filter), docSlot);
+}
+
+void BM_Project(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    auto sumSlot = bm.generateSlotId();
+    auto project =
+        makeProjectStage(std::move(scan),
+                         kEmptyPlanNodeId,
+                         sumSlot,
+                         stage_builder::makeBinaryOp(EPrimBinary::add,
+                                                     StageBenchmark::getField(docSlot, "a"),
+                                                     StageBenchmark::getField(docSlot, "b")));
+    bm.run(state, std::move(project), sumSlot);
+}
+
+void BM_FilterProject(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    auto filter = makeS<FilterStage<false>>(
+        std::move(scan),
+        stage_builder::makeBinaryOp(
+            EPrimBinary::less,
+            StageBenchmark::getField(docSlot, "a"),
+            stage_builder::makeConstant(value::TypeTags::NumberInt64, state.range(0) / 2)),
+        kEmptyPlanNodeId);
+    auto concatSlot = bm.generateSlotId();
+    auto project = makeProjectStage(std::move(filter),
+                                    kEmptyPlanNodeId,
+                                    concatSlot,
+                                    stage_builder::makeFunction(
+                                        "concat",
+                                        StageBenchmark::getField(docSlot, "s"),
+                                        stage_builder::makeConstant("-suffix"_sd)));
+    bm.run(state, std::move(project), concatSlot);
+}
+
+void BM_HashAgg(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    auto keySlot = bm.generateSlotId();
+    auto project = makeProjectStage(
+        std::move(scan), kEmptyPlanNodeId, keySlot, StageBenchmark::getField(docSlot, "a"));
+    auto sumSlot = bm.generateSlotId();
+    auto hashAgg = makeS<HashAggStage>(
+        std::move(project),
+        makeSV(keySlot),
+        makeEM(sumSlot,
+               stage_builder::makeFunction("sum", StageBenchmark::getField(docSlot, "b"))),
+        boost::none,
+        false /* allowDiskUse */,
+        HashAggMergingExprs{},
+        boost::none /* memoryLimit */,
+        kEmptyPlanNodeId);
+    bm.run(state, std::move(hashAgg), sumSlot);
+}
+
+void BM_Sort(benchmark::State& state) {
+    StageBenchmark bm(state);
+    auto [docSlot, scan] = bm.makeScan();
+    auto keySlot = bm.generateSlotId();
+    auto project = makeProjectStage(
+        std::move(scan), kEmptyPlanNodeId, keySlot, StageBenchmark::getField(docSlot, "a"));
+    auto sort = makeS<SortStage>(std::move(project),
+                                 makeSV(keySlot),
+                                 std::vector<value::SortDirection>{value::SortDirection::Ascending},
+                                 makeSV(docSlot),
+                                 std::numeric_limits<size_t>::max() /* limit */,
+                                 std::numeric_limits<size_t>::max() /* memoryLimit */,
+                                 false /* allowDiskUse */,
+                                 kEmptyPlanNodeId);
+    bm.run(state, std::move(sort), docSlot);
+}
+
+BENCHMARK(BM_Scan)->ArgsProduct(kRowsAndDistributions);
+BENCHMARK(BM_Filter)->ArgsProduct(kRowsAndDistributions);
+BENCHMARK(BM_Project)->ArgsProduct(kRowsAndDistributions);
+BENCHMARK(BM_FilterProject)->ArgsProduct(kRowsAndDistributions);
+BENCHMARK(BM_HashAgg)->ArgsProduct(kRowsAndDistributions);
+BENCHMARK(BM_Sort)->ArgsProduct(kRowsAndDistributions);
+
+/**
+ * Runs the compiled 'expr' once per iteration of 'state', with 'input' in the slot it reads.
+ * Takes ownership of 'input'.
+ */
+void runBuiltin(benchmark::State& state,
+                std::function<std::unique_ptr<EExpression>(value::SlotId)> makeExpr,
+                std::pair<value::TypeTags, value::Value> input) {
+    value::SlotIdGenerator slotIdGenerator;
+    CoScanStage emptyStage{kEmptyPlanNodeId};
+    CompileCtx ctx{std::make_unique<RuntimeEnvironment>()};
+    ctx.root = &emptyStage;
+
+    value::OwnedValueAccessor accessor;
+    auto inputSlot = slotIdGenerator.generate();
+    ctx.pushCorrelated(inputSlot, &accessor);
+    accessor.reset(input.first, input.second);
+
+    auto code = makeExpr(inputSlot)->compile(ctx);
+    vm::ByteCode vm;
+    for (auto keepRunning : state) {
+        auto [owned, tag, val] = vm.run(code.get());
+        benchmark::DoNotOptimize(val);
+        if (owned) {
+            value::releaseValue(tag, val);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+std::pair<value::TypeTags, value::Value> makeDocumentValue() {
+    auto doc = BSON("x" << 1 << "y"
+                        << "two"
+                        << "a" << 3 << "b" << BSON("c" << 4));
+    return value::copyValue(value::TypeTags::bsonObject,
+                            value::bitcastFrom<const char*>(doc.objdata()));
+}
+
+void BM_BuiltinGetField(benchmark::State& state) {
+    runBuiltin(
+        state,
+        [](value::SlotId slot) { return StageBenchmark::getField(slot, "a"); },
+        makeDocumentValue());
+}
+
+void BM_BuiltinAdd(benchmark::State& state) {
+    runBuiltin(
+        state,
+        [](value::SlotId slot) {
+            return stage_builder::makeBinaryOp(EPrimBinary::add,
+                                               makeE<EVariable>(slot),
+                                               stage_builder::makeConstant(
+                                                   value::TypeTags::NumberInt64, int64_t{1}));
+        },
+        {value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(41)});
+}
+
+void BM_BuiltinConcat(benchmark::State& state) {
+    runBuiltin(
+        state,
+        [](value::SlotId slot) {
+            return stage_builder::makeFunction(
+                "concat", makeE<EVariable>(slot), stage_builder::makeConstant("-suffix"_sd));
+        },
+        value::makeNewString("a string long enough not to be stored inline"));
+}
+
+void BM_BuiltinToLower(benchmark::State& state) {
+    runBuiltin(
+        state,
+        [](value::SlotId slot) {
+            return stage_builder::makeFunction("toLower", makeE<EVariable>(slot));
+        },
+        value::makeNewString("A String Long Enough Not To Be Stored Inline"));
+}
+
+BENCHMARK(BM_BuiltinGetField);
+BENCHMARK(BM_BuiltinAdd);
+BENCHMARK(BM_BuiltinConcat);
+BENCHMARK(BM_BuiltinToLower);
+
+}  // namespace
+}  // namespace mongo::sbe
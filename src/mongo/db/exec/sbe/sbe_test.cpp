@@ -385,6 +385,66 @@ TEST(SBEVM, CompareBinData) {
     }
 }
 
+TEST(SBEVM, GetFieldAndFillEmptyWithConstantOperands) {
+    auto obj = BSON("a" << 1);
+    auto objTag = value::TypeTags::bsonObject;
+    auto objVal = value::bitcastFrom<const char*>(obj.objdata());
+    auto [fieldATag, fieldAVal] = value::makeSmallString("a"_sd);
+    auto [fieldBTag, fieldBVal] = value::makeSmallString("b"_sd);
+    const size_t constInstrSize =
+        sizeof(vm::Instruction) + sizeof(value::TypeTags) + sizeof(value::Value);
+    {
+        // The field name is folded into the getField instruction.
+        vm::CodeFragment code;
+        code.appendConstVal(objTag, objVal);
+        code.appendConstVal(fieldATag, fieldAVal);
+        code.appendGetField();
+        ASSERT_EQ(code.instrs().size(), 2 * constInstrSize);
+        ASSERT_EQ(code.stackSize(), 1);
+
+        vm::ByteCode interpreter;
+        auto [owned, tag, val] = interpreter.run(&code);
+
+        ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+        ASSERT_EQ(value::bitcastTo<int32_t>(val), 1);
+        ASSERT_FALSE(owned);
+    }
+    {
+        // The default value appended as its own fragment is folded into the fillEmpty instruction.
+        vm::CodeFragment code;
+        code.appendConstVal(objTag, objVal);
+        code.appendConstVal(fieldBTag, fieldBVal);
+        code.appendGetField();
+        auto defaultCode = std::make_unique<vm::CodeFragment>();
+        defaultCode->appendConstVal(value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(7));
+        code.append(std::move(defaultCode));
+        code.appendFillEmpty();
+        ASSERT_EQ(code.instrs().size(), 3 * constInstrSize);
+        ASSERT_EQ(code.stackSize(), 1);
+
+        vm::ByteCode interpreter;
+        auto [owned, tag, val] = interpreter.run(&code);
+
+        ASSERT_EQ(tag, value::TypeTags::NumberInt32);
+        ASSERT_EQ(value::bitcastTo<int32_t>(val), 7);
+        ASSERT_FALSE(owned);
+    }
+    {
+        // A field name computed at runtime is read from the stack.
+        vm::CodeFragment code;
+        code.appendConstVal(objTag, objVal);
+        code.appendConstVal(fieldATag, fieldAVal);
+        code.appendExists();
+        code.appendGetField();
+        ASSERT_EQ(code.instrs().size(), 2 * constInstrSize + 2 * sizeof(vm::Instruction));
+
+        vm::ByteCode interpreter;
+        auto [owned, tag, val] = interpreter.run(&code);
+
+        ASSERT_EQ(tag, value::TypeTags::Nothing);
+    }
+}
+
 TEST(SBEVM, ConvertBinDataToBsonObj) {
     uint8_t byteArray[] = {1, 2, 3, 4, 5, 6, 7, 8};
     auto originalBinData =
@@ -0,0 +1,481 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe/stages/column_scan.h"
+
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/db/exec/trial_run_tracker.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo::sbe {
+namespace {
+/**
+ * Appends the values of 'fields', which are sorted by path, to 'bob' as nested objects. Consumes
+ * the fields from 'pos' onwards which share the first 'prefixLength' characters of its path.
+ */
+void appendFields(const std::vector<std::pair<StringData, BSONElement>>& fields,
+                  size_t prefixLength,
+                  size_t* pos,
+                  UniqueBSONObjBuilder* bob) {
+    const auto prefix = fields[*pos].first.substr(0, prefixLength);
+    while (*pos < fields.size() && fields[*pos].first.startsWith(prefix)) {
+        const auto rest = fields[*pos].first.substr(prefixLength);
+        const auto dot = rest.find('.');
+        if (dot == std::string::npos) {
+            bob->appendAs(fields[*pos].second, rest);
+            ++*pos;
+        } else {
+            UniqueBSONObjBuilder subBob(bob->subobjStart(rest.substr(0, dot)));
+            appendFields(fields, prefixLength + dot + 1, pos, &subBob);
+        }
+    }
+}
+}  // namespace
+
+ColumnScanStage::ColumnScanStage(CollectionUUID collUuid,
+                                 StringData indexName,
+                                 std::vector<std::string> paths,
+                                 boost::optional<value::SlotId> recordSlot,
+                                 boost::optional<value::SlotId> recordIdSlot,
+                                 value::SlotVector vars,
+                                 PlanYieldPolicy* yieldPolicy,
+                                 PlanNodeId nodeId,
+                                 LockAcquisitionCallback lockAcquisitionCallback)
+    : PlanStage("columnscan"_sd, yieldPolicy, nodeId),
+      _collUuid(collUuid),
+      _indexName(indexName),
+      _paths(std::move(paths)),
+      _recordSlot(recordSlot),
+      _recordIdSlot(recordIdSlot),
+      _vars(std::move(vars)),
+      _lockAcquisitionCallback(std::move(lockAcquisitionCallback)) {
+    invariant(_paths.size() == _vars.size());
+    invariant(std::adjacent_find(_paths.begin(), _paths.end(), std::greater_equal<>()) ==
+              _paths.end());
+}
+
+std::unique_ptr<PlanStage> ColumnScanStage::clone() const {
+    return std::make_unique<ColumnScanStage>(_collUuid,
+                                             _indexName,
+                                             _paths,
+                                             _recordSlot,
+                                             _recordIdSlot,
+                                             _vars,
+                                             _yieldPolicy,
+                                             _commonStats.nodeId,
+                                             _lockAcquisitionCallback);
+}
+
+void ColumnScanStage::prepare(CompileCtx& ctx) {
+    if (_recordSlot) {
+        _recordAccessor = std::make_unique<value::OwnedValueAccessor>();
+    }
+
+    if (_recordIdSlot) {
+        _recordIdAccessor = std::make_unique<value::OwnedValueAccessor>();
+    }
+
+    _accessors.resize(_vars.size());
+    for (size_t idx = 0; idx < _accessors.size(); ++idx) {
+        auto [it, inserted] = _accessorMap.emplace(_vars[idx], &_accessors[idx]);
+        uassert(5963030, str::stream() << "duplicate slot: " << _vars[idx], inserted);
+    }
+
+    std::tie(_collName, _catalogEpoch) =
+        acquireCollection(_opCtx, _collUuid, _lockAcquisitionCallback, _coll);
+
+    auto indexCatalog = _coll->getCollection()->getIndexCatalog();
+    auto indexDesc = indexCatalog->findIndexByName(_opCtx, _indexName);
+    tassert(5963031,
+            str::stream() << "could not find index named '" << _indexName << "' in collection '"
+                          << _collName << "'",
+            indexDesc);
+    tassert(5963032,
+            str::stream() << "index named '" << _indexName << "' is not a columnstore index",
+            indexDesc->getIndexType() == IndexType::INDEX_COLUMN);
+    _weakIndexCatalogEntry = indexCatalog->getEntryShared(indexDesc);
+    auto entry = _weakIndexCatalogEntry.lock();
+    tassert(5963033,
+            str::stream() << "expected IndexCatalogEntry for index named: " << _indexName,
+            static_cast<bool>(entry));
+    _ordering = entry->ordering();
+    _keyStringVersion = entry->accessMethod()->getSortedDataInterface()->getKeyStringVersion();
+
+    _rowSeekKey = ColumnKeyGenerator::makeSeekKey(
+        _keyStringVersion, *_ordering, boost::none /* path */, boost::none /* id */);
+    _rowEndKey = ColumnKeyGenerator::makeEndKey(_keyStringVersion, *_ordering, boost::none);
+    _columns.resize(_paths.size());
+    for (size_t idx = 0; idx < _paths.size(); ++idx) {
+        _columns[idx].path = _paths[idx];
+        _columns[idx].endKey =
+            ColumnKeyGenerator::makeEndKey(_keyStringVersion, *_ordering, _paths[idx]);
+    }
+}
+
+value::SlotAccessor* ColumnScanStage::getAccessor(CompileCtx& ctx, value::SlotId slot) {
+    if (_recordSlot && *_recordSlot == slot) {
+        return _recordAccessor.get();
+    }
+
+    if (_recordIdSlot && *_recordIdSlot == slot) {
+        return _recordIdAccessor.get();
+    }
+
+    if (auto it = _accessorMap.find(slot); it != _accessorMap.end()) {
+        return it->second;
+    }
+
+    return ctx.getAccessor(slot);
+}
+
+void ColumnScanStage::doSaveState() {
+    if (slotsAccessible()) {
+        for (auto& accessor : _accessors) {
+            accessor.makeOwned();
+        }
+    }
+
+    if (_rowCursor) {
+        _rowCursor->save();
+    }
+    for (auto& column : _columns) {
+        if (column.cursor) {
+            column.cursor->save();
+        }
+    }
+
+    _coll.reset();
+}
+
+void ColumnScanStage::restoreCollectionAndIndex() {
+    restoreCollection(_opCtx, _collName, _collUuid, _catalogEpoch, _lockAcquisitionCallback, _coll);
+    auto indexCatalogEntry = _weakIndexCatalogEntry.lock();
+    uassert(ErrorCodes::QueryPlanKilled,
+            str::stream() << "query plan killed :: index '" << _indexName << "' dropped",
+            indexCatalogEntry && !indexCatalogEntry->isDropped());
+}
+
+void ColumnScanStage::doRestoreState() {
+    invariant(_opCtx);
+    invariant(!_coll);
+
+    // If this stage is not currently open, then there is nothing to restore.
+    if (!_open) {
+        return;
+    }
+
+    restoreCollectionAndIndex();
+
+    if (_rowCursor) {
+        _rowCursor->restore();
+    }
+    for (auto& column : _columns) {
+        if (column.cursor) {
+            column.cursor->restore();
+        }
+    }
+}
+
+void ColumnScanStage::doDetachFromOperationContext() {
+    if (_rowCursor) {
+        _rowCursor->detachFromOperationContext();
+    }
+    for (auto& column : _columns) {
+        if (column.cursor) {
+            column.cursor->detachFromOperationContext();
+        }
+    }
+}
+
+void ColumnScanStage::doAttachToOperationContext(OperationContext* opCtx) {
+    if (_rowCursor) {
+        _rowCursor->reattachToOperationContext(opCtx);
+    }
+    for (auto& column : _columns) {
+        if (column.cursor) {
+            column.cursor->reattachToOperationContext(opCtx);
+        }
+    }
+}
+
+void ColumnScanStage::doDetachFromTrialRunTracker() {
+    _tracker = nullptr;
+}
+
+void ColumnScanStage::doAttachToTrialRunTracker(TrialRunTracker* tracker) {
+    _tracker = tracker;
+}
+
+void ColumnScanStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    _commonStats.opens++;
+    invariant(_opCtx);
+
+    if (_open) {
+        tassert(5963034, "reopened ColumnScanStage but reOpen=false", reOpen);
+        tassert(5963035, "ColumnScanStage is open but _coll is not held", _coll);
+        tassert(5963036, "ColumnScanStage is open but don't have _rowCursor", _rowCursor);
+    } else {
+        tassert(5963037, "first open to ColumnScanStage but reOpen=true", !reOpen);
+        if (!_coll) {
+            // We're being opened after 'close()'. We need to re-acquire '_coll' in this case and
+            // make some validity checks (the collection has not been dropped, renamed, etc.).
+            tassert(5963038, "ColumnScanStage is not open but have _rowCursor", !_rowCursor);
+            restoreCollectionAndIndex();
+        }
+    }
+
+    _open = true;
+    _firstGetNext = true;
+
+    auto entry = _weakIndexCatalogEntry.lock();
+    tassert(5963039,
+            str::stream() << "expected IndexCatalogEntry for index named: " << _indexName,
+            static_cast<bool>(entry));
+    auto sdi = entry->accessMethod()->getSortedDataInterface();
+    if (!_rowCursor) {
+        _rowCursor = sdi->newCursor(_opCtx, true /* forward */);
+    }
+    for (auto& column : _columns) {
+        if (!column.cursor) {
+            column.cursor = sdi->newCursor(_opCtx, true /* forward */);
+        }
+        column.recordId = boost::none;
+        column.exhausted = false;
+    }
+}
+
+void ColumnScanStage::advanceColumn(Column& column, const RecordId& recordId) {
+    if (column.exhausted || (column.recordId && *column.recordId >= recordId)) {
+        return;
+    }
+
+    // Documents which have the path tend to be clustered, so step to the next cell before falling
+    // back to a seek over the documents which lack it.
+    boost::optional<KeyStringEntry> entry;
+    if (column.recordId) {
+        entry = column.cursor->nextKeyString();
+        ++_specificStats.numReads;
+    }
+    if (!column.recordId ||
+        (entry && entry->loc < recordId && entry->keyString.compare(column.endKey) < 0)) {
+        entry = column.cursor->seekForKeyString(ColumnKeyGenerator::makeSeekKey(
+            _keyStringVersion, *_ordering, StringData{column.path}, recordId));
+        ++_specificStats.seeks;
+    }
+
+    if (!entry || entry->keyString.compare(column.endKey) >= 0) {
+        column.recordId = boost::none;
+        column.cell = BSONObj();
+        column.value = BSONElement();
+        column.exhausted = true;
+        return;
+    }
+
+    // The cell's key is { '': <path>, '': NumberLong(<record id>), '': <value> }.
+    const auto& keyString = entry->keyString;
+    column.recordId = entry->loc;
+    column.cell = KeyString::toBson(
+        keyString.getBuffer(),
+        KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize()),
+        *_ordering,
+        keyString.getTypeBits());
+    BSONObjIterator it(column.cell);
+    it.next();
+    it.next();
+    column.value = it.next();
+}
+
+void ColumnScanStage::produceRecord() {
+    std::vector<std::pair<StringData, BSONElement>> fields;
+    for (auto& column : _columns) {
+        if (column.recordId && *column.recordId == _recordId) {
+            fields.emplace_back(column.path, column.value);
+        }
+    }
+
+    UniqueBSONObjBuilder bob;
+    if (!fields.empty()) {
+        size_t pos = 0;
+        appendFields(fields, 0, &pos, &bob);
+    }
+    bob.doneFast();
+    char* data = bob.bb().release().release();
+    _recordAccessor->reset(value::TypeTags::bsonObject, value::bitcastFrom<char*>(data));
+}
+
+PlanState ColumnScanStage::getNext() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    // We are about to get next record from a storage cursor so do not bother saving our internal
+    // state in case it yields as the state will be completely overwritten after the call.
+    disableSlotAccess();
+
+    if (!_rowCursor) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    checkForInterrupt(_opCtx);
+
+    boost::optional<KeyStringEntry> row;
+    if (_firstGetNext) {
+        _firstGetNext = false;
+        row = _rowCursor->seekForKeyString(_rowSeekKey);
+        ++_specificStats.seeks;
+    } else {
+        row = _rowCursor->nextKeyString();
+    }
+
+    if (!row || row->keyString.compare(_rowEndKey) >= 0) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+    _recordId = row->loc;
+
+    for (size_t idx = 0; idx < _columns.size(); ++idx) {
+        auto& column = _columns[idx];
+        advanceColumn(column, _recordId);
+        if (column.recordId && *column.recordId == _recordId) {
+            auto [tag, val] = bson::convertFrom(true,
+                                                column.value.rawdata(),
+                                                column.cell.objdata() + column.cell.objsize(),
+                                                0 /* fieldNameSize */);
+            _accessors[idx].reset(false, tag, val);
+        } else {
+            _accessors[idx].reset();
+        }
+    }
+
+    if (_recordAccessor) {
+        produceRecord();
+    }
+
+    if (_recordIdAccessor) {
+        _recordIdAccessor->reset(
+            false, value::TypeTags::RecordId, value::bitcastFrom<int64_t>(_recordId.getLong()));
+    }
+
+    ++_specificStats.numReads;
+    if (_tracker && _tracker->trackProgress<TrialRunTracker::kNumReads>(1)) {
+        // If we're collecting execution stats during multi-planning and reached the end of the
+        // trial period because we've performed enough physical reads, bail out from the trial run
+        // by raising a special exception to signal a runtime planner that this candidate plan has
+        // completed its trial run early.
+        _tracker = nullptr;
+        uasserted(ErrorCodes::QueryTrialRunCompleted, "Trial run early exit in columnscan");
+    }
+    return trackPlanState(PlanState::ADVANCED);
+}
+
+void ColumnScanStage::close() {
+    auto optTimer(getOptTimer(_opCtx));
+
+    trackClose();
+
+    _rowCursor.reset();
+    for (auto& column : _columns) {
+        column.cursor.reset();
+        column.recordId = boost::none;
+        column.cell = BSONObj();
+        column.value = BSONElement();
+    }
+    _coll.reset();
+    _open = false;
+}
+
+std::unique_ptr<PlanStageStats> ColumnScanStage::getStats(bool includeDebugInfo) const {
+    auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<ColumnScanStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        bob.appendNumber("numReads", static_cast<long long>(_specificStats.numReads));
+        bob.appendNumber("seeks", static_cast<long long>(_specificStats.seeks));
+        if (_recordSlot) {
+            bob.appendNumber("recordSlot", static_cast<long long>(*_recordSlot));
+        }
+        if (_recordIdSlot) {
+            bob.appendNumber("recordIdSlot", static_cast<long long>(*_recordIdSlot));
+        }
+        bob.append("paths", _paths);
+        bob.append("outputSlots", _vars);
+        ret->debugInfo = bob.obj();
+    }
+
+    return ret;
+}
+
+const SpecificStats* ColumnScanStage::getSpecificStats() const {
+    return &_specificStats;
+}
+
+std::vector<DebugPrinter::Block> ColumnScanStage::debugPrint() const {
+    auto ret = PlanStage::debugPrint();
+
+    if (_recordSlot) {
+        DebugPrinter::addIdentifier(ret, _recordSlot.get());
+    } else {
+        DebugPrinter::addIdentifier(ret, DebugPrinter::kNoneKeyword);
+    }
+
+    if (_recordIdSlot) {
+        DebugPrinter::addIdentifier(ret, _recordIdSlot.get());
+    } else {
+        DebugPrinter::addIdentifier(ret, DebugPrinter::kNoneKeyword);
+    }
+
+    ret.emplace_back(DebugPrinter::Block("[`"));
+    for (size_t idx = 0; idx < _vars.size(); ++idx) {
+        if (idx) {
+            ret.emplace_back(DebugPrinter::Block("`,"));
+        }
+        DebugPrinter::addIdentifier(ret, _vars[idx]);
+        ret.emplace_back("=");
+        ret.emplace_back(DebugPrinter::Block("\"`"));
+        DebugPrinter::addIdentifier(ret, _paths[idx]);
+        ret.emplace_back(DebugPrinter::Block("`\""));
+    }
+    ret.emplace_back(DebugPrinter::Block("`]"));
+
+    ret.emplace_back("@\"`");
+    DebugPrinter::addIdentifier(ret, _collUuid.toString());
+    ret.emplace_back("`\"");
+
+    ret.emplace_back("@\"`");
+    DebugPrinter::addIdentifier(ret, _indexName);
+    ret.emplace_back("`\"");
+
+    return ret;
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,165 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/exec/sbe/stages/collection_helpers.h"
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/storage/sorted_data_interface.h"
+
+namespace mongo::sbe {
+/**
+ * A stage that reads the documents of a collection through a columnstore index, returning one
+ * result per document. Only the columns of the requested 'paths' are read, so the cost of the
+ * scan depends on the paths it needs rather than on the width of the documents.
+ *
+ * The documents are enumerated by their row markers, in record id order, while one cursor per
+ * path walks that path's column alongside, stepping to the next cell or seeking over a gap of
+ * documents which lack the path.
+ *
+ * The "output" slots are
+ *   - 'recordSlot': an object holding only the requested paths, rebuilt from their values,
+ *   - 'recordIdSlot': a reference that can be used to fetch the entire document, and
+ *   - 'vars': one slot for each of the 'paths', holding its value or Nothing if it is missing.
+ *
+ * The 'paths' must be sorted and distinct, and must be leaves of the documents: a path whose
+ * value is a non-empty object has no cell of its own. The rebuilt object holds its fields in the
+ * order of 'paths' rather than in the order of the original document.
+ */
+class ColumnScanStage final : public PlanStage {
+public:
+    ColumnScanStage(CollectionUUID collUuid,
+                    StringData indexName,
+                    std::vector<std::string> paths,
+                    boost::optional<value::SlotId> recordSlot,
+                    boost::optional<value::SlotId> recordIdSlot,
+                    value::SlotVector vars,
+                    PlanYieldPolicy* yieldPolicy,
+                    PlanNodeId nodeId,
+                    LockAcquisitionCallback lockAcquisitionCallback);
+
+    std::unique_ptr<PlanStage> clone() const final;
+
+    void prepare(CompileCtx& ctx) final;
+    value::SlotAccessor* getAccessor(CompileCtx& ctx, value::SlotId slot) final;
+    void open(bool reOpen) final;
+    PlanState getNext() final;
+    void close() final;
+
+    std::unique_ptr<PlanStageStats> getStats(bool includeDebugInfo) const final;
+    const SpecificStats* getSpecificStats() const final;
+    std::vector<DebugPrinter::Block> debugPrint() const final;
+
+protected:
+    void doSaveState() override;
+    void doRestoreState() override;
+    void doDetachFromOperationContext() override;
+    void doAttachToOperationContext(OperationContext* opCtx) override;
+    void doDetachFromTrialRunTracker() override;
+    void doAttachToTrialRunTracker(TrialRunTracker* tracker) override;
+
+private:
+    /**
+     * The cursor over the column of one path, and the cell it is positioned on.
+     */
+    struct Column {
+        std::string path;
+        // Sorts after every cell of 'path'.
+        KeyString::Value endKey;
+        std::unique_ptr<SortedDataInterface::Cursor> cursor;
+        // The record id and value of the current cell, decoded from its key which 'cell' holds.
+        // No record id means that the cursor is not yet positioned, or has passed the end of the
+        // column if 'exhausted' is set.
+        boost::optional<RecordId> recordId;
+        BSONObj cell;
+        BSONElement value;
+        bool exhausted{false};
+    };
+
+    /**
+     * When this stage is re-opened after being closed, or during yield recovery, called to verify
+     * that the index (and the index's collection) remain valid. If any validity check fails, throws
+     * a UserException that terminates execution of the query.
+     */
+    void restoreCollectionAndIndex();
+
+    /**
+     * Moves the cursor of 'column' to the first of its cells whose record id is not less than
+     * 'recordId'.
+     */
+    void advanceColumn(Column& column, const RecordId& recordId);
+
+    /**
+     * Builds the object for 'recordSlot' from the values of the columns which have a cell for the
+     * current document.
+     */
+    void produceRecord();
+
+    const CollectionUUID _collUuid;
+    const std::string _indexName;
+    const std::vector<std::string> _paths;
+    const boost::optional<value::SlotId> _recordSlot;
+    const boost::optional<value::SlotId> _recordIdSlot;
+    const value::SlotVector _vars;
+
+    NamespaceString _collName;
+    uint64_t _catalogEpoch;
+
+    LockAcquisitionCallback _lockAcquisitionCallback;
+
+    std::unique_ptr<value::OwnedValueAccessor> _recordAccessor;
+    std::unique_ptr<value::OwnedValueAccessor> _recordIdAccessor;
+
+    // One accessor and slot for each path. The accessors are in the same order as the paths.
+    std::vector<value::OwnedValueAccessor> _accessors;
+    value::SlotAccessorMap _accessorMap;
+
+    std::unique_ptr<SortedDataInterface::Cursor> _rowCursor;
+    KeyString::Value _rowSeekKey;
+    KeyString::Value _rowEndKey;
+    std::vector<Column> _columns;
+    RecordId _recordId;
+
+    std::weak_ptr<const IndexCatalogEntry> _weakIndexCatalogEntry;
+    KeyString::Version _keyStringVersion;
+    boost::optional<Ordering> _ordering{boost::none};
+    boost::optional<AutoGetCollectionForReadMaybeLockFree> _coll;
+
+    bool _open{false};
+    bool _firstGetNext{true};
+    ColumnScanStats _specificStats;
+
+    // If provided, used during a trial run to accumulate certain execution stats. Once the trial
+    // run is complete, this pointer is reset to nullptr.
+    TrialRunTracker* _tracker{nullptr};
+};
+}  // namespace mongo::sbe
@@ -31,20 +31,89 @@
 
 #include "mongo/db/exec/sbe/stages/hash_agg.h"
 
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
 
+namespace {
+std::string nextFileName() {
+    static mongo::AtomicWord<unsigned> hashAggFileCounter;
+    return "extsort-hash-agg-sbe." + std::to_string(hashAggFileCounter.fetchAndAdd(1));
+}
+}  // namespace
+
+#include "mongo/db/sorter/sorter.cpp"
+
 namespace mongo {
 namespace sbe {
+namespace {
+// The memory footprint of the hash table is re-estimated at most once per this many input rows,
+// since computing the size of a group is linear in the size of its accumulators.
+constexpr size_t kMemoryCheckInterval = 64;
+
+/**
+ * Orders spilled (key, aggregates) pairs by their group-by keys, honoring the collation if
+ * provided.
+ */
+class SpilledRowComparator {
+public:
+    explicit SpilledRowComparator(const CollatorInterface* collator) : _collator(collator) {}
+
+    int operator()(const std::pair<value::MaterializedRow, value::MaterializedRow>& lhs,
+                   const std::pair<value::MaterializedRow, value::MaterializedRow>& rhs) const {
+        return compareKeys(lhs.first, rhs.first);
+    }
+
+    int compareKeys(const value::MaterializedRow& lhs, const value::MaterializedRow& rhs) const {
+        for (size_t idx = 0; idx < lhs.size(); ++idx) {
+            auto [lhsTag, lhsVal] = lhs.getViewOfValue(idx);
+            auto [rhsTag, rhsVal] = rhs.getViewOfValue(idx);
+            auto [tag, val] = value::compareValue(lhsTag, lhsVal, rhsTag, rhsVal, _collator);
+            auto result = value::bitcastTo<int32_t>(val);
+            if (result) {
+                return result;
+            }
+        }
+        return 0;
+    }
+
+private:
+    const CollatorInterface* _collator;
+};
+}  // namespace
+
 HashAggStage::HashAggStage(std::unique_ptr<PlanStage> input,
                            value::SlotVector gbs,
                            value::SlotMap<std::unique_ptr<EExpression>> aggs,
                            boost::optional<value::SlotId> collatorSlot,
+                           bool allowDiskUse,
+                           HashAggMergingExprs mergingExprs,
+                           boost::optional<long long> memoryLimit,
                            PlanNodeId planNodeId)
     : PlanStage("group"_sd, planNodeId),
       _gbs(std::move(gbs)),
       _aggs(std::move(aggs)),
-      _collatorSlot(collatorSlot) {
+      _collatorSlot(collatorSlot),
+      _allowDiskUse(allowDiskUse),
+      _mergingExprs(std::move(mergingExprs)),
+      _memoryLimitOverride(memoryLimit) {
     _children.emplace_back(std::move(input));
+
+    tassert(5843100,
+            "merging expressions must be provided either for all aggregates or for none",
+            _mergingExprs.empty() || _mergingExprs.size() == _aggs.size());
+}
+
+HashAggStage::~HashAggStage() {
+    _mergeIt.reset();
+    _sortedRuns.clear();
+    if (!_fileName.empty()) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_fileName));
+    }
 }
 
 std::unique_ptr<PlanStage> HashAggStage::clone() const {
@@ -52,8 +121,18 @@ std::unique_ptr<PlanStage> HashAggStage::clone() const {
     for (auto& [k, v] : _aggs) {
         aggs.emplace(k, v->clone());
     }
-    return std::make_unique<HashAggStage>(
-        _children[0]->clone(), _gbs, std::move(aggs), _collatorSlot, _commonStats.nodeId);
+    HashAggMergingExprs mergingExprs;
+    for (auto& [k, v] : _mergingExprs) {
+        mergingExprs.emplace(k, std::make_pair(v.first, v.second->clone()));
+    }
+    return std::make_unique<HashAggStage>(_children[0]->clone(),
+                                          _gbs,
+                                          std::move(aggs),
+                                          _collatorSlot,
+                                          _allowDiskUse,
+                                          std::move(mergingExprs),
+                                          _memoryLimitOverride,
+                                          _commonStats.nodeId);
 }
 
 void HashAggStage::prepare(CompileCtx& ctx) {
@@ -74,8 +153,15 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         uassert(4822827, str::stream() << "duplicate field: " << slot, inserted);
 
         _inKeyAccessors.emplace_back(_children[0]->getAccessor(ctx, slot));
-        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter++));
-        _outAccessors[slot] = _outKeyAccessors.back().get();
+        _outKeyAccessors.emplace_back(std::make_unique<HashKeyAccessor>(_htIt, counter));
+        _outMergedKeyAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_mergedKeyRow, counter));
+        ++counter;
+
+        _outSwitchAccessors.emplace_back(std::make_unique<value::SwitchAccessor>(
+            std::vector<value::SlotAccessor*>{_outKeyAccessors.back().get(),
+                                              _outMergedKeyAccessors.back().get()}));
+        _outAccessors[slot] = _outSwitchAccessors.back().get();
     }
 
     counter = 0;
@@ -87,8 +173,17 @@ void HashAggStage::prepare(CompileCtx& ctx) {
         const auto slotId = slot;
         uassert(4822828, str::stream() << "duplicate field: " << slotId, inserted);
 
-        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter++));
-        _outAccessors[slot] = _outAggAccessors.back().get();
+        _outAggAccessors.emplace_back(std::make_unique<HashAggAccessor>(_htIt, counter));
+        _outMergedAggAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_mergedAggRow, counter));
+        _spilledAggAccessors.emplace_back(std::make_unique<value::MaterializedSingleRowAccessor>(
+            _nextSpilledRow.second, counter));
+        ++counter;
+
+        _outSwitchAccessors.emplace_back(std::make_unique<value::SwitchAccessor>(
+            std::vector<value::SlotAccessor*>{_outAggAccessors.back().get(),
+                                              _outMergedAggAccessors.back().get()}));
+        _outAccessors[slot] = _outSwitchAccessors.back().get();
 
         ctx.root = this;
         ctx.aggExpression = true;
@@ -96,6 +191,24 @@ void HashAggStage::prepare(CompileCtx& ctx) {
 
         _aggCodes.emplace_back(expr->compile(ctx));
         ctx.aggExpression = false;
+
+        if (!_mergingExprs.empty()) {
+            auto mergingIt = _mergingExprs.find(slot);
+            tassert(5843101,
+                    str::stream() << "missing merging expression for aggregate: " << slotId,
+                    mergingIt != _mergingExprs.end());
+            auto& [spilledSlot, mergingExpr] = mergingIt->second;
+
+            // The merging expression accumulates into the merged row and reads the partial
+            // aggregate of the spilled row through the correlated 'spilledSlot'.
+            ctx.pushCorrelated(spilledSlot, _spilledAggAccessors.back().get());
+            ctx.aggExpression = true;
+            ctx.accumulator = _outMergedAggAccessors.back().get();
+
+            _mergingCodes.emplace_back(mergingExpr->compile(ctx));
+            ctx.aggExpression = false;
+            ctx.popCorrelated();
+        }
     }
     _compiled = true;
 }
@@ -121,14 +234,27 @@ void HashAggStage::open(bool reOpen) {
     if (_collatorAccessor) {
         auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
         uassert(5402503, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
-        auto collatorView = value::getCollatorView(collatorVal);
-        const value::MaterializedRowHasher hasher(collatorView);
-        const value::MaterializedRowEq equator(collatorView);
+        _collator = value::getCollatorView(collatorVal);
+        const value::MaterializedRowHasher hasher(_collator);
+        const value::MaterializedRowEq equator(_collator);
         _ht.emplace(0, hasher, equator);
     } else {
         _ht.emplace();
     }
 
+    _memoryLimit = _memoryLimitOverride.value_or(
+        internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill.load());
+    _avgGroupSize = 0;
+    _numSampledGroups = 0;
+    _rowsSinceMemoryCheck = 0;
+    _mergeIt.reset();
+    _sortedRuns.clear();
+    _hasNextSpilledRow = false;
+    if (!_fileName.empty()) {
+        boost::filesystem::remove(_fileName);
+        _fileName.clear();
+    }
+
     while (_children[0]->getNext() == PlanState::ADVANCED) {
         value::MaterializedRow key{_inKeyAccessors.size()};
         // Copy keys in order to do the lookup.
@@ -152,16 +278,139 @@ void HashAggStage::open(bool reOpen) {
             auto [owned, tag, val] = _bytecode.run(_aggCodes[idx].get());
             _outAggAccessors[idx]->reset(owned, tag, val);
         }
+
+        checkMemoryUsageAndSpillIfNecessary(it->first, it->second);
     }
 
     _children[0]->close();
 
+    if (!_sortedRuns.empty()) {
+        // Write out the remainder of the hash table so that all groups are read back from the
+        // sorted runs in key order.
+        if (!_ht->empty()) {
+            spill();
+        }
+
+        _mergeIt.reset(SpilledRowIterator::merge(
+            _sortedRuns, SortOptions(), SpilledRowComparator(_collator)));
+        _hasNextSpilledRow = _mergeIt->more();
+        if (_hasNextSpilledRow) {
+            _nextSpilledRow = _mergeIt->next();
+        }
+    }
+
+    for (auto& accessor : _outSwitchAccessors) {
+        accessor->setIndex(_mergeIt ? 1 : 0);
+    }
+
     _htIt = _ht->end();
 }
 
+void HashAggStage::makeTemporaryFile() {
+    auto tempDir = storageGlobalParams.dbpath + "/_tmp";
+    boost::filesystem::create_directories(tempDir);
+    _fileName = tempDir + "/" + nextFileName();
+    _nextSortedFileWriterOffset = 0;
+}
+
+bool HashAggStage::canSpill() const {
+    // Partial aggregates read back from disk can only be combined if every aggregate has a merging
+    // expression. A pure group-by has no aggregates to combine.
+    return _aggs.empty() || !_mergingExprs.empty();
+}
+
+void HashAggStage::checkMemoryUsageAndSpillIfNecessary(const value::MaterializedRow& key,
+                                                       const value::MaterializedRow& aggs) {
+    if (_numSampledGroups > 0 && ++_rowsSinceMemoryCheck < kMemoryCheckInterval) {
+        return;
+    }
+    _rowsSinceMemoryCheck = 0;
+
+    // The group that has just been updated is used as the sample. Frequently updated groups tend
+    // to have the largest accumulators, so this errs on the side of overestimating the usage.
+    const double groupSize = key.memUsageForSorter() + aggs.memUsageForSorter();
+    _avgGroupSize += (groupSize - _avgGroupSize) / ++_numSampledGroups;
+
+    if (_avgGroupSize * _ht->size() > _memoryLimit) {
+        uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
+                "Exceeded memory limit for $group, but didn't allow external spilling; pass "
+                "allowDiskUse:true to opt in",
+                _allowDiskUse);
+        uassert(5843140,
+                "Exceeded memory limit for $group, and its accumulators cannot be spilled to disk",
+                canSpill());
+        spill();
+    }
+}
+
+void HashAggStage::spill() {
+    if (_fileName.empty()) {
+        makeTemporaryFile();
+    }
+
+    const SpilledRowComparator comp(_collator);
+    std::vector<const TableType::value_type*> groups;
+    groups.reserve(_ht->size());
+    for (auto& group : *_ht) {
+        groups.push_back(&group);
+    }
+    std::sort(groups.begin(), groups.end(), [&](const auto* lhs, const auto* rhs) {
+        return comp.compareKeys(lhs->first, rhs->first) < 0;
+    });
+
+    SortedFileWriter<value::MaterializedRow, value::MaterializedRow> writer(
+        SortOptions().TempDir(storageGlobalParams.dbpath + "/_tmp"),
+        _fileName,
+        _nextSortedFileWriterOffset);
+    for (auto group : groups) {
+        writer.addAlreadySorted(group->first, group->second);
+    }
+    _sortedRuns.emplace_back(writer.done());
+    _nextSortedFileWriterOffset = writer.getFileEndOffset();
+
+    _specificStats.spills++;
+    _specificStats.spilledRecords += groups.size();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementKeysSorted(groups.size());
+    metricsCollector.incrementSorterSpills(1);
+
+    _ht->clear();
+}
+
+PlanState HashAggStage::getNextSpilled() {
+    if (!_hasNextSpilledRow) {
+        return trackPlanState(PlanState::IS_EOF);
+    }
+
+    // The partial aggregates of the first spilled row of a group seed the accumulators.
+    _mergedKeyRow = std::move(_nextSpilledRow.first);
+    _mergedAggRow = std::move(_nextSpilledRow.second);
+    _hasNextSpilledRow = false;
+
+    const SpilledRowComparator comp(_collator);
+    while (_mergeIt->more()) {
+        _nextSpilledRow = _mergeIt->next();
+        if (comp.compareKeys(_mergedKeyRow, _nextSpilledRow.first) != 0) {
+            _hasNextSpilledRow = true;
+            break;
+        }
+
+        for (size_t idx = 0; idx < _mergingCodes.size(); ++idx) {
+            auto [owned, tag, val] = _bytecode.run(_mergingCodes[idx].get());
+            _outMergedAggAccessors[idx]->reset(owned, tag, val);
+        }
+    }
+
+    return trackPlanState(PlanState::ADVANCED);
+}
+
 PlanState HashAggStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
+    if (_mergeIt) {
+        return getNextSpilled();
+    }
+
     if (_htIt == _ht->end()) {
         _htIt = _ht->begin();
     } else {
@@ -177,6 +426,7 @@ PlanState HashAggStage::getNext() {
 
 std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashAggStats>(_specificStats);
 
     if (includeDebugInfo) {
         DebugPrinter printer;
@@ -188,6 +438,18 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
                 childrenBob.append(str::stream() << slot, printer.print(expr->debugPrint()));
             }
         }
+        if (!_mergingExprs.empty()) {
+            BSONObjBuilder childrenBob(bob.subobjStart("mergingExprs"));
+            for (auto&& [slot, mergingExpr] : _mergingExprs) {
+                childrenBob.append(str::stream() << slot,
+                                   printer.print(mergingExpr.second->debugPrint()));
+            }
+        }
+        bob.appendBool("allowDiskUse", _allowDiskUse);
+        bob.appendBool("usedDisk", _specificStats.spills > 0);
+        bob.appendNumber("spills", static_cast<long long>(_specificStats.spills));
+        bob.appendNumber("spilledRecords",
+                         static_cast<long long>(_specificStats.spilledRecords));
         ret->debugInfo = bob.obj();
     }
 
@@ -196,7 +458,7 @@ std::unique_ptr<PlanStageStats> HashAggStage::getStats(bool includeDebugInfo) co
 }
 
 const SpecificStats* HashAggStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 void HashAggStage::close() {
@@ -204,6 +466,13 @@ void HashAggStage::close() {
 
     trackClose();
     _ht = boost::none;
+
+    _mergeIt.reset();
+    _sortedRuns.clear();
+    if (!_fileName.empty()) {
+        boost::filesystem::remove(_fileName);
+        _fileName.clear();
+    }
 }
 
 std::vector<DebugPrinter::Block> HashAggStage::debugPrint() const {
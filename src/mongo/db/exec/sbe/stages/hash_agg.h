@@ -36,16 +36,46 @@
 #include "mongo/db/exec/sbe/vm/vm.h"
 #include "mongo/stdx/unordered_map.h"
 
+namespace mongo {
+template <typename Key, typename Value>
+class SortIteratorInterface;
+}  // namespace mongo
+
 namespace mongo {
 namespace sbe {
+/**
+ * Maps the output slot of an aggregate to a pair of (1) the slot through which a partial aggregate
+ * value read back from disk is made visible and (2) the expression which folds that partial value
+ * into the accumulator held in the output slot.
+ */
+using HashAggMergingExprs =
+    value::SlotMap<std::pair<value::SlotId, std::unique_ptr<EExpression>>>;
+
+/**
+ * Performs a hash-based aggregation. The input is consumed in full during open() and grouped by
+ * the values of the 'gbs' slots, with each of the 'aggs' expressions accumulated per group.
+ *
+ * The estimated size of the hash table is limited to 'memoryLimit' bytes, or if none is given, to
+ * 'internalQuerySlotBasedExecutionHashAggApproxMemoryUseInBytesBeforeSpill'. If 'allowDiskUse' is
+ * true and a merging expression is provided for every aggregate, the stage spills the hash table
+ * to disk as a sorted run whenever it exceeds the limit. The sorted runs are merged on getNext(),
+ * and partial aggregates that belong to the same group are combined using 'mergingExprs'. When the
+ * stage has spilled, groups are returned in the order of their keys. If the stage cannot spill,
+ * exceeding the limit fails the query.
+ */
 class HashAggStage final : public PlanStage {
 public:
     HashAggStage(std::unique_ptr<PlanStage> input,
                  value::SlotVector gbs,
                  value::SlotMap<std::unique_ptr<EExpression>> aggs,
                  boost::optional<value::SlotId> collatorSlot,
+                 bool allowDiskUse,
+                 HashAggMergingExprs mergingExprs,
+                 boost::optional<long long> memoryLimit,
                  PlanNodeId planNodeId);
 
+    ~HashAggStage();
+
     std::unique_ptr<PlanStage> clone() const final;
 
     void prepare(CompileCtx& ctx) final;
@@ -59,6 +89,13 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
 
 private:
+    void makeTemporaryFile();
+    void spill();
+    bool canSpill() const;
+    void checkMemoryUsageAndSpillIfNecessary(const value::MaterializedRow& key,
+                                             const value::MaterializedRow& aggs);
+    PlanState getNextSpilled();
+
     using TableType = stdx::unordered_map<value::MaterializedRow,
                                           value::MaterializedRow,
                                           value::MaterializedRowHasher,
@@ -67,23 +104,60 @@ private:
     using HashKeyAccessor = value::MaterializedRowKeyAccessor<TableType::iterator>;
     using HashAggAccessor = value::MaterializedRowValueAccessor<TableType::iterator>;
 
+    using SpilledRow = std::pair<value::MaterializedRow, value::MaterializedRow>;
+    using SpilledRowIterator = SortIteratorInterface<value::MaterializedRow, value::MaterializedRow>;
+
     const value::SlotVector _gbs;
     const value::SlotMap<std::unique_ptr<EExpression>> _aggs;
     const boost::optional<value::SlotId> _collatorSlot;
+    const bool _allowDiskUse;
+    const HashAggMergingExprs _mergingExprs;
+    const boost::optional<long long> _memoryLimitOverride;
 
     value::SlotAccessorMap _outAccessors;
     std::vector<value::SlotAccessor*> _inKeyAccessors;
-    std::vector<std::unique_ptr<HashKeyAccessor>> _outKeyAccessors;
 
+    // Each output slot is served by a switch accessor which selects between the hash table
+    // accessors (index 0) and the accessors over the current merged row (index 1).
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _outSwitchAccessors;
+
+    std::vector<std::unique_ptr<HashKeyAccessor>> _outKeyAccessors;
     std::vector<std::unique_ptr<HashAggAccessor>> _outAggAccessors;
     std::vector<std::unique_ptr<vm::CodeFragment>> _aggCodes;
 
+    // Accessors over the group currently produced from the merged sorted runs, and the accessors
+    // through which the partial aggregates of the next spilled row are visible to '_mergingCodes'.
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _outMergedKeyAccessors;
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _outMergedAggAccessors;
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _spilledAggAccessors;
+    std::vector<std::unique_ptr<vm::CodeFragment>> _mergingCodes;
+
     // Only set if collator slot provided on construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
+    CollatorInterface* _collator = nullptr;
 
     boost::optional<TableType> _ht;
     TableType::iterator _htIt;
 
+    // Approximate hash table memory usage, which is estimated from the average footprint of the
+    // groups sampled so far multiplied by the number of groups in the table.
+    long long _memoryLimit = 0;
+    double _avgGroupSize = 0;
+    size_t _numSampledGroups = 0;
+    size_t _rowsSinceMemoryCheck = 0;
+
+    // State of the spilled sorted runs. All runs share a single temporary file.
+    std::string _fileName;
+    std::streampos _nextSortedFileWriterOffset = 0;
+    std::vector<std::shared_ptr<SpilledRowIterator>> _sortedRuns;
+    std::unique_ptr<SpilledRowIterator> _mergeIt;
+    value::MaterializedRow _mergedKeyRow;
+    value::MaterializedRow _mergedAggRow;
+    SpilledRow _nextSpilledRow;
+    bool _hasNextSpilledRow = false;
+
+    HashAggStats _specificStats;
+
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
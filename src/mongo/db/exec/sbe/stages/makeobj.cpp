@@ -136,12 +136,21 @@ void MakeObjStageBase<O>::open(bool reOpen) {
 
 template <>
 void MakeObjStageBase<MakeObjOutputType::object>::produceObject() {
-    auto [tag, val] = value::makeNewObject();
-    auto obj = value::getObjectView(val);
+    // The object produced for the previous row is reused when this stage still owns it, i.e. when
+    // the consumer only viewed it. Clearing it keeps the storage of its vectors, so that producing
+    // a row does not allocate a new object and grow its vectors again.
+    value::Object* obj;
+    if (auto [prevTag, prevVal] = _obj.getViewOfValue();
+        _obj.isOwned() && prevTag == value::TypeTags::Object) {
+        obj = value::getObjectView(prevVal);
+        obj->clear();
+    } else {
+        auto [tag, val] = value::makeNewObject();
+        obj = value::getObjectView(val);
+        _obj.reset(tag, val);
+    }
     resetAlreadyProjected();
 
-    _obj.reset(tag, val);
-
     if (_root) {
         auto [tag, val] = _root->getViewOfValue();
 
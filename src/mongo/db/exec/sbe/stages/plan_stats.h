@@ -103,6 +103,23 @@ struct IndexScanStats final : public SpecificStats {
     size_t seeks{0};
 };
 
+struct ColumnScanStats final : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<ColumnScanStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        stats.totalKeysExamined += numReads;
+    }
+
+    size_t numReads{0};
+    size_t seeks{0};
+};
+
 struct FilterStats final : public SpecificStats {
     std::unique_ptr<SpecificStats> clone() const final {
         return std::make_unique<FilterStats>(*this);
@@ -195,6 +212,27 @@ struct TraverseStats : public SpecificStats {
     size_t innerCloses{0};
 };
 
+struct HashAggStats : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashAggStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void accumulate(PlanSummaryStats& stats) const final {
+        if (spills > 0) {
+            stats.usedDisk = true;
+        }
+    }
+
+    // The number of times the hash table was written out to disk as a sorted run.
+    size_t spills{0};
+    // The number of groups written out to disk across all spills.
+    size_t spilledRecords{0};
+};
+
 /**
  * Calculates the total number of physical reads in the given plan stats tree. If a stage can do
  * a physical read (e.g. COLLSCAN or IXSCAN), then its 'numReads' stats is added to the total.
@@ -337,7 +337,7 @@ public:
     }
 
 protected:
-    PlanYieldPolicy* const _yieldPolicy{nullptr};
+    PlanYieldPolicy* _yieldPolicy{nullptr};
 
 private:
     static const int kInterruptCheckPeriod = 128;
@@ -365,6 +365,20 @@ public:
      */
     virtual std::unique_ptr<PlanStage> clone() const = 0;
 
+    /**
+     * Points every stage of this tree which has yielding enabled at 'yieldPolicy' instead of the
+     * policy it was built with. Stages with yielding disabled are left as they are. This is used to
+     * hand a tree cloned from a cached plan over to the operation which is going to execute it.
+     */
+    void setYieldPolicy(PlanYieldPolicy* yieldPolicy) {
+        if (_yieldPolicy) {
+            _yieldPolicy = yieldPolicy;
+        }
+        for (auto&& child : _children) {
+            child->setYieldPolicy(yieldPolicy);
+        }
+    }
+
     /**
      * Prepare this SBE PlanStage tree for execution. Must be called once, and must be called
      * prior to open(), getNext(), close(), saveState(), or restoreState(),
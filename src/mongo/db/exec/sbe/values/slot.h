@@ -195,6 +195,10 @@ public:
         _owned = true;
     }
 
+    bool isOwned() const {
+        return _owned;
+    }
+
 private:
     void release() {
         if (_owned) {
@@ -437,8 +437,11 @@ public:
         if (tag != TypeTags::Nothing) {
             ValueGuard guard{tag, val};
             // Reserve space in all vectors, they are the same size. We arbitrarily picked _typeTags
-            // to determine the size.
-            reserve(_typeTags.size() + 1);
+            // to determine the size. The capacity is doubled rather than grown by one so that
+            // appending fields does not reallocate all three vectors every time.
+            if (_typeTags.size() == _typeTags.capacity()) {
+                reserve(_typeTags.size() * 2);
+            }
             _names.emplace_back(std::string(name));
 
             _typeTags.push_back(tag);
@@ -481,6 +484,19 @@ public:
         _names.reserve(s);
     }
 
+    /**
+     * Releases all the fields but keeps the storage of the object, so that it can be filled again
+     * without allocating.
+     */
+    void clear() noexcept {
+        for (size_t idx = 0; idx < _typeTags.size(); ++idx) {
+            releaseValue(_typeTags[idx], _values[idx]);
+        }
+        _typeTags.clear();
+        _values.clear();
+        _names.clear();
+    }
+
 private:
     std::vector<TypeTags> _typeTags;
     std::vector<Value> _values;
@@ -514,8 +530,11 @@ public:
         if (tag != TypeTags::Nothing) {
             ValueGuard guard{tag, val};
             // Reserve space in all vectors, they are the same size. We arbitrarily picked _typeTags
-            // to determine the size.
-            reserve(_typeTags.size() + 1);
+            // to determine the size. The capacity is doubled rather than grown by one so that
+            // appending elements does not reallocate both vectors every time.
+            if (_typeTags.size() == _typeTags.capacity()) {
+                reserve(_typeTags.size() * 2);
+            }
 
             _typeTags.push_back(tag);
             _values.push_back(val);
@@ -104,6 +104,9 @@ int Instruction::stackOffset[Instruction::Tags::lastInstruction] = {
     -1,  // getElement
     -1,  // collComparisonKey
 
+    0,  // fillEmptyImm
+    0,  // getFieldImm
+
     -1,  // aggSum
     -1,  // aggMin
     -1,  // aggMax
@@ -188,9 +191,16 @@ void CodeFragment::append(std::unique_ptr<CodeFragment> code) {
     // Fixup before copying.
     code->fixup(_stackSize);
 
+    auto oldSize = _instrs.size();
     copyCodeAndFixup(*code);
 
     _stackSize += code->_stackSize;
+
+    if (code->_lastConstValOffset && *code->_lastConstValOffset == 0) {
+        _lastConstValOffset = oldSize;
+    } else if (!code->_instrs.empty()) {
+        _lastConstValOffset = boost::none;
+    }
 }
 
 void CodeFragment::append(std::unique_ptr<CodeFragment> lhs, std::unique_ptr<CodeFragment> rhs) {
@@ -204,6 +214,9 @@ void CodeFragment::append(std::unique_ptr<CodeFragment> lhs, std::unique_ptr<Cod
     copyCodeAndFixup(*rhs);
 
     _stackSize += lhs->_stackSize;
+
+    // The end of 'rhs' is the target of a jump out of 'lhs'.
+    _lastConstValOffset = boost::none;
 }
 
 void CodeFragment::appendConstVal(value::TypeTags tag, value::Value val) {
@@ -211,11 +224,39 @@ void CodeFragment::appendConstVal(value::TypeTags tag, value::Value val) {
     i.tag = Instruction::pushConstVal;
     adjustStackSimple(i);
 
+    auto constValOffset = _instrs.size();
     auto offset = allocateSpace(sizeof(Instruction) + sizeof(tag) + sizeof(val));
 
     offset += writeToMemory(offset, i);
     offset += writeToMemory(offset, tag);
     offset += writeToMemory(offset, val);
+
+    _lastConstValOffset = constValOffset;
+}
+
+void CodeFragment::appendFusedWithConstVal(Instruction::Tags tag, Instruction::Tags fallbackTag) {
+    if (!_lastConstValOffset) {
+        appendSimpleInstruction(fallbackTag);
+        return;
+    }
+
+    // Replace the pushConstVal with 'tag', keeping the constant as its operand. The stack is one
+    // value shorter than it was after pushing the constant.
+    auto constValPtr = _instrs.data() + *_lastConstValOffset + sizeof(Instruction);
+    auto constTag = readFromMemory<value::TypeTags>(constValPtr);
+    auto constVal = readFromMemory<value::Value>(constValPtr + sizeof(constTag));
+    _instrs.resize(*_lastConstValOffset);
+    _stackSize -= Instruction::stackOffset[Instruction::pushConstVal];
+
+    Instruction i;
+    i.tag = tag;
+    adjustStackSimple(i);
+
+    auto offset = allocateSpace(sizeof(Instruction) + sizeof(constTag) + sizeof(constVal));
+
+    offset += writeToMemory(offset, i);
+    offset += writeToMemory(offset, constTag);
+    offset += writeToMemory(offset, constVal);
 }
 
 void CodeFragment::appendAccessVal(value::SlotAccessor* accessor) {
@@ -307,8 +348,12 @@ void CodeFragment::appendSimpleInstruction(Instruction::Tags tag) {
     offset += writeToMemory(offset, i);
 }
 
+void CodeFragment::appendFillEmpty() {
+    appendFusedWithConstVal(Instruction::fillEmptyImm, Instruction::fillEmpty);
+}
+
 void CodeFragment::appendGetField() {
-    appendSimpleInstruction(Instruction::getField);
+    appendFusedWithConstVal(Instruction::getFieldImm, Instruction::getField);
 }
 
 void CodeFragment::appendGetElement() {
@@ -3758,6 +3803,40 @@ std::tuple<uint8_t, value::TypeTags, value::Value> ByteCode::run(const CodeFragm
                     }
                     break;
                 }
+                case Instruction::fillEmptyImm: {
+                    auto rhsTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(rhsTag);
+                    auto rhsVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(rhsVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    if (lhsTag == value::TypeTags::Nothing) {
+                        topStack(false, rhsTag, rhsVal);
+
+                        if (lhsOwned) {
+                            value::releaseValue(lhsTag, lhsVal);
+                        }
+                    }
+                    break;
+                }
+                case Instruction::getFieldImm: {
+                    auto rhsTag = readFromMemory<value::TypeTags>(pcPointer);
+                    pcPointer += sizeof(rhsTag);
+                    auto rhsVal = readFromMemory<value::Value>(pcPointer);
+                    pcPointer += sizeof(rhsVal);
+
+                    auto [lhsOwned, lhsTag, lhsVal] = getFromStack(0);
+
+                    auto [owned, tag, val] = getField(lhsTag, lhsVal, rhsTag, rhsVal);
+
+                    topStack(owned, tag, val);
+
+                    if (lhsOwned) {
+                        value::releaseValue(lhsTag, lhsVal);
+                    }
+                    break;
+                }
                 case Instruction::getElement: {
                     auto [rhsOwned, rhsTag, rhsVal] = getFromStack(0);
                     popStack();
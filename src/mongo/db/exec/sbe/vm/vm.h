@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -221,6 +222,12 @@ struct Instruction {
         getElement,
         collComparisonKey,
 
+        // Variants of fillEmpty and getField which read their second operand from a constant
+        // encoded in the instruction rather than from the stack. CodeFragment emits them in place
+        // of a pushConstVal directly followed by fillEmpty or getField.
+        fillEmptyImm,
+        getFieldImm,
+
         aggSum,
         aggMin,
         aggMax,
@@ -424,9 +431,7 @@ public:
     void appendCollCmp3w() {
         appendSimpleInstruction(Instruction::collCmp3w);
     }
-    void appendFillEmpty() {
-        appendSimpleInstruction(Instruction::fillEmpty);
-    }
+    void appendFillEmpty();
     void appendGetField();
     void appendGetElement();
     void appendCollComparisonKey();
@@ -465,9 +470,18 @@ public:
 
 private:
     void appendSimpleInstruction(Instruction::Tags tag);
+
+    /**
+     * Appends 'tag', reading its second operand from the constant pushed by the last instruction
+     * of this fragment when it is a pushConstVal. Otherwise appends 'fallbackTag', which reads it
+     * from the stack.
+     */
+    void appendFusedWithConstVal(Instruction::Tags tag, Instruction::Tags fallbackTag);
+
     auto allocateSpace(size_t size) {
         auto oldSize = _instrs.size();
         _instrs.resize(oldSize + size);
+        _lastConstValOffset = boost::none;
         return _instrs.data() + oldSize;
     }
 
@@ -491,6 +505,11 @@ private:
     std::vector<FixUp> _fixUps;
 
     size_t _stackSize{0};
+
+    // Offset of the last instruction of this fragment when it is a pushConstVal. It is only tracked
+    // for constants pushed by this fragment or by a fragment appended holding just that constant,
+    // so no jump can target the end of the constant.
+    boost::optional<size_t> _lastConstValOffset;
 };
 
 class ByteCode {
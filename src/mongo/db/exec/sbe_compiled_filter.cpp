@@ -0,0 +1,159 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/sbe_compiled_filter.h"
+
+#include "mongo/db/exec/filter.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/sbe_stage_builder_filter.h"
+#include "mongo/db/query/sbe_stage_builder_helpers.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+
+std::unique_ptr<SbeCompiledFilter> SbeCompiledFilter::compile(ExpressionContext* expCtx,
+                                                              const MatchExpression* filter) {
+    if (!filter || !internalQueryCompileClassicFiltersToSbe.load() || !canCompile(filter)) {
+        return nullptr;
+    }
+    return std::make_unique<SbeCompiledFilter>(expCtx->opCtx, filter, expCtx->getCollator());
+}
+
+bool SbeCompiledFilter::canCompile(const MatchExpression* filter) {
+    switch (filter->matchType()) {
+        case MatchExpression::AND:
+        case MatchExpression::OR:
+        case MatchExpression::NOR:
+        case MatchExpression::NOT:
+        case MatchExpression::ELEM_MATCH_OBJECT:
+        case MatchExpression::ELEM_MATCH_VALUE:
+        case MatchExpression::SIZE:
+        case MatchExpression::EQ:
+        case MatchExpression::LTE:
+        case MatchExpression::LT:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+        case MatchExpression::REGEX:
+        case MatchExpression::MOD:
+        case MatchExpression::EXISTS:
+        case MatchExpression::MATCH_IN:
+        case MatchExpression::BITS_ALL_SET:
+        case MatchExpression::BITS_ALL_CLEAR:
+        case MatchExpression::BITS_ANY_SET:
+        case MatchExpression::BITS_ANY_CLEAR:
+        case MatchExpression::TYPE_OPERATOR:
+        case MatchExpression::ALWAYS_FALSE:
+        case MatchExpression::ALWAYS_TRUE:
+            break;
+        default:
+            // $expr and the $_internalExpr comparisons which come with it read variables from the
+            // runtime environment of a full SBE plan, $where runs JavaScript, and the stage
+            // builder does not support the rest.
+            return false;
+    }
+
+    for (size_t i = 0; i < filter->numChildren(); ++i) {
+        if (!canCompile(filter->getChild(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SbeCompiledFilter::SbeCompiledFilter(OperationContext* opCtx,
+                                     const MatchExpression* filter,
+                                     const CollatorInterface* collator)
+    : _filter(filter) {
+    sbe::value::SlotIdGenerator slotIdGenerator;
+    sbe::value::FrameIdGenerator frameIdGenerator;
+
+    auto env = std::make_unique<sbe::RuntimeEnvironment>();
+    _env = env.get();
+    _inputSlot = _env->registerSlot(
+        "filterInput"_sd, sbe::value::TypeTags::Nothing, 0, false, &slotIdGenerator);
+    if (collator) {
+        _env->registerSlot("collator"_sd,
+                           sbe::value::TypeTags::collator,
+                           sbe::value::bitcastFrom<const CollatorInterface*>(collator),
+                           false,
+                           &slotIdGenerator);
+    }
+
+    // The filter reads the document from the runtime environment, so it only needs a single row
+    // from its input stage.
+    auto [resultSlot, stage] =
+        stage_builder::generateFilter(opCtx,
+                                      filter,
+                                      stage_builder::makeLimitCoScanTree(kEmptyPlanNodeId),
+                                      &slotIdGenerator,
+                                      &frameIdGenerator,
+                                      _inputSlot,
+                                      _env,
+                                      sbe::makeSV(),
+                                      kEmptyPlanNodeId);
+    invariant(!resultSlot);
+    _root = std::move(stage);
+
+    _ctx = std::make_unique<sbe::CompileCtx>(std::move(env));
+    _root->attachToOperationContext(opCtx);
+    _root->prepare(*_ctx);
+}
+
+bool SbeCompiledFilter::passes(WorkingSetMember* wsm) {
+    if (!wsm->hasObj()) {
+        return Filter::passes(wsm, _filter);
+    }
+
+    // The document is only read while the plan runs, so the slot does not need to own it.
+    auto obj = wsm->doc.value().toBson();
+    _env->resetSlot(_inputSlot,
+                        sbe::value::TypeTags::bsonObject,
+                        sbe::value::bitcastFrom<const char*>(obj.objdata()),
+                        false);
+    ON_BLOCK_EXIT([&] {
+        _root->close();
+        _env->resetSlot(_inputSlot, sbe::value::TypeTags::Nothing, 0, false);
+    });
+
+    _root->open(false);
+    return _root->getNext() == sbe::PlanState::ADVANCED;
+}
+
+void SbeCompiledFilter::detachFromOperationContext() {
+    _root->detachFromOperationContext();
+}
+
+void SbeCompiledFilter::reattachToOperationContext(OperationContext* opCtx) {
+    _root->attachToOperationContext(opCtx);
+}
+
+}  // namespace mongo
@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/exec/sbe/expressions/expression.h"
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/exec/working_set.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+class ExpressionContext;
+
+/**
+ * Evaluates the filter of a classic plan stage with an SBE plan compiled from its MatchExpression,
+ * rather than by walking the MatchExpression for every document. The SBE plan reads the document
+ * from a slot of its runtime environment and returns a row only if the document matches.
+ */
+class SbeCompiledFilter {
+public:
+    /**
+     * Returns a compiled version of 'filter', or nullptr if 'filter' is null, if compiling
+     * classic filters is disabled by 'internalQueryCompileClassicFiltersToSbe', or if 'filter'
+     * contains a match expression which the SBE stage builder cannot compile on its own.
+     */
+    static std::unique_ptr<SbeCompiledFilter> compile(ExpressionContext* expCtx,
+                                                      const MatchExpression* filter);
+
+    /**
+     * Returns whether every node of 'filter' can be compiled into an SBE plan which only depends
+     * on the document it filters.
+     */
+    static bool canCompile(const MatchExpression* filter);
+
+    SbeCompiledFilter(OperationContext* opCtx,
+                      const MatchExpression* filter,
+                      const CollatorInterface* collator);
+
+    /**
+     * Returns whether 'wsm' satisfies the filter. Members which only hold index keys are matched
+     * against the MatchExpression itself.
+     */
+    bool passes(WorkingSetMember* wsm);
+
+    void detachFromOperationContext();
+    void reattachToOperationContext(OperationContext* opCtx);
+
+private:
+    const MatchExpression* _filter;
+
+    // Owned by '_ctx'.
+    sbe::RuntimeEnvironment* _env;
+    sbe::value::SlotId _inputSlot;
+
+    std::unique_ptr<sbe::CompileCtx> _ctx;
+    std::unique_ptr<sbe::PlanStage> _root;
+};
+
+}  // namespace mongo
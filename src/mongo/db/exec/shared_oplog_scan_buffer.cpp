@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_scan_buffer.h"
+
+#include <algorithm>
+
+#include "mongo/base/counter.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo {
+namespace {
+
+const auto getSharedOplogScanBuffer = ServiceContext::declareDecoration<SharedOplogScanBuffer>();
+
+Counter64 entriesBuffered;
+Counter64 entriesRead;
+
+ServerStatusMetricField<Counter64> displayEntriesBuffered("query.sharedOplogScan.entriesBuffered",
+                                                          &entriesBuffered);
+ServerStatusMetricField<Counter64> displayEntriesRead("query.sharedOplogScan.entriesRead",
+                                                      &entriesRead);
+
+bool lessThanId(const SharedOplogScanBuffer::Entry& entry, const RecordId& id) {
+    return entry.id < id;
+}
+
+}  // namespace
+
+SharedOplogScanBuffer& SharedOplogScanBuffer::get(ServiceContext* serviceContext) {
+    return getSharedOplogScanBuffer(serviceContext);
+}
+
+void SharedOplogScanBuffer::append(const UUID& oplogUUID,
+                                   const RecordId& prevId,
+                                   const RecordId& id,
+                                   BSONObj obj) {
+    invariant(obj.isOwned());
+    const long long maxBytes = internalQuerySharedOplogScanBufferMaxBytes.load();
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_oplogUUID != oplogUUID) {
+        _oplogUUID = oplogUUID;
+        _entries.clear();
+        _bytes = 0;
+    }
+
+    if (!_entries.empty() && _entries.back().id != prevId) {
+        if (prevId.isNull() || prevId < _entries.back().id) {
+            // Either this entry is already buffered, or we cannot tell whether it follows the
+            // last buffered entry.
+            return;
+        }
+        // Every buffered entry is older than what this scan has already read, so start over.
+        _entries.clear();
+        _bytes = 0;
+    }
+
+    _bytes += obj.objsize();
+    _entries.push_back({id, std::move(obj)});
+    entriesBuffered.increment();
+
+    while (_bytes > maxBytes && !_entries.empty()) {
+        _bytes -= _entries.front().obj.objsize();
+        _entries.pop_front();
+    }
+}
+
+size_t SharedOplogScanBuffer::readAfter(const UUID& oplogUUID,
+                                        const RecordId& afterId,
+                                        const RecordId& maxId,
+                                        size_t limit,
+                                        std::deque<Entry>* out) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_oplogUUID != oplogUUID) {
+        return 0;
+    }
+
+    auto it = std::lower_bound(_entries.begin(), _entries.end(), afterId, lessThanId);
+    if (it == _entries.end() || it->id != afterId) {
+        return 0;
+    }
+
+    size_t numRead = 0;
+    for (++it; it != _entries.end() && it->id <= maxId && numRead < limit; ++it, ++numRead) {
+        out->push_back(*it);
+    }
+    entriesRead.increment(numRead);
+    return numRead;
+}
+
+}  // namespace mongo
@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class ServiceContext;
+
+/**
+ * An in-memory copy of a contiguous range of the most recent majority committed oplog entries,
+ * shared by all tailable scans of the oplog on this node. The first scan to read an entry from
+ * the storage engine appends it here, and any other scan positioned inside the buffered range
+ * reads its next entries from memory instead of scanning the oplog again. This lets many change
+ * streams share a single oplog scan, while each of them still applies its own filter.
+ *
+ * The buffer holds at most 'internalQuerySharedOplogScanBufferMaxBytes' of entries, dropping the
+ * oldest ones first. It is tied to the UUID of the oplog, so that it starts over if the oplog is
+ * ever recreated.
+ */
+class SharedOplogScanBuffer {
+public:
+    struct Entry {
+        RecordId id;
+        BSONObj obj;
+    };
+
+    static SharedOplogScanBuffer& get(ServiceContext* serviceContext);
+
+    /**
+     * Records that a scan of the oplog identified by 'oplogUUID' read the owned entry 'obj' with
+     * RecordId 'id', and that it immediately followed 'prevId' in the oplog. A null 'prevId' means
+     * that the scan did not see the preceding entry. The entry is kept if it extends the buffered
+     * range, or if the buffer is empty or entirely behind 'prevId', in which case the buffer starts
+     * over from this entry.
+     */
+    void append(const UUID& oplogUUID, const RecordId& prevId, const RecordId& id, BSONObj obj);
+
+    /**
+     * Appends to 'out' up to 'limit' buffered entries of the oplog identified by 'oplogUUID' which
+     * immediately follow 'afterId' and have a RecordId no greater than 'maxId'. Returns the number
+     * of entries appended, which is zero if 'afterId' is not in the buffer.
+     */
+    size_t readAfter(const UUID& oplogUUID,
+                     const RecordId& afterId,
+                     const RecordId& maxId,
+                     size_t limit,
+                     std::deque<Entry>* out) const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("SharedOplogScanBuffer::_mutex");
+
+    boost::optional<UUID> _oplogUUID;
+    std::deque<Entry> _entries;
+    long long _bytes = 0;
+};
+
+}  // namespace mongo
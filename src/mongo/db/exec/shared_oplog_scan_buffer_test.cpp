@@ -0,0 +1,155 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/shared_oplog_scan_buffer.h"
+
+#include <limits>
+#include <vector>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj makeEntry(int64_t id) {
+    return BSON("ts" << Timestamp(static_cast<unsigned long long>(id)) << "o" << BSON("x" << id));
+}
+
+void appendRange(SharedOplogScanBuffer* buffer, const UUID& uuid, int64_t first, int64_t last) {
+    for (int64_t id = first; id <= last; ++id) {
+        buffer->append(uuid, RecordId(id - 1), RecordId(id), makeEntry(id));
+    }
+}
+
+std::vector<int64_t> readIds(const SharedOplogScanBuffer& buffer,
+                             const UUID& uuid,
+                             int64_t afterId,
+                             int64_t maxId = std::numeric_limits<int64_t>::max(),
+                             size_t limit = 1000) {
+    std::deque<SharedOplogScanBuffer::Entry> entries;
+    ASSERT_EQ(buffer.readAfter(uuid, RecordId(afterId), RecordId(maxId), limit, &entries),
+              entries.size());
+    std::vector<int64_t> ids;
+    for (auto&& entry : entries) {
+        ASSERT_BSONOBJ_EQ(makeEntry(entry.id.getLong()), entry.obj);
+        ids.push_back(entry.id.getLong());
+    }
+    return ids;
+}
+
+TEST(SharedOplogScanBufferTest, ReadsEntriesFollowingABufferedEntry) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 15);
+
+    ASSERT((readIds(buffer, uuid, 10) == std::vector<int64_t>{11, 12, 13, 14, 15}));
+    ASSERT((readIds(buffer, uuid, 12) == std::vector<int64_t>{13, 14, 15}));
+    ASSERT(readIds(buffer, uuid, 15).empty());
+}
+
+TEST(SharedOplogScanBufferTest, ReadsNothingAfterAnUnbufferedEntry) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 15);
+
+    ASSERT(readIds(buffer, uuid, 9).empty());
+    ASSERT(readIds(buffer, uuid, 16).empty());
+    ASSERT(readIds(buffer, UUID::gen(), 10).empty());
+}
+
+TEST(SharedOplogScanBufferTest, ReadsAreBoundedByMaxIdAndLimit) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 15);
+
+    ASSERT((readIds(buffer, uuid, 10, 13) == std::vector<int64_t>{11, 12, 13}));
+    ASSERT((readIds(buffer, uuid, 10, 15, 2) == std::vector<int64_t>{11, 12}));
+}
+
+TEST(SharedOplogScanBufferTest, IgnoresEntriesThatDoNotExtendTheBuffer) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 12);
+
+    // Already buffered, or not known to follow the last buffered entry.
+    buffer.append(uuid, RecordId(10), RecordId(11), makeEntry(11));
+    buffer.append(uuid, RecordId(), RecordId(14), makeEntry(14));
+
+    ASSERT((readIds(buffer, uuid, 10) == std::vector<int64_t>{11, 12}));
+}
+
+TEST(SharedOplogScanBufferTest, StartsOverWhenAScanIsAheadOfTheBuffer) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 12);
+
+    buffer.append(uuid, RecordId(20), RecordId(21), makeEntry(21));
+    buffer.append(uuid, RecordId(21), RecordId(22), makeEntry(22));
+
+    ASSERT(readIds(buffer, uuid, 10).empty());
+    ASSERT((readIds(buffer, uuid, 21) == std::vector<int64_t>{22}));
+}
+
+TEST(SharedOplogScanBufferTest, StartsOverForANewOplog) {
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 12);
+
+    const auto newUUID = UUID::gen();
+    buffer.append(newUUID, RecordId(), RecordId(5), makeEntry(5));
+    appendRange(&buffer, newUUID, 6, 7);
+
+    ASSERT(readIds(buffer, uuid, 10).empty());
+    ASSERT((readIds(buffer, newUUID, 5) == std::vector<int64_t>{6, 7}));
+}
+
+TEST(SharedOplogScanBufferTest, DropsTheOldestEntriesOnceFull) {
+    RAIIServerParameterControllerForTest maxBytes("internalQuerySharedOplogScanBufferMaxBytes",
+                                                  3 * makeEntry(0).objsize());
+    SharedOplogScanBuffer buffer;
+    const auto uuid = UUID::gen();
+    buffer.append(uuid, RecordId(), RecordId(10), makeEntry(10));
+    appendRange(&buffer, uuid, 11, 14);
+
+    ASSERT(readIds(buffer, uuid, 11).empty());
+    ASSERT((readIds(buffer, uuid, 12) == std::vector<int64_t>{13, 14}));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -30,10 +30,12 @@
 #pragma once
 
 #include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/normalized_sort_key.h"
 #include "mongo/db/exec/plan_stats.h"
 #include "mongo/db/exec/sort_key_comparator.h"
 #include "mongo/db/exec/working_set.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/query/query_memory_budget.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/sorter/sorter.h"
 
@@ -51,13 +53,19 @@ namespace mongo {
 template <typename T>
 class SortExecutor {
 public:
-    using DocumentSorter = Sorter<Value, T>;
+    using DocumentSorter = Sorter<NormalizedSortKey, T>;
     class Comparator {
     public:
         Comparator(const SortPattern& sortPattern) : _sortKeyComparator(sortPattern) {}
         int operator()(const typename DocumentSorter::Data& lhs,
                        const typename DocumentSorter::Data& rhs) const {
-            return _sortKeyComparator(lhs.first, rhs.first);
+            // All keys added to one sorter are either normalized or not.
+            const auto& lhsNormalized = lhs.first.normalizedKey();
+            const auto& rhsNormalized = rhs.first.normalizedKey();
+            if (lhsNormalized && rhsNormalized) {
+                return lhsNormalized->compare(*rhsNormalized);
+            }
+            return _sortKeyComparator(lhs.first.sortKey(), rhs.first.sortKey());
         }
 
     private:
@@ -73,6 +81,7 @@ public:
                  std::string tempDir,
                  bool allowDiskUse)
         : _sortPattern(std::move(sortPattern)),
+          _sortKeyNormalizer(_sortPattern),
           _tempDir(std::move(tempDir)),
           _diskUseAllowed(allowDiskUse) {
         _stats.sortPattern =
@@ -126,7 +135,7 @@ public:
         if (!_sorter) {
             _sorter.reset(DocumentSorter::make(makeSortOptions(), Comparator(_sortPattern)));
         }
-        _sorter->add(sortKey, data);
+        _sorter->add(_sortKeyNormalizer.normalize(sortKey), data);
     }
 
     /**
@@ -155,6 +164,7 @@ public:
 
         if (!_output->more()) {
             _output.reset();
+            _memoryReservation->set(0);
             _isEOF = true;
             return false;
         }
@@ -168,7 +178,8 @@ public:
      * end-of-stream must be detected with 'hasNext()'.
      */
     std::pair<Value, T> getNext() {
-        return _output->next();
+        auto next = _output->next();
+        return {next.first.sortKey(), std::move(next.second)};
     }
 
 private:
@@ -184,16 +195,30 @@ private:
             opts.tempDir = _tempDir;
         }
 
+        // Report the documents held in memory to the process-wide budget, and spill them early
+        // when it is exhausted.
+        opts.memoryUsageChanged = [reservation = _memoryReservation,
+                                   maxBytes = static_cast<int64_t>(_stats.maxMemoryUsageBytes)](
+                                      int64_t memUsageChange) {
+            reservation->add(memUsageChange);
+            return reservation->shouldSpillEarly(maxBytes);
+        };
+
         return opts;
     }
 
     const SortPattern _sortPattern;
+    const SortKeyNormalizer _sortKeyNormalizer;
     const std::string _tempDir;
     const bool _diskUseAllowed;
 
     std::unique_ptr<DocumentSorter> _sorter;
     std::unique_ptr<typename DocumentSorter::Iterator> _output;
 
+    // The memory held by the documents being sorted. Shared with the sorter, which reports to it.
+    std::shared_ptr<QueryMemoryBudget::Reservation> _memoryReservation =
+        std::make_shared<QueryMemoryBudget::Reservation>();
+
     SortStats _stats;
 
     bool _isEOF = false;
@@ -42,6 +42,7 @@
 #include "mongo/db/query/collation/collator_factory_mock.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/db/service_context_d_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 
@@ -304,4 +305,25 @@ TEST_F(SortStageDefaultTest, SortDescendingWithCollation) {
              "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
              "{output: [{a: 'ab'}, {a: 'ba'}, {a: 'aa'}]}");
 }
+
+TEST_F(SortStageDefaultTest, SortCompoundWithNormalizedKeys) {
+    RAIIServerParameterControllerForTest controller("internalQuerySortUseNormalizedKeys", true);
+    testWork("{a: 1, b: -1}",
+             nullptr,
+             0,
+             "{input: [{a: 2, b: 1}, {a: 1, b: 1}, {a: 'x', b: 0}, {a: 1, b: 2}, {b: 5}, "
+             "{a: 1.5, b: 0}, {a: [3, 0.5], b: 0}]}",
+             "{output: [{b: 5}, {a: [3, 0.5], b: 0}, {a: 1, b: 2}, {a: 1, b: 1}, {a: 1.5, b: 0}, "
+             "{a: 2, b: 1}, {a: 'x', b: 0}]}");
+}
+
+TEST_F(SortStageDefaultTest, SortDescendingWithCollationAndNormalizedKeys) {
+    RAIIServerParameterControllerForTest controller("internalQuerySortUseNormalizedKeys", true);
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kReverseString);
+    testWork("{a: -1}",
+             &collator,
+             2,
+             "{input: [{a: 'ba'}, {a: 'aa'}, {a: 'ab'}]}",
+             "{output: [{a: 'ab'}, {a: 'ba'}]}");
+}
 }  // namespace
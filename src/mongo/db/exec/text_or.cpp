@@ -29,6 +29,7 @@
 
 #include "mongo/db/exec/text_or.h"
 
+#include <limits>
 #include <map>
 #include <memory>
 #include <vector>
@@ -56,13 +57,20 @@ TextOrStage::TextOrStage(ExpressionContext* expCtx,
                          size_t keyPrefixSize,
                          WorkingSet* ws,
                          const MatchExpression* filter,
-                         const CollectionPtr& collection)
+                         const CollectionPtr& collection,
+                         boost::optional<TextOrTopKParams> topKParams)
     : RequiresCollectionStage(kStageType, expCtx, collection),
       _keyPrefixSize(keyPrefixSize),
       _ws(ws),
       _scoreIterator(_scores.end()),
+      _topKParams(std::move(topKParams)),
       _filter(filter),
-      _idRetrying(WorkingSet::INVALID_ID) {}
+      _idRetrying(WorkingSet::INVALID_ID) {
+    if (_topKParams) {
+        invariant(_topKParams->limit > 0);
+        _specificStats.limit = _topKParams->limit;
+    }
+}
 
 void TextOrStage::addChild(unique_ptr<PlanStage> child) {
     _children.push_back(std::move(child));
@@ -153,6 +161,11 @@ PlanStage::StageState TextOrStage::initStage(WorkingSetID* out) {
     *out = WorkingSet::INVALID_ID;
     try {
         _recordCursor = collection()->getCursor(opCtx());
+        if (_topKParams) {
+            // Until a child returns its first posting, nothing bounds the score of its postings.
+            _childThresholds.assign(_children.size(), std::numeric_limits<double>::infinity());
+            _childrenAtEOF.assign(_children.size(), false);
+        }
         _internalState = State::kReadingTerms;
         return PlanStage::NEED_TIME;
     } catch (const WriteConflictException&) {
@@ -182,8 +195,32 @@ PlanStage::StageState TextOrStage::readFromChildren(WorkingSetID* out) {
     }
 
     if (PlanStage::ADVANCED == childState) {
-        return addTerm(id, out);
+        auto stageState = addTerm(id, out);
+        if (_topKParams && stageState != PlanStage::NEED_YIELD) {
+            if (topKComplete()) {
+                _specificStats.earlyTermination = true;
+                _scoreIterator = _scores.begin();
+                _internalState = State::kReturningResults;
+            } else {
+                advanceToNextChild();
+            }
+        }
+        return stageState;
     } else if (PlanStage::IS_EOF == childState) {
+        if (_topKParams) {
+            _childThresholds[_currentChild] = 0;
+            _childrenAtEOF[_currentChild] = true;
+            advanceToNextChild();
+            if (!_childrenAtEOF[_currentChild]) {
+                // We have another child to read from.
+                return PlanStage::NEED_TIME;
+            }
+
+            _scoreIterator = _scores.begin();
+            _internalState = State::kReturningResults;
+            return PlanStage::NEED_TIME;
+        }
+
         // Done with this child.
         ++_currentChild;
 
@@ -235,6 +272,23 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
     const IndexKeyDatum newKeyData = wsm->keyData.back();  // copy to keep it around.
     TextRecordData* textRecordData = &_scores[wsm->recordId];
 
+    // Locate score within possibly compound key: {prefix,term,score,suffix}.
+    BSONObjIterator keyIt(newKeyData.keyData);
+    for (unsigned i = 0; i < _keyPrefixSize; i++) {
+        keyIt.next();
+    }
+
+    keyIt.next();  // Skip past 'term'.
+
+    BSONElement scoreElement = keyIt.next();
+    double documentTermScore = scoreElement.number();
+
+    if (_topKParams) {
+        // The child returns its postings in descending score order, so no posting it has yet to
+        // return scores higher than this one.
+        _childThresholds[_currentChild] = documentTermScore;
+    }
+
     if (textRecordData->score < 0) {
         // We have already rejected this document for not matching the filter.
         invariant(WorkingSet::INVALID_ID == textRecordData->wsid);
@@ -273,6 +327,11 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
 
         // Ensure that the BSONObj underlying the WorkingSetMember is owned in case we yield.
         wsm->makeObjOwnedIfNeeded();
+
+        if (_topKParams) {
+            addTopKCandidate(wsm->recordId, wsid);
+            return NEED_TIME;
+        }
     } else {
         // We already have a working set member for this RecordId. Free the new WSM and retrieve the
         // old one. Note that since we don't keep all index keys, we could get a score that doesn't
@@ -281,22 +340,66 @@ PlanStage::StageState TextOrStage::addTerm(WorkingSetID wsid, WorkingSetID* out)
         invariant(wsid != textRecordData->wsid);
         _ws->free(wsid);
         wsm = _ws->get(textRecordData->wsid);
-    }
 
-    // Locate score within possibly compound key: {prefix,term,score,suffix}.
-    BSONObjIterator keyIt(newKeyData.keyData);
-    for (unsigned i = 0; i < _keyPrefixSize; i++) {
-        keyIt.next();
+        if (_topKParams) {
+            // The document was scored in full when we first saw it.
+            return NEED_TIME;
+        }
     }
 
-    keyIt.next();  // Skip past 'term'.
-
-    BSONElement scoreElement = keyIt.next();
-    double documentTermScore = scoreElement.number();
-
     // Aggregate relevance score, term keys.
     textRecordData->score += documentTermScore;
     return NEED_TIME;
 }
 
+void TextOrStage::addTopKCandidate(const RecordId& recordId, WorkingSetID wsid) {
+    WorkingSetMember* wsm = _ws->get(wsid);
+    fts::TermFrequencyMap termFrequencies;
+    _topKParams->spec.scoreDocument(wsm->doc.value().toBson(), &termFrequencies);
+
+    double score = 0;
+    for (auto&& term : _topKParams->terms) {
+        auto it = termFrequencies.find(term);
+        if (it != termFrequencies.end()) {
+            score += it->second;
+        }
+    }
+
+    _scores[recordId].score = score;
+    _topK.push({score, recordId});
+    if (_topK.size() <= _topKParams->limit) {
+        return;
+    }
+
+    // Evict the lowest scoring document. Later postings for it are ignored like those of documents
+    // which failed the filter.
+    TextRecordData& evicted = _scores[_topK.top().recordId];
+    _ws->free(evicted.wsid);
+    evicted.wsid = WorkingSet::INVALID_ID;
+    evicted.score = -1;
+    _topK.pop();
+}
+
+bool TextOrStage::topKComplete() const {
+    if (_topK.size() < _topKParams->limit) {
+        return false;
+    }
+
+    double threshold = 0;
+    for (auto childThreshold : _childThresholds) {
+        threshold += childThreshold;
+    }
+    return _topK.top().score >= threshold;
+}
+
+void TextOrStage::advanceToNextChild() {
+    for (size_t i = 1; i <= _children.size(); ++i) {
+        size_t child = (_currentChild + i) % _children.size();
+        if (!_childrenAtEOF[child]) {
+            _currentChild = child;
+            return;
+        }
+    }
+}
+
 }  // namespace mongo
@@ -30,6 +30,11 @@
 #pragma once
 
 #include <memory>
+#include <queue>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/optional.hpp>
 
 #include "mongo/db/exec/requires_collection_stage.h"
 #include "mongo/db/fts/fts_spec.h"
@@ -42,11 +47,37 @@ using fts::FTSSpec;
 
 class OperationContext;
 
+/**
+ * Describes how a TextOrStage may compute only the 'limit' best scoring documents rather than
+ * scoring every document which contains a query term. The stage scores each document it sees
+ * exactly using 'spec', summing the weights of 'terms', so it may stop reading postings once no
+ * unseen document can beat the documents it already holds.
+ */
+struct TextOrTopKParams {
+    TextOrTopKParams(size_t limit, const FTSSpec& spec, std::set<std::string> terms)
+        : limit(limit), spec(spec), terms(std::move(terms)) {}
+
+    // The number of highest scoring documents to return. Must be positive.
+    const size_t limit;
+
+    // Spec of the text index, used to score fetched documents.
+    const FTSSpec spec;
+
+    // The stemmed query terms, one per child of the stage, in the form stored in the index.
+    const std::set<std::string> terms;
+};
+
 /**
  * A blocking stage that returns the set of WSMs with RecordIDs of all of the documents that contain
  * the positive terms in the search query, as well as their scores.
  *
  * The WorkingSetMembers returned are fetched and in the LOC_AND_OBJ state.
+ *
+ * Each child scans the postings of one term in descending score order. When constructed with
+ * TextOrTopKParams, the stage reads its children in turn and applies the threshold algorithm: every
+ * newly seen document is scored exactly, and reading stops as soon as the lowest of the 'limit'
+ * best scores is at least the sum of the last score read from each child, as no unseen document
+ * can score higher than that sum. Only the 'limit' best scoring documents are returned.
  */
 class TextOrStage final : public RequiresCollectionStage {
 public:
@@ -71,7 +102,8 @@ public:
                 size_t keyPrefixSize,
                 WorkingSet* ws,
                 const MatchExpression* filter,
-                const CollectionPtr& collection);
+                const CollectionPtr& collection,
+                boost::optional<TextOrTopKParams> topKParams = boost::none);
 
     void addChild(std::unique_ptr<PlanStage> child);
 
@@ -118,6 +150,24 @@ private:
      */
     StageState addTerm(WorkingSetID wsid, WorkingSetID* out);
 
+    /**
+     * Helper called from addTerm when computing the top-k documents. Scores the newly fetched
+     * document 'wsid' exactly and keeps it if it is among the 'limit' best documents seen so far.
+     */
+    void addTopKCandidate(const RecordId& recordId, WorkingSetID wsid);
+
+    /**
+     * Returns true if the top-k documents have been found, that is, if no document which has not
+     * been seen yet can score higher than the lowest scoring document we are keeping.
+     */
+    bool topKComplete() const;
+
+    /**
+     * Moves to the next child which has not reached EOF, in round-robin order. Used only when
+     * computing the top-k documents.
+     */
+    void advanceToNextChild();
+
     /**
      * Worker for kReturningResults. Returns a wsm with RecordID and Score.
      */
@@ -152,6 +202,25 @@ private:
 
     TextOrStats _specificStats;
 
+    // Set if this stage needs to return only the highest scoring documents.
+    const boost::optional<TextOrTopKParams> _topKParams;
+
+    // The score of the last posting read from each child when computing the top-k documents, which
+    // bounds the score of any posting the child has yet to return. Zero once the child is at EOF.
+    std::vector<double> _childThresholds;
+    std::vector<bool> _childrenAtEOF;
+
+    // The documents we are keeping when computing the top-k documents, lowest score on top.
+    struct TopKCandidate {
+        double score;
+        RecordId recordId;
+        bool operator>(const TopKCandidate& other) const {
+            return score > other.score;
+        }
+    };
+    std::priority_queue<TopKCandidate, std::vector<TopKCandidate>, std::greater<TopKCandidate>>
+        _topK;
+
     // Members needed only for using the TextMatchableDocument.
     const MatchExpression* _filter;
     WorkingSetID _idRetrying;
@@ -34,7 +34,14 @@
 #include "mongo/db/catalog/collection.h"
 
 namespace mongo::trial_period {
-size_t getTrialPeriodMaxWorks(OperationContext* opCtx, const CollectionPtr& collection) {
+namespace {
+// How many times as much as estimated the cheapest candidate plan is given to finish.
+constexpr double kEstimatedWorksMargin = 2.0;
+}  // namespace
+
+size_t getTrialPeriodMaxWorks(OperationContext* opCtx,
+                              const CollectionPtr& collection,
+                              boost::optional<double> cheapestEstimatedWorks) {
     // Run each plan some number of times. This number is at least as great as
     // 'internalQueryPlanEvaluationWorks', but may be larger for big collections.
     size_t numWorks = internalQueryPlanEvaluationWorks.load();
@@ -47,6 +54,13 @@ size_t getTrialPeriodMaxWorks(OperationContext* opCtx, const CollectionPtr& coll
                             static_cast<size_t>(fraction * collection->numRecords(opCtx)));
     }
 
+    if (cheapestEstimatedWorks) {
+        numWorks = std::min(
+            numWorks,
+            std::max(static_cast<size_t>(internalQueryPlanEvaluationWorks.load()),
+                     static_cast<size_t>(kEstimatedWorksMargin * *cheapestEstimatedWorks)));
+    }
+
     return numWorks;
 }
 
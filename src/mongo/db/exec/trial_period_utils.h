@@ -39,9 +39,29 @@ namespace trial_period {
 /**
  * Returns the number of times that we are willing to work a plan during a trial period.
  *
- * Calculated based on a fixed query knob and the size of the collection.
+ * Calculated based on a fixed query knob and the size of the collection. If the field histograms
+ * estimate how much the cheapest candidate plan examines to run to completion, the number is
+ * bounded by 'cheapestEstimatedWorks' with some margin instead of growing with the collection.
  */
-size_t getTrialPeriodMaxWorks(OperationContext* opCtx, const CollectionPtr& collection);
+size_t getTrialPeriodMaxWorks(OperationContext* opCtx,
+                              const CollectionPtr& collection,
+                              boost::optional<double> cheapestEstimatedWorks = boost::none);
+
+/**
+ * Returns the smallest of the estimated works of 'solutions', if any of them has one.
+ */
+template <typename SolutionIterator, typename GetSolution>
+boost::optional<double> getCheapestEstimatedWorks(SolutionIterator begin,
+                                                  SolutionIterator end,
+                                                  GetSolution getSolution) {
+    boost::optional<double> cheapest;
+    for (; begin != end; ++begin) {
+        if (auto works = getSolution(*begin)->estimatedWorks) {
+            cheapest = std::min(cheapest.value_or(*works), *works);
+        }
+    }
+    return cheapest;
+}
 
 /**
  * Returns the max number of documents which we should allow any plan to return during the
@@ -46,6 +46,8 @@
 #include "mongo/db/op_observer.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/operation_sharding_state.h"
 #include "mongo/db/s/resharding_util.h"
@@ -151,17 +153,6 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     // If asked to return new doc, default to the oldObj, in case nothing changes.
     BSONObj newObj = oldObj.value();
 
-    // Ask the driver to apply the mods. It may be that the driver can apply those "in
-    // place", that is, some values of the old document just get adjusted without any
-    // change to the binary layout on the bson layer. It may be that a whole new document
-    // is needed to accomodate the new bson layout of the resulting document. In any event,
-    // only enable in-place mutations if the underlying storage engine offers support for
-    // writing damage events.
-    _doc.reset(oldObj.value(),
-               (collection()->updateWithDamagesSupported()
-                    ? mutablebson::Document::kInPlaceEnabled
-                    : mutablebson::Document::kInPlaceDisabled));
-
     BSONObj logObj;
 
     bool docWasModified = false;
@@ -169,6 +160,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
     Status status = Status::OK();
     const bool isInsert = false;
     FieldRefSet immutablePaths;
+    bool isSharded = false;
 
     if (_isUserInitiatedWrite) {
         // Documents coming directly from users should be validated for storage. It is safe to
@@ -176,57 +168,84 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // metadata has not been initialized.
         const auto collDesc = CollectionShardingState::get(opCtx(), collection()->ns())
                                   ->getCollectionDescription(opCtx());
-        if (collDesc.isSharded() && !OperationShardingState::isOperationVersioned(opCtx())) {
+        isSharded = collDesc.isSharded();
+        if (isSharded && !OperationShardingState::isOperationVersioned(opCtx())) {
             immutablePaths.fillFrom(collDesc.getKeyPatternFields());
         }
         immutablePaths.keepShortest(&idFieldRef);
     }
-    if (!driver->needMatchDetails()) {
-        // If we don't need match details, avoid doing the rematch
-        status = driver->update(opCtx(),
-                                StringData(),
-                                &_doc,
-                                _isUserInitiatedWrite,
-                                immutablePaths,
-                                isInsert,
-                                &logObj,
-                                &docWasModified);
-    } else {
-        // If there was a matched field, obtain it.
-        MatchDetails matchDetails;
-        matchDetails.requestElemMatchKey();
-
-        dassert(cq);
-        verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
-
-        string matchedField;
-        if (matchDetails.hasElemMatchKey())
-            matchedField = matchDetails.elemMatchKey();
-
-        status = driver->update(opCtx(),
-                                matchedField,
-                                &_doc,
-                                _isUserInitiatedWrite,
-                                immutablePaths,
-                                isInsert,
-                                &logObj,
-                                &docWasModified);
-    }
-
-    if (!status.isOK()) {
-        uasserted(16837, status.reason());
-    }
 
     // Skip adding _id field if the collection is capped (since capped collection documents can
     // neither grow nor shrink).
     const auto createIdField = !collection()->isCapped();
 
-    // Ensure _id is first if it exists, and generate a new OID if appropriate.
-    _ensureIdFieldIsFirst(&_doc, createIdField);
-
-    // See if the changes were applied in place
     const char* source = nullptr;
-    const bool inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+    bool inPlace = false;
+
+    // Updates which only overwrite top-level numbers with numbers of the same type can be turned
+    // into damages straight from the stored document. Checking whether an update changes the
+    // shard key needs the updated document, so such updates of sharded collections take the
+    // general path below, as do documents whose _id must be moved or generated.
+    if (collection()->updateWithDamagesSupported() && !isSharded &&
+        oldObj.value().firstElementFieldNameStringData() == idFieldName) {
+        inPlace = driver->updateWithDamages(
+            oldObj.value(), immutablePaths, &_damages, &source, &logObj, &docWasModified);
+    }
+
+    if (!inPlace) {
+        // Ask the driver to apply the mods. It may be that the driver can apply those "in
+        // place", that is, some values of the old document just get adjusted without any
+        // change to the binary layout on the bson layer. It may be that a whole new document
+        // is needed to accomodate the new bson layout of the resulting document. In any event,
+        // only enable in-place mutations if the underlying storage engine offers support for
+        // writing damage events.
+        _doc.reset(oldObj.value(),
+                   (collection()->updateWithDamagesSupported()
+                        ? mutablebson::Document::kInPlaceEnabled
+                        : mutablebson::Document::kInPlaceDisabled));
+
+        if (!driver->needMatchDetails()) {
+            // If we don't need match details, avoid doing the rematch
+            status = driver->update(opCtx(),
+                                    StringData(),
+                                    &_doc,
+                                    _isUserInitiatedWrite,
+                                    immutablePaths,
+                                    isInsert,
+                                    &logObj,
+                                    &docWasModified);
+        } else {
+            // If there was a matched field, obtain it.
+            MatchDetails matchDetails;
+            matchDetails.requestElemMatchKey();
+
+            dassert(cq);
+            verify(cq->root()->matchesBSON(oldObj.value(), &matchDetails));
+
+            string matchedField;
+            if (matchDetails.hasElemMatchKey())
+                matchedField = matchDetails.elemMatchKey();
+
+            status = driver->update(opCtx(),
+                                    matchedField,
+                                    &_doc,
+                                    _isUserInitiatedWrite,
+                                    immutablePaths,
+                                    isInsert,
+                                    &logObj,
+                                    &docWasModified);
+        }
+
+        if (!status.isOK()) {
+            uasserted(16837, status.reason());
+        }
+
+        // Ensure _id is first if it exists, and generate a new OID if appropriate.
+        _ensureIdFieldIsFirst(&_doc, createIdField);
+
+        // See if the changes were applied in place
+        inPlace = _doc.getInPlaceUpdates(&_damages, &source);
+    }
 
     if (inPlace && _damages.empty()) {
         // An interesting edge case. A modifier didn't notice that it was really a no-op
@@ -248,6 +267,7 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         if (!request->explain()) {
             args.stmtIds = request->getStmtIds();
             args.update = logObj;
+            args.oplogSlot = _batchOplogSlot;
             if (_isUserInitiatedWrite) {
                 args.criteria = CollectionShardingState::get(opCtx(), collection()->ns())
                                     ->getCollectionDescription(opCtx())
@@ -329,9 +349,14 @@ BSONObj UpdateStage::transformAndUpdate(const Snapshotted<BSONObj>& oldObj, Reco
         // it again.  For an example, see the comment above near declaration of
         // updatedRecordIds.
         //
-        // This must be done after the wunit commits so we are sure we won't be rolling back.
+        // This must be done after the wunit commits so we are sure we won't be rolling back. The
+        // documents of a batch are only committed together, so they are added by _updateBatch().
         if (_updatedRecordIds && (newRecordId != recordId || driver->modsAffectIndices())) {
-            _updatedRecordIds->insert(newRecordId);
+            if (_batchUpdatedRecordIds) {
+                _batchUpdatedRecordIds->push_back(newRecordId);
+            } else {
+                _updatedRecordIds->insert(newRecordId);
+            }
         }
     }
 
@@ -362,7 +387,8 @@ void UpdateStage::_assertPathsNotArray(const mb::Document& document, const Field
 bool UpdateStage::isEOF() {
     // We're done updating if either the child has no more results to give us, or we've
     // already gotten a result back and we're not a multi-update.
-    return _idRetrying == WorkingSet::INVALID_ID && _idReturning == WorkingSet::INVALID_ID &&
+    return _idRetrying == WorkingSet::INVALID_ID && _idsRetrying.empty() &&
+        _idReturning == WorkingSet::INVALID_ID &&
         (child()->isEOF() || (_specificStats.nMatched > 0 && !_params.request->isMulti()));
 }
 
@@ -386,6 +412,11 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
         return PlanStage::ADVANCED;
     }
 
+    if (_idRetrying == WorkingSet::INVALID_ID && !_idsRetrying.empty()) {
+        _idRetrying = _idsRetrying.front();
+        _idsRetrying.pop_front();
+    }
+
     // Either retry the last WSM we worked on or get a new one from our child.
     WorkingSetID id;
     StageState status;
@@ -441,6 +472,12 @@ PlanStage::StageState UpdateStage::doWork(WorkingSetID* out) {
             return PlanStage::NEED_TIME;
         }
 
+        // Documents of a rolled back batch are retried on their own.
+        if (_canUpdateInBatches() && _idsRetrying.empty()) {
+            memberFreer.dismiss();
+            return _updateBatch(id, out);
+        }
+
         // Ensure that the BSONObj underlying the WorkingSetMember is owned because saveState()
         // is allowed to free the memory.
         member->makeObjOwnedIfNeeded();
@@ -576,6 +613,134 @@ PlanStage::StageState UpdateStage::prepareToRetryWSM(WorkingSetID idToRetry, Wor
     return NEED_YIELD;
 }
 
+bool UpdateStage::_canUpdateInBatches() const {
+    const UpdateRequest* const request = _params.request;
+
+    // Writes which are not replicated by this update, such as those of oplog application, take
+    // their timestamps from elsewhere. Retryable writes and pre-image recording log extra oplog
+    // entries which cannot use the slots reserved for the batch.
+    return internalUpdateMaxBatchSize.load() > 1 && request->isMulti() && !request->explain() &&
+        !request->shouldReturnAnyDocs() && opCtx()->writesAreReplicated() &&
+        !opCtx()->lockState()->inAWriteUnitOfWork() && !opCtx()->getTxnNumber() &&
+        !collection()->getRecordPreImages();
+}
+
+PlanStage::StageState UpdateStage::_updateBatch(WorkingSetID firstId, WorkingSetID* out) {
+    std::vector<WorkingSetID> batch{firstId};
+    auto freeBatch = makeGuard([&] {
+        for (auto id : batch) {
+            _ws->free(id);
+        }
+    });
+    auto retryBatch = [&] {
+        freeBatch.dismiss();
+        _idsRetrying.insert(_idsRetrying.end(), batch.begin(), batch.end());
+    };
+
+    const auto maxBatchSize = static_cast<size_t>(internalUpdateMaxBatchSize.load());
+    while (batch.size() < maxBatchSize && !child()->isEOF()) {
+        WorkingSetID id;
+        const auto status = child()->work(&id);
+        if (status == PlanStage::NEED_TIME) {
+            continue;
+        } else if (status == PlanStage::NEED_YIELD) {
+            retryBatch();
+            *out = id;
+            return status;
+        } else if (status != PlanStage::ADVANCED) {
+            break;
+        }
+
+        WorkingSetMember* member = _ws->get(id);
+        invariant(member->hasRecordId());
+        invariant(member->hasObj());
+        if (_updatedRecordIds->count(member->recordId) > 0) {
+            _ws->free(id);
+            continue;
+        }
+
+        bool docStillMatches;
+        try {
+            docStillMatches = write_stage_common::ensureStillMatches(
+                collection(), opCtx(), _ws, id, _params.canonicalQuery);
+        } catch (const WriteConflictException&) {
+            batch.push_back(id);
+            retryBatch();
+            *out = WorkingSet::INVALID_ID;
+            return NEED_YIELD;
+        }
+        if (!docStillMatches) {
+            _ws->free(id);
+            continue;
+        }
+        batch.push_back(id);
+    }
+
+    for (auto id : batch) {
+        // Ensure that the BSONObj underlying the WorkingSetMember is owned because saveState()
+        // is allowed to free the memory.
+        _ws->get(id)->makeObjOwnedIfNeeded();
+    }
+
+    // Save state before making changes.
+    try {
+        child()->saveState();
+    } catch (const WriteConflictException&) {
+        std::terminate();
+    }
+
+    const auto statsBeforeBatch = _specificStats;
+    try {
+        _batchUpdatedRecordIds.emplace();
+        ON_BLOCK_EXIT([&] {
+            _batchOplogSlot.reset();
+            _batchUpdatedRecordIds.reset();
+        });
+
+        WriteUnitOfWork wunit(opCtx());
+        std::vector<OplogSlot> oplogSlots;
+        if (!repl::ReplicationCoordinator::get(opCtx())->isOplogDisabledFor(
+                opCtx(), collection()->ns())) {
+            oplogSlots = repl::getNextOpTimes(opCtx(), batch.size());
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i) {
+            WorkingSetMember* member = _ws->get(batch[i]);
+            if (!oplogSlots.empty()) {
+                // Each document is written at the timestamp of its oplog entry, like it would be
+                // in a transaction of its own.
+                _batchOplogSlot = oplogSlots[i];
+                uassertStatusOK(
+                    opCtx()->recoveryUnit()->setTimestamp(_batchOplogSlot->getTimestamp()));
+            }
+            transformAndUpdate({member->doc.snapshotId(), member->doc.value().toBson()},
+                               member->recordId);
+        }
+        wunit.commit();
+
+        _updatedRecordIds->insert(_batchUpdatedRecordIds->begin(), _batchUpdatedRecordIds->end());
+    } catch (const WriteConflictException&) {
+        // Nothing in the batch was written, so none of it counts yet.
+        _specificStats = statsBeforeBatch;
+        retryBatch();
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+
+    _specificStats.nMatched += batch.size();
+
+    // As restoreState may restore (recreate) cursors, make sure to restore the state outside of
+    // the WriteUnitOfWork.
+    try {
+        child()->restoreState(&collection());
+    } catch (const WriteConflictException&) {
+        // The batch was already committed.
+        *out = WorkingSet::INVALID_ID;
+        return NEED_YIELD;
+    }
+    return PlanStage::NEED_TIME;
+}
+
 
 void UpdateStage::_checkRestrictionsOnUpdatingShardKeyAreNotViolated(
     const ScopedCollectionDescription& collDesc, const FieldRefSet& shardKeyPaths) {
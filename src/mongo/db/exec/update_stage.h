@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+#include <vector>
 
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/exec/requires_collection_stage.h"
@@ -147,6 +149,20 @@ private:
      */
     StageState prepareToRetryWSM(WorkingSetID idToRetry, WorkingSetID* out);
 
+    /**
+     * Returns true if the documents matched by this update may be written in batches of up to
+     * 'internalUpdateMaxBatchSize' documents per storage transaction.
+     */
+    bool _canUpdateInBatches() const;
+
+    /**
+     * Pulls more matching documents from the child to join 'firstId', which must already be known
+     * to match, and updates all of them in one WriteUnitOfWork. Each document is written at the
+     * timestamp of its own oplog entry. If the batch hits a write conflict, it is rolled back and
+     * its documents are retried one at a time.
+     */
+    StageState _updateBatch(WorkingSetID firstId, WorkingSetID* out);
+
     /**
      * Returns true if the owning shard under the current key pattern would change as a result of
      * the update, or if the destined recipient under the new shard key pattern from resharding
@@ -182,6 +198,15 @@ private:
     // If not WorkingSet::INVALID_ID, we use this rather than asking our child what to do next.
     WorkingSetID _idRetrying;
 
+    // Members of a rolled back batch which still have to be updated, one at a time, before asking
+    // our child for more.
+    std::deque<WorkingSetID> _idsRetrying;
+
+    // While a batch is being written, the oplog slot reserved for the document being updated, and
+    // the RecordIds to add to '_updatedRecordIds' once the batch commits.
+    boost::optional<OplogSlot> _batchOplogSlot;
+    boost::optional<std::vector<RecordId>> _batchUpdatedRecordIds;
+
     // If not WorkingSet::INVALID_ID, we return this member to our caller.
     WorkingSetID _idReturning;
 
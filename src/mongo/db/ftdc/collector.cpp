@@ -33,6 +33,7 @@
 
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bsonmisc.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
 #include "mongo/db/ftdc/constants.h"
@@ -100,4 +101,39 @@ std::tuple<BSONObj, Date_t> FTDCCollectorCollection::collect(Client* client) {
     return std::tuple<BSONObj, Date_t>(builder.obj(), start);
 }
 
+void FTDCHighFrequencyCollector::add(std::unique_ptr<FTDCCollectorInterface> collector) {
+    _collectors.add(std::move(collector));
+}
+
+void FTDCHighFrequencyCollector::setSamplesPerPeriod(size_t samplesPerPeriod) {
+    invariant(samplesPerPeriod > 0);
+    _samplesPerPeriod = samplesPerPeriod;
+}
+
+void FTDCHighFrequencyCollector::sample(Client* client) {
+    _samples.push_back(std::get<0>(_collectors.collect(client)));
+    while (_samples.size() > _samplesPerPeriod) {
+        _samples.pop_front();
+    }
+}
+
+std::string FTDCHighFrequencyCollector::name() const {
+    return kFTDCHighFrequencyCollectorName;
+}
+
+void FTDCHighFrequencyCollector::collect(OperationContext* opCtx, BSONObjBuilder& builder) {
+    // Nothing has been sampled yet, e.g. since high frequency sampling was enabled.
+    if (_samples.empty()) {
+        return;
+    }
+
+    BSONArrayBuilder samplesBuilder(builder.subarrayStart(kFTDCHighFrequencySamplesField));
+    for (size_t i = 0; i < _samplesPerPeriod; ++i) {
+        samplesBuilder.append(i < _samples.size() ? _samples[i] : _samples.back());
+    }
+    samplesBuilder.doneFast();
+
+    _samples.clear();
+}
+
 }  // namespace mongo
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -110,9 +111,86 @@ public:
      */
     std::tuple<BSONObj, Date_t> collect(Client* client);
 
+    /**
+     * Returns true if no collectors have been added.
+     */
+    bool empty() const {
+        return _collectors.empty();
+    }
+
 private:
     // collection of collectors
     std::vector<std::unique_ptr<FTDCCollectorInterface>> _collectors;
 };
 
+/**
+ * Samples a set of cheap collectors several times per period of the periodic collectors, and
+ * reports the samples taken since the last periodic sample as one periodic collector.
+ *
+ * Each periodic sample holds exactly getSamplesPerPeriod() samples, so that the schema of the
+ * periodic samples, and with it their compression, does not depend on how many samples were
+ * actually taken. Surplus samples are dropped oldest first, and missing samples are filled in by
+ * repeating the most recent one, whose unchanged "start" date shows that it is a repeat.
+ *
+ * Sample schema:
+ * {
+ *    "samples" : [        <- Oldest sample first
+ *       {                 <- Same schema as FTDCCollectorCollection::collect
+ *          "start" : Date_t,
+ *          "name" : { ... },
+ *          "end" : Date_t,
+ *       },
+ *       ...
+ *    ]
+ * }
+ *
+ * Not Thread-Safe. Locking is owner's responsibility.
+ */
+class FTDCHighFrequencyCollector : public FTDCCollectorInterface {
+public:
+    /**
+     * Add a metric collector to sample at the high frequency.
+     * Must be called before sample. Cannot be called after sample is called.
+     */
+    void add(std::unique_ptr<FTDCCollectorInterface> collector);
+
+    /**
+     * Returns true if no collectors have been added.
+     */
+    bool empty() const {
+        return _collectors.empty();
+    }
+
+    /**
+     * Set the number of samples to report in each periodic sample.
+     */
+    void setSamplesPerPeriod(size_t samplesPerPeriod);
+
+    size_t getSamplesPerPeriod() const {
+        return _samplesPerPeriod;
+    }
+
+    /**
+     * Collect a sample from all collectors, to be reported by the next call to collect.
+     */
+    void sample(Client* client);
+
+    std::string name() const final;
+
+    /**
+     * Report the samples taken since the last call, and discard them.
+     */
+    void collect(OperationContext* opCtx, BSONObjBuilder& builder) final;
+
+private:
+    // collection of collectors to sample
+    FTDCCollectorCollection _collectors;
+
+    // Number of samples to report in each periodic sample
+    size_t _samplesPerPeriod{1};
+
+    // Samples not yet reported, oldest first
+    std::deque<BSONObj> _samples;
+};
+
 }  // namespace mongo
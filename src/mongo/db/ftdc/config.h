@@ -46,6 +46,7 @@ struct FTDCConfig {
           maxDirectorySizeBytes(kMaxDirectorySizeBytesDefault),
           maxFileSizeBytes(kMaxFileSizeBytesDefault),
           period(kPeriodMillisDefault),
+          highFrequencyPeriod(kHighFrequencyPeriodMillisDefault),
           maxSamplesPerArchiveMetricChunk(kMaxSamplesPerArchiveMetricChunkDefault),
           maxSamplesPerInterimMetricChunk(kMaxSamplesPerInterimMetricChunkDefault) {}
 
@@ -73,6 +74,13 @@ struct FTDCConfig {
      */
     Milliseconds period;
 
+    /**
+     * Period at which to sample the high frequency collectors, or zero to not sample them.
+     *
+     * Only takes effect when it is shorter than the period of the periodic collectors.
+     */
+    Milliseconds highFrequencyPeriod;
+
     /**
      * Maximum number of samples to collect in an archive metric chunk for long term storage.
      */
@@ -87,6 +95,7 @@ struct FTDCConfig {
     static const bool kEnabledDefault = true;
 
     static const std::int64_t kPeriodMillisDefault;
+    static const std::int64_t kHighFrequencyPeriodMillisDefault = 0;
     static const std::uint64_t kMaxDirectorySizeBytesDefault = 200 * 1024 * 1024;
     static const std::uint64_t kMaxFileSizeBytesDefault = 10 * 1024 * 1024;
 
@@ -48,6 +48,9 @@ extern const char kFTDCDocsField[];
 extern const char kFTDCCollectStartField[];
 extern const char kFTDCCollectEndField[];
 
+extern const char kFTDCHighFrequencyCollectorName[];
+extern const char kFTDCHighFrequencySamplesField[];
+
 constexpr StringData kFTDCDefaultDirectory = "diagnostic.data"_sd;
 
 }  // namespace mongo
@@ -70,6 +70,12 @@ void FTDCController::setPeriod(Milliseconds millis) {
     _condvar.notify_one();
 }
 
+void FTDCController::setHighFrequencyPeriod(Milliseconds millis) {
+    stdx::lock_guard<Latch> lock(_mutex);
+    _configTemp.highFrequencyPeriod = millis;
+    _condvar.notify_one();
+}
+
 void FTDCController::setMaxDirectorySizeBytes(std::uint64_t size) {
     stdx::lock_guard<Latch> lock(_mutex);
     _configTemp.maxDirectorySizeBytes = size;
@@ -120,6 +126,22 @@ void FTDCController::addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface
     }
 }
 
+void FTDCController::addHighFrequencyCollector(
+    std::unique_ptr<FTDCCollectorInterface> collector) {
+    {
+        stdx::lock_guard<Latch> lock(_mutex);
+        invariant(_state == State::kNotStarted);
+
+        if (!_highFrequencyCollector) {
+            auto highFrequencyCollector = std::make_unique<FTDCHighFrequencyCollector>();
+            _highFrequencyCollector = highFrequencyCollector.get();
+            _periodicCollectors.add(std::move(highFrequencyCollector));
+        }
+
+        _highFrequencyCollector->add(std::move(collector));
+    }
+}
+
 void FTDCController::addOnRotateCollector(std::unique_ptr<FTDCCollectorInterface> collector) {
     {
         stdx::lock_guard<Latch> lock(_mutex);
@@ -208,6 +230,16 @@ void FTDCController::doLoop() noexcept {
         // Get next time to run at
         auto next_time = FTDCUtil::roundTime(now, _config.period);
 
+        // Wake up earlier if the high frequency collectors are due first
+        bool isPeriodicTime = true;
+        if (isHighFrequencySamplingEnabled()) {
+            auto next_high_frequency_time = FTDCUtil::roundTime(now, _config.highFrequencyPeriod);
+            if (next_high_frequency_time < next_time) {
+                next_time = next_high_frequency_time;
+                isPeriodicTime = false;
+            }
+        }
+
         // Wait for the next run or signal to shutdown
         {
             stdx::unique_lock<Latch> lock(_mutex);
@@ -246,6 +278,20 @@ void FTDCController::doLoop() noexcept {
                 _mgr = uassertStatusOK(std::move(swMgr));
             }
 
+            // The high frequency collectors are also sampled at the periodic time, so that each
+            // periodic sample reports the samples up to and including its own time.
+            if (isHighFrequencySamplingEnabled()) {
+                auto period = durationCount<Milliseconds>(_config.period);
+                auto highFrequencyPeriod = durationCount<Milliseconds>(_config.highFrequencyPeriod);
+                _highFrequencyCollector->setSamplesPerPeriod(
+                    (period + highFrequencyPeriod - 1) / highFrequencyPeriod);
+                _highFrequencyCollector->sample(client);
+            }
+
+            if (!isPeriodicTime) {
+                continue;
+            }
+
             auto collectSample = _periodicCollectors.collect(client);
 
             Status s = _mgr->writeSampleAndRotateIfNeeded(
@@ -262,4 +308,9 @@ void FTDCController::doLoop() noexcept {
     }
 }
 
+bool FTDCController::isHighFrequencySamplingEnabled() const {
+    return _highFrequencyCollector && _config.highFrequencyPeriod > Milliseconds(0) &&
+        _config.highFrequencyPeriod < _config.period;
+}
+
 }  // namespace mongo
@@ -75,6 +75,11 @@ public:
      */
     void setPeriod(Milliseconds millis);
 
+    /**
+     * Set the period for sampling the high frequency collectors, or zero to not sample them.
+     */
+    void setHighFrequencyPeriod(Milliseconds millis);
+
     /**
      * Set the maximum directory size in bytes.
      */
@@ -111,6 +116,14 @@ public:
      */
     void addPeriodicCollector(std::unique_ptr<FTDCCollectorInterface> collector);
 
+    /**
+     * Add a cheap metric collector to sample several times per period, i.e. ticket usage
+     *
+     * The samples taken during a period are stored as an array in the next periodic sample, see
+     * FTDCHighFrequencyCollector.
+     */
+    void addHighFrequencyCollector(std::unique_ptr<FTDCCollectorInterface> collector);
+
     /**
      * Add a collector to collect on server start, and file rotation. i.e. hostInfo
      *
@@ -148,6 +161,11 @@ private:
      */
     void doLoop() noexcept;
 
+    /**
+     * Returns true if the high frequency collectors are sampled with the current configuration.
+     */
+    bool isHighFrequencySamplingEnabled() const;
+
 private:
     /**
      * Private enum to track state.
@@ -200,6 +218,10 @@ private:
     // Set of periodic collectors
     FTDCCollectorCollection _periodicCollectors;
 
+    // Collector that samples the high frequency collectors, or null if there are none.
+    // Owned by _periodicCollectors, which reports its samples.
+    FTDCHighFrequencyCollector* _highFrequencyCollector{nullptr};
+
     // Last seen sample document from periodic collectors
     // Owned
     BSONObj _mostRecentPeriodicDocument;
@@ -283,4 +283,104 @@ TEST_F(FTDCControllerTest, TestStartAsDisabled) {
     ValidateDocumentList(alog, allDocs, FTDCValidationMode::kStrict);
 }
 
+// Test the high frequency collectors are sampled several times per period, and reported as a
+// fixed number of samples in each periodic sample
+TEST_F(FTDCControllerTest, TestHighFrequency) {
+    unittest::TempDir tempdir("metrics_testpath");
+    boost::filesystem::path dir(tempdir.path());
+
+    createDirectoryClean(dir);
+
+    FTDCConfig config;
+    config.enabled = true;
+    config.period = Milliseconds(20);
+    config.highFrequencyPeriod = Milliseconds(6);
+    config.maxFileSizeBytes = FTDCConfig::kMaxFileSizeBytesDefault;
+    config.maxDirectorySizeBytes = FTDCConfig::kMaxDirectorySizeBytesDefault;
+
+    FTDCController c(dir, config);
+
+    auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+    auto c2 = std::make_unique<FTDCMetricsCollectorMock2>();
+
+    auto c1Ptr = c1.get();
+    auto c2Ptr = c2.get();
+
+    c1Ptr->setSignalOnCount(10);
+    c2Ptr->setSignalOnCount(30);
+
+    c.addPeriodicCollector(std::move(c1));
+
+    c.addHighFrequencyCollector(std::move(c2));
+
+    c.start();
+
+    // Wait for 10 periodic samples and 30 high frequency samples to have occured
+    c1Ptr->wait();
+    c2Ptr->wait();
+
+    c.stop();
+
+    // The high frequency collector is sampled more often than the periodic collectors
+    ASSERT_GREATER_THAN(c2Ptr->getDocs().size(), c1Ptr->getDocs().size());
+
+    // Each periodic sample holds ceil(20 / 6) high frequency samples
+    auto doc = c.getMostRecentPeriodicDocument();
+    auto samples = doc[kFTDCHighFrequencyCollectorName][kFTDCHighFrequencySamplesField];
+    ASSERT_EQUALS(samples.type(), Array);
+
+    auto samplesArray = samples.Array();
+    ASSERT_EQUALS(samplesArray.size(), 4UL);
+    for (const auto& sample : samplesArray) {
+        ASSERT_EQUALS(sample["mock"]["name"].str(), "joe");
+    }
+
+    auto files = scanDirectory(dir);
+
+    ASSERT_EQUALS(files.size(), 1UL);
+}
+
+// Test the high frequency collector reports a fixed number of samples regardless of how many
+// samples it took
+TEST_F(FTDCControllerTest, TestHighFrequencyCollectorSampleCount) {
+    FTDCHighFrequencyCollector collector;
+
+    auto c1 = std::make_unique<FTDCMetricsCollectorMock2>();
+    auto c1Ptr = c1.get();
+    collector.add(std::move(c1));
+    collector.setSamplesPerPeriod(3);
+
+    auto getKeys = [&] {
+        BSONObjBuilder builder;
+        collector.collect(nullptr, builder);
+        std::vector<int> keys;
+        auto obj = builder.obj();
+        if (obj.isEmpty()) {
+            return keys;
+        }
+        for (const auto& sample : obj[kFTDCHighFrequencySamplesField].Array()) {
+            keys.push_back(sample["mock"]["key1"].numberInt());
+        }
+        return keys;
+    };
+
+    // Nothing is reported before the first sample
+    ASSERT_TRUE(getKeys().empty());
+
+    // Missing samples repeat the most recent one
+    collector.sample(getClient());
+    ASSERT((getKeys() == std::vector<int>{37, 37, 37}));
+
+    // Surplus samples are dropped oldest first
+    for (int i = 0; i < 4; ++i) {
+        collector.sample(getClient());
+    }
+    ASSERT((getKeys() == std::vector<int>{3 * 37, 4 * 37, 5 * 37}));
+
+    // Reported samples are discarded
+    ASSERT_TRUE(getKeys().empty());
+
+    ASSERT_EQUALS(c1Ptr->getDocs().size(), 5UL);
+}
+
 }  // namespace mongo
@@ -43,6 +43,16 @@ namespace mongo {
 
 namespace {
 void registerMongoDCollectors(FTDCController* controller) {
+    // CmdServerStatus, limited to the lock queues, and the ticket and cache usage, which are cheap
+    // enough to sample several times per period to show stalls shorter than the period.
+    controller->addHighFrequencyCollector(std::make_unique<FTDCSimpleInternalCommandCollector>(
+        "serverStatus",
+        "serverStatus",
+        "",
+        BSON("serverStatus" << 1 << "includeDefaultSections" << false << "metrics" << false
+                            << "timing" << false << "globalLock" << true << "wiredTiger"
+                            << BSON("highFrequency" << true))));
+
     // These metrics are only collected if replication is enabled
     if (repl::ReplicationCoordinator::get(getGlobalServiceContext())->getReplicationMode() !=
         repl::ReplicationCoordinator::modeNone) {
@@ -69,6 +69,9 @@ FTDCController* getGlobalFTDCController() {
  */
 synchronized_value<boost::filesystem::path> ftdcDirectoryPathParameter;
 
+// Sampling more often than this would spend more time collecting than running operations.
+constexpr std::int32_t kMinHighFrequencyPeriodMillis = 10;
+
 }  // namespace
 
 FTDCStartupParams ftdcStartupParams;
@@ -117,6 +120,22 @@ Status onUpdateFTDCPeriod(const std::int32_t potentialNewValue) {
     return Status::OK();
 }
 
+Status onUpdateFTDCHighFrequencyPeriod(const std::int32_t potentialNewValue) {
+    if (potentialNewValue > 0 && potentialNewValue < kMinHighFrequencyPeriodMillis) {
+        return Status(ErrorCodes::BadValue,
+                      str::stream() << "diagnosticDataCollectionHighFrequencyPeriodMillis must be "
+                                       "0 or greater than or equal to '"
+                                    << kMinHighFrequencyPeriodMillis << "'.");
+    }
+
+    auto controller = getGlobalFTDCController();
+    if (controller) {
+        controller->setHighFrequencyPeriod(Milliseconds(potentialNewValue));
+    }
+
+    return Status::OK();
+}
+
 Status onUpdateFTDCDirectorySize(const std::int32_t potentialNewValue) {
     if (potentialNewValue < ftdcStartupParams.maxFileSizeMB.load()) {
         return Status(
@@ -235,6 +254,11 @@ public:
             BSONObjBuilder subObjBuilder(commandBuilder.subobjStart("opLatencies"));
             subObjBuilder.append("histograms", true);
             subObjBuilder.append("slowBuckets", true);
+            subObjBuilder.doneFast();
+
+            // Only the percentiles of each command and namespace, as their full histograms would
+            // change shape too often to compress well.
+            commandBuilder.append("operationLatencyHistograms", true);
         }
 
         if (gDiagnosticDataCollectionVerboseTCMalloc.load()) {
@@ -277,6 +301,8 @@ void startFTDC(boost::filesystem::path& path,
                RegisterCollectorsFunction registerCollectors) {
     FTDCConfig config;
     config.period = Milliseconds(ftdcStartupParams.periodMillis.load());
+    config.highFrequencyPeriod =
+        Milliseconds(ftdcStartupParams.highFrequencyPeriodMillis.load());
     // Only enable FTDC if our caller says to enable FTDC, MongoS may not have a valid path to write
     // files to so update the diagnosticDataCollectionEnabled set parameter to reflect that.
     ftdcStartupParams.enabled.store(startupMode == FTDCStartMode::kStart &&
@@ -64,6 +64,9 @@ const char kFTDCDocsField[] = "docs";
 const char kFTDCCollectStartField[] = "start";
 const char kFTDCCollectEndField[] = "end";
 
+const char kFTDCHighFrequencyCollectorName[] = "highFrequency";
+const char kFTDCHighFrequencySamplesField[] = "samples";
+
 const std::int64_t FTDCConfig::kPeriodMillisDefault = 1000;
 
 const std::size_t kMaxRecursion = 10;
@@ -84,6 +84,14 @@ public:
      */
     virtual std::unique_ptr<FTSTokenizer> createTokenizer() const = 0;
 
+    /**
+     * Returns a tokenizer for this language which belongs to the calling thread. It is created on
+     * the thread's first call and reused by later ones, so that the words its stemmer remembers
+     * carry over from one document to the next. The caller must be done with the tokenizer before
+     * the thread calls this again for the same language.
+     */
+    FTSTokenizer* getThreadLocalTokenizer() const;
+
     /**
      * Returns a reference to the phrase matcher instance that this language owns.
      */
@@ -79,7 +79,7 @@ bool FTSMatcher::hasPositiveTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasPositiveTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    FTSTokenizer* tokenizer = language->getThreadLocalTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
     while (tokenizer->moveNext()) {
@@ -109,7 +109,7 @@ bool FTSMatcher::hasNegativeTerm(const BSONObj& obj) const {
 }
 
 bool FTSMatcher::_hasNegativeTerm_string(const FTSLanguage* language, const string& raw) const {
-    std::unique_ptr<FTSTokenizer> tokenizer(language->createTokenizer());
+    FTSTokenizer* tokenizer = language->getThreadLocalTokenizer();
     tokenizer->reset(raw.c_str(), _getTokenizerOptions());
 
     while (tokenizer->moveNext()) {
@@ -179,8 +179,8 @@ void FTSSpec::scoreDocument(const BSONObj& obj, TermFrequencyMap* term_freqs) co
 
     while (it.more()) {
         FTSIteratorValue val = it.next();
-        std::unique_ptr<FTSTokenizer> tokenizer(val._language->createTokenizer());
-        _scoreStringV2(tokenizer.get(), val._text, term_freqs, val._weight);
+        _scoreStringV2(
+            val._language->getThreadLocalTokenizer(), val._text, term_freqs, val._weight);
     }
 }
 
@@ -53,6 +53,10 @@ StringData Stemmer::stem(StringData word) const {
     if (!_stemmer)
         return word;
 
+    if (auto it = _memo.find(word); it != _memo.end()) {
+        return it->second;
+    }
+
     const sb_symbol* sb_sym =
         sb_stemmer_stem(_stemmer, (const sb_symbol*)word.rawData(), word.size());
 
@@ -61,7 +65,13 @@ StringData Stemmer::stem(StringData word) const {
         MONGO_UNREACHABLE;
     }
 
-    return StringData((const char*)(sb_sym), sb_stemmer_length(_stemmer));
+    if (_memo.size() >= kMaxMemoEntries) {
+        _memo.clear();
+    }
+    auto stem = _memo.try_emplace(word.toString(),
+                                  (const char*)(sb_sym),
+                                  static_cast<size_t>(sb_stemmer_length(_stemmer)));
+    return stem.first->second;
 }
 }  // namespace fts
 }  // namespace mongo
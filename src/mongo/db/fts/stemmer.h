@@ -30,8 +30,11 @@
 
 #pragma once
 
+#include <string>
+
 #include "mongo/base/string_data.h"
 #include "mongo/db/fts/fts_language.h"
+#include "mongo/util/string_map.h"
 #include "third_party/libstemmer_c/include/libstemmer.h"
 
 namespace mongo {
@@ -57,11 +60,19 @@ public:
      * The returned StringData is valid until the next call to any method on this object. Since the
      * input may be returned unmodified, the output's lifetime may also expire when the input's
      * does.
+     *
+     * Stems are remembered, so stemming a word this Stemmer has seen before is a hash lookup.
      */
     StringData stem(StringData word) const;
 
 private:
+    // The most stems remembered. The memo is emptied when it is full.
+    static constexpr size_t kMaxMemoEntries = 16 * 1024;
+
     struct sb_stemmer* _stemmer;
+
+    // Maps words stemmed by '_stemmer' to their stems.
+    mutable StringMap<std::string> _memo;
 };
 }  // namespace fts
 }  // namespace mongo
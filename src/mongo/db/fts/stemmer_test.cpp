@@ -32,6 +32,7 @@
 
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/fts/stemmer.h"
+#include "mongo/util/str.h"
 
 namespace mongo {
 namespace fts {
@@ -56,5 +57,22 @@ TEST(English, Caps) {
     ASSERT_EQUALS("unit", s.stem("united"));
     ASSERT_EQUALS("Unite", s.stem("United"));
 }
+
+TEST(English, RepeatedWordsStemTheSame) {
+    Stemmer s(languageEnglishV2());
+    ASSERT_EQUALS("run", s.stem("running"));
+    ASSERT_EQUALS("jump", s.stem("jumping"));
+    ASSERT_EQUALS("run", s.stem("running"));
+    ASSERT_EQUALS("jump", s.stem("jumping"));
+}
+
+TEST(English, ManyDistinctWords) {
+    Stemmer s(languageEnglishV2());
+    for (int i = 0; i < 40 * 1000; ++i) {
+        std::string word = str::stream() << "word" << i;
+        ASSERT_EQUALS(word, s.stem(word + "ing"));
+    }
+    ASSERT_EQUALS("run", s.stem("running"));
+}
 }  // namespace fts
 }  // namespace mongo
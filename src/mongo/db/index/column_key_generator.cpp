@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/column_key_generator.h"
+
+namespace mongo {
+namespace {
+
+const BSONObj kRowMarkerPathWrapper = BSON("" << MINKEY);
+
+void appendPath(KeyString::Builder* builder, boost::optional<StringData> path) {
+    if (path) {
+        builder->appendString(*path);
+    } else {
+        builder->appendBSONElement(kRowMarkerPathWrapper.firstElement());
+    }
+}
+
+void checkRecordId(const RecordId& id) {
+    uassert(5963029,
+            "columnstore indexes require record ids which are 64-bit integers",
+            id.withFormat([](RecordId::Null) { return false; },
+                          [](int64_t) { return true; },
+                          [](const char*, int) { return false; }));
+}
+
+}  // namespace
+
+ColumnKeyGenerator::ColumnKeyGenerator(KeyString::Version keyStringVersion, Ordering ordering)
+    : _keyStringVersion(keyStringVersion), _ordering(ordering) {}
+
+void ColumnKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                      const BSONObj& doc,
+                                      KeyStringSet* keys,
+                                      const RecordId& id) const {
+    checkRecordId(id);
+
+    auto keysSequence = keys->extract_sequence();
+    KeyString::PooledBuilder rowMarker(pooledBufferBuilder, _keyStringVersion, _ordering);
+    rowMarker.appendBSONElement(kRowMarkerPathWrapper.firstElement());
+    rowMarker.appendNumberLong(id.getLong());
+    rowMarker.appendRecordId(id);
+    keysSequence.push_back(rowMarker.release());
+
+    std::string path;
+    _traverse(pooledBufferBuilder, doc, &path, &keysSequence, id);
+    keys->adopt_sequence(std::move(keysSequence));
+}
+
+void ColumnKeyGenerator::_traverse(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                   const BSONObj& obj,
+                                   std::string* path,
+                                   KeyStringSet::sequence_type* keys,
+                                   const RecordId& id) const {
+    for (const auto& elem : obj) {
+        const auto fieldName = elem.fieldNameStringData();
+        if (fieldName.find('.', 0) != std::string::npos) {
+            continue;
+        }
+
+        const auto prefixLength = path->size();
+        if (prefixLength) {
+            path->push_back('.');
+        }
+        path->append(fieldName.rawData(), fieldName.size());
+
+        if (elem.type() == BSONType::Object && !elem.Obj().isEmpty()) {
+            _traverse(pooledBufferBuilder, elem.Obj(), path, keys, id);
+        } else {
+            _addCell(pooledBufferBuilder, elem, *path, keys, id);
+        }
+
+        path->resize(prefixLength);
+    }
+}
+
+void ColumnKeyGenerator::_addCell(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                                  BSONElement elem,
+                                  StringData path,
+                                  KeyStringSet::sequence_type* keys,
+                                  const RecordId& id) const {
+    KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
+    keyString.appendString(path);
+    keyString.appendNumberLong(id.getLong());
+    keyString.appendBSONElement(elem);
+    keyString.appendRecordId(id);
+    keys->push_back(keyString.release());
+}
+
+KeyString::Value ColumnKeyGenerator::makeSeekKey(KeyString::Version keyStringVersion,
+                                                 Ordering ordering,
+                                                 boost::optional<StringData> path,
+                                                 boost::optional<RecordId> id) {
+    KeyString::Builder builder(
+        keyStringVersion, ordering, KeyString::Discriminator::kExclusiveBefore);
+    appendPath(&builder, path);
+    if (id) {
+        checkRecordId(*id);
+        builder.appendNumberLong(id->getLong());
+    }
+    return builder.getValueCopy();
+}
+
+KeyString::Value ColumnKeyGenerator::makeEndKey(KeyString::Version keyStringVersion,
+                                                Ordering ordering,
+                                                boost::optional<StringData> path) {
+    KeyString::Builder builder(
+        keyStringVersion, ordering, KeyString::Discriminator::kExclusiveAfter);
+    appendPath(&builder, path);
+    return builder.getValueCopy();
+}
+
+}  // namespace mongo
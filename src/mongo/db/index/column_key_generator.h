@@ -0,0 +1,101 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/bson/ordering.h"
+#include "mongo/db/jsobj.h"
+#include "mongo/db/record_id.h"
+#include "mongo/db/storage/key_string.h"
+
+namespace mongo {
+
+/**
+ * Generates the keys of a columnstore index, which stores each path of a document in its own
+ * "column": a run of cells ordered by the RecordId of the document they come from. A reader which
+ * needs only a few of the paths of wide documents can then scan just those columns.
+ *
+ * Each cell is a key of the form
+ *      { '': 'path.to.field', '': NumberLong(<record id>), '': <value> }
+ * followed by the RecordId itself, so that the index orders the cells of a path by record id
+ * rather than by value. Every document also has a row marker cell
+ *      { '': MinKey, '': NumberLong(<record id>) }
+ * so that the documents can be enumerated whatever their fields; it sorts before all the columns.
+ *
+ * Only leaf values are stored: scalars, arrays (whole, without descending into them) and empty
+ * objects. Fields whose names contain a '.' are skipped, since they cannot be told apart from a
+ * path. Record ids must be 64-bit integers.
+ */
+class ColumnKeyGenerator {
+public:
+    ColumnKeyGenerator(KeyString::Version keyStringVersion, Ordering ordering);
+
+    /**
+     * Adds the row marker and one cell for each leaf path of 'doc' to 'keys'.
+     */
+    void generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                      const BSONObj& doc,
+                      KeyStringSet* keys,
+                      const RecordId& id) const;
+
+    /**
+     * Returns a key which sorts immediately before the cell of 'path' for 'id', or before the
+     * first cell of 'path' if 'id' is not given. A missing 'path' denotes the row markers.
+     */
+    static KeyString::Value makeSeekKey(KeyString::Version keyStringVersion,
+                                        Ordering ordering,
+                                        boost::optional<StringData> path,
+                                        boost::optional<RecordId> id);
+
+    /**
+     * Returns a key which sorts after every cell of 'path', and before the cells of any other path
+     * which sort after it. A missing 'path' denotes the row markers.
+     */
+    static KeyString::Value makeEndKey(KeyString::Version keyStringVersion,
+                                       Ordering ordering,
+                                       boost::optional<StringData> path);
+
+private:
+    void _traverse(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                   const BSONObj& obj,
+                   std::string* path,
+                   KeyStringSet::sequence_type* keys,
+                   const RecordId& id) const;
+
+    void _addCell(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                  BSONElement elem,
+                  StringData path,
+                  KeyStringSet::sequence_type* keys,
+                  const RecordId& id) const;
+
+    const KeyString::Version _keyStringVersion;
+    const Ordering _ordering;
+};
+}  // namespace mongo
@@ -0,0 +1,177 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const Ordering kOrdering = Ordering::make(BSONObj());
+
+// Returns the row marker and cells of the document with record id 'id', given as the path and
+// value of each cell.
+KeyStringSet makeKeySet(const RecordId& id, std::initializer_list<BSONObj> cells = {}) {
+    KeyStringSet keys;
+    KeyString::HeapBuilder rowMarker(KeyString::Version::kLatestVersion, kOrdering);
+    rowMarker.appendBSONElement(BSON("" << MINKEY).firstElement());
+    rowMarker.appendNumberLong(id.getLong());
+    rowMarker.appendRecordId(id);
+    keys.insert(rowMarker.release());
+    for (const auto& cell : cells) {
+        KeyString::HeapBuilder keyString(KeyString::Version::kLatestVersion, kOrdering);
+        keyString.appendString(cell.firstElement().String());
+        keyString.appendNumberLong(id.getLong());
+        keyString.appendBSONElement(cell["value"]);
+        keyString.appendRecordId(id);
+        keys.insert(keyString.release());
+    }
+    return keys;
+}
+
+std::string dumpKeyset(const KeyStringSet& keyStrings) {
+    std::stringstream ss;
+    ss << "[ ";
+    for (auto& keyString : keyStrings) {
+        ss << KeyString::toBson(keyString.getBuffer(),
+                                KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(),
+                                                                    keyString.getSize()),
+                                kOrdering,
+                                keyString.getTypeBits())
+                  .toString()
+           << " ";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+struct ColumnKeyGeneratorTest : public unittest::Test {
+    KeyStringSet generateKeys(const BSONObj& doc, const RecordId& id) {
+        KeyStringSet keys;
+        keyGen.generateKeys(allocator, doc, &keys, id);
+        return keys;
+    }
+
+    SharedBufferFragmentBuilder allocator{KeyString::HeapBuilder::kHeapAllocatorDefaultBytes};
+    ColumnKeyGenerator keyGen{KeyString::Version::kLatestVersion, kOrdering};
+};
+
+void assertKeysetsEqual(const KeyStringSet& expectedKeys, const KeyStringSet& actualKeys) {
+    ASSERT(std::equal(expectedKeys.begin(),
+                      expectedKeys.end(),
+                      actualKeys.begin(),
+                      actualKeys.end()))
+        << "Expected: " << dumpKeyset(expectedKeys) << ", Actual: " << dumpKeyset(actualKeys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, EmptyDocumentHasOnlyRowMarker) {
+    const RecordId id(7);
+    auto keys = generateKeys(BSONObj(), id);
+    assertKeysetsEqual(makeKeySet(id), keys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, ExtractTopLevelFields) {
+    const RecordId id(1);
+    auto keys = generateKeys(fromjson("{_id: 5, a: 'x', b: null}"), id);
+    assertKeysetsEqual(makeKeySet(id,
+                                  {fromjson("{path: '_id', value: 5}"),
+                                   fromjson("{path: 'a', value: 'x'}"),
+                                   fromjson("{path: 'b', value: null}")}),
+                       keys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, DescendIntoObjectsButStoreEmptyObjectsWhole) {
+    const RecordId id(2);
+    auto keys = generateKeys(fromjson("{a: {b: 1, c: {d: 2}}, e: {}}"), id);
+    assertKeysetsEqual(makeKeySet(id,
+                                  {fromjson("{path: 'a.b', value: 1}"),
+                                   fromjson("{path: 'a.c.d', value: 2}"),
+                                   fromjson("{path: 'e', value: {}}")}),
+                       keys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, StoreArraysWhole) {
+    const RecordId id(3);
+    auto keys = generateKeys(fromjson("{a: [1, {b: 2}, [3]], c: []}"), id);
+    assertKeysetsEqual(makeKeySet(id,
+                                  {fromjson("{path: 'a', value: [1, {b: 2}, [3]]}"),
+                                   fromjson("{path: 'c', value: []}")}),
+                       keys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, SkipFieldsWithDottedNames) {
+    const RecordId id(4);
+    auto keys = generateKeys(fromjson("{'a.b': 1, c: {'d.e': 2, f: 3}}"), id);
+    assertKeysetsEqual(makeKeySet(id, {fromjson("{path: 'c.f', value: 3}")}), keys);
+}
+
+TEST_F(ColumnKeyGeneratorTest, CellsOfAPathAreOrderedByRecordId) {
+    // The cells of one path sort by record id whatever their values, after all row markers, and
+    // between the seek and end keys of the path.
+    auto keys = generateKeys(fromjson("{a: 'z'}"), RecordId(1));
+    auto laterKeys = generateKeys(fromjson("{a: -1}"), RecordId(2));
+    ASSERT_EQ(keys.size(), 2U);
+    ASSERT_EQ(laterKeys.size(), 2U);
+    const auto& rowMarker = *keys.begin();
+    const auto& cell = *keys.rbegin();
+    const auto& laterRowMarker = *laterKeys.begin();
+    const auto& laterCell = *laterKeys.rbegin();
+    ASSERT_LT(rowMarker.compare(laterRowMarker), 0);
+    ASSERT_LT(laterRowMarker.compare(cell), 0);
+    ASSERT_LT(cell.compare(laterCell), 0);
+
+    const auto version = KeyString::Version::kLatestVersion;
+    auto rowSeekKey = ColumnKeyGenerator::makeSeekKey(version, kOrdering, boost::none, boost::none);
+    auto rowEndKey = ColumnKeyGenerator::makeEndKey(version, kOrdering, boost::none);
+    ASSERT_LT(rowSeekKey.compare(rowMarker), 0);
+    ASSERT_LT(laterRowMarker.compare(rowEndKey), 0);
+    ASSERT_LT(rowEndKey.compare(cell), 0);
+
+    auto seekKey = ColumnKeyGenerator::makeSeekKey(version, kOrdering, "a"_sd, RecordId(2));
+    auto endKey = ColumnKeyGenerator::makeEndKey(version, kOrdering, "a"_sd);
+    ASSERT_LT(cell.compare(seekKey), 0);
+    ASSERT_LT(seekKey.compare(laterCell), 0);
+    ASSERT_LT(laterCell.compare(endKey), 0);
+    auto nextPathCell = *generateKeys(fromjson("{a0: 1}"), RecordId(1)).rbegin();
+    ASSERT_LT(endKey.compare(nextPathCell), 0);
+}
+
+TEST_F(ColumnKeyGeneratorTest, RejectStringRecordIds) {
+    const char str[] = "abc";
+    ASSERT_THROWS_CODE(generateKeys(fromjson("{a: 1}"), RecordId(str, sizeof(str) - 1)),
+                       AssertionException,
+                       5963029);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/db/index/column_key_generator.h"
+#include "mongo/db/index/index_access_method.h"
+
+namespace mongo {
+
+/**
+ * The access method for columnstore indexes, created with { "$**": "columnstore" }. The index
+ * holds one column of cells per path of the collection's documents, which the storage engine's
+ * key prefix compression stores compactly, since the cells of a column share their path and most
+ * of their record id. See ColumnKeyGenerator for the layout of the cells.
+ *
+ * The index is never marked multikey: arrays are stored whole, as values.
+ */
+class ColumnStoreAccessMethod final : public AbstractIndexAccessMethod {
+public:
+    ColumnStoreAccessMethod(IndexCatalogEntry* columnState,
+                            std::unique_ptr<SortedDataInterface> btree);
+
+    bool shouldMarkIndexAsMultikey(size_t numberOfKeys,
+                                   const KeyStringSet& multikeyMetadataKeys,
+                                   const MultikeyPaths& multikeyPaths) const final;
+
+private:
+    void doGetKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
+                   const BSONObj& obj,
+                   GetKeysContext context,
+                   KeyStringSet* keys,
+                   KeyStringSet* multikeyMetadataKeys,
+                   MultikeyPaths* multikeyPaths,
+                   boost::optional<RecordId> id) const final;
+
+    const ColumnKeyGenerator _keyGen;
+};
+}  // namespace mongo
@@ -44,6 +44,7 @@
 #include "mongo/db/geo/s2.h"
 #include "mongo/db/index/2d_common.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/logv2/log.h"
@@ -65,6 +66,15 @@ namespace dps = ::mongo::dotted_path_support;
 Status S2GetKeysForElement(const BSONElement& element,
                            const S2IndexingParams& params,
                            vector<S2CellId>* out) {
+    boost::optional<SHA256Block> geometryHash;
+    if (params.coveringCache && S2CoveringCache::shouldCache(element)) {
+        geometryHash = S2CoveringCache::hash(element);
+        if (auto covering = params.coveringCache->find(*geometryHash)) {
+            *out = std::move(*covering);
+            return Status::OK();
+        }
+    }
+
     GeometryContainer geoContainer;
     Status status = geoContainer.parseFromStorage(element);
     if (!status.isOK())
@@ -95,7 +105,17 @@ Status S2GetKeysForElement(const BSONElement& element,
 
     invariant(geoContainer.hasS2Region());
 
+    if (geoContainer.isPoint() && params.indexVersion >= S2_INDEX_VERSION_3) {
+        // Points are indexed at the leaf level, so the covering of a point is the leaf cell which
+        // is its region, and there is no need to run the coverer.
+        out->push_back(static_cast<const S2Cell&>(geoContainer.getS2Region()).id());
+        return Status::OK();
+    }
+
     coverer.GetCovering(geoContainer.getS2Region(), out);
+    if (geometryHash) {
+        params.coveringCache->add(*geometryHash, *out);
+    }
     return Status::OK();
 }
 
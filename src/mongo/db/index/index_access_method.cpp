@@ -106,6 +106,9 @@ struct BtreeExternalSortComparison {
     int operator()(const Data& l, const Data& r) const {
         return l.first.compare(r.first);
     }
+    static StringData binaryComparableKey(const Data& data) {
+        return {data.first.getBuffer(), data.first.getSize()};
+    }
 };
 
 AbstractIndexAccessMethod::AbstractIndexAccessMethod(IndexCatalogEntry* btreeState,
@@ -215,6 +218,24 @@ Status AbstractIndexAccessMethod::insertKeys(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status AbstractIndexAccessMethod::insertKeysBatch(OperationContext* opCtx,
+                                                  const KeyStringSet& keys,
+                                                  int64_t* numInserted) {
+    // Unique indexes need the per-key duplicate handling of insertKeys().
+    invariant(!_descriptor->unique());
+    if (numInserted) {
+        *numInserted = 0;
+    }
+    Status status = _newInterface->insertBatch(opCtx, keys, true /* dupsAllowed */);
+    if (!status.isOK()) {
+        return status;
+    }
+    if (numInserted) {
+        *numInserted = keys.size();
+    }
+    return Status::OK();
+}
+
 void AbstractIndexAccessMethod::removeOneKey(OperationContext* opCtx,
                                              const KeyString::Value& keyString,
                                              const RecordId& loc,
@@ -265,36 +286,39 @@ Status AbstractIndexAccessMethod::initializeAsEmpty(OperationContext* opCtx) {
     return _newInterface->initAsEmpty(opCtx);
 }
 
+KeyString::Value AbstractIndexAccessMethod::makeSingleKeyString(
+    OperationContext* opCtx, const BSONObj& requestedKey) const {
+    if (_indexCatalogEntry->getCollator()) {
+        // For performance, call get keys only if there is a non-simple collation.
+        auto& executionCtx = StorageExecutionContext::get(opCtx);
+        auto keys = executionCtx.keys();
+        KeyStringSet* multikeyMetadataKeys = nullptr;
+        MultikeyPaths* multikeyPaths = nullptr;
+
+        getKeys(executionCtx.pooledBufferBuilder(),
+                requestedKey,
+                GetKeysMode::kEnforceConstraints,
+                GetKeysContext::kAddingKeys,
+                keys.get(),
+                multikeyMetadataKeys,
+                multikeyPaths,
+                boost::none,  // loc
+                kNoopOnSuppressedErrorFn);
+        invariant(keys->size() == 1);
+        return *keys->begin();
+    } else {
+        KeyString::HeapBuilder requestedKeyString(
+            getSortedDataInterface()->getKeyStringVersion(),
+            BSONObj::stripFieldNames(requestedKey),
+            getSortedDataInterface()->getOrdering());
+        return requestedKeyString.release();
+    }
+}
+
 RecordId AbstractIndexAccessMethod::findSingle(OperationContext* opCtx,
                                                const BSONObj& requestedKey) const {
     // Generate the key for this index.
-    KeyString::Value actualKey = [&]() {
-        if (_indexCatalogEntry->getCollator()) {
-            // For performance, call get keys only if there is a non-simple collation.
-            auto& executionCtx = StorageExecutionContext::get(opCtx);
-            auto keys = executionCtx.keys();
-            KeyStringSet* multikeyMetadataKeys = nullptr;
-            MultikeyPaths* multikeyPaths = nullptr;
-
-            getKeys(executionCtx.pooledBufferBuilder(),
-                    requestedKey,
-                    GetKeysMode::kEnforceConstraints,
-                    GetKeysContext::kAddingKeys,
-                    keys.get(),
-                    multikeyMetadataKeys,
-                    multikeyPaths,
-                    boost::none,  // loc
-                    kNoopOnSuppressedErrorFn);
-            invariant(keys->size() == 1);
-            return *keys->begin();
-        } else {
-            KeyString::HeapBuilder requestedKeyString(
-                getSortedDataInterface()->getKeyStringVersion(),
-                BSONObj::stripFieldNames(requestedKey),
-                getSortedDataInterface()->getOrdering());
-            return requestedKeyString.release();
-        }
-    }();
+    KeyString::Value actualKey = makeSingleKeyString(opCtx, requestedKey);
 
     std::unique_ptr<SortedDataInterface::Cursor> cursor(_newInterface->newCursor(opCtx));
     const auto requestedInfo = kDebugBuild ? SortedDataInterface::Cursor::kKeyAndLoc
@@ -470,8 +494,9 @@ Status AbstractIndexAccessMethod::update(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status AbstractIndexAccessMethod::compact(OperationContext* opCtx) {
-    return this->_newInterface->compact(opCtx);
+Status AbstractIndexAccessMethod::compact(OperationContext* opCtx,
+                                          boost::optional<Seconds> timeLimit) {
+    return this->_newInterface->compact(opCtx, timeLimit);
 }
 
 class AbstractIndexAccessMethod::BulkBuilderImpl : public IndexAccessMethod::BulkBuilder {
@@ -490,6 +515,21 @@ public:
                   const RecordId& loc,
                   const InsertDeleteOptions& options) final;
 
+    Status insert(OperationContext* opCtx,
+                  const BSONObj& obj,
+                  const RecordId& loc,
+                  const InsertDeleteOptions& options,
+                  std::vector<RecordId>* skippedRecords) final;
+
+    Status generateKeys(OperationContext* opCtx,
+                        const BSONObj& obj,
+                        const RecordId& loc,
+                        const InsertDeleteOptions& options,
+                        GeneratedKeys* generatedKeys,
+                        std::vector<RecordId>* skippedRecords) const final;
+
+    void insertKeys(const GeneratedKeys& generatedKeys) final;
+
     const MultikeyPaths& getMultikeyPaths() const final;
 
     bool isMultikey() const final;
@@ -505,6 +545,26 @@ public:
     Sorter::PersistedState persistDataForShutdown() final;
 
 private:
+    Status _insert(OperationContext* opCtx,
+                   const BSONObj& obj,
+                   const RecordId& loc,
+                   const InsertDeleteOptions& options,
+                   std::vector<RecordId>* skippedRecords);
+
+    /**
+     * Records the multikey paths of a document and adds its keys to the sorter.
+     */
+    void _addKeys(const KeyStringSet& keys, const MultikeyPaths& multikeyPaths);
+
+    /**
+     * Returns the callback that getKeys() invokes when it suppresses a key generation error.
+     */
+    IndexAccessMethod::OnSuppressedErrorFn _makeOnSuppressedError(
+        OperationContext* opCtx,
+        const BSONObj& obj,
+        const RecordId& loc,
+        std::vector<RecordId>* skippedRecords) const;
+
     void _insertMultikeyMetadataKeysIntoSorter();
 
     Sorter* _makeSorter(
@@ -562,6 +622,23 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
                                                           const BSONObj& obj,
                                                           const RecordId& loc,
                                                           const InsertDeleteOptions& options) {
+    return _insert(opCtx, obj, loc, options, nullptr);
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCtx,
+                                                          const BSONObj& obj,
+                                                          const RecordId& loc,
+                                                          const InsertDeleteOptions& options,
+                                                          std::vector<RecordId>* skippedRecords) {
+    invariant(skippedRecords);
+    return _insert(opCtx, obj, loc, options, skippedRecords);
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::_insert(OperationContext* opCtx,
+                                                           const BSONObj& obj,
+                                                           const RecordId& loc,
+                                                           const InsertDeleteOptions& options,
+                                                           std::vector<RecordId>* skippedRecords) {
     auto& executionCtx = StorageExecutionContext::get(opCtx);
 
     auto keys = executionCtx.keys();
@@ -577,48 +654,98 @@ Status AbstractIndexAccessMethod::BulkBuilderImpl::insert(OperationContext* opCt
             &_multikeyMetadataKeys,
             multikeyPaths.get(),
             loc,
-            [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                // If a key generation error was suppressed, record the document as "skipped" so the
-                // index builder can retry at a point when data is consistent.
-                auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
-                if (interceptor && interceptor->getSkippedRecordTracker()) {
-                    LOGV2_DEBUG(20684,
-                                1,
-                                "Recording suppressed key generation error to retry later: "
-                                "{error} on {loc}: {obj}",
-                                "error"_attr = status,
-                                "loc"_attr = loc,
-                                "obj"_attr = redact(obj));
-                    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                }
-            });
+            _makeOnSuppressedError(opCtx, obj, loc, skippedRecords));
+    } catch (...) {
+        return exceptionToStatus();
+    }
+
+    _addKeys(*keys, *multikeyPaths);
+    return Status::OK();
+}
+
+Status AbstractIndexAccessMethod::BulkBuilderImpl::generateKeys(
+    OperationContext* opCtx,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const InsertDeleteOptions& options,
+    GeneratedKeys* generatedKeys,
+    std::vector<RecordId>* skippedRecords) const {
+    invariant(skippedRecords);
+    auto& executionCtx = StorageExecutionContext::get(opCtx);
+
+    try {
+        _indexCatalogEntry->accessMethod()->getKeys(
+            executionCtx.pooledBufferBuilder(),
+            obj,
+            options.getKeysMode,
+            GetKeysContext::kAddingKeys,
+            &generatedKeys->keys,
+            &generatedKeys->multikeyMetadataKeys,
+            &generatedKeys->multikeyPaths,
+            loc,
+            _makeOnSuppressedError(opCtx, obj, loc, skippedRecords));
     } catch (...) {
         return exceptionToStatus();
     }
+    return Status::OK();
+}
 
-    if (!multikeyPaths->empty()) {
+void AbstractIndexAccessMethod::BulkBuilderImpl::insertKeys(const GeneratedKeys& generatedKeys) {
+    _multikeyMetadataKeys.insert(generatedKeys.multikeyMetadataKeys.begin(),
+                                 generatedKeys.multikeyMetadataKeys.end());
+    _addKeys(generatedKeys.keys, generatedKeys.multikeyPaths);
+}
+
+IndexAccessMethod::OnSuppressedErrorFn
+AbstractIndexAccessMethod::BulkBuilderImpl::_makeOnSuppressedError(
+    OperationContext* opCtx,
+    const BSONObj& obj,
+    const RecordId& loc,
+    std::vector<RecordId>* skippedRecords) const {
+    return [=](Status status, const BSONObj&, boost::optional<RecordId>) {
+        // If a key generation error was suppressed, record the document as "skipped" so the
+        // index builder can retry at a point when data is consistent.
+        auto interceptor = _indexCatalogEntry->indexBuildInterceptor();
+        if (interceptor && interceptor->getSkippedRecordTracker()) {
+            LOGV2_DEBUG(20684,
+                        1,
+                        "Recording suppressed key generation error to retry later: "
+                        "{error} on {loc}: {obj}",
+                        "error"_attr = status,
+                        "loc"_attr = loc,
+                        "obj"_attr = redact(obj));
+            if (skippedRecords) {
+                skippedRecords->push_back(loc);
+            } else {
+                interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+            }
+        }
+    };
+}
+
+void AbstractIndexAccessMethod::BulkBuilderImpl::_addKeys(const KeyStringSet& keys,
+                                                          const MultikeyPaths& multikeyPaths) {
+    if (!multikeyPaths.empty()) {
         if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
+            _indexMultikeyPaths = multikeyPaths;
         } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
+            invariant(_indexMultikeyPaths.size() == multikeyPaths.size());
+            for (size_t i = 0; i < multikeyPaths.size(); ++i) {
                 _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
+                                              multikeyPaths[i].begin(),
+                                              multikeyPaths[i].end());
             }
         }
     }
 
-    for (const auto& keyString : *keys) {
+    for (const auto& keyString : keys) {
         _sorter->add(keyString, mongo::NullValue());
         ++_keysInserted;
     }
 
     _isMultiKey = _isMultiKey ||
         _indexCatalogEntry->accessMethod()->shouldMarkIndexAsMultikey(
-            keys->size(), _multikeyMetadataKeys, *multikeyPaths);
-
-    return Status::OK();
+            keys.size(), _multikeyMetadataKeys, multikeyPaths);
 }
 
 const MultikeyPaths& AbstractIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
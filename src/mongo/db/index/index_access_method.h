@@ -123,6 +123,16 @@ public:
                               KeyHandlerFn&& onDuplicateKey,
                               int64_t* numInserted) = 0;
 
+    /**
+     * Inserts the keys generated for several documents, sorted together, into a non-unique index
+     * with a single pass over the SortedDataInterface. Like insertKeys(), does not attempt to
+     * determine whether the keys should cause the index to become multikey. The 'numInserted'
+     * output parameter, if non-nullptr, is set as for insertKeys().
+     */
+    virtual Status insertKeysBatch(OperationContext* opCtx,
+                                   const KeyStringSet& keys,
+                                   int64_t* numInserted) = 0;
+
     /**
      * Analogous to insertKeys above, but remove the keys instead of inserting them.
      * 'numDeleted' will be set to the number of keys removed from the index for the provided keys.
@@ -212,11 +222,18 @@ public:
 
     virtual RecordId findSingle(OperationContext* opCtx, const BSONObj& key) const = 0;
 
+    /**
+     * Returns the KeyString that findSingle() seeks to for 'key', applying the index collation if
+     * there is one.
+     */
+    virtual KeyString::Value makeSingleKeyString(OperationContext* opCtx,
+                                                 const BSONObj& key) const = 0;
+
     /**
      * Attempt compaction to regain disk space if the indexed record store supports
-     * compaction-in-place.
+     * compaction-in-place. 'timeLimit' has the same meaning as for RecordStore::compact().
      */
-    virtual Status compact(OperationContext* opCtx) = 0;
+    virtual Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) = 0;
 
     /**
      * Sets this index as multikey with the provided paths.
@@ -244,6 +261,43 @@ public:
                               const RecordId& loc,
                               const InsertDeleteOptions& options) = 0;
 
+        /**
+         * Same as above, except that the RecordIds of the documents whose key generation errors
+         * were suppressed are appended to 'skippedRecords' rather than recorded with the index
+         * build interceptor. 'opCtx' is then only used for its execution context, so this may be
+         * called from a thread other than the one running the index build, as long as only one
+         * thread uses the BulkBuilder at a time.
+         */
+        virtual Status insert(OperationContext* opCtx,
+                              const BSONObj& obj,
+                              const RecordId& loc,
+                              const InsertDeleteOptions& options,
+                              std::vector<RecordId>* skippedRecords) = 0;
+
+        /**
+         * The keys generated for a single document by generateKeys().
+         */
+        struct GeneratedKeys {
+            KeyStringSet keys;
+            KeyStringSet multikeyMetadataKeys;
+            MultikeyPaths multikeyPaths;
+        };
+
+        /**
+         * Splits insert() in two, so that the keys of different documents can be generated by
+         * several threads at once. generateKeys() only reads the state of the BulkBuilder and may
+         * be called concurrently, with 'skippedRecords' handled as by insert() above. The keys are
+         * then added with insertKeys(), which must not run concurrently with any other method.
+         */
+        virtual Status generateKeys(OperationContext* opCtx,
+                                    const BSONObj& obj,
+                                    const RecordId& loc,
+                                    const InsertDeleteOptions& options,
+                                    GeneratedKeys* generatedKeys,
+                                    std::vector<RecordId>* skippedRecords) const = 0;
+
+        virtual void insertKeys(const GeneratedKeys& generatedKeys) = 0;
+
         virtual const MultikeyPaths& getMultikeyPaths() const = 0;
 
         virtual bool isMultikey() const = 0;
@@ -473,6 +527,10 @@ public:
                       KeyHandlerFn&& onDuplicateKey,
                       int64_t* numInserted) final;
 
+    Status insertKeysBatch(OperationContext* opCtx,
+                           const KeyStringSet& keys,
+                           int64_t* numInserted) final;
+
     Status insertKeysAndUpdateMultikeyPaths(OperationContext* opCtx,
                                             const CollectionPtr& coll,
                                             const KeyStringSet& keys,
@@ -523,7 +581,10 @@ public:
 
     RecordId findSingle(OperationContext* opCtx, const BSONObj& key) const final;
 
-    Status compact(OperationContext* opCtx) final;
+    KeyString::Value makeSingleKeyString(OperationContext* opCtx,
+                                         const BSONObj& key) const final;
+
+    Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) final;
 
     void setIndexIsMultikey(OperationContext* opCtx,
                             const CollectionPtr& collection,
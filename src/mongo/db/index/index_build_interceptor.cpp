@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/index_build_interceptor.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonobj.h"
@@ -175,15 +176,14 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
 
         auto cursor = _sideWritesTable->rs()->getCursor(opCtx);
 
-        // We use an ordered container because the order of deletion for the records in the side
-        // table matters.
-        std::vector<RecordId> recordsAddedToIndex;
+        // The side writes of the batch, in the order they were read from the side table. The
+        // writes are not applied while reading, so that they can be applied in key order.
+        std::vector<SideWrite> batch;
 
         auto record = cursor->next();
         while (record) {
             opCtx->checkForInterrupt();
 
-            RecordId currentRecordId = record->id;
             BSONObj unownedDoc = record->data.toBson();
 
             // Don't apply this record if the total batch size in bytes would be too large.
@@ -200,9 +200,43 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
             batchSize += 1;
             batchSizeBytes += objSize;
 
+            // The document is owned because the cursor moves on before the write is applied.
+            BSONObj doc = unownedDoc.getOwned();
+            KeyString::Value keyString = _getKeyString(doc);
+            batch.push_back({record->id, std::move(doc), std::move(keyString)});
+
+            // Don't continue if the batch is full. Allow the transaction to commit.
+            if (batchSize == kBatchMaxSize) {
+                break;
+            }
+
+            record = cursor->next();
+        }
+
+        // Side writes are recorded in the order of the writes to the collection, which is random
+        // with respect to the index. Applying them in key order makes successive writes land on
+        // the same or neighbouring pages of the index. The sort is stable and ignores the
+        // RecordId, so the writes of any one key are still applied in the order they were made,
+        // which unique indexes rely on to detect duplicates correctly. The RecordId can only be
+        // told apart from the key for the Long key format.
+        std::vector<const SideWrite*> applyOrder;
+        applyOrder.reserve(batch.size());
+        for (const auto& sideWrite : batch) {
+            applyOrder.push_back(&sideWrite);
+        }
+        if (coll->getRecordStore()->keyFormat() == KeyFormat::Long) {
+            std::stable_sort(applyOrder.begin(),
+                             applyOrder.end(),
+                             [](const SideWrite* lhs, const SideWrite* rhs) {
+                                 return lhs->keyString.compareWithoutRecordId(rhs->keyString) < 0;
+                             });
+        }
+
+        for (const auto* sideWrite : applyOrder) {
             if (auto status = _applyWrite(opCtx,
                                           coll,
-                                          unownedDoc,
+                                          sideWrite->doc,
+                                          sideWrite->keyString,
                                           options,
                                           trackDuplicates,
                                           &totalInserted,
@@ -210,23 +244,13 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
                 !status.isOK()) {
                 return status;
             }
-
-            // Save the record ids of the documents inserted into the index for deletion later.
-            // We can't delete records while holding a positioned cursor.
-            recordsAddedToIndex.push_back(currentRecordId);
-
-            // Don't continue if the batch is full. Allow the transaction to commit.
-            if (batchSize == kBatchMaxSize) {
-                break;
-            }
-
-            record = cursor->next();
         }
 
         // Delete documents from the side table as soon as they have been inserted into the index.
-        // This ensures that no key is ever inserted twice and no keys are skipped.
-        for (const auto& recordId : recordsAddedToIndex) {
-            _sideWritesTable->rs()->deleteRecord(opCtx, recordId);
+        // This ensures that no key is ever inserted twice and no keys are skipped. The records are
+        // deleted in the order they were read, because the order of deletion matters.
+        for (const auto& sideWrite : batch) {
+            _sideWritesTable->rs()->deleteRecord(opCtx, sideWrite.recordId);
         }
 
         if (batchSize == 0) {
@@ -280,21 +304,24 @@ Status IndexBuildInterceptor::drainWritesIntoIndex(OperationContext* opCtx,
     return Status::OK();
 }
 
-Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
-                                          const CollectionPtr& coll,
-                                          const BSONObj& operation,
-                                          const InsertDeleteOptions& options,
-                                          TrackDuplicates trackDups,
-                                          int64_t* const keysInserted,
-                                          int64_t* const keysDeleted) {
+KeyString::Value IndexBuildInterceptor::_getKeyString(const BSONObj& operation) const {
     // Deserialize the encoded KeyString::Value.
     int keyLen;
     const char* binKey = operation["key"].binData(keyLen);
     BufReader reader(binKey, keyLen);
-    const KeyString::Value keyString = KeyString::Value::deserialize(
+    return KeyString::Value::deserialize(
         reader,
         _indexCatalogEntry->accessMethod()->getSortedDataInterface()->getKeyStringVersion());
+}
 
+Status IndexBuildInterceptor::_applyWrite(OperationContext* opCtx,
+                                          const CollectionPtr& coll,
+                                          const BSONObj& operation,
+                                          const KeyString::Value& keyString,
+                                          const InsertDeleteOptions& options,
+                                          TrackDuplicates trackDups,
+                                          int64_t* const keysInserted,
+                                          int64_t* const keysDeleted) {
     const Op opType =
         (strcmp(operation.getStringField("op"), "i") == 0) ? Op::kInsert : Op::kDelete;
 
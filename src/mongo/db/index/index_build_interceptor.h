@@ -175,10 +175,24 @@ public:
 private:
     using SideWriteRecord = std::pair<RecordId, BSONObj>;
 
+    /**
+     * A side write read from the side writes table by a drain, along with its decoded key.
+     */
+    struct SideWrite {
+        RecordId recordId;
+        BSONObj doc;
+        KeyString::Value keyString;
+    };
+
+    /**
+     * Deserializes the KeyString::Value of the side write 'operation'.
+     */
+    KeyString::Value _getKeyString(const BSONObj& operation) const;
 
     Status _applyWrite(OperationContext* opCtx,
                        const CollectionPtr& coll,
                        const BSONObj& doc,
+                       const KeyString::Value& keyString,
                        const InsertDeleteOptions& options,
                        TrackDuplicates trackDups,
                        int64_t* const keysInserted,
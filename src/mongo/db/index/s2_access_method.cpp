@@ -39,6 +39,7 @@
 #include "mongo/db/geo/geoparser.h"
 #include "mongo/db/index/expression_keys_private.h"
 #include "mongo/db/index/expression_params.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/logv2/log.h"
@@ -47,6 +48,9 @@ namespace mongo {
 
 static const string kIndexVersionFieldName("2dsphereIndexVersion");
 
+// The number of geometry coverings each 2dsphere index remembers.
+static const size_t kCoveringCacheMaxEntries = 1024;
+
 S2AccessMethod::S2AccessMethod(IndexCatalogEntry* btreeState,
                                std::unique_ptr<SortedDataInterface> btree)
     : AbstractIndexAccessMethod(btreeState, std::move(btree)) {
@@ -54,6 +58,7 @@ S2AccessMethod::S2AccessMethod(IndexCatalogEntry* btreeState,
 
     ExpressionParams::initialize2dsphereParams(
         descriptor->infoObj(), btreeState->getCollator(), &_params);
+    _params.coveringCache = std::make_shared<S2CoveringCache>(kCoveringCacheMaxEntries);
 
     int geoFields = 0;
 
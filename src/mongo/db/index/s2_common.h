@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include "mongo/db/jsobj.h"
@@ -41,6 +42,7 @@ class S2RegionCoverer;
 namespace mongo {
 
 class GeometryContainer;
+class S2CoveringCache;
 
 // An enum describing the version of an S2 index.
 enum S2IndexVersion {
@@ -77,6 +79,9 @@ struct S2IndexingParams {
     // Null if this index orders strings according to the simple binary compare. If non-null,
     // represents the collator used to generate index keys for indexed strings.
     const CollatorInterface* collator = nullptr;
+    // Null if the coverings of indexed geometries are not cached. If non-null, remembers the
+    // coverings of the geometries this index has recently generated keys for.
+    std::shared_ptr<S2CoveringCache> coveringCache;
 
     std::string toString() const;
 
@@ -0,0 +1,64 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/s2_covering_cache.h"
+
+namespace mongo {
+
+S2CoveringCache::S2CoveringCache(size_t maxEntries) : _coverings(maxEntries) {}
+
+SHA256Block S2CoveringCache::hash(const BSONElement& geometry) {
+    const char type = geometry.type();
+    return SHA256Block::computeHash({ConstDataRange(&type, 1),
+                                     ConstDataRange(geometry.value(), geometry.valuesize())});
+}
+
+boost::optional<std::vector<S2CellId>> S2CoveringCache::find(const SHA256Block& geometryHash) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _coverings.find(geometryHash);
+    if (it == _coverings.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void S2CoveringCache::add(const SHA256Block& geometryHash, std::vector<S2CellId> covering) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _coverings.add(geometryHash, std::move(covering));
+}
+
+size_t S2CoveringCache::size() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _coverings.size();
+}
+
+}  // namespace mongo
@@ -0,0 +1,89 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+#include "mongo/crypto/sha256_block.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "third_party/s2/s2cellid.h"
+
+namespace mongo {
+
+/**
+ * A bounded cache of the cell coverings of the geometries indexed by a 2dsphere index. Documents
+ * often embed the same geometry, such as the boundary of a city, and looking up its covering is far
+ * cheaper than parsing and covering it again. Geometries are identified by the SHA-256 hash of
+ * their BSON, and the least recently used covering is evicted when the cache is full.
+ *
+ * A cache must only be shared by key generation with the same S2IndexingParams. This class is
+ * thread-safe.
+ */
+class S2CoveringCache {
+    S2CoveringCache(const S2CoveringCache&) = delete;
+    S2CoveringCache& operator=(const S2CoveringCache&) = delete;
+
+public:
+    // Geometries smaller than this, such as points, are cheap to cover and are not cached.
+    static constexpr int kMinCachedGeometrySize = 256;
+
+    explicit S2CoveringCache(size_t maxEntries);
+
+    /**
+     * Returns whether the covering of 'geometry' is worth caching.
+     */
+    static bool shouldCache(const BSONElement& geometry) {
+        return geometry.valuesize() >= kMinCachedGeometrySize;
+    }
+
+    /**
+     * Returns the hash identifying 'geometry' in the cache.
+     */
+    static SHA256Block hash(const BSONElement& geometry);
+
+    /**
+     * Returns the covering of the geometry with hash 'geometryHash', if it is cached.
+     */
+    boost::optional<std::vector<S2CellId>> find(const SHA256Block& geometryHash);
+
+    void add(const SHA256Block& geometryHash, std::vector<S2CellId> covering);
+
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("S2CoveringCache::_mutex");
+    LRUCache<SHA256Block, std::vector<S2CellId>, SHA256Block::Hash> _coverings;
+};
+
+}  // namespace mongo
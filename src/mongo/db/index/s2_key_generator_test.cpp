@@ -34,16 +34,20 @@
 #include "mongo/db/index/expression_keys_private.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
+#include "mongo/db/index/s2_covering_cache.h"
 #include "mongo/db/json.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/str.h"
+#include "third_party/s2/s2cellid.h"
+#include "third_party/s2/s2latlng.h"
 
 using namespace mongo;
 
@@ -668,4 +672,57 @@ TEST_F(S2KeyGeneratorTest, MidPathSingleElementArrayIsConsideredMultikey) {
     assertMultikeyPathsEqual(MultikeyPaths{{0U}, MultikeyComponents{}}, actualMultikeyPaths);
 }
 
+TEST_F(S2KeyGeneratorTest, PointIsIndexedByItsLeafCell) {
+    S2CellId leafCell = S2CellId::FromPoint(S2LatLng::FromDegrees(4, 3).ToPoint());
+    ASSERT_TRUE(leafCell.is_leaf());
+    ASSERT_EQUALS(S2CellIdToIndexKey(leafCell, S2_INDEX_VERSION_3).firstElement().Long(),
+                  getCellID(3, 4));
+}
+
+TEST_F(S2KeyGeneratorTest, CachedCoveringGeneratesSameKeys) {
+    // A polygon large enough for its covering to be cached.
+    BSONArrayBuilder ring;
+    for (int i = 0; i < 24; ++i) {
+        ring.append(BSON_ARRAY(std::cos(i * M_PI / 12) << std::sin(i * M_PI / 12)));
+    }
+    ring.append(BSON_ARRAY(1.0 << 0.0));
+    BSONObj obj = BSON("a" << BSON("type"
+                                   << "Polygon"
+                                   << "coordinates" << BSON_ARRAY(ring.arr())));
+    ASSERT_TRUE(S2CoveringCache::shouldCache(obj["a"]));
+
+    BSONObj keyPattern = fromjson("{a: '2dsphere'}");
+    BSONObj infoObj = fromjson("{key: {a: '2dsphere'}, '2dsphereIndexVersion': 3}");
+    S2IndexingParams params;
+    const CollatorInterface* collator = nullptr;
+    ExpressionParams::initialize2dsphereParams(infoObj, collator, &params);
+
+    auto getKeys = [&](const S2IndexingParams& indexingParams) {
+        KeyStringSet keys;
+        ExpressionKeysPrivate::getS2Keys(allocator,
+                                         obj,
+                                         keyPattern,
+                                         indexingParams,
+                                         &keys,
+                                         nullptr,
+                                         KeyString::Version::kLatestVersion,
+                                         Ordering::make(BSONObj()));
+        return keys;
+    };
+    KeyStringSet expectedKeys = getKeys(params);
+    ASSERT_GT(expectedKeys.size(), 1U);
+
+    params.coveringCache = std::make_shared<S2CoveringCache>(1);
+    ASSERT_TRUE(areKeysetsEqual(expectedKeys, getKeys(params)));
+    ASSERT_EQUALS(1U, params.coveringCache->size());
+    ASSERT_TRUE(params.coveringCache->find(S2CoveringCache::hash(obj["a"])));
+    ASSERT_TRUE(areKeysetsEqual(expectedKeys, getKeys(params)));
+
+    // Points are not cached.
+    BSONObj point = BSON("a" << BSON("type"
+                                     << "Point"
+                                     << "coordinates" << BSON_ARRAY(0 << 0)));
+    ASSERT_FALSE(S2CoveringCache::shouldCache(point["a"]));
+}
+
 }  // namespace
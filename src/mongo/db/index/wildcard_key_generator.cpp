@@ -44,22 +44,29 @@ namespace {
 // to prevent the _id field from being indexed, since it already has its own dedicated index.
 static const BSONObj kDefaultProjection = BSON("_id"_sd << 0);
 
+// The value indexed for an object which is empty after projection.
+const BSONObj kEmptyObjectWrapper = BSON("" << BSONObj());
+
 // If the enclosing object is an array, then the current element's fieldname is the array index, so
 // we omit this when computing the full path. Otherwise, the full path is the pathPrefix plus the
-// element's fieldname.
-void pushPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathPrefix) {
+// element's fieldname. Returns the length of the path before the component was appended, which is
+// later passed to popPathComponent().
+size_t pushPathComponent(BSONElement elem, bool enclosingObjIsArray, std::string* pathPrefix) {
+    const auto prefixLength = pathPrefix->size();
     if (!enclosingObjIsArray) {
-        pathPrefix->appendPart(elem.fieldNameStringData());
+        if (prefixLength) {
+            pathPrefix->push_back('.');
+        }
+        auto fieldName = elem.fieldNameStringData();
+        pathPrefix->append(fieldName.rawData(), fieldName.size());
     }
+    return prefixLength;
 }
 
-// If the enclosing object is not an array, then the final path component should be its field name.
-// Verify that this is the case and then pop it off the FieldRef.
-void popPathComponent(BSONElement elem, bool enclosingObjIsArray, FieldRef* pathToElem) {
-    if (!enclosingObjIsArray) {
-        invariant(pathToElem->getPart(pathToElem->numParts() - 1) == elem.fieldNameStringData());
-        pathToElem->removeLastPart();
-    }
+// Truncates the path back to the length it had before the matching pushPathComponent(), so that
+// the buffer holding the path prefix is reused for every path in the document.
+void popPathComponent(size_t prefixLength, std::string* pathToElem) {
+    pathToElem->resize(prefixLength);
 }
 }  // namespace
 
@@ -105,22 +112,43 @@ WildcardKeyGenerator::WildcardKeyGenerator(BSONObj keyPattern,
       _collator(collator),
       _keyPattern(keyPattern),
       _keyStringVersion(keyStringVersion),
-      _ordering(ordering) {}
+      _ordering(ordering) {
+    // The serialized projection is fully explicit: each projected path maps to a boolean, and _id
+    // is always present.
+    _projIsInclusion = _proj.exec()->getType() ==
+        TransformerInterface::TransformerType::kInclusionProjection;
+    _buildProjectionTrie(_proj.exec()->serializeTransformation(boost::none), &_projTrie);
+}
+
+void WildcardKeyGenerator::_buildProjectionTrie(const Document& serializedProj,
+                                                ProjectionTrieNode* node) {
+    for (auto it = serializedProj.fieldIterator(); it.more();) {
+        auto field = it.next();
+        auto& child = node->children[field.first.toString()];
+        if (field.second.getType() == BSONType::Object) {
+            child.node = std::make_unique<ProjectionTrieNode>();
+            _buildProjectionTrie(field.second.getDocument(), child.node.get());
+        } else {
+            child.included = field.second.coerceToBool();
+        }
+    }
+}
 
 void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                         BSONObj inputDoc,
                                         KeyStringSet* keys,
                                         KeyStringSet* multikeyPaths,
                                         boost::optional<RecordId> id) const {
-    FieldRef rootPath;
+    std::string rootPath;
     auto keysSequence = keys->extract_sequence();
     // multikeyPaths is allowed to be nullptr
     KeyStringSet::sequence_type multikeyPathsSequence;
     if (multikeyPaths)
         multikeyPathsSequence = multikeyPaths->extract_sequence();
     _traverseWildcard(pooledBufferBuilder,
-                      _proj.exec()->applyTransformation(Document{inputDoc}).toBson(),
+                      inputDoc,
                       false,
+                      &_projTrie,
                       &rootPath,
                       &keysSequence,
                       multikeyPaths ? &multikeyPathsSequence : nullptr,
@@ -130,41 +158,101 @@ void WildcardKeyGenerator::generateKeys(SharedBufferFragmentBuilder& pooledBuffe
     keys->adopt_sequence(std::move(keysSequence));
 }
 
-void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
+bool WildcardKeyGenerator::_projectElement(BSONElement elem,
+                                           bool enclosingObjIsArray,
+                                           const ProjectionTrieNode* projNode,
+                                           const ProjectionTrieNode** elemProjNode) const {
+    *elemProjNode = nullptr;
+
+    // The projection applies to each object in an array as it does to the array itself. Nested
+    // arrays are not descended into, so like scalars they are dropped by an inclusion projection
+    // and kept as-is by an exclusion projection.
+    if (enclosingObjIsArray) {
+        if (elem.type() == BSONType::Object) {
+            *elemProjNode = projNode;
+            return true;
+        }
+        return !_projIsInclusion;
+    }
+
+    // Fields which are not mentioned in the projection are only kept by an exclusion projection.
+    auto it = projNode->children.find(elem.fieldNameStringData());
+    if (it == projNode->children.end()) {
+        return !_projIsInclusion;
+    }
+
+    const auto& child = it->second;
+    if (!child.node) {
+        return child.included;
+    }
+
+    // The projection applies to paths below this field, which only exist for objects and arrays.
+    if (elem.type() == BSONType::Object || elem.type() == BSONType::Array) {
+        *elemProjNode = child.node.get();
+        return true;
+    }
+    return !_projIsInclusion;
+}
+
+bool WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                              BSONObj obj,
                                              bool objIsArray,
-                                             FieldRef* path,
+                                             const ProjectionTrieNode* projNode,
+                                             std::string* path,
                                              KeyStringSet::sequence_type* keys,
                                              KeyStringSet::sequence_type* multikeyPaths,
                                              boost::optional<RecordId> id) const {
+    bool isEmptyAfterProjection = true;
     for (const auto& elem : obj) {
+        const ProjectionTrieNode* elemProjNode = nullptr;
+        if (projNode && !_projectElement(elem, objIsArray, projNode, &elemProjNode)) {
+            continue;
+        }
+        isEmptyAfterProjection = false;
+
         // If the element's fieldName contains a ".", fast-path skip it because it's not queryable.
         if (elem.fieldNameStringData().find('.', 0) != std::string::npos)
             continue;
 
         // Append the element's fieldname to the path, if the enclosing object is not an array.
-        pushPathComponent(elem, objIsArray, path);
+        const auto prefixLength = pushPathComponent(elem, objIsArray, path);
 
         switch (elem.type()) {
             case BSONType::Array:
                 // If this is a nested array, we don't descend it but instead index it as a value.
-                if (_addKeyForNestedArray(pooledBufferBuilder, elem, *path, objIsArray, keys, id))
+                if (objIsArray) {
+                    _addKey(pooledBufferBuilder, elem, *path, keys, id);
                     break;
+                }
 
-                // Add an entry for the multi-key path, and then fall through to BSONType::Object.
+                // Add an entry for the multi-key path, and then descend into the array. In keeping
+                // with the behaviour of regular indexes, an empty array is indexed as 'undefined'.
                 _addMultiKey(pooledBufferBuilder, *path, multikeyPaths);
+                if (!_traverseWildcard(pooledBufferBuilder,
+                                       elem.Obj(),
+                                       true,
+                                       elemProjNode,
+                                       path,
+                                       keys,
+                                       multikeyPaths,
+                                       id)) {
+                    _addKey(pooledBufferBuilder, BSONElement{}, *path, keys, id);
+                }
+                break;
 
             case BSONType::Object:
-                if (_addKeyForEmptyLeaf(pooledBufferBuilder, elem, *path, keys, id))
-                    break;
-
-                _traverseWildcard(pooledBufferBuilder,
-                                  elem.Obj(),
-                                  elem.type() == BSONType::Array,
-                                  path,
-                                  keys,
-                                  multikeyPaths,
-                                  id);
+                // An empty object is indexed as-is.
+                if (!_traverseWildcard(pooledBufferBuilder,
+                                       elem.Obj(),
+                                       false,
+                                       elemProjNode,
+                                       path,
+                                       keys,
+                                       multikeyPaths,
+                                       id)) {
+                    _addKey(
+                        pooledBufferBuilder, kEmptyObjectWrapper.firstElement(), *path, keys, id);
+                }
                 break;
 
             default:
@@ -172,51 +260,19 @@ void WildcardKeyGenerator::_traverseWildcard(SharedBufferFragmentBuilder& pooled
         }
 
         // Remove the element's fieldname from the path, if it was pushed onto it earlier.
-        popPathComponent(elem, objIsArray, path);
-    }
-}
-
-bool WildcardKeyGenerator::_addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                                 BSONElement elem,
-                                                 const FieldRef& fullPath,
-                                                 bool enclosingObjIsArray,
-                                                 KeyStringSet::sequence_type* keys,
-                                                 boost::optional<RecordId> id) const {
-    // If this element is an array whose parent is also an array, index it as a value.
-    if (enclosingObjIsArray && elem.type() == BSONType::Array) {
-        _addKey(pooledBufferBuilder, elem, fullPath, keys, id);
-        return true;
-    }
-    return false;
-}
-
-bool WildcardKeyGenerator::_addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                               BSONElement elem,
-                                               const FieldRef& fullPath,
-                                               KeyStringSet::sequence_type* keys,
-                                               boost::optional<RecordId> id) const {
-    invariant(elem.isABSONObj());
-    if (elem.embeddedObject().isEmpty()) {
-        // In keeping with the behaviour of regular indexes, an empty object is indexed as-is while
-        // empty arrays are indexed as 'undefined'.
-        _addKey(pooledBufferBuilder,
-                elem.type() == BSONType::Array ? BSONElement{} : elem,
-                fullPath,
-                keys,
-                id);
-        return true;
+        popPathComponent(prefixLength, path);
     }
-    return false;
+    return !isEmptyAfterProjection;
 }
 
 void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                                    BSONElement elem,
-                                   const FieldRef& fullPath,
+                                   StringData fullPath,
                                    KeyStringSet::sequence_type* keys,
                                    boost::optional<RecordId> id) const {
     // Wildcard keys are of the form { "": "path.to.field", "": <collation-aware value> }.
     KeyString::PooledBuilder keyString(pooledBufferBuilder, _keyStringVersion, _ordering);
-    keyString.appendString(fullPath.dottedField());
+    keyString.appendString(fullPath);
     if (_collator && elem) {
         keyString.appendBSONElement(elem, [&](StringData stringData) {
             return _collator->getComparisonString(stringData);
@@ -234,13 +290,13 @@ void WildcardKeyGenerator::_addKey(SharedBufferFragmentBuilder& pooledBufferBuil
 }
 
 void WildcardKeyGenerator::_addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                                        const FieldRef& fullPath,
+                                        StringData fullPath,
                                         KeyStringSet::sequence_type* multikeyPaths) const {
     // Multikey paths are denoted by a key of the form { "": 1, "": "path.to.array" }. The argument
     // 'multikeyPaths' may be nullptr if the access method is being used in an operation which does
     // not require multikey path generation.
     if (multikeyPaths) {
-        auto key = BSON("" << 1 << "" << fullPath.dottedField());
+        auto key = BSON("" << 1 << "" << fullPath);
         KeyString::PooledBuilder keyString(
             pooledBufferBuilder,
             _keyStringVersion,
@@ -29,11 +29,14 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+
 #include "mongo/db/exec/wildcard_projection.h"
-#include "mongo/db/field_ref.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/storage/key_string.h"
 #include "mongo/db/storage/sorted_data_interface.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -81,39 +84,56 @@ public:
                       boost::optional<RecordId> id = boost::none) const;
 
 private:
+    /**
+     * A compiled form of the wildcard projection, which is applied to the input document while
+     * its paths are traversed rather than by materializing the post-projection document. Each
+     * node holds the projection's decision for the fields at one level of the document.
+     */
+    struct ProjectionTrieNode {
+        struct Child {
+            // The projection for the paths below this field, or null if the field is included or
+            // excluded as a whole according to 'included'.
+            std::unique_ptr<ProjectionTrieNode> node;
+            bool included = false;
+        };
+        StringMap<Child> children;
+    };
+
+    // Builds the trie for the given node of the serialized projection.
+    static void _buildProjectionTrie(const Document& serializedProj, ProjectionTrieNode* node);
+
+    // Determines whether 'elem' is part of the post-projection document. If so, sets 'elemProjNode'
+    // to the projection to apply to the paths below 'elem', or to null if they are all included.
+    bool _projectElement(BSONElement elem,
+                         bool enclosingObjIsArray,
+                         const ProjectionTrieNode* projNode,
+                         const ProjectionTrieNode** elemProjNode) const;
+
     // Traverses every path of the post-projection document, adding keys to the set as it goes.
-    void _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
+    // A null 'projNode' means that 'obj' is included in its entirety. Returns false if 'obj' is
+    // empty after projection.
+    bool _traverseWildcard(SharedBufferFragmentBuilder& pooledBufferBuilder,
                            BSONObj obj,
                            bool objIsArray,
-                           FieldRef* path,
+                           const ProjectionTrieNode* projNode,
+                           std::string* path,
                            KeyStringSet::sequence_type* keys,
                            KeyStringSet::sequence_type* multikeyPaths,
                            boost::optional<RecordId> id) const;
 
     // Helper functions to format the entry appropriately before adding it to the key/path tracker.
     void _addMultiKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                      const FieldRef& fullPath,
+                      StringData fullPath,
                       KeyStringSet::sequence_type* multikeyPaths) const;
     void _addKey(SharedBufferFragmentBuilder& pooledBufferBuilder,
                  BSONElement elem,
-                 const FieldRef& fullPath,
+                 StringData fullPath,
                  KeyStringSet::sequence_type* keys,
                  boost::optional<RecordId> id) const;
 
-    // Helper to check whether the element is a nested array, and conditionally add it to 'keys'.
-    bool _addKeyForNestedArray(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                               BSONElement elem,
-                               const FieldRef& fullPath,
-                               bool enclosingObjIsArray,
-                               KeyStringSet::sequence_type* keys,
-                               boost::optional<RecordId> id) const;
-    bool _addKeyForEmptyLeaf(SharedBufferFragmentBuilder& pooledBufferBuilder,
-                             BSONElement elem,
-                             const FieldRef& fullPath,
-                             KeyStringSet::sequence_type* keys,
-                             boost::optional<RecordId> id) const;
-
     WildcardProjection _proj;
+    ProjectionTrieNode _projTrie;
+    bool _projIsInclusion;
     const CollatorInterface* _collator;
     const BSONObj _keyPattern;
     const KeyString::Version _keyStringVersion;
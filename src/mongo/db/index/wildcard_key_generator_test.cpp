@@ -598,6 +598,54 @@ TEST_F(WildcardKeyGeneratorInclusionTest, InclusionProjectionMultipleSubtrees) {
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST_F(WildcardKeyGeneratorInclusionTest, InclusionProjectionDropsNonObjectArrayElements) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 1}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: [1, [{b: 2}], {c: 3}, {b: 4}], d: [5, 6], e: {b: 7}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a', '': {}}"),
+                                    fromjson("{'': 'a.b', '': 4}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordIdReservations::reservedIdFor(ReservationId::kWildcardMultikeyMetadataId));
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
+TEST_F(WildcardKeyGeneratorInclusionTest, InclusionProjectionIndexesEmptiedValuesAsEmpty) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 1, 'c.d': 1}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: [1, [2]], c: {e: 3}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a', '': undefined}"),
+                                    fromjson("{'': 'c', '': {}}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordIdReservations::reservedIdFor(ReservationId::kWildcardMultikeyMetadataId));
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
 // Explicit exclusion tests.
 struct WildcardKeyGeneratorExclusionTest : public WildcardKeyGeneratorTest {};
 
@@ -781,6 +829,33 @@ TEST_F(WildcardKeyGeneratorExclusionTest, ExclusionProjectionMultipleSubtrees) {
     ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
 }
 
+TEST_F(WildcardKeyGeneratorExclusionTest, ExclusionProjectionKeepsNonObjectArrayElements) {
+    WildcardKeyGenerator keyGen{fromjson("{'$**': 1}"),
+                                fromjson("{'a.b': 0}"),
+                                nullptr,
+                                KeyString::Version::kLatestVersion,
+                                Ordering::make(BSONObj())};
+
+    auto inputDoc = fromjson("{a: [1, [{b: 2}], {b: 3, c: 4}, {b: 5}], d: {b: 6}}");
+
+    auto expectedKeys = makeKeySet({fromjson("{'': 'a', '': 1}"),
+                                    fromjson("{'': 'a', '': [{b: 2}]}"),
+                                    fromjson("{'': 'a', '': {}}"),
+                                    fromjson("{'': 'a.c', '': 4}"),
+                                    fromjson("{'': 'd.b', '': 6}")});
+
+    auto expectedMultikeyPaths =
+        makeKeySet({fromjson("{'': 1, '': 'a'}")},
+                   RecordIdReservations::reservedIdFor(ReservationId::kWildcardMultikeyMetadataId));
+
+    auto outputKeys = makeKeySet();
+    auto multikeyMetadataKeys = makeKeySet();
+    keyGen.generateKeys(allocator, inputDoc, &outputKeys, &multikeyMetadataKeys);
+
+    ASSERT(assertKeysetsEqual(expectedKeys, outputKeys));
+    ASSERT(assertKeysetsEqual(expectedMultikeyPaths, multikeyMetadataKeys));
+}
+
 // Test _id inclusion and exclusion behaviour.
 struct WildcardKeyGeneratorIdTest : public WildcardKeyGeneratorTest {};
 
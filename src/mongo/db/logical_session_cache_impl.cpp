@@ -106,7 +106,7 @@ Status LogicalSessionCacheImpl::vivify(OperationContext* opCtx, const LogicalSes
 
 Status LogicalSessionCacheImpl::refreshNow(OperationContext* opCtx) {
     try {
-        _refresh(opCtx->getClient());
+        _refresh(opCtx->getClient(), false /* spreadOverInterval */);
     } catch (...) {
         return exceptionToStatus();
     }
@@ -124,7 +124,7 @@ size_t LogicalSessionCacheImpl::size() {
 
 void LogicalSessionCacheImpl::_periodicRefresh(Client* client) {
     try {
-        _refresh(client);
+        _refresh(client, true /* spreadOverInterval */);
     } catch (const DBException& ex) {
         LOGV2(
             20710,
@@ -213,7 +213,7 @@ Status LogicalSessionCacheImpl::_reap(Client* client) {
     return Status::OK();
 }
 
-void LogicalSessionCacheImpl::_refresh(Client* client) {
+void LogicalSessionCacheImpl::_refresh(Client* client, bool spreadOverInterval) {
     // get or make an opCtx
     boost::optional<ServiceContext::UniqueOperationContext> uniqueCtx;
     auto* const opCtx = [&client, &uniqueCtx] {
@@ -315,7 +315,7 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 
     // Refresh the active sessions in the sessions collection.
-    _sessionsColl->refreshSessions(opCtx, activeSessionRecords);
+    _refreshInBatches(opCtx, activeSessionRecords, spreadOverInterval);
     activeSessionsBackSwapper.dismiss();
     {
         stdx::lock_guard<Latch> lk(_mutex);
@@ -373,6 +373,33 @@ void LogicalSessionCacheImpl::_refresh(Client* client) {
     }
 }
 
+void LogicalSessionCacheImpl::_refreshInBatches(OperationContext* opCtx,
+                                                const LogicalSessionRecordSet& records,
+                                                bool spreadOverInterval) {
+    const size_t batchSize = logicalSessionRefreshBatchSize.load();
+    const size_t numBatches = (records.size() + batchSize - 1) / batchSize;
+
+    // Writing every session at once makes for a burst of load on the sessions collection each
+    // interval, which on a sharded cluster lands on every shard at about the same time. Half of
+    // the interval leaves the refresh time to finish before the next one is due.
+    const Milliseconds pause = spreadOverInterval && numBatches > 1
+        ? Milliseconds(logicalSessionRefreshMillis / 2 / static_cast<long long>(numBatches - 1))
+        : Milliseconds(0);
+
+    LogicalSessionRecordSet batch;
+    for (auto it = records.begin(); it != records.end();) {
+        batch.insert(*it);
+        if (++it == records.end() || batch.size() == batchSize) {
+            _sessionsColl->refreshSessions(opCtx, batch);
+            batch.clear();
+
+            if (it != records.end() && pause > Milliseconds(0)) {
+                opCtx->sleepFor(pause);
+            }
+        }
+    }
+}
+
 void LogicalSessionCacheImpl::endSessions(const LogicalSessionIdSet& sessions) {
     stdx::lock_guard<Latch> lk(_mutex);
     _endingSessions.insert(begin(sessions), end(sessions));
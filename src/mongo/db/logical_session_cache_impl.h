@@ -91,7 +91,22 @@ public:
 
 private:
     void _periodicRefresh(Client* client);
-    void _refresh(Client* client);
+
+    /**
+     * Writes the sessions used since the last refresh to the sessions collection. A periodic
+     * refresh, with 'spreadOverInterval' set, paces its batches rather than writing them back to
+     * back.
+     */
+    void _refresh(Client* client, bool spreadOverInterval);
+
+    /**
+     * Refreshes 'records' in the sessions collection in batches of logicalSessionRefreshBatchSize,
+     * spreading the batches evenly over half of the refresh interval if 'spreadOverInterval' is
+     * set.
+     */
+    void _refreshInBatches(OperationContext* opCtx,
+                           const LogicalSessionRecordSet& records,
+                           bool spreadOverInterval);
 
     void _periodicReap(Client* client);
     Status _reap(Client* client);
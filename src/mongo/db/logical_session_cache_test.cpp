@@ -47,6 +47,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/db/service_liaison_mock.h"
 #include "mongo/db/sessions_collection_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/ensure_fcv.h"
 #include "mongo/unittest/unittest.h"
@@ -205,15 +206,46 @@ TEST_F(LogicalSessionCacheTest, ManySignedLsidsInCacheRefresh) {
         ASSERT_OK(cache()->startSession(opCtx(), record));
     }
 
-    // Check that all signedLsids refresh
-    sessions()->setRefreshHook([&count](const LogicalSessionRecordSet& sessions) {
-        ASSERT_EQ(sessions.size(), size_t(count));
+    // Check that all signedLsids refresh, in batches of at most the configured size
+    size_t numRefreshed = 0;
+    sessions()->setRefreshHook([&numRefreshed](const LogicalSessionRecordSet& sessions) {
+        ASSERT_LTE(sessions.size(), size_t(logicalSessionRefreshBatchSize.load()));
+        numRefreshed += sessions.size();
         return Status::OK();
     });
 
     // Force a refresh
     service()->fastForward(kForceRefresh);
     ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(numRefreshed, size_t(count));
+}
+
+// Test that a refresh writes the sessions to the sessions collection in batches
+TEST_F(LogicalSessionCacheTest, RefreshWritesSessionsInBatches) {
+    RAIIServerParameterControllerForTest batchSize{"logicalSessionRefreshBatchSize", 7};
+
+    LogicalSessionIdSet lsids;
+    for (int i = 0; i < 50; i++) {
+        auto record = makeLogicalSessionRecordForTest();
+        lsids.insert(record.getId());
+        ASSERT_OK(cache()->startSession(opCtx(), record));
+    }
+
+    std::vector<size_t> batchSizes;
+    LogicalSessionIdSet refreshed;
+    sessions()->setRefreshHook([&](const LogicalSessionRecordSet& sessions) {
+        batchSizes.push_back(sessions.size());
+        for (const auto& record : sessions) {
+            refreshed.insert(record.getId());
+        }
+        return Status::OK();
+    });
+
+    ASSERT_OK(cache()->refreshNow(opCtx()));
+    ASSERT_EQ(8U, batchSizes.size());
+    ASSERT_EQ(1U, batchSizes.back());
+    ASSERT(refreshed == lsids);
+    ASSERT_EQ(0U, cache()->size());
 }
 
 //
@@ -44,6 +44,9 @@
 #include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/matcher/path.h"
 #include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
 #include "mongo/util/regex_util.h"
 #include "mongo/util/str.h"
 
@@ -208,6 +211,65 @@ constexpr StringData GTEMatchExpression::kName;
 
 const std::set<char> RegexMatchExpression::kValidRegexFlags = {'i', 'm', 's', 'x'};
 
+namespace {
+
+/**
+ * Process-wide LRU cache of compiled regular expressions keyed by pattern and flags. Compiled
+ * programs are immutable once built, so matching against a cached program from several threads is
+ * safe. Holds at most 'internalQueryRegexCacheSize' programs.
+ */
+class RegexCache {
+public:
+    std::shared_ptr<const pcrecpp::RE> getOrCompile(const std::string& regex,
+                                                    const std::string& flags) {
+        const int maxSize = internalQueryRegexCacheSize.load();
+        if (maxSize <= 0) {
+            return compile(regex, flags);
+        }
+
+        auto key = std::make_pair(regex, flags);
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_cache && _maxSize == static_cast<size_t>(maxSize)) {
+                if (auto it = _cache->find(key); it != _cache->end()) {
+                    return _cache->promote(it)->second;
+                }
+            }
+        }
+
+        // Compile outside of the mutex so that a slow compilation does not hold up other lookups.
+        auto re = compile(regex, flags);
+        if (!re->error().empty()) {
+            return re;
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_cache || _maxSize != static_cast<size_t>(maxSize)) {
+            _maxSize = maxSize;
+            _cache = std::make_unique<Cache>(_maxSize);
+        }
+        _cache->add(key, re);
+        return re;
+    }
+
+private:
+    using Cache = LRUCache<std::pair<std::string, std::string>, std::shared_ptr<const pcrecpp::RE>>;
+
+    static std::shared_ptr<const pcrecpp::RE> compile(const std::string& regex,
+                                                      const std::string& flags) {
+        return std::make_shared<const pcrecpp::RE>(regex.c_str(),
+                                                   regex_util::flagsToPcreOptions(flags, true));
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("RegexCache::_mutex");
+    size_t _maxSize = 0;
+    std::unique_ptr<Cache> _cache;
+};
+
+RegexCache regexCache;
+
+}  // namespace
+
 std::unique_ptr<pcrecpp::RE> RegexMatchExpression::makeRegex(const std::string& regex,
                                                              const std::string& flags) {
     return std::make_unique<pcrecpp::RE>(regex.c_str(),
@@ -220,8 +282,7 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
                                            clonable_ptr<ErrorAnnotation> annotation)
     : LeafMatchExpression(REGEX, path, std::move(annotation)),
       _regex(regex.toString()),
-      _flags(options.toString()),
-      _re(new pcrecpp::RE(_regex.c_str(), regex_util::flagsToPcreOptions(_flags, true))) {
+      _flags(options.toString()) {
 
     uassert(ErrorCodes::BadValue,
             "Regular expression cannot contain an embedded null byte",
@@ -231,6 +292,8 @@ RegexMatchExpression::RegexMatchExpression(StringData path,
             "Regular expression options string cannot contain an embedded null byte",
             _flags.find('\0') == std::string::npos);
 
+    _re = regexCache.getOrCompile(_regex, _flags);
+
     uassert(51091,
             str::stream() << "Regular expression is invalid: " << _re->error(),
             _re->error().empty());
@@ -389,6 +452,7 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
     next->_hasEmptyArray = _hasEmptyArray;
     next->_equalitySet = _equalitySet;
     next->_originalEqualityVector = _originalEqualityVector;
+    next->_buildHashedEqualities();
     for (auto&& regex : _regexes) {
         std::unique_ptr<RegexMatchExpression> clonedRegex(
             static_cast<RegexMatchExpression*>(regex->shallowClone().release()));
@@ -398,9 +462,58 @@ std::unique_ptr<MatchExpression> InMatchExpression::shallowClone() const {
 }
 
 bool InMatchExpression::contains(const BSONElement& e) const {
+    if (_hashedIntegers) {
+        switch (e.type()) {
+            case BSONType::NumberInt:
+            case BSONType::NumberLong:
+                return _hashedIntegers->count(e.numberLong());
+            case BSONType::NumberDouble: {
+                // Only a double holding an integral value in the range of a long long can compare
+                // equal to one of the integers. NaN fails both range checks.
+                const double value = e.numberDouble();
+                if (!(value >= -9223372036854775808.0 && value < 9223372036854775808.0) ||
+                    std::trunc(value) != value) {
+                    return false;
+                }
+                return _hashedIntegers->count(static_cast<long long>(value));
+            }
+            case BSONType::NumberDecimal:
+                break;
+            default:
+                // Elements of any other canonical type never compare equal to a number.
+                return false;
+        }
+    } else if (_hashedEqualities) {
+        return _hashedEqualities->count(e);
+    }
     return std::binary_search(_equalitySet.begin(), _equalitySet.end(), e, _eltCmp.makeLessThan());
 }
 
+void InMatchExpression::_buildHashedEqualities() {
+    _hashedIntegers = boost::none;
+    _hashedEqualities = boost::none;
+
+    const int minSize = internalQueryMinInSizeForHashLookup.load();
+    if (minSize <= 0 || _equalitySet.size() < static_cast<size_t>(minSize)) {
+        return;
+    }
+
+    if (std::all_of(_equalitySet.begin(), _equalitySet.end(), [](const BSONElement& elt) {
+            return elt.type() == BSONType::NumberInt || elt.type() == BSONType::NumberLong;
+        })) {
+        _hashedIntegers.emplace();
+        _hashedIntegers->reserve(_equalitySet.size());
+        for (auto&& equality : _equalitySet) {
+            _hashedIntegers->insert(equality.numberLong());
+        }
+        return;
+    }
+
+    _hashedEqualities.emplace(_eltCmp.makeBSONEltUnorderedSet());
+    _hashedEqualities->reserve(_equalitySet.size());
+    _hashedEqualities->insert(_equalitySet.begin(), _equalitySet.end());
+}
+
 bool InMatchExpression::matchesSingleElement(const BSONElement& e, MatchDetails* details) const {
     if (_hasNull && e.eoo()) {
         return true;
@@ -509,6 +622,7 @@ void InMatchExpression::_doSetCollator(const CollatorInterface* collator) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _buildHashedEqualities();
 }
 
 Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
@@ -542,6 +656,7 @@ Status InMatchExpression::setEqualities(std::vector<BSONElement> equalities) {
                      _originalEqualityVector.end(),
                      std::back_inserter(_equalitySet),
                      _eltCmp.makeEqualTo());
+    _buildHashedEqualities();
 
     return Status::OK();
 }
@@ -40,6 +40,7 @@
 #include "mongo/db/matcher/expression_path.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 
 namespace pcrecpp {
 class RE;
@@ -466,7 +467,10 @@ private:
 
     std::string _regex;
     std::string _flags;
-    std::unique_ptr<pcrecpp::RE> _re;
+
+    // Compiled program for '_regex' and '_flags', shared with other expressions over the same
+    // pattern through the process-wide regex cache.
+    std::shared_ptr<const pcrecpp::RE> _re;
 };
 
 class ModMatchExpression : public LeafMatchExpression {
@@ -619,6 +623,12 @@ public:
 private:
     ExpressionOptimizerFunc getOptimizer() const final;
 
+    /**
+     * Rebuilds the hash set probed by contains() from '_equalitySet', or clears it when
+     * '_equalitySet' is smaller than 'internalQueryMinInSizeForHashLookup'.
+     */
+    void _buildHashedEqualities();
+
     // Whether or not '_equalities' has a jstNULL element in it.
     bool _hasNull = false;
 
@@ -642,10 +652,16 @@ private:
     // support std::binary_search. Because we need to sort the elements anyway for things like index
     // bounds building, using binary search avoids the overhead of inserting into a hash table which
     // doesn't pay for itself in the common case where lookups are done a few times if ever.
-    // TODO It may be worth dynamically creating a hashset after matchesSingleElement() has been
-    // called "many" times.
     std::vector<BSONElement> _equalitySet;
 
+    // Copies of the values in '_equalitySet' when it holds only NumberInt and NumberLong elements
+    // and is large enough for hash lookups to beat binary search.
+    boost::optional<stdx::unordered_set<long long>> _hashedIntegers;
+
+    // Set of the elements in '_equalitySet' when it is large enough for hash lookups to beat binary
+    // search but does not hold only integers. Hashes and compares elements with '_eltCmp'.
+    boost::optional<BSONEltUnorderedSet> _hashedEqualities;
+
     // Container of regex elements this object owns.
     std::vector<std::unique_ptr<RegexMatchExpression>> _regexes;
 };
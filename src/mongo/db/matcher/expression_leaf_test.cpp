@@ -998,6 +998,24 @@ TEST(RegexMatchExpression, RegexAcceptsUCPStartOption) {
                                   << "\u304C")));
 }
 
+TEST(RegexMatchExpression, CachedRegexesAreKeyedByPatternAndFlags) {
+    BSONObj upper = BSON("a"
+                         << "ABC");
+    for (int i = 0; i < 2; ++i) {
+        RegexMatchExpression caseSensitive("a", "^abc", "");
+        RegexMatchExpression caseInsensitive("a", "^abc", "i");
+        ASSERT(!caseSensitive.matchesBSON(upper));
+        ASSERT(caseInsensitive.matchesBSON(upper));
+        ASSERT(!caseSensitive.shallowClone()->matchesBSON(upper));
+        ASSERT(caseInsensitive.shallowClone()->matchesBSON(upper));
+    }
+
+    // Invalid patterns are rejected every time they are parsed.
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_THROWS_CODE(RegexMatchExpression("a", "[", ""), AssertionException, 51091);
+    }
+}
+
 TEST(RegexMatchExpression, RegexAcceptsLFOption) {
     // The LF option tells the regex to only treat \n as a newline. "." will not match newlines (by
     // default) so a\nb will not match, but a\rb will.
@@ -1370,6 +1388,73 @@ TEST(InMatchExpression, ChangingCollationAfterAddingEqualitiesPreservesEqualitie
     ASSERT(in.contains(obj2.firstElement()));
 }
 
+TEST(InMatchExpression, LargeIntegerListMatchesEquivalentNumbers) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 1000; i += 2) {
+        if (i % 4) {
+            operandBuilder.append(i);
+        } else {
+            operandBuilder.append(static_cast<long long>(i));
+        }
+    }
+    BSONArray operand = operandBuilder.arr();
+    InMatchExpression in("");
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    BSONObj matches = BSON_ARRAY(4 << 6LL << 8.0 << -0.0 << Decimal128(10));
+    for (auto&& elt : matches) {
+        ASSERT(in.matchesSingleElement(elt)) << elt;
+    }
+    BSONObj notMatches = BSON_ARRAY(3 << 1000LL << 8.5 << std::nan("") << 1e100 << Decimal128(11)
+                                      << "4" << BSONNULL);
+    for (auto&& elt : notMatches) {
+        ASSERT(!in.matchesSingleElement(elt)) << elt;
+    }
+}
+
+TEST(InMatchExpression, LargeMixedListMatchesLikeBinarySearch) {
+    BSONArrayBuilder operandBuilder;
+    for (int i = 0; i < 100; ++i) {
+        operandBuilder.append(str::stream() << "string" << i);
+        operandBuilder.append(OID::gen());
+    }
+    operandBuilder.append(2.5);
+    BSONArray operand = operandBuilder.arr();
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    InMatchExpression in("");
+    in.setCollator(&collator);
+    std::vector<BSONElement> equalities;
+    for (auto&& elt : operand) {
+        equalities.push_back(elt);
+    }
+    ASSERT_OK(in.setEqualities(std::move(equalities)));
+
+    for (auto&& elt : operand) {
+        ASSERT(in.matchesSingleElement(elt)) << elt;
+    }
+    BSONObj matches = BSON_ARRAY("STRING42" << Decimal128(2.5));
+    for (auto&& elt : matches) {
+        ASSERT(in.matchesSingleElement(elt)) << elt;
+    }
+    BSONObj notMatches = BSON_ARRAY("string100" << OID::gen() << 2);
+    for (auto&& elt : notMatches) {
+        ASSERT(!in.matchesSingleElement(elt)) << elt;
+    }
+
+    // Changing the collation rebuilds the set with the new comparison rules.
+    in.setCollator(nullptr);
+    ASSERT(!in.matchesSingleElement(matches.firstElement()));
+    ASSERT(in.matchesSingleElement(operand.firstElement()));
+
+    auto clone = in.shallowClone();
+    ASSERT(clone->matchesSingleElement(operand.firstElement()));
+    ASSERT(!clone->matchesSingleElement(matches.firstElement()));
+}
+
 std::vector<uint32_t> bsonArrayToBitPositions(const BSONArray& ba) {
     std::vector<uint32_t> bitPositions;
 
@@ -38,4 +38,23 @@ BSONMatchableDocument::BSONMatchableDocument(const BSONObj& obj) : _obj(obj) {
 }
 
 BSONMatchableDocument::~BSONMatchableDocument() {}
+
+const BSONObjFieldIndex* BSONMatchableDocument::_getFieldIndex() const {
+    // Objects smaller than this cannot hold enough fields for the index to pay for itself.
+    constexpr int kMinObjSizeToIndex = 1024;
+    constexpr size_t kMinFieldsToIndex = 32;
+
+    // Building the index costs a pass over the object and a sort, so wait until a second lookup
+    // shows that the document is searched repeatedly, as when several predicates are evaluated.
+    if (_numLookups < 2 && ++_numLookups == 2 && _obj.objsize() >= kMinObjSizeToIndex) {
+        std::vector<BSONElement> fields;
+        for (auto&& elem : _obj) {
+            fields.push_back(elem);
+        }
+        if (fields.size() >= kMinFieldsToIndex) {
+            _fieldIndex.emplace(std::move(fields));
+        }
+    }
+    return _fieldIndex.get_ptr();
+}
 }  // namespace mongo
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/field_ref.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/db/matcher/path_internal.h"
 
 namespace mongo {
 
@@ -84,10 +87,11 @@ public:
     }
 
     virtual ElementIterator* allocateIterator(const ElementPath* path) const {
+        const BSONObjFieldIndex* fieldIndex = _getFieldIndex();
         if (_iteratorUsed)
-            return new BSONElementIterator(path, _obj);
+            return new BSONElementIterator(path, _obj, fieldIndex);
         _iteratorUsed = true;
-        _iterator.reset(path, _obj);
+        _iterator.reset(path, _obj, fieldIndex);
         return &_iterator;
     }
 
@@ -100,9 +104,19 @@ public:
     }
 
 private:
+    /**
+     * Returns an index of the top-level fields of '_obj' once the document has been searched more
+     * than once and turns out to be wide enough for binary searches to beat linear scans, and null
+     * otherwise.
+     */
+    const BSONObjFieldIndex* _getFieldIndex() const;
+
     BSONObj _obj;
     mutable BSONElementIterator _iterator;
     mutable bool _iteratorUsed;
+
+    mutable int _numLookups = 0;
+    mutable boost::optional<BSONObjFieldIndex> _fieldIndex;
 };
 
 /**
@@ -188,6 +188,8 @@ private:
     BSONObjIterator _iterator;
 };
 
+class BSONObjFieldIndex;
+
 class BSONElementIterator : public ElementIterator {
 public:
     BSONElementIterator();
@@ -205,14 +207,19 @@ public:
 
     /**
      * Constructs an iterator over 'objectToIterate', where the desired element(s) is/are at the end
-     * of 'path'.
+     * of 'path'. If not null, 'fieldIndex' must index the fields of 'objectToIterate', and is used
+     * to find the first field of 'path'.
      */
-    BSONElementIterator(const ElementPath* path, const BSONObj& objectToIterate);
+    BSONElementIterator(const ElementPath* path,
+                        const BSONObj& objectToIterate,
+                        const BSONObjFieldIndex* fieldIndex = nullptr);
 
     virtual ~BSONElementIterator();
 
     void reset(const ElementPath* path, size_t suffixIndex, BSONElement elementToIterate);
-    void reset(const ElementPath* path, const BSONObj& objectToIterate);
+    void reset(const ElementPath* path,
+               const BSONObj& objectToIterate,
+               const BSONObjFieldIndex* fieldIndex = nullptr);
 
     bool more();
     Context next();
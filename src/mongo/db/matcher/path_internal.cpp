@@ -39,10 +39,29 @@ bool isAllDigits(StringData str) {
     return std::all_of(str.begin(), str.end(), [](char c) { return ctype::isDigit(c); });
 }
 
+BSONObjFieldIndex::BSONObjFieldIndex(std::vector<BSONElement> fields)
+    : _fields(std::move(fields)) {
+    // A stable sort keeps repeated names in document order, so the lookup finds the first one.
+    std::stable_sort(_fields.begin(), _fields.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.fieldNameStringData() < rhs.fieldNameStringData();
+    });
+}
+
+BSONElement BSONObjFieldIndex::getField(StringData name) const {
+    auto it = std::lower_bound(
+        _fields.begin(), _fields.end(), name, [](const auto& elem, StringData name) {
+            return elem.fieldNameStringData() < name;
+        });
+    if (it == _fields.end() || it->fieldNameStringData() != name)
+        return BSONElement();
+    return *it;
+}
+
 BSONElement getFieldDottedOrArray(const BSONObj& doc,
                                   const FieldRef& path,
                                   size_t* idxPath,
-                                  size_t startIndex) {
+                                  size_t startIndex,
+                                  const BSONObjFieldIndex* fieldIndex) {
     if (path.numParts() == startIndex)
         return doc.getField("");
 
@@ -52,7 +71,8 @@ BSONElement getFieldDottedOrArray(const BSONObj& doc,
     bool stop = false;
     size_t partNum = startIndex;
     while (partNum < path.numParts() && !stop) {
-        res = curr.getField(path.getPart(partNum));
+        res = (fieldIndex && partNum == startIndex) ? fieldIndex->getField(path.getPart(partNum))
+                                                    : curr.getField(path.getPart(partNum));
 
         switch (res.type()) {
             case EOO:
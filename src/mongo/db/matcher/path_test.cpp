@@ -31,7 +31,9 @@
 
 #include "mongo/db/jsobj.h"
 #include "mongo/db/json.h"
+#include "mongo/db/matcher/matchable.h"
 #include "mongo/db/matcher/path.h"
+#include "mongo/db/matcher/path_internal.h"
 
 namespace mongo {
 
@@ -593,4 +595,63 @@ TEST(SingleElementElementIterator, Simple1) {
 
     ASSERT(!i.more());
 }
+
+std::vector<BSONElement> allFields(const BSONObj& obj) {
+    std::vector<BSONElement> fields;
+    for (auto&& elem : obj) {
+        fields.push_back(elem);
+    }
+    return fields;
+}
+
+TEST(BSONObjFieldIndex, FindsFieldsLikeGetField) {
+    BSONObj doc = BSON("c" << 1 << "a" << 2 << "b" << 3 << "a" << 4 << "" << 5);
+    BSONObjFieldIndex index(allFields(doc));
+
+    for (auto&& name : {"a", "b", "c", ""}) {
+        ASSERT_EQ(doc.getField(name).rawdata(), index.getField(name).rawdata()) << name;
+    }
+    ASSERT_EQ(2, index.getField("a").numberInt());
+    ASSERT(index.getField("d").eoo());
+    ASSERT(index.getField("aa").eoo());
+}
+
+TEST(BSONObjFieldIndex, IteratorUsesIndexForFirstField) {
+    ElementPath p{"b.c"};
+
+    BSONObj doc = BSON("a" << 1 << "b" << BSON_ARRAY(BSON("c" << 5) << BSON("c" << 6)));
+    BSONObjFieldIndex index(allFields(doc));
+
+    BSONElementIterator cursor(&p, doc, &index);
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(5, cursor.next().element().numberInt());
+    ASSERT(cursor.more());
+    ASSERT_EQUALS(6, cursor.next().element().numberInt());
+    ASSERT(!cursor.more());
+}
+
+TEST(BSONMatchableDocument, RepeatedLookupsIntoWideDocument) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 200; i++) {
+        builder.append(str::stream() << "field" << i, i);
+    }
+    builder.append("field7", -1);
+    BSONObj doc = builder.obj();
+
+    BSONMatchableDocument matchable(doc);
+    for (int round = 0; round < 3; round++) {
+        for (int i : {0, 7, 150, 199}) {
+            ElementPath p{str::stream() << "field" << i};
+            MatchableDocument::IteratorHolder cursor(&matchable, &p);
+            ASSERT(cursor->more());
+            ASSERT_EQUALS(i, cursor->next().element().numberInt());
+            ASSERT(!cursor->more());
+        }
+
+        ElementPath missing{"field200"};
+        MatchableDocument::IteratorHolder cursor(&matchable, &missing);
+        ASSERT(cursor->more());
+        ASSERT(cursor->next().element().eoo());
+    }
+}
 }  // namespace mongo
@@ -91,6 +91,8 @@ const NamespaceString NamespaceString::kSystemReplSetNamespace(NamespaceString::
                                                                "system.replset");
 const NamespaceString NamespaceString::kIndexBuildEntryNamespace(NamespaceString::kConfigDb,
                                                                  "system.indexBuilds");
+const NamespaceString NamespaceString::kChangeStreamPreImagesNamespace(NamespaceString::kConfigDb,
+                                                                      "system.preimages");
 const NamespaceString NamespaceString::kRangeDeletionNamespace(NamespaceString::kConfigDb,
                                                                "rangeDeletions");
 const NamespaceString NamespaceString::kRangeDeletionForRenameNamespace(NamespaceString::kConfigDb,
@@ -121,6 +123,9 @@ const NamespaceString NamespaceString::kReshardingApplierProgressNamespace(
 const NamespaceString NamespaceString::kReshardingTxnClonerProgressNamespace(
     NamespaceString::kConfigDb, "localReshardingOperations.recipient.progress_txn_cloner");
 
+const NamespaceString NamespaceString::kReshardingCollectionClonerProgressNamespace(
+    NamespaceString::kConfigDb, "localReshardingOperations.recipient.progress_collection_cloner");
+
 const NamespaceString NamespaceString::kCollectionCriticalSectionsNamespace(
     NamespaceString::kConfigDb, "collection_critical_sections");
 
@@ -151,6 +156,8 @@ bool NamespaceString::isLegalClientSystemNS(
             return true;
         if (coll() == kIndexBuildEntryNamespace.coll())
             return true;
+        if (coll() == kChangeStreamPreImagesNamespace.coll())
+            return true;
         if (coll().find(".system.resharding.") != std::string::npos)
             return true;
         if (coll() == kShardingDDLCoordinatorsNamespace.coll())
@@ -348,6 +355,11 @@ bool NamespaceString::isReplicated() const {
         return false;
     }
 
+    // Each node records change stream pre-images locally while applying the oplog.
+    if (*this == kChangeStreamPreImagesNamespace) {
+        return false;
+    }
+
     // E.g: `system.version` is replicated.
     return true;
 }
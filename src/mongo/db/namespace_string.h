@@ -139,6 +139,9 @@ public:
     // Namespace for index build entries.
     static const NamespaceString kIndexBuildEntryNamespace;
 
+    // Namespace for storing change stream pre-images outside of the oplog.
+    static const NamespaceString kChangeStreamPreImagesNamespace;
+
     // Namespace for pending range deletions.
     static const NamespaceString kRangeDeletionNamespace;
 
@@ -172,6 +175,9 @@ public:
     // Namespace for storing config.transactions cloner progress for resharding.
     static const NamespaceString kReshardingTxnClonerProgressNamespace;
 
+    // Namespace for storing the _id ranges the collection cloner for resharding clones.
+    static const NamespaceString kReshardingCollectionClonerProgressNamespace;
+
     // Namespace for storing config.collectionCriticalSections documents
     static const NamespaceString kCollectionCriticalSectionsNamespace;
 
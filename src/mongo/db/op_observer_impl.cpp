@@ -41,6 +41,7 @@
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
 #include "mongo/db/catalog/import_collection_oplog_entry_gen.h"
+#include "mongo/db/change_stream_pre_images_collection.h"
 #include "mongo/db/commands/txn_cmds_gen.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
@@ -53,6 +54,7 @@
 #include "mongo/db/read_write_concern_defaults.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/tenant_migration_access_blocker_util.h"
 #include "mongo/db/repl/tenant_migration_decoration.h"
@@ -179,8 +181,11 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx,
     const auto storePreImageForRetryableWrite =
         (args.updateArgs.storeDocOption == CollectionUpdateArgs::StoreDocOption::PreImage &&
          opCtx->getTxnNumber());
+    const auto recordPreImageInPreImagesCollection =
+        args.updateArgs.preImageRecordingEnabledForCollection && !storePreImageForRetryableWrite &&
+        args.uuid && !migrationRecipientInfo && repl::recordPreImagesInPreImagesCollection.load();
     if ((storePreImageForRetryableWrite || args.updateArgs.preImageRecordingEnabledForCollection) &&
-        !migrationRecipientInfo) {
+        !migrationRecipientInfo && !recordPreImageInPreImagesCollection) {
         MutableOplogEntry noopEntry = oplogEntry;
         invariant(args.updateArgs.preImageDoc);
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
@@ -206,6 +211,9 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx,
     oplogEntry.setObject(args.updateArgs.update);
     oplogEntry.setObject2(args.updateArgs.criteria);
     oplogEntry.setFromMigrateIfTrue(args.updateArgs.source == OperationSource::kFromMigrate);
+    if (recordPreImageInPreImagesCollection) {
+        oplogEntry.setPreImageRecorded(true);
+    }
     // oplogLink could have been changed to include pre/postImageOpTime by the previous no-op write.
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, args.updateArgs.stmtIds);
     if (args.updateArgs.oplogSlot) {
@@ -213,6 +221,10 @@ OpTimeBundle replLogUpdate(OperationContext* opCtx,
     }
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
+    if (recordPreImageInPreImagesCollection && !opTimes.writeOpTime.isNull()) {
+        change_stream_pre_images::insertPreImage(
+            opCtx, *args.uuid, opTimes.writeOpTime.getTimestamp(), *args.updateArgs.preImageDoc);
+    }
     return opTimes;
 }
 
@@ -237,7 +249,12 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     // We never want to store pre-images when we're migrating oplog entries from another
     // replica set.
     const auto& migrationRecipientInfo = repl::tenantMigrationRecipientInfo(opCtx);
-    if (deletedDoc && !migrationRecipientInfo) {
+    // Pre-images of retryable deletes are needed to retry findAndModify, so they are always kept
+    // in the oplog.
+    const auto recordPreImageInPreImagesCollection = deletedDoc && uuid &&
+        !opCtx->getTxnNumber() && !migrationRecipientInfo &&
+        repl::recordPreImagesInPreImagesCollection.load();
+    if (deletedDoc && !migrationRecipientInfo && !recordPreImageInPreImagesCollection) {
         MutableOplogEntry noopEntry = oplogEntry;
         noopEntry.setOpType(repl::OpTypeEnum::kNoop);
         noopEntry.setObject(*deletedDoc);
@@ -249,10 +266,17 @@ OpTimeBundle replLogDelete(OperationContext* opCtx,
     oplogEntry.setOpType(repl::OpTypeEnum::kDelete);
     oplogEntry.setObject(documentKeyDecoration(opCtx).get().getShardKeyAndId());
     oplogEntry.setFromMigrateIfTrue(fromMigrate);
+    if (recordPreImageInPreImagesCollection) {
+        oplogEntry.setPreImageRecorded(true);
+    }
     // oplogLink could have been changed to include preImageOpTime by the previous no-op write.
     repl::appendOplogEntryChainInfo(opCtx, &oplogEntry, &oplogLink, {stmtId});
     opTimes.writeOpTime = logOperation(opCtx, &oplogEntry);
     opTimes.wallClockTime = oplogEntry.getWallClockTime();
+    if (recordPreImageInPreImagesCollection && !opTimes.writeOpTime.isNull()) {
+        change_stream_pre_images::insertPreImage(
+            opCtx, *uuid, opTimes.writeOpTime.getTimestamp(), *deletedDoc);
+    }
     return opTimes;
 }
 
@@ -625,7 +649,7 @@ void OpObserverImpl::onUpdate(OperationContext* opCtx, const OplogUpdateEntryArg
     } else if (args.nss.isTimeseriesBucketsCollection()) {
         if (args.updateArgs.source != OperationSource::kTimeseries) {
             auto& bucketCatalog = BucketCatalog::get(opCtx);
-            bucketCatalog.clear(args.updateArgs.updatedDoc["_id"].OID());
+            bucketCatalog.handleDirectWrite(opCtx, args.updateArgs.updatedDoc["_id"].OID());
         }
     }
 }
@@ -646,7 +670,7 @@ void OpObserverImpl::aboutToDelete(OperationContext* opCtx,
 
     if (nss.isTimeseriesBucketsCollection()) {
         auto& bucketCatalog = BucketCatalog::get(opCtx);
-        bucketCatalog.clear(doc["_id"].OID());
+        bucketCatalog.handleDirectWrite(opCtx, doc["_id"].OID());
     }
 }
 
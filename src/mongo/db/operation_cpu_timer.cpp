@@ -33,6 +33,7 @@
 #include <fmt/format.h>
 
 #if defined(__linux__)
+#include <pthread.h>
 #include <time.h>
 #endif  // defined(__linux__)
 
@@ -185,12 +186,34 @@ OperationCPUTimer* OperationCPUTimer::get(OperationContext* opCtx) {
     return &getCPUTimer(opCtx);
 }
 
+boost::optional<ThreadCPUClock> ThreadCPUClock::forCurrentThread() {
+    clockid_t cid;
+    if (pthread_getcpuclockid(pthread_self(), &cid) != 0)
+        return boost::none;
+    return ThreadCPUClock(cid);
+}
+
+boost::optional<Nanoseconds> ThreadCPUClock::now() const {
+    struct timespec t;
+    if (clock_gettime(_clockId, &t) != 0)
+        return boost::none;
+    return Seconds(t.tv_sec) + Nanoseconds(t.tv_nsec);
+}
+
 #else  // not defined(__linux__)
 
 OperationCPUTimer* OperationCPUTimer::get(OperationContext*) {
     return nullptr;
 }
 
+boost::optional<ThreadCPUClock> ThreadCPUClock::forCurrentThread() {
+    return boost::none;
+}
+
+boost::optional<Nanoseconds> ThreadCPUClock::now() const {
+    return boost::none;
+}
+
 #endif  // defined(__linux__)
 
 }  // namespace mongo
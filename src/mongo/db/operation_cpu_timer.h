@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/util/duration.h"
 
 namespace mongo {
@@ -68,4 +70,28 @@ public:
     virtual void onThreadDetach() = 0;
 };
 
+/**
+ * Reads the CPU time consumed by a particular thread. Unlike OperationCPUTimer, the clock may be
+ * read from any thread, which allows reporting the CPU time of an operation that is still running.
+ * Reads fail once the thread has exited.
+ */
+class ThreadCPUClock {
+public:
+    /**
+     * Returns `boost::none` if the platform does not support tracking of CPU consumption.
+     */
+    static boost::optional<ThreadCPUClock> forCurrentThread();
+
+    /**
+     * Returns the CPU time consumed by the thread since it was created, or `boost::none` if it
+     * cannot be read.
+     */
+    boost::optional<Nanoseconds> now() const;
+
+private:
+    explicit ThreadCPUClock(int clockId) : _clockId(clockId) {}
+
+    int _clockId;
+};
+
 }  // namespace mongo
@@ -211,6 +211,25 @@ TEST_F(OperationCPUTimerTest, TimerPausesOnBlockingSleep) {
     ASSERT_LTE(failures, kMaxFailures);
 }
 
+TEST_F(OperationCPUTimerTest, ThreadCPUClockIsReadableFromOtherThreads) {
+    auto clock = ThreadCPUClock::forCurrentThread();
+    ASSERT(clock);
+    auto before = clock->now();
+    ASSERT(before);
+
+    busyWait(Microseconds(1));
+
+    // The CPU time spent busy waiting is visible to another thread.
+    boost::optional<Nanoseconds> observed;
+    stdx::thread observer([&] {
+        sleepFor(Milliseconds(1));
+        observed = clock->now();
+    });
+    observer.join();
+    ASSERT(observed);
+    ASSERT_GT(*observed, *before);
+}
+
 #else
 
 TEST_F(OperationCPUTimerTest, TimerNotSetIfNotSupported) {
@@ -218,6 +237,10 @@ TEST_F(OperationCPUTimerTest, TimerNotSetIfNotSupported) {
     ASSERT(timer == nullptr);
 }
 
+TEST_F(OperationCPUTimerTest, ThreadCPUClockNotSetIfNotSupported) {
+    ASSERT_FALSE(ThreadCPUClock::forCurrentThread());
+}
+
 #endif  // defined(__linux__)
 
 }  // namespace mongo
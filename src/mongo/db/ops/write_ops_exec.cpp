@@ -61,6 +61,7 @@
 #include "mongo/db/ops/write_ops_gen.h"
 #include "mongo/db/ops/write_ops_retryability.h"
 #include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/find.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
 #include "mongo/db/record_id_helpers.h"
@@ -1004,6 +1005,33 @@ static SingleWriteResult performSingleDeleteOp(OperationContext* opCtx,
     CurOpFailpointHelpers::waitWhileFailPointEnabled(
         &hangWithLockDuringBatchRemove, opCtx, "hangWithLockDuringBatchRemove");
 
+    // A delete by _id looks the document up and removes it without building a PlanExecutor.
+    const auto& coll = collection.getCollection();
+    if (!parsedDelete.hasParsedQuery() && request.getHint().isEmpty() &&
+        request.getCollation().isEmpty() && !ns.isSystem() &&
+        canUseExpressIdLookup(opCtx, coll) && !coll->isCapped()) {
+        const long long nDeleted = writeConflictRetry(opCtx, "delete", ns.ns(), [&] {
+            Snapshotted<BSONObj> doc;
+            RecordId recordId = findByIdExpress(opCtx, coll, request.getQuery(), &doc);
+            if (recordId.isNull()) {
+                return 0;
+            }
+
+            WriteUnitOfWork wunit(opCtx);
+            coll->deleteDocument(opCtx, doc, stmtId, recordId, &curOp.debug());
+            wunit.commit();
+            return 1;
+        });
+        curOp.debug().additiveMetrics.ndeleted = nDeleted;
+        endExpressIdOp(opCtx, coll, nDeleted > 0);
+
+        LastError::get(opCtx->getClient()).recordDelete(nDeleted);
+
+        SingleWriteResult result;
+        result.setN(nDeleted);
+        return result;
+    }
+
     auto exec = uassertStatusOK(getExecutorDelete(
         &curOp.debug(), &collection.getCollection(), &parsedDelete, boost::none /* verbosity */));
 
@@ -81,6 +81,16 @@ public:
         processInternal(input, merging);
     }
 
+    /**
+     * Processes each of 'inputs' as process(input, false) would. Accumulators which can consume a
+     * batch of inputs faster than one at a time override this.
+     */
+    virtual void processBatch(const std::vector<Value>& inputs) {
+        for (auto&& input : inputs) {
+            process(input, false);
+        }
+    }
+
     /**
      * Finish processing all the pending operations, and clean up memory. Some accumulators
      * ($accumulator for example) might do a batch processing in order to improve performace. In
@@ -226,9 +236,18 @@ private:
 
 class AccumulatorSum final : public AccumulatorState {
 public:
+    /**
+     * If 'inputs' are all NumberInt or NumberDouble, or all NumberLong, adds them to 'total' with
+     * one batched summation and returns the widest of their types. Otherwise returns boost::none
+     * and leaves 'total' untouched.
+     */
+    static boost::optional<BSONType> sumUniformNumbers(const std::vector<Value>& inputs,
+                                                       DoubleDoubleSummation* total);
+
     explicit AccumulatorSum(ExpressionContext* const expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatch(const std::vector<Value>& inputs) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
@@ -316,6 +335,7 @@ public:
     explicit AccumulatorAvg(ExpressionContext* const expCtx);
 
     void processInternal(const Value& input, bool merging) final;
+    void processBatch(const std::vector<Value>& inputs) final;
     Value getValue(bool toBeMerged) final;
     const char* getOpName() const final;
     void reset() final;
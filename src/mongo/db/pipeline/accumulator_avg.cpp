@@ -98,6 +98,14 @@ void AccumulatorAvg::processInternal(const Value& input, bool merging) {
     _count++;
 }
 
+void AccumulatorAvg::processBatch(const std::vector<Value>& inputs) {
+    if (AccumulatorSum::sumUniformNumbers(inputs, &_nonDecimalTotal)) {
+        _count += inputs.size();
+        return;
+    }
+    AccumulatorState::processBatch(inputs);
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorAvg::create(ExpressionContext* const expCtx) {
     return new AccumulatorAvg(expCtx);
 }
@@ -95,6 +95,54 @@ void AccumulatorSum::processInternal(const Value& input, bool merging) {
     }
 }
 
+boost::optional<BSONType> AccumulatorSum::sumUniformNumbers(const std::vector<Value>& inputs,
+                                                            DoubleDoubleSummation* total) {
+    if (inputs.empty()) {
+        return boost::none;
+    }
+
+    if (inputs.front().getType() == NumberLong) {
+        std::vector<long long> longs;
+        longs.reserve(inputs.size());
+        for (auto&& input : inputs) {
+            if (input.getType() != NumberLong) {
+                return boost::none;
+            }
+            longs.push_back(input.getLong());
+        }
+        total->addLongs(longs.data(), longs.size());
+        return NumberLong;
+    }
+
+    // Ints are summed as doubles, as addInt() does.
+    BSONType type = NumberInt;
+    std::vector<double> doubles;
+    doubles.reserve(inputs.size());
+    for (auto&& input : inputs) {
+        switch (input.getType()) {
+            case NumberInt:
+                doubles.push_back(input.getInt());
+                break;
+            case NumberDouble:
+                type = NumberDouble;
+                doubles.push_back(input.getDouble());
+                break;
+            default:
+                return boost::none;
+        }
+    }
+    total->addDoubles(doubles.data(), doubles.size());
+    return type;
+}
+
+void AccumulatorSum::processBatch(const std::vector<Value>& inputs) {
+    if (auto type = sumUniformNumbers(inputs, &nonDecimalTotal)) {
+        totalType = Value::getWidestNumeric(totalType, *type);
+        return;
+    }
+    AccumulatorState::processBatch(inputs);
+}
+
 intrusive_ptr<AccumulatorState> AccumulatorSum::create(ExpressionContext* const expCtx) {
     return new AccumulatorSum(expCtx);
 }
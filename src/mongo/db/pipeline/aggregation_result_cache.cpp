@@ -0,0 +1,406 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/commands/server_status_metric.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/service_context.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+const auto getAggregationResultCache =
+    ServiceContext::declareDecoration<AggregationResultCache>();
+
+Counter64 aggregationResultCacheHits;
+Counter64 aggregationResultCacheMisses;
+ServerStatusMetricField<Counter64> aggregationResultCacheHitsMetric(
+    "query.aggregationResultCache.hits", &aggregationResultCacheHits);
+ServerStatusMetricField<Counter64> aggregationResultCacheMissesMetric(
+    "query.aggregationResultCache.misses", &aggregationResultCacheMisses);
+
+// The stages whose output only depends on their input documents and their own specification.
+const StringDataSet kDeterministicStages{"$addFields",
+                                         "$bucket",
+                                         "$bucketAuto",
+                                         "$count",
+                                         "$facet",
+                                         "$group",
+                                         "$limit",
+                                         "$match",
+                                         "$project",
+                                         "$redact",
+                                         "$replaceRoot",
+                                         "$replaceWith",
+                                         "$set",
+                                         "$setWindowFields",
+                                         "$skip",
+                                         "$sort",
+                                         "$sortByCount",
+                                         "$unset",
+                                         "$unwind"};
+
+// Operators whose result may change between two evaluations over the same input.
+const StringDataSet kNonDeterministicOperators{
+    "$accumulator", "$function", "$rand", "$sampleRate", "$where"};
+
+/**
+ * Returns whether 'elem', an expression or a part of a stage specification, refers to the current
+ * time or to a non-deterministic operator.
+ */
+bool isDeterministic(const BSONElement& elem) {
+    if (elem.type() == BSONType::String) {
+        const auto str = elem.valueStringData();
+        return !str.startsWith("$$NOW") && !str.startsWith("$$CLUSTER_TIME");
+    }
+    if (!elem.isABSONObj()) {
+        return true;
+    }
+    for (auto&& child : elem.Obj()) {
+        if (kNonDeterministicOperators.contains(child.fieldNameStringData()) ||
+            !isDeterministic(child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isDeterministicPipeline(const std::vector<BSONObj>& pipeline) {
+    for (auto&& stage : pipeline) {
+        const auto stageSpec = stage.firstElement();
+        const auto stageName = stageSpec.fieldNameStringData();
+        if (stage.nFields() != 1 || !kDeterministicStages.contains(stageName)) {
+            return false;
+        }
+        if (stageName == "$facet" && stageSpec.type() == BSONType::Object) {
+            for (auto&& facet : stageSpec.Obj()) {
+                if (facet.type() != BSONType::Array) {
+                    return false;
+                }
+                std::vector<BSONObj> facetPipeline;
+                for (auto&& facetStage : facet.Obj()) {
+                    if (facetStage.type() != BSONType::Object) {
+                        return false;
+                    }
+                    facetPipeline.push_back(facetStage.Obj());
+                }
+                if (!isDeterministicPipeline(facetPipeline)) {
+                    return false;
+                }
+            }
+        } else if (!isDeterministic(stageSpec)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t batchSizeBytes(const AggregationResultCache::Batch& batch) {
+    size_t bytes = 0;
+    for (auto&& doc : batch) {
+        bytes += doc.objsize();
+    }
+    return bytes;
+}
+
+}  // namespace
+
+AggregationResultCache& AggregationResultCache::get(ServiceContext* service) {
+    return getAggregationResultCache(service);
+}
+
+boost::optional<std::string> AggregationResultCache::makeKey(
+    const AggregateCommandRequest& request) {
+    if (request.getExplain() || request.getExchange() || request.getFromMongos() ||
+        request.getNeedsMerge() || request.getIsMapReduceCommand() ||
+        request.getRequestReshardingResumeToken() || request.getLegacyRuntimeConstants() ||
+        !isDeterministicPipeline(request.getPipeline())) {
+        return boost::none;
+    }
+
+    BSONObjBuilder keyBuilder;
+    keyBuilder.append("ns", request.getNamespace().ns());
+    keyBuilder.append("pipeline", request.getPipeline());
+    if (auto collation = request.getCollation()) {
+        keyBuilder.append("collation", *collation);
+    }
+    if (auto hint = request.getHint()) {
+        keyBuilder.append("hint", *hint);
+    }
+    if (auto let = request.getLet()) {
+        for (auto&& variable : *let) {
+            if (!isDeterministic(variable)) {
+                return boost::none;
+            }
+        }
+        keyBuilder.append("let", *let);
+    }
+    auto key = keyBuilder.done();
+    return std::string(key.objdata(), key.objsize());
+}
+
+AggregationResultCache::AggregationResultCache()
+    : _entries(std::numeric_limits<size_t>::max()) {}
+
+AggregationResultCache::~AggregationResultCache() = default;
+
+bool AggregationResultCache::isEnabled() const {
+    return internalQueryAggregationResultCacheMaxBytes.load() > 0;
+}
+
+size_t AggregationResultCache::_stripeIndex(const NamespaceString& nss) {
+    return StringMapHasher{}(nss.ns()) % kNumWriteGenerationStripes;
+}
+
+AggregationResultCache::WriteGeneration AggregationResultCache::getWriteGeneration(
+    const NamespaceString& nss) const {
+    const auto& stripe = _stripes[_stripeIndex(nss)];
+    WriteGeneration generation;
+    generation.global = _globalWriteGeneration.load();
+    // Reading 'finished' first means that 'started' can only be found lower than it if a write
+    // started and finished in between, which the caller sees as a write in progress.
+    generation.finished = stripe.finished.load();
+    generation.started = stripe.started.load();
+    return generation;
+}
+
+void AggregationResultCache::onWriteStarted(const NamespaceString& nss) {
+    _stripes[_stripeIndex(nss)].started.fetchAndAdd(1);
+}
+
+void AggregationResultCache::onWriteCommitted(OperationContext* opCtx,
+                                              const NamespaceString& nss,
+                                              const std::vector<BSONObj>* insertedDocs) {
+    _onWriteFinished(opCtx, nss, true /* dataChanged */, insertedDocs);
+}
+
+void AggregationResultCache::onWriteAborted(const NamespaceString& nss) {
+    _onWriteFinished(nullptr, nss, false /* dataChanged */, nullptr);
+}
+
+void AggregationResultCache::_onWriteFinished(OperationContext* opCtx,
+                                              const NamespaceString& nss,
+                                              bool dataChanged,
+                                              const std::vector<BSONObj>* insertedDocs) {
+    const auto stripeIndex = _stripeIndex(nss);
+    auto& stripe = _stripes[stripeIndex];
+    if (!isMaintainingResults()) {
+        stripe.finished.fetchAndAdd(1);
+        return;
+    }
+
+    struct PendingUpdate {
+        std::string key;
+        std::shared_ptr<MaintainedResult> maintained;
+        std::shared_ptr<const Batch> batch;
+    };
+    std::vector<PendingUpdate> pendingUpdates;
+    uint64_t newGeneration;
+    {
+        // The maintained results have to move from one generation to the next in the order of the
+        // writes, so the count and the generations of the entries are updated together.
+        stdx::lock_guard<Latch> lk(_mutex);
+        newGeneration = _globalWriteGeneration.load() + stripe.finished.addAndFetch(1);
+        auto keysIt = _maintainedKeysByStripe.find(stripeIndex);
+        if (keysIt == _maintainedKeysByStripe.end()) {
+            return;
+        }
+
+        const std::vector<std::string> keys(keysIt->second.begin(), keysIt->second.end());
+        for (auto&& key : keys) {
+            Entry* entry;
+            invariant(_entries.get(key, &entry));
+
+            // A result which missed a write, counted without holding '_mutex', is never used
+            // again. So is a result still being updated for the previous write.
+            if (entry->writeGeneration + 1 != newGeneration) {
+                _removeEntry(lk, key, *entry);
+                continue;
+            }
+            if (!dataChanged || entry->nss != nss) {
+                entry->writeGeneration = newGeneration;
+                continue;
+            }
+            if (!insertedDocs) {
+                _removeEntry(lk, key, *entry);
+                continue;
+            }
+            pendingUpdates.push_back({key, entry->maintained, entry->batch});
+        }
+    }
+    if (pendingUpdates.empty()) {
+        return;
+    }
+
+    // Updating a result can take as long as a $group over the inserted documents, so it is done
+    // without '_mutex' held. Until it is done, the entry stays at the previous generation: the
+    // reads at the new generation miss it, and another write to the stripe drops it.
+    std::vector<boost::optional<Batch>> updatedBatches;
+    for (auto&& update : pendingUpdates) {
+        stdx::lock_guard<Latch> maintainerLk(update.maintained->mutex);
+        updatedBatches.push_back(
+            update.maintained->maintainer->apply(opCtx, *update.batch, *insertedDocs));
+    }
+
+    const auto maxEntryBytes =
+        static_cast<size_t>(internalQueryAggregationResultCacheMaxEntryBytes.load());
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (size_t i = 0; i < pendingUpdates.size(); ++i) {
+        const auto& key = pendingUpdates[i].key;
+        auto& updated = updatedBatches[i];
+
+        // The key may have been dropped, or cached again from a newer read, in the meantime.
+        Entry* entry;
+        if (!_entries.get(key, &entry).isOK() ||
+            entry->maintained != pendingUpdates[i].maintained) {
+            continue;
+        }
+
+        const auto updatedBytes = updated ? key.size() + batchSizeBytes(*updated) : 0;
+        if (entry->writeGeneration + 1 != newGeneration || !updated ||
+            updatedBytes > maxEntryBytes) {
+            _removeEntry(lk, key, *entry);
+            continue;
+        }
+        _sizeBytes.fetchAndAdd(updatedBytes);
+        _sizeBytes.fetchAndSubtract(entry->bytes);
+        entry->bytes = updatedBytes;
+        entry->batch = std::make_shared<const Batch>(std::move(*updated));
+        entry->writeGeneration = newGeneration;
+    }
+    _evictToSizeLimit(lk);
+}
+
+void AggregationResultCache::onWriteToAll() {
+    _globalWriteGeneration.fetchAndAdd(1);
+}
+
+std::shared_ptr<const AggregationResultCache::Batch> AggregationResultCache::find(
+    const std::string& key, const WriteGeneration& writeGeneration) {
+    const auto generation = writeGeneration.committed();
+    stdx::lock_guard<Latch> lk(_mutex);
+    Entry* entry;
+    if (!_entries.get(key, &entry).isOK()) {
+        aggregationResultCacheMisses.increment();
+        return nullptr;
+    }
+    if (entry->writeGeneration != generation) {
+        // A result from before a write is never used again.
+        if (entry->writeGeneration < generation) {
+            _removeEntry(lk, key, *entry);
+        }
+        aggregationResultCacheMisses.increment();
+        return nullptr;
+    }
+    aggregationResultCacheHits.increment();
+    return entry->batch;
+}
+
+void AggregationResultCache::insert(const std::string& key,
+                                    const NamespaceString& nss,
+                                    const WriteGeneration& writeGeneration,
+                                    Batch batch,
+                                    std::unique_ptr<GroupResultMaintainer> maintainer) {
+    const auto maxBytes = static_cast<size_t>(internalQueryAggregationResultCacheMaxBytes.load());
+    const auto bytes = key.size() + batchSizeBytes(batch);
+    if (bytes > static_cast<size_t>(internalQueryAggregationResultCacheMaxEntryBytes.load()) ||
+        bytes > maxBytes || writeGeneration.started != writeGeneration.finished) {
+        return;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Checked with '_mutex' held, so that the writes which start from now on see this entry if
+    // it is maintained on inserts.
+    if (!(getWriteGeneration(nss) == writeGeneration)) {
+        return;
+    }
+
+    const auto generation = writeGeneration.committed();
+    Entry* existing;
+    if (_entries.get(key, &existing).isOK()) {
+        if (existing->writeGeneration >= generation) {
+            return;
+        }
+        _removeEntry(lk, key, *existing);
+    }
+
+    if (maintainer) {
+        _maintainedKeysByStripe[_stripeIndex(nss)].insert(key);
+        _numMaintainedEntries.fetchAndAdd(1);
+    }
+    _entries.add(key,
+                 new Entry{nss,
+                           generation,
+                           std::make_shared<const Batch>(std::move(batch)),
+                           bytes,
+                           maintainer ? std::make_shared<MaintainedResult>(std::move(maintainer))
+                                      : nullptr});
+    _sizeBytes.fetchAndAdd(bytes);
+    _evictToSizeLimit(lk);
+}
+
+void AggregationResultCache::_evictToSizeLimit(WithLock lk) {
+    const auto maxBytes = static_cast<size_t>(internalQueryAggregationResultCacheMaxBytes.load());
+    while (_sizeBytes.load() > maxBytes) {
+        const auto& [lruKey, lruEntry] = *std::prev(_entries.end());
+        const std::string evictedKey = lruKey;
+        _removeEntry(lk, evictedKey, *lruEntry);
+    }
+}
+
+void AggregationResultCache::_removeEntry(WithLock, const std::string& key, const Entry& entry) {
+    _sizeBytes.fetchAndSubtract(entry.bytes);
+    if (entry.maintained) {
+        auto keysIt = _maintainedKeysByStripe.find(_stripeIndex(entry.nss));
+        keysIt->second.erase(key);
+        if (keysIt->second.empty()) {
+            _maintainedKeysByStripe.erase(keysIt);
+        }
+        _numMaintainedEntries.fetchAndSubtract(1);
+    }
+    invariant(_entries.remove(key));
+}
+
+void AggregationResultCache::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+    _maintainedKeysByStripe.clear();
+    _numMaintainedEntries.store(0);
+    _sizeBytes.store(0);
+}
+
+}  // namespace mongo
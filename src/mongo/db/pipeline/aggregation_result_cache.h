@@ -0,0 +1,249 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/pipeline/group_result_maintainer.h"
+#include "mongo/db/query/lru_key_value.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+class AggregateCommandRequest;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Caches the results of aggregations that read a single collection, keyed by the request and the
+ * write generation of the collection, so that repeated identical aggregations over a collection
+ * which has not been written to are answered without running the pipeline again. Only results
+ * that fit in the first batch are cached.
+ *
+ * AggregationResultCacheOpObserver counts every write to a namespace as started when it is
+ * observed, and as finished once it commits or rolls back. The write generation of a namespace is
+ * the number of finished writes. An aggregation reads the generation before it opens its storage
+ * snapshot, and its result is only cached if no write was in progress then or started until the
+ * result was complete. Its snapshot then has every write of the generation and none after it, so
+ * that later writes either update the cached result or advance the generation past it.
+ *
+ * The results of $group pipelines that a GroupResultMaintainer supports are updated as documents
+ * are inserted, rather than dropped.
+ *
+ * The cache is bounded by 'internalQueryAggregationResultCacheMaxBytes' and is disabled when that
+ * is zero. This class is thread-safe.
+ */
+class AggregationResultCache {
+    AggregationResultCache(const AggregationResultCache&) = delete;
+    AggregationResultCache& operator=(const AggregationResultCache&) = delete;
+
+public:
+    using Batch = std::vector<BSONObj>;
+
+    /**
+     * The state of the writes to a namespace, as counted by the observer.
+     */
+    struct WriteGeneration {
+        bool operator==(const WriteGeneration& other) const {
+            return global == other.global && started == other.started &&
+                finished == other.finished;
+        }
+
+        /**
+         * The generation that a result read at this state is cached under.
+         */
+        uint64_t committed() const {
+            return global + finished;
+        }
+
+        uint64_t global = 0;
+        uint64_t started = 0;
+        uint64_t finished = 0;
+    };
+
+    static AggregationResultCache& get(ServiceContext* service);
+
+    /**
+     * Returns the key to cache the result of 'request' under, or boost::none if its result may
+     * differ between two runs over the same data. That is the case when the pipeline reads other
+     * namespaces, writes, or uses randomness or the current time.
+     */
+    static boost::optional<std::string> makeKey(const AggregateCommandRequest& request);
+
+    AggregationResultCache();
+    ~AggregationResultCache();
+
+    /**
+     * Returns whether results can be cached, per 'internalQueryAggregationResultCacheMaxBytes'.
+     */
+    bool isEnabled() const;
+
+    /**
+     * Returns the current write generation of 'nss'.
+     */
+    WriteGeneration getWriteGeneration(const NamespaceString& nss) const;
+
+    /**
+     * Returns whether some cached results are updated on inserts, and so need the inserted
+     * documents passed to onWriteCommitted().
+     */
+    bool isMaintainingResults() const {
+        return _numMaintainedEntries.load() > 0;
+    }
+
+    /**
+     * Counts a write to 'nss' as started. Must be followed by onWriteCommitted() or
+     * onWriteAborted().
+     */
+    void onWriteStarted(const NamespaceString& nss);
+
+    /**
+     * Counts a write to 'nss' as finished, once it has committed. If it only inserted documents,
+     * 'insertedDocs' are those documents and the results maintained on inserts are updated with
+     * them. Otherwise, 'insertedDocs' is null and the results cached for 'nss' are dropped.
+     */
+    void onWriteCommitted(OperationContext* opCtx,
+                          const NamespaceString& nss,
+                          const std::vector<BSONObj>* insertedDocs);
+
+    /**
+     * Counts a write to 'nss' as finished, once it has rolled back.
+     */
+    void onWriteAborted(const NamespaceString& nss);
+
+    /**
+     * Advances the write generation of every namespace, for changes such as a rollback or a
+     * database drop which do not go through per-collection writes.
+     */
+    void onWriteToAll();
+
+    /**
+     * Returns the result cached under 'key' for the write generation 'writeGeneration', or nullptr
+     * if there is none.
+     */
+    std::shared_ptr<const Batch> find(const std::string& key,
+                                      const WriteGeneration& writeGeneration);
+
+    /**
+     * Caches 'batch', the result of a read of 'nss' which started at 'writeGeneration', for 'key'.
+     * Evicts the least recently used results to stay within the size limit. Does nothing if the
+     * result is too large, or if a write to 'nss' was in progress or has started since. If
+     * 'maintainer' is not null, it keeps the result up to date on inserts.
+     */
+    void insert(const std::string& key,
+                const NamespaceString& nss,
+                const WriteGeneration& writeGeneration,
+                Batch batch,
+                std::unique_ptr<GroupResultMaintainer> maintainer = nullptr);
+
+    /**
+     * Returns the total size of the cached results.
+     */
+    size_t getSizeBytes() const {
+        return _sizeBytes.load();
+    }
+
+    void clear();
+
+private:
+    /**
+     * The maintainer of a cached result, with the lock that serializes its updates. These run
+     * without '_mutex' held, and so may outlive the entry.
+     */
+    struct MaintainedResult {
+        explicit MaintainedResult(std::unique_ptr<GroupResultMaintainer> maintainer)
+            : maintainer(std::move(maintainer)) {}
+
+        Mutex mutex = MONGO_MAKE_LATCH("AggregationResultCache::MaintainedResult::mutex");
+        const std::unique_ptr<GroupResultMaintainer> maintainer;
+    };
+
+    struct Entry {
+        NamespaceString nss;
+        uint64_t writeGeneration;
+        std::shared_ptr<const Batch> batch;
+        size_t bytes;
+        std::shared_ptr<MaintainedResult> maintained;
+    };
+
+    // Namespaces share the write counts of their stripe, so a write to one also invalidates the
+    // results cached for the others in the same stripe, unless those are maintained on inserts.
+    static constexpr size_t kNumWriteGenerationStripes = 1024;
+
+    struct Stripe {
+        AtomicWord<uint64_t> started{0};
+        AtomicWord<uint64_t> finished{0};
+    };
+
+    static size_t _stripeIndex(const NamespaceString& nss);
+
+    /**
+     * Counts a write to 'nss' as finished and brings the results maintained on inserts in its
+     * stripe to the new generation. 'dataChanged' tells whether the write did change 'nss', in
+     * which case its results are updated with 'insertedDocs' if that is not null, and dropped
+     * otherwise. The updates run without '_mutex' held, and a result is dropped if its entry
+     * changed generation in the meantime.
+     */
+    void _onWriteFinished(OperationContext* opCtx,
+                          const NamespaceString& nss,
+                          bool dataChanged,
+                          const std::vector<BSONObj>* insertedDocs);
+
+    void _evictToSizeLimit(WithLock);
+
+    void _removeEntry(WithLock, const std::string& key, const Entry& entry);
+
+    // Advanced by onWriteToAll(), and added to the generation of every stripe.
+    AtomicWord<uint64_t> _globalWriteGeneration{0};
+    std::array<Stripe, kNumWriteGenerationStripes> _stripes;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("AggregationResultCache::_mutex");
+
+    // The entries are bounded by '_sizeBytes', not by their number.
+    LRUKeyValue<std::string, Entry> _entries;
+
+    // The keys of the entries maintained on inserts, by stripe.
+    stdx::unordered_map<size_t, StringSet> _maintainedKeysByStripe;
+
+    // Only written with '_mutex' held.
+    AtomicWord<size_t> _sizeBytes{0};
+    AtomicWord<size_t> _numMaintainedEntries{0};
+};
+
+}  // namespace mongo
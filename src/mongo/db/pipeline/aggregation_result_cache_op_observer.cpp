@@ -0,0 +1,157 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache_op_observer.h"
+
+#include "mongo/db/operation_context.h"
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Counts a write to 'nss' as started, and as finished once it commits or rolls back. For inserts,
+ * 'insertedDocs' are the new documents, which the cache uses to update the results it maintains
+ * on inserts.
+ */
+void observeWrite(OperationContext* opCtx,
+                  const NamespaceString& nss,
+                  std::shared_ptr<std::vector<BSONObj>> insertedDocs = nullptr) {
+    auto& cache = AggregationResultCache::get(opCtx->getServiceContext());
+    cache.onWriteStarted(nss);
+    opCtx->recoveryUnit()->onCommit(
+        [opCtx, &cache, nss, insertedDocs = std::move(insertedDocs)](boost::optional<Timestamp>) {
+            cache.onWriteCommitted(opCtx, nss, insertedDocs.get());
+        });
+    opCtx->recoveryUnit()->onRollback([&cache, nss] { cache.onWriteAborted(nss); });
+}
+
+/**
+ * Advances the write generation of every namespace once the write being observed commits.
+ */
+void advanceAllWriteGenerationsOnCommit(OperationContext* opCtx) {
+    auto& cache = AggregationResultCache::get(opCtx->getServiceContext());
+    opCtx->recoveryUnit()->onCommit(
+        [&cache](boost::optional<Timestamp>) { cache.onWriteToAll(); });
+}
+
+}  // namespace
+
+void AggregationResultCacheOpObserver::onInserts(OperationContext* opCtx,
+                                                 const NamespaceString& nss,
+                                                 OptionalCollectionUUID uuid,
+                                                 std::vector<InsertStatement>::const_iterator first,
+                                                 std::vector<InsertStatement>::const_iterator last,
+                                                 bool fromMigrate) {
+    std::shared_ptr<std::vector<BSONObj>> insertedDocs;
+    // The documents are only needed, and so only copied, when some results are maintained.
+    if (AggregationResultCache::get(opCtx->getServiceContext()).isMaintainingResults()) {
+        insertedDocs = std::make_shared<std::vector<BSONObj>>();
+        for (auto it = first; it != last; ++it) {
+            insertedDocs->push_back(it->doc.getOwned());
+        }
+    }
+    observeWrite(opCtx, nss, std::move(insertedDocs));
+}
+
+void AggregationResultCacheOpObserver::onUpdate(OperationContext* opCtx,
+                                                const OplogUpdateEntryArgs& args) {
+    observeWrite(opCtx, args.nss);
+}
+
+void AggregationResultCacheOpObserver::onDelete(OperationContext* opCtx,
+                                                const NamespaceString& nss,
+                                                OptionalCollectionUUID uuid,
+                                                StmtId stmtId,
+                                                bool fromMigrate,
+                                                const boost::optional<BSONObj>& deletedDoc) {
+    observeWrite(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onDropDatabase(OperationContext* opCtx,
+                                                      const std::string& dbName) {
+    advanceAllWriteGenerationsOnCommit(opCtx);
+}
+
+repl::OpTime AggregationResultCacheOpObserver::onDropCollection(
+    OperationContext* opCtx,
+    const NamespaceString& collectionName,
+    OptionalCollectionUUID uuid,
+    std::uint64_t numRecords,
+    CollectionDropType dropType) {
+    observeWrite(opCtx, collectionName);
+    return {};
+}
+
+void AggregationResultCacheOpObserver::onRenameCollection(OperationContext* opCtx,
+                                                          const NamespaceString& fromCollection,
+                                                          const NamespaceString& toCollection,
+                                                          OptionalCollectionUUID uuid,
+                                                          OptionalCollectionUUID dropTargetUUID,
+                                                          std::uint64_t numRecords,
+                                                          bool stayTemp) {
+    postRenameCollection(opCtx, fromCollection, toCollection, uuid, dropTargetUUID, stayTemp);
+}
+
+void AggregationResultCacheOpObserver::postRenameCollection(OperationContext* opCtx,
+                                                            const NamespaceString& fromCollection,
+                                                            const NamespaceString& toCollection,
+                                                            OptionalCollectionUUID uuid,
+                                                            OptionalCollectionUUID dropTargetUUID,
+                                                            bool stayTemp) {
+    observeWrite(opCtx, fromCollection);
+    observeWrite(opCtx, toCollection);
+}
+
+void AggregationResultCacheOpObserver::onImportCollection(OperationContext* opCtx,
+                                                          const UUID& importUUID,
+                                                          const NamespaceString& nss,
+                                                          long long numRecords,
+                                                          long long dataSize,
+                                                          const BSONObj& catalogEntry,
+                                                          const BSONObj& storageMetadata,
+                                                          bool isDryRun) {
+    observeWrite(opCtx, nss);
+}
+
+void AggregationResultCacheOpObserver::onEmptyCapped(OperationContext* opCtx,
+                                                     const NamespaceString& collectionName,
+                                                     OptionalCollectionUUID uuid) {
+    observeWrite(opCtx, collectionName);
+}
+
+void AggregationResultCacheOpObserver::onReplicationRollback(OperationContext* opCtx,
+                                                             const RollbackObserverInfo& rbInfo) {
+    // A rollback changes the data without going through the observed writes.
+    AggregationResultCache::get(opCtx->getServiceContext()).onWriteToAll();
+}
+
+}  // namespace mongo
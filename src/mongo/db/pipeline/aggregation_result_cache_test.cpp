@@ -0,0 +1,307 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/aggregation_result_cache.h"
+
+#include <limits>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/group_result_maintainer.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kTestNss("test.coll");
+
+AggregateCommandRequest makeRequest(std::vector<BSONObj> pipeline) {
+    return AggregateCommandRequest(kTestNss, std::move(pipeline));
+}
+
+AggregationResultCache::Batch makeBatch(int numDocs) {
+    AggregationResultCache::Batch batch;
+    for (int i = 0; i < numDocs; ++i) {
+        batch.push_back(BSON("_id" << i));
+    }
+    return batch;
+}
+
+TEST(AggregationResultCacheTest, KeyDependsOnThePipelineAndItsOptions) {
+    auto request = makeRequest({fromjson("{$group: {_id: '$a', n: {$sum: 1}}}")});
+    auto key = AggregationResultCache::makeKey(request);
+    ASSERT(key);
+    ASSERT_EQ(*key, *AggregationResultCache::makeKey(request));
+
+    auto otherPipeline = makeRequest({fromjson("{$group: {_id: '$b', n: {$sum: 1}}}")});
+    ASSERT_NE(*key, *AggregationResultCache::makeKey(otherPipeline));
+
+    auto withCollation = request;
+    withCollation.setCollation(fromjson("{locale: 'fr'}"));
+    ASSERT_NE(*key, *AggregationResultCache::makeKey(withCollation));
+}
+
+TEST(AggregationResultCacheTest, NonDeterministicPipelinesAreNotCached) {
+    ASSERT_FALSE(AggregationResultCache::makeKey(makeRequest({fromjson("{$sample: {size: 1}}")})));
+    ASSERT_FALSE(AggregationResultCache::makeKey(
+        makeRequest({fromjson("{$lookup: {from: 'b', localField: 'a', foreignField: 'a', "
+                              "as: 'b'}}")})));
+    ASSERT_FALSE(
+        AggregationResultCache::makeKey(makeRequest({fromjson("{$addFields: {r: {$rand: {}}}}")})));
+    ASSERT_FALSE(
+        AggregationResultCache::makeKey(makeRequest({fromjson("{$set: {now: '$$NOW'}}")})));
+    ASSERT_FALSE(AggregationResultCache::makeKey(
+        makeRequest({fromjson("{$facet: {a: [{$match: {$sampleRate: 0.5}}]}}")})));
+    ASSERT_FALSE(AggregationResultCache::makeKey(makeRequest({fromjson("{$out: 'other'}")})));
+
+    auto withLet = makeRequest({fromjson("{$match: {$expr: {$lt: ['$a', '$$t']}}}")});
+    withLet.setLet(fromjson("{t: '$$CLUSTER_TIME'}"));
+    ASSERT_FALSE(AggregationResultCache::makeKey(withLet));
+
+    auto explain = makeRequest({fromjson("{$match: {a: 1}}")});
+    explain.setExplain(ExplainOptions::Verbosity::kQueryPlanner);
+    ASSERT_FALSE(AggregationResultCache::makeKey(explain));
+}
+
+TEST(AggregationResultCacheTest, WritesInvalidateCachedResults) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryAggregationResultCacheMaxBytes",
+                                                  1024 * 1024);
+    AggregationResultCache cache;
+    ASSERT(cache.isEnabled());
+
+    auto generation = cache.getWriteGeneration(kTestNss);
+    cache.insert("key", kTestNss, generation, makeBatch(3));
+    auto cached = cache.find("key", generation);
+    ASSERT(cached);
+    ASSERT_EQ(3U, cached->size());
+
+    cache.onWriteStarted(kTestNss);
+    cache.onWriteCommitted(nullptr, kTestNss, nullptr);
+    auto newGeneration = cache.getWriteGeneration(kTestNss);
+    ASSERT_GT(newGeneration.committed(), generation.committed());
+    ASSERT_FALSE(cache.find("key", newGeneration));
+    ASSERT_EQ(0U, cache.getSizeBytes());
+
+    cache.insert("key", kTestNss, newGeneration, makeBatch(1));
+    cache.onWriteToAll();
+    ASSERT_FALSE(cache.find("key", cache.getWriteGeneration(kTestNss)));
+}
+
+TEST(AggregationResultCacheTest, ResultsReadDuringAWriteAreNotCached) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryAggregationResultCacheMaxBytes",
+                                                  1024 * 1024);
+    AggregationResultCache cache;
+
+    // The read may or may not see the write in progress.
+    cache.onWriteStarted(kTestNss);
+    auto generation = cache.getWriteGeneration(kTestNss);
+    cache.insert("key", kTestNss, generation, makeBatch(3));
+    ASSERT_FALSE(cache.find("key", generation));
+    cache.onWriteAborted(kTestNss);
+
+    // A write that starts before the result is cached may be seen by the read as well.
+    generation = cache.getWriteGeneration(kTestNss);
+    cache.onWriteStarted(kTestNss);
+    cache.insert("key", kTestNss, generation, makeBatch(3));
+    ASSERT_FALSE(cache.find("key", generation));
+    cache.onWriteAborted(kTestNss);
+
+    generation = cache.getWriteGeneration(kTestNss);
+    cache.insert("key", kTestNss, generation, makeBatch(3));
+    ASSERT(cache.find("key", generation));
+}
+
+TEST(AggregationResultCacheTest, LeastRecentlyUsedResultsAreEvicted) {
+    const auto batchBytes = std::string("key0").size() + 10 * BSON("_id" << 0).objsize();
+    RAIIServerParameterControllerForTest maxBytes("internalQueryAggregationResultCacheMaxBytes",
+                                                  static_cast<long long>(2 * batchBytes));
+    AggregationResultCache cache;
+    const auto generation = cache.getWriteGeneration(kTestNss);
+
+    cache.insert("key0", kTestNss, generation, makeBatch(10));
+    cache.insert("key1", kTestNss, generation, makeBatch(10));
+    ASSERT_EQ(2 * batchBytes, cache.getSizeBytes());
+
+    // Using "key0" makes "key1" the least recently used result.
+    ASSERT(cache.find("key0", generation));
+    cache.insert("key2", kTestNss, generation, makeBatch(10));
+    ASSERT(cache.find("key0", generation));
+    ASSERT_FALSE(cache.find("key1", generation));
+    ASSERT(cache.find("key2", generation));
+    ASSERT_EQ(2 * batchBytes, cache.getSizeBytes());
+
+    // A result larger than the whole cache is not cached.
+    cache.insert("key3", kTestNss, generation, makeBatch(100));
+    ASSERT_FALSE(cache.find("key3", generation));
+
+    cache.clear();
+    ASSERT_EQ(0U, cache.getSizeBytes());
+}
+
+TEST(AggregationResultCacheTest, ResultsAboveTheEntryLimitAreNotCached) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryAggregationResultCacheMaxBytes",
+                                                  1024 * 1024);
+    RAIIServerParameterControllerForTest maxEntryBytes(
+        "internalQueryAggregationResultCacheMaxEntryBytes", 100);
+    AggregationResultCache cache;
+    const auto generation = cache.getWriteGeneration(kTestNss);
+
+    cache.insert("small", kTestNss, generation, makeBatch(2));
+    cache.insert("large", kTestNss, generation, makeBatch(20));
+    ASSERT(cache.find("small", generation));
+    ASSERT_FALSE(cache.find("large", generation));
+}
+
+class GroupResultMaintenanceTest : public unittest::Test {
+protected:
+    std::unique_ptr<GroupResultMaintainer> makeMaintainer(std::vector<BSONObj> pipeline) {
+        return GroupResultMaintainer::make(_opCtx.get(), makeRequest(std::move(pipeline)));
+    }
+
+    OperationContext* opCtx() {
+        return _opCtx.get();
+    }
+
+private:
+    QueryTestServiceContext _serviceContext;
+    ServiceContext::UniqueOperationContext _opCtx = _serviceContext.makeOperationContext();
+};
+
+TEST_F(GroupResultMaintenanceTest, OnlyIncrementalGroupsAreMaintained) {
+    ASSERT(makeMaintainer({fromjson("{$match: {b: {$gt: 0}}}"),
+                           fromjson("{$group: {_id: '$a', s: {$sum: '$b'}, n: {$count: {}}, "
+                                    "lo: {$min: '$b'}, hi: {$max: '$b'}}}")}));
+    ASSERT_FALSE(makeMaintainer({fromjson("{$group: {_id: '$a', s: {$avg: '$b'}}}")}));
+    ASSERT_FALSE(makeMaintainer({fromjson("{$group: {_id: {a: '$a', b: '$b'}}}")}));
+    ASSERT_FALSE(makeMaintainer(
+        {fromjson("{$group: {_id: '$a', n: {$sum: 1}}}"), fromjson("{$sort: {n: 1}}")}));
+    ASSERT_FALSE(
+        makeMaintainer({fromjson("{$project: {a: 1}}"), fromjson("{$group: {_id: '$a'}}")}));
+}
+
+TEST_F(GroupResultMaintenanceTest, InsertedDocumentsUpdateTheirGroups) {
+    auto maintainer = makeMaintainer({fromjson("{$match: {b: {$gt: 0}}}"),
+                                      fromjson("{$group: {_id: '$a', s: {$sum: '$b'}, "
+                                               "lo: {$min: '$b'}, hi: {$max: '$b'}}}")});
+    ASSERT(maintainer);
+
+    std::vector<BSONObj> result{fromjson("{_id: 1, s: 5, lo: 2, hi: 3}"),
+                                fromjson("{_id: null, s: 1, lo: 1, hi: 1}")};
+    auto updated = maintainer->apply(opCtx(),
+                                     result,
+                                     {fromjson("{a: 1, b: 10}"),
+                                      fromjson("{a: 1, b: 1}"),
+                                      fromjson("{a: 2, b: 4}"),
+                                      fromjson("{b: 6}"),
+                                      fromjson("{a: 1, b: -7}")});
+    ASSERT(updated);
+    ASSERT_EQ(3U, updated->size());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, s: 16, lo: 1, hi: 10}"), (*updated)[0]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: null, s: 7, lo: 1, hi: 6}"), (*updated)[1]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, s: 4, lo: 4, hi: 4}"), (*updated)[2]);
+
+    updated = maintainer->apply(opCtx(), *updated, {fromjson("{a: 2, b: 1}")});
+    ASSERT(updated);
+    ASSERT_EQ(3U, updated->size());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, s: 5, lo: 1, hi: 4}"), (*updated)[2]);
+}
+
+TEST_F(GroupResultMaintenanceTest, NonIntegralSumsAreNotMaintained) {
+    auto maintainer = makeMaintainer(
+        {fromjson("{$group: {_id: '$a', s: {$sum: '$b'}, n: {$count: {}}, hi: {$max: '$b'}}}")});
+    ASSERT(maintainer);
+
+    std::vector<BSONObj> result{fromjson("{_id: 1, s: 5, n: 2, hi: 3}"),
+                                fromjson("{_id: 2, s: 0.5, n: 1, hi: 0.5}")};
+    auto updated = maintainer->apply(opCtx(), result, {fromjson("{a: 1, b: 4}")});
+    ASSERT(updated);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, s: 9, n: 3, hi: 4}"), (*updated)[0]);
+
+    // Adding a double, adding to a sum which is already a double, or overflowing a sum, is left
+    // to the pipeline.
+    ASSERT_FALSE(maintainer->apply(opCtx(), result, {fromjson("{a: 1, b: 0.1}")}));
+    ASSERT_FALSE(maintainer->apply(opCtx(), result, {fromjson("{a: 2, b: 1}")}));
+    ASSERT_FALSE(maintainer->apply(opCtx(), result, {fromjson("{a: 3, b: 0.5}")}));
+    ASSERT_FALSE(maintainer->apply(
+        opCtx(), result, {BSON("a" << 1 << "b" << std::numeric_limits<long long>::max())}));
+
+    // A double only taken by $min or $max does not prevent the update.
+    auto maxOnly = makeMaintainer({fromjson("{$group: {_id: '$a', hi: {$max: '$b'}}}")});
+    updated = maxOnly->apply(opCtx(), {fromjson("{_id: 1, hi: 3}")}, {fromjson("{a: 1, b: 4.5}")});
+    ASSERT(updated);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, hi: 4.5}"), (*updated)[0]);
+}
+
+TEST_F(GroupResultMaintenanceTest, CacheUpdatesMaintainedResultsOnInsert) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryAggregationResultCacheMaxBytes",
+                                                  1024 * 1024);
+    AggregationResultCache cache;
+    const NamespaceString otherNss("test.other");
+
+    auto generation = cache.getWriteGeneration(kTestNss);
+    cache.insert("key",
+                 kTestNss,
+                 generation,
+                 {fromjson("{_id: 1, n: 1}")},
+                 makeMaintainer({fromjson("{$group: {_id: '$a', n: {$sum: 1}}}")}));
+    ASSERT(cache.isMaintainingResults());
+
+    std::vector<BSONObj> inserted{fromjson("{a: 1}"), fromjson("{a: 2}")};
+    cache.onWriteStarted(kTestNss);
+    cache.onWriteCommitted(opCtx(), kTestNss, &inserted);
+    generation = cache.getWriteGeneration(kTestNss);
+    auto cached = cache.find("key", generation);
+    ASSERT(cached);
+    ASSERT_EQ(2U, cached->size());
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 1, n: 2}"), (*cached)[0]);
+    ASSERT_BSONOBJ_EQ(fromjson("{_id: 2, n: 1}"), (*cached)[1]);
+
+    // Aborted writes and writes to other namespaces leave the result as it is.
+    cache.onWriteStarted(kTestNss);
+    cache.onWriteAborted(kTestNss);
+    cache.onWriteStarted(otherNss);
+    cache.onWriteCommitted(opCtx(), otherNss, &inserted);
+    cached = cache.find("key", cache.getWriteGeneration(kTestNss));
+    ASSERT(cached);
+    ASSERT_EQ(2U, cached->size());
+
+    // Any other write drops it.
+    cache.onWriteStarted(kTestNss);
+    cache.onWriteCommitted(opCtx(), kTestNss, nullptr);
+    ASSERT_FALSE(cache.find("key", cache.getWriteGeneration(kTestNss)));
+    ASSERT_FALSE(cache.isMaintainingResults());
+    ASSERT_EQ(0U, cache.getSizeBytes());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,252 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
+
+#include <cstring>
+#include <set>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/db/matcher/expression_path.h"
+#include "mongo/db/matcher/expression_tree.h"
+#include "mongo/db/repl/oplog_entry.h"
+
+namespace mongo {
+namespace change_stream_rewrite {
+namespace {
+
+constexpr StringData kInsertOp = "i"_sd;
+constexpr StringData kUpdateOp = "u"_sd;
+constexpr StringData kDeleteOp = "d"_sd;
+
+const StringData kFullDocumentPrefix = "fullDocument."_sd;
+
+/**
+ * Returns a predicate which matches every oplog entry that is not an insert, update or delete.
+ */
+BSONObj makeNotCrudPredicate() {
+    return BSON(repl::OplogEntry::kOpTypeFieldName
+                << BSON("$nin" << BSON_ARRAY(kInsertOp << kUpdateOp << kDeleteOp)));
+}
+
+std::string escapeForRegex(StringData str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c != '\0' && std::strchr("\\^$.|?*+()[]{}", c)) {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+/**
+ * Returns the oplog op type that produces events with the given 'operationType', or an empty
+ * string if it is not produced by a CRUD oplog entry.
+ */
+StringData opTypeForOperationType(StringData operationType) {
+    if (operationType == "insert"_sd) {
+        return kInsertOp;
+    } else if (operationType == "update"_sd || operationType == "replace"_sd) {
+        return kUpdateOp;
+    } else if (operationType == "delete"_sd) {
+        return kDeleteOp;
+    }
+    return ""_sd;
+}
+
+BSONObj rewriteOperationType(const std::vector<BSONElement>& operationTypes) {
+    std::set<StringData> excludedOps{kInsertOp, kUpdateOp, kDeleteOp};
+    for (auto&& elem : operationTypes) {
+        if (elem.type() != BSONType::String) {
+            return {};
+        }
+        excludedOps.erase(opTypeForOperationType(elem.valueStringData()));
+    }
+    if (excludedOps.empty()) {
+        return {};
+    }
+
+    BSONArrayBuilder excluded;
+    for (auto&& op : excludedOps) {
+        excluded.append(op);
+    }
+    return BSON(repl::OplogEntry::kOpTypeFieldName << BSON("$nin" << excluded.arr()));
+}
+
+/**
+ * CRUD oplog entries record the namespace as "<db>.<coll>" in their 'ns' field.
+ */
+BSONObj rewriteNamespace(StringData path, BSONElement value) {
+    BSONObj nsPredicate;
+    if (path == "ns.db"_sd && value.type() == BSONType::String) {
+        nsPredicate = BSON(repl::OplogEntry::kNssFieldName
+                           << BSON("$regex"
+                                   << "^" + escapeForRegex(value.valueStringData()) + "\\."));
+    } else if (path == "ns.coll"_sd && value.type() == BSONType::String) {
+        nsPredicate = BSON(repl::OplogEntry::kNssFieldName
+                           << BSON("$regex"
+                                   << "^[^.]*\\." + escapeForRegex(value.valueStringData()) +
+                                       "$"));
+    } else if (path == "ns"_sd && value.type() == BSONType::Object) {
+        // The event's 'ns' is exactly {db: <db>, coll: <coll>}, so anything else never matches.
+        BSONObjIterator it(value.embeddedObject());
+        BSONElement db = it.more() ? it.next() : BSONElement();
+        BSONElement coll = it.more() ? it.next() : BSONElement();
+        if (it.more() || db.fieldNameStringData() != "db"_sd || db.type() != BSONType::String ||
+            coll.fieldNameStringData() != "coll"_sd || coll.type() != BSONType::String) {
+            return {};
+        }
+        nsPredicate =
+            BSON(repl::OplogEntry::kNssFieldName << (db.String() + "." + coll.String()));
+    } else {
+        return {};
+    }
+    return BSON("$or" << BSON_ARRAY(makeNotCrudPredicate() << nsPredicate));
+}
+
+/**
+ * Inserts and deletes record the document key in 'o', and updates record it in 'o2'.
+ */
+BSONObj rewriteDocumentKeyId(BSONElement value) {
+    switch (value.type()) {
+        case BSONType::Array:
+        case BSONType::jstNULL:
+        case BSONType::Undefined:
+        case BSONType::RegEx:
+            return {};
+        default:
+            break;
+    }
+
+    const auto opType = repl::OplogEntry::kOpTypeFieldName;
+    BSONObjBuilder insertOrDelete;
+    insertOrDelete.append(opType, BSON("$in" << BSON_ARRAY(kInsertOp << kDeleteOp)));
+    insertOrDelete.appendAs(value, "o._id");
+    BSONObjBuilder update;
+    update.append(opType, kUpdateOp);
+    update.appendAs(value, "o2._id");
+    return BSON("$or" << BSON_ARRAY(makeNotCrudPredicate() << insertOrDelete.obj()
+                                                           << update.obj()));
+}
+
+/**
+ * The 'fullDocument' of an insert event is the 'o' field of its oplog entry. For all other events
+ * it may come from elsewhere, such as a post-image lookup, so they are never filtered out.
+ */
+BSONObj rewriteFullDocumentPath(const PathMatchExpression* expr) {
+    auto rewritten = expr->shallowClone();
+    static_cast<PathMatchExpression*>(rewritten.get())
+        ->setPath("o." + expr->path().substr(kFullDocumentPrefix.size()));
+    return BSON("$or" << BSON_ARRAY(BSON(repl::OplogEntry::kOpTypeFieldName
+                                         << BSON("$ne" << kInsertOp))
+                                    << rewritten->serialize()));
+}
+
+BSONObj rewritePathExpression(const PathMatchExpression* expr) {
+    const auto path = expr->path();
+    if (path.startsWith(kFullDocumentPrefix)) {
+        return rewriteFullDocumentPath(expr);
+    }
+
+    if (expr->matchType() == MatchExpression::EQ) {
+        auto value = static_cast<const EqualityMatchExpression*>(expr)->getData();
+        if (path == "operationType"_sd) {
+            return rewriteOperationType({value});
+        } else if (path == "documentKey._id"_sd) {
+            return rewriteDocumentKeyId(value);
+        }
+        return rewriteNamespace(path, value);
+    }
+
+    if (expr->matchType() == MatchExpression::MATCH_IN && path == "operationType"_sd) {
+        auto inExpr = static_cast<const InMatchExpression*>(expr);
+        if (!inExpr->getRegexes().empty()) {
+            return {};
+        }
+        return rewriteOperationType(inExpr->getEqualities());
+    }
+
+    return {};
+}
+
+}  // namespace
+
+BSONObj rewriteFilterForOplog(const MatchExpression* userFilter) {
+    switch (userFilter->matchType()) {
+        case MatchExpression::AND: {
+            // Any child which cannot be rewritten is simply left out of the conjunction.
+            BSONArrayBuilder children;
+            for (size_t i = 0; i < userFilter->numChildren(); ++i) {
+                auto child = rewriteFilterForOplog(userFilter->getChild(i));
+                if (!child.isEmpty()) {
+                    children.append(child);
+                }
+            }
+            if (children.arrSize() == 0) {
+                return {};
+            }
+            return BSON("$and" << children.arr());
+        }
+        case MatchExpression::OR: {
+            // A disjunction can only be rewritten if each of its children can.
+            BSONArrayBuilder children;
+            for (size_t i = 0; i < userFilter->numChildren(); ++i) {
+                auto child = rewriteFilterForOplog(userFilter->getChild(i));
+                if (child.isEmpty()) {
+                    return {};
+                }
+                children.append(child);
+            }
+            if (children.arrSize() == 0) {
+                return {};
+            }
+            return BSON("$or" << children.arr());
+        }
+        default:
+            break;
+    }
+
+    // Negations are not rewritten, since loosening their children would make them stricter.
+    const auto category = userFilter->getCategory();
+    if (category != MatchExpression::MatchCategory::kLeaf &&
+        category != MatchExpression::MatchCategory::kArrayMatching) {
+        return {};
+    }
+    if (auto pathExpr = dynamic_cast<const PathMatchExpression*>(userFilter)) {
+        return rewritePathExpression(pathExpr);
+    }
+    return {};
+}
+
+}  // namespace change_stream_rewrite
+}  // namespace mongo
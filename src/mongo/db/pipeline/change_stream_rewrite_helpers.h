@@ -0,0 +1,52 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+namespace change_stream_rewrite {
+
+/**
+ * Rewrites 'userFilter', a predicate on change events, into a predicate on the oplog entries that
+ * the events are generated from. Only predicates on 'operationType', 'ns', 'documentKey._id' and
+ * paths within 'fullDocument' are rewritten, and any other part of 'userFilter' is treated as
+ * matching everything. The result matches every oplog entry whose event could match 'userFilter',
+ * but it may also match entries whose events do not, so 'userFilter' must still be applied to the
+ * events themselves. Returns an empty object if no part of 'userFilter' could be rewritten.
+ *
+ * Oplog entries which are not inserts, updates or deletes, such as commands and transactions,
+ * always match the result.
+ */
+BSONObj rewriteFilterForOplog(const MatchExpression* userFilter);
+
+}  // namespace change_stream_rewrite
+}  // namespace mongo
@@ -0,0 +1,153 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/bson/json.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+class ChangeStreamRewriteTest : public AggregationContextFixture {
+protected:
+    BSONObj rewrite(const std::string& userFilter) {
+        auto expr =
+            unittest::assertGet(MatchExpressionParser::parse(fromjson(userFilter), getExpCtx()));
+        return change_stream_rewrite::rewriteFilterForOplog(expr.get());
+    }
+
+    bool matchesOplogEntry(const BSONObj& oplogFilter, const std::string& oplogEntry) {
+        auto expr = unittest::assertGet(MatchExpressionParser::parse(oplogFilter, getExpCtx()));
+        return expr->matchesBSON(fromjson(oplogEntry));
+    }
+};
+
+const std::string kInsert = "{op: 'i', ns: 'db.coll', o: {_id: 1, x: 1}}";
+const std::string kUpdate = "{op: 'u', ns: 'db.coll', o: {$v: 2, diff: {u: {x: 2}}}, o2: {_id: 1}}";
+const std::string kDelete = "{op: 'd', ns: 'db.coll', o: {_id: 1}}";
+const std::string kCommand = "{op: 'c', ns: 'db.$cmd', o: {drop: 'coll'}}";
+
+TEST_F(ChangeStreamRewriteTest, RewritesOperationTypeEquality) {
+    auto filter = rewrite("{operationType: 'insert'}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_FALSE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+
+    filter = rewrite("{operationType: 'drop'}");
+    ASSERT_FALSE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_FALSE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+}
+
+TEST_F(ChangeStreamRewriteTest, RewritesOperationTypeIn) {
+    auto filter = rewrite("{operationType: {$in: ['replace', 'delete']}}");
+    ASSERT_FALSE(matchesOplogEntry(filter, kInsert));
+    ASSERT_TRUE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_TRUE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+
+    ASSERT_BSONOBJ_EQ(rewrite("{operationType: {$in: ['insert', 'update', 'delete']}}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{operationType: {$in: ['insert', /^up/]}}"), BSONObj());
+}
+
+TEST_F(ChangeStreamRewriteTest, RewritesNamespace) {
+    auto filter = rewrite("{'ns.coll': 'coll'}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'i', ns: 'db.other', o: {_id: 1}}"));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'i', ns: 'db.coll2', o: {_id: 1}}"));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+
+    filter = rewrite("{'ns.db': 'd.b'}");
+    ASSERT_TRUE(matchesOplogEntry(filter, "{op: 'i', ns: 'd.b.coll', o: {_id: 1}}"));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'i', ns: 'dxb.coll', o: {_id: 1}}"));
+
+    filter = rewrite("{ns: {db: 'db', coll: 'coll'}}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'd', ns: 'db.other', o: {_id: 1}}"));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+}
+
+TEST_F(ChangeStreamRewriteTest, RewritesDocumentKeyId) {
+    auto filter = rewrite("{'documentKey._id': 1}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_TRUE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_TRUE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+
+    filter = rewrite("{'documentKey._id': 2}");
+    ASSERT_FALSE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_FALSE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+
+    ASSERT_BSONOBJ_EQ(rewrite("{'documentKey._id': null}"), BSONObj());
+}
+
+TEST_F(ChangeStreamRewriteTest, RewritesFullDocumentOnlyForInserts) {
+    auto filter = rewrite("{'fullDocument.x': {$gt: 0}}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'i', ns: 'db.coll', o: {_id: 2, x: 0}}"));
+    ASSERT_FALSE(matchesOplogEntry(filter, "{op: 'i', ns: 'db.coll', o: {_id: 2}}"));
+    ASSERT_TRUE(matchesOplogEntry(filter, kUpdate));
+    ASSERT_TRUE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, kCommand));
+}
+
+TEST_F(ChangeStreamRewriteTest, KeepsRewritableChildrenOfAConjunction) {
+    auto filter = rewrite("{operationType: 'insert', 'updateDescription.updatedFields.x': 1}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, kDelete));
+}
+
+TEST_F(ChangeStreamRewriteTest, RewritesDisjunctionOnlyIfEveryChildIsRewritten) {
+    auto filter = rewrite("{$or: [{operationType: 'insert'}, {'documentKey._id': 2}]}");
+    ASSERT_TRUE(matchesOplogEntry(filter, kInsert));
+    ASSERT_FALSE(matchesOplogEntry(filter, kDelete));
+    ASSERT_TRUE(matchesOplogEntry(filter, "{op: 'd', ns: 'db.coll', o: {_id: 2}}"));
+
+    ASSERT_BSONOBJ_EQ(rewrite("{$or: [{operationType: 'insert'}, {clusterTime: 1}]}"), BSONObj());
+}
+
+TEST_F(ChangeStreamRewriteTest, DoesNotRewriteNegationsOrOtherFields) {
+    ASSERT_BSONOBJ_EQ(rewrite("{operationType: {$ne: 'insert'}}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{$nor: [{operationType: 'insert'}]}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{'fullDocument.x': {$not: {$gt: 0}}}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{fullDocument: {x: 1}}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{txnNumber: 1}"), BSONObj());
+    ASSERT_BSONOBJ_EQ(rewrite("{$expr: {$eq: ['$operationType', 'insert']}}"), BSONObj());
+}
+
+}  // namespace
+}  // namespace mongo
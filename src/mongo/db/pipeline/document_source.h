@@ -498,7 +498,7 @@ public:
                           StringMap<std::string>&& renames)
             : type(type), paths(std::move(paths)), renames(std::move(renames)) {}
 
-        std::set<std::string> getNewNames() {
+        std::set<std::string> getNewNames() const {
             std::set<std::string> newNames;
             for (auto&& name : paths) {
                 newNames.insert(name);
@@ -36,6 +36,7 @@
 #include "mongo/db/commands/feature_compatibility_version_documentation.h"
 #include "mongo/db/pipeline/aggregate_command_gen.h"
 #include "mongo/db/pipeline/change_stream_constants.h"
+#include "mongo/db/pipeline/change_stream_rewrite_helpers.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_change_stream_close_cursor.h"
 #include "mongo/db/pipeline/document_source_change_stream_transform.h"
@@ -131,6 +132,47 @@ StageConstraints DocumentSourceOplogMatch::constraints(Pipeline::SplitState pipe
     return constraints;
 }
 
+Pipeline::SourceContainer::iterator DocumentSourceOplogMatch::doOptimizeAt(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    invariant(*itr == this);
+
+    // The oplog is always matched with the simple collation, so predicates which the user expects
+    // to be evaluated with another collation cannot be pushed down. On mongoS this stage is never
+    // executed at all.
+    if (_pushedDownUserFilter || pExpCtx->inMongos || pExpCtx->getCollator() ||
+        pExpCtx->initialPostBatchResumeToken.isEmpty()) {
+        return std::next(itr);
+    }
+    _pushedDownUserFilter = true;
+
+    // Every event that this pipeline returns has passed through the $match stages which are
+    // interleaved with, or directly follow, the change stream stages.
+    BSONArrayBuilder userFilters;
+    for (auto stageItr = std::next(itr); stageItr != container->end(); ++stageItr) {
+        if (auto match = dynamic_cast<DocumentSourceMatch*>(stageItr->get())) {
+            auto rewritten =
+                change_stream_rewrite::rewriteFilterForOplog(match->getMatchExpression());
+            if (!rewritten.isEmpty()) {
+                userFilters.append(rewritten);
+            }
+        } else if (!(*stageItr)->constraints().isChangeStreamStage()) {
+            break;
+        }
+    }
+    if (userFilters.arrSize() == 0) {
+        return std::next(itr);
+    }
+
+    // The entry at the resume point must still reach the stage which checks that the stream
+    // resumed from the right event, even if the resumed pipeline would filter it out.
+    const auto resumeTs =
+        ResumeToken::parse(pExpCtx->initialPostBatchResumeToken).getData().clusterTime;
+    auto resumePoint = BSON(repl::OplogEntry::kTimestampFieldName << resumeTs);
+    auto userFilter = BSON("$or" << BSON_ARRAY(resumePoint << BSON("$and" << userFilters.arr())));
+    rebuild(BSON("$and" << BSON_ARRAY(getQuery() << userFilter)));
+    return std::next(itr);
+}
+
 /**
  * Only serialize this stage for explain purposes, otherwise keep it hidden so that we can
  * properly alias.
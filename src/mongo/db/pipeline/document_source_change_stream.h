@@ -238,11 +238,14 @@ public:
 
 /**
  * A custom subclass of DocumentSourceMatch which does not serialize itself (since it came from an
- * alias) and requires itself to be the first stage in the pipeline.
+ * alias) and requires itself to be the first stage in the pipeline. During optimization it also
+ * absorbs an oplog-format rewrite of the user's $match stages which follow the change stream
+ * stages, so that oplog entries whose events cannot match are never transformed.
  */
 class DocumentSourceOplogMatch final : public DocumentSourceMatch {
 public:
-    DocumentSourceOplogMatch(const DocumentSourceOplogMatch& other) : DocumentSourceMatch(other) {}
+    DocumentSourceOplogMatch(const DocumentSourceOplogMatch& other)
+        : DocumentSourceMatch(other), _pushedDownUserFilter(other._pushedDownUserFilter) {}
 
     virtual boost::intrusive_ptr<DocumentSourceMatch> clone() const {
         return make_intrusive<std::decay_t<decltype(*this)>>(*this);
@@ -265,8 +268,18 @@ public:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain) const final;
 
+    /**
+     * Rewrites the user's $match stages which follow the change stream stages into predicates on
+     * the oplog, and adds them to this stage's filter. The $match stages themselves are kept.
+     */
+    Pipeline::SourceContainer::iterator doOptimizeAt(Pipeline::SourceContainer::iterator itr,
+                                                     Pipeline::SourceContainer* container) final;
+
 private:
     using DocumentSourceMatch::DocumentSourceMatch;
+
+    // Whether the user's $match stages have already been rewritten into this stage's filter.
+    bool _pushedDownUserFilter = false;
 };
 
 /**
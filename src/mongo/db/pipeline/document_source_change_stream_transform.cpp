@@ -182,6 +182,11 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     checkValueType(ns, repl::OplogEntry::kNssFieldName, BSONType::String);
     Value uuid = input[repl::OplogEntry::kUuidFieldName];
     Value preImageOpTime = input[repl::OplogEntry::kPreImageOpTimeFieldName];
+    if (input[repl::OplogEntry::kPreImageRecordedFieldName].coerceToBool()) {
+        // The pre-image was recorded in the pre-images collection rather than in the oplog, under
+        // an _id made up of the collection UUID and the timestamp of this entry.
+        preImageOpTime = Value(Document{{"nsUUID", uuid}, {"ts", ts}});
+    }
     std::vector<FieldPath> documentKeyFields;
 
     // Deal with CRUD operations and commands.
@@ -363,8 +368,9 @@ Document DocumentSourceChangeStreamTransform::applyTransformation(const Document
     // Add the post-image, pre-image, namespace, documentKey and other fields as appropriate.
     doc.addField(DocumentSourceChangeStream::kFullDocumentField, fullDocument);
     if (_includePreImageOptime) {
-        // Set 'kFullDocumentBeforeChangeField' to the pre-image optime. The DSCSLookupPreImage
-        // stage will replace this optime with the actual pre-image taken from the oplog.
+        // Set 'kFullDocumentBeforeChangeField' to the pre-image optime, or to the _id of the
+        // pre-image in the pre-images collection. The DSCSLookupPreImage stage will replace this
+        // with the actual pre-image.
         doc.addField(DocumentSourceChangeStream::kFullDocumentBeforeChangeField, preImageOpTime);
     }
     doc.addField(DocumentSourceChangeStream::kNamespaceField,
@@ -414,6 +420,7 @@ DepsTracker::State DocumentSourceChangeStreamTransform::getDependencies(DepsTrac
 
     if (_includePreImageOptime) {
         deps->fields.insert(repl::OplogEntry::kPreImageOpTimeFieldName.toString());
+        deps->fields.insert(repl::OplogEntry::kPreImageRecordedFieldName.toString());
     }
     return DepsTracker::State::EXHAUSTIVE_ALL;
 }
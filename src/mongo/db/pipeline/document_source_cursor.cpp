@@ -39,6 +39,7 @@
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/find_common.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/resharding/resume_token_gen.h"
@@ -70,8 +71,7 @@ bool DocumentSourceCursor::Batch::isEmpty() const {
 void DocumentSourceCursor::Batch::enqueue(Document&& doc) {
     switch (_type) {
         case CursorType::kRegular: {
-            invariant(doc.isOwned());
-            _batchOfDocs.push_back(std::move(doc));
+            _batchOfDocs.push_back(doc.isOwned() ? std::move(doc) : _copyToSharedBuffer(doc));
             _memUsageBytes += _batchOfDocs.back().getApproximateSize();
             break;
         }
@@ -82,6 +82,32 @@ void DocumentSourceCursor::Batch::enqueue(Document&& doc) {
     }
 }
 
+Document DocumentSourceCursor::Batch::_copyToSharedBuffer(const Document& doc) {
+    // A document at least half the size of a buffer would mostly waste the rest of it.
+    auto bson = doc.toBsonIfTriviallyConvertible();
+    if (!bson || static_cast<size_t>(bson->objsize()) * 2 > _sharedBufferBytes) {
+        return doc.getOwned();
+    }
+
+    const size_t size = bson->objsize();
+    if (!_sharedBuffer || _sharedBufferUsed + size > _sharedBuffer.capacity()) {
+        _sharedBuffer = SharedBuffer::allocate(_sharedBufferBytes);
+        _sharedBufferUsed = 0;
+    }
+    char* data = _sharedBuffer.get() + _sharedBufferUsed;
+    std::memcpy(data, bson->objdata(), size);
+    _sharedBufferUsed += size;
+
+    // The fields are still read lazily from the copied BSON, as the pipeline asks for them.
+    Document copy{BSONObj(data).shareOwnershipWith(_sharedBuffer)};
+    if (!doc.metadata()) {
+        return copy;
+    }
+    MutableDocument md(std::move(copy));
+    md.setMetadata(DocumentMetadataFields(doc.metadata()));
+    return md.freeze();
+}
+
 Document DocumentSourceCursor::Batch::dequeue() {
     invariant(!isEmpty());
     switch (_type) {
@@ -103,6 +129,8 @@ Document DocumentSourceCursor::Batch::dequeue() {
 
 void DocumentSourceCursor::Batch::clear() {
     _batchOfDocs.clear();
+    _sharedBuffer = {};
+    _sharedBufferUsed = 0;
     _count = 0;
     _memUsageBytes = 0;
 }
@@ -303,7 +331,7 @@ DocumentSourceCursor::DocumentSourceCursor(
     CursorType cursorType,
     bool trackOplogTimestamp)
     : DocumentSource(kStageName, pCtx),
-      _currentBatch(cursorType),
+      _currentBatch(cursorType, internalDocumentSourceCursorSharedBufferBytes.load()),
       _exec(std::move(exec)),
       _trackOplogTS(trackOplogTimestamp) {
     // It is illegal for both 'kEmptyDocuments' and 'trackOplogTimestamp' to be set.
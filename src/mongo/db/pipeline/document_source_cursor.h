@@ -37,6 +37,7 @@
 #include "mongo/db/query/explain_options.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/util/shared_buffer.h"
 
 namespace mongo {
 
@@ -160,10 +161,17 @@ private:
      */
     class Batch {
     public:
-        Batch(CursorType type) : _type(type) {}
+        /**
+         * If 'sharedBufferBytes' is not zero, documents which are not owned are copied into shared
+         * buffers of that size, which are filled one after the other.
+         */
+        Batch(CursorType type, size_t sharedBufferBytes)
+            : _type(type), _sharedBufferBytes(sharedBufferBytes) {}
 
         /**
-         * Adds a new document to the batch.
+         * Adds a new document to the batch. A document which is not owned, such as one pointing
+         * into a storage engine cursor, is copied first, since it is only valid until the
+         * PlanExecutor is advanced again.
          */
         void enqueue(Document&& doc);
 
@@ -194,10 +202,25 @@ private:
         }
 
     private:
+        /**
+         * Returns an owned copy of 'doc' whose BSON lives in '_sharedBuffer', starting a new buffer
+         * if the current one is full. Documents which are modified, or too large to share a buffer
+         * with others, are copied on their own instead.
+         */
+        Document _copyToSharedBuffer(const Document& doc);
+
         // If 'kEmptyDocuments', then dependency analysis has indicated that all we need to execute
         // the query is a count of the incoming documents.
         const CursorType _type;
 
+        // The size of the shared buffers, or zero if they are not used.
+        const size_t _sharedBufferBytes;
+
+        // The buffer which the next unowned document is copied into, and how much of it is used.
+        // The buffer outlives the batch for as long as any document copied into it is in use.
+        SharedBuffer _sharedBuffer;
+        size_t _sharedBufferUsed = 0;
+
         // Used only if '_type' is 'kRegular'. A deque of the documents comprising the batch.
         std::deque<Document> _batchOfDocs;
 
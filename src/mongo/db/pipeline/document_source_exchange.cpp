@@ -147,6 +147,32 @@ Exchange::Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter>
     _pipeline->detachFromOperationContext();
 }
 
+ExchangeSpec Exchange::makeHashedKeyRangeSpec(StringData field, size_t nConsumers) {
+    invariant(nConsumers > 0);
+
+    std::vector<BSONObj> boundaries;
+    std::vector<int> consumerIds;
+    const uint64_t rangeWidth = std::numeric_limits<uint64_t>::max() / nConsumers + 1;
+    boundaries.emplace_back(BSON(field << MINKEY));
+    for (size_t idx = 1; idx < nConsumers; ++idx) {
+        const auto split =
+            static_cast<uint64_t>(std::numeric_limits<long long>::min()) + rangeWidth * idx;
+        boundaries.emplace_back(BSON(field << static_cast<long long>(split)));
+    }
+    boundaries.emplace_back(BSON(field << MAXKEY));
+    for (size_t idx = 0; idx < nConsumers; ++idx) {
+        consumerIds.emplace_back(static_cast<int>(idx));
+    }
+
+    ExchangeSpec spec;
+    spec.setPolicy(ExchangePolicyEnum::kKeyRange);
+    spec.setKey(BSON(field << "hashed"));
+    spec.setBoundaries(std::move(boundaries));
+    spec.setConsumers(nConsumers);
+    spec.setConsumerIds(std::move(consumerIds));
+    return spec;
+}
+
 std::vector<std::string> Exchange::extractBoundaries(
     const boost::optional<std::vector<BSONObj>>& obj, Ordering ordering) {
     std::vector<std::string> ret;
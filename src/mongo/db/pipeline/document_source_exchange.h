@@ -77,6 +77,12 @@ public:
      **/
     Exchange(ExchangeSpec spec, std::unique_ptr<Pipeline, PipelineDeleter> pipeline);
 
+    /**
+     * Create the spec of a keyRange exchange on {<field>: "hashed"}, which divides the range of
+     * 64-bit hashes evenly between 'nConsumers' consumers.
+     */
+    static ExchangeSpec makeHashedKeyRangeSpec(StringData field, size_t nConsumers);
+
     /**
      * Interface for retrieving the next document. 'resourceYielder' is optional, and if provided,
      * will be used to give up resources while waiting for other threads to empty their buffers.
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_facet.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -38,14 +39,22 @@
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/db/client.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/operation_context.h"
 #include "mongo/db/pipeline/document_source_tee_consumer.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/pipeline/tee_buffer.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -66,7 +75,7 @@ DocumentSourceFacet::DocumentSourceFacet(std::vector<FacetPipeline> facetPipelin
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
         auto& facet = _facets[facetId];
         facet.pipeline->addInitialSource(
-            DocumentSourceTeeConsumer::create(pExpCtx, facetId, _teeBuffer));
+            DocumentSourceTeeConsumer::create(facet.pipeline->getContext(), facetId, _teeBuffer));
     }
 }
 
@@ -107,6 +116,189 @@ vector<pair<string, vector<BSONObj>>> extractRawPipelines(const BSONElement& ele
     return rawFacetPipelines;
 }
 
+/**
+ * Returns a copy of 'expCtx' for one pipeline of a $facet stage, so that the pipelines do not share
+ * the variables they set while evaluating expressions and may run on threads of their own.
+ */
+intrusive_ptr<ExpressionContext> copyExpCtxForFacet(const intrusive_ptr<ExpressionContext>& expCtx) {
+    auto facetExpCtx = expCtx->copyWith(expCtx->ns, expCtx->uuid);
+    facetExpCtx->isParsingViewDefinition = expCtx->isParsingViewDefinition;
+    facetExpCtx->isParsingCollectionValidator = expCtx->isParsingCollectionValidator;
+    return facetExpCtx;
+}
+
+/**
+ * Runs the pipelines of a $facet stage on several threads. The operation's thread loads each batch
+ * of input into the TeeBuffer, then waits while the worker threads run the pipelines over the
+ * batch, until every pipeline is exhausted. Each worker runs a fixed share of the pipelines, which
+ * are attached to an operation of the worker's own while it runs them.
+ */
+class ParallelFacetRunner {
+public:
+    ParallelFacetRunner(std::vector<DocumentSourceFacet::FacetPipeline>* facets,
+                        TeeBuffer* teeBuffer,
+                        const std::function<void(size_t, Document)>& onResult)
+        : _facets(facets),
+          _teeBuffer(teeBuffer),
+          _onResult(onResult),
+          _facetEOF(std::make_unique<bool[]>(facets->size())) {}
+
+    void run(OperationContext* opCtx, size_t numThreads) {
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _finished = true;
+            }
+            _roundStarted.notify_all();
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+
+        try {
+            for (size_t workerId = 0; workerId < numThreads; ++workerId) {
+                threads.emplace_back(
+                    [this, opCtx, workerId, numThreads] { _runWorker(opCtx, workerId, numThreads); });
+            }
+        } catch (const std::exception& ex) {
+            _recordFailure({ErrorCodes::InternalError,
+                            str::stream() << "Failed to start a $facet thread: " << ex.what()});
+            throw;
+        }
+
+        while (_numFacetsEOF.load() < _facets->size()) {
+            _teeBuffer->loadNextBatchForConsumers();
+
+            Status firstError = Status::OK();
+            try {
+                stdx::unique_lock<Latch> lk(_mutex);
+                ++_round;
+                _numWorkersDone = 0;
+                _roundStarted.notify_all();
+                opCtx->waitForConditionOrInterrupt(_roundFinished, lk, [&] {
+                    return _numWorkersDone == threads.size() || !_firstError.isOK();
+                });
+                firstError = _firstError;
+            } catch (const DBException& ex) {
+                _recordFailure(ex.toStatus());
+                throw;
+            }
+            uassertStatusOK(firstError);
+        }
+    }
+
+private:
+    void _runWorker(OperationContext* opCtx, size_t workerId, size_t numThreads) {
+        const std::string threadName = str::stream() << "facet-" << workerId;
+        ThreadClient tc(threadName, opCtx->getServiceContext());
+        auto workerOpCtx = cc().makeOperationContext();
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _workerOpCtxs.push_back(workerOpCtx.get());
+        }
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _workerOpCtxs.erase(
+                std::find(_workerOpCtxs.begin(), _workerOpCtxs.end(), workerOpCtx.get()));
+        });
+
+        std::vector<size_t> facetIds;
+        for (size_t facetId = workerId; facetId < _facets->size(); facetId += numThreads) {
+            auto& pipeline = (*_facets)[facetId].pipeline;
+            pipeline->detachFromOperationContext();
+            pipeline->reattachToOperationContext(workerOpCtx.get());
+            facetIds.push_back(facetId);
+        }
+        ON_BLOCK_EXIT([&] {
+            for (auto facetId : facetIds) {
+                auto& pipeline = (*_facets)[facetId].pipeline;
+                pipeline->detachFromOperationContext();
+                pipeline->reattachToOperationContext(opCtx);
+            }
+        });
+
+        try {
+            size_t round = 0;
+            while (true) {
+                {
+                    stdx::unique_lock<Latch> lk(_mutex);
+                    workerOpCtx->waitForConditionOrInterrupt(
+                        _roundStarted, lk, [&] { return _finished || _round > round; });
+                    if (_finished) {
+                        return;
+                    }
+                    round = _round;
+                }
+
+                for (auto facetId : facetIds) {
+                    _runFacetOverBatch(facetId);
+                }
+
+                {
+                    stdx::lock_guard<Latch> lk(_mutex);
+                    ++_numWorkersDone;
+                }
+                _roundFinished.notify_all();
+            }
+        } catch (const DBException& ex) {
+            _recordFailure(ex.toStatus());
+        }
+    }
+
+    /**
+     * Runs the pipeline 'facetId' until it has consumed the current batch of the TeeBuffer.
+     */
+    void _runFacetOverBatch(size_t facetId) {
+        if (_facetEOF[facetId]) {
+            return;
+        }
+
+        auto& pipeline = (*_facets)[facetId].pipeline;
+        auto next = pipeline->getSources().back()->getNext();
+        for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
+            _onResult(facetId, next.releaseDocument());
+        }
+        if (next.isEOF()) {
+            _facetEOF[facetId] = true;
+            _numFacetsEOF.fetchAndAdd(1);
+        }
+    }
+
+    /**
+     * Records the first error hit while running the pipelines and interrupts the workers.
+     */
+    void _recordFailure(Status status) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_firstError.isOK()) {
+            _firstError = std::move(status);
+        }
+
+        for (auto workerOpCtx : _workerOpCtxs) {
+            stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+            workerOpCtx->getServiceContext()->killOperation(clientLock, workerOpCtx);
+        }
+        _roundFinished.notify_all();
+    }
+
+    std::vector<DocumentSourceFacet::FacetPipeline>* const _facets;
+    TeeBuffer* const _teeBuffer;
+    const std::function<void(size_t, Document)>& _onResult;
+
+    // Whether each pipeline is exhausted. Each is only read and written by the worker running it.
+    std::unique_ptr<bool[]> _facetEOF;
+    AtomicWord<size_t> _numFacetsEOF{0};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("ParallelFacetRunner::_mutex");
+    stdx::condition_variable _roundStarted;
+    stdx::condition_variable _roundFinished;
+    size_t _round = 0;
+    size_t _numWorkersDone = 0;
+    bool _finished = false;
+    std::vector<OperationContext*> _workerOpCtxs;
+    Status _firstError = Status::OK();
+};
+
 }  // namespace
 
 std::unique_ptr<DocumentSourceFacet::LiteParsed> DocumentSourceFacet::LiteParsed::parse(
@@ -146,21 +338,26 @@ void DocumentSourceFacet::doDispose() {
     }
 }
 
-DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
-    if (_done) {
-        return GetNextResult::makeEOF();
+bool DocumentSourceFacet::_canRunFacetsInParallel() const {
+    if (_facets.size() < 2 ||
+        std::any_of(_facets.begin(), _facets.end(), [&](const FacetPipeline& facet) {
+            return facet.pipeline->getContext() == pExpCtx;
+        })) {
+        return false;
     }
 
-    const size_t maxBytes = _maxOutputDocSizeBytes;
-    auto ensureUnderMemoryLimit = [usedBytes = 0ul, &maxBytes](long long additional) mutable {
-        usedBytes += additional;
-        uassert(4031700,
-                str::stream() << "document constructed by $facet is " << usedBytes
-                              << " bytes, which exceeds the limit of " << maxBytes << " bytes",
-                usedBytes <= maxBytes);
-    };
+    stdx::unordered_set<NamespaceString> involvedNamespaces;
+    addInvolvedCollections(&involvedNamespaces);
+    return involvedNamespaces.empty();
+}
+
+void DocumentSourceFacet::_runFacets(size_t numThreads,
+                                     const std::function<void(size_t, Document)>& onResult) {
+    if (numThreads > 1) {
+        ParallelFacetRunner(&_facets, _teeBuffer.get(), onResult).run(pExpCtx->opCtx, numThreads);
+        return;
+    }
 
-    vector<vector<Value>> results(_facets.size());
     bool allPipelinesEOF = false;
     while (!allPipelinesEOF) {
         allPipelinesEOF = true;  // Set this to false if any pipeline isn't EOF.
@@ -168,12 +365,41 @@ DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
             const auto& pipeline = _facets[facetId].pipeline;
             auto next = pipeline->getSources().back()->getNext();
             for (; next.isAdvanced(); next = pipeline->getSources().back()->getNext()) {
-                ensureUnderMemoryLimit(next.getDocument().getApproximateSize());
-                results[facetId].emplace_back(next.releaseDocument());
+                onResult(facetId, next.releaseDocument());
             }
             allPipelinesEOF = allPipelinesEOF && next.isEOF();
         }
     }
+}
+
+DocumentSource::GetNextResult DocumentSourceFacet::doGetNext() {
+    if (_done) {
+        return GetNextResult::makeEOF();
+    }
+
+    // Pipelines with an ExpressionContext of their own see the variables as they are now.
+    for (auto&& facet : _facets) {
+        if (facet.pipeline->getContext() != pExpCtx) {
+            facet.pipeline->getContext()->variables = pExpCtx->variables;
+        }
+    }
+
+    const size_t maxBytes = _maxOutputDocSizeBytes;
+    AtomicWord<unsigned long long> usedBytes{0};
+    vector<vector<Value>> results(_facets.size());
+    auto onResult = [&](size_t facetId, Document doc) {
+        const auto totalBytes = usedBytes.addAndFetch(doc.getApproximateSize());
+        uassert(4031700,
+                str::stream() << "document constructed by $facet is " << totalBytes
+                              << " bytes, which exceeds the limit of " << maxBytes << " bytes",
+                totalBytes <= maxBytes);
+        results[facetId].emplace_back(std::move(doc));
+    };
+
+    const size_t numThreads = _canRunFacetsInParallel()
+        ? std::min(_facets.size(), static_cast<size_t>(internalQueryFacetMaxParallelism.load()))
+        : 1;
+    _runFacets(numThreads, onResult);
 
     MutableDocument resultDoc;
     for (size_t facetId = 0; facetId < _facets.size(); ++facetId) {
@@ -305,11 +531,15 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
     boost::optional<std::string> needsMongoS;
     boost::optional<std::string> needsShard;
 
+    // Pipelines which may run on threads of their own each get an ExpressionContext of their own.
+    const bool copyExpCtxPerFacet = internalQueryFacetMaxParallelism.load() > 1;
+
     std::vector<FacetPipeline> facetPipelines;
     for (auto&& rawFacet : extractRawPipelines(elem)) {
         const auto facetName = rawFacet.first;
 
-        auto pipeline = Pipeline::parse(rawFacet.second, expCtx, [](const Pipeline& pipeline) {
+        auto facetExpCtx = copyExpCtxPerFacet ? copyExpCtxForFacet(expCtx) : expCtx;
+        auto pipeline = Pipeline::parse(rawFacet.second, facetExpCtx, [](const Pipeline& pipeline) {
             auto sources = pipeline.getSources();
             std::for_each(sources.begin(), sources.end(), [](auto& stage) {
                 auto stageConstraints = stage->constraints();
@@ -339,6 +569,14 @@ intrusive_ptr<DocumentSource> DocumentSourceFacet::createFromBson(
                               << "' requires a shard",
                 !(needsShard && needsMongoS));
 
+        if (facetExpCtx != expCtx) {
+            expCtx->sbeCompatible = expCtx->sbeCompatible && facetExpCtx->sbeCompatible;
+            expCtx->exprUnstableForApiV1 =
+                expCtx->exprUnstableForApiV1 || facetExpCtx->exprUnstableForApiV1;
+            expCtx->exprDeprectedForApiV1 =
+                expCtx->exprDeprectedForApiV1 || facetExpCtx->exprDeprectedForApiV1;
+        }
+
         facetPipelines.emplace_back(facetName, std::move(pipeline));
     }
 
@@ -31,6 +31,7 @@
 
 #include <boost/intrusive_ptr.hpp>
 #include <boost/optional.hpp>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -157,6 +158,19 @@ private:
 
     Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
 
+    /**
+     * Returns whether the pipelines may run on threads of their own. They must each have an
+     * ExpressionContext of their own, and read no collection but the input of this stage.
+     */
+    bool _canRunFacetsInParallel() const;
+
+    /**
+     * Runs each pipeline until it is exhausted, calling 'onResult' with the id of the pipeline and
+     * each of its results. Several pipelines run at once when 'numThreads' is greater than 1, in
+     * which case 'onResult' is called from several threads, but never concurrently for one pipeline.
+     */
+    void _runFacets(size_t numThreads, const std::function<void(size_t, Document)>& onResult);
+
     boost::intrusive_ptr<TeeBuffer> _teeBuffer;
     std::vector<FacetPipeline> _facets;
 
@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/document_source_graph_lookup.h"
 
+#include <boost/filesystem/operations.hpp>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -45,6 +46,8 @@
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_common.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/util/destructor_guard.h"
 
 namespace mongo {
 
@@ -53,6 +56,16 @@ bool foreignShardedLookupAllowed() {
     return getTestCommandsEnabled() && internalQueryAllowShardedLookup.load();
 }
 
+/**
+ * Generates a new file name on each call using a static, atomic and monotonically increasing
+ * number. See the comment on nextFileName() in document_source_group.cpp.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> documentSourceGraphLookUpFileCounter;
+    return "extsort-doc-graphlookup." +
+        std::to_string(documentSourceGraphLookUpFileCounter.fetchAndAdd(1));
+}
+
 // Parses $graphLookup 'from' field. The 'from' field must be a string with the exception of
 // 'local.system.tenantMigration.oplogView'.
 //
@@ -134,11 +147,9 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::doGetNext() {
     performSearch();
 
     std::vector<Value> results;
-    while (!_visited.empty()) {
+    while (hasResultsLeft()) {
         // Remove elements one at a time to avoid consuming more memory.
-        auto it = _visited.begin();
-        results.push_back(Value(it->second));
-        _visited.erase(it);
+        results.push_back(Value(popResult()));
     }
 
     MutableDocument output(*_input);
@@ -157,7 +168,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
     // If the unwind is not preserving empty arrays, we might have to process multiple inputs before
     // we get one that will produce an output.
     while (true) {
-        if (_visited.empty()) {
+        if (!hasResultsLeft()) {
             // No results are left for the current input, so we should move on to the next one and
             // perform a new search.
 
@@ -173,7 +184,7 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
         }
         MutableDocument unwound(*_input);
 
-        if (_visited.empty()) {
+        if (!hasResultsLeft()) {
             if ((*_unwind)->preserveNullAndEmptyArrays()) {
                 // Since "preserveNullAndEmptyArrays" was specified, output a document even though
                 // we had no result.
@@ -187,13 +198,11 @@ DocumentSource::GetNextResult DocumentSourceGraphLookUp::getNextUnwound() {
                 continue;
             }
         } else {
-            auto it = _visited.begin();
-            unwound.setNestedField(_as, Value(it->second));
+            unwound.setNestedField(_as, Value(popResult()));
             if (indexPath) {
                 unwound.setNestedField(*indexPath, Value(_outputIndex));
                 ++_outputIndex;
             }
-            _visited.erase(it);
         }
 
         return unwound.freeze();
@@ -204,6 +213,7 @@ void DocumentSourceGraphLookUp::doDispose() {
     _cache.clear();
     _frontier.clear();
     _visited.clear();
+    clearSpilledResults();
 }
 
 void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
@@ -219,7 +229,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 
         // Check whether each key in the frontier exists in the cache or needs to be queried.
         auto cached = pExpCtx->getDocumentComparator().makeUnorderedDocumentSet();
-        auto matchStage = makeMatchStageFromFrontier(&cached);
+        auto matchStages = makeMatchStagesFromFrontier(&cached);
 
         ValueUnorderedSet queried = pExpCtx->getValueComparator().makeUnorderedValueSet();
         _frontier.swap(queried);
@@ -234,12 +244,12 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
             checkMemoryUsage();
         }
 
-        if (matchStage) {
+        for (auto&& matchStage : matchStages) {
             // Query for all keys that were in the frontier and not in the cache, populating
             // '_frontier' for the next iteration of search.
 
             // We've already allocated space for the trailing $match stage in '_fromPipeline'.
-            _fromPipeline.back() = *matchStage;
+            _fromPipeline.back() = matchStage;
             MakePipelineOptions pipelineOpts;
             pipelineOpts.optimize = true;
             pipelineOpts.attachCursorSource = true;
@@ -272,7 +282,7 @@ void DocumentSourceGraphLookUp::doBreadthFirstSearch() {
 bool DocumentSourceGraphLookUp::addToVisitedAndFrontier(Document result, long long depth) {
     auto id = result.getField("_id");
 
-    if (_visited.find(id) != _visited.end()) {
+    if (_visited.find(id) != _visited.end() || _spilledIds.find(id) != _spilledIds.end()) {
         // We've already seen this object, don't repeat any work.
         return false;
     }
@@ -319,7 +329,7 @@ void DocumentSourceGraphLookUp::addToCache(const Document& result,
         });
 }
 
-boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
+std::vector<BSONObj> DocumentSourceGraphLookUp::makeMatchStagesFromFrontier(
     DocumentUnorderedSet* cached) {
     // Add any cached values to 'cached' and remove them from '_frontier'.
     for (auto it = _frontier.begin(); it != _frontier.end();) {
@@ -337,40 +347,48 @@ boost::optional<BSONObj> DocumentSourceGraphLookUp::makeMatchStageFromFrontier(
         }
     }
 
-    // Create a query of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}.
+    // Create queries of the form {$and: [_additionalFilter, {_connectToField: {$in: [...]}}]}, each
+    // with a bounded number of values, so that no query grows past the maximum BSON size however
+    // wide the frontier is.
     //
-    // We wrap the query in a $match so that it can be parsed into a DocumentSourceMatch when
+    // We wrap each query in a $match so that it can be parsed into a DocumentSourceMatch when
     // constructing a pipeline to execute.
-    BSONObjBuilder match;
-    {
-        BSONObjBuilder query(match.subobjStart("$match"));
+    const size_t batchSize = internalDocumentSourceGraphLookupFrontierBatchSize.load();
+    std::vector<BSONObj> matchStages;
+    for (auto it = _frontier.begin(); it != _frontier.end();) {
+        BSONObjBuilder match;
         {
-            BSONArrayBuilder andObj(query.subarrayStart("$and"));
-            if (_additionalFilter) {
-                andObj << *_additionalFilter;
-            }
-
+            BSONObjBuilder query(match.subobjStart("$match"));
             {
-                BSONObjBuilder connectToObj(andObj.subobjStart());
+                BSONArrayBuilder andObj(query.subarrayStart("$and"));
+                if (_additionalFilter) {
+                    andObj << *_additionalFilter;
+                }
+
                 {
-                    BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                    BSONObjBuilder connectToObj(andObj.subobjStart());
                     {
-                        BSONArrayBuilder in(subObj.subarrayStart("$in"));
-                        for (auto&& value : _frontier) {
-                            in << value;
+                        BSONObjBuilder subObj(connectToObj.subobjStart(_connectToField.fullPath()));
+                        {
+                            BSONArrayBuilder in(subObj.subarrayStart("$in"));
+                            for (size_t n = 0; n < batchSize && it != _frontier.end(); ++n, ++it) {
+                                in << *it;
+                            }
                         }
                     }
                 }
             }
         }
+        matchStages.push_back(match.obj());
     }
 
-    return _frontier.empty() ? boost::none : boost::optional<BSONObj>(match.obj());
+    return matchStages;
 }
 
 void DocumentSourceGraphLookUp::performSearch() {
     // Make sure _input is set before calling performSearch().
     invariant(_input);
+    clearSpilledResults();
 
     Value startingValue = _startWith->evaluate(*_input, &pExpCtx->variables);
 
@@ -431,13 +449,80 @@ Pipeline::SourceContainer::iterator DocumentSourceGraphLookUp::doOptimizeAt(
 }
 
 void DocumentSourceGraphLookUp::checkMemoryUsage() {
-    // TODO SERVER-23980: Implement spilling to disk if allowDiskUse is specified.
+    if ((_visitedUsageBytes + _frontierUsageBytes) >= _maxMemoryUsageBytes &&
+        pExpCtx->allowDiskUse && !pExpCtx->inMongos) {
+        spillVisited();
+    }
+
     uassert(40099,
             "$graphLookup reached maximum memory consumption",
             (_visitedUsageBytes + _frontierUsageBytes) < _maxMemoryUsageBytes);
     _cache.evictDownTo(_maxMemoryUsageBytes - _frontierUsageBytes - _visitedUsageBytes);
 }
 
+void DocumentSourceGraphLookUp::spillVisited() {
+    if (_visited.empty()) {
+        return;
+    }
+
+    if (_spillFileName.empty()) {
+        _spillFileName = pExpCtx->tempDir + "/" + nextFileName();
+    }
+
+    // The documents are only ever read back in the order they were written, so they need no
+    // sorting.
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(pExpCtx->tempDir), _spillFileName, _nextSpillFileOffset);
+    const auto numSpilled = _visited.size();
+    while (!_visited.empty()) {
+        auto it = _visited.begin();
+        writer.addAlreadySorted(it->first, it->second);
+        _spilledIds.insert(it->first);
+        _visited.erase(it);
+    }
+    _spilledResults.emplace_back(writer.done());
+    _nextSpillFileOffset = writer.getFileEndOffset();
+    _usedDisk = true;
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(pExpCtx->opCtx);
+    metricsCollector.incrementKeysSorted(numSpilled);
+    metricsCollector.incrementSorterSpills(1);
+
+    // Only the '_id's of the documents discovered so far are left in memory.
+    _visitedUsageBytes = 0;
+    for (auto&& id : _spilledIds) {
+        _visitedUsageBytes += id.getApproximateSize();
+    }
+}
+
+void DocumentSourceGraphLookUp::clearSpilledResults() {
+    _spilledResults.clear();
+    _spilledIds.clear();
+    if (_nextSpillFileOffset != 0) {
+        // Nothing refers to the spilled documents anymore, so start the file over.
+        boost::filesystem::remove(_spillFileName);
+        _nextSpillFileOffset = 0;
+    }
+}
+
+bool DocumentSourceGraphLookUp::hasResultsLeft() {
+    while (!_spilledResults.empty() && !_spilledResults.back()->more()) {
+        _spilledResults.pop_back();
+    }
+    return !_spilledResults.empty() || !_visited.empty();
+}
+
+Document DocumentSourceGraphLookUp::popResult() {
+    if (!_spilledResults.empty()) {
+        return _spilledResults.back()->next().second;
+    }
+
+    auto it = _visited.begin();
+    Document result = std::move(it->second);
+    _visited.erase(it);
+    return result;
+}
+
 void DocumentSourceGraphLookUp::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
     auto fromValue = (pExpCtx->ns.db() == _from.db())
@@ -509,8 +594,10 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
       _additionalFilter(additionalFilter),
       _depthField(depthField),
       _maxDepth(maxDepth),
+      _maxMemoryUsageBytes(internalDocumentSourceGraphLookupMaxMemoryBytes.load()),
       _frontier(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _visited(ValueComparator::kInstance.makeUnorderedValueMap<Document>()),
+      _spilledIds(ValueComparator::kInstance.makeUnorderedValueSet()),
       _cache(pExpCtx->getValueComparator()),
       _unwind(unwindSrc),
       _variables(expCtx->variables),
@@ -525,6 +612,12 @@ DocumentSourceGraphLookUp::DocumentSourceGraphLookUp(
     _fromPipeline.push_back(BSON("$match" << BSONObj()));
 }
 
+DocumentSourceGraphLookUp::~DocumentSourceGraphLookUp() {
+    if (_nextSpillFileOffset != 0) {
+        DESTRUCTOR_GUARD(boost::filesystem::remove(_spillFileName));
+    }
+}
+
 intrusive_ptr<DocumentSourceGraphLookUp> DocumentSourceGraphLookUp::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     NamespaceString fromNs,
@@ -661,3 +754,6 @@ void DocumentSourceGraphLookUp::addInvolvedCollections(
     }
 }
 }  // namespace mongo
+
+#include "mongo/db/sorter/sorter.cpp"
+// Explicit instantiation unneeded since we aren't exposing Sorter outside of this file.
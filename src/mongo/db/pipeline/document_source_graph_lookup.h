@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -60,6 +61,8 @@ public:
         }
     };
 
+    ~DocumentSourceGraphLookUp();
+
     const char* getSourceName() const final;
 
     const FieldPath& getConnectFromField() const {
@@ -95,7 +98,7 @@ public:
         StageConstraints constraints(StreamType::kStreaming,
                                      PositionRequirement::kNone,
                                      HostTypeRequirement::kPrimaryShard,
-                                     DiskUseRequirement::kNoDiskUse,
+                                     DiskUseRequirement::kWritesTmpData,
                                      FacetRequirement::kAllowed,
                                      TransactionRequirement::kAllowed,
                                      LookupRequirement::kAllowed,
@@ -121,6 +124,10 @@ public:
 
     void reattachToOperationContext(OperationContext* opCtx) final;
 
+    bool usedDisk() final {
+        return _usedDisk;
+    }
+
     static boost::intrusive_ptr<DocumentSourceGraphLookUp> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         NamespaceString fromNs,
@@ -165,15 +172,15 @@ private:
     }
 
     /**
-     * Prepares the query to execute on the 'from' collection wrapped in a $match by using the
-     * contents of '_frontier'.
+     * Prepares the queries to execute on the 'from' collection wrapped in a $match by using the
+     * contents of '_frontier', each looking up at most
+     * 'internalDocumentSourceGraphLookupFrontierBatchSize' values.
      *
      * Fills 'cached' with any values that were retrieved from the cache.
      *
-     * Returns boost::none if no query is necessary, i.e., all values were retrieved from the cache.
-     * Otherwise, returns a query object.
+     * Returns no queries if none is necessary, i.e., all values were retrieved from the cache.
      */
-    boost::optional<BSONObj> makeMatchStageFromFrontier(DocumentUnorderedSet* cached);
+    std::vector<BSONObj> makeMatchStagesFromFrontier(DocumentUnorderedSet* cached);
 
     /**
      * If we have internalized a $unwind, getNext() dispatches to this function.
@@ -200,11 +207,34 @@ private:
     void addToCache(const Document& result, const ValueUnorderedSet& queried);
 
     /**
-     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, and then
-     * evict from '_cache' until this source is using less than '_maxMemoryUsageBytes'.
+     * Assert that '_visited' and '_frontier' have not exceeded the maximum meory usage, spilling
+     * '_visited' to disk first if allowed, and then evict from '_cache' until this source is using
+     * less than '_maxMemoryUsageBytes'.
      */
     void checkMemoryUsage();
 
+    /**
+     * Writes the documents in '_visited' to disk, keeping only their '_id's in '_spilledIds'.
+     */
+    void spillVisited();
+
+    /**
+     * Drops the documents spilled for the previous input, along with their '_id's.
+     */
+    void clearSpilledResults();
+
+    /**
+     * Returns whether any document discovered for the current input is left to return, whether
+     * in '_visited' or spilled to disk.
+     */
+    bool hasResultsLeft();
+
+    /**
+     * Removes and returns one of the documents discovered for the current input. Only valid if
+     * hasResultsLeft() returned true.
+     */
+    Document popResult();
+
     /**
      * Process 'result', adding it to '_visited' with the given 'depth', and updating '_frontier'
      * with the object's 'connectTo' values.
@@ -230,7 +260,7 @@ private:
     // The aggregation pipeline to perform against the '_from' namespace.
     std::vector<BSONObj> _fromPipeline;
 
-    size_t _maxMemoryUsageBytes = 100 * 1024 * 1024;
+    size_t _maxMemoryUsageBytes;
 
     // Track memory usage to ensure we don't exceed '_maxMemoryUsageBytes'.
     size_t _visitedUsageBytes = 0;
@@ -244,6 +274,16 @@ private:
     // using the simple collation.
     ValueUnorderedMap<Document> _visited;
 
+    // The '_id's of the nodes discovered for the current input whose documents were spilled to
+    // disk, and iterators over those documents. The '_id's are compared using the simple collation.
+    ValueUnorderedSet _spilledIds;
+    std::vector<std::unique_ptr<SortIteratorInterface<Value, Document>>> _spilledResults;
+
+    // The file the documents are spilled to, and where the next spill starts in it.
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset = 0;
+    bool _usedDisk = false;
+
     // Caches query results to avoid repeating any work. This structure is maintained across calls
     // to getNext().
     LookupSetCache _cache;
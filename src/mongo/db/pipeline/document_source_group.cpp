@@ -31,6 +31,7 @@
 
 #include <boost/filesystem/operations.hpp>
 #include <memory>
+#include <numeric>
 
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/exec/document_value/value.h"
@@ -117,9 +118,10 @@ DocumentSource::GetModPathsReturn GroupFromFirstDocumentTransformation::getModif
 std::unique_ptr<GroupFromFirstDocumentTransformation> GroupFromFirstDocumentTransformation::create(
     const intrusive_ptr<ExpressionContext>& expCtx,
     const std::string& groupId,
-    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs) {
-    return std::make_unique<GroupFromFirstDocumentTransformation>(groupId,
-                                                                  std::move(accumulatorExprs));
+    vector<pair<std::string, intrusive_ptr<Expression>>> accumulatorExprs,
+    ExpectedInput expectedInput) {
+    return std::make_unique<GroupFromFirstDocumentTransformation>(
+        groupId, std::move(accumulatorExprs), expectedInput);
 }
 
 constexpr StringData DocumentSourceGroup::kStageName;
@@ -139,12 +141,24 @@ bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory(std::function<int()
         _memoryTracker.memoryUsageBytes -= saveMemory();
     }
 
+    _memoryReservation.set(_memoryTracker.memoryUsageBytes);
+
     if (_memoryTracker.memoryUsageBytes > _memoryTracker.maxMemoryUsageBytes) {
         uassert(ErrorCodes::QueryExceededMemoryLimitNoDiskUseAllowed,
                 "Exceeded memory limit for $group, but didn't allow external sort."
                 " Pass allowDiskUse:true to opt in.",
                 _memoryTracker.allowDiskUse);
         _memoryTracker.memoryUsageBytes = 0;
+        _memoryReservation.set(0);
+        return true;
+    }
+
+    // When the blocking stages of all queries hold more memory than the process-wide budget, spill
+    // before reaching our own limit, if we are allowed to.
+    if (_memoryTracker.allowDiskUse &&
+        _memoryReservation.shouldSpillEarly(_memoryTracker.maxMemoryUsageBytes)) {
+        _memoryTracker.memoryUsageBytes = 0;
+        _memoryReservation.set(0);
         return true;
     }
     return false;
@@ -153,12 +167,13 @@ bool DocumentSourceGroup::shouldSpillWithAttemptToSaveMemory(std::function<int()
 int DocumentSourceGroup::freeMemory() {
     invariant(_groups);
     int totalMemorySaved = 0;
-    for (auto&& group : *_groups) {
-        for (size_t i = 0; i < group.second.size(); i++) {
-            auto prevMemUsage = group.second[i]->getMemUsage();
-            group.second[i]->reduceMemoryConsumptionIfAble();
+    for (size_t row = 0; row < _groups->size(); ++row) {
+        auto group = _groups->getAccumulators(row);
+        for (size_t i = 0; i < _accumulatedFields.size(); i++) {
+            auto prevMemUsage = group[i]->getMemUsage();
+            group[i]->reduceMemoryConsumptionIfAble();
 
-            auto memorySaved = prevMemUsage - group.second[i]->getMemUsage();
+            auto memorySaved = prevMemUsage - group[i]->getMemUsage();
             // Update the memory usage for this AccumulationStatement.
             _memoryTracker.accumStatementMemoryBytes[i].currentMemoryBytes -= memorySaved;
             // Update the memory usage for this group.
@@ -230,29 +245,30 @@ DocumentSource::GetNextResult DocumentSourceGroup::getNextSpilled() {
         _firstPartOfNextGroup = _sorterIterator->next();
     }
 
-    return makeDocument(_currentId, _currentAccumulators, pExpCtx->needsMerge);
+    return makeDocument(_currentId, _currentAccumulators.data(), pExpCtx->needsMerge);
 }
 
 DocumentSource::GetNextResult DocumentSourceGroup::getNextStandard() {
     // Not spilled, and not streaming.
-    if (_groups->empty())
+    if (!_groups || _groups->empty())
         return GetNextResult::makeEOF();
 
-    Document out = makeDocument(groupsIterator->first, groupsIterator->second, pExpCtx->needsMerge);
+    Document out = makeDocument(_groups->getKey(_nextGroupRow),
+                                _groups->getAccumulators(_nextGroupRow),
+                                pExpCtx->needsMerge);
 
-    if (++groupsIterator == _groups->end())
+    if (++_nextGroupRow == _groups->size())
         dispose();
 
     return out;
 }
 
 void DocumentSourceGroup::doDispose() {
-    // Free our resources.
-    _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+    // Free our resources, which also makes us look done.
+    _groups = boost::none;
     _sorterIterator.reset();
-
-    // Make us look done.
-    groupsIterator = _groups->end();
+    _memoryReservation.set(0);
+    _nextGroupRow = 0;
 }
 
 intrusive_ptr<DocumentSource> DocumentSourceGroup::optimize() {
@@ -405,7 +421,6 @@ DocumentSourceGroup::DocumentSourceGroup(const intrusive_ptr<ExpressionContext>&
                      maxMemoryUsageBytes ? *maxMemoryUsageBytes
                                          : internalDocumentSourceGroupMaxMemoryBytes.load()},
       _initialized(false),
-      _groups(expCtx->getValueComparator().makeUnorderedValueMap<Accumulators>()),
       _spilled(false) {
     if (!expCtx->inMongos && (expCtx->allowDiskUse || kDebugBuild)) {
         // We spill to disk in debug mode, regardless of allowDiskUse, to stress the system.
@@ -510,8 +525,6 @@ intrusive_ptr<DocumentSource> DocumentSourceGroup::createFromBson(
 
 namespace {
 
-using GroupsMap = DocumentSourceGroup::GroupsMap;
-
 class SorterComparator {
 public:
     typedef pair<Value, Value> Data;
@@ -528,19 +541,24 @@ private:
 
 class SpillSTLComparator {
 public:
-    SpillSTLComparator(ValueComparator valueComparator) : _valueComparator(valueComparator) {}
+    SpillSTLComparator(ValueComparator valueComparator, const GroupHashTable* groups)
+        : _valueComparator(valueComparator), _groups(groups) {}
 
-    bool operator()(const GroupsMap::value_type* lhs, const GroupsMap::value_type* rhs) const {
-        return _valueComparator.evaluate(lhs->first < rhs->first);
+    bool operator()(size_t lhs, size_t rhs) const {
+        return _valueComparator.evaluate(_groups->getKey(lhs) < _groups->getKey(rhs));
     }
 
 private:
     ValueComparator _valueComparator;
+    const GroupHashTable* _groups;
 };
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
     const size_t numAccumulators = _accumulatedFields.size();
+    if (!_groups) {
+        _groups.emplace(pExpCtx->getValueComparator(), numAccumulators);
+    }
 
     // Barring any pausing, this loop exhausts 'pSource' and populates '_groups'.
     GetNextResult input = pSource->getNext();
@@ -555,31 +573,31 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         auto rootDocument = input.releaseDocument();
         Value id = computeId(rootDocument);
 
-        // Look for the _id value in the map. If it's not there, add a new entry with a blank
-        // accumulator. This is done in a somewhat odd way in order to avoid hashing 'id' and
-        // looking it up in '_groups' multiple times.
-        const size_t oldSize = _groups->size();
-        vector<intrusive_ptr<AccumulatorState>>& group = (*_groups)[id];
-        const bool inserted = _groups->size() != oldSize;
+        // Look for the _id value in the table. If it's not there, add a new row, whose
+        // accumulators are created below. The growth of the table itself is charged to the memory
+        // usage along with the new key.
+        const size_t oldOverheadBytes = _groups->getMemoryOverheadBytes();
+        const auto [row, inserted] = _groups->findOrInsert(id);
+        auto group = _groups->getAccumulators(row);
 
         vector<uint64_t> oldAccumMemUsage(numAccumulators, 0);
         if (inserted) {
-            _memoryTracker.memoryUsageBytes += id.getApproximateSize();
+            _memoryTracker.memoryUsageBytes += id.getApproximateSize() +
+                _groups->getMemoryOverheadBytes() - oldOverheadBytes;
 
             // Initialize and add the accumulators
             Value expandedId = expandId(id);
             Document idDoc =
                 expandedId.getType() == BSONType::Object ? expandedId.getDocument() : Document();
-            group.reserve(numAccumulators);
-            for (auto&& accumulatedField : _accumulatedFields) {
-                auto accum = accumulatedField.makeAccumulator();
+            for (size_t i = 0; i < numAccumulators; i++) {
+                auto& accumulatedField = _accumulatedFields[i];
+                group[i] = accumulatedField.makeAccumulator();
                 Value initializerValue =
                     accumulatedField.expr.initializer->evaluate(idDoc, &pExpCtx->variables);
-                accum->startNewGroup(initializerValue);
-                group.push_back(accum);
+                group[i]->startNewGroup(initializerValue);
             }
         } else {
-            for (size_t i = 0; i < group.size(); i++) {
+            for (size_t i = 0; i < numAccumulators; i++) {
                 // subtract old mem usage. New usage added back after processing.
                 _memoryTracker.memoryUsageBytes -= group[i]->getMemUsage();
                 oldAccumMemUsage[i] = group[i]->getMemUsage();
@@ -587,8 +605,6 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
         }
 
         /* tickle all the accumulators for the group we found */
-        dassert(numAccumulators == group.size());
-
         for (size_t i = 0; i < numAccumulators; i++) {
             group[i]->process(
                 _accumulatedFields[i].expr.argument->evaluate(rootDocument, &pExpCtx->variables),
@@ -627,7 +643,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 }
 
                 // We won't be using groups again so free its memory.
-                _groups = pExpCtx->getValueComparator().makeUnorderedValueMap<Accumulators>();
+                _groups = boost::none;
 
                 _sorterIterator.reset(Sorter<Value, Value>::Iterator::merge(
                     _sortedFiles, SortOptions(), SorterComparator(pExpCtx->getValueComparator())));
@@ -643,7 +659,7 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
                 _firstPartOfNextGroup = _sorterIterator->next();
             } else {
                 // start the group iterator
-                groupsIterator = _groups->begin();
+                _nextGroupRow = 0;
             }
 
             // This must happen last so that, unless control gets here, we will re-enter
@@ -657,43 +673,43 @@ DocumentSource::GetNextResult DocumentSourceGroup::initialize() {
 
 shared_ptr<Sorter<Value, Value>::Iterator> DocumentSourceGroup::spill() {
     _stats.usedDisk = true;
-    vector<const GroupsMap::value_type*> ptrs;  // using pointers to speed sorting
-    ptrs.reserve(_groups->size());
-    for (GroupsMap::const_iterator it = _groups->begin(), end = _groups->end(); it != end; ++it) {
-        ptrs.push_back(&*it);
-    }
+    vector<size_t> rows(_groups->size());  // using row numbers to speed sorting
+    std::iota(rows.begin(), rows.end(), 0);
 
-    stable_sort(ptrs.begin(), ptrs.end(), SpillSTLComparator(pExpCtx->getValueComparator()));
+    stable_sort(
+        rows.begin(), rows.end(), SpillSTLComparator(pExpCtx->getValueComparator(), &*_groups));
 
     SortedFileWriter<Value, Value> writer(
         SortOptions().TempDir(pExpCtx->tempDir), _fileName, _nextSortedFileWriterOffset);
-    switch (_accumulatedFields.size()) {  // same as ptrs[i]->second.size() for all i.
-        case 0:                           // no values, essentially a distinct
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first, Value());
+    switch (_accumulatedFields.size()) {
+        case 0:  // no values, essentially a distinct
+            for (size_t i = 0; i < rows.size(); i++) {
+                writer.addAlreadySorted(_groups->getKey(rows[i]), Value());
             }
             break;
 
         case 1:  // just one value, use optimized serialization as single Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
-                writer.addAlreadySorted(ptrs[i]->first,
-                                        ptrs[i]->second[0]->getValue(/*toBeMerged=*/true));
+            for (size_t i = 0; i < rows.size(); i++) {
+                writer.addAlreadySorted(
+                    _groups->getKey(rows[i]),
+                    _groups->getAccumulators(rows[i])[0]->getValue(/*toBeMerged=*/true));
             }
             break;
 
         default:  // multiple values, serialize as array-typed Value
-            for (size_t i = 0; i < ptrs.size(); i++) {
+            for (size_t i = 0; i < rows.size(); i++) {
+                auto group = _groups->getAccumulators(rows[i]);
                 vector<Value> accums;
-                for (size_t j = 0; j < ptrs[i]->second.size(); j++) {
-                    accums.push_back(ptrs[i]->second[j]->getValue(/*toBeMerged=*/true));
+                for (size_t j = 0; j < _accumulatedFields.size(); j++) {
+                    accums.push_back(group[j]->getValue(/*toBeMerged=*/true));
                 }
-                writer.addAlreadySorted(ptrs[i]->first, Value(std::move(accums)));
+                writer.addAlreadySorted(_groups->getKey(rows[i]), Value(std::move(accums)));
             }
             break;
     }
 
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(pExpCtx->opCtx);
-    metricsCollector.incrementKeysSorted(ptrs.size());
+    metricsCollector.incrementKeysSorted(rows.size());
     metricsCollector.incrementSorterSpills(1);
 
     _groups->clear();
@@ -748,7 +764,7 @@ Value DocumentSourceGroup::expandId(const Value& val) {
 }
 
 Document DocumentSourceGroup::makeDocument(const Value& id,
-                                           const Accumulators& accums,
+                                           const intrusive_ptr<AccumulatorState>* accums,
                                            bool mergeableOutput) {
     const size_t n = _accumulatedFields.size();
     MutableDocument out(1 + n);
@@ -856,12 +872,16 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
 
     const auto groupId = fieldPath.tail().fullPath();
 
-    // We can't do this transformation if there are any non-$first accumulators.
+    // We can't do this transformation unless the accumulators are all $first or all $last.
+    boost::optional<AccumulatorDocumentsNeeded> documentsNeeded;
     for (auto&& accumulator : _accumulatedFields) {
-        if (AccumulatorDocumentsNeeded::kFirstDocument !=
-            accumulator.makeAccumulator()->documentsNeeded()) {
+        auto accumulatorNeeds = accumulator.makeAccumulator()->documentsNeeded();
+        if ((accumulatorNeeds != AccumulatorDocumentsNeeded::kFirstDocument &&
+             accumulatorNeeds != AccumulatorDocumentsNeeded::kLastDocument) ||
+            (documentsNeeded && *documentsNeeded != accumulatorNeeds)) {
             return nullptr;
         }
+        documentsNeeded = accumulatorNeeds;
     }
 
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> fields;
@@ -881,11 +901,17 @@ DocumentSourceGroup::rewriteGroupAsTransformOnFirstDocument() const {
     for (auto&& accumulator : _accumulatedFields) {
         fields.push_back(std::make_pair(accumulator.fieldName, accumulator.expr.argument));
 
-        // Since we don't attempt this transformation for non-$first accumulators,
-        // the initializer should always be trivial.
+        // Since we don't attempt this transformation for accumulators other than $first and
+        // $last, the initializer should always be trivial.
     }
 
-    return GroupFromFirstDocumentTransformation::create(pExpCtx, groupId, std::move(fields));
+    return GroupFromFirstDocumentTransformation::create(
+        pExpCtx,
+        groupId,
+        std::move(fields),
+        documentsNeeded == AccumulatorDocumentsNeeded::kLastDocument
+            ? GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument
+            : GroupFromFirstDocumentTransformation::ExpectedInput::kFirstDocument);
 }
 
 size_t DocumentSourceGroup::getMaxMemoryUsageBytes() const {
@@ -35,7 +35,9 @@
 #include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/group_hash_table.h"
 #include "mongo/db/pipeline/transformer_interface.h"
+#include "mongo/db/query/query_memory_budget.h"
 #include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
@@ -45,13 +47,24 @@ namespace mongo {
  * document synthesized by assigning each field name in the output document to the result of
  * evaluating the corresponding expression. If the expression evaluates to missing, we assign a
  * value of BSONNULL. This is necessary to match the semantics of $first for missing fields.
+ *
+ * When the $group uses $last accumulators, the transformation expects the last document of each
+ * group, which its input can provide as the first document of the group in the reverse order.
  */
 class GroupFromFirstDocumentTransformation final : public TransformerInterface {
 public:
+    enum class ExpectedInput {
+        kFirstDocument,
+        kLastDocument,
+    };
+
     GroupFromFirstDocumentTransformation(
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs)
-        : _accumulatorExprs(std::move(accumulatorExprs)), _groupId(groupId) {}
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument)
+        : _accumulatorExprs(std::move(accumulatorExprs)),
+          _groupId(groupId),
+          _expectedInput(expectedInput) {}
 
     TransformerType getType() const final {
         return TransformerType::kGroupFromFirstDocument;
@@ -65,6 +78,14 @@ public:
         return _groupId;
     }
 
+    /**
+     * Whether each input document must be the first or the last of its group in the order of the
+     * input of the $group.
+     */
+    ExpectedInput expectedInput() const {
+        return _expectedInput;
+    }
+
     Document applyTransformation(const Document& input) final;
 
     void optimize() final;
@@ -79,17 +100,18 @@ public:
     static std::unique_ptr<GroupFromFirstDocumentTransformation> create(
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         const std::string& groupId,
-        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs);
+        std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> accumulatorExprs,
+        ExpectedInput expectedInput = ExpectedInput::kFirstDocument);
 
 private:
     std::vector<std::pair<std::string, boost::intrusive_ptr<Expression>>> _accumulatorExprs;
     std::string _groupId;
+    ExpectedInput _expectedInput;
 };
 
 class DocumentSourceGroup final : public DocumentSource {
 public:
     using Accumulators = std::vector<boost::intrusive_ptr<AccumulatorState>>;
-    using GroupsMap = ValueUnorderedMap<Accumulators>;
 
     static constexpr StringData kStageName = "$group"_sd;
 
@@ -174,7 +196,8 @@ public:
     /**
      * When possible, creates a document transformer that transforms the first document in a group
      * into one of the output documents of the $group stage. This is possible when we are grouping
-     * on a single field and all accumulators are $first (or there are no accumluators).
+     * on a single field and all accumulators are $first (or there are no accumluators), or all
+     * accumulators are $last, in which case the transformation expects the last document.
      *
      * It is sometimes possible to use a DISTINCT_SCAN to scan the first document of each group,
      * in which case this transformation can replace the actual $group stage in the pipeline
@@ -249,7 +272,13 @@ private:
      */
     int freeMemory();
 
-    Document makeDocument(const Value& id, const Accumulators& accums, bool mergeableOutput);
+    /**
+     * Builds the output document of the group 'id' from its '_accumulatedFields.size()'
+     * accumulators, starting at 'accums'.
+     */
+    Document makeDocument(const Value& id,
+                          const boost::intrusive_ptr<AccumulatorState>* accums,
+                          bool mergeableOutput);
 
     /**
      * Computes the internal representation of the group key.
@@ -282,6 +311,9 @@ private:
 
     MemoryUsageTracker _memoryTracker;
 
+    // The memory held by the groups, as reported to the process-wide budget.
+    QueryMemoryBudget::Reservation _memoryReservation;
+
     GroupStats _stats;
 
     std::string _fileName;
@@ -296,16 +328,16 @@ private:
     Value _currentId;
     Accumulators _currentAccumulators;
 
-    // We use boost::optional to defer initialization until the ExpressionContext containing the
-    // correct comparator is injected, since the groups must be built using the comparator's
-    // definition of equality.
-    boost::optional<GroupsMap> _groups;
+    // We use boost::optional to defer initialization until the input is consumed, since the groups
+    // must be built using the comparator's definition of equality and hold one accumulator per
+    // entry of '_accumulatedFields'.
+    boost::optional<GroupHashTable> _groups;
 
     std::vector<std::shared_ptr<Sorter<Value, Value>::Iterator>> _sortedFiles;
     bool _spilled;
 
-    // Only used when '_spilled' is false.
-    GroupsMap::iterator groupsIterator;
+    // Only used when '_spilled' is false. The row of '_groups' to return next.
+    size_t _nextGroupRow = 0;
 
     // Only used when '_spilled' is true.
     std::unique_ptr<Sorter<Value, Value>::Iterator> _sorterIterator;
@@ -33,6 +33,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
 
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 
@@ -44,6 +45,7 @@
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -267,6 +269,78 @@ bool fieldIsComputed(BucketSpec spec, std::string field) {
                 expression::isPathPrefixOf(s, field);
         });
 }
+
+// Returns whether 'expr' is a conjunction of comparisons of the timeField with constants. Since the
+// set of times matched by such a predicate is an interval, every measurement of a bucket matches if
+// both bounds of the bucket do.
+bool isTimeRangeFilter(const MatchExpression* expr, StringData timeField) {
+    switch (expr->matchType()) {
+        case MatchExpression::AND:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!isTimeRangeFilter(expr->getChild(i), timeField)) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::EQ:
+        case MatchExpression::LT:
+        case MatchExpression::LTE:
+        case MatchExpression::GT:
+        case MatchExpression::GTE:
+            return expr->path() == timeField;
+        default:
+            return false;
+    }
+}
+
+// Returns whether 'expr' takes the same value on every measurement of a bucket when it takes the
+// same value on the bucket's bounds. This holds for constants, paths on the metaField and
+// $dateTrunc of the timeField with constant arguments, which never decreases with time.
+bool isDeterminedByBucketBounds(const Expression* expr, const BucketSpec& spec) {
+    if (dynamic_cast<const ExpressionConstant*>(expr)) {
+        return true;
+    }
+    if (auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(expr)) {
+        auto&& path = fieldPath->getFieldPath();
+        return spec.metaField && fieldPath->getVariableId() == Variables::kRootId &&
+            path.getPathLength() > 1 && path.getFieldName(1) == *spec.metaField;
+    }
+    if (auto object = dynamic_cast<const ExpressionObject*>(expr)) {
+        auto&& children = object->getChildExpressions();
+        return std::all_of(children.begin(), children.end(), [&](auto&& child) {
+            return isDeterminedByBucketBounds(child.second.get(), spec);
+        });
+    }
+    if (auto dateTrunc = dynamic_cast<const ExpressionDateTrunc*>(expr)) {
+        auto&& children = dateTrunc->getChildren();
+        auto date = dynamic_cast<const ExpressionFieldPath*>(children[0].get());
+        return date && date->representsPath(spec.timeField) &&
+            std::all_of(std::next(children.begin()), children.end(), [](auto&& child) {
+                   return !child || dynamic_cast<const ExpressionConstant*>(child.get());
+               });
+    }
+    return false;
+}
+
+// Returns whether the bound 'elem' of a field accumulated with $min or $max is ordered the same way
+// by the bucket catalog and by the accumulator, and is not skipped by the accumulator. A missing
+// bound means that no measurement has the field.
+bool isSummarizableBound(const BSONElement& elem) {
+    switch (elem.type()) {
+        case EOO:
+        case NumberInt:
+        case NumberLong:
+        case NumberDouble:
+        case NumberDecimal:
+        case Date:
+        case bsonTimestamp:
+        case Bool:
+        case jstOID:
+            return true;
+        default:
+            return false;
+    }
+}
 }  // namespace
 
 DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
@@ -291,6 +365,7 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
     std::vector<std::string> fields;
     auto bucketMaxSpanSeconds = 0;
     std::vector<std::string> computedMetaProjFields;
+    BSONObj bucketSummary;
     for (auto&& elem : specElem.embeddedObject()) {
         auto fieldName = elem.fieldNameStringData();
         if (fieldName == "include" || fieldName == "exclude") {
@@ -351,6 +426,11 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
                         field.find('.') == std::string::npos);
                 bucketSpec.computedMetaProjFields.emplace_back(field);
             }
+        } else if (fieldName == kBucketSummary) {
+            uassert(5963023,
+                    str::stream() << kBucketSummary << " field must be an object",
+                    elem.type() == BSONType::Object);
+            bucketSummary = elem.Obj();
         } else {
             uasserted(5346506,
                       str::stream()
@@ -366,8 +446,49 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             "The $_internalUnpackBucket stage requires a bucketMaxSpanSeconds parameter",
             specElem["bucketMaxSpanSeconds"].ok());
 
-    return make_intrusive<DocumentSourceInternalUnpackBucket>(
+    auto unpackStage = make_intrusive<DocumentSourceInternalUnpackBucket>(
         expCtx, BucketUnpacker{std::move(bucketSpec), unpackerBehavior}, bucketMaxSpanSeconds);
+    if (!bucketSummary.isEmpty()) {
+        unpackStage->setBucketSummarySpec(bucketSummary);
+    }
+    return unpackStage;
+}
+
+void DocumentSourceInternalUnpackBucket::setBucketSummarySpec(const BSONObj& spec) {
+    BucketSummarySpec summarySpec;
+    for (auto&& elem : spec) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == "filter") {
+            uassert(5963024,
+                    "bucketSummary filter must be an object",
+                    elem.type() == BSONType::Object);
+            summarySpec.filter = elem.Obj().getOwned();
+            summarySpec.filterExpr =
+                uassertStatusOK(MatchExpressionParser::parse(summarySpec.filter, pExpCtx));
+        } else if (fieldName == "groupBy") {
+            uassert(5963025,
+                    "bucketSummary groupBy must be an array",
+                    elem.type() == BSONType::Array);
+            for (auto&& key : elem.Obj()) {
+                summarySpec.groupBy.push_back(
+                    Expression::parseOperand(pExpCtx.get(), key, pExpCtx->variablesParseState));
+            }
+        } else if (fieldName == "fields") {
+            uassert(5963026,
+                    "bucketSummary fields must be an array",
+                    elem.type() == BSONType::Array);
+            for (auto&& field : elem.Obj()) {
+                uassert(5963027,
+                        "bucketSummary fields element must be a string",
+                        field.type() == BSONType::String);
+                summarySpec.fields.push_back(field.str());
+            }
+        } else {
+            uasserted(5963028,
+                      str::stream() << "unrecognized bucketSummary parameter: " << fieldName);
+        }
+    }
+    _bucketSummarySpec = std::move(summarySpec);
 }
 
 void DocumentSourceInternalUnpackBucket::serializeToArray(
@@ -406,6 +527,20 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
                          return compFields;
                      }()});
 
+    if (_bucketSummarySpec) {
+        std::vector<Value> groupBy;
+        for (auto&& expr : _bucketSummarySpec->groupBy) {
+            groupBy.push_back(expr->serialize(static_cast<bool>(explain)));
+        }
+        std::vector<Value> summaryFields;
+        for (auto&& field : _bucketSummarySpec->fields) {
+            summaryFields.emplace_back(field);
+        }
+        out.addField(kBucketSummary,
+                     Value{DOC("filter" << _bucketSummarySpec->filter << "groupBy" << groupBy
+                                        << "fields" << summaryFields)});
+    }
+
     if (!explain) {
         array.push_back(Value(DOC(getSourceName() << out.freeze())));
         if (_sampleSize) {
@@ -424,27 +559,112 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
 DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
     tassert(5521502, "calling doGetNext() when '_sampleSize' is set is disallowed", !_sampleSize);
 
+    if (_pendingBucketSummary) {
+        auto summary = std::move(*_pendingBucketSummary);
+        _pendingBucketSummary = boost::none;
+        return summary;
+    }
+
     // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
     // exhausted.
     if (_bucketUnpacker.hasNext()) {
-        return _bucketUnpacker.getNext();
+        return getNextMeasurement();
     }
 
     auto nextResult = pSource->getNext();
     if (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
+        if (_bucketSummarySpec) {
+            if (auto summaries = summarizeBucket(bucket)) {
+                _pendingBucketSummary = std::move(summaries->second);
+                return std::move(summaries->first);
+            }
+        }
+
         _bucketUnpacker.reset(std::move(bucket));
         uassert(5346509,
                 str::stream() << "A bucket with _id "
                               << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
                               << " contains an empty data region",
                 _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
+        _stripBucketSummaryCountField = _bucketSummarySpec &&
+            _bucketUnpacker.bucket()[timeseries::kBucketDataFieldName].Obj().hasField(
+                kBucketSummaryCountFieldName);
+        return getNextMeasurement();
     }
 
     return nextResult;
 }
 
+Document DocumentSourceInternalUnpackBucket::getNextMeasurement() {
+    if (!_stripBucketSummaryCountField) {
+        return _bucketUnpacker.getNext();
+    }
+    MutableDocument measurement{_bucketUnpacker.getNext()};
+    measurement.remove(kBucketSummaryCountFieldName);
+    return measurement.freeze();
+}
+
+boost::optional<std::pair<Document, Document>> DocumentSourceInternalUnpackBucket::summarizeBucket(
+    const BSONObj& bucket) const {
+    auto&& spec = _bucketUnpacker.bucketSpec();
+
+    // Compressed buckets do not give their number of measurements away cheaply.
+    auto timeColumn = bucket[timeseries::kBucketDataFieldName][spec.timeField];
+    auto control = bucket[timeseries::kBucketControlFieldName];
+    if (timeColumn.type() != BSONType::Object || timeColumn.Obj().isEmpty() ||
+        control.type() != BSONType::Object) {
+        return boost::none;
+    }
+    auto minBounds = control["min"];
+    auto maxBounds = control["max"];
+    if (minBounds.type() != BSONType::Object || maxBounds.type() != BSONType::Object) {
+        return boost::none;
+    }
+
+    for (auto&& field : _bucketSummarySpec->fields) {
+        if (!isSummarizableBound(minBounds.Obj()[field]) ||
+            !isSummarizableBound(maxBounds.Obj()[field])) {
+            return boost::none;
+        }
+    }
+
+    // The lower summary stands for every measurement of the bucket, the upper one for none, so that
+    // the pair adds up to the right count whichever order they are accumulated in.
+    auto makeSummary = [&](const BSONObj& bounds, int count) {
+        BSONObjBuilder builder;
+        for (auto&& elem : bounds) {
+            if (elem.fieldNameStringData() != kBucketSummaryCountFieldName) {
+                builder.append(elem);
+            }
+        }
+        if (auto meta = bucket[timeseries::kBucketMetaFieldName]; meta && spec.metaField) {
+            builder.appendAs(meta, *spec.metaField);
+        }
+        builder.append(kBucketSummaryCountFieldName, count);
+        return builder.obj();
+    };
+    auto lower = makeSummary(
+        minBounds.Obj(), BucketUnpacker::computeMeasurementCount(timeColumn.Obj().objsize()));
+    auto upper = makeSummary(maxBounds.Obj(), 0);
+
+    if (_bucketSummarySpec->filterExpr && (!_bucketSummarySpec->filterExpr->matchesBSON(lower) ||
+                                           !_bucketSummarySpec->filterExpr->matchesBSON(upper))) {
+        return boost::none;
+    }
+
+    Document lowerDoc{lower};
+    Document upperDoc{upper};
+    for (auto&& expr : _bucketSummarySpec->groupBy) {
+        if (pExpCtx->getValueComparator().evaluate(
+                expr->evaluate(lowerDoc, &pExpCtx->variables) !=
+                expr->evaluate(upperDoc, &pExpCtx->variables))) {
+            return boost::none;
+        }
+    }
+    return std::pair{std::move(lowerDoc), std::move(upperDoc)};
+}
+
 bool DocumentSourceInternalUnpackBucket::pushDownComputedMetaProjection(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     bool nextStageWasRemoved = false;
@@ -542,8 +762,16 @@ std::pair<BSONObj, bool> DocumentSourceInternalUnpackBucket::extractOrBuildProje
     return {BSONObj{}, false};
 }
 
+/**
+ * Maps a comparison on a measurement field onto predicates on the bucket's control fields. Besides
+ * $eq, $gt, $gte, $lt and $lte, this accepts the $_internalExprEq, $_internalExprGt and
+ * $_internalExprGte predicates which a $match generates from the comparisons of an $expr. Those
+ * compare without regard to type, so a measurement of any type which matches the $expr is still
+ * within the bucket's bounds. An $expr $lt or $lte is not mapped since it also matches
+ * measurements where the field is missing, which leave no trace in the bucket's bounds.
+ */
 std::unique_ptr<MatchExpression> createComparisonPredicate(
-    const ComparisonMatchExpression* matchExpr,
+    const ComparisonMatchExpressionBase* matchExpr,
     const BucketSpec& bucketSpec,
     int bucketMaxSpanSeconds) {
     using namespace timeseries;
@@ -562,6 +790,12 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
     if (matchExpr->getData().type() == BSONType::jstNULL)
         return nullptr;
 
+    // Under the comparison semantics of $expr, a missing field is not above MinKey either.
+    if (matchExpr->getData().type() == BSONType::MinKey &&
+        (matchExpr->matchType() == MatchExpression::INTERNAL_EXPR_GT ||
+         matchExpr->matchType() == MatchExpression::INTERNAL_EXPR_GTE))
+        return nullptr;
+
     // We must avoid mapping predicates on the meta field onto the control field.
     if (bucketSpec.metaField &&
         (matchExpr->path() == bucketSpec.metaField.get() ||
@@ -575,6 +809,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
 
     switch (matchExpr->matchType()) {
         case MatchExpression::EQ:
+        case MatchExpression::INTERNAL_EXPR_EQ:
             // For $eq, make both a $lt against 'control.min' and a $gt predicate against
             // 'control.max'. In addition, if the comparison is against the 'time' field, include a
             // predicate against the _id field which is converted to the maximum for the
@@ -592,6 +827,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                           std::string{kControlMaxFieldNamePrefix} + matchExpr->path()},
                 std::pair{kBucketIdFieldName, kBucketIdFieldName});
         case MatchExpression::GT:
+        case MatchExpression::INTERNAL_EXPR_GT:
             // For $gt, make a $gt predicate against 'control.max'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the maximum for the corresponding range of ObjectIds and is adjusted
@@ -603,6 +839,7 @@ std::unique_ptr<MatchExpression> createComparisonPredicate(
                 std::string{kControlMaxFieldNamePrefix} + matchExpr->path(),
                 kBucketIdFieldName);
         case MatchExpression::GTE:
+        case MatchExpression::INTERNAL_EXPR_GTE:
             // For $gte, make a $gte predicate against 'control.max'. In addition, if the comparison
             // is against the 'time' field, include a predicate against the _id field which is
             // converted to the minimum for the corresponding range of ObjectIds and is adjusted
@@ -655,15 +892,66 @@ DocumentSourceInternalUnpackBucket::createPredicatesOnBucketLevelField(
         if (andMatchExpr->numChildren() > 0) {
             return andMatchExpr;
         }
-    } else if (ComparisonMatchExpression::isComparisonMatchExpression(matchExpr)) {
-        return createComparisonPredicate(static_cast<const ComparisonMatchExpression*>(matchExpr),
-                                         _bucketUnpacker.bucketSpec(),
-                                         _bucketMaxSpanSeconds);
+    } else if (matchExpr->matchType() == MatchExpression::OR) {
+        // A bucket can only be skipped if it cannot match any of the branches, so every branch
+        // must map onto the control fields.
+        auto nextOr = static_cast<const OrMatchExpression*>(matchExpr);
+        auto orMatchExpr = std::make_unique<OrMatchExpression>();
+
+        for (size_t i = 0; i < nextOr->numChildren(); i++) {
+            auto child = createPredicatesOnBucketLevelField(nextOr->getChild(i));
+            if (!child) {
+                return nullptr;
+            }
+            orMatchExpr->add(std::move(child));
+        }
+        if (orMatchExpr->numChildren() > 0) {
+            return orMatchExpr;
+        }
+    } else if (matchExpr->matchType() == MatchExpression::MATCH_IN) {
+        return createInPredicate(static_cast<const InMatchExpression*>(matchExpr));
+    } else if (ComparisonMatchExpression::isComparisonMatchExpression(matchExpr) ||
+               matchExpr->matchType() == MatchExpression::INTERNAL_EXPR_EQ ||
+               matchExpr->matchType() == MatchExpression::INTERNAL_EXPR_GT ||
+               matchExpr->matchType() == MatchExpression::INTERNAL_EXPR_GTE) {
+        return createComparisonPredicate(
+            static_cast<const ComparisonMatchExpressionBase*>(matchExpr),
+            _bucketUnpacker.bucketSpec(),
+            _bucketMaxSpanSeconds);
     }
 
     return nullptr;
 }
 
+std::unique_ptr<MatchExpression> DocumentSourceInternalUnpackBucket::createInPredicate(
+    const InMatchExpression* matchExpr) const {
+    // A measurement equal to one of the values lies between the smallest and the largest of them,
+    // so the bucket's bounds must overlap that range. The equalities are sorted, using the same
+    // collation as the comparisons on the control fields.
+    const auto& equalities = matchExpr->getEqualities();
+    if (equalities.empty() || !matchExpr->getRegexes().empty() || matchExpr->hasNull()) {
+        return nullptr;
+    }
+    if (std::any_of(equalities.begin(), equalities.end(), [](auto&& elem) {
+            return elem.type() == BSONType::Object || elem.type() == BSONType::Array;
+        })) {
+        return nullptr;
+    }
+
+    GTEMatchExpression lowerBound(matchExpr->path(), Value(equalities.front()));
+    LTEMatchExpression upperBound(matchExpr->path(), Value(equalities.back()));
+    auto lowerPredicate = createComparisonPredicate(
+        &lowerBound, _bucketUnpacker.bucketSpec(), _bucketMaxSpanSeconds);
+    auto upperPredicate = createComparisonPredicate(
+        &upperBound, _bucketUnpacker.bucketSpec(), _bucketMaxSpanSeconds);
+    if (!lowerPredicate || !upperPredicate) {
+        return nullptr;
+    }
+
+    return std::make_unique<AndMatchExpression>(makeVector<std::unique_ptr<MatchExpression>>(
+        std::move(lowerPredicate), std::move(upperPredicate)));
+}
+
 std::pair<boost::intrusive_ptr<DocumentSourceMatch>, boost::intrusive_ptr<DocumentSourceMatch>>
 DocumentSourceInternalUnpackBucket::splitMatchOnMetaAndRename(
     boost::intrusive_ptr<DocumentSourceMatch> match) {
@@ -790,6 +1078,97 @@ DocumentSourceInternalUnpackBucket::rewriteGroupByMinMax(Pipeline::SourceContain
     return {};
 }
 
+bool DocumentSourceInternalUnpackBucket::rewriteGroupToBucketSummaries(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    auto&& spec = _bucketUnpacker.bucketSpec();
+    if (_bucketSummarySpec || _sampleSize || !spec.computedMetaProjFields.empty()) {
+        return false;
+    }
+
+    auto groupItr = std::next(itr);
+    BSONObj filter;
+    if (auto matchPtr = dynamic_cast<DocumentSourceMatch*>(groupItr->get())) {
+        if (!isTimeRangeFilter(matchPtr->getMatchExpression(), spec.timeField)) {
+            return false;
+        }
+        filter = matchPtr->getQuery();
+        ++groupItr;
+    }
+    if (groupItr == container->end()) {
+        return false;
+    }
+    auto groupPtr = dynamic_cast<DocumentSourceGroup*>(groupItr->get());
+    if (!groupPtr || groupPtr->doingMerge()) {
+        return false;
+    }
+
+    // Order the parts of the $group key so that the stage serializes the same way every time.
+    auto idFields = groupPtr->getIdFields();
+    std::map<std::string, boost::intrusive_ptr<Expression>> orderedIdFields(idFields.begin(),
+                                                                            idFields.end());
+    std::vector<Value> groupBy;
+    for (auto&& [key, expr] : orderedIdFields) {
+        if (!isDeterminedByBucketBounds(expr.get(), spec)) {
+            return false;
+        }
+        groupBy.push_back(expr->serialize(false));
+    }
+
+    std::vector<Value> fields;
+    std::vector<StringData> countFields;
+    for (const AccumulationStatement& stmt : groupPtr->getAccumulatedFields()) {
+        const StringData op = stmt.makeAccumulator()->getOpName();
+        if (op == "$sum"_sd) {
+            // Only a count can be computed from the number of measurements in a bucket.
+            auto constant = dynamic_cast<const ExpressionConstant*>(stmt.expr.argument.get());
+            if (!constant || constant->getValue().getType() != BSONType::NumberInt ||
+                constant->getValue().getInt() != 1) {
+                return false;
+            }
+            countFields.push_back(stmt.fieldName);
+            continue;
+        }
+        if (op != "$min"_sd && op != "$max"_sd) {
+            return false;
+        }
+
+        auto fieldPath = dynamic_cast<const ExpressionFieldPath*>(stmt.expr.argument.get());
+        if (!fieldPath || fieldPath->getVariableId() != Variables::kRootId ||
+            fieldPath->getFieldPath().getPathLength() < 2) {
+            return false;
+        }
+        auto field = fieldPath->getFieldPath().getFieldName(1);
+        if (spec.metaField && field == *spec.metaField) {
+            continue;
+        }
+        // The lower bound of the timeField is rounded down, and the bounds of an object field are
+        // not the bounds of its subfields.
+        if (fieldPath->getFieldPath().getPathLength() > 2 || field == spec.timeField ||
+            field == kBucketSummaryCountFieldName) {
+            return false;
+        }
+        fields.emplace_back(field);
+    }
+
+    setBucketSummarySpec(BSON("filter" << filter << "groupBy" << Value{std::move(groupBy)}
+                                        << "fields" << Value{std::move(fields)}));
+    if (countFields.empty()) {
+        return true;
+    }
+
+    // Count the measurements each summary stands for, and each unpacked measurement once.
+    MutableDocument groupSpec{
+        groupPtr->serialize().getDocument()[DocumentSourceGroup::kStageName].getDocument()};
+    const auto countPath = "$" + kBucketSummaryCountFieldName.toString();
+    for (auto&& field : countFields) {
+        groupSpec[field] = Value{DOC("$sum" << DOC("$ifNull" << DOC_ARRAY(countPath << 1)))};
+    }
+    *groupItr = DocumentSourceGroup::createFromBson(
+        BSON(DocumentSourceGroup::kStageName << groupSpec.freeze().toBson()).firstElement(),
+        pExpCtx);
+    return true;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -929,6 +1308,12 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // Check if we can avoid unpacking buckets which fall entirely within one group of a following
+    // $group, by summarizing them from their control fields.
+    if (!haveComputedMetaField) {
+        rewriteGroupToBucketSummaries(itr, container);
+    }
+
     return container->end();
 }
 }  // namespace mongo
@@ -33,8 +33,10 @@
 #include <vector>
 
 #include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/matcher/expression_leaf.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_match.h"
+#include "mongo/db/pipeline/expression.h"
 
 namespace mongo {
 class DocumentSourceInternalUnpackBucket : public DocumentSource {
@@ -42,6 +44,11 @@ public:
     static constexpr StringData kStageName = "$_internalUnpackBucket"_sd;
     static constexpr StringData kInclude = "include"_sd;
     static constexpr StringData kExclude = "exclude"_sd;
+    static constexpr StringData kBucketSummary = "bucketSummary"_sd;
+
+    // The field of a bucket summary holding the number of measurements it stands for. A $sum of 1
+    // is rewritten to a $sum of this field, defaulting to 1 for unpacked measurements.
+    static constexpr StringData kBucketSummaryCountFieldName = "_internalBucketSummaryCount"_sd;
 
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
@@ -151,11 +158,21 @@ public:
      *      {control.min.time: {$_internalExprLt: new Date(...)}}
      * ]}
      *
+     * Besides comparisons, conjunctions of them and the comparisons generated from an $expr, this
+     * maps a $in onto the range between its smallest and largest values, and a $or whose branches
+     * can all be mapped onto the $or of their mappings.
+     *
      * If the provided predicate is ineligible for this mapping, the function will return a nullptr.
      */
     std::unique_ptr<MatchExpression> createPredicatesOnBucketLevelField(
         const MatchExpression* matchExpr) const;
 
+    /**
+     * Maps a $in without regexes or null onto predicates requiring the bucket's bounds to overlap
+     * the range of its values. Returns nullptr if that is not possible.
+     */
+    std::unique_ptr<MatchExpression> createInPredicate(const InMatchExpression* matchExpr) const;
+
     /**
      * Sets the sample size to 'n' and the maximum number of measurements in a bucket to be
      * 'bucketMaxCount'. Calling this method implicitly changes the behavior from having the stage
@@ -195,9 +212,52 @@ public:
     std::pair<bool, Pipeline::SourceContainer::iterator> rewriteGroupByMinMax(
         Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container);
 
+    /**
+     * Checks if this stage is followed by an optional $match on the timeField and a $group whose
+     * result can be computed from the control fields of the buckets which lie entirely within one
+     * group and pass the $match. The $group key must take the same value on every measurement of a
+     * bucket as soon as it does on the bucket's bounds, and the accumulators must be $min or $max
+     * over top-level fields or the metaField, or a $sum of 1.
+     *
+     * If so, sets up this stage to replace such buckets by two summary documents built from
+     * control.min and control.max rather than unpacking them, rewrites each $sum of 1 to count the
+     * measurements a summary stands for and returns true.
+     */
+    bool rewriteGroupToBucketSummaries(Pipeline::SourceContainer::iterator itr,
+                                       Pipeline::SourceContainer* container);
+
 private:
+    // The state needed to decide whether a bucket can be summarized instead of being unpacked.
+    struct BucketSummarySpec {
+        // The $match between this stage and the $group, which a bucket must pass as a whole.
+        BSONObj filter;
+        std::unique_ptr<MatchExpression> filterExpr;
+
+        // The parts of the $group key, which must be equal on both bounds of a bucket.
+        std::vector<boost::intrusive_ptr<Expression>> groupBy;
+
+        // The fields accumulated with $min or $max, whose bounds must be scalars.
+        std::vector<std::string> fields;
+    };
+
     GetNextResult doGetNext() final;
 
+    /**
+     * Parses the serialized 'kBucketSummary' specification 'spec' into '_bucketSummarySpec'.
+     */
+    void setBucketSummarySpec(const BSONObj& spec);
+
+    /**
+     * Returns the two summary documents standing for the measurements of 'bucket', or boost::none
+     * if the bucket has to be unpacked.
+     */
+    boost::optional<std::pair<Document, Document>> summarizeBucket(const BSONObj& bucket) const;
+
+    /**
+     * Returns the next measurement of the bucket being unpacked.
+     */
+    Document getNextMeasurement();
+
     BucketUnpacker _bucketUnpacker;
     int _bucketMaxSpanSeconds;
 
@@ -209,5 +269,14 @@ private:
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
     bool _optimizedEndOfPipeline = false;
     bool _triedInternalizeProject = false;
+
+    boost::optional<BucketSummarySpec> _bucketSummarySpec;
+
+    // The second summary document of the last bucket summarized, to be returned next.
+    boost::optional<Document> _pendingBucketSummary;
+
+    // Whether the bucket being unpacked has a column named 'kBucketSummaryCountFieldName', which
+    // must be removed from its measurements so as not to be counted.
+    bool _stripBucketSummaryCountField = false;
 };
 }  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2020-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/query/util/make_data_structure.h"
+
+namespace mongo {
+namespace {
+
+using InternalUnpackBucketSummariesTest = AggregationContextFixture;
+
+auto optimizeAndSerialize(const std::vector<BSONObj>& stages,
+                          const boost::intrusive_ptr<ExpressionContext>& expCtx) {
+    auto pipeline = Pipeline::parse(stages, expCtx);
+    pipeline->optimizePipeline();
+    return pipeline->serializeToBson();
+}
+
+// Returns the specification of the $_internalUnpackBucket stage of 'serialized'.
+BSONElement findUnpack(const std::vector<BSONObj>& serialized) {
+    for (auto&& stage : serialized) {
+        if (auto unpack = stage[DocumentSourceInternalUnpackBucket::kStageName]) {
+            return unpack;
+        }
+    }
+    return {};
+}
+
+TEST_F(InternalUnpackBucketSummariesTest, RewritesGroupAfterTimeRangeMatch) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto matchSpecObj = fromjson("{$match: {time: {$gte: new Date(1000)}}}");
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: {m: '$myMeta.a', t: {$dateTrunc: {date: '$time', unit: 'hour'}}}, "
+        "lo: {$min: '$a'}, hi: {$max: '$b'}, n: {$sum: 1}}}");
+
+    auto serialized =
+        optimizeAndSerialize(makeVector(unpackSpecObj, matchSpecObj, groupSpecObj), getExpCtx());
+
+    auto unpack = findUnpack(serialized);
+    ASSERT_TRUE(unpack);
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{filter: {time: {$gte: new Date(1000)}}, groupBy: ['$myMeta.a', {$dateTrunc: "
+                 "{date: '$time', unit: {$const: 'hour'}}}], fields: ['a', 'b']}"),
+        unpack.Obj()[DocumentSourceInternalUnpackBucket::kBucketSummary].Obj());
+    ASSERT_BSONOBJ_EQ(
+        fromjson("{$group: {_id: {m: '$myMeta.a', t: {$dateTrunc: {date: '$time', unit: {$const: "
+                 "'hour'}}}}, lo: {$min: '$a'}, hi: {$max: '$b'}, n: {$sum: {$ifNull: "
+                 "['$_internalBucketSummaryCount', {$const: 1}]}}}}"),
+        serialized.back());
+}
+
+TEST_F(InternalUnpackBucketSummariesTest, DoesNotRewriteUnsuitableGroup) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    for (auto&& stages : {
+             // The $match is not on the timeField alone.
+             makeVector(unpackSpecObj,
+                        fromjson("{$match: {a: {$gt: 1}}}"),
+                        fromjson("{$group: {_id: '$myMeta', n: {$sum: 1}}}")),
+             // The $group key depends on a measurement field.
+             makeVector(unpackSpecObj, fromjson("{$group: {_id: '$a', n: {$sum: 1}}}")),
+             // The $group key is not monotonic in time.
+             makeVector(unpackSpecObj,
+                        fromjson("{$group: {_id: {$hour: '$time'}, n: {$sum: 1}}}")),
+             // The accumulators cannot be computed from the bucket bounds.
+             makeVector(unpackSpecObj, fromjson("{$group: {_id: '$myMeta', s: {$sum: '$a'}}}")),
+             makeVector(unpackSpecObj, fromjson("{$group: {_id: '$myMeta', n: {$sum: 2}}}")),
+             makeVector(unpackSpecObj, fromjson("{$group: {_id: null, lo: {$min: '$time'}}}")),
+             makeVector(unpackSpecObj, fromjson("{$group: {_id: null, lo: {$min: '$a.b'}}}")),
+         }) {
+        auto serialized = optimizeAndSerialize(stages, getExpCtx());
+        auto unpack = findUnpack(serialized);
+        ASSERT_TRUE(unpack);
+        ASSERT_FALSE(unpack.Obj().hasField(DocumentSourceInternalUnpackBucket::kBucketSummary))
+            << stages.back();
+    }
+}
+
+TEST_F(InternalUnpackBucketSummariesTest, SummarizesBucketsWithinOneGroup) {
+    auto spec = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'myMeta', "
+        "bucketMaxSpanSeconds: 3600, bucketSummary: {filter: {time: {$gte: new Date(10)}}, "
+        "groupBy: ['$myMeta'], fields: ['a']}}}");
+    auto unpack = DocumentSourceInternalUnpackBucket::createFromBson(spec.firstElement(),
+                                                                     getExpCtx());
+    auto source = DocumentSourceMock::createForTest(
+        {// Lies entirely within the filter.
+         "{control: {version: 1, min: {time: new Date(10), a: 1}, max: {time: new Date(20), "
+         "a: 5}}, meta: 'x', data: {time: {'0': new Date(10), '1': new Date(20)}, a: {'0': 1, "
+         "'1': 5}}}",
+         // Straddles the bound of the filter.
+         "{control: {version: 1, min: {time: new Date(0), a: 2}, max: {time: new Date(30), a: 2}}, "
+         "meta: 'y', data: {time: {'0': new Date(0), '1': new Date(30)}, a: {'0': 2, '1': 2}}}",
+         // Has bounds of a type which is not summarized, and a measurement field named like the
+         // count of a summary.
+         "{control: {version: 1, min: {time: new Date(40), a: 'p', _internalBucketSummaryCount: "
+         "7}, max: {time: new Date(40), a: 'p', _internalBucketSummaryCount: 7}}, meta: 'z', "
+         "data: {time: {'0': new Date(40)}, a: {'0': 'p'}, _internalBucketSummaryCount: {'0': "
+         "7}}}"},
+        getExpCtx());
+    unpack->setSource(source.get());
+
+    for (auto&& expected : {
+             "{time: new Date(10), a: 1, myMeta: 'x', _internalBucketSummaryCount: 2}",
+             "{time: new Date(20), a: 5, myMeta: 'x', _internalBucketSummaryCount: 0}",
+             "{time: new Date(0), myMeta: 'y', a: 2}",
+             "{time: new Date(30), myMeta: 'y', a: 2}",
+             "{time: new Date(40), myMeta: 'z', a: 'p'}",
+         }) {
+        auto next = unpack->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), Document(fromjson(expected)));
+    }
+    ASSERT_TRUE(unpack->getNext().isEOF());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -50,10 +50,15 @@ TEST_F(InternalUnpackBucketGroupReorder, OptimizeForCount) {
     // $count gets rewritten to $group + $project.
     ASSERT_EQ(3, serialized.size());
 
+    // Every bucket is counted from its size rather than unpacked.
     auto optimized = fromjson(
         "{$_internalUnpackBucket: { include: [], timeField: 't', metaField: 'meta', "
-        "bucketMaxSpanSeconds: 3600}}");
+        "bucketMaxSpanSeconds: 3600, bucketSummary: {filter: {}, groupBy: [{$const: null}], "
+        "fields: []}}}");
     ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
+    ASSERT_BSONOBJ_EQ(fromjson("{$group: {_id: {$const: null}, foo: {$sum: {$ifNull: "
+                               "['$_internalBucketSummaryCount', {$const: 1}]}}}}"),
+                      serialized[1]);
 }
 
 TEST_F(InternalUnpackBucketGroupReorder, OptimizeForCountNegative) {
@@ -184,14 +184,17 @@ TEST_F(OptimizePipeline, MetaMatchThenCountPushedDown) {
 
     pipeline->optimizePipeline();
 
-    // We should push down the $match and internalize the empty dependency set.
+    // We should push down the $match, internalize the empty dependency set and count the buckets
+    // from their size.
     auto serialized = pipeline->serializeToBson();
     ASSERT_EQ(4u, serialized.size());
     ASSERT_BSONOBJ_EQ(fromjson("{$match: {meta: {$eq: 'abc'}}}"), serialized[0]);
     ASSERT_BSONOBJ_EQ(fromjson("{$_internalUnpackBucket: { include: [], timeField: 'time', "
-                               "metaField: 'myMeta', bucketMaxSpanSeconds: 3600}}"),
+                               "metaField: 'myMeta', bucketMaxSpanSeconds: 3600, bucketSummary: "
+                               "{filter: {}, groupBy: [{$const: null}], fields: []}}}"),
                       serialized[1]);
-    ASSERT_BSONOBJ_EQ(fromjson("{$group: {_id: {$const: null}, foo: {$sum: {$const: 1}}}}"),
+    ASSERT_BSONOBJ_EQ(fromjson("{$group: {_id: {$const: null}, foo: {$sum: {$ifNull: "
+                               "['$_internalBucketSummaryCount', {$const: 1}]}}}}"),
                       serialized[2]);
     ASSERT_BSONOBJ_EQ(fromjson("{$project: {foo: true, _id: false}}"), serialized[3]);
 }
@@ -120,33 +120,6 @@ NamespaceString parseLookupFromAndResolveNamespace(const BSONElement& elem, Stri
     return nss;
 }
 
-/**
- * Checks if a sort stage's pattern is suitable to push the stage before $lookup. The sort stage
- * must not share the same prefix with any field created or modified by the lookup stage.
- */
-bool checkModifiedPathsSortReorder(const SortPattern& sortPattern,
-                                   const DocumentSource::GetModPathsReturn& modPaths) {
-    for (const auto& sortKey : sortPattern) {
-        if (!sortKey.fieldPath.has_value()) {
-            return false;
-        }
-        if (sortKey.fieldPath->getPathLength() < 1) {
-            return false;
-        }
-        auto sortField = sortKey.fieldPath->getFieldName(0);
-        auto it = std::find_if(
-            modPaths.paths.begin(), modPaths.paths.end(), [&sortField](const auto& modPath) {
-                // Finds if the shorter path is a prefix field of or the same as the longer one.
-                return sortField == modPath || expression::isPathPrefixOf(sortField, modPath) ||
-                    expression::isPathPrefixOf(modPath, sortField);
-            });
-        if (it != modPaths.paths.end()) {
-            return false;
-        }
-    }
-    return true;
-}
-
 }  // namespace
 
 DocumentSourceLookUp::DocumentSourceLookUp(NamespaceString fromNs,
@@ -332,6 +305,22 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    if (!_batch.empty()) {
+        auto inputDoc = std::move(_batch.front());
+        _batch.pop_front();
+        auto output = _batchTable ? lookupInTable(std::move(inputDoc), *_batchTable)
+                                  : lookupWithPipeline(std::move(inputDoc));
+        if (_batch.empty())
+            _batchTable.reset();
+        return output;
+    }
+
+    if (_batchEndResult) {
+        auto endResult = std::move(*_batchEndResult);
+        _batchEndResult.reset();
+        return endResult;
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
@@ -343,6 +332,23 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     // '_unwindSrc' would be non-null, and we would not have made it here.
     invariant(!_matchSrc);
 
+    if (isPlainEqualityJoin()) {
+        if (!_hashJoinTable && !_hashJoinAbandoned)
+            buildHashJoinTable(inputDoc);
+
+        if (_hashJoinTable)
+            return lookupInTable(std::move(inputDoc), *_hashJoinTable);
+
+        if (internalDocumentSourceLookupBatchSize.load() > 1) {
+            fillBatch(std::move(inputDoc));
+            return doGetNext();
+        }
+    }
+
+    return lookupWithPipeline(std::move(inputDoc));
+}
+
+Document DocumentSourceLookUp::lookupWithPipeline(Document inputDoc) {
     if (hasLocalFieldForeignFieldJoin()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -350,20 +356,7 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
-    try {
-        pipeline = buildPipeline(inputDoc);
-    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
-        // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
-        // throw a custom exception.
-        if (auto staleInfo = ex.extraInfo<StaleConfigInfo>()) {
-            uassert(51069,
-                    "Cannot run $lookup with sharded foreign collection",
-                    foreignShardedLookupAllowed() || !staleInfo->getVersionWanted() ||
-                        staleInfo->getVersionWanted() == ChunkVersion::UNSHARDED());
-        }
-        throw;
-    }
+    auto pipeline = buildPipelineCheckingShardedForeign(inputDoc);
 
     std::vector<Value> results;
     long long objsize = 0;
@@ -388,6 +381,128 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
     return output.freeze();
 }
 
+Document DocumentSourceLookUp::lookupInTable(Document inputDoc, const LookupForeignTable& table) {
+    auto matchStage =
+        makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
+    auto results = table.lookup(getLocalFieldValues(inputDoc), matchStage.firstElement().Obj());
+
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    for (const auto& result : results) {
+        long long safeSum = 0;
+        bool hasOverflowed = overflow::add(objsize, result.getApproximateSize(), &safeSum);
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+
+                !hasOverflowed && objsize <= maxBytes);
+        objsize = safeSum;
+    }
+
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+std::vector<Value> DocumentSourceLookUp::getLocalFieldValues(const Document& input) const {
+    std::vector<Value> values;
+    document_path_support::visitAllValuesAtPath(
+        input, *_localField, [&](const Value& nextValue) { values.push_back(nextValue); });
+
+    if (values.empty()) {
+        // Missing values are treated as null.
+        values.emplace_back(BSONNULL);
+    }
+    return values;
+}
+
+void DocumentSourceLookUp::buildHashJoinTable(const Document& inputDoc) {
+    const auto maxBytes = internalDocumentSourceLookupHashJoinMaxMemoryBytes.load();
+    if (maxBytes <= 0) {
+        _hashJoinAbandoned = true;
+        return;
+    }
+
+    // An empty $match reads the whole foreign collection.
+    _resolvedPipeline[*_fieldMatchPipelineIdx] = BSON("$match" << BSONObj());
+    auto pipeline = buildPipelineCheckingShardedForeign(inputDoc);
+
+    auto table = std::make_unique<LookupForeignTable>(_fromExpCtx, *_foreignField);
+    while (auto result = pipeline->getNext()) {
+        table->add(std::move(*result));
+        if (static_cast<long long>(table->sizeBytes()) > maxBytes) {
+            _hashJoinAbandoned = true;
+            break;
+        }
+    }
+
+    recordPlanSummaryStats(*pipeline);
+    if (!_hashJoinAbandoned) {
+        _hashJoinTable = std::move(table);
+    }
+}
+
+void DocumentSourceLookUp::fillBatch(Document inputDoc) {
+    invariant(_batch.empty());
+
+    const auto batchSize = static_cast<size_t>(internalDocumentSourceLookupBatchSize.load());
+    _batch.push_back(std::move(inputDoc));
+    while (_batch.size() < batchSize) {
+        auto nextInput = pSource->getNext();
+        if (!nextInput.isAdvanced()) {
+            _batchEndResult = std::move(nextInput);
+            break;
+        }
+        _batch.push_back(nextInput.releaseDocument());
+    }
+
+    // Match the foreign documents against the values of every document in the batch at once, then
+    // split the results between the documents of the batch.
+    std::vector<Value> batchValues;
+    for (const auto& doc : _batch) {
+        auto values = getLocalFieldValues(doc);
+        batchValues.insert(batchValues.end(), values.begin(), values.end());
+    }
+
+    static const FieldPath kBatchValuesPath("values");
+    const Document batchDoc{{kBatchValuesPath.fullPath(), Value(std::move(batchValues))}};
+    _resolvedPipeline[*_fieldMatchPipelineIdx] = makeMatchStageFromInput(
+        batchDoc, kBatchValuesPath, _foreignField->fullPath(), BSONObj());
+    auto pipeline = buildPipelineCheckingShardedForeign(_batch.front());
+
+    // The batch is bounded by the size allowed for the results of a single document.
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    auto table = std::make_unique<LookupForeignTable>(_fromExpCtx, *_foreignField);
+    while (auto result = pipeline->getNext()) {
+        table->add(std::move(*result));
+        if (static_cast<long long>(table->sizeBytes()) > maxBytes) {
+            table.reset();
+            break;
+        }
+    }
+
+    recordPlanSummaryStats(*pipeline);
+    _batchTable = std::move(table);
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter>
+DocumentSourceLookUp::buildPipelineCheckingShardedForeign(const Document& inputDoc) {
+    try {
+        return buildPipeline(inputDoc);
+    } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
+        // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
+        // throw a custom exception.
+        if (auto staleInfo = ex.extraInfo<StaleConfigInfo>()) {
+            uassert(51069,
+                    "Cannot run $lookup with sharded foreign collection",
+                    foreignShardedLookupAllowed() || !staleInfo->getVersionWanted() ||
+                        staleInfo->getVersionWanted() == ChunkVersion::UNSHARDED());
+        }
+        throw;
+    }
+}
+
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipeline(
     const Document& inputDoc) {
     // Copy all 'let' variables into the foreign pipeline's expression context.
@@ -474,8 +589,7 @@ Pipeline::SourceContainer::iterator DocumentSourceLookUp::doOptimizeAt(
     if (auto sortPtr = dynamic_cast<DocumentSourceSort*>(std::next(itr)->get())) {
         // TODO (SERVER-55417): Conditionally reorder $sort and $lookup depending on whether the
         // query planner allows for an index-provided sort.
-        if (!_unwindSrc &&
-            checkModifiedPathsSortReorder(sortPtr->getSortKeyPattern(), getModifiedPaths())) {
+        if (!_unwindSrc && sortPtr->canMoveBefore(getModifiedPaths())) {
             // We have a sort not on as field following this stage. Reorder sort and current doc.
             std::swap(*itr, *std::next(itr));
 
@@ -38,6 +38,7 @@
 #include "mongo/db/pipeline/document_source_unwind.h"
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/lite_parsed_pipeline.h"
+#include "mongo/db/pipeline/lookup_foreign_table.h"
 #include "mongo/db/pipeline/lookup_set_cache.h"
 
 namespace mongo {
@@ -253,6 +254,50 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Runs the foreign pipeline for 'inputDoc' and returns it with the results in the 'as' field.
+     */
+    Document lookupWithPipeline(Document inputDoc);
+
+    /**
+     * Returns 'inputDoc' with the documents of 'table' which join with it in the 'as' field.
+     */
+    Document lookupInTable(Document inputDoc, const LookupForeignTable& table);
+
+    /**
+     * Returns true if the foreign side only compares 'localField' to 'foreignField', with no view
+     * or sub-pipeline, so that the join can be answered from a LookupForeignTable.
+     */
+    bool isPlainEqualityJoin() const {
+        return hasLocalFieldForeignFieldJoin() && !_unwindSrc && _resolvedPipeline.size() == 1;
+    }
+
+    /**
+     * Returns the values of 'localField' in 'input' which the foreign documents are compared to.
+     * A missing value is treated as null.
+     */
+    std::vector<Value> getLocalFieldValues(const Document& input) const;
+
+    /**
+     * Reads the whole foreign collection into '_hashJoinTable', unless it exceeds
+     * 'internalDocumentSourceLookupHashJoinMaxMemoryBytes', in which case the hash join is
+     * abandoned for the rest of the operation.
+     */
+    void buildHashJoinTable(const Document& inputDoc);
+
+    /**
+     * Pulls up to 'internalDocumentSourceLookupBatchSize' input documents into '_batch', starting
+     * with 'inputDoc', and fetches the foreign documents which join with any of them in a single
+     * query.
+     */
+    void fillBatch(Document inputDoc);
+
+    /**
+     * Builds the foreign pipeline, reporting a sharded foreign collection when it is not allowed.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineCheckingShardedForeign(
+        const Document& inputDoc);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -342,6 +387,19 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // For a plain equality join, the whole foreign collection, when it fits within the hash join
+    // memory limit. It then answers the join for every input document.
+    std::unique_ptr<LookupForeignTable> _hashJoinTable;
+    bool _hashJoinAbandoned = false;
+
+    // Input documents whose foreign documents were fetched by a single query into '_batchTable',
+    // waiting to be returned. '_batchTable' is null if the results of the query exceeded the size
+    // limit, in which case each document runs its own query.
+    std::deque<Document> _batch;
+    std::unique_ptr<LookupForeignTable> _batchTable;
+    // The EOF or pause returned by the source while filling '_batch', returned once it is drained.
+    boost::optional<GetNextResult> _batchEndResult;
 };
 
 }  // namespace mongo
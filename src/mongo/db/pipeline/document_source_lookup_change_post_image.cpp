@@ -31,7 +31,10 @@
 
 #include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 
+#include <algorithm>
+
 #include "mongo/bson/simple_bsonelement_comparator.h"
+#include "mongo/db/query/query_knobs_gen.h"
 
 namespace mongo {
 
@@ -52,19 +55,46 @@ Value assertFieldHasType(const Document& fullDoc, StringData fieldName, BSONType
 }  // namespace
 
 DocumentSource::GetNextResult DocumentSourceLookupChangePostImage::doGetNext() {
+    if (_bufferedEvents.empty()) {
+        if (_pendingResult) {
+            auto pending = std::move(*_pendingResult);
+            _pendingResult = boost::none;
+            return pending;
+        }
+        if (auto notAdvanced = fillBuffer()) {
+            return std::move(*notAdvanced);
+        }
+        lookupPostImages();
+    }
+
+    auto next = std::move(_bufferedEvents.front());
+    _bufferedEvents.pop_front();
+    return next;
+}
+
+boost::optional<DocumentSource::GetNextResult> DocumentSourceLookupChangePostImage::fillBuffer() {
     auto input = pSource->getNext();
     if (!input.isAdvanced()) {
         return input;
     }
-    auto opTypeVal = assertFieldHasType(
-        input.getDocument(), DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
-    if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
-        return input;
-    }
 
-    MutableDocument output(input.releaseDocument());
-    output[kFullDocumentFieldName] = lookupPostImage(output.peek());
-    return output.freeze();
+    // Only read ahead events which are already available: a pause or EOF from the source ends the
+    // batch, and the batch is also bounded in size so that a burst of large events is not held in
+    // memory at once.
+    const size_t maxEvents = internalChangeStreamPostImageLookupBatchSize.load();
+    size_t bufferedBytes = input.getDocument().getApproximateSize();
+    _bufferedEvents.push_back(input.releaseDocument());
+    while (_bufferedEvents.size() < maxEvents &&
+           bufferedBytes < static_cast<size_t>(BSONObjMaxUserSize)) {
+        auto next = pSource->getNext();
+        if (!next.isAdvanced()) {
+            _pendingResult = std::move(next);
+            break;
+        }
+        bufferedBytes += next.getDocument().getApproximateSize();
+        _bufferedEvents.push_back(next.releaseDocument());
+    }
+    return boost::none;
 }
 
 NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
@@ -88,41 +118,83 @@ NamespaceString DocumentSourceLookupChangePostImage::assertValidNamespace(
     return nss;
 }
 
-Value DocumentSourceLookupChangePostImage::lookupPostImage(const Document& updateOp) const {
-    // Make sure we have a well-formed input.
-    auto nss = assertValidNamespace(updateOp);
-
-    auto documentKey = assertFieldHasType(updateOp,
-                                          DocumentSourceChangeStream::kDocumentKeyField,
-                                          BSONType::Object)
-                           .getDocument();
-
-    // Extract the UUID from resume token and do change stream lookups by UUID.
-    auto resumeToken =
-        ResumeToken::parse(updateOp[DocumentSourceChangeStream::kIdField].getDocument());
-
-    const auto readConcern = pExpCtx->inMongos
-        ? boost::optional<BSONObj>(BSON("level"
-                                        << "majority"
-                                        << "afterClusterTime" << resumeToken.getData().clusterTime))
-        : boost::none;
-
-
-    // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
-    // reads.
-    const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
-    invariant(resumeToken.getData().uuid);
-    auto lookedUpDoc =
-        pExpCtx->mongoProcessInterface->lookupSingleDocument(pExpCtx,
-                                                             nss,
-                                                             *resumeToken.getData().uuid,
-                                                             documentKey,
-                                                             readConcern,
-                                                             allowSpeculativeMajorityRead);
-
-    // Check whether the lookup returned any documents. Even if the lookup itself succeeded, it may
-    // not have returned any results if the document was deleted in the time since the update op.
-    return (lookedUpDoc ? Value(*lookedUpDoc) : Value(BSONNULL));
+void DocumentSourceLookupChangePostImage::lookupPostImages() {
+    // The updates to look up, grouped by the collection they apply to.
+    struct CollectionLookup {
+        NamespaceString nss;
+        UUID uuid;
+        Timestamp latestClusterTime;
+        std::vector<size_t> eventIndexes;
+        std::vector<Document> documentKeys;
+    };
+    std::vector<CollectionLookup> lookups;
+
+    for (size_t i = 0; i < _bufferedEvents.size(); ++i) {
+        const auto& event = _bufferedEvents[i];
+        auto opTypeVal = assertFieldHasType(
+            event, DocumentSourceChangeStream::kOperationTypeField, BSONType::String);
+        if (opTypeVal.getString() != DocumentSourceChangeStream::kUpdateOpType) {
+            continue;
+        }
+
+        // Make sure we have a well-formed input.
+        auto nss = assertValidNamespace(event);
+
+        auto documentKey = assertFieldHasType(event,
+                                              DocumentSourceChangeStream::kDocumentKeyField,
+                                              BSONType::Object)
+                               .getDocument();
+
+        // Extract the UUID from resume token and do change stream lookups by UUID.
+        auto resumeToken =
+            ResumeToken::parse(event[DocumentSourceChangeStream::kIdField].getDocument());
+        invariant(resumeToken.getData().uuid);
+        const auto& uuid = *resumeToken.getData().uuid;
+
+        auto lookup = std::find_if(lookups.begin(), lookups.end(), [&](const auto& candidate) {
+            return candidate.uuid == uuid && candidate.nss == nss;
+        });
+        if (lookup == lookups.end()) {
+            lookups.push_back({nss, uuid, Timestamp(), {}, {}});
+            lookup = std::prev(lookups.end());
+        }
+        lookup->latestClusterTime =
+            std::max(lookup->latestClusterTime, resumeToken.getData().clusterTime);
+        lookup->eventIndexes.push_back(i);
+        lookup->documentKeys.push_back(std::move(documentKey));
+    }
+
+    for (auto&& lookup : lookups) {
+        // On mongos, read at least as late as the latest update in the batch. Every post-image is
+        // the current version of its document, so it is no older than its own update.
+        const auto readConcern = pExpCtx->inMongos
+            ? boost::optional<BSONObj>(BSON("level"
+                                            << "majority"
+                                            << "afterClusterTime" << lookup.latestClusterTime))
+            : boost::none;
+
+        // Update lookup queries sent from mongoS to shards are allowed to use speculative majority
+        // reads.
+        const auto allowSpeculativeMajorityRead = pExpCtx->inMongos;
+        auto lookedUpDocs = pExpCtx->mongoProcessInterface->lookupDocuments(
+            pExpCtx,
+            lookup.nss,
+            lookup.uuid,
+            lookup.documentKeys,
+            readConcern,
+            allowSpeculativeMajorityRead);
+        invariant(lookedUpDocs.size() == lookup.eventIndexes.size());
+
+        for (size_t i = 0; i < lookedUpDocs.size(); ++i) {
+            // Even if the lookup itself succeeded, it may not have returned a document if the
+            // document was deleted in the time since the update op.
+            auto& event = _bufferedEvents[lookup.eventIndexes[i]];
+            MutableDocument output(std::move(event));
+            output[kFullDocumentFieldName] =
+                (lookedUpDocs[i] ? Value(*lookedUpDocs[i]) : Value(BSONNULL));
+            event = output.freeze();
+        }
+    }
 }
 
 }  // namespace mongo
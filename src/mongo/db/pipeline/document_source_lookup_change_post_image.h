@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
 
@@ -37,6 +39,11 @@ namespace mongo {
 /**
  * Part of the change stream API machinery used to look up the post-image of a document. Uses the
  * "documentKey" field of the input to look up the new version of the document.
+ *
+ * Rather than looking up each post-image as its event is returned, this stage reads ahead up to
+ * 'internalChangeStreamPostImageLookupBatchSize' events which are already available from its source
+ * and looks up the post-images of all of their updates together, with one lookup per collection.
+ * The buffered events are then returned in their original order.
  */
 class DocumentSourceLookupChangePostImage final : public DocumentSource {
 public:
@@ -105,20 +112,38 @@ public:
         return kStageName.rawData();
     }
 
+    /**
+     * Returns true if this stage has read events from its source which it has not yet returned.
+     * While this is the case, a resume token taken from the source would be ahead of the events
+     * that this stage has returned.
+     */
+    bool hasBufferedEvents() const {
+        return !_bufferedEvents.empty();
+    }
+
 private:
     DocumentSourceLookupChangePostImage(const boost::intrusive_ptr<ExpressionContext>& expCtx)
         : DocumentSource(kStageName, expCtx) {}
 
     /**
-     * Performs the lookup to retrieve the full document.
+     * Returns the next buffered event, refilling the buffer from the source and performing the
+     * lookups for the new batch of events when it is empty.
      */
     GetNextResult doGetNext() final;
 
     /**
-     * Uses the "documentKey" field from 'updateOp' to look up the current version of the document.
-     * Returns Value(BSONNULL) if the document couldn't be found.
+     * Reads the next batch of events from the source into '_bufferedEvents', stopping early at the
+     * first result which is not an event. Returns that result if the batch is empty, and otherwise
+     * saves it in '_pendingResult' to be returned once the batch has been returned.
      */
-    Value lookupPostImage(const Document& updateOp) const;
+    boost::optional<GetNextResult> fillBuffer();
+
+    /**
+     * Uses the "documentKey" field of each update in '_bufferedEvents' to look up the current
+     * version of the document, and stores it in the event's "fullDocument" field. Stores
+     * Value(BSONNULL) if the document couldn't be found.
+     */
+    void lookupPostImages();
 
     /**
      * Throws a AssertionException if the namespace found in 'inputDoc' doesn't match the one on the
@@ -126,6 +151,13 @@ private:
      * function verifies that the only the database names match.
      */
     NamespaceString assertValidNamespace(const Document& inputDoc) const;
+
+    // Events read from the source which have not yet been returned, in their original order.
+    std::deque<Document> _bufferedEvents;
+
+    // A non-advanced result which ended the current batch. It is returned after the last buffered
+    // event, so that pauses and EOF keep their position in the stream.
+    boost::optional<GetNextResult> _pendingResult;
 };
 
 }  // namespace mongo
@@ -45,6 +45,8 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/field_path.h"
 #include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -334,5 +336,153 @@ TEST_F(DocumentSourceLookupChangePostImageTest, ShouldPropagatePauses) {
     ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
 }
 
+/**
+ * Counts the calls to lookupDocuments(), which otherwise looks up each key in the mock collection.
+ */
+class CountingMockMongoInterface final : public MockMongoInterface {
+public:
+    using MockMongoInterface::MockMongoInterface;
+
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead) final {
+        ++numLookupCalls;
+        numLookedUpKeys += documentKeys.size();
+        return MockMongoInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+
+    int numLookupCalls = 0;
+    size_t numLookedUpKeys = 0;
+};
+
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldLookUpConsecutiveUpdatesTogether) {
+    auto expCtx = getExpCtx();
+    const Document nsDoc{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}};
+
+    // Set up the lookup change post image stage.
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+
+    // Mock its input with two updates, an insert and a third update, followed by a pause. The
+    // second update's document no longer exists.
+    auto mockLocalSource = DocumentSourceMock::createForTest(
+        {Document{{"_id", makeResumeToken(0)},
+                  {"documentKey", Document{{"_id", 0}}},
+                  {"operationType", "update"_sd},
+                  {"ns", nsDoc}},
+         Document{{"_id", makeResumeToken(5)},
+                  {"documentKey", Document{{"_id", 5}}},
+                  {"operationType", "update"_sd},
+                  {"ns", nsDoc}},
+         Document{{"_id", makeResumeToken(1)},
+                  {"documentKey", Document{{"_id", 1}}},
+                  {"operationType", "insert"_sd},
+                  {"ns", nsDoc},
+                  {"fullDocument", Document{{"_id", 1}}}},
+         Document{{"_id", makeResumeToken(1)},
+                  {"documentKey", Document{{"_id", 1}}},
+                  {"operationType", "update"_sd},
+                  {"ns", nsDoc}},
+         DocumentSource::GetNextResult::makePauseExecution()},
+        expCtx);
+
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    // Mock out the foreign collection.
+    auto mongoInterface = std::make_unique<CountingMockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{Document{{"_id", 0}, {"x", 0}},
+                                             Document{{"_id", 1}, {"x", 1}}});
+    auto* counter = mongoInterface.get();
+    getExpCtx()->mongoProcessInterface = std::move(mongoInterface);
+
+    auto next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", makeResumeToken(0)},
+                                 {"documentKey", Document{{"_id", 0}}},
+                                 {"operationType", "update"_sd},
+                                 {"ns", nsDoc},
+                                 {"fullDocument", Document{{"_id", 0}, {"x", 0}}}}));
+
+    // All three updates were looked up together when the first event was returned.
+    ASSERT_EQ(counter->numLookupCalls, 1);
+    ASSERT_EQ(counter->numLookedUpKeys, 3u);
+    ASSERT_TRUE(lookupChangeStage->hasBufferedEvents());
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", makeResumeToken(5)},
+                                 {"documentKey", Document{{"_id", 5}}},
+                                 {"operationType", "update"_sd},
+                                 {"ns", nsDoc},
+                                 {"fullDocument", BSONNULL}}));
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", makeResumeToken(1)},
+                                 {"documentKey", Document{{"_id", 1}}},
+                                 {"operationType", "insert"_sd},
+                                 {"ns", nsDoc},
+                                 {"fullDocument", Document{{"_id", 1}}}}));
+
+    next = lookupChangeStage->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", makeResumeToken(1)},
+                                 {"documentKey", Document{{"_id", 1}}},
+                                 {"operationType", "update"_sd},
+                                 {"ns", nsDoc},
+                                 {"fullDocument", Document{{"_id", 1}, {"x", 1}}}}));
+    ASSERT_FALSE(lookupChangeStage->hasBufferedEvents());
+
+    // The pause which ended the batch is returned after its events.
+    ASSERT_TRUE(lookupChangeStage->getNext().isPaused());
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+    ASSERT_EQ(counter->numLookupCalls, 1);
+}
+
+TEST_F(DocumentSourceLookupChangePostImageTest, ShouldNotReadAheadMoreThanTheBatchSize) {
+    auto expCtx = getExpCtx();
+    const Document nsDoc{{"db", expCtx->ns.db()}, {"coll", expCtx->ns.coll()}};
+
+    const auto originalBatchSize = internalChangeStreamPostImageLookupBatchSize.load();
+    internalChangeStreamPostImageLookupBatchSize.store(2);
+    ON_BLOCK_EXIT([&] { internalChangeStreamPostImageLookupBatchSize.store(originalBatchSize); });
+
+    auto lookupChangeStage = DocumentSourceLookupChangePostImage::create(expCtx);
+    std::deque<DocumentSource::GetNextResult> events;
+    for (int i = 0; i < 3; ++i) {
+        events.push_back(Document{{"_id", makeResumeToken(i)},
+                                  {"documentKey", Document{{"_id", i}}},
+                                  {"operationType", "update"_sd},
+                                  {"ns", nsDoc}});
+    }
+    auto mockLocalSource = DocumentSourceMock::createForTest(std::move(events), expCtx);
+    lookupChangeStage->setSource(mockLocalSource.get());
+
+    auto mongoInterface = std::make_unique<CountingMockMongoInterface>(
+        deque<DocumentSource::GetNextResult>{
+            Document{{"_id", 0}}, Document{{"_id", 1}}, Document{{"_id", 2}}});
+    auto* counter = mongoInterface.get();
+    getExpCtx()->mongoProcessInterface = std::move(mongoInterface);
+
+    for (int i = 0; i < 3; ++i) {
+        auto next = lookupChangeStage->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_VALUE_EQ(next.getDocument()["fullDocument"], Value(Document{{"_id", i}}));
+    }
+    ASSERT_TRUE(lookupChangeStage->getNext().isEOF());
+
+    // The first two updates were looked up together and the third on its own.
+    ASSERT_EQ(counter->numLookupCalls, 2);
+    ASSERT_EQ(counter->numLookedUpKeys, 3u);
+}
+
 }  // namespace
 }  // namespace mongo
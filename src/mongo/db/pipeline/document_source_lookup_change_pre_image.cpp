@@ -44,6 +44,12 @@ namespace mongo {
 constexpr StringData DocumentSourceLookupChangePreImage::kStageName;
 constexpr StringData DocumentSourceLookupChangePreImage::kFullDocumentBeforeChangeFieldName;
 
+namespace {
+// The _id of a document in the pre-images collection is {nsUUID: <UUID>, ts: <Timestamp>}.
+constexpr StringData kPreImageIdNsUUIDFieldName = "nsUUID"_sd;
+constexpr StringData kPreImageFieldName = "preImage"_sd;
+}  // namespace
+
 boost::intrusive_ptr<DocumentSourceLookupChangePreImage> DocumentSourceLookupChangePreImage::create(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const DocumentSourceChangeStreamSpec& spec) {
@@ -82,9 +88,17 @@ DocumentSource::GetNextResult DocumentSourceLookupChangePreImage::doGetNext() {
         return input;
     }
 
-    // Look up the pre-image using the optime. This may return boost::none if it was not found.
-    auto preImageOpTime = repl::OpTime::parse(preImageOpTimeVal.getDocument().toBson());
-    auto preImageDoc = lookupPreImage(input.getDocument(), preImageOpTime);
+    // The transform stage populates the field with the _id of the pre-image if it was recorded in
+    // the pre-images collection, or with the optime of the pre-image oplog entry otherwise. Either
+    // lookup may return boost::none if the pre-image was not found.
+    boost::optional<Document> preImageDoc;
+    if (!preImageOpTimeVal.getDocument()[kPreImageIdNsUUIDFieldName].missing()) {
+        preImageDoc = lookupPreImageFromPreImagesCollection(input.getDocument(),
+                                                            preImageOpTimeVal.getDocument());
+    } else {
+        auto preImageOpTime = repl::OpTime::parse(preImageOpTimeVal.getDocument().toBson());
+        preImageDoc = lookupPreImage(input.getDocument(), preImageOpTime);
+    }
 
     // Even if no pre-image was found, we have to replace the 'fullDocumentBeforeChange' field.
     MutableDocument outputDoc(input.releaseDocument());
@@ -134,4 +148,40 @@ boost::optional<Document> DocumentSourceLookupChangePreImage::lookupPreImage(
     return Document{opLogEntry.getObject().getOwned()};
 }
 
+boost::optional<Document> DocumentSourceLookupChangePreImage::lookupPreImageFromPreImagesCollection(
+    const Document& inputDoc, const Document& preImageId) const {
+    const auto& preImagesNss = NamespaceString::kChangeStreamPreImagesNamespace;
+    auto preImagesCollectionInfo =
+        pExpCtx->mongoProcessInterface->getCollectionOptions(pExpCtx->opCtx, preImagesNss);
+
+    // The pre-images collection is created on startup, but may be missing on a node which has not
+    // recorded any pre-images, in which case the pre-image is treated as not found.
+    boost::optional<Document> lookedUpDoc;
+    if (auto uuidElem = preImagesCollectionInfo["uuid"]) {
+        lookedUpDoc = pExpCtx->mongoProcessInterface->lookupSingleDocument(
+            pExpCtx,
+            preImagesNss,
+            invariantStatusOK(UUID::parse(uuidElem)),
+            Document{{"_id", preImageId}},
+            boost::none);
+    }
+
+    // Pre-images are removed from the collection along with the oplog entries they belong to.
+    if (!lookedUpDoc) {
+        uassert(
+            ErrorCodes::ChangeStreamHistoryLost,
+            str::stream()
+                << "Change stream was configured to require a pre-image for all update, delete and "
+                   "replace events, but the pre-image was not found in the pre-images collection "
+                   "for event: "
+                << inputDoc.toString(),
+            _fullDocumentBeforeChangeMode != FullDocumentBeforeChangeModeEnum::kRequired);
+        return boost::none;
+    }
+
+    auto preImage = (*lookedUpDoc)[kPreImageFieldName];
+    invariant(preImage.getType() == BSONType::Object);
+    return preImage.getDocument();
+}
+
 }  // namespace mongo
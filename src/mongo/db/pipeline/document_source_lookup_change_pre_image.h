@@ -122,6 +122,14 @@ private:
     boost::optional<Document> lookupPreImage(const Document& inputDoc,
                                              const repl::OpTime& opTime) const;
 
+    /**
+     * Looks up and returns the pre-image with the given '_id' in the pre-images collection.
+     * Returns boost::none if the mode is "kWhenAvailable" and the pre-image was not found, and
+     * throws if the mode is "kRequired" and the pre-image was not found.
+     */
+    boost::optional<Document> lookupPreImageFromPreImagesCollection(
+        const Document& inputDoc, const Document& preImageId) const;
+
     // Determines whether pre-images are strictly required or may be included only when available.
     FullDocumentBeforeChangeModeEnum _fullDocumentBeforeChangeMode =
         FullDocumentBeforeChangeModeEnum::kOff;
@@ -35,13 +35,21 @@
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <list>
 #include <map>
 
+#include "mongo/bson/simple_bsonobj_comparator.h"
+#include "mongo/db/client.h"
 #include "mongo/db/curop_failpoint_helpers.h"
+#include "mongo/db/operation_time_tracker.h"
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/variable_validation.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 
 namespace mongo {
 using namespace fmt::literals;
@@ -546,13 +554,227 @@ std::pair<DocumentSourceMerge::BatchObject, int> DocumentSourceMerge::makeBatchO
     return {{std::move(mergeOnFields), std::move(mod), std::move(vars)}, modSize};
 }
 
-void DocumentSourceMerge::spill(BatchedObjects&& batch) try {
+/**
+ * Writes the batches of a $merge on threads of their own, each with its own Client and
+ * OperationContext, so that the stage can build its next batch, and write it, while earlier
+ * batches are still on their way to the shards. Batches are partitioned by shard, using the
+ * routing table of the output collection, by the router code path each write goes through.
+ *
+ * Two batches which contain the same value of the 'on' fields are never in flight at the same
+ * time, so each target document is still written in the order of the input. The values are
+ * compared without a collation, so this ordering is not kept for values which are equal only
+ * under the collation of the output collection.
+ */
+class DocumentSourceMerge::ConcurrentBatchWriter {
+public:
+    explicit ConcurrentBatchWriter(const DocumentSourceMerge* stage) : _stage(stage) {}
+
+    ~ConcurrentBatchWriter() {
+        _recordFailure({ErrorCodes::Interrupted, "$merge stage destroyed with writes in flight"});
+        for (auto&& batch : _inFlight) {
+            batch.thread.join();
+        }
+    }
+
+    /**
+     * Starts writing 'batch' using a copy 'expCtx' of the stage's ExpressionContext, once fewer
+     * than 'maxInFlight' batches are in flight and none of them shares a target document with
+     * 'batch'. Throws the error of any batch which has failed.
+     */
+    void write(OperationContext* opCtx,
+               boost::intrusive_ptr<ExpressionContext> expCtx,
+               BatchedObjects&& batch,
+               size_t maxInFlight) {
+        SimpleBSONObjUnorderedSet keys;
+        for (auto&& obj : batch) {
+            keys.insert(std::get<0>(obj));
+        }
+
+        stdx::unique_lock<Latch> lk(_mutex);
+        _waitUntil(opCtx, lk, [&] {
+            size_t numRunning = 0;
+            for (auto&& inFlight : _inFlight) {
+                if (inFlight.done) {
+                    continue;
+                }
+                ++numRunning;
+                if (std::any_of(inFlight.keys.begin(), inFlight.keys.end(), [&](auto&& key) {
+                        return keys.count(key) > 0;
+                    })) {
+                    return false;
+                }
+            }
+            return numRunning < maxInFlight;
+        });
+
+        auto& inFlight = _inFlight.emplace_back(std::move(keys));
+        try {
+            inFlight.thread = stdx::thread([this,
+                                            &inFlight,
+                                            expCtx = std::move(expCtx),
+                                            batch = std::move(batch),
+                                            service = opCtx->getServiceContext()]() mutable {
+                _runWriter(service, &inFlight, std::move(expCtx), std::move(batch));
+            });
+        } catch (const std::exception& ex) {
+            _inFlight.pop_back();
+            uasserted(ErrorCodes::InternalError,
+                      str::stream() << "Failed to start a $merge writer thread: " << ex.what());
+        }
+    }
+
+    /**
+     * Waits for all batches in flight to be written and throws the error of any which failed.
+     */
+    void waitForAll(OperationContext* opCtx) {
+        stdx::unique_lock<Latch> lk(_mutex);
+        _waitUntil(opCtx, lk, [&] {
+            return std::all_of(_inFlight.begin(), _inFlight.end(), [](auto&& inFlight) {
+                return inFlight.done;
+            });
+        });
+    }
+
+private:
+    struct InFlightBatch {
+        explicit InFlightBatch(SimpleBSONObjUnorderedSet keys) : keys(std::move(keys)) {}
+
+        // The values of the 'on' fields of the documents in the batch.
+        const SimpleBSONObjUnorderedSet keys;
+
+        stdx::thread thread;
+
+        // Set while the batch is being written, so that it can be interrupted.
+        OperationContext* opCtx = nullptr;
+
+        // Set once the writer thread has nothing left to do but exit.
+        bool done = false;
+
+        // The greatest operation time of the cluster seen by the writes of the batch.
+        LogicalTime operationTime;
+    };
+
+    void _runWriter(ServiceContext* service,
+                    InFlightBatch* inFlight,
+                    boost::intrusive_ptr<ExpressionContext> expCtx,
+                    BatchedObjects&& batch) {
+        {
+            ThreadClient tc("merge-writer", service);
+            auto writerOpCtx = cc().makeOperationContext();
+            expCtx->opCtx = writerOpCtx.get();
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                inFlight->opCtx = writerOpCtx.get();
+                if (!_firstError.isOK()) {
+                    stdx::lock_guard<Client> clientLock(*writerOpCtx->getClient());
+                    service->killOperation(clientLock, writerOpCtx.get());
+                }
+            }
+
+            try {
+                _stage->writeBatch(expCtx, std::move(batch));
+            } catch (const DBException& ex) {
+                _recordFailure(ex.toStatus());
+            }
+
+            stdx::lock_guard<Latch> lk(_mutex);
+            inFlight->opCtx = nullptr;
+            inFlight->operationTime =
+                OperationTimeTracker::get(writerOpCtx.get())->getMaxOperationTime();
+            inFlight->done = true;
+        }
+        _batchDone.notify_all();
+    }
+
+    /**
+     * Waits on 'opCtx' until 'pred' holds, then joins the threads of the batches which are done,
+     * carrying their operation times over to 'opCtx'. Throws the first error of any batch, or the
+     * error which interrupted the wait after interrupting the batches in flight.
+     */
+    template <typename Pred>
+    void _waitUntil(OperationContext* opCtx, stdx::unique_lock<Latch>& lk, Pred pred) {
+        try {
+            opCtx->waitForConditionOrInterrupt(
+                _batchDone, lk, [&] { return !_firstError.isOK() || pred(); });
+        } catch (const DBException& ex) {
+            lk.unlock();
+            _recordFailure(ex.toStatus());
+            throw;
+        }
+        uassertStatusOK(_firstError);
+
+        for (auto it = _inFlight.begin(); it != _inFlight.end();) {
+            if (!it->done) {
+                ++it;
+                continue;
+            }
+            it->thread.join();
+            OperationTimeTracker::get(opCtx)->updateOperationTime(it->operationTime);
+            it = _inFlight.erase(it);
+        }
+    }
+
+    /**
+     * Records the first error hit by any batch and interrupts the batches in flight.
+     */
+    void _recordFailure(Status status) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            if (_firstError.isOK()) {
+                _firstError = std::move(status);
+            }
+
+            for (auto&& inFlight : _inFlight) {
+                if (inFlight.opCtx) {
+                    stdx::lock_guard<Client> clientLock(*inFlight.opCtx->getClient());
+                    inFlight.opCtx->getServiceContext()->killOperation(clientLock, inFlight.opCtx);
+                }
+            }
+        }
+        _batchDone.notify_all();
+    }
+
+    const DocumentSourceMerge* const _stage;
+
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceMerge::ConcurrentBatchWriter::_mutex");
+    stdx::condition_variable _batchDone;
+    std::list<InFlightBatch> _inFlight;
+    Status _firstError = Status::OK();
+};
+
+DocumentSourceMerge::~DocumentSourceMerge() = default;
+
+void DocumentSourceMerge::spill(BatchedObjects&& batch) {
+    const size_t maxInFlight = internalDocumentSourceMergeMaxConcurrentWriteBatches.load();
+    if (maxInFlight > 1 && pExpCtx->mongoProcessInterface->writesAreRouted()) {
+        if (!_concurrentWriter) {
+            _concurrentWriter = std::make_unique<ConcurrentBatchWriter>(this);
+        }
+        _concurrentWriter->write(
+            pExpCtx->opCtx, pExpCtx->copyWith(pExpCtx->ns), std::move(batch), maxInFlight);
+        return;
+    }
+
+    // The limit may have been lowered since the last batch was spilled.
+    waitForSpilledBatches();
+
     DocumentSourceWriteBlock writeBlock(pExpCtx->opCtx);
+    writeBatch(pExpCtx, std::move(batch));
+}
+
+void DocumentSourceMerge::waitForSpilledBatches() {
+    if (_concurrentWriter) {
+        _concurrentWriter->waitForAll(pExpCtx->opCtx);
+    }
+}
+
+void DocumentSourceMerge::writeBatch(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                     BatchedObjects&& batch) const try {
     auto targetEpoch = _targetCollectionVersion
         ? boost::optional<OID>(_targetCollectionVersion->epoch())
         : boost::none;
 
-    _descriptor.strategy(pExpCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
+    _descriptor.strategy(expCtx, _outputNs, _writeConcern, targetEpoch, std::move(batch));
 } catch (const ExceptionFor<ErrorCodes::ImmutableField>& ex) {
     uassertStatusOKWithContext(ex.toStatus(),
                                "$merge failed to update the matching document, did you "
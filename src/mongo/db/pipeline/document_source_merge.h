@@ -104,7 +104,7 @@ public:
         MergeWhenNotMatchedModeEnum _whenNotMatched;
     };
 
-    virtual ~DocumentSourceMerge() = default;
+    virtual ~DocumentSourceMerge();
 
     const char* getSourceName() const final {
         return kStageName.rawData();
@@ -140,6 +140,9 @@ public:
     }
 
 private:
+    // Writes batches on threads of their own; see document_source_merge.cpp.
+    class ConcurrentBatchWriter;
+
     /**
      * Builds a new $merge stage which will merge all documents into 'outputNs'. If
      * 'targetCollectionVersion' is provided then processing will stop with an error if the
@@ -184,6 +187,15 @@ private:
 
     void spill(BatchedObjects&& batch) override;
 
+    void waitForSpilledBatches() override;
+
+    /**
+     * Writes 'batch' to the output namespace on the calling thread, using 'expCtx' for its
+     * OperationContext.
+     */
+    void writeBatch(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                    BatchedObjects&& batch) const;
+
     void waitWhileFailPointEnabled() override;
 
     std::pair<BatchObject, int> makeBatchObject(Document&& doc) const override;
@@ -214,6 +226,10 @@ private:
     // True if '_mergeOnFields' contains the _id. We store this as a separate boolean to avoid
     // repeated lookups into the set.
     bool _mergeOnFieldsIncludesId;
+
+    // Created by the first batch spilled while several batches may be in flight at once. Only
+    // used when the writes go through the router.
+    std::unique_ptr<ConcurrentBatchWriter> _concurrentWriter;
 };
 
 }  // namespace mongo
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_operation_latency_histograms.h"
+
+#include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/stats/command_latency_histograms.h"
+
+namespace mongo {
+
+using boost::intrusive_ptr;
+
+REGISTER_DOCUMENT_SOURCE(operationLatencyHistograms,
+                         DocumentSourceOperationLatencyHistograms::LiteParsed::parse,
+                         DocumentSourceOperationLatencyHistograms::createFromBson,
+                         LiteParsedDocumentSource::AllowedWithApiStrict::kNeverInVersion1);
+
+namespace {
+static constexpr StringData kHistograms = "histograms"_sd;
+}  // namespace
+
+DocumentSource::GetNextResult DocumentSourceOperationLatencyHistograms::doGetNext() {
+    if (!_populated) {
+        auto entries =
+            CommandLatencyHistograms::get(pExpCtx->opCtx->getServiceContext()).getSnapshot();
+        for (const auto& entry : entries) {
+            BSONObjBuilder builder;
+            if (!entry.nss.isEmpty()) {
+                builder.append("ns", entry.nss.ns());
+            }
+            builder.append("command", entry.command);
+            entry.histogram.append(_includeHistograms, &builder);
+            _results.push_back(builder.obj());
+        }
+
+        _resultsIter = _results.begin();
+        _populated = true;
+    }
+
+    if (_resultsIter != _results.end()) {
+        auto doc = Document(*_resultsIter);
+        _resultsIter++;
+        return doc;
+    }
+
+    return GetNextResult::makeEOF();
+}
+
+intrusive_ptr<DocumentSource> DocumentSourceOperationLatencyHistograms::createFromBson(
+    BSONElement elem, const intrusive_ptr<ExpressionContext>& pExpCtx) {
+    const NamespaceString& nss = pExpCtx->ns;
+    uassert(ErrorCodes::InvalidNamespace,
+            str::stream() << kStageName
+                          << " must be run against the 'admin' database with {aggregate: 1}",
+            nss.db() == NamespaceString::kAdminDb && nss.isCollectionlessAggregateNS());
+
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "The " << kStageName << " stage specification must be an object",
+            elem.type() == Object);
+
+    auto stageObj = elem.Obj();
+    bool includeHistograms = false;
+    if (auto histogramsElem = stageObj.getField(kHistograms); !histogramsElem.eoo()) {
+        includeHistograms = histogramsElem.trueValue();
+    }
+    uassert(ErrorCodes::BadValue,
+            str::stream() << "The " << kStageName
+                          << " stage specification must be empty or contain only '" << kHistograms
+                          << "'",
+            stageObj.nFields() <= (stageObj.hasField(kHistograms) ? 1 : 0));
+    return new DocumentSourceOperationLatencyHistograms(pExpCtx, includeHistograms);
+}
+
+Value DocumentSourceOperationLatencyHistograms::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(DOC(getSourceName() << DOC(kHistograms << _includeHistograms)));
+}
+
+}  // namespace mongo
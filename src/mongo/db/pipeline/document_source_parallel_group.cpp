@@ -0,0 +1,304 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/document_source_parallel_group.h"
+
+#include <algorithm>
+
+#include "mongo/db/client.h"
+#include "mongo/db/pipeline/document_source_add_fields.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_project.h"
+#include "mongo/db/pipeline/expression.h"
+#include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+
+constexpr StringData DocumentSourceParallelGroup::kGroupKeyField;
+
+bool DocumentSourceParallelGroup::parallelizeIfPossible(Pipeline* pipeline, size_t numWorkers) {
+    const auto& expCtx = pipeline->getContext();
+    auto& sources = pipeline->getSources();
+
+    // The documents are routed by the hash of their group key, which only keeps together the keys
+    // that the $group considers equal under the simple collation.
+    if (numWorkers < 2 || expCtx->getCollator()) {
+        return false;
+    }
+
+    auto groupIt = std::find_if(sources.begin(), sources.end(), [](const auto& stage) {
+        return dynamic_cast<DocumentSourceGroup*>(stage.get());
+    });
+    if (groupIt == sources.begin() || groupIt == sources.end()) {
+        return false;
+    }
+    auto group = static_cast<DocumentSourceGroup*>(groupIt->get());
+
+    // A constant key puts every document into the same group, which leaves nothing to split.
+    auto idFields = group->getIdFields();
+    if (std::all_of(idFields.begin(), idFields.end(), [](const auto& idField) {
+            return dynamic_cast<ExpressionConstant*>(idField.second.get());
+        })) {
+        return false;
+    }
+
+    DepsTracker deps;
+    group->getDependencies(&deps);
+    if (std::any_of(deps.fields.begin(), deps.fields.end(), [](const auto& field) {
+            return StringData(field).startsWith(kGroupKeyField);
+        })) {
+        return false;
+    }
+
+    // The $group maps a missing key to null, so the routing key must do the same for both to land
+    // on the same worker.
+    const auto groupSpec = group->serialize().getDocument().toBson();
+    BSONObjBuilder keyBuilder;
+    {
+        BSONObjBuilder ifNullBuilder(keyBuilder.subobjStart(kGroupKeyField));
+        BSONArrayBuilder argsBuilder(ifNullBuilder.subarrayStart("$ifNull"));
+        argsBuilder.append(groupSpec.firstElement().Obj()["_id"]);
+        argsBuilder.appendNull();
+    }
+    const auto keyObj = keyBuilder.obj();
+    auto keyExpr = Expression::parseOperand(
+        expCtx.get(), keyObj.firstElement(), expCtx->variablesParseState);
+
+    Pipeline::SourceContainer producerStages(sources.begin(), groupIt);
+    producerStages.push_back(
+        DocumentSourceAddFields::create(FieldPath(kGroupKeyField), keyExpr, expCtx));
+    auto producer = Pipeline::create(std::move(producerStages), expCtx);
+
+    sources.erase(sources.begin(), std::next(groupIt));
+    pipeline->addInitialSource(make_intrusive<DocumentSourceParallelGroup>(
+        expCtx, std::move(producer), groupSpec, deps.needWholeDocument, numWorkers));
+
+    LOGV2_DEBUG(5843127,
+                3,
+                "Splitting $group between worker threads",
+                "group"_attr = groupSpec,
+                "numWorkers"_attr = numWorkers);
+    return true;
+}
+
+DocumentSourceParallelGroup::DocumentSourceParallelGroup(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    std::unique_ptr<Pipeline, PipelineDeleter> producer,
+    BSONObj groupSpec,
+    bool removeGroupKey,
+    size_t numWorkers)
+    : DocumentSource(kStageName, expCtx),
+      _producer(std::move(producer)),
+      _groupSpec(groupSpec.getOwned()),
+      _removeGroupKey(removeGroupKey),
+      _numWorkers(numWorkers) {
+    invariant(_numWorkers > 0);
+}
+
+const char* DocumentSourceParallelGroup::getSourceName() const {
+    return kStageName.rawData();
+}
+
+Value DocumentSourceParallelGroup::serialize(
+    boost::optional<ExplainOptions::Verbosity> explain) const {
+    return Value(DOC(getSourceName() << DOC("workers" << static_cast<long long>(_numWorkers)
+                                                      << "group"
+                                                      << _groupSpec.firstElement().Obj())));
+}
+
+void DocumentSourceParallelGroup::detachFromOperationContext() {
+    if (_producer) {
+        _producer->detachFromOperationContext();
+    }
+    for (auto&& worker : _workers) {
+        worker.pipeline->detachFromOperationContext();
+    }
+}
+
+void DocumentSourceParallelGroup::reattachToOperationContext(OperationContext* opCtx) {
+    if (_producer) {
+        _producer->reattachToOperationContext(opCtx);
+    }
+    for (auto&& worker : _workers) {
+        worker.pipeline->reattachToOperationContext(opCtx);
+    }
+}
+
+bool DocumentSourceParallelGroup::usedDisk() {
+    return std::any_of(_workers.begin(), _workers.end(), [](auto&& worker) {
+        return worker.pipeline->usedDisk();
+    });
+}
+
+DocumentSource::GetNextResult DocumentSourceParallelGroup::doGetNext() {
+    if (!_exchange) {
+        runWorkers();
+    }
+
+    for (; _currentWorker < _workers.size(); ++_currentWorker) {
+        auto& worker = _workers[_currentWorker];
+        auto next = worker.firstResult ? std::move(*worker.firstResult)
+                                       : worker.pipeline->getSources().back()->getNext();
+        worker.firstResult = boost::none;
+        if (!next.isEOF()) {
+            return next;
+        }
+    }
+    return GetNextResult::makeEOF();
+}
+
+void DocumentSourceParallelGroup::doDispose() {
+    if (_producer) {
+        _producer->dispose(pExpCtx->opCtx);
+    }
+    for (auto&& worker : _workers) {
+        if (!worker.pipeline->isDisposed()) {
+            worker.pipeline->dispose(pExpCtx->opCtx);
+        }
+    }
+}
+
+void DocumentSourceParallelGroup::runWorkers() {
+    auto opCtx = pExpCtx->opCtx;
+
+    // Every worker needs its own ExpressionContext, as nothing above the Exchange is synchronized
+    // between threads. They are copied before the Exchange detaches the producer, which shares
+    // this stage's ExpressionContext, from the operation.
+    std::vector<boost::intrusive_ptr<ExpressionContext>> workerExpCtxs;
+    for (size_t idx = 0; idx < _numWorkers; ++idx) {
+        workerExpCtxs.push_back(pExpCtx->copyWith(pExpCtx->ns, pExpCtx->uuid));
+    }
+
+    // Whichever worker loads the Exchange buffers attaches the producer, and with it this stage's
+    // ExpressionContext, to its own operation. Point it back at this operation once they are done.
+    ON_BLOCK_EXIT([&] { pExpCtx->opCtx = opCtx; });
+
+    _exchange = new Exchange(Exchange::makeHashedKeyRangeSpec(kGroupKeyField, _numWorkers),
+                             std::move(_producer));
+
+    for (auto&& workerExpCtx : workerExpCtxs) {
+        Pipeline::SourceContainer stages;
+        stages.push_back(make_intrusive<DocumentSourceExchange>(
+            workerExpCtx,
+            _exchange,
+            _workers.size(),
+            workerExpCtx->mongoProcessInterface->getResourceYielder()));
+        if (_removeGroupKey) {
+            stages.push_back(
+                DocumentSourceProject::createUnset(FieldPath(kGroupKeyField), workerExpCtx));
+        }
+        stages.push_back(
+            DocumentSourceGroup::createFromBson(_groupSpec.firstElement(), workerExpCtx));
+        _workers.push_back({Pipeline::create(std::move(stages), workerExpCtx), boost::none});
+    }
+
+    {
+        auto serviceContext = opCtx->getServiceContext();
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+
+        try {
+            for (size_t idx = 1; idx < _workers.size(); ++idx) {
+                threads.emplace_back([this, serviceContext, idx] {
+                    const std::string threadName = str::stream() << "ParallelGroupWorker-" << idx;
+                    ThreadClient tc(threadName, serviceContext);
+                    auto workerOpCtx = cc().makeOperationContext();
+                    {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.push_back(workerOpCtx.get());
+                    }
+                    ON_BLOCK_EXIT([&] {
+                        stdx::lock_guard<Latch> lk(_mutex);
+                        _workerOpCtxs.erase(std::find(
+                            _workerOpCtxs.begin(), _workerOpCtxs.end(), workerOpCtx.get()));
+                    });
+                    runWorker(&_workers[idx], workerOpCtx.get());
+                });
+            }
+        } catch (const std::exception& ex) {
+            // The workers which did not get a thread would never drain their buffers, so stop the
+            // Exchange from waiting for them.
+            recordFailure({ErrorCodes::InternalError,
+                           str::stream() << "Failed to start a $group worker: " << ex.what()});
+            for (size_t idx = threads.size() + 1; idx < _workers.size(); ++idx) {
+                _workers[idx].pipeline->dispose(opCtx);
+            }
+            _workers[0].pipeline->dispose(opCtx);
+            throw;
+        }
+
+        runWorker(&_workers[0], opCtx);
+    }
+
+    uassertStatusOK(_firstError);
+    for (auto&& worker : _workers) {
+        worker.pipeline->reattachToOperationContext(opCtx);
+    }
+}
+
+void DocumentSourceParallelGroup::runWorker(Worker* worker, OperationContext* opCtx) {
+    try {
+        worker->pipeline->reattachToOperationContext(opCtx);
+        worker->firstResult = worker->pipeline->getSources().back()->getNext();
+        worker->pipeline->detachFromOperationContext();
+    } catch (const DBException& ex) {
+        worker->pipeline->dispose(opCtx);
+        recordFailure(ex.toStatus());
+    }
+}
+
+void DocumentSourceParallelGroup::recordFailure(Status status) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    // Once a worker fails, the Exchange fails the other workers with ExchangePassthrough, which
+    // says nothing about the cause.
+    if (_firstError.isOK() ||
+        (_firstError == ErrorCodes::ExchangePassthrough &&
+         status != ErrorCodes::ExchangePassthrough)) {
+        _firstError = std::move(status);
+    }
+
+    for (auto workerOpCtx : _workerOpCtxs) {
+        stdx::lock_guard<Client> clientLock(*workerOpCtx->getClient());
+        workerOpCtx->getServiceContext()->killOperation(clientLock, workerOpCtx);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+/**
+ * Runs a $group over several threads of this node. An Exchange routes every input document to one
+ * of the workers by the hash of its group key, and each worker runs its own copy of the $group over
+ * its part of the input. All documents with the same key reach the same worker in their original
+ * order, so the workers' groups never overlap and their results are simply concatenated.
+ *
+ * The stage replaces the $group and every stage before it, which become the input of the Exchange.
+ * The threads only run during the first call to getNext(); the output is then read on the calling
+ * thread.
+ */
+class DocumentSourceParallelGroup final : public DocumentSource {
+public:
+    static constexpr StringData kStageName = "$_internalParallelGroup"_sd;
+
+    // The field which the Exchange input uses to carry the group key.
+    static constexpr StringData kGroupKeyField = "_internalParallelGroupKey"_sd;
+
+    /**
+     * If 'pipeline' contains a $group whose key can be hashed, replaces that $group and the stages
+     * before it with a DocumentSourceParallelGroup of 'numWorkers' workers. Returns false and
+     * leaves the pipeline unchanged otherwise.
+     */
+    static bool parallelizeIfPossible(Pipeline* pipeline, size_t numWorkers);
+
+    DocumentSourceParallelGroup(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                std::unique_ptr<Pipeline, PipelineDeleter> producer,
+                                BSONObj groupSpec,
+                                bool removeGroupKey,
+                                size_t numWorkers);
+
+    StageConstraints constraints(Pipeline::SplitState pipeState) const final {
+        return {StreamType::kBlocking,
+                PositionRequirement::kNone,
+                HostTypeRequirement::kNone,
+                DiskUseRequirement::kWritesTmpData,
+                FacetRequirement::kNotAllowed,
+                TransactionRequirement::kNotAllowed,
+                LookupRequirement::kNotAllowed,
+                UnionRequirement::kNotAllowed};
+    }
+
+    boost::optional<DistributedPlanLogic> distributedPlanLogic() final {
+        return boost::none;
+    }
+
+    const char* getSourceName() const final;
+
+    Value serialize(boost::optional<ExplainOptions::Verbosity> explain = boost::none) const final;
+
+    /**
+     * DocumentSourceParallelGroup does not have a direct source, it reads through the Exchange.
+     */
+    void setSource(DocumentSource* source) final {
+        invariant(!source);
+    }
+
+    void detachFromOperationContext() final;
+
+    void reattachToOperationContext(OperationContext* opCtx) final;
+
+    bool usedDisk() final;
+
+    size_t getNumWorkers() const {
+        return _numWorkers;
+    }
+
+private:
+    struct Worker {
+        // A $_internalExchange consumer followed by this worker's copy of the $group.
+        std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+
+        // The first result of the $group, which is returned once it has consumed all its input.
+        boost::optional<GetNextResult> firstResult;
+    };
+
+    GetNextResult doGetNext() final;
+
+    void doDispose() final;
+
+    /**
+     * Runs every worker until its $group has consumed all of its input, one of them on this thread
+     * and the others on threads of their own. Throws the first error of any worker.
+     */
+    void runWorkers();
+
+    /**
+     * Runs 'worker' on 'opCtx' until its $group has consumed all of its input. On failure, disposes
+     * of the worker's pipeline so that the Exchange stops waiting for it, and records the error.
+     */
+    void runWorker(Worker* worker, OperationContext* opCtx);
+
+    /**
+     * Records the failure of a worker and interrupts the workers which run on threads of their own,
+     * without waiting for them to finish.
+     */
+    void recordFailure(Status status);
+
+    // The stages before the $group, plus a stage that sets 'kGroupKeyField'. Moved into the
+    // Exchange once the workers start.
+    std::unique_ptr<Pipeline, PipelineDeleter> _producer;
+
+    // The serialized $group, which each worker parses into its own copy.
+    const BSONObj _groupSpec;
+
+    // Whether the workers must remove 'kGroupKeyField' from their input before grouping it, which
+    // is the case when the $group uses the whole document.
+    const bool _removeGroupKey;
+
+    const size_t _numWorkers;
+
+    boost::intrusive_ptr<Exchange> _exchange;
+
+    std::vector<Worker> _workers;
+
+    // The worker whose output is currently being returned.
+    size_t _currentWorker{0};
+
+    // Protects the members below while the workers run.
+    Mutex _mutex = MONGO_MAKE_LATCH("DocumentSourceParallelGroup::_mutex");
+
+    // The operation contexts of the workers which run on threads of their own.
+    std::vector<OperationContext*> _workerOpCtxs;
+
+    Status _firstError{Status::OK()};
+};
+
+}  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <algorithm>
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_source_group.h"
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/document_source_parallel_group.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using DocumentSourceParallelGroupTest = AggregationContextFixture;
+
+/**
+ * Returns a pipeline which feeds 'numDocs' documents to a $group made from 'groupSpec'. Every 37th
+ * document has no 'a' and the next one has a null 'a', and odd documents hold 'a' as a double.
+ */
+std::unique_ptr<Pipeline, PipelineDeleter> makeGroupPipeline(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, const BSONObj& groupSpec, int numDocs) {
+    auto source = DocumentSourceMock::createForTest(expCtx);
+    for (int i = 0; i < numDocs; ++i) {
+        const auto key = i % 37;
+        if (key == 0) {
+            source->emplace_back(Document{{"b", i}});
+        } else if (key == 1) {
+            source->emplace_back(Document{{"a", BSONNULL}, {"b", i}});
+        } else if (i % 2) {
+            source->emplace_back(Document{{"a", static_cast<double>(key)}, {"b", i}});
+        } else {
+            source->emplace_back(Document{{"a", key}, {"b", i}});
+        }
+    }
+    auto group = DocumentSourceGroup::createFromBson(BSON("$group" << groupSpec).firstElement(),
+                                                     expCtx);
+    return Pipeline::create({source, group}, expCtx);
+}
+
+std::vector<Value> getSortedResults(Pipeline* pipeline) {
+    std::vector<Value> results;
+    while (auto next = pipeline->getNext()) {
+        results.emplace_back(*next);
+    }
+    std::sort(results.begin(), results.end(), [](const Value& lhs, const Value& rhs) {
+        return ValueComparator().evaluate(lhs.getDocument()["_id"] < rhs.getDocument()["_id"]);
+    });
+    return results;
+}
+
+TEST_F(DocumentSourceParallelGroupTest, MatchesSingleThreadedGroup) {
+    const auto groupSpec = BSON("_id"
+                                << "$a"
+                                << "count" << BSON("$sum" << 1) << "total"
+                                << BSON("$sum"
+                                        << "$b")
+                                << "first"
+                                << BSON("$first"
+                                        << "$b")
+                                << "last"
+                                << BSON("$last"
+                                        << "$b"));
+    auto expected = getSortedResults(makeGroupPipeline(getExpCtx(), groupSpec, 5000).get());
+    ASSERT_EQ(expected.size(), 36U);
+
+    auto pipeline = makeGroupPipeline(getExpCtx(), groupSpec, 5000);
+    ASSERT_TRUE(DocumentSourceParallelGroup::parallelizeIfPossible(pipeline.get(), 4));
+    ASSERT_EQ(pipeline->getSources().size(), 1U);
+    auto parallelGroup = dynamic_cast<DocumentSourceParallelGroup*>(pipeline->peekFront());
+    ASSERT(parallelGroup);
+    ASSERT_EQ(parallelGroup->getNumWorkers(), 4U);
+
+    ASSERT_VALUE_EQ(Value(expected), Value(getSortedResults(pipeline.get())));
+}
+
+TEST_F(DocumentSourceParallelGroupTest, WholeDocumentDoesNotIncludeGroupKey) {
+    const auto groupSpec = BSON("_id"
+                                << "$a"
+                                << "docs"
+                                << BSON("$push"
+                                        << "$$ROOT"));
+    auto expected = getSortedResults(makeGroupPipeline(getExpCtx(), groupSpec, 500).get());
+
+    auto pipeline = makeGroupPipeline(getExpCtx(), groupSpec, 500);
+    ASSERT_TRUE(DocumentSourceParallelGroup::parallelizeIfPossible(pipeline.get(), 3));
+    ASSERT_VALUE_EQ(Value(expected), Value(getSortedResults(pipeline.get())));
+}
+
+TEST_F(DocumentSourceParallelGroupTest, ConstantKeyIsNotSplit) {
+    auto pipeline = makeGroupPipeline(getExpCtx(),
+                                      BSON("_id" << BSONNULL << "count" << BSON("$sum" << 1)),
+                                      10);
+    ASSERT_FALSE(DocumentSourceParallelGroup::parallelizeIfPossible(pipeline.get(), 4));
+    ASSERT_EQ(pipeline->getSources().size(), 2U);
+}
+
+TEST_F(DocumentSourceParallelGroupTest, NonSimpleCollationIsNotSplit) {
+    getExpCtx()->setCollator(
+        std::make_unique<CollatorInterfaceMock>(CollatorInterfaceMock::MockType::kToLowerString));
+    auto pipeline = makeGroupPipeline(getExpCtx(),
+                                      BSON("_id"
+                                           << "$a"
+                                           << "count" << BSON("$sum" << 1)),
+                                      10);
+    ASSERT_FALSE(DocumentSourceParallelGroup::parallelizeIfPossible(pipeline.get(), 4));
+    ASSERT_EQ(pipeline->getSources().size(), 2U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -45,27 +45,38 @@ boost::intrusive_ptr<DocumentSource> DocumentSourcePlanCacheStats::createFromBso
                           << " value must be an object. Found: " << typeName(spec.type()),
             spec.type() == BSONType::Object);
 
-    uassert(ErrorCodes::FailedToParse,
-            str::stream() << kStageName
-                          << " parameters object must be empty. Found: " << typeName(spec.type()),
-            spec.embeddedObject().isEmpty());
+    bool partitionStats = false;
+    for (auto&& elem : spec.embeddedObject()) {
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << kStageName << " parameters object may only contain '"
+                              << kPartitionStatsFieldName << "'. Found: " << elem.fieldName(),
+                elem.fieldNameStringData() == kPartitionStatsFieldName);
+        uassert(ErrorCodes::FailedToParse,
+                str::stream() << kStageName << " '" << kPartitionStatsFieldName
+                              << "' must be a boolean. Found: " << typeName(elem.type()),
+                elem.type() == BSONType::Bool);
+        partitionStats = elem.boolean();
+    }
 
-    return new DocumentSourcePlanCacheStats(pExpCtx);
+    return new DocumentSourcePlanCacheStats(pExpCtx, partitionStats);
 }
 
 DocumentSourcePlanCacheStats::DocumentSourcePlanCacheStats(
-    const boost::intrusive_ptr<ExpressionContext>& expCtx)
-    : DocumentSource(kStageName, expCtx) {}
+    const boost::intrusive_ptr<ExpressionContext>& expCtx, bool partitionStats)
+    : DocumentSource(kStageName, expCtx), _partitionStats(partitionStats) {}
 
 void DocumentSourcePlanCacheStats::serializeToArray(
     std::vector<Value>& array, boost::optional<ExplainOptions::Verbosity> explain) const {
+    const auto partitionStats = _partitionStats ? Value{true} : Value{};
     if (explain) {
         array.push_back(Value{
             Document{{kStageName,
-                      Document{{"match"_sd,
+                      Document{{kPartitionStatsFieldName, partitionStats},
+                               {"match"_sd,
                                 _absorbedMatch ? Value{_absorbedMatch->getQuery()} : Value{}}}}}});
     } else {
-        array.push_back(Value{Document{{kStageName, Document{}}}});
+        array.push_back(
+            Value{Document{{kStageName, Document{{kPartitionStatsFieldName, partitionStats}}}}});
         if (_absorbedMatch) {
             _absorbedMatch->serializeToArray(array);
         }
@@ -91,8 +102,11 @@ Pipeline::SourceContainer::iterator DocumentSourcePlanCacheStats::doOptimizeAt(
 DocumentSource::GetNextResult DocumentSourcePlanCacheStats::doGetNext() {
     if (!_haveRetrievedStats) {
         const auto matchExpr = _absorbedMatch ? _absorbedMatch->getMatchExpression() : nullptr;
-        _results = pExpCtx->mongoProcessInterface->getMatchingPlanCacheEntryStats(
-            pExpCtx->opCtx, pExpCtx->ns, matchExpr);
+        _results = _partitionStats
+            ? pExpCtx->mongoProcessInterface->getMatchingPlanCachePartitionStats(
+                  pExpCtx->opCtx, pExpCtx->ns, matchExpr)
+            : pExpCtx->mongoProcessInterface->getMatchingPlanCacheEntryStats(
+                  pExpCtx->opCtx, pExpCtx->ns, matchExpr);
 
         _resultsIter = _results.begin();
         _haveRetrievedStats = true;
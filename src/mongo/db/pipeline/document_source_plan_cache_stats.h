@@ -37,6 +37,7 @@ namespace mongo {
 class DocumentSourcePlanCacheStats final : public DocumentSource {
 public:
     static constexpr StringData kStageName = "$planCacheStats"_sd;
+    static constexpr StringData kPartitionStatsFieldName = "partitionStats"_sd;
 
     class LiteParsed final : public LiteParsedDocumentSource {
     public:
@@ -119,7 +120,8 @@ public:
         boost::optional<ExplainOptions::Verbosity> explain = boost::none) const override;
 
 private:
-    DocumentSourcePlanCacheStats(const boost::intrusive_ptr<ExpressionContext>& expCtx);
+    DocumentSourcePlanCacheStats(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                 bool partitionStats);
 
     GetNextResult doGetNext() final;
 
@@ -128,6 +130,10 @@ private:
         MONGO_UNREACHABLE;  // Should call serializeToArray instead.
     }
 
+    // Whether to return one document per partition of the plan cache, holding its hit, miss and
+    // eviction counts, instead of one document per cache entry.
+    const bool _partitionStats;
+
     // If running through mongos in a sharded cluster, stores the shard name so that it can be
     // appended to each plan cache entry document.
     std::string _shardName;
@@ -46,8 +46,9 @@ using DocumentSourcePlanCacheStatsTest = AggregationContextFixture;
  */
 class PlanCacheStatsMongoProcessInterface final : public StubMongoProcessInterface {
 public:
-    PlanCacheStatsMongoProcessInterface(std::vector<BSONObj> planCacheStats)
-        : _planCacheStats(std::move(planCacheStats)) {}
+    PlanCacheStatsMongoProcessInterface(std::vector<BSONObj> planCacheStats,
+                                        std::vector<BSONObj> partitionStats = {})
+        : _planCacheStats(std::move(planCacheStats)), _partitionStats(std::move(partitionStats)) {}
 
     std::vector<BSONObj> getMatchingPlanCacheEntryStats(
         OperationContext* opCtx,
@@ -65,6 +66,14 @@ public:
         return filteredStats;
     }
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(
+        OperationContext* opCtx,
+        const NamespaceString& nss,
+        const MatchExpression* matchExpr) const override {
+        ASSERT(!matchExpr);
+        return _partitionStats;
+    }
+
     std::string getShardName(OperationContext* opCtx) const override {
         return "testShardName";
     }
@@ -75,6 +84,7 @@ public:
 
 private:
     std::vector<BSONObj> _planCacheStats;
+    std::vector<BSONObj> _partitionStats;
 };
 
 TEST_F(DocumentSourcePlanCacheStatsTest, ShouldFailToParseIfSpecIsNotObject) {
@@ -102,6 +112,42 @@ TEST_F(DocumentSourcePlanCacheStatsTest, CanParseAndSerializeSuccessfully) {
     ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
 }
 
+TEST_F(DocumentSourcePlanCacheStatsTest, ShouldFailToParseIfPartitionStatsIsNotBoolean) {
+    const auto specObj = fromjson("{$planCacheStats: {partitionStats: 1}}");
+    ASSERT_THROWS_CODE(
+        DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx()),
+        AssertionException,
+        ErrorCodes::FailedToParse);
+}
+
+TEST_F(DocumentSourcePlanCacheStatsTest, CanParseAndSerializePartitionStatsSuccessfully) {
+    const auto specObj = fromjson("{$planCacheStats: {partitionStats: true}}");
+    auto stage = DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
+    std::vector<Value> serialized;
+    stage->serializeToArray(serialized);
+    ASSERT_EQ(1u, serialized.size());
+    ASSERT_BSONOBJ_EQ(specObj, serialized[0].getDocument().toBson());
+}
+
+TEST_F(DocumentSourcePlanCacheStatsTest, ReturnsPartitionStatsWhenRequested) {
+    std::vector<BSONObj> entryStats{BSON("foo"
+                                         << "bar")};
+    std::vector<BSONObj> partitionStats{BSON("partition" << 0 << "hits" << 3),
+                                        BSON("partition" << 1 << "hits" << 5)};
+    getExpCtx()->mongoProcessInterface =
+        std::make_shared<PlanCacheStatsMongoProcessInterface>(entryStats, partitionStats);
+
+    const auto specObj = fromjson("{$planCacheStats: {partitionStats: true}}");
+    auto stage = DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
+    ASSERT_BSONOBJ_EQ(stage->getNext().getDocument().toBson(),
+                      BSON("partition" << 0 << "hits" << 3 << "host"
+                                       << "testHostName"));
+    ASSERT_BSONOBJ_EQ(stage->getNext().getDocument().toBson(),
+                      BSON("partition" << 1 << "hits" << 5 << "host"
+                                       << "testHostName"));
+    ASSERT(stage->getNext().isEOF());
+}
+
 TEST_F(DocumentSourcePlanCacheStatsTest, CanParseAndSerializeAsExplainSuccessfully) {
     const auto specObj = fromjson("{$planCacheStats: {}}");
     auto stage = DocumentSourcePlanCacheStats::createFromBson(specObj.firstElement(), getExpCtx());
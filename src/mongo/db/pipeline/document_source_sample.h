@@ -65,11 +65,24 @@ public:
         return _size;
     }
 
+    /**
+     * Returns the number of consecutive documents to sample at each random position, when the
+     * sample is taken with a random cursor. 1 unless block sampling was asked for.
+     */
+    long long getBlockSize() const {
+        return _blockSize;
+    }
+
     static boost::intrusive_ptr<DocumentSource> createFromBson(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
 
     static boost::intrusive_ptr<DocumentSource> create(
-        const boost::intrusive_ptr<ExpressionContext>& expCtx, long long size);
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        long long size,
+        long long blockSize = 1);
+
+    // The largest number of consecutive documents which may be sampled at each random position.
+    static constexpr long long kMaxBlockSize = 1000;
 
 private:
     explicit DocumentSourceSample(const boost::intrusive_ptr<ExpressionContext>& pExpCtx);
@@ -77,6 +90,7 @@ private:
     GetNextResult doGetNext() final;
 
     long long _size;
+    long long _blockSize = 1;
 
     // Uses a $sort stage to randomly sort the documents.
     boost::intrusive_ptr<DocumentSourceSort> _sortStage;
@@ -49,9 +49,11 @@ DocumentSourceSampleFromRandomCursor::DocumentSourceSampleFromRandomCursor(
     const intrusive_ptr<ExpressionContext>& pExpCtx,
     long long size,
     std::string idField,
-    long long nDocsInCollection)
+    long long nDocsInCollection,
+    long long blockSize)
     : DocumentSource(kStageName, pExpCtx),
       _size(size),
+      _blockSize(blockSize),
       _idField(std::move(idField)),
       _seenDocs(pExpCtx->getValueComparator().makeUnorderedValueSet()),
       _nDocsInColl(nDocsInCollection) {}
@@ -103,8 +105,8 @@ DocumentSource::GetNextResult DocumentSourceSampleFromRandomCursor::doGetNext()
 DocumentSource::GetNextResult DocumentSourceSampleFromRandomCursor::getNextNonDuplicateDocument() {
     // We may get duplicate documents back from the random cursor, and should not return duplicate
     // documents, so keep trying until we get a new one.
-    const int kMaxAttempts = 100;
-    for (int i = 0; i < kMaxAttempts; ++i) {
+    const long long kMaxAttempts = 100 + _blockSize;
+    for (long long i = 0; i < kMaxAttempts; ++i) {
         auto nextInput = pSource->getNext();
         switch (nextInput.getStatus()) {
             case GetNextResult::ReturnStatus::kAdvanced: {
@@ -145,6 +147,9 @@ DocumentSource::GetNextResult DocumentSourceSampleFromRandomCursor::getNextNonDu
 
 Value DocumentSourceSampleFromRandomCursor::serialize(
     boost::optional<ExplainOptions::Verbosity> explain) const {
+    if (_blockSize > 1) {
+        return Value(DOC(getSourceName() << DOC("size" << _size << "blockSize" << _blockSize)));
+    }
     return Value(DOC(getSourceName() << DOC("size" << _size)));
 }
 
@@ -157,9 +162,11 @@ intrusive_ptr<DocumentSourceSampleFromRandomCursor> DocumentSourceSampleFromRand
     const intrusive_ptr<ExpressionContext>& expCtx,
     long long size,
     std::string idField,
-    long long nDocsInCollection) {
+    long long nDocsInCollection,
+    long long blockSize) {
     intrusive_ptr<DocumentSourceSampleFromRandomCursor> source(
-        new DocumentSourceSampleFromRandomCursor(expCtx, size, idField, nDocsInCollection));
+        new DocumentSourceSampleFromRandomCursor(
+            expCtx, size, idField, nDocsInCollection, blockSize));
     return source;
 }
 }  // namespace mongo
@@ -64,13 +64,15 @@ public:
         const boost::intrusive_ptr<ExpressionContext>& expCtx,
         long long size,
         std::string idField,
-        long long collectionSize);
+        long long collectionSize,
+        long long blockSize = 1);
 
 private:
     DocumentSourceSampleFromRandomCursor(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          long long size,
                                          std::string idField,
-                                         long long collectionSize);
+                                         long long collectionSize,
+                                         long long blockSize);
 
     GetNextResult doGetNext() final;
 
@@ -83,6 +85,10 @@ private:
 
     long long _size;
 
+    // The number of consecutive documents the random cursor returns from each random position.
+    // Blocks may overlap, so as many duplicates in a row are to be expected.
+    const long long _blockSize;
+
     // The field to use as the id of a document. Usually '_id', but 'ts' for the oplog.
     std::string _idField;
 
@@ -232,6 +232,32 @@ TEST_F(InvalidSampleSpec, MissingSize) {
     ASSERT_THROWS_CODE(createSample(createSpec(BSONObj())), AssertionException, 28749);
 }
 
+TEST_F(InvalidSampleSpec, InvalidBlockSize) {
+    ASSERT_THROWS_CODE(createSample(createSpec(BSON("size" << 1 << "blockSize"
+                                                           << "string"))),
+                       AssertionException,
+                       5963050);
+    ASSERT_THROWS_CODE(createSample(createSpec(BSON("size" << 1 << "blockSize" << 0))),
+                       AssertionException,
+                       5963051);
+    ASSERT_THROWS_CODE(createSample(createSpec(BSON(
+                           "size" << 1 << "blockSize" << DocumentSourceSample::kMaxBlockSize + 1))),
+                       AssertionException,
+                       5963051);
+}
+
+using SampleSpec = InvalidSampleSpec;
+
+TEST_F(SampleSpec, BlockSizeIsSerialized) {
+    auto sample = createSample(createSpec(BSON("size" << 10 << "blockSize" << 5)));
+    ASSERT_VALUE_EQ(sample->serialize(),
+                    Value(DOC("$sample" << DOC("size" << 10 << "blockSize" << 5))));
+    ASSERT_EQ(static_cast<DocumentSourceSample*>(sample.get())->getBlockSize(), 5);
+
+    sample = createSample(createSpec(BSON("size" << 10)));
+    ASSERT_VALUE_EQ(sample->serialize(), Value(DOC("$sample" << DOC("size" << 10))));
+}
+
 //
 // Test the implementation that gets results from a random cursor.
 //
@@ -331,6 +357,26 @@ TEST_F(SampleFromRandomCursorBasics, TooManyDups) {
     ASSERT_THROWS_CODE(sample()->getNext(), AssertionException, 28799);
 }
 
+/**
+ * When sampling blocks of consecutive documents, overlapping blocks may return a whole block of
+ * duplicates in a row, which the $sampleFromRandomCursor stage should skip.
+ */
+TEST_F(SampleFromRandomCursorBasics, IgnoresABlockOfDupsWhenSamplingBlocks) {
+    const long long blockSize = 500;
+    _sample =
+        DocumentSourceSampleFromRandomCursor::create(getExpCtx(), 2, "_id", 100000, blockSize);
+    sample()->setSource(_mock.get());
+    source()->push_back(DOC("_id" << 1));
+    for (int i = 0; i < blockSize; i++) {
+        source()->push_back(DOC("_id" << 1));
+    }
+    source()->push_back(DOC("_id" << 2));
+
+    ASSERT_EQUALS(1, sample()->getNext().releaseDocument()["_id"].getInt());
+    ASSERT_EQUALS(2, sample()->getNext().releaseDocument()["_id"].getInt());
+    assertEOF();
+}
+
 /**
  * The $sampleFromRandomCursor stage should error if it receives a document without an _id.
  */
@@ -311,11 +311,18 @@ DocumentSource::GetNextResult DocumentSourceInternalSetWindowFields::doGetNext()
     for (auto&& [fieldName, function] : _executableOutputs) {
         addFieldsSpec.addField(fieldName, function->getNext());
         functionMemUsage += function->getApproximateSize();
-        uassert(5414201,
-                "Exceeded memory limit in DocumentSourceSetWindowFields",
-                functionMemUsage + _iterator.getApproximateSize() < _maxMemory);
     }
 
+    // The documents behind the current one can be paged out to disk when the partition does not
+    // fit in memory. The window functions read them back if they still need them.
+    if (functionMemUsage + _iterator.getApproximateSize() >= _maxMemory && pExpCtx->allowDiskUse &&
+        !pExpCtx->inMongos) {
+        _iterator.spillToDisk();
+    }
+    uassert(5414201,
+            "Exceeded memory limit in DocumentSourceSetWindowFields",
+            functionMemUsage + _iterator.getApproximateSize() < _maxMemory);
+
     // Advance the iterator and handle partition/EOF edge cases.
     switch (_iterator.advance()) {
         case PartitionIterator::AdvanceResult::kAdvanced:
@@ -101,7 +101,7 @@ public:
         return StageConstraints(StreamType::kBlocking,
                                 PositionRequirement::kNone,
                                 HostTypeRequirement::kNone,
-                                DiskUseRequirement::kNoDiskUse,
+                                DiskUseRequirement::kWritesTmpData,
                                 FacetRequirement::kAllowed,
                                 TransactionRequirement::kAllowed,
                                 LookupRequirement::kAllowed,
@@ -37,7 +37,9 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_skip.h"
+#include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression.h"
+#include "mongo/db/pipeline/skip_and_limit.h"
 
 namespace mongo {
 
@@ -88,6 +90,27 @@ Value DocumentSourceSingleDocumentTransformation::serialize(
                                             : _cachedStageOptions}});
 }
 
+bool DocumentSourceSingleDocumentTransformation::canSwapWithBoundedSort(
+    const DocumentSourceSort& sort,
+    Pipeline::SourceContainer::const_iterator afterSort,
+    const Pipeline::SourceContainer& container) const {
+    // Projections which remove fields make the documents smaller for the $sort to hold, and
+    // $replaceRoot changes every path.
+    if (getType() != TransformerInterface::TransformerType::kComputedProjection ||
+        !sort.canMoveBefore(getModifiedPaths())) {
+        return false;
+    }
+
+    // An expression may refer to the sort key of an earlier $sort, which the next one replaces.
+    DepsTracker deps;
+    getDependencies(&deps);
+    if (deps.getNeedsMetadata(DocumentMetadataFields::kSortKey)) {
+        return false;
+    }
+
+    return sort.getLimit() || hasLimitForPushdown(afterSort, container);
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceSingleDocumentTransformation::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
@@ -102,6 +125,15 @@ Pipeline::SourceContainer::iterator DocumentSourceSingleDocumentTransformation::
         std::swap(*itr, *std::next(itr));
         return itr == container->begin() ? itr : std::prev(itr);
     }
+
+    // A bounded $sort which does not depend on the fields computed here can run first, so that
+    // only the documents it keeps are transformed. It may then move further ahead, e.g. before a
+    // $lookup which easily is the most expensive stage of the pipeline.
+    auto nextSort = dynamic_cast<DocumentSourceSort*>((*std::next(itr)).get());
+    if (nextSort && canSwapWithBoundedSort(*nextSort, std::next(itr, 2), *container)) {
+        std::swap(*itr, *std::next(itr));
+        return itr == container->begin() ? itr : std::prev(itr);
+    }
     return std::next(itr);
 }
 
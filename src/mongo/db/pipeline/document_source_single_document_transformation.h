@@ -36,6 +36,8 @@
 
 namespace mongo {
 
+class DocumentSourceSort;
+
 /**
  * This class is for DocumentSources that take in and return one document at a time, in a 1:1
  * transformation. It should only be used via an alias that passes the transformation logic through
@@ -136,6 +138,15 @@ protected:
                                                      Pipeline::SourceContainer* container) final;
 
 private:
+    /**
+     * Returns true if 'sort', which directly follows this stage, may be moved ahead of it. That is
+     * only done when the $sort keeps a bounded number of documents, i.e. when it has or can absorb
+     * a $limit from the stages starting at 'afterSort'.
+     */
+    bool canSwapWithBoundedSort(const DocumentSourceSort& sort,
+                                Pipeline::SourceContainer::const_iterator afterSort,
+                                const Pipeline::SourceContainer& container) const;
+
     // Stores transformation logic.
     std::unique_ptr<TransformerInterface> _parsedTransform;
 
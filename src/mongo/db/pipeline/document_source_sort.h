@@ -116,6 +116,13 @@ public:
      */
     boost::optional<long long> getLimit() const;
 
+    /**
+     * Returns true if this $sort may be moved ahead of a stage which modifies 'modPaths', that is,
+     * if that stage modifies a finite set of paths and none of them share a prefix with a field of
+     * the sort pattern.
+     */
+    bool canMoveBefore(const GetModPathsReturn& modPaths) const;
+
     /**
      * Loads a document to be sorted. This can be used to sort a stream of documents that are not
      * coming from another DocumentSource. Once all documents have been added, the caller must call
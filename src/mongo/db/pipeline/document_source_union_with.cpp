@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/document_source_single_document_transformation.h"
 #include "mongo/db/pipeline/document_source_union_with.h"
 #include "mongo/db/pipeline/document_source_union_with_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/views/resolved_view.h"
 #include "mongo/logv2/log.h"
 
@@ -172,6 +173,13 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kIteratingSource) {
+        // Dispatching the sub-pipeline up front lets the shards it targets run it while the
+        // outer pipeline is still being read.
+        if (!_subPipelineAttached && !pExpCtx->explain &&
+            internalQueryUnionWithDispatchSubPipelineEagerly.load()) {
+            attachCursorSourceToSubPipeline();
+        }
+
         auto nextInput = pSource->getNext();
         if (!nextInput.isEOF()) {
             return nextInput;
@@ -182,29 +190,10 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     }
 
     if (_executionState == ExecutionProgress::kStartingSubPipeline) {
-        auto serializedPipe = _pipeline->serializeToBson();
-        LOGV2_DEBUG(23869,
-                    1,
-                    "$unionWith attaching cursor to pipeline {pipeline}",
-                    "pipeline"_attr = serializedPipe);
-        try {
-            _pipeline =
-                pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
-            _executionState = ExecutionProgress::kIteratingSubPipeline;
-        } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
-            _pipeline = buildPipelineFromViewDefinition(
-                pExpCtx,
-                ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
-                serializedPipe);
-            LOGV2_DEBUG(4556300,
-                        3,
-                        "$unionWith found view definition. ns: {ns}, pipeline: {pipeline}. New "
-                        "$unionWith sub-pipeline: {new_pipe}",
-                        "ns"_attr = e->getNamespace(),
-                        "pipeline"_attr = Value(e->getPipeline()),
-                        "new_pipe"_attr = _pipeline->serializeToBson());
-            return doGetNext();
+        if (!_subPipelineAttached) {
+            attachCursorSourceToSubPipeline();
         }
+        _executionState = ExecutionProgress::kIteratingSubPipeline;
     }
 
     auto res = _pipeline->getNext();
@@ -218,6 +207,32 @@ DocumentSource::GetNextResult DocumentSourceUnionWith::doGetNext() {
     return GetNextResult::makeEOF();
 }
 
+void DocumentSourceUnionWith::attachCursorSourceToSubPipeline() {
+    auto serializedPipe = _pipeline->serializeToBson();
+    LOGV2_DEBUG(23869,
+                1,
+                "$unionWith attaching cursor to pipeline {pipeline}",
+                "pipeline"_attr = serializedPipe);
+    try {
+        _pipeline =
+            pExpCtx->mongoProcessInterface->attachCursorSourceToPipeline(_pipeline.release());
+        _subPipelineAttached = true;
+    } catch (const ExceptionFor<ErrorCodes::CommandOnShardedViewNotSupportedOnMongod>& e) {
+        _pipeline = buildPipelineFromViewDefinition(
+            pExpCtx,
+            ExpressionContext::ResolvedNamespace{e->getNamespace(), e->getPipeline()},
+            serializedPipe);
+        LOGV2_DEBUG(4556300,
+                    3,
+                    "$unionWith found view definition. ns: {ns}, pipeline: {pipeline}. New "
+                    "$unionWith sub-pipeline: {new_pipe}",
+                    "ns"_attr = e->getNamespace(),
+                    "pipeline"_attr = Value(e->getPipeline()),
+                    "new_pipe"_attr = _pipeline->serializeToBson());
+        attachCursorSourceToSubPipeline();
+    }
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceUnionWith::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     auto duplicateAcrossUnion = [&](auto&& nextStage) {
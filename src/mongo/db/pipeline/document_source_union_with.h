@@ -166,9 +166,18 @@ private:
 
     void recordPlanSummaryStats(const Pipeline& pipeline);
 
+    /**
+     * Attaches a cursor source to '_pipeline', resolving the view it may read from on the way.
+     */
+    void attachCursorSourceToSubPipeline();
+
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     Pipeline::SourceContainer _cachedPipeline;
     ExecutionProgress _executionState = ExecutionProgress::kIteratingSource;
+
+    // Whether a cursor source has been attached to '_pipeline'. This happens before 'pSource' is
+    // exhausted if 'internalQueryUnionWithDispatchSubPipelineEagerly' is set.
+    bool _subPipelineAttached = false;
     UnionWithStats _stats;
 };
 
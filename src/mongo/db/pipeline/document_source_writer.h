@@ -147,6 +147,12 @@ protected:
      */
     virtual void spill(BatchedObjects&& batch) = 0;
 
+    /**
+     * Waits for the writes of any batches which 'spill()' has handed off without completing them,
+     * called before the stage pauses or reaches EOF.
+     */
+    virtual void waitForSpilledBatches() {}
+
     /**
      * Creates a batch object from the given document and returns it to the caller along with the
      * object size.
@@ -222,6 +228,7 @@ DocumentSource::GetNextResult DocumentSourceWriter<B>::doGetNext() {
             spill(std::move(batch));
             batch.clear();
         }
+        waitForSpilledBatches();
 
         switch (nextInput.getStatus()) {
             case GetNextResult::ReturnStatus::kAdvanced: {
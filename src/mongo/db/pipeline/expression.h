@@ -461,14 +461,12 @@ public:
     Value evaluate(const Document& root, Variables* variables) const final {
         AccumulatorState accum(this->getExpressionContext());
         const auto n = this->_children.size();
-        // If a single array arg is given, loop through it passing each member to the accumulator.
+        // If a single array arg is given, pass its members to the accumulator as one batch.
         // If a single, non-array arg is given, pass it directly to the accumulator.
         if (n == 1) {
             Value singleVal = this->_children[0]->evaluate(root, variables);
             if (singleVal.getType() == Array) {
-                for (const Value& val : singleVal.getArray()) {
-                    accum.process(val, false);
-                }
+                accum.processBatch(singleVal.getArray());
             } else {
                 accum.process(singleVal, false);
             }
@@ -0,0 +1,228 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/expression_compiler.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/platform/overflow_arithmetic.h"
+
+namespace mongo {
+
+namespace {
+
+using Program = CompiledExpression::Program;
+
+bool isIntegral(BSONType type) {
+    return type == NumberInt || type == NumberLong;
+}
+
+/**
+ * Returns whether 'val' is a number which the compiled arithmetic reads directly. Decimals are
+ * left to the interpreted expressions.
+ */
+bool isUnboxedNumber(const Value& val) {
+    return isIntegral(val.getType()) || val.getType() == NumberDouble;
+}
+
+double unboxDouble(const Value& val) {
+    switch (val.getType()) {
+        case NumberInt:
+            return val.getInt();
+        case NumberLong:
+            return val.getLong();
+        default:
+            return val.getDouble();
+    }
+}
+
+long long unboxLong(const Value& val) {
+    return val.getType() == NumberInt ? val.getInt() : val.getLong();
+}
+
+/**
+ * ExpressionMultiply coerces each finite operand to a long long and fails on doubles outside of
+ * its range, so only operands which pass that check take the compiled path.
+ */
+bool isMultipliableDouble(const Value& val) {
+    double d = unboxDouble(val);
+    return !std::isfinite(d) ||
+        (d >= std::numeric_limits<long long>::min() &&
+         d < BSONElement::kLongLongMaxPlusOneAsDouble);
+}
+
+class Compiler {
+public:
+    Program compile(Expression* expr) {
+        if (auto constant = dynamic_cast<ExpressionConstant*>(expr)) {
+            ++numCompiledNodes;
+            return [value = constant->getValue()](const Document&, Variables*) { return value; };
+        }
+
+        auto& children = expr->getChildren();
+        if (children.size() == 2) {
+            if (dynamic_cast<ExpressionAdd*>(expr)) {
+                return compileAdd(expr);
+            } else if (dynamic_cast<ExpressionSubtract*>(expr)) {
+                return compileSubtract(expr);
+            } else if (dynamic_cast<ExpressionMultiply*>(expr)) {
+                return compileMultiply(expr);
+            } else if (dynamic_cast<ExpressionDivide*>(expr)) {
+                return compileDivide(expr);
+            }
+        }
+        return interpret(expr);
+    }
+
+    size_t numCompiledNodes = 0;
+
+private:
+    static Program interpret(Expression* expr) {
+        return [expr](const Document& root, Variables* variables) {
+            return expr->evaluate(root, variables);
+        };
+    }
+
+    Program compileAdd(Expression* expr) {
+        ++numCompiledNodes;
+        return [expr, left = compile(expr->getChildren()[0].get()),
+                right = compile(expr->getChildren()[1].get())](const Document& root,
+                                                                Variables* variables) {
+            // Like ExpressionAdd::evaluate(), stop at a nullish left operand without evaluating
+            // the right one. Dates, decimals, invalid operands and sums which overflow a long long
+            // are rare enough to leave to the interpreted expression.
+            Value lhs = left(root, variables);
+            if (lhs.nullish()) {
+                return Value(BSONNULL);
+            }
+            if (!isUnboxedNumber(lhs)) {
+                return expr->evaluate(root, variables);
+            }
+            Value rhs = right(root, variables);
+            if (rhs.nullish()) {
+                return Value(BSONNULL);
+            }
+            if (!isUnboxedNumber(rhs)) {
+                return expr->evaluate(root, variables);
+            }
+
+            if (isIntegral(lhs.getType()) && isIntegral(rhs.getType())) {
+                long long result;
+                if (overflow::add(unboxLong(lhs), unboxLong(rhs), &result)) {
+                    return expr->evaluate(root, variables);
+                }
+                return lhs.getType() == NumberInt && rhs.getType() == NumberInt
+                    ? Value::createIntOrLong(result)
+                    : Value(result);
+            }
+            if (lhs.getType() == NumberLong || rhs.getType() == NumberLong) {
+                // A long long may not convert to a double exactly, so only the compensated sum of
+                // the interpreted expression rounds it correctly.
+                return expr->evaluate(root, variables);
+            }
+            // Starting from +0.0 gives zero sums the same sign as the DoubleDoubleSummation used by
+            // ExpressionAdd::evaluate().
+            return Value(0.0 + unboxDouble(lhs) + unboxDouble(rhs));
+        };
+    }
+
+    Program compileSubtract(Expression* expr) {
+        ++numCompiledNodes;
+        return [left = compile(expr->getChildren()[0].get()),
+                right = compile(expr->getChildren()[1].get())](const Document& root,
+                                                                Variables* variables) {
+            Value lhs = left(root, variables);
+            Value rhs = right(root, variables);
+            if (lhs.getType() == NumberInt && rhs.getType() == NumberInt) {
+                return Value::createIntOrLong(static_cast<long long>(lhs.getInt()) - rhs.getInt());
+            }
+            if (isUnboxedNumber(lhs) && isUnboxedNumber(rhs) && lhs.getType() != NumberLong &&
+                rhs.getType() != NumberLong) {
+                return Value(unboxDouble(lhs) - unboxDouble(rhs));
+            }
+            return uassertStatusOK(ExpressionSubtract::apply(std::move(lhs), std::move(rhs)));
+        };
+    }
+
+    Program compileMultiply(Expression* expr) {
+        ++numCompiledNodes;
+        return [left = compile(expr->getChildren()[0].get()),
+                right = compile(expr->getChildren()[1].get())](const Document& root,
+                                                                Variables* variables) {
+            // Like ExpressionMultiply::evaluate(), do not evaluate the right operand when the left
+            // one is nullish or not a number. ExpressionMultiply::apply() then returns null or
+            // fails on the left operand.
+            Value lhs = left(root, variables);
+            Value rhs = lhs.numeric() ? right(root, variables) : Value();
+            if (isIntegral(lhs.getType()) && isIntegral(rhs.getType())) {
+                long long result;
+                if (!overflow::mul(unboxLong(lhs), unboxLong(rhs), &result)) {
+                    return lhs.getType() == NumberInt && rhs.getType() == NumberInt
+                        ? Value::createIntOrLong(result)
+                        : Value(result);
+                }
+            } else if (isUnboxedNumber(lhs) && isUnboxedNumber(rhs) &&
+                       isMultipliableDouble(lhs) && isMultipliableDouble(rhs)) {
+                return Value(unboxDouble(lhs) * unboxDouble(rhs));
+            }
+            return uassertStatusOK(ExpressionMultiply::apply(std::move(lhs), std::move(rhs)));
+        };
+    }
+
+    Program compileDivide(Expression* expr) {
+        ++numCompiledNodes;
+        return [left = compile(expr->getChildren()[0].get()),
+                right = compile(expr->getChildren()[1].get())](const Document& root,
+                                                                Variables* variables) {
+            Value lhs = left(root, variables);
+            Value rhs = right(root, variables);
+            if (isUnboxedNumber(lhs) && isUnboxedNumber(rhs)) {
+                double denominator = unboxDouble(rhs);
+                if (denominator != 0.0) {
+                    return Value(unboxDouble(lhs) / denominator);
+                }
+            }
+            return uassertStatusOK(ExpressionDivide::apply(std::move(lhs), std::move(rhs)));
+        };
+    }
+};
+
+}  // namespace
+
+CompiledExpression CompiledExpression::compile(boost::intrusive_ptr<Expression> expr) {
+    Compiler compiler;
+    auto program = compiler.compile(expr.get());
+    return CompiledExpression(std::move(expr), std::move(program), compiler.numCompiledNodes);
+}
+
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <functional>
+
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+/**
+ * An aggregation expression tree flattened into a tree of closures. Each compiled node calls the
+ * closures of its children directly, without virtual dispatch through Expression::evaluate(), and
+ * arithmetic nodes compute NumberInt, NumberLong and NumberDouble operands without the generic
+ * numeric coercions of the interpreted expressions.
+ *
+ * Only constants, field paths and binary $add, $subtract, $multiply and $divide have compiled
+ * forms. Any other subtree is evaluated by calling Expression::evaluate() on it. A compiled
+ * expression returns the same values and throws the same errors as the expression it was compiled
+ * from.
+ */
+class CompiledExpression {
+public:
+    using Program = std::function<Value(const Document&, Variables*)>;
+
+    /**
+     * Compiles 'expr', which should already have been optimized.
+     */
+    static CompiledExpression compile(boost::intrusive_ptr<Expression> expr);
+
+    Value evaluate(const Document& root, Variables* variables) const {
+        return _program(root, variables);
+    }
+
+    /**
+     * Returns the expression this was compiled from.
+     */
+    const boost::intrusive_ptr<Expression>& getExpression() const {
+        return _expr;
+    }
+
+    /**
+     * Returns the number of expression nodes which were compiled rather than left to be evaluated
+     * by Expression::evaluate().
+     */
+    size_t numCompiledNodes() const {
+        return _numCompiledNodes;
+    }
+
+private:
+    CompiledExpression(boost::intrusive_ptr<Expression> expr,
+                       Program program,
+                       size_t numCompiledNodes)
+        : _expr(std::move(expr)),
+          _program(std::move(program)),
+          _numCompiledNodes(numCompiledNodes) {}
+
+    // Keeps alive the expression nodes which the closures of '_program' point into.
+    boost::intrusive_ptr<Expression> _expr;
+    Program _program;
+    size_t _numCompiledNodes;
+};
+
+}  // namespace mongo
@@ -0,0 +1,163 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonmisc.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/pipeline/expression_compiler.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Evaluates 'expr' against 'root', wrapping the result or the error code in an object so that
+ * results of the interpreted and compiled expressions can be compared bit for bit.
+ */
+template <typename Evaluate>
+BSONObj evaluateToBSON(Evaluate&& evaluate) {
+    BSONObjBuilder bob;
+    try {
+        Value result = evaluate();
+        if (result.missing()) {
+            bob.append("missing", true);
+        } else {
+            result.addToBsonObj(&bob, "result");
+        }
+    } catch (const DBException& ex) {
+        bob.append("code", ex.code());
+    }
+    return bob.obj();
+}
+
+std::vector<Value> operands() {
+    return {Value(0),
+            Value(3),
+            Value(-7),
+            Value(std::numeric_limits<int>::max()),
+            Value(std::numeric_limits<int>::min()),
+            Value(5LL),
+            Value(std::numeric_limits<long long>::max()),
+            Value(std::numeric_limits<long long>::min()),
+            Value((1LL << 53) + 1),
+            Value(0.0),
+            Value(-0.0),
+            Value(2.5),
+            Value(-1e300),
+            Value(std::numeric_limits<double>::infinity()),
+            Value(std::numeric_limits<double>::quiet_NaN()),
+            Value(Decimal128("1.5")),
+            Value(Date_t::fromMillisSinceEpoch(1000)),
+            Value(BSONNULL),
+            Value(),
+            Value("str"_sd)};
+}
+
+void assertCompiledMatchesInterpreted(const BSONObj& spec, size_t expectedCompiledNodes) {
+    auto expCtx = ExpressionContextForTest{};
+    auto expr =
+        Expression::parseOperand(&expCtx, spec.firstElement(), expCtx.variablesParseState)
+            ->optimize();
+    auto compiled = CompiledExpression::compile(expr);
+    ASSERT_EQ(compiled.numCompiledNodes(), expectedCompiledNodes);
+
+    for (auto&& a : operands()) {
+        for (auto&& b : operands()) {
+            MutableDocument doc;
+            doc.addField("a", a);
+            doc.addField("b", b);
+            Document root = doc.freeze();
+
+            auto interpreted =
+                evaluateToBSON([&] { return expr->evaluate(root, &expCtx.variables); });
+            auto result =
+                evaluateToBSON([&] { return compiled.evaluate(root, &expCtx.variables); });
+            ASSERT_BSONOBJ_BINARY_EQ(interpreted, result)
+                << spec << " with a: " << a.toString() << ", b: " << b.toString();
+        }
+    }
+}
+
+TEST(CompiledExpressionTest, AddMatchesInterpreted) {
+    assertCompiledMatchesInterpreted(BSON("" << BSON("$add" << BSON_ARRAY("$a"
+                                                                          << "$b"))),
+                                     1);
+}
+
+TEST(CompiledExpressionTest, SubtractMatchesInterpreted) {
+    assertCompiledMatchesInterpreted(BSON("" << BSON("$subtract" << BSON_ARRAY("$a"
+                                                                               << "$b"))),
+                                     1);
+}
+
+TEST(CompiledExpressionTest, MultiplyMatchesInterpreted) {
+    assertCompiledMatchesInterpreted(BSON("" << BSON("$multiply" << BSON_ARRAY("$a"
+                                                                               << "$b"))),
+                                     1);
+}
+
+TEST(CompiledExpressionTest, DivideMatchesInterpreted) {
+    assertCompiledMatchesInterpreted(BSON("" << BSON("$divide" << BSON_ARRAY("$a"
+                                                                             << "$b"))),
+                                     1);
+}
+
+TEST(CompiledExpressionTest, NestedArithmeticMatchesInterpreted) {
+    // {$divide: [{$add: [{$multiply: ["$a", 2]}, "$b"]}, {$subtract: ["$b", 1]}]}
+    auto spec = BSON(
+        "" << BSON("$divide" << BSON_ARRAY(
+                       BSON("$add" << BSON_ARRAY(BSON("$multiply" << BSON_ARRAY("$a" << 2))
+                                                 << "$b"))
+                       << BSON("$subtract" << BSON_ARRAY("$b" << 1)))));
+    // Four arithmetic nodes and two constants.
+    assertCompiledMatchesInterpreted(spec, 6);
+}
+
+TEST(CompiledExpressionTest, UnsupportedSubtreesAreInterpreted) {
+    // {$add: [{$abs: "$a"}, "$b", 1]} has three operands, so neither node is compiled.
+    assertCompiledMatchesInterpreted(
+        BSON("" << BSON("$add" << BSON_ARRAY(BSON("$abs"
+                                                  << "$a")
+                                             << "$b" << 1))),
+        0);
+    // {$multiply: [{$abs: "$a"}, "$b"]} compiles the multiplication around the interpreted $abs.
+    assertCompiledMatchesInterpreted(BSON("" << BSON("$multiply" << BSON_ARRAY(BSON("$abs"
+                                                                                     << "$a")
+                                                                                << "$b"))),
+                                     1);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -718,6 +718,16 @@ TEST(ExpressionFromAccumulators, Avg) {
                            {{}, Value(BSONNULL)}});
 }
 
+TEST(ExpressionFromAccumulators, AvgOfArray) {
+    assertExpectedResults(
+        "$avg",
+        {// Arrays of one numeric type are averaged as a batch.
+         {{Value(BSON_ARRAY(1.5 << 2.5 << 3 << 4.0 << 5 << 8.0))}, Value(4.0)},
+         {{Value(BSON_ARRAY(1LL << 2LL << 3LL << 4LL << 5LL))}, Value(3.0)},
+         {{Value(BSON_ARRAY(1 << 2LL << "string"_sd << BSONNULL))}, Value(1.5)},
+         {{Value(BSONArray())}, Value(BSONNULL)}});
+}
+
 TEST(ExpressionFromAccumulators, Max) {
     assertExpectedResults("$max",
                           {// $max treats non-numeric inputs as valid arguments.
@@ -754,6 +764,21 @@ TEST(ExpressionFromAccumulators, Sum) {
          {{}, Value(0)}});
 }
 
+TEST(ExpressionFromAccumulators, SumOfArray) {
+    const long long maxLong = std::numeric_limits<long long>::max();
+    assertExpectedResults(
+        "$sum",
+        {// Arrays of one numeric type are summed as a batch, keeping the type of the elements.
+         {{Value(BSON_ARRAY(1 << 2 << 3 << 4 << 5))}, Value(15)},
+         {{Value(BSON_ARRAY(1 << 2.5 << 3 << 4 << 5))}, Value(15.5)},
+         {{Value(BSON_ARRAY(1LL << 2LL << 3LL << 4LL << 5LL))}, Value(15LL)},
+         // Sums of longs past the range of a long are still exact.
+         {{Value(BSON_ARRAY(maxLong << maxLong << -maxLong << 1LL << -1LL))}, Value(maxLong)},
+         // Mixed arrays fall back to summing each element.
+         {{Value(BSON_ARRAY(1 << 2LL << Decimal128(3) << "string"_sd))}, Value(Decimal128(6))},
+         {{Value(BSONArray())}, Value(0)}});
+}
+
 TEST(ExpressionFromAccumulators, StdDevPop) {
     assertExpectedResults("$stdDevPop",
                           {// $stdDevPop ignores non-numeric inputs.
@@ -31,6 +31,8 @@
 
 #include "mongo/db/pipeline/field_path.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
 #include "mongo/bson/bson_depth.h"
 #include "mongo/util/str.h"
@@ -73,6 +75,8 @@ FieldPath::FieldPath(std::string inputPath)
     uassert(40353, "FieldPath must not end with a '.'.", _fieldPath[_fieldPath.size() - 1] != '.');
 
     // Store index delimiter position for use in field lookup.
+    const auto numDots = std::count(_fieldPath.begin(), _fieldPath.end(), '.');
+    _fieldPathDotPosition.reserve(numDots + 2);
     size_t dotPos;
     size_t startPos = 0;
     while (string::npos != (dotPos = _fieldPath.find('.', startPos))) {
@@ -87,8 +91,11 @@ FieldPath::FieldPath(std::string inputPath)
     uassert(ErrorCodes::Overflow,
             "FieldPath is too long",
             pathLength <= BSONDepth::getMaxAllowableDepth());
+    _fieldHash.reserve(pathLength);
     for (size_t i = 0; i < pathLength; ++i) {
-        uassertValidFieldName(getFieldName(i));
+        const auto fieldName = getFieldName(i);
+        uassertValidFieldName(fieldName);
+        _fieldHash.push_back(hashFieldName(fieldName));
     }
 }
 
@@ -136,6 +143,11 @@ FieldPath FieldPath::concat(const FieldPath& tail) const {
     invariant(newDots.back() == concat.size());
     invariant(newDots.size() == expectedDotSize);
 
-    return FieldPath(std::move(concat), std::move(newDots));
+    std::vector<unsigned> newHashes;
+    newHashes.reserve(head._fieldHash.size() + tail._fieldHash.size());
+    newHashes.insert(newHashes.end(), head._fieldHash.begin(), head._fieldHash.end());
+    newHashes.insert(newHashes.end(), tail._fieldHash.begin(), tail._fieldHash.end());
+
+    return FieldPath(std::move(concat), std::move(newDots), std::move(newHashes));
 }
 }  // namespace mongo
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <third_party/murmurhash3/MurmurHash3.h>
+
 #include <string>
 #include <vector>
 
@@ -42,6 +44,24 @@ namespace mongo {
  */
 class FieldPath {
 public:
+    /**
+     * A field name along with its hash by hashFieldName(), so that a name looked up in many
+     * documents, like each component of a FieldPath, is only hashed once.
+     */
+    struct HashedFieldName {
+        StringData name;
+        unsigned hash;
+    };
+
+    /**
+     * The hash of field names used by the hash tables of Document.
+     */
+    static unsigned hashFieldName(StringData name) {
+        unsigned out;
+        MurmurHash3_x86_32(name.rawData(), name.size(), 0, &out);
+        return out;
+    }
+
     /**
      * Throws a AssertionException if a field name does not pass validation.
      */
@@ -109,6 +129,15 @@ public:
         return StringData(&_fieldPath[begin], end - begin);
     }
 
+    /**
+     * Return the ith field name from this path along with its hash, computed when the path was
+     * constructed.
+     */
+    HashedFieldName getFieldNameHashed(size_t i) const {
+        dassert(i < getPathLength());
+        return {getFieldName(i), _fieldHash[i]};
+    }
+
     /**
      * Returns the full path, not including the prefix 'FieldPath::prefix'.
      */
@@ -141,8 +170,10 @@ public:
     FieldPath concat(const FieldPath& tail) const;
 
 private:
-    FieldPath(std::string string, std::vector<size_t> dots)
-        : _fieldPath(std::move(string)), _fieldPathDotPosition(std::move(dots)) {}
+    FieldPath(std::string string, std::vector<size_t> dots, std::vector<unsigned> hashes)
+        : _fieldPath(std::move(string)),
+          _fieldPathDotPosition(std::move(dots)),
+          _fieldHash(std::move(hashes)) {}
 
     static const char prefix = '$';
 
@@ -153,6 +184,9 @@ private:
     // string::npos (which evaluates to -1) and the last contains _fieldPath.size() to facilitate
     // lookup.
     std::vector<size_t> _fieldPathDotPosition;
+
+    // Contains the hash of each field name, see hashFieldName().
+    std::vector<unsigned> _fieldHash;
 };
 
 inline bool operator<(const FieldPath& lhs, const FieldPath& rhs) {
@@ -214,6 +214,8 @@ void checkConcatWorks(const FieldPath& head, const FieldPath& tail) {
             ? head.getFieldName(i)
             : tail.getFieldName(i - head.getPathLength());
         ASSERT_EQ(concat.getFieldName(i), expected);
+        ASSERT_EQ(concat.getFieldNameHashed(i).name, expected);
+        ASSERT_EQ(concat.getFieldNameHashed(i).hash, FieldPath::hashFieldName(expected));
     }
 }
 
@@ -226,5 +228,15 @@ TEST(FieldPathTest, Concat) {
     checkConcatWorks("$db", "$id");
     checkConcatWorks("$db.$id", "$id.$db");
 }
+
+TEST(FieldPathTest, GetFieldNameHashed) {
+    FieldPath path("foo.bar.baz");
+    for (size_t i = 0; i < path.getPathLength(); i++) {
+        const auto field = path.getFieldNameHashed(i);
+        ASSERT_EQ(field.name, path.getFieldName(i));
+        ASSERT_EQ(field.hash, FieldPath::hashFieldName(path.getFieldName(i)));
+    }
+    ASSERT_EQ(path.tail().getFieldNameHashed(0).hash, path.getFieldNameHashed(1).hash);
+}
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,107 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/group_hash_table.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+constexpr size_t GroupHashTable::kMinCapacity;
+constexpr uint64_t GroupHashTable::kEmptySlot;
+constexpr uint64_t GroupHashTable::kTagMask;
+
+GroupHashTable::GroupHashTable(const ValueComparator& comparator, size_t numAccumulators)
+    : _comparator(comparator), _numAccumulators(numAccumulators) {}
+
+size_t GroupHashTable::mixHash(size_t hash) {
+    // The finalizer of MurmurHash3.
+    uint64_t h = hash;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+std::pair<size_t, bool> GroupHashTable::findOrInsert(const Value& key) {
+    // Keep the table at most three quarters full, so that the probe sequences stay short.
+    if ((_keys.size() + 1) * 4 > _slots.size() * 3) {
+        grow();
+    }
+
+    const size_t hash = mixHash(_comparator.hash(key));
+    const size_t mask = _slots.size() - 1;
+    const uint64_t tag = getTag(hash);
+    for (size_t idx = hash & mask;; idx = (idx + 1) & mask) {
+        const uint64_t slot = _slots[idx];
+        if (slot == kEmptySlot) {
+            const size_t row = _keys.size();
+            invariant(row < std::numeric_limits<uint32_t>::max());
+            _slots[idx] = makeSlot(hash, row);
+            _keys.push_back(key);
+            _hashes.push_back(hash);
+            _accumulators.resize(_accumulators.size() + _numAccumulators);
+            return {row, true};
+        }
+        if ((slot & kTagMask) == tag &&
+            _comparator.compare(_keys[getRow(slot)], key) == 0) {
+            return {getRow(slot), false};
+        }
+    }
+}
+
+void GroupHashTable::clear() {
+    _slots = std::vector<uint64_t>();
+    _keys = std::vector<Value>();
+    _hashes = std::vector<size_t>();
+    _accumulators = std::vector<AccumulatorPtr>();
+}
+
+void GroupHashTable::grow() {
+    const size_t capacity = std::max(kMinCapacity, _slots.size() * 2);
+    const size_t mask = capacity - 1;
+
+    _slots.assign(capacity, kEmptySlot);
+    for (size_t row = 0; row < _keys.size(); ++row) {
+        size_t idx = _hashes[row] & mask;
+        while (_slots[idx] != kEmptySlot) {
+            idx = (idx + 1) & mask;
+        }
+        _slots[idx] = makeSlot(_hashes[row], row);
+    }
+}
+
+}  // namespace mongo
@@ -0,0 +1,145 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/accumulator.h"
+
+namespace mongo {
+
+/**
+ * The groups of a $group stage: a hash table from group key to a fixed number of accumulators,
+ * using open addressing with linear probing.
+ *
+ * Each group is a row, and rows are numbered densely in insertion order. The keys, their hashes
+ * and the accumulators of all rows are kept in flat arrays, the accumulators of row 'i' taking
+ * the 'numAccumulators' slots starting at 'i * numAccumulators'. The probe array holds one 64-bit
+ * word per slot, with the upper half of the key's hash next to the row number, so that most
+ * probes are resolved without touching the rows or comparing keys.
+ */
+class GroupHashTable {
+public:
+    using AccumulatorPtr = boost::intrusive_ptr<AccumulatorState>;
+
+    /**
+     * Keys are hashed and compared with 'comparator', which must outlive the table.
+     */
+    GroupHashTable(const ValueComparator& comparator, size_t numAccumulators);
+
+    /**
+     * Returns the row of the group for 'key', and whether it was inserted by this call. The
+     * accumulators of an inserted row are null, and must be set by the caller.
+     */
+    std::pair<size_t, bool> findOrInsert(const Value& key);
+
+    const Value& getKey(size_t row) const {
+        return _keys[row];
+    }
+
+    /**
+     * Returns the first of the 'numAccumulators' accumulators of 'row'. The pointer stays valid
+     * until the next insertion.
+     */
+    AccumulatorPtr* getAccumulators(size_t row) {
+        return _accumulators.data() + row * _numAccumulators;
+    }
+
+    const AccumulatorPtr* getAccumulators(size_t row) const {
+        return _accumulators.data() + row * _numAccumulators;
+    }
+
+    size_t size() const {
+        return _keys.size();
+    }
+
+    bool empty() const {
+        return _keys.empty();
+    }
+
+    /**
+     * Removes every group and releases the memory of the table.
+     */
+    void clear();
+
+    /**
+     * Returns the memory held by the table itself, excluding the contents of the keys and the
+     * accumulator states, which are accounted for separately.
+     */
+    size_t getMemoryOverheadBytes() const {
+        return _slots.capacity() * sizeof(uint64_t) + _keys.capacity() * sizeof(Value) +
+            _hashes.capacity() * sizeof(size_t) + _accumulators.capacity() * sizeof(AccumulatorPtr);
+    }
+
+private:
+    static constexpr size_t kMinCapacity = 16;
+    static constexpr uint64_t kEmptySlot = 0;
+    static constexpr uint64_t kTagMask = 0xFFFFFFFF00000000ULL;
+
+    /**
+     * Mixes the bits of a Value hash, whose low bits alone are often poorly distributed, before it
+     * picks a slot.
+     */
+    static size_t mixHash(size_t hash);
+
+    static uint64_t getTag(size_t hash) {
+        return static_cast<uint64_t>(hash) & kTagMask;
+    }
+
+    static uint64_t makeSlot(size_t hash, size_t row) {
+        return getTag(hash) | (row + 1);
+    }
+
+    static size_t getRow(uint64_t slot) {
+        return (slot & ~kTagMask) - 1;
+    }
+
+    /**
+     * Doubles the number of slots and places every row again.
+     */
+    void grow();
+
+    const ValueComparator& _comparator;
+    const size_t _numAccumulators;
+
+    // A power of two number of slots, each either 'kEmptySlot' or made by makeSlot().
+    std::vector<uint64_t> _slots;
+
+    std::vector<Value> _keys;
+    std::vector<size_t> _hashes;
+    std::vector<AccumulatorPtr> _accumulators;
+};
+
+}  // namespace mongo
@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/group_hash_table.h"
+#include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using GroupHashTableTest = AggregationContextFixture;
+
+TEST_F(GroupHashTableTest, FindsEveryInsertedKeyAcrossGrowth) {
+    ValueComparator comparator;
+    GroupHashTable table(comparator, 2);
+
+    const int numKeys = 10000;
+    for (int i = 0; i < numKeys; ++i) {
+        auto [row, inserted] = table.findOrInsert(Value(i));
+        ASSERT_TRUE(inserted);
+        ASSERT_EQ(row, static_cast<size_t>(i));
+        ASSERT_FALSE(table.getAccumulators(row)[0]);
+        ASSERT_FALSE(table.getAccumulators(row)[1]);
+        table.getAccumulators(row)[1] = AccumulatorSum::create(getExpCtxRaw());
+    }
+    ASSERT_EQ(table.size(), static_cast<size_t>(numKeys));
+
+    for (int i = 0; i < numKeys; ++i) {
+        // Numbers which compare equal find the same group, whatever their type.
+        auto [row, inserted] = table.findOrInsert(Value(static_cast<double>(i)));
+        ASSERT_FALSE(inserted);
+        ASSERT_EQ(row, static_cast<size_t>(i));
+        ASSERT_VALUE_EQ(table.getKey(row), Value(i));
+        ASSERT(table.getAccumulators(row)[1]);
+    }
+    ASSERT_EQ(table.size(), static_cast<size_t>(numKeys));
+}
+
+TEST_F(GroupHashTableTest, UsesTheComparatorDefinitionOfEquality) {
+    CollatorInterfaceMock collator(CollatorInterfaceMock::MockType::kToLowerString);
+    ValueComparator comparator(&collator);
+    GroupHashTable table(comparator, 0);
+
+    ASSERT_TRUE(table.findOrInsert(Value("abc"_sd)).second);
+    ASSERT_FALSE(table.findOrInsert(Value("ABC"_sd)).second);
+    ASSERT_TRUE(table.findOrInsert(Value("abd"_sd)).second);
+    ASSERT_TRUE(table.findOrInsert(Value(BSONNULL)).second);
+    ASSERT_TRUE(table.findOrInsert(Value(Document{{"a", "x"_sd}})).second);
+    ASSERT_FALSE(table.findOrInsert(Value(Document{{"a", "X"_sd}})).second);
+    ASSERT_EQ(table.size(), 4U);
+}
+
+TEST_F(GroupHashTableTest, ClearReleasesTheMemoryOfTheTable) {
+    ValueComparator comparator;
+    GroupHashTable table(comparator, 1);
+    ASSERT_EQ(table.getMemoryOverheadBytes(), 0U);
+
+    for (int i = 0; i < 100; ++i) {
+        table.findOrInsert(Value(i));
+    }
+    ASSERT_GTE(table.getMemoryOverheadBytes(),
+               100 * (sizeof(Value) + sizeof(GroupHashTable::AccumulatorPtr)));
+
+    table.clear();
+    ASSERT_TRUE(table.empty());
+    ASSERT_EQ(table.getMemoryOverheadBytes(), 0U);
+    ASSERT_TRUE(table.findOrInsert(Value(1)).second);
+    ASSERT_EQ(table.size(), 1U);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,220 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/group_result_maintainer.h"
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+namespace {
+
+// The accumulators whose value over a group can be computed from their value over a part of the
+// group and the remaining documents.
+const StringDataSet kIncrementalAccumulators{"$count", "$max", "$min", "$sum"};
+
+/**
+ * Returns the expression for the _id of the $group specification 'spec', or nullptr if it groups
+ * by a document of several expressions, which is not supported.
+ */
+boost::intrusive_ptr<Expression> parseIdExpression(ExpressionContext* expCtx,
+                                                   const BSONElement& spec,
+                                                   const VariablesParseState& vps) {
+    if (spec.type() != BSONType::Object) {
+        return Expression::parseOperand(expCtx, spec, vps);
+    }
+    if (spec.Obj().isEmpty()) {
+        return ExpressionConstant::create(expCtx, Value(spec));
+    }
+    if (spec.Obj().firstElementFieldNameStringData().startsWith("$")) {
+        return Expression::parseObject(expCtx, spec.Obj(), vps);
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+GroupResultMaintainer::GroupResultMaintainer(boost::intrusive_ptr<ExpressionContext> expCtx)
+    : _expCtx(std::move(expCtx)) {}
+
+std::unique_ptr<GroupResultMaintainer> GroupResultMaintainer::make(
+    OperationContext* opCtx, const AggregateCommandRequest& request) {
+    const auto& pipeline = request.getPipeline();
+    if (pipeline.empty() || pipeline.back().firstElementFieldNameStringData() != "$group") {
+        return nullptr;
+    }
+
+    try {
+        auto expCtx = make_intrusive<ExpressionContext>(
+            opCtx, nullptr, request.getNamespace(), boost::none, request.getLet());
+        std::unique_ptr<GroupResultMaintainer> maintainer(new GroupResultMaintainer(expCtx));
+
+        for (size_t i = 0; i + 1 < pipeline.size(); ++i) {
+            const auto stageSpec = pipeline[i].firstElement();
+            if (stageSpec.fieldNameStringData() != "$match" ||
+                stageSpec.type() != BSONType::Object) {
+                return nullptr;
+            }
+            auto filter = MatchExpressionParser::parse(stageSpec.Obj(), expCtx);
+            if (!filter.isOK()) {
+                return nullptr;
+            }
+            maintainer->_filters.push_back(std::move(filter.getValue()));
+        }
+
+        const auto groupSpec = pipeline.back().firstElement();
+        if (groupSpec.type() != BSONType::Object) {
+            return nullptr;
+        }
+        const auto& vps = expCtx->variablesParseState;
+        for (auto&& field : groupSpec.Obj()) {
+            if (field.fieldNameStringData() == "_id") {
+                maintainer->_idExpression = parseIdExpression(expCtx.get(), field, vps);
+                if (!maintainer->_idExpression) {
+                    return nullptr;
+                }
+                continue;
+            }
+            if (field.type() != BSONType::Object ||
+                !kIncrementalAccumulators.contains(field.Obj().firstElementFieldNameStringData())) {
+                return nullptr;
+            }
+            const auto accumulatorName = field.Obj().firstElementFieldNameStringData();
+            maintainer->_isSum.push_back(accumulatorName == "$sum" || accumulatorName == "$count");
+            maintainer->_accumulatedFields.push_back(
+                AccumulationStatement::parseAccumulationStatement(expCtx.get(), field, vps));
+        }
+        if (!maintainer->_idExpression) {
+            return nullptr;
+        }
+
+        // The maintainer outlives the operation, see apply().
+        expCtx->opCtx = nullptr;
+        return maintainer;
+    } catch (const DBException&) {
+        // An invalid pipeline fails when it runs, and its result is not cached in the first place.
+        return nullptr;
+    }
+}
+
+boost::optional<std::vector<BSONObj>> GroupResultMaintainer::apply(
+    OperationContext* opCtx,
+    const std::vector<BSONObj>& result,
+    const std::vector<BSONObj>& inserted) {
+    _expCtx->opCtx = opCtx;
+    ON_BLOCK_EXIT([&] { _expCtx->opCtx = nullptr; });
+
+    // The simple collation is required, so the key comparisons need no collator.
+    const ValueComparator comparator;
+    if (!_groupPositions) {
+        _groupPositions.emplace(comparator.makeUnorderedValueMap<size_t>());
+        for (size_t pos = 0; pos < result.size(); ++pos) {
+            _groupPositions->emplace(Value(result[pos]["_id"]), pos);
+        }
+        if (_groupPositions->size() != result.size()) {
+            return boost::none;
+        }
+    }
+
+    try {
+        std::vector<BSONObj> updated = result;
+
+        // The accumulators of the groups that the inserted documents fall in, by position.
+        stdx::unordered_map<size_t, std::vector<boost::intrusive_ptr<AccumulatorState>>> changed;
+        for (auto&& bson : inserted) {
+            if (std::any_of(_filters.begin(), _filters.end(), [&](auto&& filter) {
+                    return !filter->matchesBSON(bson);
+                })) {
+                continue;
+            }
+
+            const Document doc(bson);
+            Value id = _idExpression->evaluate(doc, &_expCtx->variables);
+            if (id.missing()) {
+                id = Value(BSONNULL);
+            }
+
+            auto [groupIt, isNewGroup] = _groupPositions->emplace(id, updated.size());
+            auto [accumulatorsIt, isNewChange] = changed.try_emplace(groupIt->second);
+            auto& accumulators = accumulatorsIt->second;
+            if (isNewChange) {
+                const Document current =
+                    isNewGroup ? Document() : Document(updated[groupIt->second]);
+                for (auto&& field : _accumulatedFields) {
+                    auto accumulator = field.makeAccumulator();
+                    accumulator->startNewGroup(
+                        field.expr.initializer->evaluate(Document(), &_expCtx->variables));
+                    // The current value of a $sum, $min or $max accumulates like one more input.
+                    if (!isNewGroup) {
+                        accumulator->process(current[field.fieldName], false);
+                    }
+                    accumulators.push_back(std::move(accumulator));
+                }
+            }
+            if (isNewGroup) {
+                updated.push_back(BSON("_id" << id));
+            }
+
+            for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+                accumulators[i]->process(
+                    _accumulatedFields[i].expr.argument->evaluate(doc, &_expCtx->variables),
+                    false);
+            }
+        }
+
+        for (auto&& [pos, accumulators] : changed) {
+            MutableDocument group{Document(updated[pos])};
+            for (size_t i = 0; i < _accumulatedFields.size(); ++i) {
+                auto value = accumulators[i]->getValue(false);
+                // Running the pipeline again may add the doubles or decimals of a sum in another
+                // order, and so round it differently. An integer sum which overflowed to a double
+                // is left out as well.
+                if (_isSum[i] && value.getType() != BSONType::NumberInt &&
+                    value.getType() != BSONType::NumberLong) {
+                    _groupPositions.reset();
+                    return boost::none;
+                }
+                group.setField(_accumulatedFields[i].fieldName, std::move(value));
+            }
+            updated[pos] = group.freeze().toBson();
+        }
+        return updated;
+    } catch (const DBException&) {
+        // The positions of the groups may now be ahead of the result, so start over next time.
+        _groupPositions.reset();
+        return boost::none;
+    }
+}
+
+}  // namespace mongo
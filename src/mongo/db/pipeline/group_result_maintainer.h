@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/intrusive_ptr.hpp>
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression.h"
+
+namespace mongo {
+
+class AggregateCommandRequest;
+class OperationContext;
+
+/**
+ * Keeps the cached result of a $group, optionally preceded by $match stages, up to date as
+ * documents are inserted into its input collection, without running the pipeline again. This is
+ * only possible when every accumulator can be updated from its current value and the new
+ * documents: $sum, $count, $min and $max. Updates and deletes still require running the pipeline
+ * again. So does a $sum which is not an integer, since a sum of doubles or decimals depends on the
+ * order in which its terms are added.
+ *
+ * Not thread-safe. The AggregationResultCache serializes the calls to apply() of a maintainer.
+ */
+class GroupResultMaintainer {
+public:
+    /**
+     * Returns a maintainer for the result of 'request', or nullptr if its pipeline does not have
+     * the supported shape. The request must use the simple collation.
+     */
+    static std::unique_ptr<GroupResultMaintainer> make(OperationContext* opCtx,
+                                                       const AggregateCommandRequest& request);
+
+    /**
+     * Returns 'result' updated with the documents in 'inserted', or boost::none if that is not
+     * possible, e.g. because an expression failed to evaluate on one of them or a $sum of the
+     * updated groups is no longer an integer.
+     */
+    boost::optional<std::vector<BSONObj>> apply(OperationContext* opCtx,
+                                                const std::vector<BSONObj>& result,
+                                                const std::vector<BSONObj>& inserted);
+
+private:
+    explicit GroupResultMaintainer(boost::intrusive_ptr<ExpressionContext> expCtx);
+
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+
+    std::vector<std::unique_ptr<MatchExpression>> _filters;
+    boost::intrusive_ptr<Expression> _idExpression;
+    std::vector<AccumulationStatement> _accumulatedFields;
+
+    // Whether each of '_accumulatedFields' is a $sum or a $count.
+    std::vector<bool> _isSum;
+
+    // The position of each group in the result, built on the first call to apply().
+    boost::optional<ValueUnorderedMap<size_t>> _groupPositions;
+};
+
+}  // namespace mongo
@@ -31,17 +31,111 @@
 
 #include "mongo/db/pipeline/javascript_execution.h"
 
+#include <deque>
 #include <iostream>
 
 #include "mongo/base/status_with.h"
+#include "mongo/db/auth/authorization_session.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
 namespace {
 const auto getExec = OperationContext::declareDecoration<std::unique_ptr<JsExecution>>();
+
+// Matches the reuse time of the scopes pooled by the ScriptEngine.
+const auto kMaxScopeReuseTime = Seconds(10);
+
+/**
+ * Idle scopes kept for reuse by later JsExecutions on the same thread. The scopes are created by
+ * newScopeForCurrentThread() and so cannot move between threads. A reused scope keeps the functions
+ * already compiled in it, which saves both starting a new JS runtime and compiling the same
+ * function again for each operation.
+ */
+class ThreadScopePool {
+public:
+    std::unique_ptr<Scope> tryAcquire(const std::string& poolName) {
+        for (auto it = _scopes.begin(); it != _scopes.end(); ++it) {
+            if (it->first == poolName) {
+                auto scope = std::move(it->second);
+                _scopes.erase(it);
+                return scope;
+            }
+        }
+        return nullptr;
+    }
+
+    void release(const std::string& poolName, std::unique_ptr<Scope> scope) {
+        if (scope->hasOutOfMemoryException()) {
+            _scopes.clear();
+            return;
+        }
+
+        const auto maxPoolSize = static_cast<size_t>(internalQueryJavaScriptScopePoolSize.load());
+        if (maxPoolSize == 0 || !scope->getError().empty() ||
+            Date_t::now() - scope->getCreateTime() > kMaxScopeReuseTime) {
+            return;
+        }
+
+        scope->reset();
+        _scopes.emplace_front(poolName, std::move(scope));
+        while (_scopes.size() > maxPoolSize) {
+            // Prefer to keep recently used scopes.
+            _scopes.pop_back();
+        }
+    }
+
+private:
+    std::deque<std::pair<std::string, std::unique_ptr<Scope>>> _scopes;
+};
+
+thread_local ThreadScopePool threadScopePool;
+
+/**
+ * Scopes keep the globals of the operations which used them, so they are only reused by operations
+ * on the same database, run by the same users, with the same heap limit and stored procedures.
+ */
+std::string makePoolName(OperationContext* opCtx,
+                         StringData database,
+                         bool loadStoredProcedures,
+                         boost::optional<int> jsHeapLimitMB) {
+    StringBuilder sb;
+    sb << database << '\0' << loadStoredProcedures << '\0' << jsHeapLimitMB.value_or(-1);
+
+    auto as = AuthorizationSession::get(opCtx->getClient());
+    for (auto nameIter = as->getAuthenticatedUserNames(); nameIter.more(); nameIter.next()) {
+        // Using a NUL byte which isn't valid in usernames to separate them.
+        sb << '\0' << nameIter->getUnambiguousName();
+    }
+
+    return sb.str();
+}
 }  // namespace
 
+JsExecution::JsExecution(OperationContext* opCtx,
+                         const BSONObj& scopeVars,
+                         boost::optional<int> jsHeapLimitMB,
+                         std::string poolName)
+    : _poolName(std::move(poolName)) {
+    if (!_poolName.empty()) {
+        _scope = threadScopePool.tryAcquire(_poolName);
+    }
+    if (!_scope) {
+        _scope.reset(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB));
+    }
+    _scopeVars = scopeVars.getOwned();
+    _scope->init(&_scopeVars);
+    _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
+    _scope->registerOperation(opCtx);
+}
+
+JsExecution::~JsExecution() {
+    _scope->unregisterOperation();
+    if (!_poolName.empty()) {
+        threadScopePool.release(_poolName, std::move(_scope));
+    }
+}
+
 JsExecution* JsExecution::get(OperationContext* opCtx,
                               const BSONObj& scope,
                               StringData database,
@@ -49,7 +143,11 @@ JsExecution* JsExecution::get(OperationContext* opCtx,
                               boost::optional<int> jsHeapLimitMB) {
     auto& exec = getExec(opCtx);
     if (!exec) {
-        exec = std::make_unique<JsExecution>(opCtx, scope, jsHeapLimitMB);
+        exec = std::make_unique<JsExecution>(
+            opCtx,
+            scope,
+            jsHeapLimitMB,
+            makePoolName(opCtx, database, loadStoredProcedures, jsHeapLimitMB));
         exec->getScope()->setLocalDB(database);
         if (loadStoredProcedures) {
             exec->getScope()->loadStored(opCtx, true);
@@ -59,21 +59,17 @@ public:
                             bool loadStoredProcedures,
                             boost::optional<int> jsHeapLimitMB);
     /**
-     * Construct with a thread-local scope and initialize with the given scope variables.
+     * Construct with a thread-local scope and initialize with the given scope variables. If
+     * 'poolName' is not empty, an idle scope released by an earlier JsExecution on this thread with
+     * the same pool name is reused when there is one, and the scope is released for reuse again on
+     * destruction.
      */
     JsExecution(OperationContext* opCtx,
                 const BSONObj& scopeVars,
-                boost::optional<int> jsHeapLimitMB = boost::none)
-        : _scope(getGlobalScriptEngine()->newScopeForCurrentThread(jsHeapLimitMB)) {
-        _scopeVars = scopeVars.getOwned();
-        _scope->init(&_scopeVars);
-        _fnCallTimeoutMillis = internalQueryJavaScriptFnTimeoutMillis.load();
-        _scope->registerOperation(opCtx);
-    }
+                boost::optional<int> jsHeapLimitMB = boost::none,
+                std::string poolName = "");
 
-    ~JsExecution() {
-        _scope->unregisterOperation();
-    };
+    ~JsExecution();
 
     /**
      * Invokes the javascript function given by 'func' with the arguments 'params' and input object
@@ -117,6 +113,7 @@ public:
 
 private:
     BSONObj _scopeVars;
+    std::string _poolName;
     std::unique_ptr<Scope> _scope;
     bool _emitCreated = false;
     bool _storedProceduresLoaded = false;
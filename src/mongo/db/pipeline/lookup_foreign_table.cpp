@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_foreign_table.h"
+
+#include "mongo/db/matcher/expression_parser.h"
+
+namespace mongo {
+
+namespace {
+
+/**
+ * Returns the value at 'path' in 'doc' if it can be compared for equality on its own: the path
+ * must not go through an array, and the value must not be an array, missing, null or undefined,
+ * all of which have their own matching rules.
+ */
+boost::optional<Value> getSingleValueAtPath(const Document& doc, const FieldPath& path) {
+    auto value = doc.getField(path.getFieldName(0));
+    for (size_t i = 1; i < path.getPathLength(); ++i) {
+        if (value.getType() != BSONType::Object)
+            return boost::none;
+        value = value.getDocument().getField(path.getFieldName(i));
+    }
+
+    if (value.missing() || value.nullish() || value.isArray())
+        return boost::none;
+
+    return value;
+}
+
+}  // namespace
+
+LookupForeignTable::LookupForeignTable(const boost::intrusive_ptr<ExpressionContext>& foreignExpCtx,
+                                       FieldPath foreignField)
+    : _expCtx(foreignExpCtx),
+      _foreignField(std::move(foreignField)),
+      _positionsByValue(
+          _expCtx->getValueComparator().makeUnorderedValueMap<std::vector<size_t>>()) {}
+
+void LookupForeignTable::add(Document doc) {
+    const size_t position = _docs.size();
+    _sizeBytes += doc.getApproximateSize();
+
+    if (auto value = getSingleValueAtPath(doc, _foreignField)) {
+        _positionsByValue[*value].push_back(position);
+    } else {
+        auto obj = doc.toBson();
+        _sizeBytes += obj.objsize();
+        _unindexed.emplace_back(position, std::move(obj));
+    }
+
+    _docs.emplace_back(std::move(doc));
+}
+
+std::vector<Value> LookupForeignTable::lookup(const std::vector<Value>& localValues,
+                                              const BSONObj& joinFilter) const {
+    std::vector<size_t> positions;
+
+    // The indexed documents hold a single value, which a local value matches only if they are
+    // equal. Local arrays and nulls can only match the unindexed documents.
+    for (const auto& localValue : localValues) {
+        auto it = _positionsByValue.find(localValue);
+        if (it != _positionsByValue.end()) {
+            positions.insert(positions.end(), it->second.begin(), it->second.end());
+        }
+    }
+
+    if (!_unindexed.empty()) {
+        auto matcher = uassertStatusOK(MatchExpressionParser::parse(joinFilter, _expCtx));
+        for (const auto& [position, obj] : _unindexed) {
+            if (matcher->matchesBSON(obj)) {
+                positions.push_back(position);
+            }
+        }
+    }
+
+    // A document is returned once even if it matches several local values.
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    std::vector<Value> results;
+    results.reserve(positions.size());
+    for (auto position : positions) {
+        results.emplace_back(_docs[position]);
+    }
+    return results;
+}
+
+}  // namespace mongo
@@ -0,0 +1,92 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
+#include "mongo/db/pipeline/expression_context.h"
+#include "mongo/db/pipeline/field_path.h"
+
+namespace mongo {
+
+/**
+ * Holds a set of documents from the foreign collection of a $lookup with 'localField' and
+ * 'foreignField', and answers which of them join with a given input document without running a
+ * query. Documents whose 'foreignField' is a single value are indexed by that value. The others,
+ * whose path holds an array or is missing or null, are compared to the $match built for each input
+ * document one at a time, so that the results are exactly those of the query.
+ */
+class LookupForeignTable {
+    LookupForeignTable(const LookupForeignTable&) = delete;
+    LookupForeignTable& operator=(const LookupForeignTable&) = delete;
+
+public:
+    LookupForeignTable(const boost::intrusive_ptr<ExpressionContext>& foreignExpCtx,
+                       FieldPath foreignField);
+
+    /**
+     * Adds a document. Documents are returned by lookup() in the order they were added.
+     */
+    void add(Document doc);
+
+    /**
+     * Returns the documents which match 'joinFilter', the $match predicate built from an input
+     * document whose values on 'localField' are 'localValues'.
+     */
+    std::vector<Value> lookup(const std::vector<Value>& localValues,
+                              const BSONObj& joinFilter) const;
+
+    size_t count() const {
+        return _docs.size();
+    }
+
+    size_t sizeBytes() const {
+        return _sizeBytes;
+    }
+
+private:
+    boost::intrusive_ptr<ExpressionContext> _expCtx;
+    FieldPath _foreignField;
+
+    std::vector<Document> _docs;
+
+    // Maps each single value of 'foreignField' to the positions in '_docs' holding it.
+    ValueUnorderedMap<std::vector<size_t>> _positionsByValue;
+
+    // The positions of the documents which are not indexed by value, with their BSON form for
+    // matching.
+    std::vector<std::pair<size_t, BSONObj>> _unindexed;
+
+    size_t _sizeBytes = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/pipeline/lookup_foreign_table.h"
+
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/aggregation_context_fixture.h"
+#include "mongo/db/pipeline/document_path_support.h"
+#include "mongo/db/pipeline/document_source_lookup.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using LookupForeignTableTest = AggregationContextFixture;
+
+const std::vector<Document> kForeignDocs = {
+    Document(fromjson("{_id: 0, b: 1}")),
+    Document(fromjson("{_id: 1, b: 1.0}")),
+    Document(fromjson("{_id: 2, b: [1, 2]}")),
+    Document(fromjson("{_id: 3, b: [[1, 2]]}")),
+    Document(fromjson("{_id: 4, b: null}")),
+    Document(fromjson("{_id: 5}")),
+    Document(fromjson("{_id: 6, b: 'abc'}")),
+    Document(fromjson("{_id: 7, b: {c: 1}}")),
+    Document(fromjson("{_id: 8, b: [null, 3]}")),
+    Document(fromjson("{_id: 9, b: 2}")),
+};
+
+/**
+ * Returns the documents of 'kForeignDocs' which the $match of a $lookup built from 'localDoc'
+ * selects, in order.
+ */
+std::vector<Value> lookupByQuery(const boost::intrusive_ptr<ExpressionContext>& expCtx,
+                                 const Document& localDoc) {
+    auto match = DocumentSourceLookUp::makeMatchStageFromInput(
+        localDoc, FieldPath("a"), "b", BSONObj());
+    auto matcher =
+        uassertStatusOK(MatchExpressionParser::parse(match.firstElement().Obj(), expCtx));
+
+    std::vector<Value> results;
+    for (const auto& doc : kForeignDocs) {
+        if (matcher->matchesBSON(doc.toBson())) {
+            results.emplace_back(doc);
+        }
+    }
+    return results;
+}
+
+std::vector<Value> lookupInTable(const LookupForeignTable& table, const Document& localDoc) {
+    auto match = DocumentSourceLookUp::makeMatchStageFromInput(
+        localDoc, FieldPath("a"), "b", BSONObj());
+
+    std::vector<Value> localValues;
+    document_path_support::visitAllValuesAtPath(
+        localDoc, FieldPath("a"), [&](const Value& value) { localValues.push_back(value); });
+    if (localValues.empty()) {
+        localValues.emplace_back(BSONNULL);
+    }
+
+    return table.lookup(localValues, match.firstElement().Obj());
+}
+
+TEST_F(LookupForeignTableTest, ReturnsSameDocumentsAsQuery) {
+    LookupForeignTable table(getExpCtx(), FieldPath("b"));
+    for (const auto& doc : kForeignDocs) {
+        table.add(doc);
+    }
+    ASSERT_EQ(table.count(), kForeignDocs.size());
+
+    const std::vector<Document> localDocs = {
+        Document(fromjson("{a: 1}")),
+        Document(fromjson("{a: 2}")),
+        Document(fromjson("{a: [1, 3]}")),
+        Document(fromjson("{a: [[1, 2]]}")),
+        Document(fromjson("{a: null}")),
+        Document(fromjson("{}")),
+        Document(fromjson("{a: 'abc'}")),
+        Document(fromjson("{a: {c: 1}}")),
+        Document(fromjson("{a: 'none'}")),
+    };
+
+    for (const auto& localDoc : localDocs) {
+        auto expected = lookupByQuery(getExpCtx(), localDoc);
+        auto actual = lookupInTable(table, localDoc);
+        ASSERT_VALUE_EQ(Value(actual), Value(expected));
+    }
+}
+
+TEST_F(LookupForeignTableTest, DocumentMatchingSeveralValuesIsReturnedOnce) {
+    LookupForeignTable table(getExpCtx(), FieldPath("b"));
+    for (const auto& doc : kForeignDocs) {
+        table.add(doc);
+    }
+
+    auto results = lookupInTable(table, Document(fromjson("{a: [1, 2, 1]}")));
+    std::vector<Value> ids;
+    for (const auto& result : results) {
+        ids.push_back(result.getDocument()["_id"]);
+    }
+    ASSERT_VALUE_EQ(Value(ids), Value(fromjson("{ids: [0, 1, 2, 9]}")["ids"]));
+}
+
+}  // namespace
+}  // namespace mongo
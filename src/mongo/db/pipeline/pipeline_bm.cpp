@@ -0,0 +1,199 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/pipeline/process_interface/stub_lookup_single_document_process_interface.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_test_service_context.h"
+#include "mongo/platform/random.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kOrdersNss("test", "orders");
+const NamespaceString kCustomersNss("test", "customers");
+
+/**
+ * The number of orders is the first argument of the benchmarks and the number of customers, which
+ * is the number of groups of most of the pipelines, the second.
+ */
+const std::vector<std::vector<int64_t>> kOrdersAndCustomers = {{1 << 12, 1 << 15}, {16, 1024}};
+
+/**
+ * Returns 'numOrders' documents of the shape
+ *     {_id, customer, status, amount, ts, items: [{sku, qty}, ...]}
+ * spread randomly over 'numCustomers' customers.
+ */
+std::deque<DocumentSource::GetNextResult> makeOrders(int64_t numOrders, int64_t numCustomers) {
+    PseudoRandom random(int64_t{12345});
+    std::deque<DocumentSource::GetNextResult> orders;
+    for (int64_t i = 0; i < numOrders; ++i) {
+        BSONArrayBuilder items;
+        for (int64_t j = 0, numItems = 1 + random.nextInt64(4); j < numItems; ++j) {
+            items.append(BSON("sku" << random.nextInt64(200) << "qty" << 1 + random.nextInt64(5)));
+        }
+        orders.emplace_back(Document{BSON("_id" << i << "customer" << random.nextInt64(numCustomers)
+                                                << "status" << (i % 3 == 0 ? "A" : "B")
+                                                << "amount" << random.nextInt64(10000) << "ts"
+                                                << Date_t::fromMillisSinceEpoch(i * 1000)
+                                                << "items" << items.arr())});
+    }
+    return orders;
+}
+
+std::deque<DocumentSource::GetNextResult> makeCustomers(int64_t numCustomers) {
+    std::deque<DocumentSource::GetNextResult> customers;
+    for (int64_t i = 0; i < numCustomers; ++i) {
+        customers.emplace_back(
+            Document{BSON("_id" << i << "name"
+                                << "customer" + std::to_string(i) << "region" << i % 7)});
+    }
+    return customers;
+}
+
+/**
+ * Runs an aggregation pipeline over the orders, read from an in-memory source, once per iteration
+ * of 'state'. Reports the number of orders read per second, and for each stage which tracks it
+ * the memory it used and whether it spilled to disk in the last iteration.
+ */
+void runPipeline(benchmark::State& state, const std::vector<BSONObj>& rawPipeline) {
+    QueryTestServiceContext serviceContext;
+    auto opCtx = serviceContext.makeOperationContext();
+
+    const auto numOrders = state.range(0);
+    const auto numCustomers = state.range(1);
+    const auto orders = makeOrders(numOrders, numCustomers);
+
+    auto tempDir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    boost::intrusive_ptr<ExpressionContextForTest> expCtx =
+        new ExpressionContextForTest(opCtx.get(), kOrdersNss);
+    expCtx->allowDiskUse = true;
+    expCtx->tempDir = tempDir.string();
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {kCustomersNss.coll().toString(), {kCustomersNss, std::vector<BSONObj>()}}});
+    expCtx->mongoProcessInterface =
+        std::make_shared<StubLookupSingleDocumentProcessInterface>(makeCustomers(numCustomers));
+
+    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        pipeline = Pipeline::parse(rawPipeline, expCtx);
+        pipeline->optimizePipeline();
+        pipeline->addInitialSource(DocumentSourceMock::createForTest(orders, expCtx));
+        state.ResumeTiming();
+
+        while (auto next = pipeline->getNext()) {
+            benchmark::DoNotOptimize(*next);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numOrders);
+
+    for (auto&& stage : pipeline->getSources()) {
+        std::vector<Value> explain;
+        stage->serializeToArray(explain, ExplainOptions::Verbosity::kExecStats);
+        for (auto&& value : explain) {
+            if (value.getType() != BSONType::Object) {
+                continue;
+            }
+            const auto doc = value.getDocument();
+            const std::string stageName = stage->getSourceName();
+            long long memoryBytes = 0;
+            if (auto accums = doc["maxAccumulatorMemoryUsageBytes"]; !accums.missing()) {
+                for (auto it = accums.getDocument().fieldIterator(); it.more();) {
+                    memoryBytes += it.next().second.coerceToLong();
+                }
+            }
+            if (auto sorted = doc["totalDataSizeSortedBytesEstimate"]; !sorted.missing()) {
+                memoryBytes += sorted.coerceToLong();
+            }
+            if (memoryBytes) {
+                state.counters[stageName + "MemoryBytes"] = memoryBytes;
+            }
+            if (doc["usedDisk"].getType() == BSONType::Bool) {
+                state.counters[stageName + "UsedDisk"] = doc["usedDisk"].getBool();
+            }
+        }
+    }
+    pipeline.reset();
+    boost::filesystem::remove_all(tempDir);
+}
+
+void BM_MatchGroup(benchmark::State& state) {
+    runPipeline(state,
+                {fromjson("{$match: {status: 'A', amount: {$gte: 1000}}}"),
+                 fromjson("{$group: {_id: '$customer', total: {$sum: '$amount'}, "
+                          "n: {$sum: 1}, last: {$max: '$ts'}}}")});
+}
+
+void BM_Lookup(benchmark::State& state) {
+    runPipeline(state,
+                {fromjson("{$match: {status: 'A'}}"),
+                 fromjson("{$lookup: {from: 'customers', localField: 'customer', "
+                          "foreignField: '_id', as: 'customerDoc'}}"),
+                 fromjson("{$unwind: '$customerDoc'}")});
+}
+
+void BM_UnwindGroup(benchmark::State& state) {
+    runPipeline(state,
+                {fromjson("{$unwind: '$items'}"),
+                 fromjson("{$group: {_id: '$items.sku', qty: {$sum: '$items.qty'}, "
+                          "customers: {$addToSet: '$customer'}}}")});
+}
+
+void BM_SetWindowFields(benchmark::State& state) {
+    runPipeline(state,
+                {fromjson("{$setWindowFields: {partitionBy: '$customer', sortBy: {ts: 1}, "
+                          "output: {running: {$sum: '$amount', "
+                          "window: {documents: ['unbounded', 'current']}}, "
+                          "recent: {$avg: '$amount', window: {documents: [-10, 0]}}}}}")});
+}
+
+void BM_SortWithSpill(benchmark::State& state) {
+    // Leave the sort a small fraction of the memory the orders take, so that it spills.
+    const auto previousLimit = internalQueryMaxBlockingSortMemoryUsageBytes.load();
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(64 * 1024);
+    runPipeline(state, {fromjson("{$sort: {amount: -1, _id: 1}}")});
+    internalQueryMaxBlockingSortMemoryUsageBytes.store(previousLimit);
+}
+
+BENCHMARK(BM_MatchGroup)->ArgsProduct(kOrdersAndCustomers);
+BENCHMARK(BM_Lookup)->ArgsProduct({{1 << 10, 1 << 12}, {16, 1024}});
+BENCHMARK(BM_UnwindGroup)->ArgsProduct(kOrdersAndCustomers);
+BENCHMARK(BM_SetWindowFields)->ArgsProduct(kOrdersAndCustomers);
+BENCHMARK(BM_SortWithSpill)->ArgsProduct(kOrdersAndCustomers);
+
+}  // namespace
+}  // namespace mongo
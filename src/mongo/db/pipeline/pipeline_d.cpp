@@ -73,6 +73,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_executor_factory.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sort_pattern.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -94,15 +95,84 @@ using std::unique_ptr;
 using write_ops::InsertCommandRequest;
 
 namespace {
+/**
+ * Samples blocks of consecutive records: each record returned by a random cursor starts a block,
+ * which is read on with a forward cursor up to 'blockSize' records or the end of the collection.
+ * Reading on from a random position costs much less than a random descent per record, in exchange
+ * for records stored close to each other being sampled together. Blocks may overlap, and so
+ * return the same record more than once.
+ */
+class BlockSampleRecordCursor final : public RecordCursor {
+public:
+    BlockSampleRecordCursor(std::unique_ptr<RecordCursor> randomCursor,
+                            std::unique_ptr<SeekableRecordCursor> forwardCursor,
+                            long long blockSize)
+        : _randomCursor(std::move(randomCursor)),
+          _forwardCursor(std::move(forwardCursor)),
+          _blockSize(blockSize) {}
+
+    boost::optional<Record> next() final {
+        if (_remainingInBlock > 0) {
+            --_remainingInBlock;
+            if (auto record = _forwardCursor->next()) {
+                return record;
+            }
+            _remainingInBlock = 0;
+        }
+
+        auto start = _randomCursor->next();
+        if (!start) {
+            return boost::none;
+        }
+
+        // Position the forward cursor on the start of the block. If the record is gone, the block
+        // is only the record itself.
+        if (auto record = _forwardCursor->seekExact(start->id)) {
+            _remainingInBlock = _blockSize - 1;
+            return record;
+        }
+        return start;
+    }
+
+    void save() final {
+        _randomCursor->save();
+        _forwardCursor->save();
+    }
+
+    bool restore() final {
+        return _randomCursor->restore() && _forwardCursor->restore();
+    }
+
+    void detachFromOperationContext() final {
+        _randomCursor->detachFromOperationContext();
+        _forwardCursor->detachFromOperationContext();
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) final {
+        _randomCursor->reattachToOperationContext(opCtx);
+        _forwardCursor->reattachToOperationContext(opCtx);
+    }
+
+private:
+    const std::unique_ptr<RecordCursor> _randomCursor;
+    const std::unique_ptr<SeekableRecordCursor> _forwardCursor;
+    const long long _blockSize;
+
+    // The number of records left to return from the forward cursor in the current block.
+    long long _remainingInBlock = 0;
+};
+
 /**
  * Returns a 'PlanExecutor' which uses a random cursor to sample documents if successful as
  * determined by the boolean. Returns {} if the storage engine doesn't support random cursors, or if
- * 'sampleSize' is a large enough percentage of the collection.
+ * 'sampleSize' is a large enough percentage of the collection. If 'blockSize' is more than 1, the
+ * random cursor samples blocks of that many consecutive records.
  */
 StatusWith<std::pair<unique_ptr<PlanExecutor, PlanExecutor::Deleter>, bool>>
 createRandomCursorExecutor(const CollectionPtr& coll,
                            const boost::intrusive_ptr<ExpressionContext>& expCtx,
                            long long sampleSize,
+                           long long blockSize,
                            long long numRecords,
                            boost::optional<BucketUnpacker> bucketUnpacker) {
     OperationContext* opCtx = expCtx->opCtx;
@@ -139,6 +209,11 @@ createRandomCursorExecutor(const CollectionPtr& coll,
         return std::pair{nullptr, false};
     }
 
+    if (blockSize > 1 && !expCtx->ns.isTimeseriesBucketsCollection()) {
+        rsRandCursor = std::make_unique<BlockSampleRecordCursor>(
+            std::move(rsRandCursor), coll->getRecordStore()->getCursor(opCtx), blockSize);
+    }
+
     // Build a MultiIteratorStage and pass it the random-sampling RecordCursor.
     auto ws = std::make_unique<WorkingSet>();
     std::unique_ptr<PlanStage> root =
@@ -270,6 +345,7 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
     BSONObj sortObj,
     SkipThenLimit skipThenLimit,
     boost::optional<std::string> groupIdForDistinctScan,
+    boost::optional<CanonicalQuery::GroupPushdown> groupForPushdown,
     const AggregateCommandRequest* aggRequest,
     const size_t plannerOpts,
     const MatchExpressionParser::AllowedFeatureSet& matcherFeatures) {
@@ -345,6 +421,10 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> attemptToGetExe
         }
     }
 
+    // Offer the $group to the query system. Whether or not it was accepted can be found out from
+    // the CanonicalQuery held by the returned executor.
+    cq.getValue()->setGroupForPushdown(std::move(groupForPushdown));
+
     bool permitYield = true;
     return getExecutorFind(
         expCtx->opCtx, &collection, std::move(cq.getValue()), permitYield, plannerOpts);
@@ -447,8 +527,9 @@ PipelineD::buildInnerQueryExecutorSample(DocumentSourceSample* sampleStage,
     if (unpackBucketStage) {
         bucketUnpacker = unpackBucketStage->bucketUnpacker();
     }
+    const long long blockSize = sampleStage->getBlockSize();
     auto&& [exec, isStorageOptimizedSample] = uassertStatusOK(createRandomCursorExecutor(
-        collection, expCtx, sampleSize, numRecords, std::move(bucketUnpacker)));
+        collection, expCtx, sampleSize, blockSize, numRecords, std::move(bucketUnpacker)));
 
     AttachExecutorCallback attachExecutorCallback;
     if (exec) {
@@ -458,7 +539,7 @@ PipelineD::buildInnerQueryExecutorSample(DocumentSourceSample* sampleStage,
                 pipeline->popFront();
                 std::string idString = collection->ns().isOplog() ? "ts" : "_id";
                 pipeline->addInitialSource(DocumentSourceSampleFromRandomCursor::create(
-                    expCtx, sampleSize, idString, numRecords));
+                    expCtx, sampleSize, idString, numRecords, blockSize));
             }
         } else {
             if (isStorageOptimizedSample) {
@@ -600,6 +681,21 @@ getSortAndGroupStagesFromPipeline(const Pipeline::SourceContainer& sources) {
     return std::make_pair(sortStage, groupStage);
 }
 
+/**
+ * Returns the sort pattern which orders documents in the reverse of 'sortObj', or boost::none if
+ * 'sortObj' sorts on metadata and so cannot be reversed. An empty pattern reverses to itself.
+ */
+boost::optional<BSONObj> reverseSortPattern(const BSONObj& sortObj) {
+    BSONObjBuilder reversed;
+    for (auto&& elem : sortObj) {
+        if (!elem.isNumber()) {
+            return boost::none;
+        }
+        reversed.append(elem.fieldName(), elem.number() < 0 ? 1 : -1);
+    }
+    return reversed.obj();
+}
+
 boost::optional<long long> extractSkipForPushdown(Pipeline* pipeline) {
     // If the disablePipelineOptimization failpoint is enabled, then do not attempt the skip
     // pushdown optimization.
@@ -671,6 +767,51 @@ auto buildProjectionForPushdown(const DepsTracker& deps, Pipeline* pipeline) {
     // happen. This covers cases 2 and 3.
     return deps.toProjectionWithoutMetadata();
 }
+
+/**
+ * If the pipeline begins with a $group which the SBE engine knows how to execute, returns a
+ * description of it which can be offered to the query system. The $group is left in the pipeline;
+ * it is up to the caller to remove it if the offer is accepted.
+ *
+ * Only single-key groups computing $min, $max, $first, $last, $push and $addToSet are eligible.
+ * When disk use is allowed, only $min and $max are, since the partial results of the others cannot
+ * be merged back once SBE has spilled them, whereas the classic $group can spill them all.
+ */
+boost::optional<CanonicalQuery::GroupPushdown> extractGroupForPushdown(
+    const intrusive_ptr<ExpressionContext>& expCtx, Pipeline* pipeline) {
+    static const StringDataSet kSupportedAccumulators{
+        "$min", "$max", "$first", "$last", "$push", "$addToSet"};
+    static const StringDataSet kSpillableAccumulators{"$min", "$max"};
+
+    auto&& sources = pipeline->getSources();
+    if (sources.empty()) {
+        return boost::none;
+    }
+
+    auto groupStage = dynamic_cast<DocumentSourceGroup*>(sources.front().get());
+    if (!groupStage || groupStage->doingMerge()) {
+        return boost::none;
+    }
+
+    // Compound group keys, such as {_id: {a: "$a", b: "$b"}}, are not supported.
+    auto idFields = groupStage->getIdFields();
+    if (idFields.size() != 1 || idFields.begin()->first != "_id") {
+        return boost::none;
+    }
+
+    const auto& supportedAccumulators =
+        expCtx->allowDiskUse ? kSpillableAccumulators : kSupportedAccumulators;
+    for (auto&& acc : groupStage->getAccumulatedFields()) {
+        if (!supportedAccumulators.count(acc.expr.makeAccumulator()->getOpName())) {
+            return boost::none;
+        }
+    }
+
+    return CanonicalQuery::GroupPushdown{idFields.begin()->second,
+                                         groupStage->getAccumulatedFields(),
+                                         expCtx->allowDiskUse,
+                                         groupStage->getMaxMemoryUsageBytes()};
+}
 }  // namespace
 
 std::pair<PipelineD::AttachExecutorCallback, std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>>
@@ -898,10 +1039,24 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         // projection at the front of the pipeline, it will be removed and handled by the PlanStage
         // layer. If a projection cannot be pushed down, an empty BSONObj will be returned.
         projObj = buildProjectionForPushdown(deps, pipeline);
-        plannerOpts |= QueryPlannerParams::RETURN_OWNED_DATA;
+
+        // With shared buffers, the $cursor stage copies the documents which still point into
+        // storage itself, so the query layer need not copy each of them on its own.
+        if (internalDocumentSourceCursorSharedBufferBytes.load() == 0) {
+            plannerOpts |= QueryPlannerParams::RETURN_OWNED_DATA;
+        }
+    }
+
+    // A $group of $last accumulators needs the last document of each group in the sort order,
+    // which a DISTINCT_SCAN provides as the first document of the group in the reverse order.
+    boost::optional<BSONObj> distinctScanSortObj = sortObj;
+    if (rewrittenGroupStage &&
+        rewrittenGroupStage->expectedInput() ==
+            GroupFromFirstDocumentTransformation::ExpectedInput::kLastDocument) {
+        distinctScanSortObj = reverseSortPattern(sortObj);
     }
 
-    if (rewrittenGroupStage) {
+    if (rewrittenGroupStage && distinctScanSortObj) {
         // See if the query system can handle the $group and $sort stage using a DISTINCT_SCAN
         // (SERVER-9507).
         auto swExecutorGrouped = attemptToGetExecutor(expCtx,
@@ -910,9 +1065,10 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
                                                       queryObj,
                                                       projObj,
                                                       deps.metadataDeps(),
-                                                      sortObj,
+                                                      *distinctScanSortObj,
                                                       SkipThenLimit{boost::none, boost::none},
                                                       rewrittenGroupStage->groupId(),
+                                                      boost::none, /* groupForPushdown */
                                                       aggRequest,
                                                       plannerOpts,
                                                       matcherFeatures);
@@ -944,18 +1100,27 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> PipelineD::prep
         }
     }
 
-    return attemptToGetExecutor(expCtx,
-                                collection,
-                                nss,
-                                queryObj,
-                                projObj,
-                                deps.metadataDeps(),
-                                sortObj,
-                                skipThenLimit,
-                                boost::none, /* groupIdForDistinctScan */
-                                aggRequest,
-                                plannerOpts,
-                                matcherFeatures);
+    auto swExecutor = attemptToGetExecutor(expCtx,
+                                           collection,
+                                           nss,
+                                           queryObj,
+                                           projObj,
+                                           deps.metadataDeps(),
+                                           sortObj,
+                                           skipThenLimit,
+                                           boost::none, /* groupIdForDistinctScan */
+                                           extractGroupForPushdown(expCtx, pipeline),
+                                           aggRequest,
+                                           plannerOpts,
+                                           matcherFeatures);
+
+    // If the query system has taken over the $group at the front of the pipeline, remove it.
+    if (swExecutor.isOK()) {
+        if (auto cq = swExecutor.getValue()->getCanonicalQuery(); cq && cq->getGroupForPushdown()) {
+            pipeline->popFrontWithName(DocumentSourceGroup::kStageName);
+        }
+    }
+    return swExecutor;
 }
 
 Timestamp PipelineD::getLatestOplogTimestamp(const Pipeline* pipeline) {
@@ -682,6 +682,66 @@ TEST(PipelineOptimizationTest, LookupUnwindShouldNotMoveSortBefore) {
     assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
 }
 
+TEST(PipelineOptimizationTest, AddFieldsMoveBoundedSortNotOnComputedFieldsBefore) {
+    string inputPipe = "[{$addFields: {b: 1}}, {$sort: {a: 1}}, {$limit: 5}]";
+    string outputPipe =
+        "[{$sort: {sortKey: {a: 1}, limit: 5}}, {$addFields: {b: {$const: 1}}}]";
+    string serializedPipe = "[{$sort: {a: 1}}, {$limit: 5}, {$addFields: {b: {$const: 1}}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, AddFieldsShouldNotMoveUnboundedSortBefore) {
+    string inputPipe = "[{$addFields: {b: 1}}, {$sort: {a: 1}}]";
+    string outputPipe = "[{$addFields: {b: {$const: 1}}}, {$sort: {sortKey: {a: 1}}}]";
+    string serializedPipe = "[{$addFields: {b: {$const: 1}}}, {$sort: {a: 1}}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, AddFieldsShouldNotMoveSortOnComputedFieldsBefore) {
+    string inputPipe = "[{$addFields: {'a.b': 1}}, {$sort: {a: 1}}, {$limit: 5}]";
+    string outputPipe =
+        "[{$addFields: {a: {b: {$const: 1}}}}, {$sort: {sortKey: {a: 1}, limit: 5}}]";
+    string serializedPipe = "[{$addFields: {a: {b: {$const: 1}}}}, {$sort: {a: 1}}, {$limit: 5}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+
+    inputPipe = "[{$addFields: {b: '$a'}}, {$sort: {b: 1}}, {$limit: 5}]";
+    outputPipe = "[{$addFields: {b: '$a'}}, {$sort: {sortKey: {b: 1}, limit: 5}}]";
+    serializedPipe = "[{$addFields: {b: '$a'}}, {$sort: {b: 1}}, {$limit: 5}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, ProjectShouldNotMoveBoundedSortBefore) {
+    string inputPipe = "[{$project: {a: 1}}, {$sort: {a: 1}}, {$limit: 5}]";
+    string outputPipe =
+        "[{$project: {_id: true, a: true}}, {$sort: {sortKey: {a: 1}, limit: 5}}]";
+    string serializedPipe = "[{$project: {_id: true, a: true}}, {$sort: {a: 1}}, {$limit: 5}]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
+TEST(PipelineOptimizationTest, LookupAndAddFieldsMoveBoundedSortBefore) {
+    string inputPipe =
+        "[{$lookup: {from : 'lookupColl', as : 'new', localField: 'left', foreignField: "
+        "'right'}}"
+        ",{$addFields: {b: 1}}"
+        ",{$sort: {left: -1}}"
+        ",{$limit: 20}"
+        "]";
+    string outputPipe =
+        "[{$sort: {sortKey: {left: -1}, limit: 20}}"
+        ",{$lookup: {from : 'lookupColl', as : 'new', localField: 'left', foreignField: "
+        "'right'}}"
+        ",{$addFields: {b: {$const: 1}}}"
+        "]";
+    string serializedPipe =
+        "[{$sort: {left: -1}}"
+        ",{$limit: 20}"
+        ",{$lookup: {from : 'lookupColl', as : 'new', localField: 'left', foreignField: "
+        "'right'}}"
+        ",{$addFields: {b: {$const: 1}}}"
+        "]";
+    assertPipelineOptimizesAndSerializesTo(inputPipe, outputPipe, serializedPipe);
+}
+
 TEST(PipelineOptimizationTest, LookupShouldCoalesceWithUnwindOnAs) {
     string inputPipe =
         "[{$lookup: {from : 'lookupColl', as : 'same', localField: 'left', foreignField: "
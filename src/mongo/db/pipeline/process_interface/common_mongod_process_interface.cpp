@@ -427,6 +427,26 @@ std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCacheEntryStat
     return planCache->getMatchingStats(serializer, predicate);
 }
 
+std::vector<BSONObj> CommonMongodProcessInterface::getMatchingPlanCachePartitionStats(
+    OperationContext* opCtx, const NamespaceString& nss, const MatchExpression* matchExp) const {
+    AutoGetCollection collection(opCtx, nss, MODE_IS);
+    uassert(5843132,
+            str::stream() << "collection '" << nss.toString() << "' does not exist",
+            collection);
+
+    const auto planCache = CollectionQueryInfo::get(collection.getCollection()).getPlanCache();
+    invariant(planCache);
+
+    auto stats = planCache->getPartitionStats();
+    if (matchExp) {
+        stats.erase(std::remove_if(stats.begin(),
+                                   stats.end(),
+                                   [&](const BSONObj& obj) { return !matchExp->matchesBSON(obj); }),
+                    stats.end());
+    }
+    return stats;
+}
+
 bool CommonMongodProcessInterface::fieldsHaveSupportingUniqueIndex(
     const boost::intrusive_ptr<ExpressionContext>& expCtx,
     const NamespaceString& nss,
@@ -96,6 +96,10 @@ public:
                                                         const NamespaceString&,
                                                         const MatchExpression*) const final;
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(OperationContext*,
+                                                            const NamespaceString&,
+                                                            const MatchExpression*) const final;
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          const NamespaceString& nss,
                                          const std::set<FieldPath>& fieldPaths) const;
@@ -169,6 +169,13 @@ public:
                                             bool multi,
                                             boost::optional<OID> targetEpoch) = 0;
 
+    /**
+     * Returns true if insert() and update() send their writes through the router code path, in
+     * which case one operation may issue them from several client threads at once as long as each
+     * thread uses an OperationContext of its own.
+     */
+    virtual bool writesAreRouted() const = 0;
+
     /**
      * Returns index usage statistics for each index on collection 'ns' along with additional
      * information including the index specification and whether the index is currently being built.
@@ -358,6 +365,22 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) = 0;
 
+    /**
+     * Looks up the documents with each of the document keys in 'documentKeys', all of which belong
+     * to the same collection. Returns one entry per document key, in the same order, holding the
+     * matching document or boost::none if there is none. Throws if more than one document matches
+     * any document key. The default implementation calls lookupSingleDocument() for each key;
+     * implementations for which a lookup is a remote round-trip should override this to look up
+     * all of the keys at once.
+     */
+    virtual std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false);
+
     /**
      * Returns a vector of all idle (non-pinned) local cursors.
      */
@@ -386,6 +409,14 @@ public:
                                                                 const NamespaceString&,
                                                                 const MatchExpression*) const = 0;
 
+    /**
+     * Returns a vector of BSON objects, where each entry in the vector describes a partition of the
+     * plan cache for the given namespace: its number of entries and its hit, miss and eviction
+     * counts. Only those partitions which match the supplied MatchExpression are returned.
+     */
+    virtual std::vector<BSONObj> getMatchingPlanCachePartitionStats(
+        OperationContext*, const NamespaceString&, const MatchExpression*) const = 0;
+
     /**
      * Returns true if there is an index on 'nss' with properties that will guarantee that a
      * document with non-array values for each of 'fieldPaths' will have at most one matching
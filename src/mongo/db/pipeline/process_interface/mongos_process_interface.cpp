@@ -36,6 +36,7 @@
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection_catalog.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_merge.h"
@@ -97,6 +98,98 @@ bool supportsUniqueKey(const boost::intrusive_ptr<ExpressionContext>& expCtx,
         CollatorInterface::collatorsMatch(collation.get(), expCtx->getCollator());
 }
 
+/**
+ * Dispatches a find for 'filterObj' on the collection 'nss' with UUID 'collectionUUID' to the
+ * shards which may own matching documents, and returns the cursors established on them. Throws
+ * NamespaceNotFound if the collection no longer exists with that UUID.
+ */
+std::vector<RemoteCursor> establishLookupCursors(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const BSONObj& filterObj,
+    const boost::optional<BSONObj>& readConcern,
+    bool allowSpeculativeMajorityRead,
+    boost::optional<long long> batchSize) {
+    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
+
+    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
+    BSONObjBuilder cmdBuilder;
+    bool findCmdIsByUuid(foreignExpCtx->uuid);
+    if (findCmdIsByUuid) {
+        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
+    } else {
+        cmdBuilder.append("find", nss.coll());
+    }
+    cmdBuilder.append("filter", filterObj);
+    if (batchSize) {
+        cmdBuilder.append("batchSize", *batchSize);
+    }
+    if (readConcern) {
+        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
+    }
+    if (allowSpeculativeMajorityRead) {
+        cmdBuilder.append("allowSpeculativeMajorityRead", true);
+    }
+
+    auto findCmd = cmdBuilder.obj();
+    auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
+    return shardVersionRetry(
+        expCtx->opCtx,
+        catalogCache,
+        foreignExpCtx->ns,
+        str::stream() << "Looking up document matching " << redact(filterObj),
+        [&]() -> std::vector<RemoteCursor> {
+            // Verify that the collection exists, with the correct UUID.
+            auto cm = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
+
+            // Finalize the 'find' command object based on the routing table information.
+            if (findCmdIsByUuid && cm.isSharded()) {
+                // Find by UUID and shard versioning do not work together (SERVER-31946).  In
+                // the sharded case we've already checked the UUID, so find by namespace is
+                // safe.  In the unlikely case that the collection has been deleted and a new
+                // collection with the same name created through a different mongos or the
+                // collection had its shard key refined, the shard version will be detected as
+                // stale, as shard versions contain an 'epoch' field unique to the collection.
+                findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
+                findCmdIsByUuid = false;
+            }
+
+            // Build the versioned requests to be dispatched to the shards. Typically, only a
+            // single shard will be targeted here; however, in certain cases where only the _id
+            // is present, we may need to scatter-gather the query to all shards in order to
+            // find the document.
+            auto requests = getVersionedRequestsForTargetedShards(
+                expCtx->opCtx, nss, cm, findCmd, filterObj, CollationSpec::kSimpleSpec);
+
+            // Dispatch the requests. The 'establishCursors' method conveniently prepares the
+            // result into a vector of cursor responses for us.
+            return establishCursors(
+                expCtx->opCtx,
+                Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
+                nss,
+                ReadPreferenceSetting::get(expCtx->opCtx),
+                std::move(requests),
+                false);
+        });
+}
+
+/**
+ * Returns true if 'doc' has the value of every field of 'documentKey'. The fields of a document key
+ * are compared as the equality predicates of a lookup by that document key would compare them.
+ */
+bool matchesDocumentKey(const Document& doc, const Document& documentKey) {
+    auto it = documentKey.fieldIterator();
+    while (it.more()) {
+        auto field = it.next();
+        if (ValueComparator::kInstance.evaluate(doc.getNestedField(FieldPath(field.first)) !=
+                                                field.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace
 
 std::unique_ptr<Pipeline, PipelineDeleter> MongosProcessInterface::attachCursorSourceToPipeline(
@@ -124,66 +217,14 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     const Document& filter,
     boost::optional<BSONObj> readConcern,
     bool allowSpeculativeMajorityRead) {
-    auto foreignExpCtx = expCtx->copyWith(nss, collectionUUID);
-
-    // Create the find command to be dispatched to the shard(s) in order to return the post-image.
-    auto filterObj = filter.toBson();
-    BSONObjBuilder cmdBuilder;
-    bool findCmdIsByUuid(foreignExpCtx->uuid);
-    if (findCmdIsByUuid) {
-        foreignExpCtx->uuid->appendToBuilder(&cmdBuilder, "find");
-    } else {
-        cmdBuilder.append("find", nss.coll());
-    }
-    cmdBuilder.append("filter", filterObj);
-    if (readConcern) {
-        cmdBuilder.append(repl::ReadConcernArgs::kReadConcernFieldName, *readConcern);
-    }
-    if (allowSpeculativeMajorityRead) {
-        cmdBuilder.append("allowSpeculativeMajorityRead", true);
-    }
-
     try {
-        auto findCmd = cmdBuilder.obj();
-        auto catalogCache = Grid::get(expCtx->opCtx)->catalogCache();
-        auto shardResults = shardVersionRetry(
-            expCtx->opCtx,
-            catalogCache,
-            foreignExpCtx->ns,
-            str::stream() << "Looking up document matching " << redact(filter.toBson()),
-            [&]() -> std::vector<RemoteCursor> {
-                // Verify that the collection exists, with the correct UUID.
-                auto cm = uassertStatusOK(getCollectionRoutingInfo(foreignExpCtx));
-
-                // Finalize the 'find' command object based on the routing table information.
-                if (findCmdIsByUuid && cm.isSharded()) {
-                    // Find by UUID and shard versioning do not work together (SERVER-31946).  In
-                    // the sharded case we've already checked the UUID, so find by namespace is
-                    // safe.  In the unlikely case that the collection has been deleted and a new
-                    // collection with the same name created through a different mongos or the
-                    // collection had its shard key refined, the shard version will be detected as
-                    // stale, as shard versions contain an 'epoch' field unique to the collection.
-                    findCmd = findCmd.addField(BSON("find" << nss.coll()).firstElement());
-                    findCmdIsByUuid = false;
-                }
-
-                // Build the versioned requests to be dispatched to the shards. Typically, only a
-                // single shard will be targeted here; however, in certain cases where only the _id
-                // is present, we may need to scatter-gather the query to all shards in order to
-                // find the document.
-                auto requests = getVersionedRequestsForTargetedShards(
-                    expCtx->opCtx, nss, cm, findCmd, filterObj, CollationSpec::kSimpleSpec);
-
-                // Dispatch the requests. The 'establishCursors' method conveniently prepares the
-                // result into a vector of cursor responses for us.
-                return establishCursors(
-                    expCtx->opCtx,
-                    Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor(),
-                    nss,
-                    ReadPreferenceSetting::get(expCtx->opCtx),
-                    std::move(requests),
-                    false);
-            });
+        auto shardResults = establishLookupCursors(expCtx,
+                                                   nss,
+                                                   collectionUUID,
+                                                   filter.toBson(),
+                                                   readConcern,
+                                                   allowSpeculativeMajorityRead,
+                                                   boost::none);
 
         // Iterate all shard results and build a single composite batch. We also enforce the
         // requirement that only a single document should have been returned from across the
@@ -214,6 +255,102 @@ boost::optional<Document> MongosProcessInterface::lookupSingleDocument(
     }
 }
 
+std::vector<boost::optional<Document>> MongosProcessInterface::lookupDocuments(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const NamespaceString& nss,
+    UUID collectionUUID,
+    const std::vector<Document>& documentKeys,
+    boost::optional<BSONObj> readConcern,
+    bool allowSpeculativeMajorityRead) {
+    if (documentKeys.size() <= 1u) {
+        return MongoProcessInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+
+    // Look up all of the document keys with a single query. If every key consists of the _id
+    // alone, as it does for unsharded collections, this is an $in over the _id values. Otherwise
+    // it is an $or of the document keys, which is still routed only to the shards owning them.
+    std::vector<BSONObj> keyObjs;
+    keyObjs.reserve(documentKeys.size());
+    bool idOnly = true;
+    for (auto&& documentKey : documentKeys) {
+        keyObjs.push_back(documentKey.toBson());
+        idOnly = idOnly && keyObjs.back().nFields() == 1 &&
+            keyObjs.back().firstElementFieldNameStringData() == "_id"_sd;
+    }
+    BSONObjBuilder filterBuilder;
+    if (idOnly) {
+        BSONObjBuilder idBuilder(filterBuilder.subobjStart("_id"));
+        BSONArrayBuilder inBuilder(idBuilder.subarrayStart("$in"));
+        for (auto&& keyObj : keyObjs) {
+            inBuilder.append(keyObj.firstElement());
+        }
+    } else {
+        BSONArrayBuilder orBuilder(filterBuilder.subarrayStart("$or"));
+        for (auto&& keyObj : keyObjs) {
+            orBuilder.append(keyObj);
+        }
+    }
+    auto filterObj = filterBuilder.obj();
+
+    std::vector<boost::optional<Document>> results(documentKeys.size());
+    bool complete = true;
+    try {
+        auto shardResults = establishLookupCursors(expCtx,
+                                                   nss,
+                                                   collectionUUID,
+                                                   filterObj,
+                                                   readConcern,
+                                                   allowSpeculativeMajorityRead,
+                                                   static_cast<long long>(documentKeys.size()) + 1);
+
+        // Assign each returned document to every document key it matches, in the order of
+        // 'documentKeys'. As for a single lookup, no document key may match more than one document.
+        for (auto&& shardResult : shardResults) {
+            for (auto&& obj : shardResult.getCursorResponse().getBatch()) {
+                Document doc(obj);
+                bool matchedAnyKey = false;
+                for (size_t i = 0; i < documentKeys.size(); ++i) {
+                    if (!matchesDocumentKey(doc, documentKeys[i])) {
+                        continue;
+                    }
+                    uassert(ErrorCodes::ChangeStreamFatalError,
+                            str::stream() << "found more than one document matching "
+                                          << documentKeys[i].toString() << " ["
+                                          << results[i]->toString() << ", " << doc.toString()
+                                          << "]",
+                            !results[i]);
+                    results[i] = doc;
+                    matchedAnyKey = true;
+                }
+                // The shards match the filter with the collection's default collation, which
+                // mongos does not know for an unsharded collection. A document which only matched
+                // a key under that collation can't be attributed here, so look up each key instead.
+                complete = complete && matchedAnyKey;
+            }
+        }
+
+        // The documents returned by a shard may not all fit into its first batch. Rather than
+        // iterating those cursors, kill them and fall back to looking up each key on its own.
+        for (auto&& shardResult : shardResults) {
+            if (shardResult.getCursorResponse().getCursorId() != 0) {
+                complete = false;
+                auto executor = Grid::get(expCtx->opCtx)->getExecutorPool()->getArbitraryExecutor();
+                killRemoteCursor(expCtx->opCtx, executor.get(), std::move(shardResult), nss);
+            }
+        }
+    } catch (const ExceptionFor<ErrorCodes::NamespaceNotFound>&) {
+        // See lookupSingleDocument().
+        return std::vector<boost::optional<Document>>(documentKeys.size());
+    }
+
+    if (!complete) {
+        return MongoProcessInterface::lookupDocuments(
+            expCtx, nss, collectionUUID, documentKeys, readConcern, allowSpeculativeMajorityRead);
+    }
+    return results;
+}
+
 BSONObj MongosProcessInterface::_reportCurrentOpForClient(
     OperationContext* opCtx,
     Client* client,
@@ -53,6 +53,18 @@ public:
         boost::optional<BSONObj> readConcern,
         bool allowSpeculativeMajorityRead = false) final;
 
+    /**
+     * Looks up all of the document keys with one find, dispatched only to the shards which may own
+     * them.
+     */
+    std::vector<boost::optional<Document>> lookupDocuments(
+        const boost::intrusive_ptr<ExpressionContext>& expCtx,
+        const NamespaceString& nss,
+        UUID collectionUUID,
+        const std::vector<Document>& documentKeys,
+        boost::optional<BSONObj> readConcern,
+        bool allowSpeculativeMajorityRead = false) final;
+
     std::vector<GenericCursor> getIdleCursors(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                               CurrentOpUserMode userMode) const final;
 
@@ -81,6 +93,10 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    bool writesAreRouted() const final {
+        return false;
+    }
+
     std::vector<Document> getIndexStats(OperationContext* opCtx,
                                         const NamespaceString& ns,
                                         StringData host,
@@ -201,6 +217,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(OperationContext*,
+                                                            const NamespaceString&,
+                                                            const MatchExpression*) const final {
+        MONGO_UNREACHABLE;
+    }
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>&,
                                          const NamespaceString&,
                                          const std::set<FieldPath>& fieldPaths) const;
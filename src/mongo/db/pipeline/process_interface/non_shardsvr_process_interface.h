@@ -93,6 +93,10 @@ public:
                                     bool multi,
                                     boost::optional<OID> targetEpoch) override;
 
+    bool writesAreRouted() const final {
+        return false;
+    }
+
     void renameIfOptionsAndIndexesHaveNotChanged(
         OperationContext* opCtx,
         const BSONObj& renameCommandObj,
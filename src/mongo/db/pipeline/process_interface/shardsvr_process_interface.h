@@ -93,6 +93,10 @@ public:
                                     bool multi,
                                     boost::optional<OID> targetEpoch) final;
 
+    bool writesAreRouted() const final {
+        return true;
+    }
+
     BSONObj preparePipelineAndExplain(Pipeline* ownedPipeline,
                                       ExplainOptions::Verbosity verbosity) final;
 
@@ -59,6 +59,10 @@ public:
 
     void updateClientOperationTime(OperationContext* opCtx) const override {}
 
+    bool writesAreRouted() const override {
+        return false;
+    }
+
     Status insert(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                   const NamespaceString& ns,
                   std::vector<BSONObj>&& objs,
@@ -226,6 +230,12 @@ public:
         MONGO_UNREACHABLE;
     }
 
+    std::vector<BSONObj> getMatchingPlanCachePartitionStats(OperationContext*,
+                                                            const NamespaceString&,
+                                                            const MatchExpression*) const override {
+        MONGO_UNREACHABLE;
+    }
+
     bool fieldsHaveSupportingUniqueIndex(const boost::intrusive_ptr<ExpressionContext>& expCtx,
                                          const NamespaceString& nss,
                                          const std::set<FieldPath>& fieldPaths) const override {
@@ -37,6 +37,7 @@
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_source.h"
 #include "mongo/db/pipeline/document_source_change_stream.h"
+#include "mongo/db/pipeline/document_source_exchange.h"
 #include "mongo/db/pipeline/document_source_group.h"
 #include "mongo/db/pipeline/document_source_limit.h"
 #include "mongo/db/pipeline/document_source_match.h"
@@ -798,6 +799,59 @@ boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationConte
     return walkPipelineBackwardsTrackingShardKey(opCtx, mergePipeline, cm);
 }
 
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& shardIds) {
+    const auto maxConsumers = internalQueryGroupMergeExchangeConsumers.load();
+    if (maxConsumers < 2 || internalQueryDisableExchange.load()) {
+        return boost::none;
+    }
+
+    const auto numConsumers = std::min(static_cast<size_t>(maxConsumers), shardIds.size());
+    if (numConsumers < 2) {
+        return boost::none;
+    }
+
+    // The partial groups are routed by the hash of their _id, which only keeps equal keys together
+    // under the simple collation. A transaction has to run the merge on a single participant.
+    if (expCtx->getCollator() || TransactionRouter::get(expCtx->opCtx)) {
+        return boost::none;
+    }
+
+    auto* mergePipeline = splitPipeline.mergePipeline.get();
+    if (splitPipeline.shardCursorsSortSpec || mergePipeline->getSources().empty() ||
+        mergePipeline->needsPrimaryShardMerger() || mergePipeline->needsMongosMerger()) {
+        return boost::none;
+    }
+
+    auto group = dynamic_cast<DocumentSourceGroup*>(mergePipeline->getSources().front().get());
+    if (!group || !group->doingMerge()) {
+        return boost::none;
+    }
+
+    // Each consumer only sees its own groups and mongos just unions the consumers' output, so
+    // every later stage has to work one document at a time. Writing stages would each produce
+    // their own copy of the output.
+    for (auto it = std::next(mergePipeline->getSources().begin());
+         it != mergePipeline->getSources().end();
+         ++it) {
+        auto* stage = it->get();
+        if (stage->distributedPlanLogic() || dynamic_cast<DocumentSourceOut*>(stage) ||
+            dynamic_cast<DocumentSourceMerge*>(stage)) {
+            return boost::none;
+        }
+    }
+
+    // Split the range of 64-bit hashes evenly between the consumers, which are the first
+    // 'numConsumers' targeted shards.
+    std::vector<ShardId> consumerShards(shardIds.begin(),
+                                        std::next(shardIds.begin(), numConsumers));
+    auto exchangeSpec = Exchange::makeHashedKeyRangeSpec("_id"_sd, numConsumers);
+
+    return ShardedExchangePolicy{std::move(exchangeSpec), std::move(consumerShards)};
+}
+
 SplitPipeline splitPipeline(std::unique_ptr<Pipeline, PipelineDeleter> pipeline) {
     auto& expCtx = pipeline->getContext();
     // Re-brand 'pipeline' as the merging pipeline. We will move stages one by one from the merging
@@ -948,6 +1002,9 @@ DispatchShardPipelineResults dispatchShardPipeline(
         splitPipelines = splitPipeline(std::move(pipeline));
 
         exchangeSpec = checkIfEligibleForExchange(opCtx, splitPipelines->mergePipeline.get());
+        if (!exchangeSpec && !hasChangeStream) {
+            exchangeSpec = checkIfEligibleForGroupExchange(expCtx, *splitPipelines, shardIds);
+        }
     }
 
     // Generate the command object for the targeted shards.
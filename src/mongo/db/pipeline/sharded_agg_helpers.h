@@ -105,6 +105,17 @@ struct DispatchShardPipelineResults {
 boost::optional<ShardedExchangePolicy> checkIfEligibleForExchange(OperationContext* opCtx,
                                                                   const Pipeline* mergePipeline);
 
+/**
+ * If the merging pipeline starts with the merging half of a $group and nothing after it needs to
+ * see all of the groups, returns an $exchange that hash-partitions the partial groups by _id over
+ * up to 'internalQueryGroupMergeExchangeConsumers' of the given shards, so that each of them
+ * merges a disjoint set of groups.
+ */
+boost::optional<ShardedExchangePolicy> checkIfEligibleForGroupExchange(
+    const boost::intrusive_ptr<ExpressionContext>& expCtx,
+    const SplitPipeline& splitPipeline,
+    const std::set<ShardId>& shardIds);
+
 /**
  * Split the current Pipeline into a Pipeline for each shard, and a Pipeline that combines the
  * results within a merging process. This call also performs optimizations with the aim of reducing
@@ -115,6 +115,21 @@ boost::optional<long long> extractLimitForPushdown(Pipeline::SourceContainer::it
     return minLimit;
 }
 
+bool hasLimitForPushdown(Pipeline::SourceContainer::const_iterator itr,
+                         const Pipeline::SourceContainer& container) {
+    for (; itr != container.end(); ++itr) {
+        auto nextStage = itr->get();
+        if (exact_pointer_cast<DocumentSourceLimit*>(nextStage)) {
+            return true;
+        }
+        if (!exact_pointer_cast<DocumentSourceSkip*>(nextStage) &&
+            !nextStage->constraints().canSwapWithSkippingOrLimitingStage) {
+            return false;
+        }
+    }
+    return false;
+}
+
 boost::optional<long long> extractSkipForPushdown(Pipeline::SourceContainer::iterator itr,
                                                   Pipeline::SourceContainer* container) {
     boost::optional<long long> skipSum;
@@ -88,6 +88,13 @@ public:
 boost::optional<long long> extractLimitForPushdown(Pipeline::SourceContainer::iterator itr,
                                                    Pipeline::SourceContainer* container);
 
+/**
+ * Returns true if 'extractLimitForPushdown' would find a $limit to swap forward to the position of
+ * the pipeline pointed to by 'itr', without modifying the pipeline.
+ */
+bool hasLimitForPushdown(Pipeline::SourceContainer::const_iterator itr,
+                         const Pipeline::SourceContainer& container);
+
 /**
  * If there are any $skip stages that could be logically swapped forward to the position of the
  * pipeline pointed to by 'itr' without changing the meaning of the query, removes these $skip
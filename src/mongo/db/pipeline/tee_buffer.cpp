@@ -50,13 +50,15 @@ boost::intrusive_ptr<TeeBuffer> TeeBuffer::create(size_t nConsumers, int bufferS
 }
 
 DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
-    size_t nConsumersStillProcessingThisBatch =
-        std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
-            return info.nLeftToReturn > 0;
-        });
-
-    if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
-        loadNextBatch();
+    if (!_batchesLoadedByCaller) {
+        size_t nConsumersStillProcessingThisBatch =
+            std::count_if(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+                return info.nLeftToReturn > 0;
+            });
+
+        if (_buffer.empty() || nConsumersStillProcessingThisBatch == 0) {
+            loadNextBatch();
+        }
     }
 
     if (_buffer.empty()) {
@@ -73,9 +75,33 @@ DocumentSource::GetNextResult TeeBuffer::getNext(size_t consumerId) {
     const size_t bufferIndex = _buffer.size() - _consumers[consumerId].nLeftToReturn;
     --_consumers[consumerId].nLeftToReturn;
 
+    if (_batchesLoadedByCaller) {
+        return Document::fromBsonWithMetaData(_bsonBuffer[bufferIndex]);
+    }
     return _buffer[bufferIndex];
 }
 
+void TeeBuffer::loadNextBatchForConsumers() {
+    _batchesLoadedByCaller = true;
+    _bsonBuffer.clear();
+
+    if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
+            return info.stillInUse;
+        })) {
+        _buffer.clear();
+        if (_source) {
+            _source->dispose();
+        }
+        return;
+    }
+
+    loadNextBatch();
+    _bsonBuffer.reserve(_buffer.size());
+    for (auto&& input : _buffer) {
+        _bsonBuffer.push_back(input.getDocument().toBsonWithMetaData());
+    }
+}
+
 void TeeBuffer::loadNextBatch() {
     _buffer.clear();
     size_t bytesInBuffer = 0;
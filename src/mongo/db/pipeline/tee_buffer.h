@@ -66,6 +66,10 @@ public:
     void dispose(size_t consumerId) {
         _consumers[consumerId].stillInUse = false;
         _consumers[consumerId].nLeftToReturn = 0;
+        if (_batchesLoadedByCaller) {
+            // The input is disposed of by loadNextBatchForConsumers() once no consumer is left.
+            return;
+        }
         if (std::none_of(_consumers.begin(), _consumers.end(), [](const ConsumerInfo& info) {
                 return info.stillInUse;
             })) {
@@ -83,6 +87,17 @@ public:
      */
     DocumentSource::GetNextResult getNext(size_t consumerId);
 
+    /**
+     * Loads the next batch of input for all consumers still in use, or disposes of the input if
+     * there are none. Once this has been called, consumers no longer load batches themselves:
+     * getNext() returns GetNextState::ResultState::kPauseExecution at the end of each batch until
+     * the next call, and getNext() and dispose() only touch the state of the given consumer. Each
+     * consumer may then run on a thread of its own, as long as none is running during this call.
+     * The documents returned to each consumer are then copies of their own, since documents lazily
+     * cache their fields and cannot be read by several threads at once.
+     */
+    void loadNextBatchForConsumers();
+
 private:
     TeeBuffer(size_t nConsumers, size_t bufferSizeBytes);
 
@@ -98,6 +113,11 @@ private:
     const size_t _bufferSizeBytes;
     std::vector<DocumentSource::GetNextResult> _buffer;
 
+    // Set by loadNextBatchForConsumers(). '_bsonBuffer' then holds the documents of '_buffer',
+    // with their metadata, to copy for each consumer.
+    bool _batchesLoadedByCaller = false;
+    std::vector<BSONObj> _bsonBuffer;
+
     struct ConsumerInfo {
         bool stillInUse = true;
         int nLeftToReturn = 0;
@@ -170,5 +170,54 @@ TEST_F(TeeBufferTest, ShouldAllowOtherConsumersToAdvanceOnceTrailingConsumerIsDi
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
     ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
 }
+
+TEST_F(TeeBufferTest, ShouldOnlyLoadBatchesWhenAskedOnceCallerLoadsThem) {
+    std::deque<DocumentSource::GetNextResult> inputs{Document{{"a", 1}}, Document{{"a", 2}}};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    const size_t nConsumers = 2;
+    const size_t bufferBytes = 1;  // Both docs won't fit in a single batch.
+    auto teeBuffer = TeeBuffer::create(nConsumers, bufferBytes);
+    teeBuffer->setSource(mock.get());
+
+    teeBuffer->loadNextBatchForConsumers();
+    for (size_t consumerId = 0; consumerId < nConsumers; ++consumerId) {
+        auto next = teeBuffer->getNext(consumerId);
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.getDocument(), inputs.front().getDocument());
+
+        // Every consumer waits for the caller to load the next batch.
+        ASSERT_TRUE(teeBuffer->getNext(consumerId).isPaused());
+    }
+
+    // A disposed consumer is no longer given batches.
+    teeBuffer->dispose(1);
+    teeBuffer->loadNextBatchForConsumers();
+    auto next0 = teeBuffer->getNext(0);
+    ASSERT_TRUE(next0.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next0.getDocument(), inputs.back().getDocument());
+    ASSERT_TRUE(teeBuffer->getNext(0).isPaused());
+    ASSERT_TRUE(teeBuffer->getNext(1).isPaused());
+
+    teeBuffer->loadNextBatchForConsumers();
+    ASSERT_TRUE(teeBuffer->getNext(0).isEOF());
+}
+
+TEST_F(TeeBufferTest, ShouldKeepMetadataOnceCallerLoadsBatches) {
+    MutableDocument input(Document{{"a", 1}});
+    input.metadata().setTextScore(2.0);
+    std::deque<DocumentSource::GetNextResult> inputs{input.freeze()};
+    auto mock = DocumentSourceMock::createForTest(inputs, getExpCtx());
+
+    auto teeBuffer = TeeBuffer::create(2);
+    teeBuffer->setSource(mock.get());
+    teeBuffer->loadNextBatchForConsumers();
+
+    auto next0 = teeBuffer->getNext(0);
+    auto next1 = teeBuffer->getNext(1);
+    ASSERT_DOCUMENT_EQ(next0.getDocument(), inputs.front().getDocument());
+    ASSERT_DOCUMENT_EQ(next1.getDocument(), inputs.front().getDocument());
+    ASSERT_EQ(next0.getDocument().metadata().getTextScore(), 2.0);
+}
 }  // namespace
 }  // namespace mongo
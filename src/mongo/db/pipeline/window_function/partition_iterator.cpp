@@ -30,6 +30,11 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/pipeline/window_function/partition_iterator.h"
+
+#include <boost/filesystem/operations.hpp>
+
+#include "mongo/platform/atomic_word.h"
+#include "mongo/util/destructor_guard.h"
 #include "mongo/util/visit_helper.h"
 
 using boost::optional;
@@ -37,6 +42,14 @@ using boost::optional;
 namespace mongo {
 
 namespace {
+/**
+ * Generates a unique name for the file which the documents of a partition are spilled to.
+ */
+std::string nextFileName() {
+    static AtomicWord<unsigned> partitionIteratorFileCounter;
+    return "extsort-window-fields." + std::to_string(partitionIteratorFileCounter.fetchAndAdd(1));
+}
+
 /**
  * Create an Expression from a SortPattern, if the sort is simple enough.
  *
@@ -88,6 +101,10 @@ PartitionIterator::PartitionIterator(ExpressionContext* expCtx,
       _sortExpr(exprFromSort(_expCtx, sortPattern)),
       _state(IteratorState::kNotInitialized) {}
 
+PartitionIterator::~PartitionIterator() {
+    DESTRUCTOR_GUARD(resetSpilledDocuments());
+}
+
 optional<Document> PartitionIterator::operator[](int index) {
     auto desired = _currentCacheIndex + index;
 
@@ -105,8 +122,8 @@ optional<Document> PartitionIterator::operator[](int index) {
         return boost::none;
 
     // Case 1: Document is in the cache already.
-    if (desired >= 0 && desired < (int)_cache.size())
-        return _cache[desired];
+    if (desired >= 0 && desired < getCacheSize())
+        return getCachedDocument(desired);
 
     // Case 2: Attempting to access index greater than what the cache currently holds. If we've
     // already exhausted the partition, then early return. Otherwise continue to pull in
@@ -114,7 +131,7 @@ optional<Document> PartitionIterator::operator[](int index) {
     if (_state == IteratorState::kAwaitingAdvanceToNext ||
         _state == IteratorState::kAwaitingAdvanceToEOF)
         return boost::none;
-    for (int i = _cache.size(); i <= desired; i++) {
+    for (int i = getCacheSize(); i <= desired; i++) {
         // Pull in document from prior stage.
         getNextDocument();
         // Check for EOF or the next partition.
@@ -123,7 +140,100 @@ optional<Document> PartitionIterator::operator[](int index) {
             return boost::none;
     }
 
-    return _cache[desired];
+    return getCachedDocument(desired);
+}
+
+const Document& PartitionIterator::getCachedDocument(int cacheIndex) {
+    while (cacheIndex >= (int)_reloaded.size() && _numSpilled > 0 &&
+           cacheIndex < (int)_reloaded.size() + _numSpilled) {
+        reloadSpilledDocument();
+    }
+
+    if (cacheIndex < (int)_reloaded.size())
+        return _reloaded[cacheIndex];
+
+    return _cache[cacheIndex - _reloaded.size() - _numSpilled];
+}
+
+void PartitionIterator::popFrontCachedDocument() {
+    // A spilled document can only be skipped over by reading it back.
+    if (_reloaded.empty() && _numSpilled > 0)
+        reloadSpilledDocument();
+
+    auto& docs = _reloaded.empty() ? _cache : _reloaded;
+    _memUsageBytes -= std::min(_memUsageBytes, docs.front().getApproximateSize());
+    docs.pop_front();
+}
+
+void PartitionIterator::reloadSpilledDocument() {
+    auto& segment = _spilledSegments.front();
+    if (!segment.opened) {
+        segment.iterator->openSource();
+        segment.opened = true;
+    }
+
+    auto doc = segment.iterator->next().second;
+    _memUsageBytes += doc.getApproximateSize();
+    _reloaded.emplace_back(std::move(doc));
+    --_numSpilled;
+
+    if (--segment.remaining == 0) {
+        segment.iterator->closeSource();
+        _spilledSegments.pop_front();
+    }
+}
+
+void PartitionIterator::spillToDisk() {
+    // Documents which have been read back sit in front of the spilled segments, so they go into a
+    // new segment ahead of those. The documents behind the current one in '_cache' follow them.
+    const int numToSpill = _currentCacheIndex - _reloaded.size() - _numSpilled;
+    if (!_reloaded.empty())
+        spillDocuments(_reloaded, _reloaded.size(), true /* beforeExistingSegments */);
+    if (numToSpill > 0)
+        spillDocuments(_cache, numToSpill, false /* beforeExistingSegments */);
+}
+
+void PartitionIterator::spillDocuments(std::deque<Document>& docs,
+                                       int count,
+                                       bool beforeExistingSegments) {
+    if (_spillFileName.empty())
+        _spillFileName = _expCtx->tempDir + "/" + nextFileName();
+
+    SortedFileWriter<Value, Document> writer(
+        SortOptions().TempDir(_expCtx->tempDir), _spillFileName, _nextSpillFileOffset);
+    for (int i = 0; i < count; ++i) {
+        _memUsageBytes -= std::min(_memUsageBytes, docs.front().getApproximateSize());
+        writer.addAlreadySorted(Value(), docs.front());
+        docs.pop_front();
+    }
+
+    SpilledSegment segment{
+        std::shared_ptr<Sorter<Value, Document>::Iterator>(writer.done()), count};
+    _nextSpillFileOffset = writer.getFileEndOffset();
+    _numSpilled += count;
+    _usedDisk = true;
+
+    if (beforeExistingSegments) {
+        _spilledSegments.emplace_front(std::move(segment));
+    } else {
+        _spilledSegments.emplace_back(std::move(segment));
+    }
+}
+
+void PartitionIterator::resetSpilledDocuments() {
+    _reloaded.clear();
+    _numSpilled = 0;
+    for (auto& segment : _spilledSegments) {
+        if (segment.opened)
+            segment.iterator->closeSource();
+    }
+    _spilledSegments.clear();
+
+    if (!_spillFileName.empty()) {
+        boost::filesystem::remove(_spillFileName);
+        _spillFileName.clear();
+        _nextSpillFileOffset = 0;
+    }
 }
 
 void PartitionIterator::releaseExpired() {
@@ -143,7 +253,7 @@ void PartitionIterator::releaseExpired() {
 
     auto newCurrent = _currentCacheIndex;
     for (auto i = 0; i <= minIndex && i < _currentCacheIndex; i++) {
-        _cache.pop_front();
+        popFrontCachedDocument();
         newCurrent--;
     }
 
@@ -163,7 +273,7 @@ PartitionIterator::AdvanceResult PartitionIterator::advance() {
     ON_BLOCK_EXIT([&] { releaseExpired(); });
 
     // Check if the next document is in the cache.
-    if ((_currentCacheIndex + 1) < (int)_cache.size()) {
+    if ((_currentCacheIndex + 1) < getCacheSize()) {
         // Same partition, update the current index.
         _currentCacheIndex++;
         _currentPartitionIndex++;
@@ -33,6 +33,7 @@
 #include "mongo/db/pipeline/expression.h"
 #include "mongo/db/pipeline/window_function/window_bounds.h"
 #include "mongo/db/query/sort_pattern.h"
+#include "mongo/db/sorter/sorter.h"
 
 namespace mongo {
 
@@ -53,6 +54,8 @@ public:
                       boost::optional<boost::intrusive_ptr<Expression>> partitionExpr,
                       const boost::optional<SortPattern>& sortPattern);
 
+    ~PartitionIterator();
+
     using SlotId = unsigned int;
     SlotId newSlot() {
         tassert(5371200,
@@ -108,6 +111,23 @@ public:
         return _memUsageBytes;
     }
 
+    /**
+     * Writes the documents of the current partition which are behind the current document to a
+     * temporary file, to reduce the memory held by this iterator. The documents stay accessible
+     * and are read back in order whenever they are requested again, for instance by a window
+     * function removing documents as they leave a document-based or range-based window.
+     *
+     * Must not be called on mongos.
+     */
+    void spillToDisk();
+
+    /**
+     * Returns true if this iterator has written documents to disk at any point.
+     */
+    bool usedDisk() const {
+        return _usedDisk;
+    }
+
 private:
     friend class PartitionAccessor;
 
@@ -160,15 +180,50 @@ private:
      * This value is positive or zero, because the current document is always in '_cache'.
      */
     auto getMaxCachedOffset() const {
-        return getMinCachedOffset() + _cache.size() - 1;
+        return getMinCachedOffset() + getCacheSize() - 1;
     }
 
+    /**
+     * Returns the number of documents in the cache, including the ones which have been spilled to
+     * disk.
+     */
+    int getCacheSize() const {
+        return _reloaded.size() + _numSpilled + _cache.size();
+    }
+
+    /**
+     * Returns the document at 'cacheIndex' in the cache, reading spilled documents back from disk
+     * if necessary.
+     */
+    const Document& getCachedDocument(int cacheIndex);
+
+    /**
+     * Removes the first document of the cache.
+     */
+    void popFrontCachedDocument();
+
+    /**
+     * Reads the next spilled document back into '_reloaded'.
+     */
+    void reloadSpilledDocument();
+
+    /**
+     * Moves the first 'count' documents of 'docs' to a new segment of the spill file, which is
+     * placed either before or after the existing segments.
+     */
+    void spillDocuments(std::deque<Document>& docs, int count, bool beforeExistingSegments);
+
+    /**
+     * Drops all spilled documents and deletes the spill file.
+     */
+    void resetSpilledDocuments();
+
     /**
      * Loads documents into '_cache' until we reach a partition boundary.
      */
     void cacheWholePartition() {
         // Start from one past the end of the _cache.
-        int i = getMinCachedOffset() + _cache.size();
+        int i = getMinCachedOffset() + getCacheSize();
         // If we have already loaded everything into '_cache' then this condition will be false
         // immediately.
         while ((*this)[i]) {
@@ -197,6 +252,7 @@ private:
     void getNextDocument();
 
     void resetCache() {
+        resetSpilledDocuments();
         _cache.clear();
         // Everything should be empty at this point.
         _memUsageBytes = 0;
@@ -239,9 +295,30 @@ private:
     // the value of the "$ts" field. This _sortExpr is used in getEndpoints().
     boost::optional<boost::intrusive_ptr<ExpressionFieldPath>> _sortExpr;
 
+    // The cache of the current partition is made of '_reloaded', followed by the documents which
+    // are in '_spilledSegments', followed by '_cache'. Spilled documents are only ever read back
+    // in order, into '_reloaded'.
     std::deque<Document> _cache;
-    // '_cache[_currentCacheIndex]' is the current document, which '(*this)[0]' returns.
+    // The cache index of the current document, which '(*this)[0]' returns.
     int _currentCacheIndex = 0;
+
+    // A range of consecutive documents in the spill file.
+    struct SpilledSegment {
+        std::shared_ptr<Sorter<Value, Document>::Iterator> iterator;
+        // Number of documents in the segment which have not been read back yet.
+        int remaining = 0;
+        bool opened = false;
+    };
+    std::deque<SpilledSegment> _spilledSegments;
+    // Total number of documents in '_spilledSegments'.
+    int _numSpilled = 0;
+    // Documents read back from '_spilledSegments' which have not been released yet.
+    std::deque<Document> _reloaded;
+
+    // The spill file is shared by all the segments, and deleted when the partition ends.
+    std::string _spillFileName;
+    std::streampos _nextSpillFileOffset = 0;
+    bool _usedDisk = false;
     int _currentPartitionIndex = 0;
     Value _partitionKey;
     std::vector<int> _slots;
@@ -35,6 +35,7 @@
 #include "mongo/db/pipeline/document_source_mock.h"
 #include "mongo/db/pipeline/window_function/partition_iterator.h"
 #include "mongo/unittest/death_test.h"
+#include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -487,5 +488,48 @@ DEATH_TEST_F(PartitionIteratorTest, MixedPolicy, "Invalid access of expired docu
     ASSERT_THROWS_CODE(defaultAccessor[-2], AssertionException, 5371202);
 }
 
+TEST_F(PartitionIteratorTest, SpilledDocumentsAreReadBackInOrder) {
+    unittest::TempDir tempDir("PartitionIteratorTest");
+    getExpCtx()->tempDir = tempDir.path();
+
+    std::deque<DocumentSource::GetNextResult> docs;
+    for (int i = 0; i < 10; i++) {
+        docs.emplace_back(Document{{"a", i}});
+    }
+    const auto mock = DocumentSourceMock::createForTest(docs, getExpCtx());
+    auto partIter = PartitionIterator(getExpCtx().get(), mock.get(), boost::none, boost::none);
+    auto endpointAccessor = PartitionAccessor(&partIter, PartitionAccessor::Policy::kEndpoints);
+    // Mock a window with documents [-3, 0].
+    auto bounds = WindowBounds::parse(BSON("documents" << BSON_ARRAY(-3 << 0)),
+                                      SortPattern(BSON("a" << 1), getExpCtx()),
+                                      getExpCtx().get());
+
+    // Advance to {a: 5}, keeping the documents of the window in memory.
+    for (int i = 0; i < 5; i++) {
+        endpointAccessor.getEndpoints(bounds);
+        partIter.advance();
+    }
+    auto endpoints = endpointAccessor.getEndpoints(bounds);
+    ASSERT_EQ(endpoints->first, -3);
+
+    const auto sizeBeforeSpill = partIter.getApproximateSize();
+    partIter.spillToDisk();
+    ASSERT_TRUE(partIter.usedDisk());
+    ASSERT_LT(partIter.getApproximateSize(), sizeBeforeSpill);
+
+    // The spilled documents are still accessible, and are released as the window moves forward.
+    ASSERT_DOCUMENT_EQ(docs[2].getDocument(), *endpointAccessor[-3]);
+    ASSERT_DOCUMENT_EQ(docs[5].getDocument(), *endpointAccessor[0]);
+    partIter.advance();
+    partIter.spillToDisk();
+    for (int i = 6; i < 10; i++) {
+        endpoints = endpointAccessor.getEndpoints(bounds);
+        ASSERT_DOCUMENT_EQ(docs[i - 3].getDocument(), *endpointAccessor[endpoints->first]);
+        ASSERT_DOCUMENT_EQ(docs[i].getDocument(), *endpointAccessor[endpoints->second]);
+        partIter.advance();
+    }
+    ASSERT_ADVANCE_RESULT(PartitionIterator::AdvanceResult::kEOF, partIter.advance());
+}
+
 }  // namespace
 }  // namespace mongo
@@ -34,6 +34,12 @@
 
 namespace mongo {
 
+/**
+ * Tracks the min or max of a sliding window. Since values are always removed in the order they were
+ * added, a value can never be the result again once a later value is at least as good, so only the
+ * values which could still become the result are kept, in the order they were added. This makes
+ * add() and remove() amortized constant time.
+ */
 template <AccumulatorMinMax::Sense sense>
 class WindowFunctionMinMax : public WindowFunctionState {
 public:
@@ -43,25 +49,29 @@ public:
         return std::make_unique<WindowFunctionMinMax<sense>>(expCtx);
     }
 
-    explicit WindowFunctionMinMax(ExpressionContext* const expCtx)
-        : WindowFunctionState(expCtx),
-          _values(_expCtx->getValueComparator().makeOrderedValueMultiset()) {
+    explicit WindowFunctionMinMax(ExpressionContext* const expCtx) : WindowFunctionState(expCtx) {
         _memUsageBytes = sizeof(*this);
     }
 
     void add(Value value) final {
+        // Values which tie with the new one are kept, so that remove() can tell which of the equal
+        // values is the oldest.
+        while (!_values.empty() && isBetter(value, _values.back())) {
+            _memUsageBytes -= _values.back().getApproximateSize();
+            _values.pop_back();
+        }
         _memUsageBytes += value.getApproximateSize();
-        _values.insert(std::move(value));
+        _values.push_back(std::move(value));
     }
 
     void remove(Value value) final {
-        // std::multiset::insert is guaranteed to put the element after any equal elements
-        // already in the container. So find() / erase() will remove the oldest equal element,
-        // which is what we want, to satisfy "remove() undoes add() when called in FIFO order".
-        auto iter = _values.find(std::move(value));
-        tassert(5371400, "Can't remove from an empty WindowFunctionMinMax", iter != _values.end());
-        _memUsageBytes -= iter->getApproximateSize();
-        _values.erase(iter);
+        // The removed value is the oldest one in the window. It is still tracked only if no later
+        // value has beaten it, in which case it is at the front.
+        tassert(5371400, "Can't remove from an empty WindowFunctionMinMax", !_values.empty());
+        if (_expCtx->getValueComparator().evaluate(_values.front() == value)) {
+            _memUsageBytes -= _values.front().getApproximateSize();
+            _values.pop_front();
+        }
     }
 
     void reset() final {
@@ -72,18 +82,27 @@ public:
     Value getValue() const final {
         if (_values.empty())
             return kDefault;
+        return _values.front();
+    }
+
+protected:
+    /**
+     * Returns true if 'lhs' is strictly smaller than 'rhs' for $min, or strictly larger for $max.
+     */
+    bool isBetter(const Value& lhs, const Value& rhs) const {
+        const int cmp = _expCtx->getValueComparator().compare(lhs, rhs);
         switch (sense) {
             case AccumulatorMinMax::Sense::kMin:
-                return *_values.begin();
+                return cmp < 0;
             case AccumulatorMinMax::Sense::kMax:
-                return *_values.rbegin();
+                return cmp > 0;
         }
         MONGO_UNREACHABLE_TASSERT(5371401);
     }
 
-protected:
-    // Holds all the values in the window, in order, with constant-time access to both ends.
-    ValueMultiset _values;
+    // The values which can still become the result, in the order they were added. No value is
+    // better than the one before it, so the front is the result.
+    std::deque<Value> _values;
 };
 using WindowFunctionMin = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMin>;
 using WindowFunctionMax = WindowFunctionMinMax<AccumulatorMinMax::Sense::kMax>;
@@ -151,5 +151,46 @@ TEST_F(WindowFunctionMinMaxTest, TracksMemoryUsageOnAddAndRemove) {
     ASSERT_EQ(min.getApproximateSize(), trackingSize);
 }
 
+TEST_F(WindowFunctionMinMaxTest, SlidingWindowMatchesFullScan) {
+    // Values which go up and down, so that both increasing and decreasing runs are evicted.
+    std::vector<int> input;
+    for (int i = 0; i < 200; i++) {
+        input.push_back((i * 37) % 23 - (i % 5) * 3);
+    }
+
+    const size_t windowSize = 7;
+    for (size_t i = 0; i < input.size(); i++) {
+        min.add(Value{input[i]});
+        max.add(Value{input[i]});
+        if (i >= windowSize) {
+            min.remove(Value{input[i - windowSize]});
+            max.remove(Value{input[i - windowSize]});
+        }
+
+        const auto first = input.begin() + (i >= windowSize ? i - windowSize + 1 : 0);
+        const auto last = input.begin() + i + 1;
+        ASSERT_VALUE_EQ(min.getValue(), Value{*std::min_element(first, last)});
+        ASSERT_VALUE_EQ(max.getValue(), Value{*std::max_element(first, last)});
+    }
+}
+
+TEST_F(WindowFunctionMinMaxTest, BeatenValuesAreNotRetained) {
+    auto largeStr = Value{"this is quite a long string"_sd};
+    max.add(Value{"a"_sd});
+    max.add(largeStr);
+    max.add(Value{"b"_sd});
+    ASSERT_VALUE_EQ(max.getValue(), largeStr);
+
+    // Only the values which can still become the max are held.
+    ASSERT_EQ(max.getApproximateSize(),
+              sizeof(WindowFunctionMax) + largeStr.getApproximateSize() +
+                  Value{"b"_sd}.getApproximateSize());
+
+    max.remove(Value{"a"_sd});
+    ASSERT_VALUE_EQ(max.getValue(), largeStr);
+    max.remove(largeStr);
+    ASSERT_VALUE_EQ(max.getValue(), Value{"b"_sd});
+}
+
 }  // namespace
 }  // namespace mongo
@@ -313,6 +313,39 @@ bool CanonicalQuery::isSimpleIdQuery(const BSONObj& query) {
     return hasID;
 }
 
+// static
+bool CanonicalQuery::isSimpleIdInQuery(const BSONObj& query) {
+    if (query.nFields() != 1) {
+        return false;
+    }
+
+    BSONElement idElt = query.firstElement();
+    if (idElt.fieldNameStringData() != "_id" || idElt.type() != Object) {
+        return false;
+    }
+
+    BSONObj inObj = idElt.Obj();
+    BSONElement inElt = inObj.firstElement();
+    if (inObj.nFields() != 1 || inElt.fieldNameStringData() != "$in" || inElt.type() != Array ||
+        inElt.Obj().isEmpty()) {
+        return false;
+    }
+
+    for (auto&& elt : inElt.Obj()) {
+        // Each element must be a value which the _id index can look up exactly, as for
+        // isSimpleIdQuery(). Regexes and arrays in an $in list are not equality matches.
+        if (elt.type() == Object) {
+            if (elt.Obj().firstElementFieldName()[0] == '$') {
+                return false;
+            }
+        } else if (!Indexability::isExactBoundsGenerating(elt)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 size_t CanonicalQuery::countNodes(const MatchExpression* root, MatchExpression::MatchType type) {
     size_t sum = 0;
     if (type == root->matchType()) {
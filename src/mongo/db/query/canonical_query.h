@@ -35,6 +35,7 @@
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/extensions_callback_noop.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/query/collation/collator_interface.h"
 #include "mongo/db/query/projection.h"
 #include "mongo/db/query/projection_policies.h"
@@ -51,6 +52,17 @@ public:
     // sort with the values taken out.
     typedef std::string QueryShapeString;
 
+    /**
+     * Describes a $group stage which the aggregation layer has asked the query system to execute
+     * on top of this query. See setGroupForPushdown().
+     */
+    struct GroupPushdown {
+        boost::intrusive_ptr<Expression> groupByExpression;
+        std::vector<AccumulationStatement> accumulators;
+        bool allowDiskUse = false;
+        size_t maxMemoryUsageBytes = 0;
+    };
+
     /**
      * If parsing succeeds, returns a std::unique_ptr<CanonicalQuery> representing the parsed
      * query (which will never be NULL).  If parsing fails, returns an error Status.
@@ -106,6 +118,12 @@ public:
      */
     static bool isSimpleIdQuery(const BSONObj& query);
 
+    /**
+     * Returns true if "query" is an $in over _id whose every element is an exact-match value, such
+     * as {_id: {$in: [1, 2, 3]}}.
+     */
+    static bool isSimpleIdInQuery(const BSONObj& query);
+
     /**
      * Validates the match expression 'root' as well as the query specified by 'request', checking
      * for illegal combinations of operators. Returns a non-OK status if any such illegal
@@ -224,6 +242,21 @@ public:
         _explain = explain;
     }
 
+    /**
+     * Offers a $group stage to the query system. The offer is only taken up by the SBE engine, and
+     * only when the executor does not require runtime planning; otherwise the query system drops
+     * it by resetting it to boost::none. Callers must therefore re-check getGroupForPushdown() on
+     * the executor's CanonicalQuery to find out whether the $group still needs to be executed by
+     * the pipeline.
+     */
+    void setGroupForPushdown(boost::optional<GroupPushdown> group) {
+        _groupForPushdown = std::move(group);
+    }
+
+    const boost::optional<GroupPushdown>& getGroupForPushdown() const {
+        return _groupForPushdown;
+    }
+
     auto& getExpCtx() const {
         return _expCtx;
     }
@@ -264,6 +297,9 @@ private:
     bool _canHaveNoopMatchNodes = false;
 
     bool _explain = false;
+
+    // A $group stage offered by the aggregation layer for execution within the query system.
+    boost::optional<GroupPushdown> _groupForPushdown;
 };
 
 }  // namespace mongo
@@ -454,5 +454,20 @@ TEST(CanonicalQueryTest, InvalidSortOrdersFailToCanonicalize) {
     assertInvalidSortOrder(fromjson("{'': -1}"));
 }
 
+TEST(CanonicalQueryTest, IsSimpleIdInQuery) {
+    ASSERT_TRUE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1, 'a', {b: 1}]}}")));
+    ASSERT_TRUE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1]}}")));
+
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: 1}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: []}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1], $ne: 2}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1]}, a: 1}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{a: {$in: [1, 2]}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1, null]}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1, [2]]}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [1, /a/]}}")));
+    ASSERT_FALSE(CanonicalQuery::isSimpleIdInQuery(fromjson("{_id: {$in: [{$gt: 1}]}}")));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,213 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/cardinality_estimation.h"
+
+#include <algorithm>
+
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/collection_query_info.h"
+#include "mongo/db/query/field_histogram.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/logv2/log.h"
+
+namespace mongo {
+namespace cardinality_estimation {
+namespace {
+
+/**
+ * Estimates the keys an index scan examines from the histograms of its fields. The fraction of the
+ * keys selected by each field with point bounds narrows the scan down for the next field, up to the
+ * first field with range bounds. The fields are assumed to be independent.
+ */
+boost::optional<double> estimateIndexScan(const CollectionHistograms& histograms,
+                                          const IndexScanNode& node) {
+    if (node.index.type != INDEX_BTREE || node.index.collator || node.bounds.isSimpleRange ||
+        node.bounds.fields.empty()) {
+        return boost::none;
+    }
+
+    boost::optional<double> keys;
+    for (auto&& oil : node.bounds.fields) {
+        auto histogram = histograms.get(oil.name);
+        if (!histogram || histogram->getTotalCount() <= 0) {
+            break;
+        }
+        const double selected = histogram->estimate(oil);
+        keys = keys ? *keys * selected / histogram->getTotalCount() : selected;
+        if (!std::all_of(oil.intervals.begin(), oil.intervals.end(), [](auto&& interval) {
+                return interval.isPoint();
+            })) {
+            break;
+        }
+    }
+    return keys;
+}
+
+/**
+ * The estimated number of keys and documents a stage examines, and of results it outputs.
+ */
+struct Estimate {
+    double works;
+    double results;
+};
+
+boost::optional<Estimate> estimateNode(OperationContext* opCtx,
+                                       const CollectionPtr& collection,
+                                       const CollectionHistograms& histograms,
+                                       const QuerySolutionNode* node) {
+    switch (node->getType()) {
+        case STAGE_COLLSCAN: {
+            const double numRecords = collection->numRecords(opCtx);
+            return Estimate{numRecords, numRecords};
+        }
+        case STAGE_IXSCAN: {
+            auto keys = estimateIndexScan(histograms, *static_cast<const IndexScanNode*>(node));
+            if (!keys) {
+                return boost::none;
+            }
+            return Estimate{*keys, *keys};
+        }
+        default:
+            break;
+    }
+
+    if (node->children.empty()) {
+        return boost::none;
+    }
+    std::vector<Estimate> children;
+    for (auto&& child : node->children) {
+        auto childEstimate = estimateNode(opCtx, collection, histograms, child);
+        if (!childEstimate) {
+            return boost::none;
+        }
+        children.push_back(*childEstimate);
+    }
+
+    Estimate estimate{0, 0};
+    for (auto&& child : children) {
+        estimate.works += child.works;
+        estimate.results += child.results;
+    }
+
+    switch (node->getType()) {
+        case STAGE_FETCH:
+            // Every input is looked up in the collection. The filter is not estimated.
+            estimate.works += estimate.results;
+            break;
+        case STAGE_AND_HASH:
+        case STAGE_AND_SORTED: {
+            // An intersection outputs the fraction of the collection which every input selects,
+            // with the inputs assumed to be independent. This is what lets an intersection of
+            // selective index scans win over a single scan which fetches far more documents.
+            const double numRecords = collection->numRecords(opCtx);
+            estimate.results = numRecords;
+            for (auto&& child : children) {
+                estimate.results =
+                    numRecords > 0 ? estimate.results * child.results / numRecords : 0;
+            }
+            break;
+        }
+        default:
+            // Any other stage is assumed to output the results of its inputs together.
+            break;
+    }
+    return estimate;
+}
+
+}  // namespace
+
+boost::optional<double> estimateWorks(OperationContext* opCtx,
+                                      const CollectionPtr& collection,
+                                      const QuerySolution& solution) {
+    const auto* histograms = CollectionQueryInfo::get(collection).getHistograms();
+    if (!solution.root() || histograms->empty()) {
+        return boost::none;
+    }
+    auto estimate = estimateNode(opCtx, collection, *histograms, solution.root());
+    if (!estimate) {
+        return boost::none;
+    }
+    return estimate->works;
+}
+
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const CanonicalQuery& cq,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions) {
+    const double ratio = internalQueryCardinalityEstimationPruningRatio.load();
+    const auto& findCommand = cq.getFindCommandRequest();
+    if (ratio <= 0 || solutions->size() < 2 || !findCommand.getSort().isEmpty() ||
+        findCommand.getLimit() || findCommand.getNtoreturn() || findCommand.getSingleBatch() ||
+        CollectionQueryInfo::get(collection).getHistograms()->empty()) {
+        return;
+    }
+
+    boost::optional<double> cheapest;
+    for (auto&& solution : *solutions) {
+        solution->estimatedWorks = estimateWorks(opCtx, collection, *solution);
+        if (solution->estimatedWorks) {
+            cheapest = std::min(cheapest.value_or(*solution->estimatedWorks),
+                                *solution->estimatedWorks);
+        }
+    }
+    if (!cheapest) {
+        return;
+    }
+
+    // Plans which examine only a handful of keys are cheap to try anyway.
+    const double limit =
+        ratio * std::max(*cheapest, double(internalQueryPlanEvaluationMaxResults.load()));
+    const auto numCandidates = solutions->size();
+    solutions->erase(std::remove_if(solutions->begin(),
+                                    solutions->end(),
+                                    [&](auto&& solution) {
+                                        return solution->estimatedWorks &&
+                                            *solution->estimatedWorks > limit;
+                                    }),
+                     solutions->end());
+    if (solutions->size() < numCandidates) {
+        LOGV2_DEBUG(5843128,
+                    2,
+                    "Pruned candidate plans by their estimated cardinality",
+                    "query"_attr = redact(cq.toStringShort()),
+                    "numCandidates"_attr = numCandidates,
+                    "numPruned"_attr = numCandidates - solutions->size(),
+                    "cheapestEstimatedWorks"_attr = *cheapest);
+    }
+}
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
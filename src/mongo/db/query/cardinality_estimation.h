@@ -0,0 +1,68 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <memory>
+#include <vector>
+
+namespace mongo {
+
+class CanonicalQuery;
+class CollectionPtr;
+class OperationContext;
+class QuerySolution;
+
+namespace cardinality_estimation {
+
+/**
+ * Returns the estimated number of index keys and documents that 'solution' examines to run to
+ * completion, or boost::none if it scans a field for which the 'analyze' command has not built a
+ * histogram. A fetch counts one document per input, so an intersection of index scans is charged
+ * only for the documents in the intersection.
+ */
+boost::optional<double> estimateWorks(OperationContext* opCtx,
+                                      const CollectionPtr& collection,
+                                      const QuerySolution& solution);
+
+/**
+ * Removes the candidate plans in 'solutions' which are estimated to examine more than
+ * 'internalQueryCardinalityEstimationPruningRatio' times as much as the cheapest of them, so that
+ * they are not trial run, and records the estimates of the remaining ones. Only a query which has
+ * to produce all of its results is pruned: with a sort or a limit, a plan which examines more may
+ * still stop first. Plans with no estimate are always kept.
+ */
+void pruneSolutions(OperationContext* opCtx,
+                    const CollectionPtr& collection,
+                    const CanonicalQuery& cq,
+                    std::vector<std::unique_ptr<QuerySolution>>* solutions);
+
+}  // namespace cardinality_estimation
+}  // namespace mongo
@@ -200,7 +200,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_AND_HASH: {
             const AndHashNode* ahn = static_cast<const AndHashNode*>(root);
-            auto ret = std::make_unique<AndHashStage>(expCtx, _ws);
+            auto ret = std::make_unique<AndHashStage>(expCtx, _ws, ahn->recordIdOnly);
             for (size_t i = 0; i < ahn->children.size(); ++i) {
                 auto childStage = build(ahn->children[i]);
                 ret->addChild(std::move(childStage));
@@ -218,7 +218,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         }
         case STAGE_AND_SORTED: {
             const AndSortedNode* asn = static_cast<const AndSortedNode*>(root);
-            auto ret = std::make_unique<AndSortedStage>(expCtx, _ws);
+            auto ret = std::make_unique<AndSortedStage>(expCtx, _ws, asn->recordIdOnly);
             for (size_t i = 0; i < asn->children.size(); ++i) {
                 auto childStage = build(asn->children[i]);
                 ret->addChild(std::move(childStage));
@@ -279,8 +279,22 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
                     _ftsKeyPrefixSize);
 
             auto node = static_cast<const TextOrNode*>(root);
-            auto ret = std::make_unique<TextOrStage>(
-                expCtx, *_ftsKeyPrefixSize, _ws, node->filter.get(), _collection);
+            boost::optional<TextOrTopKParams> topKParams;
+            if (node->limit) {
+                tassert(5869300,
+                        "text match parameters must be defined before processing a limited "
+                        "TEXT_OR node",
+                        _textMatchParams);
+                topKParams.emplace(node->limit,
+                                   _textMatchParams->spec,
+                                   _textMatchParams->query.getTermsForBounds());
+            }
+            auto ret = std::make_unique<TextOrStage>(expCtx,
+                                                     *_ftsKeyPrefixSize,
+                                                     _ws,
+                                                     node->filter.get(),
+                                                     _collection,
+                                                     std::move(topKParams));
             for (auto childNode : root->children) {
                 ret->addChild(build(childNode));
             }
@@ -311,7 +325,11 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
             // here before recursively descending into procession child nodes, and will reset once a
             // text sub-tree is constructed.
             _ftsKeyPrefixSize.emplace(params.spec.numExtraBefore());
-            ON_BLOCK_EXIT([&] { _ftsKeyPrefixSize = {}; });
+            _textMatchParams = &params;
+            ON_BLOCK_EXIT([&] {
+                _ftsKeyPrefixSize = {};
+                _textMatchParams = nullptr;
+            });
 
             return std::make_unique<TextMatchStage>(expCtx, build(root->children[0]), params, _ws);
         }
@@ -409,6 +427,7 @@ std::unique_ptr<PlanStage> ClassicStageBuilder::build(const QuerySolutionNode* r
         case STAGE_CACHED_PLAN:
         case STAGE_COUNT:
         case STAGE_DELETE:
+        case STAGE_GROUP:
         case STAGE_IDHACK:
         case STAGE_MOCK:
         case STAGE_MULTI_ITERATOR:
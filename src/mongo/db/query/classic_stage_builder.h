@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/exec/plan_stage.h"
+#include "mongo/db/exec/text_match.h"
 #include "mongo/db/query/stage_builder.h"
 
 namespace mongo::stage_builder {
@@ -51,5 +52,9 @@ private:
     WorkingSet* _ws;
 
     boost::optional<size_t> _ftsKeyPrefixSize;
+
+    // The parameters of the TEXT_MATCH stage whose text sub-tree is being constructed, needed by a
+    // TEXT_OR stage which only returns the highest scoring documents.
+    const TextMatchParams* _textMatchParams = nullptr;
 };
 }  // namespace mongo::stage_builder
@@ -31,17 +31,71 @@
 
 #include "mongo/db/query/collation/collator_interface_icu.h"
 
+#include <array>
+#include <functional>
 #include <memory>
+#include <string_view>
 
 #include <unicode/coll.h>
 #include <unicode/sortkey.h>
 
+#include "mongo/platform/atomic_word.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
+namespace {
+
+AtomicWord<uint64_t> nextCollatorId{1};
+
+/**
+ * A small per-thread cache of the comparison keys of short strings. Index key generation and
+ * sorts often compute the keys of the same values over and over, such as the user names in a
+ * case-insensitive index, and computing a key with ICU costs much more than a lookup here. Each
+ * slot holds the most recent string hashed to it, and entries are tagged with the id of their
+ * collator, since collators with different specs give different keys for the same string.
+ */
+class ComparisonKeyCache {
+public:
+    // Only strings up to this long are cached, which bounds the memory of the cache per thread.
+    static constexpr size_t kMaxStringSize = 48;
+
+    /**
+     * Returns the cached key of 'stringData' for the collator 'collatorId', computing and caching
+     * it with 'computeKey' if it is not cached.
+     */
+    template <typename ComputeKey>
+    const std::string& get(uint64_t collatorId, StringData stringData, ComputeKey&& computeKey) {
+        const std::string_view view(stringData.rawData(), stringData.size());
+        const size_t hash = std::hash<std::string_view>{}(view);
+        auto& slot = _slots[(hash ^ collatorId) % kNumSlots];
+        if (slot.collatorId != collatorId || StringData(slot.string) != stringData) {
+            slot.key = computeKey(stringData);
+            slot.string.assign(stringData.rawData(), stringData.size());
+            slot.collatorId = collatorId;
+        }
+        return slot.key;
+    }
+
+private:
+    static constexpr size_t kNumSlots = 128;
+
+    struct Slot {
+        uint64_t collatorId = 0;
+        std::string string;
+        std::string key;
+    };
+
+    std::array<Slot, kNumSlots> _slots;
+};
+
+thread_local ComparisonKeyCache comparisonKeyCache;
+
+}  // namespace
 
 CollatorInterfaceICU::CollatorInterfaceICU(Collation spec, std::unique_ptr<icu::Collator> collator)
-    : CollatorInterface(std::move(spec)), _collator(std::move(collator)) {}
+    : CollatorInterface(std::move(spec)),
+      _collator(std::move(collator)),
+      _id(nextCollatorId.fetchAndAdd(1)) {}
 
 std::unique_ptr<CollatorInterface> CollatorInterfaceICU::clone() const {
     auto clone = std::make_unique<CollatorInterfaceICU>(
@@ -74,6 +128,14 @@ int CollatorInterfaceICU::compare(StringData left, StringData right) const {
 
 CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     StringData stringData) const {
+    if (stringData.size() > ComparisonKeyCache::kMaxStringSize) {
+        return makeComparisonKey(_computeComparisonKey(stringData));
+    }
+    return makeComparisonKey(comparisonKeyCache.get(
+        _id, stringData, [this](StringData str) { return _computeComparisonKey(str); }));
+}
+
+std::string CollatorInterfaceICU::_computeComparisonKey(StringData stringData) const {
     // A StringPiece is ICU's StringData. They are logically the same abstraction.
     const icu::StringPiece stringPiece(stringData.rawData(), stringData.size());
 
@@ -95,7 +157,7 @@ CollatorInterface::ComparisonKey CollatorInterfaceICU::getComparisonKey(
     // omit the trailing null byte.
     invariant(keyBuffer[keyLength - 1u] == '\0');
     const char* charBuffer = reinterpret_cast<const char*>(keyBuffer);
-    return makeComparisonKey(std::string(charBuffer, keyLength - 1u));
+    return std::string(charBuffer, keyLength - 1u);
 }
 
 }  // namespace mongo
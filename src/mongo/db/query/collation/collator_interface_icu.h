@@ -31,7 +31,9 @@
 
 #include "mongo/db/query/collation/collator_interface.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 
 namespace icu {
 class Collator;
@@ -54,9 +56,15 @@ public:
     ComparisonKey getComparisonKey(StringData stringData) const final;
 
 private:
+    std::string _computeComparisonKey(StringData stringData) const;
+
     // The ICU implementation of the collator to which we delegate interesting work. Const methods
     // on the ICU collator are expected to be thread-safe.
     const std::unique_ptr<icu::Collator> _collator;
+
+    // Identifies this collator in the per-thread cache of comparison keys. Unlike its address, it
+    // is never reused by another collator.
+    const uint64_t _id;
 };
 
 }  // namespace mongo
@@ -594,4 +594,36 @@ TEST(CollatorInterfaceICUTest, ComparisonKeysForFrCaCollatorCorrect) {
               "\x2D\x45\x4F\x31\x01\x88\x44\x8E\x06\x01\x0A");
 }
 
+TEST(CollatorInterfaceICUTest, CachedComparisonKeysAreNotSharedBetweenCollators) {
+    UErrorCode status = U_ZERO_ERROR;
+    Collation enUsSpec;
+    enUsSpec.setLocale("en_US");
+    std::unique_ptr<icu::Collator> enUsColl(
+        icu::Collator::createInstance(icu::Locale("en", "US"), status));
+    ASSERT(U_SUCCESS(status));
+    CollatorInterfaceICU enUsCollator(enUsSpec, std::move(enUsColl));
+
+    Collation frCaSpec;
+    frCaSpec.setLocale("fr_CA");
+    std::unique_ptr<icu::Collator> frCaColl(
+        icu::Collator::createInstance(icu::Locale("fr", "CA"), status));
+    ASSERT(U_SUCCESS(status));
+    CollatorInterfaceICU frCaCollator(frCaSpec, std::move(frCaColl));
+
+    // Repeated values, as in an index on a field with few distinct values, keep their keys.
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(enUsCollator.getComparisonKey("c\xC3\xB4t\xC3\xA9").getKeyData(),
+                  "\x2D\x45\x4F\x31\x01\x44\x8E\x44\x88\x01\x0A");
+        ASSERT_EQ(frCaCollator.getComparisonKey("c\xC3\xB4t\xC3\xA9").getKeyData(),
+                  "\x2D\x45\x4F\x31\x01\x88\x44\x8E\x06\x01\x0A");
+    }
+
+    // Strings too long to be cached are given their keys all the same.
+    const std::string longString(200, 'a');
+    ASSERT_EQ(enUsCollator.getComparisonKey(longString).getKeyData(),
+              frCaCollator.getComparisonKey(longString).getKeyData());
+    ASSERT_LT(enUsCollator.getComparisonKey("aaa").getKeyData(),
+              enUsCollator.getComparisonKey(longString).getKeyData());
+}
+
 }  // namespace
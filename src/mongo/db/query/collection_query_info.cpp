@@ -46,9 +46,11 @@
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index/wildcard_access_method.h"
 #include "mongo/db/query/collection_index_usage_tracker_decoration.h"
+#include "mongo/db/query/field_histogram.h"
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/planner_ixselect.h"
+#include "mongo/db/query/sbe_plan_cache.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/clock_source.h"
@@ -80,7 +82,10 @@ CoreIndexInfo indexInfoFromIndexCatalogEntry(const IndexCatalogEntry& ice) {
 }  // namespace
 
 CollectionQueryInfo::CollectionQueryInfo()
-    : _keysComputed(false), _planCache(std::make_shared<PlanCache>()) {}
+    : _keysComputed(false),
+      _planCache(std::make_shared<PlanCache>()),
+      _sbePlanCache(std::make_shared<sbe::PlanCache>()),
+      _histograms(std::make_shared<CollectionHistograms>()) {}
 
 const UpdateIndexData& CollectionQueryInfo::getIndexKeys(OperationContext* opCtx) const {
     invariant(_keysComputed);
@@ -97,7 +102,10 @@ void CollectionQueryInfo::computeIndexKeys(OperationContext* opCtx, const Collec
         const IndexDescriptor* descriptor = entry->descriptor();
         const IndexAccessMethod* iam = entry->accessMethod();
 
-        if (descriptor->getAccessMethodName() == IndexNames::WILDCARD) {
+        if (descriptor->getAccessMethodName() == IndexNames::COLUMN) {
+            // A columnstore index holds every path of the document.
+            _indexedPaths.allPathsIndexed();
+        } else if (descriptor->getAccessMethodName() == IndexNames::WILDCARD) {
             // Obtain the projection used by the $** index's key generator.
             const auto* pathProj =
                 static_cast<const WildcardAccessMethod*>(iam)->getWildcardProjection();
@@ -187,6 +195,7 @@ void CollectionQueryInfo::clearQueryCache(OperationContext* opCtx, const Collect
                     "namespace"_attr = coll->ns());
 
         _planCache->clear();
+        _sbePlanCache->clear();
     } else {
         LOGV2_DEBUG(5014502,
                     1,
@@ -194,6 +203,7 @@ void CollectionQueryInfo::clearQueryCache(OperationContext* opCtx, const Collect
                     "namespace"_attr = coll->ns());
 
         _planCache = std::make_shared<PlanCache>();
+        _sbePlanCache = std::make_shared<sbe::PlanCache>();
         updatePlanCacheIndexEntries(opCtx, coll);
     }
 }
@@ -204,12 +214,21 @@ void CollectionQueryInfo::clearQueryCacheForSetMultikey(const CollectionPtr& col
                 "Clearing plan cache for multikey - collection info cache cleared",
                 "namespace"_attr = coll->ns());
     _planCache->clear();
+    _sbePlanCache->clear();
 }
 
 PlanCache* CollectionQueryInfo::getPlanCache() const {
     return _planCache.get();
 }
 
+sbe::PlanCache* CollectionQueryInfo::getSbePlanCache() const {
+    return _sbePlanCache.get();
+}
+
+CollectionHistograms* CollectionQueryInfo::getHistograms() const {
+    return _histograms.get();
+}
+
 void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
                                                       const CollectionPtr& coll) {
     std::vector<CoreIndexInfo> indexCores;
@@ -221,6 +240,10 @@ void CollectionQueryInfo::updatePlanCacheIndexEntries(OperationContext* opCtx,
         coll->getIndexCatalog()->getIndexIterator(opCtx, includeUnfinishedIndexes);
     while (ii->more()) {
         const IndexCatalogEntry* ice = ii->next();
+        if (ice->descriptor()->getIndexType() == IndexType::INDEX_COLUMN) {
+            // Columnstore indexes are never used in query planning.
+            continue;
+        }
         indexCores.emplace_back(indexInfoFromIndexCatalogEntry(*ice));
     }
 
@@ -242,6 +265,7 @@ void CollectionQueryInfo::init(OperationContext* opCtx, const CollectionPtr& col
 
 void CollectionQueryInfo::rebuildIndexData(OperationContext* opCtx, const CollectionPtr& coll) {
     _planCache = std::make_shared<PlanCache>();
+    _sbePlanCache = std::make_shared<sbe::PlanCache>();
 
     _keysComputed = false;
     computeIndexKeys(opCtx, coll);
@@ -36,9 +36,14 @@
 
 namespace mongo {
 
+class CollectionHistograms;
 class IndexDescriptor;
 class OperationContext;
 
+namespace sbe {
+class PlanCache;
+}  // namespace sbe
+
 /**
  * Query information for a particular point-in-time view of a collection.
  *
@@ -62,6 +67,16 @@ public:
      */
     PlanCache* getPlanCache() const;
 
+    /**
+     * Get the cache of ready to execute SBE plans for this collection.
+     */
+    sbe::PlanCache* getSbePlanCache() const;
+
+    /**
+     * Get the field histograms built for this collection by the 'analyze' command.
+     */
+    CollectionHistograms* getHistograms() const;
+
     /* get set of index keys for this namespace.  handy to quickly check if a given
        field is indexed (Note it might be a secondary component of a compound index.)
     */
@@ -108,6 +123,14 @@ private:
 
     // A cache for query plans. Shared across cloned Collection instances.
     std::shared_ptr<PlanCache> _planCache;
+
+    // A cache for SBE plans, invalidated together with '_planCache'. Shared across cloned
+    // Collection instances.
+    std::shared_ptr<sbe::PlanCache> _sbePlanCache;
+
+    // The histograms describe the documents rather than the indexes, so they are kept when the
+    // plan caches are rebuilt. Shared across cloned Collection instances.
+    std::shared_ptr<CollectionHistograms> _histograms;
 };
 
 }  // namespace mongo
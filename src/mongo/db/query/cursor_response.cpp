@@ -64,6 +64,20 @@ CursorResponseBuilder::CursorResponseBuilder(rpc::ReplyBuilderInterface* replyBu
                                                                            : kBatchField));
 }
 
+void CursorResponseBuilder::_reserveForBatch(const BSONObj& firstDoc) {
+    // Each array element also takes a type byte and its index as a null-terminated field name.
+    constexpr long long kElementOverhead = 1 + 8;
+    const long long docBytes = firstDoc.objsize() + kElementOverhead;
+    const long long maxBytes = BSONObjMaxUserSize;
+    const auto bytes = _options.expectedNumDocs - 1 < maxBytes / docBytes
+        ? (_options.expectedNumDocs - 1) * docBytes
+        : maxBytes;
+
+    auto& buf = _batch->bb();
+    buf.reserveBytes(bytes);
+    buf.claimReservedBytes(bytes);
+}
+
 void CursorResponseBuilder::done(CursorId cursorId, StringData cursorNamespace) {
     invariant(_active);
 
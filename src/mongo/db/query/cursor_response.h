@@ -57,6 +57,9 @@ public:
     struct Options {
         bool isInitialResponse = false;
         boost::optional<LogicalTime> atClusterTime = boost::none;
+        // The most documents the batch can hold, if known. The reply buffer is then sized for the
+        // whole batch from the first document rather than regrown, and copied, as the batch fills.
+        long long expectedNumDocs = 0;
     };
 
     /**
@@ -85,6 +88,9 @@ public:
 
         _batch->append(obj);
         _numDocs++;
+        if (MONGO_unlikely(_numDocs == 1 && _options.expectedNumDocs > 1)) {
+            _reserveForBatch(obj);
+        }
     }
 
     void setPostBatchResumeToken(BSONObj token) {
@@ -117,6 +123,8 @@ public:
     void abandon();
 
 private:
+    void _reserveForBatch(const BSONObj& firstDoc);
+
     const Options _options;
     rpc::ReplyBuilderInterface* const _replyBuilder;
     // Order here is important to ensure destruction in the correct order.
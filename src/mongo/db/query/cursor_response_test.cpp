@@ -259,6 +259,26 @@ TEST(CursorResponseTest, roundTripThroughCursorResponseBuilderWithPartialResults
     ASSERT(!cursorBuilderIt.more());
 }
 
+TEST(CursorResponseTest, cursorResponseBuilderWithExpectedNumDocs) {
+    auto buildResponse = [](long long expectedNumDocs, int numDocs) {
+        CursorResponseBuilder::Options options;
+        options.expectedNumDocs = expectedNumDocs;
+        rpc::OpMsgReplyBuilder builder;
+        CursorResponseBuilder crb(&builder, options);
+        for (int i = 0; i < numDocs; i++) {
+            crb.append(BSON("_id" << i << "padding" << std::string(i * 10, 'x')));
+        }
+        crb.done(CursorId(123), "db.coll");
+        return OpMsg::parse(builder.done()).body.getOwned();
+    };
+
+    // Reserving space for the batch, even more than it ends up using, leaves the reply unchanged.
+    const auto expected = buildResponse(0, 20);
+    ASSERT_BSONOBJ_EQ(expected, buildResponse(20, 20));
+    ASSERT_BSONOBJ_EQ(expected, buildResponse(1000, 20));
+    ASSERT_BSONOBJ_EQ(expected, buildResponse(std::numeric_limits<long long>::max(), 20));
+}
+
 TEST(CursorResponseTest, parseFromBSONHandleErrorResponse) {
     StatusWith<CursorResponse> result =
         CursorResponse::parseFromBSON(BSON("ok" << 0 << "code" << 123 << "errmsg"
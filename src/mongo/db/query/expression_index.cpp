@@ -212,12 +212,22 @@ void ExpressionMapping::S2CellIdsToIntervalsWithParents(const std::vector<S2Cell
         }
     }
 
-    for (const S2CellId& exact : exactSet) {
-        BSONObj exactBSON = S2CellIdToIndexKey(exact, indexParams.indexVersion);
+    S2CellIdsToIntervalsWithExactCells(intervalSet,
+                                       std::vector<S2CellId>(exactSet.begin(), exactSet.end()),
+                                       indexParams.indexVersion,
+                                       oilOut);
+}
+
+void ExpressionMapping::S2CellIdsToIntervalsWithExactCells(const std::vector<S2CellId>& rangeCells,
+                                                           const std::vector<S2CellId>& exactCells,
+                                                           const S2IndexVersion indexVersion,
+                                                           OrderedIntervalList* oilOut) {
+    for (const S2CellId& exact : exactCells) {
+        BSONObj exactBSON = S2CellIdToIndexKey(exact, indexVersion);
         oilOut->intervals.push_back(IndexBoundsBuilder::makePointInterval(exactBSON));
     }
 
-    S2CellIdsToIntervalsUnsorted(intervalSet, indexParams.indexVersion, oilOut);
+    S2CellIdsToIntervalsUnsorted(rangeCells, indexVersion, oilOut);
     std::sort(oilOut->intervals.begin(), oilOut->intervals.end(), compareIntervals);
     // Make sure that our intervals don't overlap each other and are ordered correctly.
     // This perhaps should only be done in debug mode.
@@ -75,6 +75,13 @@ public:
                                                 const S2IndexingParams& indexParams,
                                                 OrderedIntervalList* out);
 
+    // Creates an ordered interval list from range intervals over 'rangeCells' and exact intervals
+    // over 'exactCells'. No cell in 'exactCells' may lie within a cell in 'rangeCells'.
+    static void S2CellIdsToIntervalsWithExactCells(const std::vector<S2CellId>& rangeCells,
+                                                   const std::vector<S2CellId>& exactCells,
+                                                   const S2IndexVersion indexVersion,
+                                                   OrderedIntervalList* oilOut);
+
     static void cover2dsphere(const S2Region& region,
                               const S2IndexingParams& indexParams,
                               OrderedIntervalList* oilOut);
@@ -0,0 +1,198 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/field_histogram.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace {
+
+bool keyLess(const BSONObj& lhs, const BSONObj& rhs) {
+    return lhs.firstElement().woCompare(rhs.firstElement(), false) < 0;
+}
+
+/**
+ * Returns where 'value' lies between 'lower' and 'upper', from 0 to 1. Only numbers and dates can
+ * be interpolated, anything else is assumed to lie in the middle.
+ */
+double interpolate(const BSONElement& lower, const BSONElement& value, const BSONElement& upper) {
+    double lo, v, hi;
+    if (lower.isNumber() && value.isNumber() && upper.isNumber()) {
+        lo = lower.numberDouble();
+        v = value.numberDouble();
+        hi = upper.numberDouble();
+    } else if (lower.type() == BSONType::Date && value.type() == BSONType::Date &&
+               upper.type() == BSONType::Date) {
+        lo = lower.date().toMillisSinceEpoch();
+        v = value.date().toMillisSinceEpoch();
+        hi = upper.date().toMillisSinceEpoch();
+    } else {
+        return 0.5;
+    }
+    if (!(hi > lo)) {
+        return 0.5;
+    }
+    return std::clamp((v - lo) / (hi - lo), 0.0, 1.0);
+}
+
+}  // namespace
+
+FieldHistogram FieldHistogram::make(std::vector<BSONObj> keys, size_t maxBuckets, double scale) {
+    invariant(maxBuckets > 0);
+
+    FieldHistogram histogram;
+    if (keys.empty()) {
+        return histogram;
+    }
+
+    std::sort(keys.begin(), keys.end(), keyLess);
+    histogram._minKey = keys.front().getOwned();
+
+    const double depth = static_cast<double>(keys.size()) / maxBuckets;
+    Bucket current;
+    for (size_t runStart = 0; runStart < keys.size();) {
+        size_t runEnd = runStart + 1;
+        while (runEnd < keys.size() && !keyLess(keys[runStart], keys[runEnd])) {
+            ++runEnd;
+        }
+        const double runLength = runEnd - runStart;
+
+        // A frequent value, or the value that fills the bucket up, ends the bucket.
+        if (runEnd == keys.size() || runLength >= depth ||
+            current.rangeCount + runLength >= depth) {
+            current.upperBound = keys[runStart].getOwned();
+            current.boundCount = runLength;
+            histogram._buckets.push_back(std::move(current));
+            current = Bucket();
+        } else {
+            current.rangeCount += runLength;
+            current.rangeDistincts += 1;
+        }
+        runStart = runEnd;
+    }
+
+    for (auto&& bucket : histogram._buckets) {
+        bucket.boundCount *= scale;
+        bucket.rangeCount *= scale;
+        bucket.rangeDistincts = std::min(bucket.rangeDistincts * scale, bucket.rangeCount);
+        histogram._totalCount += bucket.rangeCount + bucket.boundCount;
+        histogram._cumulativeCounts.push_back(histogram._totalCount);
+    }
+    return histogram;
+}
+
+double FieldHistogram::_countBelow(const BSONElement& value, bool inclusive) const {
+    auto bucket = std::lower_bound(
+        _buckets.begin(), _buckets.end(), value, [](const Bucket& bucket, const BSONElement& v) {
+            return bucket.upperBound.firstElement().woCompare(v, false) < 0;
+        });
+    if (bucket == _buckets.end()) {
+        return _totalCount;
+    }
+
+    const size_t index = bucket - _buckets.begin();
+    const double below = index == 0 ? 0 : _cumulativeCounts[index - 1];
+    const auto upper = bucket->upperBound.firstElement();
+    if (upper.woCompare(value, false) == 0) {
+        return below + bucket->rangeCount + (inclusive ? bucket->boundCount : 0);
+    }
+
+    // The value falls within the range of the bucket.
+    const auto lower =
+        index == 0 ? _minKey.firstElement() : _buckets[index - 1].upperBound.firstElement();
+    if (bucket->rangeDistincts == 0 || (index == 0 && value.woCompare(lower, false) < 0)) {
+        return below;
+    }
+    const double averageFrequency = bucket->rangeCount / bucket->rangeDistincts;
+    const double inRange = interpolate(lower, value, upper) * bucket->rangeCount +
+        (inclusive ? averageFrequency : 0);
+    return below + std::min(inRange, bucket->rangeCount);
+}
+
+double FieldHistogram::estimate(const Interval& interval) const {
+    auto start = interval.start;
+    auto end = interval.end;
+    bool startInclusive = interval.startInclusive;
+    bool endInclusive = interval.endInclusive;
+    if (start.woCompare(end, false) > 0) {
+        // The interval of a descending index or scan.
+        std::swap(start, end);
+        std::swap(startInclusive, endInclusive);
+    }
+    return std::max(_countBelow(end, endInclusive) - _countBelow(start, !startInclusive), 0.0);
+}
+
+double FieldHistogram::estimate(const OrderedIntervalList& oil) const {
+    double count = 0;
+    for (auto&& interval : oil.intervals) {
+        count += estimate(interval);
+    }
+    return std::min(count, _totalCount);
+}
+
+BSONObj FieldHistogram::toBSON() const {
+    BSONObjBuilder bob;
+    bob.append("totalCount", _totalCount);
+    if (!_minKey.isEmpty()) {
+        bob.appendAs(_minKey.firstElement(), "min");
+    }
+    BSONArrayBuilder buckets(bob.subarrayStart("buckets"));
+    for (auto&& bucket : _buckets) {
+        BSONObjBuilder bucketBob(buckets.subobjStart());
+        bucketBob.appendAs(bucket.upperBound.firstElement(), "upperBound");
+        bucketBob.append("boundCount", bucket.boundCount);
+        bucketBob.append("rangeCount", bucket.rangeCount);
+        bucketBob.append("rangeDistincts", bucket.rangeDistincts);
+    }
+    buckets.doneFast();
+    return bob.obj();
+}
+
+std::shared_ptr<const FieldHistogram> CollectionHistograms::get(StringData path) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _histograms.find(path);
+    return it == _histograms.end() ? nullptr : it->second;
+}
+
+void CollectionHistograms::set(StringData path, std::shared_ptr<const FieldHistogram> histogram) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _histograms[path] = std::move(histogram);
+}
+
+bool CollectionHistograms::empty() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _histograms.empty();
+}
+
+}  // namespace mongo
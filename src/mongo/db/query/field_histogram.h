@@ -0,0 +1,132 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/query/index_bounds.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * An equi-depth histogram of the index keys of a single field, built from a sample of the
+ * documents of a collection by the 'analyze' command. The query planner uses it to estimate how
+ * many keys an index scan over a set of intervals examines.
+ *
+ * Each bucket covers the values greater than the upper bound of the previous bucket and up to its
+ * own upper bound. Values that occur at least as often as a whole bucket holds become an upper
+ * bound of their own, so the counts of frequent values are kept exactly, as far as the sample
+ * goes, and skewed data is estimated well.
+ */
+class FieldHistogram {
+public:
+    struct Bucket {
+        // A single element object with an empty field name holding the upper bound.
+        BSONObj upperBound;
+
+        // The estimated number of keys equal to the upper bound.
+        double boundCount = 0;
+
+        // The estimated number of keys between the upper bound of the previous bucket and this
+        // one, and the number of distinct values among them.
+        double rangeCount = 0;
+        double rangeDistincts = 0;
+    };
+
+    /**
+     * Builds a histogram of about 'maxBuckets' buckets from the index keys 'keys' of the sampled
+     * documents, each a single element object with an empty field name. Every count is multiplied
+     * by 'scale', which is the number of documents in the collection over the number sampled.
+     */
+    static FieldHistogram make(std::vector<BSONObj> keys, size_t maxBuckets, double scale);
+
+    /**
+     * Returns the estimated number of keys that fall in one of the intervals of 'oil', in either
+     * index direction.
+     */
+    double estimate(const OrderedIntervalList& oil) const;
+    double estimate(const Interval& interval) const;
+
+    /**
+     * Returns the estimated number of keys in the whole collection.
+     */
+    double getTotalCount() const {
+        return _totalCount;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    BSONObj toBSON() const;
+
+private:
+    /**
+     * Returns the estimated number of keys less than 'value', or less than or equal to it if
+     * 'inclusive' is true.
+     */
+    double _countBelow(const BSONElement& value, bool inclusive) const;
+
+    std::vector<Bucket> _buckets;
+
+    // The number of keys up to and including the upper bound of each bucket.
+    std::vector<double> _cumulativeCounts;
+
+    // The smallest key in the sample, which is the lower bound of the first bucket.
+    BSONObj _minKey;
+
+    double _totalCount = 0;
+};
+
+/**
+ * The histograms built for the fields of a collection, by field path. Shared by all the clones of
+ * a Collection instance, and dropped with the collection.
+ */
+class CollectionHistograms {
+public:
+    /**
+     * Returns the histogram of 'path', or nullptr if none has been built.
+     */
+    std::shared_ptr<const FieldHistogram> get(StringData path) const;
+
+    void set(StringData path, std::shared_ptr<const FieldHistogram> histogram);
+
+    bool empty() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CollectionHistograms::_mutex");
+    StringMap<std::shared_ptr<const FieldHistogram>> _histograms;
+};
+
+}  // namespace mongo
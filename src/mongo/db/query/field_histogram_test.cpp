@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/field_histogram.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+std::vector<BSONObj> makeKeys(int begin, int end) {
+    std::vector<BSONObj> keys;
+    for (int i = begin; i < end; ++i) {
+        keys.push_back(BSON("" << i));
+    }
+    return keys;
+}
+
+double estimateRange(const FieldHistogram& histogram, BSONObj bounds, bool inclusive = true) {
+    return histogram.estimate(Interval(bounds, inclusive, inclusive));
+}
+
+TEST(FieldHistogramTest, EstimatesUniformValues) {
+    auto histogram = FieldHistogram::make(makeKeys(0, 1000), 10, 1.0);
+    ASSERT_EQ(1000, histogram.getTotalCount());
+    ASSERT_LTE(histogram.getBuckets().size(), 11U);
+
+    ASSERT_APPROX_EQUAL(500, estimateRange(histogram, BSON("" << 0 << "" << 499)), 20);
+    ASSERT_APPROX_EQUAL(100, estimateRange(histogram, BSON("" << 250 << "" << 349)), 20);
+    ASSERT_APPROX_EQUAL(1, estimateRange(histogram, BSON("" << 512 << "" << 512)), 1);
+    ASSERT_EQ(1000, estimateRange(histogram, BSON("" << MINKEY << "" << MAXKEY)));
+    ASSERT_EQ(0, estimateRange(histogram, BSON("" << 2000 << "" << MAXKEY)));
+    ASSERT_EQ(0, estimateRange(histogram, BSON("" << MINKEY << "" << -1)));
+
+    // The intervals of a descending scan are reversed.
+    ASSERT_EQ(estimateRange(histogram, BSON("" << 0 << "" << 499)),
+              estimateRange(histogram, BSON("" << 499 << "" << 0)));
+}
+
+TEST(FieldHistogramTest, KeepsTheCountsOfFrequentValues) {
+    auto keys = makeKeys(0, 100);
+    for (int i = 0; i < 900; ++i) {
+        keys.push_back(BSON("" << 7));
+    }
+    auto histogram = FieldHistogram::make(std::move(keys), 10, 1.0);
+
+    ASSERT_EQ(901, estimateRange(histogram, BSON("" << 7 << "" << 7)));
+    ASSERT_LTE(estimateRange(histogram, BSON("" << 50 << "" << 50)), 5);
+    ASSERT_APPROX_EQUAL(901 + 92, estimateRange(histogram, BSON("" << 7 << "" << MAXKEY)), 10);
+    ASSERT_APPROX_EQUAL(92, estimateRange(histogram, BSON("" << 7 << "" << MAXKEY), false), 10);
+}
+
+TEST(FieldHistogramTest, ScalesTheSampleToTheCollection) {
+    auto histogram = FieldHistogram::make(makeKeys(0, 100), 10, 10.0);
+    ASSERT_EQ(1000, histogram.getTotalCount());
+    ASSERT_APPROX_EQUAL(500, estimateRange(histogram, BSON("" << 0 << "" << 49)), 50);
+}
+
+TEST(FieldHistogramTest, OrdersValuesOfDifferentTypes) {
+    auto keys = makeKeys(0, 50);
+    for (int i = 0; i < 50; ++i) {
+        keys.push_back(BSON("" << std::string(1, 'a' + i % 26)));
+    }
+    keys.push_back(BSON("" << BSONNULL));
+    // A bucket for every key keeps every count exact.
+    const auto numKeys = keys.size();
+    auto histogram = FieldHistogram::make(std::move(keys), numKeys, 1.0);
+
+    // All of the strings.
+    ASSERT_EQ(50, histogram.estimate(Interval(BSON("" << "" << "" << BSONObj()), true, false)));
+    ASSERT_EQ(1, estimateRange(histogram, BSON("" << BSONNULL << "" << BSONNULL)));
+
+    OrderedIntervalList oil("a");
+    oil.intervals.push_back(Interval(BSON("" << BSONNULL << "" << BSONNULL), true, true));
+    oil.intervals.push_back(Interval(BSON("" << 0 << "" << 49), true, true));
+    ASSERT_EQ(51, histogram.estimate(oil));
+}
+
+TEST(FieldHistogramTest, EmptySampleEstimatesNothing) {
+    auto histogram = FieldHistogram::make({}, 10, 1.0);
+    ASSERT_EQ(0, histogram.getTotalCount());
+    ASSERT_EQ(0, estimateRange(histogram, BSON("" << MINKEY << "" << MAXKEY)));
+}
+
+TEST(CollectionHistogramsTest, KeepsAHistogramPerField) {
+    CollectionHistograms histograms;
+    ASSERT(histograms.empty());
+    ASSERT_FALSE(histograms.get("a"));
+
+    histograms.set("a",
+                   std::make_shared<FieldHistogram>(FieldHistogram::make(makeKeys(0, 10), 2, 1.0)));
+    ASSERT_FALSE(histograms.empty());
+    ASSERT_EQ(10, histograms.get("a")->getTotalCount());
+    ASSERT_FALSE(histograms.get("a.b"));
+}
+
+}  // namespace
+}  // namespace mongo
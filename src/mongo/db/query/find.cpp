@@ -38,6 +38,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/catalog/collection.h"
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/commands.h"
@@ -47,6 +48,7 @@
 #include "mongo/db/db_raii.h"
 #include "mongo/db/exec/filter.h"
 #include "mongo/db/exec/working_set_common.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/db/keypattern.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/collection_query_info.h"
@@ -55,6 +57,7 @@
 #include "mongo/db/query/get_executor.h"
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_summary_stats.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner_params.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/s/collection_sharding_state.h"
@@ -148,6 +151,56 @@ void endQueryOp(OperationContext* opCtx,
     }
 }
 
+bool canUseExpressIdLookup(OperationContext* opCtx, const CollectionPtr& collection) {
+    return internalQueryEnableExpressIdLookup.load() && collection &&
+        !collection->getDefaultCollator() && !collection.isSharded() &&
+        collection->getIndexCatalog()->findIdIndex(opCtx);
+}
+
+RecordId findByIdExpress(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         const BSONObj& idQuery,
+                         Snapshotted<BSONObj>* doc) {
+    const IndexCatalog* catalog = collection->getIndexCatalog();
+    const IndexDescriptor* desc = catalog->findIdIndex(opCtx);
+    invariant(desc);
+
+    RecordId recordId =
+        catalog->getEntry(desc)->accessMethod()->findSingle(opCtx, idQuery["_id"].wrap());
+    if (recordId.isNull() || !collection->findDoc(opCtx, recordId, doc)) {
+        return RecordId();
+    }
+    return recordId;
+}
+
+void endExpressIdOp(OperationContext* opCtx, const CollectionPtr& collection, bool found) {
+    auto curOp = CurOp::get(opCtx);
+    const auto& indexName = collection->getIndexCatalog()->findIdIndex(opCtx)->indexName();
+
+    {
+        stdx::lock_guard<Client> lk(*opCtx->getClient());
+        curOp->setPlanSummary_inlock("IDHACK"_sd);
+    }
+
+    PlanSummaryStats summaryStats;
+    summaryStats.nReturned = found ? 1 : 0;
+    summaryStats.totalKeysExamined = summaryStats.nReturned;
+    summaryStats.totalDocsExamined = summaryStats.nReturned;
+    summaryStats.indexesUsed.insert(indexName);
+    curOp->debug().setPlanSummaryMetrics(summaryStats);
+
+    CollectionQueryInfo::get(collection).notifyOfQuery(opCtx, collection, summaryStats);
+
+    if (curOp->shouldDBProfile(opCtx)) {
+        // Describe the lookup as the IDHACK stage which it stands in for.
+        curOp->debug().execStats = BSON("stage"
+                                        << "IDHACK"
+                                        << "nReturned" << static_cast<int>(found) << "keysExamined"
+                                        << static_cast<int>(found) << "docsExamined"
+                                        << static_cast<int>(found) << "indexName" << indexName);
+    }
+}
+
 namespace {
 
 /**
@@ -84,6 +84,31 @@ void endQueryOp(OperationContext* opCtx,
                 long long numResults,
                 CursorId cursorId);
 
+/**
+ * Returns true if an operation on a single exact _id value against 'collection' may look the
+ * document up with findByIdExpress() rather than through a PlanExecutor. This requires an _id
+ * index, the simple default collation and an unsharded collection, so that neither collation nor
+ * orphan filtering is needed.
+ */
+bool canUseExpressIdLookup(OperationContext* opCtx, const CollectionPtr& collection);
+
+/**
+ * Looks up the document whose _id equals the _id of 'idQuery' in the _id index of 'collection' and
+ * reads it. Returns its RecordId and fills out 'doc', or returns a null RecordId if there is no
+ * such document.
+ */
+RecordId findByIdExpress(OperationContext* opCtx,
+                         const CollectionPtr& collection,
+                         const BSONObj& idQuery,
+                         Snapshotted<BSONObj>* doc);
+
+/**
+ * The counterpart of endQueryOp() for an operation which used findByIdExpress(). Fills out the
+ * plan summary, the examined counts and the profiler's execStats for a lookup that did or did not
+ * find a document, and reports the _id index usage to the CollectionQueryInfo.
+ */
+void endExpressIdOp(OperationContext* opCtx, const CollectionPtr& collection, bool found);
+
 /**
  * Called from the getMore entry point in ops/query.cpp.
  * Returned buffer is the message to return to the client.
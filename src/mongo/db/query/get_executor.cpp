@@ -39,6 +39,7 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/parse_number.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/exec/cached_plan.h"
 #include "mongo/db/exec/collection_scan.h"
@@ -64,6 +65,7 @@
 #include "mongo/db/matcher/extensions_callback_noop.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/cardinality_estimation.h"
 #include "mongo/db/query/canonical_query_encoder.h"
 #include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/collation/collator_factory_interface.h"
@@ -86,6 +88,8 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+#include "mongo/db/query/sbe_stage_builder_index_scan.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
 #include "mongo/db/query/util/make_data_structure.h"
@@ -156,6 +160,23 @@ bool isIdHackEligibleQuery(const CollectionPtr& collection, const CanonicalQuery
         !findCommand.getTailable() &&
         CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
 }
+
+/**
+ * Returns 'true' if 'query' on the given 'collection' is an {_id: {$in: [...]}} query which an
+ * IDHACK plan can answer by looking up each key. Since the plan returns the documents in _id
+ * order, the query may not sort on anything else, and it cannot have a limit.
+ */
+bool isIdHackEligibleInQuery(const CollectionPtr& collection, const CanonicalQuery& query) {
+    const auto& findCommand = query.getFindCommandRequest();
+    const auto& sort = findCommand.getSort();
+    return internalQueryEnableIdHackForInQueries.load() && !findCommand.getShowRecordId() &&
+        findCommand.getHint().isEmpty() && findCommand.getMin().isEmpty() &&
+        findCommand.getMax().isEmpty() && !findCommand.getSkip() && !findCommand.getLimit() &&
+        !findCommand.getNtoreturn() && !findCommand.getTailable() &&
+        (sort.isEmpty() || SimpleBSONObjComparator::kInstance.evaluate(sort == BSON("_id" << 1))) &&
+        CanonicalQuery::isSimpleIdInQuery(findCommand.getFilter()) &&
+        CollatorInterface::collatorsMatch(query.getCollator(), collection->getDefaultCollator());
+}
 }  // namespace
 
 bool isAnyComponentOfPathMultikey(const BSONObj& indexKeyPattern,
@@ -289,8 +310,9 @@ void fillOutPlannerParams(OperationContext* opCtx,
              ice->descriptor()->isSparse()))
             continue;
 
-        // Skip the addition of hidden indexes to prevent use in query planning.
-        if (ice->descriptor()->hidden())
+        // Skip the addition of hidden indexes to prevent use in query planning. Columnstore
+        // indexes are only read by a column scan, which the planner does not produce.
+        if (ice->descriptor()->hidden() || indexType == IndexType::INDEX_COLUMN)
             continue;
         plannerParams->indices.push_back(
             indexEntryFromIndexCatalogEntry(opCtx, *ice, canonicalQuery));
@@ -346,6 +368,10 @@ void fillOutPlannerParams(OperationContext* opCtx,
         plannerParams->options |= QueryPlannerParams::ENUMERATE_OR_CHILDREN_LOCKSTEP;
     }
 
+    if (internalQueryPlannerEnableIndexSkipScan.load()) {
+        plannerParams->options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    }
+
     if (internalQueryPlannerGenerateCoveredWholeIndexScans.load()) {
         plannerParams->options |= QueryPlannerParams::GENERATE_COVERED_IXSCANS;
     }
@@ -569,6 +595,7 @@ public:
 
             auto solution = std::make_unique<QuerySolution>(_plannerOptions);
             solution->setRoot(std::make_unique<EofNode>());
+            extendSingleSolution(solution.get());
 
             auto root = buildExecutableTree(*solution);
 
@@ -592,7 +619,10 @@ public:
         const IndexDescriptor* idIndexDesc = _collection->getIndexCatalog()->findIdIndex(_opCtx);
 
         // If we have an _id index we can use an idhack plan.
-        if (idIndexDesc && isIdHackEligibleQuery(_collection, *_cq)) {
+        if (idIndexDesc &&
+            (isIdHackEligibleQuery(_collection, *_cq) ||
+             (supportsIdHackForInQueries() && !plannerParams.indexFiltersApplied &&
+              isIdHackEligibleInQuery(_collection, *_cq)))) {
             LOGV2_DEBUG(
                 20922, 2, "Using idhack", "canonicalQuery"_attr = redact(_cq->toStringShort()));
             // If an IDHACK plan is not supported, we will use the normal plan generation process
@@ -681,9 +711,14 @@ public:
             }
         }
 
+        // Skip the trial runs of the candidates which the field histograms show to be far more
+        // expensive than the cheapest one.
+        cardinality_estimation::pruneSolutions(_opCtx, _collection, *_cq, &solutions);
+
         if (1 == solutions.size()) {
             auto result = makeResult();
             // Only one possible plan. Run it. Build the stages from the solution.
+            extendSingleSolution(solutions[0].get());
             auto root = buildExecutableTree(*solutions[0]);
             result->emplace(std::move(root), std::move(solutions[0]));
 
@@ -713,6 +748,19 @@ protected:
      */
     virtual PlanStageType buildExecutableTree(const QuerySolution& solution) const = 0;
 
+    /**
+     * Gives the engine a chance to add nodes on top of a query 'solution' which is going to be
+     * executed as is, without any runtime planning. Called before the PlanStage tree is built.
+     */
+    virtual void extendSingleSolution(QuerySolution* solution) const {}
+
+    /**
+     * Returns true if buildIdHackPlan() can answer an {_id: {$in: [...]}} query.
+     */
+    virtual bool supportsIdHackForInQueries() const {
+        return false;
+    }
+
     /**
      * If supported, constructs a special PlanStage tree for fast-path document retrievals via the
      * _id index. Otherwise, nullptr should be returned and  this helper will fall back to the
@@ -782,6 +830,10 @@ protected:
         return stage_builder::buildClassicExecutableTree(_opCtx, _collection, *_cq, solution, _ws);
     }
 
+    bool supportsIdHackForInQueries() const final {
+        return true;
+    }
+
     std::unique_ptr<ClassicPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
         auto result = makeResult();
@@ -922,6 +974,17 @@ protected:
             _opCtx, _collection, *_cq, solution, _yieldPolicy);
     }
 
+    void extendSingleSolution(QuerySolution* solution) const final {
+        // If the aggregation layer has offered us a $group, execute it on top of the solution.
+        if (auto&& group = _cq->getGroupForPushdown()) {
+            solution->setRoot(std::make_unique<GroupNode>(solution->extractRoot(),
+                                                          group->groupByExpression,
+                                                          group->accumulators,
+                                                          group->allowDiskUse,
+                                                          group->maxMemoryUsageBytes));
+        }
+    }
+
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildIdHackPlan(
         const IndexDescriptor* descriptor, QueryPlannerParams* plannerParams) final {
         invariant(descriptor);
@@ -948,8 +1011,13 @@ protected:
 
             ixScan->bounds.fields.push_back(std::move(oil));
             ixScan->queryCollator = _cq->getCollator();
+
+            // Keep the _id seek keys out of the plan, so that it can be cached and reused for
+            // other _id values.
+            ixScan->parameterizeBounds = true;
             return ixScan;
         }();
+        const auto* ixScan = static_cast<const IndexScanNode*>(root.get());
 
         // IDHack plans always include a FETCH by convention. A covered IDHack probably isn't a
         // common case (a point query on _id where the only field returned is _id). It could be
@@ -976,8 +1044,9 @@ protected:
 
         auto soln = std::make_unique<QuerySolution>(plannerParams->options);
         soln->setRoot(std::move(root));
+        extendSingleSolution(soln.get());
 
-        auto execTree = buildExecutableTree(*soln);
+        auto execTree = buildIdHackExecutableTree(*soln, ixScan, *plannerParams);
         auto result = makeResult();
         result->emplace(std::move(execTree), std::move(soln));
 
@@ -1017,6 +1086,61 @@ protected:
         }
         return result;
     }
+
+private:
+    /**
+     * Constructs a PlanStage tree for the IDHACK 'solution', whose _id index scan is 'ixScan'. If
+     * the SBE plan cache holds a tree for a query of the same shape, a clone of that tree is bound
+     * to the _id value of this query and returned. Otherwise a new tree is built and cached.
+     */
+    std::pair<std::unique_ptr<sbe::PlanStage>, stage_builder::PlanStageData>
+    buildIdHackExecutableTree(const QuerySolution& solution,
+                              const IndexScanNode* ixScan,
+                              const QueryPlannerParams& plannerParams) {
+        // A pushed down $group and the shard filter are not part of the plan cache key, and the
+        // positional projection embeds the query predicate in the plan, so none of these plans can
+        // be shared between queries.
+        const auto* projection = _cq->getProj();
+        if (!internalQuerySlotBasedExecutionEnablePlanCache.load() ||
+            _cq->getGroupForPushdown() ||
+            (plannerParams.options & QueryPlannerParams::INCLUDE_SHARD_FILTER) ||
+            (projection && projection->requiresMatchDetails()) ||
+            _cq->getFindCommandRequest().getLet()) {
+            return buildExecutableTree(solution);
+        }
+
+        auto sbePlanCache = CollectionQueryInfo::get(_collection).getSbePlanCache();
+        const auto planCacheKey =
+            CollectionQueryInfo::get(_collection).getPlanCache()->computeKey(*_cq);
+        const auto& projectionObj = _cq->getFindCommandRequest().getProjection();
+
+        if (auto entry = sbePlanCache->get(planCacheKey); entry &&
+            SimpleBSONObjComparator::kInstance.evaluate(entry->projection == projectionObj)) {
+            auto root = entry->root->clone();
+            auto data = entry->data.makeDeepCopy();
+            if (stage_builder::rebindRuntimeEnvironment(*_cq, data.env) &&
+                stage_builder::bindParameterizedIndexBounds(
+                    _opCtx, _collection, ixScan, data.env)) {
+                root->attachToOperationContext(_opCtx);
+                if (_cq->getExpCtx()->explain || _cq->getExpCtx()->mayDbProfile) {
+                    root->markShouldCollectTimingInfo();
+                }
+
+                auto sbeYieldPolicy = dynamic_cast<PlanYieldPolicySBE*>(_yieldPolicy);
+                invariant(sbeYieldPolicy);
+                root->setYieldPolicy(sbeYieldPolicy);
+                sbeYieldPolicy->registerPlan(root.get());
+                return {std::move(root), std::move(data)};
+            }
+        }
+
+        auto execTree = buildExecutableTree(solution);
+        sbePlanCache->set(
+            planCacheKey,
+            std::make_shared<const sbe::PlanCache::Entry>(
+                execTree.first->clone(), execTree.second.makeDeepCopy(), projectionObj));
+        return execTree;
+    }
 };
 
 StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecutor(
@@ -1025,6 +1149,9 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getClassicExecu
     std::unique_ptr<CanonicalQuery> canonicalQuery,
     PlanYieldPolicy::YieldPolicy yieldPolicy,
     size_t plannerOptions) {
+    // The classic engine cannot execute a pushed down $group, so leave it in the pipeline.
+    canonicalQuery->setGroupForPushdown(boost::none);
+
     auto ws = std::make_unique<WorkingSet>();
     ClassicPrepareExecutionHelper helper{
         opCtx, *collection, ws.get(), canonicalQuery.get(), nullptr, plannerOptions};
@@ -1143,6 +1270,11 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
                                                   result->needsSubplanning(),
                                                   yieldPolicy.get(),
                                                   plannerOptions)) {
+        // The candidate plans were built without any pushed down $group, since the trial period
+        // would otherwise be spent entirely inside the blocking hash aggregation. Let the
+        // pipeline execute the $group instead.
+        cq->setGroupForPushdown(boost::none);
+
         // Do the runtime planning and pick the best candidate plan.
         auto candidates = planner->plan(std::move(solutions), std::move(roots));
         return plan_executor_factory::make(opCtx,
@@ -1651,22 +1783,52 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getExecutorUpda
 namespace {
 
 /**
- * If the given 'bounds' contains a single null interval return its position, otherwise return
- * boost::none.
+ * Returns the bounds, each with a single interval for every field, whose union is 'bounds', or
+ * boost::none if there would be none of them or more than 'maxBounds'.
  */
-boost::optional<size_t> boundsHasExactlyOneNullInterval(const IndexBounds& bounds) {
-    boost::optional<size_t> nullFieldNo;
-    for (size_t fieldNo = 0; fieldNo < bounds.fields.size(); ++fieldNo) {
-        const OrderedIntervalList& oil = bounds.fields[fieldNo];
-        if (IndexBoundsBuilder::isNullInterval(oil)) {
-            // Return boost::none if we have multiple null intervals.
-            if (nullFieldNo) {
-                return boost::none;
+boost::optional<std::vector<IndexBounds>> explodeBoundsIntoIntervals(const IndexBounds& bounds,
+                                                                     size_t maxBounds) {
+    std::vector<IndexBounds> exploded(1);
+    for (auto&& oil : bounds.fields) {
+        if (oil.intervals.empty() || exploded.size() * oil.intervals.size() > maxBounds) {
+            return boost::none;
+        }
+
+        std::vector<IndexBounds> next;
+        for (auto&& prefix : exploded) {
+            for (auto&& interval : oil.intervals) {
+                IndexBounds withInterval = prefix;
+                withInterval.fields.emplace_back(oil.name);
+                withInterval.fields.back().intervals.push_back(interval);
+                next.push_back(std::move(withInterval));
             }
-            nullFieldNo = fieldNo;
         }
+        exploded = std::move(next);
     }
-    return nullFieldNo;
+    return exploded;
+}
+
+/**
+ * Returns whether no document can have keys within more than one of the intervals of the bounds of
+ * 'isn', so that the counts of the intervals add up to the count of the bounds. Each COUNT_SCAN
+ * deduplicates its own keys, but keys of the same document in different intervals are only
+ * possible if a field with several intervals has a multikey component.
+ */
+bool intervalsHoldDistinctDocuments(const IndexScanNode& isn) {
+    if (!isn.index.multikey) {
+        return true;
+    }
+    if (isn.index.multikeyPaths.empty()) {
+        // Without path-level multikey metadata, any field may be multikey.
+        return false;
+    }
+    for (size_t fieldNo = 0; fieldNo < isn.bounds.fields.size(); ++fieldNo) {
+        if (isn.bounds.fields[fieldNo].intervals.size() > 1 &&
+            !isn.index.multikeyPaths[fieldNo].empty()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 /**
@@ -1733,54 +1895,35 @@ bool turnIxscanIntoCount(QuerySolution* soln) {
 
     if (!IndexBoundsBuilder::isSingleInterval(
             isn->bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
-        // If we have exactly one null interval, we should split the bounds and try to construct
-        // two COUNT_SCAN stages joined by an OR stage. If we had multiple null intervals, we would
-        // need 2^N count scans for N intervals, meaning this would quickly explode to a
-        // point where it would just be more efficient to use a single index scan. Consequently, we
-        // draw the line at one null interval.
-        if (auto nullFieldNo = boundsHasExactlyOneNullInterval(isn->bounds)) {
-            OrderedIntervalList undefinedPointOil, nullPointOil;
-            undefinedPointOil.intervals.push_back(IndexBoundsBuilder::kUndefinedPointInterval);
-            nullPointOil.intervals.push_back(IndexBoundsBuilder::kNullPointInterval);
-
-            tassert(5506501,
-                    "The index of the null interval is invalid",
-                    *nullFieldNo < isn->bounds.fields.size());
-            auto makeNullBoundsCountScan =
-                [&](OrderedIntervalList& oil) -> std::unique_ptr<QuerySolutionNode> {
-                std::swap(isn->bounds.fields[*nullFieldNo], oil);
-                ON_BLOCK_EXIT([&] { std::swap(isn->bounds.fields[*nullFieldNo], oil); });
-
-                BSONObj startKey, endKey;
-                bool startKeyInclusive, endKeyInclusive;
-                if (IndexBoundsBuilder::isSingleInterval(
-                        isn->bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
-                    return makeCountScan(startKey, startKeyInclusive, endKey, endKeyInclusive);
-                }
-
-                return nullptr;
-            };
-
-            auto undefinedCsn = makeNullBoundsCountScan(undefinedPointOil);
-
-            if (undefinedCsn) {
-                // If undefinedCsn is non-null, then we should also be able to successfully generate
-                // a count scan for the null interval case.
-                auto nullCsn = makeNullBoundsCountScan(nullPointOil);
-                tassert(5506500, "Invalid null bounds COUNT_SCAN", nullCsn);
-
-                auto csns = makeVector(std::move(undefinedCsn), std::move(nullCsn));
-
-                // Note that there is no need to deduplicate here because this optimization cannot
-                // be applied to multikey indexes.
-                auto orn = std::make_unique<OrNode>();
-                orn->addChildren(std::move(csns));
-                soln->setRoot(std::move(orn));
+        // The bounds may still be a union of single intervals, such as those of an $in or of a
+        // null equality, each of which can be counted by a COUNT_SCAN of its own. The number of
+        // intervals is the product of the number of intervals of each field, so it is bounded in
+        // the same way as the number of index scans of an exploded sort.
+        if (!intervalsHoldDistinctDocuments(*isn)) {
+            return false;
+        }
+        auto explodedBounds = explodeBoundsIntoIntervals(
+            isn->bounds, static_cast<size_t>(internalQueryMaxScansToExplode.load()));
+        if (!explodedBounds) {
+            return false;
+        }
 
-                return true;
+        std::vector<std::unique_ptr<QuerySolutionNode>> csns;
+        for (auto&& bounds : *explodedBounds) {
+            if (!IndexBoundsBuilder::isSingleInterval(
+                    bounds, &startKey, &startKeyInclusive, &endKey, &endKeyInclusive)) {
+                return false;
             }
+            csns.push_back(makeCountScan(startKey, startKeyInclusive, endKey, endKeyInclusive));
         }
-        return false;
+
+        // The intervals are disjoint and hold distinct documents, so there is nothing to
+        // deduplicate.
+        auto orn = std::make_unique<OrNode>();
+        orn->dedup = false;
+        orn->addChildren(std::move(csns));
+        soln->setRoot(std::move(orn));
+        return true;
     }
 
     // Make the count node that we replace the fetch + ixscan with.
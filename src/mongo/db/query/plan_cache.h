@@ -471,11 +471,16 @@ public:
     static bool shouldCacheQuery(const CanonicalQuery& query);
 
     /**
-     * If omitted, namespace set to empty string.
+     * Sizes the cache and splits it into partitions according to the
+     * 'internalQueryCacheMaxEntriesPerCollection' and 'internalQueryCacheNumPartitions' knobs.
      */
     PlanCache();
 
-    PlanCache(size_t size);
+    /**
+     * Creates a cache holding at most 'size' entries, split into 'numPartitions' partitions which
+     * each evict their least recently used entries on their own.
+     */
+    PlanCache(size_t size, size_t numPartitions = 1);
 
     ~PlanCache();
 
@@ -587,7 +592,31 @@ public:
         const std::function<BSONObj(const PlanCacheEntry&)>& serializationFunc,
         const std::function<bool(const BSONObj&)>& filterFunc) const;
 
+    /**
+     * Returns one document for each partition of the cache, holding its number of entries and
+     * the number of cache hits, cache misses and evictions it has seen.
+     */
+    std::vector<BSONObj> getPartitionStats() const;
+
 private:
+    /**
+     * A slice of the cache holding the entries whose keys hash to it. Every operation that looks
+     * up a single key locks only the partition of that key.
+     */
+    struct Partition {
+        explicit Partition(size_t size) : cache(size) {}
+
+        LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> cache;
+
+        // Protects 'cache'.
+        Mutex mutex = MONGO_MAKE_LATCH("PlanCache::Partition::mutex");
+
+        // Outcomes of get() for keys of this partition, and entries evicted to make room in it.
+        AtomicWord<long long> hits;
+        AtomicWord<long long> misses;
+        AtomicWord<long long> evictions;
+    };
+
     struct NewEntryState {
         bool shouldBeCreated = false;
         bool shouldBeActive = false;
@@ -600,10 +629,9 @@ private:
                                    size_t newWorks,
                                    double growthCoefficient);
 
-    LRUKeyValue<PlanCacheKey, PlanCacheEntry, PlanCacheKeyHasher> _cache;
+    Partition& _getPartition(const PlanCacheKey& key) const;
 
-    // Protects _cache.
-    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("PlanCache::_cacheMutex");
+    std::vector<std::unique_ptr<Partition>> _partitions;
 
     // Holds computed information about the collection's indexes.  Used for generating plan
     // cache keys.
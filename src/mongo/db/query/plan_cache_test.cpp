@@ -2371,6 +2371,67 @@ TEST(PlanCacheTest, PlanCacheSizeWithCRUDOperations) {
     ASSERT_EQ(PlanCacheEntry::planCacheTotalSizeEstimateBytes.get(), originalSize);
 }
 
+TEST(PlanCacheTest, PartitionedPlanCacheKeepsEntriesOfEveryPartition) {
+    const size_t kCacheSize = 64;
+    const size_t kNumPartitions = 4;
+    PlanCache planCache(kCacheSize, kNumPartitions);
+    QueryTestServiceContext serviceContext;
+
+    std::vector<unique_ptr<CanonicalQuery>> queries;
+    for (char field = 'a'; field <= 'p'; ++field) {
+        queries.push_back(canonicalize(std::string(str::stream() << "{" << field << ": 1}")));
+        ASSERT_EQ(planCache.get(*queries.back()).state,
+                  PlanCache::CacheEntryState::kNotPresent);
+        addCacheEntryForShape(*queries.back(), &planCache);
+    }
+    ASSERT_EQ(planCache.size(), queries.size());
+    ASSERT_EQ(planCache.getAllEntries().size(), queries.size());
+    for (auto&& cq : queries) {
+        ASSERT_EQ(planCache.get(*cq).state, PlanCache::CacheEntryState::kPresentInactive);
+    }
+
+    // Every lookup above was counted by the partition of its key.
+    auto stats = planCache.getPartitionStats();
+    ASSERT_EQ(stats.size(), kNumPartitions);
+    long long numEntries = 0, hits = 0, misses = 0, evictions = 0;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        ASSERT_EQ(stats[i]["partition"].numberLong(), static_cast<long long>(i));
+        numEntries += stats[i]["numEntries"].numberLong();
+        hits += stats[i]["hits"].numberLong();
+        misses += stats[i]["misses"].numberLong();
+        evictions += stats[i]["evictions"].numberLong();
+    }
+    ASSERT_EQ(numEntries, static_cast<long long>(queries.size()));
+    ASSERT_EQ(hits, static_cast<long long>(queries.size()));
+    ASSERT_EQ(misses, static_cast<long long>(queries.size()));
+    ASSERT_EQ(evictions, 0);
+
+    ASSERT_OK(planCache.remove(*queries.front()));
+    ASSERT_EQ(planCache.get(*queries.front()).state, PlanCache::CacheEntryState::kNotPresent);
+    planCache.clear();
+    ASSERT_EQ(planCache.size(), 0U);
+}
+
+TEST(PlanCacheTest, PartitionedPlanCacheCountsEvictions) {
+    // Each of the two partitions holds a single entry.
+    PlanCache planCache(2, 2);
+    QueryTestServiceContext serviceContext;
+
+    for (char field = 'a'; field <= 'h'; ++field) {
+        unique_ptr<CanonicalQuery> cq(
+            canonicalize(std::string(str::stream() << "{" << field << ": 1}")));
+        addCacheEntryForShape(*cq, &planCache);
+    }
+    ASSERT_LTE(planCache.size(), 2U);
+
+    long long evictions = 0;
+    for (auto&& stats : planCache.getPartitionStats()) {
+        ASSERT_LTE(stats["numEntries"].numberLong(), 1);
+        evictions += stats["evictions"].numberLong();
+    }
+    ASSERT_EQ(evictions, 8 - static_cast<long long>(planCache.size()));
+}
+
 TEST(PlanCacheTest, PlanCacheSizeWithEviction) {
     const size_t kCacheSize = 5;
     PlanCache planCache(kCacheSize);
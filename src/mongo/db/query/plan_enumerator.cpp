@@ -260,6 +260,7 @@ PlanEnumerator::PlanEnumerator(const PlanEnumeratorParams& params)
       _indices(params.indices),
       _ixisect(params.intersect),
       _enumerateOrChildrenLockstep(params.enumerateOrChildrenLockstep),
+      _skipScan(params.skipScan),
       _orLimit(params.maxSolutionsPerOr),
       _intersectLimit(params.maxIntersectPerAnd) {}
 
@@ -1018,6 +1019,36 @@ void PlanEnumerator::enumerateOneIndex(
             andAssignment->choices.push_back(std::move(state));
         }
     }
+
+    if (!_skipScan) {
+        return;
+    }
+
+    // For each btree index with predicates only over its non-leading fields, output a skip scan
+    // assignment. The planner fills in all-values bounds for the leading fields, and the index
+    // scan then seeks to the bounds of the constrained fields beneath each distinct prefix of the
+    // leading ones. Multikey indexes are left out, since without a predicate over the leading
+    // field there is no assignment to check the compounding rules against.
+    for (auto it = idxToNotFirst.begin(); it != idxToNotFirst.end(); ++it) {
+        const IndexEntry& thisIndex = (*_indices)[it->first];
+        if (idxToFirst.find(it->first) != idxToFirst.end() ||
+            thisIndex.type != IndexType::INDEX_BTREE || thisIndex.multikey) {
+            continue;
+        }
+
+        OneIndexAssignment indexAssign;
+        indexAssign.index = it->first;
+        for (auto pred : it->second) {
+            assignPredicate(outsidePreds, pred, getPosition(thisIndex, pred), &indexAssign);
+        }
+
+        // Do not output this assignment if it consists only of outside predicates.
+        if (!indexAssign.preds.empty()) {
+            AndEnumerableState state;
+            state.assignments.push_back(std::move(indexAssign));
+            andAssignment->choices.push_back(std::move(state));
+        }
+    }
 }
 
 void PlanEnumerator::enumerateAndIntersect(const IndexToPredMap& idxToFirst,
@@ -54,6 +54,10 @@ struct PlanEnumeratorParams {
     // same assignment on each branch?
     bool enumerateOrChildrenLockstep = false;
 
+    // Do we output assignments to compound btree indexes which have no predicate over their
+    // leading field (skip scans)?
+    bool skipScan = false;
+
     // Not owned here.
     MatchExpression* root;
 
@@ -589,6 +593,9 @@ private:
     // same assignment on each branch?
     bool _enumerateOrChildrenLockstep;
 
+    // Do we output assignments which leave the leading field of a btree index unconstrained?
+    bool _skipScan;
+
     // How many enumerations are we willing to produce from each OR?
     size_t _orLimit;
 
@@ -235,6 +235,10 @@ void statsToBSON(const PlanStageStats& stats,
     if (STAGE_AND_HASH == stats.stageType) {
         AndHashStats* spec = static_cast<AndHashStats*>(stats.specific.get());
 
+        if (spec->recordIdOnly) {
+            bob->appendBool("recordIdOnly", true);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("memUsage", static_cast<long long>(spec->memUsage));
             bob->appendNumber("memLimit", static_cast<long long>(spec->memLimit));
@@ -247,6 +251,10 @@ void statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_AND_SORTED == stats.stageType) {
         AndSortedStats* spec = static_cast<AndSortedStats*>(stats.specific.get());
 
+        if (spec->recordIdOnly) {
+            bob->appendBool("recordIdOnly", true);
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             for (size_t i = 0; i < spec->failedAnd.size(); ++i) {
                 bob->appendNumber(std::string(str::stream() << "failedAnd_" << i),
@@ -478,8 +486,15 @@ void statsToBSON(const PlanStageStats& stats,
     } else if (STAGE_TEXT_OR == stats.stageType) {
         TextOrStats* spec = static_cast<TextOrStats*>(stats.specific.get());
 
+        if (spec->limit > 0) {
+            bob->appendNumber("limitAmount", static_cast<long long>(spec->limit));
+        }
+
         if (verbosity >= ExplainOptions::Verbosity::kExecStats) {
             bob->appendNumber("docsExamined", static_cast<long long>(spec->fetches));
+            if (spec->limit > 0) {
+                bob->appendBool("earlyTermination", spec->earlyTermination);
+            }
         }
     } else if (STAGE_UNPACK_TIMESERIES_BUCKET == stats.stageType) {
         UnpackTimeseriesBucketStats* spec =
@@ -45,6 +45,7 @@
 #include "mongo/db/matcher/expression_array.h"
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_text.h"
+#include "mongo/db/query/collation/collation_index_key.h"
 #include "mongo/db/query/index_bounds_builder.h"
 #include "mongo/db/query/index_tag.h"
 #include "mongo/db/query/indexability.h"
@@ -213,9 +214,13 @@ bool isOplogTsLowerBoundPred(const mongo::MatchExpression* me) {
 /**
  * Helper function to add an RID range to collection scans.
  * If the query solution tree contains a collection scan node with a suitable comparison
- * predicate on '_id', we add a minRecord and maxRecord on the collection node.
+ * predicate on '_id', we add a minRecord and maxRecord on the collection node. Since RecordIds
+ * order _id values without collation, a predicate whose value is affected by the query's
+ * 'collator' does not bound the scan.
  */
-void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* collScan) {
+void handleRIDRangeScan(const MatchExpression* conjunct,
+                        CollectionScanNode* collScan,
+                        const CollatorInterface* collator) {
     if (conjunct == nullptr) {
         return;
     }
@@ -223,7 +228,7 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
     auto* andMatchPtr = dynamic_cast<const AndMatchExpression*>(conjunct);
     if (andMatchPtr != nullptr) {
         for (size_t index = 0; index < andMatchPtr->numChildren(); index++) {
-            handleRIDRangeScan(andMatchPtr->getChild(index), collScan);
+            handleRIDRangeScan(andMatchPtr->getChild(index), collScan, collator);
         }
         return;
     }
@@ -232,6 +237,12 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
         return;
     }
 
+    if (collator && ComparisonMatchExpression::isComparisonMatchExpression(conjunct) &&
+        CollationIndexKey::isCollatableType(
+            static_cast<const ComparisonMatchExpression*>(conjunct)->getData().type())) {
+        return;
+    }
+
     const bool hasMaxRecord = collScan->maxRecord.has_value();
     const bool hasMinRecord = collScan->minRecord.has_value();
 
@@ -260,6 +271,44 @@ void handleRIDRangeScan(const MatchExpression* conjunct, CollectionScanNode* col
     }
 }
 
+/**
+ * Returns true if 'expr' can be evaluated as a filter against the keys of 'index'. This is always
+ * safe for a non-multikey index. For a multikey index it is safe only if path-level multikey
+ * metadata shows that every path read by 'expr' is an indexed field without array components:
+ * then each of a document's keys carries the same value for those paths, and the filter either
+ * accepts all of them or none.
+ */
+bool canApplyFilterToIndexKeys(const MatchExpression* expr, const IndexEntry& index) {
+    if (!index.multikey) {
+        return true;
+    }
+    if (index.multikeyPaths.empty() || index.type == INDEX_WILDCARD) {
+        return false;
+    }
+
+    switch (expr->getCategory()) {
+        case MatchExpression::MatchCategory::kLogical:
+            for (size_t i = 0; i < expr->numChildren(); ++i) {
+                if (!canApplyFilterToIndexKeys(expr->getChild(i), index)) {
+                    return false;
+                }
+            }
+            return true;
+        case MatchExpression::MatchCategory::kLeaf: {
+            size_t keyPatternFieldIndex = 0;
+            for (auto&& elt : index.keyPattern) {
+                if (elt.fieldNameStringData() == expr->path()) {
+                    return index.multikeyPaths[keyPatternFieldIndex].empty();
+                }
+                ++keyPatternFieldIndex;
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
 }  // namespace
 
 std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
@@ -342,7 +391,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::makeCollectionScan(
     }
 
     if (params.allowRIDRange && !csn->resumeAfterRecordId) {
-        handleRIDRangeScan(csn->filter.get(), csn.get());
+        handleRIDRangeScan(csn->filter.get(), csn.get(), query.getCollator());
     }
 
     return csn;
@@ -799,7 +848,7 @@ bool QueryPlannerAccess::orNeedsFetch(const ScanBuildingState* scanState) {
     } else {
         invariant(scanState->loosestBounds == IndexBoundsBuilder::INEXACT_COVERED);
         const IndexEntry& index = scanState->indices[scanState->currentIndexNumber];
-        return index.multikey;
+        return !canApplyFilterToIndexKeys(scanState->curOr.get(), index);
     }
 }
 
@@ -1542,7 +1591,7 @@ std::unique_ptr<QuerySolutionNode> QueryPlannerAccess::_buildIndexedDataAccess(
                 isCoveredNullQuery(query, root, tag, indices, params)) {
                 return soln;
             } else if (tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-                       !indices[tag->index].multikey) {
+                       canApplyFilterToIndexKeys(root, indices[tag->index])) {
                 verify(nullptr == soln->filter.get());
                 soln->filter = std::move(ownedRoot);
                 return soln;
@@ -1691,18 +1740,20 @@ void QueryPlannerAccess::handleFilterAnd(ScanBuildingState* scanState) {
         // we know that we don't need it to create a FETCH stage.
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
     } else if (scanState->tightness == IndexBoundsBuilder::INEXACT_COVERED &&
-               (INDEX_TEXT == index.type || !index.multikey)) {
+               (INDEX_TEXT == index.type ||
+                canApplyFilterToIndexKeys(root->getChild(scanState->curChild), index))) {
         // The bounds are not exact, but the information needed to
         // evaluate the predicate is in the index key. Remove the
         // MatchExpression from its parent and attach it to the filter
         // of the index scan we're building.
         //
-        // We can only use this optimization if the index is NOT multikey.
+        // We can only use this optimization if the predicate's path is NOT multikey.
         // Suppose that we had the multikey index {x: 1} and a document
         // {x: ["a", "b"]}. Now if we query for {x: /b/} the filter might
         // ever only be applied to the index key "a". We'd incorrectly
         // conclude that the document does not match the query :( so we
-        // gotta stick to non-multikey indices.
+        // gotta stick to paths that path-level multikey metadata shows
+        // hold no arrays.
         auto child = std::move((*root->getChildVector())[scanState->curChild]);
         root->getChildVector()->erase(root->getChildVector()->begin() + scanState->curChild);
 
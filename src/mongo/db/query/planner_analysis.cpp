@@ -31,11 +31,13 @@
 
 #include "mongo/db/query/planner_analysis.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
 #include "mongo/bson/simple_bsonelement_comparator.h"
 #include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/index/expression_params.h"
 #include "mongo/db/index/s2_common.h"
 #include "mongo/db/jsobj.h"
@@ -561,6 +563,57 @@ bool canUseSimpleSort(const QuerySolutionNode& solnRoot,
         && !splitLimitedSortEligible;
 }
 
+/**
+ * Marks the index intersections in the tree rooted at 'node' which are fetched right away as
+ * needing only the RecordIds of their children's results. The fetch replaces the merged index keys
+ * with the document, so the intersection can skip merging and buffering them.
+ */
+void markRecordIdOnlyIntersections(QuerySolutionNode* node) {
+    for (auto&& child : node->children) {
+        const bool allChildrenAreIndexScans =
+            std::all_of(child->children.begin(), child->children.end(), [](auto&& grandchild) {
+                return grandchild->getType() == STAGE_IXSCAN;
+            });
+        if (node->getType() == STAGE_FETCH && allChildrenAreIndexScans) {
+            if (child->getType() == STAGE_AND_HASH) {
+                static_cast<AndHashNode*>(child)->recordIdOnly = true;
+            } else if (child->getType() == STAGE_AND_SORTED) {
+                static_cast<AndSortedNode*>(child)->recordIdOnly = true;
+            }
+        }
+        markRecordIdOnlyIntersections(child);
+    }
+}
+
+/**
+ * If 'sortNode' sorts the results of a text search by text score alone and keeps only its first
+ * 'limit' results, lets the TEXT_OR below it compute just those top scoring documents. This is only
+ * possible when the TEXT_MATCH between them passes every document the TEXT_OR returns, that is,
+ * when the text query has no negations or phrases and is neither case nor diacritic sensitive.
+ */
+void pushLimitIntoTextOr(SortNode* sortNode) {
+    if (sortNode->limit == 0 || sortNode->pattern.nFields() != 1 ||
+        !query_request_helper::isTextScoreMeta(sortNode->pattern.firstElement())) {
+        return;
+    }
+
+    auto child = sortNode->children[0];
+    if (child->getType() != STAGE_TEXT_MATCH || child->filter || child->children.size() != 1 ||
+        child->children[0]->getType() != STAGE_TEXT_OR) {
+        return;
+    }
+
+    auto textMatch = static_cast<TextMatchNode*>(child);
+    auto ftsQuery = dynamic_cast<const fts::FTSQueryImpl*>(textMatch->ftsQuery.get());
+    if (!ftsQuery || ftsQuery->getCaseSensitive() || ftsQuery->getDiacriticSensitive() ||
+        !ftsQuery->getNegatedTerms().empty() || !ftsQuery->getPositivePhr().empty() ||
+        !ftsQuery->getNegatedPhr().empty()) {
+        return;
+    }
+
+    static_cast<TextOrNode*>(textMatch->children[0])->limit = sortNode->limit;
+}
+
 }  // namespace
 
 // static
@@ -904,6 +957,8 @@ QuerySolutionNode* QueryPlannerAnalysis::analyzeSort(const CanonicalQuery& query
         sortNodeRaw->limit = 0;
     }
 
+    pushLimitIntoTextOr(sortNodeRaw);
+
     *blockingSortOut = true;
 
     return solnRoot;
@@ -1030,6 +1085,8 @@ std::unique_ptr<QuerySolution> QueryPlannerAnalysis::analyzeDataAccess(
 
     solnRoot = tryPushdownProjectBeneathSort(std::move(solnRoot));
 
+    markRecordIdOnlyIntersections(solnRoot.get());
+
     soln->setRoot(std::move(solnRoot));
     return soln;
 }
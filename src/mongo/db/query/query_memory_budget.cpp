@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_memory_budget.h"
+
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/util/static_immortal.h"
+
+namespace mongo {
+
+QueryMemoryBudget& QueryMemoryBudget::get() {
+    static StaticImmortal<QueryMemoryBudget> budget;
+    return *budget;
+}
+
+int64_t QueryMemoryBudget::getBytesForOperation(OperationId opId) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _bytesByOperation.find(opId);
+    return it == _bytesByOperation.end() ? 0 : it->second;
+}
+
+bool QueryMemoryBudget::isExhausted() const {
+    const auto maxBytes = internalQueryMaxTotalBlockingMemoryUsageBytes.load();
+    return maxBytes > 0 && _totalBytes.load() > maxBytes;
+}
+
+void QueryMemoryBudget::_charge(boost::optional<OperationId> oldOpId,
+                                int64_t oldBytes,
+                                boost::optional<OperationId> newOpId,
+                                int64_t newBytes) {
+    _totalBytes.fetchAndAdd(newBytes - oldBytes);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto addBytes = [&](OperationId opId, int64_t bytes) {
+        auto& opBytes = _bytesByOperation[opId];
+        opBytes += bytes;
+        if (opBytes == 0) {
+            _bytesByOperation.erase(opId);
+        }
+    };
+    if (oldOpId && oldBytes) {
+        addBytes(*oldOpId, -oldBytes);
+    }
+    if (newOpId && newBytes) {
+        addBytes(*newOpId, newBytes);
+    }
+}
+
+QueryMemoryBudget::Reservation::Reservation(QueryMemoryBudget* budget) : _budget(budget) {}
+
+QueryMemoryBudget::Reservation::~Reservation() {
+    if (_charged) {
+        _budget->_charge(_opId, _charged, _opId, 0);
+    }
+}
+
+bool QueryMemoryBudget::Reservation::set(int64_t bytes) {
+    invariant(bytes >= 0);
+    _bytes = bytes;
+
+    boost::optional<OperationId> opId = _opId;
+    if (haveClient()) {
+        if (auto opCtx = cc().getOperationContext()) {
+            opId = opCtx->getOpID();
+        }
+    }
+
+    // Charge whole multiples of the granularity, and only give one back once the stage holds at
+    // least a multiple less, so that a stage hovering around a multiple does not update the budget
+    // all the time.
+    int64_t charged = _charged;
+    if (bytes > _charged || bytes + 2 * kGranularityBytes <= _charged || bytes == 0) {
+        charged = (bytes + kGranularityBytes - 1) / kGranularityBytes * kGranularityBytes;
+    }
+
+    if (charged != _charged || opId != _opId) {
+        _budget->_charge(_opId, _charged, opId, charged);
+        _charged = charged;
+        _opId = opId;
+    }
+
+    _exhausted = _budget->isExhausted();
+    return _exhausted;
+}
+
+}  // namespace mongo
@@ -0,0 +1,152 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+
+#include "mongo/db/operation_id.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * Process-wide accounting of the memory held by the blocking stages of query execution, such as
+ * sorts and groups. Each stage bounds its own memory usage, but nothing else bounds the total when
+ * several large queries run at once. Stages report the memory they hold through a Reservation, and
+ * once the total exceeds 'internalQueryMaxTotalBlockingMemoryUsageBytes', the stages which are
+ * allowed to spill to disk do so before reaching their own limit.
+ *
+ * The memory held is also accounted to the operation running each stage, which currentOp reports.
+ */
+class QueryMemoryBudget {
+    QueryMemoryBudget(const QueryMemoryBudget&) = delete;
+    QueryMemoryBudget& operator=(const QueryMemoryBudget&) = delete;
+
+public:
+    /**
+     * Reservations are charged to the budget in multiples of this many bytes, so that the shared
+     * counters are only updated once the memory held by a stage has changed by about as much.
+     */
+    static constexpr int64_t kGranularityBytes = 1024 * 1024;
+
+    /**
+     * A stage only spills early once it holds this fraction of its own limit, so that an exhausted
+     * budget does not make it spill in many small runs.
+     */
+    static constexpr int64_t kEarlySpillDivisor = 4;
+
+    /**
+     * The memory held by one stage. Updated only by the thread executing the stage, and released
+     * on destruction.
+     */
+    class Reservation {
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+    public:
+        explicit Reservation(QueryMemoryBudget* budget = &QueryMemoryBudget::get());
+        ~Reservation();
+
+        /**
+         * Sets the memory held by the stage to 'bytes', accounted to the operation running on the
+         * current thread, if any. Returns whether the budget is exhausted.
+         */
+        bool set(int64_t bytes);
+
+        bool add(int64_t bytes) {
+            return set(_bytes + bytes);
+        }
+
+        int64_t getBytes() const {
+            return _bytes;
+        }
+
+        /**
+         * Returns whether a stage which may spill to disk, and whose own limit is 'maxBytes',
+         * should spill now to give memory back to the budget.
+         */
+        bool shouldSpillEarly(int64_t maxBytes) const {
+            return _exhausted && _bytes > 0 && _bytes >= maxBytes / kEarlySpillDivisor;
+        }
+
+    private:
+        QueryMemoryBudget* const _budget;
+
+        // The memory held by the stage.
+        int64_t _bytes = 0;
+
+        // The memory charged to the budget, a multiple of kGranularityBytes.
+        int64_t _charged = 0;
+
+        // The operation '_charged' is accounted to.
+        boost::optional<OperationId> _opId;
+
+        // Whether the budget was exhausted when '_bytes' was last set.
+        bool _exhausted = false;
+    };
+
+    QueryMemoryBudget() = default;
+
+    static QueryMemoryBudget& get();
+
+    /**
+     * Returns the memory held by all the stages, in multiples of kGranularityBytes.
+     */
+    int64_t getTotalBytes() const {
+        return _totalBytes.load();
+    }
+
+    /**
+     * Returns the memory held by the stages run by operation 'opId'.
+     */
+    int64_t getBytesForOperation(OperationId opId) const;
+
+    /**
+     * Returns whether the memory held by all the stages exceeds the budget.
+     */
+    bool isExhausted() const;
+
+private:
+    void _charge(boost::optional<OperationId> oldOpId,
+                 int64_t oldBytes,
+                 boost::optional<OperationId> newOpId,
+                 int64_t newBytes);
+
+    AtomicWord<long long> _totalBytes{0};
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryMemoryBudget::_mutex");
+    stdx::unordered_map<OperationId, int64_t> _bytesByOperation;
+};
+
+}  // namespace mongo
@@ -0,0 +1,128 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/query_memory_budget.h"
+
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+constexpr int64_t kMB = QueryMemoryBudget::kGranularityBytes;
+
+class QueryMemoryBudgetTest : public ServiceContextTest {
+protected:
+    QueryMemoryBudget budget;
+};
+
+TEST_F(QueryMemoryBudgetTest, ReservationsAreChargedInWholeMultiplesOfTheGranularity) {
+    {
+        QueryMemoryBudget::Reservation first(&budget);
+        QueryMemoryBudget::Reservation second(&budget);
+
+        first.set(1);
+        ASSERT_EQ(first.getBytes(), 1);
+        ASSERT_EQ(budget.getTotalBytes(), kMB);
+
+        second.set(kMB + 1);
+        ASSERT_EQ(budget.getTotalBytes(), 3 * kMB);
+
+        // Small decreases are not given back to the budget.
+        second.set(kMB / 2);
+        ASSERT_EQ(budget.getTotalBytes(), 3 * kMB);
+
+        second.add(-kMB / 2);
+        ASSERT_EQ(second.getBytes(), 0);
+        ASSERT_EQ(budget.getTotalBytes(), kMB);
+
+        second.set(5 * kMB);
+        ASSERT_EQ(budget.getTotalBytes(), 6 * kMB);
+        second.set(kMB);
+        ASSERT_EQ(budget.getTotalBytes(), 2 * kMB);
+    }
+    ASSERT_EQ(budget.getTotalBytes(), 0);
+}
+
+TEST_F(QueryMemoryBudgetTest, ReservationsAreAccountedToTheCurrentOperation) {
+    QueryMemoryBudget::Reservation reservation(&budget);
+    OperationId firstOpId;
+    {
+        auto opCtx = makeOperationContext();
+        firstOpId = opCtx->getOpID();
+        reservation.set(2 * kMB);
+        ASSERT_EQ(budget.getBytesForOperation(firstOpId), 2 * kMB);
+    }
+
+    // A stage which is resumed by another operation, like a getMore, moves over to it.
+    auto opCtx = makeOperationContext();
+    reservation.set(3 * kMB);
+    ASSERT_EQ(budget.getBytesForOperation(firstOpId), 0);
+    ASSERT_EQ(budget.getBytesForOperation(opCtx->getOpID()), 3 * kMB);
+
+    reservation.set(0);
+    ASSERT_EQ(budget.getBytesForOperation(opCtx->getOpID()), 0);
+}
+
+TEST_F(QueryMemoryBudgetTest, StagesSpillEarlyOnlyOnceTheBudgetIsExhausted) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryMaxTotalBlockingMemoryUsageBytes",
+                                                  static_cast<long long>(4 * kMB));
+    QueryMemoryBudget::Reservation first(&budget);
+    QueryMemoryBudget::Reservation second(&budget);
+    const int64_t stageMaxBytes = 8 * kMB;
+
+    ASSERT_FALSE(first.set(3 * kMB));
+    ASSERT_FALSE(first.shouldSpillEarly(stageMaxBytes));
+
+    ASSERT_TRUE(second.set(kMB + 1));
+    ASSERT_TRUE(budget.isExhausted());
+
+    // Only the stage holding a good part of its own limit spills.
+    ASSERT_FALSE(second.shouldSpillEarly(stageMaxBytes));
+    ASSERT_TRUE(first.set(3 * kMB));
+    ASSERT_TRUE(first.shouldSpillEarly(stageMaxBytes));
+
+    ASSERT_FALSE(first.set(0));
+    ASSERT_FALSE(budget.isExhausted());
+}
+
+TEST_F(QueryMemoryBudgetTest, BudgetIsNeverExhaustedWithoutALimit) {
+    RAIIServerParameterControllerForTest maxBytes("internalQueryMaxTotalBlockingMemoryUsageBytes",
+                                                  0LL);
+    QueryMemoryBudget::Reservation reservation(&budget);
+    ASSERT_FALSE(reservation.set(1024 * kMB));
+    ASSERT_FALSE(reservation.shouldSpillEarly(kMB));
+}
+
+}  // namespace
+}  // namespace mongo
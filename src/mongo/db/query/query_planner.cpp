@@ -185,6 +185,9 @@ string optionString(size_t options) {
             case QueryPlannerParams::RETURN_OWNED_DATA:
                 ss << "RETURN_OWNED_DATA ";
                 break;
+            case QueryPlannerParams::INDEX_SKIP_SCAN:
+                ss << "INDEX_SKIP_SCAN ";
+                break;
             case QueryPlannerParams::DEFAULT:
                 MONGO_UNREACHABLE;
                 break;
@@ -703,7 +706,8 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
     std::vector<IndexEntry> relevantIndices;
 
     if (!hintedIndexEntry) {
-        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(fields, fullIndexList);
+        relevantIndices = QueryPlannerIXSelect::findRelevantIndices(
+            fields, fullIndexList, params.options & QueryPlannerParams::INDEX_SKIP_SCAN);
     } else {
         relevantIndices = fullIndexList;
 
@@ -868,6 +872,7 @@ StatusWith<std::vector<std::unique_ptr<QuerySolution>>> QueryPlanner::plan(
         enumParams.indices = &relevantIndices;
         enumParams.enumerateOrChildrenLockstep =
             params.options & QueryPlannerParams::ENUMERATE_OR_CHILDREN_LOCKSTEP;
+        enumParams.skipScan = params.options & QueryPlannerParams::INDEX_SKIP_SCAN;
 
         PlanEnumerator planEnumerator(enumParams);
         uassertStatusOKWithContext(planEnumerator.init(), "failed to initialize plan enumerator");
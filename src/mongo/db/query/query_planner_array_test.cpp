@@ -1452,6 +1452,58 @@ TEST_F(QueryPlannerTest, CanCoverNonMultikeyDottedField) {
         "bounds: {'a.y':[[1,1,true,true]],'b.z':[[2,2,true,true]]}}}}}");
 }
 
+TEST_F(QueryPlannerTest, CanCoverInexactPredicateOnNonArrayFieldWithPathLevelMultikeyInfo) {
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: /foo/, b: 2}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {ixscan: {pattern: {a: 1, b: 1},"
+        "filter: {a: /foo/}, bounds: {a: [['', {}, true, false], [/foo/, /foo/, true, true]],"
+        "b: [[2,2,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CanCoverInexactOrPredicateOnNonArrayFieldWithPathLevelMultikeyInfo) {
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(fromjson(
+        "{find: 'testns', filter: {$or: [{a: /foo/}, {a: /bar/}]}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {ixscan: {pattern: {a: 1, b: 1},"
+        "filter: {$or: [{a: /foo/}, {a: /bar/}]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CannotCoverInexactPredicateOnArrayFieldWithPathLevelMultikeyInfo) {
+    MultikeyPaths multikeyPaths{{}, {0U}};
+    addIndex(BSON("a" << 1 << "b" << 1), multikeyPaths);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: 1, b: /foo/}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {fetch: {filter: {b: /foo/}, node: {ixscan: "
+        "{pattern: {a: 1, b: 1}, filter: null}}}}}}");
+}
+
+TEST_F(QueryPlannerTest, CannotCoverInexactPredicateWithoutPathLevelMultikeyInfo) {
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+    runQueryAsCommand(
+        fromjson("{find: 'testns', filter: {a: /foo/, b: 2}, projection: {_id: 0, a: 1}}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{proj: {spec: {_id: 0, a: 1}, node: {cscan: {dir: 1}}}}");
+    assertSolutionExists(
+        "{proj: {spec: {_id: 0, a: 1}, node: {fetch: {filter: {a: /foo/}, node: {ixscan: "
+        "{pattern: {a: 1, b: 1}, filter: null}}}}}}");
+}
+
 TEST_F(QueryPlannerTest, ContainedOrElemMatchValue) {
     addIndex(BSON("b" << 1 << "a" << 1));
     addIndex(BSON("c" << 1 << "a" << 1));
@@ -712,6 +712,23 @@ TEST_F(QueryPlannerTest, IntersectBasicTwoPred) {
         "{ixscan: {filter: null, pattern: {b:1}}}]}}}}");
 }
 
+TEST_F(QueryPlannerTest, IntersectOfIndexScansKeepsOnlyRecordIds) {
+    params.options = QueryPlannerParams::NO_TABLE_SCAN | QueryPlannerParams::INDEX_INTERSECTION;
+    addIndex(BSON("a" << 1));
+    addIndex(BSON("b" << 1));
+    runQuery(fromjson("{a: 1, b: {$gt: 1}}"));
+
+    size_t numIntersections = 0;
+    for (auto&& soln : solns) {
+        const auto* root = soln->root();
+        if (root->getType() == STAGE_FETCH && root->children[0]->getType() == STAGE_AND_HASH) {
+            ASSERT_TRUE(static_cast<const AndHashNode*>(root->children[0])->recordIdOnly);
+            ++numIntersections;
+        }
+    }
+    ASSERT_EQ(numIntersections, 1U);
+}
+
 TEST_F(QueryPlannerTest, IntersectBasicTwoPredCompound) {
     params.options = QueryPlannerParams::NO_TABLE_SCAN | QueryPlannerParams::INDEX_INTERSECTION;
     addIndex(BSON("a" << 1 << "c" << 1));
@@ -1504,5 +1521,46 @@ TEST_F(QueryPlannerTest, PlansForWholeIndexScanWithSortAreGenerated) {
         "{proj: {spec: {'b': 1, _id: 0}, node: {fetch: {node: {ixscan: {pattern: {a: 1}}}}}}}");
 }
 
+TEST_F(QueryPlannerTest, SkipScanNotConsideredUnlessEnabled) {
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanOverUnconstrainedLeadingField) {
+    params.options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1 << "c" << 1));
+    runQuery(fromjson("{b: {$gte: 5, $lt: 10}, c: 3}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1, c: 1}, bounds: "
+        "{a: [['MinKey','MaxKey',true,true]], b: [[5,10,true,false]], c: [[3,3,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotOutputWhenLeadingFieldIsConstrained) {
+    params.options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1));
+    runQuery(fromjson("{a: 1, b: 5}"));
+
+    assertNumSolutions(2U);
+    assertSolutionExists("{cscan: {dir: 1}}");
+    assertSolutionExists(
+        "{fetch: {filter: null, node: {ixscan: {pattern: {a: 1, b: 1}, bounds: "
+        "{a: [[1,1,true,true]], b: [[5,5,true,true]]}}}}}");
+}
+
+TEST_F(QueryPlannerTest, SkipScanNotOutputForMultikeyIndex) {
+    params.options |= QueryPlannerParams::INDEX_SKIP_SCAN;
+    addIndex(BSON("a" << 1 << "b" << 1), true);
+    runQuery(fromjson("{b: 5}"));
+
+    assertNumSolutions(1U);
+    assertSolutionExists("{cscan: {dir: 1, filter: {b: 5}}}");
+}
+
 }  // namespace
 }  // namespace mongo
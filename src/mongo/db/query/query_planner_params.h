@@ -130,6 +130,11 @@ struct QueryPlannerParams {
         // Ensure that any plan generated returns data that is "owned." That is, all BSONObjs are
         // in an "owned" state and are not pointing to data that belongs to the storage engine.
         RETURN_OWNED_DATA = 1 << 14,
+
+        // Consider scans of compound btree indexes which have no predicates over their leading
+        // fields. The index scan seeks past each distinct value of the unconstrained prefix to the
+        // bounds of the constrained fields, so it can be cheap when the prefix has few values.
+        INDEX_SKIP_SCAN = 1 << 15,
     };
 
     // See Options enum above.
@@ -528,6 +528,12 @@ StatusWith<BSONObj> asAggregationCommand(const FindCommandRequest& findCommand)
                               << " not supported in aggregation."};
     }
 
+    if (findCommand.getInternalParallelism()) {
+        return {ErrorCodes::InvalidPipelineOperator,
+                str::stream() << "Option " << FindCommandRequest::kInternalParallelismFieldName
+                              << " not supported in aggregation."};
+    }
+
     if (!findCommand.getResumeAfter().isEmpty()) {
         return {ErrorCodes::InvalidPipelineOperator,
                 str::stream() << "Option " << FindCommandRequest::kResumeAfterFieldName
@@ -952,6 +952,28 @@ TEST(QueryRequestTest, ParseFromCommandResumeToken) {
     ASSERT(findCommand->getRequestResumeToken());
 }
 
+TEST(QueryRequestTest, ParseFromCommandInternalParallelism) {
+    BSONObj cmdObj = BSON("find"
+                          << "testns"
+                          << "$_internalParallelism" << 4LL << "$db"
+                          << "test");
+
+    unique_ptr<FindCommandRequest> findCommand(
+        query_request_helper::makeFromFindCommandForTests(cmdObj));
+    ASSERT_EQ(*findCommand->getInternalParallelism(), 4);
+}
+
+TEST(QueryRequestTest, ParseFromCommandZeroInternalParallelismFails) {
+    BSONObj cmdObj = BSON("find"
+                          << "testns"
+                          << "$_internalParallelism" << 0LL << "$db"
+                          << "test");
+
+    ASSERT_THROWS_CODE(query_request_helper::makeFromFindCommandForTests(cmdObj),
+                       DBException,
+                       51024);
+}
+
 TEST(QueryRequestTest, ParseFromCommandEmptyResumeToken) {
     BSONObj resumeAfter = fromjson("{}");
     BSONObj cmdObj =
@@ -1387,6 +1409,12 @@ TEST(QueryRequestTest, ConvertToAggregationWithRequestResumeTokenFails) {
     ASSERT_NOT_OK(query_request_helper::asAggregationCommand(findCommand));
 }
 
+TEST(QueryRequestTest, ConvertToAggregationWithInternalParallelismFails) {
+    FindCommandRequest findCommand(testns);
+    findCommand.setInternalParallelism(4);
+    ASSERT_NOT_OK(query_request_helper::asAggregationCommand(findCommand));
+}
+
 TEST(QueryRequestTest, ConvertToAggregationWithResumeAfterFails) {
     FindCommandRequest findCommand(testns);
     BSONObj resumeAfter = BSON("$recordId" << 1LL);
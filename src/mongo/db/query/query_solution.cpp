@@ -247,6 +247,10 @@ void AndHashNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString() << '\n';
     }
+    if (recordIdOnly) {
+        addIndent(ss, indent + 1);
+        *ss << "recordIdOnly = 1\n";
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -278,6 +282,7 @@ FieldAvailability AndHashNode::getFieldAvailability(const string& field) const {
 QuerySolutionNode* AndHashNode::clone() const {
     AndHashNode* copy = new AndHashNode();
     cloneBaseData(copy);
+    copy->recordIdOnly = this->recordIdOnly;
     return copy;
 }
 
@@ -292,6 +297,10 @@ AndSortedNode::~AndSortedNode() {}
 void AndSortedNode::appendToString(str::stream* ss, int indent) const {
     addIndent(ss, indent);
     *ss << "AND_SORTED\n";
+    if (recordIdOnly) {
+        addIndent(ss, indent + 1);
+        *ss << "recordIdOnly = 1\n";
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -323,6 +332,7 @@ FieldAvailability AndSortedNode::getFieldAvailability(const string& field) const
 QuerySolutionNode* AndSortedNode::clone() const {
     AndSortedNode* copy = new AndSortedNode();
     cloneBaseData(copy);
+    copy->recordIdOnly = this->recordIdOnly;
     return copy;
 }
 
@@ -913,6 +923,7 @@ QuerySolutionNode* IndexScanNode::clone() const {
     copy->addKeyMetadata = this->addKeyMetadata;
     copy->bounds = this->bounds;
     copy->queryCollator = this->queryCollator;
+    copy->parameterizeBounds = this->parameterizeBounds;
 
     return copy;
 }
@@ -1334,6 +1345,39 @@ QuerySolutionNode* EofNode::clone() const {
     return copy;
 }
 
+//
+// GroupNode
+//
+
+void GroupNode::appendToString(str::stream* ss, int indent) const {
+    addIndent(ss, indent);
+    *ss << "GROUP\n";
+    addIndent(ss, indent + 1);
+    *ss << "accumulatedFields = [";
+    for (size_t i = 0; i < accumulators.size(); ++i) {
+        *ss << (i > 0 ? ", " : "") << accumulators[i].fieldName;
+    }
+    *ss << "]" << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "allowDiskUse = " << allowDiskUse << '\n';
+    addIndent(ss, indent + 1);
+    *ss << "maxMemoryUsageBytes = " << maxMemoryUsageBytes << '\n';
+    addCommon(ss, indent);
+    addIndent(ss, indent + 1);
+    *ss << "Child:" << '\n';
+    children[0]->appendToString(ss, indent + 2);
+}
+
+QuerySolutionNode* GroupNode::clone() const {
+    auto copy =
+        std::make_unique<GroupNode>(std::unique_ptr<QuerySolutionNode>(children[0]->clone()),
+                                    groupByExpression,
+                                    accumulators,
+                                    allowDiskUse,
+                                    maxMemoryUsageBytes);
+    return copy.release();
+}
+
 //
 // TextOrNode
 //
@@ -1344,6 +1388,10 @@ void TextOrNode::appendToString(str::stream* ss, int indent) const {
         addIndent(ss, indent + 1);
         *ss << " filter = " << filter->debugString() << '\n';
     }
+    if (limit) {
+        addIndent(ss, indent + 1);
+        *ss << "limit = " << limit << '\n';
+    }
     addCommon(ss, indent);
     for (size_t i = 0; i < children.size(); ++i) {
         addIndent(ss, indent + 1);
@@ -1357,6 +1405,7 @@ QuerySolutionNode* TextOrNode::clone() const {
     auto copy = std::make_unique<TextOrNode>();
     cloneBaseData(copy.get());
     copy->dedup = this->dedup;
+    copy->limit = this->limit;
     return copy.release();
 }
 
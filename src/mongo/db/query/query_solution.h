@@ -36,6 +36,7 @@
 #include "mongo/db/fts/fts_query.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
 #include "mongo/db/query/index_bounds.h"
 #include "mongo/db/query/plan_cache.h"
 #include "mongo/db/query/plan_enumerator_explain_info.h"
@@ -362,6 +363,14 @@ public:
      */
     void setRoot(std::unique_ptr<QuerySolutionNode> root);
 
+    /**
+     * Relinquishes ownership of the QuerySolutionNode tree of this QuerySolution. Typically used to
+     * hang the existing tree off a new root node, which is then installed with setRoot().
+     */
+    std::unique_ptr<QuerySolutionNode> extractRoot() {
+        return std::move(_root);
+    }
+
     /**
      * Returns true if the execution plan which is constructed from this QuerySolution should check
      * that the node is eligible to serve reads prior to actually performing any reads.
@@ -392,6 +401,11 @@ public:
     // Owned here. Used by the plan cache.
     std::unique_ptr<SolutionCacheData> cacheData;
 
+    // The number of keys and documents this solution is estimated to examine from the field
+    // histograms, if it is a candidate of a query which runs to completion. Bounds the trial
+    // period of the multi-planner.
+    boost::optional<double> estimatedWorks;
+
     PlanEnumeratorExplainInfo _enumeratorExplainInfo;
 
 private:
@@ -546,6 +560,10 @@ struct AndHashNode : public QuerySolutionNode {
     }
 
     QuerySolutionNode* clone() const;
+
+    // Whether the stage keeps only the RecordIds of its children's results. Set when the
+    // intersection of index scans is fetched right away, so the merged index keys are not needed.
+    bool recordIdOnly = false;
 };
 
 struct AndSortedNode : public QuerySolutionNodeWithSortSet {
@@ -565,6 +583,10 @@ struct AndSortedNode : public QuerySolutionNodeWithSortSet {
     }
 
     QuerySolutionNode* clone() const;
+
+    // Whether the stage outputs its results without merging in the index keys of the other
+    // children. See AndHashNode::recordIdOnly.
+    bool recordIdOnly = false;
 };
 
 struct OrNode : public QuerySolutionNodeWithSortSet {
@@ -689,6 +711,11 @@ struct IndexScanNode : public QuerySolutionNodeWithSortSet {
 
     const CollatorInterface* queryCollator;
 
+    // If true and the bounds form a single interval, the SBE stage builder keeps the seek keys in
+    // runtime environment slots rather than in the plan itself, so that the plan can later be
+    // rebound to the bounds of another query of the same shape.
+    bool parameterizeBounds = false;
+
     // The set of paths in the index key pattern which have at least one multikey path component, or
     // empty if the index either is not multikey or does not have path-level multikeyness metadata.
     //
@@ -1240,6 +1267,58 @@ struct EofNode : public QuerySolutionNodeWithSortSet {
     QuerySolutionNode* clone() const;
 };
 
+/**
+ * Represents a $group stage which has been pushed down from the aggregation pipeline into the query
+ * layer. Only the SBE stage builder knows how to execute this node, so it must never appear in a
+ * QuerySolution handed to the classic engine.
+ */
+struct GroupNode : public QuerySolutionNodeWithSortSet {
+    GroupNode(std::unique_ptr<QuerySolutionNode> child,
+              boost::intrusive_ptr<Expression> groupByExpression,
+              std::vector<AccumulationStatement> accumulators,
+              bool allowDiskUse,
+              size_t maxMemoryUsageBytes)
+        : QuerySolutionNodeWithSortSet(std::move(child)),
+          groupByExpression(std::move(groupByExpression)),
+          accumulators(std::move(accumulators)),
+          allowDiskUse(allowDiskUse),
+          maxMemoryUsageBytes(maxMemoryUsageBytes) {}
+
+    StageType getType() const override {
+        return STAGE_GROUP;
+    }
+
+    void appendToString(str::stream* ss, int indent) const override;
+
+    /**
+     * The output of a $group is a brand new document, so the input's fetched state, record ids and
+     * sort orders are not preserved.
+     */
+    bool fetched() const {
+        return true;
+    }
+    FieldAvailability getFieldAvailability(const std::string& field) const {
+        return FieldAvailability::kFullyProvided;
+    }
+    bool sortedByDiskLoc() const override {
+        return false;
+    }
+
+    QuerySolutionNode* clone() const override;
+
+    // The expression computing the value of the '_id' field of each group.
+    boost::intrusive_ptr<Expression> groupByExpression;
+
+    // The accumulated fields of each output document, in the order they appear in the $group.
+    std::vector<AccumulationStatement> accumulators;
+
+    // Whether the stage may spill its hash table to disk when it exceeds its memory budget.
+    bool allowDiskUse;
+
+    // The memory budget of the $group, as it would have been enforced by the pipeline.
+    size_t maxMemoryUsageBytes;
+};
+
 struct TextOrNode : public OrNode {
     TextOrNode() {}
 
@@ -1249,6 +1328,11 @@ struct TextOrNode : public OrNode {
 
     void appendToString(str::stream* ss, int indent) const override;
     QuerySolutionNode* clone() const override;
+
+    // If non-zero, only the 'limit' documents with the highest text score need to be returned. Set
+    // when the results are sorted by text score with a limit, and nothing between this node and the
+    // sort can discard documents.
+    size_t limit = 0;
 };
 
 struct TextMatchNode : public QuerySolutionNodeWithSortSet {
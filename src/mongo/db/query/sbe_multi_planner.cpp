@@ -46,10 +46,12 @@ namespace mongo::sbe {
 CandidatePlans MultiPlanner::plan(
     std::vector<std::unique_ptr<QuerySolution>> solutions,
     std::vector<std::pair<std::unique_ptr<PlanStage>, stage_builder::PlanStageData>> roots) {
-    auto candidates =
-        collectExecutionStats(std::move(solutions),
-                              std::move(roots),
-                              trial_period::getTrialPeriodMaxWorks(_opCtx, _collection));
+    const auto maxWorks = trial_period::getTrialPeriodMaxWorks(
+        _opCtx,
+        _collection,
+        trial_period::getCheapestEstimatedWorks(
+            solutions.begin(), solutions.end(), [](auto&& solution) { return solution.get(); }));
+    auto candidates = collectExecutionStats(std::move(solutions), std::move(roots), maxWorks);
     auto decision = uassertStatusOK(mongo::plan_ranker::pickBestPlan<PlanStageStats>(candidates));
     return finalizeExecutionPlans(std::move(decision), std::move(candidates));
 }
@@ -0,0 +1,66 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/db/query/query_knobs_gen.h"
+
+namespace mongo::sbe {
+PlanCache::PlanCache() : PlanCache(internalQueryCacheMaxEntriesPerCollection.load()) {}
+
+PlanCache::PlanCache(size_t size) : _cache(size) {}
+
+std::shared_ptr<const PlanCache::Entry> PlanCache::get(const PlanCacheKey& key) {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    auto it = _cache.find(key);
+    if (it == _cache.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void PlanCache::set(const PlanCacheKey& key, std::shared_ptr<const Entry> entry) {
+    invariant(entry);
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    _cache.add(key, std::move(entry));
+}
+
+void PlanCache::clear() {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    _cache.clear();
+}
+
+size_t PlanCache::size() const {
+    stdx::lock_guard<Latch> cacheLock(_cacheMutex);
+    return _cache.size();
+}
+}  // namespace mongo::sbe
@@ -0,0 +1,95 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <memory>
+
+#include "mongo/db/exec/sbe/stages/stages.h"
+#include "mongo/db/query/plan_cache.h"
+#include "mongo/db/query/sbe_stage_builder.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+
+namespace mongo::sbe {
+/**
+ * A per-collection cache of SBE plans which are ready to be cloned and executed, keyed by the same
+ * PlanCacheKey as the classic plan cache. Unlike the classic plan cache, which stores the shape of
+ * a QuerySolution and so requires the stage builder to run again on every hit, an entry of this
+ * cache holds a fully built PlanStage tree. The inputs of a cached plan live in runtime
+ * environment slots, so that the tree can be rebound to the inputs of another query of the same
+ * shape once it has been cloned.
+ *
+ * This class is thread safe.
+ */
+class PlanCache {
+public:
+    struct Entry {
+        Entry(std::unique_ptr<PlanStage> root,
+              stage_builder::PlanStageData data,
+              BSONObj projection)
+            : root(std::move(root)), data(std::move(data)), projection(projection.getOwned()) {}
+
+        // The cached tree. It is never prepared nor executed, only cloned.
+        const std::unique_ptr<PlanStage> root;
+        const stage_builder::PlanStageData data;
+
+        // The projection of the query the plan was built for. It has to be checked on every hit as
+        // the PlanCacheKey does not encode projections which need the whole document.
+        const BSONObj projection;
+    };
+
+    PlanCache();
+    explicit PlanCache(size_t size);
+
+    /**
+     * Returns the entry cached for 'key', or nullptr if there is none.
+     */
+    std::shared_ptr<const Entry> get(const PlanCacheKey& key);
+
+    /**
+     * Caches 'entry' under 'key', replacing the entry previously cached for 'key', if any.
+     */
+    void set(const PlanCacheKey& key, std::shared_ptr<const Entry> entry);
+
+    /**
+     * Removes all cached plans.
+     */
+    void clear();
+
+    size_t size() const;
+
+private:
+    LRUCache<PlanCacheKey, std::shared_ptr<const Entry>, PlanCacheKeyHasher> _cache;
+
+    // Protects _cache.
+    mutable Mutex _cacheMutex = MONGO_MAKE_LATCH("sbe::PlanCache::_cacheMutex");
+};
+}  // namespace mongo::sbe
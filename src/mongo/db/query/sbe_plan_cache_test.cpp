@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache.h"
+
+#include "mongo/db/exec/sbe/stages/co_scan.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+PlanCacheKey makeKey(std::string shape) {
+    return PlanCacheKey(std::move(shape), "");
+}
+
+std::shared_ptr<const sbe::PlanCache::Entry> makeEntry(BSONObj projection = BSONObj()) {
+    stage_builder::PlanStageData data{std::make_unique<sbe::RuntimeEnvironment>()};
+    return std::make_shared<const sbe::PlanCache::Entry>(
+        sbe::makeS<sbe::CoScanStage>(kEmptyPlanNodeId), std::move(data), projection);
+}
+
+TEST(SbePlanCacheTest, GetReturnsCachedEntry) {
+    sbe::PlanCache cache{10};
+    ASSERT_FALSE(cache.get(makeKey("a")));
+
+    auto entry = makeEntry(BSON("x" << 1));
+    cache.set(makeKey("a"), entry);
+    ASSERT_EQ(1U, cache.size());
+    ASSERT_EQ(entry, cache.get(makeKey("a")));
+    ASSERT_FALSE(cache.get(makeKey("b")));
+    ASSERT_BSONOBJ_EQ(BSON("x" << 1), cache.get(makeKey("a"))->projection);
+}
+
+TEST(SbePlanCacheTest, SetReplacesExistingEntry) {
+    sbe::PlanCache cache{10};
+    cache.set(makeKey("a"), makeEntry());
+
+    auto entry = makeEntry();
+    cache.set(makeKey("a"), entry);
+    ASSERT_EQ(1U, cache.size());
+    ASSERT_EQ(entry, cache.get(makeKey("a")));
+}
+
+TEST(SbePlanCacheTest, EvictsLeastRecentlyUsedEntry) {
+    sbe::PlanCache cache{2};
+    cache.set(makeKey("a"), makeEntry());
+    cache.set(makeKey("b"), makeEntry());
+
+    // Make "a" the most recently used entry, so that "b" is evicted to make room for "c".
+    ASSERT_TRUE(cache.get(makeKey("a")));
+    cache.set(makeKey("c"), makeEntry());
+
+    ASSERT_EQ(2U, cache.size());
+    ASSERT_TRUE(cache.get(makeKey("a")));
+    ASSERT_FALSE(cache.get(makeKey("b")));
+    ASSERT_TRUE(cache.get(makeKey("c")));
+}
+
+TEST(SbePlanCacheTest, ClearRemovesAllEntries) {
+    sbe::PlanCache cache{10};
+    cache.set(makeKey("a"), makeEntry());
+    cache.set(makeKey("b"), makeEntry());
+
+    cache.clear();
+    ASSERT_EQ(0U, cache.size());
+    ASSERT_FALSE(cache.get(makeKey("a")));
+}
+
+TEST(SbePlanCacheTest, DeepCopyOfPlanStageDataDoesNotShareSlots) {
+    sbe::value::SlotIdGenerator slotIdGenerator;
+    stage_builder::PlanStageData data{std::make_unique<sbe::RuntimeEnvironment>()};
+    auto [strTag, strVal] = sbe::value::makeNewString("a sufficiently long string value");
+    auto slot = data.env->registerSlot("param"_sd, strTag, strVal, true, &slotIdGenerator);
+
+    auto copy = data.makeDeepCopy();
+    copy.env->resetSlot(slot, sbe::value::TypeTags::NumberInt32, 42, false);
+
+    auto [origTag, origVal] = data.env->getAccessor(slot)->getViewOfValue();
+    ASSERT_TRUE(sbe::value::isString(origTag));
+    ASSERT_EQ("a sufficiently long string value", sbe::value::getStringView(origTag, origVal));
+
+    auto [copyTag, copyVal] = copy.env->getAccessor(slot)->getViewOfValue();
+    ASSERT_EQ(sbe::value::TypeTags::NumberInt32, copyTag);
+    ASSERT_EQ(42, sbe::value::bitcastTo<int32_t>(copyVal));
+}
+
+}  // namespace
+}  // namespace mongo
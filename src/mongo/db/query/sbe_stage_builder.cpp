@@ -55,12 +55,16 @@
 #include "mongo/db/fts/fts_query_impl.h"
 #include "mongo/db/fts/fts_spec.h"
 #include "mongo/db/index/fts_access_method.h"
+#include "mongo/db/pipeline/accumulator.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
+#include "mongo/db/query/sbe_stage_builder_expression.h"
 #include "mongo/db/query/sbe_stage_builder_filter.h"
 #include "mongo/db/query/sbe_stage_builder_helpers.h"
 #include "mongo/db/query/sbe_stage_builder_index_scan.h"
 #include "mongo/db/query/sbe_stage_builder_projection.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/repl/read_concern_args.h"
 #include "mongo/db/s/collection_sharding_state.h"
 #include "mongo/db/storage/execution_context.h"
 #include "mongo/logv2/log.h"
@@ -244,6 +248,37 @@ std::unique_ptr<sbe::RuntimeEnvironment> makeRuntimeEnvironment(
     return env;
 }
 
+bool rebindRuntimeEnvironment(const CanonicalQuery& cq, sbe::RuntimeEnvironment* env) {
+    if (static_cast<bool>(env->getSlotIfExists("collator"_sd)) !=
+        static_cast<bool>(cq.getCollator())) {
+        return false;
+    }
+    if (auto collator = cq.getCollator(); collator) {
+        env->resetSlot(env->getSlot("collator"_sd),
+                       sbe::value::TypeTags::collator,
+                       sbe::value::bitcastFrom<const CollatorInterface*>(collator),
+                       false);
+    }
+
+    for (auto&& [id, name] : Variables::kIdToBuiltinVarName) {
+        if (id == Variables::kRootId || id == Variables::kRemoveId) {
+            continue;
+        }
+
+        auto slot = env->getSlotIfExists(name);
+        auto hasValue = cq.getExpCtx()->variables.hasValue(id);
+        if (static_cast<bool>(slot) != hasValue) {
+            return false;
+        }
+        if (slot) {
+            auto [tag, val] = makeValue(cq.getExpCtx()->variables.getValue(id));
+            env->resetSlot(*slot, tag, val, true);
+        }
+    }
+
+    return true;
+}
+
 PlanStageSlots::PlanStageSlots(const PlanStageReqs& reqs,
                                sbe::value::SlotIdGenerator* slotIdGenerator) {
     for (auto&& [slotName, isRequired] : reqs._slots) {
@@ -268,6 +303,17 @@ std::string PlanStageData::debugString() const {
     return builder.str();
 }
 
+PlanStageData PlanStageData::makeDeepCopy() const {
+    PlanStageData copy{env->makeDeepCopy()};
+    copy.outputs = outputs;
+    copy.iamMap = iamMap;
+    copy.shouldTrackLatestOplogTimestamp = shouldTrackLatestOplogTimestamp;
+    copy.shouldTrackResumeToken = shouldTrackResumeToken;
+    copy.shouldUseTailableScan = shouldUseTailableScan;
+    copy.replanReason = replanReason;
+    return copy;
+}
+
 namespace {
 const QuerySolutionNode* getNodeByType(const QuerySolutionNode* root, StageType type) {
     if (root->getType() == type) {
@@ -460,6 +506,49 @@ std::unique_ptr<fts::FTSMatcher> makeFtsMatcher(OperationContext* opCtx,
     tassert(5432220, "expected FTSQueryImpl", query);
     return std::make_unique<fts::FTSMatcher>(*query, accessMethod->getSpec());
 }
+
+/**
+ * Returns the number of threads the collection scan 'csn' may be split across, as requested by
+ * '$_internalParallelism' and capped by 'internalQuerySlotBasedExecutionMaxParallelism'. The
+ * producers of a parallel scan run on operations of their own, which open their own storage
+ * snapshots and carry none of the read concern, read source or transaction of this one. So, as
+ * for the parallel $group, this is limited to plain local reads outside of transactions, which
+ * would observe several snapshots across yields anyway. The scan must also be free to return its
+ * documents in any order, so scans which are asked for or rely on the natural order stay serial.
+ */
+size_t getCollScanParallelism(OperationContext* opCtx,
+                              const CanonicalQuery& cq,
+                              const CollectionPtr& collection,
+                              const CollectionScanNode* csn) {
+    const auto& findCommand = cq.getFindCommandRequest();
+    const auto requested = findCommand.getInternalParallelism().value_or(1);
+    if (requested <= 1) {
+        return 1;
+    }
+
+    if (opCtx->inMultiDocumentTransaction() ||
+        opCtx->recoveryUnit()->getTimestampReadSource() != RecoveryUnit::ReadSource::kNoTimestamp) {
+        return 1;
+    }
+
+    const auto& readConcernArgs = repl::ReadConcernArgs::get(opCtx);
+    if (readConcernArgs.getLevel() != repl::ReadConcernLevel::kLocalReadConcern ||
+        readConcernArgs.getArgsAtClusterTime() || readConcernArgs.getArgsAfterClusterTime()) {
+        return 1;
+    }
+
+    if (collection->ns().isOplog() || collection->isCapped() || collection->isClustered()) {
+        return 1;
+    }
+
+    if (csn->tailable || csn->requestResumeToken || csn->resumeAfterRecordId ||
+        findCommand.getSort().hasField("$natural") || findCommand.getHint().hasField("$natural")) {
+        return 1;
+    }
+
+    return static_cast<size_t>(
+        std::min<long long>(requested, internalQuerySlotBasedExecutionMaxParallelism.load()));
+}
 }  // namespace
 
 SlotBasedStageBuilder::SlotBasedStageBuilder(OperationContext* opCtx,
@@ -520,6 +609,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     auto csn = static_cast<const CollectionScanNode*>(root);
 
+    const auto parallelism = getCollScanParallelism(_opCtx, _cq, _collection, csn);
+
     auto [stage, outputs] = generateCollScan(_opCtx,
                                              _collection,
                                              csn,
@@ -528,7 +619,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                              _yieldPolicy,
                                              _data.env,
                                              reqs.getIsTailableCollScanResumeBranch(),
-                                             _lockAcquisitionCallback);
+                                             _lockAcquisitionCallback,
+                                             parallelism);
 
     if (reqs.has(kReturnKey)) {
         // Assign the 'returnKeySlot' to be the empty object.
@@ -2160,6 +2252,160 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             std::move(outputs)};
 }
 
+std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildGroup(
+    const QuerySolutionNode* root, const PlanStageReqs& reqs) {
+    using namespace std::literals;
+    invariant(!reqs.getIndexKeyBitset());
+
+    auto gn = static_cast<const GroupNode*>(root);
+    const auto nodeId = root->nodeId();
+
+    tassert(5843102, "A pushed down $group cannot produce a record id", !reqs.has(kRecordId));
+
+    // The child only needs to produce the documents being grouped. Everything else the parent asks
+    // for is produced by the $group itself.
+    auto childReqs = reqs.copy().set(kResult);
+    auto [inputStage, outputs] = build(gn->children[0], childReqs);
+    auto stage = std::move(inputStage);
+    const auto childResult = outputs.get(kResult);
+
+    // Evaluates the given MQL expression against the input document and binds the result to a new
+    // slot. The slots bound so far must stay visible to whatever is built on top, so we keep them
+    // in 'relevantSlots'.
+    auto relevantSlots = sbe::makeSV(childResult);
+    auto projectExpression = [&](Expression* expr, auto&& makeFinalExpr) {
+        auto [slot, sbeExpr, exprStage] = generateExpression(_opCtx,
+                                                             expr,
+                                                             std::move(stage),
+                                                             &_slotIdGenerator,
+                                                             &_frameIdGenerator,
+                                                             childResult,
+                                                             _data.env,
+                                                             nodeId,
+                                                             &relevantSlots);
+        stage = makeProjectStage(
+            std::move(exprStage), nodeId, slot, makeFinalExpr(std::move(sbeExpr)));
+        relevantSlots.push_back(slot);
+        return slot;
+    };
+    auto identity = [](std::unique_ptr<sbe::EExpression> expr) { return expr; };
+
+    // Like the classic $group, treat a missing group key as null.
+    auto idSlot = projectExpression(gn->groupByExpression.get(),
+                                    [](auto expr) { return makeFillEmptyNull(std::move(expr)); });
+
+    auto collatorSlot = _data.env->getSlotIfExists("collator"_sd);
+    auto withCollator = [&](StringData name, StringData collName, auto arg) {
+        return collatorSlot ? makeFunction(collName, makeVariable(*collatorSlot), std::move(arg))
+                            : makeFunction(name, std::move(arg));
+    };
+
+    sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> aggs;
+    sbe::HashAggMergingExprs mergingExprs;
+    std::vector<std::string> fieldNames{"_id"};
+    auto fieldSlots = sbe::makeSV(idSlot);
+    std::vector<std::pair<sbe::value::SlotId, std::unique_ptr<sbe::EExpression>>> finalizers;
+    bool canMergePartialAggregates = true;
+
+    for (auto&& acc : gn->accumulators) {
+        const StringData opName = acc.expr.makeAccumulator()->getOpName();
+        const auto aggSlot = _slotIdGenerator.generate();
+        std::unique_ptr<sbe::EExpression> aggExpr;
+        std::unique_ptr<sbe::EExpression> finalExpr;
+
+        if (opName == "$min"_sd || opName == "$max"_sd) {
+            // $min and $max ignore null, undefined and missing inputs.
+            auto argSlot = projectExpression(acc.expr.argument.get(), identity);
+            auto arg = sbe::makeE<sbe::EIf>(generateNullOrMissing(sbe::EVariable{argSlot}),
+                                            makeConstant(sbe::value::TypeTags::Nothing, 0),
+                                            makeVariable(argSlot));
+            const bool isMin = opName == "$min"_sd;
+            aggExpr = withCollator(isMin ? "min"_sd : "max"_sd,
+                                   isMin ? "collMin"_sd : "collMax"_sd,
+                                   std::move(arg));
+
+            // Partial results read back from disk are folded in with the same aggregate.
+            auto spilledSlot = _slotIdGenerator.generate();
+            mergingExprs.emplace(aggSlot,
+                                 std::make_pair(spilledSlot,
+                                                withCollator(isMin ? "min"_sd : "max"_sd,
+                                                             isMin ? "collMin"_sd : "collMax"_sd,
+                                                             makeVariable(spilledSlot))));
+            finalExpr = makeFillEmptyNull(makeVariable(aggSlot));
+        } else if (opName == "$first"_sd || opName == "$last"_sd) {
+            // A missing value still counts as the first (or last) value of the group.
+            auto argSlot = projectExpression(acc.expr.argument.get(), [](auto expr) {
+                return makeFillEmptyNull(std::move(expr));
+            });
+            aggExpr =
+                makeFunction(opName == "$first"_sd ? "first"_sd : "last"_sd, makeVariable(argSlot));
+
+            // The order of the partial results of a group is lost when the sorted runs are merged.
+            canMergePartialAggregates = false;
+            finalExpr = makeFillEmptyNull(makeVariable(aggSlot));
+        } else {
+            tassert(5843103,
+                    str::stream() << "Unsupported accumulator in a pushed down $group: " << opName,
+                    opName == "$push"_sd || opName == "$addToSet"_sd);
+
+            // Missing values are not added to the array, and an empty group yields an empty array.
+            auto argSlot = projectExpression(acc.expr.argument.get(), identity);
+            aggExpr = opName == "$push"_sd
+                ? makeFunction("addToArray"_sd, makeVariable(argSlot))
+                : withCollator("addToSet"_sd, "collAddToSet"_sd, makeVariable(argSlot));
+
+            // There is no aggregate to concatenate partial arrays read back from disk.
+            canMergePartialAggregates = false;
+            finalExpr =
+                makeFunction("fillEmpty"_sd, makeVariable(aggSlot), makeFunction("newArray"_sd));
+        }
+
+        aggs.emplace(aggSlot, std::move(aggExpr));
+
+        const auto finalSlot = _slotIdGenerator.generate();
+        finalizers.emplace_back(finalSlot, std::move(finalExpr));
+        fieldNames.push_back(acc.fieldName);
+        fieldSlots.push_back(finalSlot);
+    }
+
+    if (!canMergePartialAggregates) {
+        mergingExprs.clear();
+    }
+
+    stage = sbe::makeS<sbe::HashAggStage>(std::move(stage),
+                                          sbe::makeSV(idSlot),
+                                          std::move(aggs),
+                                          collatorSlot,
+                                          gn->allowDiskUse,
+                                          std::move(mergingExprs),
+                                          static_cast<long long>(gn->maxMemoryUsageBytes),
+                                          nodeId);
+
+    if (!finalizers.empty()) {
+        sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> projects;
+        for (auto&& [slot, expr] : finalizers) {
+            projects.emplace(slot, std::move(expr));
+        }
+        stage = sbe::makeS<sbe::ProjectStage>(std::move(stage), std::move(projects), nodeId);
+    }
+
+    // Only the output document survives the $group.
+    PlanStageSlots groupOutputs;
+    groupOutputs.set(kResult, _slotIdGenerator.generate());
+    stage = sbe::makeS<sbe::MakeBsonObjStage>(std::move(stage),
+                                              groupOutputs.get(kResult),
+                                              boost::none,
+                                              boost::none,
+                                              std::vector<std::string>{},
+                                              std::move(fieldNames),
+                                              std::move(fieldSlots),
+                                              true,
+                                              false,
+                                              nodeId);
+
+    return {std::move(stage), std::move(groupOutputs)};
+}
+
 // Returns a non-null pointer to the root of a plan tree, or a non-OK status if the PlanStage tree
 // could not be constructed.
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::build(
@@ -2191,7 +2437,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
             {STAGE_AND_HASH, &SlotBasedStageBuilder::buildAndHash},
             {STAGE_AND_SORTED, &SlotBasedStageBuilder::buildAndSorted},
             {STAGE_SORT_MERGE, &SlotBasedStageBuilder::buildSortMerge},
-            {STAGE_SHARDING_FILTER, &SlotBasedStageBuilder::buildShardFilter}};
+            {STAGE_SHARDING_FILTER, &SlotBasedStageBuilder::buildShardFilter},
+            {STAGE_GROUP, &SlotBasedStageBuilder::buildGroup}};
 
     tassert(4822884,
             str::stream() << "Unsupported QSN in SBE stage builder: " << root->toString(),
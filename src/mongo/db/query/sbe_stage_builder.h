@@ -48,6 +48,13 @@ std::unique_ptr<sbe::RuntimeEnvironment> makeRuntimeEnvironment(
     OperationContext* opCtx,
     sbe::value::SlotIdGenerator* slotIdGenerator);
 
+/**
+ * Rebinds the slots registered by 'makeRuntimeEnvironment()' for the values of builtin variables
+ * in 'env' to the values of those variables in 'cq'. Returns false, leaving 'env' in an unspecified
+ * state, if 'env' was created for a query which defines a different set of builtin variables.
+ */
+bool rebindRuntimeEnvironment(const CanonicalQuery& cq, sbe::RuntimeEnvironment* env);
+
 class PlanStageReqs;
 
 /**
@@ -228,6 +235,12 @@ struct PlanStageData {
 
     std::string debugString() const;
 
+    /**
+     * Returns a copy of this object with a RuntimeEnvironment of its own, which does not share any
+     * slot values with the environment of this object.
+     */
+    PlanStageData makeDeepCopy() const;
+
     // This holds the output slots produced by SBE plan (resultSlot, recordIdSlot, etc).
     PlanStageSlots outputs;
 
@@ -349,6 +362,9 @@ private:
     std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildShardFilter(
         const QuerySolutionNode* root, const PlanStageReqs& reqs);
 
+    std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> buildGroup(
+        const QuerySolutionNode* root, const PlanStageReqs& reqs);
+
     /**
      * Constructs an optimized SBE plan for 'filterNode' in the case that the fields of the
      * 'shardKeyPattern' are provided by 'childIxscan'. In this case, the SBE plan for the child
@@ -431,7 +431,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback) {
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t parallelism) {
     const auto forward = csn->direction == CollectionScanParams::FORWARD;
 
     invariant(!csn->shouldTrackLatestOplogTimestamp || collection->ns().isOplog());
@@ -457,23 +458,47 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
     auto&& [fields, slots, tsSlot] =
         makeOplogTimestampSlotsIfNeeded(env, slotIdGenerator, csn->shouldTrackLatestOplogTimestamp);
 
+    // A forward scan over the whole collection whose output order does not matter can be split
+    // by RecordId ranges across several producer threads, which feed an exchange on top of the
+    // scan and its filter.
+    const bool isParallel = parallelism > 1 && forward && !seekRecordIdSlot && !csn->tailable &&
+        !csn->shouldTrackLatestOplogTimestamp && !csn->requestResumeToken;
+
     sbe::ScanCallbacks callbacks(
         lockAcquisitionCallback, {}, {}, makeOpenCallbackIfNeeded(collection, csn));
-    auto stage = sbe::makeS<sbe::ScanStage>(collection->uuid(),
-                                            resultSlot,
-                                            recordIdSlot,
-                                            boost::none /* snapshotIdSlot */,
-                                            boost::none /* indexIdSlot */,
-                                            boost::none /* indexKeySlot */,
-                                            boost::none /* keyPatternSlot */,
-                                            tsSlot,
-                                            std::move(fields),
-                                            std::move(slots),
-                                            seekRecordIdSlot,
-                                            forward,
-                                            yieldPolicy,
-                                            csn->nodeId(),
-                                            std::move(callbacks));
+    auto stage = [&]() -> std::unique_ptr<sbe::PlanStage> {
+        if (isParallel) {
+            // The producers run on threads of their own, each with its own OperationContext, so
+            // they cannot share the yield policy of the main plan.
+            return sbe::makeS<sbe::ParallelScanStage>(collection->uuid(),
+                                                      resultSlot,
+                                                      recordIdSlot,
+                                                      boost::none /* snapshotIdSlot */,
+                                                      boost::none /* indexIdSlot */,
+                                                      boost::none /* indexKeySlot */,
+                                                      boost::none /* keyPatternSlot */,
+                                                      std::move(fields),
+                                                      std::move(slots),
+                                                      nullptr /* yieldPolicy */,
+                                                      csn->nodeId(),
+                                                      std::move(callbacks));
+        }
+        return sbe::makeS<sbe::ScanStage>(collection->uuid(),
+                                          resultSlot,
+                                          recordIdSlot,
+                                          boost::none /* snapshotIdSlot */,
+                                          boost::none /* indexIdSlot */,
+                                          boost::none /* indexKeySlot */,
+                                          boost::none /* keyPatternSlot */,
+                                          tsSlot,
+                                          std::move(fields),
+                                          std::move(slots),
+                                          seekRecordIdSlot,
+                                          forward,
+                                          yieldPolicy,
+                                          csn->nodeId(),
+                                          std::move(callbacks));
+    }();
 
     // Check if the scan should be started after the provided resume RecordId and construct a nested
     // loop join sub-tree to project out the resume RecordId as a seekRecordIdSlot and feed it to
@@ -582,6 +607,16 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateGenericCollSc
                                                       csn->nodeId());
     }
 
+    if (isParallel) {
+        stage = sbe::makeS<sbe::ExchangeConsumer>(std::move(stage),
+                                                  parallelism,
+                                                  sbe::makeSV(resultSlot, recordIdSlot),
+                                                  sbe::ExchangePolicy::roundrobin,
+                                                  nullptr /* partition */,
+                                                  nullptr /* orderLess */,
+                                                  csn->nodeId());
+    }
+
     PlanStageSlots outputs;
     outputs.set(PlanStageSlots::kResult, resultSlot);
     outputs.set(PlanStageSlots::kRecordId, recordIdSlot);
@@ -599,7 +634,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback) {
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t parallelism) {
     if (csn->minRecord || csn->maxRecord) {
         return generateOptimizedOplogScan(opCtx,
                                           collection,
@@ -619,7 +655,8 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
                                        yieldPolicy,
                                        env,
                                        isTailableResumeBranch,
-                                       std::move(lockAcquisitionCallback));
+                                       std::move(lockAcquisitionCallback),
+                                       parallelism);
     }
 }
 }  // namespace mongo::stage_builder
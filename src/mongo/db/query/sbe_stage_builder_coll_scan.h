@@ -49,6 +49,9 @@ class PlanStageSlots;
  *     were requested to track this data.
  *   * A generated PlanStage sub-tree.
  *
+ * If 'parallelism' is greater than one and the scan covers the whole collection in no particular
+ * order, the scan is split across 'parallelism' threads whose results are gathered by an exchange.
+ *
  * In cases of an error, throws.
  */
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
@@ -60,6 +63,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateCollScan(
     PlanYieldPolicy* yieldPolicy,
     sbe::RuntimeEnvironment* env,
     bool isTailableResumeBranch,
-    sbe::LockAcquisitionCallback lockAcquisitionCallback);
+    sbe::LockAcquisitionCallback lockAcquisitionCallback,
+    size_t parallelism);
 
 }  // namespace mongo::stage_builder
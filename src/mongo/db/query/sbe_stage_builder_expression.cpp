@@ -1132,6 +1132,9 @@ public:
                                           sbe::makeSV(),
                                           sbe::makeEM(groupSlot, std::move(addToArrayExpr)),
                                           collatorSlot,
+                                          false /* allowDiskUse */,
+                                          sbe::HashAggMergingExprs{},
+                                          boost::none /* memoryLimit */,
                                           _context->planNodeId);
         EvalStage groupEvalStage = {std::move(groupStage), sbe::makeSV(groupSlot)};
 
@@ -1161,6 +1164,9 @@ public:
             sbe::makeSV(),
             sbe::makeEM(finalGroupSlot, std::move(finalAddToArrayExpr)),
             collatorSlot,
+            false /* allowDiskUse */,
+            sbe::HashAggMergingExprs{},
+            boost::none /* memoryLimit */,
             _context->planNodeId);
 
         // Create a branch stage to select between the branch that produces one null if any elements
@@ -789,6 +789,14 @@ generateGenericMultiIntervalIndexScan(const CollectionPtr& collection,
                                             makeFunction("isRecordId"_sd, makeVariable(resultSlot)),
                                             ixn->nodeId())};
 }
+
+/**
+ * Returns the names of the runtime environment slots which hold the low and high seek keys of the
+ * single-interval index scan 'nodeId' when its bounds are parameterized.
+ */
+std::pair<std::string, std::string> makeSeekKeySlotNames(PlanNodeId nodeId) {
+    return {str::stream() << "lowKey_" << nodeId, str::stream() << "highKey_" << nodeId};
+}
 }  // namespace
 
 std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleIntervalIndexScan(
@@ -796,8 +804,8 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     const std::string& indexName,
     const BSONObj& keyPattern,
     bool forward,
-    std::unique_ptr<KeyString::Value> lowKey,
-    std::unique_ptr<KeyString::Value> highKey,
+    std::unique_ptr<sbe::EExpression> lowKeyExpr,
+    std::unique_ptr<sbe::EExpression> highKeyExpr,
     sbe::IndexKeysInclusionSet indexKeysToInclude,
     sbe::value::SlotVector indexKeySlots,
     boost::optional<sbe::value::SlotId> snapshotIdSlot,
@@ -815,12 +823,8 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     // Construct a constant table scan to deliver a single row with two fields 'lowKeySlot' and
     // 'highKeySlot', representing seek boundaries, into the index scan.
     sbe::value::SlotMap<std::unique_ptr<sbe::EExpression>> projects;
-    projects.emplace(lowKeySlot,
-                     makeConstant(sbe::value::TypeTags::ksValue,
-                                  sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release())));
-    projects.emplace(highKeySlot,
-                     makeConstant(sbe::value::TypeTags::ksValue,
-                                  sbe::value::bitcastFrom<KeyString::Value*>(highKey.release())));
+    projects.emplace(lowKeySlot, std::move(lowKeyExpr));
+    projects.emplace(highKeySlot, std::move(highKeyExpr));
     if (indexIdSlot) {
         // Construct a copy of 'indexName' to project for use in the index consistency check.
         projects.emplace(*indexIdSlot, makeConstant(indexName));
@@ -975,13 +979,26 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
         auto&& [lowKey, highKey] = intervals[0];
         sbe::value::SlotId recordIdSlot;
 
+        // Unless the bounds are parameterized, the seek keys are baked into the plan as constants.
+        // Otherwise they live in the runtime environment, where they can be rebound later on.
+        auto makeSeekKeyExpr = [&](StringData slotName, std::unique_ptr<KeyString::Value> key)
+            -> std::unique_ptr<sbe::EExpression> {
+            auto tag = sbe::value::TypeTags::ksValue;
+            auto val = sbe::value::bitcastFrom<KeyString::Value*>(key.release());
+            if (!ixn->parameterizeBounds) {
+                return makeConstant(tag, val);
+            }
+            return makeVariable(env->registerSlot(slotName, tag, val, true, slotIdGenerator));
+        };
+        auto [lowKeySlotName, highKeySlotName] = makeSeekKeySlotNames(ixn->nodeId());
+
         std::tie(recordIdSlot, stage) =
             generateSingleIntervalIndexScan(collection,
                                             indexName,
                                             keyPattern,
                                             ixn->direction == 1,
-                                            std::move(lowKey),
-                                            std::move(highKey),
+                                            makeSeekKeyExpr(lowKeySlotName, std::move(lowKey)),
+                                            makeSeekKeyExpr(highKeySlotName, std::move(highKey)),
                                             indexKeyBitset,
                                             indexKeySlots,
                                             snapshotIdSlot,
@@ -1067,4 +1084,45 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
 
     return {std::move(stage), std::move(outputs)};
 }
+
+bool bindParameterizedIndexBounds(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const IndexScanNode* ixn,
+                                  sbe::RuntimeEnvironment* env) {
+    invariant(ixn->parameterizeBounds);
+
+    auto [lowKeySlotName, highKeySlotName] = makeSeekKeySlotNames(ixn->nodeId());
+    auto lowKeySlot = env->getSlotIfExists(lowKeySlotName);
+    auto highKeySlot = env->getSlotIfExists(highKeySlotName);
+    if (!lowKeySlot || !highKeySlot) {
+        return false;
+    }
+
+    auto descriptor =
+        collection->getIndexCatalog()->findIndexByName(opCtx, ixn->index.identifier.catalogName);
+    if (!descriptor) {
+        return false;
+    }
+
+    auto accessMethod = collection->getIndexCatalog()->getEntry(descriptor)->accessMethod();
+    auto intervals =
+        makeIntervalsFromIndexBounds(ixn->bounds,
+                                     ixn->direction == 1,
+                                     accessMethod->getSortedDataInterface()->getKeyStringVersion(),
+                                     accessMethod->getSortedDataInterface()->getOrdering());
+    if (intervals.size() != 1) {
+        return false;
+    }
+
+    auto&& [lowKey, highKey] = intervals[0];
+    env->resetSlot(*lowKeySlot,
+                   sbe::value::TypeTags::ksValue,
+                   sbe::value::bitcastFrom<KeyString::Value*>(lowKey.release()),
+                   true);
+    env->resetSlot(*highKeySlot,
+                   sbe::value::TypeTags::ksValue,
+                   sbe::value::bitcastFrom<KeyString::Value*>(highKey.release()),
+                   true);
+    return true;
+}
 }  // namespace mongo::stage_builder
@@ -71,14 +71,15 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> generateIndexScan(
  *         nlj [indexIdSlot, keyPatternSlot] [lowKeySlot, highKeySlot]
  *              left
  *                  project [indexIdSlot = <indexName>, keyPatternSlot = <index key pattern>,
- *                          lowKeySlot =  KS(...), highKeySlot = KS(...)]
+ *                          lowKeySlot = <lowKeyExpr>, highKeySlot = <highKeyExpr>]
  *                  limit 1
  *                  coscan
  *               right
  *                  ixseek lowKeySlot highKeySlot recordIdSlot [] @coll @index
  *
  * The inner branch of the nested loop join produces a single row with the low/high keys which is
- * fed to the ixscan.
+ * fed to the ixscan. The 'lowKeyExpr' and 'highKeyExpr' expressions must evaluate to KeyStrings,
+ * and are typically either constants or references to runtime environment slots.
  *
  * If 'recordSlot' is provided, than the corresponding slot will be filled out with each KeyString
  * in the index.
@@ -88,8 +89,8 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     const std::string& indexName,
     const BSONObj& keyPattern,
     bool forward,
-    std::unique_ptr<KeyString::Value> lowKey,
-    std::unique_ptr<KeyString::Value> highKey,
+    std::unique_ptr<sbe::EExpression> lowKeyExpr,
+    std::unique_ptr<sbe::EExpression> highKeyExpr,
     sbe::IndexKeysInclusionSet indexKeysToInclude,
     sbe::value::SlotVector vars,
     boost::optional<sbe::value::SlotId> snapshotIdSlot,
@@ -101,4 +102,16 @@ std::pair<sbe::value::SlotId, std::unique_ptr<sbe::PlanStage>> generateSingleInt
     PlanNodeId nodeId,
     sbe::LockAcquisitionCallback lockAcquisitionCallback);
 
+/**
+ * Stores the seek keys for the bounds of the index scan 'ixn' in the runtime environment slots
+ * which were registered for them when a plan was built for an index scan with the same node id and
+ * 'parameterizeBounds' set. This allows a plan built for one query to be rebound to the bounds of
+ * another query of the same shape. Returns false if the slots cannot be found in 'env' or the
+ * bounds do not form a single interval.
+ */
+bool bindParameterizedIndexBounds(OperationContext* opCtx,
+                                  const CollectionPtr& collection,
+                                  const IndexScanNode* ixn,
+                                  sbe::RuntimeEnvironment* env);
+
 }  // namespace mongo::stage_builder
@@ -30,6 +30,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/exec/shard_filterer_mock.h"
+#include "mongo/db/pipeline/accumulation_statement.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/sbe_stage_builder_test_fixture.h"
 #include "mongo/db/query/shard_filterer_factory_mock.h"
@@ -216,4 +218,63 @@ TEST_F(SbeStageBuilderTest, VirtualIndexScanWithoutRecordId) {
     }
     ASSERT_EQ(index, 3);
 }
+
+TEST_F(SbeStageBuilderTest, GroupNodeComputesAccumulatorsPerGroup) {
+    auto docs = std::vector<BSONArray>{BSON_ARRAY(BSON("a" << 1 << "b" << 5)),
+                                       BSON_ARRAY(BSON("a" << 2 << "b" << 3)),
+                                       BSON_ARRAY(BSON("a" << 1 << "b" << 7)),
+                                       BSON_ARRAY(BSON("a" << 2 << "b" << BSONNULL)),
+                                       BSON_ARRAY(BSON("b" << 1))};
+
+    // Construct a GroupNode equivalent to {$group: {_id: "$a", lo: {$min: "$b"}, all: {$push:
+    // "$b"}}} on top of a VirtualScanNode.
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto vps = expCtx->variablesParseState;
+    auto groupSpec = BSON("lo" << BSON("$min"
+                                       << "$b")
+                               << "all"
+                               << BSON("$push"
+                                       << "$b"));
+    std::vector<AccumulationStatement> accumulators;
+    for (auto&& elem : groupSpec) {
+        accumulators.push_back(
+            AccumulationStatement::parseAccumulationStatement(expCtx.get(), elem, vps));
+    }
+    auto groupNode = std::make_unique<GroupNode>(
+        std::make_unique<VirtualScanNode>(docs, VirtualScanNode::ScanType::kCollScan, false),
+        ExpressionFieldPath::parse(expCtx.get(), "$a", vps),
+        std::move(accumulators),
+        false /* allowDiskUse */,
+        100 * 1024 * 1024 /* maxMemoryUsageBytes */);
+    auto querySolution = makeQuerySolution(std::move(groupNode));
+
+    // Translate the QuerySolution tree to an sbe::PlanStage.
+    auto shardFiltererInterface = makeAlwaysPassShardFiltererInterface();
+    auto [resultSlots, stage, data] =
+        buildPlanStage(std::move(querySolution), false, std::move(shardFiltererInterface));
+    auto resultAccessors = prepareTree(&data.ctx, stage.get(), resultSlots);
+    ASSERT_EQ(resultAccessors.size(), 1u);
+
+    std::vector<BSONObj> results;
+    for (auto st = stage->getNext(); st == sbe::PlanState::ADVANCED; st = stage->getNext()) {
+        auto [tagDoc, valDoc] = resultAccessors[0]->getViewOfValue();
+        ASSERT_TRUE(tagDoc == sbe::value::TypeTags::bsonObject);
+        results.push_back(BSONObj(sbe::value::bitcastTo<const char*>(valDoc)).getOwned());
+    }
+
+    // The groups come out of a hash table, so their order is unspecified. Note that $min ignores
+    // nulls while $push keeps them, and that a missing group key is grouped as null.
+    auto expected = std::vector<BSONObj>{
+        BSON("_id" << 1 << "lo" << 5 << "all" << BSON_ARRAY(5 << 7)),
+        BSON("_id" << 2 << "lo" << 3 << "all" << BSON_ARRAY(3 << BSONNULL)),
+        BSON("_id" << BSONNULL << "lo" << 1 << "all" << BSON_ARRAY(1))};
+    ASSERT_EQ(results.size(), expected.size());
+    for (auto&& expectedDoc : expected) {
+        ASSERT_EQ(1,
+                  std::count_if(results.begin(), results.end(), [&](auto&& doc) {
+                      return doc.binaryEqual(expectedDoc);
+                  }))
+            << expectedDoc;
+    }
+}
 }  // namespace mongo
@@ -81,6 +81,9 @@ enum StageType {
     STAGE_GEO_NEAR_2D,
     STAGE_GEO_NEAR_2DSPHERE,
 
+    // A $group pushed down from the aggregation pipeline. Only implemented by the SBE engine.
+    STAGE_GROUP,
+
     STAGE_IDHACK,
 
     STAGE_IXSCAN,
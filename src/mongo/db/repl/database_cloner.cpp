@@ -31,12 +31,19 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
+
 #include "mongo/base/string_data.h"
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
 #include "mongo/db/commands/list_collections_filter.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
+#include "mongo/db/repl/replication_auth.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -127,57 +134,163 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    // The main flow of control clones collections over our own connection, while each extra
+    // cloner thread uses a connection of its own, made by the same factory as ours. An extra
+    // connection that cannot be established only reduces the parallelism.
+    const size_t maxConcurrency = initialSyncCollectionClonerConcurrency.load();
+    const size_t numExtraCloners =
+        _collections.empty() ? 0 : std::min(maxConcurrency, _collections.size()) - 1;
+    std::vector<std::unique_ptr<DBClientConnection>> extraClients;
+    std::vector<stdx::thread> extraThreads;
+    for (size_t i = 0; i < numExtraCloners; ++i) {
+        auto client = getSharedData()->createClient();
+        auto status = connectExtraClient(client.get());
+        if (!status.isOK()) {
+            LOGV2(5843119,
+                  "Failed to open an extra connection for cloning collections in parallel",
+                  "database"_attr = _dbName,
+                  "numExtraCloners"_attr = extraThreads.size(),
+                  "error"_attr = status);
+            break;
+        }
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+            ++_runningExtraCloners;
         }
-        auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(21148,
-                        1,
-                        "collection clone finished: {namespace}",
-                        "Collection clone finished",
-                        "namespace"_attr = sourceNss);
-        } else {
-            LOGV2_ERROR(21149,
-                        "collection clone for '{namespace}' failed due to {error}",
-                        "Collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString());
-            setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
-                                 collStatus
-                                     .withContext(str::stream() << "Error cloning collection '"
-                                                                << sourceNss.toString() << "'")
-                                     .toString()});
+        extraThreads.emplace_back([this, client = client.get()] {
+            Client::initThread("DatabaseClonerCollectionCloner");
+            AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+            cloneCollections(client);
+            stdx::lock_guard<Latch> lk(_mutex);
+            --_runningExtraCloners;
+            _extraClonersDone.notify_all();
+        });
+        extraClients.push_back(std::move(client));
+    }
+
+    cloneCollections(getClient());
+
+    // Wait for the extra cloners, shutting their connections down if initial sync is canceled
+    // since nothing else interrupts them.
+    stdx::unique_lock<Latch> lk(_mutex);
+    bool clientsShutDown = false;
+    while (_runningExtraCloners > 0) {
+        _extraClonersDone.wait_for(lk, Milliseconds(100).toSystemDuration());
+        if (!clientsShutDown && _runningExtraCloners > 0) {
+            lk.unlock();
+            if (mustExit()) {
+                for (auto&& client : extraClients) {
+                    client->shutdownAndDisallowReconnect();
+                }
+                clientsShutDown = true;
+            }
+            lk.lock();
         }
+    }
+    lk.unlock();
+    for (auto&& thread : extraThreads) {
+        thread.join();
+    }
+
+    lk.lock();
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+void DatabaseCloner::cloneCollections(DBClientConnection* client) {
+    while (true) {
+        size_t index;
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
+            if (_collectionCloneFailed || _nextCollection == _collections.size()) {
                 return;
-            _stats.clonedCollections++;
+            }
+            index = _nextCollection++;
         }
+        if (!cloneCollection(index, client)) {
+            return;
+        }
+    }
+}
+
+bool DatabaseCloner::cloneCollection(size_t index, DBClientConnection* client) {
+    auto& sourceNss = _collections[index].first;
+    auto& collectionOptions = _collections[index].second;
+    CollectionCloner* collectionCloner;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& cloner = _currentClonersByIndex[index];
+        cloner = std::make_unique<CollectionCloner>(sourceNss,
+                                                    collectionOptions,
+                                                    getSharedData(),
+                                                    getSource(),
+                                                    client,
+                                                    getStorageInterface(),
+                                                    getDBPool());
+        collectionCloner = cloner.get();
+    }
+    auto collStatus = collectionCloner->run();
+    if (collStatus.isOK()) {
+        LOGV2_DEBUG(21148,
+                    1,
+                    "collection clone finished: {namespace}",
+                    "Collection clone finished",
+                    "namespace"_attr = sourceNss);
+    } else {
+        LOGV2_ERROR(21149,
+                    "collection clone for '{namespace}' failed due to {error}",
+                    "Collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = collStatus.toString());
+        setSyncFailedStatus({ErrorCodes::InitialSyncFailure,
+                             collStatus
+                                 .withContext(str::stream() << "Error cloning collection '"
+                                                            << sourceNss.toString() << "'")
+                                 .toString()});
     }
+
     stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+    _stats.collectionStats[index] = collectionCloner->getStats();
+    _currentClonersByIndex.erase(index);
+    // Abort the database cloner if the collection clone failed.
+    if (!collStatus.isOK()) {
+        _collectionCloneFailed = true;
+        return false;
+    }
+    _stats.clonedCollections++;
+    return true;
+}
+
+Status DatabaseCloner::connectExtraClient(DBClientConnection* client) {
+    try {
+        // As for the main connection, only clone from a sync source which is still a primary or a
+        // secondary.
+        client->setHandshakeValidationHook([](const executor::RemoteCommandResponse& reply) {
+            if (!reply.isOK()) {
+                return reply.status;
+            }
+            if (reply.data["ismaster"].trueValue() || reply.data["secondary"].trueValue()) {
+                return Status::OK();
+            }
+            return Status(ErrorCodes::NotPrimaryOrSecondary,
+                          "Sync source is no longer a primary or a secondary");
+        });
+        auto status = client->connect(getSource(), StringData(), boost::none);
+        if (!status.isOK()) {
+            return status;
+        }
+        return replAuthenticate(client).withContext(str::stream()
+                                                    << "Failed to authenticate to " << getSource());
+    } catch (const DBException& e) {
+        return e.toStatus();
+    }
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (auto&& [index, collectionCloner] : _currentClonersByIndex) {
+        stats.collectionStats[index] = collectionCloner->getStats();
     }
     return stats;
 }
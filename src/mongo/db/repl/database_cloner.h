@@ -35,6 +35,8 @@
 #include "mongo/db/repl/collection_cloner.h"
 #include "mongo/db/repl/initial_sync_base_cloner.h"
 #include "mongo/db/repl/initial_sync_shared_data.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 namespace repl {
@@ -89,10 +91,29 @@ private:
 
     /**
      * The postStage creates and runs the individual CollectionCloners on each database found on
-     * the sync source, and sets the end time in _stats when done.
+     * the sync source, and sets the end time in _stats when done. Up to
+     * 'initialSyncCollectionClonerConcurrency' collections are cloned at the same time.
      */
     void postStage() final;
 
+    /**
+     * Runs CollectionCloners over 'client' for the collections not yet claimed by another thread,
+     * until all have been cloned or a clone has failed.
+     */
+    void cloneCollections(DBClientConnection* client);
+
+    /**
+     * Runs a CollectionCloner over 'client' for the collection at 'index' in '_collections' and
+     * records its stats. Returns false if the clone failed, which fails the database clone.
+     */
+    bool cloneCollection(size_t index, DBClientConnection* client);
+
+    /**
+     * Connects and authenticates 'client', an additional client from the shared data, to the sync
+     * source, for cloning collections in parallel with the main flow of control.
+     */
+    Status connectExtraClient(DBClientConnection* client);
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -109,8 +130,13 @@ private:
     const std::string _dbName;                                                // (R)
     ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    // The running CollectionCloners, by index in '_collections'.
+    stdx::unordered_map<size_t, std::unique_ptr<CollectionCloner>> _currentClonersByIndex;  // (M)
+    size_t _nextCollection = 0;                                                // (M)
+    bool _collectionCloneFailed = false;                                       // (M)
+    size_t _runningExtraCloners = 0;                                           // (M)
+    stdx::condition_variable _extraClonersDone;                                // (S)
+    Stats _stats;                                                              // (MX)
 };
 
 }  // namespace repl
@@ -36,6 +36,7 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
@@ -61,6 +62,8 @@ protected:
                    const BSONObj& idIndexSpec,
                    const std::vector<BSONObj>& secondaryIndexSpecs)
             -> StatusWith<std::unique_ptr<CollectionBulkLoaderMock>> {
+            // Collections may be cloned in parallel.
+            stdx::lock_guard<Latch> lk(_collectionsMutex);
             const auto collInfo = &_collections[nss];
 
             auto localLoader = std::make_unique<CollectionBulkLoaderMock>(collInfo->stats);
@@ -105,6 +108,29 @@ protected:
         return cloner->_collections;
     }
 
+    /**
+     * Sets the mock server up to list the collections 'names', without documents and with only
+     * an _id index.
+     */
+    void setUpCollections(const std::vector<std::string>& names) {
+        std::vector<BSONObj> infos;
+        for (auto&& name : names) {
+            infos.push_back(BSON("name" << name << "type"
+                                        << "collection"
+                                        << "options" << BSONObj() << "info"
+                                        << BSON("readOnly" << false << "uuid" << UUID::gen())));
+        }
+        _mockServer->setCommandReply("listCollections", createListCollectionsResponse(infos));
+        _mockServer->setCommandReply("collStats", BSON("size" << 0));
+        _mockServer->setCommandReply("count", createCountResponse(0));
+        _mockServer->setCommandReply(
+            "listIndexes",
+            createCursorResponse(_dbName + ".a",
+                                 BSON_ARRAY(BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                                     << "_id_"))));
+    }
+
+    Mutex _collectionsMutex = MONGO_MAKE_LATCH("DatabaseClonerTest::_collectionsMutex");
     std::map<NamespaceString, CollectionCloneInfo> _collections;
 
     static std::string _dbName;
@@ -503,5 +529,69 @@ TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     ASSERT_EQ(_clock.now(), stats.collectionStats[1].end);
 }
 
+TEST_F(DatabaseClonerTest, CloneCollectionsInParallel) {
+    RAIIServerParameterControllerForTest concurrency("initialSyncCollectionClonerConcurrency", 2);
+    int numExtraClients = 0;
+    _createClientFn = [&] {
+        ++numExtraClients;
+        return std::unique_ptr<DBClientConnection>(
+            new MockDBClientConnection(_mockServer.get(), true /* autoReconnect */));
+    };
+    setUpCollections({"a", "b", "c"});
+    auto cloner = makeDatabaseCloner();
+
+    // Hold the clone of 'a' up, so that the other collections can only be cloned by the other
+    // thread in the meantime.
+    auto failPoint = globalFailPointRegistry().find("hangBeforeClonerStage");
+    auto timesEntered = failPoint->setMode(
+        FailPoint::alwaysOn,
+        0,
+        fromjson("{cloner: 'CollectionCloner', stage: 'count', nss: '" + _dbName + ".a'}"));
+
+    stdx::thread clonerThread([&] {
+        Client::initThread("ClonerRunner");
+        ASSERT_OK(cloner->run());
+    });
+    failPoint->waitForTimesEntered(timesEntered + 1);
+    while (cloner->getStats().clonedCollections < 2) {
+        sleepmillis(10);
+    }
+    failPoint->setMode(FailPoint::off);
+    clonerThread.join();
+
+    ASSERT_EQ(1, numExtraClients);
+    auto stats = cloner->getStats();
+    ASSERT_EQ(3, stats.collections);
+    ASSERT_EQ(3, stats.clonedCollections);
+    for (auto&& name : {"a", "b", "c"}) {
+        ASSERT(_collections[NamespaceString(_dbName, name)].stats->commitCalled) << name;
+    }
+}
+
+TEST_F(DatabaseClonerTest, FailingExtraConnectionOnlyReducesParallelism) {
+    RAIIServerParameterControllerForTest concurrency("initialSyncCollectionClonerConcurrency", 3);
+    MockRemoteDBServer unreachableServer("unreachable:1234");
+    unreachableServer.shutdown();
+    int numExtraClients = 0;
+    _createClientFn = [&] {
+        ++numExtraClients;
+        return std::unique_ptr<DBClientConnection>(new MockDBClientConnection(&unreachableServer));
+    };
+    setUpCollections({"a", "b", "c"});
+    auto cloner = makeDatabaseCloner();
+
+    // All collections are cloned over the main connection, and no further extra connection is
+    // attempted after the first one failed.
+    ASSERT_OK(cloner->run());
+    ASSERT_OK(getSharedData()->getStatus(WithLock::withoutLock()));
+    ASSERT_EQ(1, numExtraClients);
+    auto stats = cloner->getStats();
+    ASSERT_EQ(3, stats.collections);
+    ASSERT_EQ(3, stats.clonedCollections);
+    for (auto&& name : {"a", "b", "c"}) {
+        ASSERT(_collections[NamespaceString(_dbName, name)].stats->commitCalled) << name;
+    }
+}
+
 }  // namespace repl
 }  // namespace mongo
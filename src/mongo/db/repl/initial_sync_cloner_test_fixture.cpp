@@ -39,7 +39,10 @@ namespace repl {
 void InitialSyncClonerTestFixture::setUp() {
     ClonerTestFixture::setUp();
 
-    _sharedData = std::make_unique<InitialSyncSharedData>(kInitialRollbackId, Days(1), &_clock);
+    _sharedData =
+        std::make_unique<InitialSyncSharedData>(kInitialRollbackId, Days(1), &_clock, [this] {
+            return _createClientFn();
+        });
 
     // Set the initial sync ID on the mock server.
     _mockServer->insert(
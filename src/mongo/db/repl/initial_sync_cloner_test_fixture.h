@@ -31,6 +31,7 @@
 
 #include "mongo/db/repl/cloner_test_fixture.h"
 #include "mongo/db/repl/initial_sync_shared_data.h"
+#include "mongo/dbtests/mock/mock_dbclient_connection.h"
 
 namespace mongo {
 namespace repl {
@@ -46,6 +47,13 @@ protected:
 
     UUID _initialSyncId = UUID::gen();
     static constexpr int kInitialRollbackId = 1;
+
+    // Makes the extra clients handed out by the shared data. By default, they connect to the mock
+    // server.
+    InitialSyncSharedData::CreateClientFn _createClientFn = [this] {
+        return std::unique_ptr<DBClientConnection>(
+            new MockDBClientConnection(_mockServer.get(), true /* autoReconnect */));
+    };
 };
 
 }  // namespace repl
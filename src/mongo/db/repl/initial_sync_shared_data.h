@@ -29,8 +29,11 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <mutex>
 
+#include "mongo/client/dbclient_connection.h"
 #include "mongo/db/repl/repl_sync_shared_data.h"
 #include "mongo/db/server_options.h"
 
@@ -42,16 +45,29 @@ private:
 
 public:
     typedef boost::optional<RetryingOperation> RetryableOperation;
+    using CreateClientFn = std::function<std::unique_ptr<DBClientConnection>()>;
 
-    InitialSyncSharedData(int rollBackId, Milliseconds allowedOutageDuration, ClockSource* clock)
+    InitialSyncSharedData(int rollBackId,
+                          Milliseconds allowedOutageDuration,
+                          ClockSource* clock,
+                          CreateClientFn createClientFn)
         : ReplSyncSharedData(clock),
           _rollBackId(rollBackId),
+          _createClientFn(std::move(createClientFn)),
           _allowedOutageDuration(allowedOutageDuration) {}
 
     int getRollBackId() const {
         return _rollBackId;
     }
 
+    /**
+     * Returns a new, unconnected client for the sync source, made by the same factory as the
+     * client of the initial syncer. Cloners needing connections of their own must use this.
+     */
+    std::unique_ptr<DBClientConnection> createClient() const {
+        return _createClientFn();
+    }
+
     int getRetryingOperationsCount(WithLock lk) {
         return _retryingOperationsCount;
     }
@@ -184,6 +200,9 @@ private:
     // Rollback ID at start of initial sync.
     const int _rollBackId;
 
+    // Makes the clients for the sync source.
+    const CreateClientFn _createClientFn;
+
     /**
      * This object must be locked when accessing the members below.
      */
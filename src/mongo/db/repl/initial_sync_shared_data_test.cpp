@@ -39,7 +39,7 @@ namespace repl {
 TEST(InitialSyncSharedDataTest, SingleFailedOperation) {
     Days timeout(1);
     ClockSourceMock clock;
-    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock);
+    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock, nullptr /* createClientFn */);
 
     stdx::unique_lock<InitialSyncSharedData> lk(data);
     // No current outage.
@@ -74,7 +74,7 @@ TEST(InitialSyncSharedDataTest, SingleFailedOperation) {
 TEST(InitialSyncSharedDataTest, SequentialFailedOperations) {
     Days timeout(1);
     ClockSourceMock clock;
-    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock);
+    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock, nullptr /* createClientFn */);
 
     stdx::unique_lock<InitialSyncSharedData> lk(data);
     // No current outage.
@@ -136,7 +136,7 @@ TEST(InitialSyncSharedDataTest, SequentialFailedOperations) {
 TEST(InitialSyncSharedDataTest, OverlappingFailedOperations) {
     Days timeout(1);
     ClockSourceMock clock;
-    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock);
+    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock, nullptr /* createClientFn */);
 
     stdx::unique_lock<InitialSyncSharedData> lk(data);
     // No current outage.
@@ -194,7 +194,7 @@ TEST(InitialSyncSharedDataTest, OverlappingFailedOperations) {
 TEST(InitialSyncSharedDataTest, OperationTimesOut) {
     Seconds timeout(5);
     ClockSourceMock clock;
-    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock);
+    InitialSyncSharedData data(1 /* rollBackId */, timeout, &clock, nullptr /* createClientFn */);
 
     InitialSyncSharedData::RetryableOperation op1;
     InitialSyncSharedData::RetryableOperation op2;
@@ -1137,7 +1137,8 @@ void InitialSyncer::_fcvFetcherCallback(const StatusWith<Fetcher::QueryResponse>
     _sharedData =
         std::make_unique<InitialSyncSharedData>(_rollbackChecker->getBaseRBID(),
                                                 _allowedOutageDuration,
-                                                getGlobalServiceContext()->getFastClockSource());
+                                                getGlobalServiceContext()->getFastClockSource(),
+                                                _createClientFn);
     _client = _createClientFn();
     _initialSyncState = std::make_unique<InitialSyncState>(std::make_unique<AllDatabaseCloner>(
         _sharedData.get(), _syncSource, _client.get(), _storage, _writerPool));
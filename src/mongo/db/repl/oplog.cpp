@@ -57,6 +57,7 @@
 #include "mongo/db/catalog/import_collection_oplog_entry_gen.h"
 #include "mongo/db/catalog/multi_index_block.h"
 #include "mongo/db/catalog/rename_collection.h"
+#include "mongo/db/change_stream_pre_images_collection.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands.h"
 #include "mongo/db/commands/feature_compatibility_version_parser.h"
@@ -1002,6 +1003,31 @@ const StringMap<ApplyOpMetadata> kOpsMap = {
      }}},
 };
 
+/**
+ * If the primary recorded the pre-image of the update or delete 'op' in the pre-images collection,
+ * records the current version of the document matching 'idQuery' as its pre-image on this node.
+ * Must be called inside the WriteUnitOfWork which applies 'op', before applying it. During initial
+ * sync the data being applied to may be ahead of 'op', so no pre-image is recorded.
+ */
+void recordPreImageIfNeeded(OperationContext* opCtx,
+                            const CollectionPtr& collection,
+                            const OplogEntry& op,
+                            const BSONObj& idQuery,
+                            OplogApplication::Mode mode) {
+    if (!op.getPreImageRecorded().value_or(false) || !op.getUuid() || !collection ||
+        (mode != OplogApplication::Mode::kSecondary &&
+         mode != OplogApplication::Mode::kRecovering)) {
+        return;
+    }
+
+    auto recordId = Helpers::findById(opCtx, collection, idQuery);
+    if (recordId.isNull()) {
+        return;
+    }
+    change_stream_pre_images::insertPreImage(
+        opCtx, *op.getUuid(), op.getTimestamp(), collection->docFor(opCtx, recordId).value());
+}
+
 }  // namespace
 
 constexpr StringData OplogApplication::kInitialSyncOplogApplicationMode;
@@ -1403,6 +1429,7 @@ Status applyOperation_inlock(OperationContext* opCtx,
                 if (timestamp != Timestamp::min()) {
                     uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(timestamp));
                 }
+                recordPreImageIfNeeded(opCtx, collection, op, updateCriteria, mode);
 
                 UpdateResult ur = update(opCtx, db, request);
                 if (ur.numMatched == 0 && ur.upsertedId.isEmpty()) {
@@ -1514,6 +1541,7 @@ Status applyOperation_inlock(OperationContext* opCtx,
                 if (timestamp != Timestamp::min()) {
                     uassertStatusOK(opCtx->recoveryUnit()->setTimestamp(timestamp));
                 }
+                recordPreImageIfNeeded(opCtx, collection, op, deleteCriteria, mode);
                 auto nDeleted = deleteObjects(
                     opCtx, collection, requestNss, deleteCriteria, true /* justOne */);
                 if (nDeleted == 0 && mode == OplogApplication::Mode::kSecondary) {
@@ -0,0 +1,275 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <deque>
+
+#include "mongo/db/repl/oplog_applier_impl_test_fixture.h"
+#include "mongo/db/repl/oplog_batcher.h"
+#include "mongo/db/repl/oplog_buffer_blocking_queue.h"
+#include "mongo/db/repl/oplog_entry_test_helpers.h"
+#include "mongo/db/repl/replication_coordinator.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/db/update/update_oplog_entry_serialization.h"
+#include "mongo/platform/random.h"
+#include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace repl {
+namespace {
+
+const NamespaceString kNss("test", "oplog_application_bm");
+
+// The number of documents the updates are spread over, and the number of operations applied by
+// each iteration of the benchmarks.
+constexpr int64_t kNumPreloadedDocs = 10 * 1000;
+constexpr int64_t kNumOpsPerIteration = 10 * 1000;
+
+/**
+ * Generates a stream of oplog entries against one collection: inserts of new documents, $v:2
+ * updates of preloaded documents, deletes of the documents inserted by the stream, and applyOps
+ * commands inserting a few documents each. The updates favour the preloaded documents with the
+ * lowest _ids, so that some writer threads get more work than others.
+ */
+class SyntheticOplogStream {
+public:
+    explicit SyntheticOplogStream(UUID uuid) : _uuid(std::move(uuid)) {}
+
+    std::vector<BSONObj> preload() {
+        std::vector<BSONObj> ops;
+        for (int64_t id = 0; id < kNumPreloadedDocs; ++id) {
+            ops.push_back(_makeInsert(id));
+        }
+        return ops;
+    }
+
+    std::vector<BSONObj> next(int64_t numOps) {
+        std::vector<BSONObj> ops;
+        for (int64_t i = 0; i < numOps; ++i) {
+            const auto choice = _random.nextInt32(100);
+            if (choice < 45) {
+                ops.push_back(_makeInsert(_insertNew()));
+            } else if (choice < 85) {
+                ops.push_back(_makeUpdate());
+            } else if (choice < 95 && !_insertedIds.empty()) {
+                ops.push_back(_makeDelete());
+            } else {
+                ops.push_back(_makeApplyOps());
+            }
+        }
+        return ops;
+    }
+
+private:
+    OpTime _nextOpTime() {
+        return OpTime(Timestamp(Seconds(_nextSecond++), 0), 1LL);
+    }
+
+    BSONObj _makeDocument(int64_t id) {
+        return BSON("_id" << id << "counter" << 0 << "payload" << std::string(100, 'x'));
+    }
+
+    int64_t _insertNew() {
+        _insertedIds.push_back(_nextId);
+        return _nextId++;
+    }
+
+    BSONObj _makeCrudOp(OpTypeEnum opType, BSONObj o, boost::optional<BSONObj> o2 = boost::none) {
+        return makeOplogEntry(_nextOpTime(),
+                              opType,
+                              kNss,
+                              std::move(o),
+                              std::move(o2),
+                              {} /* sessionInfo */,
+                              Date_t::now(),
+                              {} /* stmtIds */,
+                              _uuid)
+            .getEntry()
+            .toBSON();
+    }
+
+    BSONObj _makeInsert(int64_t id) {
+        return _makeCrudOp(OpTypeEnum::kInsert, _makeDocument(id));
+    }
+
+    BSONObj _makeUpdate() {
+        const auto id =
+            static_cast<int64_t>(kNumPreloadedDocs * std::pow(_random.nextCanonicalDouble(), 3));
+        return _makeCrudOp(OpTypeEnum::kUpdate,
+                           update_oplog_entry::makeDeltaOplogEntry(
+                               BSON("u" << BSON("counter" << _random.nextInt64()))),
+                           BSON("_id" << id));
+    }
+
+    BSONObj _makeDelete() {
+        const auto id = _insertedIds.front();
+        _insertedIds.pop_front();
+        return _makeCrudOp(OpTypeEnum::kDelete, BSON("_id" << id));
+    }
+
+    BSONObj _makeApplyOps() {
+        BSONArrayBuilder applyOps;
+        for (int i = 0; i < 4; ++i) {
+            applyOps.append(BSON("op"
+                                 << "i"
+                                 << "ns" << kNss.ns() << "ui" << _uuid << "o"
+                                 << _makeDocument(_insertNew())));
+        }
+        return makeCommandOplogEntry(_nextOpTime(), kNss, BSON("applyOps" << applyOps.arr()))
+            .getEntry()
+            .toBSON();
+    }
+
+    const UUID _uuid;
+    PseudoRandom _random{int64_t{1234}};
+    long long _nextSecond = 2;
+    int64_t _nextId = kNumPreloadedDocs;
+    std::deque<int64_t> _insertedIds;
+};
+
+/**
+ * Applies synthetic oplog streams as a secondary would, batching them with the OplogBatcher and
+ * applying the batches with OplogApplierImpl on WiredTiger, using a given number of writer threads.
+ */
+class OplogApplicationBenchmark : public OplogApplierImplTest {
+public:
+    explicit OplogApplicationBenchmark(int numWriterThreads)
+        : OplogApplierImplTest("wiredTiger"), _numWriterThreads(numWriterThreads) {}
+
+    void setUp() override {
+        OplogApplierImplTest::setUp();
+        _replCoord = ReplicationCoordinator::get(_opCtx.get());
+        ASSERT_OK(_replCoord->setFollowerMode(MemberState::RS_SECONDARY));
+
+        _writerPool = makeReplWriterPool(_numWriterThreads);
+        _applier = std::make_unique<OplogApplierImpl>(
+            nullptr /* executor */,
+            &_buffer,
+            &_observer,
+            _replCoord,
+            getConsistencyMarkers(),
+            getStorageInterface(),
+            OplogApplier::Options(OplogApplication::Mode::kSecondary),
+            _writerPool.get());
+
+        _stream.emplace(createCollectionWithUuid(_opCtx.get(), kNss));
+        apply(_stream->preload());
+    }
+
+    void tearDown() override {
+        _applier.reset();
+        _writerPool->shutdown();
+        _writerPool->join();
+        OplogApplierImplTest::tearDown();
+    }
+
+    SyntheticOplogStream& stream() {
+        return *_stream;
+    }
+
+    /**
+     * Applies 'ops' one batch at a time and returns how long each batch took, in microseconds.
+     */
+    std::vector<long long> apply(std::vector<BSONObj> ops) {
+        _buffer.push(_opCtx.get(), ops.cbegin(), ops.cend());
+
+        OplogBatcher::BatchLimits batchLimits;
+        batchLimits.ops = getBatchLimitOplogEntries();
+        batchLimits.bytes = getBatchLimitOplogBytes(_opCtx.get(), getStorageInterface());
+
+        std::vector<long long> batchMicros;
+        while (!_buffer.isEmpty()) {
+            Timer timer;
+            auto batch =
+                uassertStatusOK(_applier->getNextApplierBatch(_opCtx.get(), batchLimits));
+            const auto lastApplied =
+                uassertStatusOK(_applier->applyOplogBatch(_opCtx.get(), std::move(batch)));
+
+            // Make the batch visible, as the end of each batch does on a secondary.
+            getStorageInterface()->oplogDiskLocRegister(
+                _opCtx.get(), lastApplied.getTimestamp(), true /* orderedCommit */);
+            _replCoord->setMyLastAppliedOpTimeAndWallTime({lastApplied, Date_t::now()});
+            batchMicros.push_back(timer.micros());
+        }
+        return batchMicros;
+    }
+
+private:
+    void _doTest() override {}
+
+    const int _numWriterThreads;
+    ReplicationCoordinator* _replCoord = nullptr;
+    OplogBufferBlockingQueue _buffer;
+    NoopOplogApplierObserver _observer;
+    std::unique_ptr<ThreadPool> _writerPool;
+    std::unique_ptr<OplogApplierImpl> _applier;
+    boost::optional<SyntheticOplogStream> _stream;
+};
+
+/**
+ * Reports the number of oplog entries applied per second, and as a measure of the lag of a
+ * secondary applying the stream, how long the batches took to apply on average and at most.
+ */
+void BM_ApplyOplog(benchmark::State& state) {
+    OplogApplicationBenchmark fixture(state.range(0));
+    fixture.setUp();
+
+    long long numBatches = 0;
+    long long totalBatchMicros = 0;
+    long long maxBatchMicros = 0;
+    for (auto keepRunning : state) {
+        state.PauseTiming();
+        auto ops = fixture.stream().next(kNumOpsPerIteration);
+        state.ResumeTiming();
+
+        for (auto micros : fixture.apply(std::move(ops))) {
+            ++numBatches;
+            totalBatchMicros += micros;
+            maxBatchMicros = std::max(maxBatchMicros, micros);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kNumOpsPerIteration);
+    if (numBatches) {
+        state.counters["meanBatchMicros"] = double(totalBatchMicros) / numBatches;
+        state.counters["maxBatchMicros"] = maxBatchMicros;
+    }
+
+    fixture.tearDown();
+}
+
+// The writer threads do the work, so the benchmark is timed on the wall clock.
+BENCHMARK(BM_ApplyOplog)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace repl
+}  // namespace mongo
@@ -40,6 +40,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbhelpers.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/repl/apply_ops.h"
 #include "mongo/db/repl/oplog_applier_utils.h"
@@ -73,6 +74,11 @@ ServerStatusMetricField<Counter64> displayOplogApplicationBatchSize("repl.apply.
 TimerStats applyBatchStats;
 ServerStatusMetricField<TimerStats> displayOpBatchesApplied("repl.apply.batches", &applyBatchStats);
 
+// The documents read ahead of the writer threads, see prefetchDocuments().
+Counter64 prefetchedDocsStats;
+ServerStatusMetricField<Counter64> displayPrefetchedDocs("repl.apply.prefetchedDocs",
+                                                         &prefetchedDocsStats);
+
 /**
  * Used for logging a report of ops that take longer than "slowMS" to apply. This is called
  * right before returning from applyOplogEntryOrGroupedInserts, and it returns the same status.
@@ -115,6 +121,7 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
                                       std::vector<std::vector<OplogEntry>>* derivedOps,
                                       OplogEntry* op,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssigner* writerAssigner,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors) {
     std::vector<OplogEntry> txnOps;
     bool shouldSerialize = false;
@@ -124,8 +131,51 @@ void _addOplogChainOpsToWriterVectors(OperationContext* opCtx,
     partialTxnList->clear();
 
     // Transaction entries cannot have different session updates.
-    OplogApplierUtils::addDerivedOps(
-        opCtx, &derivedOps->back(), writerVectors, collPropertiesCache, shouldSerialize);
+    OplogApplierUtils::addDerivedOps(opCtx,
+                                     &derivedOps->back(),
+                                     writerVectors,
+                                     collPropertiesCache,
+                                     writerAssigner,
+                                     shouldSerialize);
+}
+
+/**
+ * Reads the documents targeted by the updates and deletes in 'ops', through the _id index, so that
+ * the writer threads applying them find the index and collection pages in the storage engine
+ * cache. This is only a hint to the storage engine, so all errors are ignored.
+ */
+void prefetchDocuments(OperationContext* opCtx, const std::vector<const OplogEntry*>& ops) {
+    // Like the writer threads, read through the PBWM lock held by the applier and ignore prepare
+    // conflicts, which may occur on secondaries but did not on the primary.
+    opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
+    opCtx->lockState()->setTicketPriority(TicketPriority::kImmediate);
+    opCtx->recoveryUnit()->setPrepareConflictBehavior(PrepareConflictBehavior::kIgnoreConflicts);
+
+    for (auto op : ops) {
+        const auto opType = op->getOpType();
+        if (opType != OpTypeEnum::kUpdate && opType != OpTypeEnum::kDelete) {
+            continue;
+        }
+        try {
+            const auto idElement = op->getIdElement();
+            if (idElement.eoo()) {
+                continue;
+            }
+            AutoGetCollection autoColl(
+                opCtx, OplogApplierUtils::getNsOrUUID(op->getNss(), *op), MODE_IS);
+            const auto& collection = autoColl.getCollection();
+            if (!collection || !collection->getIndexCatalog()->findIdIndex(opCtx)) {
+                continue;
+            }
+            const auto rid = Helpers::findById(opCtx, collection, idElement.wrap());
+            Snapshotted<BSONObj> doc;
+            if (!rid.isNull() && collection->findDoc(opCtx, rid, &doc)) {
+                prefetchedDocsStats.increment();
+            }
+        } catch (const DBException&) {
+        }
+        opCtx->recoveryUnit()->abandonSnapshot();
+    }
 }
 
 }  // namespace
@@ -260,6 +310,9 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
     // arbiterOnly field for any member.
     invariant(!_replCoord->getMemberState().arbiter());
 
+    _pipelineBatches = getOptions().mode == OplogApplication::Mode::kSecondary &&
+        !getOptions().skipWritesToOplog;
+
     std::unique_ptr<ApplyBatchFinalizer> finalizer{
         getGlobalServiceContext()->getStorageEngine()->isDurable()
             ? new ApplyBatchFinalizerForJournal(_replCoord)
@@ -289,7 +342,7 @@ void OplogApplierImpl::_run(OplogBuffer* oplogBuffer) {
 
         // Blocks up to a second waiting for a batch to be ready to apply. If one doesn't become
         // ready in time, we'll loop again so we can do the above checks periodically.
-        OplogBatch ops = _oplogBatcher->getNextBatch(Seconds(1));
+        OplogBatch ops = _getNextBatch(Seconds(1));
         if (ops.empty()) {
             if (ops.mustShutdown()) {
                 // Shut down and exit oplog application loop.
@@ -429,9 +482,39 @@ void scheduleWritesToOplog(OperationContext* opCtx,
     }
 }
 
+OplogBatch OplogApplierImpl::_getNextBatch(Seconds maxWaitTime) {
+    if (!_nextBatch) {
+        return _oplogBatcher->getNextBatch(maxWaitTime);
+    }
+
+    OplogBatch batch = std::move(*_nextBatch);
+    _nextBatch = boost::none;
+    _batchWrittenToOplog = std::exchange(_nextBatchWrittenToOplog, false);
+    return batch;
+}
+
+void OplogApplierImpl::_prefetchNextBatch(OperationContext* opCtx,
+                                          const OplogEntry& lastOpInBatch) {
+    invariant(!_nextBatch);
+
+    // An empty batch may still carry the shutdown or drain signals, so it is kept as well and
+    // handled by _run() like any other batch.
+    _nextBatch.emplace(_oplogBatcher->getNextBatch(Seconds(0)));
+    if (_nextBatch->empty()) {
+        return;
+    }
+
+    // The entries of the current batch are all in the oplog, so only the entries of the next
+    // batch can leave holes if we crash before they are written.
+    _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, lastOpInBatch.getTimestamp());
+    scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, _nextBatch->getBatch());
+    _nextBatchWrittenToOplog = true;
+}
+
 StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                                                       std::vector<OplogEntry> ops) {
     invariant(!ops.empty());
+    const bool writtenToOplog = std::exchange(_batchWrittenToOplog, false);
 
     LOGV2_DEBUG(21230,
                 2,
@@ -462,8 +545,9 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         // because the spawned threads refer to objects on the stack
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
-        // Write batch of ops into oplog.
-        if (!getOptions().skipWritesToOplog) {
+        // Write batch of ops into oplog, unless that was already done while applying the previous
+        // batch.
+        if (!getOptions().skipWritesToOplog && !writtenToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(
                 opCtx, _replCoord->getMyLastAppliedOpTime().getTimestamp());
             scheduleWritesToOplog(opCtx, _storageInterface, _writerPool, ops);
@@ -482,7 +566,30 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _writerPool->getStats().options.maxThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
-        // Wait for writes to finish before applying ops.
+        // Read the documents the batch updates and deletes while its entries are written to the
+        // oplog. Each prefetcher takes the ops of every n-th writer.
+        const auto numPrefetchers = std::min<size_t>(
+            replBatchPrefetchConcurrency.load(), _writerPool->getStats().options.maxThreads);
+        for (size_t i = 0; i < numPrefetchers; i++) {
+            _writerPool->schedule([&writerVectors, i, numPrefetchers](auto scheduleStatus) {
+                invariant(scheduleStatus);
+
+                std::vector<const OplogEntry*> prefetchOps;
+                for (size_t j = i; j < writerVectors.size(); j += numPrefetchers) {
+                    prefetchOps.insert(
+                        prefetchOps.end(), writerVectors[j].begin(), writerVectors[j].end());
+                }
+                if (prefetchOps.empty()) {
+                    return;
+                }
+
+                auto opCtx = cc().makeOperationContext();
+                opCtx->runWithoutInterruptionExceptAtGlobalShutdown(
+                    [&] { prefetchDocuments(opCtx.get(), prefetchOps); });
+            });
+        }
+
+        // Wait for writes and prefetching to finish before applying ops.
         _writerPool->waitForIdle();
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
@@ -531,6 +638,12 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
                     });
             }
 
+            // Let the writers that finish this batch early start writing the next batch to the
+            // oplog instead of waiting for the slowest writer.
+            if (_pipelineBatches && replPipelinedBatchApplication.load()) {
+                _prefetchNextBatch(opCtx, ops.back());
+            }
+
             _writerPool->waitForIdle();
 
             // If any of the statuses is not ok, return error.
@@ -607,13 +720,15 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
  *      and instructions for updating the transactions table.  Required if processing oplogs
  *      with transactions.
  * sessionUpdateTracker - if provided, keeps track of session info from ops.
+ * writerAssigner - selects the writer of each op; shared by all calls for the same batch.
  */
 void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
     OperationContext* opCtx,
     std::vector<OplogEntry>* ops,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps,
-    SessionUpdateTracker* sessionUpdateTracker) noexcept {
+    SessionUpdateTracker* sessionUpdateTracker,
+    WriterAssigner* writerAssigner) noexcept {
 
     LogicalSessionIdMap<std::vector<OplogEntry*>> partialTxnOps;
     CachedCollectionProperties collPropertiesCache;
@@ -636,6 +751,7 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
+                                                 writerAssigner,
                                                  false /*serial*/);
             }
         }
@@ -672,8 +788,13 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                 // oplog and fill writers with those operations.
                 // Flush partialTxnList operations for current transaction.
                 auto& partialTxnList = partialTxnOps[*logicalSessionId];
-                _addOplogChainOpsToWriterVectors(
-                    opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+                _addOplogChainOpsToWriterVectors(opCtx,
+                                                 &partialTxnList,
+                                                 derivedOps,
+                                                 &op,
+                                                 &collPropertiesCache,
+                                                 writerAssigner,
+                                                 writerVectors);
             } else {
                 // The applyOps entry was not generated as part of a transaction.
                 invariant(!op.getPrevWriteOpTimeInTransaction());
@@ -685,6 +806,7 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
                                                  &derivedOps->back(),
                                                  writerVectors,
                                                  &collPropertiesCache,
+                                                 writerAssigner,
                                                  false /*serial*/);
             }
             continue;
@@ -696,8 +818,13 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
         if (op.isPreparedCommit() && (getOptions().mode == OplogApplication::Mode::kInitialSync)) {
             auto logicalSessionId = op.getSessionId();
             auto& partialTxnList = partialTxnOps[*logicalSessionId];
-            _addOplogChainOpsToWriterVectors(
-                opCtx, &partialTxnList, derivedOps, &op, &collPropertiesCache, writerVectors);
+            _addOplogChainOpsToWriterVectors(opCtx,
+                                             &partialTxnList,
+                                             derivedOps,
+                                             &op,
+                                             &collPropertiesCache,
+                                             writerAssigner,
+                                             writerVectors);
             continue;
         }
 
@@ -705,8 +832,12 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
         // migration and access blocker states.
         if (op.getNss() == NamespaceString::kTenantMigrationDonorsNamespace ||
             op.getNss() == NamespaceString::kTenantMigrationRecipientsNamespace) {
-            auto writerId = OplogApplierUtils::addToWriterVector(
-                opCtx, &op, writerVectors, &collPropertiesCache, tenantMigrationsWriterId);
+            auto writerId = OplogApplierUtils::addToWriterVector(opCtx,
+                                                                 &op,
+                                                                 writerVectors,
+                                                                 &collPropertiesCache,
+                                                                 writerAssigner,
+                                                                 tenantMigrationsWriterId);
             if (!tenantMigrationsWriterId) {
                 tenantMigrationsWriterId.emplace(writerId);
             } else {
@@ -714,7 +845,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
             }
             continue;
         }
-        OplogApplierUtils::addToWriterVector(opCtx, &op, writerVectors, &collPropertiesCache);
+        OplogApplierUtils::addToWriterVector(
+            opCtx, &op, writerVectors, &collPropertiesCache, writerAssigner);
     }
 }
 
@@ -724,14 +856,18 @@ void OplogApplierImpl::fillWriterVectors(
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     std::vector<std::vector<OplogEntry>>* derivedOps) noexcept {
 
+    // The session table writes flushed at the end of the batch may update documents already
+    // written earlier in the batch, so both passes must share the same writer assignments.
+    WriterAssigner writerAssigner(replWriterBalancedAssignment.load());
     SessionUpdateTracker sessionUpdateTracker;
-    _deriveOpsAndFillWriterVectors(opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker);
+    _deriveOpsAndFillWriterVectors(
+        opCtx, ops, writerVectors, derivedOps, &sessionUpdateTracker, &writerAssigner);
 
     auto newOplogWrites = sessionUpdateTracker.flushAll();
     if (!newOplogWrites.empty()) {
         derivedOps->emplace_back(std::move(newOplogWrites));
         _deriveOpsAndFillWriterVectors(
-            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr);
+            opCtx, &derivedOps->back(), writerVectors, derivedOps, nullptr, &writerAssigner);
     }
 }
 
@@ -800,6 +936,10 @@ Status OplogApplierImpl::applyOplogBatchPerWorker(OperationContext* opCtx,
     // destroyed by unstash in its destructor. Thus we set the flag explicitly.
     opCtx->lockState()->setShouldConflictWithSecondaryBatchApplication(false);
 
+    // Secondaries falling behind because user reads hold all the tickets would only make matters
+    // worse, so oplog application does not queue for tickets.
+    opCtx->lockState()->setTicketPriority(TicketPriority::kImmediate);
+
     // Ensure future transactions read without a timestamp.
     invariant(RecoveryUnit::ReadSource::kNoTimestamp ==
               opCtx->recoveryUnit()->getTimestampReadSource());
@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/replication_state_transition_lock_guard.h"
 #include "mongo/db/repl/initial_syncer.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/replication_consistency_markers.h"
 #include "mongo/db/repl/replication_coordinator.h"
 #include "mongo/db/repl/replication_metrics.h"
@@ -102,11 +103,27 @@ private:
      */
     StatusWith<OpTime> _applyOplogBatch(OperationContext* opCtx, std::vector<OplogEntry> ops);
 
+    /**
+     * Returns the batch prefetched while applying the previous batch, if any, or else waits up to
+     * 'maxWaitTime' for the next batch from the OplogBatcher.
+     */
+    OplogBatch _getNextBatch(Seconds maxWaitTime);
+
+    /**
+     * Takes the next batch from the OplogBatcher without waiting and schedules the writes of its
+     * entries to the oplog on the writer pool, behind the application of the current batch whose
+     * last entry is 'lastOpInBatch'. Must be called with the current batch's entries already
+     * written to the oplog, and the caller must wait for the writer pool to become idle before
+     * releasing the PBWM lock.
+     */
+    void _prefetchNextBatch(OperationContext* opCtx, const OplogEntry& lastOpInBatch);
+
     void _deriveOpsAndFillWriterVectors(OperationContext* opCtx,
                                         std::vector<OplogEntry>* ops,
                                         std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                         std::vector<std::vector<OplogEntry>>* derivedOps,
-                                        SessionUpdateTracker* sessionUpdateTracker) noexcept;
+                                        SessionUpdateTracker* sessionUpdateTracker,
+                                        WriterAssigner* writerAssigner) noexcept;
 
     // Not owned by us.
     ReplicationCoordinator* const _replCoord;
@@ -123,6 +140,19 @@ private:
     // we will apply all operations that were fetched.
     OpTime _beginApplyingOpTime = OpTime();
 
+    // Set by _run() when batches may be pipelined, which is only the case during steady state
+    // replication when we write to the oplog.
+    bool _pipelineBatches = false;
+
+    // The batch prefetched by _prefetchNextBatch() to be applied next, and whether its entries
+    // have already been written to the oplog.
+    boost::optional<OplogBatch> _nextBatch;
+    bool _nextBatchWrittenToOplog = false;
+
+    // Whether the entries of the batch being applied were written to the oplog while the previous
+    // batch was being applied.
+    bool _batchWrittenToOplog = false;
+
     void fillWriterVectors(OperationContext* opCtx,
                            std::vector<OplogEntry>* ops,
                            std::vector<std::vector<const OplogEntry*>>* writerVectors,
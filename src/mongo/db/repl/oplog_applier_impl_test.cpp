@@ -56,6 +56,7 @@
 #include "mongo/db/repl/idempotency_test_fixture.h"
 #include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/oplog_applier.h"
+#include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/oplog_entry_test_helpers.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/replication_coordinator.h"
@@ -535,6 +536,35 @@ TEST_F(OplogApplierImplTest,
                   secondDerivedOp.getObject()["lastWriteOpTime"]["ts"].timestamp());
 }
 
+TEST(WriterAssignerTest, CollidingHashesAreSpreadAcrossWriters) {
+    std::vector<std::vector<const OplogEntry*>> writerVectors(4);
+    WriterAssigner writerAssigner;
+
+    // Hashes 1 and 5 both select writer 1 by modulo, so the second one must go elsewhere.
+    auto first = writerAssigner.assign(1, writerVectors);
+    ASSERT_EQ(1U, first);
+    writerVectors[first].push_back(nullptr);
+    auto second = writerAssigner.assign(5, writerVectors);
+    ASSERT_NE(first, second);
+    writerVectors[second].push_back(nullptr);
+
+    // Entries with a hash already seen in the batch always stay on the same writer, regardless of
+    // how loaded it is.
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(first, writerAssigner.assign(1, writerVectors));
+        writerVectors[first].push_back(nullptr);
+    }
+    ASSERT_EQ(second, writerAssigner.assign(5, writerVectors));
+}
+
+TEST(WriterAssignerTest, UnbalancedAssignmentUsesHashModulo) {
+    std::vector<std::vector<const OplogEntry*>> writerVectors(4);
+    WriterAssigner writerAssigner(false /* balance */);
+    writerVectors[1].push_back(nullptr);
+    ASSERT_EQ(1U, writerAssigner.assign(1, writerVectors));
+    ASSERT_EQ(1U, writerAssigner.assign(5, writerVectors));
+}
+
 class MultiOplogEntryOplogApplierImplTest : public OplogApplierImplTest {
 public:
     MultiOplogEntryOplogApplierImplTest()
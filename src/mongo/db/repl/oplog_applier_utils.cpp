@@ -74,6 +74,30 @@ CachedCollectionProperties::getCollectionPropertiesImpl(OperationContext* opCtx,
     return collProperties;
 }
 
+uint32_t WriterAssigner::assign(uint32_t hash,
+                                const std::vector<std::vector<const OplogEntry*>>& writers) {
+    const uint32_t numWriters = writers.size();
+    if (!_balance || numWriters == 1) {
+        return hash % numWriters;
+    }
+
+    auto [it, inserted] = _writerByHash.try_emplace(hash, 0);
+    if (inserted) {
+        // The hash is new to this batch, so there is no earlier entry it must be ordered after.
+        // Start from the writer its hash selects so that lightly loaded batches are spread the
+        // same way as without balancing.
+        uint32_t writerId = hash % numWriters;
+        for (uint32_t i = 1; i < numWriters; ++i) {
+            const uint32_t candidate = (hash + i) % numWriters;
+            if (writers[candidate].size() < writers[writerId].size()) {
+                writerId = candidate;
+            }
+        }
+        it->second = writerId;
+    }
+    return it->second;
+}
+
 void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
                                       OplogEntry* op,
                                       uint32_t* hash,
@@ -106,6 +130,7 @@ uint32_t OplogApplierUtils::addToWriterVector(
     OplogEntry* op,
     std::vector<std::vector<const OplogEntry*>>* writerVectors,
     CachedCollectionProperties* collPropertiesCache,
+    WriterAssigner* writerAssigner,
     boost::optional<uint32_t> forceWriterId) {
     auto hashedNs = StringMapHasher().hashed_key(op->getNss().ns());
 
@@ -118,7 +143,14 @@ uint32_t OplogApplierUtils::addToWriterVector(
         processCrudOp(opCtx, op, &hash, &hashedNs, collPropertiesCache);
 
     const uint32_t numWriters = writerVectors->size();
-    auto writerId = (forceWriterId ? *forceWriterId : hash) % numWriters;
+    uint32_t writerId;
+    if (forceWriterId) {
+        writerId = *forceWriterId % numWriters;
+    } else if (writerAssigner) {
+        writerId = writerAssigner->assign(hash, *writerVectors);
+    } else {
+        writerId = hash % numWriters;
+    }
     auto& writer = (*writerVectors)[writerId];
     if (writer.empty()) {
         writer.reserve(8);  // Skip a few growth rounds
@@ -148,13 +180,14 @@ void OplogApplierUtils::addDerivedOps(OperationContext* opCtx,
                                       std::vector<OplogEntry>* derivedOps,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssigner* writerAssigner,
                                       bool serial) {
     boost::optional<uint32_t>
         serialWriterId;  // Used to determine which writer vector to assign serial ops.
 
     for (auto&& op : *derivedOps) {
-        auto writerId =
-            addToWriterVector(opCtx, &op, writerVectors, collPropertiesCache, serialWriterId);
+        auto writerId = addToWriterVector(
+            opCtx, &op, writerVectors, collPropertiesCache, writerAssigner, serialWriterId);
         if (serial && !serialWriterId) {
             serialWriterId.emplace(writerId);
         }
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "mongo/db/repl/insert_group.h"
+#include "mongo/stdx/unordered_map.h"
 
 namespace mongo {
 class CollatorInterface;
@@ -58,6 +59,27 @@ private:
     StringMap<CollectionProperties> _cache;
 };
 
+/**
+ * Assigns the oplog entries of a single batch to writer vectors. Entries with the same hash are
+ * always assigned to the same writer, which preserves their relative order. When balancing is
+ * enabled, a hash not yet seen in the batch goes to the writer with the fewest entries so far
+ * rather than to 'hash % numWriters', so that the few hot documents of a skewed workload are
+ * spread across writers instead of colliding on one of them.
+ */
+class WriterAssigner {
+public:
+    explicit WriterAssigner(bool balance = true) : _balance(balance) {}
+
+    /**
+     * Returns the index of the writer vector that the entry with the given hash must be added to.
+     */
+    uint32_t assign(uint32_t hash, const std::vector<std::vector<const OplogEntry*>>& writers);
+
+private:
+    const bool _balance;
+    stdx::unordered_map<uint32_t, uint32_t> _writerByHash;
+};
+
 /**
  * This class contains some static methods common to ordinary oplog application and oplog
  * application as part of tenant migration.
@@ -85,12 +107,14 @@ public:
 
     /**
      * Adds a single oplog entry to the appropriate writer vector.  Returns the index of the
-     * writer vector the entry was written to.
+     * writer vector the entry was written to. If 'writerAssigner' is null, the writer is selected
+     * by the hash of the entry alone.
      */
     static uint32_t addToWriterVector(OperationContext* opCtx,
                                       OplogEntry* op,
                                       std::vector<std::vector<const OplogEntry*>>* writerVectors,
                                       CachedCollectionProperties* collPropertiesCache,
+                                      WriterAssigner* writerAssigner,
                                       boost::optional<uint32_t> forceWriterId = boost::none);
     /**
      * Adds a set of derivedOps to writerVectors.
@@ -101,6 +125,7 @@ public:
                               std::vector<OplogEntry>* derivedOps,
                               std::vector<std::vector<const OplogEntry*>>* writerVectors,
                               CachedCollectionProperties* collPropertiesCache,
+                              WriterAssigner* writerAssigner,
                               bool serial);
 
     /**
@@ -282,8 +282,10 @@ void OplogBatcher::_run(StorageInterface* storageInterface) {
 
             auto oplogEntries =
                 fassertNoTrace(31004, getNextApplierBatch(opCtx.get(), batchLimits));
-            for (const auto& oplogEntry : oplogEntries) {
-                ops.emplace_back(oplogEntry);
+            // Move the entries rather than copying them, since each carries its own parsed
+            // fields in addition to the raw document it was parsed from.
+            for (auto& oplogEntry : oplogEntries) {
+                ops.emplace_back(std::move(oplogEntry));
             }
 
             // If we don't have anything in the batch, wait a bit for something to appear.
@@ -636,6 +636,10 @@ const boost::optional<mongo::repl::OpTime>& OplogEntry::getPreImageOpTime() cons
     return _entry.getPreImageOpTime();
 }
 
+const boost::optional<bool> OplogEntry::getPreImageRecorded() const {
+    return _entry.getPreImageRecorded();
+}
+
 const boost::optional<mongo::ShardId>& OplogEntry::getDestinedRecipient() const {
     return _entry.getDestinedRecipient();
 }
@@ -177,6 +177,10 @@ public:
         return getDurableReplOperation().getPreImageOpTime();
     }
 
+    void setPreImageRecorded(boost::optional<bool> value) & {
+        getDurableReplOperation().setPreImageRecorded(std::move(value));
+    }
+
     void setTimestamp(Timestamp value) & {
         getOpTimeBase().setTimestamp(std::move(value));
     }
@@ -233,6 +237,7 @@ public:
     using MutableOplogEntry::kOpTypeFieldName;
     using MutableOplogEntry::kPostImageOpTimeFieldName;
     using MutableOplogEntry::kPreImageOpTimeFieldName;
+    using MutableOplogEntry::kPreImageRecordedFieldName;
     using MutableOplogEntry::kPrevWriteOpTimeInTransactionFieldName;
     using MutableOplogEntry::kSessionIdFieldName;
     using MutableOplogEntry::kStatementIdsFieldName;
@@ -258,6 +263,7 @@ public:
     using MutableOplogEntry::getOpType;
     using MutableOplogEntry::getPostImageOpTime;
     using MutableOplogEntry::getPreImageOpTime;
+    using MutableOplogEntry::getPreImageRecorded;
     using MutableOplogEntry::getPrevWriteOpTimeInTransaction;
     using MutableOplogEntry::getSessionId;
     using MutableOplogEntry::getStatementIds;
@@ -473,6 +479,8 @@ public:
     static constexpr auto kOpTypeFieldName = DurableOplogEntry::kOpTypeFieldName;
     static constexpr auto kPostImageOpTimeFieldName = DurableOplogEntry::kPostImageOpTimeFieldName;
     static constexpr auto kPreImageOpTimeFieldName = DurableOplogEntry::kPreImageOpTimeFieldName;
+    static constexpr auto kPreImageRecordedFieldName =
+        DurableOplogEntry::kPreImageRecordedFieldName;
     static constexpr auto kPrevWriteOpTimeInTransactionFieldName =
         DurableOplogEntry::kPrevWriteOpTimeInTransactionFieldName;
     static constexpr auto kSessionIdFieldName = DurableOplogEntry::kSessionIdFieldName;
@@ -535,6 +543,7 @@ public:
     const boost::optional<mongo::BSONObj>& getObject2() const;
     const boost::optional<bool> getUpsert() const;
     const boost::optional<mongo::repl::OpTime>& getPreImageOpTime() const;
+    const boost::optional<bool> getPreImageRecorded() const;
     const boost::optional<mongo::ShardId>& getDestinedRecipient() const;
     const mongo::Timestamp& getTimestamp() const;
     const boost::optional<std::int64_t> getTerm() const;
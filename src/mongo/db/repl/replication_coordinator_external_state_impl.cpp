@@ -44,6 +44,7 @@
 #include "mongo/db/catalog/coll_mod.h"
 #include "mongo/db/catalog/database.h"
 #include "mongo/db/catalog/database_holder.h"
+#include "mongo/db/change_stream_pre_images_collection.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/feature_compatibility_version.h"
 #include "mongo/db/commands/server_status_metric.h"
@@ -211,6 +212,9 @@ bool ReplicationCoordinatorExternalStateImpl::isInitialSyncFlagSet(OperationCont
 // ReplicationCoordinatorImpl's mutex.
 void ReplicationCoordinatorExternalStateImpl::startSteadyStateReplication(
     OperationContext* opCtx, ReplicationCoordinator* replCoord) {
+    // The pre-images collection is not replicated, so every node creates it before it starts
+    // applying the oplog.
+    change_stream_pre_images::createPreImagesCollection(opCtx);
 
     stdx::lock_guard<Latch> lk(_threadMutex);
 
@@ -548,6 +552,8 @@ OpTime ReplicationCoordinatorExternalStateImpl::onTransitionToPrimary(OperationC
 
     IndexBuildsCoordinator::get(opCtx)->onStepUp(opCtx);
 
+    change_stream_pre_images::createPreImagesCollection(opCtx);
+
     notifyFreeMonitoringOnTransitionToPrimary();
 
     // It is only necessary to check the system indexes on the first transition to primary.
@@ -204,22 +204,43 @@ constexpr StringData kQuiesceModeShutdownMessage =
 
 }  // namespace
 
+ReplicationCoordinatorImpl::WaiterList::GroupKey
+ReplicationCoordinatorImpl::WaiterList::_getGroupKey(const Waiter& waiter) {
+    if (!waiter.writeConcern) {
+        return boost::none;
+    }
+    const auto& wc = *waiter.writeConcern;
+    return std::make_tuple(wc.wMode,
+                           wc.wNumNodes,
+                           static_cast<int>(wc.syncMode),
+                           static_cast<int>(wc.checkCondition));
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    auto key = _getGroupKey(*waiter);
+    _waiters[std::move(key)].emplace(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    add_inlock(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto groupIt = _waiters.find(_getGroupKey(*waiter));
+    if (groupIt == _waiters.end()) {
+        return false;
+    }
+    auto& queue = groupIt->second;
+    for (auto iter = queue.begin(); iter != queue.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            queue.erase(iter);
+            if (queue.empty()) {
+                _waiters.erase(groupIt);
+            }
             return true;
         }
     }
@@ -227,35 +248,63 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 }
 
 template <typename Func>
-void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
-                                                               boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
+void ReplicationCoordinatorImpl::WaiterList::_setValueIf_inlock(Func&& func,
+                                                                boost::optional<OpTime> opTime,
+                                                                bool stopAtFirst) {
+    for (auto groupIt = _waiters.begin(); groupIt != _waiters.end();) {
+        auto& queue = groupIt->second;
+        for (auto it = queue.begin(); it != queue.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (func(it->first, waiter)) {
+                    waiter->promise.emplaceValue();
+                    it = queue.erase(it);
+                } else if (stopAtFirst) {
+                    break;
+                } else {
+                    ++it;
+                }
+            } catch (const DBException& e) {
+                waiter->promise.setError(e.toStatus());
+                it = queue.erase(it);
             }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
+        }
+
+        if (queue.empty()) {
+            groupIt = _waiters.erase(groupIt);
+        } else {
+            ++groupIt;
         }
     }
 }
 
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
+                                                               boost::optional<OpTime> opTime) {
+    _setValueIf_inlock(std::forward<Func>(func), opTime, false /* stopAtFirst */);
+}
+
+template <typename Func>
+void ReplicationCoordinatorImpl::WaiterList::setValueIfSatisfied_inlock(
+    Func&& func, boost::optional<OpTime> opTime) {
+    _setValueIf_inlock(std::forward<Func>(func), opTime, true /* stopAtFirst */);
+}
+
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, queue] : _waiters) {
+        for (auto& [opTime, waiter] : queue) {
+            waiter->promise.emplaceValue();
+        }
     }
     _waiters.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, queue] : _waiters) {
+        for (auto& [opTime, waiter] : queue) {
+            waiter->promise.setError(status);
+        }
     }
     _waiters.clear();
 }
@@ -4666,7 +4715,9 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
 }
 
 void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<OpTime> opTime) {
-    _replicationWaiterList.setValueIf_inlock(
+    // A write concern which is satisfied at an opTime is satisfied at every earlier opTime, so
+    // once a waiter is not satisfied, neither are the later waiters with the same write concern.
+    _replicationWaiterList.setValueIfSatisfied_inlock(
         [this](const OpTime& opTime, const SharedWaiterHandle& waiter) {
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
@@ -31,6 +31,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -672,14 +674,32 @@ private:
         // condition in func.
         template <typename Func>
         void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        // Signals the waiters whose opTime is <= the given opTime (if any) that satisfy the
+        // condition in func, stopping at the first waiter of each write concern that does not. The
+        // condition must be monotonic in the opTime for a given write concern, so that a waiter
+        // which is not satisfied means none of the later waiters with its write concern are. This
+        // only visits the waiters that are signaled, plus one per write concern.
+        template <typename Func>
+        void setValueIfSatisfied_inlock(Func&& func,
+                                        boost::optional<OpTime> opTime = boost::none);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        // The parts of a write concern which decide the opTimes at which it is satisfied, or none
+        // for waiters without a write concern.
+        using GroupKey = boost::optional<std::tuple<std::string, int, int, int>>;
+        using WaiterQueue = std::multimap<OpTime, SharedWaiterHandle>;
+
+        static GroupKey _getGroupKey(const Waiter& waiter);
+
+        template <typename Func>
+        void _setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime, bool stopAtFirst);
+
+        // Waiters grouped by write concern, and sorted by OpTime within a group.
+        std::map<GroupKey, WaiterQueue> _waiters;
     };
 
     enum class HeartbeatState { kScheduled = 0, kSent = 1 };
@@ -1122,6 +1122,69 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, NodeWakesOnlyTheSatisfiedWaitersOfEachWriteConcern) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTimeWithTermOne time1(100, 2);
+    OpTimeWithTermOne time2(100, 3);
+    OpTimeWithTermOne time3(100, 4);
+    replCoordSetMyLastAppliedOpTime(time3, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time3, Date_t() + Seconds(100));
+
+    WriteConcernOptions twoNodes;
+    twoNodes.wTimeout = WriteConcernOptions::kNoTimeout;
+    twoNodes.wNumNodes = 2;
+    WriteConcernOptions threeNodes = twoNodes;
+    threeNodes.wNumNodes = 3;
+
+    // Waiters are registered out of opTime order, and interleave the two write concerns.
+    auto twoNodesTime3 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time3, twoNodes);
+    auto threeNodesTime2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time2, threeNodes);
+    auto twoNodesTime1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time1, twoNodes);
+    auto threeNodesTime1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time1, threeNodes);
+    auto twoNodesTime2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time2, twoNodes);
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 1, time2));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 1, time2));
+    ASSERT_TRUE(twoNodesTime1.isReady());
+    ASSERT_TRUE(twoNodesTime2.isReady());
+    ASSERT_FALSE(twoNodesTime3.isReady());
+    ASSERT_FALSE(threeNodesTime1.isReady());
+    ASSERT_FALSE(threeNodesTime2.isReady());
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time1));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 2, time1));
+    ASSERT_TRUE(threeNodesTime1.isReady());
+    ASSERT_FALSE(threeNodesTime2.isReady());
+    ASSERT_FALSE(twoNodesTime3.isReady());
+
+    ASSERT_OK(getReplCoord()->setLastAppliedOptime_forTest(2, 2, time3));
+    ASSERT_OK(getReplCoord()->setLastDurableOptime_forTest(2, 2, time3));
+    ASSERT_TRUE(threeNodesTime2.isReady());
+    ASSERT_TRUE(twoNodesTime3.isReady());
+
+    for (const auto& future :
+         {twoNodesTime1, twoNodesTime2, twoNodesTime3, threeNodesTime1, threeNodesTime2}) {
+        ASSERT_OK(future.getNoThrow());
+    }
+}
+
 
 TEST_F(ReplCoordTest, NodeCalculatesDefaultWriteConcernOnStartupExistingLocalConfigMajority) {
     assertStartSuccess(BSON("_id"
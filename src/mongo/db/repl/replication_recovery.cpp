@@ -648,10 +648,6 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
                                   OplogApplier::Options(OplogApplication::Mode::kRecovering),
                                   writerPool.get());
 
-    OplogApplier::BatchLimits batchLimits;
-    batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
-    batchLimits.ops = getBatchLimitOplogEntries();
-
     // If we're doing unstable checkpoints during the recovery process (as we do during the special
     // startupRecoveryForRestore mode), we need to advance the consistency marker for each batch so
     // the next time we recover we won't start all the way over.  Further, we can advance the oldest
@@ -665,6 +661,17 @@ Timestamp ReplicationRecoveryImpl::_applyOplogOperations(OperationContext* opCtx
         (recoveryMode == RecoveryMode::kStartupFromStableTimestamp ||
          recoveryMode == RecoveryMode::kStartupFromUnstableCheckpoint);
 
+    // Unless the end of each batch is a point recovery can resume from, batch boundaries only make
+    // the writer threads wait for each other, so batches may hold many more operations. The byte
+    // limit still bounds the memory they take.
+    OplogApplier::BatchLimits batchLimits;
+    batchLimits.bytes = getBatchLimitOplogBytes(opCtx, _storageInterface);
+    batchLimits.ops = getBatchLimitOplogEntries();
+    if (!advanceTimestampsEachBatch) {
+        batchLimits.ops =
+            std::max(batchLimits.ops, std::size_t(replRecoveryBatchLimitOperations.load()));
+    }
+
     OpTime applyThroughOpTime;
     std::vector<OplogEntry> batch;
     while (
@@ -61,7 +61,8 @@ public:
                             DBClientConnection* client,
                             StorageInterface* storageInterface,
                             ThreadPool* dbPool,
-                            StringData tenantId);
+                            StringData tenantId,
+                            ClientFactory clientFactory = {});
 
     virtual ~TenantAllDatabaseCloner() = default;
 
@@ -133,6 +134,10 @@ private:
     // The database name prefix of the tenant associated with this migration.
     std::string _tenantId;  // (R)
 
+    // Opens the connections of the collection cloners which run alongside others. May be empty,
+    // in which case the collections are cloned one at a time.
+    ClientFactory _clientFactory;  // (R)
+
     TenantAllDatabaseClonerStage _listDatabasesStage;          // (R)
     TenantAllDatabaseClonerStage _listExistingDatabasesStage;  // (R)
     TenantAllDatabaseClonerStage _initializeStatsStage;        // (R)
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "mongo/base/checked_cast.h"
 #include "mongo/db/repl/base_cloner.h"
 #include "mongo/db/repl/tenant_migration_shared_data.h"
@@ -38,6 +40,13 @@ namespace repl {
 
 class TenantBaseCloner : public BaseCloner {
 public:
+    /**
+     * Opens another connection to the donor at the given host, for a cloner which runs alongside
+     * the others, or throws if the migration is being canceled. The connection is owned by the
+     * caller of the cloners, which shuts it down when the migration is canceled.
+     */
+    using ClientFactory = std::function<DBClientConnection*(const HostAndPort&)>;
+
     TenantBaseCloner(StringData clonerName,
                      TenantMigrationSharedData* sharedData,
                      const HostAndPort& source,
@@ -36,11 +36,15 @@
 #include "mongo/db/dbdirectclient.h"
 #include "mongo/db/repl/cloner_utils.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/repl/tenant_collection_cloner.h"
 #include "mongo/db/repl/tenant_database_cloner.h"
 #include "mongo/db/repl/tenant_migration_decoration.h"
 #include "mongo/logv2/log.h"
 #include "mongo/rpc/get_status_from_command_result.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/stdx/unordered_set.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -56,14 +60,16 @@ TenantDatabaseCloner::TenantDatabaseCloner(const std::string& dbName,
                                            DBClientConnection* client,
                                            StorageInterface* storageInterface,
                                            ThreadPool* dbPool,
-                                           StringData tenantId)
+                                           StringData tenantId,
+                                           ClientFactory clientFactory)
     : TenantBaseCloner(
           "TenantDatabaseCloner"_sd, sharedData, source, client, storageInterface, dbPool),
       _dbName(dbName),
       _listCollectionsStage("listCollections", this, &TenantDatabaseCloner::listCollectionsStage),
       _listExistingCollectionsStage(
           "listExistingCollections", this, &TenantDatabaseCloner::listExistingCollectionsStage),
-      _tenantId(tenantId) {
+      _tenantId(tenantId),
+      _clientFactory(std::move(clientFactory)) {
     invariant(!dbName.empty());
     _stats.dbname = dbName;
 }
@@ -178,10 +184,8 @@ BaseCloner::AfterStageBehavior TenantDatabaseCloner::listExistingCollectionsStag
     tenantMigrationRecipientInfo(opCtx.get()) =
         boost::make_optional<TenantMigrationRecipientInfo>(getSharedData()->getMigrationId());
 
-    long long sizeOfCurrCollOnDisk = 0;
-    long long approxTotalDBSizeOnDisk = 0;
-
     std::vector<UUID> clonedCollectionUUIDs;
+    stdx::unordered_map<UUID, long long, UUID::Hash> clonedCollectionSizes;
     auto collectionInfos =
         client.getCollectionInfos(_dbName, ListCollectionsFilter::makeTypeCollectionFilter());
     for (auto&& info : collectionInfos) {
@@ -220,8 +224,8 @@ BaseCloner::AfterStageBehavior TenantDatabaseCloner::listExistingCollectionsStag
                           "tenantId"_attr = _tenantId,
                           "status"_attr = status);
         } else {
-            sizeOfCurrCollOnDisk = res.getField("size").safeNumberLong();
-            approxTotalDBSizeOnDisk += sizeOfCurrCollOnDisk;
+            clonedCollectionSizes[result.getInfo().getUuid()] =
+                res.getField("size").safeNumberLong();
         }
     }
 
@@ -234,30 +238,54 @@ BaseCloner::AfterStageBehavior TenantDatabaseCloner::listExistingCollectionsStag
     }
 
     // We are resuming, restart from the collection whose UUID compared greater than or equal to
-    // the last collection we have on disk.
+    // the last collection we have on disk. Both lists are in UUID order.
     if (!clonedCollectionUUIDs.empty()) {
         const auto& lastClonedCollectionUUID = clonedCollectionUUIDs.back();
-        const auto& startingCollection = std::lower_bound(
+        auto startingCollection = std::lower_bound(
             _collections.begin(),
             _collections.end(),
             lastClonedCollectionUUID,
             [](const auto& collection, const auto& uuid) { return collection.second.uuid < uuid; });
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            if (startingCollection != _collections.end() &&
-                startingCollection->second.uuid == lastClonedCollectionUUID) {
-                _stats.clonedCollectionsBeforeFailover = clonedCollectionUUIDs.size() - 1;
-
-                // When the last collection is partially cloned, we exclude it from the total size
-                // on disk, as the partially cloned collections stats will be added by the cloner
-                // on demand.
-                _stats.approxTotalBytesCopied = approxTotalDBSizeOnDisk - sizeOfCurrCollOnDisk;
-            } else {
-                _stats.clonedCollectionsBeforeFailover = clonedCollectionUUIDs.size();
-                _stats.approxTotalBytesCopied = approxTotalDBSizeOnDisk;
+
+        // A collection is only started once all the collections more than the collection cloner
+        // concurrency before it are cloned, so the collections on disk just before the last one
+        // may be partially cloned too. Cloning one of them again when it was finished only finds
+        // that there are no documents past its last one.
+        for (auto toRevisit = getSharedData()->getCollectionClonerConcurrency() - 1;
+             toRevisit > 0 && startingCollection != _collections.begin();) {
+            --startingCollection;
+            if (std::binary_search(clonedCollectionUUIDs.begin(),
+                                   clonedCollectionUUIDs.end(),
+                                   *startingCollection->second.uuid)) {
+                --toRevisit;
             }
         }
         _collections.erase(_collections.begin(), startingCollection);
+
+        // The collections which are cloned again are excluded from the collections cloned before
+        // the failover and from the bytes copied, as their stats will be added by their cloners
+        // on demand.
+        stdx::unordered_set<UUID, UUID::Hash> uuidsToClone;
+        for (const auto& collection : _collections) {
+            uuidsToClone.insert(*collection.second.uuid);
+        }
+        size_t clonedCollectionsBeforeFailover = 0;
+        long long approxTotalBytesCopied = 0;
+        for (const auto& uuid : clonedCollectionUUIDs) {
+            if (uuidsToClone.count(uuid)) {
+                continue;
+            }
+            clonedCollectionsBeforeFailover++;
+            if (auto size = clonedCollectionSizes.find(uuid); size != clonedCollectionSizes.end()) {
+                approxTotalBytesCopied += size->second;
+            }
+        }
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _stats.clonedCollectionsBeforeFailover = clonedCollectionsBeforeFailover;
+            _stats.approxTotalBytesCopied = approxTotalBytesCopied;
+        }
+
         if (!_collections.empty()) {
             LOGV2(5271601,
                   "Tenant DatabaseCloner resumes cloning",
@@ -290,63 +318,150 @@ void TenantDatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    const auto concurrency = _clientFactory
+        ? std::min(static_cast<size_t>(getSharedData()->getCollectionClonerConcurrency()),
+                   _collections.size())
+        : 1;
+    if (concurrency > 1) {
+        _cloneCollectionsConcurrently(concurrency);
+    } else {
+        for (size_t index = 0; index < _collections.size(); ++index) {
+            // Abort the tenant database cloner if the collection clone failed.
+            if (!_runCollectionCloner(index, getClient()).isOK())
+                return;
+        }
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_stats.clonedCollections == _collections.size()) {
+        _stats.end = getSharedData()->getClock()->now();
+    }
+}
+
+void TenantDatabaseCloner::_cloneCollectionsConcurrently(size_t concurrency) {
+    auto pool = makeReplWriterPool(static_cast<int>(concurrency),
+                                   "TenantCollectionCloner"_sd,
+                                   true /* isKillableByStepdown */);
+
+    auto mutex = MONGO_MAKE_LATCH("TenantDatabaseCloner::_cloneCollectionsConcurrently::mutex");
+    stdx::condition_variable finishedCollection;
+    // Whether each collection has been cloned, and the index of the first which has not.
+    std::vector<bool> cloned(_collections.size(), false);
+    size_t firstNotCloned = 0;
+    bool failed = false;
+    // The connections of the cloners which finished, to hand to the next ones.
+    std::vector<DBClientConnection*> idleClients{getClient()};
+
+    for (size_t index = 0; index < _collections.size(); ++index) {
+        DBClientConnection* client = nullptr;
         {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner =
-                std::make_unique<TenantCollectionCloner>(sourceNss,
-                                                         collectionOptions,
-                                                         getSharedData(),
-                                                         getSource(),
-                                                         getClient(),
-                                                         getStorageInterface(),
-                                                         getDBPool(),
-                                                         _tenantId);
+            // A collection is only started once all the collections more than 'concurrency'
+            // before it are cloned, which lets a resumed migration restart from the last
+            // 'concurrency' collections on disk. This also bounds the cloners running at once.
+            stdx::unique_lock<Latch> lk(mutex);
+            finishedCollection.wait(
+                lk, [&] { return failed || index < firstNotCloned + concurrency; });
+            if (failed) {
+                break;
+            }
+            if (!idleClients.empty()) {
+                client = idleClients.back();
+                idleClients.pop_back();
+            }
         }
-        auto collStatus = _currentCollectionCloner->run();
-        if (collStatus.isOK()) {
-            LOGV2_DEBUG(4881600,
-                        1,
-                        "Tenant collection clone finished",
-                        "namespace"_attr = sourceNss,
-                        "tenantId"_attr = _tenantId);
-        } else {
-            LOGV2_ERROR(4881601,
-                        "Tenant collection clone failed",
-                        "namespace"_attr = sourceNss,
-                        "error"_attr = collStatus.toString(),
-                        "tenantId"_attr = _tenantId);
-            setSyncFailedStatus({collStatus.code(),
-                                 collStatus
-                                     .withContext(str::stream() << "Error cloning collection '"
-                                                                << sourceNss.toString() << "'")
-                                     .toString()});
+        if (mustExit()) {
+            break;
         }
-        {
-            stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _stats.approxTotalBytesCopied +=
-                _stats.collectionStats[_stats.clonedCollections].approxTotalBytesCopied;
-            _currentCollectionCloner = nullptr;
-            // Abort the tenant database cloner if the collection clone failed.
-            if (!collStatus.isOK())
-                return;
-            _stats.clonedCollections++;
+
+        if (!client) {
+            try {
+                client = _clientFactory(getSource());
+            } catch (const DBException& e) {
+                setSyncFailedStatus(e.toStatus().withContext(
+                    "Tenant database cloner failed to connect a collection cloner"));
+                break;
+            }
         }
+
+        pool->schedule([this, index, client, &mutex, &finishedCollection, &cloned, &firstNotCloned,
+                        &failed, &idleClients](auto scheduleStatus) {
+            auto collStatus =
+                scheduleStatus.isOK() ? _runCollectionCloner(index, client) : scheduleStatus;
+
+            stdx::lock_guard<Latch> lk(mutex);
+            if (collStatus.isOK()) {
+                cloned[index] = true;
+                while (firstNotCloned < cloned.size() && cloned[firstNotCloned]) {
+                    ++firstNotCloned;
+                }
+                idleClients.push_back(client);
+            } else {
+                // The connection may be left in the middle of a query, so it is not reused.
+                failed = true;
+            }
+            finishedCollection.notify_all();
+        });
     }
+
+    pool->shutdown();
+    pool->join();
+}
+
+Status TenantDatabaseCloner::_runCollectionCloner(size_t index, DBClientConnection* client) {
+    const auto& [sourceNss, collectionOptions] = _collections[index];
+    TenantCollectionCloner* cloner;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto [it, inserted] = _collectionCloners.emplace(
+            index,
+            std::make_unique<TenantCollectionCloner>(sourceNss,
+                                                     collectionOptions,
+                                                     getSharedData(),
+                                                     getSource(),
+                                                     client,
+                                                     getStorageInterface(),
+                                                     getDBPool(),
+                                                     _tenantId));
+        invariant(inserted);
+        cloner = it->second.get();
+    }
+    auto collStatus = cloner->run();
+    if (collStatus.isOK()) {
+        LOGV2_DEBUG(4881600,
+                    1,
+                    "Tenant collection clone finished",
+                    "namespace"_attr = sourceNss,
+                    "tenantId"_attr = _tenantId);
+    } else {
+        LOGV2_ERROR(4881601,
+                    "Tenant collection clone failed",
+                    "namespace"_attr = sourceNss,
+                    "error"_attr = collStatus.toString(),
+                    "tenantId"_attr = _tenantId);
+        setSyncFailedStatus({collStatus.code(),
+                             collStatus
+                                 .withContext(str::stream() << "Error cloning collection '"
+                                                            << sourceNss.toString() << "'")
+                                 .toString()});
+    }
+
     stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
+    _stats.collectionStats[index] = cloner->getStats();
+    _stats.approxTotalBytesCopied += _stats.collectionStats[index].approxTotalBytesCopied;
+    _collectionCloners.erase(index);
+    if (collStatus.isOK()) {
+        _stats.clonedCollections++;
+    }
+    return collStatus;
 }
 
 TenantDatabaseCloner::Stats TenantDatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     TenantDatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-        stats.approxTotalBytesCopied +=
-            stats.collectionStats[stats.clonedCollections].approxTotalBytesCopied;
+    for (const auto& [index, cloner] : _collectionCloners) {
+        stats.collectionStats[index] = cloner->getStats();
+        stats.approxTotalBytesCopied += stats.collectionStats[index].approxTotalBytesCopied;
     }
     return stats;
 }
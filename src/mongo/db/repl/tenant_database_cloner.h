@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -63,7 +64,8 @@ public:
                          DBClientConnection* client,
                          StorageInterface* storageInterface,
                          ThreadPool* dbPool,
-                         StringData tenantId);
+                         StringData tenantId,
+                         ClientFactory clientFactory = {});
 
     virtual ~TenantDatabaseCloner() = default;
 
@@ -116,6 +118,18 @@ private:
      */
     void postStage() final;
 
+    /**
+     * Runs the cloners of the collections in '_collections', up to 'concurrency' at once. Each
+     * cloner runs over a connection of its own, opened through '_clientFactory'.
+     */
+    void _cloneCollectionsConcurrently(size_t concurrency);
+
+    /**
+     * Creates and runs the cloner of the collection at 'index' in '_collections' over 'client',
+     * and records its stats once it finishes.
+     */
+    Status _runCollectionCloner(size_t index, DBClientConnection* client);
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -127,7 +141,9 @@ private:
     //      threads, read access allowed from main flow without mutex.
     const std::string _dbName;                                                // (R)
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<TenantCollectionCloner> _currentCollectionCloner;         // (MX)
+
+    // The collection cloners running, by the index of their collection in '_collections'.
+    std::map<size_t, std::unique_ptr<TenantCollectionCloner>> _collectionCloners;  // (M)
 
     TenantDatabaseClonerStage _listCollectionsStage;          // (R)
     TenantDatabaseClonerStage _listExistingCollectionsStage;  // (R)
@@ -135,10 +151,14 @@ private:
     // The database name prefix of the tenant associated with this migration.
     std::string _tenantId;  // (R)
 
+    // Opens the connections of the collection cloners which run alongside others. May be empty,
+    // in which case the collections are cloned one at a time.
+    ClientFactory _clientFactory;  // (R)
+
     // The operationTime returned with the listCollections result.
     Timestamp _operationTime;  // (X)
 
-    Stats _stats;  // (MX)
+    Stats _stats;  // (M)
 };
 
 
@@ -728,6 +728,62 @@ TEST_F(TenantDatabaseClonerTest, ResumingFromLastClonedCollection) {
     ASSERT_EQUALS(sizeOfOneCollection, stats.approxTotalBytesCopied);
 }
 
+TEST_F(TenantDatabaseClonerTest, ResumingWithConcurrencyClonesTheLastCollectionsAgain) {
+    // Test that, when collections were cloned two at a time, the database cloner resumes from the
+    // collection before the last cloned one, as it may be partially cloned too.
+    std::vector<UUID> uuid;
+    for (int i = 0; i < 3; ++i) {
+        uuid.push_back(UUID::gen());
+    }
+    std::sort(uuid.begin(), uuid.end());
+
+    const std::vector<std::string> collNames = {"a", "b", "c"};
+    long long sizeOfOneCollection = 0;
+    {
+        auto storage = StorageInterface::get(serviceContext);
+        auto opCtx = cc().makeOperationContext();
+        for (size_t i = 0; i < collNames.size(); ++i) {
+            NamespaceString nss(_dbName, collNames[i]);
+            CollectionOptions options;
+            options.uuid = uuid[i];
+            ASSERT_OK(createCollection(nss, options));
+            ASSERT_OK(storage->insertDocument(
+                opCtx.get(), nss, {BSON("_id" << 0 << "a" << 1001), Timestamp(0)}, 0));
+        }
+
+        auto swSize = storage->getCollectionSize(opCtx.get(), NamespaceString(_dbName, "a"));
+        ASSERT_OK(swSize.getStatus());
+        sizeOfOneCollection = swSize.getValue();
+    }
+
+    TenantMigrationSharedData resumingSharedData(
+        &_clock, _migrationId, /*resuming=*/true, /*collectionClonerConcurrency=*/2);
+    auto cloner = makeDatabaseCloner(&resumingSharedData);
+    cloner->setStopAfterStage_forTest("listExistingCollections");
+
+    std::vector<BSONObj> sourceInfos;
+    for (size_t i = 0; i < collNames.size(); ++i) {
+        sourceInfos.push_back(BSON("name" << collNames[i] << "type"
+                                          << "collection"
+                                          << "options" << BSONObj() << "info"
+                                          << BSON("readOnly" << false << "uuid" << uuid[i])));
+    }
+    _mockServer->setCommandReply("listCollections", createListCollectionsResponse(sourceInfos));
+    _mockServer->setCommandReply("find", createFindResponse());
+
+    ASSERT_OK(cloner->run());
+    ASSERT_OK(getSharedData()->getStatus(WithLock::withoutLock()));
+    auto collections = getCollectionsFromCloner(cloner.get());
+
+    ASSERT_EQUALS(2U, collections.size());
+    ASSERT_EQ(NamespaceString(_dbName, "b"), collections[0].first);
+    ASSERT_EQ(NamespaceString(_dbName, "c"), collections[1].first);
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(1, stats.clonedCollectionsBeforeFailover);
+    ASSERT_EQUALS(sizeOfOneCollection, stats.approxTotalBytesCopied);
+}
+
 TEST_F(TenantDatabaseClonerTest, LastClonedCollectionDeleted_AllGreater) {
     // Test that we correctly resume from next collection whose UUID compared greater than the last
     // cloned collection if the last cloned collection is dropped. This tests the case when all
@@ -538,6 +538,25 @@ std::unique_ptr<DBClientConnection> TenantMigrationRecipientService::Instance::_
     return client;
 }
 
+DBClientConnection* TenantMigrationRecipientService::Instance::_connectClonerClient(
+    const HostAndPort& source) {
+    // "_cloner" (7 bytes) keeps the application name within kMaxApplicationNameByteLength, as
+    // explained in _createAndConnectClients().
+    auto applicationName =
+        "TenantMigration_" + getTenantId() + "_" + getMigrationUUID().toString() + "_cloner";
+    auto client = _connectAndAuth(source, applicationName);
+
+    stdx::lock_guard lk(_mutex);
+    if (_sharedData) {
+        // _cancelRemainingWork() may have run while connecting, and it would not have shut this
+        // connection down.
+        stdx::lock_guard<TenantMigrationSharedData> sharedDataLk(*_sharedData);
+        uassertStatusOK(_sharedData->getStatus(sharedDataLk));
+    }
+    _clonerClients.push_back(std::move(client));
+    return _clonerClients.back().get();
+}
+
 OpTime TenantMigrationRecipientService::Instance::_getDonorMajorityOpTime(
     std::unique_ptr<mongo::DBClientConnection>& client) {
     auto oplogOpTimeFields =
@@ -1427,7 +1446,8 @@ Future<void> TenantMigrationRecipientService::Instance::_startTenantAllDatabaseC
         _client.get(),
         repl::StorageInterface::get(cc().getServiceContext()),
         _writerPool.get(),
-        _tenantId);
+        _tenantId,
+        [this](const HostAndPort& source) { return _connectClonerClient(source); });
     LOGV2_DEBUG(4881100,
                 1,
                 "Starting TenantAllDatabaseCloner",
@@ -1617,6 +1637,10 @@ void TenantMigrationRecipientService::Instance::_cancelRemainingWork(WithLock lk
         _client->shutdownAndDisallowReconnect();
     }
 
+    for (auto&& clonerClient : _clonerClients) {
+        clonerClient->shutdownAndDisallowReconnect();
+    }
+
     if (_oplogFetcherClient) {
         // interrupts running tenant oplog fetcher.
         _oplogFetcherClient->shutdownAndDisallowReconnect();
@@ -1927,15 +1951,23 @@ SemiFuture<void> TenantMigrationRecipientService::Instance::run(
                        // fetcher.
                        _client = std::move(ConnectionPair.first);
                        _oplogFetcherClient = std::move(ConnectionPair.second);
+                       _clonerClients.clear();
 
                        if (!_writerPool) {
                            // Create the writer pool and shared data.
                            _writerPool = makeTenantMigrationWriterPool();
                        }
+                       const bool resuming = _stateDoc.getStartFetchingDonorOpTime().has_value();
+                       if (!resuming) {
+                           // The concurrency is persisted along with 'startFetchingDonorOpTime'.
+                           _stateDoc.setCollectionClonerConcurrency(
+                               tenantMigrationCollectionClonerConcurrency.load());
+                       }
                        _sharedData = std::make_unique<TenantMigrationSharedData>(
                            getGlobalServiceContext()->getFastClockSource(),
                            getMigrationUUID(),
-                           _stateDoc.getStartFetchingDonorOpTime().has_value());
+                           resuming,
+                           _stateDoc.getCollectionClonerConcurrency().value_or(1));
                    })
                    .then([this, self = shared_from_this(), token] {
                        _fetchAndStoreDonorClusterTimeKeyDocs(token);
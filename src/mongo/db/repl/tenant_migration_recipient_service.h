@@ -333,6 +333,13 @@ public:
          */
         SemiFuture<ConnectionPair> _createAndConnectClients();
 
+        /**
+         * Creates a client connected to 'source' for a collection cloner run alongside the others,
+         * and keeps it in '_clonerClients' so that it is shut down with '_client'. Throws if the
+         * migration is being canceled.
+         */
+        DBClientConnection* _connectClonerClient(const HostAndPort& source);
+
         /**
          * Fetches all key documents from the donor's admin.system.keys collection, stores them in
          * config.external_validation_keys, and refreshes the keys cache.
@@ -525,6 +532,10 @@ public:
         std::unique_ptr<DBClientConnection> _client;              // (S)
         std::unique_ptr<DBClientConnection> _oplogFetcherClient;  // (S)
 
+        // The extra connections of the collection cloners which run alongside the one using
+        // '_client', as set by 'tenantMigrationCollectionClonerConcurrency'.
+        std::vector<std::unique_ptr<DBClientConnection>> _clonerClients;  // (M)
+
         std::unique_ptr<OplogFetcherFactory> _createOplogFetcherFn =
             std::make_unique<CreateOplogFetcherFn>();                               // (M)
         std::unique_ptr<OplogBufferCollection> _donorOplogBuffer;                   // (M)
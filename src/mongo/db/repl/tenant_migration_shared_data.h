@@ -38,8 +38,14 @@ class TenantMigrationSharedData final : public ReplSyncSharedData {
 public:
     TenantMigrationSharedData(ClockSource* clock, const UUID& migrationId)
         : ReplSyncSharedData(clock), _migrationId(migrationId), _resuming(false) {}
-    TenantMigrationSharedData(ClockSource* clock, const UUID& migrationId, bool resuming)
-        : ReplSyncSharedData(clock), _migrationId(migrationId), _resuming(resuming) {}
+    TenantMigrationSharedData(ClockSource* clock,
+                              const UUID& migrationId,
+                              bool resuming,
+                              int collectionClonerConcurrency = 1)
+        : ReplSyncSharedData(clock),
+          _migrationId(migrationId),
+          _resuming(resuming),
+          _collectionClonerConcurrency(collectionClonerConcurrency) {}
 
     void setLastVisibleOpTime(WithLock, OpTime opTime);
 
@@ -53,6 +59,10 @@ public:
         return _resuming;
     }
 
+    int getCollectionClonerConcurrency() const {
+        return _collectionClonerConcurrency;
+    }
+
 private:
     // Must hold mutex (in base class) to access this.
     // Represents last visible majority committed donor opTime.
@@ -63,6 +73,9 @@ private:
 
     // Indicate whether the tenant migration is resuming from a failover.
     const bool _resuming;
+
+    // The number of collections of a database cloned at once, fixed when data sync first started.
+    const int _collectionClonerConcurrency;
 };
 }  // namespace repl
 }  // namespace mongo
@@ -849,6 +849,7 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
     std::vector<std::vector<const OplogEntry*>> writerVectors(
         _writerPool->getStats().options.maxThreads);
     CachedCollectionProperties collPropertiesCache;
+    WriterAssigner writerAssigner(replWriterBalancedAssignment.load());
 
     for (auto&& op : batch->ops) {
         // If the operation's optime is before or the same as the beginApplyingAfterOpTime we don't
@@ -883,11 +884,12 @@ std::vector<std::vector<const OplogEntry*>> TenantOplogApplier::_fillWriterVecto
                                              expansions,
                                              &writerVectors,
                                              &collPropertiesCache,
+                                             &writerAssigner,
                                              isTransactionWithCommand /* serial */);
         } else {
             // Add a single op to the writer vectors.
             OplogApplierUtils::addToWriterVector(
-                opCtx, &op.entry, &writerVectors, &collPropertiesCache);
+                opCtx, &op.entry, &writerVectors, &collPropertiesCache, &writerAssigner);
         }
     }
     return writerVectors;
@@ -37,6 +37,7 @@
 #include "mongo/db/s/collection_sharding_runtime.h"
 #include "mongo/db/s/migration_session_id.h"
 #include "mongo/db/s/migration_source_manager.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
 
@@ -50,7 +51,7 @@ const auto getRegistry = ServiceContext::declareDecoration<ActiveMigrationsRegis
 ActiveMigrationsRegistry::ActiveMigrationsRegistry() = default;
 
 ActiveMigrationsRegistry::~ActiveMigrationsRegistry() {
-    invariant(!_activeMoveChunkState);
+    invariant(_activeMoveChunkStates.empty());
 }
 
 ActiveMigrationsRegistry& ActiveMigrationsRegistry::get(ServiceContext* service) {
@@ -74,7 +75,9 @@ void ActiveMigrationsRegistry::lock(OperationContext* opCtx, StringData reason)
 
     // Wait for any ongoing migrations to complete.
     opCtx->waitForConditionOrInterrupt(
-        _lockCond, lock, [this] { return !(_activeMoveChunkState || _activeReceiveChunkState); });
+        _lockCond, lock, [this] {
+            return _activeMoveChunkStates.empty() && !_activeReceiveChunkState;
+        });
 }
 
 void ActiveMigrationsRegistry::unlock(StringData reason) {
@@ -99,31 +102,45 @@ StatusWith<ScopedDonateChunk> ActiveMigrationsRegistry::registerDonateChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
-        if (_activeMoveChunkState->args == args) {
+    for (const auto& activeMoveChunkState : _activeMoveChunkStates) {
+        if (activeMoveChunkState.args == args) {
             LOGV2(5004704,
                   "registerDonateChunk ",
                   "keys"_attr = ChunkRange(args.getMinKey(), args.getMaxKey()).toString(),
                   "toShardId"_attr = args.getToShardId(),
                   "ns"_attr = args.getNss().ns());
-            return {ScopedDonateChunk(nullptr, false, _activeMoveChunkState->notification)};
+            return {ScopedDonateChunk(nullptr, false, activeMoveChunkState.notification)};
         }
+    }
+
+    // Concurrent migrations must be for different collections, since each collection has a single
+    // migration source manager.
+    auto conflictingIt = std::find_if(
+        _activeMoveChunkStates.begin(), _activeMoveChunkStates.end(), [&](const auto& state) {
+            return state.args.getNss() == args.getNss();
+        });
+    if (conflictingIt == _activeMoveChunkStates.end() &&
+        _activeMoveChunkStates.size() >=
+            static_cast<size_t>(maxConcurrentOutgoingMigrations.load())) {
+        conflictingIt = _activeMoveChunkStates.begin();
+    }
 
+    if (conflictingIt != _activeMoveChunkStates.end()) {
         LOGV2(5004700,
               "registerDonateChunk ",
-              "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                              _activeMoveChunkState->args.getMaxKey())
-                                       .toString(),
-              "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId(),
+              "currentKeys"_attr =
+                  ChunkRange(conflictingIt->args.getMinKey(), conflictingIt->args.getMaxKey())
+                      .toString(),
+              "currentToShardId"_attr = conflictingIt->args.getToShardId(),
               "newKeys"_attr = ChunkRange(args.getMinKey(), args.getMaxKey()).toString(),
               "newToShardId"_attr = args.getToShardId(),
               "ns"_attr = args.getNss().ns());
-        return _activeMoveChunkState->constructErrorStatus();
+        return conflictingIt->constructErrorStatus();
     }
 
-    _activeMoveChunkState.emplace(args);
+    _activeMoveChunkStates.emplace_back(args);
 
-    return {ScopedDonateChunk(this, true, _activeMoveChunkState->notification)};
+    return {ScopedDonateChunk(this, true, _activeMoveChunkStates.back().notification)};
 }
 
 StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
@@ -142,15 +159,16 @@ StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
         return _activeReceiveChunkState->constructErrorStatus();
     }
 
-    if (_activeMoveChunkState) {
+    if (!_activeMoveChunkStates.empty()) {
+        const auto& activeMoveChunkState = _activeMoveChunkStates.front();
         LOGV2(5004701,
               "registerReceiveChink ",
-              "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                              _activeMoveChunkState->args.getMaxKey())
+              "currentKeys"_attr = ChunkRange(activeMoveChunkState.args.getMinKey(),
+                                              activeMoveChunkState.args.getMaxKey())
                                        .toString(),
-              "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId(),
-              "ns"_attr = _activeMoveChunkState->args.getNss().ns());
-        return _activeMoveChunkState->constructErrorStatus();
+              "currentToShardId"_attr = activeMoveChunkState.args.getToShardId(),
+              "ns"_attr = activeMoveChunkState.args.getNss().ns());
+        return activeMoveChunkState.constructErrorStatus();
     }
 
     _activeReceiveChunkState.emplace(nss, chunkRange, fromShardId);
@@ -158,13 +176,14 @@ StatusWith<ScopedReceiveChunk> ActiveMigrationsRegistry::registerReceiveChunk(
     return {ScopedReceiveChunk(this)};
 }
 
-boost::optional<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
+std::vector<NamespaceString> ActiveMigrationsRegistry::getActiveDonateChunkNss() {
     stdx::lock_guard<Latch> lk(_mutex);
-    if (_activeMoveChunkState) {
-        return _activeMoveChunkState->args.getNss();
+    std::vector<NamespaceString> namespaces;
+    for (const auto& activeMoveChunkState : _activeMoveChunkStates) {
+        namespaces.push_back(activeMoveChunkState.args.getNss());
     }
 
-    return boost::none;
+    return namespaces;
 }
 
 BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContext* opCtx) {
@@ -172,8 +191,8 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     {
         stdx::lock_guard<Latch> lk(_mutex);
 
-        if (_activeMoveChunkState) {
-            nss = _activeMoveChunkState->args.getNss();
+        if (!_activeMoveChunkStates.empty()) {
+            nss = _activeMoveChunkStates.front().args.getNss();
         }
     }
 
@@ -195,16 +214,19 @@ BSONObj ActiveMigrationsRegistry::getActiveMigrationStatusReport(OperationContex
     return BSONObj();
 }
 
-void ActiveMigrationsRegistry::_clearDonateChunk() {
+void ActiveMigrationsRegistry::_clearDonateChunk(
+    const std::shared_ptr<Notification<Status>>& notification) {
     stdx::lock_guard<Latch> lk(_mutex);
-    invariant(_activeMoveChunkState);
+    auto it = std::find_if(
+        _activeMoveChunkStates.begin(), _activeMoveChunkStates.end(), [&](const auto& state) {
+            return state.notification == notification;
+        });
+    invariant(it != _activeMoveChunkStates.end());
     LOGV2(5004702,
           "clearDonateChunk ",
-          "currentKeys"_attr = ChunkRange(_activeMoveChunkState->args.getMinKey(),
-                                          _activeMoveChunkState->args.getMaxKey())
-                                   .toString(),
-          "currentToShardId"_attr = _activeMoveChunkState->args.getToShardId());
-    _activeMoveChunkState.reset();
+          "currentKeys"_attr = ChunkRange(it->args.getMinKey(), it->args.getMaxKey()).toString(),
+          "currentToShardId"_attr = it->args.getToShardId());
+    _activeMoveChunkStates.erase(it);
     _lockCond.notify_all();
 }
 
@@ -243,7 +265,7 @@ ScopedDonateChunk::~ScopedDonateChunk() {
     if (_registry && _shouldExecute) {
         // If this is a newly started migration the caller must always signal on completion
         invariant(*_completionNotification);
-        _registry->_clearDonateChunk();
+        _registry->_clearDonateChunk(_completionNotification);
     }
     LOGV2(5004703, "~ScopedDonateChunk", "_shouldExecute"_attr = _shouldExecute);
 }
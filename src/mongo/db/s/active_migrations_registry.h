@@ -30,7 +30,9 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <list>
 #include <memory>
+#include <vector>
 
 #include "mongo/db/s/migration_session_id.h"
 #include "mongo/platform/mutex.h"
@@ -47,7 +49,9 @@ class StatusWith;
 
 /**
  * Thread-safe object that keeps track of the active migrations running on a node and limits them
- * to only one per shard. There is only one instance of this object per shard.
+ * per shard. A shard either receives one chunk, or donates chunks of up to
+ * 'maxConcurrentOutgoingMigrations' different collections. There is only one instance of this
+ * object per shard.
  */
 class ActiveMigrationsRegistry {
     ActiveMigrationsRegistry(const ActiveMigrationsRegistry&) = delete;
@@ -70,9 +74,10 @@ public:
     void unlock(StringData reason);
 
     /**
-     * If there are no migrations running on this shard, registers an active migration with the
-     * specified arguments. Returns a ScopedDonateChunk, which must be signaled by the
-     * caller before it goes out of scope.
+     * If this shard is not receiving a chunk, is donating fewer chunks than
+     * 'maxConcurrentOutgoingMigrations' and none of the same collection, registers an active
+     * migration with the specified arguments. Returns a ScopedDonateChunk, which must be signaled
+     * by the caller before it goes out of scope.
      *
      * If there is an active migration already running on this shard and it has the exact same
      * arguments, returns a ScopedDonateChunk. The ScopedDonateChunk can be used to join the
@@ -96,14 +101,14 @@ public:
                                                         const ShardId& fromShardId);
 
     /**
-     * If a migration has been previously registered through a call to registerDonateChunk, returns
-     * that namespace. Otherwise returns boost::none.
+     * Returns the namespaces of the migrations previously registered through calls to
+     * registerDonateChunk, in the order in which they were registered.
      */
-    boost::optional<NamespaceString> getActiveDonateChunkNss();
+    std::vector<NamespaceString> getActiveDonateChunkNss();
 
     /**
-     * Returns a report on the active migration if there currently is one. Otherwise, returns an
-     * empty BSONObj.
+     * Returns a report on the oldest active outgoing migration if there currently is one.
+     * Otherwise, returns an empty BSONObj.
      *
      * Takes an IS lock on the namespace of the active migration, if one is active.
      */
@@ -151,10 +156,10 @@ private:
     };
 
     /**
-     * Unregisters a previously registered namespace with an ongoing migration. Must only be called
-     * if a previous call to registerDonateChunk has succeeded.
+     * Unregisters the previously registered migration signaled by 'notification'. Must only be
+     * called if a previous call to registerDonateChunk has succeeded.
      */
-    void _clearDonateChunk();
+    void _clearDonateChunk(const std::shared_ptr<Notification<Status>>& notification);
 
     /**
      * Unregisters a previously registered incoming migration. Must only be called if a previous
@@ -168,8 +173,8 @@ private:
 
     bool _migrationsBlocked{false};
 
-    // If there is an active moveChunk operation, this field contains the original request
-    boost::optional<ActiveMoveChunkState> _activeMoveChunkState;
+    // The original requests of the active moveChunk operations, in the order they were registered
+    std::list<ActiveMoveChunkState> _activeMoveChunkStates;
 
     // If there is an active chunk receive operation, this field contains the original session id
     boost::optional<ActiveReceiveChunkState> _activeReceiveChunkState;
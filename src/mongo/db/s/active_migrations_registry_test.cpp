@@ -32,6 +32,7 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/client.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/db/s/active_migrations_registry.h"
 #include "mongo/db/service_context_d_test_fixture.h"
 #include "mongo/s/request_types/move_chunk_request.h"
@@ -93,14 +94,16 @@ TEST_F(MoveChunkRegistration, ScopedDonateChunkMoveConstructorAndAssignment) {
 }
 
 TEST_F(MoveChunkRegistration, GetActiveMigrationNamespace) {
-    ASSERT(!_registry.getActiveDonateChunkNss());
+    ASSERT(_registry.getActiveDonateChunkNss().empty());
 
     const NamespaceString nss("TestDB", "TestColl");
 
     auto originalScopedDonateChunk =
         assertGet(_registry.registerDonateChunk(operationContext(), createMoveChunkRequest(nss)));
 
-    ASSERT_EQ(nss.ns(), _registry.getActiveDonateChunkNss()->ns());
+    const auto activeNamespaces = _registry.getActiveDonateChunkNss();
+    ASSERT_EQ(1U, activeNamespaces.size());
+    ASSERT_EQ(nss.ns(), activeNamespaces.front().ns());
 
     // Need to signal the registered migration so the destructor doesn't invariant
     originalScopedDonateChunk.signalComplete(Status::OK());
@@ -118,6 +121,75 @@ TEST_F(MoveChunkRegistration, SecondMigrationReturnsConflictingOperationInProgre
     originalScopedDonateChunk.signalComplete(Status::OK());
 }
 
+TEST_F(MoveChunkRegistration, ConcurrentMigrationsOfDifferentCollections) {
+    RAIIServerParameterControllerForTest controller("maxConcurrentOutgoingMigrations", 2);
+
+    const NamespaceString nss1("TestDB", "TestColl1");
+    const NamespaceString nss2("TestDB", "TestColl2");
+
+    auto firstScopedDonateChunk =
+        assertGet(_registry.registerDonateChunk(operationContext(), createMoveChunkRequest(nss1)));
+    ASSERT(firstScopedDonateChunk.mustExecute());
+
+    // A second chunk of the same collection cannot be donated at the same time.
+    auto sameCollectionBuilder = BSONObjBuilder();
+    MoveChunkRequest::appendAsCommand(
+        &sameCollectionBuilder,
+        nss1,
+        ChunkVersion(1, 2, OID::gen(), boost::none /* timestamp */),
+        assertGet(ConnectionString::parse("TestConfigRS/CS1:12345,CS2:12345,CS3:12345")),
+        ShardId("shard0001"),
+        ShardId("shard0002"),
+        ChunkRange(BSON("Key" << 100), BSON("Key" << 200)),
+        1024,
+        MigrationSecondaryThrottleOptions::create(MigrationSecondaryThrottleOptions::kOff),
+        true,
+        MoveChunkRequest::ForceJumbo::kDoNotForce);
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              _registry
+                  .registerDonateChunk(operationContext(),
+                                       assertGet(MoveChunkRequest::createFromCommand(
+                                           nss1, sameCollectionBuilder.obj())))
+                  .getStatus());
+
+    auto secondScopedDonateChunk =
+        assertGet(_registry.registerDonateChunk(operationContext(), createMoveChunkRequest(nss2)));
+    ASSERT(secondScopedDonateChunk.mustExecute());
+
+    const auto activeNamespaces = _registry.getActiveDonateChunkNss();
+    ASSERT_EQ(2U, activeNamespaces.size());
+    ASSERT_EQ(nss1.ns(), activeNamespaces[0].ns());
+    ASSERT_EQ(nss2.ns(), activeNamespaces[1].ns());
+
+    // The limit is reached, and a shard which donates chunks cannot receive any.
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              _registry
+                  .registerDonateChunk(operationContext(),
+                                       createMoveChunkRequest(NamespaceString("TestDB", "TestColl3")))
+                  .getStatus());
+    ASSERT_EQ(ErrorCodes::ConflictingOperationInProgress,
+              _registry
+                  .registerReceiveChunk(operationContext(),
+                                        NamespaceString("TestDB", "TestColl3"),
+                                        ChunkRange(BSON("Key" << -100), BSON("Key" << 100)),
+                                        ShardId("shard0001"))
+                  .getStatus());
+
+    // Completing the first migration makes room for another one.
+    firstScopedDonateChunk.signalComplete(Status::OK());
+    {
+        auto completed = std::move(firstScopedDonateChunk);
+    }
+    ASSERT_EQ(1U, _registry.getActiveDonateChunkNss().size());
+
+    auto thirdScopedDonateChunk = assertGet(_registry.registerDonateChunk(
+        operationContext(), createMoveChunkRequest(NamespaceString("TestDB", "TestColl3"))));
+    ASSERT(thirdScopedDonateChunk.mustExecute());
+
+    secondScopedDonateChunk.signalComplete(Status::OK());
+    thirdScopedDonateChunk.signalComplete(Status::OK());
+}
+
 TEST_F(MoveChunkRegistration, SecondMigrationWithSameArgumentsJoinsFirst) {
     auto originalScopedDonateChunk = assertGet(_registry.registerDonateChunk(
         operationContext(), createMoveChunkRequest(NamespaceString("TestDB", "TestColl"))));
@@ -34,6 +34,7 @@
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 
 #include <algorithm>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -57,6 +58,16 @@ using SplitInfoVector = BalancerChunkSelectionPolicy::SplitInfoVector;
 
 namespace {
 
+/**
+ * Returns whether the shard described by 'stat' is loaded lightly enough to donate a chunk while it
+ * is already donating others. Its secondaries must keep up with its writes, and its cache must not
+ * be so dirty that the extra writes would stall on eviction.
+ */
+bool canDonateConcurrently(const ClusterStatistics::ShardStatistics& stat) {
+    return stat.majorityReplicationLag <= Seconds(balancerMigrationMaxReplicationLagSecs.load()) &&
+        stat.dirtyCacheFraction <= balancerMigrationMaxDirtyCacheFraction.load();
+}
+
 /**
  * Does a linear pass over the information cached in the specified chunk manager and extracts chunk
  * distribution and chunk placement information which is needed by the balancer policy.
@@ -374,6 +385,13 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
     MigrateInfoVector candidateChunks;
     std::set<ShardId> usedShards;
 
+    // A shard may donate chunks of up to 'balancerMaxConcurrentMigrationsPerShard' collections in
+    // the same round, but it only receives one chunk and never donates and receives at the same
+    // time.
+    const int maxConcurrentMigrationsPerShard = balancerMaxConcurrentMigrationsPerShard.load();
+    std::map<ShardId, int> numOutgoingMigrations;
+    std::set<ShardId> recipientShards;
+
     std::shuffle(collections.begin(), collections.end(), _random);
 
     for (const auto& coll : collections) {
@@ -409,9 +427,29 @@ StatusWith<MigrateInfoVector> BalancerChunkSelectionPolicyImpl::selectChunksToMo
             continue;
         }
 
-        candidateChunks.insert(candidateChunks.end(),
-                               std::make_move_iterator(candidatesStatus.getValue().begin()),
-                               std::make_move_iterator(candidatesStatus.getValue().end()));
+        for (auto& migrateInfo : candidatesStatus.getValue()) {
+            if (numOutgoingMigrations.count(migrateInfo.to)) {
+                LOGV2_DEBUG(5963002,
+                            1,
+                            "Not moving chunk to a shard which is donating chunks",
+                            "migrateInfo"_attr = redact(migrateInfo.toString()));
+                continue;
+            }
+
+            ++numOutgoingMigrations[migrateInfo.from];
+            recipientShards.insert(migrateInfo.to);
+            candidateChunks.push_back(std::move(migrateInfo));
+        }
+
+        // Let the donors with room for another migration be picked again for the next collection.
+        usedShards = recipientShards;
+        for (const auto& stat : shardStats) {
+            auto it = numOutgoingMigrations.find(stat.shardId);
+            if (it != numOutgoingMigrations.end() &&
+                (it->second >= maxConcurrentMigrationsPerShard || !canDonateConcurrently(stat))) {
+                usedShards.insert(stat.shardId);
+            }
+        }
     }
 
     return candidateChunks;
@@ -33,6 +33,7 @@
 #include "mongo/db/s/balancer/balancer_chunk_selection_policy_impl.h"
 #include "mongo/db/s/balancer/cluster_statistics_impl.h"
 #include "mongo/db/s/balancer/migration_test_fixture.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/type_collection_timeseries_fields_gen.h"
 
@@ -76,15 +77,21 @@ protected:
 
     /**
      * Sets up mock network to expect a serverStatus command and returns a BSON response with
-     * a dummy version.
+     * a dummy version and the given majority replication lag.
      */
-    void expectServerStatusCommand() {
+    void expectServerStatusCommand(Milliseconds majorityReplicationLag = Milliseconds(0)) {
         BSONObjBuilder resultBuilder;
         CommandHelpers::appendCommandStatusNoThrow(resultBuilder, Status::OK());
 
-        onCommand([&resultBuilder](const RemoteCommandRequest& request) {
+        onCommand([&resultBuilder, majorityReplicationLag](const RemoteCommandRequest& request) {
             ASSERT(request.cmdObj["serverStatus"]);
             resultBuilder.append("version", "MONGO_VERSION");
+            const auto lastWriteDate = Date_t::fromMillisSinceEpoch(1000000);
+            resultBuilder.append(
+                "repl",
+                BSON("lastWrite" << BSON("lastWriteDate"
+                                         << lastWriteDate << "majorityWriteDate"
+                                         << lastWriteDate - majorityReplicationLag)));
             return resultBuilder.obj();
         });
     }
@@ -93,10 +100,11 @@ protected:
      * Sets up mock network for all the shards to expect the commands executed for computing cluster
      * stats, which include listDatabase and serverStatus.
      */
-    void expectGetStatsCommands(int numShards) {
+    void expectGetStatsCommands(int numShards,
+                                Milliseconds majorityReplicationLag = Milliseconds(0)) {
         for (int i = 0; i < numShards; i++) {
             expectListDatabasesCommand();
-            expectServerStatusCommand();
+            expectServerStatusCommand(majorityReplicationLag);
         }
     }
 
@@ -323,5 +331,68 @@ TEST_F(BalancerChunkSelectionTest, ShardedTimeseriesCollectionsCannotBeBalanced)
     future.default_timed_get();
 }
 
+TEST_F(BalancerChunkSelectionTest, ShardDonatesChunksOfSeveralCollectionsConcurrently) {
+    // Set up three shards in the metadata.
+    for (const auto& shard : {kShard0, kShard1, kShard2}) {
+        ASSERT_OK(catalogClient()->insertConfigDocument(
+            operationContext(), ShardType::ConfigNS, shard, kMajorityWriteConcern));
+    }
+
+    // Set up two sharded collections in the metadata, which have all their chunks on shard0.
+    setUpDatabase(kDbName, kShardId0);
+    const NamespaceString kNamespace2(kDbName, "TestColl2");
+    for (const auto& nss : {kNamespace, kNamespace2}) {
+        const auto collUUID = UUID::gen();
+        ChunkVersion version(2, 0, OID::gen(), Timestamp(42));
+        setUpCollection(nss, collUUID, version);
+
+        setUpChunk(nss, collUUID, kKeyPattern.globalMin(), BSON(kPattern << 0), kShardId0, version);
+        for (int i = 1; i <= 10; ++i) {
+            version.incMinor();
+            setUpChunk(
+                nss, collUUID, BSON(kPattern << (i - 1)), BSON(kPattern << i), kShardId0, version);
+        }
+        version.incMinor();
+        setUpChunk(nss, collUUID, BSON(kPattern << 10), kKeyPattern.globalMax(), kShardId0, version);
+    }
+
+    auto selectChunksToMove = [&](Milliseconds majorityReplicationLag) {
+        BalancerChunkSelectionPolicy::MigrateInfoVector candidateChunks;
+        auto future = launchAsync([&] {
+            ThreadClient tc(getServiceContext());
+            auto opCtx = Client::getCurrent()->makeOperationContext();
+
+            // Requests chunks to be relocated requires running commands on each shard to
+            // get shard statistics. Set up dummy hosts for the source shards.
+            shardTargeterMock(opCtx.get(), kShardId0)->setFindHostReturnValue(kShardHost0);
+            shardTargeterMock(opCtx.get(), kShardId1)->setFindHostReturnValue(kShardHost1);
+            shardTargeterMock(opCtx.get(), kShardId2)->setFindHostReturnValue(kShardHost2);
+
+            candidateChunks =
+                uassertStatusOK(_chunkSelectionPolicy.get()->selectChunksToMove(opCtx.get()));
+        });
+
+        expectGetStatsCommands(3, majorityReplicationLag);
+        future.default_timed_get();
+        return candidateChunks;
+    };
+
+    // By default a shard donates one chunk at a time.
+    ASSERT_EQUALS(1U, selectChunksToMove(Milliseconds(0)).size());
+
+    RAIIServerParameterControllerForTest controller("balancerMaxConcurrentMigrationsPerShard", 2);
+
+    // Each recipient receives one of the chunks.
+    auto candidateChunks = selectChunksToMove(Milliseconds(0));
+    ASSERT_EQUALS(2U, candidateChunks.size());
+    ASSERT_EQUALS(kShardId0, candidateChunks[0].from);
+    ASSERT_EQUALS(kShardId0, candidateChunks[1].from);
+    ASSERT_NOT_EQUALS(candidateChunks[0].nss, candidateChunks[1].nss);
+    ASSERT_NOT_EQUALS(candidateChunks[0].to, candidateChunks[1].to);
+
+    // A donor whose secondaries lag behind does not donate another chunk.
+    ASSERT_EQUALS(1U, selectChunksToMove(Seconds(60)).size());
+}
+
 }  // namespace
 }  // namespace mongo
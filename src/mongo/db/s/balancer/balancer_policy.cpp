@@ -33,9 +33,12 @@
 
 #include "mongo/db/s/balancer/balancer_policy.h"
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 
 #include "mongo/db/s/balancer/type_migration.h"
+#include "mongo/db/s/sharding_config_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/catalog/type_tags.h"
@@ -58,6 +61,45 @@ namespace {
 // optimal average across all shards for a zone for a rebalancing migration to be initiated.
 const size_t kDefaultImbalanceThreshold = 1;
 
+// The minimum difference between the write rates of two shards for a collection for a migration
+// to be initiated because of it, so that idle collections are not balanced by their noise.
+const double kMinWriteRateImbalanceBytesPerSecond = 256 * 1024;
+
+/**
+ * Returns the rates of writes to the chunks of the specified collection reported by the specified
+ * shard, or nullptr if it has not reported any.
+ */
+const ClusterStatistics::CollectionWriteRates* findCollectionWriteRates(
+    const ShardStatisticsVector& shardStats, const ShardId& shardId, const NamespaceString& nss) {
+    for (const auto& stat : shardStats) {
+        if (stat.shardId != shardId)
+            continue;
+
+        auto it = stat.collectionWriteRates.find(nss.ns());
+        return it == stat.collectionWriteRates.end() ? nullptr : &it->second;
+    }
+
+    return nullptr;
+}
+
+/**
+ * Returns the rate of writes to the specified chunk, or zero if it is not among the hottest chunks
+ * reported by its shard.
+ */
+double getChunkBytesWrittenPerSecond(const ClusterStatistics::CollectionWriteRates* writeRates,
+                                     const ChunkType& chunk) {
+    if (!writeRates)
+        return 0;
+
+    for (const auto& chunkWriteRate : writeRates->hottestChunks) {
+        if (chunkWriteRate.min.woCompare(chunk.getMin()) == 0 &&
+            chunkWriteRate.max.woCompare(chunk.getMax()) == 0)
+            return chunkWriteRate.bytesWrittenPerSecond;
+    }
+
+    return 0;
+}
+
 }  // namespace
 
 DistributionStatus::DistributionStatus(NamespaceString nss, ShardToChunksMap shardToChunksMap)
@@ -548,6 +590,16 @@ vector<MigrateInfo> BalancerPolicy::balance(const ShardStatisticsVector& shardSt
             ;
     }
 
+    // 4) Once the chunks are balanced by count, balance the writes to them
+    if (migrations.empty()) {
+        _writeRateBalance(shardStats,
+                          distribution,
+                          &migrations,
+                          usedShards,
+                          forceJumbo ? MoveChunkRequest::ForceJumbo::kForceBalancer
+                                     : MoveChunkRequest::ForceJumbo::kDoNotForce);
+    }
+
     return migrations;
 }
 
@@ -624,8 +676,11 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
         return false;
 
     const vector<ChunkType>& chunks = distribution.getChunks(from);
+    const auto writeRates = findCollectionWriteRates(shardStats, from, distribution.nss());
 
     unsigned numJumboChunks = 0;
+    const ChunkType* coldestChunk = nullptr;
+    double coldestChunkBytesWrittenPerSecond = 0;
 
     for (const auto& chunk : chunks) {
         if (distribution.getTagForChunk(chunk) != tag)
@@ -636,8 +691,20 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
             continue;
         }
 
-        migrations->emplace_back(to, chunk, forceJumbo, MigrateInfo::chunksImbalance);
-        invariant(usedShards->insert(chunk.getShard()).second);
+        const double bytesWrittenPerSecond = getChunkBytesWrittenPerSecond(writeRates, chunk);
+        if (!coldestChunk || bytesWrittenPerSecond < coldestChunkBytesWrittenPerSecond) {
+            coldestChunk = &chunk;
+            coldestChunkBytesWrittenPerSecond = bytesWrittenPerSecond;
+        }
+
+        // No chunk can receive fewer writes than one which is not among the hottest
+        if (coldestChunkBytesWrittenPerSecond == 0)
+            break;
+    }
+
+    if (coldestChunk) {
+        migrations->emplace_back(to, *coldestChunk, forceJumbo, MigrateInfo::chunksImbalance);
+        invariant(usedShards->insert(coldestChunk->getShard()).second);
         invariant(usedShards->insert(to).second);
         return true;
     }
@@ -657,6 +724,109 @@ bool BalancerPolicy::_singleZoneBalance(const ShardStatisticsVector& shardStats,
     return false;
 }
 
+bool BalancerPolicy::_writeRateBalance(const ShardStatisticsVector& shardStats,
+                                       const DistributionStatus& distribution,
+                                       vector<MigrateInfo>* migrations,
+                                       set<ShardId>* usedShards,
+                                       MoveChunkRequest::ForceJumbo forceJumbo) {
+    const double imbalanceRatio = balancerWriteRateImbalanceRatio.load();
+    if (imbalanceRatio <= 0)
+        return false;
+
+    const NamespaceString& nss = distribution.nss();
+
+    const ClusterStatistics::ShardStatistics* hottest = nullptr;
+    for (const auto& stat : shardStats) {
+        if (usedShards->count(stat.shardId))
+            continue;
+
+        if (!hottest ||
+            stat.getBytesWrittenPerSecond(nss) > hottest->getBytesWrittenPerSecond(nss)) {
+            hottest = &stat;
+        }
+    }
+
+    if (!hottest)
+        return false;
+
+    const auto writeRates = findCollectionWriteRates(shardStats, hottest->shardId, nss);
+    if (!writeRates)
+        return false;
+
+    const vector<ChunkType>& chunks = distribution.getChunks(hottest->shardId);
+
+    const ChunkType* bestChunk = nullptr;
+    ShardId bestTo;
+    double bestDistance = numeric_limits<double>::max();
+
+    for (const auto& chunkWriteRate : writeRates->hottestChunks) {
+        if (chunkWriteRate.bytesWrittenPerSecond <= 0)
+            continue;
+
+        // The shard reports its chunks as of its own routing table, which may be out of date
+        auto chunkIt = std::find_if(chunks.begin(), chunks.end(), [&](const ChunkType& chunk) {
+            return chunk.getMin().woCompare(chunkWriteRate.min) == 0 &&
+                chunk.getMax().woCompare(chunkWriteRate.max) == 0;
+        });
+        if (chunkIt == chunks.end() || chunkIt->getJumbo())
+            continue;
+
+        const string tag = distribution.getTagForChunk(*chunkIt);
+
+        const ClusterStatistics::ShardStatistics* coldest = nullptr;
+        for (const auto& stat : shardStats) {
+            if (stat.shardId == hottest->shardId || usedShards->count(stat.shardId))
+                continue;
+
+            if (!isShardSuitableReceiver(stat, tag).isOK())
+                continue;
+
+            if (!coldest ||
+                stat.getBytesWrittenPerSecond(nss) < coldest->getBytesWrittenPerSecond(nss)) {
+                coldest = &stat;
+            }
+        }
+
+        if (!coldest)
+            continue;
+
+        const double hottestBytesWrittenPerSecond = hottest->getBytesWrittenPerSecond(nss);
+        const double coldestBytesWrittenPerSecond = coldest->getBytesWrittenPerSecond(nss);
+        const double imbalance = hottestBytesWrittenPerSecond - coldestBytesWrittenPerSecond;
+        if (hottestBytesWrittenPerSecond <= imbalanceRatio * coldestBytesWrittenPerSecond ||
+            imbalance < kMinWriteRateImbalanceBytesPerSecond)
+            continue;
+
+        // Moving a chunk which receives at least as many writes as the difference would only make
+        // the receiver the hottest shard
+        if (chunkWriteRate.bytesWrittenPerSecond >= imbalance)
+            continue;
+
+        const double distance = std::abs(chunkWriteRate.bytesWrittenPerSecond - imbalance / 2);
+        if (distance < bestDistance) {
+            bestChunk = &(*chunkIt);
+            bestTo = coldest->shardId;
+            bestDistance = distance;
+        }
+    }
+
+    if (!bestChunk)
+        return false;
+
+    LOGV2_DEBUG(5963010,
+                1,
+                "Balancing writes to collection",
+                "namespace"_attr = nss.ns(),
+                "fromShardId"_attr = hottest->shardId,
+                "toShardId"_attr = bestTo,
+                "chunk"_attr = redact(bestChunk->toString()));
+
+    migrations->emplace_back(bestTo, *bestChunk, forceJumbo, MigrateInfo::writesImbalance);
+    invariant(usedShards->insert(hottest->shardId).second);
+    invariant(usedShards->insert(bestTo).second);
+    return true;
+}
+
 ZoneRange::ZoneRange(const BSONObj& a_min, const BSONObj& a_max, const std::string& _zone)
     : min(a_min.getOwned()), max(a_max.getOwned()), zone(_zone) {}
 
@@ -54,7 +54,7 @@ struct ZoneRange {
 };
 
 struct MigrateInfo {
-    enum MigrationReason { drain, zoneViolation, chunksImbalance };
+    enum MigrationReason { drain, zoneViolation, chunksImbalance, writesImbalance };
 
     MigrateInfo(const ShardId& a_to,
                 const ChunkType& a_chunk,
@@ -231,6 +231,10 @@ public:
      * any of the shards have chunks, which are sufficiently higher than this number, suggests
      * moving chunks to shards, which are under this number.
      *
+     * Once the chunk counts are balanced, moves a chunk off the shard which receives the most
+     * writes to the collection if it receives sufficiently more than the shard which receives the
+     * fewest, as reported by the shards in their statistics.
+     *
      * The usedShards parameter is in/out and it contains the set of shards, which have already been
      * used for migrations. Used so we don't return multiple conflicting migrations for the same
      * shard.
@@ -276,6 +280,9 @@ private:
      * each shard must have and is used to determine the imbalance and also to prevent chunks from
      * moving when not necessary.
      *
+     * Of the chunks of the most overloaded shard, moves the one which receives the fewest writes,
+     * so that the write load does not follow the chunk count around the cluster.
+     *
      * Returns true if a migration was suggested, false otherwise. This method is intented to be
      * called multiple times until all posible migrations for a zone have been selected.
      */
@@ -286,6 +293,20 @@ private:
                                    std::vector<MigrateInfo>* migrations,
                                    std::set<ShardId>* usedShards,
                                    MoveChunkRequest::ForceJumbo forceJumbo);
+
+    /**
+     * Selects one of the hottest chunks of the shard which receives the most writes to the
+     * collection to be moved to the shard which receives the fewest, if the difference between
+     * their write rates exceeds the balancerWriteRateImbalanceRatio. Prefers the chunk whose write
+     * rate is closest to half the difference, so that the move does not just swap the two shards.
+     *
+     * Returns true if a migration was suggested, false otherwise.
+     */
+    static bool _writeRateBalance(const ShardStatisticsVector& shardStats,
+                                  const DistributionStatus& distribution,
+                                  std::vector<MigrateInfo>* migrations,
+                                  std::set<ShardId>* usedShards,
+                                  MoveChunkRequest::ForceJumbo forceJumbo);
 };
 
 }  // namespace mongo
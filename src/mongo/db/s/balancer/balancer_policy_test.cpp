@@ -692,6 +692,66 @@ TEST(BalancerPolicy, BalancerHandlesNoShardsWithTag) {
     ASSERT(balanceChunks(cluster.first, distribution, false, false).empty());
 }
 
+TEST(BalancerPolicy, BalancerMovesColdestChunkToBalanceChunkCount) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 3, false, emptyTagSet, emptyShardVersion), 3},
+         {ShardStatistics(kShardId1, kNoMaxSize, 0, false, emptyTagSet, emptyShardVersion), 0}});
+
+    const auto& chunks = cluster.second[kShardId0];
+    cluster.first[0].collectionWriteRates[kNamespace.ns()] = {
+        3 * 1024 * 1024,
+        {{chunks[0].getMin(), chunks[0].getMax(), 2 * 1024 * 1024},
+         {chunks[2].getMin(), chunks[2].getMax(), 1024 * 1024}}};
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(chunks[1].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(chunks[1].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(MigrateInfo::chunksImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, BalancerMovesHotChunkOffShardWithMostWrites) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    const auto& chunks = cluster.second[kShardId0];
+    cluster.first[0].collectionWriteRates[kNamespace.ns()] = {
+        4 * 1024 * 1024,
+        {{chunks[0].getMin(), chunks[0].getMax(), 3 * 1024 * 1024},
+         {chunks[1].getMin(), chunks[1].getMax(), 1536 * 1024}}};
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT_EQ(1U, migrations.size());
+    ASSERT_EQ(kShardId0, migrations[0].from);
+    ASSERT_EQ(kShardId1, migrations[0].to);
+    ASSERT_BSONOBJ_EQ(chunks[1].getMin(), migrations[0].minKey);
+    ASSERT_BSONOBJ_EQ(chunks[1].getMax(), migrations[0].maxKey);
+    ASSERT_EQ(MigrateInfo::writesImbalance, migrations[0].reason);
+}
+
+TEST(BalancerPolicy, BalancerDoesNotMoveChunksWhenWritesAreWithinImbalanceRatio) {
+    auto cluster = generateCluster(
+        {{ShardStatistics(kShardId0, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2},
+         {ShardStatistics(kShardId1, kNoMaxSize, 2, false, emptyTagSet, emptyShardVersion), 2}});
+
+    const auto& chunks0 = cluster.second[kShardId0];
+    cluster.first[0].collectionWriteRates[kNamespace.ns()] = {
+        4 * 1024 * 1024, {{chunks0[0].getMin(), chunks0[0].getMax(), 3 * 1024 * 1024}}};
+
+    const auto& chunks1 = cluster.second[kShardId1];
+    cluster.first[1].collectionWriteRates[kNamespace.ns()] = {
+        3 * 1024 * 1024, {{chunks1[0].getMin(), chunks1[0].getMax(), 3 * 1024 * 1024}}};
+
+    const auto migrations(
+        balanceChunks(cluster.first, DistributionStatus(kNamespace, cluster.second), false, false));
+    ASSERT(migrations.empty());
+}
+
 TEST(DistributionStatus, AddTagRangeOverlap) {
     DistributionStatus d(kNamespace, ShardToChunksMap{});
 
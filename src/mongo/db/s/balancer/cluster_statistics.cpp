@@ -61,6 +61,12 @@ bool ClusterStatistics::ShardStatistics::isSizeMaxed() const {
     return currSizeMB >= maxSizeMB;
 }
 
+double ClusterStatistics::ShardStatistics::getBytesWrittenPerSecond(
+    const NamespaceString& nss) const {
+    auto it = collectionWriteRates.find(nss.ns());
+    return it == collectionWriteRates.end() ? 0 : it->second.bytesWrittenPerSecond;
+}
+
 BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     BSONObjBuilder builder;
     builder.append("id", shardId.toString());
@@ -73,6 +79,9 @@ BSONObj ClusterStatistics::ShardStatistics::toBSON() const {
     }
 
     builder.append("version", mongoVersion);
+    builder.append("majorityReplicationLagMillis",
+                   durationCount<Milliseconds>(majorityReplicationLag));
+    builder.append("dirtyCacheFraction", dirtyCacheFraction);
     return builder.obj();
 }
 
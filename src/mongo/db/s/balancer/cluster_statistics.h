@@ -34,7 +34,9 @@
 #include <string>
 #include <vector>
 
+#include "mongo/bson/bsonobj.h"
 #include "mongo/s/client/shard.h"
+#include "mongo/util/string_map.h"
 
 namespace mongo {
 
@@ -53,6 +55,24 @@ class ClusterStatistics {
     ClusterStatistics& operator=(const ClusterStatistics&) = delete;
 
 public:
+    /**
+     * Rate of writes to a single chunk, as reported by the shard which owns it.
+     */
+    struct ChunkWriteRate {
+        BSONObj min;
+        BSONObj max;
+        double bytesWrittenPerSecond{0};
+    };
+
+    /**
+     * Rate of writes to the chunks of a collection owned by a single shard, along with the most
+     * written to of those chunks, hottest first.
+     */
+    struct CollectionWriteRates {
+        double bytesWrittenPerSecond{0};
+        std::vector<ChunkWriteRate> hottestChunks;
+    };
+
     /**
      * Structure, which describes the statistics of a single shard host.
      */
@@ -93,6 +113,22 @@ public:
 
         // Version of mongod, which runs on this shard's primary
         std::string mongoVersion;
+
+        // How far the majority committed writes lag behind the last write on this shard's primary
+        Milliseconds majorityReplicationLag{0};
+
+        // Fraction of the storage engine cache of this shard's primary which holds dirty data
+        double dirtyCacheFraction{0};
+
+        // Rates of writes to the collections with chunks on this shard, by namespace. Collections
+        // without recent writes are omitted.
+        StringMap<CollectionWriteRates> collectionWriteRates;
+
+        /**
+         * Returns the rate of writes to the chunks of the specified collection on this shard, or
+         * zero if it is not known.
+         */
+        double getBytesWrittenPerSecond(const NamespaceString& nss) const;
     };
 
     virtual ~ClusterStatistics();
@@ -49,16 +49,21 @@ namespace mongo {
 namespace {
 
 const char kVersionField[] = "version";
+const char kLastWriteDateField[] = "lastWriteDate";
+const char kMajorityWriteDateField[] = "majorityWriteDate";
+const char kCacheDirtyBytesField[] = "tracked dirty bytes in the cache";
+const char kCacheMaxBytesField[] = "maximum bytes configured";
+const char kChunkWritesField[] = "chunkWrites";
+const char kBytesWrittenPerSecondField[] = "bytesWrittenPerSecond";
+const char kHottestChunksField[] = "hottestChunks";
 
 /**
- * Executes the serverStatus command against the specified shard and obtains the version of the
- * running MongoD service.
+ * Executes the serverStatus command against the specified shard's primary.
  *
- * Returns the MongoD version in strig format or an error. Known error codes are:
+ * Returns the serverStatus response or an error. Known error codes are:
  *  ShardNotFound if shard by that id is not available on the registry
- *  NoSuchKey if the version could not be retrieved
  */
-StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, ShardId shardId) {
+StatusWith<BSONObj> retrieveShardServerStatus(OperationContext* opCtx, ShardId shardId) {
     auto shardRegistry = Grid::get(opCtx)->shardRegistry();
     auto shardStatus = shardRegistry->getShard(opCtx, shardId);
     if (!shardStatus.isOK()) {
@@ -70,7 +75,7 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         shard->runCommandWithFixedRetryAttempts(opCtx,
                                                 ReadPreferenceSetting{ReadPreference::PrimaryOnly},
                                                 "admin",
-                                                BSON("serverStatus" << 1),
+                                                BSON("serverStatus" << 1 << kChunkWritesField << 1),
                                                 Shard::RetryPolicy::kIdempotent);
     if (!commandResponse.isOK()) {
         return commandResponse.getStatus();
@@ -79,15 +84,68 @@ StatusWith<std::string> retrieveShardMongoDVersion(OperationContext* opCtx, Shar
         return commandResponse.getValue().commandStatus;
     }
 
-    BSONObj serverStatus = std::move(commandResponse.getValue().response);
+    return std::move(commandResponse.getValue().response);
+}
+
+/**
+ * Returns how far the majority committed writes lag behind the last write according to the
+ * 'repl' section of a serverStatus response, or zero if it is not reported.
+ */
+Milliseconds getMajorityReplicationLag(const BSONObj& serverStatus) {
+    const auto lastWrite = serverStatus.getObjectField("repl").getObjectField("lastWrite");
+    const auto lastWriteDate = lastWrite[kLastWriteDateField];
+    const auto majorityWriteDate = lastWrite[kMajorityWriteDateField];
+    if (lastWriteDate.type() != Date || majorityWriteDate.type() != Date) {
+        return Milliseconds(0);
+    }
+
+    return std::max(Milliseconds(0), lastWriteDate.date() - majorityWriteDate.date());
+}
 
-    std::string version;
-    Status status = bsonExtractStringField(serverStatus, kVersionField, &version);
-    if (!status.isOK()) {
-        return status;
+/**
+ * Returns the fraction of the WiredTiger cache which holds dirty data according to a serverStatus
+ * response, or zero if it is not reported.
+ */
+double getDirtyCacheFraction(const BSONObj& serverStatus) {
+    const auto cache = serverStatus.getObjectField("wiredTiger").getObjectField("cache");
+    const auto dirtyBytes = cache[kCacheDirtyBytesField].safeNumberLong();
+    const auto maxBytes = cache[kCacheMaxBytesField].safeNumberLong();
+    if (dirtyBytes <= 0 || maxBytes <= 0) {
+        return 0;
     }
 
-    return version;
+    return static_cast<double>(dirtyBytes) / maxBytes;
+}
+
+/**
+ * Returns the rates of writes to the chunks owned by the shard according to the 'chunkWrites'
+ * section of a serverStatus response, by namespace.
+ */
+StringMap<ClusterStatistics::CollectionWriteRates> getCollectionWriteRates(
+    const BSONObj& serverStatus) {
+    StringMap<ClusterStatistics::CollectionWriteRates> collectionWriteRates;
+    for (const auto& collElem : serverStatus.getObjectField(kChunkWritesField)) {
+        if (collElem.type() != Object) {
+            continue;
+        }
+
+        const auto collObj = collElem.Obj();
+        auto& writeRates = collectionWriteRates[collElem.fieldNameStringData()];
+        writeRates.bytesWrittenPerSecond = collObj[kBytesWrittenPerSecondField].numberDouble();
+        for (const auto& chunkElem : collObj.getObjectField(kHottestChunksField)) {
+            if (chunkElem.type() != Object) {
+                continue;
+            }
+
+            const auto chunkObj = chunkElem.Obj();
+            writeRates.hottestChunks.push_back(
+                {chunkObj.getObjectField("min").getOwned(),
+                 chunkObj.getObjectField("max").getOwned(),
+                 chunkObj[kBytesWrittenPerSecondField].numberDouble()});
+        }
+    }
+
+    return collectionWriteRates;
 }
 
 }  // namespace
@@ -134,18 +192,30 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
         }
 
         std::string mongoDVersion;
+        Milliseconds majorityReplicationLag{0};
+        double dirtyCacheFraction = 0;
+        StringMap<CollectionWriteRates> collectionWriteRates;
+
+        auto serverStatus = retrieveShardServerStatus(opCtx, shard.getName());
+        auto mongoDVersionStatus = [&]() -> Status {
+            if (!serverStatus.isOK()) {
+                return serverStatus.getStatus();
+            }
+
+            majorityReplicationLag = getMajorityReplicationLag(serverStatus.getValue());
+            dirtyCacheFraction = getDirtyCacheFraction(serverStatus.getValue());
+            collectionWriteRates = getCollectionWriteRates(serverStatus.getValue());
+            return bsonExtractStringField(serverStatus.getValue(), kVersionField, &mongoDVersion);
+        }();
 
-        auto mongoDVersionStatus = retrieveShardMongoDVersion(opCtx, shard.getName());
-        if (mongoDVersionStatus.isOK()) {
-            mongoDVersion = std::move(mongoDVersionStatus.getValue());
-        } else {
+        if (!mongoDVersionStatus.isOK()) {
             // Since the mongod version is only used for reporting, there is no need to fail the
             // entire round if it cannot be retrieved, so just leave it empty
             LOGV2(21895,
                   "Unable to obtain shard version for {shardId}: {error}",
                   "Unable to obtain shard version",
                   "shardId"_attr = shard.getName(),
-                  "error"_attr = mongoDVersionStatus.getStatus());
+                  "error"_attr = mongoDVersionStatus);
         }
 
         std::set<std::string> shardTags;
@@ -160,6 +230,9 @@ StatusWith<std::vector<ShardStatistics>> ClusterStatisticsImpl::getStats(Operati
                            shard.getDraining(),
                            std::move(shardTags),
                            std::move(mongoDVersion));
+        stats.back().majorityReplicationLag = majorityReplicationLag;
+        stats.back().dirtyCacheFraction = dirtyCacheFraction;
+        stats.back().collectionWriteRates = std::move(collectionWriteRates);
     }
 
     return stats;
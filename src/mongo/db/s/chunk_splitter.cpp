@@ -40,6 +40,7 @@
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/s/chunk_split_state_driver.h"
 #include "mongo/db/s/shard_filtering_metadata_refresh.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_state.h"
 #include "mongo/db/s/split_chunk.h"
 #include "mongo/db/s/split_vector.h"
@@ -336,15 +337,31 @@ void ChunkSplitter::_runAutosplit(std::shared_ptr<ChunkSplitStateDriver> chunkSp
                     "maxChunkSizeBytes"_attr = maxChunkSizeBytes);
 
         chunkSplitStateDriver->prepareSplit();
-        auto splitPoints = splitVector(opCtx.get(),
-                                       nss,
-                                       shardKeyPattern.toBSON(),
-                                       chunk.getMin(),
-                                       chunk.getMax(),
-                                       false,
-                                       boost::none,
-                                       boost::none,
-                                       maxChunkSizeBytes);
+        auto splitPoints = [&] {
+            // Estimating the split points from a sample of the documents avoids reading every key
+            // of a large chunk from the shard key index.
+            if (const auto numSamples = autoSplitSampleSize.load(); numSamples > 0) {
+                if (auto sampledSplitPoints = splitVectorFromSamples(opCtx.get(),
+                                                                     nss,
+                                                                     shardKeyPattern.toBSON(),
+                                                                     chunk.getMin(),
+                                                                     chunk.getMax(),
+                                                                     maxChunkSizeBytes,
+                                                                     numSamples)) {
+                    return std::move(*sampledSplitPoints);
+                }
+            }
+
+            return splitVector(opCtx.get(),
+                               nss,
+                               shardKeyPattern.toBSON(),
+                               chunk.getMin(),
+                               chunk.getMax(),
+                               false,
+                               boost::none,
+                               boost::none,
+                               maxChunkSizeBytes);
+        }();
 
         if (splitPoints.empty()) {
             LOGV2_DEBUG(21907,
@@ -45,6 +45,9 @@
 namespace mongo {
 namespace {
 
+// The number of the most written to chunks of each collection reported by appendChunkWriteRates().
+const int kMaxReportedHottestChunks = 16;
+
 class UnshardedCollection : public ScopedCollectionDescription::Impl {
 public:
     UnshardedCollection() = default;
@@ -379,6 +382,53 @@ void CollectionShardingRuntime::appendShardVersion(BSONObjBuilder* builder) {
     }
 }
 
+void CollectionShardingRuntime::appendChunkWriteRates(BSONObjBuilder* builder) {
+    auto optCollDescr = getCurrentMetadataIfKnown();
+    if (!optCollDescr || !optCollDescr->isSharded()) {
+        return;
+    }
+
+    const auto& thisShardId = optCollDescr->shardId();
+    const auto now = Date_t::now();
+
+    double totalBytesWrittenPerSecond = 0;
+    std::vector<std::pair<double, ChunkRange>> chunkWriteRates;
+    optCollDescr->getChunkManager()->forEachChunk([&](const Chunk& chunk) {
+        if (chunk.getShardId() != thisShardId) {
+            return true;
+        }
+
+        const auto bytesWrittenPerSecond = chunk.getWritesTracker()->getBytesWrittenPerSecond(now);
+        if (bytesWrittenPerSecond > 0) {
+            totalBytesWrittenPerSecond += bytesWrittenPerSecond;
+            chunkWriteRates.emplace_back(bytesWrittenPerSecond, chunk.getRange());
+        }
+        return true;
+    });
+
+    if (chunkWriteRates.empty()) {
+        return;
+    }
+
+    const auto numHottestChunks =
+        std::min(chunkWriteRates.size(), size_t(kMaxReportedHottestChunks));
+    std::partial_sort(chunkWriteRates.begin(),
+                      chunkWriteRates.begin() + numHottestChunks,
+                      chunkWriteRates.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+    BSONObjBuilder collBuilder(builder->subobjStart(_nss.ns()));
+    collBuilder.append("bytesWrittenPerSecond", totalBytesWrittenPerSecond);
+
+    BSONArrayBuilder hottestChunksBuilder(collBuilder.subarrayStart("hottestChunks"));
+    for (size_t i = 0; i < numHottestChunks; ++i) {
+        const auto& [bytesWrittenPerSecond, range] = chunkWriteRates[i];
+        hottestChunksBuilder.append(BSON("min" << range.getMin() << "max" << range.getMax()
+                                               << "bytesWrittenPerSecond"
+                                               << bytesWrittenPerSecond));
+    }
+}
+
 size_t CollectionShardingRuntime::numberOfRangesScheduledForDeletion() const {
     stdx::lock_guard lk(_metadataManagerLock);
     if (_metadataManager) {
@@ -89,6 +89,8 @@ public:
 
     size_t numberOfRangesScheduledForDeletion() const override;
 
+    void appendChunkWriteRates(BSONObjBuilder* builder) override;
+
     /**
      * Returns boost::none if the description for the collection is not known yet. Otherwise
      * returns the most recently refreshed from the config server metadata.
@@ -100,6 +100,13 @@ public:
         builder->appendNumber("rangeDeleterTasks", totalNumberOfRangesScheduledForDeletion);
     }
 
+    void appendChunkWriteRatesForServerStatus(BSONObjBuilder* builder) {
+        stdx::lock_guard<Latch> lg(_mutex);
+        for (const auto& coll : _collections) {
+            coll.second->appendChunkWriteRates(builder);
+        }
+    }
+
 private:
     using CollectionsMap = StringMap<std::shared_ptr<CollectionShardingState>>;
 
@@ -148,6 +155,12 @@ void CollectionShardingState::appendInfoForServerStatus(OperationContext* opCtx,
     collectionsMap->appendInfoForServerStatus(builder);
 }
 
+void CollectionShardingState::appendChunkWriteRatesForServerStatus(OperationContext* opCtx,
+                                                                   BSONObjBuilder* builder) {
+    auto& collectionsMap = CollectionShardingStateMap::get(opCtx->getServiceContext());
+    collectionsMap->appendChunkWriteRatesForServerStatus(builder);
+}
+
 void CollectionShardingStateFactory::set(ServiceContext* service,
                                          std::unique_ptr<CollectionShardingStateFactory> factory) {
     auto& collectionsMap = CollectionShardingStateMap::get(service);
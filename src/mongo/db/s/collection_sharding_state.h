@@ -89,6 +89,13 @@ public:
      */
     static void appendInfoForServerStatus(OperationContext* opCtx, BSONObjBuilder* builder);
 
+    /**
+     * Reports the rates of writes to the chunks owned by this shard of all sharded collections, by
+     * namespace.
+     */
+    static void appendChunkWriteRatesForServerStatus(OperationContext* opCtx,
+                                                     BSONObjBuilder* builder);
+
     /**
      * If the shard currently doesn't know whether the collection is sharded or not, it will throw
      * StaleShardVersion.
@@ -147,6 +154,12 @@ public:
      */
     virtual size_t numberOfRangesScheduledForDeletion() const = 0;
 
+    /**
+     * Appends the rate of writes to the chunks of the collection owned by this shard and the
+     * hottest of those chunks, if the collection is sharded.
+     */
+    virtual void appendChunkWriteRates(BSONObjBuilder* builder) = 0;
+
 protected:
     /**
      * It is the caller's responsibility to ensure that the collection locks for this namespace are
@@ -66,6 +66,8 @@ public:
     size_t numberOfRangesScheduledForDeletion() const override {
         return 0;
     }
+
+    void appendChunkWriteRates(BSONObjBuilder* builder) override {}
 };
 
 }  // namespace
@@ -592,6 +592,9 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromIndexScan(OperationCon
                            internalQueryExecYieldIterations.load(),
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
+    // The executor scans the chunk in order, so concurrent _migrateClone requests take turns.
+    stdx::lock_guard<Latch> indexScanLk(_indexScanMutex);
+
     if (!_jumboChunkCloneState->clonerExec) {
         auto exec = uassertStatusOK(_getIndexScanExecutor(
             opCtx, collection, InternalPlanner::IndexScanOptions::IXSCAN_FETCH));
@@ -651,16 +654,17 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
                            Milliseconds(internalQueryExecYieldPeriodMS.load()));
 
     stdx::unique_lock<Latch> lk(_mutex);
-    auto iter = _cloneLocs.begin();
 
-    for (; iter != _cloneLocs.end(); ++iter) {
+    while (!_cloneLocs.empty()) {
         // We must always make progress in this method by at least one document because empty
         // return indicates there is no more initial clone data.
         if (arrBuilder->arrSize() && tracker.intervalHasElapsed()) {
             break;
         }
 
-        auto nextRecordId = *iter;
+        // Take the record id out of the set before reading the document, so that concurrent
+        // _migrateClone requests from the recipient return disjoint sets of documents.
+        auto nextRecordId = _cloneLocs.extract(_cloneLocs.begin()).value();
 
         lk.unlock();
 
@@ -670,7 +674,9 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
             // that we take into consideration the overhead of BSONArray indices.
             if (arrBuilder->arrSize() &&
                 (arrBuilder->len() + doc.value().objsize() + 1024) > BSONObjMaxUserSize) {
-
+                // Leave the document for the next batch.
+                lk.lock();
+                _cloneLocs.insert(nextRecordId);
                 break;
             }
 
@@ -680,8 +686,6 @@ void MigrationChunkClonerSourceLegacy::_nextCloneBatchFromCloneLocs(OperationCon
 
         lk.lock();
     }
-
-    _cloneLocs.erase(_cloneLocs.begin(), iter);
 }
 
 uint64_t MigrationChunkClonerSourceLegacy::getCloneBatchBufferAllocationSize() {
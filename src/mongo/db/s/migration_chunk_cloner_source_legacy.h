@@ -146,8 +146,8 @@ public:
 
     /**
      * Called by the recipient shard. Populates the passed BSONArrayBuilder with a set of documents,
-     * which are part of the initial clone sequence. Assumes that there is only one active caller
-     * to this method at a time (otherwise, it can cause corruption/crash).
+     * which are part of the initial clone sequence. Concurrent callers receive disjoint sets of
+     * documents, so the recipient may fetch the initial clone over several concurrent requests.
      *
      * Returns OK status on success. If there were documents returned in the result argument, this
      * method should be called more times until the result is empty. If it returns failure, it is
@@ -344,6 +344,10 @@ private:
 
     std::unique_ptr<SessionCatalogMigrationSource> _sessionCatalogSource;
 
+    // Serializes the clone batches read through the index scan executor of a jumbo chunk. Must be
+    // acquired before '_mutex'.
+    Mutex _indexScanMutex = MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_indexScanMutex");
+
     // Protects the entries below
     Mutex _mutex = MONGO_MAKE_LATCH("MigrationChunkClonerSourceLegacy::_mutex");
 
@@ -53,8 +53,8 @@ namespace {
 
 /**
  * Shortcut class to perform the appropriate checks and acquire the cloner associated with the
- * currently active migration. Uses the currently registered migration for this shard and ensures
- * the session ids match.
+ * currently active migration. Uses the migration registered for this shard whose session id
+ * matches the requested one, since several chunks may be donated at the same time.
  */
 class AutoGetActiveCloner {
     AutoGetActiveCloner(const AutoGetActiveCloner&) = delete;
@@ -64,40 +64,62 @@ public:
     AutoGetActiveCloner(OperationContext* opCtx,
                         const MigrationSessionId& migrationSessionId,
                         const bool holdCollectionLock) {
-        const auto nss = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
-        uassert(ErrorCodes::NotYetInitialized, "No active migrations were found", nss);
-
-        // Once the collection is locked, the migration status cannot change
-        _autoColl.emplace(opCtx, *nss, MODE_IS);
-
-        uassert(ErrorCodes::NamespaceNotFound,
-                str::stream() << "Collection " << nss->ns() << " does not exist",
-                _autoColl->getCollection());
+        const auto namespaces = ActiveMigrationsRegistry::get(opCtx).getActiveDonateChunkNss();
+        uassert(
+            ErrorCodes::NotYetInitialized, "No active migrations were found", !namespaces.empty());
+
+        for (const auto& nss : namespaces) {
+            // The errors about a single migration are only reported if it is the only candidate
+            const bool isOnlyMigration = namespaces.size() == 1;
+
+            // Once the collection is locked, the migration status cannot change
+            _autoColl.emplace(opCtx, nss, MODE_IS);
+
+            if (!_autoColl->getCollection()) {
+                uassert(ErrorCodes::NamespaceNotFound,
+                        str::stream() << "Collection " << nss.ns() << " does not exist",
+                        !isOnlyMigration);
+                continue;
+            }
 
-        {
-            auto csr = CollectionShardingRuntime::get(opCtx, *nss);
-            auto csrLock = CollectionShardingRuntime::CSRLock::lockShared(opCtx, csr);
+            {
+                auto csr = CollectionShardingRuntime::get(opCtx, nss);
+                auto csrLock = CollectionShardingRuntime::CSRLock::lockShared(opCtx, csr);
+
+                auto msm = MigrationSourceManager::get(csr, csrLock);
+                if (!msm) {
+                    uassert(ErrorCodes::IllegalOperation,
+                            str::stream()
+                                << "No active migrations were found for collection " << nss.ns(),
+                            !isOnlyMigration);
+                    continue;
+                }
 
-            if (auto msm = MigrationSourceManager::get(csr, csrLock)) {
                 // It is now safe to access the cloner
                 _chunkCloner =
                     std::dynamic_pointer_cast<MigrationChunkClonerSourceLegacy,
                                               MigrationChunkClonerSource>(msm->getCloner());
                 invariant(_chunkCloner);
-            } else {
-                uasserted(ErrorCodes::IllegalOperation,
-                          str::stream()
-                              << "No active migrations were found for collection " << nss->ns());
             }
+
+            // Ensure the session ids are correct
+            if (migrationSessionId.matches(_chunkCloner->getSessionId())) {
+                break;
+            }
+
+            uassert(ErrorCodes::IllegalOperation,
+                    str::stream() << "Requested migration session id "
+                                  << migrationSessionId.toString()
+                                  << " does not match active session id "
+                                  << _chunkCloner->getSessionId().toString(),
+                    !isOnlyMigration);
+            _chunkCloner.reset();
         }
 
-        // Ensure the session ids are correct
         uassert(ErrorCodes::IllegalOperation,
                 str::stream() << "Requested migration session id " << migrationSessionId.toString()
-                              << " does not match active session id "
-                              << _chunkCloner->getSessionId().toString(),
-                migrationSessionId.matches(_chunkCloner->getSessionId()));
-
+                              << " does not match any active migration",
+                _chunkCloner);
 
         if (!holdCollectionLock)
             _autoColl = boost::none;
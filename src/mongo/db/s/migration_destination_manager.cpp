@@ -446,69 +446,138 @@ Status MigrationDestinationManager::start(OperationContext* opCtx,
 repl::OpTime MigrationDestinationManager::cloneDocumentsFromDonor(
     OperationContext* opCtx,
     std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-    std::function<BSONObj(OperationContext*)> fetchBatchFn) {
+    std::function<BSONObj(OperationContext*)> fetchBatchFn,
+    int numStreams,
+    size_t maxBufferedBytes) {
+    invariant(numStreams > 0);
+
+    // The fetched batches are charged for their size against the budget, but there is always room
+    // for one of them so that a batch of the maximum size can make progress.
+    struct BatchCost {
+        size_t operator()(const BSONObj& batch) const {
+            return batch.objsize();
+        }
+    };
+
+    MultiProducerMultiConsumerQueue<BSONObj, BatchCost>::Options options;
+    options.maxQueueDepth = std::max(maxBufferedBytes, static_cast<size_t>(BSONObjMaxInternalSize));
 
-    SingleProducerSingleConsumerQueue<BSONObj>::Options options;
-    options.maxQueueDepth = 1;
+    MultiProducerMultiConsumerQueue<BSONObj, BatchCost> batches(options);
 
-    SingleProducerSingleConsumerQueue<BSONObj> batches(options);
+    auto mutex = MONGO_MAKE_LATCH("MigrationDestinationManager::cloneDocumentsFromDonor");
     repl::OpTime lastOpApplied;
+    Status fetchStatus = Status::OK();
 
-    stdx::thread inserterThread{[&] {
-        Client::initThread("chunkInserter", opCtx->getServiceContext(), nullptr);
+    auto makeClient = [&](StringData name) {
+        Client::initThread(name, opCtx->getServiceContext(), nullptr);
         auto client = Client::getCurrent();
         {
             stdx::lock_guard lk(*client);
             client->setSystemOperationKillableByStepdown(lk);
         }
+        return client;
+    };
 
+    auto runInserter = [&] {
+        auto client = makeClient("chunkInserter");
         auto inserterOpCtx = client->makeOperationContext();
-        auto consumerGuard = makeGuard([&] {
-            batches.closeConsumerEnd();
-            lastOpApplied = repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp();
+        ON_BLOCK_EXIT([&] {
+            stdx::lock_guard<Latch> lk(mutex);
+            lastOpApplied = std::max(
+                lastOpApplied,
+                repl::ReplClientInfo::forClient(inserterOpCtx->getClient()).getLastOp());
         });
 
         try {
             while (true) {
                 auto nextBatch = batches.pop(inserterOpCtx.get());
-                auto arr = nextBatch["objects"].Obj();
-                if (arr.isEmpty()) {
-                    return;
-                }
-                insertBatchFn(inserterOpCtx.get(), arr);
+                insertBatchFn(inserterOpCtx.get(), nextBatch["objects"].Obj());
             }
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueConsumed>&) {
+            // Every batch has been inserted.
+        } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
+            // Another thread failed and reported the error.
         } catch (...) {
-            stdx::lock_guard<Client> lk(*opCtx->getClient());
-            opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
+            {
+                stdx::lock_guard<Client> lk(*opCtx->getClient());
+                opCtx->getServiceContext()->killOperation(lk, opCtx, ErrorCodes::Error(51008));
+            }
+            batches.closeConsumerEnd();
             LOGV2(21999,
                   "Batch insertion failed: {error}",
                   "Batch insertion failed",
                   "error"_attr = redact(exceptionToStatus()));
         }
-    }};
-
-
-    {
-        auto inserterThreadJoinGuard = makeGuard([&] {
-            batches.closeProducerEnd();
-            inserterThread.join();
-        });
+    };
 
+    // Each stream fetches batches until the donor returns an empty one. The donor hands out
+    // disjoint sets of documents to concurrent requests, so every stream sees the end of the
+    // initial clone.
+    auto fetchBatches = [&](OperationContext* fetcherOpCtx) {
         while (true) {
-            auto res = fetchBatchFn(opCtx);
+            auto res = fetchBatchFn(fetcherOpCtx);
+            if (res["objects"].Obj().isEmpty()) {
+                return;
+            }
             try {
-                batches.push(res.getOwned(), opCtx);
-                auto arr = res["objects"].Obj();
-                if (arr.isEmpty()) {
-                    break;
-                }
+                batches.push(res.getOwned(), fetcherOpCtx);
             } catch (const ExceptionFor<ErrorCodes::ProducerConsumerQueueEndClosed>&) {
-                break;
+                return;
+            }
+        }
+    };
+
+    auto runFetcher = [&] {
+        auto client = makeClient("chunkFetcher");
+        auto fetcherOpCtx = client->makeOperationContext();
+        try {
+            fetchBatches(fetcherOpCtx.get());
+        } catch (...) {
+            {
+                stdx::lock_guard<Latch> lk(mutex);
+                if (fetchStatus.isOK()) {
+                    fetchStatus = exceptionToStatus();
+                }
             }
+            batches.closeConsumerEnd();
         }
-    }  // This scope ensures that the guard is destroyed
+    };
 
-    // This check is necessary because the consumer thread uses killOp to propagate errors to the
+    std::vector<stdx::thread> inserterThreads;
+    std::vector<stdx::thread> fetcherThreads;
+    auto joinAll = [](std::vector<stdx::thread>& threads) {
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    };
+
+    {
+        auto threadsJoinGuard = makeGuard([&] {
+            batches.closeConsumerEnd();
+            joinAll(fetcherThreads);
+            joinAll(inserterThreads);
+        });
+
+        for (int i = 0; i < numStreams; ++i) {
+            inserterThreads.emplace_back(runInserter);
+        }
+        for (int i = 1; i < numStreams; ++i) {
+            fetcherThreads.emplace_back(runFetcher);
+        }
+
+        // The first stream runs on this thread.
+        fetchBatches(opCtx);
+
+        joinAll(fetcherThreads);
+        batches.closeProducerEnd();
+        joinAll(inserterThreads);
+        threadsJoinGuard.dismiss();
+    }
+
+    uassertStatusOK(fetchStatus);
+
+    // This check is necessary because the consumer threads use killOp to propagate errors to the
     // producer thread (this thread)
     opCtx->checkForInterrupt();
     return lastOpApplied;
@@ -1047,6 +1116,10 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
             uassert(50748, "Migration aborted while copying documents", getState() != ABORT);
         };
 
+        // Inserter threads share the session of 'outerOpCtx' while waiting for replication.
+        auto secondaryThrottleMutex =
+            MONGO_MAKE_LATCH("MigrationDestinationManager::secondaryThrottleMutex");
+
         auto insertBatchFn = [&](OperationContext* opCtx, BSONObj arr) {
             auto it = arr.begin();
             while (it != arr.end()) {
@@ -1089,6 +1162,7 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
                     _clonedBytes += batchClonedBytes;
                 }
                 if (_writeConcern.needToWaitForOtherNodes()) {
+                    stdx::lock_guard<Latch> secondaryThrottleLk(secondaryThrottleMutex);
                     runWithoutSession(outerOpCtx, [&] {
                         repl::ReplicationCoordinator::StatusAndDuration replStatus =
                             repl::ReplicationCoordinator::get(opCtx)->awaitReplication(
@@ -1127,7 +1201,12 @@ void MigrationDestinationManager::_migrateDriver(OperationContext* outerOpCtx) {
 
         // If running on a replicated system, we'll need to flush the docs we cloned to the
         // secondaries
-        lastOpApplied = cloneDocumentsFromDonor(opCtx, insertBatchFn, fetchBatchFn);
+        lastOpApplied =
+            cloneDocumentsFromDonor(opCtx,
+                                    insertBatchFn,
+                                    fetchBatchFn,
+                                    migrateCloneConcurrency.load(),
+                                    static_cast<size_t>(migrateCloneMaxBufferedBytes.load()));
 
         timing.done(3);
         migrateThreadHangAtStep3.pauseWhileSet();
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 
 #include "mongo/base/string_data.h"
@@ -114,12 +115,17 @@ public:
                  const WriteConcernOptions& writeConcern);
 
     /**
-     * Clones documents from a donor shard.
+     * Clones documents from a donor shard. Runs 'numStreams' concurrent loops calling
+     * 'fetchBatchFn' until it returns an empty batch, and as many threads calling 'insertBatchFn'
+     * on the fetched batches. At most 'maxBufferedBytes' of fetched batches are buffered, but at
+     * least one.
      */
     static repl::OpTime cloneDocumentsFromDonor(
         OperationContext* opCtx,
         std::function<void(OperationContext*, BSONObj)> insertBatchFn,
-        std::function<BSONObj(OperationContext*)> fetchBatchFn);
+        std::function<BSONObj(OperationContext*)> fetchBatchFn,
+        int numStreams = 1,
+        size_t maxBufferedBytes = std::numeric_limits<size_t>::max());
 
     /**
      * Idempotent method, which causes the current ongoing migration to abort only if it has the
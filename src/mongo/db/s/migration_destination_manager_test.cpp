@@ -157,6 +157,66 @@ TEST_F(MigrationDestinationManagerTest, CloneDocumentsCatchesInsertErrors) {
     ASSERT_EQ(operationContext()->getKillStatus(), 51008);
 }
 
+// Tests that concurrent streams fetch and insert every batch exactly once.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsFromDonorWithConcurrentStreams) {
+    const int kNumBatches = 50;
+
+    auto mutex = MONGO_MAKE_LATCH();
+    int nextBatch = 0;
+    std::set<int> insertedIds;
+
+    auto fetchBatchFn = [&](OperationContext* opCtx) {
+        BSONObjBuilder fetchBatchResultBuilder;
+        BSONArrayBuilder arrayBuilder(fetchBatchResultBuilder.subarrayStart("objects"));
+        {
+            stdx::lock_guard<Latch> lk(mutex);
+            if (nextBatch < kNumBatches) {
+                arrayBuilder.append(createDocument(2 * nextBatch));
+                arrayBuilder.append(createDocument(2 * nextBatch + 1));
+                ++nextBatch;
+            }
+        }
+        arrayBuilder.done();
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {
+        stdx::lock_guard<Latch> lk(mutex);
+        for (auto&& docToClone : docs) {
+            ASSERT(insertedIds.insert(docToClone.Obj()["_id"].numberInt()).second);
+        }
+    };
+
+    MigrationDestinationManager::cloneDocumentsFromDonor(
+        operationContext(), insertBatchFn, fetchBatchFn, 4 /* numStreams */, 1024);
+
+    ASSERT_EQ(2 * kNumBatches, insertedIds.size());
+    ASSERT_EQ(0, *insertedIds.begin());
+    ASSERT_EQ(2 * kNumBatches - 1, *insertedIds.rbegin());
+}
+
+// Tests that an exception in the fetch logic of any stream will successfully throw an exception on
+// the main thread.
+TEST_F(MigrationDestinationManagerTest, CloneDocumentsThrowsFetchErrorsOfConcurrentStreams) {
+    auto fetchBatchFn = [&](OperationContext* opCtx) -> BSONObj {
+        if (opCtx != operationContext()) {
+            uasserted(ErrorCodes::NetworkTimeout, "network error");
+        }
+
+        BSONObjBuilder fetchBatchResultBuilder;
+        fetchBatchResultBuilder.append("objects", createDocumentsToCloneArray());
+        return fetchBatchResultBuilder.obj();
+    };
+
+    auto insertBatchFn = [&](OperationContext* opCtx, BSONObj docs) {};
+
+    ASSERT_THROWS_CODE_AND_WHAT(MigrationDestinationManager::cloneDocumentsFromDonor(
+                                    operationContext(), insertBatchFn, fetchBatchFn, 2),
+                                DBException,
+                                ErrorCodes::NetworkTimeout,
+                                "network error");
+}
+
 using MigrationDestinationManagerNetworkTest = CatalogCacheTestFixture;
 
 // Verifies MigrationDestinationManager::getCollectionOptions() and
@@ -56,8 +56,10 @@
 #include "mongo/db/repl/repl_client_info.h"
 #include "mongo/db/repl/wait_for_majority_service.h"
 #include "mongo/db/s/migration_util.h"
+#include "mongo/db/s/sharding_runtime_d_params_gen.h"
 #include "mongo/db/s/sharding_statistics.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/remove_saver.h"
 #include "mongo/db/write_concern.h"
 #include "mongo/executor/task_executor.h"
@@ -114,8 +116,8 @@ bool collectionUuidHasChanged(const NamespaceString& nss,
 }
 
 /**
- * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress. Must
- * be called under the collection lock.
+ * Performs the deletion of up to numDocsToRemovePerBatch entries within the range in progress, in
+ * index order and in a single storage transaction. Must be called under the collection lock.
  *
  * Returns the number of documents deleted, 0 if done with the range, or bad status if deleting
  * the range failed.
@@ -188,7 +190,7 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
                                                      min,
                                                      max,
                                                      BoundInclusion::kIncludeStartKeyOnly,
-                                                     PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
+                                                     PlanYieldPolicy::YieldPolicy::INTERRUPT_ONLY,
                                                      InternalPlanner::FORWARD);
 
     if (MONGO_unlikely(hangBeforeDoingDeletion.shouldFail())) {
@@ -196,6 +198,9 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         hangBeforeDoingDeletion.pauseWhileSet(opCtx);
     }
 
+    // The whole batch is deleted in one storage transaction, so the executor cannot yield and
+    // a write conflict aborts the batch, which is then retried.
+    WriteUnitOfWork wuow(opCtx);
     int numDeleted = 0;
     do {
         BSONObj deletedObj;
@@ -211,6 +216,8 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         PlanExecutor::ExecState state;
         try {
             state = exec->getNext(&deletedObj, nullptr);
+        } catch (const WriteConflictException&) {
+            throw;
         } catch (const DBException& ex) {
             auto&& explainer = exec->getPlanExplainer();
             auto&& [stats, _] =
@@ -232,13 +239,85 @@ StatusWith<int> deleteNextBatch(OperationContext* opCtx,
         }
 
         invariant(PlanExecutor::ADVANCED == state);
-        ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(1);
-
     } while (++numDeleted < numDocsToRemovePerBatch);
 
+    wuow.commit();
+    ShardingStatistics::get(opCtx).countDocsDeletedOnDonor.addAndFetch(numDeleted);
+
     return numDeleted;
 }
 
+/**
+ * Sizes the batches of a range deletion, and the delays between them, after the fraction of the
+ * storage engine cache which holds dirty data. While the cache keeps up with the deletes, the
+ * batches double up to rangeDeleterMaxBatchSize and the delay goes back to the configured one.
+ * While the dirty fraction is above rangeDeleterMaxDirtyCacheFraction, the batches halve and the
+ * delay doubles up to rangeDeleterMaxBatchDelayMS, so that eviction can catch up before it stalls
+ * user operations. Storage engines which do not report the dirty fraction keep the configured
+ * batch size and delay.
+ */
+class RangeDeletionThrottle {
+public:
+    RangeDeletionThrottle(int batchSize, Milliseconds delayBetweenBatches)
+        : _initialBatchSize(batchSize),
+          _batchSize(batchSize),
+          _initialDelay(delayBetweenBatches),
+          _delay(delayBetweenBatches) {}
+
+    int batchSize() const {
+        return _batchSize;
+    }
+
+    Milliseconds delay() const {
+        return _delay;
+    }
+
+    void onBatchDeleted(OperationContext* opCtx) {
+        auto kvEngine = opCtx->getServiceContext()->getStorageEngine()->getEngine();
+        boost::optional<double> dirtyFraction;
+        if (kvEngine) {
+            dirtyFraction = kvEngine->getCacheDirtyFraction();
+        }
+        if (!dirtyFraction) {
+            return;
+        }
+
+        if (*dirtyFraction > rangeDeleterMaxDirtyCacheFraction.load()) {
+            const Milliseconds maxDelay{
+                std::max<long long>(rangeDeleterMaxBatchDelayMS.load(), _initialDelay.count())};
+            _batchSize = std::max(1, _batchSize / 2);
+            _delay = std::min(std::max(_delay * 2, Milliseconds(1)), maxDelay);
+        } else {
+            const long long maxBatchSize =
+                std::max(rangeDeleterMaxBatchSize.load(), _initialBatchSize);
+            _batchSize = static_cast<int>(std::min(2LL * _batchSize, maxBatchSize));
+            _delay = _initialDelay;
+        }
+    }
+
+private:
+    const int _initialBatchSize;
+    int _batchSize;
+    const Milliseconds _initialDelay;
+    Milliseconds _delay;
+};
+
+/**
+ * Lets AsyncTry wait between the batches of a range deletion for as long as the throttle says.
+ */
+class RangeDeletionBackoff {
+public:
+    explicit RangeDeletionBackoff(std::shared_ptr<RangeDeletionThrottle> throttle)
+        : _throttle(std::move(throttle)) {}
+
+    Milliseconds nextSleep() {
+        return _throttle->delay();
+    }
+
+private:
+    std::shared_ptr<RangeDeletionThrottle> _throttle;
+};
+
 
 template <typename Callable>
 auto withTemporaryOperationContext(Callable&& callable) {
@@ -290,7 +369,8 @@ void ensureRangeDeletionTaskStillExists(OperationContext* opCtx, const UUID& mig
 
 /**
  * Delete the range in a sequence of batches until there are no more documents to
- * delete or deletion returns an error.
+ * delete or deletion returns an error. The batches of the range interleave on the executor with
+ * those of the other ranges being deleted.
  */
 ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskExecutor>& executor,
                                           const NamespaceString& nss,
@@ -300,6 +380,8 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                           const boost::optional<UUID>& migrationId,
                                           int numDocsToRemovePerBatch,
                                           Milliseconds delayBetweenBatches) {
+    auto throttle =
+        std::make_shared<RangeDeletionThrottle>(numDocsToRemovePerBatch, delayBetweenBatches);
     return AsyncTry([=] {
                return withTemporaryOperationContext([=](OperationContext* opCtx) {
                    LOGV2_DEBUG(5346200,
@@ -307,28 +389,33 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                                "Starting batch deletion",
                                "namespace"_attr = nss,
                                "range"_attr = redact(range.toString()),
-                               "numDocsToRemovePerBatch"_attr = numDocsToRemovePerBatch,
-                               "delayBetweenBatches"_attr = delayBetweenBatches);
+                               "numDocsToRemovePerBatch"_attr = throttle->batchSize(),
+                               "delayBetweenBatches"_attr = throttle->delay());
 
                    if (migrationId) {
                        ensureRangeDeletionTaskStillExists(opCtx, *migrationId);
                    }
 
-                   AutoGetCollection collection(opCtx, nss, MODE_IX);
+                   auto numDeleted = [&] {
+                       AutoGetCollection collection(opCtx, nss, MODE_IX);
+
+                       // Ensure the collection exists and has not been dropped or dropped and
+                       // recreated.
+                       uassert(ErrorCodes::
+                                   RangeDeletionAbandonedBecauseCollectionWithUUIDDoesNotExist,
+                               "Collection has been dropped since enqueuing this range "
+                               "deletion task. No need to delete documents.",
+                               !collectionUuidHasChanged(
+                                   nss, collection.getCollection(), collectionUuid));
 
-                   // Ensure the collection exists and has not been dropped or dropped and
-                   // recreated.
-                   uassert(
-                       ErrorCodes::RangeDeletionAbandonedBecauseCollectionWithUUIDDoesNotExist,
-                       "Collection has been dropped since enqueuing this range "
-                       "deletion task. No need to delete documents.",
-                       !collectionUuidHasChanged(nss, collection.getCollection(), collectionUuid));
+                       return uassertStatusOK(deleteNextBatch(opCtx,
+                                                              collection.getCollection(),
+                                                              keyPattern,
+                                                              range,
+                                                              throttle->batchSize()));
+                   }();
 
-                   auto numDeleted = uassertStatusOK(deleteNextBatch(opCtx,
-                                                                     collection.getCollection(),
-                                                                     keyPattern,
-                                                                     range,
-                                                                     numDocsToRemovePerBatch));
+                   throttle->onBatchDeleted(opCtx);
 
                    LOGV2_DEBUG(
                        23769,
@@ -355,7 +442,7 @@ ExecutorFuture<void> deleteRangeInBatches(const std::shared_ptr<executor::TaskEx
                 ErrorCodes::isShutdownError(swNumDeleted.getStatus()) ||
                 ErrorCodes::isNotPrimaryError(swNumDeleted.getStatus());
         })
-        .withDelayBetweenIterations(delayBetweenBatches)
+        .withBackoffBetweenIterations(RangeDeletionBackoff(throttle))
         .on(executor, CancellationToken::uncancelable())
         .ignoreValue();
 }
@@ -61,8 +61,10 @@ extern AtomicWord<int> rangeDeleterBatchDelayMS;
  *    for the waitForActiveQueriesToComplete future to resolve.
  * 2. Waits for delayForActiveQueriesOnSecondariesToComplete seconds before deleting any documents,
  *    to give queries running on secondaries a chance to finish.
- * 3. Delete documents in a series of batches with up to numDocsToRemovePerBatch documents per
- *    batch, with a delay of delayBetweenBatches milliseconds in between batches.
+ * 3. Delete documents in a series of batches, each in one storage transaction, starting with
+ *    numDocsToRemovePerBatch documents per batch and a delay of delayBetweenBatches milliseconds in
+ *    between batches. The batches grow while the storage engine cache keeps up with the deletes,
+ *    and shrink, with longer delays in between them, while too much of the cache is dirty.
  */
 SharedSemiFuture<void> removeDocumentsInRange(
     const std::shared_ptr<executor::TaskExecutor>& executor,
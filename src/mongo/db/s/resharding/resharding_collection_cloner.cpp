@@ -33,6 +33,7 @@
 
 #include "mongo/db/s/resharding/resharding_collection_cloner.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "mongo/bson/json.h"
@@ -43,12 +44,14 @@
 #include "mongo/db/curop.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/logical_session_id_helpers.h"
+#include "mongo/db/persistent_task_store.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_source_lookup.h"
 #include "mongo/db/pipeline/document_source_match.h"
 #include "mongo/db/pipeline/document_source_replace_root.h"
 #include "mongo/db/pipeline/sharded_agg_helpers.h"
 #include "mongo/db/query/query_request_helper.h"
+#include "mongo/db/s/resharding/resharding_collection_cloner_progress_gen.h"
 #include "mongo/db/s/resharding/resharding_data_copy_util.h"
 #include "mongo/db/s/resharding/resharding_future_util.h"
 #include "mongo/db/s/resharding/resharding_metrics.h"
@@ -65,6 +68,9 @@
 namespace mongo {
 namespace {
 
+// The number of documents sampled from the source collection for each _id range it is split into.
+constexpr int kSamplesPerIdRange = 100;
+
 bool collectionHasSimpleCollation(OperationContext* opCtx, const NamespaceString& nss) {
     auto catalogCache = Grid::get(opCtx)->catalogCache();
     auto sourceChunkMgr = uassertStatusOK(catalogCache->getCollectionRoutingInfo(opCtx, nss));
@@ -76,6 +82,20 @@ bool collectionHasSimpleCollation(OperationContext* opCtx, const NamespaceString
     return !sourceChunkMgr.getDefaultCollator();
 }
 
+AggregateCommandRequest makeAggregateRequest(const NamespaceString& nss,
+                                             const CollectionUUID& uuid,
+                                             const Pipeline& pipeline,
+                                             Timestamp atClusterTime) {
+    AggregateCommandRequest request(nss, pipeline.serializeToBson());
+    request.setCollectionUUID(uuid);
+    request.setReadConcern(BSON(repl::ReadConcernArgs::kLevelFieldName
+                                << repl::readConcernLevels::kSnapshotName
+                                << repl::ReadConcernArgs::kAtClusterTimeFieldName
+                                << atClusterTime));
+    request.setUnwrappedReadPref(ReadPreferenceSetting{ReadPreference::Nearest}.toContainingBSON());
+    return request;
+}
+
 }  // namespace
 
 ReshardingCollectionCloner::ReshardingCollectionCloner(std::unique_ptr<Env> env,
@@ -96,7 +116,8 @@ ReshardingCollectionCloner::ReshardingCollectionCloner(std::unique_ptr<Env> env,
 std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipeline(
     OperationContext* opCtx,
     std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
-    Value resumeId) {
+    Value resumeId,
+    const IdRange& range) {
     using Doc = Document;
     using Arr = std::vector<Value>;
     using V = Value;
@@ -141,12 +162,20 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::makePipel
 
     Pipeline::SourceContainer stages;
 
-    if (!resumeId.missing()) {
-        stages.emplace_back(DocumentSourceMatch::create(
-            Doc{{"$expr",
-                 Doc{{"$gte", Arr{V{"$_id"_sd}, V{Doc{{"$literal", std::move(resumeId)}}}}}}}}
-                .toBson(),
-            expCtx));
+    Arr idBounds;
+    if (auto minId = resumeId.missing() ? range.min : std::move(resumeId); !minId.missing()) {
+        idBounds.emplace_back(
+            Doc{{"$gte", Arr{V{"$_id"_sd}, V{Doc{{"$literal", std::move(minId)}}}}}});
+    }
+    if (!range.max.missing()) {
+        idBounds.emplace_back(Doc{{"$lt", Arr{V{"$_id"_sd}, V{Doc{{"$literal", range.max}}}}}});
+    }
+
+    if (!idBounds.empty()) {
+        auto idFilter = idBounds.size() == 1 ? std::move(idBounds.front())
+                                             : V{Doc{{"$and", std::move(idBounds)}}};
+        stages.emplace_back(
+            DocumentSourceMatch::create(Doc{{"$expr", std::move(idFilter)}}.toBson(), expCtx));
     }
 
     stages.emplace_back(DocumentSourceReplaceRoot::createFromBson(
@@ -222,8 +251,7 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_targetAg
     // shard while idle for a long period on another donor shard.
     opCtx->setLogicalSessionId(makeLogicalSessionId(opCtx));
 
-    AggregateCommandRequest request(_sourceNss, pipeline.serializeToBson());
-    request.setCollectionUUID(_sourceUUID);
+    auto request = makeAggregateRequest(_sourceNss, _sourceUUID, pipeline, _atClusterTime);
 
     auto hint = collectionHasSimpleCollation(opCtx, _sourceNss)
         ? boost::optional<BSONObj>{BSON("_id" << 1)}
@@ -233,12 +261,6 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_targetAg
         request.setHint(*hint);
     }
 
-    request.setReadConcern(BSON(repl::ReadConcernArgs::kLevelFieldName
-                                << repl::readConcernLevels::kSnapshotName
-                                << repl::ReadConcernArgs::kAtClusterTimeFieldName
-                                << _atClusterTime));
-    request.setUnwrappedReadPref(ReadPreferenceSetting{ReadPreference::Nearest}.toContainingBSON());
-
     return shardVersionRetry(opCtx,
                              Grid::get(opCtx)->catalogCache(),
                              _sourceNss,
@@ -253,14 +275,15 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_targetAg
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_restartPipeline(
-    OperationContext* opCtx) {
+    OperationContext* opCtx, const IdRange& range) {
     auto idToResumeFrom = [&] {
         AutoGetCollection outputColl(opCtx, _outputNss, MODE_IS);
         uassert(ErrorCodes::NamespaceNotFound,
                 str::stream() << "Resharding collection cloner's output collection '" << _outputNss
                               << "' did not already exist",
                 outputColl);
-        return resharding::data_copy::findHighestInsertedId(opCtx, *outputColl);
+        return resharding::data_copy::findHighestInsertedIdInRange(
+            opCtx, *outputColl, range.min, range.max);
     }();
 
     // The BlockingResultsMerger underlying by the $mergeCursors stage records how long the
@@ -271,7 +294,7 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_restartP
     ON_BLOCK_EXIT([curOp] { curOp->done(); });
 
     auto pipeline = _targetAggregationRequest(
-        opCtx, *makePipeline(opCtx, MongoProcessInterface::create(opCtx), idToResumeFrom));
+        opCtx, *makePipeline(opCtx, MongoProcessInterface::create(opCtx), idToResumeFrom, range));
 
     if (!idToResumeFrom.missing()) {
         // Skip inserting the first document retrieved after resuming because $gte was used in the
@@ -300,6 +323,131 @@ std::unique_ptr<Pipeline, PipelineDeleter> ReshardingCollectionCloner::_restartP
     return pipeline;
 }
 
+std::vector<ReshardingCollectionCloner::IdRange> ReshardingCollectionCloner::_getIdRanges(
+    OperationContext* opCtx) {
+    PersistentTaskStore<ReshardingCollectionClonerProgress> store(
+        NamespaceString::kReshardingCollectionClonerProgressNamespace);
+
+    boost::optional<ReshardingCollectionClonerProgress> progress;
+    store.forEach(opCtx,
+                  QUERY(ReshardingCollectionClonerProgress::kSourceUUIDFieldName << _sourceUUID),
+                  [&](const auto& doc) {
+                      progress = doc;
+                      return false;
+                  });
+
+    if (!progress) {
+        const auto numRanges = resharding::gReshardingCollectionClonerReaderCount;
+        if (numRanges == 1 || !collectionHasSimpleCollation(opCtx, _sourceNss)) {
+            return {IdRange{}};
+        }
+
+        // The boundaries are persisted before the first document is inserted. Documents already
+        // being present means they were inserted by a single reader, which must then go on alone.
+        const bool hasStartedCloning = [&] {
+            AutoGetCollection outputColl(opCtx, _outputNss, MODE_IS);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Resharding collection cloner's output collection '"
+                                  << _outputNss << "' did not already exist",
+                    outputColl);
+            return outputColl->numRecords(opCtx) > 0;
+        }();
+        if (hasStartedCloning) {
+            return {IdRange{}};
+        }
+
+        progress.emplace(_sourceUUID, _sampleIdBoundaries(opCtx, numRanges));
+        store.add(opCtx, *progress);
+    }
+
+    std::vector<IdRange> ranges;
+    Value min;
+    for (const auto& boundary : progress->getIdBoundaries()) {
+        Value max{boundary["_id"]};
+        ranges.push_back({std::move(min), max});
+        min = std::move(max);
+    }
+    ranges.push_back({std::move(min), Value()});
+
+    LOGV2(5963004,
+          "Cloning the collection being resharded as several _id ranges concurrently",
+          "sourceNamespace"_attr = _sourceNss,
+          "outputNamespace"_attr = _outputNss,
+          "numRanges"_attr = ranges.size());
+
+    return ranges;
+}
+
+std::vector<BSONObj> ReshardingCollectionCloner::_sampleIdBoundaries(OperationContext* opCtx,
+                                                                     int numRanges) {
+    StringMap<ExpressionContext::ResolvedNamespace> resolvedNamespaces;
+    resolvedNamespaces[_sourceNss.coll()] = {_sourceNss, std::vector<BSONObj>{}};
+
+    auto expCtx = make_intrusive<ExpressionContext>(opCtx,
+                                                    boost::none, /* explain */
+                                                    false,       /* fromMongos */
+                                                    false,       /* needsMerge */
+                                                    false,       /* allowDiskUse */
+                                                    false,       /* bypassDocumentValidation */
+                                                    false,       /* isMapReduceCommand */
+                                                    _sourceNss,
+                                                    boost::none, /* runtimeConstants */
+                                                    nullptr,     /* collator */
+                                                    MongoProcessInterface::create(opCtx),
+                                                    std::move(resolvedNamespaces),
+                                                    _sourceUUID);
+
+    auto samplePipeline =
+        Pipeline::parse({BSON("$sample" << BSON("size" << numRanges * kSamplesPerIdRange)),
+                         BSON("$project" << BSON("_id" << 1))},
+                        expCtx);
+    auto request = makeAggregateRequest(_sourceNss, _sourceUUID, *samplePipeline, _atClusterTime);
+
+    // The BlockingResultsMerger underlying by the $mergeCursors stage requires the CurOp to be
+    // marked as having started.
+    auto* curOp = CurOp::get(opCtx);
+    curOp->ensureStarted();
+    ON_BLOCK_EXIT([curOp] { curOp->done(); });
+
+    auto sampledIds = shardVersionRetry(
+        opCtx,
+        Grid::get(opCtx)->catalogCache(),
+        _sourceNss,
+        "sampling donor shards to split resharding collection cloning"_sd,
+        [&] {
+            auto pipeline = sharded_agg_helpers::targetShardsAndAddMergeCursors(expCtx, request);
+
+            std::vector<Value> ids;
+            while (auto doc = pipeline->getNext()) {
+                ids.emplace_back((*doc)["_id"]);
+            }
+            return ids;
+        });
+
+    std::sort(sampledIds.begin(), sampledIds.end(), ValueComparator::kInstance.getLessThan());
+
+    // Split the sampled _id values into 'numRanges' ranges of about the same number of values.
+    std::vector<BSONObj> boundaries;
+    if (sampledIds.empty()) {
+        return boundaries;
+    }
+
+    boost::optional<Value> lastBoundary;
+    for (int i = 1; i < numRanges; ++i) {
+        const auto& id = sampledIds[i * sampledIds.size() / numRanges];
+        if (lastBoundary && ValueComparator::kInstance.evaluate(*lastBoundary == id)) {
+            continue;
+        }
+
+        BSONObjBuilder builder;
+        id.addToBsonObj(&builder, "_id");
+        boundaries.push_back(builder.obj());
+        lastBoundary = id;
+    }
+
+    return boundaries;
+}
+
 bool ReshardingCollectionCloner::doOneBatch(OperationContext* opCtx, Pipeline& pipeline) {
     pipeline.reattachToOperationContext(opCtx);
     ON_BLOCK_EXIT([&pipeline] { pipeline.detachFromOperationContext(); });
@@ -316,6 +464,57 @@ bool ReshardingCollectionCloner::doOneBatch(OperationContext* opCtx, Pipeline& p
 }
 
 SemiFuture<void> ReshardingCollectionCloner::run(
+    std::shared_ptr<executor::TaskExecutor> executor,
+    std::shared_ptr<executor::TaskExecutor> cleanupExecutor,
+    CancellationToken cancelToken,
+    CancelableOperationContextFactory factory) {
+    auto ranges = std::make_shared<std::vector<IdRange>>();
+
+    return resharding::WithAutomaticRetry([this, ranges, factory] {
+               auto opCtx = factory.makeOperationContext(&cc());
+               *ranges = _getIdRanges(opCtx.get());
+           })
+        .onTransientError([this](const Status& status) {
+            LOGV2(5963005,
+                  "Transient error while splitting the cloning of sharded collection",
+                  "sourceNamespace"_attr = _sourceNss,
+                  "outputNamespace"_attr = _outputNss,
+                  "readTimestamp"_attr = _atClusterTime,
+                  "error"_attr = redact(status));
+        })
+        .onUnrecoverableError([this](const Status& status) {
+            LOGV2_ERROR(5963006,
+                        "Operation-fatal error for resharding while splitting the cloning of "
+                        "sharded collection",
+                        "sourceNamespace"_attr = _sourceNss,
+                        "outputNamespace"_attr = _outputNss,
+                        "readTimestamp"_attr = _atClusterTime,
+                        "error"_attr = redact(status));
+        })
+        .until([](const Status& status) { return status.isOK(); })
+        .on(executor, cancelToken)
+        .then([this, ranges, executor, cleanupExecutor, cancelToken, factory] {
+            // Stop cloning the other ranges as soon as one of them fails.
+            CancellationSource cancelSource(cancelToken);
+
+            std::vector<SharedSemiFuture<void>> futures;
+            futures.reserve(ranges->size());
+            for (auto& range : *ranges) {
+                futures.emplace_back(_runRange(std::move(range),
+                                               executor,
+                                               cleanupExecutor,
+                                               cancelSource.token(),
+                                               factory)
+                                         .share());
+            }
+
+            return resharding::cancelWhenAnyErrorThenQuiesce(futures, executor, cancelSource);
+        })
+        .semi();
+}
+
+ExecutorFuture<void> ReshardingCollectionCloner::_runRange(
+    IdRange range,
     std::shared_ptr<executor::TaskExecutor> executor,
     std::shared_ptr<executor::TaskExecutor> cleanupExecutor,
     CancellationToken cancelToken,
@@ -327,10 +526,10 @@ SemiFuture<void> ReshardingCollectionCloner::run(
 
     auto chainCtx = std::make_shared<ChainContext>();
 
-    return resharding::WithAutomaticRetry([this, chainCtx, factory] {
+    return resharding::WithAutomaticRetry([this, chainCtx, factory, range = std::move(range)] {
                if (!chainCtx->pipeline) {
                    auto opCtx = factory.makeOperationContext(&cc());
-                   chainCtx->pipeline = _restartPipeline(opCtx.get());
+                   chainCtx->pipeline = _restartPipeline(opCtx.get(), range);
                }
 
                auto opCtx = factory.makeOperationContext(&cc());
@@ -381,8 +580,7 @@ SemiFuture<void> ReshardingCollectionCloner::run(
 
             // Propagate the result of the AsyncTry.
             return status;
-        })
-        .semi();
+        });
 }
 
 }  // namespace mongo
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/cancelable_operation_context.h"
@@ -81,13 +82,28 @@ public:
                                Timestamp atClusterTime,
                                NamespaceString outputNss);
 
+    /**
+     * A range [min, max) of _id values which is fetched and inserted independently of the others.
+     * A missing bound leaves that end of the range unbounded.
+     */
+    struct IdRange {
+        Value min;
+        Value max;
+    };
+
+    /**
+     * Returns the pipeline which fetches the documents of 'range' this shard owns under the new
+     * shard key, starting from the one with _id 'resumeId' if it isn't missing.
+     */
     std::unique_ptr<Pipeline, PipelineDeleter> makePipeline(
         OperationContext* opCtx,
         std::shared_ptr<MongoProcessInterface> mongoProcessInterface,
-        Value resumeId = Value());
+        Value resumeId = Value(),
+        const IdRange& range = IdRange());
 
     /**
-     * Schedules work to repeatedly fetch and insert batches of documents.
+     * Schedules work to repeatedly fetch and insert batches of documents. The collection is split
+     * into the _id ranges of _getIdRanges(), which are cloned concurrently.
      *
      * Returns a future that becomes ready when either:
      *   (a) all documents have been fetched and inserted, or
@@ -110,7 +126,23 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _targetAggregationRequest(OperationContext* opCtx,
                                                                          const Pipeline& pipeline);
 
-    std::unique_ptr<Pipeline, PipelineDeleter> _restartPipeline(OperationContext* opCtx);
+    std::unique_ptr<Pipeline, PipelineDeleter> _restartPipeline(OperationContext* opCtx,
+                                                                const IdRange& range);
+
+    /**
+     * Returns the _id ranges to clone concurrently. The boundaries of the ranges are chosen from a
+     * sample of the source collection the first time cloning starts, and persisted so that each
+     * range can resume from the highest _id inserted within it.
+     */
+    std::vector<IdRange> _getIdRanges(OperationContext* opCtx);
+
+    std::vector<BSONObj> _sampleIdBoundaries(OperationContext* opCtx, int numRanges);
+
+    ExecutorFuture<void> _runRange(IdRange range,
+                                   std::shared_ptr<executor::TaskExecutor> executor,
+                                   std::shared_ptr<executor::TaskExecutor> cleanupExecutor,
+                                   CancellationToken cancelToken,
+                                   CancelableOperationContextFactory factory);
 
     const std::unique_ptr<Env> _env;
     const ShardKeyPattern _newShardKeyPattern;
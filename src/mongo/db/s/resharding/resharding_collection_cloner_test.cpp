@@ -79,7 +79,8 @@ protected:
         ShardKeyPattern newShardKeyPattern,
         ShardId recipientShard,
         std::deque<DocumentSource::GetNextResult> sourceCollectionData,
-        std::deque<DocumentSource::GetNextResult> configCacheChunksData) {
+        std::deque<DocumentSource::GetNextResult> configCacheChunksData,
+        ReshardingCollectionCloner::IdRange idRange = {}) {
         auto tempNss = constructTemporaryReshardingNss(_sourceNss.db(), _sourceUUID);
 
         ReshardingCollectionCloner cloner(
@@ -92,7 +93,10 @@ protected:
             std::move(tempNss));
 
         auto pipeline = cloner.makePipeline(
-            _opCtx.get(), std::make_shared<MockMongoInterface>(std::move(configCacheChunksData)));
+            _opCtx.get(),
+            std::make_shared<MockMongoInterface>(std::move(configCacheChunksData)),
+            Value(),
+            idRange);
 
         pipeline->addInitialSource(DocumentSourceMock::createForTest(
             std::move(sourceCollectionData), pipeline->getContext()));
@@ -271,5 +275,29 @@ TEST_F(ReshardingCollectionClonerTest, CompoundHashedShardKey) {
     ASSERT_FALSE(pipeline->getNext());
 }
 
+TEST_F(ReshardingCollectionClonerTest, IdRange) {
+    auto pipeline = makePipeline(
+        ShardKeyPattern(fromjson("{x: 1}")),
+        ShardId("shard1"),
+        {Doc(fromjson("{_id: 1, x: 1}")),
+         Doc(fromjson("{_id: 2, x: 2}")),
+         Doc(fromjson("{_id: 3, x: 3}")),
+         Doc(fromjson("{_id: 4, x: 4}"))},
+        {Doc(fromjson("{_id: {x: {$minKey: 1}}, max: {x: {$maxKey: 1}}, shard: 'shard1'}"))},
+        {V(2), V(4)});
+
+    auto next = pipeline->getNext();
+    ASSERT(next);
+    ASSERT_BSONOBJ_BINARY_EQ(BSON("_id" << 2 << "x" << 2 << "$sortKey" << BSON_ARRAY(2)),
+                             next->toBson());
+
+    next = pipeline->getNext();
+    ASSERT(next);
+    ASSERT_BSONOBJ_BINARY_EQ(BSON("_id" << 3 << "x" << 3 << "$sortKey" << BSON_ARRAY(3)),
+                             next->toBson());
+
+    ASSERT_FALSE(pipeline->getNext());
+}
+
 }  // namespace
 }  // namespace mongo
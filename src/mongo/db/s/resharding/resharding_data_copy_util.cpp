@@ -31,6 +31,7 @@
 
 #include "mongo/db/s/resharding/resharding_data_copy_util.h"
 
+#include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
@@ -39,6 +40,8 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/persistent_task_store.h"
 #include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/internal_plans.h"
+#include "mongo/db/s/resharding/resharding_collection_cloner_progress_gen.h"
 #include "mongo/db/s/resharding/resharding_oplog_applier_progress_gen.h"
 #include "mongo/db/s/resharding/resharding_txn_cloner_progress_gen.h"
 #include "mongo/db/s/resharding_util.h"
@@ -95,6 +98,14 @@ void ensureOplogCollectionsDropped(OperationContext* opCtx,
                                    const UUID& reshardingUUID,
                                    const UUID& sourceUUID,
                                    const std::vector<DonorShardFetchTimestamp>& donorShards) {
+    // Remove the _id ranges of the collection cloner.
+    PersistentTaskStore<ReshardingCollectionClonerProgress> collectionClonerProgressStore(
+        NamespaceString::kReshardingCollectionClonerProgressNamespace);
+    collectionClonerProgressStore.remove(
+        opCtx,
+        QUERY(ReshardingCollectionClonerProgress::kSourceUUIDFieldName << sourceUUID),
+        WriteConcernOptions());
+
     for (const auto& donor : donorShards) {
         auto reshardingSourceId = ReshardingSourceId{reshardingUUID, donor.getShardId()};
 
@@ -145,6 +156,48 @@ Value findHighestInsertedId(OperationContext* opCtx, const CollectionPtr& collec
     return value;
 }
 
+Value findHighestInsertedIdInRange(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   const Value& min,
+                                   const Value& max) {
+    auto idIndex = collection->getIndexCatalog()->findIdIndex(opCtx);
+    uassert(ErrorCodes::IndexNotFound,
+            str::stream() << "Missing _id index for temporary resharding collection "
+                          << collection->ns(),
+            idIndex);
+
+    auto toKey = [](const Value& bound) {
+        BSONObjBuilder builder;
+        bound.addToBsonObj(&builder, "");
+        return builder.obj();
+    };
+
+    // Scan the _id index backwards from the upper bound, which is excluded unless it is MaxKey.
+    auto exec = InternalPlanner::indexScan(
+        opCtx,
+        &collection,
+        idIndex,
+        max.missing() ? BSON("" << MAXKEY) : toKey(max),
+        min.missing() ? BSON("" << MINKEY) : toKey(min),
+        max.missing() ? BoundInclusion::kIncludeBothStartAndEndKeys
+                      : BoundInclusion::kIncludeEndKeyOnly,
+        PlanYieldPolicy::YieldPolicy::NO_YIELD,
+        InternalPlanner::BACKWARD,
+        InternalPlanner::IXSCAN_FETCH);
+
+    BSONObj doc;
+    if (exec->getNext(&doc, nullptr) == PlanExecutor::IS_EOF) {
+        return Value{};
+    }
+
+    auto value = Value{doc["_id"]};
+    uassert(5963003,
+            "Missing _id field for document in temporary resharding collection",
+            !value.missing());
+
+    return value;
+}
+
 std::vector<InsertStatement> fillBatchForInsert(Pipeline& pipeline, int batchSizeLimitBytes) {
     // The BlockingResultsMerger underlying by the $mergeCursors stage records how long the
     // recipient spent waiting for documents from the donor shards. It doing so requires the CurOp
@@ -83,6 +83,15 @@ void ensureOplogCollectionsDropped(OperationContext* opCtx,
  */
 Value findHighestInsertedId(OperationContext* opCtx, const CollectionPtr& collection);
 
+/**
+ * Returns the largest _id value in the collection which is within [min, max), where a missing
+ * bound leaves that end of the range unbounded.
+ */
+Value findHighestInsertedIdInRange(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   const Value& min,
+                                   const Value& max);
+
 /**
  * Returns a batch of documents suitable for being inserted with insertBatch().
  *
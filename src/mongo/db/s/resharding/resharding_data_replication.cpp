@@ -33,6 +33,8 @@
 
 #include "mongo/db/s/resharding/resharding_data_replication.h"
 
+#include "mongo/db/auth/authorization_session.h"
+#include "mongo/db/client.h"
 #include "mongo/db/repl/oplog_applier.h"
 #include "mongo/db/s/resharding/resharding_collection_cloner.h"
 #include "mongo/db/s/resharding/resharding_data_copy_util.h"
@@ -43,10 +45,12 @@
 #include "mongo/db/s/resharding/resharding_server_parameters_gen.h"
 #include "mongo/db/s/resharding/resharding_txn_cloner.h"
 #include "mongo/db/s/resharding_util.h"
+#include "mongo/db/vector_clock_metadata_hook.h"
 #include "mongo/executor/network_interface_factory.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/redaction.h"
+#include "mongo/rpc/metadata/egress_metadata_hook_list.h"
 #include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/future_util.h"
 
@@ -77,6 +81,19 @@ void ensureFulfilledPromise(SharedPromise<void>& sp, Status error) {
     }
 }
 
+/**
+ * Sets up the threads of the executors owned by ReshardingDataReplication identically to the
+ * threads of the recipient's primary-only service.
+ */
+void initRecipientWorkerThread(const std::string& threadName) {
+    Client::initThread(threadName.c_str());
+    auto* client = Client::getCurrent();
+    AuthorizationSession::get(*client)->grantInternalAuthorization(client);
+
+    stdx::lock_guard<Client> lk(*client);
+    client->setSystemOperationKillableByStepdown(lk);
+}
+
 }  // namespace
 
 std::unique_ptr<ReshardingCollectionCloner> ReshardingDataReplication::_makeCollectionCloner(
@@ -160,6 +177,51 @@ std::shared_ptr<executor::TaskExecutor> ReshardingDataReplication::_makeOplogFet
     return executor;
 }
 
+std::shared_ptr<executor::TaskExecutor> ReshardingDataReplication::_makeCollectionClonerExecutor(
+    OperationContext* opCtx) {
+    ThreadPool::Limits threadPoolLimits;
+    threadPoolLimits.maxThreads = resharding::gReshardingCollectionClonerReaderCount;
+    ThreadPool::Options threadPoolOptions(std::move(threadPoolLimits));
+
+    auto prefix = "ReshardingCollectionCloner"_sd;
+    threadPoolOptions.threadNamePrefix = prefix + "-";
+    threadPoolOptions.poolName = prefix + "ThreadPool";
+    // The ReshardingCollectionCloner expects there to already be a Client associated with the
+    // thread from the thread pool.
+    threadPoolOptions.onCreateThread = initRecipientWorkerThread;
+
+    auto hookList = std::make_unique<rpc::EgressMetadataHookList>();
+    hookList->addHook(std::make_unique<rpc::VectorClockMetadataHook>(opCtx->getServiceContext()));
+
+    auto executor = std::make_shared<executor::ThreadPoolTaskExecutor>(
+        std::make_unique<ThreadPool>(std::move(threadPoolOptions)),
+        executor::makeNetworkInterface(prefix + "Network", nullptr, std::move(hookList)));
+
+    executor->startup();
+    return executor;
+}
+
+std::shared_ptr<executor::TaskExecutor>
+ReshardingDataReplication::_makeOplogApplierWriterExecutor() {
+    ThreadPool::Limits threadPoolLimits;
+    threadPoolLimits.maxThreads = resharding::gReshardingOplogApplierWriterThreadCount;
+    ThreadPool::Options threadPoolOptions(std::move(threadPoolLimits));
+
+    auto prefix = "ReshardingOplogApplierWriter"_sd;
+    threadPoolOptions.threadNamePrefix = prefix + "-";
+    threadPoolOptions.poolName = prefix + "ThreadPool";
+    // The ReshardingOplogBatchApplier expects there to already be a Client associated with the
+    // thread from the thread pool.
+    threadPoolOptions.onCreateThread = initRecipientWorkerThread;
+
+    auto executor = std::make_shared<executor::ThreadPoolTaskExecutor>(
+        std::make_unique<ThreadPool>(std::move(threadPoolOptions)),
+        executor::makeNetworkInterface(prefix + "Network"));
+
+    executor->startup();
+    return executor;
+}
+
 std::vector<std::unique_ptr<ReshardingOplogApplier>> ReshardingDataReplication::_makeOplogAppliers(
     OperationContext* opCtx,
     ReshardingMetrics* metrics,
@@ -209,10 +271,12 @@ std::unique_ptr<ReshardingDataReplicationInterface> ReshardingDataReplication::m
     ShardId myShardId,
     ChunkManager sourceChunkMgr) {
     std::unique_ptr<ReshardingCollectionCloner> collectionCloner;
+    std::shared_ptr<executor::TaskExecutor> collectionClonerExecutor;
     std::vector<std::unique_ptr<ReshardingTxnCloner>> txnCloners;
 
     if (!cloningDone) {
         collectionCloner = _makeCollectionCloner(metrics, metadata, myShardId, cloneTimestamp);
+        collectionClonerExecutor = _makeCollectionClonerExecutor(opCtx);
         txnCloners = _makeTxnCloners(metadata, donorShards);
     }
 
@@ -229,12 +293,15 @@ std::unique_ptr<ReshardingDataReplicationInterface> ReshardingDataReplication::m
                                             std::move(sourceChunkMgr),
                                             stashCollections,
                                             oplogFetchers);
+    auto oplogApplierWriterExecutor = _makeOplogApplierWriterExecutor();
 
     return std::make_unique<ReshardingDataReplication>(std::move(collectionCloner),
                                                        std::move(txnCloners),
                                                        std::move(oplogAppliers),
                                                        std::move(oplogFetchers),
                                                        std::move(oplogFetcherExecutor),
+                                                       std::move(collectionClonerExecutor),
+                                                       std::move(oplogApplierWriterExecutor),
                                                        TrustedInitTag{});
 }
 
@@ -244,12 +311,16 @@ ReshardingDataReplication::ReshardingDataReplication(
     std::vector<std::unique_ptr<ReshardingOplogApplier>> oplogAppliers,
     std::vector<std::unique_ptr<ReshardingOplogFetcher>> oplogFetchers,
     std::shared_ptr<executor::TaskExecutor> oplogFetcherExecutor,
+    std::shared_ptr<executor::TaskExecutor> collectionClonerExecutor,
+    std::shared_ptr<executor::TaskExecutor> oplogApplierWriterExecutor,
     TrustedInitTag)
     : _collectionCloner{std::move(collectionCloner)},
       _txnCloners{std::move(txnCloners)},
       _oplogAppliers{std::move(oplogAppliers)},
       _oplogFetchers{std::move(oplogFetchers)},
-      _oplogFetcherExecutor{std::move(oplogFetcherExecutor)} {}
+      _oplogFetcherExecutor{std::move(oplogFetcherExecutor)},
+      _collectionClonerExecutor{std::move(collectionClonerExecutor)},
+      _oplogApplierWriterExecutor{std::move(oplogApplierWriterExecutor)} {}
 
 void ReshardingDataReplication::startOplogApplication() {
     ensureFulfilledPromise(_startOplogApplication);
@@ -274,7 +345,7 @@ SemiFuture<void> ReshardingDataReplication::runUntilStrictlyConsistent(
     auto oplogFetcherFutures = _runOplogFetchers(executor, errorSource.token(), opCtxFactory);
 
     auto collectionClonerFuture =
-        _runCollectionCloner(executor, cleanupExecutor, errorSource.token(), opCtxFactory);
+        _runCollectionCloner(cleanupExecutor, errorSource.token(), opCtxFactory);
 
     auto txnClonerFutures = _runTxnCloners(
         executor, cleanupExecutor, errorSource.token(), opCtxFactory, minimumOperationDuration);
@@ -323,12 +394,11 @@ SemiFuture<void> ReshardingDataReplication::runUntilStrictlyConsistent(
 }
 
 SharedSemiFuture<void> ReshardingDataReplication::_runCollectionCloner(
-    std::shared_ptr<executor::TaskExecutor> executor,
     std::shared_ptr<executor::TaskExecutor> cleanupExecutor,
     CancellationToken cancelToken,
     CancelableOperationContextFactory opCtxFactory) {
     return _collectionCloner ? _collectionCloner
-                                   ->run(std::move(executor),
+                                   ->run(_collectionClonerExecutor,
                                          std::move(cleanupExecutor),
                                          std::move(cancelToken),
                                          std::move(opCtxFactory))
@@ -391,8 +461,12 @@ std::vector<SharedSemiFuture<void>> ReshardingDataReplication::_runOplogAppliers
         oplogApplierFutures.emplace_back(
             future_util::withCancellation(_startOplogApplication.getFuture(), cancelToken)
                 .thenRunOn(executor)
-                .then([applier = applier.get(), executor, cancelToken, opCtxFactory] {
-                    return applier->run(executor, cancelToken, opCtxFactory);
+                .then([applier = applier.get(),
+                       executor,
+                       writerExecutor = _oplogApplierWriterExecutor,
+                       cancelToken,
+                       opCtxFactory] {
+                    return applier->run(executor, writerExecutor, cancelToken, opCtxFactory);
                 })
                 .share());
     }
@@ -402,6 +476,11 @@ std::vector<SharedSemiFuture<void>> ReshardingDataReplication::_runOplogAppliers
 
 void ReshardingDataReplication::shutdown() {
     _oplogFetcherExecutor->shutdown();
+    _oplogApplierWriterExecutor->shutdown();
+
+    if (_collectionClonerExecutor) {
+        _collectionClonerExecutor->shutdown();
+    }
 }
 
 std::vector<NamespaceString> ReshardingDataReplication::ensureStashCollectionsExist(
@@ -152,6 +152,8 @@ public:
                               std::vector<std::unique_ptr<ReshardingOplogApplier>> oplogAppliers,
                               std::vector<std::unique_ptr<ReshardingOplogFetcher>> oplogFetchers,
                               std::shared_ptr<executor::TaskExecutor> oplogFetcherExecutor,
+                              std::shared_ptr<executor::TaskExecutor> collectionClonerExecutor,
+                              std::shared_ptr<executor::TaskExecutor> oplogApplierWriterExecutor,
                               TrustedInitTag);
 
     SemiFuture<void> runUntilStrictlyConsistent(
@@ -205,6 +207,11 @@ private:
 
     static std::shared_ptr<executor::TaskExecutor> _makeOplogFetcherExecutor(size_t numDonors);
 
+    static std::shared_ptr<executor::TaskExecutor> _makeCollectionClonerExecutor(
+        OperationContext* opCtx);
+
+    static std::shared_ptr<executor::TaskExecutor> _makeOplogApplierWriterExecutor();
+
     static std::vector<std::unique_ptr<ReshardingOplogApplier>> _makeOplogAppliers(
         OperationContext* opCtx,
         ReshardingMetrics* metrics,
@@ -216,7 +223,6 @@ private:
         const std::vector<std::unique_ptr<ReshardingOplogFetcher>>& oplogFetchers);
 
     SharedSemiFuture<void> _runCollectionCloner(
-        std::shared_ptr<executor::TaskExecutor> executor,
         std::shared_ptr<executor::TaskExecutor> cleanupExecutor,
         CancellationToken cancelToken,
         CancelableOperationContextFactory opCtxFactory);
@@ -251,6 +257,13 @@ private:
     const std::vector<std::unique_ptr<ReshardingOplogFetcher>> _oplogFetchers;
     const std::shared_ptr<executor::TaskExecutor> _oplogFetcherExecutor;
 
+    // Runs the _id ranges of the collection cloner concurrently with each other. It is left as
+    // nullptr along with _collectionCloner.
+    const std::shared_ptr<executor::TaskExecutor> _collectionClonerExecutor;
+
+    // Applies the writer vectors of the oplog appliers for all of the donor shards.
+    const std::shared_ptr<executor::TaskExecutor> _oplogApplierWriterExecutor;
+
     // Promise fulfilled by startOplogApplication() to signal that oplog application can begin.
     SharedPromise<void> _startOplogApplication;
 
@@ -121,10 +121,89 @@ Status ReshardingOplogApplicationRules::applyOperation(OperationContext* opCtx,
                                                        const repl::OplogEntry& op) const {
     LOGV2_DEBUG(49901, 3, "Applying op for resharding", "op"_attr = redact(op.toBSONForLogging()));
 
+    return _runInWriteUnitOfWork(
+        opCtx,
+        "applyOplogEntryCRUDOpResharding",
+        op.getNss().ns(),
+        [&](Database* db, const CollectionPtr& outputColl, const CollectionPtr& stashColl) {
+            auto opType = op.getOpType();
+            switch (opType) {
+                case repl::OpTypeEnum::kInsert:
+                    _applyInsert_inlock(opCtx, db, outputColl, stashColl, op);
+                    break;
+                case repl::OpTypeEnum::kUpdate:
+                    _applyUpdate_inlock(opCtx, db, outputColl, stashColl, op);
+                    break;
+                case repl::OpTypeEnum::kDelete:
+                    _applyDelete_inlock(opCtx, db, outputColl, stashColl, op);
+                    break;
+                default:
+                    MONGO_UNREACHABLE;
+            }
+        });
+}
+
+Status ReshardingOplogApplicationRules::applyInsertGroup(
+    OperationContext* opCtx, const std::vector<const repl::OplogEntry*>& ops) const {
+    invariant(!ops.empty());
+    LOGV2_DEBUG(5963007,
+                3,
+                "Applying group of inserts for resharding",
+                "numOps"_attr = ops.size(),
+                "firstOp"_attr = redact(ops.front()->toBSONForLogging()));
+
+    return _runInWriteUnitOfWork(
+        opCtx,
+        "applyOplogEntryInsertGroupResharding",
+        ops.front()->getNss().ns(),
+        [&](Database* db, const CollectionPtr& outputColl, const CollectionPtr& stashColl) {
+            // Inserts which fall under rule #2 of _applyInsert_inlock() are collected and inserted
+            // into the output collection together at the end. Because the _ids in the group are
+            // distinct, applying the remaining inserts first cannot change which rule applies to
+            // any of them.
+            std::vector<InsertStatement> outputCollInserts;
+            outputCollInserts.reserve(ops.size());
+
+            for (const auto* op : ops) {
+                invariant(op->getOpType() == repl::OpTypeEnum::kInsert);
+
+                BSONObj oField = op->getObject();
+                auto idField = oField["_id"];
+                uassert(ErrorCodes::NoSuchKey,
+                        str::stream() << "Failed to apply insert due to missing _id: "
+                                      << redact(op->toBSONForLogging()),
+                        !idField.eoo());
+
+                BSONObj idQuery = idField.wrap();
+                if (!_queryStashCollById(opCtx, db, stashColl, idQuery).isEmpty() ||
+                    !Helpers::findById(opCtx, outputColl, idQuery).isNull()) {
+                    _applyInsert_inlock(opCtx, db, outputColl, stashColl, *op);
+                    continue;
+                }
+
+                // Writes are replicated, so use global op counters.
+                globalOpCounters.gotInsert();
+                outputCollInserts.emplace_back(oField);
+            }
+
+            uassertStatusOK(outputColl->insertDocuments(opCtx,
+                                                        outputCollInserts.begin(),
+                                                        outputCollInserts.end(),
+                                                        nullptr /* nullOpDebug */,
+                                                        false /* fromMigrate */));
+        });
+}
+
+Status ReshardingOplogApplicationRules::_runInWriteUnitOfWork(
+    OperationContext* opCtx,
+    StringData opStr,
+    StringData ns,
+    const std::function<void(Database*, const CollectionPtr&, const CollectionPtr&)>& applyFn)
+    const {
     invariant(!opCtx->lockState()->inAWriteUnitOfWork());
     invariant(opCtx->writesAreReplicated());
 
-    return writeConflictRetry(opCtx, "applyOplogEntryCRUDOpResharding", op.getNss().ns(), [&] {
+    return writeConflictRetry(opCtx, opStr, ns, [&] {
         try {
             WriteUnitOfWork wuow(opCtx);
 
@@ -150,23 +229,7 @@ Status ReshardingOplogApplicationRules::applyOperation(OperationContext* opCtx,
                               << _myStashNss.ns(),
                 autoCollStash);
 
-            auto opType = op.getOpType();
-            switch (opType) {
-                case repl::OpTypeEnum::kInsert:
-                    _applyInsert_inlock(
-                        opCtx, autoCollOutput.getDb(), *autoCollOutput, *autoCollStash, op);
-                    break;
-                case repl::OpTypeEnum::kUpdate:
-                    _applyUpdate_inlock(
-                        opCtx, autoCollOutput.getDb(), *autoCollOutput, *autoCollStash, op);
-                    break;
-                case repl::OpTypeEnum::kDelete:
-                    _applyDelete_inlock(
-                        opCtx, autoCollOutput.getDb(), *autoCollOutput, *autoCollStash, op);
-                    break;
-                default:
-                    MONGO_UNREACHABLE;
-            }
+            applyFn(autoCollOutput.getDb(), *autoCollOutput, *autoCollStash);
 
             if (opCtx->recoveryUnit()->isTimestamped()) {
                 // Resharding oplog application does two kinds of writes:
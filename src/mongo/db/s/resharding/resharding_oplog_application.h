@@ -66,7 +66,24 @@ public:
      */
     Status applyOperation(OperationContext* opCtx, const repl::OplogEntry& op) const;
 
+    /**
+     * Applies a group of insert operations for distinct _ids in a single WUOW. The inserts which
+     * go to the output collection without conflicting with an existing document are inserted
+     * together, similar to how InsertGroup batches inserts during secondary oplog application.
+     */
+    Status applyInsertGroup(OperationContext* opCtx,
+                            const std::vector<const repl::OplogEntry*>& ops) const;
+
 private:
+    // Runs 'applyFn' against the output and stash collections inside a writeConflictRetry loop,
+    // committing the WUOW only if it made a timestamped write.
+    Status _runInWriteUnitOfWork(
+        OperationContext* opCtx,
+        StringData opStr,
+        StringData ns,
+        const std::function<void(Database*, const CollectionPtr&, const CollectionPtr&)>& applyFn)
+        const;
+
     // Applies an insert operation
     void _applyInsert_inlock(OperationContext* opCtx,
                              Database* db,
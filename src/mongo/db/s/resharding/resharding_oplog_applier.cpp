@@ -67,6 +67,7 @@ ReshardingOplogApplier::ReshardingOplogApplier(
 
 SemiFuture<void> ReshardingOplogApplier::_applyBatch(
     std::shared_ptr<executor::TaskExecutor> executor,
+    std::shared_ptr<executor::TaskExecutor> writerExecutor,
     CancellationToken cancelToken,
     CancelableOperationContextFactory factory,
     bool isForSessionApplication) {
@@ -86,7 +87,8 @@ SemiFuture<void> ReshardingOplogApplier::_applyBatch(
     for (auto&& writer : currentWriterVectors) {
         if (!writer.empty()) {
             batchApplierFutures.emplace_back(
-                _batchApplier.applyBatch(std::move(writer), executor, errorSource.token(), factory)
+                _batchApplier
+                    .applyBatch(std::move(writer), writerExecutor, errorSource.token(), factory)
                     .share());
         }
     }
@@ -103,19 +105,33 @@ SemiFuture<void> ReshardingOplogApplier::_applyBatch(
 SemiFuture<void> ReshardingOplogApplier::run(std::shared_ptr<executor::TaskExecutor> executor,
                                              CancellationToken cancelToken,
                                              CancelableOperationContextFactory factory) {
-    return AsyncTry([this, executor, cancelToken, factory] {
+    return run(executor, executor, std::move(cancelToken), std::move(factory));
+}
+
+SemiFuture<void> ReshardingOplogApplier::run(
+    std::shared_ptr<executor::TaskExecutor> executor,
+    std::shared_ptr<executor::TaskExecutor> writerExecutor,
+    CancellationToken cancelToken,
+    CancelableOperationContextFactory factory) {
+    return AsyncTry([this, executor, writerExecutor, cancelToken, factory] {
                return _oplogIter->getNextBatch(executor, cancelToken, factory)
                    .thenRunOn(executor)
-                   .then([this, executor, cancelToken, factory](OplogBatch batch) {
+                   .then([this, executor, writerExecutor, cancelToken, factory](OplogBatch batch) {
                        LOGV2_DEBUG(5391002, 3, "Starting batch", "batchSize"_attr = batch.size());
                        _currentBatchToApply = std::move(batch);
 
-                       return _applyBatch(
-                           executor, cancelToken, factory, false /* isForSessionApplication */);
+                       return _applyBatch(executor,
+                                          writerExecutor,
+                                          cancelToken,
+                                          factory,
+                                          false /* isForSessionApplication */);
                    })
-                   .then([this, executor, cancelToken, factory] {
-                       return _applyBatch(
-                           executor, cancelToken, factory, true /* isForSessionApplication */);
+                   .then([this, executor, writerExecutor, cancelToken, factory] {
+                       return _applyBatch(executor,
+                                          writerExecutor,
+                                          cancelToken,
+                                          factory,
+                                          true /* isForSessionApplication */);
                    })
                    .then([this, factory] {
                        if (_currentBatchToApply.empty()) {
@@ -99,6 +99,16 @@ public:
                          CancellationToken cancelToken,
                          CancelableOperationContextFactory factory);
 
+    /**
+     * Same as above, except the writer vectors of each batch are applied on 'writerExecutor'. The
+     * appliers for all of the donor shards share the same 'writerExecutor' so the number of threads
+     * applying oplog entries is bounded regardless of how many donor shards there are.
+     */
+    SemiFuture<void> run(std::shared_ptr<executor::TaskExecutor> executor,
+                         std::shared_ptr<executor::TaskExecutor> writerExecutor,
+                         CancellationToken cancelToken,
+                         CancelableOperationContextFactory factory);
+
     static boost::optional<ReshardingOplogApplierProgress> checkStoredProgress(
         OperationContext* opCtx, const ReshardingSourceId& id);
 
@@ -115,6 +125,7 @@ private:
      * worker threads to finish (even when some of them finished early due to an error).
      */
     SemiFuture<void> _applyBatch(std::shared_ptr<executor::TaskExecutor> executor,
+                                 std::shared_ptr<executor::TaskExecutor> writerExecutor,
                                  CancellationToken cancelToken,
                                  CancelableOperationContextFactory factory,
                                  bool isForSessionApplication);
@@ -35,12 +35,26 @@
 
 #include <memory>
 
+#include "mongo/db/ops/write_ops.h"
 #include "mongo/db/s/resharding/resharding_future_util.h"
 #include "mongo/db/s/resharding/resharding_oplog_application.h"
 #include "mongo/db/s/resharding/resharding_oplog_session_application.h"
 #include "mongo/logv2/log.h"
 
 namespace mongo {
+namespace {
+
+// Must not create too large an object.
+const auto kInsertGroupMaxGroupSize = write_ops::insertVectorMaxBytes;
+
+// Limit number of ops in a single group.
+constexpr auto kInsertGroupMaxOpCount = 64;
+
+bool isGroupableInsert(const repl::OplogEntry& op) {
+    return !op.isForReshardingSessionApplication() && op.getOpType() == repl::OpTypeEnum::kInsert;
+}
+
+}  // namespace
 
 ReshardingOplogBatchApplier::ReshardingOplogBatchApplier(
     const ReshardingOplogApplicationRules& crudApplication,
@@ -55,6 +69,9 @@ SemiFuture<void> ReshardingOplogBatchApplier::applyBatch(
     struct ChainContext {
         OplogBatch batch;
         size_t nextToApply = 0;
+
+        // Index up to which inserts are applied one at a time, because grouping them failed.
+        size_t doNotGroupBeforePoint = 0;
     };
 
     auto chainCtx = std::make_shared<ChainContext>();
@@ -67,6 +84,17 @@ SemiFuture<void> ReshardingOplogBatchApplier::applyBatch(
                    const auto& oplogEntry = *chainCtx->batch[i];
                    auto opCtx = factory.makeOperationContext(&cc());
 
+                   if (i >= chainCtx->doNotGroupBeforePoint && isGroupableInsert(oplogEntry)) {
+                       if (auto groupEnd = _tryApplyInsertGroup(opCtx.get(), chainCtx->batch, i)) {
+                           i = *groupEnd - 1;
+                           continue;
+                       }
+
+                       // Applying the inserts one at a time surfaces the error which caused the
+                       // group to fail, if there is one.
+                       chainCtx->doNotGroupBeforePoint = _findInsertGroupEnd(chainCtx->batch, i);
+                   }
+
                    if (oplogEntry.isForReshardingSessionApplication()) {
                        auto hitPreparedTxn =
                            _sessionApplication.tryApplyOperation(opCtx.get(), oplogEntry);
@@ -104,4 +132,44 @@ SemiFuture<void> ReshardingOplogBatchApplier::applyBatch(
         .semi();
 }
 
+size_t ReshardingOplogBatchApplier::_findInsertGroupEnd(const OplogBatch& batch,
+                                                       size_t groupStart) {
+    size_t groupSize = 0;
+    size_t groupEnd = groupStart;
+    for (; groupEnd < batch.size() && groupEnd - groupStart < size_t(kInsertGroupMaxOpCount);
+         ++groupEnd) {
+        const auto& op = *batch[groupEnd];
+        if (!isGroupableInsert(op) || op.getNss() != batch[groupStart]->getNss()) {
+            break;
+        }
+
+        groupSize += op.getObject().objsize();
+        if (groupEnd > groupStart && groupSize > size_t(kInsertGroupMaxGroupSize)) {
+            break;
+        }
+    }
+    return groupEnd;
+}
+
+boost::optional<size_t> ReshardingOplogBatchApplier::_tryApplyInsertGroup(
+    OperationContext* opCtx, const OplogBatch& batch, size_t groupStart) const {
+    auto groupEnd = _findInsertGroupEnd(batch, groupStart);
+    if (groupEnd - groupStart < 2) {
+        return boost::none;
+    }
+
+    std::vector<const repl::OplogEntry*> group(batch.begin() + groupStart,
+                                               batch.begin() + groupEnd);
+    auto status = _crudApplication.applyInsertGroup(opCtx, group);
+    if (!status.isOK()) {
+        LOGV2_DEBUG(5963008,
+                    2,
+                    "Failed to apply group of inserts for resharding, applying them individually",
+                    "numOps"_attr = group.size(),
+                    "error"_attr = redact(status));
+        return boost::none;
+    }
+    return groupEnd;
+}
+
 }  // namespace mongo
@@ -29,6 +29,8 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/db/cancelable_operation_context.h"
 #include "mongo/db/s/resharding/resharding_oplog_batch_preparer.h"
 #include "mongo/executor/task_executor.h"
@@ -58,6 +60,16 @@ public:
                                 CancelableOperationContextFactory factory) const;
 
 private:
+    // Returns the end of the run of inserts starting at 'groupStart' which may be applied as a
+    // single group.
+    static size_t _findInsertGroupEnd(const OplogBatch& batch, size_t groupStart);
+
+    // Applies the run of inserts starting at 'groupStart' as a single group. Returns the end of the
+    // group, or boost::none if the inserts must be applied individually instead.
+    boost::optional<size_t> _tryApplyInsertGroup(OperationContext* opCtx,
+                                                 const OplogBatch& batch,
+                                                 size_t groupStart) const;
+
     const ReshardingOplogApplicationRules& _crudApplication;
     const ReshardingOplogSessionApplication& _sessionApplication;
 };
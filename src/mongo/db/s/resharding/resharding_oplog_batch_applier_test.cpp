@@ -38,6 +38,7 @@
 #include "mongo/bson/bsonmisc.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/logical_session_cache_noop.h"
 #include "mongo/db/logical_session_id.h"
 #include "mongo/db/op_observer_registry.h"
@@ -220,6 +221,29 @@ public:
         return {op.toBSON()};
     }
 
+    repl::OplogEntry makeInsertOp(BSONObj document) {
+        repl::MutableOplogEntry op;
+        op.setOpType(repl::OpTypeEnum::kInsert);
+        op.setNss(_sourceNss);
+        op.setObject(std::move(document));
+
+        // These are unused by ReshardingOplogApplicationRules but required by IDL parsing.
+        op.setOpTime({{}, {}});
+        op.setWallClockTime({});
+
+        return {op.toBSON()};
+    }
+
+    std::vector<BSONObj> findOutputCollectionDocuments(OperationContext* opCtx) {
+        DBDirectClient client(opCtx);
+        std::vector<BSONObj> result;
+        auto cursor = client.query(_outputNss, Query().sort(BSON("_id" << 1)));
+        while (cursor->more()) {
+            result.emplace_back(cursor->next().getOwned());
+        }
+        return result;
+    }
+
     std::vector<repl::DurableOplogEntry> findOplogEntriesNewerThan(OperationContext* opCtx,
                                                                    Timestamp ts) {
         std::vector<repl::DurableOplogEntry> result;
@@ -413,5 +437,33 @@ TEST_F(ReshardingOplogBatchApplierTest, CancelableWhileWaitingOnPreparedTxn) {
     ASSERT_EQ(future.getNoThrow(), ErrorCodes::CallbackCanceled);
 }
 
+TEST_F(ReshardingOplogBatchApplierTest, FallsBackToIndividualInsertsWhenGroupFails) {
+    // The inserts are grouped together, but the duplicate _id makes inserting the group fail. The
+    // inserts are then applied one at a time and the second insert for {_id: 0} becomes a
+    // replacement update because this donor shard owns the document under the original shard key.
+    std::vector<repl::OplogEntry> ops{makeInsertOp(BSON("_id" << 0 << "sk" << 1)),
+                                      makeInsertOp(BSON("_id" << 1 << "sk" << 1)),
+                                      makeInsertOp(BSON("_id" << 0 << "sk" << 2)),
+                                      makeInsertOp(BSON("_id" << 2 << "sk" << 1))};
+
+    ReshardingOplogBatchApplier::OplogBatch batch;
+    for (const auto& op : ops) {
+        batch.push_back(&op);
+    }
+
+    auto executor = makeTaskExecutorForApplier();
+    auto factory = makeCancelableOpCtxForApplier(CancellationToken::uncancelable());
+    auto future = applier()->applyBatch(
+        std::move(batch), executor, CancellationToken::uncancelable(), factory);
+    ASSERT_OK(future.getNoThrow());
+
+    auto opCtx = makeOperationContext();
+    auto docs = findOutputCollectionDocuments(opCtx.get());
+    ASSERT_EQ(docs.size(), 3U);
+    ASSERT_BSONOBJ_EQ(docs[0], BSON("_id" << 0 << "sk" << 2));
+    ASSERT_BSONOBJ_EQ(docs[1], BSON("_id" << 1 << "sk" << 1));
+    ASSERT_BSONOBJ_EQ(docs[2], BSON("_id" << 2 << "sk" << 1));
+}
+
 }  // namespace
 }  // namespace mongo
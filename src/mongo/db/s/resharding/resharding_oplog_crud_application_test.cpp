@@ -387,6 +387,46 @@ TEST_F(ReshardingOplogCrudApplicationTest, InsertOpWritesToStashCollectionAfterC
     }
 }
 
+TEST_F(ReshardingOplogCrudApplicationTest, InsertGroupAppliesInsertRulesToEachOp) {
+    // Make sure documents with {_id: 0} and {_id: 1} exist in the output collection before applying
+    // a group of inserts. This donor shard owns {_id: 1, sk: 1} but not {_id: 0, sk: -1} under the
+    // original shard key.
+    {
+        auto opCtx = makeOperationContext();
+        ASSERT_OK(
+            applier()->applyOperation(opCtx.get(), makeInsertOp(BSON("_id" << 0 << sk() << -1))));
+        ASSERT_OK(
+            applier()->applyOperation(opCtx.get(), makeInsertOp(BSON("_id" << 1 << sk() << 1))));
+    }
+
+    {
+        auto opCtx = makeOperationContext();
+        std::vector<repl::OplogEntry> ops{makeInsertOp(BSON("_id" << 2 << sk() << 1)),
+                                          makeInsertOp(BSON("_id" << 0 << sk() << 2)),
+                                          makeInsertOp(BSON("_id" << 1 << sk() << 2)),
+                                          makeInsertOp(BSON("_id" << 3 << sk() << 1))};
+        std::vector<const repl::OplogEntry*> group;
+        for (const auto& op : ops) {
+            group.push_back(&op);
+        }
+        ASSERT_OK(applier()->applyInsertGroup(opCtx.get(), group));
+    }
+
+    // The inserts for {_id: 2} and {_id: 3} should have applied rule #2, the insert for {_id: 0}
+    // should have applied rule #4, and the insert for {_id: 1} should have applied rule #3.
+    {
+        auto opCtx = makeOperationContext();
+        checkCollectionContents(opCtx.get(),
+                                outputNss(),
+                                {BSON("_id" << 0 << sk() << -1),
+                                 BSON("_id" << 1 << sk() << 2),
+                                 BSON("_id" << 2 << sk() << 1),
+                                 BSON("_id" << 3 << sk() << 1)});
+        checkCollectionContents(opCtx.get(), myStashNss(), {BSON("_id" << 0 << sk() << 2)});
+        checkCollectionContents(opCtx.get(), otherStashNss(), {});
+    }
+}
+
 TEST_F(ReshardingOplogCrudApplicationTest, UpdateOpModifiesStashCollectionAfterInsertConflict) {
     // This case tests applying rule #1 described in
     // ReshardingOplogApplicationRules::_applyUpdate_inlock.
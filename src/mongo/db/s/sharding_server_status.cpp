@@ -127,5 +127,27 @@ public:
 
 } shardingStatisticsServerStatus;
 
+class ChunkWritesServerStatus final : public ServerStatusSection {
+public:
+    ChunkWritesServerStatus() : ServerStatusSection("chunkWrites") {}
+
+    bool includeByDefault() const override {
+        // Only the balancer asks for the rates of writes to the chunks, since reporting them visits
+        // every chunk owned by this shard.
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        if (!isClusterNode() || !ShardingState::get(opCtx)->enabled())
+            return {};
+
+        BSONObjBuilder result;
+        CollectionShardingState::appendChunkWriteRatesForServerStatus(opCtx, &result);
+        return result.obj();
+    }
+
+} chunkWritesServerStatus;
+
 }  // namespace
 }  // namespace mongo
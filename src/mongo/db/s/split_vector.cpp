@@ -45,6 +45,7 @@
 #include "mongo/db/query/internal_plans.h"
 #include "mongo/db/query/plan_executor.h"
 #include "mongo/logv2/log.h"
+#include "mongo/s/shard_key_pattern.h"
 
 namespace mongo {
 namespace {
@@ -52,6 +53,10 @@ namespace {
 const int kMaxObjectPerChunk{250000};
 const int estimatedAdditionalBytesPerItemInBSONArray{2};
 
+// The fewest samples which must fall within each of the chunks produced by
+// splitVectorFromSamples() for the split points to be trusted.
+const int kMinSamplesPerChunk{10};
+
 BSONObj prettyKey(const BSONObj& keyPattern, const BSONObj& key) {
     return key.replaceFieldNames(keyPattern).clientReadable();
 }
@@ -349,4 +354,109 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
     return splitKeys;
 }
 
+boost::optional<std::vector<BSONObj>> splitVectorFromSamples(OperationContext* opCtx,
+                                                             const NamespaceString& nss,
+                                                             const BSONObj& keyPattern,
+                                                             const BSONObj& min,
+                                                             const BSONObj& max,
+                                                             long long maxChunkSizeBytes,
+                                                             int numSamples) {
+    invariant(maxChunkSizeBytes > 0);
+    invariant(numSamples > 0);
+
+    AutoGetCollection collection(opCtx, nss, MODE_IS);
+    uassert(ErrorCodes::NamespaceNotFound, "ns not found", collection);
+
+    const long long recCount = collection->numRecords(opCtx);
+    const long long dataSize = collection->dataSize(opCtx);
+
+    // If there's not enough data for more than one chunk, no point continuing.
+    if (dataSize < maxChunkSizeBytes || recCount == 0) {
+        return std::vector<BSONObj>();
+    }
+
+    // Same as splitVector(), each chunk should have approximately half the keys of the
+    // maxChunkSizeBytes chunk.
+    const long long avgRecSize = dataSize / recCount;
+    const long long keyCount = std::max(maxChunkSizeBytes / (2 * avgRecSize), 1LL);
+
+    // Every sample stands for 'recCount / numSamples' documents, so there must be enough samples
+    // to place a split point every 'keyCount' documents.
+    const long long samplesPerChunk = keyCount * numSamples / recCount;
+    if (samplesPerChunk < kMinSamplesPerChunk) {
+        return boost::none;
+    }
+
+    auto cursor = collection->getRecordStore()->getRandomCursor(opCtx);
+    if (!cursor) {
+        return boost::none;
+    }
+
+    const ShardKeyPattern shardKeyPattern(keyPattern);
+    const BSONObj maxBound = max.isEmpty() ? shardKeyPattern.getKeyPattern().globalMax() : max;
+    const auto& comparator = SimpleBSONObjComparator::kInstance;
+
+    // Collect the shard keys of the sampled documents which fall within the chunk. Documents whose
+    // shard key can't be extracted are skipped.
+    std::vector<BSONObj> sampledKeys;
+    for (int i = 0; i < numSamples; ++i) {
+        auto record = cursor->next();
+        if (!record) {
+            break;
+        }
+
+        auto shardKey = shardKeyPattern.extractShardKeyFromDoc(record->data.toBson());
+        if (shardKey.isEmpty() || comparator.evaluate(shardKey < min) ||
+            !comparator.evaluate(shardKey < maxBound)) {
+            continue;
+        }
+        sampledKeys.push_back(shardKey.getOwned());
+    }
+
+    if (static_cast<long long>(sampledKeys.size()) <= samplesPerChunk) {
+        // The chunk is estimated to hold fewer than 'keyCount' documents.
+        return std::vector<BSONObj>();
+    }
+
+    std::sort(sampledKeys.begin(), sampledKeys.end(), comparator.makeLessThan());
+
+    // Use every 'samplesPerChunk'-th sampled key as a split point. A key equal to the chunk's
+    // minimum or to the previous split point is skipped in favor of the next distinct key, so all
+    // of the instances of a given key value live in the same chunk.
+    std::vector<BSONObj> splitKeys;
+    std::size_t splitVectorResponseSize = 0;
+    long long currCount = 0;
+    for (const auto& key : sampledKeys) {
+        if (++currCount <= samplesPerChunk) {
+            continue;
+        }
+
+        const auto& prevKey = splitKeys.empty() ? min : splitKeys.back();
+        if (comparator.evaluate(key == prevKey)) {
+            continue;
+        }
+
+        auto additionalKeySize = key.objsize() + estimatedAdditionalBytesPerItemInBSONArray;
+        if (splitVectorResponseSize + additionalKeySize > BSONObjMaxUserSize) {
+            break;
+        }
+
+        splitVectorResponseSize += additionalKeySize;
+        splitKeys.push_back(key);
+        currCount = 0;
+    }
+
+    LOGV2_DEBUG(5963009,
+                1,
+                "Estimated split points from sampled documents",
+                "namespace"_attr = nss.toString(),
+                "minKey"_attr = redact(min),
+                "maxKey"_attr = redact(maxBound),
+                "numSamples"_attr = numSamples,
+                "numSamplesInChunk"_attr = sampledKeys.size(),
+                "numSplits"_attr = splitKeys.size());
+
+    return splitKeys;
+}
+
 }  // namespace mongo
@@ -66,4 +66,22 @@ std::vector<BSONObj> splitVector(OperationContext* opCtx,
                                  boost::optional<long long> maxChunkObjects,
                                  boost::optional<long long> maxChunkSizeBytes);
 
+/**
+ * Estimates the split points of a chunk from the shard keys of 'numSamples' documents sampled at
+ * random from the collection, instead of scanning the chunk's range of the shard key index. The
+ * split points are chosen the same as splitVector() chooses them when force is false and
+ * maxChunkObjects and maxSplitPoints are not specified.
+ *
+ * Returns boost::none if the storage engine doesn't support random cursors or if 'numSamples' is
+ * too small relative to the collection to place the split points, in which case the caller should
+ * fall back to splitVector().
+ */
+boost::optional<std::vector<BSONObj>> splitVectorFromSamples(OperationContext* opCtx,
+                                                             const NamespaceString& nss,
+                                                             const BSONObj& keyPattern,
+                                                             const BSONObj& min,
+                                                             const BSONObj& max,
+                                                             long long maxChunkSizeBytes,
+                                                             int numSamples);
+
 }  // namespace mongo
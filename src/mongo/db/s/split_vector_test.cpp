@@ -108,6 +108,30 @@ TEST_F(SplitVectorTest, SplitVectorInHalf) {
     }
 }
 
+TEST_F(SplitVectorTest, SplitVectorFromSamplesNoSplitWhenCollectionIsSmallerThanChunk) {
+    auto splitKeys = splitVectorFromSamples(operationContext(),
+                                            kNss,
+                                            BSON(kPattern << 1),
+                                            BSON(kPattern << 0),
+                                            BSON(kPattern << 100),
+                                            getDocSizeBytes() * 200LL,
+                                            1000);
+    ASSERT(splitKeys);
+    ASSERT(splitKeys->empty());
+}
+
+TEST_F(SplitVectorTest, SplitVectorFromSamplesFallsBackWithTooFewSamples) {
+    // Splitting every 5 documents out of 100 needs more than 10 samples to place the split points.
+    auto splitKeys = splitVectorFromSamples(operationContext(),
+                                            kNss,
+                                            BSON(kPattern << 1),
+                                            BSON(kPattern << 0),
+                                            BSON(kPattern << 100),
+                                            getDocSizeBytes() * 10LL,
+                                            10);
+    ASSERT_FALSE(splitKeys);
+}
+
 TEST_F(SplitVectorTest, ForceSplit) {
     std::vector<BSONObj> splitKeys = splitVector(operationContext(),
                                                  kNss,
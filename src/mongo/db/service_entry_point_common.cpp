@@ -81,10 +81,13 @@
 #include "mongo/db/service_entry_point_common.h"
 #include "mongo/db/session_catalog_mongod.h"
 #include "mongo/db/stats/api_version_metrics.h"
+#include "mongo/db/stats/command_latency_histograms.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/stats/query_shape_stats.h"
 #include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/stats/server_read_concern_metrics.h"
 #include "mongo/db/stats/top.h"
+#include "mongo/db/ticket_priority_gen.h"
 #include "mongo/db/transaction_participant.h"
 #include "mongo/db/transaction_validation.h"
 #include "mongo/db/vector_clock.h"
@@ -103,6 +106,7 @@
 #include "mongo/transport/hello_metrics.h"
 #include "mongo/transport/service_executor.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/cpu_profiler.h"
 #include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future_util.h"
@@ -150,6 +154,23 @@ Future<void> runCommandInvocation(std::shared_ptr<RequestExecutionContext> rec,
         std::move(rec), std::move(invocation), threadingModel);
 }
 
+/**
+ * Sets the priority with which the operation waits for storage engine tickets according to the
+ * application name of its client.
+ */
+void setTicketPriorityFromAppName(OperationContext* opCtx, StringData appName) {
+    auto matches = [&](const std::vector<std::string>& appNames) {
+        return std::find(appNames.begin(), appNames.end(), appName) != appNames.end();
+    };
+    if (appName.empty()) {
+        return;
+    } else if (matches(gHighTicketPriorityAppNames)) {
+        opCtx->lockState()->setTicketPriority(TicketPriority::kHigh);
+    } else if (matches(gLowTicketPriorityAppNames)) {
+        opCtx->lockState()->setTicketPriority(TicketPriority::kLow);
+    }
+}
+
 /*
  * Allows for the very complex handleRequest function to be decomposed into parts.
  * It also provides the infrastructure to futurize the process of executing commands.
@@ -649,6 +670,9 @@ private:
             APIParameters::get(opCtx) = APIParameters::fromClient(apiParamsFromClient);
         }
 
+        // Reset by ServiceEntryPointCommon::handleRequest once the request completes.
+        CPUProfiler::setOperationType(&command->getName());
+
         CommandHelpers::uassertShouldAttemptParse(opCtx, command, request);
         _startOperationTime = getClientOperationTime(opCtx);
 
@@ -1317,6 +1341,7 @@ void ExecCommandDatabase::_initiateCommand() {
     if (auto clientMetadata = ClientMetadata::get(client)) {
         auto appName = clientMetadata->getApplicationName().toString();
         apiVersionMetrics.update(appName, apiParams);
+        setTicketPriorityFromAppName(opCtx, appName);
     }
 
     sleepMillisAfterCommandExecutionBegins.execute([&](const BSONObj& data) {
@@ -2338,11 +2363,27 @@ void HandleRequest::completeOperation(DbResponse& response) {
                                                                  executionContext->slowMsOverride,
                                                                  executionContext->forceLog);
 
+    const auto elapsedMicros = durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses());
     Top::get(opCtx->getServiceContext())
-        .incrementGlobalLatencyStats(
-            opCtx,
-            durationCount<Microseconds>(currentOp.elapsedTimeExcludingPauses()),
-            currentOp.getReadWriteType());
+        .incrementGlobalLatencyStats(opCtx, elapsedMicros, currentOp.getReadWriteType());
+    if (auto command = currentOp.getCommand()) {
+        CommandLatencyHistograms::get(opCtx->getServiceContext())
+            .increment(opCtx, command->getName(), currentOp.getNSS(), elapsedMicros);
+
+        const auto& debug = currentOp.debug();
+        if (debug.queryHash && QueryShapeStats::shouldSample(opCtx)) {
+            QueryShapeStats::get(opCtx->getServiceContext())
+                .record({command->getName(),
+                         currentOp.getNSS(),
+                         *debug.queryHash,
+                         currentOp.getPlanSummary(),
+                         Microseconds(elapsedMicros),
+                         debug.additiveMetrics.docsExamined.value_or(0),
+                         debug.additiveMetrics.keysExamined.value_or(0),
+                         std::max(debug.nreturned, 0LL)},
+                        opCtx->getServiceContext()->getFastClockSource()->now());
+        }
+    }
 
     if (shouldProfile) {
         // Performance profiling is on
@@ -2384,6 +2425,10 @@ Future<DbResponse> ServiceEntryPointCommon::handleRequest(
     OperationContext* opCtx,
     const Message& m,
     std::unique_ptr<const Hooks> behaviors) noexcept try {
+    // Samples taken by the CPU profiler on this thread while the request runs are attributed to
+    // its command, once it is known.
+    ON_BLOCK_EXIT([] { CPUProfiler::setOperationType(nullptr); });
+
     HandleRequest hr(opCtx, m, std::move(behaviors));
     hr.startOperation();
 
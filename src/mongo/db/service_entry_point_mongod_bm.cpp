@@ -0,0 +1,253 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/repl/mock_repl_coord_server_fixture.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/rpc/op_msg.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/transport/mock_session.h"
+#include "mongo/transport/service_entry_point_impl.h"
+#include "mongo/transport/service_executor.h"
+#include "mongo/util/future.h"
+
+namespace mongo {
+namespace {
+
+using ThreadingModel = transport::ServiceExecutor::ThreadingModel;
+
+const NamespaceString kFindNss("test", "find");
+const NamespaceString kInsertNss("test", "insert");
+
+const auto kSessionClosedStatus = Status{ErrorCodes::SocketException, "Session is closed"};
+
+/**
+ * An in-memory session which hands the requests of the benchmark to the ServiceStateMachine, one
+ * at a time, and the replies back to the benchmark.
+ */
+class LoopbackSession final : public transport::MockSessionBase {
+public:
+    /**
+     * Sends 'request' and waits for its reply.
+     */
+    Message roundTrip(Message request) {
+        stdx::unique_lock lk(_mutex);
+        if (auto promise = std::exchange(_requestPromise, {})) {
+            lk.unlock();
+            promise->emplaceValue(std::move(request));
+            lk.lock();
+        } else {
+            _request = std::move(request);
+            _cv.notify_all();
+        }
+
+        _cv.wait(lk, [&] { return _reply || _ended; });
+        invariant(_reply, "The session ended before replying");
+        return *std::exchange(_reply, {});
+    }
+
+    TransportLayer* getTransportLayer() const override {
+        MONGO_UNREACHABLE;
+    }
+
+    void end() override {
+        stdx::unique_lock lk(_mutex);
+        _ended = true;
+        _cv.notify_all();
+        if (auto promise = std::exchange(_requestPromise, {})) {
+            lk.unlock();
+            promise->setError(kSessionClosedStatus);
+        }
+    }
+
+    bool isConnected() override {
+        stdx::lock_guard lk(_mutex);
+        return !_ended;
+    }
+
+    Status waitForData() noexcept override {
+        return Status::OK();
+    }
+
+    Future<void> asyncWaitForData() noexcept override {
+        return Future<void>::makeReady();
+    }
+
+    StatusWith<Message> sourceMessage() noexcept override {
+        stdx::unique_lock lk(_mutex);
+        _cv.wait(lk, [&] { return _request || _ended; });
+        if (_ended) {
+            return kSessionClosedStatus;
+        }
+        return *std::exchange(_request, {});
+    }
+
+    Future<Message> asyncSourceMessage(const BatonHandle&) noexcept override {
+        stdx::lock_guard lk(_mutex);
+        if (_ended) {
+            return Future<Message>::makeReady(kSessionClosedStatus);
+        }
+        if (_request) {
+            return Future<Message>::makeReady(*std::exchange(_request, {}));
+        }
+        auto pf = makePromiseFuture<Message>();
+        _requestPromise.emplace(std::move(pf.promise));
+        return std::move(pf.future);
+    }
+
+    Status sinkMessage(Message message) noexcept override {
+        stdx::lock_guard lk(_mutex);
+        _reply = std::move(message);
+        _cv.notify_all();
+        return Status::OK();
+    }
+
+    Future<void> asyncSinkMessage(Message message, const BatonHandle&) noexcept override {
+        return Future<void>::makeReady(sinkMessage(std::move(message)));
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("LoopbackSession::_mutex");
+    stdx::condition_variable _cv;
+    bool _ended = false;
+    boost::optional<Message> _request;
+    boost::optional<Promise<Message>> _requestPromise;
+    boost::optional<Message> _reply;
+};
+
+/**
+ * Runs a mongod ServiceEntryPoint over the ephemeralForTest storage engine, with a single
+ * LoopbackSession whose ServiceStateMachine runs on the service executor of 'threadingModel'.
+ */
+class ServiceEntryPointBenchmark : public MockReplCoordServerFixture {
+public:
+    explicit ServiceEntryPointBenchmark(ThreadingModel threadingModel)
+        : _threadingModel(threadingModel) {}
+
+    void setUp() override {
+        _originalThreadingModel = transport::ServiceExecutor::getInitialThreadingModel();
+        transport::ServiceExecutor::setInitialThreadingModel(_threadingModel);
+        MockReplCoordServerFixture::setUp();
+
+        DBDirectClient client(opCtx());
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < 1000; ++i) {
+            docs.push_back(BSON("_id" << i << "x" << i));
+        }
+        client.insert(kFindNss.ns(), docs);
+
+        _sep = checked_cast<ServiceEntryPointImpl*>(getServiceContext()->getServiceEntryPoint());
+        uassertStatusOK(_sep->start());
+        _session = std::make_shared<LoopbackSession>();
+        _sep->startSession(_session);
+    }
+
+    void tearDown() override {
+        _session->end();
+        invariant(_sep->shutdownAndWait(Seconds{10}));
+        MockReplCoordServerFixture::tearDown();
+        transport::ServiceExecutor::setInitialThreadingModel(_originalThreadingModel);
+    }
+
+    LoopbackSession& session() {
+        return *_session;
+    }
+
+private:
+    void _doTest() override {}
+
+    const ThreadingModel _threadingModel;
+    ThreadingModel _originalThreadingModel;
+    ServiceEntryPointImpl* _sep = nullptr;
+    std::shared_ptr<LoopbackSession> _session;
+};
+
+/**
+ * Sends the command 'body' through the session over and over, with the threading model given by
+ * the benchmark argument. Only the transport, dispatch and execution of the command are timed.
+ */
+void runCommand(benchmark::State& state, StringData dbName, const BSONObj& body) {
+    const auto threadingModel = static_cast<ThreadingModel>(state.range(0));
+    state.SetLabel(toString(threadingModel).toString());
+
+    ServiceEntryPointBenchmark fixture(threadingModel);
+    fixture.setUp();
+
+    const auto request = OpMsgRequest::fromDBAndBody(dbName, body).serialize();
+    Message reply;
+    for (auto keepRunning : state) {
+        reply = fixture.session().roundTrip(request);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (const auto replyBody = OpMsg::parse(reply).body; !replyBody["ok"].trueValue()) {
+        state.SkipWithError(replyBody.toString().c_str());
+    }
+    fixture.tearDown();
+}
+
+void BM_Ping(benchmark::State& state) {
+    runCommand(state, "admin", BSON("ping" << 1));
+}
+
+void BM_FindById(benchmark::State& state) {
+    runCommand(state,
+               kFindNss.db(),
+               BSON("find" << kFindNss.coll() << "filter" << BSON("_id" << 42) << "limit" << 1
+                           << "singleBatch" << true));
+}
+
+void BM_Insert(benchmark::State& state) {
+    // The documents have no _id, so that the server generates a new one for every insert.
+    runCommand(state,
+               kInsertNss.db(),
+               BSON("insert" << kInsertNss.coll() << "documents"
+                             << BSON_ARRAY(BSON("x" << 1 << "y"
+                                                    << "abc"))));
+}
+
+// The commands run on the threads of the service executor, so the benchmarks are timed on the wall
+// clock.
+#define BENCHMARK_THREADING_MODELS(name)                     \
+    BENCHMARK(name)                                          \
+        ->Arg(static_cast<int>(ThreadingModel::kDedicated)) \
+        ->Arg(static_cast<int>(ThreadingModel::kBorrowed))  \
+        ->UseRealTime()
+
+BENCHMARK_THREADING_MODELS(BM_Ping);
+BENCHMARK_THREADING_MODELS(BM_FindById);
+BENCHMARK_THREADING_MODELS(BM_Insert);
+
+}  // namespace
+}  // namespace mongo
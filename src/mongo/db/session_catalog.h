@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <boost/optional.hpp>
 #include <vector>
 
@@ -37,6 +38,7 @@
 #include "mongo/db/operation_context.h"
 #include "mongo/db/session.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/unordered_map.h"
@@ -50,6 +52,9 @@ class ScopedBlockSessionCheckouts;
 
 /**
  * Keeps track of the transaction runtime state for every active session on this instance.
+ *
+ * The sessions are spread over a fixed number of partitions by the hash of their id, each with a
+ * mutex of its own, so that checking out and in unrelated sessions does not contend on one mutex.
  */
 class SessionCatalog {
     SessionCatalog(const SessionCatalog&) = delete;
@@ -92,13 +97,13 @@ public:
     SessionToKill checkOutSessionForKill(OperationContext* opCtx, KillToken killToken);
 
     /**
-     * Iterates through the SessionCatalog under the SessionCatalog mutex and applies 'workerFn' to
-     * each Session which matches the specified 'matcher'.
+     * Iterates through the SessionCatalog and applies 'workerFn' to each Session which matches the
+     * specified 'matcher'. Each Session is visited under the mutex of the partition it lives in,
+     * and the partitions are visited one after the other, so the scan is not a snapshot of the
+     * whole catalog.
      *
-     * NOTE: Since this method runs with the session catalog mutex, the work done by 'workerFn' is
-     * not allowed to block, perform I/O or acquire any lock manager locks.
-     * Iterates through the SessionCatalog and applies 'workerFn' to each Session. This locks the
-     * SessionCatalog.
+     * NOTE: Since this method runs with a session catalog mutex, the work done by 'workerFn' is not
+     * allowed to block, perform I/O or acquire any lock manager locks.
      */
     using ScanSessionsCallbackFn = std::function<void(ObservableSession&)>;
     void scanSession(const LogicalSessionId& lsid, const ScanSessionsCallbackFn& workerFn);
@@ -106,8 +111,8 @@ public:
                       const ScanSessionsCallbackFn& workerFn);
 
     /**
-     * Shortcut to invoke 'kill' on the specified session under the SessionCatalog mutex. Throws a
-     * NoSuchSession exception if the session doesn't exist.
+     * Shortcut to invoke 'kill' on the specified session under the mutex of its partition. Throws
+     * a NoSuchSession exception if the session doesn't exist.
      */
     KillToken killSession(const LogicalSessionId& lsid);
 
@@ -131,23 +136,40 @@ private:
         // sessions entries from the map.
         int numWaitingToCheckOut{0};
 
-        // Signaled when the state becomes available. Uses the transaction table's mutex to protect
-        // the state transitions.
+        // Signaled when the state becomes available. Uses the mutex of the session's partition to
+        // protect the state transitions.
         stdx::condition_variable availableCondVar;
     };
     using SessionRuntimeInfoMap = LogicalSessionIdMap<std::unique_ptr<SessionRuntimeInfo>>;
 
+    static constexpr size_t kNumPartitions = 16;
+
+    struct Partition {
+        // Protects the sessions of this partition and their runtime info.
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::Partition::mutex");
+
+        // Owns the Session objects for the current Sessions hashed to this partition.
+        SessionRuntimeInfoMap sessions;
+    };
+
+    /**
+     * Returns the partition which the session with id 'lsid' lives in.
+     */
+    Partition& _getPartition(const LogicalSessionId& lsid);
+
     /**
      * Blocking method, which checks-out the session set on 'opCtx'.
      */
     ScopedCheckedOutSession _checkOutSession(OperationContext* opCtx);
 
     /**
-     * Creates or returns the session runtime info for 'lsid' from the '_sessions' map. The returned
-     * pointer is guaranteed to be linked on the map for as long as the mutex is held.
+     * Creates or returns the session runtime info for 'lsid' from the map of 'partition', which
+     * must be the partition of 'lsid'. The returned pointer is guaranteed to be linked on the map
+     * for as long as the partition's mutex is held.
      */
     SessionRuntimeInfo* _getOrCreateSessionRuntimeInfo(WithLock,
-                                                       OperationContext* opCtx,
+                                                       Partition& partition,
                                                        const LogicalSessionId& lsid);
 
     /**
@@ -165,17 +187,14 @@ private:
      */
     void _allowCheckouts();
 
-    // Protects the state below
-    mutable Mutex _mutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "SessionCatalog::_mutex");
-
-    // Owns the Session objects for all current Sessions.
-    SessionRuntimeInfoMap _sessions;
+    std::array<Partition, kNumPartitions> _partitions;
 
     // If false no new sessions can be checked out. Reasons why this could be true is because step
     // down is in progress and we should not allow new sessions to get checked out in order to
-    // prevent deadlocks.
-    bool _checkoutAllowed{true};
+    // prevent deadlocks. Only read with the mutex of the partition of the session being checked
+    // out held, so that once checkouts are disallowed and every partition mutex has been acquired
+    // in turn, no checkout which saw it set can still be in progress.
+    AtomicWord<bool> _checkoutAllowed{true};
 };
 
 /**
@@ -259,8 +278,8 @@ using SessionToKill = SessionCatalog::SessionToKill;
 /**
  * This type represents access to a session inside of a scanSessions loop.
  * If you have one of these, you're in a scanSessions callback context, and so
- * have locked the whole catalog and, if the observed session is bound to an operation context,
- * you hold that operation context's client's mutex, as well.
+ * have locked the session's partition of the catalog and, if the observed session is bound to an
+ * operation context, you hold that operation context's client's mutex, as well.
  */
 class ObservableSession {
 public:
@@ -121,8 +121,8 @@ void disallowDirectWritesUnderSession(OperationContext* opCtx) {
 }
 
 const auto kIdProjection = BSON(SessionTxnRecord::kSessionIdFieldName << 1);
-const auto kSortById = BSON(SessionTxnRecord::kSessionIdFieldName << 1);
 const auto kLastWriteDateFieldName = SessionTxnRecord::kLastWriteDateFieldName;
+constexpr auto kLastWriteDateIndexName = "lastWriteDate_1"_sd;
 
 /**
  * Removes the specified set of session ids from the persistent sessions collection and returns the
@@ -187,6 +187,16 @@ void createTransactionTable(OperationContext* opCtx) {
         status,
         str::stream() << "Failed to create the "
                       << NamespaceString::kSessionTransactionsTableNamespace.ns() << " collection");
+
+    // Index the last write date, so that reaping only visits the records old enough to be reaped
+    auto indexSpec = BSON("v" << 2 << "key" << BSON(kLastWriteDateFieldName << 1) << "name"
+                              << kLastWriteDateIndexName);
+    uassertStatusOKWithContext(
+        repl::StorageInterface::get(serviceCtx)
+            ->createIndexesOnEmptyCollection(
+                opCtx, NamespaceString::kSessionTransactionsTableNamespace, {indexSpec}),
+        str::stream() << "Failed to create the " << kLastWriteDateIndexName << " index on "
+                      << NamespaceString::kSessionTransactionsTableNamespace.ns());
 }
 
 void abortInProgressTransactions(OperationContext* opCtx) {
@@ -375,14 +385,15 @@ int MongoDSessionCatalog::reapSessionsOlderThan(OperationContext* opCtx,
     if (!replCoord->canAcceptWritesForDatabase_UNSAFE(opCtx, NamespaceString::kConfigDb))
         return 0;
 
-    // Scan for records older than the minimum lifetime and uses a sort to walk the '_id' index
+    // Scan for records older than the minimum lifetime. There is no sort, so that the range on the
+    // last write date can be answered from its index, where one exists, rather than the whole
+    // collection being walked in '_id' order
     DBDirectClient client(opCtx);
-    auto cursor =
-        client.query(NamespaceString::kSessionTransactionsTableNamespace,
-                     Query(BSON(kLastWriteDateFieldName << LT << possiblyExpired)).sort(kSortById),
-                     0,
-                     0,
-                     &kIdProjection);
+    auto cursor = client.query(NamespaceString::kSessionTransactionsTableNamespace,
+                               Query(BSON(kLastWriteDateFieldName << LT << possiblyExpired)),
+                               0,
+                               0,
+                               &kIdProjection);
 
     // The max batch size is chosen so that a single batch won't exceed the 16MB BSON object size
     // limit
@@ -266,6 +266,35 @@ TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsMarkForReap) {
     });
 }
 
+TEST_F(SessionCatalogTestWithDefaultOpCtx, ScanSessionsVisitsSessionsOfEveryPartition) {
+    // Enough sessions that every partition of the catalog is all but certain to hold some.
+    LogicalSessionIdSet lsids;
+    for (int i = 0; i < 200; ++i) {
+        lsids.insert(makeLogicalSessionIdForTest());
+    }
+    stdx::async(stdx::launch::async,
+                [&] {
+                    ThreadClient tc(getServiceContext());
+                    for (const auto& lsid : lsids) {
+                        auto opCtx = makeOperationContext();
+                        opCtx->setLogicalSessionId(lsid);
+                        OperationContextSession ocs(opCtx.get());
+                    }
+                })
+        .get();
+    ASSERT_EQ(lsids.size(), catalog()->size());
+
+    SessionKiller::Matcher matcherAllSessions(
+        KillAllSessionsByPatternSet{makeKillAllSessionsByPattern(_opCtx)});
+    LogicalSessionIdSet lsidsFound;
+    catalog()->scanSessions(matcherAllSessions, [&](ObservableSession& session) {
+        lsidsFound.insert(session.getSessionId());
+        session.markForReap();
+    });
+    ASSERT(lsidsFound == lsids);
+    ASSERT_EQ(0U, catalog()->size());
+}
+
 TEST_F(SessionCatalogTest, KillSessionWhenSessionIsNotCheckedOut) {
     const auto lsid = makeLogicalSessionIdForTest();
 
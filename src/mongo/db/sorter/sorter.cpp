@@ -49,18 +49,27 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <snappy.h>
 #include <vector>
 
+#include "mongo/base/data_type_endian.h"
+#include "mongo/base/data_view.h"
 #include "mongo/base/string_data.h"
 #include "mongo/config.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/service_context.h"
+#include "mongo/db/sorter/sorter_compression.h"
 #include "mongo/db/storage/encryption_hooks.h"
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -110,6 +119,67 @@ namespace sorter {
 
 using std::shared_ptr;
 
+// Set in the absolute value of a negative block size to indicate that the block was compressed with
+// zstd rather than snappy. Blocks are far smaller than 1GB, so the bit is never part of the size.
+constexpr int32_t kZstdCompressedBlockFlag = 1 << 30;
+
+/**
+ * Runs block reads scheduled by the FileIterators being merged by a MergeIterator on a single
+ * background thread, so that the next block of each spilled range is read, decrypted and
+ * decompressed while the current block of that range is being merged.
+ *
+ * Tasks that have not started running when the BlockPrefetcher is destroyed are discarded.
+ */
+class BlockPrefetcher {
+    BlockPrefetcher(const BlockPrefetcher&) = delete;
+    BlockPrefetcher& operator=(const BlockPrefetcher&) = delete;
+
+public:
+    BlockPrefetcher() : _thread([this] { _run(); }) {}
+
+    ~BlockPrefetcher() {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _inShutdown = true;
+        }
+        _cv.notify_one();
+        _thread.join();
+    }
+
+    void schedule(std::function<void()> task) {
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _cv.notify_one();
+    }
+
+private:
+    void _run() {
+        while (true) {
+            std::function<void()> task;
+            {
+                stdx::unique_lock<Latch> lk(_mutex);
+                _cv.wait(lk, [&] { return _inShutdown || !_tasks.empty(); });
+                if (_inShutdown) {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    Mutex _mutex = MONGO_MAKE_LATCH("BlockPrefetcher::_mutex");
+    stdx::condition_variable _cv;
+    std::deque<std::function<void()>> _tasks;
+    bool _inShutdown = false;
+
+    // Must be last so that the members above are initialized before the thread starts.
+    stdx::thread _thread;
+};
+
 // We need to use the "real" errno everywhere, not GetLastError() on Windows
 inline std::string myErrnoWithDescription() {
     int errnoCopy = errno;
@@ -118,6 +188,31 @@ inline std::string myErrnoWithDescription() {
     return sb.str();
 }
 
+/**
+ * Whether 'Comparator' orders pairs exactly as the bytes returned by its static member function
+ * binaryComparableKey(const Data&) compare with memcmp, shorter keys first on a tie.
+ */
+template <typename Comparator, typename Data, typename = void>
+constexpr bool hasBinaryComparableKey = false;
+
+template <typename Comparator, typename Data>
+constexpr bool hasBinaryComparableKey<
+    Comparator,
+    Data,
+    std::void_t<decltype(Comparator::binaryComparableKey(std::declval<const Data&>()))>> = true;
+
+/**
+ * Returns the first eight bytes of 'key' as a big-endian integer, padded with zero bytes, so that
+ * comparing two prefixes orders their keys as memcmp would whenever the prefixes differ.
+ */
+inline uint64_t loadKeyPrefix(StringData key) {
+    char bytes[sizeof(uint64_t)] = {};
+    if (!key.empty()) {
+        memcpy(bytes, key.rawData(), std::min(key.size(), sizeof(bytes)));
+    }
+    return ConstDataView(bytes).read<BigEndian<uint64_t>>();
+}
+
 template <typename Data, typename Comparator>
 void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs) {
 #if defined(MONGO_CONFIG_DEBUG_BUILD) && !defined(_MSC_VER)
@@ -277,6 +372,20 @@ public:
         return {_fileStartOffset, _fileEndOffset, _originalChecksum};
     }
 
+    /**
+     * Reads ahead the next block of the range with 'prefetcher' from now on, or stops reading ahead
+     * if 'prefetcher' is null. Stopping must only happen once 'prefetcher' has been destroyed.
+     */
+    void setPrefetcher(BlockPrefetcher* prefetcher) {
+        _prefetcher = prefetcher;
+        if (!_prefetcher) {
+            _prefetchPending = false;
+            _prefetchReady = false;
+            _prefetchedBlock = {};
+            _prefetchError = nullptr;
+        }
+    }
+
 private:
     /**
      * Attempts to refill the _bufferReader if it is empty. Expects _done to be false.
@@ -289,28 +398,92 @@ private:
     }
 
     /**
-     * Tries to read from disk and places any results in _bufferReader. If there is no more data to
-     * read, then _done is set to true and the function returns immediately.
+     * A decoded block of a sorted data range. 'data' is null once the end of the range is reached.
+     */
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+    };
+
+    /**
+     * Places the next block in _bufferReader, taking it from the prefetcher if one was requested.
+     * If there is no more data to read, then _done is set to true and the function returns
+     * immediately.
      */
     void fillBufferFromDisk() {
-        int32_t rawSize;
-        read(&rawSize, sizeof(rawSize));
-        if (_done)
+        Block block = _prefetchPending ? waitForPrefetchedBlock() : readBlock();
+        if (!block.data) {
+            _done = true;
             return;
+        }
+
+        // hold on to decompressed data and throw out compressed data at block exit
+        _buffer = std::move(block.data);
+        _bufferReader.reset(new BufReader(_buffer.get(), block.size));
+
+        if (_prefetcher) {
+            schedulePrefetch();
+        }
+    }
+
+    /**
+     * Asks the prefetcher to read the block following the one in _bufferReader. The file must not
+     * be touched by this thread until the block is taken by waitForPrefetchedBlock().
+     */
+    void schedulePrefetch() {
+        invariant(!_prefetchPending);
+        _prefetchPending = true;
+        _prefetcher->schedule([this] {
+            Block block;
+            std::exception_ptr error;
+            try {
+                block = readBlock();
+            } catch (...) {
+                error = std::current_exception();
+            }
+
+            stdx::lock_guard<Latch> lk(_prefetchMutex);
+            _prefetchedBlock = std::move(block);
+            _prefetchError = error;
+            _prefetchReady = true;
+            _prefetchCV.notify_one();
+        });
+    }
+
+    Block waitForPrefetchedBlock() {
+        stdx::unique_lock<Latch> lk(_prefetchMutex);
+        _prefetchCV.wait(lk, [&] { return _prefetchReady; });
+        _prefetchPending = false;
+        _prefetchReady = false;
+        if (_prefetchError) {
+            std::rethrow_exception(std::exchange(_prefetchError, nullptr));
+        }
+        return std::move(_prefetchedBlock);
+    }
+
+    /**
+     * Reads, decrypts and decompresses the next block of the range from disk. Returns an empty
+     * Block when the end of the range is reached.
+     */
+    Block readBlock() {
+        int32_t rawSize;
+        if (!read(&rawSize, sizeof(rawSize)))
+            return {};
 
         // negative size means compressed
         const bool compressed = rawSize < 0;
         int32_t blockSize = std::abs(rawSize);
+        const bool zstdCompressed = compressed && (blockSize & kZstdCompressedBlockFlag);
+        blockSize &= ~kZstdCompressedBlockFlag;
 
-        _buffer.reset(new char[blockSize]);
-        read(_buffer.get(), blockSize);
-        uassert(16816, "file too short?", !_done);
+        std::unique_ptr<char[]> buffer(new char[blockSize]);
+        uassert(16816, "file too short?", read(buffer.get(), blockSize));
 
         if (auto encryptionHooks = getEncryptionHooksIfEnabled()) {
             std::unique_ptr<char[]> out(new char[blockSize]);
             size_t outLen;
             Status status =
-                encryptionHooks->unprotectTmpData(reinterpret_cast<const uint8_t*>(_buffer.get()),
+                encryptionHooks->unprotectTmpData(reinterpret_cast<const uint8_t*>(buffer.get()),
                                                   blockSize,
                                                   reinterpret_cast<uint8_t*>(out.get()),
                                                   blockSize,
@@ -320,37 +493,39 @@ private:
                     str::stream() << "Failed to unprotect data: " << status.toString(),
                     status.isOK());
             blockSize = outLen;
-            _buffer.swap(out);
+            buffer.swap(out);
         }
 
         if (!compressed) {
-            _bufferReader.reset(new BufReader(_buffer.get(), blockSize));
-            return;
+            return {std::move(buffer), static_cast<size_t>(blockSize)};
         }
 
-        dassert(snappy::IsValidCompressedBuffer(_buffer.get(), blockSize));
-
         size_t uncompressedSize;
+        if (zstdCompressed) {
+            auto decompressionBuffer = uncompressZstd(buffer.get(), blockSize, &uncompressedSize);
+            return {std::move(decompressionBuffer), uncompressedSize};
+        }
+
+        dassert(snappy::IsValidCompressedBuffer(buffer.get(), blockSize));
+
         uassert(17061,
                 "couldn't get uncompressed length",
-                snappy::GetUncompressedLength(_buffer.get(), blockSize, &uncompressedSize));
+                snappy::GetUncompressedLength(buffer.get(), blockSize, &uncompressedSize));
 
         std::unique_ptr<char[]> decompressionBuffer(new char[uncompressedSize]);
         uassert(17062,
                 "decompression failed",
-                snappy::RawUncompress(_buffer.get(), blockSize, decompressionBuffer.get()));
+                snappy::RawUncompress(buffer.get(), blockSize, decompressionBuffer.get()));
 
-        // hold on to decompressed data and throw out compressed data at block exit
-        _buffer.swap(decompressionBuffer);
-        _bufferReader.reset(new BufReader(_buffer.get(), uncompressedSize));
+        return {std::move(decompressionBuffer), uncompressedSize};
     }
 
     /**
-     * Attempts to read data from disk. Sets _done to true when file offset reaches _fileEndOffset.
+     * Attempts to read data from disk. Returns false when file offset reaches _fileEndOffset.
      *
      * Masserts on any file errors
      */
-    void read(void* out, size_t size) {
+    bool read(void* out, size_t size) {
         invariant(_file.is_open());
 
         const std::streampos offset = _file.tellg();
@@ -361,8 +536,7 @@ private:
 
         if (offset >= _fileEndOffset) {
             invariant(offset == _fileEndOffset);
-            _done = true;
-            return;
+            return false;
         }
 
         _file.read(reinterpret_cast<char*>(out), size);
@@ -371,6 +545,7 @@ private:
                               << "\": " << myErrnoWithDescription(),
                 _file.good());
         verify(_file.gcount() == static_cast<std::streamsize>(size));
+        return true;
     }
 
     const Settings _settings;
@@ -393,12 +568,26 @@ private:
     // to disk. This is not modified, and is only used for comparison against _afterReadChecksum
     // when the FileIterator is exhausted to ensure no data corruption.
     const uint32_t _originalChecksum;
+
+    // When set, the block following the current one is read ahead by this prefetcher. The
+    // prefetched block and any error raised while reading it are handed over under
+    // _prefetchMutex.
+    BlockPrefetcher* _prefetcher = nullptr;
+    bool _prefetchPending = false;
+    Mutex _prefetchMutex = MONGO_MAKE_LATCH("FileIterator::_prefetchMutex");
+    stdx::condition_variable _prefetchCV;
+    bool _prefetchReady = false;
+    Block _prefetchedBlock;
+    std::exception_ptr _prefetchError;
 };
 
 /**
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The inputs are merged with a tournament tree of losers, which takes a single comparison per level
+ * of the tree to replace the smallest element, rather than the two per level that a heap needs.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -412,39 +601,75 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _comp(comp) {
+        if (opts.prefetchMergeBlocks) {
+            for (const auto& iter : iters) {
+                if (auto fileIter = std::dynamic_pointer_cast<FileIterator<Key, Value>>(iter)) {
+                    if (!_prefetcher) {
+                        _prefetcher = std::make_unique<BlockPrefetcher>();
+                    }
+                    fileIter->setPrefetcher(_prefetcher.get());
+                    _prefetchingIters.push_back(fileIter);
+                }
+            }
+        }
+
+        _streams.resize(iters.size());
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams[i] = std::make_unique<Stream>(i, iters[i]->next(), iters[i]);
+                _numStreams++;
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_numStreams == 0) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        // Play the initial tournament. The leaves of the tree are the streams, at positions
+        // [size, 2 * size), and each internal node remembers the loser of the match played there.
+        const size_t size = _streams.size();
+        _tree.resize(size);
+        std::vector<size_t> winners(2 * size);
+        for (size_t i = 0; i < size; i++) {
+            winners[size + i] = i;
+        }
+        for (size_t node = size - 1; node > 0; node--) {
+            size_t left = winners[2 * node];
+            size_t right = winners[2 * node + 1];
+            if (_beats(left, right)) {
+                winners[node] = left;
+                _tree[node] = right;
+            } else {
+                winners[node] = right;
+                _tree[node] = left;
+            }
+        }
+        _tree[0] = size == 1 ? 0 : winners[1];
     }
 
     ~MergeIterator() {
+        // Stop reading ahead before the streams close their sources.
+        _prefetcher.reset();
+        for (const auto& fileIter : _prefetchingIters) {
+            fileIter->setPrefetcher(nullptr);
+        }
+
         // Clear the remaining Stream objects to close the file handles. Some systems will error
         // closing the file if any file handles are still open.
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
     }
 
     void openSource() {}
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 &&
+            (_first || _numStreams > 1 || (_streams[_tree[0]] && _streams[_tree[0]]->more())))
             return true;
 
         _remaining = 0;
@@ -458,21 +683,24 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _streams[_tree[0]]->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        // Advance the winner's stream and replay its matches on the way from its leaf to the root.
+        size_t winner = _tree[0];
+        if (!_streams[winner]->advance()) {
+            _streams[winner].reset();
+            _numStreams--;
+            verify(_numStreams > 0);
+        }
+        for (size_t node = (winner + _streams.size()) / 2; node > 0; node /= 2) {
+            if (_beats(_tree[node], winner)) {
+                std::swap(_tree[node], winner);
+            }
         }
+        _tree[0] = winner;
 
-        return _current->current();
+        return _streams[winner]->current();
     }
 
 
@@ -514,32 +742,36 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
-
-        template <typename Ptr>
-        bool operator()(const Ptr& lhs, const Ptr& rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
-
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
-        }
-
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Returns whether the current element of stream 'lhs' comes before that of stream 'rhs'.
+     * Exhausted streams lose every match, and ties go to the lower fileNum to ensure stability.
+     */
+    bool _beats(size_t lhs, size_t rhs) const {
+        const auto& lhsStream = _streams[lhs];
+        const auto& rhsStream = _streams[rhs];
+        if (!lhsStream || !rhsStream)
+            return !rhsStream && lhsStream;
+
+        // first compare data
+        dassertCompIsSane(_comp, lhsStream->current(), rhsStream->current());
+        int ret = _comp(lhsStream->current(), rhsStream->current());
+        if (ret)
+            return ret < 0;
+
+        // then compare fileNums to ensure stability
+        return lhsStream->fileNum < rhsStream->fileNum;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    const Comparator _comp;
+    std::vector<std::unique_ptr<Stream>> _streams;  // Indexed by fileNum, null once exhausted.
+    size_t _numStreams = 0;                         // The number of non-null streams.
+    std::vector<size_t> _tree;  // _tree[0] is the winner, other nodes hold the losers.
+
+    std::unique_ptr<BlockPrefetcher> _prefetcher;
+    std::vector<std::shared_ptr<FileIterator<Key, Value>>> _prefetchingIters;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -600,7 +832,7 @@ public:
         _memUsed += memUsage;
         this->_totalDataSizeSorted += memUsage;
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
+        if (_memUsed > this->_opts.maxMemoryUsageBytes || shouldSpillEarly(memUsage))
             spill();
     }
 
@@ -613,7 +845,7 @@ public:
 
         _data.emplace_back(std::move(key), std::move(val));
 
-        if (_memUsed > this->_opts.maxMemoryUsageBytes)
+        if (_memUsed > this->_opts.maxMemoryUsageBytes || shouldSpillEarly(memUsage))
             spill();
     }
 
@@ -643,11 +875,52 @@ private:
     };
 
     void sort() {
-        STLComparator less(_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        if constexpr (hasBinaryComparableKey<Comparator, Data>) {
+            sortByKeyPrefix();
+        } else {
+            STLComparator less(_comp);
+            std::stable_sort(_data.begin(), _data.end(), less);
+        }
         this->_numSorted += _data.size();
     }
 
+    /**
+     * Stable sort for comparators with binary comparable keys. The first bytes of each key are
+     * cached next to its position in _data, so that most comparisons are decided without reading
+     * the keys themselves. Only ties on the prefix are compared with _comp, and ties on _comp are
+     * decided by position.
+     */
+    void sortByKeyPrefix() {
+        struct Entry {
+            uint64_t prefix;
+            size_t index;
+        };
+
+        std::vector<Entry> entries;
+        entries.reserve(_data.size());
+        for (size_t i = 0; i < _data.size(); i++) {
+            entries.push_back({loadKeyPrefix(Comparator::binaryComparableKey(_data[i])), i});
+        }
+
+        std::sort(entries.begin(), entries.end(), [this](const Entry& lhs, const Entry& rhs) {
+            if (lhs.prefix != rhs.prefix)
+                return lhs.prefix < rhs.prefix;
+
+            dassertCompIsSane(_comp, _data[lhs.index], _data[rhs.index]);
+            int ret = _comp(_data[lhs.index], _data[rhs.index]);
+            if (ret)
+                return ret < 0;
+
+            return lhs.index < rhs.index;
+        });
+
+        std::deque<Data> sorted;
+        for (const auto& entry : entries) {
+            sorted.push_back(std::move(_data[entry.index]));
+        }
+        _data.swap(sorted);
+    }
+
     void spill() {
         this->_numSpills++;
         if (_data.empty())
@@ -676,9 +949,23 @@ private:
 
         this->_iters.push_back(std::shared_ptr<Iterator>(iteratorPtr));
 
+        if (this->_opts.memoryUsageChanged) {
+            this->_opts.memoryUsageChanged(-static_cast<int64_t>(_memUsed));
+        }
         _memUsed = 0;
     }
 
+    /**
+     * Reports that the data held in memory grew by 'memUsage' bytes, and returns whether it should
+     * be spilled before reaching the memory limit.
+     */
+    bool shouldSpillEarly(size_t memUsage) {
+        if (!this->_opts.memoryUsageChanged) {
+            return false;
+        }
+        return this->_opts.memoryUsageChanged(memUsage) && this->_opts.extSortAllowed;
+    }
+
     const Comparator _comp;
     const Settings _settings;
     std::streampos _nextSortedFileWriterOffset = 0;
@@ -1036,7 +1323,8 @@ SortedFileWriter<Key, Value>::SortedFileWriter(const SortOptions& opts,
       // _file.tellp() is not initialized on all systems to reflect this. Therefore, we must also
       // pass in the expected offset to this constructor.
       _fileStartOffset(fileStartOffset),
-      _dbName(opts.dbName) {
+      _dbName(opts.dbName),
+      _zstdSpillCompression(opts.zstdSpillCompression) {
 
     // This should be checked by consumers, but if we get here don't allow writes.
     uassert(
@@ -1089,7 +1377,11 @@ void SortedFileWriter<Key, Value>::spill() {
         return;
 
     std::string compressed;
-    snappy::Compress(outBuffer, size, &compressed);
+    if (_zstdSpillCompression) {
+        sorter::compressZstd(outBuffer, size, &compressed);
+    } else {
+        snappy::Compress(outBuffer, size, &compressed);
+    }
     verify(compressed.size() <= size_t(std::numeric_limits<int32_t>::max()));
 
     const bool shouldCompress = compressed.size() < size_t(_buffer.len() / 10 * 9);
@@ -1117,6 +1409,12 @@ void SortedFileWriter<Key, Value>::spill() {
     }
 
     // negative size means compressed
+    if (shouldCompress && _zstdSpillCompression) {
+        uassert(5843124,
+                str::stream() << "Sorter block of " << size << " bytes is too large to spill",
+                size < sorter::kZstdCompressedBlockFlag);
+        size |= sorter::kZstdCompressedBlockFlag;
+    }
     size = shouldCompress ? -size : size;
     try {
         _file.write(reinterpret_cast<const char*>(&size), sizeof(size));
@@ -33,6 +33,7 @@
 
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -86,6 +87,12 @@
  *     }
  *     Ordering _ord;
  * };
+ *
+ * A comparator that orders pairs exactly as memcmp orders some bytes of the pair, with shorter
+ * byte strings first on a tie, may expose those bytes to let the Sorter use a faster in-memory
+ * sort:
+ *
+ *     static StringData binaryComparableKey(const std::pair<Key, Value>& data);
  */
 
 namespace mongo {
@@ -114,7 +121,23 @@ struct SortOptions {
     // extSortAllowed is true.
     std::string tempDir;
 
-    SortOptions() : limit(0), maxMemoryUsageBytes(64 * 1024 * 1024), extSortAllowed(false) {}
+    // Whether spilled blocks are compressed with zstd rather than snappy.
+    bool zstdSpillCompression;
+
+    // Whether merging spilled ranges reads the next block of each range on a background thread.
+    bool prefetchMergeBlocks;
+
+    // If set, called with the change in the size of the data held in memory whenever it changes.
+    // If it returns true and external sorting is allowed, the data held in memory is spilled
+    // before maxMemoryUsageBytes is reached.
+    std::function<bool(int64_t)> memoryUsageChanged;
+
+    SortOptions()
+        : limit(0),
+          maxMemoryUsageBytes(64 * 1024 * 1024),
+          extSortAllowed(false),
+          zstdSpillCompression(sorterZstdSpillCompression.load()),
+          prefetchMergeBlocks(sorterPrefetchMergeBlocks.load()) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -142,6 +165,21 @@ struct SortOptions {
         dbName = std::move(newDbName);
         return *this;
     }
+
+    SortOptions& ZstdSpillCompression(bool newZstdSpillCompression = true) {
+        zstdSpillCompression = newZstdSpillCompression;
+        return *this;
+    }
+
+    SortOptions& PrefetchMergeBlocks(bool newPrefetchMergeBlocks = true) {
+        prefetchMergeBlocks = newPrefetchMergeBlocks;
+        return *this;
+    }
+
+    SortOptions& MemoryUsageChanged(std::function<bool(int64_t)> newMemoryUsageChanged) {
+        memoryUsageChanged = std::move(newMemoryUsageChanged);
+        return *this;
+    }
 };
 
 /**
@@ -363,6 +401,8 @@ private:
     std::streampos _fileEndOffset;
 
     boost::optional<std::string> _dbName;
+
+    const bool _zstdSpillCompression;
 };
 }  // namespace mongo
 
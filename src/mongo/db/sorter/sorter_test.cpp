@@ -305,6 +305,18 @@ public:
 
             ASSERT_TRUE(boost::filesystem::remove(fileName));
         }
+        {  // big, compressed with zstd
+            std::string fileName = opts.tempDir + "/" + nextFileName();
+            SortedFileWriter<IntWrapper, IntWrapper> sorter(
+                SortOptions(opts).ZstdSpillCompression(), fileName, 0);
+            for (int i = 0; i < 10 * 1000 * 1000; i++)
+                sorter.addAlreadySorted(i, -i);
+
+            ASSERT_ITERATORS_EQUIVALENT(std::shared_ptr<IWIterator>(sorter.done()),
+                                        std::make_shared<IntIterator>(0, 10 * 1000 * 1000));
+
+            ASSERT_TRUE(boost::filesystem::remove(fileName));
+        }
 
         ASSERT(boost::filesystem::is_empty(tempDir.path()));
     }
@@ -359,6 +371,19 @@ public:
                 mergeIterators(iterators, ASC, SortOptions().Limit(10)),
                 std::make_shared<LimitIterator>(10, std::make_shared<IntIterator>(0, 20, 1)));
         }
+        {  // test a number of inputs that is not a power of two, with inputs of different lengths
+            std::shared_ptr<IWIterator> iterators[] = {
+                std::make_shared<IntIterator>(4, 100, 5),  // 4, 9, ... 99
+                std::make_shared<IntIterator>(0, 100, 5),  // 0, 5, ... 95
+                std::make_shared<EmptyIterator>(),
+                std::make_shared<IntIterator>(2, 100, 5),  // 2, 7, ... 97
+                std::make_shared<IntIterator>(3, 100, 5),  // 3, 8, ... 98
+                std::make_shared<IntIterator>(1, 100, 5),  // 1, 6, ... 96
+                std::make_shared<IntIterator>(100, 150)};  // 100, 101, ... 149
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        std::make_shared<IntIterator>(0, 150, 1));
+        }
     }
 };
 
@@ -624,6 +649,15 @@ public:
 };
 
 
+template <bool Random = true>
+class LotsOfDataLittleMemoryZstdPrefetch : public LotsOfDataLittleMemory<Random> {
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        return LotsOfDataLittleMemory<Random>::adjustSortOptions(opts)
+            .ZstdSpillCompression()
+            .PrefetchMergeBlocks();
+    }
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -670,6 +704,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataLittleMemoryZstdPrefetch</*random=*/false>>();
+        add<SorterTests::LotsOfDataLittleMemoryZstdPrefetch</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -867,6 +903,94 @@ TEST_F(SorterMakeFromExistingRangesTest, RoundTrip) {
     }
 }
 
+/**
+ * A string Key whose comparator exposes the string as its binary comparable key.
+ */
+class StringWrapper {
+public:
+    StringWrapper(std::string str = "") : _str(std::move(str)) {}
+    operator StringData() const {
+        return _str;
+    }
+
+    /// members for Sorter
+    struct SorterDeserializeSettings {};  // unused
+    void serializeForSorter(BufBuilder& buf) const {
+        buf.appendNum(static_cast<int>(_str.size()));
+        buf.appendStr(_str, /*includeEndingNull*/ false);
+    }
+    static StringWrapper deserializeForSorter(BufReader& buf, const SorterDeserializeSettings&) {
+        int size = buf.read<LittleEndian<int>>().value;
+        return std::string(static_cast<const char*>(buf.skip(size)), size);
+    }
+    int memUsageForSorter() const {
+        return sizeof(StringWrapper) + _str.size();
+    }
+    StringWrapper getOwned() const {
+        return *this;
+    }
+
+private:
+    std::string _str;
+};
+
+typedef std::pair<StringWrapper, IntWrapper> SWPair;
+
+class SWComparator {
+public:
+    int operator()(const SWPair& lhs, const SWPair& rhs) const {
+        return binaryComparableKey(lhs).compare(binaryComparableKey(rhs));
+    }
+    static StringData binaryComparableKey(const SWPair& data) {
+        return data.first;
+    }
+};
+
+void assertSortsBinaryComparableKeysStably(const SortOptions& opts) {
+    // Keys made of few distinct bytes, so that many of them share their first eight bytes, differ
+    // only in length or contain zero bytes, and so that many are duplicates.
+    PseudoRandom random(int64_t(time(nullptr)));
+    std::vector<SWPair> input;
+    for (int i = 0; i < 20 * 1000; i++) {
+        std::string key(random.nextInt32(12), 'a');
+        for (auto& c : key) {
+            c = "\0ab"[random.nextInt32(3)];
+        }
+        input.emplace_back(key, i);
+    }
+
+    std::unique_ptr<Sorter<StringWrapper, IntWrapper>> sorter(
+        Sorter<StringWrapper, IntWrapper>::make(opts, SWComparator()));
+    for (const auto& data : input) {
+        sorter->add(data.first, data.second);
+    }
+    std::unique_ptr<SortIteratorInterface<StringWrapper, IntWrapper>> iter(sorter->done());
+
+    std::stable_sort(input.begin(), input.end(), [](const SWPair& lhs, const SWPair& rhs) {
+        return SWComparator()(lhs, rhs) < 0;
+    });
+
+    iter->openSource();
+    for (const auto& expected : input) {
+        ASSERT(iter->more());
+        auto data = iter->next();
+        ASSERT_EQ(StringData(expected.first), StringData(data.first));
+        ASSERT_EQ(expected.second, data.second);
+    }
+    ASSERT_FALSE(iter->more());
+    iter->closeSource();
+}
+
+TEST(SorterBinaryComparableKeyTest, InMemory) {
+    assertSortsBinaryComparableKeysStably(SortOptions());
+}
+
+TEST(SorterBinaryComparableKeyTest, Spills) {
+    unittest::TempDir tempDir("sorterBinaryComparableKeyTests");
+    assertSortsBinaryComparableKeysStably(
+        SortOptions().TempDir(tempDir.path()).ExtSortAllowed().MaxMemoryUsageBytes(16 * 1024));
+}
+
 }  // namespace
 }  // namespace sorter
 }  // namespace mongo
@@ -0,0 +1,122 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/command_latency_histograms.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/command_latency_histograms_gen.h"
+
+namespace mongo {
+namespace {
+const auto getCommandLatencyHistograms =
+    ServiceContext::declareDecoration<CommandLatencyHistograms>();
+
+// Namespaces always contain a dot, so this cannot collide with one.
+constexpr auto kOtherNamespacesFieldName = "otherNamespaces"_sd;
+}  // namespace
+
+CommandLatencyHistograms& CommandLatencyHistograms::get(ServiceContext* service) {
+    return getCommandLatencyHistograms(service);
+}
+
+void CommandLatencyHistograms::increment(OperationContext* opCtx,
+                                         StringData command,
+                                         const NamespaceString& nss,
+                                         uint64_t micros) {
+    auto client = opCtx->getClient();
+    if (client->isFromUserConnection() && !client->isInDirectClient()) {
+        increment(command, nss, micros);
+    }
+}
+
+void CommandLatencyHistograms::increment(StringData command,
+                                         const NamespaceString& nss,
+                                         uint64_t micros) {
+    if (gOperationLatencyHistogramsMaxEntries.load() == 0) {
+        return;
+    }
+    _getOrCreate(command, nss)->increment(micros);
+}
+
+HdrLatencyHistogram* CommandLatencyHistograms::_getOrCreate(StringData command,
+                                                            const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    Key key{nss, command.toString()};
+    auto it = _histograms.find(key);
+    if (it != _histograms.end()) {
+        return it->second.get();
+    }
+
+    if (!key.first.isEmpty()) {
+        if (_namespacedEntries >=
+            static_cast<size_t>(gOperationLatencyHistogramsMaxEntries.load())) {
+            key.first = NamespaceString();
+            it = _histograms.find(key);
+            if (it != _histograms.end()) {
+                return it->second.get();
+            }
+        } else {
+            ++_namespacedEntries;
+        }
+    }
+
+    return _histograms.emplace(std::move(key), std::make_unique<HdrLatencyHistogram>())
+        .first->second.get();
+}
+
+std::vector<CommandLatencyHistograms::Entry> CommandLatencyHistograms::getSnapshot() const {
+    std::vector<Entry> entries;
+    stdx::lock_guard<Latch> lk(_mutex);
+    entries.reserve(_histograms.size());
+    for (const auto& [key, histogram] : _histograms) {
+        entries.push_back({key.second, key.first, *histogram});
+    }
+    return entries;
+}
+
+void CommandLatencyHistograms::append(bool includeHistograms, BSONObjBuilder* builder) const {
+    const auto entries = getSnapshot();
+    for (auto it = entries.begin(); it != entries.end();) {
+        const auto& nss = it->nss;
+        BSONObjBuilder nsBuilder(
+            builder->subobjStart(nss.isEmpty() ? kOtherNamespacesFieldName : nss.ns()));
+        for (; it != entries.end() && it->nss == nss; ++it) {
+            BSONObjBuilder commandBuilder(nsBuilder.subobjStart(it->command));
+            it->histogram.append(includeHistograms, &commandBuilder);
+        }
+    }
+}
+
+}  // namespace mongo
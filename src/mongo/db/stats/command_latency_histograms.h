@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
+#include "mongo/platform/mutex.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Tracks a latency histogram for each pair of command name and namespace run by users.
+ *
+ * Once a pair has a histogram it is kept for the lifetime of the process, so that operations can
+ * record their latency without holding the mutex. The number of pairs is capped by the
+ * 'operationLatencyHistogramsMaxEntries' server parameter, beyond which operations are recorded
+ * against their command name with an empty namespace.
+ */
+class CommandLatencyHistograms {
+public:
+    struct Entry {
+        std::string command;
+        NamespaceString nss;
+        HdrLatencyHistogram histogram;
+    };
+
+    static CommandLatencyHistograms& get(ServiceContext* service);
+
+    /**
+     * Records the latency of an operation if it came from a user.
+     */
+    void increment(OperationContext* opCtx,
+                   StringData command,
+                   const NamespaceString& nss,
+                   uint64_t micros);
+
+    /**
+     * Records the latency of an operation regardless of where it came from.
+     */
+    void increment(StringData command, const NamespaceString& nss, uint64_t micros);
+
+    /**
+     * Returns a copy of every histogram, ordered by namespace and then command name.
+     */
+    std::vector<Entry> getSnapshot() const;
+
+    /**
+     * Appends the statistics of every histogram, grouped by namespace and then command name.
+     * Operations recorded without a namespace are grouped under "otherNamespaces".
+     */
+    void append(bool includeHistograms, BSONObjBuilder* builder) const;
+
+private:
+    using Key = std::pair<NamespaceString, std::string>;
+
+    HdrLatencyHistogram* _getOrCreate(StringData command, const NamespaceString& nss);
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CommandLatencyHistograms::_mutex");
+
+    // Keyed by namespace and then command name. The number of entries with a non-empty namespace
+    // is capped, so that a workload touching many collections cannot grow this without bound.
+    std::map<Key, std::unique_ptr<HdrLatencyHistogram>> _histograms;
+    size_t _namespacedEntries = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,110 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/command_latency_histograms.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kFooNss("test.foo");
+const NamespaceString kBarNss("test.bar");
+
+TEST(CommandLatencyHistograms, RecordsEachCommandAndNamespace) {
+    CommandLatencyHistograms histograms;
+    histograms.increment("find", kFooNss, 10);
+    histograms.increment("find", kFooNss, 20);
+    histograms.increment("insert", kFooNss, 30);
+    histograms.increment("find", kBarNss, 40);
+
+    auto entries = histograms.getSnapshot();
+    ASSERT_EQ(entries.size(), 3U);
+
+    ASSERT_EQ(entries[0].nss, kBarNss);
+    ASSERT_EQ(entries[0].command, "find");
+    ASSERT_EQ(entries[0].histogram.getCount(), 1ULL);
+
+    ASSERT_EQ(entries[1].nss, kFooNss);
+    ASSERT_EQ(entries[1].command, "find");
+    ASSERT_EQ(entries[1].histogram.getCount(), 2ULL);
+    ASSERT_EQ(entries[1].histogram.getSum(), 30ULL);
+
+    ASSERT_EQ(entries[2].nss, kFooNss);
+    ASSERT_EQ(entries[2].command, "insert");
+    ASSERT_EQ(entries[2].histogram.getCount(), 1ULL);
+}
+
+TEST(CommandLatencyHistograms, SnapshotIsACopy) {
+    CommandLatencyHistograms histograms;
+    histograms.increment("find", kFooNss, 10);
+    auto entries = histograms.getSnapshot();
+    histograms.increment("find", kFooNss, 10);
+
+    ASSERT_EQ(entries[0].histogram.getCount(), 1ULL);
+    ASSERT_EQ(histograms.getSnapshot()[0].histogram.getCount(), 2ULL);
+}
+
+TEST(CommandLatencyHistograms, NamespacesBeyondTheCapAreRecordedTogether) {
+    RAIIServerParameterControllerForTest maxEntries("operationLatencyHistogramsMaxEntries", 1);
+
+    CommandLatencyHistograms histograms;
+    histograms.increment("find", kFooNss, 10);
+    histograms.increment("find", kBarNss, 20);
+    histograms.increment("find", NamespaceString("test.baz"), 30);
+    histograms.increment("find", kFooNss, 40);
+
+    auto entries = histograms.getSnapshot();
+    ASSERT_EQ(entries.size(), 2U);
+    ASSERT(entries[0].nss.isEmpty());
+    ASSERT_EQ(entries[0].histogram.getCount(), 2ULL);
+    ASSERT_EQ(entries[1].nss, kFooNss);
+    ASSERT_EQ(entries[1].histogram.getCount(), 2ULL);
+
+    BSONObjBuilder builder;
+    histograms.append(false, &builder);
+    BSONObj obj = builder.obj();
+    ASSERT_EQ(obj["otherNamespaces"]["find"]["count"].numberLong(), 2);
+    ASSERT_EQ(obj[kFooNss.ns()]["find"]["micros"].numberLong(), 50);
+}
+
+TEST(CommandLatencyHistograms, DisabledWhenMaxEntriesIsZero) {
+    RAIIServerParameterControllerForTest maxEntries("operationLatencyHistogramsMaxEntries", 0);
+
+    CommandLatencyHistograms histograms;
+    histograms.increment("find", kFooNss, 10);
+    ASSERT(histograms.getSnapshot().empty());
+}
+
+}  // namespace
+}  // namespace mongo
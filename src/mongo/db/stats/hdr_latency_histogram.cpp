@@ -0,0 +1,170 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+namespace {
+constexpr int kSubBuckets = 1 << HdrLatencyHistogram::kSubBucketBits;
+constexpr int kHalfSubBuckets = kSubBuckets / 2;
+
+const struct {
+    const char* name;
+    double percentile;
+} kReportedPercentiles[] = {{"p50", 50}, {"p90", 90}, {"p99", 99}, {"p999", 99.9}};
+}  // namespace
+
+HdrLatencyHistogram::HdrLatencyHistogram(const HdrLatencyHistogram& other) {
+    merge(other);
+}
+
+HdrLatencyHistogram& HdrLatencyHistogram::operator=(const HdrLatencyHistogram& other) {
+    if (this != &other) {
+        for (auto& bucket : _buckets) {
+            bucket.store(0);
+        }
+        _count.store(0);
+        _sum.store(0);
+        merge(other);
+    }
+    return *this;
+}
+
+int HdrLatencyHistogram::getBucket(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(micros);
+    }
+
+    // The top kSubBucketBits bits of the value pick the bucket within its power of two.
+    const int log2 = 63 - countLeadingZeros64(micros);
+    const int shift = log2 - (kSubBucketBits - 1);
+    const int subBucket = static_cast<int>(micros >> shift) - kHalfSubBuckets;
+    const int bucket = kSubBuckets + (log2 - kSubBucketBits) * kHalfSubBuckets + subBucket;
+    return std::min(bucket, kMaxBuckets - 1);
+}
+
+uint64_t HdrLatencyHistogram::getBucketLowerBound(int bucket) {
+    invariant(bucket >= 0 && bucket < kMaxBuckets);
+    if (bucket < kSubBuckets) {
+        return bucket;
+    }
+
+    const int shift = (bucket - kSubBuckets) / kHalfSubBuckets + 1;
+    const uint64_t subBucket = kHalfSubBuckets + (bucket - kSubBuckets) % kHalfSubBuckets;
+    return subBucket << shift;
+}
+
+uint64_t HdrLatencyHistogram::getBucketUpperBound(int bucket) {
+    invariant(bucket >= 0 && bucket < kMaxBuckets);
+    if (bucket == kMaxBuckets - 1) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return getBucketLowerBound(bucket + 1) - 1;
+}
+
+void HdrLatencyHistogram::increment(uint64_t micros) {
+    _buckets[getBucket(micros)].fetchAndAddRelaxed(1);
+    _count.fetchAndAddRelaxed(1);
+    _sum.fetchAndAddRelaxed(micros);
+}
+
+void HdrLatencyHistogram::merge(const HdrLatencyHistogram& other) {
+    for (int i = 0; i < kMaxBuckets; ++i) {
+        if (auto count = other._buckets[i].loadRelaxed()) {
+            _buckets[i].fetchAndAddRelaxed(count);
+        }
+    }
+    _count.fetchAndAddRelaxed(other._count.loadRelaxed());
+    _sum.fetchAndAddRelaxed(other._sum.loadRelaxed());
+}
+
+uint64_t HdrLatencyHistogram::getPercentile(double percentile) const {
+    invariant(percentile >= 0 && percentile <= 100);
+
+    // The total is taken from the buckets rather than '_count', which may have been read at a
+    // different point of a concurrent increment.
+    uint64_t total = 0;
+    for (const auto& bucket : _buckets) {
+        total += bucket.loadRelaxed();
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint64_t rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100 * total)));
+    uint64_t seen = 0;
+    for (int i = 0; i < kMaxBuckets; ++i) {
+        seen += _buckets[i].loadRelaxed();
+        if (seen >= rank) {
+            return getBucketUpperBound(i);
+        }
+    }
+    return getBucketUpperBound(kMaxBuckets - 1);
+}
+
+void HdrLatencyHistogram::append(bool includeHistogram, BSONObjBuilder* builder) const {
+    builder->append("count", static_cast<long long>(getCount()));
+    builder->append("micros", static_cast<long long>(getSum()));
+
+    BSONObjBuilder percentilesBuilder(builder->subobjStart("percentiles"));
+    for (const auto& reported : kReportedPercentiles) {
+        percentilesBuilder.append(reported.name,
+                                  static_cast<long long>(getPercentile(reported.percentile)));
+    }
+    percentilesBuilder.doneFast();
+
+    if (includeHistogram) {
+        BSONArrayBuilder arrayBuilder(builder->subarrayStart("histogram"));
+        for (int i = 0; i < kMaxBuckets; ++i) {
+            auto count = _buckets[i].loadRelaxed();
+            if (count == 0) {
+                continue;
+            }
+
+            BSONObjBuilder entryBuilder(arrayBuilder.subobjStart());
+            entryBuilder.append("micros", static_cast<long long>(getBucketLowerBound(i)));
+            entryBuilder.append("count", static_cast<long long>(count));
+            entryBuilder.doneFast();
+        }
+        arrayBuilder.doneFast();
+    }
+}
+
+}  // namespace mongo
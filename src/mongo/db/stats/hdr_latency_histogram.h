@@ -0,0 +1,104 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+
+/**
+ * A high dynamic range histogram of latencies in microseconds. Latencies below 64 microseconds are
+ * counted exactly, and every power of two above that is split into 32 equal buckets, so the
+ * latency reported for any percentile is within about 3% of the true value. Latencies above
+ * 2^36 microseconds (about 19 hours) are counted in the last bucket.
+ *
+ * Increments are lock-free and may race with reads, so a concurrent snapshot may be missing some
+ * of the increments in flight. Histograms have the same buckets, so they merge losslessly.
+ */
+class HdrLatencyHistogram {
+public:
+    // Values below 2^kSubBucketBits get their own bucket, and each power of two above that has
+    // 2^(kSubBucketBits - 1) buckets.
+    static constexpr int kSubBucketBits = 6;
+    static constexpr int kMaxBuckets = 1024;
+
+    HdrLatencyHistogram() = default;
+    HdrLatencyHistogram(const HdrLatencyHistogram& other);
+    HdrLatencyHistogram& operator=(const HdrLatencyHistogram& other);
+
+    /**
+     * Records one operation which took 'micros' microseconds.
+     */
+    void increment(uint64_t micros);
+
+    /**
+     * Adds the counts of 'other' to this histogram.
+     */
+    void merge(const HdrLatencyHistogram& other);
+
+    uint64_t getCount() const {
+        return _count.loadRelaxed();
+    }
+
+    uint64_t getSum() const {
+        return _sum.loadRelaxed();
+    }
+
+    /**
+     * Returns the upper bound of the bucket holding the value at 'percentile', which must be in
+     * [0, 100]. Returns 0 if the histogram is empty.
+     */
+    uint64_t getPercentile(double percentile) const;
+
+    /**
+     * Appends the count, total latency and common percentiles, followed by the non-empty buckets
+     * as {micros, count} pairs if 'includeHistogram' is true.
+     */
+    void append(bool includeHistogram, BSONObjBuilder* builder) const;
+
+    static int getBucket(uint64_t micros);
+
+    // Inclusive lower bound of a bucket.
+    static uint64_t getBucketLowerBound(int bucket);
+
+    // Inclusive upper bound of a bucket.
+    static uint64_t getBucketUpperBound(int bucket);
+
+private:
+    std::array<AtomicWord<uint64_t>, kMaxBuckets> _buckets;
+    AtomicWord<uint64_t> _count;
+    AtomicWord<uint64_t> _sum;
+};
+
+}  // namespace mongo
@@ -0,0 +1,154 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+
+#include <vector>
+
+#include "mongo/db/jsobj.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+TEST(HdrLatencyHistogram, BucketBoundsCoverEveryValue) {
+    for (int i = 0; i < HdrLatencyHistogram::kMaxBuckets - 1; ++i) {
+        auto lower = HdrLatencyHistogram::getBucketLowerBound(i);
+        auto upper = HdrLatencyHistogram::getBucketUpperBound(i);
+        ASSERT_EQ(HdrLatencyHistogram::getBucket(lower), i);
+        ASSERT_EQ(HdrLatencyHistogram::getBucket(upper), i);
+        ASSERT_EQ(HdrLatencyHistogram::getBucketLowerBound(i + 1), upper + 1);
+    }
+}
+
+TEST(HdrLatencyHistogram, SmallValuesAreExact) {
+    for (uint64_t micros = 0; micros < 64; ++micros) {
+        auto bucket = HdrLatencyHistogram::getBucket(micros);
+        ASSERT_EQ(HdrLatencyHistogram::getBucketLowerBound(bucket), micros);
+        ASSERT_EQ(HdrLatencyHistogram::getBucketUpperBound(bucket), micros);
+    }
+}
+
+TEST(HdrLatencyHistogram, BucketWidthIsWithinRelativeError) {
+    for (uint64_t micros : {64ULL, 1000ULL, 12345ULL, 999999ULL, 1ULL << 30, (1ULL << 35) + 1}) {
+        auto bucket = HdrLatencyHistogram::getBucket(micros);
+        auto width = HdrLatencyHistogram::getBucketUpperBound(bucket) -
+            HdrLatencyHistogram::getBucketLowerBound(bucket) + 1;
+        ASSERT_LTE(width * 32, micros) << micros;
+    }
+}
+
+TEST(HdrLatencyHistogram, LargeValuesAreClamped) {
+    const auto last = HdrLatencyHistogram::kMaxBuckets - 1;
+    ASSERT_EQ(HdrLatencyHistogram::getBucket(1ULL << 36), last);
+    ASSERT_EQ(HdrLatencyHistogram::getBucket(std::numeric_limits<uint64_t>::max()), last);
+}
+
+TEST(HdrLatencyHistogram, Percentiles) {
+    HdrLatencyHistogram hist;
+    ASSERT_EQ(hist.getPercentile(99), 0ULL);
+
+    for (uint64_t micros = 1; micros <= 1000; ++micros) {
+        hist.increment(micros);
+    }
+    ASSERT_EQ(hist.getCount(), 1000ULL);
+    ASSERT_EQ(hist.getSum(), 500500ULL);
+
+    for (double percentile : {0.0, 50.0, 90.0, 99.0, 99.9, 100.0}) {
+        auto expected = std::max(1.0, percentile * 10);
+        auto actual = static_cast<double>(hist.getPercentile(percentile));
+        ASSERT_GTE(actual, expected) << percentile;
+        ASSERT_LTE(actual, expected * 1.04) << percentile;
+    }
+}
+
+TEST(HdrLatencyHistogram, MergeAddsCounts) {
+    HdrLatencyHistogram first, second;
+    for (int i = 0; i < 99; ++i) {
+        first.increment(10);
+    }
+    second.increment(5000);
+
+    first.merge(second);
+    ASSERT_EQ(first.getCount(), 100ULL);
+    ASSERT_EQ(first.getSum(), 99 * 10 + 5000ULL);
+    ASSERT_EQ(first.getPercentile(50), 10ULL);
+    ASSERT_GTE(first.getPercentile(100), 5000ULL);
+
+    HdrLatencyHistogram copy(first);
+    ASSERT_EQ(copy.getCount(), 100ULL);
+    ASSERT_EQ(copy.getPercentile(100), first.getPercentile(100));
+}
+
+TEST(HdrLatencyHistogram, ConcurrentIncrements) {
+    HdrLatencyHistogram hist;
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&] {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                hist.increment(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(hist.getCount(), 40000ULL);
+    ASSERT_EQ(hist.getSum(), 4 * (9999ULL * 10000 / 2));
+}
+
+TEST(HdrLatencyHistogram, Append) {
+    HdrLatencyHistogram hist;
+    hist.increment(3);
+    hist.increment(3);
+    hist.increment(100);
+
+    BSONObjBuilder builder;
+    hist.append(true, &builder);
+    BSONObj obj = builder.obj();
+    ASSERT_EQ(obj["count"].numberLong(), 3);
+    ASSERT_EQ(obj["micros"].numberLong(), 106);
+    ASSERT_EQ(obj["percentiles"]["p50"].numberLong(), 3);
+    ASSERT_GTE(obj["percentiles"]["p999"].numberLong(), 100);
+
+    auto histogram = obj["histogram"].Array();
+    ASSERT_EQ(histogram.size(), 2U);
+    ASSERT_BSONOBJ_EQ(histogram[0].Obj(), BSON("micros" << 3LL << "count" << 2LL));
+    ASSERT_EQ(histogram[1]["count"].numberLong(), 1);
+
+    BSONObjBuilder summaryBuilder;
+    hist.append(false, &summaryBuilder);
+    ASSERT_FALSE(summaryBuilder.obj().hasField("histogram"));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -32,6 +32,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/stats/command_latency_histograms.h"
 #include "mongo/db/stats/top.h"
 
 namespace mongo {
@@ -60,5 +61,29 @@ public:
         return latencyBuilder.obj();
     }
 } globalHistogramServerStatusSection;
+
+/**
+ * Appends the latency percentiles of each command and namespace to the server status.
+ */
+class CommandLatencyHistogramsServerStatusSection final : public ServerStatusSection {
+public:
+    CommandLatencyHistogramsServerStatusSection()
+        : ServerStatusSection("operationLatencyHistograms") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx, const BSONElement& configElem) const override {
+        BSONObjBuilder histogramsBuilder;
+        bool includeHistograms = false;
+        if (configElem.type() == BSONType::Object) {
+            includeHistograms = configElem.Obj()["histograms"].trueValue();
+        }
+        CommandLatencyHistograms::get(opCtx->getServiceContext())
+            .append(includeHistograms, &histogramsBuilder);
+        return histogramsBuilder.obj();
+    }
+} commandLatencyHistogramsServerStatusSection;
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,141 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include <absl/hash/hash.h>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/client.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/query_shape_stats_gen.h"
+#include "mongo/util/hex.h"
+
+namespace mongo {
+namespace {
+const auto getQueryShapeStats = ServiceContext::declareDecoration<QueryShapeStats>();
+}  // namespace
+
+QueryShapeStats& QueryShapeStats::get(ServiceContext* service) {
+    return getQueryShapeStats(service);
+}
+
+std::size_t QueryShapeStats::KeyHasher::operator()(const Key& key) const {
+    return absl::Hash<std::tuple<absl::string_view, absl::string_view, uint32_t>>{}(
+        std::make_tuple(absl::string_view(key.command),
+                        absl::string_view(key.nss.ns()),
+                        key.queryHash));
+}
+
+bool QueryShapeStats::shouldSample(OperationContext* opCtx) {
+    const double sampleRate = gQueryStatsSampleRate.load();
+    if (sampleRate <= 0) {
+        return false;
+    }
+
+    auto client = opCtx->getClient();
+    if (!client->isFromUserConnection() || client->isInDirectClient()) {
+        return false;
+    }
+    return sampleRate >= 1 || client->getPrng().nextCanonicalDouble() < sampleRate;
+}
+
+void QueryShapeStats::record(const Execution& execution, Date_t now) {
+    Key key{execution.command.toString(), execution.nss, execution.queryHash};
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    Entry* entry;
+    if (auto it = _entries.promote(key); it != _entries.end()) {
+        entry = it->second.get();
+    } else {
+        auto newEntry = std::make_unique<Entry>();
+        newEntry->command = key.command;
+        newEntry->nss = key.nss;
+        newEntry->queryHash = key.queryHash;
+        newEntry->firstSeen = now;
+        entry = newEntry.get();
+        _entries.add(key, std::move(newEntry));
+
+        const auto maxShapes = static_cast<std::size_t>(gQueryStatsMaxShapes.load());
+        while (_entries.size() > maxShapes) {
+            _entries.erase(std::prev(_entries.end()));
+        }
+    }
+
+    entry->latestPlanSummary = execution.planSummary.toString();
+    entry->lastSeen = now;
+    entry->executions++;
+    entry->docsExamined += execution.docsExamined;
+    entry->maxDocsExamined = std::max(entry->maxDocsExamined, execution.docsExamined);
+    entry->keysExamined += execution.keysExamined;
+    entry->maxKeysExamined = std::max(entry->maxKeysExamined, execution.keysExamined);
+    entry->nreturned += execution.nreturned;
+    entry->latency.increment(durationCount<Microseconds>(execution.latency));
+}
+
+std::vector<QueryShapeStats::Entry> QueryShapeStats::getSnapshot() const {
+    std::vector<Entry> entries;
+    stdx::lock_guard<Latch> lk(_mutex);
+    entries.reserve(_entries.size());
+    for (const auto& [key, entry] : _entries) {
+        entries.push_back(*entry);
+    }
+    return entries;
+}
+
+void QueryShapeStats::clear() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _entries.clear();
+}
+
+void QueryShapeStats::Entry::toBSON(BSONObjBuilder* builder) const {
+    builder->append("ns", nss.ns());
+    builder->append("command", command);
+    builder->append("queryHash", zeroPaddedHex(queryHash));
+    builder->append("planSummary", latestPlanSummary);
+    builder->append("firstSeen", firstSeen);
+    builder->append("lastSeen", lastSeen);
+    builder->append("executions", executions);
+    builder->append("docsExamined", docsExamined);
+    builder->append("maxDocsExamined", maxDocsExamined);
+    builder->append("keysExamined", keysExamined);
+    builder->append("maxKeysExamined", maxKeysExamined);
+    builder->append("nreturned", nreturned);
+
+    BSONObjBuilder latencyBuilder(builder->subobjStart("latency"));
+    latency.append(false, &latencyBuilder);
+}
+
+}  // namespace mongo
@@ -0,0 +1,134 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/stats/hdr_latency_histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/lru_cache.h"
+#include "mongo/util/time_support.h"
+
+namespace mongo {
+
+class BSONObjBuilder;
+class OperationContext;
+class ServiceContext;
+
+/**
+ * Aggregates statistics about sampled user operations by query shape, as identified by the
+ * namespace, the command and the 'queryHash' of the query. Only operations whose query has a
+ * 'queryHash' are recorded.
+ *
+ * A fraction 'queryStatsSampleRate' of the operations are recorded, and at most
+ * 'queryStatsMaxShapes' shapes are kept, evicting the least recently recorded one.
+ */
+class QueryShapeStats {
+public:
+    /**
+     * What is recorded about one execution of a query.
+     */
+    struct Execution {
+        StringData command;
+        NamespaceString nss;
+        uint32_t queryHash = 0;
+        StringData planSummary;
+        Microseconds latency{0};
+        long long docsExamined = 0;
+        long long keysExamined = 0;
+        long long nreturned = 0;
+    };
+
+    /**
+     * The statistics of one query shape.
+     */
+    struct Entry {
+        std::string command;
+        NamespaceString nss;
+        uint32_t queryHash = 0;
+        std::string latestPlanSummary;
+        Date_t firstSeen;
+        Date_t lastSeen;
+        long long executions = 0;
+        long long docsExamined = 0;
+        long long maxDocsExamined = 0;
+        long long keysExamined = 0;
+        long long maxKeysExamined = 0;
+        long long nreturned = 0;
+        HdrLatencyHistogram latency;
+
+        void toBSON(BSONObjBuilder* builder) const;
+    };
+
+    static QueryShapeStats& get(ServiceContext* service);
+
+    /**
+     * Returns true if an operation from 'opCtx' should be recorded, according to its client and
+     * the sample rate.
+     */
+    static bool shouldSample(OperationContext* opCtx);
+
+    void record(const Execution& execution, Date_t now);
+
+    /**
+     * Returns a copy of every entry, from the most to the least recently recorded.
+     */
+    std::vector<Entry> getSnapshot() const;
+
+    void clear();
+
+private:
+    struct Key {
+        std::string command;
+        NamespaceString nss;
+        uint32_t queryHash;
+
+        bool operator==(const Key& other) const {
+            return queryHash == other.queryHash && command == other.command && nss == other.nss;
+        }
+    };
+
+    struct KeyHasher {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("QueryShapeStats::_mutex");
+
+    // Entries beyond 'queryStatsMaxShapes' are evicted by record() rather than by the cache, as
+    // the parameter may change at runtime.
+    LRUCache<Key, std::unique_ptr<Entry>, KeyHasher> _entries{
+        std::numeric_limits<std::size_t>::max()};
+};
+
+}  // namespace mongo
@@ -0,0 +1,120 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/stats/query_shape_stats.h"
+
+#include "mongo/db/jsobj.h"
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const NamespaceString kNss("test.coll");
+const Date_t kNow = Date_t::fromMillisSinceEpoch(1000);
+
+QueryShapeStats::Execution makeExecution(uint32_t queryHash, long long docsExamined) {
+    QueryShapeStats::Execution execution;
+    execution.command = "find";
+    execution.nss = kNss;
+    execution.queryHash = queryHash;
+    execution.planSummary = "IXSCAN { a: 1 }";
+    execution.latency = Microseconds(100);
+    execution.docsExamined = docsExamined;
+    execution.keysExamined = docsExamined;
+    execution.nreturned = 1;
+    return execution;
+}
+
+TEST(QueryShapeStats, AggregatesExecutionsOfAShape) {
+    QueryShapeStats stats;
+    stats.record(makeExecution(1, 10), kNow);
+    stats.record(makeExecution(1, 30), kNow + Seconds(1));
+
+    auto entries = stats.getSnapshot();
+    ASSERT_EQ(entries.size(), 1U);
+    const auto& entry = entries[0];
+    ASSERT_EQ(entry.executions, 2);
+    ASSERT_EQ(entry.docsExamined, 40);
+    ASSERT_EQ(entry.maxDocsExamined, 30);
+    ASSERT_EQ(entry.keysExamined, 40);
+    ASSERT_EQ(entry.nreturned, 2);
+    ASSERT_EQ(entry.firstSeen, kNow);
+    ASSERT_EQ(entry.lastSeen, kNow + Seconds(1));
+    ASSERT_EQ(entry.latency.getCount(), 2ULL);
+    ASSERT_EQ(entry.latency.getSum(), 200ULL);
+
+    BSONObjBuilder builder;
+    entry.toBSON(&builder);
+    BSONObj obj = builder.obj();
+    ASSERT_EQ(obj["ns"].String(), kNss.ns());
+    ASSERT_EQ(obj["queryHash"].String(), "00000001");
+    ASSERT_EQ(obj["planSummary"].String(), "IXSCAN { a: 1 }");
+    ASSERT_EQ(obj["latency"]["percentiles"]["p50"].numberLong(), 100);
+}
+
+TEST(QueryShapeStats, ShapesAreKeyedByCommandNamespaceAndHash) {
+    QueryShapeStats stats;
+    stats.record(makeExecution(1, 1), kNow);
+    stats.record(makeExecution(2, 1), kNow);
+
+    auto execution = makeExecution(1, 1);
+    execution.command = "count";
+    stats.record(execution, kNow);
+
+    execution = makeExecution(1, 1);
+    execution.nss = NamespaceString("test.other");
+    stats.record(execution, kNow);
+
+    ASSERT_EQ(stats.getSnapshot().size(), 4U);
+}
+
+TEST(QueryShapeStats, EvictsTheLeastRecentlyRecordedShape) {
+    RAIIServerParameterControllerForTest maxShapes("queryStatsMaxShapes", 2);
+
+    QueryShapeStats stats;
+    stats.record(makeExecution(1, 1), kNow);
+    stats.record(makeExecution(2, 1), kNow);
+    stats.record(makeExecution(1, 1), kNow);
+    stats.record(makeExecution(3, 1), kNow);
+
+    auto entries = stats.getSnapshot();
+    ASSERT_EQ(entries.size(), 2U);
+    ASSERT_EQ(entries[0].queryHash, 3U);
+    ASSERT_EQ(entries[1].queryHash, 1U);
+    ASSERT_EQ(entries[1].executions, 2);
+
+    stats.clear();
+    ASSERT(stats.getSnapshot().empty());
+}
+
+}  // namespace
+}  // namespace mongo
@@ -33,9 +33,14 @@
 
 #include "mongo/db/storage/checkpointer.h"
 
+#include <algorithm>
+
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
@@ -48,6 +53,32 @@ const auto getCheckpointer = ServiceContext::declareDecoration<std::unique_ptr<C
 
 MONGO_FAIL_POINT_DEFINE(pauseCheckpointThread);
 
+// How often the dirty bytes in the cache are checked against checkpointDirtyBytesTrigger.
+const Milliseconds kDirtyBytesPollInterval{1000};
+
+// If the checkpointDelaySecs is set to 0, that means we should skip checkpointing. However,
+// checkpointDelaySecs is adjustable by a runtime server parameter, so we need to wake up to check
+// periodically. The wakeup to check period is arbitrary.
+const Milliseconds kDisabledPollInterval{3000};
+
+class CheckpointerServerStatusSection final : public ServerStatusSection {
+public:
+    CheckpointerServerStatusSection() : ServerStatusSection("checkpointer") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto& checkpointer = getCheckpointer(opCtx->getServiceContext())) {
+            checkpointer->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} checkpointerServerStatusSection;
+
 }  // namespace
 
 Checkpointer* Checkpointer::get(ServiceContext* serviceCtx) {
@@ -71,31 +102,21 @@ void Checkpointer::run() {
     ThreadClient tc(name(), getGlobalServiceContext());
     LOGV2_DEBUG(22307, 1, "Starting thread", "threadName"_attr = name());
 
+    {
+        stdx::unique_lock<Latch> lock(_mutex);
+        _lastCheckpointEnd = Date_t::now();
+    }
+
     while (true) {
         auto opCtx = tc->makeOperationContext();
 
+        boost::optional<CheckpointReason> reason;
         {
             stdx::unique_lock<Latch> lock(_mutex);
             MONGO_IDLE_THREAD_BLOCK;
 
-            // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds; or until either shutdown
-            // is signaled or a checkpoint is triggered.
-            _sleepCV.wait_for(lock,
-                              stdx::chrono::seconds(static_cast<std::int64_t>(
-                                  storageGlobalParams.checkpointDelaySecs)),
-                              [&] { return _shuttingDown || _triggerCheckpoint; });
-
-            // If the checkpointDelaySecs is set to 0, that means we should skip checkpointing.
-            // However, checkpointDelaySecs is adjustable by a runtime server parameter, so we
-            // need to wake up to check periodically. The wakeup to check period is arbitrary.
-            while (storageGlobalParams.checkpointDelaySecs == 0 && !_shuttingDown &&
-                   !_triggerCheckpoint) {
-                _sleepCV.wait_for(lock, stdx::chrono::seconds(static_cast<std::int64_t>(3)), [&] {
-                    return _shuttingDown || _triggerCheckpoint;
-                });
-            }
-
-            if (_shuttingDown) {
+            reason = _waitForNextCheckpoint(lock);
+            if (!reason) {
                 invariant(!_shutdownReason.isOK());
                 LOGV2_DEBUG(22309,
                             1,
@@ -111,19 +132,101 @@ void Checkpointer::run() {
 
         pauseCheckpointThread.pauseWhileSet();
 
-        const Date_t startTime = Date_t::now();
+        _checkpoint(*reason);
+    }
+}
+
+boost::optional<Checkpointer::CheckpointReason> Checkpointer::_waitForNextCheckpoint(
+    stdx::unique_lock<Latch>& lock) {
+    while (true) {
+        if (_shuttingDown) {
+            return boost::none;
+        }
+        if (_triggerCheckpoint) {
+            return CheckpointReason::kTriggered;
+        }
 
-        // TODO SERVER-50861: Access the storage engine via the ServiceContext.
-        _kvEngine->checkpoint();
+        const auto now = Date_t::now();
+        const auto delaySecs = static_cast<std::int64_t>(storageGlobalParams.checkpointDelaySecs);
+        const auto dirtyBytesTrigger = gCheckpointDirtyBytesTrigger.load();
 
-        const auto secondsElapsed = durationCount<Seconds>(Date_t::now() - startTime);
-        if (secondsElapsed >= 30) {
-            LOGV2_DEBUG(22308,
-                        1,
-                        "Checkpoint was slow to complete",
-                        "secondsElapsed"_attr = secondsElapsed);
+        Date_t wakeUp = now + kDisabledPollInterval;
+        if (delaySecs > 0) {
+            // Wait for 'storageGlobalParams.checkpointDelaySecs' seconds after the last
+            // checkpoint; or until either shutdown is signaled or a checkpoint is triggered.
+            const auto scheduled = _lastCheckpointEnd + Seconds(delaySecs);
+            if (now >= scheduled) {
+                return CheckpointReason::kScheduled;
+            }
+            wakeUp = scheduled;
+
+            if (dirtyBytesTrigger > 0) {
+                if (now >= _nextDirtyBytesCheckpointAllowed) {
+                    // Querying the storage engine may block, so do it without holding the mutex.
+                    lock.unlock();
+                    const auto dirtyBytes = _kvEngine->getCacheDirtyBytes();
+                    lock.lock();
+                    if (dirtyBytes && *dirtyBytes >= dirtyBytesTrigger && !_shuttingDown) {
+                        return CheckpointReason::kDirtyBytes;
+                    }
+                }
+                wakeUp = std::min(wakeUp,
+                                  std::max(now + kDirtyBytesPollInterval,
+                                           _nextDirtyBytesCheckpointAllowed));
+            }
         }
+
+        _sleepCV.wait_until(lock, wakeUp.toSystemTimePoint(), [&] {
+            return _shuttingDown || _triggerCheckpoint;
+        });
+    }
+}
+
+void Checkpointer::_checkpoint(CheckpointReason reason) {
+    // TODO SERVER-50861: Access the storage engine via the ServiceContext.
+    const auto dirtyBytes = _kvEngine->getCacheDirtyBytes();
+    const Date_t startTime = Date_t::now();
+
+    _kvEngine->checkpoint();
+
+    const Date_t endTime = Date_t::now();
+    const auto elapsed = endTime - startTime;
+    const auto secondsElapsed = durationCount<Seconds>(elapsed);
+    if (secondsElapsed >= 30) {
+        LOGV2_DEBUG(22308,
+                    1,
+                    "Checkpoint was slow to complete",
+                    "secondsElapsed"_attr = secondsElapsed);
+    }
+
+    switch (reason) {
+        case CheckpointReason::kScheduled:
+            _numScheduledCheckpoints.fetchAndAdd(1);
+            break;
+        case CheckpointReason::kDirtyBytes:
+            _numDirtyBytesCheckpoints.fetchAndAdd(1);
+            break;
+        case CheckpointReason::kTriggered:
+            _numTriggeredCheckpoints.fetchAndAdd(1);
+            break;
+    }
+    _durationMicros.increment(std::max<int64_t>(durationCount<Microseconds>(elapsed), 0));
+    if (dirtyBytes) {
+        _dirtyKBAtStart.increment(std::max<int64_t>(*dirtyBytes, 0) / 1024);
     }
+
+    // Space out the checkpoints taken because of the dirty bytes trigger so that writing the bytes
+    // which were dirty at the start of this one stays within the I/O budget.
+    Date_t nextDirtyBytesCheckpointAllowed = endTime;
+    const auto ioBudgetMBPerSec = gCheckpointIOBudgetMBPerSec.load();
+    if (ioBudgetMBPerSec > 0 && dirtyBytes && *dirtyBytes > 0) {
+        nextDirtyBytesCheckpointAllowed =
+            startTime + Milliseconds(*dirtyBytes * 1000 / (ioBudgetMBPerSec * 1024LL * 1024));
+    }
+
+    stdx::unique_lock<Latch> lock(_mutex);
+    _lastCheckpointEnd = endTime;
+    _nextDirtyBytesCheckpointAllowed = nextDirtyBytesCheckpointAllowed;
 }
 
 void Checkpointer::triggerFirstStableCheckpoint(Timestamp prevStable,
@@ -165,4 +268,24 @@ void Checkpointer::shutdown(const Status& reason) {
     LOGV2(22323, "Finished shutting down checkpoint thread");
 }
 
+void Checkpointer::appendStats(BSONObjBuilder* builder) const {
+    BSONObjBuilder countsBuilder(builder->subobjStart("checkpoints"));
+    countsBuilder.append("scheduled", _numScheduledCheckpoints.load());
+    countsBuilder.append("dirtyBytes", _numDirtyBytesCheckpoints.load());
+    countsBuilder.append("triggered", _numTriggeredCheckpoints.load());
+    countsBuilder.doneFast();
+
+    BSONObjBuilder durationBuilder(builder->subobjStart("duration"));
+    _durationMicros.append(false /* includeHistogram */, &durationBuilder);
+    durationBuilder.doneFast();
+
+    BSONObjBuilder dirtyBuilder(builder->subobjStart("dirtyKBAtStart"));
+    dirtyBuilder.append("count", static_cast<long long>(_dirtyKBAtStart.getCount()));
+    dirtyBuilder.append("totalKB", static_cast<long long>(_dirtyKBAtStart.getSum()));
+    dirtyBuilder.append("p50", static_cast<long long>(_dirtyKBAtStart.getPercentile(50)));
+    dirtyBuilder.append("p90", static_cast<long long>(_dirtyKBAtStart.getPercentile(90)));
+    dirtyBuilder.append("max", static_cast<long long>(_dirtyKBAtStart.getPercentile(100)));
+    dirtyBuilder.doneFast();
+}
+
 }  // namespace mongo
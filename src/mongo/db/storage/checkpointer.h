@@ -29,12 +29,18 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
+#include "mongo/db/stats/hdr_latency_histogram.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/background.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class KVEngine;
 class OperationContext;
 class ServiceContext;
@@ -60,6 +66,9 @@ public:
 
     /**
      * Starts the checkpoint thread that runs every storageGlobalParams.checkpointDelaySecs seconds.
+     * When checkpointDirtyBytesTrigger is set, the thread also takes a checkpoint as soon as the
+     * storage engine cache holds that many dirty bytes, no more often than
+     * checkpointIOBudgetMBPerSec allows for the bytes written by the previous checkpoint.
      */
     void run() override;
 
@@ -87,7 +96,25 @@ public:
      */
     void shutdown(const Status& reason);
 
+    /**
+     * Appends the number of checkpoints taken for each reason, and the distribution of their
+     * durations and of the dirty cache bytes at their start.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
+    enum class CheckpointReason { kScheduled, kDirtyBytes, kTriggered };
+
+    /**
+     * Waits until a checkpoint is due, and returns why, or returns boost::none on shutdown.
+     */
+    boost::optional<CheckpointReason> _waitForNextCheckpoint(stdx::unique_lock<Latch>& lock);
+
+    /**
+     * Takes a checkpoint and records its statistics.
+     */
+    void _checkpoint(CheckpointReason reason);
+
     // A pointer to the KVEngine is maintained only due to unit testing limitations that don't fully
     // setup the ServiceContext.
     // TODO SERVER-50861: Remove this pointer.
@@ -109,6 +136,21 @@ private:
 
     // This flag allows the checkpoint thread to wake up early when _sleepCV is signaled.
     bool _triggerCheckpoint;
+
+    // The time the last checkpoint finished, from which the checkpoint delay is counted.
+    Date_t _lastCheckpointEnd;
+
+    // Checkpoints taken because of the dirty bytes trigger are not started before this time, so
+    // that they stay within the I/O budget.
+    Date_t _nextDirtyBytesCheckpointAllowed;
+
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _numScheduledCheckpoints{0};
+    AtomicWord<long long> _numDirtyBytesCheckpoints{0};
+    AtomicWord<long long> _numTriggeredCheckpoints{0};
+    HdrLatencyHistogram _durationMicros;
+    // Kilobytes rather than bytes keep large caches within the range of the histogram.
+    HdrLatencyHistogram _dirtyKBAtStart;
 };
 
 }  // namespace mongo
@@ -34,13 +34,16 @@
 #include "mongo/db/storage/control/journal_flusher.h"
 
 #include "mongo/db/client.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/recovery_unit.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/future.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -50,6 +53,24 @@ const auto getJournalFlusher = ServiceContext::declareDecoration<std::unique_ptr
 
 MONGO_FAIL_POINT_DEFINE(pauseJournalFlusherThread);
 
+class JournalFlusherServerStatusSection final : public ServerStatusSection {
+public:
+    JournalFlusherServerStatusSection() : ServerStatusSection("journalFlusher") {}
+
+    bool includeByDefault() const override {
+        return true;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        BSONObjBuilder builder;
+        if (auto& journalFlusher = getJournalFlusher(opCtx->getServiceContext())) {
+            journalFlusher->appendStats(&builder);
+        }
+        return builder.obj();
+    }
+} journalFlusherServerStatusSection;
+
 }  // namespace
 
 JournalFlusher* JournalFlusher::get(ServiceContext* serviceCtx) {
@@ -109,7 +130,10 @@ void JournalFlusher::run() {
                 _uniqueCtx->get()->setShouldParticipateInFlowControl(false);
             });
 
+            Timer flushTimer;
             _uniqueCtx->get()->recoveryUnit()->waitUntilDurable(_uniqueCtx->get());
+            _flushMicros.fetchAndAdd(flushTimer.micros());
+            _numFlushes.fetchAndAdd(1);
 
             // Signal the waiters that a round completed.
             _currentSharedPromise->emplaceValue();
@@ -157,6 +181,23 @@ void JournalFlusher::run() {
             });
         }
 
+        // Once a flush has been requested, give other writers a chance to request it too, so that
+        // one flush makes all of their writes durable instead of each of them paying for one.
+        const auto groupCommitWindowMicros = gJournalFlusherGroupCommitWindowMicros.load();
+        if (_flushJournalNow && groupCommitWindowMicros > 0 && !_needToPause && !_shuttingDown) {
+            const auto maxWaiters = gJournalFlusherGroupCommitMaxWaiters.load();
+            Timer windowTimer;
+            _flushJournalNowCV.wait_until(
+                lk,
+                stdx::chrono::system_clock::now() +
+                    stdx::chrono::microseconds(groupCommitWindowMicros),
+                [&] {
+                    return _needToPause || _shuttingDown ||
+                        (maxWaiters > 0 && _numWaitersForNextFlush >= maxWaiters);
+                });
+            _groupCommitWaitMicros.fetchAndAdd(windowTimer.micros());
+        }
+
         if (_needToPause) {
             _state = States::Paused;
             _stateChangeCV.notify_all();
@@ -185,6 +226,12 @@ void JournalFlusher::run() {
         // Take the next promise as current and reset the next promise.
         _currentSharedPromise =
             std::exchange(_nextSharedPromise, std::make_unique<SharedPromise<void>>());
+
+        const auto numWaiters = std::exchange(_numWaitersForNextFlush, 0);
+        _numWaitersServed.fetchAndAdd(numWaiters);
+        if (numWaiters > _maxWaitersPerFlush.load()) {
+            _maxWaitersPerFlush.store(numWaiters);
+        }
     }
 }
 
@@ -251,12 +298,25 @@ void JournalFlusher::interruptJournalFlusherForReplStateChange() {
     }
 }
 
+void JournalFlusher::appendStats(BSONObjBuilder* builder) const {
+    builder->append("flushes", _numFlushes.load());
+    builder->append("waitersServed", _numWaitersServed.load());
+    builder->append("maxWaitersPerFlush", _maxWaitersPerFlush.load());
+    builder->append("flushMicros", _flushMicros.load());
+    builder->append("groupCommitWaitMicros", _groupCommitWaitMicros.load());
+}
+
 void JournalFlusher::_waitForJournalFlushNoRetry() {
     auto myFuture = [&]() {
         stdx::unique_lock<Latch> lk(_stateMutex);
+        ++_numWaitersForNextFlush;
+        const auto maxWaiters = gJournalFlusherGroupCommitMaxWaiters.load();
         if (!_flushJournalNow) {
             _flushJournalNow = true;
             _flushJournalNowCV.notify_one();
+        } else if (maxWaiters > 0 && _numWaitersForNextFlush >= maxWaiters) {
+            // End the group commit window early.
+            _flushJournalNowCV.notify_one();
         }
         return _nextSharedPromise->getFuture();
     }();
@@ -29,7 +29,9 @@
 
 #pragma once
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/background.h"
 #include "mongo/util/future.h"
@@ -121,6 +123,11 @@ public:
      */
     void interruptJournalFlusherForReplStateChange();
 
+    /**
+     * Appends the number of flushes executed and how many waiters they served.
+     */
+    void appendStats(BSONObjBuilder* builder) const;
+
 private:
     // Journal flusher internal states.
     enum class States {
@@ -159,6 +166,9 @@ private:
 
     bool _flushJournalNow = false;
     bool _needToPause = false;
+
+    // Callers of waitForJournalFlush() waiting on _nextSharedPromise.
+    int _numWaitersForNextFlush = 0;
     bool _shuttingDown = false;
     Status _shutdownReason = Status::OK();
 
@@ -170,6 +180,13 @@ private:
     std::unique_ptr<SharedPromise<void>> _nextSharedPromise =
         std::make_unique<SharedPromise<void>>();
 
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _numFlushes{0};
+    AtomicWord<long long> _numWaitersServed{0};
+    AtomicWord<long long> _maxWaitersPerFlush{0};
+    AtomicWord<long long> _flushMicros{0};
+    AtomicWord<long long> _groupCommitWaitMicros{0};
+
     // Controls whether to ignore the 'storageGlobalParams.journalCommitIntervalMs' setting. If set,
     // data flushes will only be executed upon explicit request, no longer periodically in addition
     // to upon request.
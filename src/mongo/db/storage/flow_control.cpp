@@ -56,6 +56,14 @@ MONGO_FAIL_POINT_DEFINE(flowControlTicketOverride);
 namespace {
 const auto getFlowControl = ServiceContext::declareDecoration<std::unique_ptr<FlowControl>>();
 
+// Bounds the lag accumulated by the applier rate model, so that a long lagged period does not keep
+// throttling the primary long after the lag is gone.
+constexpr double kMaxControllerIntegral = 10.0;
+
+// While the lag shrinks fast, the applier rate model may admit more than the predicted sustainer
+// rate, up to this factor.
+constexpr double kMaxAdmissionFactor = 1.5;
+
 int multiplyWithOverflowCheck(double term1, double term2, int maxValue) {
     if (term1 == 0.0 || term2 == 0.0) {
         // Early return to avoid any divide by zero errors.
@@ -222,6 +230,17 @@ BSONObj FlowControl::generateSection(OperationContext* opCtx,
     bob.append("isLaggedCount", _isLaggedCount.load());
     bob.append("isLaggedTimeMicros", _isLaggedTimeMicros.load());
 
+    // The state of the applier rate model is reported on every sample so that FTDC traces how the
+    // controller reacts each second. The ratios are scaled like locksPerKiloOp.
+    BSONObjBuilder modelBuilder(bob.subobjStart("applierRateModel"));
+    modelBuilder.append("enabled", gFlowControlUseApplierRateModel.load());
+    modelBuilder.append("predictedSustainerRate",
+                        static_cast<long long>(std::max(_predictedSustainerRate.load(), 0.0)));
+    modelBuilder.append("lagErrorPerKilo", _lastControllerError.load() * 1000);
+    modelBuilder.append("lagErrorIntegralPerKilo", _controllerIntegral.load() * 1000);
+    modelBuilder.append("admissionFactorPerKilo", _lastAdmissionFactor.load() * 1000);
+    modelBuilder.doneFast();
+
     return bob.obj();
 }
 
@@ -244,13 +263,9 @@ void FlowControl::_updateTopologyData() {
               });
 }
 
-int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
-                                            const std::vector<repl::MemberData>& currMemberData,
-                                            std::int64_t locksUsedLastPeriod,
-                                            double locksPerOp,
-                                            std::uint64_t lagMillis,
-                                            std::uint64_t thresholdLagMillis) {
-    invariant(lagMillis >= thresholdLagMillis);
+std::int64_t FlowControl::_getSustainerAppliedCount(
+    const std::vector<repl::MemberData>& prevMemberData,
+    const std::vector<repl::MemberData>& currMemberData) {
     using namespace fmt::literals;
 
     const auto currSustainerAppliedTs = getMedianAppliedTimestamp(currMemberData);
@@ -285,6 +300,19 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     }
 
     _lastSustainerAppliedCount.store(static_cast<int>(sustainerAppliedCount));
+    return sustainerAppliedCount;
+}
+
+int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>& prevMemberData,
+                                            const std::vector<repl::MemberData>& currMemberData,
+                                            std::int64_t locksUsedLastPeriod,
+                                            double locksPerOp,
+                                            std::uint64_t lagMillis,
+                                            std::uint64_t thresholdLagMillis) {
+    invariant(lagMillis >= thresholdLagMillis);
+
+    const std::int64_t sustainerAppliedCount =
+        _getSustainerAppliedCount(prevMemberData, currMemberData);
     if (sustainerAppliedCount == -1) {
         // We don't know how many ops the sustainer applied. Hand out less tickets than were
         // used in the last period.
@@ -326,6 +354,72 @@ int FlowControl::_calculateNewTicketsForLag(const std::vector<repl::MemberData>&
     return multiplyWithOverflowCheck(locksPerOp, sustainerAppliedPenalty, kMaxTickets);
 }
 
+int FlowControl::_calculateNewTicketsFromApplierModel(
+    const std::vector<repl::MemberData>& prevMemberData,
+    const std::vector<repl::MemberData>& currMemberData,
+    std::int64_t locksUsedLastPeriod,
+    double locksPerOp,
+    std::uint64_t lagMillis,
+    std::uint64_t thresholdLagMillis) {
+    invariant(lagMillis >= thresholdLagMillis);
+
+    const std::int64_t sustainerAppliedCount =
+        _getSustainerAppliedCount(prevMemberData, currMemberData);
+    if (sustainerAppliedCount == -1) {
+        // We don't know how many ops the sustainer applied. Hand out less tickets than were
+        // used in the last period.
+        return std::min(static_cast<int>(locksUsedLastPeriod / 2.0), kMaxTickets);
+    }
+
+    // Secondaries report their progress through replSetUpdatePosition, so the sustainer's progress
+    // over a period is a noisy measure of how fast it can apply. Smooth it into a prediction of the
+    // next period.
+    const double smoothing = gFlowControlApplierRateSmoothing.load();
+    double predictedRate = _predictedSustainerRate.load();
+    predictedRate = predictedRate < 0.0
+        ? sustainerAppliedCount
+        : smoothing * sustainerAppliedCount + (1.0 - smoothing) * predictedRate;
+    _predictedSustainerRate.store(predictedRate);
+
+    // The error is the lag beyond the threshold, relative to the threshold. Admitting the predicted
+    // rate keeps the lag where it is, so the controller admits less in proportion to the error, to
+    // the error accumulated while lagged, and to how fast the error grows.
+    const double error = static_cast<double>(lagMillis - thresholdLagMillis) /
+        static_cast<double>(std::max(thresholdLagMillis, static_cast<std::uint64_t>(1)));
+    const double integral = std::min(_controllerIntegral.load() + error, kMaxControllerIntegral);
+    const double derivative = _hasLastControllerError ? error - _lastControllerError.load() : 0.0;
+    _controllerIntegral.store(integral);
+    _lastControllerError.store(error);
+    _hasLastControllerError = true;
+
+    const double output = gFlowControlProportionalGain.load() * error +
+        gFlowControlIntegralGain.load() * integral + gFlowControlDerivativeGain.load() * derivative;
+    const double admissionFactor = std::clamp(1.0 - output, 0.0, kMaxAdmissionFactor);
+    _lastAdmissionFactor.store(admissionFactor);
+
+    LOGV2_DEBUG(5963013,
+                DEBUG_LOG_LEVEL,
+                "Flow control applier rate model",
+                "sustainerAppliedCount"_attr = sustainerAppliedCount,
+                "predictedSustainerRate"_attr = predictedRate,
+                "lagMillis"_attr = lagMillis,
+                "thresholdLagMillis"_attr = thresholdLagMillis,
+                "error"_attr = error,
+                "integral"_attr = integral,
+                "derivative"_attr = derivative,
+                "admissionFactor"_attr = admissionFactor);
+
+    return multiplyWithOverflowCheck(locksPerOp, predictedRate * admissionFactor, kMaxTickets);
+}
+
+void FlowControl::_resetApplierModel() {
+    _predictedSustainerRate.store(-1.0);
+    _lastControllerError.store(0.0);
+    _controllerIntegral.store(0.0);
+    _lastAdmissionFactor.store(1.0);
+    _hasLastControllerError = false;
+}
+
 int FlowControl::getNumTickets(Date_t now) {
     // Flow control can be disabled until a certain deadline is passed.
     const Date_t disabledUntil = _disableUntil.load();
@@ -383,6 +477,7 @@ int FlowControl::getNumTickets(Date_t now) {
                                         gFlowControlTicketMultiplierConstant.load(),
                                         kMaxTickets);
         _lastTimeSustainerAdvanced = Date_t::now();
+        _resetApplierModel();
         if (_isLagged.load()) {
             _isLagged.store(false);
             auto waitTime = curTimeMicros64() - _startWaitTime;
@@ -391,13 +486,22 @@ int FlowControl::getNumTickets(Date_t now) {
     } else if (!ignoreWallTimes && sustainerAdvanced(_prevMemberData, _currMemberData)) {
         // Expected case where flow control has meaningful data from the last period to make a new
         // calculation.
-        ret =
-            _calculateNewTicketsForLag(_prevMemberData,
-                                       _currMemberData,
-                                       locksUsedLastPeriod,
-                                       locksPerOp,
-                                       getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime),
-                                       thresholdLagMillis);
+        const auto lagMillis = getLagMillis(myLastApplied.wallTime, lastCommitted.wallTime);
+        if (gFlowControlUseApplierRateModel.load()) {
+            ret = _calculateNewTicketsFromApplierModel(_prevMemberData,
+                                                       _currMemberData,
+                                                       locksUsedLastPeriod,
+                                                       locksPerOp,
+                                                       lagMillis,
+                                                       thresholdLagMillis);
+        } else {
+            ret = _calculateNewTicketsForLag(_prevMemberData,
+                                             _currMemberData,
+                                             locksUsedLastPeriod,
+                                             locksPerOp,
+                                             lagMillis,
+                                             thresholdLagMillis);
+        }
         if (!_isLagged.load()) {
             _isLagged.store(true);
             _isLaggedCount.fetchAndAddRelaxed(1);
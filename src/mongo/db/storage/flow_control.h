@@ -132,6 +132,20 @@ public:
                                    double locksPerOp,
                                    std::uint64_t lagMillis,
                                    std::uint64_t thresholdLagMillis);
+
+    /**
+     * Alternative to `_calculateNewTicketsForLag` used when `flowControlUseApplierRateModel` is
+     * set. Predicts the number of operations the sustainer applies per period from its progress
+     * over the recent periods, and admits that many operations scaled down by a PID controller
+     * whose error is the lag beyond the threshold.
+     */
+    int _calculateNewTicketsFromApplierModel(const std::vector<repl::MemberData>& prevMemberData,
+                                             const std::vector<repl::MemberData>& currMemberData,
+                                             std::int64_t locksUsedLastPeriod,
+                                             double locksPerOp,
+                                             std::uint64_t lagMillis,
+                                             std::uint64_t thresholdLagMillis);
+    void _resetApplierModel();
     void _trimSamples(const Timestamp trimSamplesTo);
 
     // Sample of (timestamp, ops, lock acquisitions) where ops and lock acquisitions are
@@ -142,6 +156,13 @@ public:
     }
 
 private:
+    /**
+     * Returns the number of operations the sustainer applied between the two observations, or -1
+     * if it is unknown, and warns if the sustainer has not moved for too long.
+     */
+    std::int64_t _getSustainerAppliedCount(const std::vector<repl::MemberData>& prevMemberData,
+                                           const std::vector<repl::MemberData>& currMemberData);
+
     repl::ReplicationCoordinator* _replCoord;
 
     // These values are updated with each flow control computation and are also surfaced in server
@@ -155,6 +176,14 @@ private:
     AtomicWord<std::int64_t> _isLaggedTimeMicros{0};
     AtomicWord<Date_t> _disableUntil;
 
+    // State of the applier rate model, which is reset whenever the replica set is not lagged. The
+    // predicted rate is negative until the sustainer has been observed.
+    AtomicWord<double> _predictedSustainerRate{-1.0};
+    AtomicWord<double> _lastControllerError{0.0};
+    AtomicWord<double> _controllerIntegral{0.0};
+    AtomicWord<double> _lastAdmissionFactor{1.0};
+    bool _hasLastControllerError = false;
+
     mutable Mutex _sampledOpsMutex = MONGO_MAKE_LATCH("FlowControl::_sampledOpsMutex");
     std::deque<Sample> _sampledOpsApplied;
 
@@ -266,6 +266,74 @@ TEST_F(FlowControlTest, CalculatingTickets) {
                                                       thresholdLag));
 }
 
+TEST_F(FlowControlTest, CalculatingTicketsFromApplierModel) {
+    gFlowControlApplierRateSmoothing.store(0.5);
+    gFlowControlProportionalGain.store(0.5);
+    gFlowControlIntegralGain.store(0.125);
+    gFlowControlDerivativeGain.store(0.25);
+
+    auto constructMemberData = [](Timestamp ts) -> repl::MemberData {
+        repl::MemberData ret;
+        ret.setLastAppliedOpTimeAndWallTime({{ts, 1}, Date_t()}, Date_t());
+        return ret;
+    };
+    auto constructTopology = [&](Timestamp secondaries, Timestamp primary) {
+        std::vector<repl::MemberData> memberData;
+        memberData.emplace_back(constructMemberData(secondaries));
+        memberData.emplace_back(constructMemberData(secondaries));
+        memberData.emplace_back(constructMemberData(primary));
+        return memberData;
+    };
+
+    // Construct samples where Timestamp X maps to operation number X.
+    for (int ts = 1; ts <= 5000; ++ts) {
+        flowControl->sample(Timestamp(ts), 1);
+    }
+
+    const std::int64_t locksUsedLastPeriod = -1;  // Irrelevant to this call.
+    const double locksPerOp = 2.0;
+    const std::uint64_t thresholdLag = 1000;
+
+    // The sustainer applies 1,000 operations in the first period. At the threshold lag the
+    // controller has no error, so the primary admits the predicted rate of 1,000 operations.
+    ASSERT_EQ(2000,
+              flowControl->_calculateNewTicketsFromApplierModel(
+                  constructTopology(Timestamp(1000), Timestamp(3000)),
+                  constructTopology(Timestamp(2000), Timestamp(3000)),
+                  locksUsedLastPeriod,
+                  locksPerOp,
+                  thresholdLag,
+                  thresholdLag));
+
+    // The sustainer applies 3,000 operations in the next period, which the prediction smooths to
+    // 2,000. The lag doubles, for an error of 1, an accumulated error of 1 and an error growth of
+    // 1, so the primary admits 1 - (0.5 + 0.125 + 0.25) = 0.125 of the predicted rate.
+    ASSERT_EQ(500,
+              flowControl->_calculateNewTicketsFromApplierModel(
+                  constructTopology(Timestamp(2000), Timestamp(5000)),
+                  constructTopology(Timestamp(5000), Timestamp(5000)),
+                  locksUsedLastPeriod,
+                  locksPerOp,
+                  2 * thresholdLag,
+                  thresholdLag));
+
+    auto section = flowControl->generateSection(opCtx.get(), BSONElement());
+    auto model = section.getObjectField("applierRateModel");
+    ASSERT_EQ(2000, model.getIntField("predictedSustainerRate")) << section;
+    ASSERT_EQ(125.0, model.getField("admissionFactorPerKilo").numberDouble()) << section;
+
+    // Once reset, the prediction starts over from the next period.
+    flowControl->_resetApplierModel();
+    ASSERT_EQ(6000,
+              flowControl->_calculateNewTicketsFromApplierModel(
+                  constructTopology(Timestamp(2000), Timestamp(5000)),
+                  constructTopology(Timestamp(5000), Timestamp(5000)),
+                  locksUsedLastPeriod,
+                  locksPerOp,
+                  thresholdLag,
+                  thresholdLag));
+}
+
 TEST_F(FlowControlTest, DisableUntil) {
     const int ticketOverride = 52319;
 
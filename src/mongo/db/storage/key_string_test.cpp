@@ -798,6 +798,32 @@ TEST_F(KeyStringBuilderTest, DiscardIfNotReleased) {
     }
 }
 
+TEST_F(KeyStringBuilderTest, PooledBuilderReusesReleasedBlock) {
+    SharedBufferFragmentBuilder fragmentBuilder(1024);
+    const char* firstBuffer;
+    {
+        KeyString::PooledBuilder pooledBuilder(
+            fragmentBuilder, version, BSON("" << 1), ALL_ASCENDING);
+        KeyString::Value value = pooledBuilder.release();
+        firstBuffer = value.getBuffer();
+
+        // While 'value' is alive the next key goes after it in the same block.
+        KeyString::PooledBuilder otherBuilder(
+            fragmentBuilder, version, BSON("" << 2), ALL_ASCENDING);
+        KeyString::Value other = otherBuilder.release();
+        ASSERT_GT(other.getBuffer(), firstBuffer);
+        ASSERT_LT(other.getBuffer(), firstBuffer + 1024);
+    }
+
+    // Once every key built in the block is gone, the block is rewound instead of replaced.
+    KeyString::PooledBuilder pooledBuilder(fragmentBuilder, version, BSON("" << 3), ALL_ASCENDING);
+    KeyString::Value value = pooledBuilder.release();
+    ASSERT_EQ(firstBuffer, value.getBuffer());
+    ASSERT_EQ(0,
+              value.compare(
+                  KeyString::Builder(version, BSON("" << 3), ALL_ASCENDING).getValueCopy()));
+}
+
 TEST_F(KeyStringBuilderTest, LotsOfNumbers1) {
     for (int i = 0; i < 64; i++) {
         int64_t x = 1LL << i;
@@ -401,6 +401,23 @@ public:
         MONGO_UNREACHABLE
     }
 
+    /**
+     * Returns the fraction of the storage engine cache which holds dirty data, or boost::none if
+     * the engine does not track it. Background writers can use it to back off when eviction falls
+     * behind.
+     */
+    virtual boost::optional<double> getCacheDirtyFraction() const {
+        return boost::none;
+    }
+
+    /**
+     * Returns the number of bytes of dirty data in the storage engine cache, or boost::none if the
+     * engine does not track it.
+     */
+    virtual boost::optional<int64_t> getCacheDirtyBytes() const {
+        return boost::none;
+    }
+
     /**
      * The destructor will never be called from mongod, but may be called from tests.
      * Engines may assume that this will only be called in the case of clean shutdown, even if
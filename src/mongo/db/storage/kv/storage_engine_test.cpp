@@ -48,6 +48,7 @@
 #include "mongo/db/storage/storage_engine_impl.h"
 #include "mongo/db/storage/storage_engine_test_fixture.h"
 #include "mongo/db/storage/storage_repair_observer.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/periodic_runner_factory.h"
@@ -162,6 +163,7 @@ TEST_F(StorageEngineTest, ReconcileKeepsTemporary) {
 }
 
 TEST_F(StorageEngineTest, TemporaryDropsItself) {
+    RAIIServerParameterControllerForTest poolSize{"temporaryRecordStorePoolSize", 0};
     auto opCtx = cc().makeOperationContext();
 
     Lock::GlobalLock lk(&*opCtx, MODE_IS);
@@ -181,6 +183,47 @@ TEST_F(StorageEngineTest, TemporaryDropsItself) {
     ASSERT(!identExists(opCtx.get(), ident));
 }
 
+TEST_F(StorageEngineTest, TemporaryReturnsToPool) {
+    RAIIServerParameterControllerForTest poolSize{"temporaryRecordStorePoolSize", 1};
+    auto opCtx = cc().makeOperationContext();
+
+    Lock::GlobalLock lk(&*opCtx, MODE_IS);
+
+    auto first = makeTemporary(opCtx.get());
+    auto second = makeTemporary(opCtx.get());
+    const std::string firstIdent = first->rs()->getIdent();
+    const std::string secondIdent = second->rs()->getIdent();
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(first->rs()->insertRecord(opCtx.get(), "abc", 4, Timestamp()).getStatus());
+        wuow.commit();
+    }
+    opCtx->recoveryUnit()->abandonSnapshot();
+
+    // The first record store fills the pool, so the second one is dropped.
+    first->finalizeTemporaryTable(opCtx.get(), TemporaryRecordStore::FinalizationAction::kDelete);
+    second->finalizeTemporaryTable(opCtx.get(),
+                                   TemporaryRecordStore::FinalizationAction::kDelete);
+    ASSERT(identExists(opCtx.get(), firstIdent));
+    ASSERT(!identExists(opCtx.get(), secondIdent));
+
+    // The next temporary record store reuses the pooled one, which was emptied.
+    auto reused = makeTemporary(opCtx.get());
+    ASSERT_EQ(firstIdent, reused->rs()->getIdent());
+    ASSERT_EQ(0, reused->rs()->numRecords(opCtx.get()));
+    ASSERT(!reused->rs()->getCursor(opCtx.get())->next());
+    opCtx->recoveryUnit()->abandonSnapshot();
+
+    // A storage transaction left open by the caller is not committed to empty the record store.
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        reused->finalizeTemporaryTable(opCtx.get(),
+                                       TemporaryRecordStore::FinalizationAction::kDelete);
+        wuow.commit();
+    }
+    ASSERT(!identExists(opCtx.get(), firstIdent));
+}
+
 TEST_F(StorageEngineTest, ReconcileUnfinishedIndex) {
     auto opCtx = cc().makeOperationContext();
 
@@ -405,6 +448,32 @@ TEST_F(StorageEngineRepairTest, LoadCatalogRecoversOrphansInCatalog) {
     ASSERT_EQ(1U, StorageRepairObserver::get(getGlobalServiceContext())->getModifications().size());
 }
 
+TEST_F(StorageEngineTest, LoadCatalogOpensCollectionsInParallel) {
+    RAIIServerParameterControllerForTest threads{"storageEngineCatalogLoadThreads", 4};
+    auto opCtx = cc().makeOperationContext();
+
+    // Enough collections for the catalog to be opened on all four threads.
+    std::vector<NamespaceString> namespaces;
+    for (int i = 0; i < 400; ++i) {
+        namespaces.emplace_back("db.coll" + std::to_string(i));
+        ASSERT_OK(createCollection(opCtx.get(), namespaces.back()).getStatus());
+    }
+
+    {
+        Lock::GlobalWrite writeLock(opCtx.get(), Date_t::max(), Lock::InterruptBehavior::kThrow);
+        _storageEngine->closeCatalog(opCtx.get());
+        auto loadingFromUncleanShutdown = false;
+        _storageEngine->loadCatalog(opCtx.get(), loadingFromUncleanShutdown);
+    }
+
+    auto catalog = CollectionCatalog::get(opCtx.get());
+    for (const auto& nss : namespaces) {
+        auto coll = catalog->lookupCollectionByNamespace(opCtx.get(), nss);
+        ASSERT(coll) << nss;
+        ASSERT(coll->getRecordStore());
+    }
+}
+
 TEST_F(StorageEngineTest, LoadCatalogDropsOrphans) {
     auto opCtx = cc().makeOperationContext();
 
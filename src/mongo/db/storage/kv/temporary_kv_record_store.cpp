@@ -33,14 +33,69 @@
 
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
 
+#include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/db/storage/kv/kv_engine.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
 
+std::unique_ptr<RecordStore> TemporaryKVRecordStorePool::take() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_recordStores.empty()) {
+        return nullptr;
+    }
+
+    auto rs = std::move(_recordStores.back());
+    _recordStores.pop_back();
+    return rs;
+}
+
+bool TemporaryKVRecordStorePool::release(OperationContext* opCtx,
+                                         std::unique_ptr<RecordStore>& rs) {
+    const auto poolSize = static_cast<size_t>(gTemporaryRecordStorePoolSize.load());
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_recordStores.size() >= poolSize) {
+            return false;
+        }
+    }
+
+    // Only truncate when the caller has no storage transaction open, which committing the
+    // truncate would also end.
+    if (opCtx->lockState()->inAWriteUnitOfWork() || opCtx->recoveryUnit()->isActive()) {
+        return false;
+    }
+
+    try {
+        WriteUnitOfWork wuow(opCtx);
+        if (!rs->truncate(opCtx).isOK()) {
+            return false;
+        }
+        wuow.commit();
+    } catch (const WriteConflictException&) {
+        return false;
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_recordStores.size() >= poolSize) {
+        return false;
+    }
+    _recordStores.push_back(std::move(rs));
+    return true;
+}
+
+std::vector<std::unique_ptr<RecordStore>> TemporaryKVRecordStorePool::releaseAll() {
+    std::vector<std::unique_ptr<RecordStore>> recordStores;
+    stdx::lock_guard<Latch> lk(_mutex);
+    recordStores.swap(_recordStores);
+    return recordStores;
+}
+
 TemporaryKVRecordStore::~TemporaryKVRecordStore() {
     invariant(_recordStoreHasBeenFinalized);
 }
@@ -65,6 +120,13 @@ void TemporaryKVRecordStore::finalizeTemporaryTable(OperationContext* opCtx,
     // destructed while we're using it.
     invariant(opCtx->lockState()->isReadLocked());
 
+    const auto ident = _rs->getIdent();
+    if (_pool && _pool->release(opCtx, _rs)) {
+        LOGV2_DEBUG(
+            5963020, 1, "Returned temporary record store to the pool", "ident"_attr = ident);
+        return;
+    }
+
     auto status = _kvEngine->dropIdent(opCtx->recoveryUnit(), _rs->getIdent());
 
     if (!status.isOK()) {
@@ -29,21 +29,59 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/temporary_record_store.h"
+#include "mongo/platform/mutex.h"
 
 namespace mongo {
 
 class KVEngine;
 class OperationContext;
 
+/**
+ * Keeps empty temporary RecordStores for reuse, so that making a temporary RecordStore does not
+ * always create a table in the KVEngine, nor finalizing one drop it.
+ */
+class TemporaryKVRecordStorePool {
+public:
+    /**
+     * Returns an empty RecordStore from the pool, or nullptr if the pool is empty.
+     */
+    std::unique_ptr<RecordStore> take();
+
+    /**
+     * Truncates 'rs' and takes it into the pool. Returns false, leaving 'rs' to the caller, if the
+     * pool already holds 'temporaryRecordStorePoolSize' RecordStores, or if 'rs' cannot be
+     * truncated without committing the storage transaction of 'opCtx'.
+     */
+    bool release(OperationContext* opCtx, std::unique_ptr<RecordStore>& rs);
+
+    /**
+     * Empties the pool and returns the RecordStores it held.
+     */
+    std::vector<std::unique_ptr<RecordStore>> releaseAll();
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("TemporaryKVRecordStorePool::_mutex");
+    std::vector<std::unique_ptr<RecordStore>> _recordStores;
+};
+
 /**
  * Implementation of TemporaryRecordStore that manages a temporary RecordStore on a KVEngine.
  */
 class TemporaryKVRecordStore : public TemporaryRecordStore {
 public:
-    TemporaryKVRecordStore(KVEngine* kvEngine, std::unique_ptr<RecordStore> rs)
-        : TemporaryRecordStore(std::move(rs)), _kvEngine(kvEngine){};
+    /**
+     * When 'pool' is given, finalizing with kDelete returns the RecordStore to it when it can
+     * instead of dropping it.
+     */
+    TemporaryKVRecordStore(KVEngine* kvEngine,
+                           std::unique_ptr<RecordStore> rs,
+                           TemporaryKVRecordStorePool* pool = nullptr)
+        : TemporaryRecordStore(std::move(rs)), _kvEngine(kvEngine), _pool(pool){};
 
     // Not copyable.
     TemporaryKVRecordStore(const TemporaryKVRecordStore&) = delete;
@@ -51,7 +89,9 @@ public:
 
     // Move constructor.
     TemporaryKVRecordStore(TemporaryKVRecordStore&& other) noexcept
-        : TemporaryRecordStore(std::move(other._rs)), _kvEngine(other._kvEngine) {}
+        : TemporaryRecordStore(std::move(other._rs)),
+          _kvEngine(other._kvEngine),
+          _pool(other._pool) {}
 
     ~TemporaryKVRecordStore();
 
@@ -64,6 +104,7 @@ public:
 
 private:
     KVEngine* _kvEngine;
+    TemporaryKVRecordStorePool* _pool;
     bool _recordStoreHasBeenFinalized = false;
 };
 
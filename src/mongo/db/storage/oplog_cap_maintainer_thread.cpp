@@ -36,6 +36,7 @@
 #include "mongo/base/error_codes.h"
 #include "mongo/base/string_data.h"
 #include "mongo/db/catalog_raii.h"
+#include "mongo/db/change_stream_pre_images_collection.h"
 #include "mongo/db/client.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
@@ -65,20 +66,36 @@ bool OplogCapMaintainerThread::_deleteExcessDocuments() {
     opCtx->setShouldParticipateInFlowControl(false);
 
     try {
-        // A Global IX lock should be good enough to protect the oplog truncation from
-        // interruptions such as restartCatalog. PBWM, database lock or collection lock is not
-        // needed. This improves concurrency if oplog truncation takes long time.
-        AutoGetOplog oplogWrite(opCtx.get(), OplogAccessMode::kWrite);
-        const auto& oplog = oplogWrite.getCollection();
-        if (!oplog) {
-            LOGV2_DEBUG(4562600, 2, "oplog collection does not exist");
-            return false;
+        boost::optional<Timestamp> earliestOplogTimestamp;
+        {
+            // A Global IX lock should be good enough to protect the oplog truncation from
+            // interruptions such as restartCatalog. PBWM, database lock or collection lock is not
+            // needed. This improves concurrency if oplog truncation takes long time.
+            AutoGetOplog oplogWrite(opCtx.get(), OplogAccessMode::kWrite);
+            const auto& oplog = oplogWrite.getCollection();
+            if (!oplog) {
+                LOGV2_DEBUG(4562600, 2, "oplog collection does not exist");
+                return false;
+            }
+            auto rs = oplog->getRecordStore();
+            if (!rs->yieldAndAwaitOplogDeletionRequest(opCtx.get())) {
+                return false;  // Oplog went away.
+            }
+            rs->reclaimOplog(opCtx.get());
+
+            auto swEarliestOplogTimestamp = rs->getEarliestOplogTimestamp(opCtx.get());
+            if (swEarliestOplogTimestamp.isOK()) {
+                earliestOplogTimestamp = swEarliestOplogTimestamp.getValue();
+            }
         }
-        auto rs = oplog->getRecordStore();
-        if (!rs->yieldAndAwaitOplogDeletionRequest(opCtx.get())) {
-            return false;  // Oplog went away.
+
+        // Pre-images are only needed for as long as the oplog entries they belong to, so remove
+        // the pre-images of the entries that were just truncated. This is done after releasing the
+        // oplog so that writers are not blocked by the removal.
+        if (earliestOplogTimestamp) {
+            change_stream_pre_images::truncatePreImagesOlderThan(opCtx.get(),
+                                                                 *earliestOplogTimestamp);
         }
-        rs->reclaimOplog(opCtx.get());
     } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
         return false;
     } catch (const std::exception& e) {
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <functional>
 
 #include "mongo/base/owned_pointer_vector.h"
 #include "mongo/bson/mutable/damage_vector.h"
@@ -38,6 +39,7 @@
 #include "mongo/db/record_id.h"
 #include "mongo/db/storage/ident.h"
 #include "mongo/db/storage/record_data.h"
+#include "mongo/util/duration.h"
 
 namespace mongo {
 
@@ -122,6 +124,33 @@ public:
      */
     virtual boost::optional<Record> next() = 0;
 
+    /**
+     * Moves forward through up to 'maxRecords' records, passing each one to 'consumer', and
+     * returns the number of records passed. Stops early at EOF or once 'consumer' returns false.
+     * Returns 0 once the cursor has reached EOF.
+     *
+     * The data of each record is only valid during the call to 'consumer' that receives it, since
+     * moving the cursor forward may release it. Consumers that need it afterwards must copy it.
+     *
+     * Behaves like calling next() repeatedly. Storage engines may override it to pay the cost of
+     * setting up a read once per batch instead of once per record.
+     */
+    virtual size_t nextBatch(size_t maxRecords,
+                             const std::function<bool(const Record&)>& consumer) {
+        size_t numRecords = 0;
+        while (numRecords < maxRecords) {
+            auto record = next();
+            if (!record) {
+                break;
+            }
+            ++numRecords;
+            if (!consumer(*record)) {
+                break;
+            }
+        }
+        return numRecords;
+    }
+
     //
     // Saving and restoring state
     //
@@ -476,9 +505,13 @@ public:
     /**
      * Attempt to reduce the storage space used by this RecordStore.
      *
+     * If 'timeLimit' is set, gives up after running for about that long and returns
+     * ErrorCodes::ExceededTimeLimit. The space reclaimed so far is kept, so compacting again
+     * continues where this call left off. Only set when supportsOnlineCompaction() returns true.
+     *
      * Only called if compactSupported() returns true.
      */
-    virtual Status compact(OperationContext* opCtx) {
+    virtual Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) {
         MONGO_UNREACHABLE;
     }
 
@@ -406,6 +406,50 @@ TEST(RecordStoreTestHarness, Cursor1) {
     }
 }
 
+TEST(RecordStoreTestHarness, InsertRecordsAssignsAscendingIds) {
+    const int N = 100;
+
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+    if (rs->keyFormat() != KeyFormat::Long) {
+        return;
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    // Insert one record on its own, then a batch.
+    std::vector<std::string> data;
+    std::vector<Record> records;
+    for (int i = 0; i < N; i++) {
+        data.push_back(str::stream() << "eliot" << i);
+    }
+    for (const auto& s : data) {
+        records.push_back({RecordId(), RecordData(s.c_str(), s.size() + 1)});
+    }
+    RecordId first;
+    {
+        WriteUnitOfWork uow(opCtx.get());
+        first = unittest::assertGet(rs->insertRecord(opCtx.get(), "first", 6, Timestamp()));
+        std::vector<Timestamp> timestamps(N, Timestamp());
+        ASSERT_OK(rs->insertRecords(opCtx.get(), &records, timestamps));
+        uow.commit();
+    }
+    ASSERT_EQUALS(N + 1, rs->numRecords(opCtx.get()));
+
+    auto cursor = rs->getCursor(opCtx.get());
+    auto record = cursor->next();
+    ASSERT(record);
+    ASSERT_EQUALS(first, record->id);
+    for (int i = 0; i < N; i++) {
+        record = cursor->next();
+        ASSERT(record);
+        ASSERT_EQUALS(records[i].id, record->id);
+        ASSERT_GT(record->id, i == 0 ? first : records[i - 1].id);
+        ASSERT_EQUALS(data[i], record->data.data());
+    }
+    ASSERT(!cursor->next());
+}
+
 TEST(RecordStoreTestHarness, ClusteredRecordStore) {
     const auto harnessHelper = newRecordStoreHarnessHelper();
     if (!harnessHelper->getEngine()->supportsClusteredIdIndex()) {
@@ -479,5 +479,58 @@ TEST(RecordStoreTestHarness, SeekExactForMissingRecordReturnsNone) {
     ASSERT_FALSE(recordStore->findRecord(opCtx.get(), recordIds[1], &outputData));
 }
 
+// Insert multiple records and read them back with nextBatch(), checking that each batch is bounded
+// by 'maxRecords', that a consumer returning false stops the batch early, and that a batch
+// positioned at EOF is empty.
+TEST(RecordStoreTestHarness, IterateInBatches) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore());
+
+    const int nToInsert = 10;
+    RecordId locs[nToInsert];
+    std::string datas[nToInsert];
+    for (int i = 0; i < nToInsert; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        stringstream ss;
+        ss << "record " << i;
+        string data = ss.str();
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        locs[i] = res.getValue();
+        datas[i] = data;
+        uow.commit();
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        int i = 0;
+        auto consumer = [&](const Record& record) {
+            ASSERT_EQUALS(locs[i], record.id);
+            ASSERT_EQUALS(datas[i], record.data.data());
+            i++;
+            return true;
+        };
+
+        ASSERT_EQUALS(4U, cursor->nextBatch(4, consumer));
+        ASSERT_EQUALS(4, i);
+
+        // The record that stops the batch is consumed and counted.
+        ASSERT_EQUALS(1U, cursor->nextBatch(4, [&](const Record& record) {
+            consumer(record);
+            return false;
+        }));
+        ASSERT_EQUALS(5, i);
+
+        ASSERT_EQUALS(5U, cursor->nextBatch(8, consumer));
+        ASSERT_EQUALS(nToInsert, i);
+        ASSERT_EQUALS(0U, cursor->nextBatch(8, consumer));
+        ASSERT(!cursor->next());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
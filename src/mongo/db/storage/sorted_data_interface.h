@@ -93,6 +93,27 @@ public:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
+    /**
+     * Inserts every entry of 'keys', each of which must have a RecordId appended to the end, in
+     * key order. Stops at and returns the first non-OK status, with the same meaning as for
+     * insert(). Entries inserted before the failure are not undone; callers rely on the enclosing
+     * WriteUnitOfWork for that.
+     *
+     * Behaves like calling insert() for each key. Storage engines may override it to reuse one
+     * cursor across the batch, which is cheaper when neighbouring keys land on the same page.
+     */
+    virtual Status insertBatch(OperationContext* opCtx,
+                               const KeyStringSet& keys,
+                               bool dupsAllowed) {
+        for (const auto& keyString : keys) {
+            Status status = insert(opCtx, keyString, dupsAllowed);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
     /**
      * Remove the entry from the index with the specified KeyString, which must have a RecordId
      * appended to the end.
@@ -116,9 +137,10 @@ public:
 
     /**
      * Attempt to reduce the storage space used by this index via compaction. Only called if the
-     * indexed record store supports compaction-in-place.
+     * indexed record store supports compaction-in-place. 'timeLimit' has the same meaning as for
+     * RecordStore::compact().
      */
-    virtual Status compact(OperationContext* opCtx) {
+    virtual Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) {
         return Status::OK();
     }
 
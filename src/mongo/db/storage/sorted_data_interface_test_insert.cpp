@@ -717,5 +717,73 @@ TEST(SortedDataInterface, InsertReservedRecordId) {
     ASSERT_EQUALS(1, sorted->numEntries(opCtx.get()));
 }
 
+// Insert several KeyStrings with insertBatch() and verify that they are all found, in order.
+TEST(SortedDataInterface, InsertBatch) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/false, /*partial=*/false));
+
+    const KeyStringSet keys{makeKeyString(sorted.get(), key1, loc1),
+                            makeKeyString(sorted.get(), key2, loc2),
+                            makeKeyString(sorted.get(), key2, loc3),
+                            makeKeyString(sorted.get(), key3, loc1)};
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(sorted->insertBatch(opCtx.get(), keys, true));
+            uow.commit();
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(4, sorted->numEntries(opCtx.get()));
+
+        const std::unique_ptr<SortedDataInterface::Cursor> cursor(sorted->newCursor(opCtx.get()));
+        ASSERT_EQ(cursor->seek(makeKeyStringForSeek(sorted.get(), key1, true, true)),
+                  IndexKeyEntry(key1, loc1));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key2, loc2));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key2, loc3));
+        ASSERT_EQ(cursor->next(), IndexKeyEntry(key3, loc1));
+        ASSERT_EQ(cursor->next(), boost::none);
+    }
+}
+
+// A batch inserted into a unique index without allowing duplicates stops at the first duplicate
+// key.
+TEST(SortedDataInterface, InsertBatchStopsAtDuplicateKey) {
+    const auto harnessHelper(newSortedDataInterfaceHarnessHelper());
+    const std::unique_ptr<SortedDataInterface> sorted(
+        harnessHelper->newSortedDataInterface(/*unique=*/true, /*partial=*/false));
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_OK(sorted->insert(opCtx.get(), makeKeyString(sorted.get(), key2, loc1), false));
+            uow.commit();
+        }
+    }
+
+    {
+        const KeyStringSet keys{makeKeyString(sorted.get(), key1, loc2),
+                                makeKeyString(sorted.get(), key2, loc2)};
+
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        {
+            WriteUnitOfWork uow(opCtx.get());
+            ASSERT_EQ(ErrorCodes::DuplicateKey,
+                      sorted->insertBatch(opCtx.get(), keys, false).code());
+        }
+    }
+
+    {
+        const ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        ASSERT_EQUALS(1, sorted->numEntries(opCtx.get()));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
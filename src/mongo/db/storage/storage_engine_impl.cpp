@@ -32,6 +32,7 @@
 #include "mongo/db/storage/storage_engine_impl.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "mongo/db/audit.h"
 #include "mongo/db/catalog/catalog_control.h"
@@ -47,12 +48,14 @@
 #include "mongo/db/storage/durable_history_pin.h"
 #include "mongo/db/storage/kv/kv_engine.h"
 #include "mongo/db/storage/kv/temporary_kv_record_store.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/storage_util.h"
 #include "mongo/db/storage/two_phase_index_build_knobs_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/concurrency/thread_pool.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
@@ -232,6 +235,8 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
         }
     }
 
+    std::vector<std::pair<DurableCatalog::Entry, Timestamp>> entriesToInit;
+    entriesToInit.reserve(catalogEntries.size());
     for (DurableCatalog::Entry entry : catalogEntries) {
         if (loadingFromUncleanShutdownOrRepair) {
             // If we are loading the catalog after an unclean shutdown or during repair, it's
@@ -286,24 +291,115 @@ void StorageEngineImpl::loadCatalog(OperationContext* opCtx, bool loadingFromUnc
             }
         }
 
-        _initCollection(opCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
-
         if (entry.nss.isOrphanCollection()) {
             LOGV2(22248,
                   "Orphaned collection found: {namespace}",
                   "Orphaned collection found",
                   "namespace"_attr = entry.nss);
         }
+
+        entriesToInit.emplace_back(std::move(entry), minVisibleTs);
     }
 
+    _initCollections(opCtx, entriesToInit);
+
     opCtx->recoveryUnit()->abandonSnapshot();
 }
 
+void StorageEngineImpl::_initCollections(
+    OperationContext* opCtx,
+    const std::vector<std::pair<DurableCatalog::Entry, Timestamp>>& entries) {
+    // Opening a record store is independent of opening any other, so the collections are made on
+    // a pool of threads, each working through a contiguous range of the entries. Below this many
+    // entries per thread, starting the threads costs more than it saves.
+    const size_t kMinEntriesPerThread = 100;
+
+    std::vector<std::shared_ptr<Collection>> collections(entries.size());
+    auto makeCollections = [&](OperationContext* makeOpCtx, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const auto& [entry, minVisibleTs] = entries[i];
+            collections[i] = _makeCollection(
+                makeOpCtx, entry.catalogId, entry.nss, _options.forRepair, minVisibleTs);
+        }
+    };
+
+    const size_t numThreads = std::min(static_cast<size_t>(gStorageEngineCatalogLoadThreads),
+                                       entries.size() / kMinEntriesPerThread);
+    if (numThreads <= 1) {
+        makeCollections(opCtx, 0, entries.size());
+    } else {
+        ThreadPool::Options options;
+        options.poolName = "CatalogLoad";
+        options.threadNamePrefix = "CatalogLoad-";
+        options.minThreads = 0;
+        options.maxThreads = numThreads;
+        options.onCreateThread = [](const std::string& threadName) {
+            Client::initThread(threadName);
+        };
+        ThreadPool pool(options);
+        pool.startup();
+
+        auto mutex = MONGO_MAKE_LATCH("StorageEngineImpl::_initCollections");
+        Status firstError = Status::OK();
+        const size_t entriesPerThread = (entries.size() + numThreads - 1) / numThreads;
+        for (size_t begin = 0; begin < entries.size(); begin += entriesPerThread) {
+            pool.schedule([&, begin](Status status) {
+                invariant(status);
+
+                // The threads read the catalog through their own recovery units. On startup the
+                // storage engine is not yet installed on the service context, so the operation
+                // contexts are handed a noop recovery unit that has to be replaced.
+                auto makeOpCtx = cc().makeOperationContext();
+                if (makeOpCtx->recoveryUnit()->isNoop()) {
+                    makeOpCtx->setRecoveryUnit(
+                        std::unique_ptr<RecoveryUnit>(_engine->newRecoveryUnit()),
+                        WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+                }
+
+                try {
+                    makeCollections(makeOpCtx.get(),
+                                    begin,
+                                    std::min(begin + entriesPerThread, entries.size()));
+                } catch (const DBException& ex) {
+                    stdx::lock_guard<Latch> lk(mutex);
+                    if (firstError.isOK()) {
+                        firstError = ex.toStatus();
+                    }
+                }
+            });
+        }
+        pool.shutdown();
+        pool.join();
+        uassertStatusOK(firstError);
+    }
+
+    // Register everything in a single catalog write rather than copying the catalog once per
+    // collection.
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        for (auto& collection : collections) {
+            auto uuid = collection->uuid();
+            catalog.registerCollection(opCtx, uuid, std::move(collection));
+        }
+    });
+}
+
 void StorageEngineImpl::_initCollection(OperationContext* opCtx,
                                         RecordId catalogId,
                                         const NamespaceString& nss,
                                         bool forRepair,
                                         Timestamp minVisibleTs) {
+    auto collection = _makeCollection(opCtx, catalogId, nss, forRepair, minVisibleTs);
+    auto uuid = collection->uuid();
+    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
+        catalog.registerCollection(opCtx, uuid, std::move(collection));
+    });
+}
+
+std::shared_ptr<Collection> StorageEngineImpl::_makeCollection(OperationContext* opCtx,
+                                                               RecordId catalogId,
+                                                               const NamespaceString& nss,
+                                                               bool forRepair,
+                                                               Timestamp minVisibleTs) {
     BSONCollectionCatalogEntry::MetaData md = _catalog->getMetaData(opCtx, catalogId);
     uassert(ErrorCodes::MustDowngrade,
             str::stream() << "Collection does not have UUID in KVCatalog. Collection: " << nss,
@@ -326,10 +422,7 @@ void StorageEngineImpl::_initCollection(OperationContext* opCtx,
     auto collectionFactory = Collection::Factory::get(getGlobalServiceContext());
     auto collection = collectionFactory->make(opCtx, nss, catalogId, options, std::move(rs));
     collection->setMinimumVisibleSnapshot(minVisibleTs);
-
-    CollectionCatalog::write(opCtx, [&](CollectionCatalog& catalog) {
-        catalog.registerCollection(opCtx, options.uuid.get(), std::move(collection));
-    });
+    return collection;
 }
 
 void StorageEngineImpl::closeCatalog(OperationContext* opCtx) {
@@ -708,6 +801,21 @@ void StorageEngineImpl::cleanShutdown() {
 
     _timestampMonitor.reset();
 
+    // Drop the pooled temporary record stores now, as a startup which resumes index builds keeps
+    // the internal idents it finds.
+    std::unique_ptr<RecoveryUnit> ru(_engine->newRecoveryUnit());
+    for (auto&& rs : _temporaryRecordStorePool.releaseAll()) {
+        const auto ident = rs->getIdent();
+        rs.reset();
+        auto status = _engine->dropIdent(ru.get(), ident);
+        if (!status.isOK()) {
+            LOGV2_WARNING(5963022,
+                          "Failed to drop pooled temporary record store",
+                          "ident"_attr = ident,
+                          "error"_attr = status);
+        }
+    }
+
     _engine->cleanShutdown();
     // intentionally not deleting _engine
 }
@@ -908,10 +1016,15 @@ Status StorageEngineImpl::repairRecordStore(OperationContext* opCtx,
 
 std::unique_ptr<TemporaryRecordStore> StorageEngineImpl::makeTemporaryRecordStore(
     OperationContext* opCtx) {
-    std::unique_ptr<RecordStore> rs =
-        _engine->makeTemporaryRecordStore(opCtx, _catalog->newInternalIdent());
-    LOGV2_DEBUG(22258, 1, "Created temporary record store", "ident"_attr = rs->getIdent());
-    return std::make_unique<TemporaryKVRecordStore>(getEngine(), std::move(rs));
+    std::unique_ptr<RecordStore> rs = _temporaryRecordStorePool.take();
+    if (rs) {
+        LOGV2_DEBUG(5963021, 1, "Reusing temporary record store", "ident"_attr = rs->getIdent());
+    } else {
+        rs = _engine->makeTemporaryRecordStore(opCtx, _catalog->newInternalIdent());
+        LOGV2_DEBUG(22258, 1, "Created temporary record store", "ident"_attr = rs->getIdent());
+    }
+    return std::make_unique<TemporaryKVRecordStore>(
+        getEngine(), std::move(rs), &_temporaryRecordStorePool);
 }
 
 std::unique_ptr<TemporaryRecordStore>
@@ -33,6 +33,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mongo/base/status_with.h"
 #include "mongo/base/string_data.h"
@@ -42,6 +44,7 @@
 #include "mongo/db/storage/durable_catalog_feature_tracker.h"
 #include "mongo/db/storage/journal_listener.h"
 #include "mongo/db/storage/kv/kv_drop_pending_ident_reaper.h"
+#include "mongo/db/storage/kv/temporary_kv_record_store.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/storage_engine.h"
 #include "mongo/db/storage/storage_engine_interface.h"
@@ -379,6 +382,20 @@ private:
                          bool forRepair,
                          Timestamp minVisibleTs);
 
+    /**
+     * Opens the collection for each catalog entry, paired with its minimum visible timestamp, and
+     * registers them all with the CollectionCatalog. Large catalogs are opened on a pool of up to
+     * 'storageEngineCatalogLoadThreads' threads.
+     */
+    void _initCollections(OperationContext* opCtx,
+                          const std::vector<std::pair<DurableCatalog::Entry, Timestamp>>& entries);
+
+    std::shared_ptr<Collection> _makeCollection(OperationContext* opCtx,
+                                                RecordId catalogId,
+                                                const NamespaceString& nss,
+                                                bool forRepair,
+                                                Timestamp minVisibleTs);
+
     Status _dropCollectionsNoTimestamp(OperationContext* opCtx, const std::vector<UUID>& toDrop);
 
     /**
@@ -437,5 +454,8 @@ private:
     bool _inBackupMode = false;
 
     std::unique_ptr<TimestampMonitor> _timestampMonitor;
+
+    // Empty temporary record stores kept for reuse by makeTemporaryRecordStore().
+    TemporaryKVRecordStorePool _temporaryRecordStorePool;
 };
 }  // namespace mongo
@@ -0,0 +1,151 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/db/auth/action_set.h"
+#include "mongo/db/auth/action_type.h"
+#include "mongo/db/auth/privilege.h"
+#include "mongo/db/catalog/collection.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/storage/wiredtiger/train_compression_dictionary_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compression.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// zstd suggests training on about a hundred times as much data as the dictionary is to hold, so
+// sampling stops there even if fewer documents than asked for have been read.
+constexpr size_t kSampleBytesPerDictionaryByte = 100;
+
+/**
+ * Trains a compression dictionary for a collection created with the "zstd-dict" block compressor.
+ * Dictionaries are part of the physical layout of a node's data files, so the command is run on
+ * each node separately and is not replicated.
+ */
+class TrainCompressionDictionaryCmd : public BasicCommand {
+public:
+    TrainCompressionDictionaryCmd() : BasicCommand("trainCompressionDictionary") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kAlways;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    std::string help() const override {
+        return "train a block compression dictionary on sampled documents\n"
+               "{ trainCompressionDictionary : <collection_name>, [sampleSize: <int>], "
+               "[dictionarySize: <bytes>] }";
+    }
+
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {
+        ActionSet actions;
+        actions.addAction(ActionType::compact);
+        out->push_back(Privilege(parseResourcePattern(dbname, cmdObj), actions));
+    }
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        auto request = TrainCompressionDictionary::parse(
+            IDLParserErrorContext("trainCompressionDictionary"), cmdObj);
+        const auto& nss = request.getNamespace();
+        const size_t dictionarySize = request.getDictionarySize();
+        const size_t maxSampleBytes = dictionarySize * kSampleBytesPerDictionaryByte;
+
+        std::shared_ptr<WiredTigerDictionaryCompression> compression;
+        std::string compressor;
+        std::string samples;
+        std::vector<size_t> sampleSizes;
+        {
+            AutoGetCollectionForRead coll(opCtx, nss);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nss << " does not exist",
+                    coll);
+            auto rs = dynamic_cast<WiredTigerRecordStore*>(coll->getRecordStore());
+            uassert(ErrorCodes::CommandNotSupported,
+                    "trainCompressionDictionary requires the WiredTiger storage engine",
+                    rs);
+
+            compression = WiredTigerDictionaryCompression::get(
+                WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->conn());
+            invariant(compression);
+
+            auto config = uassertStatusOK(WiredTigerUtil::getMetadataCreate(opCtx, rs->getURI()));
+            WT_CONFIG_ITEM blockCompressor;
+            if (WiredTigerConfigParser(config).get("block_compressor", &blockCompressor) == 0) {
+                compressor.assign(blockCompressor.str, blockCompressor.len);
+            }
+            uassert(ErrorCodes::InvalidOptions,
+                    str::stream() << "Collection " << nss << " was not created with the '"
+                                  << WiredTigerDictionaryCompression::kBlockCompressorName
+                                  << "' block compressor",
+                    compression->hasCompressor(compressor));
+
+            auto cursor = rs->getRandomCursor(opCtx);
+            uassert(ErrorCodes::CommandNotSupported,
+                    str::stream() << "Collection " << nss << " cannot be sampled",
+                    cursor);
+            while (sampleSizes.size() < static_cast<size_t>(request.getSampleSize()) &&
+                   samples.size() < maxSampleBytes) {
+                auto record = cursor->next();
+                if (!record) {
+                    break;
+                }
+                samples.append(record->data.data(), record->data.size());
+                sampleSizes.push_back(record->data.size());
+            }
+        }
+
+        // Training takes a while, so it runs without holding any lock on the collection.
+        auto size = uassertStatusOK(
+            compression->trainDictionary(compressor, samples, sampleSizes, dictionarySize));
+        result.append("numSamples", static_cast<long long>(sampleSizes.size()));
+        result.append("dictionarySize", static_cast<long long>(size));
+        return true;
+    }
+} trainCompressionDictionaryCmd;
+
+}  // namespace
+}  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <array>
 #include <cstdio>
 #include <fmt/format.h>
 
@@ -40,16 +41,20 @@
 #include "mongo/util/errno_util.h"
 
 namespace mongo {
-using namespace fmt::literals;
 
-WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
-    WT_SESSION* session,
-    PrepareConflictBehavior prepareConflictBehavior,
-    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
-    RoundUpReadTimestamp roundUpReadTimestamp)
-    : _session(session) {
-    invariant(!_rollback);
+namespace {
 
+using RoundUpPreparedTimestamps = WiredTigerBeginTxnBlock::RoundUpPreparedTimestamps;
+using RoundUpReadTimestamp = WiredTigerBeginTxnBlock::RoundUpReadTimestamp;
+
+// The number of values of each of the options of begin_transaction.
+constexpr size_t kNumPrepareConflictBehaviors = 3;
+constexpr size_t kNumRoundUpPreparedTimestamps = 2;
+constexpr size_t kNumRoundUpReadTimestamps = 3;
+
+std::string makeBeginTxnConfigString(PrepareConflictBehavior prepareConflictBehavior,
+                                     RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+                                     RoundUpReadTimestamp roundUpReadTimestamp) {
     str::stream builder;
     if (prepareConflictBehavior == PrepareConflictBehavior::kIgnoreConflicts) {
         builder << "ignore_prepare=true,";
@@ -70,9 +75,62 @@ WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
     if (roundUpReadTimestamp == RoundUpReadTimestamp::kNoRoundForce) {
         builder << "read_before_oldest=true,";
     }
+    return builder;
+}
+
+/**
+ * Returns the begin_transaction configuration string for the given options. There are few enough
+ * combinations to build them all once, rather than on every transaction.
+ */
+const char* getBeginTxnConfigString(PrepareConflictBehavior prepareConflictBehavior,
+                                    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+                                    RoundUpReadTimestamp roundUpReadTimestamp) {
+    auto index = [](size_t prepareConflictBehavior,
+                    size_t roundUpPreparedTimestamps,
+                    size_t roundUpReadTimestamp) {
+        return (prepareConflictBehavior * kNumRoundUpPreparedTimestamps +
+                roundUpPreparedTimestamps) *
+            kNumRoundUpReadTimestamps +
+            roundUpReadTimestamp;
+    };
 
-    const std::string beginTxnConfigString = builder;
-    invariantWTOK(_session->begin_transaction(_session, beginTxnConfigString.c_str()));
+    static const auto configStrings = [&] {
+        std::array<std::string,
+                   kNumPrepareConflictBehaviors * kNumRoundUpPreparedTimestamps *
+                       kNumRoundUpReadTimestamps>
+            configStrings;
+        for (size_t i = 0; i < kNumPrepareConflictBehaviors; ++i) {
+            for (size_t j = 0; j < kNumRoundUpPreparedTimestamps; ++j) {
+                for (size_t k = 0; k < kNumRoundUpReadTimestamps; ++k) {
+                    configStrings[index(i, j, k)] =
+                        makeBeginTxnConfigString(static_cast<PrepareConflictBehavior>(i),
+                                                 static_cast<RoundUpPreparedTimestamps>(j),
+                                                 static_cast<RoundUpReadTimestamp>(k));
+                }
+            }
+        }
+        return configStrings;
+    }();
+
+    return configStrings[index(static_cast<size_t>(prepareConflictBehavior),
+                               static_cast<size_t>(roundUpPreparedTimestamps),
+                               static_cast<size_t>(roundUpReadTimestamp))]
+        .c_str();
+}
+
+}  // namespace
+
+WiredTigerBeginTxnBlock::WiredTigerBeginTxnBlock(
+    WT_SESSION* session,
+    PrepareConflictBehavior prepareConflictBehavior,
+    RoundUpPreparedTimestamps roundUpPreparedTimestamps,
+    RoundUpReadTimestamp roundUpReadTimestamp)
+    : _session(session) {
+    invariant(!_rollback);
+    invariantWTOK(_session->begin_transaction(
+        _session,
+        getBeginTxnConfigString(
+            prepareConflictBehavior, roundUpPreparedTimestamps, roundUpReadTimestamp)));
     _rollback = true;
 }
 
@@ -91,9 +149,12 @@ WiredTigerBeginTxnBlock::~WiredTigerBeginTxnBlock() {
 
 Status WiredTigerBeginTxnBlock::setReadSnapshot(Timestamp readTimestamp) {
     invariant(_rollback);
-    std::string readTSConfigString = "read_timestamp={:x}"_format(readTimestamp.asULL());
+    // Format into a buffer on the stack, as this is done for every timestamped read.
+    fmt::memory_buffer readTSConfigString;
+    fmt::format_to(readTSConfigString, "read_timestamp={:x}", readTimestamp.asULL());
+    readTSConfigString.push_back('\0');
 
-    return wtRCToStatus(_session->timestamp_transaction(_session, readTSConfigString.c_str()));
+    return wtRCToStatus(_session->timestamp_transaction(_session, readTSConfigString.data()));
 }
 
 void WiredTigerBeginTxnBlock::done() {
@@ -0,0 +1,292 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/db/catalog/collection_options.h"
+#include "mongo/db/concurrency/locker_noop.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/key_string.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/util/clock_source_mock.h"
+
+namespace mongo {
+namespace {
+
+constexpr int kNumRecords = 100 * 1000;
+
+/**
+ * A WiredTiger instance in a temporary directory, holding one collection of 'kNumRecords'
+ * documents {_id: i, a: i, payload: <100 bytes>} and an index on 'a'. It is loaded once and shared
+ * by all the benchmarks, which only read it.
+ */
+class WiredTigerCursorBenchmarkEnv {
+public:
+    static WiredTigerCursorBenchmarkEnv& get() {
+        static WiredTigerCursorBenchmarkEnv env;
+        return env;
+    }
+
+    ~WiredTigerCursorBenchmarkEnv() {
+        _index.reset();
+        _rs.reset();
+        _engine.cleanShutdown();
+    }
+
+    ServiceContext::UniqueOperationContext makeOperationContext(Client* client) {
+        auto opCtx = client->makeOperationContext();
+        opCtx->setRecoveryUnit(std::unique_ptr<RecoveryUnit>(_engine.newRecoveryUnit()),
+                               WriteUnitOfWork::RecoveryUnitState::kNotInUnitOfWork);
+        opCtx->swapLockState(std::make_unique<LockerNoop>(), WithLock::withoutLock());
+        return opCtx;
+    }
+
+    WiredTigerRecordStore* recordStore() {
+        return _rs.get();
+    }
+
+    SortedDataInterface* index() {
+        return _index.get();
+    }
+
+    const std::vector<RecordId>& recordIds() const {
+        return _recordIds;
+    }
+
+private:
+    WiredTigerCursorBenchmarkEnv()
+        : _dbpath("wiredtiger_cursor_bm"),
+          _engine(kWiredTigerEngineName,
+                  _dbpath.path(),
+                  &_clockSource,
+                  "" /* extraOpenOptions */,
+                  256 /* cacheSizeMB */,
+                  0 /* maxHistoryFileSizeMB */,
+                  false /* durable */,
+                  false /* ephemeral */,
+                  false /* repair */,
+                  false /* readOnly */),
+          _indexDescriptor("",
+                           BSON("v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion)
+                                    << "key" << BSON("a" << 1) << "name"
+                                    << "a_1")) {
+        auto service = getGlobalServiceContext();
+        repl::ReplicationCoordinator::set(service,
+                                          std::make_unique<repl::ReplicationCoordinatorMock>(
+                                              service, repl::ReplSettings()));
+        _engine.notifyStartupComplete();
+
+        auto client = service->makeClient("wiredtiger_cursor_bm");
+        auto opCtx = makeOperationContext(client.get());
+        const NamespaceString nss("test", "wiredtiger_cursor_bm");
+        invariant(_engine.createRecordStore(opCtx.get(), nss.ns(), "collection", {}));
+        _rs.reset(checked_cast<WiredTigerRecordStore*>(
+            _engine.getRecordStore(opCtx.get(), nss.ns(), "collection", {}).release()));
+        invariant(_engine.createSortedDataInterface(opCtx.get(), {}, "index", &_indexDescriptor));
+        _index = _engine.getSortedDataInterface(opCtx.get(), {}, "index", &_indexDescriptor);
+
+        const std::string payload(100, 'x');
+        for (int i = 0; i < kNumRecords;) {
+            WriteUnitOfWork wuow(opCtx.get());
+            for (const int end = i + 1000; i < end; ++i) {
+                const auto doc = BSON("_id" << i << "a" << i << "payload" << payload);
+                const auto rid = uassertStatusOK(
+                    _rs->insertRecord(opCtx.get(), doc.objdata(), doc.objsize(), Timestamp()));
+                KeyString::Builder key(
+                    _index->getKeyStringVersion(), BSON("" << i), _index->getOrdering(), rid);
+                uassertStatusOK(_index->insert(opCtx.get(), key.getValueCopy(), false));
+                _recordIds.push_back(rid);
+            }
+            wuow.commit();
+        }
+    }
+
+    unittest::TempDir _dbpath;
+    ClockSourceMock _clockSource;
+    WiredTigerKVEngine _engine;
+    IndexDescriptor _indexDescriptor;
+    std::unique_ptr<WiredTigerRecordStore> _rs;
+    std::unique_ptr<SortedDataInterface> _index;
+    std::vector<RecordId> _recordIds;
+};
+
+/**
+ * The Client and OperationContext of one benchmark thread.
+ */
+struct BenchmarkThread {
+    BenchmarkThread()
+        : env(WiredTigerCursorBenchmarkEnv::get()),
+          client(getGlobalServiceContext()->makeClient("wiredtiger_cursor_bm")),
+          opCtx(env.makeOperationContext(client.get())) {}
+
+    WiredTigerCursorBenchmarkEnv& env;
+    ServiceContext::UniqueClient client;
+    ServiceContext::UniqueOperationContext opCtx;
+    PseudoRandom random{int64_t{1234}};
+};
+
+void BM_RecordCursorNext(benchmark::State& state) {
+    BenchmarkThread thread;
+    auto cursor = thread.env.recordStore()->getCursor(thread.opCtx.get());
+    for (auto keepRunning : state) {
+        auto record = cursor->next();
+        if (!record) {
+            cursor = thread.env.recordStore()->getCursor(thread.opCtx.get());
+        }
+        benchmark::DoNotOptimize(record);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RecordCursorSeekExact(benchmark::State& state) {
+    BenchmarkThread thread;
+    const auto& recordIds = thread.env.recordIds();
+    auto cursor = thread.env.recordStore()->getCursor(thread.opCtx.get());
+    for (auto keepRunning : state) {
+        const auto& rid = recordIds[thread.random.nextInt32(recordIds.size())];
+        benchmark::DoNotOptimize(cursor->seekExact(rid));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RecordCursorRandom(benchmark::State& state) {
+    BenchmarkThread thread;
+    auto cursor = thread.env.recordStore()->getRandomCursor(thread.opCtx.get());
+    for (auto keepRunning : state) {
+        benchmark::DoNotOptimize(cursor->next());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_IndexCursorNext(benchmark::State& state) {
+    BenchmarkThread thread;
+    auto cursor = thread.env.index()->newCursor(thread.opCtx.get());
+    for (auto keepRunning : state) {
+        auto entry = cursor->next();
+        if (!entry) {
+            cursor = thread.env.index()->newCursor(thread.opCtx.get());
+        }
+        benchmark::DoNotOptimize(entry);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_IndexCursorSeek(benchmark::State& state) {
+    BenchmarkThread thread;
+    auto index = thread.env.index();
+    auto cursor = index->newCursor(thread.opCtx.get());
+    for (auto keepRunning : state) {
+        KeyString::Builder key(index->getKeyStringVersion(),
+                               BSON("" << thread.random.nextInt32(kNumRecords)),
+                               index->getOrdering(),
+                               KeyString::Discriminator::kExclusiveBefore);
+        benchmark::DoNotOptimize(cursor->seek(key.getValueCopy()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SnapshotOpenClose(benchmark::State& state) {
+    BenchmarkThread thread;
+    auto ru = thread.opCtx->recoveryUnit();
+    for (auto keepRunning : state) {
+        ru->preallocateSnapshot();
+        ru->abandonSnapshot();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/**
+ * The same reads as BM_RecordCursorNext and BM_RecordCursorSeekExact, made directly with a
+ * WT_CURSOR on the session of the recovery unit, as a baseline for the cost of the storage API.
+ */
+WT_CURSOR* openRawCursor(BenchmarkThread& thread) {
+    auto session = WiredTigerRecoveryUnit::get(thread.opCtx.get())->getSession()->getSession();
+    WT_CURSOR* cursor;
+    invariantWTOK(session->open_cursor(
+        session, thread.env.recordStore()->getURI().c_str(), nullptr, nullptr, &cursor));
+    return cursor;
+}
+
+void BM_RawWiredTigerCursorNext(benchmark::State& state) {
+    BenchmarkThread thread;
+    WT_CURSOR* cursor = openRawCursor(thread);
+    for (auto keepRunning : state) {
+        if (cursor->next(cursor) == WT_NOTFOUND) {
+            invariantWTOK(cursor->reset(cursor));
+            continue;
+        }
+        WT_ITEM value;
+        invariantWTOK(cursor->get_value(cursor, &value));
+        benchmark::DoNotOptimize(value);
+    }
+    invariantWTOK(cursor->close(cursor));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_RawWiredTigerCursorSearch(benchmark::State& state) {
+    BenchmarkThread thread;
+    const auto& recordIds = thread.env.recordIds();
+    WT_CURSOR* cursor = openRawCursor(thread);
+    for (auto keepRunning : state) {
+        const auto& rid = recordIds[thread.random.nextInt32(recordIds.size())];
+        cursor->set_key(cursor, rid.getLong());
+        invariantWTOK(cursor->search(cursor));
+        WT_ITEM value;
+        invariantWTOK(cursor->get_value(cursor, &value));
+        benchmark::DoNotOptimize(value);
+    }
+    invariantWTOK(cursor->close(cursor));
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define BENCHMARK_THREADS(name) BENCHMARK(name)->Threads(1)->Threads(4)->Threads(16)->UseRealTime()
+
+BENCHMARK_THREADS(BM_RecordCursorNext);
+BENCHMARK_THREADS(BM_RecordCursorSeekExact);
+BENCHMARK_THREADS(BM_RecordCursorRandom);
+BENCHMARK_THREADS(BM_IndexCursorNext);
+BENCHMARK_THREADS(BM_IndexCursorSeek);
+BENCHMARK_THREADS(BM_SnapshotOpenClose);
+BENCHMARK_THREADS(BM_RawWiredTigerCursorNext);
+BENCHMARK_THREADS(BM_RawWiredTigerCursorSearch);
+
+}  // namespace
+}  // namespace mongo
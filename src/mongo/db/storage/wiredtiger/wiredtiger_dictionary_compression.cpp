@@ -0,0 +1,589 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compression.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <wiredtiger_ext.h>
+#include <zdict.h>
+#include <zstd.h>
+
+#include "mongo/base/data_view.h"
+#include "mongo/base/parse_number.h"
+#include "mongo/db/storage/storage_file_util.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+constexpr StringData kCompressorPrefix = "zstd_dict_"_sd;
+constexpr StringData kDictionarySuffix = ".dict"_sd;
+constexpr StringData kCompressorFileName = "compressor"_sd;
+
+// The level WiredTiger's own zstd compressor uses by default.
+constexpr int kCompressionLevel = 6;
+
+// Every page starts with the length of its zstd frame, which zstd needs to decompress it and which
+// WiredTiger does not keep, followed by the number of the dictionary the frame was compressed with,
+// or zero if it was compressed without one.
+constexpr size_t kLengthSize = sizeof(uint64_t);
+constexpr size_t kPrefixSize = kLengthSize + sizeof(uint32_t);
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// Pages are compressed by eviction and checkpoint threads and decompressed by whichever thread
+// misses in the cache, so each thread keeps one context of each kind rather than allocating one
+// per page.
+ZSTD_CCtx* getCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> cctx(ZSTD_createCCtx());
+    return cctx.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> dctx(ZSTD_createDCtx());
+    return dctx.get();
+}
+
+/**
+ * A trained dictionary, digested for compression and for decompression.
+ */
+class Dictionary {
+    Dictionary(const Dictionary&) = delete;
+    Dictionary& operator=(const Dictionary&) = delete;
+
+public:
+    Dictionary(uint32_t number, const std::string& data)
+        : number(number),
+          cdict(ZSTD_createCDict(data.data(), data.size(), kCompressionLevel)),
+          ddict(ZSTD_createDDict(data.data(), data.size())) {}
+
+    ~Dictionary() {
+        ZSTD_freeCDict(cdict);
+        ZSTD_freeDDict(ddict);
+    }
+
+    bool isValid() const {
+        return cdict && ddict;
+    }
+
+    const uint32_t number;
+    ZSTD_CDict* const cdict;
+    ZSTD_DDict* const ddict;
+};
+
+boost::filesystem::path dictionaryPath(const boost::filesystem::path& directory, uint32_t number) {
+    return directory / (std::to_string(number) + kDictionarySuffix);
+}
+
+StatusWith<std::string> readFile(const boost::filesystem::path& path) {
+    std::ifstream in(path.string(), std::ios::in | std::ios::binary);
+    std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (!in.good() && !in.eof()) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to read " << path.string() << ": "
+                              << errnoWithDescription()};
+    }
+    return data;
+}
+
+}  // namespace
+
+/**
+ * The dictionaries of one compressor, by number. Dictionaries are only ever added.
+ */
+class WiredTigerDictionaryCompression::DictionarySet {
+public:
+    explicit DictionarySet(boost::filesystem::path directory) : _directory(std::move(directory)) {}
+
+    const boost::filesystem::path& directory() const {
+        return _directory;
+    }
+
+    std::shared_ptr<const Dictionary> latest() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _latest;
+    }
+
+    std::shared_ptr<const Dictionary> find(uint32_t number) const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _dictionaries.find(number);
+        return it == _dictionaries.end() ? nullptr : it->second;
+    }
+
+    std::vector<uint32_t> numbers() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        std::vector<uint32_t> numbers;
+        for (auto&& [number, dictionary] : _dictionaries) {
+            numbers.push_back(number);
+        }
+        return numbers;
+    }
+
+    uint32_t nextNumber() const {
+        stdx::lock_guard<Latch> lk(_mutex);
+        return _latest ? _latest->number + 1 : 1;
+    }
+
+    void add(std::shared_ptr<const Dictionary> dictionary) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_latest || dictionary->number > _latest->number) {
+            _latest = dictionary;
+        }
+        _dictionaries.emplace(dictionary->number, std::move(dictionary));
+    }
+
+private:
+    const boost::filesystem::path _directory;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("DictionarySet::_mutex");
+    std::map<uint32_t, std::shared_ptr<const Dictionary>> _dictionaries;
+    std::shared_ptr<const Dictionary> _latest;
+};
+
+namespace {
+
+struct DictionaryCompressor : public WT_COMPRESSOR {
+    WT_EXTENSION_API* wtApi;
+    std::shared_ptr<WiredTigerDictionaryCompression::DictionarySet> dictionaries;
+};
+
+int zstdError(WT_COMPRESSOR* compressor, WT_SESSION* session, const char* call, size_t error) {
+    auto wtApi = static_cast<DictionaryCompressor*>(compressor)->wtApi;
+    wtApi->err_printf(wtApi, session, "zstd error: %s: %s", call, ZSTD_getErrorName(error));
+    return WT_ERROR;
+}
+
+int compressPage(WT_COMPRESSOR* compressor,
+                 WT_SESSION* session,
+                 uint8_t* src,
+                 size_t srcLen,
+                 uint8_t* dst,
+                 size_t dstLen,
+                 size_t* resultLen,
+                 int* compressionFailed) {
+    auto cctx = getCompressionContext();
+    if (!cctx) {
+        return ENOMEM;
+    }
+
+    auto dictionary = static_cast<DictionaryCompressor*>(compressor)->dictionaries->latest();
+    size_t zstdLen = dictionary
+        ? ZSTD_compress_usingCDict(
+              cctx, dst + kPrefixSize, dstLen - kPrefixSize, src, srcLen, dictionary->cdict)
+        : ZSTD_compressCCtx(
+              cctx, dst + kPrefixSize, dstLen - kPrefixSize, src, srcLen, kCompressionLevel);
+
+    if (ZSTD_isError(zstdLen)) {
+        *compressionFailed = 1;
+        return zstdError(compressor, session, "ZSTD_compress", zstdLen);
+    }
+    if (zstdLen + kPrefixSize >= srcLen) {
+        *compressionFailed = 1;
+        return 0;
+    }
+
+    DataView(reinterpret_cast<char*>(dst)).write<LittleEndian<uint64_t>>(zstdLen);
+    DataView(reinterpret_cast<char*>(dst) + kLengthSize)
+        .write<LittleEndian<uint32_t>>(dictionary ? dictionary->number : 0);
+    *resultLen = zstdLen + kPrefixSize;
+    *compressionFailed = 0;
+    return 0;
+}
+
+int decompressPage(WT_COMPRESSOR* compressor,
+                   WT_SESSION* session,
+                   uint8_t* src,
+                   size_t srcLen,
+                   uint8_t* dst,
+                   size_t dstLen,
+                   size_t* resultLen) {
+    auto self = static_cast<DictionaryCompressor*>(compressor);
+    if (srcLen < kPrefixSize) {
+        self->wtApi->err_printf(
+            self->wtApi, session, "WT_COMPRESSOR.decompress: page too short for its prefix");
+        return WT_ERROR;
+    }
+
+    ConstDataView prefix(reinterpret_cast<const char*>(src));
+    uint64_t zstdLen = prefix.read<LittleEndian<uint64_t>>();
+    uint32_t number = prefix.read<LittleEndian<uint32_t>>(kLengthSize);
+    if (zstdLen > srcLen - kPrefixSize) {
+        self->wtApi->err_printf(
+            self->wtApi, session, "WT_COMPRESSOR.decompress: stored size exceeds source size");
+        return WT_ERROR;
+    }
+
+    auto dctx = getDecompressionContext();
+    if (!dctx) {
+        return ENOMEM;
+    }
+
+    size_t ret;
+    if (number == 0) {
+        ret = ZSTD_decompressDCtx(dctx, dst, dstLen, src + kPrefixSize, zstdLen);
+    } else {
+        auto dictionary = self->dictionaries->find(number);
+        if (!dictionary) {
+            self->wtApi->err_printf(self->wtApi,
+                                    session,
+                                    "WT_COMPRESSOR.decompress: dictionary %s is missing",
+                                    dictionaryPath(self->dictionaries->directory(), number)
+                                        .string()
+                                        .c_str());
+            return WT_ERROR;
+        }
+        ret = ZSTD_decompress_usingDDict(
+            dctx, dst, dstLen, src + kPrefixSize, zstdLen, dictionary->ddict);
+    }
+
+    if (ZSTD_isError(ret)) {
+        return zstdError(compressor, session, "ZSTD_decompress", ret);
+    }
+    *resultLen = ret;
+    return 0;
+}
+
+int preSize(WT_COMPRESSOR* compressor,
+            WT_SESSION* session,
+            uint8_t* src,
+            size_t srcLen,
+            size_t* resultLen) {
+    *resultLen = ZSTD_compressBound(srcLen) + kPrefixSize;
+    return 0;
+}
+
+int terminateCompressor(WT_COMPRESSOR* compressor, WT_SESSION* session) {
+    delete static_cast<DictionaryCompressor*>(compressor);
+    return 0;
+}
+
+// The extension's state for each open connection. An entry is added when WiredTiger loads the
+// extension and removed when it closes the connection.
+Mutex registryMutex = MONGO_MAKE_LATCH("WiredTigerDictionaryCompression::registryMutex");
+stdx::unordered_map<WT_CONNECTION*, std::shared_ptr<WiredTigerDictionaryCompression>> registry;
+
+}  // namespace
+
+std::string WiredTigerDictionaryCompression::getExtensionConfig(const std::string& path) {
+    const auto directory = boost::filesystem::path(path) / kDirectoryName.toString();
+    return str::stream() << "local=(entry=mongo_wt_dictionary_compression_init,"
+                         << "terminate=mongo_wt_dictionary_compression_terminate,"
+                         << "config=(directory=\"" << directory.string() << "\"))";
+}
+
+std::shared_ptr<WiredTigerDictionaryCompression> WiredTigerDictionaryCompression::get(
+    WT_CONNECTION* conn) {
+    stdx::lock_guard<Latch> lk(registryMutex);
+    auto it = registry.find(conn);
+    return it == registry.end() ? nullptr : it->second;
+}
+
+WiredTigerDictionaryCompression::WiredTigerDictionaryCompression(WT_CONNECTION* conn,
+                                                                 boost::filesystem::path directory)
+    : _conn(conn), _directory(std::move(directory)) {}
+
+Status WiredTigerDictionaryCompression::loadCompressors() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    try {
+        // The directory is only created along with the first compressor, so that a read-only
+        // database without one opens too.
+        if (!boost::filesystem::exists(_directory)) {
+            return Status::OK();
+        }
+
+        for (const auto& entry : boost::filesystem::directory_iterator(_directory)) {
+            int id;
+            if (!boost::filesystem::is_directory(entry.path()) ||
+                !NumberParser{}(entry.path().filename().string(), &id).isOK() || id <= 0) {
+                continue;
+            }
+
+            auto dictionaries = std::make_shared<DictionarySet>(entry.path());
+            for (const auto& file : boost::filesystem::directory_iterator(entry.path())) {
+                // Dictionaries are written under a temporary name and renamed once they are
+                // durable, so anything else is either the compressor file or was left behind by a
+                // crash during training.
+                uint32_t number;
+                if (file.path().extension().string() != kDictionarySuffix ||
+                    !NumberParser{}(file.path().stem().string(), &number).isOK() ||
+                    number == 0) {
+                    continue;
+                }
+
+                auto data = readFile(file.path());
+                if (!data.isOK()) {
+                    return data.getStatus();
+                }
+                auto dictionary = std::make_shared<const Dictionary>(number, data.getValue());
+                if (!dictionary->isValid()) {
+                    return {ErrorCodes::InvalidPath,
+                            str::stream() << "Invalid compression dictionary "
+                                          << file.path().string()};
+                }
+                dictionaries->add(std::move(dictionary));
+            }
+
+            auto status = _registerCompressor(id, std::move(dictionaries));
+            if (!status.isOK()) {
+                return status;
+            }
+            _nextId = std::max(_nextId, id + 1);
+        }
+    } catch (const boost::filesystem::filesystem_error& ex) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to load compression dictionaries from "
+                              << _directory.string() << ": " << ex.what()};
+    }
+
+    LOGV2(5963040,
+          "Loaded dictionary block compressors",
+          "directory"_attr = _directory.string(),
+          "numCompressors"_attr = _compressors.size());
+    return Status::OK();
+}
+
+StatusWith<std::string> WiredTigerDictionaryCompression::addCompressor() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    const int id = _nextId++;
+    const auto directory = _directory / std::to_string(id);
+    try {
+        // The directory must be durable before any table names the compressor, since its presence
+        // is what registers the compressor after a restart.
+        if (boost::filesystem::create_directory(_directory)) {
+            auto status = fsyncParentDirectory(_directory);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        boost::filesystem::create_directory(directory);
+        auto status = fsyncParentDirectory(directory);
+        if (!status.isOK()) {
+            return status;
+        }
+
+        const auto compressorFile = directory / kCompressorFileName.toString();
+        std::ofstream out(compressorFile.string(), std::ios::out | std::ios::trunc);
+        out.close();
+        if (!out.good()) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to write " << compressorFile.string() << ": "
+                                  << errnoWithDescription()};
+        }
+        status = fsyncFile(compressorFile);
+        if (status.isOK()) {
+            status = fsyncParentDirectory(compressorFile);
+        }
+        if (!status.isOK()) {
+            return status;
+        }
+    } catch (const boost::filesystem::filesystem_error& ex) {
+        return {ErrorCodes::FileStreamFailed,
+                str::stream() << "Failed to create " << directory.string() << ": " << ex.what()};
+    }
+
+    auto status = _registerCompressor(id, std::make_shared<DictionarySet>(directory));
+    if (!status.isOK()) {
+        return status;
+    }
+    return kCompressorPrefix + std::to_string(id);
+}
+
+bool WiredTigerDictionaryCompression::hasCompressor(StringData compressorName) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    return _compressors.find(compressorName) != _compressors.end();
+}
+
+std::vector<boost::filesystem::path> WiredTigerDictionaryCompression::getBackupFiles() const {
+    // Holding '_mutex' waits for the dictionary being written, if any, to be durable.
+    stdx::lock_guard<Latch> lk(_mutex);
+    std::vector<boost::filesystem::path> files;
+    for (auto&& [name, dictionaries] : _compressors) {
+        const auto compressorFile = dictionaries->directory() / kCompressorFileName.toString();
+        if (boost::filesystem::exists(compressorFile)) {
+            files.push_back(compressorFile);
+        }
+        for (auto number : dictionaries->numbers()) {
+            files.push_back(dictionaryPath(dictionaries->directory(), number));
+        }
+    }
+    return files;
+}
+
+StatusWith<size_t> WiredTigerDictionaryCompression::trainDictionary(
+    StringData compressorName,
+    const std::string& samples,
+    const std::vector<size_t>& sampleSizes,
+    size_t maxDictionarySize) {
+    std::shared_ptr<DictionarySet> dictionaries;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _compressors.find(compressorName);
+        if (it == _compressors.end()) {
+            return {ErrorCodes::InvalidOptions,
+                    str::stream() << "The collection is not compressed with the '"
+                                  << kBlockCompressorName << "' block compressor"};
+        }
+        dictionaries = it->second;
+    }
+
+    std::string data(maxDictionarySize, '\0');
+    size_t size = ZDICT_trainFromBuffer(data.data(),
+                                        data.size(),
+                                        samples.data(),
+                                        sampleSizes.data(),
+                                        static_cast<unsigned>(sampleSizes.size()));
+    if (ZDICT_isError(size)) {
+        return {ErrorCodes::OperationFailed,
+                str::stream() << "Failed to train a compression dictionary: "
+                              << ZDICT_getErrorName(size)};
+    }
+    data.resize(size);
+
+    // Only one dictionary is written at a time, so that each gets a number of its own.
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto dictionary = std::make_shared<const Dictionary>(dictionaries->nextNumber(), data);
+    if (!dictionary->isValid()) {
+        return {ErrorCodes::OperationFailed, "Failed to load the trained compression dictionary"};
+    }
+
+    const auto path = dictionaryPath(dictionaries->directory(), dictionary->number);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream out(tempPath.string(), std::ios::out | std::ios::binary | std::ios::trunc);
+        out.write(data.data(), data.size());
+        out.close();
+        if (!out.good()) {
+            return {ErrorCodes::FileStreamFailed,
+                    str::stream() << "Failed to write " << tempPath.string() << ": "
+                                  << errnoWithDescription()};
+        }
+    }
+    auto status = fsyncFile(tempPath);
+    if (status.isOK()) {
+        status = fsyncRename(tempPath, path);
+    }
+    if (!status.isOK()) {
+        return status;
+    }
+
+    dictionaries->add(dictionary);
+    LOGV2(5963041,
+          "Trained a block compression dictionary",
+          "compressor"_attr = compressorName,
+          "path"_attr = path.string(),
+          "size"_attr = size,
+          "numSamples"_attr = sampleSizes.size());
+    return size;
+}
+
+Status WiredTigerDictionaryCompression::_registerCompressor(
+    int id, std::shared_ptr<DictionarySet> dictionaries) {
+    auto name = kCompressorPrefix + std::to_string(id);
+    auto compressor = std::make_unique<DictionaryCompressor>();
+    compressor->compress = compressPage;
+    compressor->decompress = decompressPage;
+    compressor->pre_size = preSize;
+    compressor->terminate = terminateCompressor;
+    compressor->wtApi = _conn->get_extension_api(_conn);
+    compressor->dictionaries = dictionaries;
+
+    // WiredTiger owns the compressor once it is added, and frees it through terminateCompressor().
+    int ret = _conn->add_compressor(_conn, name.c_str(), compressor.get(), nullptr);
+    if (ret != 0) {
+        return wtRCToStatus(ret, "Failed to add a dictionary block compressor");
+    }
+    compressor.release();
+    _compressors.emplace(std::move(name), std::move(dictionaries));
+    return Status::OK();
+}
+
+}  // namespace mongo
+
+int mongo_wt_dictionary_compression_init(WT_CONNECTION* conn, WT_CONFIG_ARG* config) {
+    using namespace mongo;
+    auto wtApi = conn->get_extension_api(conn);
+    WT_CONFIG_ITEM directory;
+    int ret = wtApi->config_get(wtApi, nullptr, config, "directory", &directory);
+    if (ret != 0) {
+        wtApi->err_printf(wtApi,
+                          nullptr,
+                          "mongo_wt_dictionary_compression_init: %s",
+                          wtApi->strerror(wtApi, nullptr, ret));
+        return ret;
+    }
+
+    try {
+        auto compression = std::make_shared<WiredTigerDictionaryCompression>(
+            conn, std::string(directory.str, directory.len));
+        auto status = compression->loadCompressors();
+        if (!status.isOK()) {
+            wtApi->err_printf(wtApi,
+                              nullptr,
+                              "mongo_wt_dictionary_compression_init: %s",
+                              status.reason().c_str());
+            return WT_ERROR;
+        }
+
+        stdx::lock_guard<Latch> lk(registryMutex);
+        registry[conn] = std::move(compression);
+    } catch (const std::exception& ex) {
+        wtApi->err_printf(wtApi, nullptr, "mongo_wt_dictionary_compression_init: %s", ex.what());
+        return WT_ERROR;
+    }
+    return 0;
+}
+
+int mongo_wt_dictionary_compression_terminate(WT_CONNECTION* conn) {
+    using namespace mongo;
+    stdx::lock_guard<Latch> lk(registryMutex);
+    registry.erase(conn);
+    return 0;
+}
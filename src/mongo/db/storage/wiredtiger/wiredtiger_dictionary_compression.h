@@ -0,0 +1,142 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <wiredtiger.h>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+
+extern "C" {
+/**
+ * Entry points of the WiredTiger extension which registers the dictionary compressors. They are
+ * loaded as a "local" extension, so WiredTiger looks them up by name in the running process.
+ */
+int mongo_wt_dictionary_compression_init(WT_CONNECTION* conn, WT_CONFIG_ARG* config);
+int mongo_wt_dictionary_compression_terminate(WT_CONNECTION* conn);
+}
+
+namespace mongo {
+
+/**
+ * Block compression of record stores with zstd dictionaries trained on their own documents.
+ *
+ * A WiredTiger compressor is not told which table it compresses, so every record store which asks
+ * for the "zstd-dict" block compressor gets a compressor of its own, named "zstd_dict_<id>". The
+ * dictionaries of compressor <id> are kept in "<dbpath>/zstdDictionaries/<id>/<n>.dict", and all
+ * the compressors found there are registered before WiredTiger runs recovery. New pages are
+ * compressed with the most recently trained dictionary, and each page records the number of the
+ * dictionary it was compressed with, so dictionaries are never removed while the table exists.
+ * Until a dictionary has been trained, pages are compressed with plain zstd.
+ *
+ * The directory of each compressor also holds an empty "compressor" file, so that backups, which
+ * list files rather than directories, restore compressors without a dictionary too.
+ */
+class WiredTigerDictionaryCompression {
+public:
+    /**
+     * The block compressor a collection asks for to be compressed with trained dictionaries.
+     */
+    static constexpr StringData kBlockCompressorName = "zstd-dict"_sd;
+
+    /**
+     * The directory under the dbpath holding the dictionaries.
+     */
+    static constexpr StringData kDirectoryName = "zstdDictionaries"_sd;
+
+    /**
+     * Returns the `extensions=[...]` item which loads the dictionary compressors for the database
+     * at 'path' when WiredTiger is opened.
+     */
+    static std::string getExtensionConfig(const std::string& path);
+
+    /**
+     * Returns the dictionary compressors registered with 'conn', or nullptr if the extension was
+     * not loaded.
+     */
+    static std::shared_ptr<WiredTigerDictionaryCompression> get(WT_CONNECTION* conn);
+
+    WiredTigerDictionaryCompression(WT_CONNECTION* conn, boost::filesystem::path directory);
+
+    /**
+     * Registers the compressors found on disk. Called once, when the extension is loaded.
+     */
+    Status loadCompressors();
+
+    /**
+     * Creates and registers a new compressor for a record store, and returns the name to give as
+     * its "block_compressor". The compressor starts out without a dictionary.
+     */
+    StatusWith<std::string> addCompressor();
+
+    /**
+     * Returns whether 'compressorName' is one of the compressors registered here.
+     */
+    bool hasCompressor(StringData compressorName) const;
+
+    /**
+     * Returns the files of the compressors and of their dictionaries, which a backup of the data
+     * files must include. These files are never modified once they are listed.
+     */
+    std::vector<boost::filesystem::path> getBackupFiles() const;
+
+    /**
+     * Trains a dictionary of at most 'maxDictionarySize' bytes on 'samples', the concatenation of
+     * documents of the sizes in 'sampleSizes', and makes the compressor named 'compressorName' use
+     * it for the pages it compresses from then on. The dictionary is written to disk before it is
+     * used. Returns the size of the dictionary trained.
+     */
+    StatusWith<size_t> trainDictionary(StringData compressorName,
+                                       const std::string& samples,
+                                       const std::vector<size_t>& sampleSizes,
+                                       size_t maxDictionarySize);
+
+    class DictionarySet;
+
+private:
+    Status _registerCompressor(int id, std::shared_ptr<DictionarySet> dictionaries);
+
+    WT_CONNECTION* const _conn;
+    const boost::filesystem::path _directory;
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerDictionaryCompression::_mutex");
+    // Keyed by compressor name.
+    StringMap<std::shared_ptr<DictionarySet>> _compressors;
+    int _nextId = 1;
+};
+
+}  // namespace mongo
@@ -46,13 +46,17 @@ WiredTigerExtensions* WiredTigerExtensions::get(ServiceContext* service) {
     return &getConfigHooks(service);
 }
 
-std::string WiredTigerExtensions::getOpenExtensionsConfig() const {
-    if (_wtExtensions.size() == 0) {
+std::string WiredTigerExtensions::getOpenExtensionsConfig(
+    const std::vector<std::string>& engineExtensions) const {
+    if (engineExtensions.empty() && _wtExtensions.empty()) {
         return "";
     }
 
     StringBuilder extensions;
     extensions << "extensions=[";
+    for (const auto& ext : engineExtensions) {
+        extensions << ext << ",";
+    }
     for (const auto& ext : _wtExtensions) {
         extensions << ext << ",";
     }
@@ -43,9 +43,12 @@ public:
     static WiredTigerExtensions* get(ServiceContext* service);
 
     /**
-     * Return the `extensions=[...]` piece for a `wiredtiger_open` call.
+     * Return the `extensions=[...]` piece for a `wiredtiger_open` call, listing the extensions the
+     * storage engine always loads, in 'engineExtensions', ahead of the ones added here. WiredTiger
+     * only honours the last `extensions` setting, so they must all be given in one list.
      */
-    std::string getOpenExtensionsConfig() const;
+    std::string getOpenExtensionsConfig(
+        const std::vector<std::string>& engineExtensions = {}) const;
 
     /**
      * Add an item to the `wiredtiger_open` extensions list.
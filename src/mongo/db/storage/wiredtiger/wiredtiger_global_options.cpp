@@ -33,6 +33,7 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compression.h"
 #include "mongo/logv2/log.h"
 
 namespace moe = mongo::optionenvironment;
@@ -82,4 +83,18 @@ Status WiredTigerGlobalOptions::validateWiredTigerCompressor(const std::string&
     return Status::OK();
 }
 
+Status WiredTigerGlobalOptions::validateWiredTigerCollectionCompressor(const std::string& value) {
+    if (value == WiredTigerDictionaryCompression::kBlockCompressorName) {
+        return Status::OK();
+    }
+
+    auto status = validateWiredTigerCompressor(value);
+    if (!status.isOK()) {
+        return {ErrorCodes::BadValue,
+                "Compression option must be one of: 'none', 'snappy', 'zlib', 'zstd', or "
+                "'zstd-dict'"};
+    }
+    return status;
+}
+
 }  // namespace mongo
@@ -64,6 +64,14 @@ public:
 
     static Status validateWiredTigerCompressor(const std::string&);
 
+    /**
+     * Collections may also be compressed with dictionaries trained on their documents. That
+     * requires featureFlagZstdDictionaryCompression, which is only set after the options are
+     * validated, so it is checked when the storage engine starts and the FCV when a collection is
+     * created.
+     */
+    static Status validateWiredTigerCollectionCompressor(const std::string&);
+
     /**
      * Returns current history file size limit in MB.
      * Always returns 0 for unbounded.
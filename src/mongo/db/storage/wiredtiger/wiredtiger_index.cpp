@@ -51,6 +51,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
@@ -58,6 +59,7 @@
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/hex.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 #include "mongo/util/testing_proctor.h"
 
@@ -100,15 +102,28 @@ const int kDataFormatV4KeyStringV1UniqueIndexVersionV2 = 12;
 const int kMinimumIndexVersion = kDataFormatV1KeyStringV0IndexVersionV1;
 const int kMaximumIndexVersion = kDataFormatV4KeyStringV1UniqueIndexVersionV2;
 
-void WiredTigerIndex::setKey(WT_CURSOR* cursor, const WT_ITEM* item) {
-    cursor->set_key(cursor, item);
+void WiredTigerIndex::setKey(WT_CURSOR* cursor, const WT_ITEM* item) const {
+    if (_prefix) {
+        cursor->set_key(cursor, *_prefix, item);
+    } else {
+        cursor->set_key(cursor, item);
+    }
 }
 
-void WiredTigerIndex::getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key) {
-    invariantWTOK(cursor->get_key(cursor, key));
+bool WiredTigerIndex::getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key) const {
+    if (_prefix) {
+        std::int64_t prefix;
+        invariantWTOK(cursor->get_key(cursor, &prefix, key));
+        if (prefix != *_prefix) {
+            return false;
+        }
+    } else {
+        invariantWTOK(cursor->get_key(cursor, key));
+    }
 
     auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
     metricsCollector.incrementOneIdxEntryRead(key->size);
+    return true;
 }
 
 // static
@@ -160,7 +175,8 @@ StatusWith<std::string> WiredTigerIndex::generateCreateString(
     const std::string& sysIndexConfig,
     const std::string& collIndexConfig,
     const NamespaceString& collectionNamespace,
-    const IndexDescriptor& desc) {
+    const IndexDescriptor& desc,
+    bool prefixed) {
     str::stream ss;
 
     // Separate out a prefix and suffix in the default string. User configuration will override
@@ -198,8 +214,9 @@ StatusWith<std::string> WiredTigerIndex::generateCreateString(
     // WARNING: No user-specified config can appear below this line. These options are required
     // for correct behavior of the server.
 
-    // Indexes need to store the metadata for collation to work as expected.
-    ss << ",key_format=u";
+    // Indexes need to store the metadata for collation to work as expected. Shared tables precede
+    // the keys of every index with its prefix.
+    ss << (prefixed ? ",key_format=qu" : ",key_format=u");
     ss << ",value_format=u";
 
     // Index metadata
@@ -240,7 +257,8 @@ WiredTigerIndex::WiredTigerIndex(OperationContext* ctx,
                                  StringData ident,
                                  KeyFormat rsKeyFormat,
                                  const IndexDescriptor* desc,
-                                 bool isReadOnly)
+                                 bool isReadOnly,
+                                 boost::optional<int64_t> prefix)
     : SortedDataInterface(ident,
                           _handleVersionInfo(ctx, uri, desc, isReadOnly),
                           Ordering::make(desc->keyPattern())),
@@ -250,7 +268,8 @@ WiredTigerIndex::WiredTigerIndex(OperationContext* ctx,
       _indexName(desc->indexName()),
       _keyPattern(desc->keyPattern()),
       _collation(desc->collation()),
-      _rsKeyFormat(rsKeyFormat) {}
+      _rsKeyFormat(rsKeyFormat),
+      _prefix(prefix) {}
 
 NamespaceString WiredTigerIndex::getCollectionNamespace(OperationContext* opCtx) const {
     return _desc->getEntry()->getNSSFromCatalog(opCtx);
@@ -287,6 +306,29 @@ Status WiredTigerIndex::insert(OperationContext* opCtx,
     return _insert(opCtx, c, keyString, dupsAllowed);
 }
 
+Status WiredTigerIndex::insertBatch(OperationContext* opCtx,
+                                    const KeyStringSet& keys,
+                                    bool dupsAllowed) {
+    dassert(opCtx->lockState()->isWriteLocked());
+
+    // One cursor serves the whole batch, and since the keys are sorted, consecutive inserts tend
+    // to fall on the leaf page the previous one just brought into cache.
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    curwrap.assertInActiveTxn();
+    WT_CURSOR* c = curwrap.get();
+
+    for (const auto& keyString : keys) {
+        dassertRecordIdAtEnd(keyString, _rsKeyFormat);
+        LOGV2_TRACE_INDEX(5843133, "KeyString: {keyString}", "keyString"_attr = keyString);
+
+        Status status = _insert(opCtx, c, keyString, dupsAllowed);
+        if (!status.isOK()) {
+            return status;
+        }
+    }
+    return Status::OK();
+}
+
 void WiredTigerIndex::unindex(OperationContext* opCtx,
                               const KeyString::Value& keyString,
                               bool dupsAllowed) {
@@ -305,7 +347,9 @@ void WiredTigerIndex::fullValidate(OperationContext* opCtx,
                                    long long* numKeysOut,
                                    IndexValidateResults* fullResults) const {
     dassert(opCtx->lockState()->isReadLocked());
-    if (fullResults && !WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->isEphemeral()) {
+    // Verifying a shared table would require exclusive access to every index in it.
+    if (fullResults && !_prefix &&
+        !WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->isEphemeral()) {
         int err = WiredTigerUtil::verifyTable(opCtx, _uri, &(fullResults->errors));
         if (err == EBUSY) {
             std::string msg = str::stream()
@@ -415,6 +459,20 @@ bool WiredTigerIndex::isEmpty(OperationContext* opCtx) {
     WT_CURSOR* c = curwrap.get();
     if (!c)
         return true;
+    if (_prefix) {
+        // Look for the first entry at or after our prefix.
+        setKey(c, emptyItem.Get());
+        int cmp;
+        int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->search_near(c, &cmp); });
+        if (ret == 0 && cmp < 0) {
+            ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
+        }
+        if (ret == WT_NOTFOUND)
+            return true;
+        invariantWTOK(ret);
+        WT_ITEM item;
+        return !getKey(opCtx, c, &item);
+    }
     int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
     if (ret == WT_NOTFOUND)
         return true;
@@ -424,6 +482,10 @@ bool WiredTigerIndex::isEmpty(OperationContext* opCtx) {
 
 long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
     dassert(opCtx->lockState()->isReadLocked());
+    if (_prefix) {
+        // The blocks of a shared table are not attributed to the indexes living in it.
+        return 0;
+    }
     auto ru = WiredTigerRecoveryUnit::get(opCtx);
     WiredTigerSession* session = ru->getSession();
 
@@ -464,6 +526,9 @@ long long WiredTigerIndex::getSpaceUsedBytes(OperationContext* opCtx) const {
 
 long long WiredTigerIndex::getFreeStorageBytes(OperationContext* opCtx) const {
     dassert(opCtx->lockState()->isReadLocked());
+    if (_prefix) {
+        return 0;
+    }
     auto ru = WiredTigerRecoveryUnit::get(opCtx);
     WiredTigerSession* session = ru->getSession();
 
@@ -475,13 +540,15 @@ Status WiredTigerIndex::initAsEmpty(OperationContext* opCtx) {
     return Status::OK();
 }
 
-Status WiredTigerIndex::compact(OperationContext* opCtx) {
+Status WiredTigerIndex::compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) {
     dassert(opCtx->lockState()->isWriteLocked());
     WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
     if (!cache->isEphemeral()) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
-        int ret = s->compact(s, uri().c_str(), "timeout=0");
+        const std::string config = str::stream()
+            << "timeout=" << (timeLimit ? durationCount<Seconds>(*timeLimit) : 0);
+        int ret = s->compact(s, uri().c_str(), config.c_str());
         if (MONGO_unlikely(WTCompactIndexEBUSY.shouldFail())) {
             ret = EBUSY;
         }
@@ -491,6 +558,11 @@ Status WiredTigerIndex::compact(OperationContext* opCtx) {
                           str::stream() << "Compaction interrupted on " << uri().c_str()
                                         << " due to cache eviction pressure");
         }
+        if (ret == ETIMEDOUT) {
+            return Status(ErrorCodes::ExceededTimeLimit,
+                          str::stream() << "Compaction of " << uri().c_str()
+                                        << " did not finish within the time limit");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -564,18 +636,25 @@ public:
 
 protected:
     WT_CURSOR* openBulkCursor(WiredTigerIndex* idx) {
+        WT_CURSOR* cursor;
+        WT_SESSION* session = _session->getSession();
+        if (idx->_prefix) {
+            // Bulk cursors can only load empty tables, which a shared table seldom is.
+            invariantWTOK(
+                session->open_cursor(session, idx->uri().c_str(), nullptr, nullptr, &cursor));
+            return cursor;
+        }
+
         // Open cursors can cause bulk open_cursor to fail with EBUSY.
         // TODO any other cases that could cause EBUSY?
         WiredTigerSession* outerSession = WiredTigerRecoveryUnit::get(_opCtx)->getSession();
         outerSession->closeAllCursors(idx->uri());
 
         // Not using cursor cache since we need to set "bulk".
-        WT_CURSOR* cursor;
         // Use a different session to ensure we don't hijack an existing transaction.
         // Configure the bulk cursor open to fail quickly if it would wait on a checkpoint
         // completing - since checkpoints can take a long time, and waiting can result in
         // an unexpected pause in building an index.
-        WT_SESSION* session = _session->getSession();
         int err = session->open_cursor(
             session, idx->uri().c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
         if (!err)
@@ -592,10 +671,6 @@ protected:
         return cursor;
     }
 
-    void setKey(WT_CURSOR* cursor, const WT_ITEM* item) {
-        cursor->set_key(cursor, item);
-    }
-
     const Ordering _ordering;
     OperationContext* const _opCtx;
     UniqueWiredTigerSession const _session;
@@ -616,7 +691,7 @@ public:
 
         // Can't use WiredTigerCursor since we aren't using the cache.
         WiredTigerItem item(keyString.getBuffer(), keyString.getSize());
-        setKey(_cursor, item.Get());
+        _idx->setKey(_cursor, item.Get());
 
         const KeyString::TypeBits typeBits = keyString.getTypeBits();
         WiredTigerItem valueItem = typeBits.isAllZeros()
@@ -647,7 +722,7 @@ private:
  */
 class WiredTigerIndex::UniqueBulkBuilder : public BulkBuilder {
 public:
-    UniqueBulkBuilder(WiredTigerIndex* idx, OperationContext* opCtx, bool dupsAllowed)
+    UniqueBulkBuilder(WiredTigerIndexUnique* idx, OperationContext* opCtx, bool dupsAllowed)
         : BulkBuilder(idx, opCtx),
           _idx(idx),
           _dupsAllowed(dupsAllowed),
@@ -682,7 +757,7 @@ public:
 
         // Can't use WiredTigerCursor since we aren't using the cache.
         WiredTigerItem keyItem(newKeyString.getBuffer(), newKeyString.getSize());
-        setKey(_cursor, keyItem.Get());
+        _idx->setKey(_cursor, keyItem.Get());
 
         const KeyString::TypeBits typeBits = newKeyString.getTypeBits();
         WiredTigerItem valueItem = typeBits.isAllZeros()
@@ -693,6 +768,13 @@ public:
 
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
 
+        if (_idx->_keyFilter) {
+            _idx->_keyFilter->insert(
+                newKeyString.getBuffer(),
+                KeyString::sizeWithoutRecordIdAtEnd(newKeyString.getBuffer(),
+                                                    newKeyString.getSize()));
+        }
+
         auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
         metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
 
@@ -704,7 +786,7 @@ public:
     }
 
 private:
-    WiredTigerIndex* _idx;
+    WiredTigerIndexUnique* _idx;
     const bool _dupsAllowed;
     KeyString::Builder _previousKeyString;
 };
@@ -740,7 +822,7 @@ public:
         WiredTigerItem keyItem(newKeyString.getBuffer(), sizeWithoutRecordId);
         WiredTigerItem valueItem(value.getBuffer(), value.getSize());
 
-        setKey(_cursor, keyItem.Get());
+        _idx->setKey(_cursor, keyItem.Get());
         _cursor->set_value(_cursor, valueItem.Get());
 
         invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor));
@@ -962,14 +1044,11 @@ protected:
     }
 
     void setKey(WT_CURSOR* cursor, const WT_ITEM* item) {
-        cursor->set_key(cursor, item);
+        _idx.setKey(cursor, item);
     }
 
-    void getKey(WT_CURSOR* cursor, WT_ITEM* key) {
-        invariantWTOK(cursor->get_key(cursor, key));
-
-        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
-        metricsCollector.incrementOneIdxEntryRead(key->size);
+    bool getKey(WT_CURSOR* cursor, WT_ITEM* key) {
+        return _idx.getKey(_opCtx, cursor, key);
     }
 
     boost::optional<IndexKeyEntry> curr(RequestedInfo parts) const {
@@ -1080,7 +1159,13 @@ protected:
 
         WT_CURSOR* c = _cursor->get();
         WT_ITEM item;
-        getKey(c, &item);
+        if (!getKey(c, &item)) {
+            // We moved onto an entry of another index sharing the table.
+            _cursorAtEof = true;
+            _eof = true;
+            _id = RecordId();
+            return;
+        }
 
         const auto isForwardNextCall = _forward && inNext && !_key.isEmpty();
         if (isForwardNextCall) {
@@ -1242,7 +1327,7 @@ public:
             // know we are positioned correctly and have not skipped a record.
             WT_ITEM item;
             WT_CURSOR* c = _cursor->get();
-            getKey(c, &item);
+            const bool samePrefix = getKey(c, &item);
 
             // Get the size of the prefix key
             auto keySize = KeyString::getKeySize(
@@ -1251,7 +1336,8 @@ public:
             // This check is only to avoid returning the same key again after a restore. Keys
             // shorter than _key cannot have "prefix key" same as _key. Therefore we care only about
             // the keys with size greater than or equal to that of the _key.
-            if (item.size >= keySize && std::memcmp(_key.getBuffer(), item.data, keySize) == 0) {
+            if (samePrefix && item.size >= keySize &&
+                std::memcmp(_key.getBuffer(), item.data, keySize) == 0) {
                 _lastMoveSkippedKey = false;
                 LOGV2_TRACE_CURSOR(20092, "restore _lastMoveSkippedKey changed to false.");
             }
@@ -1326,13 +1412,68 @@ WiredTigerIndexUnique::WiredTigerIndexUnique(OperationContext* ctx,
                                              const std::string& uri,
                                              StringData ident,
                                              const IndexDescriptor* desc,
-                                             bool isReadOnly)
-    : WiredTigerIndex(ctx, uri, ident, KeyFormat::Long, desc, isReadOnly),
+                                             bool isReadOnly,
+                                             boost::optional<int64_t> prefix)
+    : WiredTigerIndex(ctx, uri, ident, KeyFormat::Long, desc, isReadOnly, prefix),
       _partial(desc->isPartial()) {
     // _id indexes must use WiredTigerIdIndex
     invariant(!isIdIndex());
     // All unique indexes should be in the timestamp-safe format version as of version 4.2.
     invariant(isTimestampSafeUniqueIdx());
+
+    // The key filter is built by scanning the whole table, which is shared by many indexes when
+    // there is a prefix.
+    if (gWiredTigerUniqueIndexBloomFilterBitsPerKey > 0 && !isReadOnly && !_prefix) {
+        _buildKeyFilter(ctx);
+    }
+}
+
+void WiredTigerIndexUnique::_buildKeyFilter(OperationContext* opCtx) {
+    // Scan on a session of our own so that the caller's transaction is left untouched. The scan
+    // sees every committed key: indexes are opened when nothing else can write to them.
+    auto session = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getSession();
+    WT_CURSOR* c = session->getNewCursor(_uri);
+    ON_BLOCK_EXIT([&] { session->closeCursor(c); });
+
+    // Size the filter to leave room for the index to double in size before it fills up. A full
+    // filter stays correct but lets more and more inserts through to the lookup.
+    const size_t kMinCapacity = 64 * 1024;
+    auto scan = [&](auto&& onKey) {
+        int ret;
+        while ((ret = c->next(c)) == 0) {
+            WT_ITEM item;
+            invariantWTOK(c->get_key(c, &item));
+            onKey(item);
+        }
+        invariantWTOK(c->reset(c));
+        return ret == WT_NOTFOUND;
+    };
+
+    size_t numKeys = 0;
+    std::unique_ptr<BlockedBloomFilter> filter;
+    bool complete = scan([&](const WT_ITEM&) { ++numKeys; });
+    if (complete) {
+        filter = std::make_unique<BlockedBloomFilter>(std::max(2 * numKeys, kMinCapacity),
+                                                      gWiredTigerUniqueIndexBloomFilterBitsPerKey);
+        complete = scan([&](const WT_ITEM& item) {
+            filter->insert(item.data, KeyString::sizeWithoutRecordIdAtEnd(item.data, item.size));
+        });
+    }
+    if (!complete) {
+        LOGV2(5843130,
+              "Could not build the key filter of a unique index",
+              "index"_attr = _indexName,
+              "uri"_attr = _uri);
+        return;
+    }
+
+    LOGV2_DEBUG(5843131,
+                1,
+                "Built the key filter of a unique index",
+                "index"_attr = _indexName,
+                "numKeys"_attr = numKeys,
+                "bytes"_attr = filter->memUsageBytes());
+    _keyFilter = std::move(filter);
 }
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexUnique::newCursor(
@@ -1377,8 +1518,8 @@ bool WiredTigerIndexUnique::_keyExists(OperationContext* opCtx,
 
     WT_ITEM item;
     // Obtain the key from the record returned by search near.
-    getKey(opCtx, c, &item);
-    if (std::memcmp(buffer, item.data, std::min(size, item.size)) == 0) {
+    if (getKey(opCtx, c, &item) &&
+        std::memcmp(buffer, item.data, std::min(size, item.size)) == 0) {
         return true;
     }
 
@@ -1396,8 +1537,8 @@ bool WiredTigerIndexUnique::_keyExists(OperationContext* opCtx,
     }
     invariantWTOK(ret);
 
-    getKey(opCtx, c, &item);
-    return std::memcmp(buffer, item.data, std::min(size, item.size)) == 0;
+    return getKey(opCtx, c, &item) &&
+        std::memcmp(buffer, item.data, std::min(size, item.size)) == 0;
 }
 
 bool WiredTigerIndexUnique::isDup(OperationContext* opCtx,
@@ -1415,9 +1556,9 @@ bool WiredTigerIndexUnique::isDup(OperationContext* opCtx,
 
     WT_ITEM item;
     if (ret == 0) {
-        getKey(opCtx, c, &item);
-        return std::memcmp(
-                   prefixKey.getBuffer(), item.data, std::min(prefixKey.getSize(), item.size)) == 0;
+        return getKey(opCtx, c, &item) &&
+            std::memcmp(
+                prefixKey.getBuffer(), item.data, std::min(prefixKey.getSize(), item.size)) == 0;
     }
 
     // Make sure that next call did not fail due to any other error but not found. In case of
@@ -1434,8 +1575,9 @@ WiredTigerIdIndex::WiredTigerIdIndex(OperationContext* ctx,
                                      const std::string& uri,
                                      StringData ident,
                                      const IndexDescriptor* desc,
-                                     bool isReadOnly)
-    : WiredTigerIndex(ctx, uri, ident, KeyFormat::Long, desc, isReadOnly) {
+                                     bool isReadOnly,
+                                     boost::optional<int64_t> prefix)
+    : WiredTigerIndex(ctx, uri, ident, KeyFormat::Long, desc, isReadOnly, prefix) {
     invariant(isIdIndex());
 }
 
@@ -1521,8 +1663,17 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
         ret = WT_OP_CHECK(wiredTigerCursorRemove(opCtx, c));
         invariantWTOK(ret);
 
+        // The key filter is consulted only after the first phase. Any concurrent insert of the
+        // same key has by now either conflicted with ours or committed before our snapshot was
+        // taken, in which case it had already added the key to the filter.
+        const bool mayExist =
+            !_keyFilter || _keyFilter->mayContain(keyString.getBuffer(), sizeWithoutRecordId);
+        if (_keyFilter) {
+            _keyFilter->insert(keyString.getBuffer(), sizeWithoutRecordId);
+        }
+
         // Second phase looks up for existence of key to avoid insertion of duplicate key
-        if (_keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
+        if (mayExist && _keyExists(opCtx, c, keyString.getBuffer(), sizeWithoutRecordId)) {
             auto key = KeyString::toBson(
                 keyString.getBuffer(), sizeWithoutRecordId, _ordering, keyString.getTypeBits());
             auto entry = _desc->getEntry();
@@ -1533,6 +1684,10 @@ Status WiredTigerIndexUnique::_insert(OperationContext* opCtx,
                                           _keyPattern,
                                           _collation);
         }
+    } else if (_keyFilter) {
+        _keyFilter->insert(
+            keyString.getBuffer(),
+            KeyString::sizeWithoutRecordIdAtEnd(keyString.getBuffer(), keyString.getSize()));
     }
 
     // Now create the table key/value, the actual data record.
@@ -1674,8 +1829,9 @@ WiredTigerIndexStandard::WiredTigerIndexStandard(OperationContext* ctx,
                                                  StringData ident,
                                                  KeyFormat rsKeyFormat,
                                                  const IndexDescriptor* desc,
-                                                 bool isReadOnly)
-    : WiredTigerIndex(ctx, uri, ident, rsKeyFormat, desc, isReadOnly) {}
+                                                 bool isReadOnly,
+                                                 boost::optional<int64_t> prefix)
+    : WiredTigerIndex(ctx, uri, ident, rsKeyFormat, desc, isReadOnly, prefix) {}
 
 std::unique_ptr<SortedDataInterface::Cursor> WiredTigerIndexStandard::newCursor(
     OperationContext* opCtx, bool forward) const {
@@ -37,6 +37,7 @@
 #include "mongo/db/storage/sorted_data_interface.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/util/blocked_bloom_filter.h"
 
 namespace mongo {
 
@@ -76,7 +77,8 @@ public:
                                                         const std::string& sysIndexConfig,
                                                         const std::string& collIndexConfig,
                                                         const NamespaceString& collectionNamespace,
-                                                        const IndexDescriptor& desc);
+                                                        const IndexDescriptor& desc,
+                                                        bool prefixed = false);
 
     /**
      * Creates a WiredTiger table suitable for implementing a MongoDB index.
@@ -91,18 +93,25 @@ public:
 
     /**
      * Constructs an index. The rsKeyFormat is the RecordId key format of the related RecordStore.
+     * When 'prefix' is set, the index lives in the shared table at 'uri', where its keys are
+     * preceded by the prefix.
      */
     WiredTigerIndex(OperationContext* ctx,
                     const std::string& uri,
                     StringData ident,
                     KeyFormat rsKeyFormat,
                     const IndexDescriptor* desc,
-                    bool readOnly);
+                    bool readOnly,
+                    boost::optional<int64_t> prefix = boost::none);
 
     virtual Status insert(OperationContext* opCtx,
                           const KeyString::Value& keyString,
                           bool dupsAllowed);
 
+    Status insertBatch(OperationContext* opCtx,
+                       const KeyStringSet& keys,
+                       bool dupsAllowed) override;
+
     virtual void unindex(OperationContext* opCtx,
                          const KeyString::Value& keyString,
                          bool dupsAllowed);
@@ -123,7 +132,7 @@ public:
 
     virtual Status initAsEmpty(OperationContext* opCtx);
 
-    Status compact(OperationContext* opCtx) override;
+    Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) override;
 
     const std::string& uri() const {
         return _uri;
@@ -159,6 +168,14 @@ public:
     virtual bool unique() const = 0;
     virtual bool isTimestampSafeUniqueIdx() const = 0;
 
+    void setKey(WT_CURSOR* cursor, const WT_ITEM* item) const;
+
+    /**
+     * Returns false without filling in 'key' if the entry the cursor is positioned on belongs to
+     * another index sharing the same table.
+     */
+    bool getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key) const;
+
 protected:
     virtual Status _insert(OperationContext* opCtx,
                            WT_CURSOR* c,
@@ -170,9 +187,6 @@ protected:
                           const KeyString::Value& keyString,
                           bool dupsAllowed) = 0;
 
-    void setKey(WT_CURSOR* cursor, const WT_ITEM* item);
-    void getKey(OperationContext* opCtx, WT_CURSOR* cursor, WT_ITEM* key);
-
     /*
      * Determines the data format version from application metadata and verifies compatibility.
      * Returns the corresponding KeyString version.
@@ -199,6 +213,8 @@ protected:
     const BSONObj _keyPattern;
     const BSONObj _collation;
     const KeyFormat _rsKeyFormat;
+    // Set when the index lives in a shared table.
+    const boost::optional<int64_t> _prefix;
 };
 
 class WiredTigerIndexUnique : public WiredTigerIndex {
@@ -207,7 +223,8 @@ public:
                           const std::string& uri,
                           StringData ident,
                           const IndexDescriptor* desc,
-                          bool readOnly = false);
+                          bool readOnly = false,
+                          boost::optional<int64_t> prefix = boost::none);
 
     std::unique_ptr<SortedDataInterface::Cursor> newCursor(OperationContext* opCtx,
                                                            bool forward) const override;
@@ -235,12 +252,25 @@ protected:
                   bool dupsAllowed) override;
 
 private:
+    friend class WiredTigerIndex::UniqueBulkBuilder;
+
     /**
      * If this returns true, the cursor will be positioned on the first matching the input 'key'.
      */
     bool _keyExists(OperationContext* opCtx, WT_CURSOR* c, const char* buffer, size_t size);
 
+    /**
+     * Fills '_keyFilter' with the prefix keys of every entry in the index. Leaves it unset if the
+     * index cannot be read in full.
+     */
+    void _buildKeyFilter(OperationContext* opCtx);
+
     bool _partial;
+
+    // Set when 'wiredTigerUniqueIndexBloomFilterBitsPerKey' is enabled. Holds the prefix key of
+    // every entry inserted into the index since it was opened, so an insert of a key the filter
+    // does not contain can skip the duplicate key lookup. Removed keys are never taken out.
+    std::unique_ptr<BlockedBloomFilter> _keyFilter;
 };
 
 class WiredTigerIdIndex : public WiredTigerIndex {
@@ -249,7 +279,8 @@ public:
                       const std::string& uri,
                       StringData ident,
                       const IndexDescriptor* desc,
-                      bool readOnly = false);
+                      bool readOnly = false,
+                      boost::optional<int64_t> prefix = boost::none);
 
     std::unique_ptr<Cursor> newCursor(OperationContext* opCtx,
                                       bool isForward = true) const override;
@@ -293,7 +324,8 @@ public:
                             StringData ident,
                             KeyFormat rsKeyFormat,
                             const IndexDescriptor* desc,
-                            bool readOnly = false);
+                            bool readOnly = false,
+                            boost::optional<int64_t> prefix = boost::none);
 
     std::unique_ptr<SortedDataInterface::Cursor> newCursor(OperationContext* opCtx,
                                                            bool forward) const override;
@@ -44,6 +44,8 @@
 #include "mongo/db/storage/storage_engine_lock_file.h"
 #include "mongo/db/storage/storage_engine_metadata.h"
 #include "mongo/db/storage/storage_options.h"
+#include "mongo/db/storage/storage_parameters_gen.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compression.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -71,6 +73,16 @@ public:
             LOGV2_WARNING(22302, "Recovering data from the last clean checkpoint.");
         }
 
+        // The block compressor option is validated before the feature flags are set, so the flag
+        // is only checked here.
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "The '" << WiredTigerDictionaryCompression::kBlockCompressorName
+                              << "' collection block compressor requires "
+                                 "featureFlagZstdDictionaryCompression to be enabled",
+                wiredTigerGlobalOptions.collectionBlockCompressor !=
+                        WiredTigerDictionaryCompression::kBlockCompressorName ||
+                    feature_flags::gZstdDictionaryCompression.isEnabledAndIgnoreFCV());
+
 #if defined(__linux__)
 // This is from <linux/magic.h> but that isn't available on all systems.
 // Note that the magic number for ext4 is the same as ext2 and ext3.
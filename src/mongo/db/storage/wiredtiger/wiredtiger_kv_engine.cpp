@@ -79,6 +79,7 @@
 #include "mongo/db/storage/storage_repair_observer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_dictionary_compression.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
@@ -86,11 +87,13 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_shared_tables.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
 #include "mongo/util/concurrency/ticketholder.h"
 #include "mongo/util/debug_util.h"
 #include "mongo/util/exit.h"
@@ -123,6 +126,20 @@ MONGO_FAIL_POINT_DEFINE(WTSetOldestTSToStableTS);
 
 const std::string kPinOldestTimestampAtStartupName = "_wt_startup";
 
+/**
+ * Returns true if a collection in 'ns' created with 'options', or one of its indexes, is stored in
+ * a shared table when 'wiredTigerSharedTables' is enabled. Only collections in user databases with
+ * the default storage options qualify.
+ */
+bool canShareTable(const NamespaceString& nss, const CollectionOptions& options) {
+    if (!gWiredTigerSharedTables || nss.isEmpty() || nss.isOnInternalDb() || nss.isSystem()) {
+        return false;
+    }
+    return !options.capped && !options.clusteredIndex && options.storageEngine.isEmpty() &&
+        wiredTigerGlobalOptions.collectionBlockCompressor !=
+        WiredTigerDictionaryCompression::kBlockCompressorName;
+}
+
 }  // namespace
 
 bool WiredTigerFileVersion::shouldDowngrade(bool readOnly,
@@ -218,6 +235,8 @@ public:
 
             _sessionCache->closeExpiredIdleSessions(gWiredTigerSessionCloseIdleTimeSecs.load() *
                                                     1000);
+            _sessionCache->closeExpiredIdleCursors(gWiredTigerCursorCloseIdleTimeSecs.load() *
+                                                   1000);
         }
         LOGV2_DEBUG(22304, 1, "stopping {name} thread", "name"_attr = name());
     }
@@ -260,8 +279,134 @@ std::string toString(const StorageEngine::OldestActiveTransactionTimestampResult
 namespace {
 TicketHolder openWriteTransaction(128);
 TicketHolder openReadTransaction(128);
+
+boost::optional<double> getCacheDirtyFractionFromSession(WT_SESSION* session) {
+    auto dirty = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    auto max = WiredTigerUtil::getStatisticsValue(
+        session, "statistics:", "statistics=(fast)", WT_STAT_CONN_CACHE_BYTES_MAX);
+    if (!dirty.isOK() || !max.isOK() || max.getValue() <= 0) {
+        return boost::none;
+    }
+    return static_cast<double>(dirty.getValue()) / max.getValue();
+}
 }  // namespace
 
+/**
+ * Periodically resizes the read and write ticket holders, each driven by an
+ * AdaptiveTicketController fed with the usage of the holder and the dirty fill ratio of the cache.
+ */
+class WiredTigerKVEngine::WiredTigerTicketTuner : public BackgroundJob {
+public:
+    explicit WiredTigerTicketTuner(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTTicketTuner";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(5843115, 1, "starting {name} thread", "name"_attr = name());
+
+        WiredTigerSession session(_conn);
+        TunedHolder read{"read", &openReadTransaction};
+        TunedHolder write{"write", &openWriteTransaction};
+        auto lastSampleTime = Date_t::now();
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(lock, kTuningInterval.toSystemDuration());
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            auto now = Date_t::now();
+            auto cacheDirtyRatio = _getCacheDirtyRatio(session.getSession());
+            read.tune(now - lastSampleTime, cacheDirtyRatio);
+            write.tune(now - lastSampleTime, cacheDirtyRatio);
+            lastSampleTime = now;
+        }
+        LOGV2_DEBUG(5843116, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    static constexpr Milliseconds kTuningInterval{200};
+
+    struct TunedHolder {
+        TunedHolder(StringData name, TicketHolder* holder)
+            : name(name), holder(holder), lastNumReleased(holder->numReleased()) {}
+
+        void tune(Milliseconds elapsed, double cacheDirtyRatio) {
+            // Start over from the current size whenever it was changed by someone else, typically
+            // by setting wiredTigerConcurrent{Read,Write}Transactions.
+            if (!controller || controller->limit() != holder->outof()) {
+                controller.emplace(holder->outof(),
+                                   std::min(gWiredTigerAdaptiveConcurrentTransactionsMin,
+                                            gWiredTigerAdaptiveConcurrentTransactionsMax),
+                                   gWiredTigerAdaptiveConcurrentTransactionsMax);
+            }
+
+            AdaptiveTicketController::Sample sample;
+            sample.used = holder->used();
+            sample.released = holder->numReleased() - lastNumReleased;
+            sample.elapsed = elapsed;
+            sample.cacheDirtyRatio = cacheDirtyRatio;
+            lastNumReleased += sample.released;
+
+            auto previous = holder->outof();
+            auto limit = controller->update(sample);
+            if (limit != previous) {
+                LOGV2_DEBUG(5843117,
+                            2,
+                            "Resizing concurrent transactions",
+                            "kind"_attr = name,
+                            "from"_attr = previous,
+                            "to"_attr = limit,
+                            "cacheDirtyRatio"_attr = cacheDirtyRatio);
+                // Shrinking waits for the tickets in excess to be released.
+                auto status = holder->resize(limit);
+                if (!status.isOK()) {
+                    LOGV2_DEBUG(5843118,
+                                1,
+                                "Failed to resize concurrent transactions",
+                                "kind"_attr = name,
+                                "error"_attr = status);
+                }
+            }
+        }
+
+        StringData name;
+        TicketHolder* holder;
+        long long lastNumReleased;
+        boost::optional<AdaptiveTicketController> controller;
+    };
+
+    double _getCacheDirtyRatio(WT_SESSION* session) const {
+        return getCacheDirtyFractionFromSession(session).value_or(0);
+    }
+
+    WT_CONNECTION* _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerTicketTuner::_mutex");  // protects _condvar
+    // The tuner thread idles on this condition variable between two samples. It can be triggered
+    // early to expedite shutdown.
+    stdx::condition_variable _condvar;
+};
+
 OpenWriteTransactionParam::OpenWriteTransactionParam(StringData name, ServerParameterType spt)
     : ServerParameter(name, spt), _data(&openWriteTransaction) {}
 
@@ -409,7 +554,9 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())
               ->getTableCreateConfig("system");
-    ss << WiredTigerExtensions::get(getGlobalServiceContext())->getOpenExtensionsConfig();
+    ss << WiredTigerExtensions::get(getGlobalServiceContext())
+              ->getOpenExtensionsConfig(
+                  {WiredTigerDictionaryCompression::getExtensionConfig(path)});
     ss << extraOpenOptions;
 
     if (!_durable) {
@@ -569,9 +716,17 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
     }
 
     _sizeStorer = std::make_unique<WiredTigerSizeStorer>(_conn, _sizeStorerUri, _readOnly);
+    if (!_ephemeral) {
+        _sharedTables = std::make_unique<WiredTigerSharedTables>(_conn, _readOnly);
+    }
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
+    if (gWiredTigerAdaptiveConcurrentTransactions) {
+        _ticketTuner = std::make_unique<WiredTigerTicketTuner>(_conn);
+        _ticketTuner->go();
+    }
+
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
     _runTimeConfigParam->_data.second = this;
@@ -599,6 +754,10 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        {
+            BSONObjBuilder queueBuilder(bbb.subobjStart("queue"));
+            openWriteTransaction.appendQueueStats(&queueBuilder);
+        }
         bbb.done();
     }
     {
@@ -606,6 +765,10 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        {
+            BSONObjBuilder queueBuilder(bbb.subobjStart("queue"));
+            openReadTransaction.appendQueueStats(&queueBuilder);
+        }
         bbb.done();
     }
     bb.done();
@@ -718,6 +881,9 @@ void WiredTigerKVEngine::cleanShutdown() {
         _sessionSweeper->shutdown();
         LOGV2(22319, "Finished shutting down session sweeper thread");
     }
+    if (_ticketTuner) {
+        _ticketTuner->shutdown();
+    }
     LOGV2_FOR_RECOVERY(23988,
                        2,
                        "Shutdown timestamps.",
@@ -726,6 +892,7 @@ void WiredTigerKVEngine::cleanShutdown() {
                        "Oldest Timestamp"_attr = Timestamp(_oldestTimestamp.load()));
 
     _sizeStorer.reset();
+    _sharedTables.reset();
     _sessionCache->shuttingDown();
 
     // We want WiredTiger to leak memory for faster shutdown except when we are running tools to
@@ -797,11 +964,19 @@ Status WiredTigerKVEngine::okToRename(OperationContext* opCtx,
 }
 
 int64_t WiredTigerKVEngine::getIdentSize(OperationContext* opCtx, StringData ident) {
+    if (_sharedTables && _sharedTables->find(ident)) {
+        // The blocks of a shared table are not attributed to the idents living in it.
+        return 0;
+    }
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
     return WiredTigerUtil::getIdentSize(session->getSession(), _uri(ident));
 }
 
 Status WiredTigerKVEngine::repairIdent(OperationContext* opCtx, StringData ident) {
+    if (_sharedTables && _sharedTables->find(ident)) {
+        // A shared table can only be salvaged as a whole.
+        return Status::OK();
+    }
     WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
     string uri = _uri(ident);
     session->closeAllCursors(uri);
@@ -1032,16 +1207,18 @@ public:
     explicit StreamingCursorImpl(WT_SESSION* session,
                                  std::string path,
                                  StorageEngine::BackupOptions options,
-                                 WiredTigerBackup* wtBackup)
+                                 WiredTigerBackup* wtBackup,
+                                 std::vector<boost::filesystem::path> dictionaryFiles)
         : StorageEngine::StreamingCursor(options),
           _session(session),
           _path(path),
-          _wtBackup(wtBackup){};
+          _wtBackup(wtBackup),
+          _dictionaryFiles(std::move(dictionaryFiles)){};
 
     ~StreamingCursorImpl() = default;
 
     StatusWith<std::vector<StorageEngine::BackupBlock>> getNextBatch(const std::size_t batchSize) {
-        int wtRet;
+        int wtRet = 0;
         std::vector<StorageEngine::BackupBlock> backupBlocks;
 
         stdx::lock_guard<Latch> backupCursorLk(_wtBackup->wtBackupCursorMutex);
@@ -1107,6 +1284,22 @@ public:
             return wtRCToStatus(wtRet);
         }
 
+        // The dictionaries of the 'zstd-dict' block compressors are not WiredTiger files, so they
+        // follow the files of the backup cursor. They are never modified, so even a subsequent
+        // incremental backup copies them whole.
+        while (wtRet == WT_NOTFOUND && backupBlocks.size() < batchSize &&
+               _nextDictionaryFile < _dictionaryFiles.size()) {
+            const auto& filePath = _dictionaryFiles[_nextDictionaryFile++];
+            boost::system::error_code errorCode;
+            const std::uint64_t fileSize = boost::filesystem::file_size(filePath, errorCode);
+            uassert(31403,
+                    "Failed to get a file's size. Filename: {} Error: {}"_format(
+                        filePath.string(), errorCode.message()),
+                    !errorCode);
+            const std::uint64_t length = options.incrementalBackup ? fileSize : 0;
+            backupBlocks.push_back({filePath.string(), 0 /* offset */, length, fileSize});
+        }
+
         return backupBlocks;
     }
 
@@ -1177,6 +1370,9 @@ private:
     WT_SESSION* _session;
     std::string _path;
     WiredTigerBackup* _wtBackup;  // '_wtBackup' is an out parameter.
+
+    const std::vector<boost::filesystem::path> _dictionaryFiles;
+    size_t _nextDictionaryFile = 0;
 };
 
 }  // namespace
@@ -1228,8 +1424,14 @@ WiredTigerKVEngine::beginNonBlockingBackup(OperationContext* opCtx,
 
     invariant(_wtBackup.logFilePathsSeenByExtendBackupCursor.empty());
     invariant(_wtBackup.logFilePathsSeenByGetNextBatch.empty());
-    auto streamingCursor =
-        std::make_unique<StreamingCursorImpl>(session, _path, options, &_wtBackup);
+    // The dictionaries in use are listed along with the checkpoint of the backup cursor, which
+    // only has pages compressed with them.
+    std::vector<boost::filesystem::path> dictionaryFiles;
+    if (auto dictionaryCompression = WiredTigerDictionaryCompression::get(_conn)) {
+        dictionaryFiles = dictionaryCompression->getBackupFiles();
+    }
+    auto streamingCursor = std::make_unique<StreamingCursorImpl>(
+        session, _path, options, &_wtBackup, std::move(dictionaryFiles));
 
     pinOplogGuard.dismiss();
     _backupSession = std::move(sessionRaii);
@@ -1336,6 +1538,21 @@ Status WiredTigerKVEngine::createRecordStore(OperationContext* opCtx,
                                              StringData ns,
                                              StringData ident,
                                              const CollectionOptions& options) {
+    if (_sharedTables && canShareTable(NamespaceString(ns), options)) {
+        StatusWith<std::string> result = WiredTigerRecordStore::generateCreateString(
+            _canonicalName, ns, options, _rsOptions, /*prefixed=*/true);
+        if (!result.isOK()) {
+            return result.getStatus();
+        }
+        LOGV2_DEBUG(5843138,
+                    2,
+                    "WiredTigerKVEngine::createRecordStore in a shared table",
+                    "ns"_attr = ns,
+                    "ident"_attr = ident);
+        return _sharedTables->add(
+            ident, WiredTigerSharedTables::Kind::kRecordStore, result.getValue());
+    }
+
     _ensureIdentPath(ident);
     WiredTigerSession session(_conn);
 
@@ -1346,6 +1563,34 @@ Status WiredTigerKVEngine::createRecordStore(OperationContext* opCtx,
     }
     std::string config = result.getValue();
 
+    // A record store compressed with trained dictionaries gets a compressor of its own, which the
+    // dictionaries trained on its documents are added to. Below the latest FCV, which includes
+    // startup before the FCV is known, it is compressed with plain zstd instead, so that the
+    // binaries of the downgraded version can read it.
+    WT_CONFIG_ITEM blockCompressor;
+    if (WiredTigerConfigParser(config).get("block_compressor", &blockCompressor) == 0 &&
+        StringData(blockCompressor.str, blockCompressor.len) ==
+            WiredTigerDictionaryCompression::kBlockCompressorName) {
+        if (feature_flags::gZstdDictionaryCompression.isEnabled(
+                serverGlobalParams.featureCompatibility)) {
+            auto dictionaryCompression = WiredTigerDictionaryCompression::get(_conn);
+            invariant(dictionaryCompression);
+            auto compressor = dictionaryCompression->addCompressor();
+            if (!compressor.isOK()) {
+                return compressor.getStatus();
+            }
+            config += ",block_compressor=" + compressor.getValue();
+        } else {
+            LOGV2_DEBUG(5843142,
+                        1,
+                        "Compressing a record store with zstd, as dictionary compression is not "
+                        "enabled in the current FCV",
+                        "ns"_attr = ns,
+                        "ident"_attr = ident);
+            config += ",block_compressor=zstd";
+        }
+    }
+
     string uri = _uri(ident);
     WT_SESSION* s = session.getSession();
     LOGV2_DEBUG(22331,
@@ -1486,7 +1731,14 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::getRecordStore(OperationContext
     }
 
     std::unique_ptr<WiredTigerRecordStore> ret;
-    ret = std::make_unique<StandardWiredTigerRecordStore>(this, opCtx, params);
+    auto shared = _sharedTables ? _sharedTables->find(ident) : boost::none;
+    if (shared) {
+        invariant(shared->kind == WiredTigerSharedTables::Kind::kRecordStore);
+        params.prefix = shared->prefix;
+        ret = std::make_unique<PrefixedWiredTigerRecordStore>(this, opCtx, params);
+    } else {
+        ret = std::make_unique<StandardWiredTigerRecordStore>(this, opCtx, params);
+    }
     ret->postConstructorInit(opCtx);
 
     // Sizes should always be checked when creating a collection during rollback or replication
@@ -1511,8 +1763,6 @@ Status WiredTigerKVEngine::createSortedDataInterface(OperationContext* opCtx,
                                                      const CollectionOptions& collOptions,
                                                      StringData ident,
                                                      const IndexDescriptor* desc) {
-    _ensureIdentPath(ident);
-
     std::string collIndexOptions;
 
     if (auto storageEngineOptions = collOptions.indexOptionDefaults.getStorageEngine()) {
@@ -1525,14 +1775,34 @@ Status WiredTigerKVEngine::createSortedDataInterface(OperationContext* opCtx,
         ? *CollectionCatalog::get(opCtx)->lookupNSSByUUID(opCtx, *collOptions.uuid)
         : NamespaceString();
 
+    const bool prefixed = _sharedTables && canShareTable(ns, collOptions) &&
+        desc->version() >= IndexDescriptor::IndexVersion::kV2 &&
+        !collOptions.indexOptionDefaults.getStorageEngine() &&
+        !desc->infoObj().hasField("storageEngine");
+
     StatusWith<std::string> result = WiredTigerIndex::generateCreateString(
-        _canonicalName, _indexOptions, collIndexOptions, ns, *desc);
+        _canonicalName, _indexOptions, collIndexOptions, ns, *desc, prefixed);
     if (!result.isOK()) {
         return result.getStatus();
     }
 
     std::string config = result.getValue();
 
+    if (prefixed) {
+        // Standard and _id indexes share the table of the same data format version.
+        const auto kind = desc->unique() && !desc->isIdIndex()
+            ? WiredTigerSharedTables::Kind::kUniqueIndex
+            : WiredTigerSharedTables::Kind::kStandardIndex;
+        LOGV2_DEBUG(5843139,
+                    2,
+                    "WiredTigerKVEngine::createSortedDataInterface in a shared table",
+                    "collection_uuid"_attr = collOptions.uuid,
+                    "ident"_attr = ident);
+        return _sharedTables->add(ident, kind, config);
+    }
+
+    _ensureIdentPath(ident);
+
     LOGV2_DEBUG(
         22336,
         2,
@@ -1561,6 +1831,10 @@ Status WiredTigerKVEngine::importSortedDataInterface(OperationContext* opCtx,
 }
 
 Status WiredTigerKVEngine::dropSortedDataInterface(OperationContext* opCtx, StringData ident) {
+    if (_sharedTables && _sharedTables->find(ident)) {
+        _sharedTables->remove(ident);
+        return Status::OK();
+    }
     return wtRCToStatus(WiredTigerIndex::Drop(opCtx, _uri(ident)));
 }
 
@@ -1569,18 +1843,25 @@ std::unique_ptr<SortedDataInterface> WiredTigerKVEngine::getSortedDataInterface(
     const CollectionOptions& collOptions,
     StringData ident,
     const IndexDescriptor* desc) {
+    std::string uri = _uri(ident);
+    boost::optional<int64_t> prefix;
+    if (auto shared = _sharedTables ? _sharedTables->find(ident) : boost::none) {
+        uri = WiredTigerSharedTables::uriFor(shared->kind);
+        prefix = shared->prefix;
+    }
+
     if (desc->isIdIndex()) {
         invariant(!collOptions.clusteredIndex);
-        return std::make_unique<WiredTigerIdIndex>(opCtx, _uri(ident), ident, desc, _readOnly);
+        return std::make_unique<WiredTigerIdIndex>(opCtx, uri, ident, desc, _readOnly, prefix);
     }
     if (desc->unique()) {
         invariant(!collOptions.clusteredIndex);
-        return std::make_unique<WiredTigerIndexUnique>(opCtx, _uri(ident), ident, desc, _readOnly);
+        return std::make_unique<WiredTigerIndexUnique>(opCtx, uri, ident, desc, _readOnly, prefix);
     }
 
     auto keyFormat = (collOptions.clusteredIndex) ? KeyFormat::String : KeyFormat::Long;
     return std::make_unique<WiredTigerIndexStandard>(
-        opCtx, _uri(ident), ident, keyFormat, desc, _readOnly);
+        opCtx, uri, ident, keyFormat, desc, _readOnly, prefix);
 }
 
 std::unique_ptr<RecordStore> WiredTigerKVEngine::makeTemporaryRecordStore(OperationContext* opCtx,
@@ -1631,6 +1912,15 @@ std::unique_ptr<RecordStore> WiredTigerKVEngine::makeTemporaryRecordStore(Operat
 Status WiredTigerKVEngine::dropIdent(RecoveryUnit* ru,
                                      StringData ident,
                                      StorageEngine::DropIdentCallback&& onDrop) {
+    if (_sharedTables && _sharedTables->find(ident)) {
+        // Only the entries of the ident are deleted, so the shared table is never busy.
+        _sharedTables->remove(ident);
+        if (onDrop) {
+            onDrop();
+        }
+        return Status::OK();
+    }
+
     string uri = _uri(ident);
 
     WiredTigerRecoveryUnit* wtRu = checked_cast<WiredTigerRecoveryUnit*>(ru);
@@ -1866,6 +2156,9 @@ void WiredTigerKVEngine::checkpoint() {
 }
 
 bool WiredTigerKVEngine::hasIdent(OperationContext* opCtx, StringData ident) const {
+    if (_sharedTables && _sharedTables->find(ident)) {
+        return true;
+    }
     return _hasUri(WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession(), _uri(ident));
 }
 
@@ -1904,7 +2197,7 @@ std::vector<std::string> WiredTigerKVEngine::getAllIdents(OperationContext* opCt
             continue;
 
         StringData ident = key.substr(idx + 1);
-        if (ident == "sizeStorer")
+        if (ident == "sizeStorer" || WiredTigerSharedTables::isSharedTableIdent(ident))
             continue;
 
         all.push_back(ident.toString());
@@ -1912,6 +2205,11 @@ std::vector<std::string> WiredTigerKVEngine::getAllIdents(OperationContext* opCt
 
     fassert(50663, ret == WT_NOTFOUND);
 
+    if (_sharedTables) {
+        auto shared = _sharedTables->getAllIdents();
+        all.insert(all.end(), shared.begin(), shared.end());
+    }
+
     return all;
 }
 
@@ -2487,6 +2785,23 @@ Timestamp WiredTigerKVEngine::getCheckpointTimestamp() const {
     return Timestamp(_getCheckpointTimestamp());
 }
 
+boost::optional<double> WiredTigerKVEngine::getCacheDirtyFraction() const {
+    WiredTigerSession session(_conn);
+    return getCacheDirtyFractionFromSession(session.getSession());
+}
+
+boost::optional<int64_t> WiredTigerKVEngine::getCacheDirtyBytes() const {
+    WiredTigerSession session(_conn);
+    auto dirty = WiredTigerUtil::getStatisticsValue(session.getSession(),
+                                                    "statistics:",
+                                                    "statistics=(fast)",
+                                                    WT_STAT_CONN_CACHE_BYTES_DIRTY);
+    if (!dirty.isOK()) {
+        return boost::none;
+    }
+    return dirty.getValue();
+}
+
 std::uint64_t WiredTigerKVEngine::_getCheckpointTimestamp() const {
     char buf[(2 * 8 /*bytes in hex*/) + 1 /*nul terminator*/];
     invariantWTOK(_conn->query_timestamp(_conn, buf, "get=last_checkpoint"));
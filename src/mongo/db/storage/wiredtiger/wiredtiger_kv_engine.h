@@ -55,6 +55,7 @@ class ClockSource;
 class JournalListener;
 class WiredTigerRecordStore;
 class WiredTigerSessionCache;
+class WiredTigerSharedTables;
 class WiredTigerSizeStorer;
 class WiredTigerEngineRuntimeConfigParameter;
 
@@ -307,6 +308,9 @@ public:
     Timestamp getOldestTimestamp() const override;
     Timestamp getCheckpointTimestamp() const override;
 
+    boost::optional<double> getCacheDirtyFraction() const override;
+    boost::optional<int64_t> getCacheDirtyBytes() const override;
+
     /**
      * Returns the data file path associated with an ident on disk. Returns boost::none if the data
      * file can not be found. This will attempt to locate a file even if the storage engine's own
@@ -364,6 +368,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerTicketTuner;
 
     struct IdentToDrop {
         std::string uri;
@@ -444,6 +449,9 @@ private:
     std::string _sizeStorerUri;
     mutable ElapsedTracker _sizeStorerSyncTracker;
 
+    // Null for the in-memory engine, whose collections never share tables.
+    std::unique_ptr<WiredTigerSharedTables> _sharedTables;
+
     bool _durable;
     bool _ephemeral;  // whether we are using the in-memory mode of the WT engine
     const bool _inRepairMode;
@@ -457,6 +465,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerTicketTuner> _ticketTuner;
 
     std::string _rsOptions;
     std::string _indexOptions;
@@ -46,6 +46,7 @@
 #include "mongo/db/storage/checkpointer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/unittest/log_test.h"
 #include "mongo/unittest/temp_dir.h"
@@ -396,6 +397,88 @@ TEST_F(WiredTigerKVEngineTest, IdentDrop) {
     ASSERT(boost::filesystem::exists(renamedFilePath));
 }
 
+TEST_F(WiredTigerKVEngineTest, SharedTablesKeepRecordStoresApart) {
+    RAIIServerParameterControllerForTest sharedTables("wiredTigerSharedTables", true);
+    auto opCtxPtr = _makeOperationContext();
+    auto opCtx = opCtxPtr.get();
+
+    NamespaceString nss("a.b");
+    CollectionOptions defaultCollectionOptions;
+    const std::vector<std::string> idents = {"collection-1", "collection-2", "collection-3"};
+
+    std::vector<std::unique_ptr<RecordStore>> rss;
+    for (const auto& ident : idents) {
+        ASSERT_OK(_engine->createRecordStore(opCtx, nss.ns(), ident, defaultCollectionOptions));
+        rss.push_back(_engine->getRecordStore(opCtx, nss.ns(), ident, defaultCollectionOptions));
+        ASSERT(rss.back());
+        ASSERT(_engine->hasIdent(opCtx, ident));
+
+        // The record store does not get a table of its own.
+        ASSERT(!_engine->getDataFilePathForIdent(ident));
+    }
+
+    // Record store 'i' holds 'i + 1' records, all of them with the same RecordIds as the records
+    // of the other record stores.
+    for (size_t i = 0; i < rss.size(); ++i) {
+        WriteUnitOfWork uow(opCtx);
+        for (size_t j = 0; j <= i; ++j) {
+            std::string record = str::stream() << i << "-" << j;
+            ASSERT_OK(rss[i]
+                          ->insertRecord(opCtx, record.c_str(), record.length() + 1, Timestamp())
+                          .getStatus());
+        }
+        uow.commit();
+    }
+
+    // Counts the records of record store 'i', checking that they all belong to it.
+    auto countRecords = [&](size_t i, bool forward) {
+        size_t count = 0;
+        auto cursor = rss[i]->getCursor(opCtx, forward);
+        while (auto record = cursor->next()) {
+            ASSERT(StringData(record->data.data()).startsWith(std::to_string(i) + "-"));
+            ++count;
+        }
+        return count;
+    };
+    for (size_t i = 0; i < rss.size(); ++i) {
+        ASSERT_EQ(i + 1, countRecords(i, /*forward=*/true));
+        ASSERT_EQ(i + 1, countRecords(i, /*forward=*/false));
+    }
+
+    // Seeking near a RecordId outside of a record store finds its closest record.
+    auto cursor = rss[1]->getCursor(opCtx, /*forward=*/true);
+    auto record = cursor->seekNear(RecordId(100));
+    ASSERT(record);
+    ASSERT_EQ(RecordId(2), record->id);
+    ASSERT_EQ("1-1", StringData(record->data.data()));
+    record = cursor->seekNear(RecordId(0));
+    ASSERT(record);
+    ASSERT_EQ(RecordId(1), record->id);
+    ASSERT_EQ("1-0", StringData(record->data.data()));
+    cursor.reset();
+
+    // Truncating or dropping a record store leaves the others alone.
+    {
+        WriteUnitOfWork uow(opCtx);
+        ASSERT_OK(rss[1]->truncate(opCtx));
+        uow.commit();
+    }
+    ASSERT_EQ(0U, countRecords(1, /*forward=*/true));
+    ASSERT_FALSE(rss[1]->getCursor(opCtx, /*forward=*/true)->seekNear(RecordId(1)));
+    ASSERT_EQ(1U, countRecords(0, /*forward=*/true));
+    ASSERT_EQ(3U, countRecords(2, /*forward=*/false));
+
+    rss[2].reset();
+    opCtx->recoveryUnit()->abandonSnapshot();
+    ASSERT_OK(_engine->dropIdent(opCtx->recoveryUnit(), idents[2]));
+    ASSERT_FALSE(_engine->hasIdent(opCtx, idents[2]));
+    ASSERT_EQ(1U, countRecords(0, /*forward=*/false));
+
+    auto allIdents = _engine->getAllIdents(opCtx);
+    ASSERT_EQ(1, std::count(allIdents.begin(), allIdents.end(), idents[0]));
+    ASSERT_EQ(0, std::count(allIdents.begin(), allIdents.end(), idents[2]));
+}
+
 TEST_F(WiredTigerKVEngineTest, TestBasicPinOldestTimestamp) {
     auto opCtxRaii = _makeOperationContext();
     const Timestamp initTs = Timestamp(1, 0);
@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include <cstring>
+#include <limits>
 
 #include "mongo/db/concurrency/lock_state.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
@@ -40,16 +41,15 @@
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
-#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(WTPauseOplogVisibilityUpdateLoop);
 
-// Arbitrary. Using the storageGlobalParams.journalCommitIntervalMs default, which used to
-// dynamically control the visibility thread's delay back when the visibility thread also flushed
-// the journal.
-const int kDelayMillis = 100;
+// The number of visibility updates a committing thread runs before it leaves the remaining ones to
+// the visibility thread, which bounds the latency added to that commit when commits arrive faster
+// than the updates run.
+const int kMaxVisibilityUpdatesOnCommit = 2;
 
 void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
                                                    WiredTigerRecordStore* oplogRecordStore) {
@@ -77,10 +77,10 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
     // Need to obtain the mutex before starting the thread, as otherwise it may race ahead
     // see _shuttingDown as true and quit prematurely.
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    _oplogVisibilityThread = stdx::thread(&WiredTigerOplogManager::_updateOplogVisibilityLoop,
-                                          this,
-                                          WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
-                                          oplogRecordStore);
+    _sessionCache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    _oplogRecordStore = oplogRecordStore;
+    _oplogVisibilityThread =
+        stdx::thread(&WiredTigerOplogManager::_updateOplogVisibilityLoop, this);
 
     _isRunning = true;
     _shuttingDown = false;
@@ -88,7 +88,7 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
 
 void WiredTigerOplogManager::haltVisibilityThread() {
     {
-        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
         if (!_isRunning) {
             // This is called from two places; on clean shutdown and when the record store for the
             // oplog is destroyed. We will perform the actual shutdown on the first call and the
@@ -102,20 +102,32 @@ void WiredTigerOplogManager::haltVisibilityThread() {
 
         _shuttingDown = true;
         _isRunning = false;
+        _oplogVisibilityThreadCV.notify_all();
+
+        // A committing thread may be in the middle of an update, which uses the oplog record store.
+        _oplogVisibilityThreadCV.wait(lk, [&] { return !_visibilityUpdateInProgress; });
     }
 
     if (_oplogVisibilityThread.joinable()) {
-        _oplogVisibilityThreadCV.notify_one();
         _oplogVisibilityThread.join();
     }
 }
 
 void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
-    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    if (!_triggerOplogVisibilityUpdate) {
-        _triggerOplogVisibilityUpdate = true;
-        _oplogVisibilityThreadCV.notify_one();
+    stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
+    _triggerOplogVisibilityUpdate = true;
+    if (!_isRunning || _shuttingDown || _visibilityUpdateInProgress) {
+        // The thread running the updates will pick this commit up in its next pass.
+        return;
+    }
+
+    if (MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
+        _oplogVisibilityThreadCV.notify_all();
+        return;
     }
+
+    _visibilityUpdateInProgress = true;
+    _runPendingOplogVisibilityUpdates(lk, kMaxVisibilityUpdatesOnCommit);
 }
 
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
@@ -144,16 +156,9 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
 
     stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
 
-    // Prevent any scheduled oplog visibility updates from being delayed for batching and blocking
-    // this wait excessively.
-    ++_opsWaitingForOplogVisibilityUpdate;
-    invariant(_opsWaitingForOplogVisibilityUpdate > 0);
-    auto exitGuard = makeGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
-
     // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
-    // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
-    // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
-    // holes.
+    // update the oplog visibility. We simply need to wait until all of the writes behind and
+    // including 'waitingFor' commit so there are no oplog holes.
     opCtx->waitForConditionOrInterrupt(_oplogEntriesBecameVisibleCV, lk, [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
@@ -182,39 +187,20 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     });
 }
 
-void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
-                                                        WiredTigerRecordStore* oplogRecordStore) {
+void WiredTigerOplogManager::_updateOplogVisibilityLoop() {
     Client::initThread("OplogVisibilityThread");
 
-    // This thread updates the oplog read timestamp, the timestamp used to read from the oplog with
-    // forward cursors. The timestamp is used to hide oplog entries that might be committed but have
-    // uncommitted entries behind them. This prevents cursors from seeing 'holes' in the oplog and
-    // consequently missing data that was not there yet when scanning went passed up to a later
-    // timestamp.
+    // This thread runs the oplog visibility updates that committing threads leave behind, either
+    // because they stopped after kMaxVisibilityUpdatesOnCommit passes or because updates are
+    // paused by the WTPauseOplogVisibilityUpdateLoop failpoint.
     while (true) {
         stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
         {
             MONGO_IDLE_THREAD_BLOCK;
-            _oplogVisibilityThreadCV.wait(
-                lk, [&] { return _shuttingDown || _triggerOplogVisibilityUpdate; });
-
-            // If we are not shutting down and nobody is actively waiting for the oplog to become
-            // visible, delay a bit to batch more requests into one update and reduce system load.
-            auto now = Date_t::now();
-            auto deadline = now + Milliseconds(kDelayMillis);
-
-            auto wakeUpEarlyForWaitersPredicate = [&] {
-                return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
-                    oplogRecordStore->haveCappedWaiters();
-            };
-
-            // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
-            while (now < deadline &&
-                   !_oplogVisibilityThreadCV.wait_until(
-                       lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
-                now += Milliseconds(1);
-            }
+            _oplogVisibilityThreadCV.wait(lk, [&] {
+                return _shuttingDown ||
+                    (_triggerOplogVisibilityUpdate && !_visibilityUpdateInProgress);
+            });
         }
 
         while (!_shuttingDown && MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
@@ -228,41 +214,68 @@ void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache*
             return;
         }
 
-        invariant(_triggerOplogVisibilityUpdate);
-        _triggerOplogVisibilityUpdate = false;
+        // A committing thread may have run the updates while the mutex was released above.
+        if (!_triggerOplogVisibilityUpdate || _visibilityUpdateInProgress) {
+            continue;
+        }
+
+        _visibilityUpdateInProgress = true;
+        _runPendingOplogVisibilityUpdates(lk, std::numeric_limits<int>::max());
+    }
+}
+
+void WiredTigerOplogManager::_runPendingOplogVisibilityUpdates(stdx::unique_lock<Latch>& lk,
+                                                               int maxPasses) {
+    invariant(_visibilityUpdateInProgress);
 
+    // Every commit which arrives while an update is running only sets the trigger, so one pass
+    // makes all of them visible at once.
+    for (int pass = 0; pass < maxPasses && _triggerOplogVisibilityUpdate && !_shuttingDown;
+         ++pass) {
+        _triggerOplogVisibilityUpdate = false;
         lk.unlock();
+        _updateOplogReadTimestamp();
+        lk.lock();
+    }
 
-        // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
-        // any holes behind it in-memory.
-        const uint64_t newTimestamp = sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
+    _visibilityUpdateInProgress = false;
 
-        // The newTimestamp may actually go backward during secondary batch application,
-        // where we commit data file changes separately from oplog changes, so ignore
-        // a non-incrementing timestamp.
-        if (newTimestamp <= _oplogReadTimestamp.load()) {
-            LOGV2_DEBUG(22373,
-                        2,
-                        "No new oplog entries became visible.",
-                        "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
-            continue;
-        }
+    // Wakes up the visibility thread if updates are still pending, and haltVisibilityThread() if
+    // it is waiting for this update to finish.
+    _oplogVisibilityThreadCV.notify_all();
+}
 
-        lk.lock();
+void WiredTigerOplogManager::_updateOplogReadTimestamp() {
+    // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
+    // any holes behind it in-memory.
+    const uint64_t newTimestamp = _sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
+
+    // The newTimestamp may actually go backward during secondary batch application,
+    // where we commit data file changes separately from oplog changes, so ignore
+    // a non-incrementing timestamp.
+    if (newTimestamp <= _oplogReadTimestamp.load()) {
+        LOGV2_DEBUG(22373,
+                    2,
+                    "No new oplog entries became visible.",
+                    "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
+        return;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
         // Publish the new timestamp value. Avoid going backward.
         auto currentVisibleTimestamp = getOplogReadTimestamp();
         if (newTimestamp > currentVisibleTimestamp) {
             _setOplogReadTimestamp(lk, newTimestamp);
         }
-        lk.unlock();
-
-        // Wake up any awaitData cursors and tell them more data might be visible now.
-        //
-        // We normally notify waiters on capped collection inserts/updates, but oplog entries will
-        // not become visible immediately upon insert, so we notify waiters here as well, when new
-        // oplog entries actually become visible to cursors.
-        oplogRecordStore->notifyCappedWaitersIfNeeded();
     }
+
+    // Wake up any awaitData cursors and tell them more data might be visible now.
+    //
+    // We normally notify waiters on capped collection inserts/updates, but oplog entries will
+    // not become visible immediately upon insert, so we notify waiters here as well, when new
+    // oplog entries actually become visible to cursors.
+    _oplogRecordStore->notifyCappedWaitersIfNeeded();
 }
 
 std::uint64_t WiredTigerOplogManager::getOplogReadTimestamp() const {
@@ -44,7 +44,11 @@ class WiredTigerSessionCache;
  * Manages oplog visibility.
  *
  * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * The update is run by the thread committing the write which requested it, so that filling an
+ * oplog hole makes the entries behind it visible without waiting on another thread. Only one
+ * thread runs updates at a time; commits that arrive while an update is running are batched into
+ * its next pass. The thread that startVisibilityThread() sets up takes over the updates a
+ * committing thread leaves behind.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -75,7 +79,8 @@ public:
     }
 
     /**
-     * Signals the oplog visibility thread to update the oplog read timestamp.
+     * Updates the oplog read timestamp, or, if another thread is already updating it, makes that
+     * thread run another update once it is done.
      */
     void triggerOplogVisibilityUpdate();
 
@@ -100,11 +105,23 @@ public:
 
 private:
     /**
-     * Runs the oplog visibility updates when signaled by triggerOplogVisibilityUpdate() until
+     * Runs the oplog visibility updates left behind by triggerOplogVisibilityUpdate() until
      * _shuttingDown is set to true.
      */
-    void _updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
-                                    WiredTigerRecordStore* oplogRecordStore);
+    void _updateOplogVisibilityLoop();
+
+    /**
+     * Runs pending oplog visibility updates until there are none left or 'maxPasses' updates have
+     * run, and then gives up the role of the updating thread. Must be called with
+     * _visibilityUpdateInProgress set by the caller.
+     */
+    void _runPendingOplogVisibilityUpdates(stdx::unique_lock<Latch>& lk, int maxPasses);
+
+    /**
+     * Fetches the all_durable timestamp, publishes it as the oplog read timestamp if it moved
+     * forward and wakes up any awaitData cursors on the oplog.
+     */
+    void _updateOplogReadTimestamp();
 
     void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
 
@@ -112,7 +129,12 @@ private:
 
     stdx::thread _oplogVisibilityThread;
 
-    // Signaled to trigger the oplog visibility thread to run.
+    // Set by startVisibilityThread() and used by whichever thread runs the visibility updates.
+    WiredTigerSessionCache* _sessionCache = nullptr;
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
+    // Signaled to trigger the oplog visibility thread to run, and when a thread stops running
+    // visibility updates.
     mutable stdx::condition_variable _oplogVisibilityThreadCV;
 
     // Signaled when oplog visibility has been updated.
@@ -125,12 +147,10 @@ private:
     bool _isRunning = false;
     bool _shuttingDown = false;
 
-    // Triggers an oplog visibility update -- can be delayed if no callers are waiting for an
-    // update, per the _opsWaitingForOplogVisibility counter.
+    // Set when a commit may have filled an oplog hole and no update has started since.
     bool _triggerOplogVisibilityUpdate = false;
 
-    // Incremented when a caller is waiting for more of the oplog to become visible, to avoid update
-    // delays for batching.
-    int64_t _opsWaitingForOplogVisibilityUpdate = 0;
+    // Set while a thread is running visibility updates. Only one thread runs them at a time.
+    bool _visibilityUpdateInProgress = false;
 };
 }  // namespace mongo
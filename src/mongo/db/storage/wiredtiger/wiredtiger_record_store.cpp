@@ -64,6 +64,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store_oplog_stones.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_shared_tables.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
@@ -137,7 +138,8 @@ public:
         // We only want to initialize _wall by parsing BSONObj when we expect to need it in
         // OplogStone::createNewStoneIfNeeded.
         int64_t currBytes = _oplogStones->_currentBytes.load() + _bytesInserted;
-        if (currBytes >= _oplogStones->_minBytesPerStone) {
+        if (currBytes >= _oplogStones->_minBytesPerStone ||
+            _oplogStones->_isNewStoneDueByTime(Date_t::now())) {
             BSONObj obj = highestInsertedRecord.data.toBson();
             BSONElement ele = obj["wall"];
             if (!ele) {
@@ -157,7 +159,9 @@ public:
 
         _oplogStones->_currentRecords.addAndFetch(_countInserted);
         int64_t newCurrentBytes = _oplogStones->_currentBytes.addAndFetch(_bytesInserted);
-        if (_wall != Date_t() && newCurrentBytes >= _oplogStones->_minBytesPerStone) {
+        if (_wall != Date_t() &&
+            (newCurrentBytes >= _oplogStones->_minBytesPerStone ||
+             _oplogStones->_isNewStoneDueByTime(Date_t::now()))) {
             // When other InsertChanges commit concurrently, an uninitialized wallTime may delay the
             // creation of a new stone. This delay is limited to the number of concurrently running
             // transactions, so the size difference should be inconsequential.
@@ -186,6 +190,7 @@ public:
 
         stdx::lock_guard<Latch> lk(_oplogStones->_mutex);
         _oplogStones->_stones.clear();
+        _oplogStones->_storeStones_inlock();
     }
 
     void rollback() final {}
@@ -219,6 +224,8 @@ WiredTigerRecordStore::OplogStones::OplogStones(OperationContext* opCtx, WiredTi
     invariant(_minBytesPerStone > 0);
 
     _calculateStones(opCtx, numStonesToKeep);
+    _storeStones_inlock();
+    _lastNewStoneMillis.store(Date_t::now().toMillisSinceEpoch());
     _pokeReclaimThreadIfNeeded();  // Reclaim stones if over the limit.
 }
 
@@ -269,29 +276,38 @@ void WiredTigerRecordStore::OplogStones::awaitHasExcessStonesOrDead() {
 }
 
 bool WiredTigerRecordStore::OplogStones::hasExcessStones_inlock() const {
+    if (_stones.empty()) {
+        return false;
+    }
+
     int64_t totalBytes = 0;
     for (auto&& stone : _stones) {
         totalBytes += stone.bytes;
     }
 
+    double minRetentionHours = storageGlobalParams.oplogMinRetentionHours.load();
+    double maxRetentionHours = gOplogMaxRetentionHours.load();
+
+    auto nowWall = Date_t::now();
+    auto lastStoneWall = _stones.front().wallTime;
+
+    auto currRetentionMS = durationCount<Milliseconds>(nowWall - lastStoneWall);
+    double currRetentionHours = currRetentionMS / kNumMSInHour;
+
     // check that oplog stones is at capacity
     if (totalBytes <= *_rs->_oplogMaxSize) {
-        return false;
+        // Below capacity, the oldest stone is only reaped once every record in it is older than
+        // the maximum retention period, and never before the minimum one.
+        return maxRetentionHours != 0.0 &&
+            currRetentionHours >= std::max(maxRetentionHours, minRetentionHours);
     }
 
-    double minRetentionHours = storageGlobalParams.oplogMinRetentionHours.load();
-
     // If we are not checking for time, then yes, there is a stone to be reaped
     // because oplog is at capacity.
     if (minRetentionHours == 0.0) {
         return true;
     }
 
-    auto nowWall = Date_t::now();
-    auto lastStoneWall = _stones.front().wallTime;
-
-    auto currRetentionMS = durationCount<Milliseconds>(nowWall - lastStoneWall);
-    double currRetentionHours = currRetentionMS / kNumMSInHour;
     return currRetentionHours >= minRetentionHours;
 }
 
@@ -309,6 +325,7 @@ WiredTigerRecordStore::OplogStones::peekOldestStoneIfNeeded() const {
 void WiredTigerRecordStore::OplogStones::popOldestStone() {
     stdx::lock_guard<Latch> lk(_mutex);
     _stones.pop_front();
+    _storeStones_inlock();
 }
 
 void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext* opCtx,
@@ -336,7 +353,7 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
         return;
     }
 
-    if (_currentBytes.load() < _minBytesPerStone) {
+    if (_currentBytes.load() < _minBytesPerStone && !_isNewStoneDueByTime(Date_t::now())) {
         // Must have raced to create a new stone, someone else already triggered it.
         return;
     }
@@ -350,6 +367,8 @@ void WiredTigerRecordStore::OplogStones::createNewStoneIfNeeded(OperationContext
 
     OplogStones::Stone stone(_currentRecords.swap(0), _currentBytes.swap(0), lastRecord, wallTime);
     _stones.push_back(stone);
+    _storeStones_inlock();
+    _lastNewStoneMillis.store(Date_t::now().toMillisSinceEpoch());
 
     LOGV2_DEBUG(22381,
                 2,
@@ -396,6 +415,7 @@ void WiredTigerRecordStore::OplogStones::updateStonesAfterCappedTruncateAfter(
     // Remove the stones corresponding to the records that were deleted.
     int64_t offset = _stones.size() - numStonesToRemove;
     _stones.erase(_stones.begin() + offset, _stones.end());
+    _storeStones_inlock();
 
     // Account for any remaining records from a partially truncated stone in the stone currently
     // being filled.
@@ -442,6 +462,10 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
         return;
     }
 
+    if (_loadStoredStones(opCtx, numRecords, dataSize)) {
+        return;
+    }
+
     // Only use sampling to estimate where to place the oplog stones if the number of samples drawn
     // is less than 5% of the collection.
     const uint64_t kMinSampleRatioForRandCursor = 20;
@@ -464,6 +488,107 @@ void WiredTigerRecordStore::OplogStones::_calculateStones(OperationContext* opCt
     _calculateStonesBySampling(opCtx, int64_t(estRecordsPerStone), int64_t(estBytesPerStone));
 }
 
+bool WiredTigerRecordStore::OplogStones::_loadStoredStones(OperationContext* opCtx,
+                                                           long long numRecords,
+                                                           long long dataSize) {
+    if (!gUseStoredOplogTruncationPoints) {
+        return false;
+    }
+
+    BSONObj storedStones = _rs->_sizeInfo->getOplogTruncateMarkers();
+    if (storedStones.isEmpty()) {
+        return false;
+    }
+
+    // The stones may have been stored before the oplog was truncated at either end, for example by
+    // replication recovery, so only keep the stones which still fall within the oplog.
+    RecordId firstRecord;
+    RecordId lastRecord;
+    {
+        auto record = _rs->getCursor(opCtx, true /* forward */)->next();
+        if (!record) {
+            return false;
+        }
+        firstRecord = record->id;
+    }
+    {
+        auto record = _rs->getCursor(opCtx, false /* forward */)->next();
+        if (!record) {
+            return false;
+        }
+        lastRecord = record->id;
+    }
+
+    std::deque<OplogStones::Stone> stones;
+    int64_t recordsInStones = 0;
+    int64_t bytesInStones = 0;
+    try {
+        for (auto&& elem : storedStones["stones"].Array()) {
+            BSONObj storedStone = elem.Obj();
+            RecordId stoneLastRecord(storedStone["lastRecord"].numberLong());
+            if (stoneLastRecord < firstRecord) {
+                continue;
+            }
+            if (stoneLastRecord > lastRecord) {
+                break;
+            }
+
+            stones.emplace_back(storedStone["records"].numberLong(),
+                                storedStone["bytes"].numberLong(),
+                                stoneLastRecord,
+                                storedStone["wallTime"].Date());
+            recordsInStones += stones.back().records;
+            bytesInStones += stones.back().bytes;
+        }
+    } catch (const DBException& ex) {
+        LOGV2_WARNING(5963011,
+                      "Failed to parse the stored oplog truncation points, computing them instead",
+                      "error"_attr = ex.toStatus(),
+                      "storedTruncationPoints"_attr = storedStones);
+        return false;
+    }
+
+    LOGV2(5963012,
+          "Loaded the stored oplog truncation points",
+          "numStones"_attr = stones.size(),
+          "numStoredStones"_attr = storedStones["stones"].Array().size());
+
+    _processFromStoredStones.store(true);
+    _stones = std::move(stones);
+
+    // The records after the last stone belong to the stone being filled.
+    _currentRecords.store(std::max<int64_t>(numRecords - recordsInStones, 0));
+    _currentBytes.store(std::max<int64_t>(dataSize - bytesInStones, 0));
+    return true;
+}
+
+void WiredTigerRecordStore::OplogStones::_storeStones_inlock() {
+    BSONArrayBuilder stonesBuilder;
+    for (auto&& stone : _stones) {
+        stonesBuilder.append(BSON("records" << stone.records << "bytes" << stone.bytes
+                                            << "lastRecord" << stone.lastRecord.getLong()
+                                            << "wallTime" << stone.wallTime));
+    }
+    _rs->_sizeInfo->setOplogTruncateMarkers(BSON("stones" << stonesBuilder.arr()));
+
+    if (_rs->_sizeStorer) {
+        _rs->_sizeStorer->store(_rs->_sizeStorerUri, _rs->_sizeInfo);
+    }
+}
+
+bool WiredTigerRecordStore::OplogStones::_isNewStoneDueByTime(Date_t now) const {
+    double maxRetentionHours = gOplogMaxRetentionHours.load();
+    if (maxRetentionHours == 0.0) {
+        return false;
+    }
+
+    // Split the retention period into at least as many stones as are kept by size, so that the
+    // oplog is truncated in steps which are small compared to the retention period.
+    auto stoneSpan = Milliseconds(static_cast<long long>(maxRetentionHours * kNumMSInHour /
+                                                         static_cast<double>(gMinOplogStones)));
+    return now - Date_t::fromMillisSinceEpoch(_lastNewStoneMillis.load()) >= stoneSpan;
+}
+
 void WiredTigerRecordStore::OplogStones::_calculateStonesByScanning(OperationContext* opCtx) {
     _processBySampling.store(false);  // process by scanning
     LOGV2(22384, "Scanning the oplog to determine where to place markers for truncation");
@@ -758,7 +883,8 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
     const std::string& engineName,
     StringData ns,
     const CollectionOptions& options,
-    StringData extraStrings) {
+    StringData extraStrings,
+    bool prefixed) {
     // Separate out a prefix and suffix in the default string. User configuration will
     // override values in the prefix, but not values in the suffix.
     str::stream ss;
@@ -798,7 +924,11 @@ StatusWith<std::string> WiredTigerRecordStore::generateCreateString(
 
     // WARNING: No user-specified config can appear below this line. These options are required
     // for correct behavior of the server.
-    if (options.clusteredIndex) {
+    if (prefixed) {
+        // Shared tables key every record by the prefix of its record store and its RecordId.
+        invariant(!options.clusteredIndex);
+        ss << "key_format=qq";
+    } else if (options.clusteredIndex) {
         // If the RecordId format is a String, assume a byte array key format.
         ss << "key_format=u";
     } else {
@@ -832,8 +962,11 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
                                              OperationContext* ctx,
                                              Params params)
     : RecordStore(params.ns, params.ident),
-      _uri(WiredTigerKVEngine::kTableUriPrefix + params.ident),
+      _uri(params.prefix
+               ? WiredTigerSharedTables::uriFor(WiredTigerSharedTables::Kind::kRecordStore)
+               : WiredTigerKVEngine::kTableUriPrefix + params.ident),
       _tableId(WiredTigerSession::genTableId()),
+      _sizeStorerUri(WiredTigerKVEngine::kTableUriPrefix + params.ident),
       _engineName(params.engineName),
       _isCapped(params.isCapped),
       _keyFormat(params.keyFormat),
@@ -887,7 +1020,7 @@ WiredTigerRecordStore::WiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
     // case for temporary RecordStores (those not associated with any collection) and in unit
     // tests. Persistent size information is not required in either case. If a RecordStore needs
     // persistent size information, we require it to use a SizeStorer.
-    _sizeInfo = _sizeStorer ? _sizeStorer->load(_uri)
+    _sizeInfo = _sizeStorer ? _sizeStorer->load(_sizeStorerUri)
                             : std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0);
 }
 
@@ -944,7 +1077,7 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
     }
 
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::postConstructorInit(OperationContext* opCtx) {
@@ -1254,7 +1387,9 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
 
     if (_keyFormat == KeyFormat::Long) {
         // Non-clustered record stores will extract the RecordId key for the oplog and generate
-        // unique int64_t RecordId's for everything else.
+        // unique int64_t RecordId's for everything else. The latter are reserved for the whole
+        // batch at once.
+        const auto firstId = _isOplog ? RecordId() : _reserveIds(opCtx, nRecords);
         for (size_t i = 0; i < nRecords; i++) {
             auto& record = records[i];
             if (_isOplog) {
@@ -1264,13 +1399,16 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
                     return status.getStatus();
                 record.id = status.getValue();
             } else {
-                record.id = _nextId(opCtx);
+                record.id = RecordId(firstId.getLong() + static_cast<int64_t>(i));
             }
             dassert(record.id > highestIdRecord.id);
             highestIdRecord = record;
         }
     }
 
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
+    Timestamp lastTimestamp;
+
     for (size_t i = 0; i < nRecords; i++) {
         auto& record = records[i];
         invariant(!record.id.isNull());
@@ -1287,9 +1425,12 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         } else {
             ts = timestamps[i];
         }
-        if (!ts.isNull()) {
+        // Records of a batch often share a timestamp, for instance inside a multi-document
+        // transaction, so only set it when it changes.
+        if (!ts.isNull() && ts != lastTimestamp) {
             LOGV2_DEBUG(22403, 4, "inserting record with timestamp {ts}", "ts"_attr = ts);
             fassert(39001, opCtx->recoveryUnit()->setTimestamp(ts));
+            lastTimestamp = ts;
         }
         CursorKey key = makeCursorKey(record.id, _keyFormat);
         setKey(c, &key);
@@ -1317,7 +1458,6 @@ Status WiredTigerRecordStore::_insertRecords(OperationContext* opCtx,
         // Increment metrics for each insert separately, as opposed to outside of the loop. The API
         // requires that each record be accounted for separately.
         if (!_isOplog) {
-            auto& metricsCollector = ResourceConsumption::MetricsCollector::get(opCtx);
             metricsCollector.incrementOneDocWritten(value.size);
         }
     }
@@ -1571,14 +1711,17 @@ Status WiredTigerRecordStore::truncate(OperationContext* opCtx) {
     return Status::OK();
 }
 
-Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
+Status WiredTigerRecordStore::compact(OperationContext* opCtx,
+                                      boost::optional<Seconds> timeLimit) {
     dassert(opCtx->lockState()->isWriteLocked());
 
     WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
     if (!cache->isEphemeral()) {
         WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
         opCtx->recoveryUnit()->abandonSnapshot();
-        int ret = s->compact(s, getURI().c_str(), "timeout=0");
+        const std::string config = str::stream()
+            << "timeout=" << (timeLimit ? durationCount<Seconds>(*timeLimit) : 0);
+        int ret = s->compact(s, getURI().c_str(), config.c_str());
         if (MONGO_unlikely(WTCompactRecordStoreEBUSY.shouldFail())) {
             ret = EBUSY;
         }
@@ -1588,6 +1731,11 @@ Status WiredTigerRecordStore::compact(OperationContext* opCtx) {
                           str::stream() << "Compaction interrupted on " << getURI().c_str()
                                         << " due to cache eviction pressure");
         }
+        if (ret == ETIMEDOUT) {
+            return Status(ErrorCodes::ExceededTimeLimit,
+                          str::stream() << "Compaction of " << getURI().c_str()
+                                        << " did not finish within the time limit");
+        }
         invariantWTOK(ret);
     }
     return Status::OK();
@@ -1708,7 +1856,7 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
@@ -1750,13 +1898,13 @@ void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
     _nextIdNum.store(nextId);
 }
 
-RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
+RecordId WiredTigerRecordStore::_reserveIds(OperationContext* opCtx, size_t count) {
     // Clustered record stores do not generate unique ObjectId's for RecordId's as the expectation
     // is for the caller to set the RecordId using the server generated ObjectId.
     invariant(_keyFormat == KeyFormat::Long);
     invariant(!_isOplog);
     _initNextIdIfNeeded(opCtx);
-    RecordId out = RecordId(_nextIdNum.fetchAndAdd(1));
+    RecordId out = RecordId(_nextIdNum.fetchAndAdd(static_cast<long long>(count)));
     invariant(out.isValid());
     return out;
 }
@@ -1821,7 +1969,7 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
         _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
 
     if (_sizeStorer)
-        _sizeStorer->store(_uri, _sizeInfo);
+        _sizeStorer->store(_sizeStorerUri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::setNumRecords(long long numRecords) {
@@ -1832,7 +1980,7 @@ void WiredTigerRecordStore::setNumRecords(long long numRecords) {
     }
 
     // Flush the updated number of records to disk immediately.
-    _sizeStorer->store(_uri, _sizeInfo);
+    _sizeStorer->store(_sizeStorerUri, _sizeInfo);
     bool syncToDisk = true;
     _sizeStorer->flush(syncToDisk);
 }
@@ -1845,7 +1993,7 @@ void WiredTigerRecordStore::setDataSize(long long dataSize) {
     }
 
     // Flush the updated data size to disk immediately.
-    _sizeStorer->store(_uri, _sizeInfo);
+    _sizeStorer->store(_sizeStorerUri, _sizeInfo);
     bool syncToDisk = true;
     _sizeStorer->flush(syncToDisk);
 }
@@ -1984,6 +2132,35 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     // options we pass when we explicitly start transactions in the RecoveryUnit.
     WiredTigerRecoveryUnit::get(_opCtx)->getSession();
 
+    return _next(ResourceConsumption::MetricsCollector::get(_opCtx));
+}
+
+size_t WiredTigerRecordStoreCursorBase::nextBatch(
+    size_t maxRecords, const std::function<bool(const Record&)>& consumer) {
+    invariant(_hasRestored);
+    if (_eof)
+        return 0;
+
+    // Open the transaction and look up the metrics collector once for the whole batch.
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+
+    size_t numRecords = 0;
+    while (numRecords < maxRecords) {
+        auto record = _next(metricsCollector);
+        if (!record) {
+            break;
+        }
+        ++numRecords;
+        if (!consumer(*record)) {
+            break;
+        }
+    }
+    return numRecords;
+}
+
+boost::optional<Record> WiredTigerRecordStoreCursorBase::_next(
+    ResourceConsumption::MetricsCollector& metricsCollector) {
     WT_CURSOR* c = _cursor->get();
 
     RecordId id;
@@ -1998,12 +2175,13 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
             return {};
         }
         invariantWTOK(advanceRet);
-        id = getKey(c);
     }
 
     _skipNextAdvance = false;
-    if (!id.isValid()) {
-        id = getKey(c);
+    if (hasWrongPrefix(c, &id)) {
+        // We went past the last record of a record store sharing its table.
+        _eof = true;
+        return {};
     }
 
     if (_forward && _oplogVisibleTs && id.getLong() > *_oplogVisibleTs) {
@@ -2030,7 +2208,6 @@ boost::optional<Record> WiredTigerRecordStoreCursorBase::next() {
     WT_ITEM value;
     invariantWTOK(c->get_value(c, &value));
 
-    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
     metricsCollector.incrementOneDocRead(value.size);
 
     _lastReturnedId = id;
@@ -2258,6 +2435,78 @@ void StandardWiredTigerRecordStore::setKey(WT_CURSOR* cursor, const CursorKey* k
     }
 }
 
+PrefixedWiredTigerRecordStore::PrefixedWiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
+                                                             OperationContext* opCtx,
+                                                             Params params)
+    : WiredTigerRecordStore(kvEngine, opCtx, params), _prefix(*params.prefix) {
+    invariant(!_isCapped && !_isOplog && _keyFormat == KeyFormat::Long);
+}
+
+RecordId PrefixedWiredTigerRecordStore::getKey(WT_CURSOR* cursor) const {
+    std::int64_t prefix;
+    std::int64_t recordId;
+    invariantWTOK(cursor->get_key(cursor, &prefix, &recordId));
+    invariant(prefix == _prefix);
+    return RecordId(recordId);
+}
+
+void PrefixedWiredTigerRecordStore::setKey(WT_CURSOR* cursor, const CursorKey* key) const {
+    cursor->set_key(cursor, _prefix, stdx::get<int64_t>(*key));
+}
+
+std::unique_ptr<SeekableRecordCursor> PrefixedWiredTigerRecordStore::getCursor(
+    OperationContext* opCtx, bool forward) const {
+    return std::make_unique<WiredTigerRecordStorePrefixedCursor>(opCtx, *this, _prefix, forward);
+}
+
+std::unique_ptr<RecordCursor> PrefixedWiredTigerRecordStore::getRandomCursorWithOptions(
+    OperationContext* opCtx, StringData extraConfig) const {
+    return nullptr;
+}
+
+Status PrefixedWiredTigerRecordStore::truncate(OperationContext* opCtx) {
+    auto first = getCursor(opCtx, /*forward=*/true)->next();
+    // Empty collections don't have anything to truncate.
+    if (!first) {
+        return Status::OK();
+    }
+    auto last = getCursor(opCtx, /*forward=*/false)->next();
+    invariant(last);
+
+    // Only truncate the range of our prefix, the rest of the table belongs to other record stores.
+    WiredTigerCursor startWrap(_uri, _tableId, true, opCtx);
+    WiredTigerCursor stopWrap(_uri, _tableId, true, opCtx);
+    WT_CURSOR* start = startWrap.get();
+    WT_CURSOR* stop = stopWrap.get();
+    start->set_key(start, _prefix, first->id.getLong());
+    stop->set_key(stop, _prefix, last->id.getLong());
+
+    WT_SESSION* session = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+    invariantWTOK(WT_OP_CHECK(session->truncate(session, nullptr, start, stop, nullptr)));
+    _changeNumRecords(opCtx, -numRecords(opCtx));
+    _increaseDataSize(opCtx, -dataSize(opCtx));
+
+    return Status::OK();
+}
+
+int64_t PrefixedWiredTigerRecordStore::storageSize(OperationContext* opCtx,
+                                                   BSONObjBuilder* extraInfo,
+                                                   int infoLevel) const {
+    // The blocks of the shared table are not attributed to the record stores living in it.
+    return dataSize(opCtx);
+}
+
+int64_t PrefixedWiredTigerRecordStore::freeStorageSize(OperationContext* opCtx) const {
+    return 0;
+}
+
+void PrefixedWiredTigerRecordStore::validate(OperationContext* opCtx,
+                                             ValidateResults* results,
+                                             BSONObjBuilder* output) {
+    // Verifying the shared table would require exclusive access to every record store in it, so
+    // only the records themselves are validated.
+}
+
 std::unique_ptr<SeekableRecordCursor> StandardWiredTigerRecordStore::getCursor(
     OperationContext* opCtx, bool forward) const {
     if (_isOplog && forward) {
@@ -2303,6 +2552,106 @@ RecordId WiredTigerRecordStoreStandardCursor::getKey(WT_CURSOR* cursor) const {
     }
 }
 
+WiredTigerRecordStorePrefixedCursor::WiredTigerRecordStorePrefixedCursor(
+    OperationContext* opCtx, const WiredTigerRecordStore& rs, int64_t prefix, bool forward)
+    : WiredTigerRecordStoreCursorBase(opCtx, rs, forward), _prefix(prefix) {
+    initCursorToBeginning();
+}
+
+void WiredTigerRecordStorePrefixedCursor::setKey(
+    WT_CURSOR* cursor, const WiredTigerRecordStore::CursorKey* key) const {
+    cursor->set_key(cursor, _prefix, stdx::get<int64_t>(*key));
+}
+
+RecordId WiredTigerRecordStorePrefixedCursor::getKey(WT_CURSOR* cursor) const {
+    RecordId id;
+    invariant(!hasWrongPrefix(cursor, &id));
+    return id;
+}
+
+bool WiredTigerRecordStorePrefixedCursor::hasWrongPrefix(WT_CURSOR* cursor, RecordId* id) const {
+    std::int64_t prefix;
+    std::int64_t recordId;
+    invariantWTOK(cursor->get_key(cursor, &prefix, &recordId));
+    *id = RecordId(recordId);
+    return prefix != _prefix;
+}
+
+void WiredTigerRecordStorePrefixedCursor::initCursorToBeginning() {
+    WT_CURSOR* c = _cursor->get();
+    c->set_key(
+        c, _prefix, _forward ? RecordId::minLong().getLong() : RecordId::maxLong().getLong());
+
+    int cmp;
+    int ret = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->search_near(c, &cmp); });
+    if (ret == WT_NOTFOUND) {
+        // The table is empty. Leave the cursor unpositioned, so that the next advance finds
+        // nothing as well.
+        return;
+    }
+    invariantWTOK(ret);
+
+    // Return the record we landed on next, unless it sorts before our first record, in which case
+    // the next advance moves onto it.
+    _skipNextAdvance = _forward ? cmp >= 0 : cmp <= 0;
+}
+
+boost::optional<Record> WiredTigerRecordStorePrefixedCursor::seekNear(const RecordId& id) {
+    dassert(_opCtx->lockState()->isReadLocked());
+
+    _skipNextAdvance = false;
+    WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+    WT_CURSOR* c = _cursor->get();
+
+    auto key = makeCursorKey(id, _rs.keyFormat());
+    setKey(c, &key);
+
+    int cmp;
+    int ret = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c->search_near(c, &cmp); });
+    if (ret == WT_NOTFOUND) {
+        _eof = true;
+        return boost::none;
+    }
+    invariantWTOK(ret);
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneCursorSeek();
+
+    // Per the requirement of the API, return the lower (for forward) or higher (for reverse)
+    // record, falling back to the other one when there is no such record in our prefix.
+    auto towardsPreferred = [&] { return _forward ? c->prev(c) : c->next(c); };
+    auto awayFromPreferred = [&] { return _forward ? c->next(c) : c->prev(c); };
+    RecordId curId;
+    if (_forward ? cmp > 0 : cmp < 0) {
+        ret = wiredTigerPrepareConflictRetry(_opCtx, towardsPreferred);
+        if (ret == WT_NOTFOUND || (ret == 0 && hasWrongPrefix(c, &curId))) {
+            // Go back to our original location.
+            ret = wiredTigerPrepareConflictRetry(_opCtx, awayFromPreferred);
+        }
+    } else if (hasWrongPrefix(c, &curId)) {
+        ret = wiredTigerPrepareConflictRetry(_opCtx, awayFromPreferred);
+        if (ret == WT_NOTFOUND) {
+            _eof = true;
+            return boost::none;
+        }
+    }
+    invariantWTOK(ret);
+
+    if (hasWrongPrefix(c, &curId)) {
+        _eof = true;
+        return boost::none;
+    }
+
+    WT_ITEM value;
+    invariantWTOK(c->get_value(c, &value));
+
+    metricsCollector.incrementOneDocRead(value.size);
+
+    _lastReturnedId = curId;
+    _eof = false;
+    return {{curId, {static_cast<const char*>(value.data), static_cast<int>(value.size)}}};
+}
+
 Status WiredTigerRecordStore::updateOplogSize(long long newOplogSize) {
     invariant(_isOplog && _oplogMaxSize);
 
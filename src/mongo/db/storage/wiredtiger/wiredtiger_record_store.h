@@ -34,6 +34,7 @@
 #include <string>
 #include <wiredtiger.h>
 
+#include "mongo/db/stats/resource_consumption_metrics.h"
 #include "mongo/db/storage/capped_callback.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
@@ -73,6 +74,7 @@ class WiredTigerRecordStore : public RecordStore {
     friend class WiredTigerRecordStoreCursorBase;
 
     friend class StandardWiredTigerRecordStore;
+    friend class PrefixedWiredTigerRecordStore;
 
 public:
     /**
@@ -93,11 +95,14 @@ public:
      * Returns error status if validation fails.
      * Note that even if this function returns an OK status, WT_SESSION:create() may still
      * fail with the constructed configuration string.
+     * When 'prefixed' is true, the table is created to be shared by record stores whose keys are
+     * preceded by a prefix.
      */
     static StatusWith<std::string> generateCreateString(const std::string& engineName,
                                                         StringData ns,
                                                         const CollectionOptions& options,
-                                                        StringData extraStrings);
+                                                        StringData extraStrings,
+                                                        bool prefixed = false);
 
     struct Params {
         StringData ns;
@@ -112,6 +117,8 @@ public:
         WiredTigerSizeStorer* sizeStorer;
         bool isReadOnly;
         bool tracksSizeAdjustments;
+        // Set when the record store lives in the shared table for record stores.
+        boost::optional<int64_t> prefix;
     };
 
     WiredTigerRecordStore(WiredTigerKVEngine* kvEngine, OperationContext* opCtx, Params params);
@@ -183,7 +190,7 @@ public:
 
     virtual Timestamp getPinnedOplog() const final;
 
-    virtual Status compact(OperationContext* opCtx) final;
+    virtual Status compact(OperationContext* opCtx, boost::optional<Seconds> timeLimit) final;
 
     virtual void validate(OperationContext* opCtx,
                           ValidateResults* results,
@@ -289,7 +296,10 @@ private:
                           const Timestamp* timestamps,
                           size_t nRecords);
 
-    RecordId _nextId(OperationContext* opCtx);
+    /**
+     * Reserves 'count' consecutive RecordIds for new records and returns the first of them.
+     */
+    RecordId _reserveIds(OperationContext* opCtx, size_t count);
     RecordData _getData(const WiredTigerCursor& cursor) const;
 
 
@@ -322,6 +332,9 @@ private:
 
     const std::string _uri;
     const uint64_t _tableId;  // not persisted
+    // Key of the size information in the SizeStorer, which differs from '_uri' for record stores
+    // living in a shared table.
+    const std::string _sizeStorerUri;
 
     // Canonical engine name to use for retrieving options
     const std::string _engineName;
@@ -382,6 +395,51 @@ protected:
     virtual void setKey(WT_CURSOR* cursor, const CursorKey* key) const override;
 };
 
+/**
+ * A record store living in the shared table for record stores, where its keys are preceded by its
+ * prefix.
+ */
+class PrefixedWiredTigerRecordStore final : public WiredTigerRecordStore {
+public:
+    PrefixedWiredTigerRecordStore(WiredTigerKVEngine* kvEngine,
+                                  OperationContext* opCtx,
+                                  Params params);
+
+    virtual std::unique_ptr<SeekableRecordCursor> getCursor(OperationContext* opCtx,
+                                                            bool forward) const override;
+
+    /**
+     * A random cursor on the shared table could not be limited to this record store, so none is
+     * provided.
+     */
+    virtual std::unique_ptr<RecordCursor> getRandomCursorWithOptions(
+        OperationContext* opCtx, StringData extraConfig) const override;
+
+    virtual Status truncate(OperationContext* opCtx) override;
+
+    virtual int64_t storageSize(OperationContext* opCtx,
+                                BSONObjBuilder* extraInfo = nullptr,
+                                int infoLevel = 0) const override;
+
+    virtual int64_t freeStorageSize(OperationContext* opCtx) const override;
+
+    virtual void validate(OperationContext* opCtx,
+                          ValidateResults* results,
+                          BSONObjBuilder* output) override;
+
+    int64_t prefix() const {
+        return _prefix;
+    }
+
+protected:
+    virtual RecordId getKey(WT_CURSOR* cursor) const override;
+
+    virtual void setKey(WT_CURSOR* cursor, const CursorKey* key) const override;
+
+private:
+    const int64_t _prefix;
+};
+
 class WiredTigerRecordStoreCursorBase : public SeekableRecordCursor {
 public:
     WiredTigerRecordStoreCursorBase(OperationContext* opCtx,
@@ -390,6 +448,9 @@ public:
 
     boost::optional<Record> next();
 
+    size_t nextBatch(size_t maxRecords,
+                     const std::function<bool(const Record&)>& consumer) override;
+
     boost::optional<Record> seekExact(const RecordId& id);
 
     boost::optional<Record> seekNear(const RecordId& start);
@@ -409,6 +470,15 @@ protected:
 
     virtual void setKey(WT_CURSOR* cursor, const WiredTigerRecordStore::CursorKey* key) const = 0;
 
+    /**
+     * Sets 'id' to the RecordId of the entry the cursor is positioned on, and returns true if that
+     * entry belongs to another record store sharing the same table.
+     */
+    virtual bool hasWrongPrefix(WT_CURSOR* cursor, RecordId* id) const {
+        *id = getKey(cursor);
+        return false;
+    }
+
     /**
      * Called when restoring a cursor that has not been advanced.
      */
@@ -426,6 +496,12 @@ protected:
 private:
     bool isVisible(const RecordId& id);
 
+    /**
+     * Implements next() once the caller has made sure that a transaction is open, counting the
+     * returned record with 'metricsCollector'.
+     */
+    boost::optional<Record> _next(ResourceConsumption::MetricsCollector& metricsCollector);
+
     /**
      * This value is used for visibility calculations on what oplog entries can be returned to a
      * client. This value *must* be initialized/updated *before* a WiredTiger snapshot is
@@ -449,6 +525,33 @@ protected:
     virtual void initCursorToBeginning() override{};
 };
 
+class WiredTigerRecordStorePrefixedCursor final : public WiredTigerRecordStoreCursorBase {
+public:
+    WiredTigerRecordStorePrefixedCursor(OperationContext* opCtx,
+                                        const WiredTigerRecordStore& rs,
+                                        int64_t prefix,
+                                        bool forward = true);
+
+    boost::optional<Record> seekNear(const RecordId& start) override;
+
+protected:
+    virtual RecordId getKey(WT_CURSOR* cursor) const override;
+
+    virtual void setKey(WT_CURSOR* cursor,
+                        const WiredTigerRecordStore::CursorKey* key) const override;
+
+    virtual bool hasWrongPrefix(WT_CURSOR* cursor, RecordId* id) const override;
+
+    /**
+     * Positions the cursor just ahead of the first record with our prefix, since the beginning of
+     * the table belongs to other record stores.
+     */
+    virtual void initCursorToBeginning() override;
+
+private:
+    const int64_t _prefix;
+};
+
 // WT failpoint to throw write conflict exceptions randomly
 extern FailPoint WTWriteConflictException;
 extern FailPoint WTWriteConflictExceptionForReads;
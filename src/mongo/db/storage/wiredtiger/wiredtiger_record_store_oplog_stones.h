@@ -31,6 +31,7 @@
 
 #include <boost/optional.hpp>
 
+#include "mongo/db/storage/wiredtiger/oplog_stone_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
@@ -42,7 +43,9 @@ class OperationContext;
 class RecordId;
 
 // Keep "milestones" against the oplog to efficiently remove the old records when the collection
-// grows beyond its desired maximum size.
+// grows beyond its desired maximum size, or when its records grow older than
+// 'oplogMaxRetentionHours'. The milestones are stored with the size information of the oplog, so
+// that they do not have to be computed again on startup.
 class WiredTigerRecordStore::OplogStones {
 public:
     struct Stone {
@@ -67,10 +70,16 @@ public:
 
     void getOplogStonesStats(BSONObjBuilder& builder) const {
         builder.append("totalTimeProcessingMicros", _totalTimeProcessing.load());
-        builder.append("processingMethod", _processBySampling.load() ? "sampling" : "scanning");
+        builder.append("processingMethod",
+                       _processFromStoredStones.load()
+                           ? "stored"
+                           : (_processBySampling.load() ? "sampling" : "scanning"));
         if (auto oplogMinRetentionHours = storageGlobalParams.oplogMinRetentionHours.load()) {
             builder.append("oplogMinRetentionHours", oplogMinRetentionHours);
         }
+        if (auto oplogMaxRetentionHours = gOplogMaxRetentionHours.load()) {
+            builder.append("oplogMaxRetentionHours", oplogMaxRetentionHours);
+        }
     }
 
     boost::optional<OplogStones::Stone> peekOldestStoneIfNeeded() const;
@@ -122,6 +131,19 @@ private:
     class TruncateChange;
 
     void _calculateStones(OperationContext* opCtx, size_t size);
+
+    // Loads the stones stored on the last shutdown, discarding those which no longer fall within
+    // the oplog. Returns false if there are no stored stones to use.
+    bool _loadStoredStones(OperationContext* opCtx, long long numRecords, long long dataSize);
+
+    // Records the current stones with the size information of the oplog, to be written by the next
+    // flush of the size storer.
+    void _storeStones_inlock();
+
+    // Returns true if the stone being filled should be added to the deque of oplog stones even
+    // though it has less than '_minBytesPerStone' bytes, so that the oplog can be truncated by time
+    // during quiet periods.
+    bool _isNewStoneDueByTime(Date_t now) const;
     void _calculateStonesByScanning(OperationContext* opCtx);
     void _calculateStonesBySampling(OperationContext* opCtx,
                                     int64_t estRecordsPerStone,
@@ -150,6 +172,12 @@ private:
                                                // oplog during start up, if any.
     AtomicWord<bool> _processBySampling;       // Whether the oplog was sampled or scanned.
 
+    // Whether the stones stored on the last shutdown were loaded instead of scanning or sampling.
+    AtomicWord<bool> _processFromStoredStones;
+
+    // When the newest stone was created, in milliseconds since the epoch.
+    AtomicWord<long long> _lastNewStoneMillis;
+
     // Protects against concurrent access to the deque of oplog stones.
     mutable Mutex _mutex = MONGO_MAKE_LATCH("OplogStones::_mutex");
     std::deque<OplogStones::Stone> _stones;  // front = oldest, back = newest.
@@ -310,6 +310,38 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityOutOfOrder) {
     ASSERT(!wtrs->isOpHidden_forTest(id2));
 }
 
+// Test that committing the write which fills an oplog hole makes the entries behind it visible by
+// the time the commit returns, without waiting for the oplog visibility thread.
+TEST(WiredTigerRecordStoreTest, OplogVisibilityAdvancesOnCommitFillingHole) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+
+    ServiceContext::UniqueOperationContext longLivedOp(harnessHelper->newOperationContext());
+    WriteUnitOfWork uow(longLivedOp.get());
+    RecordId id1 = _oplogOrderInsertOplog(longLivedOp.get(), rs, 1);
+
+    RecordId id2;
+    {
+        auto innerClient = harnessHelper->serviceContext()->makeClient("inner");
+        ServiceContext::UniqueOperationContext opCtx(
+            harnessHelper->newOperationContext(innerClient.get()));
+        WriteUnitOfWork uow(opCtx.get());
+        id2 = _oplogOrderInsertOplog(opCtx.get(), rs, 2);
+        uow.commit();
+    }
+
+    // The first entry has not committed, so neither entry is visible.
+    ASSERT(wtrs->isOpHidden_forTest(id1));
+    ASSERT(wtrs->isOpHidden_forTest(id2));
+
+    uow.commit();
+
+    ASSERT(!wtrs->isOpHidden_forTest(id1));
+    ASSERT(!wtrs->isOpHidden_forTest(id2));
+}
+
 TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
     unique_ptr<RecordStore> rs(harnessHelper->newNonCappedRecordStore("a.b"));
@@ -809,6 +841,91 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
     }
 }
 
+// Verify that stones are truncated by time when 'oplogMaxRetentionHours' is set, even though the
+// oplog is below its maximum size, and that stones are created by time during quiet periods.
+TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStonesByTime) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    ASSERT_OK(wtrs->updateOplogSize(1024 * 1024));
+
+    oplogStones->setMinBytesPerStone(100);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 100), RecordId(1, 2));
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 100), RecordId(1, 3));
+        ASSERT_EQ(3U, oplogStones->numStones());
+
+        // The oplog is below its maximum size, so nothing is truncated.
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 3));
+        ASSERT_EQ(3, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(3U, oplogStones->numStones());
+    }
+
+    ON_BLOCK_EXIT([] { gOplogMaxRetentionHours.store(0.0); });
+    gOplogMaxRetentionHours.store(1.0 / (60 * 60 * 1000));  // 1 millisecond.
+    sleepmillis(10);
+
+    // Every stone is older than the maximum retention period, so the stones before the truncate
+    // point are truncated.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, 3));
+        ASSERT_EQ(1, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(100, rs->dataSize(opCtx.get()));
+        ASSERT_EQ(1U, oplogStones->numStones());
+    }
+
+    // A record smaller than 'minBytesPerStone' creates a new stone once the stone being filled
+    // spans long enough.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 4), 50), RecordId(1, 4));
+        ASSERT_EQ(2U, oplogStones->numStones());
+        ASSERT_EQ(0, oplogStones->currentRecords());
+        ASSERT_EQ(0, oplogStones->currentBytes());
+    }
+}
+
+// Verify that the stones are stored with the size information of the oplog and loaded from there
+// instead of being computed again.
+TEST(WiredTigerRecordStoreTest, OplogStones_LoadStoredStones) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    oplogStones->setMinBytesPerStone(100);
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+    ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 1), 100), RecordId(1, 1));
+    ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 2), 60), RecordId(1, 2));
+    ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 3), 60), RecordId(1, 3));
+    ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, 4), 50), RecordId(1, 4));
+    ASSERT_EQ(2U, oplogStones->numStones());
+    ASSERT_EQ(1, oplogStones->currentRecords());
+    ASSERT_EQ(50, oplogStones->currentBytes());
+
+    WiredTigerRecordStore::OplogStones loadedStones(opCtx.get(), wtrs);
+    ASSERT_EQ(2U, loadedStones.numStones());
+    ASSERT_EQ(1, loadedStones.currentRecords());
+    ASSERT_EQ(50, loadedStones.currentBytes());
+
+    BSONObjBuilder builder;
+    loadedStones.getOplogStonesStats(builder);
+    ASSERT_EQ("stored", builder.obj()["processingMethod"].str());
+}
+
 // Verify that an oplog stone isn't created if it would cause the logical representation of the
 // records to not be in increasing order.
 TEST(WiredTigerRecordStoreTest, OplogStones_AscendingOrder) {
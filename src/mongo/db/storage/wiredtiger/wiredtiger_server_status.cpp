@@ -48,6 +48,37 @@ namespace mongo {
 
 using std::string;
 
+namespace {
+
+/**
+ * Appends the ticket and cache counters that FTDC samples at a high frequency. Each counter is
+ * looked up directly, as walking every statistic many times a second would be too expensive.
+ */
+void appendHighFrequencyStats(WT_SESSION* s, BSONObjBuilder* bob) {
+    const std::pair<StringData, int> cacheStats[] = {
+        {"bytes currently in the cache"_sd, WT_STAT_CONN_CACHE_BYTES_INUSE},
+        {"tracked dirty bytes in the cache"_sd, WT_STAT_CONN_CACHE_BYTES_DIRTY},
+        {"maximum bytes configured"_sd, WT_STAT_CONN_CACHE_BYTES_MAX},
+        {"pages read into cache"_sd, WT_STAT_CONN_CACHE_READ},
+        {"pages written from cache"_sd, WT_STAT_CONN_CACHE_WRITE},
+        {"pages evicted by application threads"_sd, WT_STAT_CONN_CACHE_EVICTION_APP},
+    };
+
+    {
+        BSONObjBuilder cache(bob->subobjStart("cache"));
+        for (const auto& [name, key] : cacheStats) {
+            auto value =
+                WiredTigerUtil::getStatisticsValue(s, "statistics:", "statistics=(fast)", key);
+            // Keep the shape of the section stable when a statistic cannot be read.
+            cache.appendNumber(name, value.isOK() ? static_cast<long long>(value.getValue()) : 0);
+        }
+    }
+
+    WiredTigerKVEngine::appendGlobalStats(*bob);
+}
+
+}  // namespace
+
 WiredTigerServerStatusSection::WiredTigerServerStatusSection(WiredTigerKVEngine* engine)
     : ServerStatusSection(kWiredTigerEngineName), _engine(engine) {}
 
@@ -55,6 +86,10 @@ bool WiredTigerServerStatusSection::includeByDefault() const {
     return true;
 }
 
+ServerStatusSection::Cost WiredTigerServerStatusSection::getCost() const {
+    return Cost::kExpensive;
+}
+
 BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
                                                        const BSONElement& configElement) const {
     Lock::GlobalLock lk(
@@ -72,6 +107,13 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WT_SESSION* s = session->getSession();
     invariant(s);
+
+    if (configElement.type() == Object && configElement.Obj()["highFrequency"].trueValue()) {
+        BSONObjBuilder bob;
+        appendHighFrequencyStats(s, &bob);
+        return bob.obj();
+    }
+
     const string uri = "statistics:";
 
     // Filter out unrelevant statistic fields.
@@ -90,6 +132,11 @@ BSONObj WiredTigerServerStatusSection::generateSection(OperationContext* opCtx,
 
     WiredTigerUtil::appendSnapshotWindowSettings(_engine, session, &bob);
 
+    {
+        BSONObjBuilder subsection(bob.subobjStart("session cache"));
+        WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->appendStats(&subsection);
+    }
+
     {
         BSONObjBuilder subsection(bob.subobjStart("oplog"));
         subsection.append("visibility timestamp",
@@ -36,12 +36,14 @@ namespace mongo {
 class WiredTigerKVEngine;
 
 /**
- * Adds "wiredTiger" to the results of db.serverStatus().
+ * Adds "wiredTiger" to the results of db.serverStatus(). Walking every statistic of the connection
+ * is expensive, so the full section is shared between the commands which run close together.
  */
 class WiredTigerServerStatusSection : public ServerStatusSection {
 public:
     WiredTigerServerStatusSection(WiredTigerKVEngine* engine);
     bool includeByDefault() const override;
+    Cost getCost() const override;
     BSONObj generateSection(OperationContext* opCtx,
                             const BSONElement& configElement) const override;
 
@@ -45,7 +45,9 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
@@ -53,7 +55,6 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn, uint64_t epoch, uint64
     : _epoch(epoch),
       _cursorEpoch(cursorEpoch),
       _session(nullptr),
-      _cursorGen(0),
       _cursorsOut(0),
       _idleExpireTime(Date_t::min()) {
     invariantWTOK(conn->open_session(conn, nullptr, "isolation=snapshot", &_session));
@@ -67,7 +68,6 @@ WiredTigerSession::WiredTigerSession(WT_CONNECTION* conn,
       _cursorEpoch(cursorEpoch),
       _cache(cache),
       _session(nullptr),
-      _cursorGen(0),
       _cursorsOut(0),
       _idleExpireTime(Date_t::min()) {
     invariantWTOK(conn->open_session(conn, nullptr, "isolation=snapshot", &_session));
@@ -112,21 +112,49 @@ void _openCursor(WT_SESSION* session,
 }  // namespace
 
 WT_CURSOR* WiredTigerSession::getCachedCursor(uint64_t id, const std::string& config) {
-    // Find the most recently used cursor
-    for (CursorCache::iterator i = _cursors.begin(); i != _cursors.end(); ++i) {
-        // Ensure that all properties of this cursor are identical to avoid mixing cursor
-        // configurations. Note that this uses an exact string match, so cursor configurations with
-        // parameters in different orders will not be considered equivalent.
-        if (i->_id == id && i->_config == config) {
-            WT_CURSOR* c = i->_cursor;
-            _cursors.erase(i);
-            _cursorsOut++;
-            return c;
+    auto indexIt = _cursorsById.find(id);
+    if (indexIt != _cursorsById.end()) {
+        // Find the most recently used cursor
+        auto& cursors = indexIt->second;
+        for (auto i = cursors.rbegin(); i != cursors.rend(); ++i) {
+            // Ensure that all properties of this cursor are identical to avoid mixing cursor
+            // configurations. Note that this uses an exact string match, so cursor configurations
+            // with parameters in different orders will not be considered equivalent.
+            if ((*i)->_config == config) {
+                WT_CURSOR* c = (*i)->_cursor;
+                _cursors.erase(*i);
+                cursors.erase(std::next(i).base());
+                if (cursors.empty()) {
+                    _cursorsById.erase(indexIt);
+                }
+                _cursorsOut++;
+                _cursorCacheHits++;
+                return c;
+            }
         }
     }
+    _cursorCacheMisses++;
     return nullptr;
 }
 
+void WiredTigerSession::_unindexCursor(CursorCache::iterator it) {
+    auto indexIt = _cursorsById.find(it->_id);
+    invariant(indexIt != _cursorsById.end());
+    auto& cursors = indexIt->second;
+    cursors.erase(std::find(cursors.begin(), cursors.end(), it));
+    if (cursors.empty()) {
+        _cursorsById.erase(indexIt);
+    }
+}
+
+void WiredTigerSession::_rebuildCursorIndex() {
+    _cursorsById.clear();
+    for (auto it = _cursors.end(); it != _cursors.begin();) {
+        --it;
+        _cursorsById[it->_id].push_back(it);
+    }
+}
+
 WT_CURSOR* WiredTigerSession::getNewCursor(const std::string& uri, const char* config) {
     WT_CURSOR* cursor = nullptr;
     _openCursor(_session, uri, config, &cursor);
@@ -141,16 +169,22 @@ void WiredTigerSession::releaseCursor(uint64_t id, WT_CURSOR* cursor, const std:
 
     invariantWTOK(cursor->reset(cursor));
 
-    // Cursors are pushed to the front of the list and removed from the back
-    _cursors.push_front(WiredTigerCachedCursor(id, _cursorGen++, cursor, config));
+    // Cursors are pushed to the front of the list and removed from the back, so the list is also
+    // ordered by release time.
+    _cursors.push_front(WiredTigerCachedCursor(
+        id, cursor, config, _cache ? _cache->getClockSource()->now() : Date_t()));
+    _cursorsById[id].push_back(_cursors.begin());
 
     // A negative value for wiredTigercursorCacheSize means to use hybrid caching.
     std::uint32_t cacheSize = abs(gWiredTigerCursorCacheSize.load());
 
-    while (!_cursors.empty() && _cursorGen - _cursors.back()._gen > cacheSize) {
-        cursor = _cursors.back()._cursor;
-        _cursors.pop_back();
+    while (_cursors.size() > cacheSize) {
+        auto last = std::prev(_cursors.end());
+        cursor = last->_cursor;
+        _unindexCursor(last);
+        _cursors.erase(last);
         invariantWTOK(cursor->close(cursor));
+        _cursorCacheEvictions++;
     }
 }
 
@@ -170,17 +204,36 @@ void WiredTigerSession::closeAllCursors(const std::string& uri) {
         WT_CURSOR* cursor = i->_cursor;
         if (cursor && (all || uri == cursor->uri)) {
             invariantWTOK(cursor->close(cursor));
+            _unindexCursor(i);
             i = _cursors.erase(i);
         } else
             ++i;
     }
 }
 
+size_t WiredTigerSession::closeCursorsReleasedBefore(Date_t cutoff) {
+    invariant(_session);
+
+    size_t closed = 0;
+    while (!_cursors.empty() && _cursors.back()._releasedAt < cutoff) {
+        auto last = std::prev(_cursors.end());
+        WT_CURSOR* cursor = last->_cursor;
+        _unindexCursor(last);
+        _cursors.erase(last);
+        invariantWTOK(cursor->close(cursor));
+        ++closed;
+    }
+    return closed;
+}
+
 void WiredTigerSession::closeCursorsForQueuedDrops(WiredTigerKVEngine* engine) {
     invariant(_session);
 
     _cursorEpoch = _cache->getCursorEpoch();
     auto toDrop = engine->filterCursorsWithQueuedDrops(&_cursors);
+    if (!toDrop.empty()) {
+        _rebuildCursorIndex();
+    }
 
     for (auto i = toDrop.begin(); i != toDrop.end(); i++) {
         WT_CURSOR* cursor = i->_cursor;
@@ -200,19 +253,35 @@ uint64_t WiredTigerSession::genTableId() {
 
 // -----------------------
 
+namespace {
+// Used to spread threads evenly over the shards of the session caches.
+AtomicWord<unsigned> nextThreadShardSeed;
+thread_local unsigned threadShardSeed = nextThreadShardSeed.fetchAndAdd(1);
+
+size_t getNumSessionCacheShards() {
+    if (gWiredTigerSessionCacheShards > 0) {
+        return gWiredTigerSessionCacheShards;
+    }
+    return std::max<size_t>(ProcessInfo::getNumAvailableCores(), 1);
+}
+}  // namespace
+
 WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
-    : _engine(engine),
-      _conn(engine->getConnection()),
-      _clockSource(_engine->getClockSource()),
-      _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+    : WiredTigerSessionCache(engine->getConnection(), engine->getClockSource()) {
+    _engine = engine;
+}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
     : _engine(nullptr),
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
-      _prepareCommitOrAbortCounter(0) {}
+      _prepareCommitOrAbortCounter(0) {
+    _shards.resize(getNumSessionCacheShards());
+    for (auto& shard : _shards) {
+        shard = std::make_unique<CacheShard>();
+    }
+}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
     shuttingDown();
@@ -376,10 +445,28 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 }
 
 
+WiredTigerSessionCache::CacheShard& WiredTigerSessionCache::_getHomeShard() {
+    return *_shards[threadShardSeed % _shards.size()];
+}
+
+stdx::unique_lock<Latch> WiredTigerSessionCache::_lockShard(CacheShard& shard) {
+    stdx::unique_lock<Latch> lock(shard.mutex, stdx::try_to_lock);
+    if (!lock.owns_lock()) {
+        // Only time the acquisitions that have to wait, to keep the uncontended path cheap.
+        Timer timer;
+        lock.lock();
+        _contendedLockAcquisitions.fetchAndAddRelaxed(1);
+        _lockWaitMicros.fetchAndAddRelaxed(timer.micros());
+    }
+    return lock;
+}
+
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        for (SessionCache::iterator i = shard->sessions.begin(); i != shard->sessions.end(); i++) {
+            (*i)->closeAllCursors(uri);
+        }
     }
 }
 
@@ -387,15 +474,35 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        for (SessionCache::iterator i = shard->sessions.begin(); i != shard->sessions.end(); i++) {
+            (*i)->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        count += shard->sessions.size();
+    }
+    return count;
+}
+
+void WiredTigerSessionCache::appendStats(BSONObjBuilder* builder) {
+    builder->append("shards", static_cast<long long>(_shards.size()));
+    builder->append("idle sessions", static_cast<long long>(getIdleSessionsCount()));
+    builder->append("sessions reused from the home shard", _homeShardHits.load());
+    builder->append("sessions stolen from other shards", _stolenSessions.load());
+    builder->append("sessions created", _sessionsCreated.load());
+    builder->append("contended shard lock acquisitions", _contendedLockAcquisitions.load());
+    builder->append("shard lock wait time (usecs)", _lockWaitMicros.load());
+    builder->append("cursor cache hits", _cursorCacheHits.load());
+    builder->append("cursor cache misses", _cursorCacheMisses.load());
+    builder->append("cursor cache evictions", _cursorCacheEvictions.load());
+    builder->append("idle cached cursors closed", _idleCursorsClosed.load());
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -407,19 +514,20 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = shard->sessions.begin(); it != shard->sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = shard->sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
             }
         }
+        shard->numSessions.store(shard->sessions.size());
     }
 
     // Closing expired idle sessions is expensive, so do it outside of the cache mutex. This helps
@@ -429,18 +537,40 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     }
 }
 
-void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
+void WiredTigerSessionCache::closeExpiredIdleCursors(int64_t idleTimeMillis) {
+    // Cursors cached at the WiredTiger level do not keep data handles in use, and the cursors of
+    // idle sessions are already closed on release in that mode.
+    if (idleTimeMillis <= 0 || isEngineCachingCursors()) {
+        return;
+    }
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
+    auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> lock(shard->mutex);
+        for (auto session : shard->sessions) {
+            _idleCursorsClosed.fetchAndAddRelaxed(
+                session->closeCursorsReleasedBefore(cutoffTime));
+        }
     }
+}
+
+void WiredTigerSessionCache::closeAll() {
+    // Increment the epoch as we are now closing all sessions with this epoch. It is incremented
+    // before emptying the shards, so that releaseSession either sees the new epoch under the lock
+    // of a shard and deletes its session, or adds the session before the shard is emptied.
+    _epoch.fetchAndAdd(1);
+
+    for (auto& shard : _shards) {
+        SessionCache swap;
+        {
+            stdx::lock_guard<Latch> lock(shard->mutex);
+            shard->sessions.swap(swap);
+            shard->numSessions.store(0);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
+            delete (*i);
+        }
     }
 }
 
@@ -453,13 +583,24 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Look in the home shard first, then in the others.
+    auto& homeShard = _getHomeShard();
+    for (size_t i = 0; i < _shards.size(); i++) {
+        auto& shard = i == 0 ? homeShard : *_shards[(threadShardSeed + i) % _shards.size()];
+        if (shard.numSessions.loadRelaxed() == 0) {
+            continue;
+        }
+
+        auto lock = _lockShard(shard);
+        if (!shard.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = shard.sessions.back();
+            shard.sessions.pop_back();
+            shard.numSessions.store(shard.sessions.size());
+            lock.unlock();
+
+            (i == 0 ? _homeShardHits : _stolenSessions).fetchAndAddRelaxed(1);
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -467,6 +608,7 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     }
 
     // Outside of the cache partition lock, but on release will be put back on the cache
+    _sessionsCreated.fetchAndAddRelaxed(1);
     return UniqueWiredTigerSession(
         new WiredTigerSession(_conn, this, _epoch.load(), _cursorEpoch.load()));
 }
@@ -502,10 +644,18 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
         // be cached at the WiredTiger level.
         if (gWiredTigerCursorCacheSize.load() < 0) {
             session->closeAllCursors("");
+        } else if (auto idleSecs = gWiredTigerCursorCloseIdleTimeSecs.load(); idleSecs > 0) {
+            _idleCursorsClosed.fetchAndAddRelaxed(session->closeCursorsReleasedBefore(
+                _clockSource->now() - Seconds(idleSecs)));
         }
         invariantWTOK(ss->reset(ss));
     }
 
+    // Fold the cursor cache statistics of the session into the totals.
+    _cursorCacheHits.fetchAndAddRelaxed(std::exchange(session->_cursorCacheHits, 0));
+    _cursorCacheMisses.fetchAndAddRelaxed(std::exchange(session->_cursorCacheMisses, 0));
+    _cursorCacheEvictions.fetchAndAddRelaxed(std::exchange(session->_cursorCacheEvictions, 0));
+
     // If the cursor epoch has moved on, close all cursors in the session.
     uint64_t cursorEpoch = _cursorEpoch.load();
     if (session->_getCursorEpoch() != cursorEpoch)
@@ -521,10 +671,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& shard = _getHomeShard();
+        auto lock = _lockShard(shard);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            shard.sessions.push_back(session);
+            shard.numSessions.store(shard.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
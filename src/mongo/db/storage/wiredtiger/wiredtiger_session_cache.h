@@ -38,22 +38,28 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
+#include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
 
+class BSONObjBuilder;
 class WiredTigerKVEngine;
 class WiredTigerSessionCache;
 
 class WiredTigerCachedCursor {
 public:
-    WiredTigerCachedCursor(uint64_t id, uint64_t gen, WT_CURSOR* cursor, const std::string& config)
-        : _id(id), _gen(gen), _cursor(cursor), _config(config) {}
+    WiredTigerCachedCursor(uint64_t id,
+                           WT_CURSOR* cursor,
+                           const std::string& config,
+                           Date_t releasedAt = Date_t())
+        : _id(id), _cursor(cursor), _config(config), _releasedAt(releasedAt) {}
 
-    uint64_t _id;   // Source ID, assigned to each URI
-    uint64_t _gen;  // Generation, used to age out old cursors
+    uint64_t _id;  // Source ID, assigned to each URI
     WT_CURSOR* _cursor;
     std::string _config;  // Cursor config. Do not serve cursors with different configurations
+    Date_t _releasedAt;   // When the cursor was last released into the cache
 };
 
 /**
@@ -120,8 +126,8 @@ public:
     }
 
     /**
-     * Release a cursor into the cursor cache and close old cursors if the number of cursors in the
-     * cache exceeds wiredTigerCursorCacheSize.
+     * Release a cursor into the cursor cache and close the least recently released cursors if the
+     * number of cursors in the cache exceeds wiredTigerCursorCacheSize.
      * The exact cursor config that was used to create the cursor must be provided or subsequent
      * users will retrieve cursors with incorrect configurations.
      */
@@ -134,6 +140,12 @@ public:
 
     void closeCursorsForQueuedDrops(WiredTigerKVEngine* engine);
 
+    /**
+     * Closes the cached cursors that were last released before 'cutoff' and returns how many were
+     * closed.
+     */
+    size_t closeCursorsReleasedBefore(Date_t cutoff);
+
     /**
      * Closes all cached cursors matching the uri.  If the uri is empty,
      * all cached cursors are closed.
@@ -182,9 +194,20 @@ private:
     friend class WiredTigerSessionCache;
     friend class WiredTigerKVEngine;
 
-    // The cursor cache is a list of pairs that contain an ID and cursor
+    // The cursor cache is a list of pairs that contain an ID and cursor, most recently released
+    // first.
     typedef std::list<WiredTigerCachedCursor> CursorCache;
 
+    /**
+     * Removes the cursor at 'it' from _cursorsById. The caller erases it from _cursors.
+     */
+    void _unindexCursor(CursorCache::iterator it);
+
+    /**
+     * Rebuilds _cursorsById after cursors were erased from _cursors by someone else.
+     */
+    void _rebuildCursorIndex();
+
     // Used internally by WiredTigerSessionCache
     uint64_t _getEpoch() const {
         return _epoch;
@@ -200,8 +223,17 @@ private:
     WiredTigerSessionCache* _cache;  // not owned
     WT_SESSION* _session;            // owned
     CursorCache _cursors;            // owned
-    uint64_t _cursorGen;
     int _cursorsOut;
+
+    // Indexes the cached cursors of each table, least recently released first, so that finding a
+    // cursor does not scan the whole cache.
+    stdx::unordered_map<uint64_t, std::vector<CursorCache::iterator>> _cursorsById;
+
+    // Cursor cache statistics since the session was last released to the session cache, which
+    // adds them to its own totals.
+    uint64_t _cursorCacheHits = 0;
+    uint64_t _cursorCacheMisses = 0;
+    uint64_t _cursorCacheEvictions = 0;
     bool _dropQueuedIdentsAtSessionEnd = true;
     Date_t _idleExpireTime;
 };
@@ -262,11 +294,23 @@ public:
      */
     size_t getIdleSessionsCount();
 
+    /**
+     * Appends statistics about the reuse of idle sessions and the contention on the cache to
+     * 'builder', for serverStatus.
+     */
+    void appendStats(BSONObjBuilder* builder);
+
     /**
      * Closes all cached sessions whose idle expiration time has been reached.
      */
     void closeExpiredIdleSessions(int64_t idleTimeMillis);
 
+    /**
+     * Closes the cursors cached in idle sessions that have not been used for 'idleTimeMillis', so
+     * that WiredTiger can close the data handles of tables nobody is using.
+     */
+    void closeExpiredIdleCursors(int64_t idleTimeMillis);
+
     /**
      * Free all cached sessions and ensures that previously acquired sessions will be freed on
      * release.
@@ -363,6 +407,10 @@ public:
         return _engine;
     }
 
+    ClockSource* getClockSource() const {
+        return _clockSource;
+    }
+
     std::uint64_t getPrepareCommitOrAbortCount() const {
         return _prepareCommitOrAbortCounter.loadRelaxed();
     }
@@ -379,9 +427,42 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // Idle sessions are spread over shards, each with its own mutex, so that threads reusing and
+    // releasing sessions concurrently rarely contend. Every thread is assigned a home shard, and
+    // steals from the other shards when its home shard is empty.
+    struct alignas(stdx::hardware_destructive_interference_size) CacheShard {
+        Mutex mutex = MONGO_MAKE_LATCH("WiredTigerSessionCache::CacheShard::mutex");
+        SessionCache sessions;
+
+        // The number of sessions, readable without the mutex to skip empty shards when stealing.
+        AtomicWord<size_t> numSessions{0};
+    };
+    std::vector<std::unique_ptr<CacheShard>> _shards;
+
+    /**
+     * Returns the shard the calling thread releases its sessions to and looks in first for an idle
+     * session.
+     */
+    CacheShard& _getHomeShard();
+
+    /**
+     * Locks the mutex of 'shard', recording in the statistics below how long the caller was
+     * blocked if the mutex was not immediately available.
+     */
+    stdx::unique_lock<Latch> _lockShard(CacheShard& shard);
+
+    // Statistics reported by appendStats().
+    AtomicWord<long long> _homeShardHits{0};
+    AtomicWord<long long> _stolenSessions{0};
+    AtomicWord<long long> _sessionsCreated{0};
+    AtomicWord<long long> _contendedLockAcquisitions{0};
+    AtomicWord<long long> _lockWaitMicros{0};
+    AtomicWord<long long> _cursorCacheHits{0};
+    AtomicWord<long long> _cursorCacheMisses{0};
+    AtomicWord<long long> _cursorCacheEvictions{0};
+    AtomicWord<long long> _idleCursorsClosed{0};
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
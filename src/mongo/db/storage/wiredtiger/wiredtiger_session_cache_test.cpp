@@ -33,11 +33,15 @@
 #include <string>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_parameters_gen.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/system_clock_source.h"
 
 namespace mongo {
@@ -114,4 +118,112 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, ReusesSessionsReleasedByOtherThreads) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    // Release sessions from several threads, which may each return them to a different shard.
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < 8; i++) {
+        threads.emplace_back([&] { UniqueWiredTigerSession session = sessionCache->getSession(); });
+        threads.back().join();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    // This thread finds the idle session wherever it is.
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(stats["sessions created"].numberLong(), 1);
+    ASSERT_EQUALS(stats["sessions reused from the home shard"].numberLong() +
+                      stats["sessions stolen from other shards"].numberLong(),
+                  8);
+
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+}
+
+TEST(WiredTigerSessionCacheTest, CursorCacheEvictsLeastRecentlyReleasedCursors) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    UniqueWiredTigerSession session = sessionCache->getSession();
+    WT_SESSION* wtSession = session->getSession();
+    const std::string uri = "table:cursor_cache_test";
+    ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, uri.c_str(), nullptr)));
+
+    const auto originalCacheSize = gWiredTigerCursorCacheSize.load();
+    ON_BLOCK_EXIT([&] { gWiredTigerCursorCacheSize.store(originalCacheSize); });
+    gWiredTigerCursorCacheSize.store(2);
+
+    for (uint64_t tableId = 1; tableId <= 3; tableId++) {
+        ASSERT_FALSE(session->getCachedCursor(tableId, ""));
+        session->releaseCursor(tableId, session->getNewCursor(uri), "");
+    }
+    ASSERT_EQUALS(session->cachedCursors(), 2);
+
+    // Reusing the cursor of table 2 makes the cursor of table 3 the least recently released one.
+    WT_CURSOR* cursor = session->getCachedCursor(2, "");
+    ASSERT(cursor);
+    session->releaseCursor(2, cursor, "");
+    session->releaseCursor(4, session->getNewCursor(uri), "");
+
+    ASSERT_FALSE(session->getCachedCursor(1, ""));
+    ASSERT_FALSE(session->getCachedCursor(3, ""));
+    for (uint64_t tableId : {2, 4}) {
+        cursor = session->getCachedCursor(tableId, "");
+        ASSERT(cursor);
+        session->closeCursor(cursor);
+    }
+    ASSERT_EQUALS(session->cachedCursors(), 0);
+
+    session.reset();
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQUALS(stats["cursor cache hits"].numberLong(), 3);
+    ASSERT_EQUALS(stats["cursor cache misses"].numberLong(), 5);
+    ASSERT_EQUALS(stats["cursor cache evictions"].numberLong(), 2);
+}
+
+TEST(WiredTigerSessionCacheTest, ClosesIdleCachedCursorsOfIdleSessions) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+    const std::string uri = "table:idle_cursor_test";
+
+    const auto originalCacheSize = gWiredTigerCursorCacheSize.load();
+    ON_BLOCK_EXIT([&] { gWiredTigerCursorCacheSize.store(originalCacheSize); });
+    gWiredTigerCursorCacheSize.store(10);
+
+    WiredTigerSession* idleSession;
+    {
+        UniqueWiredTigerSession session = sessionCache->getSession();
+        WT_SESSION* wtSession = session->getSession();
+        ASSERT_OK(wtRCToStatus(wtSession->create(wtSession, uri.c_str(), nullptr)));
+        session->releaseCursor(1, session->getNewCursor(uri), "");
+        idleSession = session.get();
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+    ASSERT_EQUALS(idleSession->cachedCursors(), 1);
+
+    // An idle time of 0 keeps the cached cursors, as does one the cursor has not reached yet.
+    sessionCache->closeExpiredIdleCursors(0);
+    sessionCache->closeExpiredIdleCursors(10000);
+    ASSERT_EQUALS(idleSession->cachedCursors(), 1);
+
+    sleepmillis(10);
+    sessionCache->closeExpiredIdleCursors(2);
+    ASSERT_EQUALS(idleSession->cachedCursors(), 0);
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    BSONObjBuilder builder;
+    sessionCache->appendStats(&builder);
+    ASSERT_EQUALS(builder.obj()["idle cached cursors closed"].numberLong(), 1);
+}
+
 }  // namespace mongo
@@ -0,0 +1,306 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_shared_tables.h"
+
+#include <limits>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_begin_transaction_block.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo {
+namespace {
+
+constexpr StringData kRegistryIdent = "sharedIdents"_sd;
+const std::string kRegistryUri = std::string("table:") + kRegistryIdent;
+
+// Key of the registry entry remembering the highest prefix ever assigned. Never a valid ident.
+constexpr StringData kHighestPrefixKey = ""_sd;
+
+StringData identFor(WiredTigerSharedTables::Kind kind) {
+    switch (kind) {
+        case WiredTigerSharedTables::Kind::kRecordStore:
+            return "sharedRecordStores"_sd;
+        case WiredTigerSharedTables::Kind::kStandardIndex:
+            return "sharedIndexes"_sd;
+        case WiredTigerSharedTables::Kind::kUniqueIndex:
+            return "sharedUniqueIndexes"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+void setPrefixKey(WT_CURSOR* c, WiredTigerSharedTables::Kind kind, int64_t prefix) {
+    if (kind == WiredTigerSharedTables::Kind::kRecordStore) {
+        c->set_key(c, prefix, std::numeric_limits<int64_t>::min());
+    } else {
+        const WiredTigerItem emptyItem(nullptr, 0);
+        c->set_key(c, prefix, emptyItem.Get());
+    }
+}
+
+int64_t getPrefix(WT_CURSOR* c, WiredTigerSharedTables::Kind kind) {
+    int64_t prefix;
+    if (kind == WiredTigerSharedTables::Kind::kRecordStore) {
+        int64_t recordId;
+        invariantWTOK(c->get_key(c, &prefix, &recordId));
+    } else {
+        WT_ITEM item;
+        invariantWTOK(c->get_key(c, &prefix, &item));
+    }
+    return prefix;
+}
+
+/**
+ * Positions 'c' on the first or the last entry with 'prefix'. Returns false if there is none.
+ */
+bool seekToPrefixBound(WT_CURSOR* c,
+                       WiredTigerSharedTables::Kind kind,
+                       int64_t prefix,
+                       bool first) {
+    // Every key of an ident sorts at or after its prefix followed by the smallest key.
+    setPrefixKey(c, kind, first ? prefix : prefix + 1);
+    int cmp;
+    int ret = c->search_near(c, &cmp);
+    if (ret == WT_NOTFOUND) {
+        return false;
+    }
+    invariantWTOK(ret);
+
+    if (first && cmp < 0) {
+        ret = c->next(c);
+    } else if (!first && cmp >= 0) {
+        ret = c->prev(c);
+    }
+    if (ret == WT_NOTFOUND) {
+        return false;
+    }
+    invariantWTOK(ret);
+    return getPrefix(c, kind) == prefix;
+}
+
+}  // namespace
+
+WiredTigerSharedTables::WiredTigerSharedTables(WT_CONNECTION* conn, bool readOnly)
+    : _readOnly(readOnly), _session(conn) {
+    WT_SESSION* session = _session.getSession();
+    int ret =
+        session->open_cursor(session, kRegistryUri.c_str(), nullptr, "overwrite=true", &_cursor);
+    if (ret == ENOENT) {
+        // Nothing was ever shared.
+        _cursor = nullptr;
+        return;
+    }
+    invariantWTOK(ret);
+
+    while ((ret = _cursor->next(_cursor)) == 0) {
+        WT_ITEM key;
+        WT_ITEM value;
+        invariantWTOK(_cursor->get_key(_cursor, &key));
+        invariantWTOK(_cursor->get_value(_cursor, &value));
+
+        StringData ident(static_cast<const char*>(key.data), key.size);
+        BSONObj data(static_cast<const char*>(value.data));
+        const int64_t prefix = data["prefix"].safeNumberLong();
+        _nextPrefix = std::max(_nextPrefix, prefix + 1);
+        if (ident != kHighestPrefixKey) {
+            _entries[ident] = {static_cast<Kind>(data["kind"].numberInt()), prefix};
+        }
+    }
+    invariant(ret == WT_NOTFOUND);
+    invariantWTOK(_cursor->reset(_cursor));
+
+    LOGV2_DEBUG(5843134,
+                1,
+                "Loaded the idents living in shared tables",
+                "numIdents"_attr = _entries.size(),
+                "nextPrefix"_attr = _nextPrefix);
+}
+
+WiredTigerSharedTables::~WiredTigerSharedTables() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_cursor) {
+        _cursor->close(_cursor);
+    }
+}
+
+std::string WiredTigerSharedTables::uriFor(Kind kind) {
+    return std::string("table:") + identFor(kind);
+}
+
+bool WiredTigerSharedTables::isSharedTableIdent(StringData ident) {
+    return ident == identFor(Kind::kRecordStore) || ident == identFor(Kind::kStandardIndex) ||
+        ident == identFor(Kind::kUniqueIndex) || ident == kRegistryIdent;
+}
+
+boost::optional<WiredTigerSharedTables::Entry> WiredTigerSharedTables::find(
+    StringData ident) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(ident);
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+    return it->second;
+}
+
+void WiredTigerSharedTables::_createRegistryIfNeeded() {
+    if (_cursor) {
+        return;
+    }
+
+    WT_SESSION* session = _session.getSession();
+    std::string config = WiredTigerCustomizationHooks::get(getGlobalServiceContext())
+                             ->getTableCreateConfig(kRegistryUri);
+    invariantWTOK(session->create(session, kRegistryUri.c_str(), config.c_str()));
+    invariantWTOK(
+        session->open_cursor(session, kRegistryUri.c_str(), nullptr, "overwrite=true", &_cursor));
+}
+
+Status WiredTigerSharedTables::add(StringData ident, Kind kind, const std::string& config) {
+    invariant(!_readOnly);
+    invariant(!ident.empty());
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (_entries.find(ident) != _entries.end()) {
+        return Status::OK();
+    }
+
+    // Creating a table that already exists does nothing, whatever the configuration.
+    WT_SESSION* session = _session.getSession();
+    const std::string uri = uriFor(kind);
+    if (int ret = session->create(session, uri.c_str(), config.c_str())) {
+        return wtRCToStatus(ret, "WiredTigerSharedTables::add");
+    }
+    _createRegistryIfNeeded();
+
+    const int64_t prefix = _nextPrefix;
+    {
+        ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+        WiredTigerBeginTxnBlock txnOpen(session, nullptr);
+
+        auto write = [&](StringData key, const BSONObj& data) {
+            WiredTigerItem keyItem(key.rawData(), key.size());
+            WiredTigerItem valueItem(data.objdata(), data.objsize());
+            _cursor->set_key(_cursor, keyItem.Get());
+            _cursor->set_value(_cursor, valueItem.Get());
+            invariantWTOK(_cursor->insert(_cursor));
+        };
+        write(ident, BSON("kind" << static_cast<int>(kind) << "prefix" << prefix));
+        write(kHighestPrefixKey, BSON("prefix" << prefix));
+
+        txnOpen.done();
+        invariantWTOK(session->commit_transaction(session, nullptr));
+    }
+
+    _nextPrefix = prefix + 1;
+    _entries[ident] = {kind, prefix};
+    LOGV2_DEBUG(5843135,
+                1,
+                "Added an ident to a shared table",
+                "ident"_attr = ident,
+                "uri"_attr = uri,
+                "prefix"_attr = prefix);
+    return Status::OK();
+}
+
+int WiredTigerSharedTables::_removeInTxn(StringData ident, const Entry& entry) {
+    WT_SESSION* session = _session.getSession();
+    const std::string uri = uriFor(entry.kind);
+
+    WT_CURSOR* start;
+    WT_CURSOR* stop;
+    invariantWTOK(session->open_cursor(session, uri.c_str(), nullptr, nullptr, &start));
+    ON_BLOCK_EXIT([&] { start->close(start); });
+    invariantWTOK(session->open_cursor(session, uri.c_str(), nullptr, nullptr, &stop));
+    ON_BLOCK_EXIT([&] { stop->close(stop); });
+    ON_BLOCK_EXIT([&] { _cursor->reset(_cursor); });
+
+    WiredTigerBeginTxnBlock txnOpen(session, nullptr);
+    if (seekToPrefixBound(start, entry.kind, entry.prefix, /*first=*/true)) {
+        invariant(seekToPrefixBound(stop, entry.kind, entry.prefix, /*first=*/false));
+        if (int ret = session->truncate(session, nullptr, start, stop, nullptr)) {
+            return ret;
+        }
+    }
+
+    WiredTigerItem keyItem(ident.rawData(), ident.size());
+    _cursor->set_key(_cursor, keyItem.Get());
+    if (int ret = _cursor->remove(_cursor)) {
+        return ret;
+    }
+
+    txnOpen.done();
+    return session->commit_transaction(session, nullptr);
+}
+
+void WiredTigerSharedTables::remove(StringData ident) {
+    invariant(!_readOnly);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto it = _entries.find(ident);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    // Nothing else uses the range of a dropped ident, but a large truncate may still be rolled
+    // back to relieve cache pressure, in which case it is retried.
+    int ret;
+    while ((ret = _removeInTxn(ident, it->second)) == WT_ROLLBACK) {
+        LOGV2_DEBUG(5843136, 1, "Retrying the removal of a shared ident", "ident"_attr = ident);
+    }
+    invariantWTOK(ret);
+
+    LOGV2_DEBUG(5843137,
+                1,
+                "Removed an ident from a shared table",
+                "ident"_attr = ident,
+                "prefix"_attr = it->second.prefix);
+    _entries.erase(it);
+}
+
+std::vector<std::string> WiredTigerSharedTables::getAllIdents() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    std::vector<std::string> idents;
+    idents.reserve(_entries.size());
+    for (const auto& entry : _entries) {
+        idents.push_back(entry.first);
+    }
+    return idents;
+}
+
+}  // namespace mongo
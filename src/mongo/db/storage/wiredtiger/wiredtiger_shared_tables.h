@@ -0,0 +1,124 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <string>
+#include <vector>
+
+#include <wiredtiger.h>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+
+namespace mongo {
+
+/**
+ * The WiredTigerSharedTables class keeps track of the record stores and indexes that live in one of
+ * a few WiredTiger tables shared between many idents, rather than in a table of their own. All the
+ * entries of a shared ident are keyed by the ident's prefix followed by the usual key, so that
+ * every ident owns a contiguous range of its shared table.
+ *
+ * The prefix assigned to each shared ident is persisted in a separate WiredTiger table, keyed by
+ * the ident, with a BSON document holding the kind of the ident and its prefix as the value. That
+ * table and the shared tables are created on first use. Prefixes are never reused, so entries left
+ * behind by a drop that did not survive a crash can never be seen by a later ident.
+ */
+class WiredTigerSharedTables {
+public:
+    /**
+     * The kind of a shared ident, which determines the shared table it lives in. Standard and _id
+     * indexes share the same table since they use the same data format version.
+     */
+    enum class Kind { kRecordStore = 0, kStandardIndex = 1, kUniqueIndex = 2 };
+
+    struct Entry {
+        Kind kind;
+        int64_t prefix;
+    };
+
+    WiredTigerSharedTables(WT_CONNECTION* conn, bool readOnly);
+    ~WiredTigerSharedTables();
+
+    /**
+     * Returns the URI of the shared table holding idents of the given kind.
+     */
+    static std::string uriFor(Kind kind);
+
+    /**
+     * Returns true if 'ident' names one of the shared tables, or the table persisting prefixes.
+     */
+    static bool isSharedTableIdent(StringData ident);
+
+    /**
+     * Returns the kind and the prefix of 'ident' if it lives in a shared table.
+     */
+    boost::optional<Entry> find(StringData ident) const;
+
+    /**
+     * Assigns a new prefix to 'ident' in the shared table for 'kind', creating that table with
+     * 'config' first if it does not exist yet. Does nothing if 'ident' is already shared.
+     */
+    Status add(StringData ident, Kind kind, const std::string& config);
+
+    /**
+     * Deletes all the entries of 'ident' from its shared table and forgets its prefix. Does nothing
+     * if 'ident' is not shared.
+     */
+    void remove(StringData ident);
+
+    /**
+     * Returns every ident living in a shared table.
+     */
+    std::vector<std::string> getAllIdents() const;
+
+private:
+    /**
+     * Deletes every entry with the prefix of 'entry' and the persisted prefix of 'ident', in a
+     * single transaction. Returns the WiredTiger error that aborted the transaction, if any.
+     */
+    int _removeInTxn(StringData ident, const Entry& entry);
+
+    void _createRegistryIfNeeded();
+
+    const bool _readOnly;
+
+    // Guards all the members below, and serializes the use of '_session' and '_cursor'.
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerSharedTables::_mutex");
+    WiredTigerSession _session;
+    WT_CURSOR* _cursor = nullptr;  // Null until the table persisting prefixes exists.
+    StringMap<Entry> _entries;
+    int64_t _nextPrefix = 1;
+};
+
+}  // namespace mongo
@@ -74,8 +74,9 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
         return;
 
     // Ordering is important: as the entry may be flushed concurrently, set the dirty flag last.
-    stdx::lock_guard<Latch> lk(_bufferMutex);
-    auto& entry = _buffer[uri];
+    auto& partition = _getPartition(uri);
+    stdx::lock_guard<Latch> lk(partition.mutex);
+    auto& entry = partition.buffer[uri];
     // During rollback it is possible to get a new SizeInfo. In that case clear the dirty flag,
     // so the SizeInfo can be destructed without triggering the dirty check invariant.
     if (entry && entry.get() != sizeInfo.get())
@@ -96,9 +97,10 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
 std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(StringData uri) const {
     {
         // Check if we can satisfy the read from the buffer.
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        Buffer::const_iterator it = _buffer.find(uri);
-        if (it != _buffer.end())
+        const auto& partition = _getPartition(uri);
+        stdx::lock_guard<Latch> bufferLock(partition.mutex);
+        Buffer::const_iterator it = partition.buffer.find(uri);
+        if (it != partition.buffer.end())
             return it->second;
     }
 
@@ -126,15 +128,39 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Strin
                 "WiredTigerSizeStorer::load {uri} -> {data}",
                 "uri"_attr = uri,
                 "data"_attr = redact(data));
-    return std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
-                                      data["dataSize"].safeNumberLong());
+    auto sizeInfo = std::make_shared<SizeInfo>(data["numRecords"].safeNumberLong(),
+                                               data["dataSize"].safeNumberLong());
+    if (auto markers = data["oplogTruncateMarkers"]; markers.type() == Object) {
+        sizeInfo->setOplogTruncateMarkers(markers.Obj());
+    }
+    return sizeInfo;
+}
+
+WiredTigerSizeStorer::BufferPartition& WiredTigerSizeStorer::_getPartition(StringData uri) {
+    return _partitions[StringMapHasher{}(uri) % kNumBufferPartitions];
+}
+
+const WiredTigerSizeStorer::BufferPartition& WiredTigerSizeStorer::_getPartition(
+    StringData uri) const {
+    return _partitions[StringMapHasher{}(uri) % kNumBufferPartitions];
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
+    // Take the entries out one partition at a time, so that writers are never blocked for longer
+    // than a swap or a move of the entries of a single partition.
     Buffer buffer;
-    {
-        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
-        _buffer.swap(buffer);
+    for (auto& partition : _partitions) {
+        Buffer partitionBuffer;
+        {
+            stdx::lock_guard<Latch> bufferLock(partition.mutex);
+            partition.buffer.swap(partitionBuffer);
+        }
+        if (buffer.empty()) {
+            buffer.swap(partitionBuffer);
+        } else {
+            buffer.insert(std::make_move_iterator(partitionBuffer.begin()),
+                          std::make_move_iterator(partitionBuffer.end()));
+        }
     }
 
     if (buffer.empty())
@@ -146,10 +172,10 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
         // On failure, place entries back into the map, unless a newer value already exists.
         ON_BLOCK_EXIT([this, &buffer]() {
             this->_cursor->reset(this->_cursor);
-            if (!buffer.empty()) {
-                stdx::lock_guard<Latch> bufferLock(this->_bufferMutex);
-                for (auto& it : buffer)
-                    this->_buffer.try_emplace(it.first, it.second);
+            for (auto& it : buffer) {
+                auto& partition = this->_getPartition(it.first);
+                stdx::lock_guard<Latch> bufferLock(partition.mutex);
+                partition.buffer.try_emplace(it.first, it.second);
             }
         });
 
@@ -163,8 +189,13 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            BSONObjBuilder dataBuilder;
+            dataBuilder.append("numRecords", sizeInfo.numRecords.load());
+            dataBuilder.append("dataSize", sizeInfo.dataSize.load());
+            if (auto markers = sizeInfo.getOplogTruncateMarkers(); !markers.isEmpty()) {
+                dataBuilder.append("oplogTruncateMarkers", markers);
+            }
+            BSONObj data = dataBuilder.obj();
 
             auto& uri = it->first;
             LOGV2_DEBUG(22425,
@@ -29,11 +29,13 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
 
 #include "mongo/base/string_data.h"
+#include "mongo/bson/bsonobj.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
@@ -44,7 +46,8 @@ namespace mongo {
 /**
  * The WiredTigerSizeStorer class serves as a write buffer to durably store size information for
  * MongoDB collections. The size storer uses a separate WiredTiger table as key-value store, where
- * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields.
+ * the URI serves as key and the value is a BSON document with `numRecords` and `dataSize` fields,
+ * and for the oplog an `oplogTruncateMarkers` field.
  * This buffering is neccessary to allow concurrent updates of size information without causing
  * write conflicts. The dirty size information is periodically stored written back to the table,
  * including on clean shutdown and/or catalog reload. Crashes or replica-set fail-overs may result
@@ -71,9 +74,27 @@ public:
         AtomicWord<long long> numRecords;
         AtomicWord<long long> dataSize;
 
+        /**
+         * The truncate markers of the oplog, stored along with its size so that they do not have to
+         * be computed again on startup. Empty for every other collection.
+         */
+        BSONObj getOplogTruncateMarkers() const {
+            stdx::lock_guard<Latch> lk(_oplogTruncateMarkersMutex);
+            return _oplogTruncateMarkers;
+        }
+
+        void setOplogTruncateMarkers(BSONObj markers) {
+            stdx::lock_guard<Latch> lk(_oplogTruncateMarkersMutex);
+            _oplogTruncateMarkers = markers.getOwned();
+        }
+
     private:
         friend WiredTigerSizeStorer;
         AtomicWord<bool> _dirty;
+
+        mutable Mutex _oplogTruncateMarkersMutex =
+            MONGO_MAKE_LATCH("WiredTigerSizeStorer::SizeInfo::_oplogTruncateMarkersMutex");
+        BSONObj _oplogTruncateMarkers;
     };
 
     WiredTigerSizeStorer(WT_CONNECTION* conn,
@@ -97,14 +118,26 @@ public:
 private:
     const WiredTigerSession _session;
     const bool _readOnly;
-    // Guards _cursor. Acquire *before* _bufferMutex.
+    // Guards _cursor. Acquire *before* any BufferPartition::mutex.
     mutable Mutex _cursorMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_cursorMutex");
     WT_CURSOR* _cursor;  // pointer is const after constructor
 
     using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
 
-    mutable Mutex _bufferMutex =
-        MONGO_MAKE_LATCH("WiredTigerSessionStorer::_bufferMutex");  // Guards _buffer
-    Buffer _buffer;
+    // The buffer is split into partitions by the hash of the URI, so that writers to different
+    // collections marking their SizeInfo dirty do not contend on a single mutex, and so that flush
+    // only holds each partition's mutex long enough to swap its contents out.
+    static constexpr size_t kNumBufferPartitions = 16;
+
+    struct BufferPartition {
+        mutable Mutex mutex =
+            MONGO_MAKE_LATCH("WiredTigerSessionStorer::BufferPartition::mutex");  // Guards buffer
+        Buffer buffer;
+    };
+
+    BufferPartition& _getPartition(StringData uri);
+    const BufferPartition& _getPartition(StringData uri) const;
+
+    std::array<BufferPartition, kNumBufferPartitions> _partitions;
 };
 }  // namespace mongo
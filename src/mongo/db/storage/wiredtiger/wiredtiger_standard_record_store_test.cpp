@@ -53,6 +53,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
@@ -348,5 +349,49 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(), val);
 }
 
+// Size information of many collections which are written concurrently with flushes is not lost.
+TEST_F(SizeStorerUpdateTest, ConcurrentStoresAndFlushes) {
+    const int kNumCollections = 100;
+    const int kNumWriters = 4;
+    const int kNumRounds = 100;
+
+    auto collectionUri = [](int i) {
+        return WiredTigerKVEngine::kTableUriPrefix + "collection-" + std::to_string(i);
+    };
+    std::vector<std::shared_ptr<WiredTigerSizeStorer::SizeInfo>> sizeInfos;
+    for (int i = 0; i < kNumCollections; i++) {
+        sizeInfos.push_back(std::make_shared<WiredTigerSizeStorer::SizeInfo>(0, 0));
+    }
+
+    std::vector<stdx::thread> writers;
+    for (int writer = 0; writer < kNumWriters; writer++) {
+        writers.emplace_back([&, writer] {
+            for (int round = 0; round < kNumRounds; round++) {
+                for (int i = writer; i < kNumCollections; i += kNumWriters) {
+                    sizeInfos[i]->numRecords.fetchAndAdd(1);
+                    sizeInfos[i]->dataSize.fetchAndAdd(10);
+                    sizeStorer->store(collectionUri(i), sizeInfos[i]);
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 10; i++) {
+        sizeStorer->flush(false);
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    sizeStorer->flush(false);
+
+    const bool readOnly = true;
+    WiredTigerSizeStorer reloaded(
+        harnessHelper->conn(), WiredTigerKVEngine::kTableUriPrefix + "sizeStorer", readOnly);
+    for (int i = 0; i < kNumCollections; i++) {
+        auto sizeInfo = reloaded.load(collectionUri(i));
+        ASSERT_EQUALS(kNumRounds, sizeInfo->numRecords.load());
+        ASSERT_EQUALS(10 * kNumRounds, sizeInfo->dataSize.load());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,6 +38,7 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/timeseries/timeseries_field_names.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
@@ -47,6 +48,13 @@ namespace {
 const auto getBucketCatalog = ServiceContext::declareDecoration<BucketCatalog>();
 MONGO_FAIL_POINT_DEFINE(hangTimeseriesDirectModificationBeforeWriteConflict);
 
+// Version of the control field of buckets whose data fields are not compressed.
+constexpr int kUncompressedBucketControlVersion = 1;
+
+// Number of times an insert looks up its open bucket under a shared catalog lock and finds it
+// locked by another writer before it waits for the bucket while holding the catalog lock.
+constexpr int kMaxBucketTryLockAttempts = 4;
+
 uint8_t numDigits(uint32_t num) {
     uint8_t numDigits = 0;
     while (num) {
@@ -141,7 +149,8 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     const StringData::ComparatorInterface* comparator,
     const TimeseriesOptions& options,
     const BSONObj& doc,
-    CombineWithInsertsFromOtherClients combine) {
+    CombineWithInsertsFromOtherClients combine,
+    const BucketFinder& findBucketToReopen) {
 
     BSONObjBuilder metadata;
     if (auto metaField = options.getMetaField()) {
@@ -163,7 +172,19 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
 
     auto time = timeElem.Date();
 
-    BucketAccess bucket{this, key, stats.get(), time};
+    BucketToReopen bucketToReopen;
+    if (findBucketToReopen && gTimeseriesBucketReopeningEnabled.load() && !_hasOpenBucket(key)) {
+        {
+            stdx::lock_guard statesLk{_statesMutex};
+            bucketToReopen.era = _era;
+        }
+        auto bucketDoc = findBucketToReopen(key.metadata.toBSON(), time);
+        if (!bucketDoc.isEmpty()) {
+            bucketToReopen.bucket = _rehydrateBucket(ns, key, options, time, bucketDoc);
+        }
+    }
+
+    BucketAccess bucket{this, key, stats.get(), time, std::move(bucketToReopen)};
     invariant(bucket);
 
     NewFieldNames newFieldNamesToBeInserted;
@@ -202,8 +223,9 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
         return false;
     };
 
+    boost::optional<ClosedBucket> closedBucket;
     if (!bucket->_ns.isEmpty() && isBucketFull(&bucket)) {
-        bucket.rollover(isBucketFull);
+        closedBucket = bucket.rollover(isBucketFull);
         bucket->_calculateBucketFieldsAndSizeChange(doc,
                                                     options.getMetaField(),
                                                     &newFieldNamesToBeInserted,
@@ -214,6 +236,9 @@ StatusWith<std::shared_ptr<BucketCatalog::WriteBatch>> BucketCatalog::insert(
     auto batch = bucket->_activeBatch(getLsid(opCtx, combine), stats);
     batch->_addMeasurement(doc);
     batch->_recordNewFields(std::move(newFieldNamesToBeInserted));
+    if (closedBucket) {
+        batch->_closedBuckets.push_back(std::move(*closedBucket));
+    }
 
     bucket->_numMeasurements++;
     bucket->_size += sizeToBeAdded;
@@ -265,7 +290,8 @@ bool BucketCatalog::prepareCommit(std::shared_ptr<WriteBatch> batch) {
     return true;
 }
 
-void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
+boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::finish(
+    std::shared_ptr<WriteBatch> batch, const CommitInfo& info) {
     invariant(!batch->finished());
     invariant(!batch->active());
 
@@ -291,6 +317,8 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
         bucket->_numCommittedMeasurements += batch->measurements().size();
     }
 
+    boost::optional<ClosedBucket> closedBucket;
+
     if (!bucket) {
         // It's possible that we cleared the bucket in between preparing the commit and finishing
         // here. In this case, we should abort any other ongoing batches and clear the bucket from
@@ -317,11 +345,13 @@ void BucketCatalog::finish(std::shared_ptr<WriteBatch> batch, const CommitInfo&
                 stdx::lock_guard statesLk{_statesMutex};
                 _bucketStates.erase(ptr->_id);
             }
+            closedBucket = ClosedBucket{ptr->_id};
             _allBuckets.erase(ptr);
         } else {
             _markBucketIdle(bucket);
         }
     }
+    return closedBucket;
 }
 
 void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
@@ -356,7 +386,35 @@ void BucketCatalog::clear(const OID& oid) {
     }
 }
 
+void BucketCatalog::handleDirectWrite(OperationContext* opCtx, const OID& oid) {
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        ++_pendingDirectWrites[oid];
+    }
+
+    // The bucket as it was before this write may be read from disk until the write commits, and
+    // must not be reopened until then.
+    auto finish = [this, oid] {
+        stdx::lock_guard statesLk{_statesMutex};
+        auto it = _pendingDirectWrites.find(oid);
+        invariant(it != _pendingDirectWrites.end());
+        if (--it->second == 0) {
+            _pendingDirectWrites.erase(it);
+        }
+        ++_era;
+    };
+    opCtx->recoveryUnit()->onCommit([finish](boost::optional<Timestamp>) { finish(); });
+    opCtx->recoveryUnit()->onRollback(finish);
+
+    clear(oid);
+}
+
 void BucketCatalog::clear(const NamespaceString& ns) {
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        ++_era;
+    }
+
     auto lk = _lockExclusive();
     auto statsLk = _statsMutex.lockExclusive();
 
@@ -389,6 +447,7 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
     builder->appendNumber("numBucketUpdates", stats->numBucketUpdates.load());
     builder->appendNumber("numBucketsOpenedDueToMetadata",
                           stats->numBucketsOpenedDueToMetadata.load());
+    builder->appendNumber("numBucketsReopened", stats->numBucketsReopened.load());
     builder->appendNumber("numBucketsClosedDueToCount", stats->numBucketsClosedDueToCount.load());
     builder->appendNumber("numBucketsClosedDueToSize", stats->numBucketsClosedDueToSize.load());
     builder->appendNumber("numBucketsClosedDueToTimeForward",
@@ -569,6 +628,140 @@ BucketCatalog::Bucket* BucketCatalog::_allocateBucket(const BucketKey& key,
     return bucket;
 }
 
+bool BucketCatalog::_hasOpenBucket(const BucketKey& key) const {
+    {
+        auto lk = _lockShared();
+        if (_openBuckets.contains(key)) {
+            return true;
+        }
+    }
+
+    if (key.metadata.normalized()) {
+        return false;
+    }
+
+    auto normalizedKey = key;
+    normalizedKey.metadata.normalize();
+    auto lk = _lockShared();
+    return _openBuckets.contains(normalizedKey);
+}
+
+std::unique_ptr<BucketCatalog::Bucket> BucketCatalog::_rehydrateBucket(
+    const NamespaceString& ns,
+    const BucketKey& key,
+    const TimeseriesOptions& options,
+    const Date_t& time,
+    const BSONObj& bucketDoc) const {
+    auto idElem = bucketDoc[timeseries::kBucketIdFieldName];
+    auto controlElem = bucketDoc[timeseries::kBucketControlFieldName];
+    auto dataElem = bucketDoc[timeseries::kBucketDataFieldName];
+    if (idElem.type() != jstOID || controlElem.type() != Object || dataElem.type() != Object) {
+        return nullptr;
+    }
+
+    // Compressed and closed buckets are never written to again.
+    auto control = controlElem.embeddedObject();
+    if (control.getIntField("version") != kUncompressedBucketControlVersion ||
+        control.getBoolField("closed")) {
+        return nullptr;
+    }
+
+    auto bucketMetadata = key.metadata;
+    bucketMetadata.normalize();
+    {
+        BSONObjBuilder metadata;
+        auto metaElem = bucketDoc[timeseries::kBucketMetaFieldName];
+        if (auto metaField = options.getMetaField(); metaField && metaElem) {
+            metadata.appendAs(metaElem, *metaField);
+        }
+        BucketMetadata onDiskMetadata{metadata.obj(), key.metadata.getComparator()};
+        onDiskMetadata.normalize();
+        if (!(onDiskMetadata == bucketMetadata)) {
+            return nullptr;
+        }
+    }
+
+    auto bucket = std::make_unique<Bucket>();
+    bucket->_id = idElem.OID();
+    auto bucketTime = bucket->_id.asDateT();
+    if (time < bucketTime || time - bucketTime >= Seconds(options.getBucketMaxSpanSeconds())) {
+        return nullptr;
+    }
+
+    auto timeColumn = dataElem.embeddedObject()[options.getTimeField()];
+    if (timeColumn.type() != Object) {
+        return nullptr;
+    }
+    for (auto&& column : dataElem.embeddedObject()) {
+        if (column.type() != Object) {
+            return nullptr;
+        }
+        bucket->_fieldNames.emplace(column.fieldName());
+    }
+
+    bucket->_numMeasurements = timeColumn.embeddedObject().nFields();
+    bucket->_numCommittedMeasurements = bucket->_numMeasurements;
+    bucket->_size = bucketDoc.objsize();
+    if (bucket->_numMeasurements == 0 ||
+        bucket->_numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount) ||
+        bucket->_size >= static_cast<std::uint64_t>(gTimeseriesBucketMaxSize)) {
+        return nullptr;
+    }
+
+    auto minElem = control["min"];
+    auto maxElem = control["max"];
+    auto latestTimeElem = maxElem.type() == Object
+        ? maxElem.embeddedObject()[options.getTimeField()]
+        : BSONElement();
+    if (minElem.type() != Object || latestTimeElem.type() != Date) {
+        return nullptr;
+    }
+    bucket->_latestTime = latestTimeElem.Date();
+
+    // Since the minimum is no greater than the maximum for every field, treating them as two
+    // measurements yields the same control fields. Only changes from here on are then written.
+    auto comparator = key.metadata.getComparator();
+    bucket->_minmax.update(minElem.embeddedObject(), boost::none, comparator);
+    bucket->_minmax.update(maxElem.embeddedObject(), boost::none, comparator);
+    bucket->_minmax.minUpdates();
+    bucket->_minmax.maxUpdates();
+
+    bucket->_ns = ns;
+    bucket->_metadata = std::move(bucketMetadata);
+
+    // Accounted for the same way as a new bucket in insert().
+    bucket->_memoryUsage += (ns.size() * 2) + (bucket->_metadata.toBSON().objsize() * 2) +
+        sizeof(Bucket) + sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2) +
+        bucket->_minmax.getMemoryUsage();
+
+    return bucket;
+}
+
+BucketCatalog::Bucket* BucketCatalog::_reopenBucket(const BucketKey& key,
+                                                    BucketToReopen bucketToReopen,
+                                                    ExecutionStats* stats) {
+    invariant(bucketToReopen.bucket);
+    {
+        stdx::lock_guard statesLk{_statesMutex};
+        const auto& id = bucketToReopen.bucket->_id;
+        if (bucketToReopen.era != _era || _bucketStates.contains(id) ||
+            _pendingDirectWrites.contains(id)) {
+            return nullptr;
+        }
+        _bucketStates.emplace(id, BucketState::kNormal);
+    }
+
+    _expireIdleBuckets(stats);
+
+    auto [it, inserted] = _allBuckets.insert(std::move(bucketToReopen.bucket));
+    Bucket* bucket = it->get();
+    _openBuckets[key] = bucket;
+    _memoryUsage.fetchAndAdd(bucket->_memoryUsage);
+    stats->numBucketsReopened.fetchAndAddRelaxed(1);
+
+    return bucket;
+}
+
 std::shared_ptr<BucketCatalog::ExecutionStats> BucketCatalog::_getExecutionStats(
     const NamespaceString& ns) {
     {
@@ -737,8 +930,13 @@ std::shared_ptr<BucketCatalog::WriteBatch> BucketCatalog::Bucket::_activeBatch(
 BucketCatalog::BucketAccess::BucketAccess(BucketCatalog* catalog,
                                           BucketKey& key,
                                           ExecutionStats* stats,
-                                          const Date_t& time)
-    : _catalog(catalog), _key(&key), _stats(stats), _time(&time) {
+                                          const Date_t& time,
+                                          BucketToReopen bucketToReopen)
+    : _catalog(catalog),
+      _key(&key),
+      _stats(stats),
+      _time(&time),
+      _bucketToReopen(std::move(bucketToReopen)) {
 
     auto bucketFound = [](BucketState bucketState) {
         return bucketState == BucketState::kNormal || bucketState == BucketState::kPrepared;
@@ -816,7 +1014,7 @@ BucketCatalog::BucketAccess::~BucketAccess() {
 
 BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLock(
     const HashedBucketKey& key) {
-    {
+    for (int attempt = 1;; ++attempt) {
         auto lk = _catalog->_lockShared();
         auto it = _catalog->_openBuckets.find(key);
         if (it == _catalog->_openBuckets.end()) {
@@ -825,7 +1023,21 @@ BucketCatalog::BucketState BucketCatalog::BucketAccess::_findOpenBucketThenLock(
         }
 
         _bucket = it->second;
-        _acquire();
+        if (attempt == kMaxBucketTryLockAttempts) {
+            _acquire();
+            break;
+        }
+
+        // Blocking on a busy bucket here would also block every other writer mapped to the same
+        // stripe of the catalog lock, regardless of the bucket they are after. Instead, back off
+        // and look the bucket up again, since it may not even exist once we get to lock it.
+        _guard = stdx::unique_lock<Mutex>(_bucket->_mutex, stdx::try_to_lock);
+        if (_guard.owns_lock()) {
+            break;
+        }
+        _bucket = nullptr;
+        lk.unlock();
+        stdx::this_thread::yield();
     }
 
     return _confirmStateForAcquiredBucket();
@@ -909,7 +1121,13 @@ void BucketCatalog::BucketAccess::_acquire() {
 void BucketCatalog::BucketAccess::_create(const HashedBucketKey& normalizedKey,
                                           const HashedBucketKey& key,
                                           bool openedDuetoMetadata) {
-    _bucket = _catalog->_allocateBucket(normalizedKey, *_time, _stats, openedDuetoMetadata);
+    _bucket = nullptr;
+    if (_bucketToReopen.bucket) {
+        _bucket = _catalog->_reopenBucket(normalizedKey, std::move(_bucketToReopen), _stats);
+    }
+    if (!_bucket) {
+        _bucket = _catalog->_allocateBucket(normalizedKey, *_time, _stats, openedDuetoMetadata);
+    }
     _catalog->_openBuckets[key] = _bucket;
     _bucket->_nonNormalizedKeyMetadatas.push_back(key.key->metadata.toBSON());
     _acquire();
@@ -938,7 +1156,8 @@ BucketCatalog::BucketAccess::operator BucketCatalog::Bucket*() const {
     return _bucket;
 }
 
-void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess*)>& isBucketFull) {
+boost::optional<BucketCatalog::ClosedBucket> BucketCatalog::BucketAccess::rollover(
+    const std::function<bool(BucketAccess*)>& isBucketFull) {
     invariant(isLocked());
     invariant(_key);
     invariant(_time);
@@ -959,12 +1178,14 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
     // Recheck if still full now that we've reacquired the bucket.
     bool sameBucket =
         oldBucket == _bucket;  // Only record stats if bucket has changed, don't double-count.
+    boost::optional<ClosedBucket> closedBucket;
     if (sameBucket || isBucketFull(this)) {
         // The bucket is indeed full, so create a new one.
         if (_bucket->allCommitted()) {
             // The bucket does not contain any measurements that are yet to be committed, so we can
             // remove it now. Otherwise, we must keep the bucket around until it is committed.
             oldBucket = _bucket;
+            closedBucket = ClosedBucket{oldBucket->_id};
             release();
             bool removed = _catalog->_removeBucket(oldBucket, false /* expiringBuckets */);
             invariant(removed);
@@ -979,6 +1200,7 @@ void BucketCatalog::BucketAccess::rollover(const std::function<bool(BucketAccess
 
         _create(hashedNormalizedKey, hashedKey, false /* openedDueToMetadata */);
     }
+    return closedBucket;
 }
 
 void BucketCatalog::BucketAccess::setTime() {
@@ -1348,6 +1570,11 @@ uint32_t BucketCatalog::WriteBatch::numPreviouslyCommittedMeasurements() const {
     return _numPreviouslyCommittedMeasurements;
 }
 
+const std::vector<BucketCatalog::ClosedBucket>& BucketCatalog::WriteBatch::closedBuckets() const {
+    invariant(!_active);
+    return _closedBuckets;
+}
+
 bool BucketCatalog::WriteBatch::active() const {
     return _active;
 }
@@ -64,6 +64,14 @@ public:
         boost::optional<OID> electionId;
     };
 
+    /**
+     * Information about a bucket which will receive no more measurements, returned when committing
+     * the last batch of the bucket.
+     */
+    struct ClosedBucket {
+        OID bucketId;
+    };
+
     /**
      * The basic unit of work for a bucket. Each insert will return a shared_ptr to a WriteBatch.
      * When a writer is finished with all their insertions, they should then take steps to ensure
@@ -103,6 +111,13 @@ public:
         const StringMap<std::size_t>& newFieldNamesToBeInserted() const;
         uint32_t numPreviouslyCommittedMeasurements() const;
 
+        /**
+         * The full buckets which were closed and removed from the catalog when rolling over to the
+         * bucket of this batch. Must only be accessed by the holder of commit rights once the batch
+         * has been prepared.
+         */
+        const std::vector<ClosedBucket>& closedBuckets() const;
+
         /**
          * Whether the batch is active and can be written to.
          */
@@ -156,6 +171,7 @@ public:
         BSONObj _max;  // Batch-local max; full if first batch, updates otherwise.
         uint32_t _numPreviouslyCommittedMeasurements = 0;
         StringMap<std::size_t> _newFieldNamesToBeInserted;  // Value is hash of string key
+        std::vector<ClosedBucket> _closedBuckets;
 
         bool _active = true;
 
@@ -181,10 +197,21 @@ public:
      */
     BSONObj getMetadata(Bucket* bucket) const;
 
+    /**
+     * Looks for a bucket on disk that a measurement with the given metadata, in the format returned
+     * by getMetadata(), and time could be added to. Returns the bucket document, or an empty
+     * document if there is none.
+     */
+    using BucketFinder = std::function<BSONObj(const BSONObj& metadata, Date_t time)>;
+
     /**
      * Returns the WriteBatch into which the document was inserted. Any caller who receives the same
      * batch may commit or abort the batch after claiming commit rights. See WriteBatch for more
      * details.
+     *
+     * If there is no open bucket for the document's metadata, bucket reopening is enabled and
+     * 'findBucketToReopen' is provided, it is called without holding any of the catalog's locks
+     * and the bucket it returns, if it is not yet full, is reopened instead of starting a new one.
      */
     StatusWith<std::shared_ptr<WriteBatch>> insert(
         OperationContext* opCtx,
@@ -192,7 +219,8 @@ public:
         const StringData::ComparatorInterface* comparator,
         const TimeseriesOptions& options,
         const BSONObj& doc,
-        CombineWithInsertsFromOtherClients combine);
+        CombineWithInsertsFromOtherClients combine,
+        const BucketFinder& findBucketToReopen = nullptr);
 
     /**
      * Prepares a batch for commit, transitioning it to an inactive state. Caller must already have
@@ -203,9 +231,11 @@ public:
 
     /**
      * Records the result of a batch commit. Caller must already have commit rights on batch, and
-     * batch must have been previously prepared.
+     * batch must have been previously prepared. Returns the bucket of the batch if it is full and
+     * has now been removed from the catalog, such that it will not be written to again.
      */
-    void finish(std::shared_ptr<WriteBatch> batch, const CommitInfo& info);
+    boost::optional<ClosedBucket> finish(std::shared_ptr<WriteBatch> batch,
+                                         const CommitInfo& info);
 
     /**
      * Aborts the given write batch and any other outstanding batches on the same bucket. Caller
@@ -221,6 +251,13 @@ public:
      */
     void clear(const OID& oid);
 
+    /**
+     * Clears the bucket with the specified OID, like clear() above, for a write to it from outside
+     * of the catalog. Until the operation's write unit of work commits or rolls back, the bucket
+     * cannot be reopened.
+     */
+    void handleDirectWrite(OperationContext* opCtx, const OID& oid);
+
     /**
      * Clears the buckets for the given namespace.
      */
@@ -567,6 +604,7 @@ private:
         AtomicWord<long long> numBucketInserts;
         AtomicWord<long long> numBucketUpdates;
         AtomicWord<long long> numBucketsOpenedDueToMetadata;
+        AtomicWord<long long> numBucketsReopened;
         AtomicWord<long long> numBucketsClosedDueToCount;
         AtomicWord<long long> numBucketsClosedDueToSize;
         AtomicWord<long long> numBucketsClosedDueToTimeForward;
@@ -674,6 +712,15 @@ private:
         }
     };
 
+    /**
+     * A bucket rebuilt from its document on disk, along with the era of the catalog at the time the
+     * document was read.
+     */
+    struct BucketToReopen {
+        std::unique_ptr<Bucket> bucket;
+        uint64_t era = 0;
+    };
+
     /**
      * Helper class to handle all the locking necessary to lookup and lock a bucket for use. This
      * is intended primarily for using a single bucket, including replacing it when it becomes full.
@@ -686,7 +733,8 @@ private:
         BucketAccess(BucketCatalog* catalog,
                      BucketKey& key,
                      ExecutionStats* stats,
-                     const Date_t& time);
+                     const Date_t& time,
+                     BucketToReopen bucketToReopen = {});
         BucketAccess(BucketCatalog* catalog, Bucket* bucket);
         ~BucketAccess();
 
@@ -702,9 +750,11 @@ private:
          * Close the existing, full bucket and open a new one for the same metadata.
          * Parameter is a function which should check that the bucket is indeed still full after
          * reacquiring the necessary locks. The first parameter will give the function access to
-         * this BucketAccess instance, with the bucket locked.
+         * this BucketAccess instance, with the bucket locked. Returns the closed bucket if it could
+         * be removed from the catalog right away, since it had no uncommitted measurements.
          */
-        void rollover(const std::function<bool(BucketAccess*)>& isBucketFull);
+        boost::optional<ClosedBucket> rollover(
+            const std::function<bool(BucketAccess*)>& isBucketFull);
 
         // Adjust the time associated with the bucket (id) if it hasn't been committed yet.
         void setTime();
@@ -715,7 +765,9 @@ private:
     private:
         /**
          * Helper to find and lock an open bucket for the given metadata if it exists. Takes a
-         * shared lock on the catalog. Returns the state of the bucket if it is locked and usable.
+         * shared lock on the catalog, which is released and reacquired while the bucket is locked
+         * by other writers, up to a few times. Returns the state of the bucket if it is locked and
+         * usable.
          * In case the bucket does not exist or was previously cleared and thus is not usable, the
          * return value will be BucketState::kCleared.
          */
@@ -745,8 +797,8 @@ private:
         // Lock _bucket.
         void _acquire();
 
-        // Allocate a new bucket in the catalog, set the local state to that bucket, and acquire
-        // a lock on it.
+        // Allocate a new bucket in the catalog, or reopen _bucketToReopen if there is one, set the
+        // local state to that bucket, and acquire a lock on it.
         void _create(const HashedBucketKey& normalizedKey,
                      const HashedBucketKey& key,
                      bool openedDuetoMetadata = true);
@@ -755,6 +807,7 @@ private:
         BucketKey* _key = nullptr;
         ExecutionStats* _stats = nullptr;
         const Date_t* _time = nullptr;
+        BucketToReopen _bucketToReopen;
 
         Bucket* _bucket = nullptr;
         stdx::unique_lock<Mutex> _guard;
@@ -817,6 +870,33 @@ private:
                             ExecutionStats* stats,
                             bool openedDuetoMetadata);
 
+    /**
+     * Returns whether there is an open bucket for the given key, whether or not its metadata is
+     * normalized.
+     */
+    bool _hasOpenBucket(const BucketKey& key) const;
+
+    /**
+     * Rebuilds the in-memory state of the bucket stored on disk as 'bucketDoc', as the bucket for
+     * 'key' in 'ns'. Returns nullptr if the bucket cannot be reopened for 'key', either because its
+     * metadata or time range does not match, it is compressed, or it is already full.
+     */
+    std::unique_ptr<Bucket> _rehydrateBucket(const NamespaceString& ns,
+                                             const BucketKey& key,
+                                             const TimeseriesOptions& options,
+                                             const Date_t& time,
+                                             const BSONObj& bucketDoc) const;
+
+    /**
+     * Adds a bucket rebuilt by _rehydrateBucket to the catalog as the open bucket for 'key'.
+     * Returns nullptr, leaving the catalog as it was, if the bucket is already in the catalog, has
+     * a direct write in progress, or may have been written to since it was read. Requires an
+     * exclusive lock on the catalog.
+     */
+    Bucket* _reopenBucket(const BucketKey& key,
+                          BucketToReopen bucketToReopen,
+                          ExecutionStats* stats);
+
     std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns);
     const std::shared_ptr<ExecutionStats> _getExecutionStats(const NamespaceString& ns) const;
 
@@ -860,6 +940,13 @@ private:
     mutable Mutex _statesMutex = MONGO_MAKE_LATCH("BucketCatalog::_statesMutex");
     stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
 
+    // Number of direct writes in progress for each bucket that has any, protected by _statesMutex.
+    stdx::unordered_map<OID, int, OID::Hasher> _pendingDirectWrites;
+
+    // Incremented, under _statesMutex, whenever a direct write finishes or buckets are cleared. A
+    // bucket read from disk may only be reopened if the era has not changed since it was read.
+    uint64_t _era = 0;
+
     // This mutex protects access to _idleBuckets
     mutable Mutex _idleMutex = MONGO_MAKE_LATCH("BucketCatalog::_idleMutex");
 
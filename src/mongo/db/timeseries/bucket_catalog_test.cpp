@@ -35,6 +35,7 @@
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -70,6 +71,7 @@ protected:
                              uint16_t numPreviouslyCommittedMeasurements);
 
     long long _getNumWaits(const NamespaceString& ns);
+    BSONObj _makeBucketToReopen(const OID& id, Date_t time, int meta) const;
 
     OperationContext* _opCtx;
     BucketCatalog* _bucketCatalog;
@@ -167,6 +169,15 @@ long long BucketCatalogTest::_getNumWaits(const NamespaceString& ns) {
     return builder.obj().getIntField("numWaits");
 }
 
+BSONObj BucketCatalogTest::_makeBucketToReopen(const OID& id, Date_t time, int meta) const {
+    return BSON("_id" << id << "control"
+                      << BSON("version" << 1 << "min" << BSON(_timeField << time << "a" << 1)
+                                        << "max" << BSON(_timeField << time << "a" << 3))
+                      << "meta" << meta << "data"
+                      << BSON(_timeField << BSON("0" << time << "1" << time) << "a"
+                                         << BSON("0" << 1 << "1" << 3)));
+}
+
 TEST_F(BucketCatalogTest, InsertIntoSameBucket) {
     // The first insert should be able to take commit rights, but batch is still active
     auto result1 =
@@ -363,6 +374,69 @@ TEST_F(BucketCatalogTest, InsertBetweenPrepareAndFinish) {
     _commit(batch2, 1);
 }
 
+TEST_F(BucketCatalogTest, RolloverReportsClosedBucket) {
+    auto insert = [&](Date_t time) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue();
+    };
+
+    auto time = Date_t::now();
+    auto batch1 = insert(time);
+    auto oldId = batch1->bucket()->id();
+    ASSERT(batch1->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch1);
+    ASSERT(batch1->closedBuckets().empty());
+    ASSERT_FALSE(_bucketCatalog->finish(batch1, {}));
+
+    // A measurement outside of the time span of the committed bucket closes it right away, and the
+    // batch of the new bucket reports it.
+    auto batch2 = insert(time + Hours(2));
+    ASSERT_NE(oldId, batch2->bucket()->id());
+    ASSERT(batch2->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch2);
+    ASSERT_EQ(1U, batch2->closedBuckets().size());
+    ASSERT_EQ(oldId, batch2->closedBuckets()[0].bucketId);
+    ASSERT_FALSE(_bucketCatalog->finish(batch2, {}));
+}
+
+TEST_F(BucketCatalogTest, FinishReportsClosedBucket) {
+    auto insert = [&](Date_t time) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << time),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow)
+            .getValue();
+    };
+
+    auto time = Date_t::now();
+    auto batch1 = insert(time);
+    auto oldId = batch1->bucket()->id();
+    ASSERT(batch1->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch1);
+
+    // The bucket still has a measurement to commit when it is rolled over, so it is only closed
+    // once that is committed.
+    auto batch2 = insert(time + Hours(2));
+    ASSERT_NE(oldId, batch2->bucket()->id());
+    auto closedBucket = _bucketCatalog->finish(batch1, {});
+    ASSERT(closedBucket);
+    ASSERT_EQ(oldId, closedBucket->bucketId);
+
+    ASSERT(batch2->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch2);
+    ASSERT(batch2->closedBuckets().empty());
+    ASSERT_FALSE(_bucketCatalog->finish(batch2, {}));
+}
+
 DEATH_TEST_F(BucketCatalogTest, CannotCommitWithoutRights, "invariant") {
     auto result = _bucketCatalog->insert(_opCtx,
                                          _ns1,
@@ -720,5 +794,134 @@ TEST_F(BucketCatalogTest, DuplicateNewFieldNamesAcrossConcurrentBatches) {
     _bucketCatalog->finish(batch1, {});
 }
 
+TEST_F(BucketCatalogTest, ReopenBucketFromDisk) {
+    RAIIServerParameterControllerForTest controller{"timeseriesBucketReopeningEnabled", true};
+
+    auto time = Date_t::now();
+    OID id;
+    id.init(time);
+    auto findBucket = [&](const BSONObj& metadata, Date_t measurementTime) {
+        ASSERT_BSONOBJ_EQ(metadata, BSON(_metaField << 1));
+        ASSERT_EQ(measurementTime, time + Seconds(1));
+        return _makeBucketToReopen(id, time, 1);
+    };
+
+    auto batch = _bucketCatalog
+                     ->insert(_opCtx,
+                              _ns1,
+                              _getCollator(_ns1),
+                              _getTimeseriesOptions(_ns1),
+                              BSON(_timeField << time + Seconds(1) << _metaField << 1 << "a" << 5),
+                              BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                              findBucket)
+                     .getValue();
+    ASSERT_EQ(batch->bucket()->id(), id);
+
+    // The measurement is written as an update appending to the two on disk, changing only the
+    // maximums.
+    ASSERT(batch->claimCommitRights());
+    _bucketCatalog->prepareCommit(batch);
+    ASSERT_EQ(batch->numPreviouslyCommittedMeasurements(), 2);
+    ASSERT(batch->newFieldNamesToBeInserted().empty());
+    ASSERT_BSONOBJ_EQ(batch->min(), BSONObj());
+    ASSERT_EQ(batch->max()["u"]["a"].numberInt(), 5);
+    ASSERT_EQ(batch->max()["u"][_timeField].Date(), time + Seconds(1));
+    _bucketCatalog->finish(batch, {});
+
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(_ns1, &builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats.getIntField("numBucketsReopened"), 1);
+    ASSERT_EQ(stats.getIntField("numBucketUpdates"), 1);
+    ASSERT_EQ(stats.getIntField("numBucketInserts"), 0);
+}
+
+TEST_F(BucketCatalogTest, DoNotReopenUnsuitableBucket) {
+    RAIIServerParameterControllerForTest controller{"timeseriesBucketReopeningEnabled", true};
+
+    auto time = Date_t::now();
+    OID id;
+    id.init(time);
+    auto insert = [&](const BSONObj& bucketToReopen, Date_t measurementTime) {
+        return _bucketCatalog
+            ->insert(_opCtx,
+                     _ns1,
+                     _getCollator(_ns1),
+                     _getTimeseriesOptions(_ns1),
+                     BSON(_timeField << measurementTime << _metaField << 1),
+                     BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                     [&](const BSONObj&, Date_t) { return bucketToReopen; })
+            .getValue();
+    };
+    auto abort = [&](const std::shared_ptr<BucketCatalog::WriteBatch>& batch) {
+        ASSERT(batch->claimCommitRights());
+        _bucketCatalog->abort(batch);
+    };
+
+    // Different metadata.
+    auto batch = insert(_makeBucketToReopen(id, time, 2), time);
+    ASSERT_NE(batch->bucket()->id(), id);
+    abort(batch);
+
+    // Measurement outside of the bucket's time range.
+    batch = insert(_makeBucketToReopen(id, time, 1), time - Seconds(10));
+    ASSERT_NE(batch->bucket()->id(), id);
+    abort(batch);
+
+    // Compressed bucket.
+    auto compressed = _makeBucketToReopen(id, time, 1);
+    compressed = compressed.addFields(
+        BSON("control" << compressed["control"].Obj().addFields(BSON("version" << 2))));
+    batch = insert(compressed, time);
+    ASSERT_NE(batch->bucket()->id(), id);
+    abort(batch);
+
+    // Bucket with a direct write in progress, and which may have changed once it finished.
+    {
+        WriteUnitOfWork wuow(_opCtx);
+        _bucketCatalog->handleDirectWrite(_opCtx, id);
+        batch = insert(_makeBucketToReopen(id, time, 1), time);
+        ASSERT_NE(batch->bucket()->id(), id);
+        abort(batch);
+    }
+    {
+        auto bucketToReopen = _makeBucketToReopen(id, time, 1);
+        batch = _bucketCatalog
+                    ->insert(_opCtx,
+                             _ns1,
+                             _getCollator(_ns1),
+                             _getTimeseriesOptions(_ns1),
+                             BSON(_timeField << time << _metaField << 1),
+                             BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                             [&](const BSONObj&, Date_t) {
+                                 WriteUnitOfWork wuow(_opCtx);
+                                 _bucketCatalog->handleDirectWrite(_opCtx, id);
+                                 wuow.commit();
+                                 return bucketToReopen;
+                             })
+                    .getValue();
+        ASSERT_NE(batch->bucket()->id(), id);
+        abort(batch);
+    }
+
+    // The same bucket is reopened once nothing stands in the way.
+    batch = insert(_makeBucketToReopen(id, time, 1), time);
+    ASSERT_EQ(batch->bucket()->id(), id);
+    abort(batch);
+
+    // Nothing is looked up with reopening disabled.
+    RAIIServerParameterControllerForTest disabled{"timeseriesBucketReopeningEnabled", false};
+    batch = _bucketCatalog
+                ->insert(_opCtx,
+                         _ns1,
+                         _getCollator(_ns1),
+                         _getTimeseriesOptions(_ns1),
+                         BSON(_timeField << time << _metaField << 1),
+                         BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                         [](const BSONObj&, Date_t) -> BSONObj { MONGO_UNREACHABLE; })
+                .getValue();
+    ASSERT_NE(batch->bucket()->id(), id);
+}
+
 }  // namespace
 }  // namespace mongo
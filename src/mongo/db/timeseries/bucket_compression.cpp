@@ -0,0 +1,395 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+
+#include <string>
+
+#include "mongo/base/data_view.h"
+#include "mongo/db/timeseries/timeseries_field_names.h"
+#include "mongo/platform/bits.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace timeseries {
+
+namespace {
+
+constexpr uint8_t kFormatVersion = 1;
+
+// Control bytes which are not BSON types.
+constexpr uint8_t kEnd = 0x00;
+constexpr uint8_t kRepeat = 0xF0;
+constexpr uint8_t kSkip = 0xF1;
+
+void appendVarint(BufBuilder* buf, uint64_t value) {
+    while (value >= 0x80) {
+        buf->appendChar(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    buf->appendChar(static_cast<char>(value));
+}
+
+uint64_t zigZagEncode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t zigZagDecode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+bool isIntegral(BSONType type) {
+    return type == NumberInt || type == NumberLong || type == Date || type == bsonTimestamp;
+}
+
+uint64_t readIntegral(const BSONElement& elem) {
+    if (elem.type() == NumberInt) {
+        return static_cast<uint64_t>(static_cast<int64_t>(elem._numberInt()));
+    }
+    return ConstDataView(elem.value()).read<LittleEndian<uint64_t>>();
+}
+
+/**
+ * The codec state carried from one value to the next. It is reset whenever the type of the values
+ * changes, and is left untouched by repeated rows, so that the encoder and the decoder always agree
+ * on it.
+ */
+struct ColumnState {
+    void resetIfTypeChanged(BSONType type) {
+        if (type != lastType) {
+            lastType = type;
+            lastIntegral = 0;
+            lastDelta = 0;
+            lastDoubleBits = 0;
+        }
+    }
+
+    BSONType lastType = EOO;
+
+    // Integral arithmetic is done on unsigned values so that it wraps instead of overflowing.
+    uint64_t lastIntegral = 0;
+    uint64_t lastDelta = 0;
+    uint64_t lastDoubleBits = 0;
+};
+
+/**
+ * Parses a row index field name, rejecting anything that would not round-trip through
+ * std::to_string().
+ */
+bool parseRowIndex(StringData fieldName, int64_t* row) {
+    if (fieldName.empty() || fieldName.size() > 9) {
+        return false;
+    }
+    if (fieldName.size() > 1 && fieldName[0] == '0') {
+        return false;
+    }
+    int64_t value = 0;
+    for (char c : fieldName) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    *row = value;
+    return true;
+}
+
+/**
+ * Bounds-checked reader over the payload of a compressed column.
+ */
+class Reader {
+public:
+    Reader(const char* data, int len) : _pos(data), _end(data + len) {}
+
+    uint8_t readByte() {
+        uassert(5843108, "Truncated compressed time-series column", _pos < _end);
+        return static_cast<uint8_t>(*_pos++);
+    }
+
+    uint64_t readVarint() {
+        uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            uassert(5843109, "Malformed varint in compressed time-series column", shift < 64);
+            uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    const char* readBytes(uint64_t len) {
+        uassert(5843110,
+                "Truncated compressed time-series column",
+                len <= static_cast<uint64_t>(_end - _pos));
+        const char* bytes = _pos;
+        _pos += len;
+        return bytes;
+    }
+
+private:
+    const char* _pos;
+    const char* _end;
+};
+
+void appendRawElement(BSONObjBuilder* builder,
+                      StringData fieldName,
+                      BSONType type,
+                      const char* value,
+                      size_t len) {
+    auto& bb = builder->bb();
+    bb.appendNum(static_cast<char>(type));
+    bb.appendStr(fieldName);
+    bb.appendBuf(value, len);
+}
+
+}  // namespace
+
+bool isCompressedColumn(const BSONElement& column) {
+    return column.type() == BinData && column.binDataType() == bdtCustom;
+}
+
+bool appendCompressedColumn(BSONObjBuilder* builder, StringData fieldName, const BSONObj& column) {
+    BufBuilder buf;
+    buf.appendChar(static_cast<char>(kFormatVersion));
+
+    ColumnState state;
+    BSONElement last;
+    int64_t lastRow = -1;
+    uint64_t pendingRepeats = 0;
+    auto flushRepeats = [&] {
+        if (pendingRepeats) {
+            buf.appendChar(static_cast<char>(kRepeat));
+            appendVarint(&buf, pendingRepeats);
+            pendingRepeats = 0;
+        }
+    };
+
+    for (auto&& elem : column) {
+        int64_t row;
+        if (!parseRowIndex(elem.fieldNameStringData(), &row) || row <= lastRow) {
+            return false;
+        }
+
+        if (row == lastRow + 1 && !last.eoo() && elem.type() == last.type() &&
+            elem.valuesize() == last.valuesize() &&
+            memcmp(elem.value(), last.value(), elem.valuesize()) == 0) {
+            ++pendingRepeats;
+            lastRow = row;
+            continue;
+        }
+
+        flushRepeats();
+        if (row > lastRow + 1) {
+            buf.appendChar(static_cast<char>(kSkip));
+            appendVarint(&buf, row - lastRow - 1);
+        }
+
+        auto type = elem.type();
+        buf.appendChar(static_cast<char>(type));
+        state.resetIfTypeChanged(type);
+
+        if (isIntegral(type)) {
+            uint64_t value = readIntegral(elem);
+            uint64_t delta = value - state.lastIntegral;
+            appendVarint(&buf, zigZagEncode(static_cast<int64_t>(delta - state.lastDelta)));
+            state.lastIntegral = value;
+            state.lastDelta = delta;
+        } else if (type == NumberDouble) {
+            // The header byte holds the number of trailing zero bytes of the XOR in its high nibble
+            // and the number of bytes which follow in its low nibble.
+            uint64_t bits = ConstDataView(elem.value()).read<LittleEndian<uint64_t>>();
+            uint64_t xored = bits ^ state.lastDoubleBits;
+            state.lastDoubleBits = bits;
+            if (!xored) {
+                buf.appendChar(0);
+            } else {
+                int trailing = countTrailingZeros64(xored) / 8;
+                int count = 8 - countLeadingZeros64(xored) / 8 - trailing;
+                buf.appendChar(static_cast<char>((trailing << 4) | count));
+                xored >>= 8 * trailing;
+                for (int i = 0; i < count; ++i, xored >>= 8) {
+                    buf.appendChar(static_cast<char>(xored & 0xFF));
+                }
+            }
+        } else {
+            appendVarint(&buf, elem.valuesize());
+            buf.appendBuf(elem.value(), elem.valuesize());
+        }
+
+        last = elem;
+        lastRow = row;
+    }
+    flushRepeats();
+    buf.appendChar(static_cast<char>(kEnd));
+
+    builder->appendBinData(fieldName, buf.len(), bdtCustom, buf.buf());
+    return true;
+}
+
+BSONObj decompressColumn(const BSONElement& column) {
+    invariant(isCompressedColumn(column));
+
+    int len;
+    const char* data = column.binData(len);
+    Reader reader(data, len);
+
+    auto version = reader.readByte();
+    uassert(5843111,
+            str::stream() << "Unsupported compressed time-series column version "
+                          << static_cast<int>(version),
+            version == kFormatVersion);
+
+    BSONObjBuilder builder;
+    ColumnState state;
+    int64_t nextRow = 0;
+
+    // The last value appended, kept outside of the builder's buffer which may be reallocated.
+    BSONType lastType = EOO;
+    std::string lastValue;
+
+    while (true) {
+        auto control = reader.readByte();
+        if (control == kEnd) {
+            break;
+        }
+        if (control == kSkip) {
+            nextRow += reader.readVarint();
+            continue;
+        }
+        if (control == kRepeat) {
+            uassert(5843112,
+                    "Repeat without a value in compressed time-series column",
+                    lastType != EOO);
+            for (auto count = reader.readVarint(); count > 0; --count) {
+                appendRawElement(&builder,
+                                 std::to_string(nextRow++),
+                                 lastType,
+                                 lastValue.data(),
+                                 lastValue.size());
+            }
+            continue;
+        }
+
+        auto type = static_cast<BSONType>(static_cast<signed char>(control));
+        uassert(5843113,
+                str::stream() << "Invalid type " << static_cast<int>(control)
+                              << " in compressed time-series column",
+                isValidBSONType(type));
+        state.resetIfTypeChanged(type);
+
+        if (isIntegral(type)) {
+            state.lastDelta += static_cast<uint64_t>(zigZagDecode(reader.readVarint()));
+            state.lastIntegral += state.lastDelta;
+            if (type == NumberInt) {
+                char bytes[4];
+                DataView(bytes).write<LittleEndian<int32_t>>(
+                    static_cast<int32_t>(state.lastIntegral));
+                lastValue.assign(bytes, sizeof(bytes));
+            } else {
+                char bytes[8];
+                DataView(bytes).write<LittleEndian<uint64_t>>(state.lastIntegral);
+                lastValue.assign(bytes, sizeof(bytes));
+            }
+        } else if (type == NumberDouble) {
+            auto header = reader.readByte();
+            int trailing = header >> 4;
+            int count = header & 0x0F;
+            uassert(5843114,
+                    "Malformed double in compressed time-series column",
+                    trailing + count <= 8);
+            uint64_t xored = 0;
+            for (int i = 0; i < count; ++i) {
+                xored |= static_cast<uint64_t>(reader.readByte()) << (8 * i);
+            }
+            state.lastDoubleBits ^= xored << (8 * trailing);
+            char bytes[8];
+            DataView(bytes).write<LittleEndian<uint64_t>>(state.lastDoubleBits);
+            lastValue.assign(bytes, sizeof(bytes));
+        } else {
+            auto size = reader.readVarint();
+            lastValue.assign(reader.readBytes(size), size);
+        }
+
+        lastType = type;
+        appendRawElement(
+            &builder, std::to_string(nextRow++), lastType, lastValue.data(), lastValue.size());
+    }
+
+    return builder.obj();
+}
+
+BSONObj compressBucket(const BSONObj& bucket) {
+    auto data = bucket[kBucketDataFieldName];
+    if (data.type() != Object) {
+        return bucket;
+    }
+
+    // Compress the data region first, since the control version depends on whether any column
+    // could be compressed.
+    bool compressedAnyColumn = false;
+    BSONObjBuilder dataBuilder;
+    for (auto&& column : data.embeddedObject()) {
+        if (column.type() == Object &&
+            appendCompressedColumn(
+                &dataBuilder, column.fieldNameStringData(), column.embeddedObject())) {
+            compressedAnyColumn = true;
+        } else {
+            dataBuilder.append(column);
+        }
+    }
+    if (!compressedAnyColumn) {
+        return bucket;
+    }
+
+    BSONObjBuilder builder;
+    for (auto&& elem : bucket) {
+        auto fieldName = elem.fieldNameStringData();
+        if (fieldName == kBucketDataFieldName) {
+            builder.append(kBucketDataFieldName, dataBuilder.done());
+        } else if (fieldName == kBucketControlFieldName && elem.type() == Object) {
+            BSONObjBuilder controlBuilder(builder.subobjStart(kBucketControlFieldName));
+            controlBuilder.append("version", kCompressedBucketControlVersion);
+            for (auto&& controlElem : elem.embeddedObject()) {
+                if (controlElem.fieldNameStringData() != "version"_sd) {
+                    controlBuilder.append(controlElem);
+                }
+            }
+        } else {
+            builder.append(elem);
+        }
+    }
+    return builder.obj();
+}
+
+}  // namespace timeseries
+}  // namespace mongo
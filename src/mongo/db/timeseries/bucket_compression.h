@@ -0,0 +1,86 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/bsonobjbuilder.h"
+
+namespace mongo {
+namespace timeseries {
+
+/**
+ * Compressed format for the columns of the data region of a time-series bucket.
+ *
+ * An uncompressed column is an object whose field names are increasing row indexes ("0", "1", ...)
+ * with a gap wherever a measurement lacks the field. A compressed column holds the same values in
+ * a BinData of subtype 'bdtCustom', starting with a format version byte, followed by a sequence of
+ * records each introduced by a control byte:
+ *
+ *  - the BSON type of the value in the next row, followed by the value. Integral values (ints,
+ *    longs, dates and timestamps) are stored as the zig-zag varint of their delta-of-delta against
+ *    the preceding values of the same type, doubles as the non-zero bytes of their XOR against the
+ *    preceding double, and all other values as their varint length followed by their raw bytes;
+ *  - kRepeat, followed by a varint count of consecutive rows repeating the previous value;
+ *  - kSkip, followed by a varint count of row indexes without a value;
+ *  - kEnd, which terminates the column.
+ *
+ * Monotonic timestamps and slowly changing measurements thus compress to a byte or two per row, and
+ * runs of repeated values, such as strings, to a few bytes per run.
+ */
+
+// The control.version of a bucket with compressed data columns. Uncompressed buckets are version 1.
+static constexpr int kCompressedBucketControlVersion = 2;
+
+/**
+ * Returns true if 'column' is a data column in the compressed format.
+ */
+bool isCompressedColumn(const BSONElement& column);
+
+/**
+ * Appends a compressed version of the uncompressed data column 'column' to 'builder' under
+ * 'fieldName'. Returns false without appending anything if the field names of 'column' are not
+ * increasing row indexes, in which case the column cannot be compressed.
+ */
+bool appendCompressedColumn(BSONObjBuilder* builder, StringData fieldName, const BSONObj& column);
+
+/**
+ * Returns the uncompressed version of the compressed data column 'column'.
+ */
+BSONObj decompressColumn(const BSONElement& column);
+
+/**
+ * Returns a copy of the bucket document 'bucket' in which all columns of the data region are
+ * compressed, except for those which cannot be compressed, and whose control.version is
+ * 'kCompressedBucketControlVersion'. Returns 'bucket' itself if no column can be compressed.
+ */
+BSONObj compressBucket(const BSONObj& bucket);
+
+}  // namespace timeseries
+}  // namespace mongo
@@ -0,0 +1,166 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/unittest/bson_test_util.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+BSONObj roundTrip(const BSONObj& column) {
+    BSONObjBuilder builder;
+    ASSERT(timeseries::appendCompressedColumn(&builder, "c", column));
+    auto compressed = builder.obj();
+    ASSERT(timeseries::isCompressedColumn(compressed["c"]));
+    return timeseries::decompressColumn(compressed["c"]).getOwned();
+}
+
+int compressedSize(const BSONObj& column) {
+    BSONObjBuilder builder;
+    ASSERT(timeseries::appendCompressedColumn(&builder, "c", column));
+    int len;
+    builder.obj()["c"].binData(len);
+    return len;
+}
+
+TEST(BucketCompressionTest, RoundTripsMonotonicDates) {
+    BSONObjBuilder builder;
+    auto start = Date_t::fromMillisSinceEpoch(1620000000000);
+    for (int i = 0; i < 100; ++i) {
+        builder.append(std::to_string(i), start + Seconds(i));
+    }
+    auto column = builder.obj();
+
+    ASSERT_BSONOBJ_BINARY_EQ(column, roundTrip(column));
+    // Constant deltas encode to a zero delta-of-delta after the first two values.
+    ASSERT_LT(compressedSize(column), column.objsize() / 4);
+}
+
+TEST(BucketCompressionTest, RoundTripsIntegers) {
+    auto column = BSON("0" << 1 << "1" << -5 << "2" << std::numeric_limits<int>::max() << "3"
+                           << std::numeric_limits<long long>::min() << "4" << 7LL << "5"
+                           << Timestamp(10, 1) << "6" << Timestamp(10, 2) << "7" << 3);
+    ASSERT_BSONOBJ_BINARY_EQ(column, roundTrip(column));
+}
+
+TEST(BucketCompressionTest, RoundTripsDoubles) {
+    auto column = BSON("0" << 20.5 << "1" << 20.5 << "2" << 20.75 << "3" << -0.0 << "4"
+                           << std::numeric_limits<double>::quiet_NaN() << "5"
+                           << std::numeric_limits<double>::infinity() << "6" << 1e-300);
+    ASSERT_BSONOBJ_BINARY_EQ(column, roundTrip(column));
+}
+
+TEST(BucketCompressionTest, RoundTripsRepeatedValues) {
+    BSONObjBuilder builder;
+    for (int i = 0; i < 1000; ++i) {
+        builder.append(std::to_string(i), i < 500 ? "sensor-a" : "sensor-b");
+    }
+    auto column = builder.obj();
+
+    ASSERT_BSONOBJ_BINARY_EQ(column, roundTrip(column));
+    ASSERT_LT(compressedSize(column), column.objsize() / 100);
+}
+
+TEST(BucketCompressionTest, RoundTripsSparseMixedColumns) {
+    auto column = BSON("1" << BSON("a" << 1) << "2" << BSON("a" << 1) << "4" << "x"
+                           << "5" << BSONNULL << "9" << 1.5 << "10" << 2 << "11"
+                           << BSON_ARRAY(1 << 2) << "20" << MINKEY << "21" << MAXKEY);
+    ASSERT_BSONOBJ_BINARY_EQ(column, roundTrip(column));
+}
+
+TEST(BucketCompressionTest, RoundTripsEmptyColumn) {
+    ASSERT_BSONOBJ_BINARY_EQ(BSONObj(), roundTrip(BSONObj()));
+}
+
+TEST(BucketCompressionTest, RejectsColumnsWithoutIncreasingRowIndexes) {
+    for (auto&& column : {BSON("1" << 1 << "0" << 2),
+                          BSON("0" << 1 << "0" << 2),
+                          BSON("a" << 1),
+                          BSON("01" << 1),
+                          BSON("-1" << 1)}) {
+        BSONObjBuilder builder;
+        ASSERT_FALSE(timeseries::appendCompressedColumn(&builder, "c", column));
+        ASSERT_BSONOBJ_EQ(BSONObj(), builder.obj());
+    }
+}
+
+TEST(BucketCompressionTest, RejectsTruncatedColumns) {
+    BSONObjBuilder builder;
+    ASSERT(timeseries::appendCompressedColumn(&builder, "c", BSON("0" << "abc" << "1" << 2)));
+    auto compressed = builder.obj();
+    int len;
+    const char* data = compressed["c"].binData(len);
+
+    BSONObjBuilder truncated;
+    // Cut the payload in the middle of the string value.
+    ASSERT_GT(len, 6);
+    truncated.appendBinData("c", 6, bdtCustom, data);
+    ASSERT_THROWS_CODE(timeseries::decompressColumn(truncated.obj()["c"]).getOwned(),
+                       DBException,
+                       5843110);
+}
+
+TEST(BucketCompressionTest, CompressesBucketDataColumns) {
+    auto bucket = BSON("_id" << OID::gen() << "control"
+                             << BSON("version" << 1 << "min" << BSON("t" << 1) << "max"
+                                               << BSON("t" << 2))
+                             << "data"
+                             << BSON("t" << BSON("0" << 1 << "1" << 2) << "a"
+                                         << BSON("1" << "x") << "b"
+                                         << BSON("1" << 1 << "0" << 2)));
+    auto compressed = timeseries::compressBucket(bucket);
+
+    ASSERT_BSONELT_EQ(bucket["_id"], compressed["_id"]);
+    ASSERT_BSONOBJ_EQ(BSON("version" << timeseries::kCompressedBucketControlVersion << "min"
+                                     << BSON("t" << 1) << "max" << BSON("t" << 2)),
+                      compressed["control"].Obj());
+
+    auto data = compressed["data"].Obj();
+    ASSERT(timeseries::isCompressedColumn(data["t"]));
+    ASSERT(timeseries::isCompressedColumn(data["a"]));
+    // A column whose row indexes are out of order is copied as-is.
+    ASSERT_FALSE(timeseries::isCompressedColumn(data["b"]));
+    ASSERT_BSONOBJ_EQ(bucket["data"]["b"].Obj(), data["b"].Obj());
+
+    ASSERT_BSONOBJ_BINARY_EQ(bucket["data"]["t"].Obj(), timeseries::decompressColumn(data["t"]));
+    ASSERT_BSONOBJ_BINARY_EQ(bucket["data"]["a"].Obj(), timeseries::decompressColumn(data["a"]));
+}
+
+TEST(BucketCompressionTest, LeavesBucketWithoutCompressibleColumnsAsIs) {
+    auto bucket = BSON("_id" << OID::gen() << "control" << BSON("version" << 1) << "data"
+                             << BSON("t" << BSON("1" << 1 << "0" << 2)));
+    ASSERT_BSONOBJ_BINARY_EQ(bucket, timeseries::compressBucket(bucket));
+}
+
+}  // namespace
+}  // namespace mongo
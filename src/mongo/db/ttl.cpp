@@ -33,6 +33,9 @@
 
 #include "mongo/db/ttl.h"
 
+#include <map>
+#include <vector>
+
 #include "mongo/base/counter.h"
 #include "mongo/db/auth/authorization_session.h"
 #include "mongo/db/auth/user_name.h"
@@ -41,6 +44,7 @@
 #include "mongo/db/catalog/index_catalog.h"
 #include "mongo/db/client.h"
 #include "mongo/db/commands/fsync_locked.h"
+#include "mongo/db/commands/server_status.h"
 #include "mongo/db/commands/server_status_metric.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/db_raii.h"
@@ -60,6 +64,8 @@
 #include "mongo/db/ttl_gen.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/background.h"
 #include "mongo/util/concurrency/idle_thread_block.h"
 #include "mongo/util/log_with_sampling.h"
@@ -84,6 +90,112 @@ ServerStatusMetricField<Counter64> ttlDeletedDocumentsDisplay("ttl.deletedDocume
                                                               &ttlDeletedDocuments);
 using MtabType = TenantMigrationAccessBlocker::BlockerType;
 
+namespace {
+
+/**
+ * Reports what the TTL monitor did for each TTL index in the "ttl" serverStatus section, keyed by
+ * namespace and index name. The index of a collection clustered by _id is reported as "_id".
+ */
+class TTLIndexStatsSSS : public ServerStatusSection {
+public:
+    TTLIndexStatsSSS() : ServerStatusSection("ttl") {}
+
+    bool includeByDefault() const override {
+        return false;
+    }
+
+    BSONObj generateSection(OperationContext* opCtx,
+                            const BSONElement& configElement) const override {
+        stdx::lock_guard<Latch> lk(_mutex);
+        std::map<std::string, BSONObjBuilder> collections;
+        for (const auto& [key, stats] : _stats) {
+            BSONObjBuilder indexBuilder(collections[stats.ns.ns()].subobjStart(key.second));
+            indexBuilder.append("passes", stats.passes);
+            indexBuilder.append("deletedDocuments", stats.deletedDocuments);
+            indexBuilder.append("stoppedForReplicationLag", stats.stoppedForReplicationLag);
+            indexBuilder.append("lastDurationMillis",
+                                durationCount<Milliseconds>(stats.lastDuration));
+            indexBuilder.append("lastRun", stats.lastRun);
+        }
+
+        BSONObjBuilder builder;
+        for (auto& [ns, collectionBuilder] : collections) {
+            builder.append(ns, collectionBuilder.done());
+        }
+        return builder.obj();
+    }
+
+    /**
+     * Records a deletion pass over the TTL index 'indexName' of the collection 'uuid'.
+     */
+    void recordPass(const UUID& uuid,
+                    const NamespaceString& nss,
+                    const std::string& indexName,
+                    long long numDeleted,
+                    Milliseconds duration,
+                    bool stoppedForReplicationLag) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto& stats = _stats[{uuid, indexName}];
+        stats.ns = nss;
+        ++stats.passes;
+        stats.deletedDocuments += numDeleted;
+        stats.stoppedForReplicationLag += stoppedForReplicationLag;
+        stats.lastDuration = duration;
+        stats.lastRun = Date_t::now();
+    }
+
+    /**
+     * Forgets the TTL index 'indexName' of the collection 'uuid', or every TTL index of the
+     * collection when 'indexName' is not given.
+     */
+    void remove(const UUID& uuid, boost::optional<std::string> indexName = boost::none) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        for (auto it = _stats.begin(); it != _stats.end();) {
+            if (it->first.first == uuid && (!indexName || it->first.second == *indexName)) {
+                it = _stats.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    struct IndexStats {
+        NamespaceString ns;
+        long long passes = 0;
+        long long deletedDocuments = 0;
+        long long stoppedForReplicationLag = 0;
+        Milliseconds lastDuration{0};
+        Date_t lastRun;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("TTLIndexStatsSSS::_mutex");
+    std::map<std::pair<UUID, std::string>, IndexStats> _stats;
+} ttlIndexStats;
+
+constexpr auto kClusteredIdIndexName = "_id"_sd;
+
+/**
+ * Returns whether the majority commit point lags the last applied optime by more than
+ * ttlMonitorMaxReplicationLagSecs, in which case the TTL monitor stops deleting until its next
+ * pass to let the secondaries catch up.
+ */
+bool replicationLagExceeded(OperationContext* opCtx) {
+    const auto maxLagSecs = ttlMonitorMaxReplicationLagSecs.load();
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    if (maxLagSecs == 0 || !replCoord->isReplEnabled()) {
+        return false;
+    }
+
+    const auto lastApplied = replCoord->getMyLastAppliedOpTime().getTimestamp();
+    const auto lastCommitted = replCoord->getLastCommittedOpTime().getTimestamp();
+    return static_cast<long long>(lastApplied.getSecs()) -
+        static_cast<long long>(lastCommitted.getSecs()) >
+        maxLagSecs;
+}
+
+}  // namespace
+
 class TTLMonitor : public BackgroundJob {
 public:
     explicit TTLMonitor() : BackgroundJob(false /* selfDelete */) {}
@@ -192,40 +304,107 @@ private:
         // Increment the metric after the TTL work has been finished.
         ON_BLOCK_EXIT([&] { ttlPasses.increment(); });
 
-        // Perform a pass for every collection and index described as being TTL.
+        // Perform a pass for every collection and index described as being TTL, on up to
+        // ttlMonitorConcurrency threads which each take the next TTL index to work on.
+        std::vector<std::pair<UUID, TTLCollectionCache::Info>> work;
         for (const auto& [uuid, infos] : ttlInfos) {
             for (const auto& info : infos) {
-                // Skip collections that have not been made visible yet. The TTLCollectionCache
-                // already has the index information available, so we want to avoid removing it
-                // until the collection is visible.
-                auto collectionCatalog = CollectionCatalog::get(opCtx);
-                if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
-                    continue;
-                }
-
-                // The collection was dropped.
-                auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
-                if (!nss) {
-                    ttlCollectionCache.deregisterTTLInfo(uuid, info);
-                    continue;
-                }
+                work.emplace_back(uuid, info);
+            }
+        }
 
-                try {
-                    deleteExpired(opCtx, &ttlCollectionCache, uuid, *nss, info);
-                } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
-                    LOGV2_WARNING(22537,
-                                  "TTLMonitor was interrupted, waiting before doing another pass",
-                                  "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+        AtomicWord<size_t> nextWork{0};
+        AtomicWord<bool> interrupted{false};
+        auto runWorker = [&](OperationContext* workerOpCtx) {
+            while (!interrupted.load()) {
+                const auto idx = nextWork.fetchAndAdd(1);
+                if (idx >= work.size()) {
                     return;
-                } catch (const DBException& ex) {
-                    LOGV2_ERROR(5400703,
-                                "Error running TTL job on collection",
-                                logAttrs(*nss),
-                                "error"_attr = ex);
-                    continue;
                 }
+                if (!doTTLIndexPass(
+                        workerOpCtx, &ttlCollectionCache, work[idx].first, work[idx].second)) {
+                    interrupted.store(true);
+                }
+            }
+        };
+
+        const auto numThreads =
+            std::min(static_cast<size_t>(ttlMonitorConcurrency.load()), work.size());
+        auto serviceContext = opCtx->getServiceContext();
+        std::vector<stdx::thread> threads;
+        ON_BLOCK_EXIT([&] {
+            for (auto&& thread : threads) {
+                thread.join();
+            }
+        });
+
+        try {
+            for (size_t idx = 1; idx < numThreads; ++idx) {
+                threads.emplace_back([&runWorker, &interrupted, serviceContext, idx] {
+                    const std::string threadName = str::stream() << "TTLMonitorWorker-" << idx;
+                    ThreadClient tc(threadName, serviceContext);
+                    AuthorizationSession::get(cc())->grantInternalAuthorization(&cc());
+                    {
+                        stdx::lock_guard<Client> lk(*tc.get());
+                        tc.get()->setSystemOperationKillableByStepdown(lk);
+                    }
+
+                    try {
+                        auto workerOpCtx = cc().makeOperationContext();
+                        runWorker(workerOpCtx.get());
+                    } catch (const DBException& ex) {
+                        LOGV2_DEBUG(5963017, 1, "TTL monitor worker failed", "error"_attr = ex);
+                        interrupted.store(true);
+                    }
+                });
             }
+        } catch (const std::exception& ex) {
+            // The threads which did start, and this one, still work through every TTL index.
+            LOGV2_WARNING(5963018,
+                          "Failed to start a TTL monitor worker",
+                          "error"_attr = ex.what(),
+                          "numThreads"_attr = threads.size() + 1);
+        }
+
+        runWorker(opCtx);
+    }
+
+    /**
+     * Deletes the expired documents of the collection 'uuid' described by 'info'. Returns false
+     * when the TTL monitor was interrupted and should wait for its next pass.
+     */
+    bool doTTLIndexPass(OperationContext* opCtx,
+                        TTLCollectionCache* ttlCollectionCache,
+                        const UUID& uuid,
+                        const TTLCollectionCache::Info& info) {
+        // Skip collections that have not been made visible yet. The TTLCollectionCache already
+        // has the index information available, so we want to avoid removing it until the
+        // collection is visible.
+        auto collectionCatalog = CollectionCatalog::get(opCtx);
+        if (collectionCatalog->isCollectionAwaitingVisibility(uuid)) {
+            return true;
+        }
+
+        // The collection was dropped.
+        auto nss = collectionCatalog->lookupNSSByUUID(opCtx, uuid);
+        if (!nss) {
+            ttlCollectionCache->deregisterTTLInfo(uuid, info);
+            ttlIndexStats.remove(uuid);
+            return true;
         }
+
+        try {
+            deleteExpired(opCtx, ttlCollectionCache, uuid, *nss, info);
+        } catch (const ExceptionForCat<ErrorCategory::Interruption>&) {
+            LOGV2_WARNING(22537,
+                          "TTLMonitor was interrupted, waiting before doing another pass",
+                          "wait"_attr = Milliseconds(Seconds(ttlMonitorSleepSecs.load())));
+            return false;
+        } catch (const DBException& ex) {
+            LOGV2_ERROR(
+                5400703, "Error running TTL job on collection", logAttrs(*nss), "error"_attr = ex);
+        }
+        return true;
     }
 
     /**
@@ -268,6 +447,15 @@ private:
             return;
         }
 
+        if (replicationLagExceeded(opCtx)) {
+            LOGV2_DEBUG(5963019,
+                        1,
+                        "Postpone TTL of collection because replication is lagging",
+                        logAttrs(nss),
+                        "maxLagSecs"_attr = ttlMonitorMaxReplicationLagSecs.load());
+            return;
+        }
+
         std::shared_ptr<TenantMigrationAccessBlocker> mtab;
         if (coll.getDb() &&
             nullptr !=
@@ -318,6 +506,23 @@ private:
         return Date_t::now() - Seconds(expireAfterSeconds);
     }
 
+    /**
+     * Returns the parameters of a delete of expired documents, which deletes ttlMonitorBatchSize
+     * documents at a time and stops after a batch once replication lags too far behind, setting
+     * 'stoppedForReplicationLag'.
+     */
+    std::unique_ptr<DeleteStageParams> makeDeleteStageParams(OperationContext* opCtx,
+                                                             bool* stoppedForReplicationLag) {
+        auto params = std::make_unique<DeleteStageParams>();
+        params->isMulti = true;
+        params->batchSize = static_cast<size_t>(ttlMonitorBatchSize.load());
+        params->continueAfterBatch = [opCtx, stoppedForReplicationLag](size_t) {
+            *stoppedForReplicationLag = replicationLagExceeded(opCtx);
+            return !*stoppedForReplicationLag;
+        };
+        return params;
+    }
+
     /**
      * Removes documents from the collection using the specified TTL index after a sufficient
      * amount of time has passed according to its expiry specification.
@@ -329,6 +534,7 @@ private:
         if (!DurableCatalog::get(opCtx)->isIndexPresent(
                 opCtx, collection->getCatalogId(), indexName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
+            ttlIndexStats.remove(collection->uuid(), indexName);
             return;
         }
 
@@ -336,6 +542,7 @@ private:
             DurableCatalog::get(opCtx)->getIndexSpec(opCtx, collection->getCatalogId(), indexName);
         if (!spec.hasField(IndexDescriptor::kExpireAfterSecondsFieldName)) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(), indexName);
+            ttlIndexStats.remove(collection->uuid(), indexName);
             return;
         }
 
@@ -406,8 +613,8 @@ private:
         auto canonicalQuery = CanonicalQuery::canonicalize(opCtx, std::move(findCommand));
         invariant(canonicalQuery.getStatus());
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
+        bool stoppedForReplicationLag = false;
+        auto params = makeDeleteStageParams(opCtx, &stoppedForReplicationLag);
         params->canonicalQuery = canonicalQuery.getValue().get();
 
         Timer timer;
@@ -427,6 +634,12 @@ private:
             ttlDeletedDocuments.increment(numDeleted);
 
             const auto duration = Milliseconds(timer.millis());
+            ttlIndexStats.recordPass(collection->uuid(),
+                                     collection->ns(),
+                                     name.toString(),
+                                     numDeleted,
+                                     duration,
+                                     stoppedForReplicationLag);
             if (shouldLogSlowOpWithSampling(opCtx,
                                             logv2::LogComponent::kIndex,
                                             duration,
@@ -462,6 +675,7 @@ private:
         if (!expireAfterSeconds) {
             ttlCollectionCache->deregisterTTLInfo(collection->uuid(),
                                                   TTLCollectionCache::ClusteredId{});
+            ttlIndexStats.remove(collection->uuid(), kClusteredIdIndexName.toString());
             return;
         }
 
@@ -479,8 +693,12 @@ private:
 
         const auto endId = record_id_helpers::keyForOID(endOID);
 
-        auto params = std::make_unique<DeleteStageParams>();
-        params->isMulti = true;
+        // Only ObjectId _id values carry a time, so start from the lowest ObjectId. Documents in a
+        // clustered collection whose _id is of another type never expire.
+        const auto startId = record_id_helpers::keyForOID(OID());
+
+        bool stoppedForReplicationLag = false;
+        auto params = makeDeleteStageParams(opCtx, &stoppedForReplicationLag);
 
         // Deletes records using a bounded collection scan from the beginning of time to the
         // expiration time (inclusive).
@@ -491,7 +709,7 @@ private:
                                                       std::move(params),
                                                       PlanYieldPolicy::YieldPolicy::YIELD_AUTO,
                                                       InternalPlanner::Direction::FORWARD,
-                                                      boost::none /* minRecord */,
+                                                      startId,
                                                       endId);
 
         try {
@@ -499,6 +717,12 @@ private:
             ttlDeletedDocuments.increment(numDeleted);
 
             const auto duration = Milliseconds(timer.millis());
+            ttlIndexStats.recordPass(collection->uuid(),
+                                     collection->ns(),
+                                     kClusteredIdIndexName.toString(),
+                                     numDeleted,
+                                     duration,
+                                     stoppedForReplicationLag);
             if (shouldLogSlowOpWithSampling(opCtx,
                                             logv2::LogComponent::kIndex,
                                             duration,
@@ -57,6 +57,14 @@ public:
         visitor->visit(this);
     }
 
+    ArithmeticOp getOp() const {
+        return _op;
+    }
+
+    BSONElement getValue() const {
+        return _val;
+    }
+
 protected:
     ModifyResult updateExistingElement(mutablebson::Element* element,
                                        const FieldRef& elementPath) const final;
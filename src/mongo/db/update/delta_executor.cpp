@@ -39,7 +39,26 @@ namespace mongo {
 
 DeltaExecutor::ApplyResult DeltaExecutor::applyUpdate(
     UpdateExecutor::ApplyParams applyParams) const {
-    const auto originalDoc = applyParams.element.getDocument().getObject();
+    auto& doc = applyParams.element.getDocument();
+
+    // When the storage engine can write damages, try to overwrite the updated values in place
+    // rather than rebuilding the document. Replacement updates are not validated for storage nor
+    // checked against immutable paths when applying oplog entries, so skipping the replacement
+    // executor below only skips those checks when they would have been no-ops.
+    if (doc.isInPlaceModeEnabled() && applyParams.element == doc.root() &&
+        !applyParams.validateForStorage && applyParams.immutablePaths.empty()) {
+        if (auto inPlace = doc_diff::applyDiffInPlace(&doc, _diff, applyParams.indexData)) {
+            if (inPlace->noop) {
+                return ApplyResult::noopResult();
+            }
+            ApplyResult result;
+            result.indexesAffected = inPlace->indexesAffected;
+            result.oplogEntry = _outputOplogEntry;
+            return result;
+        }
+    }
+
+    const auto originalDoc = doc.getObject();
 
     auto applyDiffOutput = doc_diff::applyDiff(
         originalDoc, _diff, applyParams.indexData, _mustCheckExistenceForInsertOperations);
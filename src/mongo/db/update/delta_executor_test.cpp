@@ -31,6 +31,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cstring>
+
 #include "mongo/bson/json.h"
 #include "mongo/bson/mutable/document.h"
 #include "mongo/db/update/delta_executor.h"
@@ -384,5 +386,66 @@ TEST(DeltaExecutorTest, ArraysAfterIndexPath) {
     }
 }
 
+TEST(DeltaExecutorTest, SameSizeUpdatesAreAppliedInPlace) {
+    BSONObj preImage(fromjson("{_id: 1, a: 1, b: {c: 'xyz', d: [1, 2, 3]}, e: 'long string'}"));
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("e"));
+    FieldRefSet fieldRefSet;
+    constexpr bool mustCheckExistenceForInsertOperations = true;
+
+    // Applies the diff to a document in in-place mode, as UpdateStage does when applying oplog
+    // entries, and returns the damages it recorded applied to a copy of the pre image.
+    auto applyInPlace = [&](const BSONObj& diff, bool expectInPlace, bool expectIndexesAffected) {
+        mutablebson::Document doc(preImage, mutablebson::Document::kInPlaceEnabled);
+        UpdateExecutor::ApplyParams params(doc.root(), fieldRefSet);
+        params.indexData = &indexData;
+        params.validateForStorage = false;
+        DeltaExecutor test(diff, mustCheckExistenceForInsertOperations);
+        auto result = test.applyUpdate(params);
+        ASSERT_FALSE(result.noop);
+        ASSERT_EQ(expectIndexesAffected, result.indexesAffected);
+
+        mutablebson::DamageVector damages;
+        const char* source = nullptr;
+        ASSERT_EQ(expectInPlace, doc.getInPlaceUpdates(&damages, &source));
+        if (!expectInPlace) {
+            return doc.getObject();
+        }
+        ASSERT_FALSE(damages.empty());
+        BSONObj postImage = preImage.copy();
+        for (auto&& damage : damages) {
+            std::memcpy(const_cast<char*>(postImage.objdata()) + damage.targetOffset,
+                        source + damage.sourceOffset,
+                        damage.size);
+        }
+        ASSERT_BSONOBJ_BINARY_EQ(postImage, doc.getObject());
+        return postImage;
+    };
+
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{u: {a: 2}, sb: {u: {c: 'abc'}, sd: {a: true, u1: 5}}}"),
+                     true,
+                     false),
+        fromjson("{_id: 1, a: 2, b: {c: 'abc', d: [1, 5, 3]}, e: 'long string'}"));
+
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{u: {e: 'LONG STRING'}}"), true, true),
+        fromjson("{_id: 1, a: 1, b: {c: 'xyz', d: [1, 2, 3]}, e: 'LONG STRING'}"));
+
+    // Anything that changes the layout of the document rewrites it.
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{u: {a: 2.5}}"), false, false),
+        fromjson("{_id: 1, a: 2.5, b: {c: 'xyz', d: [1, 2, 3]}, e: 'long string'}"));
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{u: {e: 'short'}}"), false, true),
+        fromjson("{_id: 1, a: 1, b: {c: 'xyz', d: [1, 2, 3]}, e: 'short'}"));
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{i: {f: 1}}"), false, false),
+        fromjson("{_id: 1, a: 1, b: {c: 'xyz', d: [1, 2, 3]}, e: 'long string', f: 1}"));
+    ASSERT_BSONOBJ_BINARY_EQ(
+        applyInPlace(fromjson("{sb: {sd: {a: true, l: 2}}}"), false, false),
+        fromjson("{_id: 1, a: 1, b: {c: 'xyz', d: [1, 2]}, e: 'long string'}"));
+}
+
 }  // namespace
 }  // namespace mongo
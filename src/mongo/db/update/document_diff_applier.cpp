@@ -29,6 +29,8 @@
 
 #include "mongo/platform/basic.h"
 
+#include <cstring>
+
 #include "mongo/db/field_ref.h"
 #include "mongo/db/update/document_diff_applier.h"
 #include "mongo/db/update_index_data.h"
@@ -340,6 +342,127 @@ private:
     bool _mustCheckExistenceForInsertOperations = true;
     bool _indexesAffected = false;
 };
+
+/**
+ * Checks whether a diff can be applied in place and, if so, collects the values it overwrites.
+ * Nothing is modified, so that the caller can still fall back to rebuilding the document.
+ */
+class InPlaceDiffPlanner {
+public:
+    struct Overwrite {
+        FieldRef path;
+        BSONElement newValue;
+    };
+
+    explicit InPlaceDiffPlanner(const UpdateIndexData* indexData) : _indexData(indexData) {}
+
+    bool planObject(const BSONObj& preImage, FieldRef* path, DocumentDiffReader* reader) {
+        const DocumentDiffTables tables = buildObjDiffTables(reader);
+
+        size_t numMatched = 0;
+        for (auto&& elt : preImage) {
+            if (numMatched == tables.fieldMap.size()) {
+                break;
+            }
+            auto it = tables.fieldMap.find(elt.fieldNameStringData());
+            if (it == tables.fieldMap.end()) {
+                continue;
+            }
+            ++numMatched;
+
+            FieldRef::FieldRefTempAppend tempAppend(*path, elt.fieldNameStringData());
+            const bool applicable = stdx::visit(
+                visit_helper::Overloaded{
+                    [](Delete) { return false; },
+                    [](const Insert&) { return false; },
+                    [&](const Update& update) { return planOverwrite(elt, path, update.newElt); },
+                    [&](const SubDiff& subDiff) { return planSubDiff(elt, path, subDiff.reader); },
+                },
+                it->second);
+            if (!applicable) {
+                return false;
+            }
+        }
+
+        // Updates of fields the pre image does not have append them, which is not in place.
+        return numMatched == tables.fieldMap.size();
+    }
+
+    const std::vector<Overwrite>& overwrites() const {
+        return _overwrites;
+    }
+
+    bool indexesAffected() const {
+        return _indexesAffected;
+    }
+
+private:
+    bool planArray(const BSONObj& arrayPreImage, FieldRef* path, ArrayDiffReader* reader) {
+        if (reader->newSize()) {
+            return false;
+        }
+
+        auto nextMod = reader->next();
+        size_t idx = 0;
+        for (BSONObjIterator preImageIt(arrayPreImage); preImageIt.more() && nextMod;
+             ++idx, ++preImageIt) {
+            if (idx != nextMod->first) {
+                continue;
+            }
+
+            auto elt = *preImageIt;
+            FieldRef::FieldRefTempAppend tempAppend(*path, elt.fieldNameStringData());
+            const bool applicable = stdx::visit(
+                visit_helper::Overloaded{
+                    [&](const BSONElement& update) { return planOverwrite(elt, path, update); },
+                    [&](auto subReader) {
+                        return planSubDiff(
+                            elt,
+                            path,
+                            stdx::variant<DocumentDiffReader, ArrayDiffReader>(subReader));
+                    },
+                },
+                nextMod->second);
+            if (!applicable) {
+                return false;
+            }
+            nextMod = reader->next();
+        }
+
+        // Modifications past the end of the array pad it, which is not in place.
+        return !nextMod;
+    }
+
+    bool planSubDiff(const BSONElement& elt,
+                     FieldRef* path,
+                     stdx::variant<DocumentDiffReader, ArrayDiffReader> reader) {
+        if (auto docReader = stdx::get_if<DocumentDiffReader>(&reader)) {
+            return elt.type() == BSONType::Object &&
+                planObject(elt.embeddedObject(), path, docReader);
+        }
+        return elt.type() == BSONType::Array &&
+            planArray(elt.embeddedObject(), path, stdx::get_if<ArrayDiffReader>(&reader));
+    }
+
+    bool planOverwrite(const BSONElement& elt, FieldRef* path, const BSONElement& newValue) {
+        invariant(!newValue.eoo());
+        if (elt.valuesize() != newValue.valuesize()) {
+            return false;
+        }
+        if (_indexData) {
+            _indexesAffected = _indexesAffected || _indexData->mightBeIndexed(*path);
+        }
+        if (elt.type() != newValue.type() ||
+            std::memcmp(elt.value(), newValue.value(), elt.valuesize()) != 0) {
+            _overwrites.push_back({*path, newValue});
+        }
+        return true;
+    }
+
+    const UpdateIndexData* _indexData;
+    std::vector<Overwrite> _overwrites;
+    bool _indexesAffected = false;
+};
 }  // namespace
 
 ApplyDiffOutput applyDiff(const BSONObj& pre,
@@ -353,4 +476,26 @@ ApplyDiffOutput applyDiff(const BSONObj& pre,
     applier.applyDiffToObject(pre, &path, &reader, &out);
     return {out.obj(), applier.indexesAffected()};
 }
+
+boost::optional<ApplyDiffInPlaceOutput> applyDiffInPlace(mutablebson::Document* doc,
+                                                         const Diff& diff,
+                                                         const UpdateIndexData* indexData) {
+    const BSONObj preImage = doc->getObject();
+    DocumentDiffReader reader(diff);
+    InPlaceDiffPlanner planner(indexData);
+    FieldRef path;
+    if (!planner.planObject(preImage, &path, &reader)) {
+        return boost::none;
+    }
+
+    for (auto&& [overwritePath, newValue] : planner.overwrites()) {
+        auto elem = doc->root();
+        for (FieldIndex i = 0; i < overwritePath.numParts(); ++i) {
+            elem = elem.findFirstChildNamed(overwritePath.getPart(i));
+            invariant(elem.ok());
+        }
+        invariantStatusOK(elem.setValueBSONElement(newValue));
+    }
+    return ApplyDiffInPlaceOutput{planner.overwrites().empty(), planner.indexesAffected()};
+}
 }  // namespace mongo::doc_diff
@@ -29,7 +29,10 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+
 #include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/bson/mutable/document.h"
 #include "mongo/db/update/document_diff_serialization.h"
 #include "mongo/db/update_index_data.h"
 
@@ -53,5 +56,22 @@ ApplyDiffOutput applyDiff(const BSONObj& pre,
                           const Diff& diff,
                           const UpdateIndexData* indexData,
                           bool mustCheckExistenceForInsertOperations);
+
+struct ApplyDiffInPlaceOutput {
+    bool noop;
+    bool indexesAffected;
+};
+
+/**
+ * Applies the diff to 'doc' by overwriting the values of existing fields and array elements, when
+ * that is all the diff does and every new value has the same size as the value it replaces. This
+ * lets a document in in-place mode record the update as damages to the original BSON instead of
+ * being rewritten. Returns boost::none, leaving 'doc' untouched, if the diff inserts, deletes or
+ * resizes anything, or does not match the shape of the pre image. The caller should then fall
+ * back to applyDiff(). Throws if the diff is invalid.
+ */
+boost::optional<ApplyDiffInPlaceOutput> applyDiffInPlace(mutablebson::Document* doc,
+                                                         const Diff& diff,
+                                                         const UpdateIndexData* indexData);
 }  // namespace doc_diff
 }  // namespace mongo
@@ -0,0 +1,244 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/update/fixed_width_update.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/update/arithmetic_node.h"
+#include "mongo/db/update/set_node.h"
+#include "mongo/db/update/update_node_visitor.h"
+#include "mongo/db/update/update_object_node.h"
+#include "mongo/db/update/update_oplog_entry_serialization.h"
+#include "mongo/db/update/update_oplog_entry_version.h"
+#include "mongo/util/safe_num.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Collects the modifiers directly below the root of an update tree, giving up on the first node
+ * that cannot be applied by overwriting a top-level numeric value.
+ */
+class FieldUpdateCollector final : public UpdateNodeVisitor {
+public:
+    explicit FieldUpdateCollector(std::vector<FixedWidthUpdate::FieldUpdate>* updates)
+        : _updates(updates) {}
+
+    bool collect(UpdateObjectNode* root) {
+        if (root->hasPositionalChild()) {
+            return false;
+        }
+        for (const auto& [fieldName, child] : root->getChildren()) {
+            _fieldName = fieldName;
+            child->acceptVisitor(this);
+            if (!_eligible) {
+                return false;
+            }
+        }
+        return !_updates->empty();
+    }
+
+    void visit(AddToSetNode*) final {
+        _eligible = false;
+    }
+    void visit(ArithmeticNode* node) final {
+        const auto op = node->getOp() == ArithmeticNode::ArithmeticOp::kAdd
+            ? FixedWidthUpdate::Op::kInc
+            : FixedWidthUpdate::Op::kMul;
+        _add(op, node->getValue());
+    }
+    void visit(BitNode*) final {
+        _eligible = false;
+    }
+    void visit(CompareNode*) final {
+        _eligible = false;
+    }
+    void visit(ConflictPlaceholderNode*) final {
+        _eligible = false;
+    }
+    void visit(CurrentDateNode*) final {
+        _eligible = false;
+    }
+    void visit(PopNode*) final {
+        _eligible = false;
+    }
+    void visit(PullAllNode*) final {
+        _eligible = false;
+    }
+    void visit(PullNode*) final {
+        _eligible = false;
+    }
+    void visit(PushNode*) final {
+        _eligible = false;
+    }
+    void visit(RenameNode*) final {
+        _eligible = false;
+    }
+    void visit(SetElementNode*) final {
+        _eligible = false;
+    }
+    void visit(SetNode* node) final {
+        if (node->context != UpdateNode::Context::kAll) {
+            _eligible = false;
+            return;
+        }
+        _add(FixedWidthUpdate::Op::kSet, node->val);
+    }
+    void visit(UnsetNode*) final {
+        _eligible = false;
+    }
+    void visit(UpdateArrayNode*) final {
+        _eligible = false;
+    }
+    void visit(UpdateObjectNode*) final {
+        // Only top-level fields are supported.
+        _eligible = false;
+    }
+
+private:
+    void _add(FixedWidthUpdate::Op op, BSONElement operand) {
+        if (!operand.isNumber()) {
+            _eligible = false;
+            return;
+        }
+        _updates->push_back({FieldRef(_fieldName), op, operand});
+    }
+
+    std::vector<FixedWidthUpdate::FieldUpdate>* _updates;
+    StringData _fieldName;
+    bool _eligible = true;
+};
+
+}  // namespace
+
+std::unique_ptr<FixedWidthUpdate> FixedWidthUpdate::make(UpdateObjectNode* root) {
+    auto update = std::make_unique<FixedWidthUpdate>();
+    FieldUpdateCollector collector(&update->_updates);
+    if (!collector.collect(root)) {
+        return nullptr;
+    }
+    return update;
+}
+
+bool FixedWidthUpdate::affectsIndexes(const UpdateIndexData* indexData) const {
+    if (!indexData) {
+        return false;
+    }
+    return std::any_of(_updates.begin(), _updates.end(), [&](const auto& update) {
+        return indexData->mightBeIndexed(update.path);
+    });
+}
+
+bool FixedWidthUpdate::modifiesAnyOf(const FieldRefSet& immutablePaths) const {
+    return std::any_of(_updates.begin(), _updates.end(), [&](const auto& update) {
+        return immutablePaths.findConflicts(&update.path, nullptr);
+    });
+}
+
+boost::optional<FixedWidthUpdate::Result> FixedWidthUpdate::computeDamages(
+    const BSONObj& doc,
+    UpdateExecutor::ApplyParams::LogMode logMode,
+    mutablebson::DamageVector* damages) {
+    damages->clear();
+
+    // The values being overwritten, in the same order as their new values in '_newValues'.
+    std::vector<BSONElement> targets;
+    BSONObjBuilder newValues;
+    for (const auto& update : _updates) {
+        const auto fieldName = update.path.getPart(0);
+        const auto original = doc.getField(fieldName);
+        if (!original.isNumber()) {
+            return boost::none;
+        }
+
+        if (update.op == Op::kSet) {
+            if (original.type() != update.operand.type()) {
+                return boost::none;
+            }
+            if (original.binaryEqualValues(update.operand)) {
+                continue;
+            }
+            newValues.appendAs(update.operand, fieldName);
+        } else {
+            // Mirrors ArithmeticNode::updateExistingElement().
+            SafeNum originalValue(original);
+            SafeNum valueToSet(update.operand);
+            if (update.op == Op::kInc) {
+                valueToSet += originalValue;
+            } else {
+                valueToSet *= originalValue;
+            }
+            if (valueToSet.isIdentical(originalValue)) {
+                continue;
+            }
+            if (!valueToSet.isValid() || valueToSet.type() != original.type()) {
+                return boost::none;
+            }
+            valueToSet.toBSON(fieldName, &newValues);
+        }
+        targets.push_back(original);
+    }
+    _newValues = newValues.obj();
+
+    Result result;
+    if (targets.empty()) {
+        return result;
+    }
+    result.noop = false;
+
+    BSONObjIterator newValuesIt(_newValues);
+    for (const auto& target : targets) {
+        const auto newValue = newValuesIt.next();
+        invariant(newValue.valuesize() == target.valuesize());
+        damages->push_back({static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                newValue.value() - _newValues.objdata()),
+                            static_cast<mutablebson::DamageEvent::OffsetSizeType>(
+                                target.value() - doc.objdata()),
+                            static_cast<size_t>(target.valuesize())});
+    }
+
+    switch (logMode) {
+        case UpdateExecutor::ApplyParams::LogMode::kDoNotGenerateOplogEntry:
+            break;
+        case UpdateExecutor::ApplyParams::LogMode::kGenerateOnlyV1OplogEntry:
+            result.oplogEntry = BSON(kUpdateOplogEntryVersionFieldName
+                                     << static_cast<int>(UpdateOplogEntryVersion::kUpdateNodeV1)
+                                     << "$set" << _newValues);
+            break;
+        case UpdateExecutor::ApplyParams::LogMode::kGenerateOplogEntry:
+            result.oplogEntry = update_oplog_entry::makeDeltaOplogEntry(
+                BSON(doc_diff::kUpdateSectionFieldName << _newValues));
+            break;
+    }
+    return result;
+}
+
+}  // namespace mongo
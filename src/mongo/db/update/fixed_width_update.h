@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/bson/mutable/damage_vector.h"
+#include "mongo/db/field_ref.h"
+#include "mongo/db/field_ref_set.h"
+#include "mongo/db/update/update_executor.h"
+#include "mongo/db/update_index_data.h"
+
+namespace mongo {
+
+class UpdateObjectNode;
+
+/**
+ * Applies an update made up only of $inc, $mul and numeric $set modifiers on top-level fields by
+ * overwriting the bytes of the values it changes. This is only possible when every new value has
+ * the same BSON type as the value it replaces, which keeps the size and layout of the document
+ * unchanged, so the update can be written to storage as damages without first loading the
+ * document into a mutablebson::Document.
+ */
+class FixedWidthUpdate {
+public:
+    enum class Op { kInc, kMul, kSet };
+
+    struct FieldUpdate {
+        FieldRef path;
+        Op op;
+        BSONElement operand;
+    };
+
+    struct Result {
+        bool noop = true;
+        BSONObj oplogEntry;
+    };
+
+    /**
+     * Returns a FixedWidthUpdate equivalent to the update tree rooted at 'root', or nullptr if the
+     * tree contains a modifier other than $inc, $mul or a $set of a number, a dotted or positional
+     * path, or a $setOnInsert.
+     */
+    static std::unique_ptr<FixedWidthUpdate> make(UpdateObjectNode* root);
+
+    /**
+     * Returns true if a path this update modifies might be indexed according to 'indexData'.
+     */
+    bool affectsIndexes(const UpdateIndexData* indexData) const;
+
+    /**
+     * Returns true if a path this update modifies is a prefix of, or is prefixed by, one of the
+     * 'immutablePaths'.
+     */
+    bool modifiesAnyOf(const FieldRefSet& immutablePaths) const;
+
+    /**
+     * Computes the damages that apply this update to 'doc' and stores them in 'damages'. Their
+     * source offsets refer to the buffer returned by source(), which stays valid until the next
+     * call. Returns boost::none, leaving 'damages' in an unspecified state, if one of the fields
+     * is missing from 'doc' or the new value would not have the same type as the old one; the
+     * update must then be applied through the update tree, which also reports any error.
+     *
+     * The returned oplog entry matches the one the update tree would generate for 'logMode'.
+     */
+    boost::optional<Result> computeDamages(const BSONObj& doc,
+                                           UpdateExecutor::ApplyParams::LogMode logMode,
+                                           mutablebson::DamageVector* damages);
+
+    const char* source() const {
+        return _newValues.objdata();
+    }
+
+private:
+    // Ordered by field name, in the order the update tree applies and logs them.
+    std::vector<FieldUpdate> _updates;
+
+    // The new values computed by the last call to computeDamages().
+    BSONObj _newValues;
+};
+
+}  // namespace mongo
@@ -58,6 +58,23 @@ MONGO_FAIL_POINT_DEFINE(hangAfterPipelineUpdateFCVCheck);
 using pathsupport::EqualityMatches;
 
 namespace {
+UpdateExecutor::ApplyParams::LogMode getOplogEntryLogMode() {
+    const auto& fcvState = serverGlobalParams.featureCompatibility;
+
+    // Updates may be run as part of the startup sequence, before the global FCV state has been
+    // initialized. We conservatively do not permit the use of $v:2 oplog entries in these
+    // situations.
+
+    // TODO SERVER-51075: Remove FCV check for $v:2 delta oplog entries.
+    const bool fcvAllowsV2Entries = fcvState.isVersionInitialized() &&
+        fcvState.isGreaterThanOrEqualTo(
+            ServerGlobalParams::FeatureCompatibility::Version::kVersion47);
+
+    return fcvAllowsV2Entries && internalQueryEnableLoggingV2OplogEntries.load()
+        ? UpdateExecutor::ApplyParams::LogMode::kGenerateOplogEntry
+        : UpdateExecutor::ApplyParams::LogMode::kGenerateOnlyV1OplogEntry;
+}
+
 modifiertable::ModifierType validateMod(BSONElement mod) {
     auto modType = modifiertable::getType(mod.fieldName());
 
@@ -186,6 +203,7 @@ void UpdateDriver::parse(
 
     auto root = std::make_unique<UpdateObjectNode>();
     _positional = parseUpdateExpression(updateExpr, root.get(), _expCtx, arrayFilters);
+    _fixedWidthUpdate = FixedWidthUpdate::make(root.get());
     _updateExecutor = std::make_unique<UpdateTreeExecutor>(std::move(root));
 }
 
@@ -265,20 +283,7 @@ Status UpdateDriver::update(OperationContext* opCtx,
     invariant(!modifiedPaths || modifiedPaths->empty());
 
     if (_logOp && logOpRec) {
-        const auto& fcvState = serverGlobalParams.featureCompatibility;
-
-        // Updates may be run as part of the startup sequence, before the global FCV state has been
-        // initialized. We conservatively do not permit the use of $v:2 oplog entries in these
-        // situations.
-
-        // TODO SERVER-51075: Remove FCV check for $v:2 delta oplog entries.
-        const bool fcvAllowsV2Entries = fcvState.isVersionInitialized() &&
-            fcvState.isGreaterThanOrEqualTo(
-                ServerGlobalParams::FeatureCompatibility::Version::kVersion47);
-
-        applyParams.logMode = fcvAllowsV2Entries && internalQueryEnableLoggingV2OplogEntries.load()
-            ? ApplyParams::LogMode::kGenerateOplogEntry
-            : ApplyParams::LogMode::kGenerateOnlyV1OplogEntry;
+        applyParams.logMode = getOplogEntryLogMode();
 
         if (MONGO_unlikely(hangAfterPipelineUpdateFCVCheck.shouldFail()) &&
             type() == UpdateType::kPipeline) {
@@ -304,6 +309,36 @@ Status UpdateDriver::update(OperationContext* opCtx,
     return Status::OK();
 }
 
+bool UpdateDriver::updateWithDamages(const BSONObj& doc,
+                                     const FieldRefSet& immutablePaths,
+                                     mutablebson::DamageVector* damages,
+                                     const char** source,
+                                     BSONObj* logOpRec,
+                                     bool* docWasModified) {
+    if (!_fixedWidthUpdate || _fixedWidthUpdate->affectsIndexes(_indexedFields) ||
+        _fixedWidthUpdate->modifiesAnyOf(immutablePaths)) {
+        return false;
+    }
+
+    const auto logMode = _logOp && logOpRec
+        ? getOplogEntryLogMode()
+        : UpdateExecutor::ApplyParams::LogMode::kDoNotGenerateOplogEntry;
+    auto result = _fixedWidthUpdate->computeDamages(doc, logMode, damages);
+    if (!result) {
+        return false;
+    }
+
+    _affectIndices = false;
+    *source = _fixedWidthUpdate->source();
+    if (docWasModified) {
+        *docWasModified = !result->noop;
+    }
+    if (_logOp && logOpRec && !result->noop) {
+        *logOpRec = std::move(result->oplogEntry);
+    }
+    return true;
+}
+
 void UpdateDriver::setCollator(const CollatorInterface* collator) {
     if (_updateExecutor) {
         _updateExecutor->setCollator(collator);
@@ -41,6 +41,7 @@
 #include "mongo/db/ops/write_ops.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/canonical_query.h"
+#include "mongo/db/update/fixed_width_update.h"
 #include "mongo/db/update/modifier_table.h"
 #include "mongo/db/update/object_replace_executor.h"
 #include "mongo/db/update/pipeline_executor.h"
@@ -125,6 +126,25 @@ public:
                   bool* docWasModified = nullptr,
                   FieldRefSetWithStorage* modifiedPaths = nullptr);
 
+    /**
+     * Tries to apply the update to 'doc' without building a mutablebson::Document, by overwriting
+     * the values of the fields it modifies. This is only possible for an update made up of $inc,
+     * $mul and numeric $set modifiers on top-level fields which affects no index and modifies none
+     * of the 'immutablePaths', and only if every new value has the same BSON type as the value it
+     * replaces.
+     *
+     * Returns false if the update cannot be applied this way, in which case the caller must use
+     * update(). Otherwise fills 'damages' and 'source' with the writes to make to 'doc', sets
+     * 'docWasModified' and 'logOpRec' as update() would, and returns true. 'source' remains valid
+     * until the next call.
+     */
+    bool updateWithDamages(const BSONObj& doc,
+                           const FieldRefSet& immutablePaths,
+                           mutablebson::DamageVector* damages,
+                           const char** source,
+                           BSONObj* logOpRec = nullptr,
+                           bool* docWasModified = nullptr);
+
     /**
      * Passes the visitor through to the root of the update tree. The visitor is responsible for
      * implementing methods that operate on the nodes of the tree.
@@ -213,6 +233,9 @@ private:
 
     std::unique_ptr<UpdateExecutor> _updateExecutor;
 
+    // Set for operator-style updates which updateWithDamages() may be able to apply.
+    std::unique_ptr<FixedWidthUpdate> _fixedWidthUpdate;
+
     // What are the list of fields in the collection over which the update is going to be
     // applied that participate in indices?
     //
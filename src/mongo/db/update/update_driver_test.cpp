@@ -738,5 +738,106 @@ TEST_F(ModifiedPathsTestFixture, DeltaUpdateAffectingIndex) {
     ASSERT(_driver->modsAffectIndices());
 }
 
+class UpdateWithDamagesTest : public mongo::unittest::Test {
+public:
+    void parse(const BSONObj& spec, UpdateIndexData* indexData = nullptr) {
+        _driver = std::make_unique<UpdateDriver>(_expCtx);
+        _driver->setLogOp(true);
+        _driver->refreshIndexKeys(indexData);
+        std::map<StringData, std::unique_ptr<ExpressionWithPlaceholder>> arrayFilters;
+        _driver->parse(makeUpdateMod(spec), arrayFilters);
+    }
+
+    /**
+     * Returns boost::none if the driver cannot apply the update to 'doc' with damages, and the
+     * updated document otherwise.
+     */
+    boost::optional<BSONObj> updateWithDamages(const BSONObj& doc,
+                                               const FieldRefSet& immutablePaths = {}) {
+        mutablebson::DamageVector damages;
+        const char* source = nullptr;
+        _logOpRec = BSONObj();
+        _docWasModified = false;
+        if (!_driver->updateWithDamages(
+                doc, immutablePaths, &damages, &source, &_logOpRec, &_docWasModified)) {
+            return boost::none;
+        }
+        ASSERT_EQ(_docWasModified, !damages.empty());
+
+        std::string updated(doc.objdata(), doc.objsize());
+        for (const auto& damage : damages) {
+            std::memcpy(&updated[damage.targetOffset], source + damage.sourceOffset, damage.size);
+        }
+        return BSONObj(updated.data()).getOwned();
+    }
+
+protected:
+    boost::intrusive_ptr<ExpressionContextForTest> _expCtx{new ExpressionContextForTest()};
+    std::unique_ptr<UpdateDriver> _driver;
+    BSONObj _logOpRec;
+    bool _docWasModified = false;
+};
+
+TEST_F(UpdateWithDamagesTest, OverwritesNumbersOfTheSameType) {
+    parse(BSON("$inc" << BSON("a" << 1 << "c" << 10LL) << "$set" << BSON("b" << 3.5)));
+    auto updated =
+        updateWithDamages(BSON("_id" << 1 << "a" << 1 << "b" << 2.5 << "c" << 3LL << "d" << 4));
+    ASSERT(updated);
+    ASSERT(_docWasModified);
+    ASSERT_BSONOBJ_BINARY_EQ(*updated,
+                             BSON("_id" << 1 << "a" << 2 << "b" << 3.5 << "c" << 13LL << "d" << 4));
+    ASSERT_BSONOBJ_BINARY_EQ(
+        _logOpRec, BSON("$v" << 1 << "$set" << BSON("a" << 2 << "b" << 3.5 << "c" << 13LL)));
+}
+
+TEST_F(UpdateWithDamagesTest, UnchangedValuesAreNoops) {
+    parse(BSON("$inc" << BSON("a" << 0) << "$mul" << BSON("b" << 1.0) << "$set"
+                      << BSON("c" << 3LL)));
+    auto doc = BSON("_id" << 1 << "a" << 1 << "b" << 2.5 << "c" << 3LL);
+    auto updated = updateWithDamages(doc);
+    ASSERT(updated);
+    ASSERT_FALSE(_docWasModified);
+    ASSERT_BSONOBJ_BINARY_EQ(*updated, doc);
+    ASSERT(_logOpRec.isEmpty());
+}
+
+TEST_F(UpdateWithDamagesTest, FallsBackWhenTheTypeWouldChange) {
+    parse(BSON("$inc" << BSON("a" << 1)));
+    ASSERT_FALSE(updateWithDamages(BSON("_id" << 1 << "a" << std::numeric_limits<int>::max())));
+    ASSERT_FALSE(updateWithDamages(BSON("_id" << 1 << "a"
+                                              << "1")));
+    ASSERT_FALSE(updateWithDamages(BSON("_id" << 1)));
+
+    parse(BSON("$set" << BSON("a" << 1.0)));
+    ASSERT_FALSE(updateWithDamages(BSON("_id" << 1 << "a" << 1LL)));
+}
+
+TEST_F(UpdateWithDamagesTest, FallsBackForUnsupportedUpdates) {
+    const auto doc = BSON("_id" << 1 << "a" << 1 << "b" << BSON("c" << 1));
+    for (auto&& spec : {BSON("$inc" << BSON("b.c" << 1)),
+                        BSON("$set" << BSON("a" << 1 << "b" << BSON("c" << 2))),
+                        BSON("$max" << BSON("a" << 2)),
+                        BSON("$setOnInsert" << BSON("a" << 2)),
+                        BSON("$inc" << BSON("a" << 1) << "$unset" << BSON("x" << 1))}) {
+        parse(spec);
+        ASSERT_FALSE(updateWithDamages(doc)) << spec;
+    }
+}
+
+TEST_F(UpdateWithDamagesTest, FallsBackForIndexedAndImmutablePaths) {
+    const auto doc = BSON("_id" << 1 << "a" << 1);
+
+    UpdateIndexData indexData;
+    indexData.addPath(FieldRef("a.b"));
+    parse(BSON("$inc" << BSON("a" << 1)), &indexData);
+    ASSERT_FALSE(updateWithDamages(doc));
+
+    parse(BSON("$inc" << BSON("_id" << 1)));
+    FieldRefSet immutablePaths;
+    FieldRef idPath("_id");
+    immutablePaths.insert(&idPath);
+    ASSERT_FALSE(updateWithDamages(doc, immutablePaths));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -131,6 +131,10 @@ public:
         return _children;
     }
 
+    bool hasPositionalChild() const {
+        return static_cast<bool>(_positionalChild);
+    }
+
 private:
     std::map<std::string, clonable_ptr<UpdateNode>, pathsupport::cmpPathsAndArrayIndexes> _children;
     clonable_ptr<UpdateNode> _positionalChild;
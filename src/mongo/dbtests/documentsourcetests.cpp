@@ -53,6 +53,7 @@
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/stage_builder.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -86,7 +87,8 @@ public:
     }
 
 protected:
-    void createSource(boost::optional<BSONObj> hint = boost::none) {
+    void createSource(boost::optional<BSONObj> hint = boost::none,
+                      size_t plannerOptions = QueryPlannerParams::RETURN_OWNED_DATA) {
         // clean up first if this was called before
         _source.reset();
 
@@ -103,7 +105,7 @@ protected:
                                                 &_coll,
                                                 std::move(cq),
                                                 PlanYieldPolicy::YieldPolicy::NO_YIELD,
-                                                QueryPlannerParams::RETURN_OWNED_DATA));
+                                                plannerOptions));
 
         exec->saveState();
         _source = DocumentSourceCursor::create(
@@ -201,6 +203,36 @@ TEST_F(DocumentSourceCursorTest, IterateDispose) {
     ASSERT(source()->getNext().isEOF());
 }
 
+/** Documents read straight from storage are copied into buffers shared across the batch. */
+TEST_F(DocumentSourceCursorTest, UnownedDocumentsAreCopiedIntoSharedBuffers) {
+    RAIIServerParameterControllerForTest sharedBufferBytes{
+        "internalDocumentSourceCursorSharedBufferBytes", 1024};
+    const std::string padding(300, 'x');
+    for (int i = 0; i < 5; ++i) {
+        client.insert(nss.ns(), BSON("_id" << i << "padding" << padding));
+    }
+    client.insert(nss.ns(), BSON("_id" << 5 << "padding" << std::string(600, 'x')));
+    createSource(boost::none, QueryPlannerParams::DEFAULT);
+
+    std::vector<Document> docs;
+    for (auto next = source()->getNext(); next.isAdvanced(); next = source()->getNext()) {
+        ASSERT(next.getDocument().isOwned());
+        docs.push_back(next.releaseDocument());
+    }
+    ASSERT_EQ(docs.size(), 6UL);
+    for (int i = 0; i < 6; ++i) {
+        ASSERT_VALUE_EQ(Value(i), docs[i].getField("_id"));
+    }
+
+    // Three documents fit in each buffer, and the one larger than half a buffer gets its own.
+    auto bufferOf = [&](size_t i) { return docs[i].toBson().sharedBuffer().get(); };
+    ASSERT_EQ(bufferOf(0), bufferOf(2));
+    ASSERT_NE(bufferOf(2), bufferOf(3));
+    ASSERT_EQ(bufferOf(3), bufferOf(4));
+    ASSERT_NE(bufferOf(4), bufferOf(5));
+    ASSERT_EQ(docs[5].toBson().objdata(), bufferOf(5));
+}
+
 /** Set a value or await an expected value. */
 class PendingValue {
 public:
@@ -524,6 +524,68 @@ public:
     }
 };
 
+// An AND with three children which keeps only the RecordIds of its first two children's results.
+class QueryStageAndHashThreeLeafRecordIdOnly : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << i << "bar" << i << "baz" << i));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+        addIndex(BSON("baz" << 1));
+
+        WorkingSet ws;
+        auto ah = std::make_unique<AndHashStage>(_expCtx.get(), &ws, true);
+
+        // Foo <= 20
+        auto params = makeIndexScanParams(&_opCtx, getIndex(BSON("foo" << 1), coll));
+        params.bounds.startKey = BSON("" << 20);
+        params.direction = -1;
+        ah->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+
+        // Bar >= 10
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("bar" << 1), coll));
+        params.bounds.startKey = BSON("" << 10);
+        ah->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+
+        // 5 <= baz <= 15
+        params = makeIndexScanParams(&_opCtx, getIndex(BSON("baz" << 1), coll));
+        params.bounds.startKey = BSON("" << 5);
+        params.bounds.endKey = BSON("" << 15);
+        ah->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+
+        // The results are those of the last child, in its order, with only its index key.
+        int count = 0;
+        while (!ah->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED != ah->work(&id)) {
+                continue;
+            }
+            WorkingSetMember* member = ws.get(id);
+            ASSERT_EQUALS(1U, member->keyData.size());
+            ASSERT_BSONOBJ_EQ(BSON("baz" << 1), member->keyData[0].indexKeyPattern);
+            ASSERT_EQUALS(10 + count, member->keyData[0].keyData.firstElement().numberInt());
+            ws.free(id);
+            ++count;
+        }
+        ASSERT_EQUALS(6, count);
+
+        const auto* stats = static_cast<const AndHashStats*>(ah->getSpecificStats());
+        ASSERT_TRUE(stats->recordIdOnly);
+    }
+};
+
 // An AND with three children.
 // Add large keys (512 bytes) to index of second child to cause
 // internal buffer within hashed AND to exceed threshold (32MB)
@@ -1074,6 +1136,53 @@ public:
     }
 };
 
+// An AND_SORTED which does not merge the index keys of its children into its results.
+class QueryStageAndSortedThreeLeafRecordIdOnly : public QueryStageAndBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, ns());
+        Database* db = ctx.db();
+        CollectionPtr coll = ctx.getCollection();
+        if (!coll) {
+            WriteUnitOfWork wuow(&_opCtx);
+            coll = db->createCollection(&_opCtx, nss());
+            wuow.commit();
+        }
+
+        for (int i = 0; i < 50; ++i) {
+            insert(BSON("foo" << 1 << "baz" << 1));
+            insert(BSON("foo" << 1 << "bar" << 1 << "baz" << 1));
+            insert(BSON("bar" << 1));
+        }
+
+        addIndex(BSON("foo" << 1));
+        addIndex(BSON("bar" << 1));
+        addIndex(BSON("baz" << 1));
+
+        WorkingSet ws;
+        auto ah = std::make_unique<AndSortedStage>(_expCtx.get(), &ws, true);
+
+        for (auto&& field : {"foo", "bar", "baz"}) {
+            auto params = makeIndexScanParams(&_opCtx, getIndex(BSON(field << 1), coll));
+            params.bounds.startKey = BSON("" << 1);
+            params.bounds.endKey = BSON("" << 1);
+            ah->addChild(std::make_unique<IndexScan>(_expCtx.get(), coll, params, &ws, nullptr));
+        }
+
+        int count = 0;
+        while (!ah->isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            if (PlanStage::ADVANCED != ah->work(&id)) {
+                continue;
+            }
+            ASSERT_EQUALS(1U, ws.get(id)->keyData.size());
+            ws.free(id);
+            ++count;
+        }
+        ASSERT_EQUALS(50, count);
+    }
+};
+
 // An AND with an index scan that returns nothing.
 class QueryStageAndSortedWithNothing : public QueryStageAndBase {
 public:
@@ -1331,6 +1440,7 @@ public:
         add<QueryStageAndHashTwoLeafFirstChildLargeKeys>();
         add<QueryStageAndHashTwoLeafLastChildLargeKeys>();
         add<QueryStageAndHashThreeLeaf>();
+        add<QueryStageAndHashThreeLeafRecordIdOnly>();
         add<QueryStageAndHashThreeLeafMiddleChildLargeKeys>();
         add<QueryStageAndHashWithNothing>();
         add<QueryStageAndHashProducesNothing>();
@@ -1340,6 +1450,7 @@ public:
         add<QueryStageAndHashDeadChild>();
         add<QueryStageAndSortedDeleteDuringYield>();
         add<QueryStageAndSortedThreeLeaf>();
+        add<QueryStageAndSortedThreeLeafRecordIdOnly>();
         add<QueryStageAndSortedWithNothing>();
         add<QueryStageAndSortedProducesNothing>();
         add<QueryStageAndSortedByLastChild>();
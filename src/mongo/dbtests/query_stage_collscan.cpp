@@ -51,6 +51,7 @@
 #include "mongo/db/record_id_helpers.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/dbtests/dbtests.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
 
@@ -231,6 +232,32 @@ TEST_F(QueryStageCollectionScanTest, QueryStageCollscanBasicBackwardWithMatch) {
     ASSERT_EQUALS(25, countResults(CollectionScanParams::BACKWARD, obj));
 }
 
+// Filters compiled into SBE plans match the same documents as the classic matcher, and filters
+// which cannot be compiled still match through it.
+TEST_F(QueryStageCollectionScanTest, QueryStageCollscanCompiledFilterMatchesClassic) {
+    std::vector<BSONObj> filters{BSON("foo" << BSON("$lt" << 25)),
+                                 BSON("foo" << BSON("$in" << BSON_ARRAY(1 << 3 << 5 << 100))),
+                                 BSON("foo" << BSON("$mod" << BSON_ARRAY(7 << 0))),
+                                 BSON("$or" << BSON_ARRAY(BSON("foo" << 1) << BSON("foo" << 2))),
+                                 BSON("foo" << BSON("$not" << BSON("$gte" << 10))),
+                                 BSON("foo" << BSON("$exists" << false)),
+                                 BSON("$expr" << BSON("$lt" << BSON_ARRAY("$foo" << 10)))};
+
+    std::vector<int> expected;
+    for (auto&& filter : filters) {
+        expected.push_back(countResults(CollectionScanParams::FORWARD, filter));
+    }
+    ASSERT_EQUALS(25, expected[0]);
+    ASSERT_EQUALS(0, expected[5]);
+
+    RAIIServerParameterControllerForTest controller("internalQueryCompileClassicFiltersToSbe",
+                                                    true);
+    for (size_t i = 0; i < filters.size(); ++i) {
+        ASSERT_EQUALS(expected[i], countResults(CollectionScanParams::FORWARD, filters[i]));
+        ASSERT_EQUALS(expected[i], countResults(CollectionScanParams::BACKWARD, filters[i]));
+    }
+}
+
 // Get objects in the order we inserted them.
 TEST_F(QueryStageCollectionScanTest, QueryStageCollscanObjectsInOrderForward) {
     AutoGetCollectionForReadCommand collection(&_opCtx, nss);
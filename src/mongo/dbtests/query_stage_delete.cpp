@@ -253,6 +253,62 @@ public:
     }
 };
 
+/**
+ * Test that a delete stage with a batch size deletes every matching document, and that it stops
+ * after the batch for which 'continueAfterBatch' returns false.
+ */
+class QueryStageDeleteBatched : public QueryStageDeleteBase {
+public:
+    void run() {
+        dbtests::WriteContextForTests ctx(&_opCtx, nss.ns());
+        const CollectionPtr& coll = ctx.getCollection();
+        ASSERT(coll);
+
+        const size_t batchSize = 7;
+        const size_t stopAfter = 20;
+        std::vector<size_t> numDeletedAfterBatches;
+
+        CollectionScanParams collScanParams;
+        collScanParams.direction = CollectionScanParams::FORWARD;
+        collScanParams.tailable = false;
+
+        auto deleteStageParams = std::make_unique<DeleteStageParams>();
+        deleteStageParams->isMulti = true;
+        deleteStageParams->batchSize = batchSize;
+        deleteStageParams->continueAfterBatch = [&](size_t numDeleted) {
+            numDeletedAfterBatches.push_back(numDeleted);
+            return numDeleted < stopAfter;
+        };
+
+        WorkingSet ws;
+        DeleteStage deleteStage(
+            _expCtx.get(),
+            std::move(deleteStageParams),
+            &ws,
+            coll,
+            new CollectionScan(_expCtx.get(), coll, collScanParams, &ws, nullptr));
+
+        const DeleteStats* stats = static_cast<const DeleteStats*>(deleteStage.getSpecificStats());
+
+        while (!deleteStage.isEOF()) {
+            WorkingSetID id = WorkingSet::INVALID_ID;
+            PlanStage::StageState state = deleteStage.work(&id);
+            ASSERT(PlanStage::NEED_TIME == state || PlanStage::IS_EOF == state);
+        }
+
+        // The delete stops after the third batch, the first to take it past 'stopAfter'.
+        ASSERT_EQUALS(3 * batchSize, stats->docsDeleted);
+        ASSERT_EQUALS(3U, numDeletedAfterBatches.size());
+        ASSERT_EQUALS(batchSize, numDeletedAfterBatches[0]);
+        ASSERT_EQUALS(2 * batchSize, numDeletedAfterBatches[1]);
+        ASSERT_EQUALS(3 * batchSize, numDeletedAfterBatches[2]);
+
+        vector<RecordId> recordIds;
+        getRecordIds(coll, CollectionScanParams::FORWARD, &recordIds);
+        ASSERT_EQUALS(numObj() - 3 * batchSize, recordIds.size());
+    }
+};
+
 class All : public OldStyleSuiteSpecification {
 public:
     All() : OldStyleSuiteSpecification("query_stage_delete") {}
@@ -261,6 +317,7 @@ public:
         // Stage-specific tests below.
         add<QueryStageDeleteUpcomingObjectWasDeleted>();
         add<QueryStageDeleteReturnOldDoc>();
+        add<QueryStageDeleteBatched>();
     }
 };
 
@@ -546,6 +546,59 @@ TEST_F(QueryStageMultiPlanTest, MPSExplainAllPlans) {
     }
 }
 
+// Test that a candidate plan which trails the leader by more than the cutoff ratio stops being
+// worked before the end of the trial period, and is not scored.
+TEST_F(QueryStageMultiPlanTest, MPSCutsOffTrailingPlans) {
+    internalQueryPlanEvaluationCutoffRatio.store(4.0);
+    ON_BLOCK_EXIT([] { internalQueryPlanEvaluationCutoffRatio.store(0.0); });
+
+    // Insert a document to create the collection.
+    insert(BSON("x" << 1));
+
+    const int nDocs = 500;
+
+    auto ws = std::make_unique<WorkingSet>();
+    auto firstPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+    auto secondPlan = std::make_unique<MockStage>(_expCtx.get(), ws.get());
+
+    for (int i = 0; i < nDocs; ++i) {
+        addMember(firstPlan.get(), ws.get(), BSON("x" << 1));
+
+        // Make the second plan much slower by inserting many NEED_TIMEs between every result.
+        addMember(secondPlan.get(), ws.get(), BSON("x" << 1));
+        for (int j = 0; j < 10; ++j) {
+            secondPlan->enqueueStateCode(PlanStage::NEED_TIME);
+        }
+    }
+
+    AutoGetCollectionForReadCommand ctx(_opCtx.get(), nss);
+
+    auto findCommand = std::make_unique<FindCommandRequest>(nss);
+    findCommand->setFilter(BSON("x" << 1));
+    auto cq = uassertStatusOK(CanonicalQuery::canonicalize(opCtx(), std::move(findCommand)));
+    unique_ptr<MultiPlanStage> mps =
+        std::make_unique<MultiPlanStage>(_expCtx.get(), ctx.getCollection(), cq.get());
+    mps->addPlan(std::make_unique<QuerySolution>(QueryPlannerParams::Options::DEFAULT),
+                 std::move(firstPlan),
+                 ws.get());
+    mps->addPlan(std::make_unique<QuerySolution>(QueryPlannerParams::Options::DEFAULT),
+                 std::move(secondPlan),
+                 ws.get());
+
+    NoopYieldPolicy yieldPolicy(_clock);
+    ASSERT_OK(mps->pickBestPlan(&yieldPolicy));
+    ASSERT_EQ(*mps->bestPlanIdx(), 0U);
+
+    // The first plan returned all of its trial period results, while the second one was cut off
+    // as soon as the first was four times as far ahead.
+    auto firstStats = mps->getChildren()[0]->getStats();
+    auto secondStats = mps->getChildren()[1]->getStats();
+    ASSERT_EQ(firstStats->common.advanced,
+              static_cast<size_t>(internalQueryPlanEvaluationMaxResults.load()));
+    ASSERT_LT(secondStats->common.works, firstStats->common.works);
+    ASSERT_LTE(secondStats->common.advanced * 4, firstStats->common.advanced);
+}
+
 // Test that the plan summary only includes stats from the winning plan.
 //
 // This is a regression test for SERVER-20111.
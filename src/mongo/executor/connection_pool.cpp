@@ -135,8 +135,9 @@ std::string ConnectionPool::ConnectionControls::toString() const {
 }
 
 std::string ConnectionPool::HostState::toString() const {
-    return "{{ requests: {}, ready: {}, pending: {}, active: {}, isExpired: {} }}"_format(
-        requests, ready, pending, active, health.isExpired);
+    return "{{ requests: {}, ready: {}, pending: {}, active: {}, recentDemand: {}, "
+           "isExpired: {} }}"_format(
+               requests, ready, pending, active, recentDemand, health.isExpired);
 }
 
 /**
@@ -160,7 +161,8 @@ public:
         const auto minConns = getPool()->_options.minConnections;
         const auto maxConns = getPool()->_options.maxConnections;
 
-        data.target = stats.requests + stats.active;
+        data.target = std::max(stats.requests + stats.active, stats.recentDemand) +
+            getPool()->_options.spareConnections;
         if (data.target < minConns) {
             data.target = minConns;
         } else if (data.target > maxConns) {
@@ -193,6 +195,9 @@ public:
     Milliseconds toRefreshTimeout() const override {
         return getPool()->_options.refreshRequirement;
     }
+    Milliseconds demandWindow() const override {
+        return getPool()->_options.demandWindow;
+    }
 
     StringData name() const override {
         return "LimitController"_sd;
@@ -322,6 +327,17 @@ public:
      */
     size_t requestsPending() const;
 
+    /**
+     * Returns the number of requests that had to wait for a connection, and the total time they
+     * spent waiting.
+     */
+    size_t waitedRequests() const {
+        return _waitedRequests;
+    }
+    Milliseconds requestWaitTime() const {
+        return _requestWaitTime;
+    }
+
     /**
      * Returns the HostAndPort for this pool.
      */
@@ -354,10 +370,14 @@ private:
     using OwnedConnection = std::shared_ptr<ConnectionInterface>;
     using OwnershipPool = stdx::unordered_map<ConnectionInterface*, OwnedConnection>;
     using LRUOwnershipPool = LRUCache<OwnershipPool::key_type, OwnershipPool::mapped_type>;
-    using Request = std::pair<Date_t, Promise<ConnectionHandle>>;
+    struct Request {
+        Date_t expiration;
+        Date_t requestedAt;
+        Promise<ConnectionHandle> promise;
+    };
     struct RequestComparator {
         bool operator()(const Request& a, const Request& b) {
-            return a.first > b.first;
+            return a.expiration > b.expiration;
         }
     };
 
@@ -428,6 +448,10 @@ private:
 
     size_t _created = 0;
 
+    // Requests that could not be served from the ready pool, and how long they waited.
+    size_t _waitedRequests = 0;
+    Milliseconds _requestWaitTime{0};
+
     transport::Session::TagMask _tags = transport::Session::kPending;
 
     HostHealth _health;
@@ -579,10 +603,45 @@ void ConnectionPool::appendConnectionStats(ConnectionPoolStats* stats) const {
                                      pool->availableConnections(),
                                      pool->createdConnections(),
                                      pool->refreshingConnections()};
+        hostStats.waitedForConnection = pool->waitedRequests();
+        hostStats.waitTimeForConnection = pool->requestWaitTime();
         stats->updateStatsForHost(_name, host, hostStats);
     }
 }
 
+size_t ConnectionPool::_recordDemand(const HostAndPort& hostAndPort, size_t demand) {
+    const auto window = _controller->demandWindow();
+    if (window <= Milliseconds(0)) {
+        _demandHistory.clear();
+        return demand;
+    }
+
+    const auto now = _factory->now();
+    auto& history = _demandHistory[hostAndPort];
+    if (now - history.windowStart >= window) {
+        // Only a window that has just ended still counts towards the prediction.
+        history.previousPeak = (now - history.windowStart < window * 2) ? history.currentPeak : 0;
+        history.currentPeak = 0;
+        history.windowStart = now;
+    }
+    history.currentPeak = std::max(history.currentPeak, demand);
+    const auto recentDemand = std::max(history.currentPeak, history.previousPeak);
+
+    // Forget hosts that have not been used for two windows.
+    if (now - _lastDemandHistoryPrune >= window) {
+        _lastDemandHistoryPrune = now;
+        for (auto it = _demandHistory.begin(); it != _demandHistory.end();) {
+            if (now - it->second.windowStart >= window * 2) {
+                _demandHistory.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    return recentDemand;
+}
+
 size_t ConnectionPool::getNumConnectionsPerHost(const HostAndPort& hostAndPort) const {
     stdx::lock_guard lk(_mutex);
     auto iter = _pools.find(hostAndPort);
@@ -673,7 +732,8 @@ Future<ConnectionPool::ConnectionHandle> ConnectionPool::SpecificPool::getConnec
     const auto expiration = now + timeout;
     auto pf = makePromiseFuture<ConnectionHandle>();
 
-    _requests.push_back(make_pair(expiration, std::move(pf.promise)));
+    _requests.push_back({expiration, now, std::move(pf.promise)});
+    ++_waitedRequests;
     std::push_heap(begin(_requests), end(_requests), RequestComparator{});
 
     return std::move(pf.future);
@@ -950,7 +1010,7 @@ void ConnectionPool::SpecificPool::processFailure(const Status& status) {
     }
 
     for (auto& request : _requests) {
-        request.second.setError(status);
+        request.promise.setError(status);
     }
 
     LOGV2_DEBUG(22573,
@@ -979,7 +1039,8 @@ void ConnectionPool::SpecificPool::fulfillRequests() {
         }
 
         // Grab the request and callback
-        auto promise = std::move(_requests.front().second);
+        auto promise = std::move(_requests.front().promise);
+        _requestWaitTime += _lastActiveTime - _requests.front().requestedAt;
         std::pop_heap(begin(_requests), end(_requests), RequestComparator{});
         _requests.pop_back();
 
@@ -1112,8 +1173,8 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
     }
 
     // If a request would timeout before the next event, then it is the next event
-    if (_requests.size() && (_requests.front().first < nextEventTime)) {
-        nextEventTime = _requests.front().first;
+    if (_requests.size() && (_requests.front().expiration < nextEventTime)) {
+        nextEventTime = _requests.front().expiration;
     }
 
     // If our timer is already set to the next event, then we're done
@@ -1133,11 +1194,12 @@ void ConnectionPool::SpecificPool::updateEventTimer() {
 
         _health.isFailed = false;
 
-        while (_requests.size() && (_requests.front().first <= now)) {
+        while (_requests.size() && (_requests.front().expiration <= now)) {
             std::pop_heap(begin(_requests), end(_requests), RequestComparator{});
 
             auto& request = _requests.back();
-            request.second.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit,
+            _requestWaitTime += now - request.requestedAt;
+            request.promise.setError(Status(ErrorCodes::NetworkInterfaceExceededTimeLimit,
                                            "Couldn't get a connection within the time limit"));
             _requests.pop_back();
 
@@ -1163,6 +1225,7 @@ void ConnectionPool::SpecificPool::updateController() {
         availableConnections(),
         inUseConnections(),
     };
+    state.recentDemand = _parent->_recordDemand(_hostAndPort, state.requests + state.active);
     LOGV2_DEBUG(22578,
                 kDiagnosticLogLevel,
                 "Updating pool controller for {hostAndPort} with state: {poolState}",
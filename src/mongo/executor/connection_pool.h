@@ -139,6 +139,27 @@ public:
          */
         Milliseconds hostTimeout = kDefaultHostTimeout;
 
+        /**
+         * If positive, the pool keeps enough connections open for the highest demand (requests
+         * plus connections in use) seen for a host within roughly this long, rather than for
+         * current demand only. The history outlives the pool for the host, so a pool recreated
+         * after a failover or a restart of its peer warms straight back up.
+         */
+        Milliseconds demandWindow = Milliseconds(0);
+
+        /**
+         * The number of connections to keep open beyond the demand for a host, so that a burst
+         * does not have to wait for connection setup.
+         */
+        size_t spareConnections = 0;
+
+        /**
+         * The number of commands the NetworkInterface may pipeline on one connection. Only plain
+         * single-target commands are pipelined, and only while no baton is involved. Commands
+         * sharing a connection are still executed one at a time by the remote.
+         */
+        size_t maxRequestsPerConnection = 1;
+
         /**
          * An egress tag closer manager which will provide global access to this connection pool.
          * The manager set's tags and potentially drops connections that don't match those tags.
@@ -211,6 +232,10 @@ public:
         size_t ready = 0;
         size_t active = 0;
 
+        // The highest demand (requests plus active) recorded for the host within the
+        // controller's demandWindow(), or the current demand if there is no window.
+        size_t recentDemand = 0;
+
         std::string toString() const;
     };
 
@@ -264,6 +289,18 @@ public:
     size_t getNumConnectionsPerHost(const HostAndPort& hostAndPort) const;
 
 private:
+    struct DemandHistory {
+        Date_t windowStart;
+        size_t currentPeak = 0;
+        size_t previousPeak = 0;
+    };
+
+    /**
+     * Records the current demand for a host and returns the highest one seen for it within the
+     * current and the previous demand window. Must be called while holding _mutex.
+     */
+    size_t _recordDemand(const HostAndPort& hostAndPort, size_t demand);
+
     std::string _name;
 
     const std::shared_ptr<DependentTypeFactoryInterface> _factory;
@@ -277,6 +314,9 @@ private:
     PoolId _nextPoolId = 0;
     stdx::unordered_map<HostAndPort, std::shared_ptr<SpecificPool>> _pools;
 
+    stdx::unordered_map<HostAndPort, DemandHistory> _demandHistory;
+    Date_t _lastDemandHistoryPrune;
+
     EgressTagCloserManager* _manager;
 };
 
@@ -481,6 +521,12 @@ public:
     virtual Milliseconds pendingTimeout() const = 0;
     virtual Milliseconds toRefreshTimeout() const = 0;
 
+    /**
+     * Get how long the pool should remember a host's peak demand for, see HostState::recentDemand.
+     * A non-positive window turns the history off.
+     */
+    virtual Milliseconds demandWindow() const = 0;
+
     /**
      * Get the name for this controller
      *
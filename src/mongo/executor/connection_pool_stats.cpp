@@ -49,6 +49,8 @@ ConnectionStatsPer& ConnectionStatsPer::operator+=(const ConnectionStatsPer& oth
     available += other.available;
     created += other.created;
     refreshing += other.refreshing;
+    waitedForConnection += other.waitedForConnection;
+    waitTimeForConnection += other.waitTimeForConnection;
 
     return *this;
 }
@@ -74,6 +76,8 @@ void ConnectionPoolStats::updateStatsForHost(std::string pool,
     totalAvailable += newStats.available;
     totalCreated += newStats.created;
     totalRefreshing += newStats.refreshing;
+    totalWaitedForConnection += newStats.waitedForConnection;
+    totalWaitTimeForConnection += newStats.waitTimeForConnection;
 }
 
 void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFTDC) {
@@ -81,6 +85,10 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
     result.appendNumber("totalAvailable", static_cast<long long>(totalAvailable));
     result.appendNumber("totalCreated", static_cast<long long>(totalCreated));
     result.appendNumber("totalRefreshing", static_cast<long long>(totalRefreshing));
+    result.appendNumber("totalWaitedForConnection",
+                        static_cast<long long>(totalWaitedForConnection));
+    result.appendNumber("totalWaitTimeForConnectionMillis",
+                        durationCount<Milliseconds>(totalWaitTimeForConnection));
 
     if (forFTDC) {
         BSONObjBuilder poolBuilder(result.subobjStart("connectionsInUsePerPool"));
@@ -131,6 +139,10 @@ void ConnectionPoolStats::appendToBSON(mongo::BSONObjBuilder& result, bool forFT
             hostInfo.appendNumber("available", static_cast<long long>(hostStats.available));
             hostInfo.appendNumber("created", static_cast<long long>(hostStats.created));
             hostInfo.appendNumber("refreshing", static_cast<long long>(hostStats.refreshing));
+            hostInfo.appendNumber("waitedForConnection",
+                                  static_cast<long long>(hostStats.waitedForConnection));
+            hostInfo.appendNumber("waitTimeForConnectionMillis",
+                                  durationCount<Milliseconds>(hostStats.waitTimeForConnection));
         }
     }
 }
@@ -31,6 +31,7 @@
 
 #include "mongo/s/sharding_task_executor_pool_controller.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
 #include "mongo/util/net/hostandport.h"
 
 namespace mongo {
@@ -51,6 +52,9 @@ struct ConnectionStatsPer {
     size_t available = 0u;
     size_t created = 0u;
     size_t refreshing = 0u;
+    // Requests that had to wait for a connection, and the total time they waited.
+    size_t waitedForConnection = 0u;
+    Milliseconds waitTimeForConnection{0};
 };
 
 /**
@@ -67,6 +71,8 @@ struct ConnectionPoolStats {
     size_t totalAvailable = 0u;
     size_t totalCreated = 0u;
     size_t totalRefreshing = 0u;
+    size_t totalWaitedForConnection = 0u;
+    Milliseconds totalWaitTimeForConnection{0};
     boost::optional<ShardingTaskExecutorPoolController::MatchingStrategy> strategy;
 
     using StatsByHost = std::map<HostAndPort, ConnectionStatsPer>;
@@ -960,6 +960,42 @@ TEST_F(ConnectionPoolTest, minPoolRespected) {
 }
 
 
+/**
+ * Verify that spareConnections keeps connections open beyond the current demand.
+ */
+TEST_F(ConnectionPoolTest, spareConnectionsRespected) {
+    ConnectionPool::Options options;
+    options.minConnections = 0;
+    options.spareConnections = 2;
+    auto pool = makePool(options);
+
+    auto now = Date_t::now();
+    PoolImpl::setNow(now);
+
+    size_t setups = 0;
+    for (int i = 0; i < 4; ++i) {
+        ConnectionImpl::pushSetup([&]() {
+            ++setups;
+            return Status::OK();
+        });
+    }
+
+    ConnectionPool::ConnectionHandle conn;
+    pool->get_forTest(HostAndPort(),
+                      Milliseconds(5000),
+                      [&](StatusWith<ConnectionPool::ConnectionHandle> swConn) {
+                          ASSERT(swConn.isOK());
+                          conn = std::move(swConn.getValue());
+                      });
+
+    // One connection for the request and two spares.
+    ASSERT(conn);
+    ASSERT_EQ(setups, 3U);
+    ASSERT_EQ(pool->getNumConnectionsPerHost(HostAndPort()), 3U);
+
+    doneWith(conn);
+}
+
 /**
  * Verify that the hostTimeout is respected. This implies that an idle
  * hostAndPort drops it's connections.
@@ -29,6 +29,8 @@
 
 #include "mongo/executor/hedging_metrics.h"
 
+#include <algorithm>
+
 namespace mongo {
 
 namespace {
@@ -67,12 +69,48 @@ void HedgingMetrics::incrementNumAdvantageouslyHedgedOperations() {
     _numAdvantageouslyHedgedOperations.fetchAndAdd(1);
 }
 
+long long HedgingMetrics::getNumDeferredHedgesSkipped() const {
+    return _numDeferredHedgesSkipped.load();
+}
+
+void HedgingMetrics::incrementNumDeferredHedgesSkipped() {
+    _numDeferredHedgesSkipped.fetchAndAdd(1);
+}
+
+void HedgingMetrics::recordLatency(const HostAndPort& host, Milliseconds latency) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    auto& latencies = _latencies[host];
+    latencies.samples[latencies.numRecorded++ % kNumLatencySamples] = latency;
+}
+
+boost::optional<Milliseconds> HedgingMetrics::getLatencyPercentile(const HostAndPort& host,
+                                                                   int percentile) const {
+    invariant(percentile >= 0 && percentile <= 100);
+
+    std::array<Milliseconds, kNumLatencySamples> samples;
+    size_t numSamples;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _latencies.find(host);
+        if (it == _latencies.end() || it->second.numRecorded < kMinLatencySamples) {
+            return boost::none;
+        }
+        numSamples = std::min(it->second.numRecorded, kNumLatencySamples);
+        samples = it->second.samples;
+    }
+
+    const auto nth = samples.begin() + std::min(numSamples - 1, numSamples * percentile / 100);
+    std::nth_element(samples.begin(), nth, samples.begin() + numSamples);
+    return *nth;
+}
+
 BSONObj HedgingMetrics::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("numTotalOperations", _numTotalOperations.load());
     builder.append("numTotalHedgedOperations", _numTotalHedgedOperations.load());
     builder.append("numAdvantageouslyHedgedOperations", _numAdvantageouslyHedgedOperations.load());
+    builder.append("numDeferredHedgesSkipped", _numDeferredHedgesSkipped.load());
 
     return builder.obj();
 }
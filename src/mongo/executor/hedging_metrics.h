@@ -29,8 +29,14 @@
 
 #pragma once
 
+#include <array>
+
 #include "mongo/db/operation_context.h"
 #include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/net/hostandport.h"
 
 namespace mongo {
 
@@ -56,8 +62,27 @@ public:
     long long getNumAdvantageouslyHedgedOperations() const;
     void incrementNumAdvantageouslyHedgedOperations();
 
+    long long getNumDeferredHedgesSkipped() const;
+    void incrementNumDeferredHedgesSkipped();
+
+    /**
+     * Records how long a hedgeable request to 'host' took. Only the most recent
+     * 'kNumLatencySamples' latencies of each host are kept.
+     */
+    void recordLatency(const HostAndPort& host, Milliseconds latency);
+
+    /**
+     * Returns the given percentile of the recent latencies of requests to 'host', or boost::none
+     * if fewer than 'kMinLatencySamples' have been recorded.
+     */
+    boost::optional<Milliseconds> getLatencyPercentile(const HostAndPort& host,
+                                                       int percentile) const;
+
     BSONObj toBSON() const;
 
+    static constexpr size_t kNumLatencySamples = 64;
+    static constexpr size_t kMinLatencySamples = 8;
+
 private:
     // The number of all operations with readPreference options such that they could be hedged.
     AtomicWord<long long> _numTotalOperations{0};
@@ -68,6 +93,19 @@ private:
     // The number of all operations where a rpc other than the first one fulfilled the client
     // request.
     AtomicWord<long long> _numAdvantageouslyHedgedOperations{0};
+
+    // The number of all operations whose additional rpc was deferred and then not dispatched
+    // because the first one had already responded.
+    AtomicWord<long long> _numDeferredHedgesSkipped{0};
+
+    // A ring buffer of the most recent latencies of requests to a host.
+    struct LatencySamples {
+        std::array<Milliseconds, kNumLatencySamples> samples;
+        size_t numRecorded = 0;
+    };
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("HedgingMetrics::_mutex");
+    stdx::unordered_map<HostAndPort, LatencySamples> _latencies;
 };
 
 }  // namespace mongo
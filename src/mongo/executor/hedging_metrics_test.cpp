@@ -0,0 +1,77 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/executor/hedging_metrics.h"
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const HostAndPort kHost("host1", 27017);
+const HostAndPort kOtherHost("host2", 27017);
+
+TEST(HedgingMetricsTest, LatencyPercentileNeedsEnoughSamples) {
+    HedgingMetrics metrics;
+    for (size_t i = 1; i < HedgingMetrics::kMinLatencySamples; ++i) {
+        metrics.recordLatency(kHost, Milliseconds(10));
+    }
+    ASSERT_FALSE(metrics.getLatencyPercentile(kHost, 50));
+
+    metrics.recordLatency(kHost, Milliseconds(10));
+    ASSERT_EQ(Milliseconds(10), *metrics.getLatencyPercentile(kHost, 50));
+    ASSERT_FALSE(metrics.getLatencyPercentile(kOtherHost, 50));
+}
+
+TEST(HedgingMetricsTest, LatencyPercentile) {
+    HedgingMetrics metrics;
+    for (int i = 1; i <= 10; ++i) {
+        metrics.recordLatency(kHost, Milliseconds(i * 10));
+    }
+    ASSERT_EQ(Milliseconds(10), *metrics.getLatencyPercentile(kHost, 0));
+    ASSERT_EQ(Milliseconds(60), *metrics.getLatencyPercentile(kHost, 50));
+    ASSERT_EQ(Milliseconds(100), *metrics.getLatencyPercentile(kHost, 90));
+    ASSERT_EQ(Milliseconds(100), *metrics.getLatencyPercentile(kHost, 100));
+}
+
+TEST(HedgingMetricsTest, LatencyPercentileOnlyUsesRecentSamples) {
+    HedgingMetrics metrics;
+    for (size_t i = 0; i < HedgingMetrics::kNumLatencySamples; ++i) {
+        metrics.recordLatency(kHost, Milliseconds(1000));
+    }
+    for (size_t i = 0; i < HedgingMetrics::kNumLatencySamples; ++i) {
+        metrics.recordLatency(kHost, Milliseconds(5));
+    }
+    ASSERT_EQ(Milliseconds(5), *metrics.getLatencyPercentile(kHost, 100));
+}
+
+}  // namespace
+}  // namespace mongo
@@ -309,6 +309,32 @@ public:
     }
 };
 
+class NetworkInterfaceMultiplexedTest : public NetworkInterfaceTest {
+public:
+    void setUp() override {
+        ConnectionPool::Options options;
+        options.maxRequestsPerConnection = 4;
+        createNet(nullptr, std::move(options));
+        net().startup();
+    }
+};
+
+TEST_F(NetworkInterfaceMultiplexedTest, PipelinedCommandsGetTheirOwnReplies) {
+    const int kNumCommands = 16;
+    std::vector<Future<RemoteCommandResponse>> futures;
+    for (int i = 0; i < kNumCommands; ++i) {
+        auto request = makeTestCommand(kNoTimeout, BSON("echo" << 1 << "i" << i));
+        futures.push_back(runCommand(makeCallbackHandle(), std::move(request)));
+    }
+
+    for (int i = 0; i < kNumCommands; ++i) {
+        auto res = futures[i].get();
+        uassertStatusOK(res.status);
+        ASSERT_EQ(i, res.data.getObjectField("echo").getIntField("i"));
+    }
+    assertNumOps(0u, 0u, 0u, kNumCommands);
+}
+
 TEST_F(NetworkInterfaceTest, CancelMissingOperation) {
     // This is just a sanity check, this action should have no effect.
     net().cancelCommand(makeCallbackHandle());
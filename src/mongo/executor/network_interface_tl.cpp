@@ -282,6 +282,9 @@ NetworkInterfaceTL::CommandStateBase::CommandStateBase(
       requestOnAny(std::move(request_)),
       cbHandle(cbHandle_),
       timer(interface->_reactor->makeTimer()),
+      hedgeTimer(requestOnAny.hedgeOptions && requestOnAny.hedgeOptions->delayPercentile
+                     ? interface->_reactor->makeTimer()
+                     : nullptr),
       finishLine(1),
       operationKey(requestOnAny.operationKey) {}
 
@@ -382,6 +385,14 @@ void NetworkInterfaceTL::RequestState::returnConnection(Status status) noexcept
 
     auto connToReturn = std::exchange(conn, {});
 
+    if (multiplexed) {
+        // A reply can arrive after another command broke the connection it was pipelined on.
+        if (status.isOK()) {
+            status = getClient(connToReturn)->pipelineStatus();
+        }
+        interface()->_releaseMultiplexedConnection(host, connToReturn.get(), status.isOK());
+    }
+
     if (!status.isOK()) {
         connToReturn->indicateFailure(std::move(status));
         return;
@@ -399,6 +410,9 @@ void NetworkInterfaceTL::CommandStateBase::tryFinish(Status status) noexcept {
 
     // The command has resolved one way or another.
     timer->cancel(baton);
+    if (hedgeTimer) {
+        hedgeTimer->cancel(baton);
+    }
 
     if (interface->_counters) {
         // Increment our counters for the integration test
@@ -442,6 +456,12 @@ void NetworkInterfaceTL::CommandStateBase::tryFinish(Status status) noexcept {
 }
 
 void NetworkInterfaceTL::RequestState::cancel() noexcept {
+    if (multiplexed) {
+        // Cancelling the client would fail every command pipelined on the connection. The reply
+        // to this one is dropped when it arrives instead.
+        return;
+    }
+
     auto connToCancel = weakConn.lock();
     if (auto clientPtr = getClient(connToCancel)) {
         // If we have a client, cancel it
@@ -486,6 +506,30 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
                   [](const HostAndPort& target1, const HostAndPort& target2) {
                       return target1.toString() < target2.toString();
                   });
+    } else if (_svcCtx && request.hedgeOptions && request.hedgeOptions->targetLatencyPercentile) {
+        // Send the first request to the host which has recently been the fastest. Hosts with too
+        // few known latencies go first, so that they are measured.
+        auto hm = HedgingMetrics::get(_svcCtx);
+        std::vector<std::pair<Milliseconds, HostAndPort>> targets;
+        for (auto& target : request.target) {
+            auto latency =
+                hm->getLatencyPercentile(target, request.hedgeOptions->targetLatencyPercentile);
+            targets.emplace_back(latency.value_or(Milliseconds::min()), std::move(target));
+        }
+        std::stable_sort(targets.begin(), targets.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.first < rhs.first;
+        });
+        for (size_t idx = 0; idx < targets.size(); ++idx) {
+            request.target[idx] = std::move(targets[idx].second);
+        }
+    }
+
+    // Unless the first target is slower than usual, it is the only one a hedged command needs.
+    boost::optional<Milliseconds> hedgeDelay;
+    if (!targetHostsInAlphabeticalOrder && _svcCtx && request.hedgeOptions &&
+        request.hedgeOptions->delayPercentile && request.target.size() > 1) {
+        hedgeDelay = HedgingMetrics::get(_svcCtx)->getLatencyPercentile(
+            request.target[0], request.hedgeOptions->delayPercentile);
     }
 
     auto [cmdState, future] = CommandState::make(this, request, cbHandle);
@@ -493,6 +537,10 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         cmdState->deadline = cmdState->stopwatch.start() + cmdState->requestOnAny.timeout;
     }
     cmdState->baton = baton;
+    cmdState->multiplexable = _connPoolOpts.maxRequestsPerConnection > 1 && !baton &&
+        !cmdState->requestOnAny.hedgeOptions && cmdState->requestOnAny.target.size() == 1 &&
+        cmdState->requestOnAny.fireAndForgetMode ==
+            RemoteCommandRequest::FireAndForgetMode::kOff;
 
     if (_svcCtx && cmdState->requestOnAny.hedgeOptions) {
         auto hm = HedgingMetrics::get(_svcCtx);
@@ -531,21 +579,53 @@ Status NetworkInterfaceTL::startCommand(const TaskExecutor::CallbackHandle& cbHa
         return Status::OK();
     }
 
-    // Attempt to get a connection to every target host
-    for (size_t idx = 0; idx < request.target.size(); ++idx) {
+    // Attempt to get a connection to the target host 'idx'.
+    auto acquireConnection = [this, cmdState = cmdState, targetHostsInAlphabeticalOrder](
+                                 size_t idx) {
+        const auto& request = cmdState->requestOnAny;
+        if (cmdState->multiplexable) {
+            if (auto conn = _acquireMultiplexedConnection(request.target[idx])) {
+                cmdState->requestManager->sendOnConnection(std::move(conn), idx, true);
+                return;
+            }
+        }
+
         auto connFuture = _pool->get(request.target[idx], request.sslMode, request.timeout);
 
         // If connection future is ready or requests should be sent in order, send the request
         // immediately.
         if (connFuture.isReady() || targetHostsInAlphabeticalOrder) {
             cmdState->requestManager->trySend(std::move(connFuture).getNoThrow(), idx);
-            continue;
+            return;
         }
 
         // Otherwise, schedule the request.
         std::move(connFuture).thenRunOn(_reactor).getAsync([cmdState = cmdState, idx](auto swConn) {
             cmdState->requestManager->trySend(std::move(swConn), idx);
         });
+    };
+
+    // Attempt to get a connection to every target host, or only to the first one if the hedged
+    // requests are deferred.
+    const size_t numTargetsToSendNow = hedgeDelay ? 1 : request.target.size();
+    for (size_t idx = 0; idx < numTargetsToSendNow; ++idx) {
+        acquireConnection(idx);
+    }
+
+    if (hedgeDelay) {
+        invariant(cmdState->hedgeTimer);
+        cmdState->hedgeTimer->waitUntil(now() + *hedgeDelay, baton)
+            .getAsync([this, cmdState = cmdState, acquireConnection](Status status) {
+                // The timer is canceled when the command finishes.
+                if (!status.isOK() || cmdState->finishLine.isReady()) {
+                    HedgingMetrics::get(_svcCtx)->incrementNumDeferredHedgesSkipped();
+                    return;
+                }
+
+                for (size_t idx = 1; idx < cmdState->requestOnAny.target.size(); ++idx) {
+                    acquireConnection(idx);
+                }
+            });
     }
 
     return Status::OK();
@@ -569,8 +649,11 @@ Future<RemoteCommandResponse> NetworkInterfaceTL::CommandState::sendRequest(
     std::shared_ptr<RequestState> requestState) {
     return makeReadyFutureWith([this, requestState] {
                setTimer();
-               return RequestState::getClient(requestState->conn)
-                   ->runCommandRequest(*requestState->request, baton);
+               auto client = RequestState::getClient(requestState->conn);
+               if (requestState->multiplexed) {
+                   return client->runPipelinedCommandRequest(*requestState->request);
+               }
+               return client->runCommandRequest(*requestState->request, baton);
            })
         .then([this, requestState](RemoteCommandResponse response) {
             doMetadataHook(RemoteCommandOnAnyResponse(requestState->host, response));
@@ -702,10 +785,16 @@ void NetworkInterfaceTL::RequestManager::trySend(
         return;
     }
 
+    sendOnConnection(std::move(swConn.getValue()), idx, false);
+}
+
+void NetworkInterfaceTL::RequestManager::sendOnConnection(RequestState::ConnectionHandle conn,
+                                                          size_t idx,
+                                                          bool isShared) noexcept {
     std::shared_ptr<RequestState> requestState;
 
     {
-        stdx::lock_guard<Latch> lk(mutex);
+        stdx::unique_lock<Latch> lk(mutex);
 
         // Increment the number of conns we were able to resolve.
         ++connsResolved;
@@ -714,7 +803,13 @@ void NetworkInterfaceTL::RequestManager::trySend(
         if (haveSentAll || isLocked) {
             // Our command has already been satisfied or we have already sent out all
             // the requests.
-            swConn.getValue()->indicateSuccess();
+            lk.unlock();
+            if (isShared) {
+                cmdState->interface->_releaseMultiplexedConnection(
+                    cmdState->requestOnAny.target[idx], conn.get(), true);
+            } else {
+                conn->indicateSuccess();
+            }
             return;
         }
 
@@ -722,9 +817,10 @@ void NetworkInterfaceTL::RequestManager::trySend(
 
         requestState = std::make_shared<RequestState>(this, cmdState->shared_from_this(), idx);
         requestState->isHedge = currentSentIdx > 0;
+        requestState->multiplexed = cmdState->multiplexable;
 
         // Set conn/weakConn+request under the lock so they will always be observed during cancel.
-        requestState->conn = std::move(swConn.getValue());
+        requestState->conn = std::move(conn);
         requestState->weakConn = requestState->conn;
 
         requestState->request = RemoteCommandRequest(cmdState->requestOnAny, idx);
@@ -733,6 +829,11 @@ void NetworkInterfaceTL::RequestManager::trySend(
         requests.at(currentSentIdx) = requestState;
     }
 
+    if (requestState->multiplexed && !isShared) {
+        cmdState->interface->_registerMultiplexedConnection(requestState->host,
+                                                            requestState->conn);
+    }
+
     LOGV2_DEBUG(4646300,
                 2,
                 "Sending request",
@@ -820,6 +921,16 @@ void NetworkInterfaceTL::RequestState::resolve(Future<RemoteCommandResponse> fut
 
             returnConnection(status);
 
+            // Track the latencies of the hosts hedged commands are sent to, including the requests
+            // which lose the race and are killed, so that a slow host is not only sampled when it
+            // is fast.
+            if (status.isOK() && cmdState->requestOnAny.hedgeOptions && interface()->_svcCtx) {
+                HedgingMetrics::get(interface()->_svcCtx)
+                    ->recordLatency(host,
+                                    duration_cast<Milliseconds>(
+                                        response.elapsed.value_or(stopwatch.elapsed())));
+            }
+
             const auto commandStatus = getStatusFromCommandResult(response.data);
             if (isHedge) {
                 // Ignore maxTimeMS expiration, StaleDbVersion or any error belonging to
@@ -1267,6 +1378,59 @@ bool NetworkInterfaceTL::onNetworkThread() {
     return _reactor->onReactorThread();
 }
 
+auto NetworkInterfaceTL::_acquireMultiplexedConnection(const HostAndPort& host)
+    -> RequestState::ConnectionHandle {
+    stdx::lock_guard lk(_multiplexedConnsMutex);
+    auto it = _multiplexedConns.find(host);
+    if (it == _multiplexedConns.end()) {
+        return nullptr;
+    }
+
+    for (auto& entry : it->second) {
+        if (entry.inFlight >= _connPoolOpts.maxRequestsPerConnection) {
+            continue;
+        }
+
+        if (auto conn = entry.conn.lock()) {
+            ++entry.inFlight;
+            return conn;
+        }
+    }
+
+    return nullptr;
+}
+
+void NetworkInterfaceTL::_registerMultiplexedConnection(
+    const HostAndPort& host, const RequestState::ConnectionHandle& conn) {
+    stdx::lock_guard lk(_multiplexedConnsMutex);
+    _multiplexedConns[host].push_back({conn, 1});
+}
+
+void NetworkInterfaceTL::_releaseMultiplexedConnection(
+    const HostAndPort& host, const ConnectionPool::ConnectionInterface* conn, bool isHealthy) {
+    stdx::lock_guard lk(_multiplexedConnsMutex);
+    auto it = _multiplexedConns.find(host);
+    if (it == _multiplexedConns.end()) {
+        return;
+    }
+
+    auto& entries = it->second;
+    for (auto entryIt = entries.begin(); entryIt != entries.end(); ++entryIt) {
+        if (entryIt->conn.lock().get() != conn) {
+            continue;
+        }
+
+        if (--entryIt->inFlight == 0 || !isHealthy) {
+            entries.erase(entryIt);
+        }
+        break;
+    }
+
+    if (entries.empty()) {
+        _multiplexedConns.erase(it);
+    }
+}
+
 void NetworkInterfaceTL::dropConnections(const HostAndPort& hostAndPort) {
     _pool->dropConnections(hostAndPort);
 }
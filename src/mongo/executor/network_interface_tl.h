@@ -172,6 +172,9 @@ private:
         BatonHandle baton;
         std::unique_ptr<transport::ReactorTimer> timer;
 
+        // Defers the additional requests of a hedged command, see HedgeOptions::delayPercentile.
+        std::unique_ptr<transport::ReactorTimer> hedgeTimer;
+
         std::unique_ptr<RequestManager> requestManager;
 
         // TODO replace the finishLine with an atomic bool. It is no longer tracking allowed
@@ -179,6 +182,9 @@ private:
         StrongWeakFinishLine finishLine;
 
         boost::optional<UUID> operationKey;
+
+        // True if this command may share its connection with other commands to the same host.
+        bool multiplexable = false;
     };
 
     struct CommandState final : public CommandStateBase {
@@ -234,6 +240,14 @@ private:
         RequestManager(CommandStateBase* cmdState);
 
         void trySend(StatusWith<ConnectionPool::ConnectionHandle> swConn, size_t idx) noexcept;
+
+        /**
+         * Send the request for target idx on a connection that is either freshly acquired or,
+         * if isShared, already carrying other multiplexed commands.
+         */
+        void sendOnConnection(std::shared_ptr<ConnectionPool::ConnectionHandle::element_type> conn,
+                              size_t idx,
+                              bool isShared) noexcept;
         void cancelRequests();
         void killOperationsForPendingRequests();
 
@@ -303,6 +317,9 @@ private:
         // True if this request is an additional request sent to hedge the operation.
         bool isHedge{false};
 
+        // True if this request is pipelined on a connection other requests may share.
+        bool multiplexed{false};
+
         // Set to true if the response to the request is used to fulfill the command's
         // promise (i.e. arrives before the responses to all other requests and is not
         // a MaxTimeMSExpired error response if this is a hedged request).
@@ -334,6 +351,26 @@ private:
 
     Status _killOperation(std::shared_ptr<RequestState> requestStateToKill);
 
+    /**
+     * Returns a connection to host that carries fewer than maxRequestsPerConnection multiplexed
+     * commands and counts one more command on it, or nullptr if there is none.
+     */
+    RequestState::ConnectionHandle _acquireMultiplexedConnection(const HostAndPort& host);
+
+    /**
+     * Makes a freshly acquired connection that carries one command available for multiplexing.
+     */
+    void _registerMultiplexedConnection(const HostAndPort& host,
+                                        const RequestState::ConnectionHandle& conn);
+
+    /**
+     * Counts one command less on a multiplexed connection. The connection stops being offered
+     * once it is idle or unhealthy, so that it can go back to the pool.
+     */
+    void _releaseMultiplexedConnection(const HostAndPort& host,
+                                       const ConnectionPool::ConnectionInterface* conn,
+                                       bool isHealthy);
+
     std::string _instanceName;
     ServiceContext* _svcCtx = nullptr;
     transport::TransportLayer* _tl = nullptr;
@@ -366,6 +403,13 @@ private:
         MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "NetworkInterfaceTL::_inProgressMutex");
     stdx::unordered_map<TaskExecutor::CallbackHandle, std::weak_ptr<CommandStateBase>> _inProgress;
 
+    struct MultiplexedConnection {
+        RequestState::WeakConnectionHandle conn;
+        size_t inFlight = 0;
+    };
+    Mutex _multiplexedConnsMutex = MONGO_MAKE_LATCH("NetworkInterfaceTL::_multiplexedConnsMutex");
+    stdx::unordered_map<HostAndPort, std::vector<MultiplexedConnection>> _multiplexedConns;
+
     bool _inProgressAlarmsInShutdown = false;
     stdx::unordered_map<TaskExecutor::CallbackHandle, std::shared_ptr<AlarmState>>
         _inProgressAlarms;
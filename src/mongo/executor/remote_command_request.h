@@ -47,6 +47,12 @@ struct RemoteCommandRequestBase {
     struct HedgeOptions {
         size_t count = 0;
         int maxTimeMSForHedgedReads = 0;
+        // If non-zero, the additional requests are only sent if the first target has not responded
+        // after this percentile of its recent latencies.
+        int delayPercentile = 0;
+        // If non-zero, the targets are tried in increasing order of this percentile of their
+        // recent latencies.
+        int targetLatencyPercentile = 0;
     };
 
     enum FireAndForgetMode { kOn, kOff };
@@ -54,7 +54,16 @@ namespace executor {
 
 namespace {
 MONGO_FAIL_POINT_DEFINE(scheduleIntoPoolSpinsUntilThreadPoolTaskExecutorShutsDown);
+
+/**
+ * Spreads the callbacks created by each thread over the shards in turn, without the threads
+ * sharing a counter.
+ */
+size_t nextShardIndex() {
+    thread_local size_t next = 0;
+    return next++;
 }
+}  // namespace
 
 class ThreadPoolTaskExecutor::CallbackState : public TaskExecutor::CallbackState {
     CallbackState(const CallbackState&) = delete;
@@ -71,7 +80,10 @@ public:
      * Do not call directly. Use make.
      */
     CallbackState(CallbackFn&& cb, Date_t theReadyDate, const BatonHandle& baton)
-        : callback(std::move(cb)), readyDate(theReadyDate), baton(baton) {}
+        : callback(std::move(cb)),
+          readyDate(theReadyDate),
+          baton(baton),
+          shardIndex(nextShardIndex() % kNumShards) {}
 
     virtual ~CallbackState() = default;
 
@@ -87,9 +99,11 @@ public:
         MONGO_UNREACHABLE;
     }
 
-    // All fields except for "canceled" are guarded by the owning task executor's _mutex. The
-    // "canceled" field may be observed without holding _mutex, but may only be set while holding
-    // _mutex.
+    // All fields except for "canceled", "isFinished" and "shardIndex" are guarded by the owning
+    // task executor's _mutex while the callback is in the sleepers queue or waiting on an event,
+    // and by the mutex of its shard while it is in progress in the thread pool or the network
+    // interface. The "canceled" field may be observed without holding any mutex, but may only be
+    // set while holding one of them.
 
     CallbackFn callback;
     AtomicWord<unsigned> canceled{0U};
@@ -103,7 +117,8 @@ public:
     BatonHandle baton;
     AtomicWord<bool> exhaustErased{
         false};  // Used only in the exhaust path. Used to indicate that a cbState associated with
-                 // an exhaust request has been removed from the '_networkInProgressQueue'.
+                 // an exhaust request has been removed from the 'networkInProgressQueue'.
+    const size_t shardIndex;
 };
 
 class ThreadPoolTaskExecutor::EventState : public TaskExecutor::EventState {
@@ -156,13 +171,23 @@ void ThreadPoolTaskExecutor::startup() {
 void ThreadPoolTaskExecutor::shutdown() {
     stdx::unique_lock<Latch> lk(_mutex);
     if (_inShutdown_inlock()) {
-        invariant(_networkInProgressQueue.empty());
+        for (auto& shard : _shards) {
+            stdx::lock_guard<Latch> shardLk(shard.mutex);
+            invariant(shard.networkInProgressQueue.empty());
+        }
         invariant(_sleepersQueue.empty());
         return;
     }
     _setState_inlock(joinRequired);
     WorkQueue pending;
-    pending.splice(pending.end(), _networkInProgressQueue);
+    for (auto& shard : _shards) {
+        // Nothing is added to the network queue of a shard once '_inShutdown' is set.
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        pending.splice(pending.end(), shard.networkInProgressQueue);
+        for (auto&& cbState : shard.poolInProgressQueue) {
+            cbState->canceled.store(1);
+        }
+    }
     pending.splice(pending.end(), _sleepersQueue);
     for (auto&& eventState : _unsignaledEvents) {
         pending.splice(pending.end(), eventState->waiters);
@@ -170,9 +195,6 @@ void ThreadPoolTaskExecutor::shutdown() {
     for (auto&& cbState : pending) {
         cbState->canceled.store(1);
     }
-    for (auto&& cbState : _poolInProgressQueue) {
-        cbState->canceled.store(1);
-    }
     scheduleIntoPool_inlock(&pending, std::move(lk));
 }
 
@@ -186,15 +208,16 @@ SharedSemiFuture<void> ThreadPoolTaskExecutor::joinAsync() {
 
 stdx::unique_lock<Latch> ThreadPoolTaskExecutor::_join(stdx::unique_lock<Latch> lk) {
     _stateChange.wait(lk, [this] {
-        // All non-exhaust tasks are spliced into the _poolInProgressQueue immediately after we
-        // accept them. This occurs in scheduleIntoPool_inlock.
+        // All non-exhaust tasks are spliced into the poolInProgressQueue of their shard
+        // immediately after we accept them. This occurs in scheduleIntoPool_inlock and
+        // scheduleIntoPool_inShardLock.
         //
-        // On the other side, all tasks are spliced out of the _poolInProgressQueue in runCallback,
+        // On the other side, all tasks are spliced out of the poolInProgressQueue in runCallback,
         // which removes them from this list after executing the users callback.
         //
         // This check ensures that all work managed to enter after shutdown successfully flushes
         // after shutdown
-        if (!_poolInProgressQueue.empty()) {
+        if (!_poolInProgressQueuesEmpty()) {
             return false;
         }
 
@@ -233,8 +256,11 @@ stdx::unique_lock<Latch> ThreadPoolTaskExecutor::_join(stdx::unique_lock<Latch>
     lk.unlock();
     _net->shutdown();
     lk.lock();
-    invariant(_poolInProgressQueue.empty());
-    invariant(_networkInProgressQueue.empty());
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        invariant(shard.poolInProgressQueue.empty());
+        invariant(shard.networkInProgressQueue.empty());
+    }
     invariant(_sleepersQueue.empty());
     invariant(_unsignaledEvents.empty());
     _setState_inlock(shutdownComplete);
@@ -249,17 +275,23 @@ bool ThreadPoolTaskExecutor::isShuttingDown() const {
 void ThreadPoolTaskExecutor::appendDiagnosticBSON(BSONObjBuilder* b) const {
     stdx::lock_guard<Latch> lk(_mutex);
 
+    long long poolInProgressCount = 0;
+    long long networkInProgressCount = 0;
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        poolInProgressCount += shard.poolInProgressQueue.size();
+        networkInProgressCount += shard.networkInProgressQueue.size();
+    }
+
     // ThreadPool details
     // TODO: fill in
     BSONObjBuilder poolCounters(b->subobjStart("pool"));
-    poolCounters.appendNumber("inProgressCount",
-                              static_cast<long long>(_poolInProgressQueue.size()));
+    poolCounters.appendNumber("inProgressCount", poolInProgressCount);
     poolCounters.done();
 
     // Queues
     BSONObjBuilder queues(b->subobjStart("queues"));
-    queues.appendNumber("networkInProgress",
-                        static_cast<long long>(_networkInProgressQueue.size()));
+    queues.appendNumber("networkInProgress", networkInProgressCount);
     queues.appendNumber("sleepers", static_cast<long long>(_sleepersQueue.size()));
     queues.done();
 
@@ -346,14 +378,15 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleWork(Ca
     // Unsure if we'll succeed yet, so pass an empty CallbackFn.
     auto wq = makeSingletonWorkQueue({}, nullptr);
     WorkQueue temp;
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto& shard = _getShard(*wq.front());
+    stdx::unique_lock<Latch> shardLk(shard.mutex);
     auto cbHandle = enqueueCallbackState_inlock(&temp, &wq);
     if (!cbHandle.isOK()) {
         return cbHandle;
     }
     // Success, invalidate "work" by moving it into the queue.
     temp.back()->callback = std::move(work);
-    scheduleIntoPool_inlock(&temp, std::move(lk));
+    scheduleIntoPool_inShardLock(shard, &temp, temp.begin(), std::move(shardLk));
     return cbHandle;
 }
 
@@ -438,17 +471,18 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
         },
         baton);
     wq.front()->isNetworkOperation = true;
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto swCbHandle = enqueueCallbackState_inlock(&_networkInProgressQueue, &wq);
+    auto& shard = _getShard(*wq.front());
+    stdx::unique_lock<Latch> shardLk(shard.mutex);
+    auto swCbHandle = enqueueCallbackState_inlock(&shard.networkInProgressQueue, &wq);
     if (!swCbHandle.isOK())
         return swCbHandle;
-    const auto cbState = _networkInProgressQueue.back();
+    const auto cbState = shard.networkInProgressQueue.back();
+    shardLk.unlock();
     LOGV2_DEBUG(22607,
                 3,
                 "Scheduling remote command request: {request}",
                 "Scheduling remote command request",
                 "request"_attr = redact(scheduledRequest.toString()));
-    lk.unlock();
 
     auto commandStatus = _net->startCommand(
         swCbHandle.getValue(),
@@ -458,18 +492,20 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleRemoteC
             CallbackFn newCb = [cb, scheduledRequest, response](const CallbackArgs& cbData) {
                 remoteCommandFinished(cbData, cb, scheduledRequest, response);
             };
-            stdx::unique_lock<Latch> lk(_mutex);
-            if (_inShutdown_inlock()) {
-                return;
-            }
             LOGV2_DEBUG(22608,
                         3,
                         "Received remote response: {response}",
                         "Received remote response",
                         "response"_attr = redact(response.isOK() ? response.toString()
                                                                  : response.status.toString()));
+            auto& shard = _getShard(*cbState);
+            stdx::unique_lock<Latch> shardLk(shard.mutex);
+            if (_inShutdown.load()) {
+                return;
+            }
             swap(cbState->callback, newCb);
-            scheduleIntoPool_inlock(&_networkInProgressQueue, cbState->iter, std::move(lk));
+            scheduleIntoPool_inShardLock(
+                shard, &shard.networkInProgressQueue, cbState->iter, std::move(shardLk));
         },
         baton);
 
@@ -518,7 +554,7 @@ void ThreadPoolTaskExecutor::wait(const CallbackHandle& cbHandle, Interruptible*
     if (cbState->isFinished.load()) {
         return;
     }
-    stdx::unique_lock<Latch> lk(_mutex);
+    stdx::unique_lock<Latch> lk(_getShard(*cbState).mutex);
     if (!cbState->finishedCondition) {
         cbState->finishedCondition.emplace();
     }
@@ -531,9 +567,13 @@ void ThreadPoolTaskExecutor::appendConnectionStats(ConnectionPoolStats* stats) c
     _net->appendConnectionStats(stats);
 }
 
+ThreadPoolTaskExecutor::Shard& ThreadPoolTaskExecutor::_getShard(const CallbackState& cbState) {
+    return _shards[cbState.shardIndex];
+}
+
 StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::enqueueCallbackState_inlock(
     WorkQueue* queue, WorkQueue* wq) {
-    if (_inShutdown_inlock()) {
+    if (_inShutdown.load()) {
         return {ErrorCodes::ShutdownInProgress, "Shutdown in progress"};
     }
     invariant(!wq->empty());
@@ -585,18 +625,36 @@ void ThreadPoolTaskExecutor::scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                                      const WorkQueue::iterator& begin,
                                                      const WorkQueue::iterator& end,
                                                      stdx::unique_lock<Latch> lk) {
-    dassert(fromQueue != &_poolInProgressQueue);
     std::vector<std::shared_ptr<CallbackState>> todo(begin, end);
-    _poolInProgressQueue.splice(_poolInProgressQueue.end(), *fromQueue, begin, end);
+    for (const auto& cbState : todo) {
+        auto& shard = _getShard(*cbState);
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        shard.poolInProgressQueue.splice(
+            shard.poolInProgressQueue.end(), *fromQueue, cbState->iter);
+    }
 
     lk.unlock();
+    runInPool(std::move(todo));
+}
+
+void ThreadPoolTaskExecutor::scheduleIntoPool_inShardLock(Shard& shard,
+                                                          WorkQueue* fromQueue,
+                                                          const WorkQueue::iterator& iter,
+                                                          stdx::unique_lock<Latch> shardLk) {
+    dassert(fromQueue != &shard.poolInProgressQueue);
+    std::vector<std::shared_ptr<CallbackState>> todo{*iter};
+    shard.poolInProgressQueue.splice(shard.poolInProgressQueue.end(), *fromQueue, iter);
 
+    shardLk.unlock();
+    runInPool(std::move(todo));
+}
+
+void ThreadPoolTaskExecutor::runInPool(std::vector<std::shared_ptr<CallbackState>> todo) {
     if (MONGO_unlikely(scheduleIntoPoolSpinsUntilThreadPoolTaskExecutorShutsDown.shouldFail())) {
         scheduleIntoPoolSpinsUntilThreadPoolTaskExecutorShutsDown.setMode(FailPoint::off);
 
-        lk.lock();
+        stdx::unique_lock<Latch> lk(_mutex);
         _stateChange.wait(lk, [&] { return _inShutdown_inlock(); });
-        lk.unlock();
     }
 
     for (const auto& cbState : todo) {
@@ -652,14 +710,15 @@ void ThreadPoolTaskExecutor::runCallback(std::shared_ptr<CallbackState> cbStateA
         callback(std::move(args));
     }
     cbStateArg->isFinished.store(true);
-    stdx::lock_guard<Latch> lk(_mutex);
-    _poolInProgressQueue.erase(cbStateArg->iter);
-    if (cbStateArg->finishedCondition) {
-        cbStateArg->finishedCondition->notify_all();
-    }
-    if (_inShutdown_inlock() && _poolInProgressQueue.empty()) {
-        _stateChange.notify_all();
+    {
+        auto& shard = _getShard(*cbStateArg);
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        shard.poolInProgressQueue.erase(cbStateArg->iter);
+        if (cbStateArg->finishedCondition) {
+            cbStateArg->finishedCondition->notify_all();
+        }
     }
+    _notifyIfJoinable();
 }
 
 StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaustRemoteCommandOnAny(
@@ -677,12 +736,13 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaust
         },
         baton);
     wq.front()->isNetworkOperation = true;
-    stdx::unique_lock<Latch> lk(_mutex);
-    auto swCbHandle = enqueueCallbackState_inlock(&_networkInProgressQueue, &wq);
+    auto& shard = _getShard(*wq.front());
+    stdx::unique_lock<Latch> shardLk(shard.mutex);
+    auto swCbHandle = enqueueCallbackState_inlock(&shard.networkInProgressQueue, &wq);
     if (!swCbHandle.isOK())
         return swCbHandle;
-    std::shared_ptr<CallbackState> cbState = _networkInProgressQueue.back();
-    lk.unlock();
+    std::shared_ptr<CallbackState> cbState = shard.networkInProgressQueue.back();
+    shardLk.unlock();
     LOGV2_DEBUG(4495133,
                 3,
                 "Scheduling exhaust remote command request: {request}",
@@ -702,19 +762,20 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaust
                         "response"_attr = redact(response.isOK() ? response.toString()
                                                                  : response.status.toString()));
 
-            // The cbState remains in the '_networkInProgressQueue' for the entirety of the
-            // request's lifetime and is added to and removed from the '_poolInProgressQueue' each
-            // time a response is received and its callback run respectively. It must be erased from
-            // the '_networkInProgressQueue' when either the request is cancelled or a response is
-            // received that has moreToCome == false to avoid shutting down with a task still in the
-            // '_networkInProgressQueue'. It is also possible that we receive both of these
-            // responses around the same time, so the 'exhaustErased' bool protects against
+            // The cbState remains in the 'networkInProgressQueue' of its shard for the entirety of
+            // the request's lifetime and is added to and removed from the 'poolInProgressQueue'
+            // each time a response is received and its callback run respectively. It must be
+            // erased from the 'networkInProgressQueue' when either the request is cancelled or a
+            // response is received that has moreToCome == false to avoid shutting down with a task
+            // still in the 'networkInProgressQueue'. It is also possible that we receive both of
+            // these responses around the same time, so the 'exhaustErased' bool protects against
             // attempting to erase the same cbState twice.
 
-            stdx::unique_lock<Latch> lk(_mutex);
-            if (_inShutdown_inlock() || cbState->exhaustErased.load()) {
+            auto& shard = _getShard(*cbState);
+            stdx::unique_lock<Latch> shardLk(shard.mutex);
+            if (_inShutdown.load() || cbState->exhaustErased.load()) {
                 if (cbState->exhaustIter) {
-                    _poolInProgressQueue.erase(cbState->exhaustIter.get());
+                    shard.poolInProgressQueue.erase(cbState->exhaustIter.get());
                     cbState->exhaustIter = boost::none;
                 }
                 return;
@@ -725,11 +786,11 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaust
                 TaskExecutor::CallbackFn callback = [](const CallbackArgs&) {};
                 std::swap(cbState->callback, callback);
 
-                _networkInProgressQueue.erase(cbState->iter);
+                shard.networkInProgressQueue.erase(cbState->iter);
                 cbState->exhaustErased.store(1);
 
                 if (cbState->exhaustIter) {
-                    _poolInProgressQueue.erase(cbState->exhaustIter.get());
+                    shard.poolInProgressQueue.erase(cbState->exhaustIter.get());
                     cbState->exhaustIter = boost::none;
                 }
 
@@ -743,20 +804,15 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaust
             swap(cbState->callback, newCb);
 
             // If this is the last response, invoke the non-exhaust path. This will mark cbState as
-            // finished and remove the task from _networkInProgressQueue
+            // finished and remove the task from the networkInProgressQueue
             if (!response.moreToCome) {
-                _networkInProgressQueue.erase(cbState->iter);
                 cbState->exhaustErased.store(1);
-
-                WorkQueue result;
-                result.emplace_front(cbState);
-                result.front()->iter = result.begin();
-
-                scheduleIntoPool_inlock(&result, std::move(lk));
+                scheduleIntoPool_inShardLock(
+                    shard, &shard.networkInProgressQueue, cbState->iter, std::move(shardLk));
                 return;
             }
 
-            scheduleExhaustIntoPool_inlock(cbState, std::move(lk));
+            scheduleExhaustIntoPool_inShardLock(shard, cbState, std::move(shardLk));
         },
         baton);
 
@@ -766,12 +822,12 @@ StatusWith<TaskExecutor::CallbackHandle> ThreadPoolTaskExecutor::scheduleExhaust
     return swCbHandle;
 }
 
-void ThreadPoolTaskExecutor::scheduleExhaustIntoPool_inlock(std::shared_ptr<CallbackState> cbState,
-                                                            stdx::unique_lock<Latch> lk) {
-    _poolInProgressQueue.push_back(cbState);
-    cbState->exhaustIter = --_poolInProgressQueue.end();
+void ThreadPoolTaskExecutor::scheduleExhaustIntoPool_inShardLock(
+    Shard& shard, std::shared_ptr<CallbackState> cbState, stdx::unique_lock<Latch> shardLk) {
+    shard.poolInProgressQueue.push_back(cbState);
+    cbState->exhaustIter = --shard.poolInProgressQueue.end();
     auto expectedExhaustIter = cbState->exhaustIter.get();
-    lk.unlock();
+    shardLk.unlock();
 
     if (cbState->baton) {
         cbState->baton->schedule([this, cbState, expectedExhaustIter](Status status) {
@@ -830,35 +886,64 @@ void ThreadPoolTaskExecutor::runCallbackExhaust(std::shared_ptr<CallbackState> c
 
     // Do not mark cbState as finished. It will be marked as finished on the last reply which is
     // handled in 'runCallback'.
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    // It is possible that we receive multiple responses in quick succession. If this happens, the
-    // later responses can overwrite the 'exhaustIter' value on the cbState when adding the cbState
-    // to the '_poolInProgressQueue' if the previous responses have not been run yet. We take in the
-    // 'expectedExhaustIter' so that we can still remove this task from the 'poolInProgressQueue' if
-    // this happens, but we do not want to reset the 'exhaustIter' value in this case.
-    if (cbState->exhaustIter) {
-        if (cbState->exhaustIter.get() == expectedExhaustIter) {
-            cbState->exhaustIter = boost::none;
+    {
+        auto& shard = _getShard(*cbState);
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+
+        // It is possible that we receive multiple responses in quick succession. If this happens,
+        // the later responses can overwrite the 'exhaustIter' value on the cbState when adding the
+        // cbState to the 'poolInProgressQueue' if the previous responses have not been run yet. We
+        // take in the 'expectedExhaustIter' so that we can still remove this task from the
+        // 'poolInProgressQueue' if this happens, but we do not want to reset the 'exhaustIter'
+        // value in this case.
+        if (cbState->exhaustIter) {
+            if (cbState->exhaustIter.get() == expectedExhaustIter) {
+                cbState->exhaustIter = boost::none;
+            }
+            shard.poolInProgressQueue.erase(expectedExhaustIter);
         }
-        _poolInProgressQueue.erase(expectedExhaustIter);
     }
 
-    if (_inShutdown_inlock() && _poolInProgressQueue.empty()) {
-        _stateChange.notify_all();
-    }
+    _notifyIfJoinable();
 }
 
 bool ThreadPoolTaskExecutor::hasTasks() {
     stdx::unique_lock<Latch> lk(_mutex);
-    if (!_poolInProgressQueue.empty() || !_networkInProgressQueue.empty() ||
-        !_sleepersQueue.empty()) {
+    if (!_sleepersQueue.empty()) {
         return true;
     }
 
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        if (!shard.poolInProgressQueue.empty() || !shard.networkInProgressQueue.empty()) {
+            return true;
+        }
+    }
+
     return false;
 }
 
+void ThreadPoolTaskExecutor::_notifyIfJoinable() {
+    if (!_inShutdown.load()) {
+        return;
+    }
+
+    // _join() checks its condition while holding _mutex, so this cannot slip in between the check
+    // and the wait.
+    stdx::lock_guard<Latch> lk(_mutex);
+    _stateChange.notify_all();
+}
+
+bool ThreadPoolTaskExecutor::_poolInProgressQueuesEmpty() {
+    for (auto& shard : _shards) {
+        stdx::lock_guard<Latch> shardLk(shard.mutex);
+        if (!shard.poolInProgressQueue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ThreadPoolTaskExecutor::_inShutdown_inlock() const {
     return _state >= joinRequired;
 }
@@ -868,6 +953,9 @@ void ThreadPoolTaskExecutor::_setState_inlock(State newState) {
         return;
     }
     _state = newState;
+    if (_inShutdown_inlock()) {
+        _inShutdown.store(true);
+    }
     _stateChange.notify_all();
 }
 
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <array>
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "mongo/executor/task_executor.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/stdx/thread.h"
@@ -105,8 +108,8 @@ public:
     void dropConnections(const HostAndPort& hostAndPort);
 
     /**
-     * Returns true if there are any tasks in any of _poolInProgressQueue, _networkInProgressQueue,
-     * or _sleepersQueue.
+     * Returns true if there are any tasks in progress in the thread pool or the network interface,
+     * or waiting in _sleepersQueue.
      */
     bool hasTasks();
 
@@ -116,6 +119,24 @@ private:
     using WorkQueue = std::list<std::shared_ptr<CallbackState>>;
     using EventList = std::list<std::shared_ptr<EventState>>;
 
+    /**
+     * The callbacks in progress in the thread pool or the network interface are spread over this
+     * many shards, each with its own mutex, so that scheduling work and completing remote commands
+     * do not all serialize on _mutex. A callback stays in the same shard for its whole life.
+     */
+    static constexpr size_t kNumShards = 16;
+
+    struct Shard {
+        mutable Mutex mutex = MONGO_MAKE_LATCH("ThreadPoolTaskExecutor::Shard::mutex");
+
+        // Queue containing the items of this shard scheduled into the thread pool but not yet
+        // completed.
+        WorkQueue poolInProgressQueue;
+
+        // Queue containing the items of this shard scheduled into the network interface.
+        WorkQueue networkInProgressQueue;
+    };
+
     /**
      * Representation of the stage of life of a thread pool.
      *
@@ -151,9 +172,15 @@ private:
                                             const BatonHandle& baton,
                                             Date_t when = {});
 
+    /**
+     * Returns the shard which tracks "cbState" while it is in progress.
+     */
+    Shard& _getShard(const CallbackState& cbState);
+
     /**
      * Moves the single callback in "wq" to the end of "queue". It is required that "wq" was
-     * produced via a call to makeSingletonWorkQueue().
+     * produced via a call to makeSingletonWorkQueue(). The caller must hold the mutex guarding
+     * "queue".
      */
     StatusWith<CallbackHandle> enqueueCallbackState_inlock(WorkQueue* queue, WorkQueue* wq);
 
@@ -163,14 +190,14 @@ private:
     void signalEvent_inlock(const EventHandle& event, stdx::unique_lock<Latch> lk);
 
     /**
-     * Schedules all items from "fromQueue" into the thread pool and moves them into
-     * _poolInProgressQueue.
+     * Schedules all items from "fromQueue" into the thread pool and moves them into the
+     * poolInProgressQueue of their shards. "lk" must hold _mutex.
      */
     void scheduleIntoPool_inlock(WorkQueue* fromQueue, stdx::unique_lock<Latch> lk);
 
     /**
-     * Schedules the given item from "fromQueue" into the thread pool and moves it into
-     * _poolInProgressQueue.
+     * Schedules the given item from "fromQueue" into the thread pool and moves it into the
+     * poolInProgressQueue of its shard. "lk" must hold _mutex.
      */
     void scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                  const WorkQueue::iterator& iter,
@@ -178,7 +205,7 @@ private:
 
     /**
      * Schedules entries from "begin" through "end" in "fromQueue" into the thread pool
-     * and moves them into _poolInProgressQueue.
+     * and moves them into the poolInProgressQueue of their shards. "lk" must hold _mutex.
      */
     void scheduleIntoPool_inlock(WorkQueue* fromQueue,
                                  const WorkQueue::iterator& begin,
@@ -186,11 +213,29 @@ private:
                                  stdx::unique_lock<Latch> lk);
 
     /**
-     * Schedules cbState into the thread pool and places it into _poolInProgressQueue. Does not
-     * remove the entry from the original queue.
+     * Schedules the given item from "fromQueue", which is either a queue of "shard" or a local
+     * one, into the thread pool and moves it into the poolInProgressQueue of "shard". "shardLk"
+     * must hold the mutex of "shard", which must be the shard of the item.
+     */
+    void scheduleIntoPool_inShardLock(Shard& shard,
+                                      WorkQueue* fromQueue,
+                                      const WorkQueue::iterator& iter,
+                                      stdx::unique_lock<Latch> shardLk);
+
+    /**
+     * Hands the callbacks in "todo", which are already in the poolInProgressQueue of their shards,
+     * to the thread pool, or to their batons. Must be called without holding any lock.
      */
-    void scheduleExhaustIntoPool_inlock(std::shared_ptr<CallbackState> cbState,
-                                        stdx::unique_lock<Latch> lk);
+    void runInPool(std::vector<std::shared_ptr<CallbackState>> todo);
+
+    /**
+     * Schedules cbState into the thread pool and places it into the poolInProgressQueue of its
+     * shard. Does not remove the entry from the original queue. "shardLk" must hold the mutex of
+     * "shard", which must be the shard of cbState.
+     */
+    void scheduleExhaustIntoPool_inShardLock(Shard& shard,
+                                             std::shared_ptr<CallbackState> cbState,
+                                             stdx::unique_lock<Latch> shardLk);
     /**
      * Executes the callback specified by "cbState".
      */
@@ -202,6 +247,17 @@ private:
     void runCallbackExhaust(std::shared_ptr<CallbackState> cbState,
                             WorkQueue::iterator expectedExhaustIter);
 
+    /**
+     * Called after a callback was removed from the poolInProgressQueue of its shard, without
+     * holding any lock, to wake up _join() once shutdown has started.
+     */
+    void _notifyIfJoinable();
+
+    /**
+     * Returns true if the poolInProgressQueue of every shard is empty. Locks each shard in turn.
+     */
+    bool _poolInProgressQueuesEmpty();
+
     bool _inShutdown_inlock() const;
     void _setState_inlock(State newState);
     stdx::unique_lock<Latch> _join(stdx::unique_lock<Latch> lk);
@@ -212,17 +268,19 @@ private:
     // The thread pool that executes scheduled work items.
     std::shared_ptr<ThreadPoolInterface> _pool;
 
+    // The callbacks in progress in the thread pool or the network interface. The mutex of a shard
+    // may be acquired while holding _mutex, but not the other way around.
+    std::array<Shard, kNumShards> _shards;
+
+    // Set once the executor has started shutting down, so that the shards can be checked without
+    // _mutex. Only written while holding _mutex, and then before any shard is drained.
+    AtomicWord<bool> _inShutdown{false};
+
     // Mutex guarding all remaining fields.
     mutable Mutex _mutex = MONGO_MAKE_LATCH(
         // This is sadly held for a subset of task execution HierarchicalAcquisitionLevel(1),
         "ThreadPoolTaskExecutor::_mutex");
 
-    // Queue containing all items currently scheduled into the thread pool but not yet completed.
-    WorkQueue _poolInProgressQueue;
-
-    // Queue containing all items currently scheduled into the network interface.
-    WorkQueue _networkInProgressQueue;
-
     // Queue containing all items waiting for a particular point in time to execute.
     WorkQueue _sleepersQueue;
 
@@ -30,6 +30,7 @@
 #include "mongo/platform/basic.h"
 
 #include <memory>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -41,6 +42,8 @@
 #include "mongo/executor/thread_pool_mock.h"
 #include "mongo/executor/thread_pool_task_executor.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/barrier.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
@@ -182,6 +185,36 @@ TEST_F(ThreadPoolExecutorTest,
     ASSERT_TRUE(sharedCallbackStateDestroyed);
 }
 
+TEST_F(ThreadPoolExecutorTest, ScheduleWorkFromManyThreadsRunsEveryCallback) {
+    // Callbacks scheduled from different threads land in different shards of the in-progress
+    // queues; every one of them must run, canceled by shutdown or not, before join() returns.
+    auto& executor = getExecutor();
+    launchExecutorThread();
+
+    const int kNumThreads = 8;
+    const int kCallbacksPerThread = 100;
+    AtomicWord<int> numRun{0};
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kCallbacksPerThread; ++j) {
+                ASSERT_OK(executor
+                              .scheduleWork([&](const TaskExecutor::CallbackArgs&) {
+                                  numRun.fetchAndAdd(1);
+                              })
+                              .getStatus());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    executor.shutdown();
+    executor.join();
+    ASSERT_EQUALS(kNumThreads * kCallbacksPerThread, numRun.load());
+}
+
 thread_local bool amRunningRecursively = false;
 
 TEST_F(ThreadPoolExecutorTest, ShutdownAndScheduleWorkRaceDoesNotCrash) {
@@ -33,13 +33,20 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/iterator/filter_iterator.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/log/attributes/value_extraction.hpp>
 #include <boost/make_shared.hpp>
 #include <fmt/format.h>
 #include <fstream>
 
+#include "mongo/logv2/attributes.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log_detail.h"
+#include "mongo/logv2/log_severity.h"
 #include "mongo/logv2/shared_access_fstream.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/mutex.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/thread_name.h"
 #include "mongo/util/quick_exit.h"
 #include "mongo/util/stacktrace.h"
 #include "mongo/util/string_map.h"
@@ -70,14 +77,168 @@ StatusWith<boost::shared_ptr<stream_t>> openFile(const std::string& filename, bo
 }  // namespace
 
 struct FileRotateSink::Impl {
-    Impl(LogTimestampFormat tsFormat) : timestampFormat(tsFormat) {}
+    Impl(LogTimestampFormat tsFormat, size_t asyncBufferSize)
+        : timestampFormat(tsFormat), asyncBuffer(asyncBufferSize) {}
+
+    bool isAsync() const {
+        return !asyncBuffer.empty();
+    }
+
+    // Copies 'data' into the ring buffer, waiting for the writer thread to make room if needed.
+    void enqueue(StringData data);
+
+    // Waits until everything in the ring buffer has been written to the files.
+    void drain();
+
+    // Body of the writer thread.
+    void writeLoop();
+
+    // Writes 'data' to every file and aborts the process if any of the writes fails.
+    void writeToFiles(StringData data);
+
+    // Aborts the process if writing to any of the files failed.
+    void abortIfWriteFailed();
+
     StringMap<boost::shared_ptr<stream_t>> files;
     LogTimestampFormat timestampFormat;
+
+    // Formatted records waiting to be written by the writer thread. 'asyncBegin' and 'asyncEnd'
+    // count the bytes ever taken out of and put into the ring buffer, so the pending bytes start
+    // at 'asyncBegin % asyncBuffer.size()'.
+    std::vector<char> asyncBuffer;
+    stdx::mutex asyncMutex;  // NOLINT
+    stdx::condition_variable asyncWriterCV;
+    stdx::condition_variable asyncProducerCV;
+    uint64_t asyncBegin = 0;
+    uint64_t asyncEnd = 0;
+    bool asyncWriting = false;
+    bool asyncShutdown = false;
+    stdx::thread asyncWriter;
 };
 
-FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat)
-    : _impl(std::make_unique<Impl>(timestampFormat)) {}
-FileRotateSink::~FileRotateSink() {}
+void FileRotateSink::Impl::enqueue(StringData data) {
+    const size_t capacity = asyncBuffer.size();
+    stdx::unique_lock<stdx::mutex> lk(asyncMutex);  // NOLINT
+
+    if (data.size() > capacity) {
+        // Too large to ever fit, so write it directly once the writer thread has caught up.
+        asyncProducerCV.wait(lk, [&] { return asyncBegin == asyncEnd && !asyncWriting; });
+        writeToFiles(data);
+        return;
+    }
+
+    asyncProducerCV.wait(lk, [&] { return capacity - (asyncEnd - asyncBegin) >= data.size(); });
+    const size_t offset = asyncEnd % capacity;
+    const size_t firstPart = std::min(data.size(), capacity - offset);
+    std::memcpy(asyncBuffer.data() + offset, data.rawData(), firstPart);
+    std::memcpy(asyncBuffer.data(), data.rawData() + firstPart, data.size() - firstPart);
+    asyncEnd += data.size();
+    asyncWriterCV.notify_one();
+}
+
+void FileRotateSink::Impl::drain() {
+    stdx::unique_lock<stdx::mutex> lk(asyncMutex);  // NOLINT
+    asyncProducerCV.wait(lk, [&] { return asyncBegin == asyncEnd && !asyncWriting; });
+}
+
+void FileRotateSink::Impl::writeLoop() {
+    setThreadName("LogWriter");
+
+    stdx::unique_lock<stdx::mutex> lk(asyncMutex);  // NOLINT
+    while (true) {
+        asyncWriterCV.wait(lk, [&] { return asyncBegin != asyncEnd || asyncShutdown; });
+        if (asyncBegin == asyncEnd) {
+            return;
+        }
+
+        // The pending bytes are not overwritten until 'asyncBegin' moves past them, so they can
+        // be written without holding the mutex. Write up to the end of the buffer, and pick up
+        // any bytes which wrapped around on the next pass.
+        const size_t capacity = asyncBuffer.size();
+        const size_t offset = asyncBegin % capacity;
+        const size_t size = std::min<uint64_t>(asyncEnd - asyncBegin, capacity - offset);
+        asyncWriting = true;
+        lk.unlock();
+        writeToFiles(StringData(asyncBuffer.data() + offset, size));
+        lk.lock();
+        asyncWriting = false;
+        asyncBegin += size;
+        asyncProducerCV.notify_all();
+    }
+}
+
+void FileRotateSink::Impl::writeToFiles(StringData data) {
+    for (auto& file : files) {
+        file.second->write(data.rawData(), data.size());
+        file.second->flush();
+    }
+    abortIfWriteFailed();
+}
+
+void FileRotateSink::Impl::abortIfWriteFailed() {
+    auto isFailed = [](const auto& file) { return file.second->fail(); };
+    if (std::any_of(files.begin(), files.end(), isFailed)) {
+        try {
+            auto failedBegin = boost::make_filter_iterator(isFailed, files.begin(), files.end());
+            auto failedEnd = boost::make_filter_iterator(isFailed, files.end(), files.end());
+
+            auto getFilename = [](const auto& file) -> const auto& {
+                return file.first;
+            };
+            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
+            auto end = boost::make_transform_iterator(failedEnd, getFilename);
+            auto sequence = logv2::seqLog(begin, end);
+
+            DynamicAttributes attrs;
+            attrs.add("files", sequence);
+
+            fmt::memory_buffer buffer;
+            JSONFormatter(nullptr, timestampFormat)
+                .format(buffer,
+                        LogSeverity::Severe(),
+                        LogComponent::kControl,
+                        Date_t::now(),
+                        4522200,
+                        getThreadName(),
+                        "Writing to log file failed, aborting application",
+                        TypeErasedAttributeStorage(attrs),
+                        LogTag::kNone,
+                        LogTruncation::Disabled);
+            // Commented out log line below to get validation of the log id with the errorcodes
+            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
+            std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
+        } catch (const std::exception& ex) {
+            std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
+                      << ex.what() << std::endl;
+        } catch (const boost::exception& ex) {
+            std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
+                      << boost::diagnostic_information(ex) << std::endl;
+        } catch (...) {
+            std::cerr << "Caught unidentified exception" << std::endl;
+        }
+
+        printStackTrace(std::cerr);
+        quickExitWithoutLogging(EXIT_FAILURE);
+    }
+}
+
+FileRotateSink::FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferSizeBytes)
+    : _impl(std::make_unique<Impl>(timestampFormat, asyncBufferSizeBytes)) {
+    if (_impl->isAsync()) {
+        _impl->asyncWriter = stdx::thread([impl = _impl.get()] { impl->writeLoop(); });
+    }
+}
+
+FileRotateSink::~FileRotateSink() {
+    if (_impl->isAsync()) {
+        {
+            stdx::lock_guard<stdx::mutex> lk(_impl->asyncMutex);  // NOLINT
+            _impl->asyncShutdown = true;
+            _impl->asyncWriterCV.notify_one();
+        }
+        _impl->asyncWriter.join();
+    }
+}
 
 Status FileRotateSink::addFile(const std::string& filename, bool append) {
     auto statusWithFile = openFile(filename, append);
@@ -89,6 +250,10 @@ Status FileRotateSink::addFile(const std::string& filename, bool append) {
     return statusWithFile.getStatus().withContext("Can't initialize rotatable log file");
 }
 void FileRotateSink::removeFile(const std::string& filename) {
+    if (_impl->isAsync()) {
+        _impl->drain();
+    }
+
     auto it = _impl->files.find(filename);
     if (it != _impl->files.cend()) {
         remove_stream(it->second);
@@ -97,6 +262,10 @@ void FileRotateSink::removeFile(const std::string& filename) {
 }
 
 Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
+    if (_impl->isAsync()) {
+        _impl->drain();
+    }
+
     for (auto& file : _impl->files) {
         const std::string& filename = file.first;
         if (rename) {
@@ -142,53 +311,29 @@ Status FileRotateSink::rotate(bool rename, StringData renameSuffix) {
 
 void FileRotateSink::consume(const boost::log::record_view& rec,
                              const string_type& formatted_string) {
-    auto isFailed = [](const auto& file) { return file.second->fail(); };
-    boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
-    if (std::any_of(_impl->files.begin(), _impl->files.end(), isFailed)) {
-        try {
-            auto failedBegin =
-                boost::make_filter_iterator(isFailed, _impl->files.begin(), _impl->files.end());
-            auto failedEnd =
-                boost::make_filter_iterator(isFailed, _impl->files.end(), _impl->files.end());
-
-            auto getFilename = [](const auto& file) -> const auto& {
-                return file.first;
-            };
-            auto begin = boost::make_transform_iterator(failedBegin, getFilename);
-            auto end = boost::make_transform_iterator(failedEnd, getFilename);
-            auto sequence = logv2::seqLog(begin, end);
+    if (!_impl->isAsync()) {
+        boost::log::sinks::text_ostream_backend::consume(rec, formatted_string);
+        _impl->abortIfWriteFailed();
+        return;
+    }
 
-            DynamicAttributes attrs;
-            attrs.add("files", sequence);
+    // Callers are serialized by the sink frontend, so a record and its newline are queued
+    // together.
+    _impl->enqueue(formatted_string);
+    _impl->enqueue("\n"_sd);
 
-            fmt::memory_buffer buffer;
-            JSONFormatter(nullptr, _impl->timestampFormat)
-                .format(buffer,
-                        LogSeverity::Severe(),
-                        LogComponent::kControl,
-                        Date_t::now(),
-                        4522200,
-                        getThreadName(),
-                        "Writing to log file failed, aborting application",
-                        TypeErasedAttributeStorage(attrs),
-                        LogTag::kNone,
-                        LogTruncation::Disabled);
-            // Commented out log line below to get validation of the log id with the errorcodes
-            // linter LOGV2(4522200, "Writing to log file failed, aborting application");
-            std::cerr << StringData(buffer.data(), buffer.size()) << std::endl;
-        } catch (const std::exception& ex) {
-            std::cerr << "Caught std::exception of type " << demangleName(typeid(ex)) << ": "
-                      << ex.what() << std::endl;
-        } catch (const boost::exception& ex) {
-            std::cerr << "Caught boost::exception of type " << demangleName(typeid(ex)) << ": "
-                      << boost::diagnostic_information(ex) << std::endl;
-        } catch (...) {
-            std::cerr << "Caught unidentified exception" << std::endl;
-        }
+    // Errors often precede the process exiting, so they must reach the files before returning.
+    auto severity = boost::log::extract<LogSeverity>(attributes::severity(), rec);
+    if (severity && severity.get() >= LogSeverity::Error()) {
+        _impl->drain();
+    }
+}
 
-        printStackTrace(std::cerr);
-        quickExitWithoutLogging(EXIT_FAILURE);
+void FileRotateSink::flush() {
+    if (_impl->isAsync()) {
+        _impl->drain();
     }
+    boost::log::sinks::text_ostream_backend::flush();
 }
 
 }  // namespace mongo::logv2
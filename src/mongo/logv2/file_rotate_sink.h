@@ -40,9 +40,14 @@ namespace mongo::logv2 {
 // boost::log backend sink to provide MongoDB style file rotation.
 // Uses custom stream type to open log files with shared access on Windows, somthing the built-in
 // boost file rotation sink does not do.
+//
+// When constructed with a non-zero 'asyncBufferSizeBytes', formatted records are copied into a
+// pre-allocated ring buffer of that size and written to the files by a background thread, so the
+// logging thread does not wait on file I/O. Records of severity Error and above, and calls to
+// flush() or rotate(), wait for everything buffered so far to be written.
 class FileRotateSink : public boost::log::sinks::text_ostream_backend {
 public:
-    FileRotateSink(LogTimestampFormat timestampFormat);
+    FileRotateSink(LogTimestampFormat timestampFormat, size_t asyncBufferSizeBytes = 0);
     ~FileRotateSink();
 
     Status addFile(const std::string& filename, bool append);
@@ -52,6 +57,8 @@ public:
 
     void consume(const boost::log::record_view& rec, const string_type& formatted_string);
 
+    void flush();
+
 private:
     struct Impl;
     std::unique_ptr<Impl> _impl;
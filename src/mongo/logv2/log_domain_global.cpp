@@ -73,6 +73,8 @@ struct LogDomainGlobal::Impl {
     Status configure(LogDomainGlobal::ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
 
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogSource& source();
@@ -159,7 +161,8 @@ Status LogDomainGlobal::Impl::configure(LogDomainGlobal::ConfigurationOptions co
 
     if (options.fileEnabled) {
         auto backend = boost::make_shared<RotatableFileBackend>(
-            boost::make_shared<FileRotateSink>(options.timestampFormat),
+            boost::make_shared<FileRotateSink>(options.timestampFormat,
+                                               options.fileAsyncBufferSizeBytes),
             boost::make_shared<RamLogSink>(RamLog::get("global")),
             boost::make_shared<RamLogSink>(RamLog::get("startupWarnings")),
             boost::make_shared<UserAssertSink>());
@@ -230,6 +233,12 @@ Status LogDomainGlobal::Impl::rotate(bool rename, StringData renameSuffix) {
     return Status::OK();
 }
 
+void LogDomainGlobal::Impl::flush() {
+    if (_rotatableFileSink) {
+        _rotatableFileSink->flush();
+    }
+}
+
 LogSource& LogDomainGlobal::Impl::source() {
     // Use a thread_local logger so we don't need to have locking. thread_locals are destroyed
     // before statics so keep track of number of thread_locals we have active and if this code
@@ -283,6 +292,10 @@ Status LogDomainGlobal::rotate(bool rename, StringData renameSuffix) {
     return _impl->rotate(rename, renameSuffix);
 }
 
+void LogDomainGlobal::flush() {
+    _impl->flush();
+}
+
 LogComponentSettings& LogDomainGlobal::settings() {
     return _impl->_settings;
 }
@@ -45,6 +45,9 @@ public:
         std::string filePath;
         RotationMode fileRotationMode{RotationMode::kRename};
         OpenMode fileOpenMode{OpenMode::kTruncate};
+        // When non-zero, records are written to the log file by a background thread from a buffer
+        // of this size instead of by the logging thread.
+        size_t fileAsyncBufferSizeBytes{0};
         LogTimestampFormat timestampFormat{LogTimestampFormat::kISO8601UTC};
         bool syslogEnabled{false};
         int syslogFacility{-1};  // invalid facility by default, must be set
@@ -62,6 +65,9 @@ public:
     Status configure(ConfigurationOptions const& options);
     Status rotate(bool rename, StringData renameSuffix);
 
+    // Waits until every record logged so far has been written to the log file.
+    void flush();
+
     const ConfigurationOptions& config() const;
 
     LogComponentSettings& settings();
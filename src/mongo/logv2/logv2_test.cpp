@@ -44,6 +44,7 @@
 #include "mongo/logv2/component_settings_filter.h"
 #include "mongo/logv2/composite_backend.h"
 #include "mongo/logv2/constants.h"
+#include "mongo/logv2/file_rotate_sink.h"
 #include "mongo/logv2/json_formatter.h"
 #include "mongo/logv2/log.h"
 #include "mongo/logv2/log_capture_backend.h"
@@ -1705,6 +1706,67 @@ TEST_F(LogV2Test, FileLogging) {
     ASSERT(before_rotation == after_rotation);
 }
 
+TEST_F(LogV2Test, AsyncFileLogging) {
+    auto logv2_dir = std::make_unique<mongo::unittest::TempDir>("logv2");
+    std::string file_name = logv2_dir->path() + "/file.log";
+
+    // A buffer smaller than some of the records, so that records wrap around the end of the buffer
+    // and some are too large to be buffered at all.
+    auto backend = boost::make_shared<FileRotateSink>(LogTimestampFormat::kISO8601UTC, 64);
+    ASSERT_OK(backend->addFile(file_name, false));
+
+    auto sink = wrapInSynchronousSink(backend);
+    applyDefaultFilterToSink(sink);
+    sink->set_formatter(PlainFormatter());
+    attachSink(sink);
+
+    auto readFile = [&](std::string const& filename) {
+        std::vector<std::string> lines;
+        std::ifstream file(filename);
+        for (std::string line; std::getline(file, line, '\n');)
+            lines.push_back(std::move(line));
+        return lines;
+    };
+
+    constexpr int kNumThreads = 4;
+    constexpr int kNumPerThread = 1000;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kNumPerThread; ++j)
+                LOGV2(5941200, "{value}", "value"_attr = std::string(j % 100, 'x'));
+        });
+    }
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    sink->flush();
+    auto lines = readFile(file_name);
+    ASSERT_EQ(lines.size(), kNumThreads * kNumPerThread);
+    for (auto&& line : lines) {
+        ASSERT_EQ(line, std::string(line.size(), 'x'));
+    }
+
+    // Errors are written before the logging call returns.
+    LOGV2_ERROR(5941201, "error");
+    ASSERT_EQ(readFile(file_name).back(), "error");
+
+    // Everything buffered is written to the old file before rotating.
+    LOGV2(5941202, "before rotation");
+    {
+        auto locked = sink->locked_backend();
+        ASSERT_OK(locked->rotate(true, "-rotated"));
+    }
+    ASSERT_EQ(readFile(file_name + "-rotated").back(), "before rotation");
+
+    LOGV2(5941203, "after rotation");
+    sink->flush();
+    auto afterRotation = readFile(file_name);
+    ASSERT_EQ(afterRotation.size(), 1);
+    ASSERT_EQ(afterRotation.back(), "after rotation");
+}
+
 TEST_F(LogV2Test, UserAssert) {
     std::vector<std::string> lines;
     auto sink = wrapInSynchronousSink(wrapInCompositeBackend(
@@ -80,7 +80,6 @@ AsyncRequestsSender::AsyncRequestsSender(OperationContext* opCtx,
     // Initialize command metadata to handle the read preference.
     _metadataObj = readPreference.toContainingBSON();
 
-    _remotes.reserve(requests.size());
     for (const auto& request : requests) {
         // Kick off requests immediately.
         _remotes.emplace_back(this, request.shardId, request.cmdObj).executeRequest();
@@ -135,6 +134,20 @@ AsyncRequestsSender::Response AsyncRequestsSender::next() noexcept {
     return _responseQueue.pop();
 }
 
+void AsyncRequestsSender::addRequest(const Request& request) {
+    _remotesLeft++;
+
+    auto& remote = _remotes.emplace_back(this, request.shardId, request.cmdObj);
+
+    // Once interrupted, next() only returns the responses which are already queued
+    if (!_interruptStatus.isOK()) {
+        _responseQueue.push(std::move(remote).makeFailedResponse(_interruptStatus));
+        return;
+    }
+
+    remote.executeRequest();
+}
+
 void AsyncRequestsSender::stopRetrying() noexcept {
     _stopRetrying = true;
 }
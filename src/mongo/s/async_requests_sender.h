@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 #include <vector>
 
 #include "mongo/base/status_with.h"
@@ -137,6 +138,13 @@ public:
                         const ReadPreferenceSetting& readPreference,
                         Shard::RetryPolicy retryPolicy);
 
+    /**
+     * Sends another request, whose response is returned by next() along with the responses for the
+     * requests the ARS was constructed with. May be called after done() returned true, in which
+     * case done() returns false again until that response has been returned.
+     */
+    void addRequest(const Request& request);
+
     /**
      * Returns true if responses for all requests have been returned via next().
      */
@@ -267,8 +275,9 @@ private:
     // The policy to use when deciding whether to retry on an error.
     Shard::RetryPolicy _retryPolicy;
 
-    // Data tracking the state of our communication with each of the remote nodes.
-    std::vector<RemoteData> _remotes;
+    // Data tracking the state of our communication with each of the remote nodes. A deque, since
+    // the remotes are referenced by their callbacks and addRequest() must not move them.
+    std::deque<RemoteData> _remotes;
 
     // Number of remotes we haven't returned final results from.
     size_t _remotesLeft;
@@ -76,6 +76,28 @@ void appendChunkTo(std::vector<std::shared_ptr<ChunkInfo>>& chunks,
     }
 }
 
+bool isContiguous(const ChunkInfo& prev, const ChunkInfo& next) {
+    return prev.getShardIdAt(boost::none) == next.getShardIdAt(boost::none) ||
+        SimpleBSONObjComparator::kInstance.evaluate(prev.getMax() == next.getMin());
+}
+
+// Throws if there is a gap or an overlap between two adjacent chunks owned by different shards.
+void checkContinuity(const ChunkInfo& prev, const ChunkInfo& next) {
+    if (isContiguous(prev, next))
+        return;
+
+    if (SimpleBSONObjComparator::kInstance.evaluate(prev.getMax() < next.getMin()))
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Gap exists in the routing table between chunks "
+                                << prev.getRange().toString() << " and "
+                                << next.getRange().toString());
+    else
+        uasserted(ErrorCodes::ConflictingOperationInProgress,
+                  str::stream() << "Overlap exists in the routing table between chunks "
+                                << prev.getRange().toString() << " and "
+                                << next.getRange().toString());
+}
+
 // This function processes the passed in chunks by removing the older versions of any overlapping
 // chunks. The resulting chunks must be ordered by the maximum bound and not have any
 // overlapping chunks. In order to process the original set of chunks correctly which may have
@@ -113,96 +135,185 @@ std::vector<std::shared_ptr<ChunkInfo>> flatten(const std::vector<ChunkType>& ch
 
 }  // namespace
 
-ShardVersionMap ChunkMap::constructShardVersionMap() const {
-    ShardVersionMap shardVersions;
-    ChunkVector::const_iterator current = _chunkMap.cbegin();
-
-    boost::optional<BSONObj> firstMin = boost::none;
-    boost::optional<BSONObj> lastMax = boost::none;
-
-    while (current != _chunkMap.cend()) {
-        const auto& firstChunkInRange = *current;
-        const auto& currentRangeShardId = firstChunkInRange->getShardIdAt(boost::none);
-
-        // Tracks the max shard version for the shard on which the current range will reside
-        auto shardVersionIt = shardVersions.find(currentRangeShardId);
-        if (shardVersionIt == shardVersions.end()) {
-            shardVersionIt = shardVersions
-                                 .emplace(std::piecewise_construct,
-                                          std::forward_as_tuple(currentRangeShardId),
-                                          std::forward_as_tuple(_collectionVersion.epoch(),
-                                                                _collectionVersion.getTimestamp()))
-                                 .first;
+void ChunkMap::ChunkBlock::push_back(const std::shared_ptr<ChunkInfo>& chunk) {
+    if (!chunks.empty() && !discontinuity && !isContiguous(*chunks.back(), *chunk))
+        discontinuity = chunks.size();
+
+    chunks.push_back(chunk);
+
+    if (hasIntegerMaxes) {
+        const auto& max = chunk->getMax();
+        const auto maxElem = max.firstElement();
+
+        // Only the max of the last chunk of the collection may be MaxKey, and it is not stored
+        if (integerMaxes.size() + 1 < chunks.size() || max.nFields() != 1) {
+            hasIntegerMaxes = false;
+        } else if (maxElem.type() == NumberLong) {
+            integerMaxes.push_back(maxElem._numberLong());
+        } else if (maxElem.type() != MaxKey) {
+            hasIntegerMaxes = false;
         }
 
-        auto& maxShardVersion = shardVersionIt->second.shardVersion;
+        if (!hasIntegerMaxes)
+            integerMaxes.clear();
+    }
 
-        current =
-            std::find_if(current,
-                         _chunkMap.cend(),
-                         [&currentRangeShardId, &maxShardVersion](const auto& currentChunk) {
-                             if (currentChunk->getShardIdAt(boost::none) != currentRangeShardId)
-                                 return true;
+    const auto& shardId = chunk->getShardIdAt(boost::none);
+    auto it = std::find_if(shardVersions.begin(), shardVersions.end(), [&](const auto& entry) {
+        return entry.first == shardId;
+    });
+    if (it == shardVersions.end()) {
+        shardVersions.emplace_back(shardId, chunk->getLastmod());
+    } else if (it->second.isOlderThan(chunk->getLastmod())) {
+        it->second = chunk->getLastmod();
+    }
+}
 
-                             if (maxShardVersion.isOlderThan(currentChunk->getLastmod()))
-                                 maxShardVersion = currentChunk->getLastmod();
+void ChunkMap::ChunkBlock::pop_back() {
+    // The removed chunk may have held the max version of its shard, so the summary of the block is
+    // rebuilt from the remaining chunks
+    auto remaining = std::move(chunks);
+    remaining.pop_back();
 
-                             return false;
-                         });
+    chunks.clear();
+    shardVersions.clear();
+    discontinuity = boost::none;
+    integerMaxes.clear();
+    hasIntegerMaxes = true;
 
-        const auto rangeLast = *std::prev(current);
+    for (const auto& chunk : remaining) {
+        push_back(chunk);
+    }
+}
 
-        const auto& rangeMin = firstChunkInRange->getMin();
-        const auto& rangeMax = rangeLast->getMax();
+ShardVersionMap ChunkMap::constructShardVersionMap() const {
+    ShardVersionMap shardVersions;
+    const ChunkInfo* prevChunk = nullptr;
 
-        // Check the continuity of the chunks map
-        if (lastMax && !SimpleBSONObjComparator::kInstance.evaluate(*lastMax == rangeMin)) {
-            if (SimpleBSONObjComparator::kInstance.evaluate(*lastMax < rangeMin))
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Gap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
-            else
-                uasserted(ErrorCodes::ConflictingOperationInProgress,
-                          str::stream() << "Overlap exists in the routing table between chunks "
-                                        << findIntersectingChunk(*lastMax)->getRange().toString()
-                                        << " and " << rangeLast->getRange().toString());
+    // Each block keeps the max chunk version of the shards it contains and the first break in its
+    // continuity, so only the boundaries between the blocks need to be checked here
+    for (const auto& block : _blocks) {
+        if (prevChunk)
+            checkContinuity(*prevChunk, *block->chunks.front());
+
+        if (block->discontinuity) {
+            const auto idx = *block->discontinuity;
+            checkContinuity(*block->chunks[idx - 1], *block->chunks[idx]);
         }
 
-        if (!firstMin)
-            firstMin = rangeMin;
+        prevChunk = block->chunks.back().get();
+
+        for (const auto& [shardId, version] : block->shardVersions) {
+            // Tracks the max shard version for the shard on which the chunks reside
+            auto shardVersionIt = shardVersions.find(shardId);
+            if (shardVersionIt == shardVersions.end()) {
+                shardVersionIt =
+                    shardVersions
+                        .emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(shardId),
+                                 std::forward_as_tuple(_collectionVersion.epoch(),
+                                                       _collectionVersion.getTimestamp()))
+                        .first;
+            }
 
-        lastMax = rangeMax;
+            auto& maxShardVersion = shardVersionIt->second.shardVersion;
+            if (maxShardVersion.isOlderThan(version))
+                maxShardVersion = version;
+        }
+    }
 
-        // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
-        // somewhere, which should have been caught at chunk load time
-        invariant(maxShardVersion.isSet());
+    // If a shard has chunks it must have a shard version, otherwise we have an invalid chunk
+    // somewhere, which should have been caught at chunk load time
+    for (const auto& entry : shardVersions) {
+        invariant(entry.second.shardVersion.isSet());
     }
 
-    if (!_chunkMap.empty()) {
+    if (!_blocks.empty()) {
         invariant(!shardVersions.empty());
-        invariant(firstMin.is_initialized());
-        invariant(lastMax.is_initialized());
 
-        checkAllElementsAreOfType(MinKey, firstMin.get());
-        checkAllElementsAreOfType(MaxKey, lastMax.get());
+        checkAllElementsAreOfType(MinKey, _blocks.front()->chunks.front()->getMin());
+        checkAllElementsAreOfType(MaxKey, _blocks.back()->chunks.back()->getMax());
     }
 
     return shardVersions;
 }
 
 void ChunkMap::appendChunk(const std::shared_ptr<ChunkInfo>& chunk) {
-    appendChunkTo(_chunkMap, chunk);
+    if (!_blocks.empty()) {
+        const auto& lastChunk = _blocks.back()->chunks.back();
+        if (chunk->getRange().overlaps(lastChunk->getRange())) {
+            if (!lastChunk->getLastmod().isOlderThan(chunk->getLastmod()))
+                return;
+
+            _mutableLastBlock().pop_back();
+            --_size;
+
+            if (_blocks.back()->chunks.empty())
+                _blocks.pop_back();
+        }
+    }
+
+    // A small block which is shared with another map is copied rather than followed by a new
+    // block, so that repeated merges do not fragment the map into many tiny blocks
+    if (_blocks.empty() || _blocks.back()->chunks.size() >= kMaxChunksPerBlock ||
+        (_blocks.back().use_count() > 1 &&
+         _blocks.back()->chunks.size() >= kMaxChunksPerBlock / 2)) {
+        _blocks.push_back(std::make_shared<ChunkBlock>());
+        _blocks.back()->chunks.reserve(kMaxChunksPerBlock);
+    }
+
+    _mutableLastBlock().push_back(chunk);
+    ++_size;
 
     if (_collectionVersion.isOlderThan(chunk->getLastmod()))
         _collectionVersion = chunk->getLastmod();
 }
 
+void ChunkMap::_appendBlock(const std::shared_ptr<ChunkBlock>& block) {
+    if (!_blocks.empty() && _blocks.back().use_count() == 1 &&
+        _blocks.back()->chunks.size() + block->chunks.size() <= kMaxChunksPerBlock) {
+        for (const auto& chunk : block->chunks) {
+            _blocks.back()->push_back(chunk);
+        }
+    } else {
+        _blocks.push_back(block);
+    }
+
+    _size += block->chunks.size();
+
+    for (const auto& entry : block->shardVersions) {
+        if (_collectionVersion.isOlderThan(entry.second))
+            _collectionVersion = entry.second;
+    }
+}
+
+ChunkMap::ChunkBlock& ChunkMap::_mutableLastBlock() {
+    auto& lastBlock = _blocks.back();
+    if (lastBlock.use_count() > 1)
+        lastBlock = std::make_shared<ChunkBlock>(*lastBlock);
+
+    return *lastBlock;
+}
+
+size_t ChunkMap::numSharedBlocksForTest(const ChunkMap& other) const {
+    const std::set<const ChunkBlock*> otherBlocks = [&] {
+        std::set<const ChunkBlock*> blocks;
+        for (const auto& block : other._blocks) {
+            blocks.insert(block.get());
+        }
+        return blocks;
+    }();
+
+    return std::count_if(_blocks.begin(), _blocks.end(), [&](const auto& block) {
+        return otherBlocks.count(block.get()) > 0;
+    });
+}
+
 std::shared_ptr<ChunkInfo> ChunkMap::findIntersectingChunk(const BSONObj& shardKey) const {
-    const auto it = _findIntersectingChunk(shardKey);
+    const auto pos = _findIntersectingChunk(shardKey);
 
-    if (it != _chunkMap.end())
-        return *it;
+    if (pos.block < _blocks.size())
+        return _blocks[pos.block]->chunks[pos.chunk];
 
     return std::shared_ptr<ChunkInfo>();
 }
@@ -218,41 +329,50 @@ void validateChunk(const std::shared_ptr<ChunkInfo>& chunk, const ChunkVersion&
 
 ChunkMap ChunkMap::createMerged(
     const std::vector<std::shared_ptr<ChunkInfo>>& changedChunks) const {
-    size_t chunkMapIndex = 0;
     size_t changedChunkIndex = 0;
 
     ChunkMap updatedChunkMap(
-        getVersion().epoch(), getVersion().getTimestamp(), _chunkMap.size() + changedChunks.size());
-
-    while (chunkMapIndex < _chunkMap.size() || changedChunkIndex < changedChunks.size()) {
-        if (chunkMapIndex >= _chunkMap.size()) {
-            validateChunk(changedChunks[changedChunkIndex], getVersion());
-            updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+        getVersion().epoch(), getVersion().getTimestamp(), _size + changedChunks.size());
+
+    for (const auto& block : _blocks) {
+        const auto& firstChunk = block->chunks.front();
+        const auto& lastChunk = block->chunks.back();
+
+        // A block which neither the next changed chunk nor the last merged chunk overlaps would be
+        // copied unchanged, so it is shared instead
+        const bool overlapsChangedChunk = changedChunkIndex < changedChunks.size() &&
+            changedChunks[changedChunkIndex]->getRange().overlaps(
+                ChunkRange(firstChunk->getMin(), lastChunk->getMax()));
+        const bool overlapsMergedChunk = !updatedChunkMap._blocks.empty() &&
+            updatedChunkMap._blocks.back()->chunks.back()->getRange().overlaps(
+                firstChunk->getRange());
+
+        if (!overlapsChangedChunk && !overlapsMergedChunk) {
+            updatedChunkMap._appendBlock(block);
             continue;
         }
 
-        if (changedChunkIndex >= changedChunks.size()) {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
-            continue;
-        }
+        for (const auto& chunkInfo : block->chunks) {
+            while (changedChunkIndex < changedChunks.size() &&
+                   chunkInfo->getRange().overlaps(changedChunks[changedChunkIndex]->getRange())) {
+                auto& changedChunk = changedChunks[changedChunkIndex++];
 
-        auto overlap = _chunkMap[chunkMapIndex]->getRange().overlaps(
-            changedChunks[changedChunkIndex]->getRange());
+                auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
+                changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
 
-        if (overlap) {
-            auto& changedChunk = changedChunks[changedChunkIndex++];
-            auto& chunkInfo = _chunkMap[chunkMapIndex];
-
-            auto bytesInReplacedChunk = chunkInfo->getWritesTracker()->getBytesWritten();
-            changedChunk->getWritesTracker()->addBytesWritten(bytesInReplacedChunk);
+                validateChunk(changedChunk, getVersion());
+                updatedChunkMap.appendChunk(changedChunk);
+            }
 
-            validateChunk(changedChunk, getVersion());
-            updatedChunkMap.appendChunk(changedChunk);
-        } else {
-            updatedChunkMap.appendChunk(_chunkMap[chunkMapIndex++]);
+            updatedChunkMap.appendChunk(chunkInfo);
         }
     }
 
+    while (changedChunkIndex < changedChunks.size()) {
+        validateChunk(changedChunks[changedChunkIndex], getVersion());
+        updatedChunkMap.appendChunk(changedChunks[changedChunkIndex++]);
+    }
+
     return updatedChunkMap;
 }
 
@@ -260,48 +380,112 @@ BSONObj ChunkMap::toBSON() const {
     BSONObjBuilder builder;
 
     builder.append("startingVersion"_sd, getVersion().toBSON());
-    builder.append("chunkCount", static_cast<int64_t>(_chunkMap.size()));
+    builder.append("chunkCount", static_cast<int64_t>(_size));
 
     {
         BSONArrayBuilder arrayBuilder(builder.subarrayStart("chunks"_sd));
-        for (const auto& chunk : _chunkMap) {
+        forEach([&](const auto& chunk) {
             arrayBuilder.append(chunk->toString());
-        }
+            return true;
+        });
     }
 
     return builder.obj();
 }
 
-ChunkMap::ChunkVector::const_iterator ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
-                                                                       bool isMaxInclusive) const {
+ChunkMap::Position ChunkMap::_findIntersectingChunk(const BSONObj& shardKey,
+                                                    bool isMaxInclusive) const {
+    if (isMaxInclusive) {
+        const auto shardKeyElem = shardKey.firstElement();
+        if (shardKeyElem.type() == NumberLong && shardKey.nFields() == 1) {
+            if (auto pos = _findIntersectingChunkByIntegerKey(shardKeyElem._numberLong()))
+                return *pos;
+        }
+    }
+
     auto shardKeyString = ShardKeyPattern::toKeyString(shardKey);
 
-    if (!isMaxInclusive) {
-        return std::lower_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const auto& chunkInfo, const BSONObj& shardKey) {
-                                    return chunkInfo->getMaxKeyString() < shardKeyString;
-                                });
-    } else {
-        return std::upper_bound(_chunkMap.begin(),
-                                _chunkMap.end(),
-                                shardKey,
-                                [&shardKeyString](const BSONObj& shardKey, const auto& chunkInfo) {
-                                    return shardKeyString < chunkInfo->getMaxKeyString();
-                                });
+    const auto isBefore = [&](const std::shared_ptr<ChunkInfo>& chunkInfo) {
+        return isMaxInclusive ? !(shardKeyString < chunkInfo->getMaxKeyString())
+                              : chunkInfo->getMaxKeyString() < shardKeyString;
+    };
+
+    // The chunks are ordered by max key across the blocks, so the block holding the chunk is the
+    // first one whose last chunk is not before the key
+    const auto blockIt = std::partition_point(_blocks.begin(),
+                                              _blocks.end(),
+                                              [&](const auto& block) {
+                                                  return isBefore(block->chunks.back());
+                                              });
+    if (blockIt == _blocks.end())
+        return {_blocks.size(), 0};
+
+    const auto& chunks = (*blockIt)->chunks;
+    const auto chunkIt = std::partition_point(chunks.begin(), chunks.end(), isBefore);
+
+    return {static_cast<size_t>(blockIt - _blocks.begin()),
+            static_cast<size_t>(chunkIt - chunks.begin())};
+}
+
+boost::optional<ChunkMap::Position> ChunkMap::_findIntersectingChunkByIntegerKey(
+    long long shardKey) const {
+    bool missingIntegerMaxes = false;
+
+    // A block is before the key if its last chunk is, which cannot be the case for the block whose
+    // last max is MaxKey and so is not among its integer maxes
+    const auto blockIt =
+        std::partition_point(_blocks.begin(), _blocks.end(), [&](const auto& block) {
+            if (!block->hasIntegerMaxes) {
+                missingIntegerMaxes = true;
+                return false;
+            }
+
+            return block->integerMaxes.size() == block->chunks.size() &&
+                !(shardKey < block->integerMaxes.back());
+        });
+    if (missingIntegerMaxes)
+        return boost::none;
+
+    if (blockIt == _blocks.end())
+        return Position{_blocks.size(), 0};
+
+    if (!(*blockIt)->hasIntegerMaxes)
+        return boost::none;
+
+    // Counts the maxes which are not greater than the key, which is the index of the first chunk
+    // whose max is. The halving step selects the next base without a branch, so that the search
+    // compiles to conditional moves rather than mispredicted jumps.
+    const auto& maxes = (*blockIt)->integerMaxes;
+    size_t chunkIdx = 0;
+    if (!maxes.empty()) {
+        const long long* base = maxes.data();
+        size_t count = maxes.size();
+        while (count > 1) {
+            const size_t half = count / 2;
+            base = base[half] <= shardKey ? base + half : base;
+            count -= half;
+        }
+        chunkIdx = static_cast<size_t>(base - maxes.data()) + (*base <= shardKey ? 1 : 0);
     }
+
+    return Position{static_cast<size_t>(blockIt - _blocks.begin()), chunkIdx};
 }
 
-std::pair<ChunkMap::ChunkVector::const_iterator, ChunkMap::ChunkVector::const_iterator>
-ChunkMap::_overlappingBounds(const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
-    const auto itMin = _findIntersectingChunk(min);
-    const auto itMax = [&]() {
-        auto it = _findIntersectingChunk(max, isMaxInclusive);
-        return it == _chunkMap.end() ? it : ++it;
+std::pair<ChunkMap::Position, ChunkMap::Position> ChunkMap::_overlappingBounds(
+    const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const {
+    const auto posMin = _findIntersectingChunk(min);
+    const auto posMax = [&]() -> Position {
+        auto pos = _findIntersectingChunk(max, isMaxInclusive);
+        if (pos.block == _blocks.size())
+            return pos;
+
+        if (pos.chunk + 1 < _blocks[pos.block]->chunks.size())
+            return {pos.block, pos.chunk + 1};
+
+        return {pos.block + 1, 0};
     }();
 
-    return {itMin, itMax};
+    return {posMin, posMax};
 }
 
 ShardVersionTargetingInfo::ShardVersionTargetingInfo(const OID& epoch,
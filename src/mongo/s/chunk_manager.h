@@ -76,16 +76,50 @@ class ChunkMap {
     // Vector of chunks ordered by max key.
     using ChunkVector = std::vector<std::shared_ptr<ChunkInfo>>;
 
+    // The chunks are stored as a sequence of blocks of consecutive chunks. A block is not modified
+    // once it is shared with another map, so createMerged() only copies the blocks which overlap
+    // the changed chunks and shares all the other ones with the map it was created from.
+    struct ChunkBlock {
+        void push_back(const std::shared_ptr<ChunkInfo>& chunk);
+        void pop_back();
+
+        ChunkVector chunks;
+
+        // Max chunk version for each shard which owns chunks in this block
+        std::vector<std::pair<ShardId, ChunkVersion>> shardVersions;
+
+        // Index of the first chunk whose min does not match the max of the preceding chunk, when
+        // the two chunks are owned by different shards
+        boost::optional<size_t> discontinuity;
+
+        // The max of each chunk as an integer, as long as all of them are single NumberLong values
+        // except for the MaxKey max of the last chunk of the collection, which is left out. This is
+        // always the case for a hashed shard key, whose point lookups can then search an array of
+        // integers rather than compare KeyStrings through the chunks.
+        std::vector<long long> integerMaxes;
+        bool hasIntegerMaxes{true};
+    };
+    using BlockVector = std::vector<std::shared_ptr<ChunkBlock>>;
+
+    // Location of a chunk as the index of its block and its index within that block
+    struct Position {
+        size_t block;
+        size_t chunk;
+    };
+
 public:
+    // Number of chunks after which a new block is started
+    static constexpr size_t kMaxChunksPerBlock = 256;
+
     explicit ChunkMap(OID epoch,
                       const boost::optional<Timestamp>& timestamp,
                       size_t initialCapacity = 0)
         : _collectionVersion(0, 0, epoch, timestamp) {
-        _chunkMap.reserve(initialCapacity);
+        _blocks.reserve(initialCapacity / kMaxChunksPerBlock + 1);
     }
 
     size_t size() const {
-        return _chunkMap.size();
+        return _size;
     }
 
     ChunkVersion getVersion() const {
@@ -94,12 +128,10 @@ public:
 
     template <typename Callable>
     void forEach(Callable&& handler, const BSONObj& shardKey = BSONObj()) const {
-        auto it = shardKey.isEmpty() ? _chunkMap.begin() : _findIntersectingChunk(shardKey);
+        const auto begin =
+            shardKey.isEmpty() ? Position{0, 0} : _findIntersectingChunk(shardKey);
 
-        for (; it != _chunkMap.end(); ++it) {
-            if (!handler(*it))
-                break;
-        }
+        _forEachInRange(begin, Position{_blocks.size(), 0}, handler);
     }
 
     template <typename Callable>
@@ -109,10 +141,7 @@ public:
                                  Callable&& handler) const {
         const auto bounds = _overlappingBounds(min, max, isMaxInclusive);
 
-        for (auto it = bounds.first; it != bounds.second; ++it) {
-            if (!handler(*it))
-                break;
-        }
+        _forEachInRange(bounds.first, bounds.second, handler);
     }
 
     ShardVersionMap constructShardVersionMap() const;
@@ -124,13 +153,60 @@ public:
 
     BSONObj toBSON() const;
 
+    /**
+     * Returns the number of blocks the chunks are stored in. Only used for testing.
+     */
+    size_t numBlocksForTest() const {
+        return _blocks.size();
+    }
+
+    /**
+     * Returns the number of blocks this map shares with 'other'. Only used for testing.
+     */
+    size_t numSharedBlocksForTest(const ChunkMap& other) const;
+
 private:
-    ChunkVector::const_iterator _findIntersectingChunk(const BSONObj& shardKey,
-                                                       bool isMaxInclusive = true) const;
-    std::pair<ChunkVector::const_iterator, ChunkVector::const_iterator> _overlappingBounds(
-        const BSONObj& min, const BSONObj& max, bool isMaxInclusive) const;
+    template <typename Callable>
+    void _forEachInRange(const Position& begin, const Position& end, Callable&& handler) const {
+        for (size_t blockIdx = begin.block; blockIdx <= end.block && blockIdx < _blocks.size();
+             ++blockIdx) {
+            const auto& chunks = _blocks[blockIdx]->chunks;
+            const size_t first = blockIdx == begin.block ? begin.chunk : 0;
+            const size_t last = blockIdx == end.block ? end.chunk : chunks.size();
+
+            for (size_t chunkIdx = first; chunkIdx < last; ++chunkIdx) {
+                if (!handler(chunks[chunkIdx]))
+                    return;
+            }
+        }
+    }
+
+    Position _findIntersectingChunk(const BSONObj& shardKey, bool isMaxInclusive = true) const;
+
+    /**
+     * Same as _findIntersectingChunk for a shard key consisting of a single NumberLong value, but
+     * using the integer maxes of the blocks. Returns boost::none if any of the blocks it looks at
+     * does not have them.
+     */
+    boost::optional<Position> _findIntersectingChunkByIntegerKey(long long shardKey) const;
+    std::pair<Position, Position> _overlappingBounds(const BSONObj& min,
+                                                     const BSONObj& max,
+                                                     bool isMaxInclusive) const;
+
+    /**
+     * Adds 'block' at the end of the map, sharing it unless it can be folded into the last block.
+     */
+    void _appendBlock(const std::shared_ptr<ChunkBlock>& block);
+
+    /**
+     * Returns the last block, copying it first if it is shared with another map.
+     */
+    ChunkBlock& _mutableLastBlock();
+
+    BlockVector _blocks;
 
-    ChunkVector _chunkMap;
+    // Total number of chunks across all blocks
+    size_t _size{0};
 
     // Max version across all chunks
     ChunkVersion _collectionVersion;
@@ -38,6 +38,7 @@ namespace {
 
 const NamespaceString kNss("TestDB", "TestColl");
 const ShardId kThisShard("testShard");
+const ShardId kOtherShard("otherShard");
 
 class ChunkMapTest : public unittest::Test {
 public:
@@ -132,6 +133,52 @@ TEST_F(ChunkMapTest, TestIntersectingChunk) {
                                                        BSON("a" << 100)));
 }
 
+TEST_F(ChunkMapTest, TestIntersectingChunkWithIntegerBounds) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    // Enough chunks with NumberLong bounds, as for a hashed shard key, to span several blocks
+    const long long kNumChunks = 3 * ChunkMap::kMaxChunksPerBlock;
+    const auto boundFor = [&](long long i) {
+        return BSON("a" << (i - kNumChunks / 2) * 1000LL);
+    };
+
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (long long i = 0; i < kNumChunks; ++i) {
+        const auto min = i == 0 ? getShardKeyPattern().globalMin() : boundFor(i);
+        const auto max = i == kNumChunks - 1 ? getShardKeyPattern().globalMax() : boundFor(i + 1);
+        chunks.push_back(std::make_shared<ChunkInfo>(
+            ChunkType{kNss, ChunkRange{min, max}, version, kThisShard}));
+        version.incMinor();
+    }
+
+    auto newChunkMap = chunkMap.createMerged(chunks);
+    ASSERT_GT(newChunkMap.numBlocksForTest(), 1U);
+
+    for (long long i = 0; i < kNumChunks; ++i) {
+        // The lower bound of a chunk, a key inside of it and the same key as a double, which is
+        // looked up through its KeyString, all find the chunk
+        const long long value = (i - kNumChunks / 2) * 1000LL;
+        for (const auto& key :
+             {BSON("a" << value), BSON("a" << value + 1), BSON("a" << double(value + 1))}) {
+            auto intersectingChunk = newChunkMap.findIntersectingChunk(key);
+            ASSERT(intersectingChunk);
+            ASSERT_BSONOBJ_EQ(chunks[i]->getMin(), intersectingChunk->getMin());
+        }
+    }
+
+    auto lowestChunk = newChunkMap.findIntersectingChunk(
+        BSON("a" << std::numeric_limits<long long>::min()));
+    ASSERT(lowestChunk);
+    ASSERT_BSONOBJ_EQ(chunks.front()->getMin(), lowestChunk->getMin());
+
+    auto highestChunk = newChunkMap.findIntersectingChunk(
+        BSON("a" << std::numeric_limits<long long>::max()));
+    ASSERT(highestChunk);
+    ASSERT_BSONOBJ_EQ(chunks.back()->getMin(), highestChunk->getMin());
+}
+
 TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     const OID epoch = OID::gen();
     ChunkMap chunkMap{epoch, boost::none /* timestamp */};
@@ -165,4 +212,92 @@ TEST_F(ChunkMapTest, TestEnumerateOverlappingChunks) {
     ASSERT_EQ(count, 3);
 }
 
+TEST_F(ChunkMapTest, TestMergeSharesUnchangedBlocks) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    const int numChunks = 10 * ChunkMap::kMaxChunksPerBlock;
+    std::vector<std::shared_ptr<ChunkInfo>> chunks;
+    for (int i = 0; i < numChunks; ++i) {
+        const auto min = i == 0 ? getShardKeyPattern().globalMin() : BSON("a" << i * 10);
+        const auto max =
+            i == numChunks - 1 ? getShardKeyPattern().globalMax() : BSON("a" << (i + 1) * 10);
+        const auto& shard = i < numChunks / 2 ? kThisShard : kOtherShard;
+        chunks.push_back(
+            std::make_shared<ChunkInfo>(ChunkType{kNss, ChunkRange{min, max}, version, shard}));
+        version.incMinor();
+    }
+
+    auto chunkMap1 = chunkMap.createMerged(chunks);
+    ASSERT_EQ(chunkMap1.size(), numChunks);
+    ASSERT_EQ(chunkMap1.numBlocksForTest(), 10);
+
+    // Split a chunk in the middle of the map
+    const int splitChunk = numChunks / 4;
+    version.incMajor();
+    ChunkVersion splitVersion = version;
+    splitVersion.incMinor();
+    auto chunkMap2 = chunkMap1.createMerged(
+        {std::make_shared<ChunkInfo>(ChunkType{kNss,
+                                               ChunkRange{BSON("a" << splitChunk * 10),
+                                                          BSON("a" << splitChunk * 10 + 5)},
+                                               version,
+                                               kThisShard}),
+         std::make_shared<ChunkInfo>(ChunkType{kNss,
+                                               ChunkRange{BSON("a" << splitChunk * 10 + 5),
+                                                          BSON("a" << (splitChunk + 1) * 10)},
+                                               splitVersion,
+                                               kThisShard})});
+
+    ASSERT_EQ(chunkMap2.size(), numChunks + 1);
+    ASSERT_EQ(chunkMap2.getVersion(), splitVersion);
+    ASSERT_GTE(chunkMap2.numSharedBlocksForTest(chunkMap1), 9);
+
+    // The previous map is left untouched
+    ASSERT_EQ(chunkMap1.size(), numChunks);
+    auto oldChunk = chunkMap1.findIntersectingChunk(BSON("a" << splitChunk * 10 + 7));
+    ASSERT_BSONOBJ_EQ(oldChunk->getMin(), BSON("a" << splitChunk * 10));
+
+    auto newChunk = chunkMap2.findIntersectingChunk(BSON("a" << splitChunk * 10 + 7));
+    ASSERT_BSONOBJ_EQ(newChunk->getMin(), BSON("a" << splitChunk * 10 + 5));
+
+    int count = 0;
+    auto lastMax = getShardKeyPattern().globalMin();
+    chunkMap2.forEach([&](const auto& chunkInfo) {
+        ASSERT_BSONOBJ_EQ(chunkInfo->getMin(), lastMax);
+        lastMax = chunkInfo->getMax();
+        count++;
+        return true;
+    });
+    ASSERT_EQ(count, numChunks + 1);
+
+    const auto shardVersions = chunkMap2.constructShardVersionMap();
+    ASSERT_EQ(shardVersions.size(), 2);
+    ASSERT_EQ(shardVersions.at(kThisShard).shardVersion, splitVersion);
+}
+
+TEST_F(ChunkMapTest, TestGapBetweenShardsIsDetected) {
+    const OID epoch = OID::gen();
+    ChunkMap chunkMap{epoch, boost::none /* timestamp */};
+    ChunkVersion version{1, 0, epoch, boost::none /* timestamp */};
+
+    auto newChunkMap = chunkMap.createMerged(
+        {std::make_shared<ChunkInfo>(
+             ChunkType{kNss,
+                       ChunkRange{getShardKeyPattern().globalMin(), BSON("a" << 0)},
+                       version,
+                       kThisShard}),
+
+         std::make_shared<ChunkInfo>(ChunkType{
+             kNss,
+             ChunkRange{BSON("a" << 100), getShardKeyPattern().globalMax()},
+             version,
+             kOtherShard})});
+
+    ASSERT_THROWS_CODE(newChunkMap.constructShardVersionMap(),
+                       DBException,
+                       ErrorCodes::ConflictingOperationInProgress);
+}
+
 }  // namespace mongo
@@ -42,6 +42,37 @@ uint64_t ChunkWritesTracker::clearBytesWritten() {
     return _bytesWritten.swap(0);
 }
 
+double ChunkWritesTracker::getBytesWrittenPerSecond(Date_t now) const {
+    const auto windowMillis = durationCount<Milliseconds>(kWriteRateWindow);
+    const auto sinceWindowStart = now.toMillisSinceEpoch() - _windowStartMillis.load();
+
+    // Once the current window has ended it is the last complete window, until the next write
+    // rolls it over. If a whole window has passed since then, there were no writes in it.
+    unsigned long long bytes = 0;
+    if (sinceWindowStart < windowMillis) {
+        bytes = _previousWindowBytes.load();
+    } else if (sinceWindowStart < 2 * windowMillis) {
+        bytes = _currentWindowBytes.load();
+    }
+
+    return static_cast<double>(bytes) / durationCount<Seconds>(kWriteRateWindow);
+}
+
+void ChunkWritesTracker::_addToWriteRateWindow(uint64_t bytesWritten, Date_t now) {
+    const auto windowMillis = durationCount<Milliseconds>(kWriteRateWindow);
+    auto windowStart = _windowStartMillis.load();
+    const auto nowMillis = now.toMillisSinceEpoch();
+
+    // Only the thread which moves the start of the window rolls the windows over.
+    if (nowMillis - windowStart >= windowMillis &&
+        _windowStartMillis.compareAndSwap(&windowStart, nowMillis)) {
+        const auto bytes = _currentWindowBytes.swap(0);
+        _previousWindowBytes.store(nowMillis - windowStart < 2 * windowMillis ? bytes : 0);
+    }
+
+    _currentWindowBytes.fetchAndAdd(bytesWritten);
+}
+
 bool ChunkWritesTracker::shouldSplit(uint64_t maxChunkSize) {
     if (_isLockedForSplitting) {
         return false;
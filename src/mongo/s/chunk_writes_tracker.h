@@ -31,6 +31,8 @@
 
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/util/duration.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
@@ -42,13 +44,25 @@ public:
      */
     static constexpr uint64_t kSplitTestFactor = 5;
 
+    /**
+     * The length of the windows over which the rate of writes to the chunk is measured.
+     */
+    static constexpr Seconds kWriteRateWindow{60};
+
     /**
      * Add more bytes written to the chunk.
      */
-    void addBytesWritten(uint64_t bytesWritten) {
+    void addBytesWritten(uint64_t bytesWritten, Date_t now = Date_t::now()) {
         _bytesWritten.fetchAndAdd(bytesWritten);
+        _addToWriteRateWindow(bytesWritten, now);
     }
 
+    /**
+     * Returns the number of bytes written to the chunk per second over the last complete window of
+     * kWriteRateWindow. Unlike getBytesWritten(), this is not reset by clearBytesWritten().
+     */
+    double getBytesWrittenPerSecond(Date_t now = Date_t::now()) const;
+
     /**
      * Returns the total number of bytes that have been written to the chunk.
      */
@@ -80,12 +94,27 @@ public:
     void releaseSplitLock();
 
 private:
+    /**
+     * Adds the bytes written to the current window, first rolling the current window over to the
+     * previous window if it has ended.
+     */
+    void _addToWriteRateWindow(uint64_t bytesWritten, Date_t now);
+
     /**
      * The number of bytes that have been written to this chunk. May be
      * modified concurrently by several threads.
      */
     AtomicWord<unsigned long long> _bytesWritten{0};
 
+    /**
+     * When the current window started, in milliseconds since the epoch, and the number of bytes
+     * written during the current and the previous windows. Rolling the windows over isn't atomic
+     * with respect to concurrent writers, so a few writes may be counted in the wrong window.
+     */
+    AtomicWord<long long> _windowStartMillis{0};
+    AtomicWord<unsigned long long> _currentWindowBytes{0};
+    AtomicWord<unsigned long long> _previousWindowBytes{0};
+
     /**
      * Protects _splitState when starting a split.
      */
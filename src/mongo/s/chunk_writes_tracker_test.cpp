@@ -64,6 +64,32 @@ TEST(ChunkWritesTrackerTest, ClearBytesWrittenReturnsBytesWrittenBeforeClearing)
     ASSERT_EQ(previousBytesWritten, bytesToAdd);
 }
 
+TEST(ChunkWritesTrackerTest, BytesWrittenPerSecondCoversLastCompleteWindow) {
+    ChunkWritesTracker wt;
+    const auto window = ChunkWritesTracker::kWriteRateWindow;
+    const auto start = Date_t::fromMillisSinceEpoch(1000 * 1000);
+
+    // Nothing is reported until the first window is complete.
+    wt.addBytesWritten(60, start);
+    wt.addBytesWritten(60, start + Seconds(1));
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + Seconds(2)), 0);
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window), 2);
+
+    // Writes in the next window don't change the rate until that window is complete.
+    wt.addBytesWritten(600, start + window);
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window + Seconds(1)), 2);
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window * 2), 10);
+
+    // A window without writes has a rate of zero.
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window * 3), 0);
+    wt.addBytesWritten(60, start + window * 3);
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window * 3 + Seconds(1)), 0);
+
+    // Clearing the bytes written for splitting doesn't affect the rate.
+    wt.clearBytesWritten();
+    ASSERT_EQ(wt.getBytesWrittenPerSecond(start + window * 4), 1);
+}
+
 TEST(ChunkWritesTrackerTest, ShouldSplitReturnsTrueWithBytesWrittenAndMaxChunkSizeZero) {
     ChunkWritesTracker wt;
     wt.addBytesWritten(4ull);
@@ -98,6 +98,11 @@ MultiStatementTransactionRequestsSender::~MultiStatementTransactionRequestsSende
     baton->schedule([ars = std::move(_ars)](Status) mutable { ars.reset(); });
 }
 
+void MultiStatementTransactionRequestsSender::addRequest(
+    const AsyncRequestsSender::Request& request) {
+    _ars->addRequest(attachTxnDetails(_opCtx, {request}).front());
+}
+
 bool MultiStatementTransactionRequestsSender::done() {
     return _ars->done();
 }
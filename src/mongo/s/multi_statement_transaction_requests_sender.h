@@ -57,6 +57,8 @@ public:
 
     ~MultiStatementTransactionRequestsSender();
 
+    void addRequest(const AsyncRequestsSender::Request& request);
+
     bool done();
 
     AsyncRequestsSender::Response next();
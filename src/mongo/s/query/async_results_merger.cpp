@@ -32,6 +32,7 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/s/query/async_results_merger.h"
+#include "mongo/s/query/async_results_merger_params_gen.h"
 
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/client/remote_command_targeter.h"
@@ -361,7 +362,7 @@ StatusWith<ClusterQueryResult> AsyncResultsMerger::nextReady() {
     return _params.getSort() ? _nextReadySorted(lk) : _nextReadyUnsorted(lk);
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock lk) {
     // Tailable non-awaitData cursors cannot have a sort.
     invariant(_tailableMode != TailableModeEnum::kTailable);
 
@@ -377,6 +378,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
 
     ClusterQueryResult front = _remotes[smallestRemote].docBuffer.front();
     _remotes[smallestRemote].docBuffer.pop();
+    _prefetchIfNeeded(lk, smallestRemote);
 
     // Re-populate the merging queue with the next result from 'smallestRemote', if it has a
     // next result.
@@ -395,7 +397,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadySorted(WithLock) {
     return front;
 }
 
-ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
+ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock lk) {
     size_t remotesAttempted = 0;
     while (remotesAttempted < _remotes.size()) {
         // It is illegal to call this method if there is an error received from any shard.
@@ -404,6 +406,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
         if (_remotes[_gettingFromRemote].hasNext()) {
             ClusterQueryResult front = _remotes[_gettingFromRemote].docBuffer.front();
             _remotes[_gettingFromRemote].docBuffer.pop();
+            _prefetchIfNeeded(lk, _gettingFromRemote);
 
             if (_tailableMode == TailableModeEnum::kTailable &&
                 !_remotes[_gettingFromRemote].hasNext()) {
@@ -426,7 +429,7 @@ ClusterQueryResult AsyncResultsMerger::_nextReadyUnsorted(WithLock) {
     return {};
 }
 
-Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
+Status AsyncResultsMerger::_askForNextBatch(WithLock lk, size_t remoteIndex) {
     invariant(_opCtx, "Cannot schedule a getMore without an OperationContext");
     auto& remote = _remotes[remoteIndex];
 
@@ -474,20 +477,56 @@ Status AsyncResultsMerger::_askForNextBatch(WithLock, size_t remoteIndex) {
         remote.getTargetHost(), remote.cursorNss.db().toString(), cmdObj, _opCtx);
     ignoreApiParametersBlock.release();
 
-    auto callbackStatus =
-        _executor->scheduleRemoteCommand(request, [this, remoteIndex](auto const& cbData) {
-            stdx::lock_guard<Latch> lk(this->_mutex);
-            this->_handleBatchResponse(lk, cbData, remoteIndex);
-        });
+    auto callback = [this, remoteIndex](auto const& cbData) {
+        stdx::lock_guard<Latch> lk(this->_mutex);
+        this->_handleBatchResponse(lk, cbData, remoteIndex);
+    };
+
+    const bool exhaust = _shouldStreamExhaust(lk);
+    if (exhaust) {
+        // The stream outlives the getMore of the client which started it, so it must not inherit
+        // that getMore's deadline.
+        request.timeout = executor::RemoteCommandRequest::kNoTimeout;
+    }
+    auto callbackStatus = exhaust ? _executor->scheduleExhaustRemoteCommand(request, callback)
+                                  : _executor->scheduleRemoteCommand(request, callback);
 
     if (!callbackStatus.isOK()) {
         return callbackStatus.getStatus();
     }
 
     remote.cbHandle = callbackStatus.getValue();
+    remote.exhaustStream = exhaust;
     return Status::OK();
 }
 
+bool AsyncResultsMerger::_shouldStreamExhaust(WithLock) const {
+    return internalQueryAsyncResultsMergerExhaust.load() &&
+        _tailableMode == TailableModeEnum::kNormal && !_params.getTxnNumber() && _opCtx &&
+        _opCtx->isExhaust();
+}
+
+bool AsyncResultsMerger::_shouldPrefetch(WithLock, const RemoteCursorData& remote) const {
+    const auto prefetchBatches = internalQueryAsyncResultsMergerPrefetchBatches.load();
+    if (prefetchBatches <= 0 || _tailableMode != TailableModeEnum::kNormal ||
+        _params.getTxnNumber() || _lifecycleState != kAlive || !_opCtx) {
+        return false;
+    }
+
+    if (!remote.status.isOK() || remote.exhausted() || remote.cbHandle.isValid()) {
+        return false;
+    }
+
+    return remote.docBuffer.size() < static_cast<size_t>(prefetchBatches) * remote.lastBatchSize;
+}
+
+void AsyncResultsMerger::_prefetchIfNeeded(WithLock lk, size_t remoteIndex) {
+    auto& remote = _remotes[remoteIndex];
+    if (_shouldPrefetch(lk, remote)) {
+        remote.status = _askForNextBatch(lk, remoteIndex);
+    }
+}
+
 Status AsyncResultsMerger::scheduleGetMores() {
     stdx::lock_guard<Latch> lk(_mutex);
     return _scheduleGetMores(lk);
@@ -502,7 +541,8 @@ Status AsyncResultsMerger::_scheduleGetMores(WithLock lk) {
             return remote.status;
         }
 
-        if (!remote.hasNext() && !remote.exhausted() && !remote.cbHandle.isValid()) {
+        if ((!remote.hasNext() || _shouldPrefetch(lk, remote)) && !remote.exhausted() &&
+            !remote.cbHandle.isValid()) {
             // If this remote is not exhausted and there is no outstanding request for it, schedule
             // work to retrieve the next batch.
             auto nextBatchStatus = _askForNextBatch(lk, i);
@@ -692,8 +732,13 @@ bool AsyncResultsMerger::_checkHighWaterMarkEligibility(WithLock,
 void AsyncResultsMerger::_handleBatchResponse(WithLock lk,
                                               CbData const& cbData,
                                               size_t remoteIndex) {
-    // Got a response from remote, so indicate we are no longer waiting for one.
-    _remotes[remoteIndex].cbHandle = executor::TaskExecutor::CallbackHandle();
+    // Got a response from remote, so indicate we are no longer waiting for one, unless it is
+    // streaming more.
+    auto& remote = _remotes[remoteIndex];
+    if (!remote.exhaustStream || !cbData.response.moreToCome) {
+        remote.cbHandle = executor::TaskExecutor::CallbackHandle();
+        remote.exhaustStream = false;
+    }
 
     //  On shutdown, there is no need to process the response.
     if (_lifecycleState != kAlive) {
@@ -733,10 +778,10 @@ void AsyncResultsMerger::_cleanUpFailedBatch(WithLock lk, Status status, size_t
     // the error to the user. In order to avoid polluting the user's error message, we ignore such
     // errors with the expectation that all outstanding cursors will be closed promptly.
     if (_params.getAllowPartialResults() || remote.status == ErrorCodes::ExchangePassthrough) {
-        // Clear the results buffer and cursor id, and set 'partialResultsReturned' if appropriate.
+        // Clear the cursor id, and set 'partialResultsReturned' if appropriate. The results buffer
+        // is only non-empty if the failed getMore was a prefetch; those results are still returned
+        // since the remote may already be on the merge queue.
         remote.partialResultsReturned = (remote.status != ErrorCodes::ExchangePassthrough);
-        std::queue<ClusterQueryResult> emptyBuffer;
-        std::swap(remote.docBuffer, emptyBuffer);
         remote.status = Status::OK();
         remote.cursorId = 0;
     }
@@ -778,12 +823,15 @@ void AsyncResultsMerger::_processBatchResults(WithLock lk,
     if (_tailableMode == TailableModeEnum::kTailable && !remote.hasNext()) {
         invariant(_remotes.size() == 1);
         _eofNext = true;
-    } else if (!remote.hasNext() && !remote.exhausted() && _lifecycleState == kAlive && _opCtx) {
+    } else if (!remote.hasNext() && !remote.exhausted() && !remote.cbHandle.isValid() &&
+               _lifecycleState == kAlive && _opCtx) {
         // If this is normal or tailable-awaitData cursor and we still don't have anything buffered
         // after receiving this batch, we can schedule work to retrieve the next batch right away.
         // Be careful only to do this when '_opCtx' is non-null, since it is illegal to schedule a
         // remote command on a user's behalf without a non-null OperationContext.
         remote.status = _askForNextBatch(lk, remoteIndex);
+    } else {
+        _prefetchIfNeeded(lk, remoteIndex);
     }
 }
 
@@ -792,6 +840,8 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
                                            const CursorResponse& response) {
     auto& remote = _remotes[remoteIndex];
     _updateRemoteMetadata(lk, remoteIndex, response);
+    const bool hadBufferedResults = remote.hasNext();
+    remote.lastBatchSize = response.getBatch().size();
     for (const auto& obj : response.getBatch()) {
         // If there's a sort, we're expecting the remote node to have given us back a sort key.
         if (_params.getSort()) {
@@ -817,8 +867,8 @@ bool AsyncResultsMerger::_addBatchToBuffer(WithLock lk,
     }
 
     // If we're doing a sorted merge, then we have to make sure to put this remote onto the merge
-    // queue.
-    if (_params.getSort() && !response.getBatch().empty()) {
+    // queue. A remote whose next batch was prefetched is already on it.
+    if (_params.getSort() && !response.getBatch().empty() && !hadBufferedResults) {
         _mergeQueue.push(remoteIndex);
     }
     return true;
@@ -884,9 +934,11 @@ stdx::shared_future<void> AsyncResultsMerger::kill(OperationContext* opCtx) {
         return _killCompleteInfo->getFuture();
     }
 
-    // Cancel all of our callbacks. Once they all complete, the event will be signaled.
+    // Cancel all of our callbacks. Once they all complete, the event will be signaled. An exhaust
+    // stream is not cancelled, since its callback would then never run again: it ends with the
+    // error from the killCursors sent above.
     for (const auto& remote : _remotes) {
-        if (remote.cbHandle.isValid()) {
+        if (remote.cbHandle.isValid() && !remote.exhaustStream) {
             _executor->cancel(remote.cbHandle);
         }
     }
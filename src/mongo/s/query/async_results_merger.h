@@ -309,6 +309,10 @@ private:
         // Is valid if there is currently a pending request to this remote.
         executor::TaskExecutor::CallbackHandle cbHandle;
 
+        // Set if the pending request is an exhaust getMore, which the remote keeps answering with
+        // batches until its cursor is exhausted or fails.
+        bool exhaustStream = false;
+
         // Set to an error status if there is an error retrieving a response from this remote or if
         // the command result contained an error.
         Status status = Status::OK();
@@ -317,6 +321,9 @@ private:
         // batchSize in getMore when mongod returned less docs than the requested batchSize.
         long long fetchedCount = 0;
 
+        // Number of documents in the last batch received from this remote.
+        size_t lastBatchSize = 0;
+
         // If set to 'true', the cursor on this shard has been invalidated.
         bool invalidated = false;
     };
@@ -373,6 +380,25 @@ private:
      */
     Status _askForNextBatch(WithLock, size_t remoteIndex);
 
+    /**
+     * Returns true if the next batch should be requested with an exhaust getMore, so that the
+     * remote streams its batches without waiting for a getMore for each, see
+     * internalQueryAsyncResultsMergerExhaust.
+     */
+    bool _shouldStreamExhaust(WithLock) const;
+
+    /**
+     * Returns true if the next batch for the given remote should be requested even though there
+     * are still buffered results for it, see internalQueryAsyncResultsMergerPrefetchBatches.
+     */
+    bool _shouldPrefetch(WithLock, const RemoteCursorData& remote) const;
+
+    /**
+     * Requests the next batch for the given remote if _shouldPrefetch() says so. A failure to
+     * schedule the request is recorded in the remote's status.
+     */
+    void _prefetchIfNeeded(WithLock, size_t remoteIndex);
+
     /**
      * Checks whether or not the remote cursors are all exhausted.
      */
@@ -41,9 +41,11 @@
 #include "mongo/executor/task_executor.h"
 #include "mongo/s/catalog/type_shard.h"
 #include "mongo/s/client/shard_registry.h"
+#include "mongo/s/query/async_results_merger_params_gen.h"
 #include "mongo/s/query/results_merger_test_fixture.h"
 #include "mongo/unittest/death_test.h"
 #include "mongo/unittest/unittest.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
@@ -156,6 +158,83 @@ TEST_F(AsyncResultsMergerTest, SingleShardSorted) {
     ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
 }
 
+TEST_F(AsyncResultsMergerTest, SingleShardSortedPrefetchesNextBatch) {
+    internalQueryAsyncResultsMergerPrefetchBatches.store(1);
+    ON_BLOCK_EXIT([] { internalQueryAsyncResultsMergerPrefetchBatches.store(0); });
+
+    BSONObj findCmd = fromjson("{find: 'testcoll', sort: {_id: 1}}");
+    std::vector<RemoteCursor> cursors;
+    std::vector<BSONObj> firstBatch = {fromjson("{$sortKey: [1]}"), fromjson("{$sortKey: [2]}")};
+    cursors.push_back(makeRemoteCursor(
+        kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, firstBatch)));
+    auto arm = makeARMFromExistingCursors(std::move(cursors), findCmd);
+
+    // Nothing is requested while the whole first batch is still buffered.
+    ASSERT_TRUE(arm->ready());
+    ASSERT_FALSE(networkHasReadyRequests());
+
+    // Consuming a result leaves less than a batch buffered, so the next batch is requested even
+    // though there are still results to return.
+    ASSERT_BSONOBJ_EQ(fromjson("{$sortKey: [1]}"),
+                      *unittest::assertGet(arm->nextReady()).getResult());
+    ASSERT_TRUE(networkHasReadyRequests());
+    ASSERT_TRUE(arm->ready());
+
+    std::vector<CursorResponse> responses;
+    std::vector<BSONObj> batch = {fromjson("{$sortKey: [3]}"), fromjson("{$sortKey: [4]}")};
+    responses.emplace_back(kTestNss, CursorId(0), batch);
+    scheduleNetworkResponses(std::move(responses));
+
+    // The prefetched batch is merged behind the results that were already buffered.
+    for (int i = 2; i <= 4; ++i) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("$sortKey" << BSON_ARRAY(i)),
+                          *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+}
+
+TEST_F(AsyncResultsMergerTest, ExhaustGetMoreStreamsBatchesFromOneRequest) {
+    internalQueryAsyncResultsMergerExhaust.store(true);
+    ON_BLOCK_EXIT([] { internalQueryAsyncResultsMergerExhaust.store(false); });
+    operationContext()->setExhaust(true);
+
+    std::vector<RemoteCursor> cursors;
+    cursors.push_back(
+        makeRemoteCursor(kTestShardIds[0], kTestShardHosts[0], CursorResponse(kTestNss, 5, {})));
+    auto arm = makeARMFromExistingCursors(std::move(cursors));
+    auto readyEvent = unittest::assertGet(arm->nextEvent());
+
+    // The shard answers the one exhaust getMore with a batch at a time until its cursor is
+    // exhausted.
+    {
+        executor::NetworkInterfaceMock::InNetworkGuard guard(network());
+        auto noi = guard->getNextReadyRequest();
+        for (CursorId cursorId : {CursorId(5), CursorId(5), CursorId(0)}) {
+            std::vector<BSONObj> batch = {BSON("_id" << cursorId)};
+            auto response =
+                CursorResponse(kTestNss, cursorId, batch)
+                    .toBSON(CursorResponse::ResponseType::SubsequentResponse);
+            guard->scheduleResponse(
+                noi,
+                guard->now(),
+                executor::RemoteCommandResponse(response, Milliseconds(0), cursorId != 0));
+        }
+        guard->runReadyNetworkOperations();
+        ASSERT_FALSE(guard->hasReadyRequests());
+    }
+
+    executor()->waitForEvent(readyEvent);
+    for (int id : {5, 5, 0}) {
+        ASSERT_TRUE(arm->ready());
+        ASSERT_BSONOBJ_EQ(BSON("_id" << id), *unittest::assertGet(arm->nextReady()).getResult());
+    }
+    ASSERT_TRUE(arm->ready());
+    ASSERT_TRUE(unittest::assertGet(arm->nextReady()).isEOF());
+    ASSERT_FALSE(networkHasReadyRequests());
+}
+
 TEST_F(AsyncResultsMergerTest, MultiShardUnsorted) {
     std::vector<RemoteCursor> cursors;
     cursors.push_back(
@@ -62,19 +62,6 @@ Status cursorInUseStatus(const NamespaceString& nss, CursorId cursorId) {
                           << "', id: " << cursorId << ")."};
 }
 
-//
-// CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  The below helpers
-// convert between a CursorId and its prefix/suffix.
-//
-
-CursorId createCursorId(uint32_t prefix, uint32_t suffix) {
-    return (static_cast<uint64_t>(prefix) << 32) | suffix;
-}
-
-uint32_t extractPrefixFromCursorId(CursorId cursorId) {
-    return static_cast<uint64_t>(cursorId) >> 32;
-}
-
 }  // namespace
 
 ClusterCursorManager::PinnedCursor::PinnedCursor(ClusterCursorManager* manager,
@@ -155,14 +142,13 @@ ClusterCursorManager::ClusterCursorManager(ClockSource* clockSource)
 }
 
 ClusterCursorManager::~ClusterCursorManager() {
-    invariant(_cursorIdPrefixToNamespaceMap.empty());
-    invariant(_namespaceToContainerMap.empty());
+    invariant(_cursorEntryMap.empty());
 }
 
 void ClusterCursorManager::shutdown(OperationContext* opCtx) {
     {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _inShutdown = true;
+        stdx::lock_guard<Latch> lk(_registrationMutex);
+        _inShutdown.store(true);
     }
     killAllCursors(opCtx);
 }
@@ -177,10 +163,9 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     // Read the clock out of the lock.
     const auto now = _clockSource->now();
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kRegisterAttempt, boost::none, now, nss});
+    stdx::unique_lock<Latch> lk(_registrationMutex);
 
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         lk.unlock();
         cursor->kill(opCtx);
         return Status(ErrorCodes::ShutdownInProgress,
@@ -190,54 +175,35 @@ StatusWith<CursorId> ClusterCursorManager::registerCursor(
     invariant(cursor);
     cursor->setLeftoverMaxTimeMicros(opCtx->getRemainingMaxTimeMicros());
 
-    // Find the CursorEntryContainer for this namespace.  If none exists, create one.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        uint32_t containerPrefix = 0;
-        do {
-            // The server has always generated positive values for CursorId (which is a signed
-            // type), so we use std::abs() here on the prefix for consistency with this historical
-            // behavior. If the random number generated is INT_MIN, calling std::abs on it is
-            // undefined behavior on 2's complement systems so we need to generate a new number.
-            int32_t randomNumber = 0;
-            do {
-                randomNumber = _pseudoRandom.nextInt32();
-            } while (randomNumber == std::numeric_limits<int32_t>::min());
-            containerPrefix = static_cast<uint32_t>(std::abs(randomNumber));
-        } while (_cursorIdPrefixToNamespaceMap.count(containerPrefix) > 0);
-        _cursorIdPrefixToNamespaceMap[containerPrefix] = nss;
-
-        auto emplaceResult =
-            _namespaceToContainerMap.emplace(nss, CursorEntryContainer(containerPrefix));
-        invariant(emplaceResult.second);
-        invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
+    // Generate a CursorId (which can't be the invalid value zero). The server has always generated
+    // positive values for CursorId (which is a signed type), so we use std::abs() here for
+    // consistency with this historical behavior. If the random number generated is the minimum
+    // representable negative number, calling std::abs on it is undefined behavior on 2's
+    // complement systems so we need to generate a new number.
+    while (true) {
+        CursorId cursorId = _pseudoRandom.nextInt64();
+        if (cursorId == 0 || cursorId == std::numeric_limits<CursorId>::min()) {
+            continue;
+        }
+        cursorId = std::abs(cursorId);
 
-        nsToContainerIt = emplaceResult.first;
-    } else {
-        invariant(!nsToContainerIt->second.entryMap.empty());  // If exists, shouldn't be empty.
+        auto partition = _cursorEntryMap.lockOnePartition(cursorId);
+        if (partition->count(cursorId) > 0) {
+            continue;
+        }
+
+        // Create a new CursorEntry and register it in the cursor's partition.
+        auto emplaceResult = partition->emplace(cursorId,
+                                                CursorEntry(std::move(cursor),
+                                                            nss,
+                                                            cursorType,
+                                                            cursorLifetime,
+                                                            now,
+                                                            authenticatedUsers,
+                                                            opCtx->getOperationKey()));
+        invariant(emplaceResult.second);
+        return cursorId;
     }
-    CursorEntryContainer& container = nsToContainerIt->second;
-
-    // Generate a CursorId (which can't be the invalid value zero).
-    CursorEntryMap& entryMap = container.entryMap;
-    CursorId cursorId = 0;
-    do {
-        const uint32_t cursorSuffix = static_cast<uint32_t>(_pseudoRandom.nextInt32());
-        cursorId = createCursorId(container.containerPrefix, cursorSuffix);
-    } while (cursorId == 0 || entryMap.count(cursorId) > 0);
-
-    // Create a new CursorEntry and register it in the CursorEntryContainer's map.
-    auto emplaceResult = entryMap.emplace(cursorId,
-                                          CursorEntry(std::move(cursor),
-                                                      cursorType,
-                                                      cursorLifetime,
-                                                      now,
-                                                      authenticatedUsers,
-                                                      opCtx->getOperationKey()));
-    invariant(emplaceResult.second);
-    _log.push({LogEvent::Type::kRegisterComplete, cursorId, now, nss});
-
-    return cursorId;
 }
 
 StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCursor(
@@ -246,17 +212,14 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     OperationContext* opCtx,
     AuthzCheckFn authChecker,
     AuthCheck checkSessionAuth) {
-    const auto now = _clockSource->now();
-
-    stdx::lock_guard<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckoutAttempt, cursorId, now, nss});
-
-    if (_inShutdown) {
+    if (_inShutdown.load()) {
         return Status(ErrorCodes::ShutdownInProgress,
                       "Cannot check out cursor as we are in the process of shutting down");
     }
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntryMap.lockOnePartition(cursorId);
+
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -293,7 +256,6 @@ StatusWith<ClusterCursorManager::PinnedCursor> ClusterCursorManager::checkOutCur
     }
     cursorGuard->reattachToOperationContext(opCtx);
 
-    _log.push({LogEvent::Type::kCheckoutComplete, cursorId, now, nss});
     return PinnedCursor(this, std::move(cursorGuard), nss, cursorId);
 }
 
@@ -311,10 +273,9 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     cursor->detachFromOperationContext();
     cursor->setLastUseDate(now);
 
-    stdx::unique_lock<Latch> lk(_mutex);
-    _log.push({LogEvent::Type::kCheckInAttempt, cursorId, now, nss});
+    auto partition = _cursorEntryMap.lockOnePartition(cursorId);
 
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     invariant(entry);
 
     // killPending will be true if killCursor() was called while the cursor was in use.
@@ -324,22 +285,21 @@ void ClusterCursorManager::checkInCursor(std::unique_ptr<ClusterClientCursor> cu
     entry->returnCursor(std::move(cursor));
 
     if (cursorState == CursorState::NotExhausted && !killPending) {
-        _log.push({LogEvent::Type::kCheckInCompleteCursorSaved, cursorId, now, nss});
         // The caller may need the cursor again.
         return;
     }
 
     // After detaching the cursor, the entry will be destroyed.
     entry = nullptr;
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(partition), opCtx, nss, cursorId);
 }
 
 Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
                                                      const NamespaceString& nss,
                                                      CursorId cursorId,
                                                      AuthzCheckFn authChecker) {
-    stdx::lock_guard<Latch> lk(_mutex);
-    auto entry = _getEntry(lk, nss, cursorId);
+    auto partition = _cursorEntryMap.lockOnePartition(cursorId);
+    auto entry = _getEntry(partition, nss, cursorId);
 
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
@@ -350,7 +310,7 @@ Status ClusterCursorManager::checkAuthForKillCursors(OperationContext* opCtx,
     return authChecker(entry->getAuthenticatedUsers());
 }
 
-void ClusterCursorManager::killOperationUsingCursor(WithLock, CursorEntry* entry) {
+void ClusterCursorManager::killOperationUsingCursor(CursorEntry* entry) {
     invariant(entry->getOperationUsingCursor());
     // Interrupt any operation currently using the cursor.
     OperationContext* opUsingCursor = entry->getOperationUsingCursor();
@@ -366,12 +326,9 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
                                         CursorId cursorId) {
     invariant(opCtx);
 
-    const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
+    auto partition = _cursorEntryMap.lockOnePartition(cursorId);
 
-    _log.push({LogEvent::Type::kKillCursorAttempt, cursorId, now, nss});
-
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -381,35 +338,34 @@ Status ClusterCursorManager::killCursor(OperationContext* opCtx,
     if (opUsingCursor) {
         // The caller shouldn't need to call killCursor on their own cursor.
         invariant(opUsingCursor != opCtx, "Cannot call killCursor() on your own cursor");
-        killOperationUsingCursor(lk, entry);
+        killOperationUsingCursor(entry);
         return Status::OK();
     }
 
     // No one is using the cursor, so we destroy it.
-    detachAndKillCursor(std::move(lk), opCtx, nss, cursorId);
+    detachAndKillCursor(std::move(partition), opCtx, nss, cursorId);
 
     // We no longer hold the lock here.
 
     return Status::OK();
 }
 
-void ClusterCursorManager::detachAndKillCursor(stdx::unique_lock<Latch> lk,
+void ClusterCursorManager::detachAndKillCursor(CursorEntryPartition&& partition,
                                                OperationContext* opCtx,
                                                const NamespaceString& nss,
                                                CursorId cursorId) {
-    auto detachedCursorGuard = _detachCursor(lk, opCtx, nss, cursorId);
+    auto detachedCursorGuard = [&] {
+        auto lockWithRestrictedScope = std::move(partition);
+        return _detachCursor(lockWithRestrictedScope, opCtx, nss, cursorId);
+    }();
     invariant(detachedCursorGuard.getStatus());
 
     // Deletion of the cursor can happen out of the lock.
-    lk.unlock();
     detachedCursorGuard.getValue()->kill(opCtx);
 }
 
 std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContext* opCtx,
                                                                  Date_t cutoff) {
-    const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
-
     auto pred = [cutoff](CursorId cursorId, const CursorEntry& entry) -> bool {
         bool res = entry.getLifetimeType() == CursorLifetime::Mortal && !entry.getLsid() &&
             !entry.getOperationUsingCursor() && entry.getLastActive() <= cutoff;
@@ -424,35 +380,26 @@ std::size_t ClusterCursorManager::killMortalCursorsInactiveSince(OperationContex
         return res;
     };
 
-    return killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    return killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 void ClusterCursorManager::killAllCursors(OperationContext* opCtx) {
-    const auto now = _clockSource->now();
-    stdx::unique_lock<Latch> lk(_mutex);
     auto pred = [](CursorId, const CursorEntry&) -> bool { return true; };
 
-    killCursorsSatisfying(std::move(lk), opCtx, std::move(pred), now);
+    killCursorsSatisfying(opCtx, std::move(pred));
 }
 
 std::size_t ClusterCursorManager::killCursorsSatisfying(
-    stdx::unique_lock<Latch> lk,
-    OperationContext* opCtx,
-    std::function<bool(CursorId, const CursorEntry&)> pred,
-    Date_t now) {
+    OperationContext* opCtx, std::function<bool(CursorId, const CursorEntry&)> pred) {
     invariant(opCtx);
-    invariant(lk.owns_lock());
     std::size_t nKilled = 0;
 
-    _log.push(
-        {LogEvent::Type::kRemoveCursorsSatisfyingPredicateAttempt, boost::none, now, boost::none});
-
     std::vector<ClusterClientCursorGuard> cursorsToDestroy;
-    auto nsContainerIt = _namespaceToContainerMap.begin();
-    while (nsContainerIt != _namespaceToContainerMap.end()) {
-        auto&& entryMap = nsContainerIt->second.entryMap;
-        auto cursorIdEntryIt = entryMap.begin();
-        while (cursorIdEntryIt != entryMap.end()) {
+    for (std::size_t partitionId = 0; partitionId < kNumPartitions; ++partitionId) {
+        auto partition = _cursorEntryMap.lockOnePartitionById(partitionId);
+
+        auto cursorIdEntryIt = partition->begin();
+        while (cursorIdEntryIt != partition->end()) {
             auto cursorId = cursorIdEntryIt->first;
             auto& entry = cursorIdEntryIt->second;
 
@@ -465,44 +412,20 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
 
             if (entry.getOperationUsingCursor()) {
                 // Mark the OperationContext using the cursor as killed, and move on.
-                killOperationUsingCursor(lk, &entry);
+                killOperationUsingCursor(&entry);
                 ++cursorIdEntryIt;
                 continue;
             }
 
-            _log.push({LogEvent::Type::kCursorMarkedForDeletionBySatisfyingPredicate,
-                       cursorId,
-                       // While we collected 'now' above, we ran caller-provided predicates which
-                       // may have been expensive. To avoid re-reading from the clock while the
-                       // lock is held, we do not provide a value for 'now' in this log entry.
-                       boost::none,
-                       nsContainerIt->first});
-
             cursorsToDestroy.push_back(entry.releaseCursor(opCtx));
 
             // Destroy the entry and set the iterator to the next element.
-            entryMap.erase(cursorIdEntryIt++);
-        }
-
-        if (entryMap.empty()) {
-            nsContainerIt = eraseContainer(nsContainerIt);
-        } else {
-            ++nsContainerIt;
+            partition->erase(cursorIdEntryIt++);
         }
     }
 
-    _log.push({LogEvent::Type::kRemoveCursorsSatisfyingPredicateComplete,
-               boost::none,
-               // While we collected 'now' above, we ran caller-provided predicates which may have
-               // been expensive. To avoid re-reading from the clock while the lock is held, we do
-               // not provide a value for 'now' in this log entry.
-               boost::none,
-               boost::none});
-
     // Ensure cursors are killed outside the lock, as killing may require waiting for callbacks to
     // finish.
-    lk.unlock();
-
     for (auto&& cursorGuard : cursorsToDestroy) {
         invariant(cursorGuard);
         cursorGuard->kill(opCtx);
@@ -512,12 +435,12 @@ std::size_t ClusterCursorManager::killCursorsSatisfying(
 }
 
 ClusterCursorManager::Stats ClusterCursorManager::stats() const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto allPartitions = _cursorEntryMap.lockAllPartitions();
 
     Stats stats;
 
-    for (auto& nsContainerPair : _namespaceToContainerMap) {
-        for (auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (auto&& partition : allPartitions) {
+        for (auto& cursorIdEntryPair : partition) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -545,10 +468,10 @@ ClusterCursorManager::Stats ClusterCursorManager::stats() const {
 }
 
 void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto allPartitions = _cursorEntryMap.lockAllPartitions();
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (auto&& partition : allPartitions) {
+        for (const auto& cursorIdEntryPair : partition) {
             const CursorEntry& entry = cursorIdEntryPair.second;
 
             if (entry.isKillPending()) {
@@ -564,12 +487,11 @@ void ClusterCursorManager::appendActiveSessions(LogicalSessionIdSet* lsids) cons
     }
 }
 
-GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(
-    CursorId cursorId, const NamespaceString& ns) const {
+GenericCursor ClusterCursorManager::CursorEntry::cursorToGenericCursor(CursorId cursorId) const {
     invariant(_cursor);
     GenericCursor gc;
     gc.setCursorId(cursorId);
-    gc.setNs(ns);
+    gc.setNs(_nss);
     gc.setCreatedDate(_cursor->getCreatedDate());
     gc.setLastAccessDate(_cursor->getLastUseDate());
     gc.setLsid(_cursor->getLsid());
@@ -586,12 +508,12 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
     const OperationContext* opCtx, MongoProcessInterface::CurrentOpUserMode userMode) const {
     std::vector<GenericCursor> cursors;
 
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto allPartitions = _cursorEntryMap.lockAllPartitions();
 
     AuthorizationSession* ctxAuth = AuthorizationSession::get(opCtx->getClient());
 
-    for (const auto& nsContainerPair : _namespaceToContainerMap) {
-        for (const auto& cursorIdEntryPair : nsContainerPair.second.entryMap) {
+    for (auto&& partition : allPartitions) {
+        for (const auto& cursorIdEntryPair : partition) {
 
             const CursorEntry& entry = cursorIdEntryPair.second;
             // If auth is enabled, and userMode is allUsers, check if the current user has
@@ -606,8 +528,7 @@ std::vector<GenericCursor> ClusterCursorManager::getIdleCursors(
                 continue;
             }
 
-            cursors.emplace_back(
-                entry.cursorToGenericCursor(cursorIdEntryPair.first, nsContainerPair.first));
+            cursors.emplace_back(entry.cursorToGenericCursor(cursorIdEntryPair.first));
         }
     }
 
@@ -635,12 +556,12 @@ std::pair<Status, int> ClusterCursorManager::killCursorsWithMatchingSessions(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
     LogicalSessionId lsid) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto allPartitions = _cursorEntryMap.lockAllPartitions();
 
     stdx::unordered_set<CursorId> cursorIds;
 
-    for (auto&& nsContainerPair : _namespaceToContainerMap) {
-        for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+    for (auto&& partition : allPartitions) {
+        for (auto&& [cursorId, entry] : partition) {
             if (entry.isKillPending()) {
                 // Don't include sessions for killed cursors.
                 continue;
@@ -658,7 +579,7 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForSession(
 
 stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     std::vector<OperationKey> opKeys) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto allPartitions = _cursorEntryMap.lockAllPartitions();
 
     stdx::unordered_set<CursorId> cursorIds;
 
@@ -666,8 +587,8 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
     // this approach was chosen given that 1) mongos will not have as many open cursors as a shard
     // and 2) mongos performance has historically not been a bottleneck.
     for (auto&& opKey : opKeys) {
-        for (auto&& nsContainerPair : _namespaceToContainerMap) {
-            for (auto&& [cursorId, entry] : nsContainerPair.second.entryMap) {
+        for (auto&& partition : allPartitions) {
+            for (auto&& [cursorId, entry] : partition) {
                 if (entry.isKillPending()) {
                     // Don't include any killed cursors.
                     continue;
@@ -685,71 +606,32 @@ stdx::unordered_set<CursorId> ClusterCursorManager::getCursorsForOpKeys(
 
 boost::optional<NamespaceString> ClusterCursorManager::getNamespaceForCursorId(
     CursorId cursorId) const {
-    stdx::lock_guard<Latch> lk(_mutex);
+    auto partition = _cursorEntryMap.lockOnePartition(cursorId);
 
-    const auto it = _cursorIdPrefixToNamespaceMap.find(extractPrefixFromCursorId(cursorId));
-    if (it == _cursorIdPrefixToNamespaceMap.end()) {
+    const auto it = partition->find(cursorId);
+    if (it == partition->end()) {
         return boost::none;
     }
-    return it->second;
+    return it->second.getNamespace();
 }
 
-auto ClusterCursorManager::_getEntry(WithLock, NamespaceString const& nss, CursorId cursorId)
-    -> CursorEntry* {
-
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    if (nsToContainerIt == _namespaceToContainerMap.end()) {
-        return nullptr;
-    }
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    auto entryMapIt = entryMap.find(cursorId);
-    if (entryMapIt == entryMap.end()) {
+auto ClusterCursorManager::_getEntry(const CursorEntryPartition& partition,
+                                     NamespaceString const& nss,
+                                     CursorId cursorId) -> CursorEntry* {
+    auto entryMapIt = partition->find(cursorId);
+    if (entryMapIt == partition->end() || entryMapIt->second.getNamespace() != nss) {
         return nullptr;
     }
 
     return &entryMapIt->second;
 }
 
-auto ClusterCursorManager::eraseContainer(NssToCursorContainerMap::iterator it)
-    -> NssToCursorContainerMap::iterator {
-    auto&& container = it->second;
-    auto&& entryMap = container.entryMap;
-    invariant(entryMap.empty());
-
-    // This was the last cursor remaining in the given namespace.  Erase all state associated
-    // with this namespace.
-    size_t numDeleted = _cursorIdPrefixToNamespaceMap.erase(container.containerPrefix);
-    if (numDeleted != 1) {
-        LOGV2_ERROR(
-            4786901,
-            "Error attempting to erase CursorEntryContainer for nss {nss} and containerPrefix"
-            "{prefix}. Could not find containerPrefix in map from cursor ID prefix to nss. "
-            "Expected 'numDeleted' to be 1, but got {actualNumDeleted}",
-            "Error attempting to erase CursorEntryContainer. Could not find containerPrefix in map "
-            "from cursor id prefix to namespace string.",
-            "nss"_attr = it->first,
-            "prefix"_attr = container.containerPrefix,
-            "actualNumDeleted"_attr = numDeleted);
-        logCursorManagerInfo();
-        MONGO_UNREACHABLE;
-    }
-    const auto nssRemoved = it->first;
-    _namespaceToContainerMap.erase(it++);
-    _log.push({LogEvent::Type::kNamespaceEntryMapErased,
-               boost::none,
-               boost::none,
-               std::move(nssRemoved)});
-
-    invariant(_namespaceToContainerMap.size() == _cursorIdPrefixToNamespaceMap.size());
-    return it;
-}
-
-StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLock lk,
-                                                                         OperationContext* opCtx,
-                                                                         const NamespaceString& nss,
-                                                                         CursorId cursorId) {
-    _log.push({LogEvent::Type::kDetachAttempt, cursorId, boost::none, nss});
-    CursorEntry* entry = _getEntry(lk, nss, cursorId);
+StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(
+    const CursorEntryPartition& partition,
+    OperationContext* opCtx,
+    const NamespaceString& nss,
+    CursorId cursorId) {
+    CursorEntry* entry = _getEntry(partition, nss, cursorId);
     if (!entry) {
         return cursorNotFoundStatus(nss, cursorId);
     }
@@ -762,116 +644,10 @@ StatusWith<ClusterClientCursorGuard> ClusterCursorManager::_detachCursor(WithLoc
     ClusterClientCursorGuard cursor = entry->releaseCursor(opCtx);
 
     // Destroy the entry.
-    auto nsToContainerIt = _namespaceToContainerMap.find(nss);
-    invariant(nsToContainerIt != _namespaceToContainerMap.end());
-    CursorEntryMap& entryMap = nsToContainerIt->second.entryMap;
-    size_t eraseResult = entryMap.erase(cursorId);
+    size_t eraseResult = partition->erase(cursorId);
     invariant(1 == eraseResult);
-    if (entryMap.empty()) {
-        eraseContainer(nsToContainerIt);
-    }
-
-    _log.push({LogEvent::Type::kDetachComplete, cursorId, boost::none, nss});
 
     return std::move(cursor);
 }
 
-void ClusterCursorManager::logCursorManagerInfo() const {
-    LOGV2_ERROR_OPTIONS(4786900,
-                        logv2::LogTruncation::Disabled,
-                        "Dumping cursor manager contents. "
-                        "NSS -> Container map: {nssToContainer} "
-                        "Cursor ID Prefix -> NSS map: {cursorIdToNss} "
-                        "Internal log: {internalLog}",
-                        "Dumping cursor manager contents.",
-                        "{nssToContainer}"_attr = dumpNssToContainerMap(),
-                        "{cursorIdToNss}"_attr = dumpCursorIdToNssMap(),
-                        "{internalLog}"_attr = dumpInternalLog());
-}
-
-std::string ClusterCursorManager::LogEvent::typeToString(ClusterCursorManager::LogEvent::Type t) {
-    const static stdx::unordered_map<LogEvent::Type, std::string> kMap = {
-        {Type::kRegisterAttempt, "registerAttempt"},
-        {Type::kRegisterComplete, "registerComplete"},
-        {Type::kCheckoutAttempt, "checkoutAttempt"},
-        {Type::kCheckoutComplete, "checkoutComplete"},
-        {Type::kCheckInAttempt, "checkInAttempt"},
-        {Type::kCheckInCompleteCursorSaved, "checkInCompleteCursorSaved"},
-        {Type::kDetachAttempt, "detachAttempt"},
-        {Type::kDetachComplete, "detachComplete"},
-        {Type::kNamespaceEntryMapErased, "namespaceEntryMapErased"},
-        {Type::kRemoveCursorsSatisfyingPredicateAttempt, "killCursorsSatisfyingPredicateAttempt"},
-        {Type::kRemoveCursorsSatisfyingPredicateComplete, "killCursorsSatisfyingPredicateComplete"},
-        {Type::kKillCursorAttempt, "killCursorAttempt"},
-    };
-
-    if (auto it = kMap.find(t); it != kMap.end()) {
-        return it->second;
-    }
-    return "unknown " + std::to_string(static_cast<int>(t));
-}
-
-BSONObj ClusterCursorManager::dumpNssToContainerMap() const {
-    BSONObjBuilder bob;
-    // Record an object for the NSS -> Container map.
-    {
-        BSONObjBuilder nssToContainer(bob.subobjStart("nssToContainer"));
-        for (auto&& [nss, cursorContainer] : _namespaceToContainerMap) {
-            BSONObjBuilder nssBob(nssToContainer.subobjStart(nss.toString()));
-            nssBob.appendNumber("containerPrefix",
-                                static_cast<long long>(cursorContainer.containerPrefix));
-            BSONArrayBuilder cursors(nssBob.subarrayStart("cursors"));
-            for (auto&& [cursorId, cursorEntry] : cursorContainer.entryMap) {
-                BSONObjBuilder cursorBob(cursors.subobjStart());
-                cursorBob.appendNumber("id", cursorId);
-                cursorBob.append("lastActive", cursorEntry.getLastActive());
-            }
-        }
-    }
-    return bob.obj();
-}
-
-BSONObj ClusterCursorManager::dumpCursorIdToNssMap() const {
-    BSONObjBuilder bob;
-
-    // Record an array for the Cursor ID Prefix -> NSS map.
-    {
-        BSONArrayBuilder cursorIdPrefixToNss(bob.subarrayStart("cursorIdPrefixToNss"));
-        for (auto&& [cursorIdPrefix, nss] : _cursorIdPrefixToNamespaceMap) {
-            BSONObjBuilder bob(cursorIdPrefixToNss.subobjStart());
-            bob.appendNumber("cursorIdPrefix", static_cast<long long>(cursorIdPrefix));
-            bob.append("nss", nss.toString());
-        }
-    }
-
-    return bob.obj();
-}
-
-BSONObj ClusterCursorManager::dumpInternalLog() const {
-    BSONObjBuilder bob;
-    // Dump the internal log maintained by the ClusterCursorManager.
-    {
-        BSONArrayBuilder logBuilder(bob.subarrayStart("log"));
-        size_t i = _log.start;
-        while (i != _log.end) {
-            BSONObjBuilder bob(logBuilder.subobjStart());
-            const auto& logEntry = _log.events[i];
-            if (logEntry.cursorId) {
-                bob.appendNumber("cursorId", *logEntry.cursorId);
-            }
-            bob.append("type", LogEvent::typeToString(logEntry.type));
-
-            if (logEntry.time) {
-                bob.append("approxTime", *logEntry.time);
-            }
-
-            if (logEntry.nss) {
-                bob.append("nss", logEntry.nss->toString());
-            }
-
-            i = (i + 1) % _log.events.size();
-        }
-    }
-    return bob.obj();
-}
 }  // namespace mongo
@@ -33,18 +33,19 @@
 #include <utility>
 #include <vector>
 
+#include "mongo/db/catalog/util/partitioned.h"
 #include "mongo/db/cursor_id.h"
 #include "mongo/db/generic_cursor.h"
 #include "mongo/db/kill_sessions.h"
 #include "mongo/db/namespace_string.h"
 #include "mongo/db/session_killer.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/platform/random.h"
 #include "mongo/s/query/cluster_client_cursor.h"
 #include "mongo/s/query/cluster_client_cursor_guard.h"
 #include "mongo/s/query/cluster_client_cursor_params.h"
 #include "mongo/stdx/unordered_map.h"
-#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
@@ -366,10 +367,8 @@ public:
     stdx::unordered_set<CursorId> getCursorsForOpKeys(std::vector<OperationKey>) const;
 
     /**
-     * Returns the namespace associated with the given cursor id, by examining the 'namespace
-     * prefix' portion of the cursor id.  A cursor with the given cursor id need not actually exist.
-     * If no such namespace is associated with the 'namespace prefix' portion of the cursor id,
-     * returns boost::none.
+     * Returns the namespace of the cursor with the given cursor id, or boost::none if no such
+     * cursor is registered.
      *
      * This method is deprecated.  Use only when a cursor needs to be operated on in cases where a
      * namespace is not available (e.g. OP_KILL_CURSORS).
@@ -387,140 +386,7 @@ public:
     }
 
 private:
-    class CursorEntry;
-    struct CursorEntryContainer;
-    using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
-    using NssToCursorContainerMap = stdx::unordered_map<NamespaceString, CursorEntryContainer>;
-
-    // Internal, fixed size log of events cursor manager. This has been added to help diagnose
-    // SERVER-27796.
-    struct LogEvent {
-        enum class Type {
-            kRegisterAttempt,   // Any attempt to create a cursor.
-            kRegisterComplete,  // A cursor actually being created.
-
-            // Checking out a cursor.
-            kCheckoutAttempt,
-            kCheckoutComplete,
-
-            // Caller attempts to check a cursor in. This event may be followed by a
-            // kCheckInCompleteCursorSaved, or by events which indicate the cursor is deleted.
-            kCheckInAttempt,
-
-            // Logged when the check-in is successful and the cursor is kept.
-            kCheckInCompleteCursorSaved,
-
-            // Detaching a cursor (and erasing associated namespace).
-            kDetachAttempt,
-            kDetachComplete,
-            kNamespaceEntryMapErased,
-
-            // These mark the beginning and end of the period where
-            // killCursorsSatisfyingPredicate() holds a lock.
-            kRemoveCursorsSatisfyingPredicateAttempt,
-            kRemoveCursorsSatisfyingPredicateComplete,
-
-            // Any call to killCursor().
-            kKillCursorAttempt,
-
-            // Represents each time killCursorsSatisfyingPredicate() detaches a cursor that it
-            // intends to destroy.
-            kCursorMarkedForDeletionBySatisfyingPredicate,
-
-            //
-            // NOTE: If you ever add to this enum be sure to update the typeToString() method
-            // below.
-            //
-        };
-
-        static std::string typeToString(Type);
-
-        Type type;
-
-        // boost::none for log entries that don't have an associated cursor ID.
-        boost::optional<CursorId> cursorId;
-
-        // Time is not always provided to avoid having to read the clock while the mutex is held.
-        boost::optional<Date_t> time;
-        boost::optional<NamespaceString> nss;
-    };
-
-    // Circular queue used to store the latest events that happened in the ClusterCursorManager.
-    struct CircularLogQueue {
-        std::vector<LogEvent> events{512};
-        size_t start = 0;
-        size_t end = 0;
-
-        void push(LogEvent&& e) {
-            events[end] = std::move(e);
-            end = (end + 1) % events.size();
-            if (end == start) {
-                start = (start + 1) % events.size();
-            }
-        }
-    };
-
-    /**
-     * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
-     * the 'idle' state.
-     *
-     * If 'cursorState' is 'Exhausted', the cursor will be destroyed.
-     *
-     * Thread-safe.
-     *
-     * Intentionally private.  Clients should use public methods on PinnedCursor to check a cursor
-     * back in.
-     */
-    void checkInCursor(std::unique_ptr<ClusterClientCursor> cursor,
-                       const NamespaceString& nss,
-                       CursorId cursorId,
-                       CursorState cursorState);
-
-    /**
-     * Will detach a cursor, release the lock and then call kill() on it.
-     */
-    void detachAndKillCursor(stdx::unique_lock<Latch> lk,
-                             OperationContext* opCtx,
-                             const NamespaceString& nss,
-                             CursorId cursorId);
-
-    /**
-     * Returns a pointer to the CursorEntry for the given cursor.  If the given cursor is not
-     * registered, returns null.
-     *
-     * Not thread-safe.
-     */
-    CursorEntry* _getEntry(WithLock, NamespaceString const& nss, CursorId cursorId);
-
-    /**
-     * De-registers the given cursor, and returns an owned pointer to the underlying
-     * ClusterClientCursor object.
-     *
-     * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
-     * cursor is not registered, returns an error Status with code CursorNotFound.
-     *
-     * Not thread-safe.
-     */
-    StatusWith<ClusterClientCursorGuard> _detachCursor(WithLock,
-                                                       OperationContext* opCtx,
-                                                       const NamespaceString& nss,
-                                                       CursorId cursorId);
-
-    /**
-     * Flags the OperationContext that's using the given cursor as interrupted.
-     */
-    void killOperationUsingCursor(WithLock, CursorEntry* entry);
-
-    /**
-     * Kill the cursors satisfying the given predicate. Assumes that 'lk' is held upon entry. The
-     * 'now' parameter is only used for the internal logging mechansim.
-     *
-     * Returns the number of cursors killed.
-     */
-    std::size_t killCursorsSatisfying(stdx::unique_lock<Latch> lk,
-                                      OperationContext* opCtx,
-                                      std::function<bool(CursorId, const CursorEntry&)> pred,
-                                      Date_t now);
+    static constexpr std::size_t kNumPartitions = 16;
 
     /**
      * CursorEntry is a moveable, non-copyable container for a single cursor.
@@ -533,12 +399,14 @@ private:
         CursorEntry() = default;
 
         CursorEntry(std::unique_ptr<ClusterClientCursor> cursor,
+                    const NamespaceString& nss,
                     CursorType cursorType,
                     CursorLifetime cursorLifetime,
                     Date_t lastActive,
                     UserNameIterator authenticatedUsersIter,
                     boost::optional<OperationKey> opKey)
             : _cursor(std::move(cursor)),
+              _nss(nss),
               _cursorType(cursorType),
               _cursorLifetime(cursorLifetime),
               _lastActive(lastActive),
@@ -564,6 +432,10 @@ private:
             return _operationUsingCursor->isKillPending();
         }
 
+        const NamespaceString& getNamespace() const {
+            return _nss;
+        }
+
         CursorType getCursorType() const {
             return _cursorType;
         }
@@ -602,11 +474,11 @@ private:
 
         /**
          * Creates a generic cursor from the cursor inside this entry. Should only be called on
-         * idle cursors. The caller must supply the cursorId and namespace because the CursorEntry
-         * does not have access to them.  Cannot be called if this CursorEntry does not own an
-         * underlying ClusterClientCursor.
+         * idle cursors. The caller must supply the cursorId because the CursorEntry does not have
+         * access to it.  Cannot be called if this CursorEntry does not own an underlying
+         * ClusterClientCursor.
          */
-        GenericCursor cursorToGenericCursor(CursorId cursorId, const NamespaceString& ns) const;
+        GenericCursor cursorToGenericCursor(CursorId cursorId) const;
 
         OperationContext* getOperationUsingCursor() const {
             return _operationUsingCursor;
@@ -635,6 +507,7 @@ private:
 
     private:
         std::unique_ptr<ClusterClientCursor> _cursor;
+        NamespaceString _nss;
         CursorType _cursorType = CursorType::SingleTarget;
         CursorLifetime _cursorLifetime = CursorLifetime::Mortal;
         Date_t _lastActive;
@@ -650,80 +523,91 @@ private:
         const std::vector<UserName> _authenticatedUsers;
     };
 
+    using CursorEntryMap = stdx::unordered_map<CursorId, CursorEntry>;
+    using PartitionedCursorEntryMap = Partitioned<CursorEntryMap, kNumPartitions>;
+    using CursorEntryPartition = PartitionedCursorEntryMap::OnePartition;
+
     /**
-     * CursorEntryContainer is a moveable, non-copyable container for a set of cursors, where all
-     * contained cursors share the same 32-bit prefix of their cursor id.
+     * Transfers ownership of the given pinned cursor back to the manager, and moves the cursor to
+     * the 'idle' state.
+     *
+     * If 'cursorState' is 'Exhausted', the cursor will be destroyed.
+     *
+     * Thread-safe.
+     *
+     * Intentionally private.  Clients should use public methods on PinnedCursor to check a cursor
+     * back in.
      */
-    struct CursorEntryContainer {
-        CursorEntryContainer(const CursorEntryContainer&) = delete;
-        CursorEntryContainer& operator=(const CursorEntryContainer&) = delete;
-
-        CursorEntryContainer(uint32_t containerPrefix) : containerPrefix(containerPrefix) {}
-
-        CursorEntryContainer(CursorEntryContainer&& other) = default;
-        CursorEntryContainer& operator=(CursorEntryContainer&& other) = default;
+    void checkInCursor(std::unique_ptr<ClusterClientCursor> cursor,
+                       const NamespaceString& nss,
+                       CursorId cursorId,
+                       CursorState cursorState);
 
-        // Common cursor id prefix for all cursors in this container.
-        uint32_t containerPrefix;
+    /**
+     * Will detach a cursor, release the partition lock and then call kill() on it.
+     */
+    void detachAndKillCursor(CursorEntryPartition&& partition,
+                             OperationContext* opCtx,
+                             const NamespaceString& nss,
+                             CursorId cursorId);
 
-        // Map from cursor id to cursor entry.
-        CursorEntryMap entryMap;
-    };
+    /**
+     * Returns a pointer to the CursorEntry for the given cursor, which must belong to the locked
+     * 'partition'.  If the given cursor is not registered, or is registered on another namespace,
+     * returns null.
+     */
+    CursorEntry* _getEntry(const CursorEntryPartition& partition,
+                           NamespaceString const& nss,
+                           CursorId cursorId);
 
     /**
-     * Erase the container that 'it' points to and return an iterator to the next one. Assumes 'it'
-     * is an iterator in '_namespaceToContainerMap'.
+     * De-registers the given cursor, which must belong to the locked 'partition', and returns an
+     * owned pointer to the underlying ClusterClientCursor object.
+     *
+     * If the given cursor is pinned, returns an error Status with code CursorInUse.  If the given
+     * cursor is not registered, returns an error Status with code CursorNotFound.
      */
-    NssToCursorContainerMap::iterator eraseContainer(NssToCursorContainerMap::iterator it);
+    StatusWith<ClusterClientCursorGuard> _detachCursor(const CursorEntryPartition& partition,
+                                                       OperationContext* opCtx,
+                                                       const NamespaceString& nss,
+                                                       CursorId cursorId);
 
     /**
-     * Functions which dump the state/history of the cursor manager into a BSONObj for debug
-     * purposes.
+     * Flags the OperationContext that's using the given cursor as interrupted. The partition
+     * holding 'entry' must be locked.
      */
-    BSONObj dumpCursorIdToNssMap() const;
-    BSONObj dumpNssToContainerMap() const;
-    BSONObj dumpInternalLog() const;
+    void killOperationUsingCursor(CursorEntry* entry);
 
     /**
-     * Logs objects which summarize the current state of the cursor manager as well as its recent
-     * history.
+     * Kill the cursors satisfying the given predicate, locking one partition at a time.
+     *
+     * Returns the number of cursors killed.
      */
-    void logCursorManagerInfo() const;
+    std::size_t killCursorsSatisfying(OperationContext* opCtx,
+                                      std::function<bool(CursorId, const CursorEntry&)> pred);
 
     // Clock source.  Used when the 'last active' time for a cursor needs to be set/updated.  May be
     // concurrently accessed by multiple threads.
     ClockSource* _clockSource;
 
-    // Synchronizes access to all private state variables below.
-    mutable Mutex _mutex = MONGO_MAKE_LATCH("ClusterCursorManager::_mutex");
+    // Synchronizes cursor id generation. It is held from the generation of a cursor id until the
+    // cursor is inserted into '_cursorEntryMap', so that no two cursors are given the same id, and
+    // so that no cursor is registered once shutdown() has begun killing the registered ones. It
+    // must be acquired before any partition of '_cursorEntryMap'.
+    Mutex _registrationMutex = MONGO_MAKE_LATCH("ClusterCursorManager::_registrationMutex");
 
-    bool _inShutdown{false};
+    AtomicWord<bool> _inShutdown{false};
 
     // Randomness source.  Used for cursor id generation.
     const int64_t _randomSeed;
     PseudoRandom _pseudoRandom;
 
-    // Map from cursor id prefix to associated namespace.  Exists only to provide namespace lookup
-    // for (deprecated) getNamespaceForCursorId() method.
-    //
-    // A CursorId is a 64-bit type, made up of a 32-bit prefix and a 32-bit suffix.  When the first
-    // cursor on a given namespace is registered, it is given a CursorId with a prefix that is
-    // unique to that namespace, and an arbitrary suffix.  Cursors subsequently registered on that
-    // namespace will all share the same prefix.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    stdx::unordered_map<uint32_t, NamespaceString> _cursorIdPrefixToNamespaceMap;
-
-    // Map from namespace to the CursorEntryContainer for that namespace.
-    //
-    // Entries are added when the first cursor on the given namespace is registered, and removed
-    // when the last cursor on the given namespace is destroyed.
-    NssToCursorContainerMap _namespaceToContainerMap;
+    // Map from cursor id to the entry of that cursor, partitioned by cursor id so that operations
+    // on different cursors do not contend on one mutex. Operations on a single cursor lock only
+    // its partition. Operations on every cursor lock the partitions in ascending order.
+    mutable PartitionedCursorEntryMap _cursorEntryMap;
 
     size_t _cursorsTimedOut = 0;
-
-    CircularLogQueue _log;
 };
 
 }  // namespace mongo
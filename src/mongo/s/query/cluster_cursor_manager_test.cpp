@@ -801,6 +801,68 @@ TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdUnknown) {
     ASSERT_FALSE(cursorNamespace);
 }
 
+// Test that getting the namespace for a cursor which has been killed returns boost::none.
+TEST_F(ClusterCursorManagerTest, GetNamespaceForCursorIdKilled) {
+    auto cursorId =
+        assertGet(getManager()->registerCursor(_opCtx.get(),
+                                               allocateMockCursor(),
+                                               nss,
+                                               ClusterCursorManager::CursorType::SingleTarget,
+                                               ClusterCursorManager::CursorLifetime::Mortal,
+                                               UserNameIterator()));
+    ASSERT_OK(getManager()->killCursor(_opCtx.get(), nss, cursorId));
+    ASSERT_FALSE(getManager()->getNamespaceForCursorId(cursorId));
+}
+
+// Test that many cursors, which are spread over the partitions of the manager, can each be checked
+// out and killed on their own, and are all visited by the operations on every cursor.
+TEST_F(ClusterCursorManagerTest, ManyCursorsAcrossPartitions) {
+    const size_t numCursors = 200;
+    std::vector<std::pair<NamespaceString, CursorId>> cursors;
+    stdx::unordered_set<CursorId> cursorIds;
+    for (size_t i = 0; i < numCursors; ++i) {
+        NamespaceString cursorNamespace(std::string(str::stream() << "test.collection" << i % 3));
+        auto cursorId =
+            assertGet(getManager()->registerCursor(_opCtx.get(),
+                                                   allocateMockCursor(),
+                                                   cursorNamespace,
+                                                   ClusterCursorManager::CursorType::MultiTarget,
+                                                   ClusterCursorManager::CursorLifetime::Mortal,
+                                                   UserNameIterator()));
+        ASSERT_GT(cursorId, 0);
+        ASSERT(cursorIds.insert(cursorId).second);
+        cursors.emplace_back(cursorNamespace, cursorId);
+    }
+    ASSERT_EQ(numCursors, getManager()->stats().cursorsMultiTarget);
+
+    for (size_t i = 0; i < numCursors; ++i) {
+        const auto& [cursorNamespace, cursorId] = cursors[i];
+        ASSERT_EQ(ErrorCodes::CursorNotFound,
+                  getManager()
+                      ->checkOutCursor(NamespaceString("test.other"),
+                                       cursorId,
+                                       _opCtx.get(),
+                                       successAuthChecker)
+                      .getStatus());
+        auto pinnedCursor = getManager()->checkOutCursor(
+            cursorNamespace, cursorId, _opCtx.get(), successAuthChecker);
+        ASSERT_OK(pinnedCursor.getStatus());
+        pinnedCursor.getValue().returnCursor(
+            i % 2 ? ClusterCursorManager::CursorState::Exhausted
+                  : ClusterCursorManager::CursorState::NotExhausted);
+    }
+    ASSERT_EQ(numCursors / 2, getManager()->stats().cursorsMultiTarget);
+    for (size_t i = 0; i < numCursors; ++i) {
+        ASSERT_EQ(i % 2 == 1, isMockCursorKilled(i));
+    }
+
+    getManager()->killAllCursors(_opCtx.get());
+    ASSERT_EQ(0U, getManager()->stats().cursorsMultiTarget);
+    for (size_t i = 0; i < numCursors; ++i) {
+        ASSERT(isMockCursorKilled(i));
+    }
+}
+
 // Test that the PinnedCursor default constructor creates a pin that owns no cursor.
 TEST_F(ClusterCursorManagerTest, PinnedCursorDefaultConstructor) {
     ClusterCursorManager::PinnedCursor pinnedCursor;
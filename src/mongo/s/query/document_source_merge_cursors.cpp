@@ -106,6 +106,10 @@ DocumentSource::GetNextResult DocumentSourceMergeCursors::doGetNext() {
     if (next.isEOF()) {
         return GetNextResult::makeEOF();
     }
+    if (_awaitOnlyForFirstResult &&
+        _execContext == RouterExecStage::ExecContext::kGetMoreNoResultsYet) {
+        _execContext = RouterExecStage::ExecContext::kGetMoreWithAtLeastOneResultInBatch;
+    }
     return Document::fromBsonWithMetaData(*next.getResult());
 }
 
@@ -115,6 +115,15 @@ public:
         _execContext = execContext;
     }
 
+    /**
+     * If set, a tailable awaitData getMore only awaits data until this stage has returned one
+     * result. Further results within the same RouterExecStage::next() call are only returned if
+     * they are already available. Used when a later stage reads ahead of the results it returns.
+     */
+    void setAwaitOnlyForFirstResult(bool awaitOnlyForFirstResult) {
+        _awaitOnlyForFirstResult = awaitOnlyForFirstResult;
+    }
+
     Status setAwaitDataTimeout(Milliseconds awaitDataTimeout) {
         if (!_blockingResultsMerger) {
             // In cases where a cursor was established with a batchSize of 0, the first getMore
@@ -179,6 +188,9 @@ private:
     // allows us to determine which situation we're in.
     RouterExecStage::ExecContext _execContext = RouterExecStage::ExecContext::kInitialFind;
 
+    // See setAwaitOnlyForFirstResult().
+    bool _awaitOnlyForFirstResult = false;
+
     // Indicates whether the cursors stored in _armParams are "owned", meaning the cursors should be
     // killed upon disposal of this DocumentSource.
     bool _ownCursors = true;
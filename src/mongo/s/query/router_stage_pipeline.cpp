@@ -45,6 +45,18 @@ RouterStagePipeline::RouterStagePipeline(std::unique_ptr<Pipeline, PipelineDelet
     invariant(!_mergePipeline->getSources().empty());
     _mergeCursorsStage =
         dynamic_cast<DocumentSourceMergeCursors*>(_mergePipeline->getSources().front().get());
+    for (auto&& source : _mergePipeline->getSources()) {
+        if (auto lookupPostImageStage =
+                dynamic_cast<DocumentSourceLookupChangePostImage*>(source.get())) {
+            _lookupPostImageStage = lookupPostImageStage;
+        }
+    }
+
+    // The post-image lookup stage reads ahead to batch its lookups. It must not wait for events
+    // which have not arrived yet while it already holds one to return.
+    if (_mergeCursorsStage && _lookupPostImageStage) {
+        _mergeCursorsStage->setAwaitOnlyForFirstResult(true);
+    }
 }
 
 StatusWith<ClusterQueryResult> RouterStagePipeline::next(RouterExecStage::ExecContext execContext) {
@@ -87,6 +99,9 @@ std::size_t RouterStagePipeline::getNumRemotes() const {
 }
 
 BSONObj RouterStagePipeline::getPostBatchResumeToken() const {
+    if (_lookupPostImageStage && _lookupPostImageStage->hasBufferedEvents()) {
+        return _latestReturnedResumeToken;
+    }
     return _mergeCursorsStage ? _mergeCursorsStage->getHighWaterMark() : BSONObj();
 }
 
@@ -111,6 +126,8 @@ BSONObj RouterStagePipeline::_validateAndConvertToBSON(const Document& event) {
             (resumeToken.getType() == BSONType::Object) &&
                 idField.binaryEqual(resumeToken.getDocument().toBson()));
 
+    _latestReturnedResumeToken = resumeToken.getDocument().toBson();
+
     // Return the event in BSONObj form, minus the $sortKey metadata.
     return eventBSON;
 }
@@ -32,6 +32,7 @@
 #include "mongo/s/query/router_exec_stage.h"
 
 #include "mongo/db/pipeline/document_source.h"
+#include "mongo/db/pipeline/document_source_lookup_change_post_image.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/s/query/document_source_merge_cursors.h"
 
@@ -69,5 +70,13 @@ private:
 
     // May be null if this pipeline runs exclusively on mongos without contacting the shards at all.
     boost::intrusive_ptr<DocumentSourceMergeCursors> _mergeCursorsStage;
+
+    // Set if this is a change stream which looks up post-images. That stage reads ahead of the
+    // events it returns, so while it holds buffered events the postBatchResumeToken is the resume
+    // token of the last event returned rather than the high water mark of the merged cursors.
+    boost::intrusive_ptr<DocumentSourceLookupChangePostImage> _lookupPostImageStage;
+
+    // The resume token of the last change stream event returned by this stage.
+    BSONObj _latestReturnedResumeToken;
 };
 }  // namespace mongo
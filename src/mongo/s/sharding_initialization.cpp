@@ -169,6 +169,8 @@ Status initializeGlobalShardingState(OperationContext* opCtx,
     connPoolOptions.controllerFactory = []() noexcept {
         return std::make_shared<ShardingTaskExecutorPoolController>();
     };
+    connPoolOptions.maxRequestsPerConnection =
+        ShardingTaskExecutorPoolController::gParameters.maxRequestsPerConnection.load();
 
     auto network = executor::makeNetworkInterface(
         "ShardRegistry", std::make_unique<ShardingNetworkConnectionHook>(), hookBuilder());
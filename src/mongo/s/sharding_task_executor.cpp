@@ -122,10 +122,30 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCom
     const RemoteCommandRequestOnAny& request,
     const RemoteCommandOnAnyCallbackFn& cb,
     const BatonHandle& baton) {
+    return _scheduleRemoteCommandOnAny(request, cb, baton, false /* exhaust */);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleExhaustRemoteCommandOnAny(
+    const RemoteCommandRequestOnAny& request,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton) {
+    return _scheduleRemoteCommandOnAny(request, cb, baton, true /* exhaust */);
+}
+
+StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::_scheduleRemoteCommandOnAny(
+    const RemoteCommandRequestOnAny& request,
+    const RemoteCommandOnAnyCallbackFn& cb,
+    const BatonHandle& baton,
+    bool exhaust) {
+    auto schedule = [&](const RemoteCommandRequestOnAny& toSchedule,
+                        const RemoteCommandOnAnyCallbackFn& callback) {
+        return exhaust ? _executor->scheduleExhaustRemoteCommandOnAny(toSchedule, callback, baton)
+                       : _executor->scheduleRemoteCommandOnAny(toSchedule, callback, baton);
+    };
 
     // schedule the user's callback if there is not opCtx
     if (!request.opCtx) {
-        return _executor->scheduleRemoteCommandOnAny(request, cb, baton);
+        return schedule(request, cb);
     }
 
     boost::optional<RemoteCommandRequestOnAny> requestWithFixedLsid = [&] {
@@ -267,15 +287,7 @@ StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleRemoteCom
         }
     };
 
-    return _executor->scheduleRemoteCommandOnAny(
-        requestWithFixedLsid ? *requestWithFixedLsid : request, shardingCb, baton);
-}
-
-StatusWith<TaskExecutor::CallbackHandle> ShardingTaskExecutor::scheduleExhaustRemoteCommandOnAny(
-    const RemoteCommandRequestOnAny& request,
-    const RemoteCommandOnAnyCallbackFn& cb,
-    const BatonHandle& baton) {
-    MONGO_UNREACHABLE;
+    return schedule(requestWithFixedLsid ? *requestWithFixedLsid : request, shardingCb);
 }
 
 bool ShardingTaskExecutor::hasTasks() {
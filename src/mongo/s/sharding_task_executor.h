@@ -86,6 +86,16 @@ public:
     void appendConnectionStats(ConnectionPoolStats* stats) const override;
 
 private:
+    /**
+     * Schedules 'request' on the underlying executor, as an exhaust command if 'exhaust' is true,
+     * with a callback which gossips the cluster time and updates the replica set monitors from
+     * each response before running 'cb'.
+     */
+    StatusWith<CallbackHandle> _scheduleRemoteCommandOnAny(const RemoteCommandRequestOnAny& request,
+                                                           const RemoteCommandOnAnyCallbackFn& cb,
+                                                           const BatonHandle& baton,
+                                                           bool exhaust);
+
     std::unique_ptr<ThreadPoolTaskExecutor> _executor;
 };
 
@@ -224,7 +224,8 @@ auto ShardingTaskExecutorPoolController::updateHost(PoolId id, const HostState&
     const size_t maxConns = gParameters.maxConnections.load();
 
     // Update the target for just the pool first
-    poolData.target = stats.requests + stats.active;
+    poolData.target = std::max(stats.requests + stats.active, stats.recentDemand) +
+        static_cast<size_t>(gParameters.spareConnections.load());
 
     if (poolData.target < minConns) {
         poolData.target = minConns;
@@ -319,6 +320,10 @@ Milliseconds ShardingTaskExecutorPoolController::toRefreshTimeout() const {
     return Milliseconds{gParameters.toRefreshTimeoutMS.load()};
 }
 
+Milliseconds ShardingTaskExecutorPoolController::demandWindow() const {
+    return Milliseconds{gParameters.demandWindowMS.load()};
+}
+
 void ShardingTaskExecutorPoolController::updateConnectionPoolStats(
     executor::ConnectionPoolStats* cps) const {
     cps->strategy = gParameters.matchingStrategy.load();
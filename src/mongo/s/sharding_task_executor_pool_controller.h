@@ -100,6 +100,10 @@ public:
         AtomicWord<int> pendingTimeoutMS;
         AtomicWord<int> toRefreshTimeoutMS;
 
+        AtomicWord<int> demandWindowMS;
+        AtomicWord<int> spareConnections;
+        AtomicWord<int> maxRequestsPerConnection;
+
         synchronized_value<std::string> matchingStrategyString;
         AtomicWord<MatchingStrategy> matchingStrategy;
     };
@@ -137,6 +141,7 @@ public:
     Milliseconds hostTimeout() const override;
     Milliseconds pendingTimeout() const override;
     Milliseconds toRefreshTimeout() const override;
+    Milliseconds demandWindow() const override;
 
     StringData name() const override {
         return "ShardingTaskExecutorPoolController"_sd;
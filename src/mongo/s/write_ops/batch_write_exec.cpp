@@ -35,6 +35,7 @@
 
 #include "mongo/base/error_codes.h"
 #include "mongo/base/owned_pointer_map.h"
+#include "mongo/base/owned_pointer_vector.h"
 #include "mongo/base/status.h"
 #include "mongo/bson/util/builder.h"
 #include "mongo/client/connection_string.h"
@@ -129,6 +130,33 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
     BatchWriteOp batchOp(opCtx, clientRequest);
 
+    // Outside of transactions, the next batch of an unordered write for a shard is sent as soon as
+    // the shard has responded to the previous one, rather than with the next round, so that the
+    // other shards do not wait for the slowest one
+    const bool streamBatches = !clientRequest.getWriteCommandRequestBase().getOrdered() &&
+        !TransactionRouter::get(opCtx);
+
+    const auto buildShardRequest = [&](const TargetedWriteBatch& batch) {
+        const auto request = [&] {
+            const auto shardBatchRequest(batchOp.buildBatchRequest(batch));
+
+            BSONObjBuilder requestBuilder;
+            shardBatchRequest.serialize(&requestBuilder);
+            logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
+
+            return requestBuilder.obj();
+        }();
+
+        LOGV2_DEBUG(22905,
+                    4,
+                    "Sending write batch to {shardId}: {request}",
+                    "Sending write batch",
+                    "shardId"_attr = batch.getEndpoint().shardName,
+                    "request"_attr = redact(request));
+
+        return AsyncRequestsSender::Request(batch.getEndpoint().shardName, request);
+    };
+
     // Current batch status
     bool refreshedTargeter = false;
     int rounds = 0;
@@ -195,12 +223,19 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
         const size_t numToSend = childBatches.size();
         size_t numSent = 0;
 
+        // The next batches are not streamed to shards once metadata is known to be stale, since
+        // they would have to be targeted again anyway
+        bool canStreamBatches = streamBatches && targetStatus.isOK();
+
         while (numSent != numToSend) {
             // Collect batches out on the network, mapped by endpoint
             OwnedPointerMap<ShardId, TargetedWriteBatch> ownedPendingBatches;
             OwnedPointerMap<ShardId, TargetedWriteBatch>::MapType& pendingBatches =
                 ownedPendingBatches.mutableMap();
 
+            // Batches which were replaced in 'pendingBatches' by the next batch for their shard
+            OwnedPointerVector<TargetedWriteBatch> respondedBatches;
+
             //
             // Construct the requests.
             //
@@ -222,24 +257,7 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
 
                 stats->noteTargetedShard(targetShardId);
 
-                const auto request = [&] {
-                    const auto shardBatchRequest(batchOp.buildBatchRequest(*nextBatch));
-
-                    BSONObjBuilder requestBuilder;
-                    shardBatchRequest.serialize(&requestBuilder);
-                    logical_session_id_helpers::serializeLsidAndTxnNumber(opCtx, &requestBuilder);
-
-                    return requestBuilder.obj();
-                }();
-
-                LOGV2_DEBUG(22905,
-                            4,
-                            "Sending write batch to {shardId}: {request}",
-                            "Sending write batch",
-                            "shardId"_attr = targetShardId,
-                            "request"_attr = redact(request));
-
-                requests.emplace_back(targetShardId, request);
+                requests.push_back(buildShardRequest(*nextBatch));
 
                 // Indicate we're done by setting the batch to nullptr. We'll only get duplicate
                 // hostEndpoints if we have broadcast and non-broadcast endpoints for the same host,
@@ -344,6 +362,10 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                         ++stats->numStaleDbBatches;
                     }
 
+                    if (!staleShardErrors.empty() || !staleDbErrors.empty()) {
+                        canStreamBatches = false;
+                    }
+
                     if (response.shardHostAndPort) {
                         // Remember that we successfully wrote to this shard
                         // NOTE: This will record lastOps for shards where we actually didn't update
@@ -356,6 +378,22 @@ void BatchWriteExec::executeBatch(OperationContext* opCtx,
                                                ? batchedCommandResponse.getElectionId()
                                                : OID());
                     }
+
+                    if (canStreamBatches && batchOp.hasDeferredWritesForShard(response.shardId)) {
+                        std::map<ShardId, TargetedWriteBatch*> nextBatches;
+                        batchOp.targetBatchForShard(targeter, response.shardId, &nextBatches);
+
+                        if (!nextBatches.empty()) {
+                            invariant(nextBatches.size() == 1u);
+                            TargetedWriteBatch* const nextBatch = nextBatches.begin()->second;
+
+                            ars.addRequest(buildShardRequest(*nextBatch));
+                            ++stats->numStreamedBatches;
+
+                            respondedBatches.mutableVector().push_back(batch);
+                            pendingBatches[response.shardId] = nextBatch;
+                        }
+                    }
                 } else {
                     // Error occurred dispatching, note it
                     const Status status = responseStatus.withContext(
@@ -90,7 +90,8 @@ public:
           numTargetErrors(0),
           numResolveErrors(0),
           numStaleShardBatches(0),
-          numStaleDbBatches(0) {}
+          numStaleDbBatches(0),
+          numStreamedBatches(0) {}
 
     void noteWriteAt(const HostAndPort& host, repl::OpTime opTime, const OID& electionId);
     void noteTargetedShard(const ShardId& shardId);
@@ -112,6 +113,8 @@ public:
     int numStaleShardBatches;
     // Number of stale batches due to StaleDbVersion
     int numStaleDbBatches;
+    // Number of batches sent to a shard as soon as it responded to its previous batch
+    int numStreamedBatches;
 
 private:
     std::set<ShardId> _targetedShards;
@@ -31,6 +31,7 @@
 
 #include "mongo/s/write_ops/batch_write_op.h"
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 
@@ -270,6 +271,22 @@ BatchWriteOp::BatchWriteOp(OperationContext* opCtx, const BatchedCommandRequest&
 Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                                  bool recordTargetErrors,
                                  std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
+    return _targetBatch(targeter, recordTargetErrors, nullptr, targetedBatches);
+}
+
+void BatchWriteOp::targetBatchForShard(const NSTargeter& targeter,
+                                       const ShardId& shardId,
+                                       std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
+    invariant(!_clientRequest.getWriteCommandRequestBase().getOrdered());
+    invariant(!_inTransaction);
+
+    uassertStatusOK(_targetBatch(targeter, false, &shardId, targetedBatches));
+}
+
+Status BatchWriteOp::_targetBatch(const NSTargeter& targeter,
+                                  bool recordTargetErrors,
+                                  const ShardId* onlyShardId,
+                                  std::map<ShardId, TargetedWriteBatch*>* targetedBatches) {
     //
     // Targeting of unordered batches is fairly simple - each remaining write op is targeted,
     // and each of those targeted writes are grouped into a batch for a particular shard
@@ -302,9 +319,19 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
     //  [{ skey : [c,x] }],
     //  [{ skey : y }, { skey : z }]
     //
+    // Once the batch for a shard of an unordered batch is full, the later write ops for that shard
+    // are deferred, so that they are still sent to it in order, while the write ops for the other
+    // shards keep being targeted.
+    //
 
     const bool ordered = _clientRequest.getWriteCommandRequestBase().getOrdered();
 
+    if (onlyShardId) {
+        _shardsWithDeferredWrites.erase(*onlyShardId);
+    } else {
+        _shardsWithDeferredWrites.clear();
+    }
+
     TargetedBatchMap batchMap;
     std::set<ShardId> targetedShards;
 
@@ -333,6 +360,10 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
         }
 
         if (!targetStatus.isOK()) {
+            // Leave the error to be recorded by the next call to targetBatch()
+            if (onlyShardId)
+                continue;
+
             WriteErrorDetail targetError;
             buildTargetError(targetStatus, &targetError);
 
@@ -367,6 +398,22 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
             }
         }
 
+        //
+        // When targeting a single shard, leave the writes which go to any other shard for later, as
+        // well as the unordered writes to shards whose batches are already full.
+        //
+
+        const bool isDeferred =
+            std::any_of(writes.begin(), writes.end(), [&](const TargetedWrite* write) {
+                const auto& shardId = write->endpoint.shardName;
+                return (onlyShardId && shardId != *onlyShardId) ||
+                    (!ordered && _shardsWithDeferredWrites.count(shardId));
+            });
+        if (isDeferred) {
+            writeOp.cancelWrites(nullptr);
+            continue;
+        }
+
         //
         // If ordered and we have a previous endpoint, make sure we don't need to send these
         // targeted writes to any other endpoints.
@@ -403,7 +450,14 @@ Status BatchWriteOp::targetBatch(const NSTargeter& targeter,
                 writes, std::max(writeSizeBytes, errorResponsePotentialSizeBytes), batchMap)) {
             invariant(!batchMap.empty());
             writeOp.cancelWrites(nullptr);
-            break;
+            if (ordered)
+                break;
+
+            for (const auto write : writes) {
+                if (batchMap.count(&write->endpoint))
+                    _shardsWithDeferredWrites.insert(write->endpoint.shardName);
+            }
+            continue;
         }
 
         if (!ordered && !batchMap.empty() &&
@@ -147,6 +147,26 @@ public:
                        bool recordTargetErrors,
                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
 
+    /**
+     * Targets the next write ops of an unordered batch op which only go to 'shardId', leaving all
+     * the others ready for the next call to targetBatch(). Write ops which fail to target are also
+     * left to targetBatch(), which records the errors.
+     *
+     * Used to send the next batch to a shard as soon as it has responded to the previous one,
+     * rather than waiting for all the shards to respond.
+     */
+    void targetBatchForShard(const NSTargeter& targeter,
+                             const ShardId& shardId,
+                             std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
+
+    /**
+     * Returns true if the last targeting of an unordered batch op left write ops for 'shardId'
+     * because its batch was full.
+     */
+    bool hasDeferredWritesForShard(const ShardId& shardId) const {
+        return _shardsWithDeferredWrites.count(shardId);
+    }
+
     /**
      * Fills a BatchCommandRequest from a TargetedWriteBatch for this BatchWriteOp.
      */
@@ -204,6 +224,14 @@ public:
     boost::optional<int> getNShardsOwningChunks();
 
 private:
+    /**
+     * Implements targetBatch() and targetBatchForShard(), the latter if 'onlyShardId' is set.
+     */
+    Status _targetBatch(const NSTargeter& targeter,
+                        bool recordTargetErrors,
+                        const ShardId* onlyShardId,
+                        std::map<ShardId, TargetedWriteBatch*>* targetedBatches);
+
     /**
      * Maintains the batch execution statistics when a response is received.
      */
@@ -229,6 +257,10 @@ private:
     // Not owned here but tracked for reporting
     std::set<const TargetedWriteBatch*> _targeted;
 
+    // Shards whose batch was full when the write ops of an unordered batch op were last targeted,
+    // so that some of their write ops are still ready
+    std::set<ShardId> _shardsWithDeferredWrites;
+
     // Write concern responses from all write batches so far
     std::vector<ShardWCError> _wcErrors;
 
@@ -1537,6 +1537,65 @@ TEST_F(BatchWriteOpLimitTests, OneBigOneSmall) {
     ASSERT(batchOp.isFinished());
 }
 
+// Big doc followed by smaller docs to two shards, unordered - the writes to the other shard should
+// not wait for the shard whose batch is full, and the deferred write can be targeted on its own
+TEST_F(BatchWriteOpLimitTests, UnorderedFullShardDefersOnlyItsWrites) {
+    NamespaceString nss("foo.bar");
+    ShardEndpoint endpointA(ShardId("shardA"), ChunkVersion::IGNORED(), boost::none);
+    ShardEndpoint endpointB(ShardId("shardB"), ChunkVersion::IGNORED(), boost::none);
+
+    auto targeter = initTargeterSplitRange(nss, endpointA, endpointB);
+
+    // Create a BSONObj (slightly) bigger than the maximum size by including a max-size string
+    const std::string bigString(BSONObjMaxUserSize, 'x');
+
+    BatchedCommandRequest request([&] {
+        write_ops::InsertCommandRequest insertOp(nss);
+        insertOp.setWriteCommandRequestBase([] {
+            write_ops::WriteCommandRequestBase wcb;
+            wcb.setOrdered(false);
+            return wcb;
+        }());
+        insertOp.setDocuments({BSON("x" << -1 << "data" << bigString),
+                               BSON("x" << -2),
+                               BSON("x" << 1),
+                               BSON("x" << 2)});
+        return insertOp;
+    }());
+
+    BatchWriteOp batchOp(_opCtx, request);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> targetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& targeted = targetedOwned.mutableMap();
+    ASSERT_OK(batchOp.targetBatch(targeter, false, &targeted));
+    verifyTargetedBatches({{endpointA.shardName, 1u}, {endpointB.shardName, 2u}}, targeted);
+    ASSERT(batchOp.hasDeferredWritesForShard(endpointA.shardName));
+    ASSERT(!batchOp.hasDeferredWritesForShard(endpointB.shardName));
+
+    BatchedCommandResponse responseA;
+    buildResponse(1, &responseA);
+    batchOp.noteBatchResponse(*targeted[endpointA.shardName], responseA, nullptr);
+
+    OwnedPointerMap<ShardId, TargetedWriteBatch> nextTargetedOwned;
+    std::map<ShardId, TargetedWriteBatch*>& nextTargeted = nextTargetedOwned.mutableMap();
+    batchOp.targetBatchForShard(targeter, endpointA.shardName, &nextTargeted);
+    verifyTargetedBatches({{endpointA.shardName, 1u}}, nextTargeted);
+    ASSERT(!batchOp.hasDeferredWritesForShard(endpointA.shardName));
+
+    batchOp.noteBatchResponse(*nextTargeted[endpointA.shardName], responseA, nullptr);
+    ASSERT(!batchOp.isFinished());
+
+    BatchedCommandResponse responseB;
+    buildResponse(2, &responseB);
+    batchOp.noteBatchResponse(*targeted[endpointB.shardName], responseB, nullptr);
+    ASSERT(batchOp.isFinished());
+
+    BatchedCommandResponse clientResponse;
+    batchOp.buildClientResponse(&clientResponse);
+    ASSERT(clientResponse.getOk());
+    ASSERT_EQUALS(clientResponse.getN(), 4);
+}
+
 class BatchWriteOpTransactionTest : public ShardingTestFixture {
 public:
     const TxnNumber kTxnNumber = 5;
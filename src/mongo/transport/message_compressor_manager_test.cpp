@@ -261,6 +261,35 @@ TEST(ZstdMessageCompressor, Fidelity) {
     checkFidelity(testMessage, std::make_unique<ZstdMessageCompressor>());
 }
 
+TEST(ZstdMessageCompressor, ReusedContextsKeepMessagesIndependent) {
+    // The compressor reuses its contexts across calls on a thread, including calls that fail.
+    ZstdMessageCompressor compressor;
+    std::array<char, 16> smallBuffer;
+    std::vector<std::string> inputs;
+    std::vector<std::vector<char>> outputs;
+    for (int i = 0; i < 10; i++) {
+        inputs.push_back(std::string(100 * (i + 1), 'a' + i));
+        ConstDataRange input(inputs.back().data(), inputs.back().size());
+        ASSERT_NOT_OK(
+            compressor.compressData(input, DataRange(smallBuffer.data(), smallBuffer.size())));
+
+        outputs.emplace_back(compressor.getMaxCompressedSize(input.length()));
+        auto sws =
+            compressor.compressData(input, DataRange(outputs.back().data(), outputs.back().size()));
+        ASSERT_OK(sws);
+        outputs.back().resize(sws.getValue());
+    }
+
+    // Each message decompresses on its own, in any order.
+    for (int i = 9; i >= 0; i--) {
+        std::vector<char> decompressed(inputs[i].size());
+        auto sws = compressor.decompressData(ConstDataRange(outputs[i].data(), outputs[i].size()),
+                                             DataRange(decompressed.data(), decompressed.size()));
+        ASSERT_OK(sws);
+        ASSERT_EQ(std::string(decompressed.data(), sws.getValue()), inputs[i]);
+    }
+}
+
 TEST(SnappyMessageCompressor, Overflow) {
     checkOverflow(std::make_unique<SnappyMessageCompressor>());
 }
@@ -38,6 +38,35 @@
 #include "mongo/transport/message_compressor_zstd.h"
 
 namespace mongo {
+namespace {
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// ZSTD_compress() and ZSTD_decompress() allocate and initialize a context for every call, which
+// dominates the cost of compressing the small messages that make up most traffic. Each thread
+// keeps one of each instead; the one-shot calls below reset them, so no state carries over from
+// one message to the next. A null context just falls back to the allocating calls.
+ZSTD_CCtx* getCompressionContext() {
+    thread_local std::unique_ptr<ZSTD_CCtx, CCtxDeleter> cctx(ZSTD_createCCtx());
+    return cctx.get();
+}
+
+ZSTD_DCtx* getDecompressionContext() {
+    thread_local std::unique_ptr<ZSTD_DCtx, DCtxDeleter> dctx(ZSTD_createDCtx());
+    return dctx.get();
+}
+
+}  // namespace
 
 ZstdMessageCompressor::ZstdMessageCompressor() : MessageCompressorBase(MessageCompressor::kZstd) {}
 
@@ -47,11 +76,18 @@ std::size_t ZstdMessageCompressor::getMaxCompressedSize(size_t inputSize) {
 
 StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input,
                                                             DataRange output) {
-    size_t ret = ZSTD_compress(const_cast<char*>(output.data()),
-                               output.length(),
-                               input.data(),
-                               input.length(),
-                               ZSTD_CLEVEL_DEFAULT);
+    auto cctx = getCompressionContext();
+    size_t ret = cctx ? ZSTD_compressCCtx(cctx,
+                                          const_cast<char*>(output.data()),
+                                          output.length(),
+                                          input.data(),
+                                          input.length(),
+                                          ZSTD_CLEVEL_DEFAULT)
+                      : ZSTD_compress(const_cast<char*>(output.data()),
+                                      output.length(),
+                                      input.data(),
+                                      input.length(),
+                                      ZSTD_CLEVEL_DEFAULT);
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
@@ -63,8 +99,12 @@ StatusWith<std::size_t> ZstdMessageCompressor::compressData(ConstDataRange input
 
 StatusWith<std::size_t> ZstdMessageCompressor::decompressData(ConstDataRange input,
                                                               DataRange output) {
-    size_t ret = ZSTD_decompress(
-        const_cast<char*>(output.data()), output.length(), input.data(), input.length());
+    auto dctx = getDecompressionContext();
+    size_t ret = dctx
+        ? ZSTD_decompressDCtx(
+              dctx, const_cast<char*>(output.data()), output.length(), input.data(), input.length())
+        : ZSTD_decompress(
+              const_cast<char*>(output.data()), output.length(), input.data(), input.length());
 
     if (ZSTD_isError(ret)) {
         return Status{ErrorCodes::BadValue,
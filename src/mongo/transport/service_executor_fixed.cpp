@@ -31,6 +31,8 @@
 
 #include "mongo/transport/service_executor_fixed.h"
 
+#include <deque>
+
 #include "mongo/base/error_codes.h"
 #include "mongo/logv2/log.h"
 #include "mongo/transport/service_executor_gen.h"
@@ -55,6 +57,8 @@ constexpr auto kThreadsRunning = "threadsRunning"_sd;
 constexpr auto kClientsInTotal = "clientsInTotal"_sd;
 constexpr auto kClientsRunning = "clientsRunning"_sd;
 constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
+constexpr auto kTasksQueuedLocally = "tasksQueuedLocally"_sd;
+constexpr auto kTasksStolen = "tasksStolen"_sd;
 
 struct Handle {
     ~Handle() {
@@ -76,6 +80,50 @@ const auto serviceExecutorFixedRegisterer = ServiceContext::ConstructorActionReg
     }};
 }  // namespace
 
+class ServiceExecutorFixed::LocalQueue {
+public:
+    void push(unique_function<void()> task, bool* needsSteal) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _tasks.push_back(std::move(task));
+        *needsSteal = !std::exchange(_stealScheduled, true);
+    }
+
+    /**
+     * Takes the newest task, which is the one most likely to find its session still in cache.
+     */
+    unique_function<void()> pop() {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_tasks.empty()) {
+            return {};
+        }
+        auto task = std::move(_tasks.back());
+        _tasks.pop_back();
+        return task;
+    }
+
+    /**
+     * Takes the oldest task on behalf of the steal scheduled for this queue. At most one steal is
+     * outstanding per queue: 'needsSteal' is set if another one should follow.
+     */
+    unique_function<void()> steal(bool* needsSteal) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _stealScheduled = false;
+        if (_tasks.empty()) {
+            *needsSteal = false;
+            return {};
+        }
+        auto task = std::move(_tasks.front());
+        _tasks.pop_front();
+        *needsSteal = _stealScheduled = !_tasks.empty();
+        return task;
+    }
+
+private:
+    Mutex _mutex = MONGO_MAKE_LATCH("ServiceExecutorFixed::LocalQueue::_mutex");
+    std::deque<unique_function<void()>> _tasks;
+    bool _stealScheduled = false;
+};
+
 class ServiceExecutorFixed::ExecutorThreadContext {
 public:
     ExecutorThreadContext(ServiceExecutorFixed* serviceExecutor);
@@ -107,14 +155,33 @@ public:
         return _recursionDepth;
     }
 
+    /**
+     * Returns the queue for tasks scheduled from this thread, or nullptr if they should go to the
+     * shared thread pool. The thread running the reactor never returns to its queue, so it has
+     * none.
+     */
+    const std::shared_ptr<LocalQueue>& getLocalQueue() const {
+        static const std::shared_ptr<LocalQueue> kNone;
+        return _isRunningReactor ? kNone : _localQueue;
+    }
+
+    void setRunningReactor(bool isRunningReactor) {
+        _isRunningReactor = isRunningReactor;
+    }
+
 private:
     ServiceExecutorFixed* const _executor;
     int _recursionDepth = 0;
+    bool _isRunningReactor = false;
+    std::shared_ptr<LocalQueue> _localQueue;
 };
 
 ServiceExecutorFixed::ExecutorThreadContext::ExecutorThreadContext(
     ServiceExecutorFixed* serviceExecutor)
     : _executor(serviceExecutor) {
+    if (fixedServiceExecutorUseLocalQueues) {
+        _localQueue = std::make_shared<LocalQueue>();
+    }
     _executor->_stats.threadsStarted.fetchAndAdd(1);
     hangAfterServiceExecutorFixedExecutorThreadsStart.pauseWhileSet();
 }
@@ -225,6 +292,8 @@ Status ServiceExecutorFixed::start() {
         }
 
         // Start running on the reactor immediately.
+        _executorContext->setRunningReactor(true);
+        ON_BLOCK_EXIT([&] { _executorContext->setRunningReactor(false); });
         reactor->run();
     });
 
@@ -373,11 +442,7 @@ Status ServiceExecutorFixed::scheduleTask(Task task, ScheduleFlags flags) try {
 
     hangBeforeSchedulingServiceExecutorFixedTask.pauseWhileSet();
 
-    _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        invariant(status);
-
-        _executorContext->run([&] { task(); });
-    });
+    _enqueue(std::move(task));
 
     return Status::OK();
 } catch (DBException& e) {
@@ -397,8 +462,55 @@ void ServiceExecutorFixed::_schedule(OutOfLineExecutor::Task task) noexcept {
         _stats.tasksScheduled.fetchAndAdd(1);
     }
 
+    _enqueue([task = std::move(task)]() mutable { task(Status::OK()); });
+}
+
+void ServiceExecutorFixed::_enqueue(unique_function<void()> task) {
+    if (_executorContext) {
+        if (auto& queue = _executorContext->getLocalQueue()) {
+            bool needsSteal;
+            queue->push(std::move(task), &needsSteal);
+            _stats.tasksQueuedLocally.fetchAndAdd(1);
+            if (needsSteal) {
+                _scheduleSteal(queue);
+            }
+            return;
+        }
+    }
+
     _threadPool->schedule([this, task = std::move(task)](Status status) mutable {
-        _executorContext->run([&] { task(std::move(status)); });
+        invariant(status);
+        _runTask(std::move(task));
+    });
+}
+
+void ServiceExecutorFixed::_runTask(unique_function<void()> task) {
+    _executorContext->run(std::move(task));
+
+    // Tasks queued here are only ever run from this frame, never from a recursive one.
+    if (auto& queue = _executorContext->getLocalQueue()) {
+        while (auto next = queue->pop()) {
+            _executorContext->run(std::move(next));
+        }
+    }
+}
+
+void ServiceExecutorFixed::_scheduleSteal(std::shared_ptr<LocalQueue> queue) {
+    _threadPool->schedule([this, queue = std::move(queue)](Status) mutable {
+        bool needsSteal;
+        auto task = queue->steal(&needsSteal);
+        if (needsSteal) {
+            _scheduleSteal(queue);
+        }
+        if (!task) {
+            // The owning thread got to its tasks first.
+            return;
+        }
+
+        if (queue != _executorContext->getLocalQueue()) {
+            _stats.tasksStolen.fetchAndAdd(1);
+        }
+        _runTask(std::move(task));
     });
 }
 
@@ -455,6 +567,9 @@ void ServiceExecutorFixed::appendStats(BSONObjBuilder* bob) const {
     subbob.append(kClientsInTotal, static_cast<int>(_tasksTotal()));
     subbob.append(kClientsRunning, static_cast<int>(_tasksRunning()));
     subbob.append(kClientsWaiting, static_cast<int>(_tasksWaiting()));
+    subbob.append(kTasksQueuedLocally,
+                  static_cast<long long>(_stats.tasksQueuedLocally.loadRelaxed()));
+    subbob.append(kTasksStolen, static_cast<long long>(_stats.tasksStolen.loadRelaxed()));
 }
 
 int ServiceExecutorFixed::getRecursionDepthForExecutorThread() const {
@@ -52,6 +52,11 @@ namespace transport {
  * A service executor that uses a fixed (configurable) number of threads to execute tasks.
  * This executor always yields before executing scheduled tasks, and never yields before scheduling
  * new tasks (i.e., `ScheduleFlags::kMayYieldBeforeSchedule` is a no-op for this executor).
+ *
+ * Tasks scheduled from an executor thread are queued on that thread, which runs them, newest
+ * first, once its current task returns. This keeps the tasks of a session on the thread that ran
+ * its previous step. Idle threads steal the oldest of them through the shared thread pool, so a
+ * thread that blocks never strands its queue.
  */
 class ServiceExecutorFixed final : public ServiceExecutor,
                                    public std::enable_shared_from_this<ServiceExecutorFixed> {
@@ -97,11 +102,29 @@ public:
 private:
     // Maintains the execution state (e.g., recursion depth) for executor threads
     class ExecutorThreadContext;
+    // The tasks scheduled from an executor thread, see the class comment.
+    class LocalQueue;
 
     void _checkForShutdown(WithLock);
     void _beginShutdown(WithLock);
     void _schedule(OutOfLineExecutor::Task task) noexcept;
 
+    /**
+     * Queues an already counted task on the current executor thread if it has a local queue, or
+     * else on the shared thread pool.
+     */
+    void _enqueue(unique_function<void()> task);
+
+    /**
+     * Runs a task taken from the thread pool, followed by the tasks it left on this thread.
+     */
+    void _runTask(unique_function<void()> task);
+
+    /**
+     * Schedules a thread pool task that steals the oldest task of a local queue.
+     */
+    void _scheduleSteal(std::shared_ptr<LocalQueue> queue);
+
     auto _threadsRunning() const {
         auto ended = _stats.threadsEnded.load();
         auto started = _stats.threadsStarted.loadRelaxed();
@@ -140,6 +163,9 @@ private:
 
         AtomicWord<size_t> waitersStarted{0};
         AtomicWord<size_t> waitersEnded{0};
+
+        AtomicWord<size_t> tasksQueuedLocally{0};
+        AtomicWord<size_t> tasksStolen{0};
     };
     Stats _stats;
 
@@ -35,6 +35,7 @@
 
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/transport/service_executor_fixed.h"
 #include "mongo/transport/service_executor_gen.h"
 #include "mongo/transport/service_executor_utils.h"
 #include "mongo/util/thread_safety_context.h"
@@ -48,6 +49,7 @@ constexpr auto kThreadsRunning = "threadsRunning"_sd;
 constexpr auto kClientsInTotal = "clientsInTotal"_sd;
 constexpr auto kClientsRunning = "clientsRunning"_sd;
 constexpr auto kClientsWaiting = "clientsWaitingForData"_sd;
+constexpr auto kClientsParkedTotal = "clientsParkedTotal"_sd;
 
 const auto getServiceExecutorSynchronous =
     ServiceContext::declareDecoration<std::unique_ptr<ServiceExecutorSynchronous>>();
@@ -63,7 +65,7 @@ thread_local int ServiceExecutorSynchronous::_localRecursionDepth = 0;
 thread_local int64_t ServiceExecutorSynchronous::_localThreadIdleCounter = 0;
 
 ServiceExecutorSynchronous::ServiceExecutorSynchronous(ServiceContext* ctx)
-    : _shutdownCondition(std::make_shared<stdx::condition_variable>()) {}
+    : _svcCtx(ctx), _shutdownCondition(std::make_shared<stdx::condition_variable>()) {}
 
 Status ServiceExecutorSynchronous::start() {
     _stillRunning.store(true);
@@ -145,14 +147,17 @@ Status ServiceExecutorSynchronous::scheduleTask(Task task, ScheduleFlags flags)
 }
 
 void ServiceExecutorSynchronous::appendStats(BSONObjBuilder* bob) const {
-    // The ServiceExecutorSynchronous has one client per thread and waits synchronously on thread.
+    // The ServiceExecutorSynchronous has one client per thread and waits synchronously on thread,
+    // except for the clients that are parked until they have data.
     auto threads = static_cast<int>(_numRunningWorkerThreads.loadRelaxed());
+    auto parked = static_cast<int>(_numParkedSessions.loadRelaxed());
 
     BSONObjBuilder subbob = bob->subobjStart(kExecutorName);
     subbob.append(kThreadsRunning, threads);
-    subbob.append(kClientsInTotal, threads);
+    subbob.append(kClientsInTotal, threads + parked);
     subbob.append(kClientsRunning, threads);
-    subbob.append(kClientsWaiting, 0);
+    subbob.append(kClientsWaiting, parked);
+    subbob.append(kClientsParkedTotal, _totalParkedSessions.loadRelaxed());
 }
 
 void ServiceExecutorSynchronous::runOnDataAvailable(const SessionHandle& session,
@@ -160,9 +165,46 @@ void ServiceExecutorSynchronous::runOnDataAvailable(const SessionHandle& session
     invariant(session);
     yieldIfAppropriate();
 
+    // Only a session's own worker thread may park it; the first call comes from the listener.
+    const auto parkAfter =
+        Milliseconds(synchronousServiceExecutorParkIdleSessionsAfterMS.loadRelaxed());
+    if (parkAfter > Milliseconds(0) && _svcCtx && !_localWorkQueue.empty()) {
+        auto status = session->waitForDataFor(parkAfter);
+        if (status == ErrorCodes::NetworkTimeout) {
+            _parkSession(session, std::move(callback));
+            return;
+        }
+        // Other errors surface from the read that follows.
+    }
+
     schedule([callback = std::move(callback)](Status status) { callback(std::move(status)); });
 }
 
+void ServiceExecutorSynchronous::_parkSession(const SessionHandle& session,
+                                              OutOfLineExecutor::Task callback) {
+    LOGV2_DEBUG(5843126, 3, "Parking idle session", "remote"_attr = session->remote());
+
+    _numParkedSessions.addAndFetch(1);
+    _totalParkedSessions.addAndFetch(1);
+    ServiceExecutorFixed::get(_svcCtx)->runOnDataAvailable(
+        session, [this, callback = std::move(callback)](Status status) mutable {
+            _numParkedSessions.subtractAndFetch(1);
+            if (!status.isOK()) {
+                callback(std::move(status));
+                return;
+            }
+
+            // We are on a ServiceExecutorFixed thread here, so this starts a new worker thread.
+            invariant(_localWorkQueue.empty());
+            auto sharedCallback = std::make_shared<OutOfLineExecutor::Task>(std::move(callback));
+            status = scheduleTask([sharedCallback] { (*sharedCallback)(Status::OK()); },
+                                  ScheduleFlags::kEmptyFlags);
+            if (!status.isOK()) {
+                (*sharedCallback)(std::move(status));
+            }
+        });
+}
+
 
 }  // namespace transport
 }  // namespace mongo
@@ -45,6 +45,10 @@ namespace transport {
 /**
  * The passthrough service executor emulates a thread per connection.
  * Each connection has its own worker thread where jobs get scheduled.
+ *
+ * If synchronousServiceExecutorParkIdleSessionsAfterMS is set, a session that stays idle that
+ * long releases its worker thread and waits for data on the ServiceExecutorFixed reactor instead.
+ * It gets a new worker thread once its next request arrives.
  */
 class ServiceExecutorSynchronous final : public ServiceExecutor {
 public:
@@ -70,10 +74,18 @@ public:
     void appendStats(BSONObjBuilder* bob) const override;
 
 private:
+    /**
+     * Hands the session to ServiceExecutorFixed to wait for data. The calling worker thread exits
+     * once it returns, and a new one runs the callback.
+     */
+    void _parkSession(const SessionHandle& session, OutOfLineExecutor::Task callback);
+
     static thread_local std::deque<Task> _localWorkQueue;
     static thread_local int _localRecursionDepth;
     static thread_local int64_t _localThreadIdleCounter;
 
+    ServiceContext* const _svcCtx;
+
     AtomicWord<bool> _stillRunning{false};
 
     mutable Mutex _shutdownMutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0),
@@ -81,6 +93,8 @@ private:
     std::shared_ptr<stdx::condition_variable> _shutdownCondition;
 
     AtomicWord<size_t> _numRunningWorkerThreads{0};
+    AtomicWord<size_t> _numParkedSessions{0};
+    AtomicWord<long long> _totalParkedSessions{0};
     size_t _numHardwareCores{0};
 };
 
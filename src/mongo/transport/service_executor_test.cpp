@@ -51,6 +51,7 @@
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future.h"
 #include "mongo/util/scopeguard.h"
+#include "mongo/util/time_support.h"
 
 #include <asio.hpp>
 
@@ -169,6 +170,61 @@ TEST_F(ServiceExecutorSynchronousFixture, ScheduleFailsBeforeStartup) {
     scheduleBasicTask(executor.get(), false);
 }
 
+TEST_F(ServiceExecutorSynchronousFixture, IdleSessionIsParked) {
+    // A session that never sees data within the idle period.
+    class IdleSession : public MockSession {
+    public:
+        using MockSession::MockSession;
+
+        Status waitForDataFor(Milliseconds) noexcept override {
+            return Status(ErrorCodes::NetworkTimeout, "no data");
+        }
+    };
+
+    auto tl = std::make_unique<TransportLayerMock>();
+    auto session = std::make_shared<IdleSession>(tl.get());
+
+    auto fixed = ServiceExecutorFixed::get(getGlobalServiceContext());
+    ASSERT_OK(fixed->start());
+    ASSERT_OK(executor->start());
+    auto guard = makeGuard([&] {
+        ASSERT_OK(executor->shutdown(kShutdownTime));
+        ASSERT_OK(fixed->shutdown(kShutdownTime));
+    });
+
+    synchronousServiceExecutorParkIdleSessionsAfterMS.store(1);
+    ON_BLOCK_EXIT([] { synchronousServiceExecutorParkIdleSessionsAfterMS.store(0); });
+
+    auto getStats = [&] {
+        BSONObjBuilder bob;
+        executor->appendStats(&bob);
+        return bob.obj()["passthrough"].Obj().getOwned();
+    };
+
+    // Wait for data from the session's worker thread, as the service state machine does.
+    auto ran = std::make_shared<SharedPromise<void>>();
+    ASSERT_OK(executor->scheduleTask(
+        [&, ran, exec = executor.get()] {
+            exec->runOnDataAvailable(session, [ran, exec](Status status) mutable {
+                ASSERT_OK(status);
+                ASSERT_EQ(exec->getRunningThreads(), 1);
+                ran->emplaceValue();
+            });
+        },
+        ServiceExecutor::kEmptyFlags));
+
+    // The worker thread exits once the session is parked.
+    while (getStats()["clientsWaitingForData"].numberInt() != 1 ||
+           executor->getRunningThreads() != 0) {
+        sleepmillis(1);
+    }
+    ASSERT_EQ(getStats()["clientsParkedTotal"].numberLong(), 1);
+
+    session->signalAvailableData();
+    ran->getFuture().get();
+    ASSERT_EQ(getStats()["clientsWaitingForData"].numberInt(), 0);
+}
+
 class ServiceExecutorFixedFixture : public unittest::Test {
 public:
     static constexpr auto kNumExecutorThreads = 2;
@@ -298,6 +354,32 @@ TEST_F(ServiceExecutorFixedFixture, FlattenRecursiveScheduledTasks) {
     barrier->countDownAndWait();
 }
 
+TEST_F(ServiceExecutorFixedFixture, BlockedThreadHasItsTasksStolen) {
+    auto executorHandle = ServiceExecutorHandle();
+    executorHandle.start();
+
+    auto barrier = std::make_shared<unittest::Barrier>(2);
+    auto stolen = std::make_shared<SharedPromise<stdx::thread::id>>();
+
+    // The first task queues the second one on its own thread, then blocks until it has run.
+    ASSERT_OK(executorHandle->scheduleTask(
+        [barrier, stolen, executor = *executorHandle] {
+            ASSERT_OK(executor->scheduleTask(
+                [stolen] { stolen->emplaceValue(stdx::this_thread::get_id()); },
+                ServiceExecutor::kEmptyFlags));
+            ASSERT_NE(stolen->getFuture().get(), stdx::this_thread::get_id());
+            barrier->countDownAndWait();
+        },
+        ServiceExecutor::kEmptyFlags));
+    barrier->countDownAndWait();
+
+    BSONObjBuilder bob;
+    executorHandle->appendStats(&bob);
+    auto stats = bob.obj()["fixed"].Obj();
+    ASSERT_EQ(stats["tasksQueuedLocally"].numberLong(), 1);
+    ASSERT_EQ(stats["tasksStolen"].numberLong(), 1);
+}
+
 TEST_F(ServiceExecutorFixedFixture, ShutdownTimeLimit) {
     auto executorHandle = ServiceExecutorHandle();
     executorHandle.start();
@@ -121,6 +121,14 @@ public:
     virtual Status waitForData() noexcept = 0;
     virtual Future<void> asyncWaitForData() noexcept = 0;
 
+    /**
+     * Like waitForData(), but gives up with ErrorCodes::NetworkTimeout once the timeout expires.
+     * Sessions that cannot bound the wait simply wait for data.
+     */
+    virtual Status waitForDataFor(Milliseconds timeout) noexcept {
+        return waitForData();
+    }
+
     /**
      * Sink (send) a Message to the remote host for this Session.
      *
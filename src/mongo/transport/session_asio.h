@@ -186,6 +186,9 @@ public:
 
     Status waitForData() noexcept override try {
         ensureSync();
+        if (!_readAheadBytes.empty()) {
+            return Status::OK();
+        }
         asio::error_code ec;
         getSocket().wait(asio::ip::tcp::socket::wait_read, ec);
         return errorCodeToStatus(ec);
@@ -193,8 +196,21 @@ public:
         return ex.toStatus();
     }
 
+    Status waitForDataFor(Milliseconds timeout) noexcept override try {
+        ensureSync();
+        if (!_readAheadBytes.empty()) {
+            return Status::OK();
+        }
+        return pollASIOSocket(getSocket(), POLLIN, timeout).getStatus();
+    } catch (const DBException& ex) {
+        return ex.toStatus();
+    }
+
     Future<void> asyncWaitForData() noexcept override try {
         ensureAsync();
+        if (!_readAheadBytes.empty()) {
+            return Future<void>::makeReady();
+        }
         return getSocket().async_wait(asio::ip::tcp::socket::wait_read, UseFuture{});
     } catch (const DBException& ex) {
         return ex.toStatus();
@@ -252,6 +268,10 @@ public:
         if (!getSocket().is_open())
             return false;
 
+        // The peer already sent the start of another message.
+        if (!_readAheadBytes.empty())
+            return true;
+
         auto swPollEvents = pollASIOSocket(getSocket(), POLLIN, Milliseconds{0});
         if (!swPollEvents.isOK()) {
             if (swPollEvents != ErrorCodes::NetworkTimeout) {
@@ -440,6 +460,10 @@ private:
     Future<Message> sourceMessageImpl(const BatonHandle& baton = nullptr) {
         static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
 
+        if (canReadAhead()) {
+            return sourceMessageWithReadAhead(baton);
+        }
+
         auto headerBuffer = SharedBuffer::allocate(kHeaderSize);
         auto ptr = headerBuffer.get();
         return read(asio::buffer(ptr, kHeaderSize), baton)
@@ -486,6 +510,85 @@ private:
             });
     }
 
+    /**
+     * Once a session is known to be unencrypted, messages are sourced with a single read that
+     * takes the header together with whatever follows it on the socket, up to kReadAheadBytes.
+     * Most requests fit, saving the second syscall per message. The first message of an ingress
+     * session always goes through read() so that TLS and HTTP detection see only its header.
+     */
+    bool canReadAhead() const {
+#ifdef MONGO_CONFIG_SSL
+        return !_sslSocket && _ranHandshake;
+#else
+        return true;
+#endif
+    }
+
+    Future<Message> sourceMessageWithReadAhead(const BatonHandle& baton) {
+        static constexpr auto kHeaderSize = sizeof(MSGHEADER::Value);
+
+        // Start from the bytes of the next message that the previous read received.
+        auto buffer = SharedBuffer::allocate(kReadAheadBytes);
+        const size_t pending = _readAheadBytes.size();
+        invariant(pending < kReadAheadBytes);
+        memcpy(buffer.get(), _readAheadBytes.data(), pending);
+        _readAheadBytes.clear();
+
+        auto received = [&] {
+            if (pending >= kHeaderSize) {
+                return Future<size_t>::makeReady(pending);
+            }
+            return opportunisticReadAtLeast(
+                       _socket,
+                       asio::buffer(buffer.get() + pending, kReadAheadBytes - pending),
+                       kHeaderSize - pending,
+                       baton)
+                .then([pending](size_t size) { return pending + size; });
+        }();
+
+        return std::move(received).then([this, buffer = std::move(buffer), baton](
+                                            size_t received) mutable -> Future<Message> {
+            const auto msgLen = size_t(MSGHEADER::View(buffer.get()).getMessageLength());
+            if (msgLen < kHeaderSize || msgLen > MaxMessageSizeBytes) {
+                LOGV2(5843125,
+                      "recv(): message msgLen {msgLen} is invalid. Min: {min} Max: {max}",
+                      "recv(): message msgLen is invalid.",
+                      "msgLen"_attr = msgLen,
+                      "min"_attr = kHeaderSize,
+                      "max"_attr = MaxMessageSizeBytes);
+                return Status(ErrorCodes::ProtocolError,
+                              str::stream() << "recv(): message msgLen " << msgLen
+                                            << " is invalid. Min " << kHeaderSize
+                                            << " Max: " << MaxMessageSizeBytes);
+            }
+
+            if (received > msgLen) {
+                // The peer pipelined another message behind this one; keep the start of it.
+                _readAheadBytes.assign(buffer.get() + msgLen, received - msgLen);
+                received = msgLen;
+            }
+
+            if (msgLen > kReadAheadBytes) {
+                auto large = SharedBuffer::allocate(msgLen);
+                memcpy(large.get(), buffer.get(), received);
+                buffer = std::move(large);
+            }
+
+            auto remaining = asio::buffer(buffer.get() + received, msgLen - received);
+            auto finish = [this, buffer = std::move(buffer), msgLen]() mutable {
+                if (_isIngressSession) {
+                    networkCounter.hitPhysicalIn(msgLen);
+                }
+                return Message(std::move(buffer));
+            };
+
+            if (received == msgLen) {
+                return finish();
+            }
+            return opportunisticRead(_socket, remaining, baton).then(std::move(finish));
+        });
+    }
+
     template <typename MutableBufferSequence>
     Future<void> read(const MutableBufferSequence& buffers, const BatonHandle& baton = nullptr) {
         // TODO SERVER-47229 Guard active ops for cancellation here.
@@ -598,6 +701,65 @@ private:
         }
     }
 
+    /**
+     * Like opportunisticRead(), but completes as soon as at least minBytes have been read into
+     * buffer, returning how many bytes were read in total.
+     */
+    template <typename Stream>
+    Future<size_t> opportunisticReadAtLeast(Stream& stream,
+                                            asio::mutable_buffer buffer,
+                                            size_t minBytes,
+                                            const BatonHandle& baton = nullptr) {
+        invariant(minBytes > 0 && minBytes <= buffer.size());
+        std::error_code ec;
+        size_t size = 0;
+
+        if (MONGO_unlikely(transportLayerASIOshortOpportunisticReadWrite.shouldFail()) &&
+            _blockingMode == Async) {
+            do {
+                size = asio::read(stream, asio::mutable_buffer(buffer.data(), 1), ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+
+            if (!ec && minBytes > 1) {
+                ec = asio::error::would_block;
+            }
+        } else {
+            do {
+                size = asio::read(stream, buffer, asio::transfer_at_least(minBytes), ec);
+            } while (ec == asio::error::interrupted);  // retry syscall EINTR
+        }
+
+        if (((ec == asio::error::would_block) || (ec == asio::error::try_again)) &&
+            (_blockingMode == Async)) {
+            // As in opportunisticRead(), part of the buffer may have been filled already.
+            auto asyncBuffer = buffer + size;
+            auto asyncMinBytes = minBytes - size;
+            auto addSize = [size](size_t asyncSize) { return size + asyncSize; };
+
+            if (auto networkingBaton = baton ? baton->networking() : nullptr;
+                networkingBaton && networkingBaton->canWait()) {
+                return networkingBaton->addSession(*this, NetworkingBaton::Type::In)
+                    .onError([](Status error) {
+                        if (ErrorCodes::isShutdownError(error)) {
+                            return Status::OK();
+                        }
+
+                        return error;
+                    })
+                    .then([&stream, asyncBuffer, asyncMinBytes, baton, this] {
+                        return opportunisticReadAtLeast(stream, asyncBuffer, asyncMinBytes, baton);
+                    })
+                    .then(addSize);
+            }
+
+            return asio::async_read(
+                       stream, asyncBuffer, asio::transfer_at_least(asyncMinBytes), UseFuture{})
+                .then(addSize);
+        } else {
+            return futurize(ec, size);
+        }
+    }
+
     /**
      * moreToSend checks the ssl socket after an opportunisticWrite.  If there are still bytes to
      * send, we manually send them off the underlying socket.  Then we hook that up with a future
@@ -846,6 +1008,12 @@ private:
     boost::optional<Milliseconds> _socketTimeout;
 
     GenericSocket _socket;
+
+    // Bytes read past the end of the last message, which begin the next one. Only used once
+    // canReadAhead() holds.
+    static constexpr size_t kReadAheadBytes = 4 * 1024;
+    std::string _readAheadBytes;
+
 #ifdef MONGO_CONFIG_SSL
     boost::optional<asio::ssl::stream<decltype(_socket)>> _sslSocket;
     bool _ranHandshake = false;
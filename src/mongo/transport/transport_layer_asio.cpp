@@ -34,6 +34,7 @@
 #include "mongo/transport/transport_layer_asio.h"
 
 #include <fstream>
+#include <map>
 
 #include <asio.hpp>
 #include <asio/system_timer.hpp>
@@ -323,6 +324,73 @@ private:
     Endpoint _endpoint;
 };
 
+/**
+ * Caches the endpoints which host names resolve to, so that the connections opened to a host in
+ * quick succession don't each wait on a DNS lookup. The system resolver doesn't expose the TTLs of
+ * the records, so entries expire after hostResolutionCacheExpirySecs instead, and the entry of a
+ * host is dropped as soon as connecting to it fails, in case its address changed.
+ */
+class HostResolutionCache {
+public:
+    static constexpr size_t kMaxEntries = 4096;
+
+    static HostResolutionCache& get() {
+        static auto cache = new HostResolutionCache();
+        return *cache;
+    }
+
+    boost::optional<std::vector<WrappedEndpoint>> find(const HostAndPort& peer, bool enableIPv6) {
+        if (gHostResolutionCacheExpirySecs.load() == 0) {
+            return boost::none;
+        }
+
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _entries.find({peer, enableIPv6});
+        if (it == _entries.end()) {
+            return boost::none;
+        }
+        if (it->second.expiry <= Date_t::now()) {
+            _entries.erase(it);
+            return boost::none;
+        }
+        return it->second.endpoints;
+    }
+
+    void insert(const HostAndPort& peer, bool enableIPv6, std::vector<WrappedEndpoint> endpoints) {
+        const auto expirySecs = gHostResolutionCacheExpirySecs.load();
+        if (expirySecs == 0) {
+            return;
+        }
+
+        const auto now = Date_t::now();
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_entries.size() >= kMaxEntries) {
+            for (auto it = _entries.begin(); it != _entries.end();) {
+                it = it->second.expiry <= now ? _entries.erase(it) : std::next(it);
+            }
+            if (_entries.size() >= kMaxEntries) {
+                _entries.clear();
+            }
+        }
+        _entries[{peer, enableIPv6}] = {std::move(endpoints), now + Seconds(expirySecs)};
+    }
+
+    void erase(const HostAndPort& peer) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _entries.erase({peer, false});
+        _entries.erase({peer, true});
+    }
+
+private:
+    struct Entry {
+        std::vector<WrappedEndpoint> endpoints;
+        Date_t expiry;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("HostResolutionCache::_mutex");
+    std::map<std::pair<HostAndPort, bool>, Entry> _entries;
+};
+
 using Resolver = asio::ip::tcp::resolver;
 class WrappedResolver {
 public:
@@ -350,7 +418,15 @@ public:
         // Then, if the numeric (IP address) lookup failed, we fall back to DNS or return the error
         // from the resolver.
         return _resolve(peer, flags | Resolver::numeric_host, enableIPv6)
-            .onError([=](Status) { return _resolve(peer, flags, enableIPv6); })
+            .onError([=](Status) {
+                if (auto cached = HostResolutionCache::get().find(peer, enableIPv6)) {
+                    return Future<EndpointVector>::makeReady(std::move(*cached));
+                }
+                return _resolve(peer, flags, enableIPv6).then([=](EndpointVector endpoints) {
+                    HostResolutionCache::get().insert(peer, enableIPv6, endpoints);
+                    return endpoints;
+                });
+            })
             .getNoThrow();
     }
 
@@ -363,7 +439,13 @@ public:
         // function for setting resolver flags (see above).
         const auto flags = Resolver::numeric_service;
         return _asyncResolve(peer, flags | Resolver::numeric_host, enableIPv6).onError([=](Status) {
-            return _asyncResolve(peer, flags, enableIPv6);
+            if (auto cached = HostResolutionCache::get().find(peer, enableIPv6)) {
+                return Future<EndpointVector>::makeReady(std::move(*cached));
+            }
+            return _asyncResolve(peer, flags, enableIPv6).then([=](EndpointVector endpoints) {
+                HostResolutionCache::get().insert(peer, enableIPv6, endpoints);
+                return endpoints;
+            });
         });
     }
 
@@ -485,6 +567,7 @@ StatusWith<SessionHandle> TransportLayerASIO::connect(
     auto endpoints = std::move(swEndpoints.getValue());
     auto sws = _doSyncConnect(endpoints.front(), peer, timeout, transientSSLParams);
     if (!sws.isOK()) {
+        HostResolutionCache::get().erase(peer);
         return sws.getStatus();
     }
 
@@ -731,6 +814,7 @@ Future<SessionHandle> TransportLayerASIO::asyncConnect(
             return Status::OK();
         })
         .onError([connector](Status status) -> Future<void> {
+            HostResolutionCache::get().erase(connector->peer);
             return makeConnectError(status, connector->peer, connector->resolvedEndpoint);
         })
         .getAsync([connector](Status connectResult) {
@@ -273,15 +273,24 @@ public:
     }
 
     void sendMessage() {
-        OpMsgBuilder builder;
-        builder.setBody(BSON("ping" << 1));
-        Message msg = builder.finish();
-        msg.header().setResponseToMsgId(0);
-        msg.header().setId(0);
-        OpMsg::appendChecksum(&msg);
+        sendMessages({BSON("ping" << 1)});
+    }
+
+    // Sends one message per body with a single write, as a client pipelining requests would.
+    void sendMessages(const std::vector<BSONObj>& bodies) {
+        std::string bytes;
+        for (const auto& body : bodies) {
+            OpMsgBuilder builder;
+            builder.setBody(body);
+            Message msg = builder.finish();
+            msg.header().setResponseToMsgId(0);
+            msg.header().setId(0);
+            OpMsg::appendChecksum(&msg);
+            bytes.append(msg.buf(), msg.size());
+        }
 
         std::error_code ec;
-        asio::write(_sock, asio::buffer(msg.buf(), msg.size()), ec);
+        asio::write(_sock, asio::buffer(bytes.data(), bytes.size()), ec);
         ASSERT_FALSE(ec);
     }
 
@@ -382,5 +391,48 @@ TEST(TransportLayerASIO, SwitchTimeoutModes) {
     tla->shutdown();
 }
 
+/* check that messages sent back to back in one write are each sourced intact */
+class PipelinedSEP : public TimeoutSEP {
+public:
+    explicit PipelinedSEP(std::vector<BSONObj> expected) : _expected(std::move(expected)) {}
+
+    void startSession(transport::SessionHandle session) override {
+        startWorkerThread([this, session = std::move(session)]() mutable {
+            for (const auto& expected : _expected) {
+                auto swMsg = session->sourceMessage();
+                ASSERT_OK(swMsg.getStatus());
+                ASSERT_BSONOBJ_EQ(OpMsg::parse(swMsg.getValue()).body, expected);
+            }
+
+            session.reset();
+            notifyComplete();
+        });
+    }
+
+private:
+    std::vector<BSONObj> _expected;
+};
+
+TEST(TransportLayerASIO, SourcePipelinedMessages) {
+    // Small messages that share a read, followed by one larger than the read-ahead buffer.
+    std::vector<BSONObj> bodies;
+    for (int i = 0; i < 3; i++) {
+        bodies.push_back(BSON("ping" << i));
+    }
+    bodies.push_back(BSON("ping" << 3 << "padding" << std::string(64 * 1024, 'x')));
+    bodies.push_back(BSON("ping" << 4));
+
+    PipelinedSEP sep(bodies);
+    auto tla = makeAndStartTL(&sep);
+
+    // The first message is sourced on its own, as it is checked for a TLS handshake.
+    TimeoutConnector connector(tla->listenerPort(), false);
+    connector.sendMessages({bodies[0]});
+    connector.sendMessages({bodies.begin() + 1, bodies.end()});
+
+    ASSERT_TRUE(sep.waitForTimeout());
+    tla->shutdown();
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <time.h>
+
+#include "mongo/stdx/mutex.h"
+
+namespace mongo {
+namespace stack_trace_detail {
+
+/** Safe to call from a signal handler. Might wake early with EINTR. */
+inline void sleepMicros(int64_t usec) {
+    auto nsec = usec * 1000;
+    constexpr static int64_t k1E9 = 1'000'000'000;
+    timespec ts{nsec / k1E9, nsec % k1E9};
+    nanosleep(&ts, nullptr);
+}
+
+/** Cannot yield. AS-Safe. */
+class SimpleSpinLock {
+public:
+    void lock() {
+        while (true) {
+            for (int i = 0; i < 100; ++i) {
+                if (!_flag.test_and_set(std::memory_order_acquire)) {
+                    return;
+                }
+            }
+            sleepMicros(1);
+        }
+    }
+
+    void unlock() {
+        _flag.clear(std::memory_order_release);
+    }
+
+private:
+    std::atomic_flag _flag = ATOMIC_FLAG_INIT;  // NOLINT
+};
+
+/**
+ * Intrusive stack of `T` nodes linked through `T::intrusiveNext`, which signal handlers can push
+ * to and pop from. A thread must not use a stack from a signal handler which may interrupt its
+ * own use of the same stack, as the handler would spin forever on the lock.
+ */
+template <typename T>
+class AsyncStack {
+public:
+    T* tryPop() {
+        stdx::lock_guard lock{_spin};
+        T* node = _head;
+        if (node) {
+            node = std::exchange(_head, node->intrusiveNext);
+            node->intrusiveNext = nullptr;
+        }
+        return node;
+    }
+
+    void push(T* node) {
+        stdx::lock_guard lock{_spin};
+        node->intrusiveNext = std::exchange(_head, node);
+    }
+
+private:
+    T* _head = nullptr;
+    SimpleSpinLock _spin;  // guards _head
+};
+
+}  // namespace stack_trace_detail
+}  // namespace mongo
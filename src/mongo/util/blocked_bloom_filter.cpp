@@ -0,0 +1,109 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/blocked_bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/util/assert_util.h"
+#include <third_party/murmurhash3/MurmurHash3.h>
+
+namespace mongo {
+namespace {
+
+struct KeyHash {
+    uint64_t block;
+    uint64_t bits;
+};
+
+KeyHash hashKey(const void* data, size_t size) {
+    uint64_t out[2];
+    MurmurHash3_x64_128(data, size, 0, out);
+    return {out[0], out[1]};
+}
+
+/**
+ * Returns the position of the 'probe'-th bit set for a key within its block. Each probe takes 9
+ * bits of the hash, which addresses one of the 512 bits of the block.
+ */
+size_t bitInBlock(uint64_t bits, int probe) {
+    return (bits >> (9 * probe)) & 511;
+}
+
+}  // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(size_t capacity, int bitsPerKey)
+    : _capacity(std::max<size_t>(capacity, 1)) {
+    invariant(bitsPerKey > 0);
+    // The false positive rate of a Bloom filter is lowest with ln(2) probes per bit of each key.
+    _numProbes = std::clamp(static_cast<int>(std::lround(bitsPerKey * 0.69)), 1, kMaxProbes);
+    _numBlocks = std::max<size_t>(
+        (_capacity * static_cast<size_t>(bitsPerKey) + kBitsPerBlock - 1) / kBitsPerBlock, 1);
+    _blocks = std::make_unique<Block[]>(_numBlocks);
+}
+
+const BlockedBloomFilter::Block& BlockedBloomFilter::_blockFor(uint64_t hash) const {
+    return _blocks[hash % _numBlocks];
+}
+
+void BlockedBloomFilter::insert(const void* data, size_t size) {
+    auto hash = hashKey(data, size);
+    auto& block = const_cast<Block&>(_blockFor(hash.block));
+
+    uint64_t masks[kWordsPerBlock] = {};
+    for (int probe = 0; probe < _numProbes; ++probe) {
+        auto bit = bitInBlock(hash.bits, probe);
+        masks[bit / 64] |= uint64_t{1} << (bit % 64);
+    }
+    for (size_t word = 0; word < kWordsPerBlock; ++word) {
+        // Skip the atomic read-modify-write when the bits are already set, which is the common
+        // case for keys that are inserted again.
+        if (masks[word] && (block.words[word].loadRelaxed() & masks[word]) != masks[word]) {
+            block.words[word].fetchAndBitOr(masks[word]);
+        }
+    }
+}
+
+bool BlockedBloomFilter::mayContain(const void* data, size_t size) const {
+    auto hash = hashKey(data, size);
+    const auto& block = _blockFor(hash.block);
+
+    for (int probe = 0; probe < _numProbes; ++probe) {
+        auto bit = bitInBlock(hash.bits, probe);
+        if (!(block.words[bit / 64].load() & (uint64_t{1} << (bit % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace mongo
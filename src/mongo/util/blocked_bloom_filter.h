@@ -0,0 +1,102 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "mongo/platform/atomic_word.h"
+
+namespace mongo {
+
+/**
+ * A fixed-size Bloom filter whose bits are split into cache-line-sized blocks. Each key maps to a
+ * single block and sets or tests several bits within it, so that an insert or a lookup touches
+ * one cache line no matter how many probes it makes.
+ *
+ * The filter never reports a false negative: once insert() of a key returns, mayContain() of that
+ * key on any thread returns true. It does report false positives, at a rate that grows as more
+ * keys than the requested capacity are inserted. There is no way to remove a key.
+ *
+ * insert() and mayContain() may be called concurrently from any number of threads.
+ */
+class BlockedBloomFilter {
+public:
+    /**
+     * Maximum number of bits set in a block for each key.
+     */
+    static constexpr int kMaxProbes = 7;
+
+    /**
+     * Sizes the filter to hold 'capacity' keys using about 'bitsPerKey' bits for each.
+     */
+    BlockedBloomFilter(size_t capacity, int bitsPerKey);
+
+    void insert(const void* data, size_t size);
+
+    /**
+     * Returns false only if the key was never inserted.
+     */
+    bool mayContain(const void* data, size_t size) const;
+
+    size_t capacity() const {
+        return _capacity;
+    }
+
+    size_t numBlocks() const {
+        return _numBlocks;
+    }
+
+    int numProbes() const {
+        return _numProbes;
+    }
+
+    size_t memUsageBytes() const {
+        return _numBlocks * sizeof(Block);
+    }
+
+private:
+    static constexpr size_t kWordsPerBlock = 8;
+    static constexpr size_t kBitsPerBlock = kWordsPerBlock * 64;
+
+    struct alignas(64) Block {
+        AtomicWord<uint64_t> words[kWordsPerBlock];
+    };
+
+    const Block& _blockFor(uint64_t hash) const;
+
+    const size_t _capacity;
+    size_t _numBlocks;
+    int _numProbes;
+    std::unique_ptr<Block[]> _blocks;
+};
+
+}  // namespace mongo
@@ -0,0 +1,131 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <string>
+#include <vector>
+
+#include "mongo/stdx/thread.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/blocked_bloom_filter.h"
+
+namespace mongo {
+namespace {
+
+std::string makeKey(int i) {
+    return "key" + std::to_string(i);
+}
+
+TEST(BlockedBloomFilterTest, ContainsEveryInsertedKey) {
+    BlockedBloomFilter filter(1000, 10);
+    for (int i = 0; i < 1000; ++i) {
+        auto key = makeKey(i);
+        filter.insert(key.data(), key.size());
+    }
+    for (int i = 0; i < 1000; ++i) {
+        auto key = makeKey(i);
+        ASSERT_TRUE(filter.mayContain(key.data(), key.size())) << key;
+    }
+}
+
+TEST(BlockedBloomFilterTest, EmptyFilterContainsNothing) {
+    BlockedBloomFilter filter(1000, 10);
+    for (int i = 0; i < 1000; ++i) {
+        auto key = makeKey(i);
+        ASSERT_FALSE(filter.mayContain(key.data(), key.size())) << key;
+    }
+}
+
+TEST(BlockedBloomFilterTest, FalsePositiveRateAtCapacity) {
+    BlockedBloomFilter filter(10000, 10);
+    for (int i = 0; i < 10000; ++i) {
+        auto key = makeKey(i);
+        filter.insert(key.data(), key.size());
+    }
+
+    int falsePositives = 0;
+    for (int i = 10000; i < 20000; ++i) {
+        auto key = makeKey(i);
+        falsePositives += filter.mayContain(key.data(), key.size());
+    }
+    // An unblocked filter with 10 bits per key has a false positive rate just under 1%. Blocking
+    // costs a little accuracy, so allow for several times that.
+    ASSERT_LT(falsePositives, 500);
+}
+
+TEST(BlockedBloomFilterTest, OverfilledFilterStillContainsEveryInsertedKey) {
+    BlockedBloomFilter filter(10, 4);
+    for (int i = 0; i < 1000; ++i) {
+        auto key = makeKey(i);
+        filter.insert(key.data(), key.size());
+    }
+    for (int i = 0; i < 1000; ++i) {
+        auto key = makeKey(i);
+        ASSERT_TRUE(filter.mayContain(key.data(), key.size())) << key;
+    }
+}
+
+TEST(BlockedBloomFilterTest, Sizing) {
+    BlockedBloomFilter filter(1024, 8);
+    ASSERT_EQ(filter.capacity(), 1024U);
+    ASSERT_EQ(filter.numBlocks(), 16U);
+    ASSERT_EQ(filter.memUsageBytes(), 1024U);
+    ASSERT_EQ(filter.numProbes(), 6);
+
+    BlockedBloomFilter large(10, 32);
+    ASSERT_EQ(large.numProbes(), BlockedBloomFilter::kMaxProbes);
+}
+
+TEST(BlockedBloomFilterTest, ConcurrentInserts) {
+    constexpr int kThreads = 4;
+    constexpr int kKeysPerThread = 2000;
+    BlockedBloomFilter filter(kThreads * kKeysPerThread, 10);
+
+    std::vector<stdx::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < kKeysPerThread; ++i) {
+                auto key = makeKey(t * kKeysPerThread + i);
+                filter.insert(key.data(), key.size());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < kThreads * kKeysPerThread; ++i) {
+        auto key = makeKey(i);
+        ASSERT_TRUE(filter.mayContain(key.data(), key.size())) << key;
+    }
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,100 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+namespace {
+
+// Weight of a new sample in the smoothed latency, and of a new target in the limit.
+constexpr double kSmoothing = 0.2;
+
+// Rate at which the lowest latency observed decays towards the current one, so that it keeps up
+// with changes of the workload.
+constexpr double kMinLatencyDrift = 1.01;
+
+// Bounds of the ratio between the lowest and the current latency.
+constexpr double kMinGradient = 0.5;
+constexpr double kMaxGradient = 1.0;
+
+// The fraction of the limit which must be in use for the limit to grow.
+constexpr double kSaturationRatio = 0.9;
+
+// The factor applied to the limit under cache pressure.
+constexpr double kBackoffRatio = 0.9;
+
+}  // namespace
+
+AdaptiveTicketController::AdaptiveTicketController(int initialLimit, int minLimit, int maxLimit)
+    : _minLimit(minLimit),
+      _maxLimit(maxLimit),
+      _limit(std::clamp(initialLimit, minLimit, maxLimit)) {
+    invariant(0 < minLimit && minLimit <= maxLimit);
+}
+
+int AdaptiveTicketController::update(const Sample& sample) {
+    if (sample.cacheDirtyRatio > kMaxCacheDirtyRatio) {
+        _limit = std::max(_minLimit, static_cast<int>(_limit * kBackoffRatio));
+        return _limit;
+    }
+
+    if (sample.used <= 0 || sample.released <= 0 || sample.elapsed <= Milliseconds(0)) {
+        // Without load there is nothing to learn from.
+        return _limit;
+    }
+
+    double throughput =
+        static_cast<double>(sample.released) / durationCount<Milliseconds>(sample.elapsed);
+    double latency = sample.used / throughput;
+    _latency = _latency ? (1 - kSmoothing) * _latency + kSmoothing * latency : latency;
+    _minLatency = _minLatency ? std::min(_minLatency * kMinLatencyDrift, _latency) : _latency;
+
+    double gradient = std::clamp(_minLatency / _latency, kMinGradient, kMaxGradient);
+    double target = _limit * gradient + std::sqrt(_limit);
+    if (sample.used < _limit * kSaturationRatio) {
+        // The limit is not what holds operations back, so there is no evidence that more
+        // concurrency would help.
+        target = std::min(target, static_cast<double>(_limit));
+    }
+
+    auto limit = std::lround((1 - kSmoothing) * _limit + kSmoothing * target);
+    _limit = std::clamp(static_cast<int>(limit), _minLimit, _maxLimit);
+    return _limit;
+}
+
+}  // namespace mongo
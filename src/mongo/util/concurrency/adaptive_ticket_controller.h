@@ -0,0 +1,91 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * Computes the size of a TicketHolder from periodic samples of its usage, so that the concurrency
+ * it admits follows the load instead of being hand-tuned.
+ *
+ * The latency of operations is estimated with Little's law, as the number of tickets in use divided
+ * by the rate at which tickets are released, and the lowest latency observed stands for the
+ * latency of an uncongested system. While the tickets are saturated, the limit moves towards
+ * 'limit * minLatency / latency + sqrt(limit)', so it grows as long as added concurrency does not
+ * increase latency, and shrinks once operations merely queue up inside the storage engine. A cache
+ * filling up with dirty data overrides the latency signal and shrinks the limit multiplicatively.
+ *
+ * This class is not thread-safe.
+ */
+class AdaptiveTicketController {
+public:
+    struct Sample {
+        // The number of tickets in use when the sample was taken.
+        int used = 0;
+
+        // The number of tickets released since the previous sample.
+        long long released = 0;
+
+        // The time elapsed since the previous sample.
+        Milliseconds elapsed{0};
+
+        // The fraction of the storage engine cache holding dirty data.
+        double cacheDirtyRatio = 0;
+    };
+
+    // Above this fraction of dirty data in the cache, the limit shrinks regardless of latency.
+    static constexpr double kMaxCacheDirtyRatio = 0.15;
+
+    AdaptiveTicketController(int initialLimit, int minLimit, int maxLimit);
+
+    /**
+     * Accounts for 'sample' and returns the new limit.
+     */
+    int update(const Sample& sample);
+
+    int limit() const {
+        return _limit;
+    }
+
+private:
+    const int _minLimit;
+    const int _maxLimit;
+    int _limit;
+
+    // Smoothed latency estimate and the lowest one observed, in milliseconds. Zero until the first
+    // sample with any load.
+    double _latency = 0;
+    double _minLatency = 0;
+};
+
+}  // namespace mongo
@@ -0,0 +1,108 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/concurrency/adaptive_ticket_controller.h"
+
+namespace mongo {
+namespace {
+
+/**
+ * Returns a sample of a second during which 'used' tickets were in use by operations taking
+ * 'latency' each.
+ */
+AdaptiveTicketController::Sample makeSample(int used,
+                                            Milliseconds latency,
+                                            double cacheDirtyRatio = 0) {
+    AdaptiveTicketController::Sample sample;
+    sample.used = used;
+    sample.elapsed = Seconds(1);
+    sample.released = used * durationCount<Milliseconds>(sample.elapsed) /
+        durationCount<Milliseconds>(latency);
+    sample.cacheDirtyRatio = cacheDirtyRatio;
+    return sample;
+}
+
+TEST(AdaptiveTicketControllerTest, GrowsWhileSaturatedAndLatencyIsStable) {
+    AdaptiveTicketController controller(64, 8, 256);
+    for (int i = 0; i < 10; ++i) {
+        auto previous = controller.limit();
+        ASSERT_GT(controller.update(makeSample(controller.limit(), Milliseconds(2))), previous);
+    }
+}
+
+TEST(AdaptiveTicketControllerTest, DoesNotGrowWhenNotSaturated) {
+    AdaptiveTicketController controller(64, 8, 256);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(controller.update(makeSample(16, Milliseconds(2))), 64);
+    }
+}
+
+TEST(AdaptiveTicketControllerTest, ShrinksWhenLatencyIncreases) {
+    AdaptiveTicketController controller(64, 8, 256);
+    controller.update(makeSample(64, Milliseconds(2)));
+    auto limit = controller.limit();
+
+    for (int i = 0; i < 10; ++i) {
+        controller.update(makeSample(controller.limit(), Milliseconds(8)));
+    }
+    ASSERT_LT(controller.limit(), limit);
+}
+
+TEST(AdaptiveTicketControllerTest, ShrinksUnderCachePressure) {
+    AdaptiveTicketController controller(100, 8, 256);
+    ASSERT_EQ(controller.update(makeSample(100, Milliseconds(2), 0.5)), 90);
+    ASSERT_EQ(controller.update(makeSample(0, Milliseconds(2), 0.5)), 81);
+}
+
+TEST(AdaptiveTicketControllerTest, StaysWithinBounds) {
+    AdaptiveTicketController controller(300, 8, 256);
+    ASSERT_EQ(controller.limit(), 256);
+    for (int i = 0; i < 10; ++i) {
+        controller.update(makeSample(controller.limit(), Milliseconds(1)));
+    }
+    ASSERT_EQ(controller.limit(), 256);
+
+    for (int i = 0; i < 100; ++i) {
+        controller.update(makeSample(controller.limit(), Milliseconds(1), 1.0));
+    }
+    ASSERT_EQ(controller.limit(), 8);
+}
+
+TEST(AdaptiveTicketControllerTest, IgnoresIdleSamples) {
+    AdaptiveTicketController controller(64, 8, 256);
+    ASSERT_EQ(controller.update(makeSample(0, Milliseconds(2))), 64);
+    ASSERT_EQ(controller.update({}), 64);
+}
+
+}  // namespace
+}  // namespace mongo
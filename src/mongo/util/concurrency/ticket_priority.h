@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include "mongo/base/string_data.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo {
+
+/**
+ * The priority of an operation waiting for a ticket of a TicketHolder. Waiters of a higher priority
+ * are granted tickets before those of a lower priority, and waiters of the same priority are served
+ * in the order in which they started to wait.
+ */
+enum class TicketPriority {
+    kLow,
+    kNormal,
+    kHigh,
+
+    // Operations which never wait for a ticket: they take one if one is available, and proceed
+    // without one otherwise. To be used sparingly for internal operations which must not be
+    // starved by user operations, such as oplog application.
+    kImmediate,
+};
+
+// The number of priorities for which a TicketHolder keeps a queue of waiters.
+constexpr std::size_t kNumQueuedTicketPriorities =
+    static_cast<std::size_t>(TicketPriority::kHigh) + 1;
+
+inline StringData toString(TicketPriority priority) {
+    switch (priority) {
+        case TicketPriority::kLow:
+            return "low"_sd;
+        case TicketPriority::kNormal:
+            return "normal"_sd;
+        case TicketPriority::kHigh:
+            return "high"_sd;
+        case TicketPriority::kImmediate:
+            return "immediate"_sd;
+    }
+    MONGO_UNREACHABLE;
+}
+
+}  // namespace mongo
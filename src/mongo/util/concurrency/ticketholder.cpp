@@ -33,6 +33,7 @@
 
 #include "mongo/util/concurrency/ticketholder.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "mongo/logv2/log.h"
@@ -40,6 +41,100 @@
 
 namespace mongo {
 
+void TicketHolder::waitForTicket(OperationContext* opCtx, TicketPriority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
+}
+
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      TicketPriority priority) {
+    // Only bypass the queues while nobody waits, so that waiters keep their turn.
+    if (_numQueued.load() == 0 && tryAcquire()) {
+        return true;
+    }
+    return _waitInQueue(opCtx, until, priority);
+}
+
+void TicketHolder::release() {
+    _numReleased.fetchAndAdd(1);
+    _releaseToPool();
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> lk(_queueMutex);
+        _handOffToWaiters(lk);
+    }
+}
+
+void TicketHolder::appendQueueStats(BSONObjBuilder* builder) const {
+    stdx::lock_guard<Latch> lk(_queueMutex);
+    for (std::size_t i = 0; i < kNumQueuedTicketPriorities; ++i) {
+        BSONObjBuilder bb(builder->subobjStart(toString(static_cast<TicketPriority>(i))));
+        bb.append("queued", static_cast<long long>(_queues[i].size()));
+        bb.append("totalQueued", _totalQueued[i]);
+    }
+}
+
+bool TicketHolder::_waitInQueue(OperationContext* opCtx, Date_t until, TicketPriority priority) {
+    invariant(priority != TicketPriority::kImmediate);
+    auto index = static_cast<std::size_t>(priority);
+    auto& queue = _queues[index];
+
+    Waiter waiter;
+    stdx::unique_lock<Latch> lk(_queueMutex);
+    auto it = queue.insert(queue.end(), &waiter);
+    _numQueued.fetchAndAdd(1);
+    ++_totalQueued[index];
+
+    // Tickets released before this waiter got queued may not have been handed off to anybody.
+    _handOffToWaiters(lk);
+
+    auto isGranted = [&] { return waiter.granted; };
+    try {
+        if (opCtx && until == Date_t::max()) {
+            opCtx->waitForConditionOrInterrupt(waiter.cv, lk, isGranted);
+        } else if (opCtx) {
+            opCtx->waitForConditionOrInterruptUntil(waiter.cv, lk, until, isGranted);
+        } else if (until == Date_t::max()) {
+            waiter.cv.wait(lk, isGranted);
+        } else {
+            waiter.cv.wait_until(lk, until.toSystemTimePoint(), isGranted);
+        }
+    } catch (...) {
+        if (waiter.granted) {
+            // The ticket was handed off to us just as we got interrupted.
+            lk.unlock();
+            release();
+        } else {
+            queue.erase(it);
+            _numQueued.subtractAndFetch(1);
+        }
+        throw;
+    }
+
+    if (!waiter.granted) {
+        queue.erase(it);
+        _numQueued.subtractAndFetch(1);
+        return false;
+    }
+    return true;
+}
+
+void TicketHolder::_handOffToWaiters(WithLock) {
+    while (_numQueued.load() > 0) {
+        auto queue = std::find_if(
+            _queues.rbegin(), _queues.rend(), [](const auto& queue) { return !queue.empty(); });
+        invariant(queue != _queues.rend());
+        if (!tryAcquire()) {
+            return;
+        }
+
+        auto waiter = queue->front();
+        queue->pop_front();
+        _numQueued.subtractAndFetch(1);
+        waiter->granted = true;
+        waiter->cv.notify_one();
+    }
+}
+
 #if defined(__linux__)
 namespace {
 
@@ -61,14 +156,6 @@ void check(int ret) {
         return;
     failWithErrno(errno);
 }
-
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
 }  // namespace
 
 TicketHolder::TicketHolder(int num) : _outof(num) {
@@ -89,47 +176,7 @@ bool TicketHolder::tryAcquire() {
     return true;
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
-        return true;
-    }
-
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
-        }
-
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
-    }
-    return true;
-}
-
-void TicketHolder::release() {
+void TicketHolder::_releaseToPool() {
     check(sem_post(&_sem));
 }
 
@@ -146,9 +193,13 @@ Status TicketHolder::resize(int newSize) {
                                     << "; given " << newSize);
 
     while (_outof.load() < newSize) {
-        release();
+        _releaseToPool();
         _outof.fetchAndAdd(1);
     }
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> queueLk(_queueMutex);
+        _handOffToWaiters(queueLk);
+    }
 
     while (_outof.load() > newSize) {
         waitForTicket();
@@ -184,55 +235,33 @@ bool TicketHolder::tryAcquire() {
     return _tryAcquire();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
-}
-
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
-    }
+void TicketHolder::_releaseToPool() {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _num++;
 }
 
-void TicketHolder::release() {
+Status TicketHolder::resize(int newSize) {
     {
         stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
-    }
-    _newTicket.notify_one();
-}
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
+        int used = _outof.load() - _num;
+        if (used > newSize) {
+            std::stringstream ss;
+            ss << "can't resize since we're using (" << used << ") "
+               << "more than newSize(" << newSize << ")";
 
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
+            std::string errmsg = ss.str();
+            LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
+            return Status(ErrorCodes::BadValue, errmsg);
+        }
 
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+        _outof.store(newSize);
+        _num = _outof.load() - used;
     }
 
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
+    // The '_queueMutex' must not be acquired while holding '_mutex'.
+    stdx::lock_guard<Latch> queueLk(_queueMutex);
+    _handOffToWaiters(queueLk);
     return Status::OK();
 }
 
@@ -32,15 +32,27 @@
 #include <semaphore.h>
 #endif
 
+#include <array>
+#include <list>
+
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/ticket_priority.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+/**
+ * A counting semaphore of tickets. Acquisitions which cannot be satisfied right away wait in a
+ * queue per TicketPriority, and released tickets are handed off to the oldest waiter of the highest
+ * priority. While operations are queued, new acquisitions queue behind them rather than compete for
+ * released tickets.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -49,6 +61,9 @@ public:
     explicit TicketHolder(int num);
     ~TicketHolder();
 
+    /**
+     * Attempts to acquire a ticket without waiting, regardless of the operations queued for one.
+     */
     bool tryAcquire();
 
     /**
@@ -56,7 +71,7 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx, TicketPriority priority = TicketPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,7 +83,9 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            TicketPriority priority = TicketPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
@@ -82,7 +99,45 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of tickets released since the construction of this TicketHolder, used to
+     * measure the throughput of the operations it admits.
+     */
+    long long numReleased() const {
+        return _numReleased.load();
+    }
+
+    /**
+     * Appends, for each priority, the number of operations currently waiting for a ticket and the
+     * total number of operations which had to wait for one.
+     */
+    void appendQueueStats(BSONObjBuilder* builder) const;
+
 private:
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool granted = false;
+    };
+
+    bool _waitInQueue(OperationContext* opCtx, Date_t until, TicketPriority priority);
+
+    // Returns a ticket to the pool, without handing it off to a waiter.
+    void _releaseToPool();
+
+    // Hands tickets off from the pool to the queued waiters, for as long as there are both.
+    void _handOffToWaiters(WithLock);
+
+    AtomicWord<long long> _numReleased{0};
+
+    // The number of waiters in '_queues', which can be read without a lock to skip the queues
+    // entirely while nobody waits.
+    AtomicWord<int> _numQueued{0};
+
+    // Protects '_queues' and '_totalQueued'. Must not be acquired while holding the mutexes below.
+    mutable Mutex _queueMutex = MONGO_MAKE_LATCH("TicketHolder::_queueMutex");
+    std::array<std::list<Waiter*>, kNumQueuedTicketPriorities> _queues;
+    std::array<long long, kNumQueuedTicketPriorities> _totalQueued{};
+
 #if defined(__linux__)
     mutable sem_t _sem;
 
@@ -96,7 +151,6 @@ private:
     AtomicWord<int> _outof;
     int _num;
     Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
 #endif
 };
 
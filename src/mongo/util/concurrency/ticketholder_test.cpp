@@ -32,8 +32,10 @@
 
 #include "mongo/platform/basic.h"
 
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -71,5 +73,58 @@ TEST(TicketholderTest, BasicTimeout) {
     ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(2)));
     holder.release();
     ASSERT_EQ(holder.used(), 0);
+    ASSERT_EQ(holder.numReleased(), 3);
+}
+
+int numQueued(const TicketHolder& holder, StringData priority) {
+    BSONObjBuilder builder;
+    holder.appendQueueStats(&builder);
+    return builder.obj()[priority]["queued"].numberInt();
+}
+
+TEST(TicketholderTest, WaitersAreServedByPriorityThenInOrder) {
+    TicketHolder holder(1);
+    holder.waitForTicket();
+
+    auto mutex = MONGO_MAKE_LATCH();
+    std::vector<int> order;
+    std::vector<stdx::thread> threads;
+    auto startWaiter = [&](TicketPriority priority, int id) {
+        auto queuedBefore = numQueued(holder, toString(priority));
+        threads.emplace_back([&, priority, id] {
+            holder.waitForTicket(nullptr, priority);
+            {
+                stdx::lock_guard lk(mutex);
+                order.push_back(id);
+            }
+            holder.release();
+        });
+        while (numQueued(holder, toString(priority)) == queuedBefore) {
+            sleepmillis(1);
+        }
+    };
+
+    startWaiter(TicketPriority::kLow, 1);
+    startWaiter(TicketPriority::kNormal, 2);
+    startWaiter(TicketPriority::kLow, 3);
+    startWaiter(TicketPriority::kHigh, 4);
+
+    // Newcomers queue behind the waiters rather than take released tickets.
+    ASSERT_FALSE(holder.waitForTicketUntil(Date_t::now() + Milliseconds(1)));
+
+    holder.release();
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+    ASSERT(order == std::vector<int>({4, 2, 1, 3}));
+    ASSERT_EQ(holder.used(), 0);
+
+    BSONObjBuilder builder;
+    holder.appendQueueStats(&builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["low"]["queued"].numberInt(), 0);
+    ASSERT_EQ(stats["low"]["totalQueued"].numberInt(), 2);
+    ASSERT_EQ(stats["normal"]["totalQueued"].numberInt(), 2);
+    ASSERT_EQ(stats["high"]["totalQueued"].numberInt(), 1);
 }
 }  // namespace
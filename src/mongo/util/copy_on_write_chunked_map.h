@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "mongo/stdx/unordered_map.h"
+
+namespace mongo {
+
+/**
+ * A hash map that is cheap to copy and to modify after copying. The entries are spread over a
+ * fixed number of chunks, each a separately allocated hash map shared between copies. Copying
+ * the map only copies the pointers to the chunks, and a modification only copies the one chunk
+ * it touches if that chunk is still shared with another copy. For n entries a copy followed by a
+ * modification therefore costs O(kNumChunks + n / kNumChunks) instead of O(n).
+ *
+ * Meant for structures that are published as immutable snapshots and rebuilt by copying the
+ * previous snapshot, like the CollectionCatalog. A single instance is not thread safe, but
+ * different copies sharing chunks may be used concurrently, as long as every copy that is
+ * modified is only accessible from one thread.
+ */
+template <typename Key,
+          typename Value,
+          typename Hasher = DefaultHasher<Key>,
+          size_t kNumChunks = 256>
+class CopyOnWriteChunkedMap {
+public:
+    using Chunk = stdx::unordered_map<Key, Value, Hasher>;
+
+    /**
+     * Returns a pointer to the value for 'key', or nullptr if there is none. The pointer is
+     * invalidated by the next modification of this map.
+     */
+    const Value* find(const Key& key) const {
+        const auto& chunk = _chunks[_chunkIndex(key)];
+        if (!chunk) {
+            return nullptr;
+        }
+        auto it = chunk->find(key);
+        return it == chunk->end() ? nullptr : &it->second;
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != nullptr;
+    }
+
+    /**
+     * Returns a reference to the value for 'key', value-initializing it first if there is none.
+     * The reference is invalidated by the next modification of this map.
+     */
+    Value& getOrCreate(const Key& key) {
+        auto [it, inserted] = _mutableChunk(_chunkIndex(key)).try_emplace(key);
+        if (inserted) {
+            _size++;
+        }
+        return it->second;
+    }
+
+    /**
+     * Removes the entry for 'key', if any. Returns whether there was one.
+     */
+    bool erase(const Key& key) {
+        const auto index = _chunkIndex(key);
+        if (!_chunks[index] || !_chunks[index]->count(key)) {
+            return false;
+        }
+        _mutableChunk(index).erase(key);
+        _size--;
+        return true;
+    }
+
+    void clear() {
+        for (auto& chunk : _chunks) {
+            chunk.reset();
+        }
+        _size = 0;
+    }
+
+    size_t size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Calls 'fn' with the key and value of every entry, in no particular order.
+     */
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& chunk : _chunks) {
+            if (chunk) {
+                for (const auto& [key, value] : *chunk) {
+                    fn(key, value);
+                }
+            }
+        }
+    }
+
+private:
+    size_t _chunkIndex(const Key& key) const {
+        // The hash map of each chunk uses the low bits of the hash, so pick the chunk with high
+        // bits. Otherwise all the keys in a chunk would have the same low bits and collide.
+        const uint64_t hash = typename Chunk::hasher()(key);
+        return (hash >> 32) % kNumChunks;
+    }
+
+    /**
+     * Returns the chunk at 'index', first copying it if another map shares it. Sharing is only
+     * created by copying this map, which cannot happen concurrently with a modification, so a
+     * use count of one cannot go up behind our back.
+     */
+    Chunk& _mutableChunk(size_t index) {
+        auto& chunk = _chunks[index];
+        if (!chunk) {
+            chunk = std::make_shared<Chunk>();
+        } else if (chunk.use_count() > 1) {
+            chunk = std::make_shared<Chunk>(*chunk);
+        }
+        return *chunk;
+    }
+
+    std::array<std::shared_ptr<Chunk>, kNumChunks> _chunks;
+    size_t _size = 0;
+};
+
+}  // namespace mongo
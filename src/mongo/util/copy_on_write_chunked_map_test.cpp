@@ -0,0 +1,112 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/copy_on_write_chunked_map.h"
+
+#include <string>
+
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Map = CopyOnWriteChunkedMap<int, std::string, DefaultHasher<int>, 8>;
+
+TEST(CopyOnWriteChunkedMapTest, InsertFindErase) {
+    Map map;
+    ASSERT_TRUE(map.empty());
+    ASSERT_EQ(map.find(1), nullptr);
+
+    map.getOrCreate(1) = "one";
+    map.getOrCreate(2) = "two";
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), "one");
+    ASSERT_TRUE(map.contains(2));
+
+    // Looking up an existing key does not insert.
+    map.getOrCreate(1) = "uno";
+    ASSERT_EQ(map.size(), 2U);
+    ASSERT_EQ(*map.find(1), "uno");
+
+    ASSERT_TRUE(map.erase(1));
+    ASSERT_FALSE(map.erase(1));
+    ASSERT_FALSE(map.contains(1));
+    ASSERT_EQ(map.size(), 1U);
+
+    map.clear();
+    ASSERT_TRUE(map.empty());
+    ASSERT_FALSE(map.contains(2));
+}
+
+TEST(CopyOnWriteChunkedMapTest, ModifyingCopyLeavesOriginalUnchanged) {
+    Map original;
+    for (int i = 0; i < 100; ++i) {
+        original.getOrCreate(i) = std::to_string(i);
+    }
+
+    Map copy = original;
+    copy.getOrCreate(0) = "changed";
+    copy.getOrCreate(100) = "100";
+    ASSERT_TRUE(copy.erase(50));
+    ASSERT_EQ(copy.size(), 100U);
+
+    ASSERT_EQ(original.size(), 100U);
+    ASSERT_EQ(*original.find(0), "0");
+    ASSERT_FALSE(original.contains(100));
+    ASSERT_EQ(*original.find(50), "50");
+
+    ASSERT_EQ(*copy.find(0), "changed");
+    ASSERT_EQ(*copy.find(1), "1");
+    ASSERT_FALSE(copy.contains(50));
+
+    copy.clear();
+    ASSERT_EQ(original.size(), 100U);
+}
+
+TEST(CopyOnWriteChunkedMapTest, ForEachVisitsEveryEntry) {
+    Map map;
+    for (int i = 0; i < 100; ++i) {
+        map.getOrCreate(i) = std::to_string(i);
+    }
+
+    int sum = 0;
+    size_t count = 0;
+    map.forEach([&](int key, const std::string& value) {
+        ASSERT_EQ(value, std::to_string(key));
+        sum += key;
+        ++count;
+    });
+    ASSERT_EQ(count, 100U);
+    ASSERT_EQ(sum, 99 * 100 / 2);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,416 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kControl
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/cpu_profiler.h"
+
+#include <atomic>
+
+#include "mongo/util/stacktrace.h"
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <signal.h>
+#include <sstream>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <vector>
+
+#include "mongo/logv2/log.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/thread.h"
+#include "mongo/util/async_stack.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/concurrency/with_lock.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/scopeguard.h"
+#include "mongo/util/str.h"
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+namespace mongo {
+
+namespace {
+
+// Read by the signal handler, which interrupts the thread that sets it, so it does not need to be
+// atomic.
+thread_local const std::string* currentOperationType = nullptr;
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+// Number of samples which can wait for the background thread at once. At the default period this
+// lasts for about ten seconds of a fully loaded CPU, so it only runs out when the background thread
+// is starved.
+constexpr size_t kMaxPendingSamples = 1024;
+
+// How often the background thread aggregates the pending samples.
+constexpr Milliseconds kAggregationInterval{10};
+
+struct Sample {
+    Sample* intrusiveNext = nullptr;
+    const std::string* operationType = nullptr;
+    void* interruptedAddr = nullptr;
+    size_t size = 0;
+    std::array<void*, kStackTraceFrameMax> addrs;
+};
+
+/**
+ * Returns the address of the instruction that the signal with 'context' interrupted, or null if
+ * it is not known on this architecture.
+ */
+void* getInterruptedAddr(void* context) {
+    auto uc = static_cast<ucontext_t*>(context);
+#if defined(__x86_64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.pc);
+#elif defined(__powerpc64__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.regs->nip);
+#elif defined(__s390x__)
+    return reinterpret_cast<void*>(uc->uc_mcontext.psw.addr);
+#else
+    return nullptr;
+#endif
+}
+
+timeval toTimeval(Microseconds duration) {
+    auto micros = durationCount<Microseconds>(duration);
+    return timeval{static_cast<time_t>(micros / 1'000'000),
+                   static_cast<suseconds_t>(micros % 1'000'000)};
+}
+
+class CPUProfilerImpl final : public CPUProfiler {
+public:
+    CPUProfilerImpl() : _sampleStorage(kMaxPendingSamples) {
+        for (auto& sample : _sampleStorage) {
+            _freeSamples.push(&sample);
+        }
+    }
+
+    Status start(Microseconds period) override;
+    Status stop() override;
+    Stats getStats() const override;
+    std::string exportPprof(boost::optional<StringData> operationType) const override;
+
+    /**
+     * Records a sample of the calling thread. AS-safe.
+     */
+    void onSignal(void* context);
+
+private:
+    using Stack = std::vector<void*>;
+    using ProfileKey = std::pair<const std::string*, Stack>;
+
+    /**
+     * Body of the background thread, which aggregates the pending samples until the profiler
+     * stops.
+     */
+    void _aggregateLoop();
+
+    void _aggregatePendingSamples(WithLock);
+
+    // Backing storage for the samples, which are always on one of the two stacks below or being
+    // filled in by a signal handler.
+    std::vector<Sample> _sampleStorage;
+
+    // The signal handlers pop samples from _freeSamples and push them to _pendingSamples once they
+    // are filled in. The background thread aggregates them and pushes them back. These stacks are
+    // only ever used by the signal handlers and by the background thread, which blocks the signal.
+    stack_trace_detail::AsyncStack<Sample> _freeSamples;
+    stack_trace_detail::AsyncStack<Sample> _pendingSamples;
+
+    AtomicWord<long long> _droppedSamples{0};
+
+    // Serializes start() and stop().
+    Mutex _controlMutex = MONGO_MAKE_LATCH("CPUProfilerImpl::_controlMutex");
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("CPUProfilerImpl::_mutex");
+    stdx::condition_variable _stopCV;
+
+    // Guarded by _mutex.
+    bool _running = false;
+    Microseconds _period{0};
+    std::map<ProfileKey, long long> _profile;
+
+    bool _signalActionInstalled = false;
+    stdx::thread _aggregator;
+};
+
+CPUProfilerImpl* profilerForSignalAction = nullptr;
+
+extern "C" void cpuProfilerSignalAction(int, siginfo_t*, void* context) {
+    profilerForSignalAction->onSignal(context);
+}
+
+Status CPUProfilerImpl::start(Microseconds period) {
+    stdx::lock_guard<Latch> controlLk(_controlMutex);
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (_running) {
+            return Status(ErrorCodes::IllegalOperation, "The CPU profiler is already running");
+        }
+    }
+
+    if (!_signalActionInstalled) {
+        profilerForSignalAction = this;
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sigemptyset(&sa.sa_mask);
+        sa.sa_sigaction = cpuProfilerSignalAction;
+        sa.sa_flags = SA_SIGINFO | SA_ONSTACK | SA_RESTART;
+        if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+            int savedErr = errno;
+            return Status(ErrorCodes::InternalError,
+                          str::stream() << "Failed to install the CPU profiler signal action: "
+                                        << errnoWithDescription(savedErr));
+        }
+        _signalActionInstalled = true;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _profile.clear();
+        _droppedSamples.store(0);
+        _period = period;
+        _running = true;
+    }
+    _aggregator = stdx::thread([this] { _aggregateLoop(); });
+
+    itimerval timer;
+    timer.it_interval = toTimeval(period);
+    timer.it_value = toTimeval(period);
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+        int savedErr = errno;
+        {
+            stdx::lock_guard<Latch> lk(_mutex);
+            _running = false;
+            _stopCV.notify_all();
+        }
+        _aggregator.join();
+        return Status(ErrorCodes::InternalError,
+                      str::stream() << "Failed to start the CPU profiler timer: "
+                                    << errnoWithDescription(savedErr));
+    }
+
+    LOGV2(5963000, "Started the CPU profiler", "period"_attr = period);
+    return Status::OK();
+}
+
+Status CPUProfilerImpl::stop() {
+    stdx::lock_guard<Latch> controlLk(_controlMutex);
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!_running) {
+            return Status(ErrorCodes::IllegalOperation, "The CPU profiler is not running");
+        }
+    }
+
+    itimerval timer{};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _running = false;
+        _stopCV.notify_all();
+    }
+    _aggregator.join();
+
+    LOGV2(5963001, "Stopped the CPU profiler");
+    return Status::OK();
+}
+
+void CPUProfilerImpl::onSignal(void* context) {
+    const auto errnoGuard = makeGuard([e = errno] { errno = e; });
+
+    Sample* sample = _freeSamples.tryPop();
+    if (!sample) {
+        _droppedSamples.fetchAndAdd(1);
+        return;
+    }
+
+    sample->operationType = currentOperationType;
+    sample->interruptedAddr = getInterruptedAddr(context);
+    sample->size = rawBacktrace(sample->addrs.data(), sample->addrs.size());
+    _pendingSamples.push(sample);
+}
+
+void CPUProfilerImpl::_aggregateLoop() {
+    setThreadName("CPUProfiler");
+
+    // A signal handler interrupting this thread while it holds the lock of one of the sample
+    // stacks would spin forever.
+    sigset_t sigset;
+    sigemptyset(&sigset);
+    sigaddset(&sigset, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    while (true) {
+        _stopCV.wait_for(lk, kAggregationInterval.toSystemDuration(), [&] { return !_running; });
+        _aggregatePendingSamples(lk);
+        if (!_running) {
+            return;
+        }
+    }
+}
+
+void CPUProfilerImpl::_aggregatePendingSamples(WithLock) {
+    while (Sample* sample = _pendingSamples.tryPop()) {
+        auto begin = sample->addrs.begin();
+        auto end = begin + sample->size;
+
+        // Skip the frames of the signal handler, which are above the interrupted frame.
+        if (auto interrupted = std::find(begin, end, sample->interruptedAddr); interrupted != end) {
+            begin = interrupted;
+        }
+
+        if (begin != end) {
+            ++_profile[{sample->operationType, Stack(begin, end)}];
+        }
+        _freeSamples.push(sample);
+    }
+}
+
+CPUProfiler::Stats CPUProfilerImpl::getStats() const {
+    stdx::lock_guard<Latch> lk(_mutex);
+
+    Stats stats;
+    stats.running = _running;
+    stats.period = _period;
+    stats.droppedSamples = _droppedSamples.load();
+    for (const auto& [key, count] : _profile) {
+        stats.samples += count;
+        stats.samplesByOperationType[key.first ? *key.first : kNoOperationType.toString()] +=
+            count;
+    }
+    return stats;
+}
+
+std::string CPUProfilerImpl::exportPprof(boost::optional<StringData> operationType) const {
+    std::map<Stack, long long> stacks;
+    long long periodMicros;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        periodMicros = durationCount<Microseconds>(_period);
+        for (const auto& [key, count] : _profile) {
+            if (operationType &&
+                *operationType != (key.first ? StringData(*key.first) : kNoOperationType)) {
+                continue;
+            }
+            stacks[key.second] += count;
+        }
+    }
+
+    // See https://gperftools.github.io/gperftools/cpuprofile-fileformat.html for the format, in
+    // which every slot is a machine word.
+    std::string out;
+    auto appendSlot = [&](uintptr_t slot) {
+        out.append(reinterpret_cast<const char*>(&slot), sizeof(slot));
+    };
+
+    // Header: header count, header words, version, sampling period in microseconds, padding.
+    appendSlot(0);
+    appendSlot(3);
+    appendSlot(0);
+    appendSlot(periodMicros);
+    appendSlot(0);
+
+    // Records: sample count, number of frames, frames from innermost to outermost.
+    for (const auto& [stack, count] : stacks) {
+        appendSlot(count);
+        appendSlot(stack.size());
+        for (void* addr : stack) {
+            appendSlot(reinterpret_cast<uintptr_t>(addr));
+        }
+    }
+
+    // Trailer.
+    appendSlot(0);
+    appendSlot(1);
+    appendSlot(0);
+
+    // The memory map lets pprof map the addresses back to the binary and shared libraries.
+    std::ifstream maps("/proc/self/maps");
+    std::ostringstream mapsText;
+    mapsText << maps.rdbuf();
+    out += mapsText.str();
+
+    return out;
+}
+
+#else  // !defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+class CPUProfilerImpl final : public CPUProfiler {
+public:
+    Status start(Microseconds period) override {
+        return Status(ErrorCodes::InternalErrorNotSupported,
+                      "The CPU profiler is not supported on this platform");
+    }
+
+    Status stop() override {
+        return Status(ErrorCodes::IllegalOperation, "The CPU profiler is not running");
+    }
+
+    Stats getStats() const override {
+        return {};
+    }
+
+    std::string exportPprof(boost::optional<StringData> operationType) const override {
+        return {};
+    }
+};
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+}  // namespace
+
+void CPUProfiler::setOperationType(const std::string* operationType) {
+    currentOperationType = operationType;
+    // Keep the compiler from moving the assignment past code that a signal may interrupt.
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+CPUProfiler* CPUProfiler::get() {
+    static CPUProfilerImpl* profiler = new CPUProfilerImpl();
+    return profiler;
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <map>
+#include <string>
+
+#include "mongo/base/status.h"
+#include "mongo/base/string_data.h"
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * Sampling on-CPU profiler.
+ *
+ * While the profiler runs, the kernel sends SIGPROF to the process for every period of CPU time
+ * consumed by its threads (see setitimer(ITIMER_PROF)), and delivers it to a thread which is
+ * running. The signal handler records the backtrace of that thread along with the type of the
+ * operation the thread is running, and a background thread aggregates the recorded samples by
+ * operation type and stack.
+ *
+ * The profiler is only available when MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS is defined, as that is
+ * when rawBacktrace is AS-safe. Elsewhere, start() fails.
+ */
+class CPUProfiler {
+public:
+    /**
+     * Type reported for the samples of threads which are not running an operation.
+     */
+    static constexpr StringData kNoOperationType = "none"_sd;
+
+    struct Stats {
+        bool running = false;
+        Microseconds period{0};
+        long long samples = 0;
+
+        // Samples which could not be recorded because the background thread fell behind.
+        long long droppedSamples = 0;
+
+        std::map<std::string, long long> samplesByOperationType;
+    };
+
+    /**
+     * Attributes the samples taken on the calling thread to 'operationType' until the next call,
+     * or to kNoOperationType if it is null. 'operationType' must outlive every profile, e.g. the
+     * name of a registered command.
+     */
+    static void setOperationType(const std::string* operationType);
+
+    static CPUProfiler* get();
+
+    virtual ~CPUProfiler() = default;
+
+    /**
+     * Discards the current profile and starts sampling every 'period' of CPU time.
+     */
+    virtual Status start(Microseconds period) = 0;
+
+    /**
+     * Stops sampling. The profile is kept until the next call to start().
+     */
+    virtual Status stop() = 0;
+
+    virtual Stats getStats() const = 0;
+
+    /**
+     * Returns the samples of 'operationType', or of every operation type if none, in the legacy
+     * binary CPU profile format which pprof reads, followed by the memory map of the process.
+     */
+    virtual std::string exportPprof(boost::optional<StringData> operationType) const = 0;
+
+protected:
+    CPUProfiler() = default;
+};
+
+}  // namespace mongo
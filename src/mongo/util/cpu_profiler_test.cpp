@@ -0,0 +1,117 @@
+/**
+ *    Copyright (C) 2021-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/util/cpu_profiler.h"
+
+#include <cstring>
+
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/stacktrace.h"
+#include "mongo/util/timer.h"
+
+namespace mongo {
+namespace {
+
+#if defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+uintptr_t readSlot(const std::string& profile, size_t index) {
+    uintptr_t slot;
+    ASSERT_GTE(profile.size(), (index + 1) * sizeof(slot));
+    memcpy(&slot, profile.data() + index * sizeof(slot), sizeof(slot));
+    return slot;
+}
+
+TEST(CPUProfilerTest, SamplesAreAttributedToOperationType) {
+    static const std::string kOperationType = "cpuProfilerTest";
+    auto profiler = CPUProfiler::get();
+
+    ASSERT_OK(profiler->start(Microseconds(1000)));
+    ASSERT_EQ(profiler->start(Microseconds(1000)), ErrorCodes::IllegalOperation);
+
+    // Burn CPU until enough samples have been taken, which should take around 50ms.
+    CPUProfiler::setOperationType(&kOperationType);
+    volatile uint64_t sink = 0;
+    Timer timer;
+    while (profiler->getStats().samplesByOperationType[kOperationType] < 50 &&
+           timer.seconds() < 60) {
+        for (int i = 0; i < 1'000'000; ++i) {
+            sink = sink + i;
+        }
+    }
+    CPUProfiler::setOperationType(nullptr);
+
+    ASSERT_OK(profiler->stop());
+    ASSERT_EQ(profiler->stop(), ErrorCodes::IllegalOperation);
+
+    auto stats = profiler->getStats();
+    ASSERT_FALSE(stats.running);
+    ASSERT_EQ(stats.period, Microseconds(1000));
+    ASSERT_GTE(stats.samplesByOperationType[kOperationType], 50);
+    ASSERT_GTE(stats.samples, stats.samplesByOperationType[kOperationType]);
+
+    // The profile holds the header, the records and the trailer, followed by the memory map.
+    auto profile = profiler->exportPprof(StringData(kOperationType));
+    ASSERT_EQ(readSlot(profile, 0), 0U);
+    ASSERT_EQ(readSlot(profile, 1), 3U);
+    ASSERT_EQ(readSlot(profile, 2), 0U);
+    ASSERT_EQ(readSlot(profile, 3), 1000U);
+
+    size_t index = 5;
+    long long samples = 0;
+    while (readSlot(profile, index) != 0) {
+        auto count = readSlot(profile, index);
+        auto depth = readSlot(profile, index + 1);
+        ASSERT_GT(depth, 0U);
+        samples += count;
+        index += 2 + depth;
+    }
+    ASSERT_EQ(samples, stats.samplesByOperationType[kOperationType]);
+    ASSERT_EQ(readSlot(profile, index + 1), 1U);
+    ASSERT_EQ(readSlot(profile, index + 2), 0U);
+    ASSERT_NE(profile.find("r-xp", index * sizeof(uintptr_t)), std::string::npos);
+
+    // Restarting the profiler discards the previous profile.
+    ASSERT_OK(profiler->start(Microseconds(1000)));
+    ASSERT_OK(profiler->stop());
+    ASSERT_EQ(profiler->getStats().samplesByOperationType[kOperationType], 0);
+}
+
+#else  // !defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+TEST(CPUProfilerTest, NotSupported) {
+    ASSERT_EQ(CPUProfiler::get()->start(Microseconds(1000)),
+              ErrorCodes::InternalErrorNotSupported);
+}
+
+#endif  // defined(MONGO_STACKTRACE_CAN_DUMP_ALL_THREADS)
+
+}  // namespace
+}  // namespace mongo
@@ -548,6 +548,48 @@ Future(T)->Future<T>;
 template <typename T>
 Future(StatusWith<T>)->Future<T>;
 
+namespace future_details {
+/**
+ * Lets an ExecutorFuture continuation run inline, rather than being scheduled again, when the
+ * continuation before it in the chain completes on the same executor. This only applies while the
+ * result of that continuation is being set, and not while the user callback runs, so that a
+ * callback which completes some other promise while holding a lock doesn't run continuations under
+ * it. The depth of inline runs is bounded, so that long chains still unwind through the executor.
+ */
+class ExecutorContinuationScope {
+public:
+    static constexpr int kMaxInlineDepth = 16;
+
+    /**
+     * Marks this thread as running a continuation on 'exec'. A null 'exec' suspends inline runs.
+     */
+    explicit ExecutorContinuationScope(const OutOfLineExecutor* exec)
+        : _prevExec(_exec), _prevDepth(_depth) {
+        _depth = exec && exec == _exec ? _depth + 1 : 0;
+        _exec = exec;
+    }
+
+    ~ExecutorContinuationScope() {
+        _exec = _prevExec;
+        _depth = _prevDepth;
+    }
+
+    ExecutorContinuationScope(const ExecutorContinuationScope&) = delete;
+    ExecutorContinuationScope& operator=(const ExecutorContinuationScope&) = delete;
+
+    static bool canRunInline(const OutOfLineExecutor* exec) {
+        return exec == _exec && _depth < kMaxInlineDepth;
+    }
+
+private:
+    static inline thread_local const OutOfLineExecutor* _exec = nullptr;
+    static inline thread_local int _depth = 0;
+
+    const OutOfLineExecutor* const _prevExec;
+    const int _prevDepth;
+};
+}  // namespace future_details
+
 /**
  * An ExecutorFuture is like a Future that ensures that all callbacks are run on a supplied
  * executor.
@@ -636,6 +678,11 @@ public:
             exec = std::move(_exec),  // Unlike wrapCB this can move because we won't need it later.
             func = std::forward<Func>(func)
         ](StatusOrStatusWith<T> arg) mutable noexcept {
+            if (future_details::ExecutorContinuationScope::canRunInline(exec.get())) {
+                future_details::ExecutorContinuationScope noInlineRuns(nullptr);
+                func(std::move(arg));
+                return;
+            }
             exec->schedule([ func = std::move(func),
                              arg = std::move(arg) ](Status execStatus) mutable noexcept {
                 if (execStatus.isOK())
@@ -1230,14 +1277,17 @@ MONGO_COMPILER_NOINLINE auto ExecutorFuture<T>::wrapCBHelper(unique_function<Sig
         auto [promise, future] = makePromiseFuture<
             UnwrappedType<decltype(func(std::forward<decltype(args)>(args)...))>>();
 
-        exec->schedule([
+        auto task = [
             promise = std::move(promise),
             func = std::move(func),
+            rawExec = exec.get(),
             argsT =
                 std::tuple<std::decay_t<decltype(args)>...>(std::forward<decltype(args)>(args)...)
         ](Status execStatus) mutable noexcept {
             if (execStatus.isOK()) {
+                ExecutorContinuationScope scope(rawExec);
                 promise.setWith([&] {
+                    ExecutorContinuationScope noInlineRuns(nullptr);
                     return [&](auto nullary) {
                         // Using a lambda taking a nullary lambda here to work around an MSVC2017
                         // bug that caused it to not ignore the other side of the constexpr-if.
@@ -1254,7 +1304,13 @@ MONGO_COMPILER_NOINLINE auto ExecutorFuture<T>::wrapCBHelper(unique_function<Sig
             } else {
                 promise.setError(std::move(execStatus));
             }
-        });
+        };
+
+        if (ExecutorContinuationScope::canRunInline(exec.get())) {
+            task(Status::OK());
+        } else {
+            exec->schedule(std::move(task));
+        }
 
         return std::move(future);
     };
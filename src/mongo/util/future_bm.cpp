@@ -199,6 +199,30 @@ void BM_futureInt4xDeferredThenChained(benchmark::State& state) {
 }
 
 
+class InlineExecutor final : public OutOfLineExecutor {
+public:
+    void schedule(Task task) override {
+        task(Status::OK());
+    }
+};
+
+void BM_executorFutureInt4xDeferredThenChained(benchmark::State& state) {
+    auto exec = std::make_shared<InlineExecutor>();
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto pf = makePromiseFuture<int>();
+        auto fut = std::move(pf.future)
+                       .thenRunOn(exec)
+                       .then([](int i) { return i + 1; })
+                       .then([](int i) { return i + 1; })
+                       .then([](int i) { return i + 1; })
+                       .then([](int i) { return i + 1; });
+        pf.promise.emplaceValue(1);
+        benchmark::DoNotOptimize(std::move(fut).get());
+    }
+}
+
+
 BENCHMARK(BM_plainIntReady);
 BENCHMARK(BM_futureIntReady);
 BENCHMARK(BM_futureIntReadyThen);
@@ -212,5 +236,6 @@ BENCHMARK(BM_futureInt3xDeferredThenNested);
 BENCHMARK(BM_futureInt3xDeferredThenChained);
 BENCHMARK(BM_futureInt4xDeferredThenNested);
 BENCHMARK(BM_futureInt4xDeferredThenChained);
+BENCHMARK(BM_executorFutureInt4xDeferredThenChained);
 
 }  // namespace mongo
@@ -30,8 +30,10 @@
 #pragma once
 
 #include <boost/intrusive_ptr.hpp>
+#include <array>
 #include <boost/optional.hpp>
 #include <forward_list>
+#include <new>
 #include <type_traits>
 
 #include "mongo/base/checked_cast.h"
@@ -359,10 +361,128 @@ enum class SSBState : uint8_t {
     kFinished,
 };
 
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define MONGO_FUTURE_SHARED_STATE_POOL_DISABLED
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define MONGO_FUTURE_SHARED_STATE_POOL_DISABLED
+#endif
+
+/**
+ * Recycles the memory of SharedStates through per-thread free lists, one for each allocation size
+ * rounded up to kGranularity, so that making a promise or chaining a continuation usually doesn't
+ * go to the allocator. A block goes back to the list of the thread which frees it, whichever
+ * thread allocated it, and each list keeps at most kMaxCachedPerSize blocks. The pool is disabled
+ * under the sanitizers, so that they keep seeing every allocation.
+ */
+class SharedStateAllocator {
+public:
+    static constexpr size_t kGranularity = 16;
+    static constexpr size_t kMaxPooledSize = 256;
+    static constexpr size_t kMaxCachedPerSize = 64;
+
+    static void* allocate(size_t size) {
+        if (!_isPooled(size)) {
+            return ::operator new(size);
+        }
+        if (!_cacheDestroyed) {
+            auto& list = _cache().lists[_listIndex(size)];
+            if (auto block = list.head) {
+                list.head = block->next;
+                --list.count;
+                return block;
+            }
+        }
+        // Always the rounded up size, since the block may be reused for any size in its list.
+        return ::operator new(_roundUp(size));
+    }
+
+    static void deallocate(void* ptr, size_t size) noexcept {
+        // SharedStates can be freed by the destructors of other thread_locals, after the cache of
+        // the exiting thread is gone.
+        if (!_isPooled(size) || _cacheDestroyed) {
+            ::operator delete(ptr);
+            return;
+        }
+        auto& list = _cache().lists[_listIndex(size)];
+        if (list.count == kMaxCachedPerSize) {
+            ::operator delete(ptr);
+            return;
+        }
+        list.head = new (ptr) FreeBlock{list.head};
+        ++list.count;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeBlock* head = nullptr;
+        size_t count = 0;
+    };
+
+    struct Cache {
+        ~Cache() {
+            _cacheDestroyed = true;
+            for (auto& list : lists) {
+                while (auto block = list.head) {
+                    list.head = block->next;
+                    ::operator delete(block);
+                }
+            }
+        }
+
+        std::array<FreeList, kMaxPooledSize / kGranularity> lists;
+    };
+
+    static constexpr size_t _roundUp(size_t size) {
+        return (size + kGranularity - 1) / kGranularity * kGranularity;
+    }
+
+    static constexpr size_t _listIndex(size_t size) {
+        return _roundUp(size) / kGranularity - 1;
+    }
+
+    static constexpr bool _isPooled(size_t size) {
+#ifdef MONGO_FUTURE_SHARED_STATE_POOL_DISABLED
+        return false;
+#else
+        return size <= kMaxPooledSize;
+#endif
+    }
+
+    static Cache& _cache() {
+        static thread_local Cache cache;
+        return cache;
+    }
+
+    static inline thread_local bool _cacheDestroyed = false;
+};
+
 class SharedStateBase : public RefCountable {
 public:
     using Children = std::forward_list<boost::intrusive_ptr<SharedStateBase>>;
 
+    // The size passed to operator delete is the one of the most derived type, since the destructor
+    // is virtual.
+    static void* operator new(size_t size) {
+        return SharedStateAllocator::allocate(size);
+    }
+    static void operator delete(void* ptr, size_t size) noexcept {
+        SharedStateAllocator::deallocate(ptr, size);
+    }
+    // Over-aligned results bypass the pool.
+    static void* operator new(size_t size, std::align_val_t alignment) {
+        return ::operator new(size, alignment);
+    }
+    static void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept {
+        ::operator delete(ptr, alignment);
+    }
+
     SharedStateBase(const SharedStateBase&) = delete;
     SharedStateBase(SharedStateBase&&) = delete;
     SharedStateBase& operator=(const SharedStateBase&) = delete;
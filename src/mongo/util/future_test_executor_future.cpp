@@ -164,9 +164,11 @@ TEST(Executor_Future, Success_then_onError_onError_then) {
                                     .get(),
                                 3);
 
-                            // 1 would also be valid if we did the optimization to not reschedule if
-                            // running on the same executor.
-                            ASSERT_EQ(exec->tasksRun.load(), 3);
+                            // Continuations run inline when the one before them completes on the
+                            // same executor, so whether the chain was ready as it was built decides
+                            // how many tasks are scheduled.
+                            ASSERT_GTE(exec->tasksRun.load(), 1);
+                            ASSERT_LTE(exec->tasksRun.load(), 3);
                         });
 }
 
@@ -196,5 +198,52 @@ TEST(Executor_Future, Success_reject_recoverToFallback) {
                             ASSERT_EQ(accepter->tasksRun.load(), 1);
                         });
 }
+
+TEST(Executor_Future, ChainedContinuationsRunInline) {
+    auto exec = InlineQueuedCountingExecutor::make();
+    auto pf = makePromiseFuture<int>();
+    auto fut = std::move(pf.future)
+                   .thenRunOn(exec)
+                   .then([](int i) { return i + 1; })
+                   .then([](int i) { return i + 1; })
+                   .onError([](Status) {
+                       FAIL("onError()");
+                       return 0;
+                   })
+                   .then([](int i) { return i + 1; });
+    pf.promise.emplaceValue(1);
+    ASSERT_EQ(std::move(fut).get(), 4);
+    ASSERT_EQ(exec->tasksRun.load(), 1);
+}
+
+TEST(Executor_Future, InlineContinuationsAreBounded) {
+    auto exec = InlineQueuedCountingExecutor::make();
+    auto pf = makePromiseFuture<int>();
+    auto fut = std::move(pf.future).thenRunOn(exec);
+    const int kNumContinuations = future_details::ExecutorContinuationScope::kMaxInlineDepth + 4;
+    for (int i = 0; i < kNumContinuations; ++i) {
+        fut = std::move(fut).then([](int n) { return n + 1; });
+    }
+    pf.promise.emplaceValue(0);
+    ASSERT_EQ(std::move(fut).get(), kNumContinuations);
+    ASSERT_EQ(exec->tasksRun.load(), 2);
+}
+
+TEST(Executor_Future, ContinuationsCompletedFromCallbacksAreScheduled) {
+    // A promise completed from within a callback may be completed under a lock, so continuations
+    // on it are not run inline.
+    auto exec = InlineQueuedCountingExecutor::make();
+    auto inner = makePromiseFuture<void>();
+    auto innerFut = std::move(inner.future).thenRunOn(exec).then([] { return 2; });
+    auto outer = makePromiseFuture<void>();
+    auto outerFut = std::move(outer.future).thenRunOn(exec).then([&] {
+        inner.promise.emplaceValue();
+        return 1;
+    });
+    outer.promise.emplaceValue();
+    ASSERT_EQ(std::move(outerFut).get(), 1);
+    ASSERT_EQ(std::move(innerFut).get(), 2);
+    ASSERT_EQ(exec->tasksRun.load(), 2);
+}
 }  // namespace
 }  // namespace mongo
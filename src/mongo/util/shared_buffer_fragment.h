@@ -90,6 +90,10 @@ private:
 /**
  * Builder of SharedBufferFragment where multiple fragments are using different parts of the same
  * underlying buffer. Can only build one fragment at a time
+ *
+ * Once every fragment of the current buffer has been released, the buffer is rewound and reused
+ * rather than replaced, so a builder that outlives the fragments it builds (like the one kept by
+ * the StorageExecutionContext for index keys) settles on a single allocation.
  */
 class SharedBufferFragmentBuilder {
 public:
@@ -119,6 +123,9 @@ public:
     // May only be called if we are not currently building a fragment
     void start(size_t initialSize) {
         invariant(!_inUse);
+        if (_isUnused()) {
+            _offset = 0;
+        }
         if (_buffer.capacity() < (_offset + initialSize)) {
             // If capacity is 0, then this is our initial allocation and we should not use the grow
             // strategy
@@ -136,6 +143,13 @@ public:
     void grow(size_t size) {
         invariant(_inUse);
         auto currentCapacity = capacity();
+        if (currentCapacity < size && _offset > 0 && _isUnused() && _buffer.capacity() >= size) {
+            // Only the fragment being built lives in this buffer, so move it to the front rather
+            // than allocating a new buffer.
+            memmove(_buffer.get(), _buffer.get() + _offset, currentCapacity);
+            _offset = 0;
+            return;
+        }
         if (currentCapacity < size) {
             _blockSize = _growStrategy(_blockSize);
             size_t allocSize = std::max(_blockSize, size);
@@ -191,6 +205,11 @@ public:
     }
 
 private:
+    // Returns true if no fragment finished by this builder still references the current buffer.
+    bool _isUnused() const {
+        return _buffer && !_buffer.isShared();
+    }
+
     SharedBuffer _buffer;
     ptrdiff_t _offset;
     size_t _blockSize;
@@ -57,6 +57,7 @@
 #include "mongo/stdx/mutex.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/async_stack.h"
 #include "mongo/util/signal_handlers_synchronous.h"
 #include "mongo/util/stacktrace_somap.h"
 
@@ -201,14 +202,6 @@ private:
     StackTraceAddressMetadataGenerator _gen;
 };
 
-/** Safe to call from a signal handler. Might wake early with EINTR. */
-void sleepMicros(int64_t usec) {
-    auto nsec = usec * 1000;
-    constexpr static int64_t k1E9 = 1'000'000'000;
-    timespec ts{nsec / k1E9, nsec % k1E9};
-    nanosleep(&ts, nullptr);
-}
-
 int gettid() {
     return syscall(SYS_gettid);
 }
@@ -250,51 +243,6 @@ std::string readThreadName(int tid) {
     return threadName;
 }
 
-/** Cannot yield. AS-Safe. */
-class SimpleSpinLock {
-public:
-    void lock() {
-        while (true) {
-            for (int i = 0; i < 100; ++i) {
-                if (!_flag.test_and_set(std::memory_order_acquire)) {
-                    return;
-                }
-            }
-            sleepMicros(1);
-        }
-    }
-
-    void unlock() {
-        _flag.clear(std::memory_order_release);
-    }
-
-private:
-    std::atomic_flag _flag = ATOMIC_FLAG_INIT;  // NOLINT
-};
-
-template <typename T>
-class AsyncStack {
-public:
-    T* tryPop() {
-        stdx::lock_guard lock{_spin};
-        T* node = _head;
-        if (node) {
-            node = std::exchange(_head, node->intrusiveNext);
-            node->intrusiveNext = nullptr;
-        }
-        return node;
-    }
-
-    void push(T* node) {
-        stdx::lock_guard lock{_spin};
-        node->intrusiveNext = std::exchange(_head, node);
-    }
-
-private:
-    T* _head = nullptr;
-    SimpleSpinLock _spin;  // guards _head
-};
-
 class ThreadBacktrace {
 public:
     ThreadBacktrace* intrusiveNext;
@@ -33,6 +33,7 @@
 
 #include <cmath>
 
+#include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/util/assert_util.h"
 
 namespace mongo {
@@ -45,6 +46,61 @@ void DoubleDoubleSummation::addLong(long long x) {
     addDouble(high);
 }
 
+void DoubleDoubleSummation::addDoubles(const double* values, size_t count) {
+    constexpr size_t kLanes = 4;
+    double sums[kLanes] = {};
+    double addends[kLanes] = {};
+    double specials[kLanes] = {};
+
+    size_t i = 0;
+    for (; i + kLanes <= count; i += kLanes) {
+        // Same steps as addDouble(), with _fast2Sum() and _2Sum() written out so that the lanes
+        // have no dependencies on each other.
+        for (size_t lane = 0; lane < kLanes; ++lane) {
+            double x = values[i + lane];
+            specials[lane] += x;
+
+            double s = x + addends[lane];
+            double z = s - x;
+            addends[lane] = addends[lane] - z;
+            x = s;
+
+            s = sums[lane] + x;
+            double aPrime = s - x;
+            double bPrime = s - aPrime;
+            addends[lane] += (sums[lane] - aPrime) + (x - bPrime);
+            sums[lane] = s;
+        }
+    }
+
+    double special = _special;
+    for (size_t lane = 0; lane < kLanes; ++lane) {
+        addDouble(sums[lane]);
+        addDouble(addends[lane]);
+        special += specials[lane];
+    }
+    // addDouble() also added the lane sums and addends to the simple sum, but those turn into NaN
+    // after an infinity, so the simple sum is rebuilt from the simple lane sums instead.
+    _special = special;
+
+    for (; i < count; ++i) {
+        addDouble(values[i]);
+    }
+}
+
+void DoubleDoubleSummation::addLongs(const long long* values, size_t count) {
+    long long run = 0;
+    for (size_t i = 0; i < count; ++i) {
+        long long next;
+        if (overflow::add(run, values[i], &next)) {
+            addLong(run);
+            next = values[i];
+        }
+        run = next;
+    }
+    addLong(run);
+}
+
 /**
  * Returns whether the sum is in range of the 64-bit signed integer long long type.
  */
@@ -64,6 +64,20 @@ public:
      */
     void addLong(long long x);
 
+    /**
+     * Adds 'count' doubles to the sum. The values are summed in several independent compensated
+     * lanes, which compilers can keep in vector registers, before the lanes are added to the sum.
+     * The result has the same precision as calling addDouble() for each value.
+     */
+    void addDoubles(const double* values, size_t count);
+
+    /**
+     * Adds 'count' 64-bit integers to the sum. Runs of values whose sum fits a long long are added
+     * as integers, so only one addLong() is needed per run. The result is exact under the same
+     * conditions as addLong().
+     */
+    void addLongs(const long long* values, size_t count);
+
     /**
      * Adds x to internal sum. Adds as double as that is more efficient.
      */
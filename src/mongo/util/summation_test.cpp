@@ -205,6 +205,56 @@ TEST(Summation, AddDoubles) {
     ASSERT(straightSum != sum.getDouble());
 }
 
+TEST(Summation, BatchedDoublesMatchAddDouble) {
+    // Cover every remainder of the batch size beyond the lanes.
+    for (size_t count = 0; count <= doubleValues.size(); ++count) {
+        DoubleDoubleSummation single;
+        for (size_t i = 0; i < count; ++i) {
+            single.addDouble(doubleValues[i]);
+        }
+
+        DoubleDoubleSummation batched;
+        batched.addDoubles(doubleValues.data(), count);
+        ASSERT_EQUALS(batched.getDouble(), single.getDouble());
+    }
+
+    DoubleDoubleSummation sum;
+    sum.addDoubles(doubleValues.data(), doubleValues.size());
+    ASSERT_EQUALS(sum.getDouble(), doubleValuesSum);
+}
+
+TEST(Summation, BatchedLongsAreExact) {
+    // The values overflow a long long many times over, so the batch is split into several runs.
+    DoubleDoubleSummation sum;
+    uint64_t checkUint64 = 0;
+    for (int repeat = 0; repeat < 3; ++repeat) {
+        sum.addLongs(longValues.data(), longValues.size());
+        for (auto x : longValues) {
+            checkUint64 += static_cast<uint64_t>(x);
+        }
+    }
+    ASSERT(sum.isInteger());
+    while (!sum.fitsLong()) {
+        sum.addDouble(sum.getDouble() < 0 ? std::ldexp(1, 64) : -std::ldexp(1, 64));
+    }
+    ASSERT_EQUALS(static_cast<uint64_t>(sum.getLong()), checkUint64);
+}
+
+TEST(Summation, BatchedSpecialValues) {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    std::vector<double> values(9, 1.0);
+
+    values[5] = infinity;
+    DoubleDoubleSummation sum;
+    sum.addDoubles(values.data(), values.size());
+    ASSERT_EQUALS(sum.getDouble(), infinity);
+
+    values[2] = -infinity;
+    DoubleDoubleSummation nanSum;
+    nanSum.addDoubles(values.data(), values.size());
+    ASSERT(std::isnan(nanSum.getDouble()));
+}
+
 TEST(Summation, ConvertInfinityToDecimal) {
     constexpr double infinity = std::numeric_limits<double>::infinity();
     DoubleDoubleSummation sum;